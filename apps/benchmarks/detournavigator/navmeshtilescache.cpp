@@ -227,6 +227,79 @@ namespace
         getFromFilledCache<64 * 1024 * 1024, 70>(state);
     }
 
+    template <std::size_t maxCacheSize>
+    void getMissingFromFilledCache(benchmark::State& state)
+    {
+        NavMeshTilesCache cache(maxCacheSize);
+        std::minstd_rand random;
+        std::vector<Key> cached;
+        fillCache(std::back_inserter(cached), random, cache);
+        std::vector<Key> keys;
+        generateKeys(std::back_inserter(keys), cached.size(), random);
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            const auto& key = keys[n++ % keys.size()];
+            auto result = cache.get(key.mAgentBounds, key.mTilePosition, key.mRecastMesh);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    void getMissingFromFilledCache_1m(benchmark::State& state)
+    {
+        getMissingFromFilledCache<1 * 1024 * 1024>(state);
+    }
+
+    void getMissingFromFilledCache_4m(benchmark::State& state)
+    {
+        getMissingFromFilledCache<4 * 1024 * 1024>(state);
+    }
+
+    void getMissingFromFilledCache_16m(benchmark::State& state)
+    {
+        getMissingFromFilledCache<16 * 1024 * 1024>(state);
+    }
+
+    void getMissingFromFilledCache_64m(benchmark::State& state)
+    {
+        getMissingFromFilledCache<64 * 1024 * 1024>(state);
+    }
+
+    template <std::size_t maxCacheSize>
+    void setExistingToFilledCache(benchmark::State& state)
+    {
+        NavMeshTilesCache cache(maxCacheSize);
+        std::minstd_rand random;
+        std::vector<Key> keys;
+        fillCache(std::back_inserter(keys), random, cache);
+        keys.pop_back();
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            const auto& key = keys[n++ % keys.size()];
+            auto result = cache.set(
+                key.mAgentBounds, key.mTilePosition, key.mRecastMesh, std::make_unique<PreparedNavMeshData>());
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    void setExistingToFilledCache_1m(benchmark::State& state)
+    {
+        setExistingToFilledCache<1 * 1024 * 1024>(state);
+    }
+
+    void setExistingToFilledCache_16m(benchmark::State& state)
+    {
+        setExistingToFilledCache<16 * 1024 * 1024>(state);
+    }
+
+    void setExistingToFilledCache_64m(benchmark::State& state)
+    {
+        setExistingToFilledCache<64 * 1024 * 1024>(state);
+    }
+
     template <std::size_t maxCacheSize>
     void setToBoundedNonEmptyCache(benchmark::State& state)
     {
@@ -276,6 +349,13 @@ BENCHMARK(getFromFilledCache_1m_70hit);
 BENCHMARK(getFromFilledCache_4m_70hit);
 BENCHMARK(getFromFilledCache_16m_70hit);
 BENCHMARK(getFromFilledCache_64m_70hit);
+BENCHMARK(getMissingFromFilledCache_1m);
+BENCHMARK(getMissingFromFilledCache_4m);
+BENCHMARK(getMissingFromFilledCache_16m);
+BENCHMARK(getMissingFromFilledCache_64m);
+BENCHMARK(setExistingToFilledCache_1m);
+BENCHMARK(setExistingToFilledCache_16m);
+BENCHMARK(setExistingToFilledCache_64m);
 BENCHMARK(setToBoundedNonEmptyCache_1m);
 BENCHMARK(setToBoundedNonEmptyCache_4m);
 BENCHMARK(setToBoundedNonEmptyCache_16m);
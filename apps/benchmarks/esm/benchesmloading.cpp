@@ -0,0 +1,285 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/format.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/loadmisc.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/esm4/reader.hpp>
+#include <components/esm4/readerutils.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+
+#include "apps/openmw/mwmechanics/spelllist.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace MWMechanics
+{
+    SpellList::SpellList(const ESM::RefId& id, int type)
+        : mId(id)
+        , mType(type)
+    {
+    }
+}
+
+namespace
+{
+    Loading::Listener dummyListener;
+
+    struct Content
+    {
+        std::string mData;
+        std::size_t mRecords = 0;
+    };
+
+    template <class T>
+    void writeRecord(ESM::ESMWriter& writer, const T& record)
+    {
+        writer.startRecord(T::sRecordId);
+        record.save(writer);
+        writer.endRecord(T::sRecordId);
+    }
+
+    // Similar to what the base game defines in the most numerous record types
+    Content generateContent(std::size_t count)
+    {
+        ESM::ESMWriter writer;
+        std::ostringstream stream;
+        writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+        writer.save(stream);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::string index = std::to_string(i);
+            if (i % 2 == 0)
+            {
+                ESM::Static record;
+                record.mId = ESM::RefId::stringRefId("static_" + index);
+                record.mModel = "x\\ex_static_" + index + ".nif";
+                record.mRecordFlags = 0;
+                writeRecord(writer, record);
+            }
+            else
+            {
+                ESM::Miscellaneous record;
+                record.blank();
+                record.mId = ESM::RefId::stringRefId("misc_" + index);
+                record.mName = "Miscellaneous item " + index;
+                record.mModel = "m\\misc_item_" + index + ".nif";
+                record.mIcon = "m\\tx_misc_item_" + index + ".tga";
+                record.mData.mWeight = 1;
+                record.mData.mValue = static_cast<int32_t>(i);
+                record.mRecordFlags = 0;
+                writeRecord(writer, record);
+            }
+        }
+        return Content{ .mData = std::move(stream).str(), .mRecords = count };
+    }
+
+    // Real content files are opt-in, they are not a part of the repository
+    const Content* getRealContent(ESM::Format format)
+    {
+        static const Content content = [] {
+            Content result;
+            const char* const path = std::getenv("OPENMW_BENCHMARK_CONTENT_FILE");
+            if (path == nullptr)
+                return result;
+            std::ifstream file(path, std::ios::binary);
+            std::ostringstream data;
+            data << file.rdbuf();
+            result.mData = std::move(data).str();
+            return result;
+        }();
+        if (content.mData.empty())
+            return nullptr;
+        std::istringstream stream(content.mData);
+        if (ESM::readFormat(stream) != format)
+            return nullptr;
+        return &content;
+    }
+
+    std::unique_ptr<std::istream> makeStream(const Content& content)
+    {
+        return std::make_unique<std::istringstream>(content.mData);
+    }
+
+    void reportProcessed(benchmark::State& state, const Content& content, std::size_t records)
+    {
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records));
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * content.mData.size()));
+    }
+
+    std::size_t readSubrecords(ESM::ESMReader& reader)
+    {
+        std::size_t records = 0;
+        while (reader.hasMoreRecs())
+        {
+            benchmark::DoNotOptimize(reader.getRecName());
+            reader.getRecHeader();
+            while (reader.hasMoreSubs())
+            {
+                reader.getSubName();
+                reader.skipHSub();
+            }
+            ++records;
+        }
+        return records;
+    }
+
+    Content countESM3Records(const Content& content)
+    {
+        ESM::ESMReader reader;
+        reader.open(makeStream(content), "benchmark.esm");
+        return Content{ .mData = content.mData, .mRecords = readSubrecords(reader) };
+    }
+
+    void loadESMStore(MWWorld::ESMStore& store, const Content& content)
+    {
+        ESM::ESMReader reader;
+        reader.open(makeStream(content), "benchmark.esp");
+        ESM::Dialogue* dialogue = nullptr;
+        store.load(reader, &dummyListener, dialogue);
+    }
+
+    void readESM3Subrecords(benchmark::State& state, const Content& content, bool bufferRecords = true)
+    {
+        std::size_t records = 0;
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            reader.setBufferRecords(bufferRecords);
+            reader.open(makeStream(content), "benchmark.esp");
+            records = readSubrecords(reader);
+        }
+        reportProcessed(state, content, records);
+    }
+
+    void loadESM3Store(benchmark::State& state, const Content& content)
+    {
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto store = std::make_unique<MWWorld::ESMStore>();
+            state.ResumeTiming();
+            loadESMStore(*store, content);
+            state.PauseTiming();
+            store.reset();
+            state.ResumeTiming();
+        }
+        reportProcessed(state, content, content.mRecords);
+    }
+
+    void setUpESM3Store(benchmark::State& state, const Content& content)
+    {
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto store = std::make_unique<MWWorld::ESMStore>();
+            loadESMStore(*store, content);
+            state.ResumeTiming();
+            store->setUp();
+            state.PauseTiming();
+            store.reset();
+            state.ResumeTiming();
+        }
+        reportProcessed(state, content, content.mRecords);
+    }
+
+    void readGeneratedESM3Subrecords(benchmark::State& state)
+    {
+        readESM3Subrecords(state, generateContent(static_cast<std::size_t>(state.range(0))));
+    }
+
+    void readGeneratedESM3SubrecordsUnbuffered(benchmark::State& state)
+    {
+        readESM3Subrecords(state, generateContent(static_cast<std::size_t>(state.range(0))), false);
+    }
+
+    void loadGeneratedESM3Store(benchmark::State& state)
+    {
+        loadESM3Store(state, generateContent(static_cast<std::size_t>(state.range(0))));
+    }
+
+    void setUpGeneratedESM3Store(benchmark::State& state)
+    {
+        setUpESM3Store(state, generateContent(static_cast<std::size_t>(state.range(0))));
+    }
+
+    void readRealESM3Subrecords(benchmark::State& state)
+    {
+        const Content* const content = getRealContent(ESM::Format::Tes3);
+        if (content == nullptr)
+            return state.SkipWithError("OPENMW_BENCHMARK_CONTENT_FILE is not set to an ESM3 content file");
+        readESM3Subrecords(state, *content);
+    }
+
+    void loadRealESM3Store(benchmark::State& state)
+    {
+        const Content* const content = getRealContent(ESM::Format::Tes3);
+        if (content == nullptr)
+            return state.SkipWithError("OPENMW_BENCHMARK_CONTENT_FILE is not set to an ESM3 content file");
+        loadESM3Store(state, countESM3Records(*content));
+    }
+
+    void setUpRealESM3Store(benchmark::State& state)
+    {
+        const Content* const content = getRealContent(ESM::Format::Tes3);
+        if (content == nullptr)
+            return state.SkipWithError("OPENMW_BENCHMARK_CONTENT_FILE is not set to an ESM3 content file");
+        setUpESM3Store(state, countESM3Records(*content));
+    }
+
+    // Compressed records are inflated by getRecordData, so they are covered as long as the file has any
+    void traverseESM4Groups(benchmark::State& state, bool inflateAhead)
+    {
+        const Content* const content = getRealContent(ESM::Format::Tes4);
+        if (content == nullptr)
+            return state.SkipWithError("OPENMW_BENCHMARK_CONTENT_FILE is not set to an ESM4 content file");
+        std::size_t records = 0;
+        for (auto _ : state)
+        {
+            records = 0;
+            ESM4::Reader reader(makeStream(*content), "benchmark.esm", nullptr, nullptr, true);
+            if (inflateAhead)
+                reader.inflateAhead(makeStream(*content));
+            ESM4::ReaderUtils::readAll(
+                reader,
+                [&](ESM4::Reader& recordReader) {
+                    recordReader.getRecordData();
+                    while (recordReader.getSubRecordHeader())
+                        recordReader.skipSubRecordData();
+                    ++records;
+                    return true;
+                },
+                [](ESM4::Reader&) {});
+        }
+        reportProcessed(state, *content, records);
+    }
+
+    void traverseRealESM4Groups(benchmark::State& state)
+    {
+        traverseESM4Groups(state, false);
+    }
+
+    void traverseRealESM4GroupsInflatingAhead(benchmark::State& state)
+    {
+        traverseESM4Groups(state, true);
+    }
+}
+
+BENCHMARK(readGeneratedESM3Subrecords)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
+BENCHMARK(readGeneratedESM3SubrecordsUnbuffered)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
+BENCHMARK(loadGeneratedESM3Store)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
+BENCHMARK(setUpGeneratedESM3Store)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
+BENCHMARK(readRealESM3Subrecords);
+BENCHMARK(loadRealESM3Store);
+BENCHMARK(setUpRealESM3Store);
+BENCHMARK(traverseRealESM4Groups);
+BENCHMARK(traverseRealESM4GroupsInflatingAhead);
+
+BENCHMARK_MAIN();
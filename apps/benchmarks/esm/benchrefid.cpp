@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <random>
 #include <string>
 #include <vector>
@@ -99,6 +100,33 @@ namespace
         return generateSerializedRefIds(generateESM3ExteriorCellRefIds(random), serialize);
     }
 
+    void constructExistingStringRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<std::string> values
+            = generateSerializedStringRefIds(state.range(0), random, [](ESM::RefId v) { return v.getRefIdString(); });
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ESM::StringRefId(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void hashStringRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(std::hash<ESM::RefId>{}(refIds[i]));
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
+
     void serializeRefId(benchmark::State& state)
     {
         std::minstd_rand random;
@@ -235,6 +263,8 @@ namespace
     }
 }
 
+BENCHMARK(constructExistingStringRefId)->RangeMultiplier(4)->Range(8, 64)->ThreadRange(1, 8);
+BENCHMARK(hashStringRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(serializeRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(deserializeRefId)->RangeMultiplier(4)->Range(8, 64);
 BENCHMARK(serializeTextStringRefId)->RangeMultiplier(4)->Range(8, 64);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esmterrain/storage.hpp>
+
+#include <osg/Array>
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    osg::ref_ptr<const ESMTerrain::LandObject> makeLand()
+    {
+        ESM::Land land;
+        land.mDataTypes = ESM::Land::DATA_VNML | ESM::Land::DATA_VHGT | ESM::Land::DATA_WNAM
+            | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+        land.mLandData = std::make_unique<ESM::Land::LandData>();
+
+        ESM::Land::LandData& data = *land.mLandData;
+        for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+        {
+            const float phase = static_cast<float>(i) * 0.1f;
+            data.mHeights[i] = 256 * std::sin(phase);
+            data.mNormals[i * 3] = static_cast<std::int8_t>(32 * std::cos(phase));
+            data.mNormals[i * 3 + 1] = static_cast<std::int8_t>(32 * std::sin(phase));
+            data.mNormals[i * 3 + 2] = 120;
+            data.mColours[i * 3] = static_cast<std::uint8_t>(i);
+            data.mColours[i * 3 + 1] = static_cast<std::uint8_t>(i >> 2);
+            data.mColours[i * 3 + 2] = static_cast<std::uint8_t>(i >> 4);
+        }
+        data.mTextures.fill(0);
+        data.mMinHeight = -256;
+        data.mMaxHeight = 256;
+        data.mDataLoaded = land.mDataTypes;
+
+        return new ESMTerrain::LandObject(land, land.mDataTypes);
+    }
+
+    class TestStorage final : public ESMTerrain::Storage
+    {
+    public:
+        TestStorage()
+            : ESMTerrain::Storage(nullptr)
+            , mLand(makeLand())
+        {
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(ESM::ExteriorCellLocation /*cellLocation*/) override
+        {
+            return mLand;
+        }
+
+        const std::string* getLandTexture(std::uint16_t /*index*/, int /*plugin*/) override { return nullptr; }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY, ESM::RefId /*worldspace*/) override
+        {
+            minX = -64;
+            maxX = 64;
+            minY = -64;
+            maxY = 64;
+        }
+
+    private:
+        osg::ref_ptr<const ESMTerrain::LandObject> mLand;
+    };
+
+    void fillVertexBuffers(benchmark::State& state)
+    {
+        const int lodLevel = static_cast<int>(state.range(0));
+        const float size = static_cast<float>(state.range(1));
+        const std::size_t numVerts
+            = static_cast<std::size_t>((ESM::Land::LAND_SIZE - 1) * size / (1 << lodLevel)) + 1;
+        TestStorage storage;
+        osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array(numVerts * numVerts));
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array(numVerts * numVerts));
+        osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray(numVerts * numVerts));
+
+        for (auto _ : state)
+        {
+            storage.fillVertexBuffers(lodLevel, size, osg::Vec2f(0.5f, 0.5f), ESM::Cell::sDefaultWorldspaceId,
+                *positions, *normals, *colours);
+            benchmark::DoNotOptimize(positions->data());
+            benchmark::DoNotOptimize(normals->data());
+            benchmark::DoNotOptimize(colours->data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(numVerts * numVerts));
+    }
+
+    BENCHMARK(fillVertexBuffers)->Args({ 0, 1 })->Args({ 1, 2 })->Args({ 2, 4 })->Args({ 3, 8 })->Args({ 4, 16 });
+}
+
+BENCHMARK_MAIN();
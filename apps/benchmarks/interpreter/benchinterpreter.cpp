@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include "components/compiler/generator.hpp"
+#include "components/interpreter/context.hpp"
+#include "components/interpreter/installopcodes.hpp"
+#include "components/interpreter/interpreter.hpp"
+#include "components/interpreter/opcodes.hpp"
+#include "components/interpreter/program.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using Compiler::Generator::segment0;
+    using Compiler::Generator::segment5;
+
+    constexpr unsigned opcodePushInt = 0;
+    constexpr unsigned opcodeStoreLocalLong = 1;
+    constexpr unsigned opcodeAddInt = 9;
+    constexpr unsigned opcodeFetchLocalLong = 22;
+    constexpr unsigned opcodeExtension = 0x2000000;
+
+    class Context final : public Interpreter::Context
+    {
+        std::vector<int> mLocals = std::vector<int>(1);
+
+    public:
+        int getLocal() const { return mLocals[0]; }
+
+        ESM::RefId getTarget() const override { return ESM::RefId(); }
+
+        int getLocalShort(int index) const override { return mLocals[index]; }
+
+        int getLocalLong(int index) const override { return mLocals[index]; }
+
+        float getLocalFloat(int index) const override { return static_cast<float>(mLocals[index]); }
+
+        void setLocalShort(int index, int value) override { mLocals[index] = value; }
+
+        void setLocalLong(int index, int value) override { mLocals[index] = value; }
+
+        void setLocalFloat(int index, float value) override { mLocals[index] = static_cast<int>(value); }
+
+        void messageBox(std::string_view message, const std::vector<std::string>& buttons) override {}
+
+        void report(const std::string& message) override {}
+
+        int getGlobalShort(std::string_view name) const override { return {}; }
+
+        int getGlobalLong(std::string_view name) const override { return {}; }
+
+        float getGlobalFloat(std::string_view name) const override { return {}; }
+
+        void setGlobalShort(std::string_view name, int value) override {}
+
+        void setGlobalLong(std::string_view name, int value) override {}
+
+        void setGlobalFloat(std::string_view name, float value) override {}
+
+        std::vector<std::string> getGlobals() const override { return {}; }
+
+        char getGlobalType(std::string_view name) const override { return ' '; }
+
+        std::string getActionBinding(std::string_view action) const override { return {}; }
+
+        std::string_view getActorName() const override { return {}; }
+
+        std::string_view getNPCRace() const override { return {}; }
+
+        std::string_view getNPCClass() const override { return {}; }
+
+        std::string_view getNPCFaction() const override { return {}; }
+
+        std::string_view getNPCRank() const override { return {}; }
+
+        std::string_view getPCName() const override { return {}; }
+
+        std::string_view getPCRace() const override { return {}; }
+
+        std::string_view getPCClass() const override { return {}; }
+
+        std::string_view getPCRank() const override { return {}; }
+
+        std::string_view getPCNextRank() const override { return {}; }
+
+        int getPCBounty() const override { return {}; }
+
+        std::string_view getCurrentCellName() const override { return {}; }
+
+        int getMemberShort(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        int getMemberLong(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        float getMemberFloat(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        void setMemberShort(ESM::RefId id, std::string_view name, int value, bool global) override {}
+
+        void setMemberLong(ESM::RefId id, std::string_view name, int value, bool global) override {}
+
+        void setMemberFloat(ESM::RefId id, std::string_view name, float value, bool global) override {}
+    };
+
+    class OpNothing final : public Interpreter::Opcode0
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime) override {}
+    };
+
+    // Equivalent of "set value to value + 1" repeated the given number of times
+    Interpreter::Program makeIncrementProgram(std::size_t count)
+    {
+        Interpreter::Program program;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            program.mInstructions.push_back(segment0(opcodePushInt, 0));
+            program.mInstructions.push_back(segment0(opcodePushInt, 0));
+            program.mInstructions.push_back(segment5(opcodeFetchLocalLong));
+            program.mInstructions.push_back(segment0(opcodePushInt, 1));
+            program.mInstructions.push_back(segment5(opcodeAddInt));
+            program.mInstructions.push_back(segment5(opcodeStoreLocalLong));
+        }
+        return program;
+    }
+
+    void runIncrementProgram(benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::Program program = makeIncrementProgram(static_cast<std::size_t>(state.range(0)));
+        Context context;
+
+        for (auto _ : state)
+            interpreter.run(program, context);
+
+        benchmark::DoNotOptimize(context.getLocal());
+        state.SetItemsProcessed(state.iterations() * program.mInstructions.size());
+    }
+
+    void runExtensionOpcodes(benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        interpreter.installSegment5<OpNothing>(opcodeExtension);
+        Interpreter::Program program;
+        program.mInstructions.resize(static_cast<std::size_t>(state.range(0)), segment5(opcodeExtension));
+        Context context;
+
+        for (auto _ : state)
+            interpreter.run(program, context);
+
+        state.SetItemsProcessed(state.iterations() * program.mInstructions.size());
+    }
+}
+
+BENCHMARK(runIncrementProgram)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(runExtensionOpcodes)->RangeMultiplier(8)->Range(1, 4096);
+
+BENCHMARK_MAIN();
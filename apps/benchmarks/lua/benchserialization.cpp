@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <osg/Vec3f>
+
+#include <components/lua/serialization.hpp>
+
+#include <string>
+
+namespace
+{
+    // Similar to the data of an event sent by a script every frame
+    sol::object makeSmallEvent(sol::state& lua)
+    {
+        sol::table event(lua, sol::create);
+        event["target"] = sol::make_object(lua, osg::Vec3f(1, 2, 3));
+        event["amount"] = 42.5;
+        event["name"] = "fortify_attack";
+        event["force"] = true;
+        return event;
+    }
+
+    sol::object makeLargeEvent(sol::state& lua, int count)
+    {
+        sol::table event(lua, sol::create);
+        for (int i = 1; i <= count; ++i)
+        {
+            sol::table item(lua, sol::create);
+            item["id"] = "item_" + std::to_string(i);
+            item["count"] = i;
+            event[i] = item;
+        }
+        return event;
+    }
+
+    void serializeSmallEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::object event = makeSmallEvent(lua);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::serialize(event));
+    }
+
+    void deserializeSmallEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const LuaUtil::BinaryData data = LuaUtil::serialize(makeSmallEvent(lua));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::deserialize(lua, data));
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    void serializeLargeEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::object event = makeLargeEvent(lua, static_cast<int>(state.range(0)));
+        std::size_t size = 0;
+
+        for (auto _ : state)
+        {
+            const LuaUtil::BinaryData data = LuaUtil::serialize(event);
+            size = data.size();
+            benchmark::DoNotOptimize(data);
+        }
+
+        state.SetBytesProcessed(state.iterations() * size);
+    }
+
+    void deserializeLargeEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const LuaUtil::BinaryData data = LuaUtil::serialize(makeLargeEvent(lua, static_cast<int>(state.range(0))));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::deserialize(lua, data));
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+}
+
+BENCHMARK(serializeSmallEvent);
+BENCHMARK(deserializeSmallEvent);
+BENCHMARK(serializeLargeEvent)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(deserializeLargeEvent)->RangeMultiplier(8)->Range(1, 512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/formid.hpp>
+#include <components/misc/flathashmap.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Similar to the numbers of the references loaded from a few content files
+    std::vector<ESM::FormId> generateRefNums(std::size_t count, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<std::uint32_t> index(0, 1 << 20);
+        std::uniform_int_distribution<std::int32_t> contentFile(0, 8);
+        std::vector<ESM::FormId> result;
+        result.reserve(count);
+        std::generate_n(std::back_inserter(result), count,
+            [&] { return ESM::FormId{ .mIndex = index(random), .mContentFile = contentFile(random) }; });
+        return result;
+    }
+
+    // Similar to the names of interior cells
+    std::vector<std::string> generateNames(std::size_t count, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::uniform_int_distribution<std::size_t> size(8, 32);
+        std::vector<std::string> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string name(size(random), ' ');
+            std::generate(name.begin(), name.end(), [&] { return static_cast<char>(letter(random)); });
+            name += std::to_string(i);
+            result.push_back(std::move(name));
+        }
+        return result;
+    }
+
+    template <class Map, class Keys>
+    void findExisting(benchmark::State& state, Map& map, const Keys& keys)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = i;
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(keys[i]));
+            if (++i >= keys.size())
+                i = 0;
+        }
+    }
+
+    void findRefNumInFlatHashMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::FormId> keys = generateRefNums(static_cast<std::size_t>(state.range(0)), random);
+        Misc::FlatHashMap<ESM::FormId, std::size_t> map;
+        findExisting(state, map, keys);
+    }
+
+    void findRefNumInUnorderedMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::FormId> keys = generateRefNums(static_cast<std::size_t>(state.range(0)), random);
+        std::unordered_map<ESM::FormId, std::size_t> map;
+        findExisting(state, map, keys);
+    }
+
+    void findNameInFlatHashMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> keys = generateNames(static_cast<std::size_t>(state.range(0)), random);
+        Misc::FlatHashMap<std::string, std::size_t, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> map;
+        findExisting(state, map, keys);
+    }
+
+    void findNameInMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> keys = generateNames(static_cast<std::size_t>(state.range(0)), random);
+        std::map<std::string, std::size_t, Misc::StringUtils::CiComp> map;
+        findExisting(state, map, keys);
+    }
+}
+
+BENCHMARK(findRefNumInFlatHashMap)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(findRefNumInUnorderedMap)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(findNameInFlatHashMap)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(findNameInMap)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/sampleconversion.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    // Number of samples per channel in a frame of the MP3 decoder
+    constexpr std::size_t count = 1152;
+
+    std::vector<float> makeSamples(std::size_t size)
+    {
+        std::vector<float> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = std::sin(static_cast<float>(i) * 0.01f) * 1.1f;
+        return result;
+    }
+
+    void convertStereoFloat(benchmark::State& state)
+    {
+        const std::vector<float> input = makeSamples(count * 2);
+        std::vector<std::int16_t> output(input.size());
+
+        for (auto _ : state)
+        {
+            Misc::convertSamples(input, output.data());
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * input.size());
+    }
+
+    void interleaveMonoFloat(benchmark::State& state)
+    {
+        const std::vector<float> input = makeSamples(count);
+        const std::array<const float*, 1> planes{ input.data() };
+        std::vector<std::int16_t> output(count);
+
+        for (auto _ : state)
+        {
+            Misc::interleaveSamples(planes, count, output.data());
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * output.size());
+    }
+
+    void interleaveStereoFloat(benchmark::State& state)
+    {
+        const std::vector<float> left = makeSamples(count);
+        const std::vector<float> right = makeSamples(count);
+        const std::array<const float*, 2> planes{ left.data(), right.data() };
+        std::vector<std::int16_t> output(count * 2);
+
+        for (auto _ : state)
+        {
+            Misc::interleaveSamples(planes, count, output.data());
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * output.size());
+    }
+
+    void interleaveStereoInt16(benchmark::State& state)
+    {
+        const std::vector<std::int16_t> left(count, 1000);
+        const std::vector<std::int16_t> right(count, -1000);
+        const std::array<const std::int16_t*, 2> planes{ left.data(), right.data() };
+        std::vector<std::int16_t> output(count * 2);
+
+        for (auto _ : state)
+        {
+            Misc::interleaveSamples(planes, count, output.data());
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * output.size());
+    }
+}
+
+BENCHMARK(convertStereoFloat);
+BENCHMARK(interleaveMonoFloat);
+BENCHMARK(interleaveStereoFloat);
+BENCHMARK(interleaveStereoInt16);
+
+BENCHMARK_MAIN();
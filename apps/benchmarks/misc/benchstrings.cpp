@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/strings/algorithm.hpp>
+#include <components/misc/strings/lower.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Similar to the names of interior cells and records, in mixed case
+    std::vector<std::string> generateNames(std::size_t count, std::size_t size, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::bernoulli_distribution upper(0.2);
+        std::vector<std::string> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string name(size, ' ');
+            std::generate(name.begin(), name.end(), [&] {
+                const char c = static_cast<char>(letter(random));
+                return upper(random) ? static_cast<char>(c - 'a' + 'A') : c;
+            });
+            result.push_back(std::move(name));
+        }
+        return result;
+    }
+
+    std::vector<std::string> swapCase(std::vector<std::string> values)
+    {
+        for (std::string& value : values)
+            for (char& c : value)
+                c = static_cast<char>(c ^ 0x20);
+        return values;
+    }
+
+    void ciEqualForEqualStrings(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateNames(1024, static_cast<std::size_t>(state.range(0)), random);
+        const std::vector<std::string> others = swapCase(values);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::ciEqual(values[i], others[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void ciLessForEqualStrings(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateNames(1024, static_cast<std::size_t>(state.range(0)), random);
+        const std::vector<std::string> others = swapCase(values);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::ciLess(values[i], others[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void lowerCase(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateNames(1024, static_cast<std::size_t>(state.range(0)), random);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::lowerCase(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+}
+
+BENCHMARK(ciEqualForEqualStrings)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(ciLessForEqualStrings)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(lowerCase)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+BENCHMARK_MAIN();
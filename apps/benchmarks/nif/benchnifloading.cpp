@@ -0,0 +1,471 @@
+#include <benchmark/benchmark.h>
+
+#include <components/nif/base.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifbullet/bulletnifloader.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/optimizer.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/shader/shadervisitor.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    enum class NifKind
+    {
+        ManyNodes,
+        LargeTriShape,
+        Skinned,
+        Particles,
+    };
+
+    // Writes the records in the 4.0.0.2 layout read by Nif::Reader, the version used by Morrowind assets
+    class NifWriter
+    {
+    public:
+        template <class T>
+        void write(T value)
+        {
+            char buffer[sizeof(T)];
+            std::memcpy(buffer, &value, sizeof(T));
+            mRecords.append(buffer, sizeof(T));
+        }
+
+        // Booleans are 32-bit before 4.1.0.0
+        void writeBool(bool value) { write<std::int32_t>(value ? 1 : 0); }
+
+        void writeString(std::string_view value)
+        {
+            write(static_cast<std::uint32_t>(value.size()));
+            mRecords.append(value);
+        }
+
+        void writeVec3(float x, float y, float z)
+        {
+            write(x);
+            write(y);
+            write(z);
+        }
+
+        void writeRefList(const std::vector<std::int32_t>& refs)
+        {
+            write(static_cast<std::uint32_t>(refs.size()));
+            for (const std::int32_t ref : refs)
+                write(ref);
+        }
+
+        void writeIdentityRotation()
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    write(i == j ? 1.f : 0.f);
+        }
+
+        void beginRecord(std::string_view type)
+        {
+            ++mRecordsCount;
+            writeString(type);
+        }
+
+        void writeAVObject(std::string_view name, std::int32_t controller, float x, float y, float z)
+        {
+            writeString(name);
+            write<std::int32_t>(-1); // Extra data
+            write(controller);
+            write<std::uint16_t>(0); // Flags
+            writeVec3(x, y, z);
+            writeIdentityRotation();
+            write(1.f); // Scale
+            writeVec3(0, 0, 0); // Velocity
+            writeRefList({}); // Properties
+            writeBool(false); // Has bounding volume
+        }
+
+        void writeNode(std::string_view name, float x, float y, float z, const std::vector<std::int32_t>& children)
+        {
+            beginRecord("NiNode");
+            writeAVObject(name, -1, x, y, z);
+            writeRefList(children);
+            writeRefList({}); // Effects
+        }
+
+        void writeTriShape(std::string_view name, std::int32_t data, std::int32_t skin)
+        {
+            beginRecord("NiTriShape");
+            writeAVObject(name, -1, 0, 0, 0);
+            write(data);
+            write(skin);
+        }
+
+        // Square grid of size x size vertices in the XY plane
+        void writeGridData(std::uint16_t size, float step)
+        {
+            beginRecord("NiTriShapeData");
+            const std::uint16_t numVertices = size * size;
+            write(numVertices);
+            writeBool(true);
+            for (std::uint16_t y = 0; y < size; ++y)
+                for (std::uint16_t x = 0; x < size; ++x)
+                    writeVec3(x * step, y * step, std::sin(x + y * 0.5f) * step);
+            writeBool(true);
+            for (std::uint16_t i = 0; i < numVertices; ++i)
+                writeVec3(0, 0, 1);
+            const float extent = (size - 1) * step;
+            writeVec3(extent / 2, extent / 2, 0); // Bounding sphere
+            write(extent);
+            writeBool(false); // Has vertex colors
+            write<std::uint16_t>(1); // Number of UV sets
+            writeBool(true);
+            for (std::uint16_t y = 0; y < size; ++y)
+                for (std::uint16_t x = 0; x < size; ++x)
+                {
+                    write(static_cast<float>(x) / size);
+                    write(static_cast<float>(y) / size);
+                }
+            const std::uint16_t cells = size - 1;
+            write(static_cast<std::uint16_t>(cells * cells * 2));
+            write(static_cast<std::uint32_t>(cells * cells * 6));
+            for (std::uint16_t y = 0; y < cells; ++y)
+                for (std::uint16_t x = 0; x < cells; ++x)
+                {
+                    const std::uint16_t corner = y * size + x;
+                    for (const std::uint16_t index : { corner, static_cast<std::uint16_t>(corner + 1),
+                             static_cast<std::uint16_t>(corner + size), static_cast<std::uint16_t>(corner + 1),
+                             static_cast<std::uint16_t>(corner + size + 1),
+                             static_cast<std::uint16_t>(corner + size) })
+                        write(index);
+                }
+            write<std::uint16_t>(0); // Match groups
+        }
+
+        std::string finish(std::int32_t root) const
+        {
+            std::string result = "NetImmerse File Format, Version 4.0.0.2\n";
+            const auto append = [&](auto value) {
+                char buffer[sizeof(value)];
+                std::memcpy(buffer, &value, sizeof(value));
+                result.append(buffer, sizeof(value));
+            };
+            append(static_cast<std::uint32_t>(Nif::NIFFile::VER_MW));
+            append(mRecordsCount);
+            result += mRecords;
+            append(std::uint32_t{ 1 });
+            append(root);
+            return result;
+        }
+
+    private:
+        std::string mRecords;
+        std::uint32_t mRecordsCount = 0;
+    };
+
+    // Similar to architecture pieces made of many small parts
+    std::string generateManyNodes()
+    {
+        constexpr std::int32_t count = 256;
+        NifWriter writer;
+        std::vector<std::int32_t> children;
+        for (std::int32_t i = 0; i < count; ++i)
+            children.push_back(1 + i * 3);
+        writer.writeNode("root", 0, 0, 0, children);
+        for (std::int32_t i = 0; i < count; ++i)
+        {
+            const std::string index = std::to_string(i);
+            writer.writeNode("node " + index, (i % 16) * 64.f, (i / 16) * 64.f, 0, { 2 + i * 3 });
+            writer.writeTriShape("shape " + index, 3 + i * 3, -1);
+            writer.writeGridData(2, 32);
+        }
+        return writer.finish(0);
+    }
+
+    // Similar to terrain-like meshes with tens of thousands of triangles
+    std::string generateLargeTriShape()
+    {
+        NifWriter writer;
+        writer.writeNode("root", 0, 0, 0, { 1 });
+        writer.writeTriShape("shape", 2, -1);
+        writer.writeGridData(128, 16);
+        return writer.finish(0);
+    }
+
+    // Similar to creature meshes with a chain of bones
+    std::string generateSkinned()
+    {
+        constexpr std::int32_t bones = 32;
+        constexpr std::uint16_t size = 32;
+        constexpr std::int32_t shape = bones + 1;
+        constexpr std::int32_t data = bones + 2;
+        constexpr std::int32_t skinInstance = bones + 3;
+        constexpr std::int32_t skinData = bones + 4;
+        NifWriter writer;
+        writer.writeNode("Bip01", 0, 0, 0, { 1, shape });
+        for (std::int32_t i = 1; i <= bones; ++i)
+        {
+            std::vector<std::int32_t> children;
+            if (i < bones)
+                children.push_back(i + 1);
+            writer.writeNode("Bip01 Bone " + std::to_string(i), 0, 16, 0, children);
+        }
+        writer.writeTriShape("skinned shape", data, skinInstance);
+        writer.writeGridData(size, 16);
+
+        writer.beginRecord("NiSkinInstance");
+        writer.write(skinData);
+        writer.write<std::int32_t>(0); // Root
+        std::vector<std::int32_t> boneRefs;
+        for (std::int32_t i = 1; i <= bones; ++i)
+            boneRefs.push_back(i);
+        writer.writeRefList(boneRefs);
+
+        writer.beginRecord("NiSkinData");
+        writer.writeIdentityRotation();
+        writer.writeVec3(0, 0, 0);
+        writer.write(1.f);
+        writer.write(static_cast<std::uint32_t>(bones));
+        writer.write<std::int32_t>(-1); // Partitions
+        // Each row of the grid follows its own bone
+        for (std::int32_t bone = 0; bone < bones; ++bone)
+        {
+            writer.writeIdentityRotation();
+            writer.writeVec3(0, -16.f * (bone + 1), 0);
+            writer.write(1.f);
+            writer.writeVec3(0, 0, 0); // Bounding sphere
+            writer.write(16.f * size);
+            writer.write(size);
+            for (std::uint16_t x = 0; x < size; ++x)
+            {
+                writer.write(static_cast<std::uint16_t>(bone * size + x));
+                writer.write(1.f);
+            }
+        }
+        return writer.finish(0);
+    }
+
+    // Similar to magic effects emitting a few hundred particles
+    std::string generateParticles()
+    {
+        constexpr std::uint16_t count = 256;
+        NifWriter writer;
+        writer.writeNode("root", 0, 0, 0, { 1 });
+
+        writer.beginRecord("NiAutoNormalParticles");
+        writer.writeAVObject("particles", 2, 0, 0, 0);
+        writer.write<std::int32_t>(3); // Data
+        writer.write<std::int32_t>(-1); // Skin
+
+        writer.beginRecord("NiParticleSystemController");
+        writer.write<std::int32_t>(-1); // Next controller
+        writer.write<std::uint16_t>(Nif::NiTimeController::Flag_Active);
+        writer.write(1.f); // Frequency
+        writer.write(0.f); // Phase
+        writer.write(0.f); // Start time
+        writer.write(10.f); // Stop time
+        writer.write<std::int32_t>(1); // Target
+        writer.write(64.f); // Speed
+        writer.write(16.f); // Speed variation
+        writer.write(0.f); // Declination
+        writer.write(0.5f); // Declination variation
+        writer.write(0.f); // Planar angle
+        writer.write(6.28f); // Planar angle variation
+        writer.writeVec3(0, 0, 1); // Initial normal
+        for (int i = 0; i < 4; ++i)
+            writer.write(1.f); // Initial color
+        writer.write(8.f); // Initial size
+        writer.write(0.f); // Emit start time
+        writer.write(10.f); // Emit stop time
+        writer.write<std::uint8_t>(0); // Reset particle system
+        writer.write(32.f); // Birth rate
+        writer.write(4.f); // Lifetime
+        writer.write(1.f); // Lifetime variation
+        writer.write<std::uint16_t>(0); // Emit flags
+        writer.writeVec3(32, 32, 32); // Emitter dimensions
+        writer.write<std::int32_t>(0); // Emitter
+        writer.write<std::uint16_t>(0); // Spawn generations
+        writer.write(0.f); // Percentage spawned
+        writer.write<std::uint16_t>(1); // Spawn multiplier
+        writer.write(0.f); // Spawn speed chaos
+        writer.write(0.f); // Spawn direction chaos
+        writer.write(count);
+        writer.write(count); // Valid particles
+        for (std::uint16_t i = 0; i < count; ++i)
+        {
+            writer.writeVec3(0, 0, 64); // Velocity
+            writer.writeVec3(0, 0, 1); // Rotation axis
+            writer.write(i * 4.f / count); // Age
+            writer.write(4.f); // Lifespan
+            writer.write(0.f); // Last update
+            writer.write<std::uint16_t>(0); // Spawn generation
+            writer.write(i); // Code
+        }
+        writer.write<std::int32_t>(-1); // Emitter modifier
+        writer.write<std::int32_t>(-1); // Modifier
+        writer.write<std::int32_t>(-1); // Collider
+        writer.write<std::uint8_t>(0); // Static target bound
+
+        writer.beginRecord("NiAutoNormalParticlesData");
+        writer.write(count);
+        writer.writeBool(true);
+        for (std::uint16_t i = 0; i < count; ++i)
+            writer.writeVec3((i % 16) * 4.f, (i / 16) * 4.f, i * 0.5f);
+        writer.writeBool(false); // Has normals
+        writer.writeVec3(32, 32, 64); // Bounding sphere
+        writer.write(128.f);
+        writer.writeBool(false); // Has vertex colors
+        writer.write<std::uint16_t>(0); // Number of UV sets
+        writer.writeBool(false);
+        writer.write(count); // Particles
+        writer.write(8.f); // Radius
+        writer.write(count); // Active particles
+        writer.writeBool(true);
+        for (std::uint16_t i = 0; i < count; ++i)
+            writer.write(1.f); // Size
+        return writer.finish(0);
+    }
+
+    std::string generateNif(NifKind kind)
+    {
+        switch (kind)
+        {
+            case NifKind::ManyNodes:
+                return generateManyNodes();
+            case NifKind::LargeTriShape:
+                return generateLargeTriShape();
+            case NifKind::Skinned:
+                return generateSkinned();
+            case NifKind::Particles:
+                return generateParticles();
+        }
+        return {};
+    }
+
+    std::unique_ptr<Nif::NIFFile> parseNif(const std::string& content)
+    {
+        auto file = std::make_unique<Nif::NIFFile>("generated.nif");
+        Nif::Reader reader(*file, nullptr);
+        reader.parse(std::make_unique<std::istringstream>(content));
+        return file;
+    }
+
+    struct Resources
+    {
+        VFS::Manager mVfs;
+        Resource::ImageManager mImageManager{ &mVfs, 0 };
+        Resource::BgsmFileManager mMaterialManager{ &mVfs, 0 };
+        Shader::ShaderManager mShaderManager;
+
+        osg::ref_ptr<osg::Node> convert(const Nif::NIFFile& file)
+        {
+            return NifOsg::Loader::load(file, &mImageManager, &mMaterialManager);
+        }
+    };
+
+    void parse(benchmark::State& state, NifKind kind)
+    {
+        const std::string content = generateNif(kind);
+        Nif::Reader::setReadIntoMemory(state.range(0) != 0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(parseNif(content));
+        Nif::Reader::setReadIntoMemory(false);
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * content.size()));
+    }
+
+    void convertToOsg(benchmark::State& state, NifKind kind)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = parseNif(generateNif(kind));
+        Resources resources;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(resources.convert(*file));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Uses the options SceneManager applies to the objects without a shared state manager to not measure sharing
+    void optimize(benchmark::State& state, NifKind kind)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = parseNif(generateNif(kind));
+        Resources resources;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            osg::ref_ptr<osg::Node> node = resources.convert(*file);
+            state.ResumeTiming();
+            SceneUtil::Optimizer optimizer;
+            optimizer.optimize(node,
+                SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                    | SceneUtil::Optimizer::MERGE_GEOMETRY);
+            state.PauseTiming();
+            node = nullptr;
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void applyShaderVisitor(benchmark::State& state, NifKind kind)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = parseNif(generateNif(kind));
+        Resources resources;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            osg::ref_ptr<osg::Node> node = resources.convert(*file);
+            state.ResumeTiming();
+            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(
+                new Shader::ShaderVisitor(resources.mShaderManager, resources.mImageManager, "objects"));
+            node->accept(*shaderVisitor);
+            state.PauseTiming();
+            node = nullptr;
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void createBulletShape(benchmark::State& state, NifKind kind)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = parseNif(generateNif(kind));
+        for (auto _ : state)
+        {
+            NifBullet::BulletNifLoader loader;
+            benchmark::DoNotOptimize(loader.load(*file));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK_CAPTURE(parse, manyNodes, NifKind::ManyNodes)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(parse, largeTriShape, NifKind::LargeTriShape)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(parse, skinned, NifKind::Skinned)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(parse, particles, NifKind::Particles)->Arg(0)->Arg(1);
+
+BENCHMARK_CAPTURE(convertToOsg, manyNodes, NifKind::ManyNodes);
+BENCHMARK_CAPTURE(convertToOsg, largeTriShape, NifKind::LargeTriShape);
+BENCHMARK_CAPTURE(convertToOsg, skinned, NifKind::Skinned);
+BENCHMARK_CAPTURE(convertToOsg, particles, NifKind::Particles);
+
+BENCHMARK_CAPTURE(optimize, manyNodes, NifKind::ManyNodes);
+BENCHMARK_CAPTURE(optimize, largeTriShape, NifKind::LargeTriShape);
+BENCHMARK_CAPTURE(optimize, skinned, NifKind::Skinned);
+BENCHMARK_CAPTURE(optimize, particles, NifKind::Particles);
+
+BENCHMARK_CAPTURE(applyShaderVisitor, manyNodes, NifKind::ManyNodes);
+BENCHMARK_CAPTURE(applyShaderVisitor, largeTriShape, NifKind::LargeTriShape);
+BENCHMARK_CAPTURE(applyShaderVisitor, skinned, NifKind::Skinned);
+BENCHMARK_CAPTURE(applyShaderVisitor, particles, NifKind::Particles);
+
+BENCHMARK_CAPTURE(createBulletShape, manyNodes, NifKind::ManyNodes);
+BENCHMARK_CAPTURE(createBulletShape, largeTriShape, NifKind::LargeTriShape);
+BENCHMARK_CAPTURE(createBulletShape, skinned, NifKind::Skinned);
+BENCHMARK_CAPTURE(createBulletShape, particles, NifKind::Particles);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,387 @@
+#include <benchmark/benchmark.h>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <LinearMath/btThreads.h>
+
+#include <osg/Math>
+
+#include <components/bullethelpers/heightfield.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/workstealingrange.hpp>
+
+#include "apps/openmw/mwbase/environment.hpp"
+#include "apps/openmw/mwmechanics/spelllist.hpp"
+#include "apps/openmw/mwphysics/actor.hpp"
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/movementsolver.hpp"
+#include "apps/openmw/mwphysics/physicssystem.hpp"
+#include "apps/openmw/mwphysics/projectile.hpp"
+#include "apps/openmw/mwworld/refdata.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// The benchmark links only the sources of the movement solver, the functions below belong to the sources which depend
+// on the rest of the game. Neither traceDown nor projectiles are used here.
+namespace MWBase
+{
+    Environment* Environment::sThis = nullptr;
+}
+
+namespace MWMechanics
+{
+    SpellList::SpellList(const ESM::RefId& id, int type)
+        : mId(id)
+        , mType(type)
+    {
+    }
+}
+
+namespace MWWorld
+{
+    const ESM::Position& RefData::getPosition() const
+    {
+        return mPosition;
+    }
+}
+
+namespace MWPhysics
+{
+    osg::Vec3f Actor::getCollisionObjectPosition() const
+    {
+        return Misc::Convert::toOsg(mCollisionObject->getWorldTransform().getOrigin());
+    }
+
+    void Actor::setOnGround(bool grounded)
+    {
+        mOnGround = grounded;
+    }
+
+    void Actor::setOnSlope(bool slope)
+    {
+        mOnSlope = slope;
+    }
+
+    void Projectile::hit(const btCollisionObject* /*target*/, btVector3 /*pos*/, btVector3 /*normal*/) {}
+
+    bool Projectile::isValidTarget(const btCollisionObject* /*target*/) const
+    {
+        return false;
+    }
+}
+
+namespace
+{
+    using namespace MWPhysics;
+
+    constexpr int cellSize = 8192;
+    constexpr int heightFieldVerts = 65;
+    constexpr float physicsDt = 1.f / 60.f;
+    const osg::Vec3f actorHalfExtents(29, 29, 64);
+
+    float getTerrainHeight(float x, float y)
+    {
+        return 256 * std::sin(x / 1024) * std::cos(y / 1024);
+    }
+
+    // Similar to an exterior cell with a few hundred static objects
+    class CollisionWorld
+    {
+    public:
+        explicit CollisionWorld(std::size_t staticObjects)
+            : mDispatcher(&mCollisionConfiguration)
+            , mCollisionWorld(&mDispatcher, &mBroadphase, &mCollisionConfiguration)
+        {
+            mCollisionWorld.setForceUpdateAllAabbs(false);
+
+            const float step = static_cast<float>(cellSize) / (heightFieldVerts - 1);
+            for (int y = 0; y < heightFieldVerts; ++y)
+                for (int x = 0; x < heightFieldVerts; ++x)
+                    mHeights.push_back(getTerrainHeight(x * step, y * step));
+            const auto [minHeight, maxHeight] = std::minmax_element(mHeights.begin(), mHeights.end());
+            auto heightField = std::make_unique<btHeightfieldTerrainShape>(heightFieldVerts, heightFieldVerts,
+                mHeights.data(), 1, *minHeight, *maxHeight, 2, PHY_FLOAT, false);
+            heightField->setUseDiamondSubdivision(true);
+            heightField->setLocalScaling(btVector3(step, step, 1));
+#if BT_BULLET_VERSION >= 289
+            heightField->buildAccelerator();
+#endif
+            addObject(std::move(heightField),
+                btTransform(btQuaternion::getIdentity(),
+                    BulletHelpers::getHeightfieldShift(0, 0, cellSize, *minHeight, *maxHeight)),
+                CollisionType_HeightMap, CollisionType_Actor | CollisionType_Projectile);
+
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> position(0, cellSize);
+            std::uniform_real_distribution<float> size(32, 256);
+            std::uniform_real_distribution<float> angle(0, osg::PIf * 2);
+            for (std::size_t i = 0; i < staticObjects; ++i)
+            {
+                const float x = position(random);
+                const float y = position(random);
+                const btVector3 halfExtents(size(random), size(random), size(random) / 2);
+                addObject(makeBox(halfExtents),
+                    btTransform(btQuaternion(btVector3(0, 0, 1), angle(random)),
+                        btVector3(x, y, getTerrainHeight(x, y) + halfExtents.z() / 2)),
+                    CollisionType_World, CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
+            }
+        }
+
+        ~CollisionWorld()
+        {
+            for (const std::unique_ptr<btCollisionObject>& object : mObjects)
+                mCollisionWorld.removeCollisionObject(object.get());
+        }
+
+        btCollisionWorld& get() { return mCollisionWorld; }
+
+        unsigned getMaxThreads()
+        {
+            return std::min<unsigned>(mBroadphase.m_rayTestStacks.size(), BT_MAX_THREAD_COUNT - 1);
+        }
+
+        void addActor(btCollisionObject& object)
+        {
+            mCollisionWorld.addCollisionObject(&object, CollisionType_Actor,
+                CollisionType_World | CollisionType_HeightMap | CollisionType_Actor | CollisionType_Projectile
+                    | CollisionType_Door);
+        }
+
+    private:
+        btDefaultCollisionConfiguration mCollisionConfiguration;
+        btCollisionDispatcher mDispatcher;
+        btDbvtBroadphase mBroadphase;
+        btCollisionWorld mCollisionWorld;
+        std::vector<float> mHeights;
+        std::vector<std::unique_ptr<btTriangleMesh>> mMeshes;
+        std::vector<std::unique_ptr<btCollisionShape>> mShapes;
+        std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+
+        // Static objects are usually triangle meshes loaded from NIF files
+        std::unique_ptr<btCollisionShape> makeBox(const btVector3& halfExtents)
+        {
+            static constexpr int faces[6][4] = {
+                { 0, 2, 3, 1 },
+                { 4, 5, 7, 6 },
+                { 0, 1, 5, 4 },
+                { 2, 6, 7, 3 },
+                { 0, 4, 6, 2 },
+                { 1, 3, 7, 5 },
+            };
+            const auto corner = [&](int index) {
+                return btVector3((index & 1) ? halfExtents.x() : -halfExtents.x(),
+                    (index & 2) ? halfExtents.y() : -halfExtents.y(), (index & 4) ? halfExtents.z() : -halfExtents.z());
+            };
+            auto mesh = std::make_unique<btTriangleMesh>();
+            for (const auto& face : faces)
+            {
+                mesh->addTriangle(corner(face[0]), corner(face[1]), corner(face[2]));
+                mesh->addTriangle(corner(face[0]), corner(face[2]), corner(face[3]));
+            }
+            auto shape = std::make_unique<btBvhTriangleMeshShape>(mesh.get(), true);
+            mMeshes.push_back(std::move(mesh));
+            return shape;
+        }
+
+        void addObject(std::unique_ptr<btCollisionShape>&& shape, const btTransform& transform, int group, int mask)
+        {
+            auto object = std::make_unique<btCollisionObject>();
+            object->setCollisionShape(shape.get());
+            object->setWorldTransform(transform);
+            mCollisionWorld.addCollisionObject(object.get(), group, mask);
+            mShapes.push_back(std::move(shape));
+            mObjects.push_back(std::move(object));
+        }
+    };
+
+    struct SimulatedActor
+    {
+        btBoxShape mShape{ Misc::Convert::toBullet(actorHalfExtents) };
+        btCollisionObject mCollisionObject;
+        ActorFrameData mFrameData;
+        float mTurnRate;
+
+        SimulatedActor(const osg::Vec3f& position, float heading, float turnRate)
+            : mFrameData(&mCollisionObject, position, osg::Vec3f(0, 150, 0), actorHalfExtents.z(), -1e6f)
+            , mTurnRate(turnRate)
+        {
+            mCollisionObject.setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
+            mCollisionObject.setActivationState(DISABLE_DEACTIVATION);
+            mCollisionObject.setCollisionShape(&mShape);
+            mFrameData.mRotation.y() = heading;
+            updateCollisionObject();
+        }
+
+        void updateCollisionObject()
+        {
+            btTransform& transform = mCollisionObject.getWorldTransform();
+            transform.setOrigin(Misc::Convert::toBullet(mFrameData.mPosition + osg::Vec3f(0, 0, actorHalfExtents.z())));
+            mCollisionObject.setWorldTransform(transform);
+        }
+    };
+
+    // Runs the same tasks as PhysicsTaskScheduler does for the actors: unstuck, move and update position. Each task
+    // is split into chunks shared by the threads, the next one starts when all the chunks are done.
+    class Simulation
+    {
+    public:
+        Simulation(std::size_t actors, std::size_t threads)
+            : mWorld(256)
+            , mRange(threads)
+            , mStart(static_cast<std::ptrdiff_t>(threads), Completion{ this, &Simulation::startUnstuck })
+            , mUnstuckDone(static_cast<std::ptrdiff_t>(threads), Completion{ this, &Simulation::startMove })
+            , mMoveDone(static_cast<std::ptrdiff_t>(threads), Completion{ this, &Simulation::updatePositions })
+        {
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> position(cellSize / 8, cellSize * 7 / 8);
+            std::uniform_real_distribution<float> heading(0, osg::PIf * 2);
+            std::uniform_real_distribution<float> turnRate(-0.02f, 0.02f);
+            mActors.reserve(actors);
+            for (std::size_t i = 0; i < actors; ++i)
+            {
+                const float x = position(random);
+                const float y = position(random);
+                SimulatedActor& actor = *mActors.emplace_back(std::make_unique<SimulatedActor>(
+                    osg::Vec3f(x, y, getTerrainHeight(x, y) + 8), heading(random), turnRate(random)));
+                mWorld.addActor(actor.mCollisionObject);
+            }
+            for (std::size_t i = 1; i < threads; ++i)
+                mThreads.emplace_back([this, i] {
+                    while (true)
+                    {
+                        mStart.arrive_and_wait();
+                        if (mStop.load(std::memory_order_acquire))
+                            return;
+                        run(i);
+                    }
+                });
+        }
+
+        ~Simulation()
+        {
+            mStop.store(true, std::memory_order_release);
+            mStart.arrive_and_wait();
+            for (std::thread& thread : mThreads)
+                thread.join();
+            for (const std::unique_ptr<SimulatedActor>& actor : mActors)
+                mWorld.get().removeCollisionObject(&actor->mCollisionObject);
+        }
+
+        bool isSupported() { return mThreads.size() < mWorld.getMaxThreads(); }
+
+        void step()
+        {
+            mStart.arrive_and_wait();
+            run(0);
+        }
+
+    private:
+        struct Completion
+        {
+            Simulation* mSimulation;
+            void (Simulation::*mFunction)();
+
+            void operator()() noexcept { (mSimulation->*mFunction)(); }
+        };
+
+        CollisionWorld mWorld;
+        std::vector<std::unique_ptr<SimulatedActor>> mActors;
+        Misc::WorkStealingRange mRange;
+        std::barrier<Completion> mStart;
+        std::barrier<Completion> mUnstuckDone;
+        std::barrier<Completion> mMoveDone;
+        std::atomic_bool mStop{ false };
+        std::vector<std::thread> mThreads;
+
+        void resetRange() { mRange.reset(mActors.size(), std::max<std::size_t>(mActors.size() / 64, 1)); }
+
+        void startUnstuck() { resetRange(); }
+
+        void startMove() { resetRange(); }
+
+        void run(std::size_t worker)
+        {
+            while (const auto chunk = mRange.take(worker))
+                for (std::size_t i = chunk->mBegin; i < chunk->mEnd; ++i)
+                    MovementSolver::unstuck(mActors[i]->mFrameData, &mWorld.get());
+            mUnstuckDone.arrive_and_wait();
+            const WorldFrameData worldData(false, osg::Vec3f());
+            while (const auto chunk = mRange.take(worker))
+                for (std::size_t i = chunk->mBegin; i < chunk->mEnd; ++i)
+                    MovementSolver::move(mActors[i]->mFrameData, physicsDt, &mWorld.get(), worldData);
+            mMoveDone.arrive_and_wait();
+        }
+
+        // Bullet doesn't allow to modify the collision world concurrently
+        void updatePositions()
+        {
+            for (const std::unique_ptr<SimulatedActor>& actor : mActors)
+            {
+                actor->mFrameData.mRotation.y() += actor->mTurnRate;
+                actor->updateCollisionObject();
+                mWorld.get().updateSingleAabb(&actor->mCollisionObject);
+            }
+        }
+    };
+
+    double measureSecondsPerStep(Simulation& simulation, int steps)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; ++i)
+            simulation.step();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / steps;
+    }
+
+    // Single threaded simulation of the same world is the baseline for the scaling efficiency
+    double getSingleThreadSecondsPerStep(std::size_t actors)
+    {
+        static std::map<std::size_t, double> cache;
+        const auto it = cache.find(actors);
+        if (it != cache.end())
+            return it->second;
+        Simulation simulation(actors, 1);
+        measureSecondsPerStep(simulation, 16);
+        return cache.emplace(actors, measureSecondsPerStep(simulation, 128)).first->second;
+    }
+
+    void moveActors(benchmark::State& state)
+    {
+        const std::size_t actors = static_cast<std::size_t>(state.range(0));
+        const std::size_t threads = static_cast<std::size_t>(state.range(1));
+        Simulation simulation(actors, threads);
+        if (!simulation.isSupported())
+            return state.SkipWithError("Bullet doesn't support that many threads");
+        const double baseline = getSingleThreadSecondsPerStep(actors);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+            simulation.step();
+        const double secondsPerStep
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / state.iterations();
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * actors));
+        state.counters["steps"]
+            = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+        state.counters["efficiency"] = baseline / (secondsPerStep * threads);
+    }
+}
+
+BENCHMARK(moveActors)->ArgsProduct({ { 16, 128, 512 }, { 1, 2, 4, 8 } })->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <boost/program_options.hpp>
@@ -29,6 +35,7 @@ struct Arguments
 
     bool longformat;
     bool fullpath;
+    unsigned threads;
 };
 
 bool parseOptions(int argc, char** argv, Arguments& info)
@@ -42,7 +49,7 @@ Usages:
   bsatool extract [-f] archivefile [file_to_extract] [output_directory]
       Extract a file from the input archive.
 
-  bsatool extractall archivefile [output_directory]
+  bsatool extractall [-j threads] archivefile [output_directory]
       Extract all files from the input archive.
 
   bsatool add [-a] archivefile file_to_add
@@ -57,6 +64,8 @@ Allowed options)");
     addOption("version,v", "print version information and quit.");
     addOption("long,l", "Include extra information in archive listing.");
     addOption("full-path,f", "Create directory hierarchy on file extraction (always true for extractall).");
+    addOption("threads,j", bpo::value<unsigned>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+        "Number of threads to extract files with in extractall mode.");
 
     // input-file is hidden and used as a positional argument
     bpo::options_description hidden("Hidden Options");
@@ -154,6 +163,7 @@ Allowed options)");
 
     info.longformat = variables.count("long") != 0;
     info.fullpath = variables.count("full-path") != 0;
+    info.threads = std::max(variables["threads"].as<unsigned>(), 1u);
 
     return true;
 }
@@ -243,7 +253,12 @@ int extract(std::unique_ptr<File>& bsa, Arguments& info)
 template <typename File>
 int extractAll(std::unique_ptr<File>& bsa, Arguments& info)
 {
-    for (const auto& file : bsa->getList())
+    const auto& files = bsa->getList();
+    std::vector<std::filesystem::path> targets;
+    targets.reserve(files.size());
+
+    // Create the directory hierarchy before extracting so the threads only write files
+    for (const auto& file : files)
     {
         std::string extractPath(file.name());
         Misc::StringUtils::replaceAll(extractPath, "\\", "/");
@@ -252,7 +267,6 @@ int extractAll(std::unique_ptr<File>& bsa, Arguments& info)
         auto target = info.outdir;
         target /= Misc::StringUtils::stringToU8String(extractPath);
 
-        // Create the directory hierarchy
         std::filesystem::create_directories(target.parent_path());
 
         std::filesystem::file_status s = std::filesystem::status(target.parent_path());
@@ -262,15 +276,73 @@ int extractAll(std::unique_ptr<File>& bsa, Arguments& info)
             return 3;
         }
 
-        // Get a stream for the file to extract
-        Files::IStreamPtr data = bsa->getFile(&file);
-        std::ofstream out(target, std::ios::binary);
+        targets.push_back(std::move(target));
+    }
+
+    std::atomic_size_t next = 0;
+    std::atomic_bool failed = false;
+    std::mutex outputMutex;
+
+    const auto extractFiles = [&] {
+        for (std::size_t i = next++; i < files.size() && !failed; i = next++)
+        {
+            // Get a stream for the file to extract
+            Files::IStreamPtr data = bsa->getFile(&files[i]);
+            std::ofstream out(targets[i], std::ios::binary);
+
+            {
+                const std::lock_guard lock(outputMutex);
+                std::cout << "Extracting " << Files::pathToUnicodeString(targets[i]) << std::endl;
+            }
+
+            // Write the file to disk
+            out << data->rdbuf();
+            out.close();
+        }
+    };
+
+    const auto extractFilesOrFail = [&] {
+        try
+        {
+            extractFiles();
+        }
+        catch (...)
+        {
+            failed = true;
+            throw;
+        }
+    };
+
+    const std::size_t threads = std::min<std::size_t>(info.threads, files.size());
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 1; i < threads; ++i)
+        workers.push_back(std::async(std::launch::async, extractFilesOrFail));
 
-        // Write the file to disk
-        std::cout << "Extracting " << Files::pathToUnicodeString(target) << std::endl;
-        out << data->rdbuf();
-        out.close();
+    std::exception_ptr error;
+    try
+    {
+        extractFilesOrFail();
     }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    for (auto& worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            if (error == nullptr)
+                error = std::current_exception();
+        }
+    }
+
+    if (error != nullptr)
+        std::rethrow_exception(error);
 
     return 0;
 }
@@ -294,7 +366,9 @@ int call(Arguments& info)
         return 0;
     }
 
-    bsa->open(info.filename);
+    // Archive files are read from multiple threads by extractall, so they share the mapping instead of each
+    // opening the archive
+    bsa->open(info.filename, info.mode == "extractall");
 
     if (info.mode == "list")
         return list(bsa, info);
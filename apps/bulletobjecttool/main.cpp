@@ -14,12 +14,14 @@
 #include <components/platform/platform.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapecache.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/foreachbulletobject.hpp>
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/niffilemanager.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/settings/settings.hpp>
+#include <components/settings/values.hpp>
 #include <components/to_utf8/to_utf8.hpp>
 #include <components/version/version.hpp>
 #include <components/vfs/manager.hpp>
@@ -27,6 +29,7 @@
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
@@ -39,6 +42,7 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -90,6 +94,13 @@ namespace
         addOption("fallback", bpo::value<FallbackMap>()->default_value(FallbackMap(), "")->multitoken()->composing(),
             "fallback values");
 
+        addOption("write-shape-cache", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "write the collision shapes of all objects to the shape cache of the user data directory");
+
+        addOption("threads",
+            bpo::value<std::size_t>()->default_value(std::max<std::size_t>(std::thread::hardware_concurrency() - 1, 1)),
+            "number of threads to load the collision shapes with");
+
         Files::ConfigurationManager::addCommonOptions(result);
 
         return result;
@@ -155,10 +166,10 @@ namespace
 
         VFS::Manager vfs;
 
-        VFS::registerArchives(&vfs, fileCollections, archives, true);
-
         Settings::Manager::load(config);
 
+        VFS::registerArchives(&vfs, fileCollections, archives, true, Settings::general().mMemoryMappedArchives);
+
         ESM::ReadersCache readers;
         EsmLoader::Query query;
         query.mLoadActivators = true;
@@ -177,9 +188,13 @@ namespace
         Resource::BgsmFileManager bgsmFileManager(&vfs, expiryDelay);
         Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
         Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
+        if (variables["write-shape-cache"].as<bool>())
+            bulletShapeManager.setShapeCache(new Resource::BulletShapeCache(config.getUserDataPath() / "shapecache"));
+
+        const std::size_t threads = variables["threads"].as<std::size_t>();
 
-        Resource::forEachBulletObject(
-            readers, vfs, bulletShapeManager, esmData, [](const ESM::Cell& cell, const Resource::BulletObject& object) {
+        Resource::forEachBulletObject(readers, vfs, bulletShapeManager, esmData, threads,
+            [](const ESM::Cell& cell, const Resource::BulletObject& object) {
                 Log(Debug::Verbose) << "Found bullet object in " << (cell.isExterior() ? "exterior" : "interior")
                                     << " cell \"" << cell.getDescription() << "\":"
                                     << " fileName=\"" << object.mShape->mFileName << '"'
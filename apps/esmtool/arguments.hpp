@@ -1,6 +1,7 @@
 #ifndef OPENMW_ESMTOOL_ARGUMENTS_H
 #define OPENMW_ESMTOOL_ARGUMENTS_H
 
+#include <cstddef>
 #include <filesystem>
 #include <optional>
 #include <vector>
@@ -12,6 +13,7 @@ namespace EsmTool
     struct Arguments
     {
         std::optional<ESM::Format> mRawFormat;
+        std::size_t mThreads = 1;
         bool quiet_given = false;
         bool loadcells_given = false;
         bool plain_given = false;
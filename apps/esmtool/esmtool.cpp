@@ -1,11 +1,15 @@
+#include <algorithm>
 #include <cmath>
 #include <deque>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <optional>
+#include <sstream>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -73,6 +77,10 @@ Allowed options)");
             "Only affects dump mode.");
         addOption("quiet,q", "Suppress all record information. Useful for speed tests.");
         addOption("loadcells,C", "Browse through contents of all cells.");
+        addOption("threads,j",
+            bpo::value<std::size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+            "Number of threads to format records with.  Records are printed in the file order.  Only affects dump "
+            "mode.");
 
         addOption("encoding,e", bpo::value<std::string>(&(info.encoding))->default_value("win1252"),
             "Character encoding used in ESMTool:\n"
@@ -169,6 +177,7 @@ Allowed options)");
         info.quiet_given = variables.count("quiet") != 0;
         info.loadcells_given = variables.count("loadcells") != 0;
         info.plain_given = variables.count("plain") != 0;
+        info.mThreads = std::max<std::size_t>(variables["threads"].as<std::size_t>(), 1);
 
         // Font encoding settings
         info.encoding = variables["encoding"].as<std::string>();
@@ -182,6 +191,79 @@ Allowed options)");
         return true;
     }
 
+    void printRecord(RecordBase& record, std::ostream& stream)
+    {
+        stream << "\nRecord: " << record.getType().toStringView() << " " << record.getId() << "\n"
+               << "Record flags: " << recordFlags(record.getFlags()) << '\n';
+        record.print(stream);
+    }
+
+    /// Prints records to the standard output in the order they are added, formatting batches of them on worker
+    /// threads when more than one thread is used.
+    class RecordPrinter
+    {
+    public:
+        explicit RecordPrinter(std::size_t threads)
+            : mThreads(threads)
+        {
+        }
+
+        void print(std::unique_ptr<RecordBase>&& record)
+        {
+            if (mThreads <= 1)
+                return printRecord(*record, std::cout);
+
+            mBatch.push_back(std::move(record));
+            if (mBatch.size() < sBatchSize)
+                return;
+
+            submit();
+
+            if (mPending.size() > mThreads)
+                writeFront();
+        }
+
+        void print(RecordBase& record)
+        ///< Print a record that is still used by the caller after the records added before it.
+        {
+            flush();
+            printRecord(record, std::cout);
+        }
+
+        void flush()
+        ///< Write all added records, must be called before anything else is printed.
+        {
+            if (!mBatch.empty())
+                submit();
+            while (!mPending.empty())
+                writeFront();
+        }
+
+    private:
+        static constexpr std::size_t sBatchSize = 256;
+
+        const std::size_t mThreads;
+        std::vector<std::unique_ptr<RecordBase>> mBatch;
+        std::deque<std::future<std::string>> mPending;
+
+        void submit()
+        {
+            mPending.push_back(std::async(std::launch::async, [batch = std::move(mBatch)] {
+                std::ostringstream stream;
+                for (const std::unique_ptr<RecordBase>& record : batch)
+                    printRecord(*record, stream);
+                return std::move(stream).str();
+            }));
+            mBatch.clear();
+        }
+
+        void writeFront()
+        {
+            std::cout << mPending.front().get();
+            mPending.pop_front();
+        }
+    };
+
     void loadCell(const Arguments& info, ESM::Cell& cell, ESM::ESMReader& esm, ESMData* data);
 
     int load(const Arguments& info, ESMData* data);
@@ -255,32 +337,33 @@ namespace
                       << ")\n";
             if (ref.mScale != 1.f)
                 std::cout << "    Scale: " << ref.mScale << '\n';
-            if (!ref.mOwner.empty())
-                std::cout << "    Owner: " << ref.mOwner << '\n';
-            if (!ref.mGlobalVariable.empty())
-                std::cout << "    Global: " << ref.mGlobalVariable << '\n';
-            if (!ref.mFaction.empty())
-                std::cout << "    Faction: " << ref.mFaction << '\n';
-            if (!ref.mFaction.empty() || ref.mFactionRank != -2)
-                std::cout << "    Faction rank: " << ref.mFactionRank << '\n';
+            if (!ref.getOwner().empty())
+                std::cout << "    Owner: " << ref.getOwner() << '\n';
+            if (!ref.getGlobalVariable().empty())
+                std::cout << "    Global: " << ref.getGlobalVariable() << '\n';
+            if (!ref.getFaction().empty())
+                std::cout << "    Faction: " << ref.getFaction() << '\n';
+            if (!ref.getFaction().empty() || ref.getFactionRank() != -2)
+                std::cout << "    Faction rank: " << ref.getFactionRank() << '\n';
             std::cout << "    Enchantment charge: " << ref.mEnchantmentCharge << '\n';
             std::cout << "    Uses/health: " << ref.mChargeInt << '\n';
             std::cout << "    Count: " << ref.mCount << '\n';
             std::cout << "    Blocked: " << static_cast<int>(ref.mReferenceBlocked) << '\n';
             std::cout << "    Deleted: " << deleted << '\n';
-            if (!ref.mKey.empty())
-                std::cout << "    Key: " << ref.mKey << '\n';
+            if (!ref.getKey().empty())
+                std::cout << "    Key: " << ref.getKey() << '\n';
             std::cout << "    Lock level: " << ref.mLockLevel << '\n';
-            if (!ref.mTrap.empty())
-                std::cout << "    Trap: " << ref.mTrap << '\n';
-            if (!ref.mSoul.empty())
-                std::cout << "    Soul: " << ref.mSoul << '\n';
-            if (ref.mTeleport)
+            if (!ref.getTrap().empty())
+                std::cout << "    Trap: " << ref.getTrap() << '\n';
+            if (!ref.getSoul().empty())
+                std::cout << "    Soul: " << ref.getSoul() << '\n';
+            if (ref.getTeleport())
             {
-                std::cout << "    Destination position: (" << ref.mDoorDest.pos[0] << ", " << ref.mDoorDest.pos[1]
-                          << ", " << ref.mDoorDest.pos[2] << ")\n";
-                if (!ref.mDestCell.empty())
-                    std::cout << "    Destination cell: " << ref.mDestCell << '\n';
+                const ESM::Position& doorDest = ref.getDoorDest();
+                std::cout << "    Destination position: (" << doorDest.pos[0] << ", " << doorDest.pos[1] << ", "
+                          << doorDest.pos[2] << ")\n";
+                if (!ref.getDestCell().empty())
+                    std::cout << "    Destination cell: " << ref.getDestCell() << '\n';
             }
             std::cout << "    Moved: " << std::boolalpha << moved << std::noboolalpha << '\n';
             if (moved)
@@ -325,6 +408,7 @@ namespace
         esm.setEncoder(&encoder);
 
         std::unordered_set<uint32_t> skipped;
+        RecordPrinter printer(info.mode == "dump" ? info.mThreads : 1);
 
         try
         {
@@ -361,6 +445,8 @@ namespace
                 auto record = EsmTool::RecordBase::create(n);
                 if (record == nullptr)
                 {
+                    printer.flush();
+
                     if (!quiet && skipped.count(n.toInt()) == 0)
                     {
                         std::cout << "Skipping " << n.toStringView() << " records.\n";
@@ -388,14 +474,18 @@ namespace
                 if (!info.name.empty() && !Misc::StringUtils::ciEqual(info.name, record->getId()))
                     interested = false;
 
+                const bool printCell = record->getType().toInt() == ESM::REC_CELL && loadCells && interested;
+
                 if (!quiet && interested)
                 {
-                    std::cout << "\nRecord: " << n.toStringView() << " " << record->getId() << "\n"
-                              << "Record flags: " << recordFlags(record->getFlags()) << '\n';
-                    record->print();
+                    // Cell references are printed right after their cell and saved records are kept
+                    if (printCell || save)
+                        printer.print(*record);
+                    else
+                        printer.print(std::move(record));
                 }
 
-                if (record->getType().toInt() == ESM::REC_CELL && loadCells && interested)
+                if (printCell)
                 {
                     loadCell(info, record->cast<ESM::Cell>()->get(), esm, data);
                 }
@@ -407,9 +497,12 @@ namespace
                     ++data->mRecordStats[n.toInt()];
                 }
             }
+
+            printer.flush();
         }
         catch (const std::exception& e)
         {
+            printer.flush();
             std::cout << "\nERROR:\n\n  " << e.what() << std::endl;
             if (data != nullptr)
                 data->mRecords.clear();
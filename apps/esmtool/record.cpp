@@ -12,49 +12,49 @@
 namespace
 {
 
-    void printAIPackage(const ESM::AIPackage& p)
+    void printAIPackage(std::ostream& stream, const ESM::AIPackage& p)
     {
-        std::cout << "  AI Type: " << aiTypeLabel(p.mType) << " (" << Misc::StringUtils::format("0x%08X", p.mType)
-                  << ")" << std::endl;
+        stream << "  AI Type: " << aiTypeLabel(p.mType) << " (" << Misc::StringUtils::format("0x%08X", p.mType)
+               << ")\n";
         if (p.mType == ESM::AI_Wander)
         {
-            std::cout << "    Distance: " << p.mWander.mDistance << std::endl;
-            std::cout << "    Duration: " << p.mWander.mDuration << std::endl;
-            std::cout << "    Time of Day: " << (int)p.mWander.mTimeOfDay << std::endl;
+            stream << "    Distance: " << p.mWander.mDistance << '\n';
+            stream << "    Duration: " << p.mWander.mDuration << '\n';
+            stream << "    Time of Day: " << (int)p.mWander.mTimeOfDay << '\n';
             if (p.mWander.mShouldRepeat != 1)
-                std::cout << "    Should repeat: " << static_cast<bool>(p.mWander.mShouldRepeat != 0) << std::endl;
+                stream << "    Should repeat: " << static_cast<bool>(p.mWander.mShouldRepeat != 0) << '\n';
 
-            std::cout << "    Idle: ";
+            stream << "    Idle: ";
             for (int i = 0; i != 8; i++)
-                std::cout << (int)p.mWander.mIdle[i] << " ";
-            std::cout << std::endl;
+                stream << (int)p.mWander.mIdle[i] << " ";
+            stream << '\n';
         }
         else if (p.mType == ESM::AI_Travel)
         {
-            std::cout << "    Travel Coordinates: (" << p.mTravel.mX << "," << p.mTravel.mY << "," << p.mTravel.mZ
-                      << ")" << std::endl;
-            std::cout << "    Should repeat: " << static_cast<bool>(p.mTravel.mShouldRepeat != 0) << std::endl;
+            stream << "    Travel Coordinates: (" << p.mTravel.mX << "," << p.mTravel.mY << "," << p.mTravel.mZ
+                   << ")\n";
+            stream << "    Should repeat: " << static_cast<bool>(p.mTravel.mShouldRepeat != 0) << '\n';
         }
         else if (p.mType == ESM::AI_Follow || p.mType == ESM::AI_Escort)
         {
-            std::cout << "    Follow Coordinates: (" << p.mTarget.mX << "," << p.mTarget.mY << "," << p.mTarget.mZ
-                      << ")" << std::endl;
-            std::cout << "    Duration: " << p.mTarget.mDuration << std::endl;
-            std::cout << "    Target ID: " << p.mTarget.mId.toString() << std::endl;
-            std::cout << "    Should repeat: " << static_cast<bool>(p.mTarget.mShouldRepeat != 0) << std::endl;
+            stream << "    Follow Coordinates: (" << p.mTarget.mX << "," << p.mTarget.mY << "," << p.mTarget.mZ
+                   << ")\n";
+            stream << "    Duration: " << p.mTarget.mDuration << '\n';
+            stream << "    Target ID: " << p.mTarget.mId.toString() << '\n';
+            stream << "    Should repeat: " << static_cast<bool>(p.mTarget.mShouldRepeat != 0) << '\n';
         }
         else if (p.mType == ESM::AI_Activate)
         {
-            std::cout << "    Name: " << p.mActivate.mName.toString() << std::endl;
-            std::cout << "    Should repeat: " << static_cast<bool>(p.mActivate.mShouldRepeat != 0) << std::endl;
+            stream << "    Name: " << p.mActivate.mName.toString() << '\n';
+            stream << "    Should repeat: " << static_cast<bool>(p.mActivate.mShouldRepeat != 0) << '\n';
         }
         else
         {
-            std::cout << "    BadPackage: " << Misc::StringUtils::format("0x%08X", p.mType) << std::endl;
+            stream << "    BadPackage: " << Misc::StringUtils::format("0x%08X", p.mType) << '\n';
         }
 
         if (!p.mCellName.empty())
-            std::cout << "    Cell Name: " << p.mCellName << std::endl;
+            stream << "    Cell Name: " << p.mCellName << '\n';
     }
 
     std::string ruleString(const ESM::DialogueCondition& ss)
@@ -147,42 +147,42 @@ namespace
         return result;
     }
 
-    void printEffectList(const ESM::EffectList& effects)
+    void printEffectList(std::ostream& stream, const ESM::EffectList& effects)
     {
         int i = 0;
         for (const ESM::IndexedENAMstruct& effect : effects.mList)
         {
-            std::cout << "  Effect[" << i << "]: " << magicEffectLabel(effect.mData.mEffectID) << " ("
-                      << effect.mData.mEffectID << ")" << std::endl;
+            stream << "  Effect[" << i << "]: " << magicEffectLabel(effect.mData.mEffectID) << " ("
+                   << effect.mData.mEffectID << ")\n";
             if (effect.mData.mSkill != -1)
-                std::cout << "    Skill: " << skillLabel(effect.mData.mSkill) << " (" << (int)effect.mData.mSkill << ")"
-                          << std::endl;
+                stream << "    Skill: " << skillLabel(effect.mData.mSkill) << " (" << (int)effect.mData.mSkill << ")"
+                       << '\n';
             if (effect.mData.mAttribute != -1)
-                std::cout << "    Attribute: " << attributeLabel(effect.mData.mAttribute) << " ("
-                          << (int)effect.mData.mAttribute << ")" << std::endl;
-            std::cout << "    Range: " << rangeTypeLabel(effect.mData.mRange) << " (" << effect.mData.mRange << ")"
-                      << std::endl;
+                stream << "    Attribute: " << attributeLabel(effect.mData.mAttribute) << " ("
+                       << (int)effect.mData.mAttribute << ")\n";
+            stream << "    Range: " << rangeTypeLabel(effect.mData.mRange) << " (" << effect.mData.mRange << ")"
+                   << '\n';
             // Area is always zero if range type is "Self"
             if (effect.mData.mRange != ESM::RT_Self)
-                std::cout << "    Area: " << effect.mData.mArea << std::endl;
-            std::cout << "    Duration: " << effect.mData.mDuration << std::endl;
-            std::cout << "    Magnitude: " << effect.mData.mMagnMin << "-" << effect.mData.mMagnMax << std::endl;
+                stream << "    Area: " << effect.mData.mArea << '\n';
+            stream << "    Duration: " << effect.mData.mDuration << '\n';
+            stream << "    Magnitude: " << effect.mData.mMagnMin << "-" << effect.mData.mMagnMax << '\n';
             i++;
         }
     }
 
-    void printTransport(const std::vector<ESM::Transport::Dest>& transport)
+    void printTransport(std::ostream& stream, const std::vector<ESM::Transport::Dest>& transport)
     {
         for (const ESM::Transport::Dest& dest : transport)
         {
-            std::cout << "  Destination Position: " << Misc::StringUtils::format("%12.3f", dest.mPos.pos[0]) << ","
-                      << Misc::StringUtils::format("%12.3f", dest.mPos.pos[1]) << ","
-                      << Misc::StringUtils::format("%12.3f", dest.mPos.pos[2]) << ")" << std::endl;
-            std::cout << "  Destination Rotation: " << Misc::StringUtils::format("%9.6f", dest.mPos.rot[0]) << ","
-                      << Misc::StringUtils::format("%9.6f", dest.mPos.rot[1]) << ","
-                      << Misc::StringUtils::format("%9.6f", dest.mPos.rot[2]) << ")" << std::endl;
+            stream << "  Destination Position: " << Misc::StringUtils::format("%12.3f", dest.mPos.pos[0]) << ","
+                   << Misc::StringUtils::format("%12.3f", dest.mPos.pos[1]) << ","
+                   << Misc::StringUtils::format("%12.3f", dest.mPos.pos[2]) << ")\n";
+            stream << "  Destination Rotation: " << Misc::StringUtils::format("%9.6f", dest.mPos.rot[0]) << ","
+                   << Misc::StringUtils::format("%9.6f", dest.mPos.rot[1]) << ","
+                   << Misc::StringUtils::format("%9.6f", dest.mPos.rot[2]) << ")\n";
             if (!dest.mCellName.empty())
-                std::cout << "  Destination Cell: " << dest.mCellName << std::endl;
+                stream << "  Destination Cell: " << dest.mCellName << '\n';
         }
     }
 }
@@ -431,898 +431,891 @@ namespace EsmTool
     }
 
     template <>
-    void Record<ESM::Activator>::print()
+    void Record<ESM::Activator>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Potion>::print()
+    void Record<ESM::Potion>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Flags: " << potionFlags(mData.mData.mFlags) << std::endl;
-        printEffectList(mData.mEffects);
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Flags: " << potionFlags(mData.mData.mFlags) << '\n';
+        printEffectList(stream, mData.mEffects);
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Armor>::print()
+    void Record<ESM::Armor>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
         if (!mData.mEnchant.empty())
-            std::cout << "  Enchantment: " << mData.mEnchant << std::endl;
-        std::cout << "  Type: " << armorTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Health: " << mData.mData.mHealth << std::endl;
-        std::cout << "  Armor: " << mData.mData.mArmor << std::endl;
-        std::cout << "  Enchantment Points: " << mData.mData.mEnchant << std::endl;
+            stream << "  Enchantment: " << mData.mEnchant << '\n';
+        stream << "  Type: " << armorTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")\n";
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Health: " << mData.mData.mHealth << '\n';
+        stream << "  Armor: " << mData.mData.mArmor << '\n';
+        stream << "  Enchantment Points: " << mData.mData.mEnchant << '\n';
         for (const ESM::PartReference& part : mData.mParts.mParts)
         {
-            std::cout << "  Body Part: " << bodyPartLabel(part.mPart) << " (" << (int)(part.mPart) << ")" << std::endl;
-            std::cout << "    Male Name: " << part.mMale << std::endl;
+            stream << "  Body Part: " << bodyPartLabel(part.mPart) << " (" << (int)(part.mPart) << ")\n";
+            stream << "    Male Name: " << part.mMale << '\n';
             if (!part.mFemale.empty())
-                std::cout << "    Female Name: " << part.mFemale << std::endl;
+                stream << "    Female Name: " << part.mFemale << '\n';
         }
 
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Apparatus>::print()
+    void Record<ESM::Apparatus>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Type: " << apparatusTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")"
-                  << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Quality: " << mData.mData.mQuality << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Type: " << apparatusTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Quality: " << mData.mData.mQuality << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::BodyPart>::print()
+    void Record<ESM::BodyPart>::print(std::ostream& stream)
     {
-        std::cout << "  Race: " << mData.mRace << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Type: " << meshTypeLabel(mData.mData.mType) << " (" << (int)mData.mData.mType << ")"
-                  << std::endl;
-        std::cout << "  Flags: " << bodyPartFlags(mData.mData.mFlags) << std::endl;
-        std::cout << "  Part: " << meshPartLabel(mData.mData.mPart) << " (" << (int)mData.mData.mPart << ")"
-                  << std::endl;
-        std::cout << "  Vampire: " << (int)mData.mData.mVampire << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Race: " << mData.mRace << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Type: " << meshTypeLabel(mData.mData.mType) << " (" << (int)mData.mData.mType << ")" << '\n';
+        stream << "  Flags: " << bodyPartFlags(mData.mData.mFlags) << '\n';
+        stream << "  Part: " << meshPartLabel(mData.mData.mPart) << " (" << (int)mData.mData.mPart << ")" << '\n';
+        stream << "  Vampire: " << (int)mData.mData.mVampire << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Book>::print()
+    void Record<ESM::Book>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
         if (!mData.mEnchant.empty())
-            std::cout << "  Enchantment: " << mData.mEnchant << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  IsScroll: " << mData.mData.mIsScroll << std::endl;
-        std::cout << "  SkillId: " << mData.mData.mSkillId << std::endl;
-        std::cout << "  Enchantment Points: " << mData.mData.mEnchant << std::endl;
+            stream << "  Enchantment: " << mData.mEnchant << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  IsScroll: " << mData.mData.mIsScroll << '\n';
+        stream << "  SkillId: " << mData.mData.mSkillId << '\n';
+        stream << "  Enchantment Points: " << mData.mData.mEnchant << '\n';
         if (mPrintPlain)
         {
-            std::cout << "  Text:" << std::endl;
-            std::cout << "START--------------------------------------" << std::endl;
-            std::cout << mData.mText << std::endl;
-            std::cout << "END----------------------------------------" << std::endl;
+            stream << "  Text:\n";
+            stream << "START--------------------------------------\n";
+            stream << mData.mText << '\n';
+            stream << "END----------------------------------------\n";
         }
         else
         {
-            std::cout << "  Text: [skipped]" << std::endl;
+            stream << "  Text: [skipped]\n";
         }
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::BirthSign>::print()
+    void Record<ESM::BirthSign>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Texture: " << mData.mTexture << std::endl;
-        std::cout << "  Description: " << mData.mDescription << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Texture: " << mData.mTexture << '\n';
+        stream << "  Description: " << mData.mDescription << '\n';
         for (const auto& power : mData.mPowers.mList)
-            std::cout << "  Power: " << power << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Power: " << power << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Cell>::print()
+    void Record<ESM::Cell>::print(std::ostream& stream)
     {
         // None of the cells have names...
         if (!mData.mName.empty())
-            std::cout << "  Name: " << mData.mName << std::endl;
+            stream << "  Name: " << mData.mName << '\n';
         if (!mData.mRegion.empty())
-            std::cout << "  Region: " << mData.mRegion << std::endl;
-        std::cout << "  Flags: " << cellFlags(mData.mData.mFlags) << std::endl;
+            stream << "  Region: " << mData.mRegion << '\n';
+        stream << "  Flags: " << cellFlags(mData.mData.mFlags) << '\n';
 
-        std::cout << "  Coordinates: "
-                  << " (" << mData.getGridX() << "," << mData.getGridY() << ")" << std::endl;
+        stream << "  Coordinates: " << " (" << mData.getGridX() << "," << mData.getGridY() << ")\n";
 
         if (mData.mData.mFlags & ESM::Cell::Interior && !(mData.mData.mFlags & ESM::Cell::QuasiEx))
         {
             if (mData.hasAmbient())
             {
                 // TODO: see if we can change the integer representation to something more sensible
-                std::cout << "  Ambient Light Color: " << mData.mAmbi.mAmbient << std::endl;
-                std::cout << "  Sunlight Color: " << mData.mAmbi.mSunlight << std::endl;
-                std::cout << "  Fog Color: " << mData.mAmbi.mFog << std::endl;
-                std::cout << "  Fog Density: " << mData.mAmbi.mFogDensity << std::endl;
+                stream << "  Ambient Light Color: " << mData.mAmbi.mAmbient << '\n';
+                stream << "  Sunlight Color: " << mData.mAmbi.mSunlight << '\n';
+                stream << "  Fog Color: " << mData.mAmbi.mFog << '\n';
+                stream << "  Fog Density: " << mData.mAmbi.mFogDensity << '\n';
             }
             else
             {
-                std::cout << "  No Ambient Information" << std::endl;
+                stream << "  No Ambient Information\n";
             }
-            std::cout << "  Water Level: " << mData.mWater << std::endl;
+            stream << "  Water Level: " << mData.mWater << '\n';
         }
         else
-            std::cout << "  Map Color: " << Misc::StringUtils::format("0x%08X", mData.mMapColor) << std::endl;
-        std::cout << "  RefId counter: " << mData.mRefNumCounter << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Map Color: " << Misc::StringUtils::format("0x%08X", mData.mMapColor) << '\n';
+        stream << "  RefId counter: " << mData.mRefNumCounter << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Class>::print()
+    void Record<ESM::Class>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Description: " << mData.mDescription << std::endl;
-        std::cout << "  Playable: " << mData.mData.mIsPlayable << std::endl;
-        std::cout << "  AI Services: " << Misc::StringUtils::format("0x%08X", mData.mData.mServices) << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Description: " << mData.mDescription << '\n';
+        stream << "  Playable: " << mData.mData.mIsPlayable << '\n';
+        stream << "  AI Services: " << Misc::StringUtils::format("0x%08X", mData.mData.mServices) << '\n';
         for (size_t i = 0; i < mData.mData.mAttribute.size(); ++i)
-            std::cout << "  Attribute" << (i + 1) << ": " << attributeLabel(mData.mData.mAttribute[i]) << " ("
-                      << mData.mData.mAttribute[i] << ")" << std::endl;
-        std::cout << "  Specialization: " << specializationLabel(mData.mData.mSpecialization) << " ("
-                  << mData.mData.mSpecialization << ")" << std::endl;
+            stream << "  Attribute" << (i + 1) << ": " << attributeLabel(mData.mData.mAttribute[i]) << " ("
+                   << mData.mData.mAttribute[i] << ")\n";
+        stream << "  Specialization: " << specializationLabel(mData.mData.mSpecialization) << " ("
+               << mData.mData.mSpecialization << ")\n";
         for (const auto& skills : mData.mData.mSkills)
-            std::cout << "  Minor Skill: " << skillLabel(skills[0]) << " (" << skills[0] << ")" << std::endl;
+            stream << "  Minor Skill: " << skillLabel(skills[0]) << " (" << skills[0] << ")\n";
         for (const auto& skills : mData.mData.mSkills)
-            std::cout << "  Major Skill: " << skillLabel(skills[1]) << " (" << skills[1] << ")" << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Major Skill: " << skillLabel(skills[1]) << " (" << skills[1] << ")\n";
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Clothing>::print()
+    void Record<ESM::Clothing>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
         if (!mData.mEnchant.empty())
-            std::cout << "  Enchantment: " << mData.mEnchant << std::endl;
-        std::cout << "  Type: " << clothingTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")"
-                  << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Enchantment Points: " << mData.mData.mEnchant << std::endl;
+            stream << "  Enchantment: " << mData.mEnchant << '\n';
+        stream << "  Type: " << clothingTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Enchantment Points: " << mData.mData.mEnchant << '\n';
         for (const ESM::PartReference& part : mData.mParts.mParts)
         {
-            std::cout << "  Body Part: " << bodyPartLabel(part.mPart) << " (" << (int)(part.mPart) << ")" << std::endl;
-            std::cout << "    Male Name: " << part.mMale << std::endl;
+            stream << "  Body Part: " << bodyPartLabel(part.mPart) << " (" << (int)(part.mPart) << ")\n";
+            stream << "    Male Name: " << part.mMale << '\n';
             if (!part.mFemale.empty())
-                std::cout << "    Female Name: " << part.mFemale << std::endl;
+                stream << "    Female Name: " << part.mFemale << '\n';
         }
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Container>::print()
+    void Record<ESM::Container>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Flags: " << containerFlags(mData.mFlags) << std::endl;
-        std::cout << "  Weight: " << mData.mWeight << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Flags: " << containerFlags(mData.mFlags) << '\n';
+        stream << "  Weight: " << mData.mWeight << '\n';
         for (const ESM::ContItem& item : mData.mInventory.mList)
-            std::cout << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
-                      << " Item: " << item.mItem << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
+                   << " Item: " << item.mItem << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Creature>::print()
+    void Record<ESM::Creature>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Flags: " << creatureFlags((int)mData.mFlags) << std::endl;
-        std::cout << "  Blood Type: " << mData.mBloodType + 1 << std::endl;
-        std::cout << "  Original: " << mData.mOriginal << std::endl;
-        std::cout << "  Scale: " << mData.mScale << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Flags: " << creatureFlags((int)mData.mFlags) << '\n';
+        stream << "  Blood Type: " << mData.mBloodType + 1 << '\n';
+        stream << "  Original: " << mData.mOriginal << '\n';
+        stream << "  Scale: " << mData.mScale << '\n';
 
-        std::cout << "  Type: " << creatureTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")"
-                  << std::endl;
-        std::cout << "  Level: " << mData.mData.mLevel << std::endl;
+        stream << "  Type: " << creatureTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << '\n';
+        stream << "  Level: " << mData.mData.mLevel << '\n';
 
-        std::cout << "  Attributes:" << std::endl;
+        stream << "  Attributes:\n";
         for (size_t i = 0; i < mData.mData.mAttributes.size(); ++i)
-            std::cout << "    " << ESM::Attribute::indexToRefId(i) << ": " << mData.mData.mAttributes[i] << std::endl;
-
-        std::cout << "  Health: " << mData.mData.mHealth << std::endl;
-        std::cout << "  Magicka: " << mData.mData.mMana << std::endl;
-        std::cout << "  Fatigue: " << mData.mData.mFatigue << std::endl;
-        std::cout << "  Soul: " << mData.mData.mSoul << std::endl;
-        std::cout << "  Combat: " << mData.mData.mCombat << std::endl;
-        std::cout << "  Magic: " << mData.mData.mMagic << std::endl;
-        std::cout << "  Stealth: " << mData.mData.mStealth << std::endl;
-        std::cout << "  Attack1: " << mData.mData.mAttack[0] << "-" << mData.mData.mAttack[1] << std::endl;
-        std::cout << "  Attack2: " << mData.mData.mAttack[2] << "-" << mData.mData.mAttack[3] << std::endl;
-        std::cout << "  Attack3: " << mData.mData.mAttack[4] << "-" << mData.mData.mAttack[5] << std::endl;
-        std::cout << "  Gold: " << mData.mData.mGold << std::endl;
+            stream << "    " << ESM::Attribute::indexToRefId(i) << ": " << mData.mData.mAttributes[i] << '\n';
+
+        stream << "  Health: " << mData.mData.mHealth << '\n';
+        stream << "  Magicka: " << mData.mData.mMana << '\n';
+        stream << "  Fatigue: " << mData.mData.mFatigue << '\n';
+        stream << "  Soul: " << mData.mData.mSoul << '\n';
+        stream << "  Combat: " << mData.mData.mCombat << '\n';
+        stream << "  Magic: " << mData.mData.mMagic << '\n';
+        stream << "  Stealth: " << mData.mData.mStealth << '\n';
+        stream << "  Attack1: " << mData.mData.mAttack[0] << "-" << mData.mData.mAttack[1] << '\n';
+        stream << "  Attack2: " << mData.mData.mAttack[2] << "-" << mData.mData.mAttack[3] << '\n';
+        stream << "  Attack3: " << mData.mData.mAttack[4] << "-" << mData.mData.mAttack[5] << '\n';
+        stream << "  Gold: " << mData.mData.mGold << '\n';
 
         for (const ESM::ContItem& item : mData.mInventory.mList)
-            std::cout << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
-                      << " Item: " << item.mItem << std::endl;
+            stream << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
+                   << " Item: " << item.mItem << '\n';
 
         for (const auto& spell : mData.mSpells.mList)
-            std::cout << "  Spell: " << spell << std::endl;
+            stream << "  Spell: " << spell << '\n';
 
-        printTransport(mData.getTransport());
+        printTransport(stream, mData.getTransport());
 
-        std::cout << "  Artificial Intelligence: " << std::endl;
-        std::cout << "    AI Hello:" << (int)mData.mAiData.mHello << std::endl;
-        std::cout << "    AI Fight:" << (int)mData.mAiData.mFight << std::endl;
-        std::cout << "    AI Flee:" << (int)mData.mAiData.mFlee << std::endl;
-        std::cout << "    AI Alarm:" << (int)mData.mAiData.mAlarm << std::endl;
-        std::cout << "    AI Services:" << Misc::StringUtils::format("0x%08X", mData.mAiData.mServices) << std::endl;
+        stream << "  Artificial Intelligence: \n";
+        stream << "    AI Hello:" << (int)mData.mAiData.mHello << '\n';
+        stream << "    AI Fight:" << (int)mData.mAiData.mFight << '\n';
+        stream << "    AI Flee:" << (int)mData.mAiData.mFlee << '\n';
+        stream << "    AI Alarm:" << (int)mData.mAiData.mAlarm << '\n';
+        stream << "    AI Services:" << Misc::StringUtils::format("0x%08X", mData.mAiData.mServices) << '\n';
 
         for (const ESM::AIPackage& package : mData.mAiPackage.mList)
-            printAIPackage(package);
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            printAIPackage(stream, package);
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Dialogue>::print()
+    void Record<ESM::Dialogue>::print(std::ostream& stream)
     {
-        std::cout << "  StringId: " << mData.mStringId << std::endl;
-        std::cout << "  Type: " << dialogTypeLabel(mData.mType) << " (" << (int)mData.mType << ")" << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  StringId: " << mData.mStringId << '\n';
+        stream << "  Type: " << dialogTypeLabel(mData.mType) << " (" << (int)mData.mType << ")\n";
+        stream << "  Deleted: " << mIsDeleted << '\n';
         // Sadly, there are no DialInfos, because the loader dumps as it
         // loads, rather than loading and then dumping. :-( Anyone mind if
         // I change this?
         for (const ESM::DialInfo& info : mData.mInfo)
-            std::cout << "INFO!" << info.mId << std::endl;
+            stream << "INFO!" << info.mId << '\n';
     }
 
     template <>
-    void Record<ESM::Door>::print()
+    void Record<ESM::Door>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  OpenSound: " << mData.mOpenSound << std::endl;
-        std::cout << "  CloseSound: " << mData.mCloseSound << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  OpenSound: " << mData.mOpenSound << '\n';
+        stream << "  CloseSound: " << mData.mCloseSound << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Enchantment>::print()
+    void Record<ESM::Enchantment>::print(std::ostream& stream)
     {
-        std::cout << "  Type: " << enchantTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << std::endl;
-        std::cout << "  Cost: " << mData.mData.mCost << std::endl;
-        std::cout << "  Charge: " << mData.mData.mCharge << std::endl;
-        std::cout << "  Flags: " << enchantmentFlags(mData.mData.mFlags) << std::endl;
-        printEffectList(mData.mEffects);
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Type: " << enchantTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")\n";
+        stream << "  Cost: " << mData.mData.mCost << '\n';
+        stream << "  Charge: " << mData.mData.mCharge << '\n';
+        stream << "  Flags: " << enchantmentFlags(mData.mData.mFlags) << '\n';
+        printEffectList(stream, mData.mEffects);
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Faction>::print()
+    void Record<ESM::Faction>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Hidden: " << mData.mData.mIsHidden << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Hidden: " << mData.mData.mIsHidden << '\n';
         for (size_t i = 0; i < mData.mData.mAttribute.size(); ++i)
-            std::cout << "  Attribute" << (i + 1) << ": " << attributeLabel(mData.mData.mAttribute[i]) << " ("
-                      << mData.mData.mAttribute[i] << ")" << std::endl;
+            stream << "  Attribute" << (i + 1) << ": " << attributeLabel(mData.mData.mAttribute[i]) << " ("
+                   << mData.mData.mAttribute[i] << ")\n";
         for (int skill : mData.mData.mSkills)
             if (skill != -1)
-                std::cout << "  Skill: " << skillLabel(skill) << " (" << skill << ")" << std::endl;
+                stream << "  Skill: " << skillLabel(skill) << " (" << skill << ")\n";
         for (size_t i = 0; i != mData.mData.mRankData.size(); i++)
             if (!mData.mRanks[i].empty())
             {
-                std::cout << "  Rank: " << mData.mRanks[i] << std::endl;
-                std::cout << "    Attribute1 Requirement: " << mData.mData.mRankData[i].mAttribute1 << std::endl;
-                std::cout << "    Attribute2 Requirement: " << mData.mData.mRankData[i].mAttribute2 << std::endl;
-                std::cout << "    One Skill at Level: " << mData.mData.mRankData[i].mPrimarySkill << std::endl;
-                std::cout << "    Two Skills at Level: " << mData.mData.mRankData[i].mFavouredSkill << std::endl;
-                std::cout << "    Faction Reaction: " << mData.mData.mRankData[i].mFactReaction << std::endl;
+                stream << "  Rank: " << mData.mRanks[i] << '\n';
+                stream << "    Attribute1 Requirement: " << mData.mData.mRankData[i].mAttribute1 << '\n';
+                stream << "    Attribute2 Requirement: " << mData.mData.mRankData[i].mAttribute2 << '\n';
+                stream << "    One Skill at Level: " << mData.mData.mRankData[i].mPrimarySkill << '\n';
+                stream << "    Two Skills at Level: " << mData.mData.mRankData[i].mFavouredSkill << '\n';
+                stream << "    Faction Reaction: " << mData.mData.mRankData[i].mFactReaction << '\n';
             }
         for (const auto& reaction : mData.mReactions)
-            std::cout << "  Reaction: " << reaction.second << " = " << reaction.first << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Reaction: " << reaction.second << " = " << reaction.first << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Global>::print()
+    void Record<ESM::Global>::print(std::ostream& stream)
     {
-        std::cout << "  " << mData.mValue << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  " << mData.mValue << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::GameSetting>::print()
+    void Record<ESM::GameSetting>::print(std::ostream& stream)
     {
-        std::cout << "  " << mData.mValue << std::endl;
+        stream << "  " << mData.mValue << '\n';
     }
 
     template <>
-    void Record<ESM::DialInfo>::print()
+    void Record<ESM::DialInfo>::print(std::ostream& stream)
     {
-        std::cout << "  Id: " << mData.mId << std::endl;
+        stream << "  Id: " << mData.mId << '\n';
         if (!mData.mPrev.empty())
-            std::cout << "  Previous ID: " << mData.mPrev << std::endl;
+            stream << "  Previous ID: " << mData.mPrev << '\n';
         if (!mData.mNext.empty())
-            std::cout << "  Next ID: " << mData.mNext << std::endl;
-        std::cout << "  Text: " << mData.mResponse << std::endl;
+            stream << "  Next ID: " << mData.mNext << '\n';
+        stream << "  Text: " << mData.mResponse << '\n';
         if (!mData.mActor.empty())
-            std::cout << "  Actor: " << mData.mActor << std::endl;
+            stream << "  Actor: " << mData.mActor << '\n';
         if (!mData.mRace.empty())
-            std::cout << "  Race: " << mData.mRace << std::endl;
+            stream << "  Race: " << mData.mRace << '\n';
         if (!mData.mClass.empty())
-            std::cout << "  Class: " << mData.mClass << std::endl;
-        std::cout << "  Factionless: " << mData.mFactionLess << std::endl;
+            stream << "  Class: " << mData.mClass << '\n';
+        stream << "  Factionless: " << mData.mFactionLess << '\n';
         if (!mData.mFaction.empty())
-            std::cout << "  NPC Faction: " << mData.mFaction << std::endl;
+            stream << "  NPC Faction: " << mData.mFaction << '\n';
         if (mData.mData.mRank != -1)
-            std::cout << "  NPC Rank: " << (int)mData.mData.mRank << std::endl;
+            stream << "  NPC Rank: " << (int)mData.mData.mRank << '\n';
         if (!mData.mPcFaction.empty())
-            std::cout << "  PC Faction: " << mData.mPcFaction << std::endl;
+            stream << "  PC Faction: " << mData.mPcFaction << '\n';
         // CHANGE? non-standard capitalization mPCrank -> mPCRank (mPcRank?)
         if (mData.mData.mPCrank != -1)
-            std::cout << "  PC Rank: " << (int)mData.mData.mPCrank << std::endl;
+            stream << "  PC Rank: " << (int)mData.mData.mPCrank << '\n';
         if (!mData.mCell.empty())
-            std::cout << "  Cell: " << mData.mCell << std::endl;
+            stream << "  Cell: " << mData.mCell << '\n';
         if (mData.mData.mDisposition > 0)
-            std::cout << "  Disposition/Journal index: " << mData.mData.mDisposition << std::endl;
+            stream << "  Disposition/Journal index: " << mData.mData.mDisposition << '\n';
         if (mData.mData.mGender != ESM::DialInfo::NA)
-            std::cout << "  Gender: " << static_cast<int>(mData.mData.mGender) << std::endl;
+            stream << "  Gender: " << static_cast<int>(mData.mData.mGender) << '\n';
         if (!mData.mSound.empty())
-            std::cout << "  Sound File: " << mData.mSound << std::endl;
+            stream << "  Sound File: " << mData.mSound << '\n';
 
-        std::cout << "  Quest Status: " << questStatusLabel(mData.mQuestStatus) << " (" << mData.mQuestStatus << ")"
-                  << std::endl;
-        std::cout << "  Type: " << dialogTypeLabel(mData.mData.mType) << std::endl;
+        stream << "  Quest Status: " << questStatusLabel(mData.mQuestStatus) << " (" << mData.mQuestStatus << ")"
+               << '\n';
+        stream << "  Type: " << dialogTypeLabel(mData.mData.mType) << '\n';
 
         for (const auto& rule : mData.mSelects)
-            std::cout << "  Select Rule: " << ruleString(rule) << std::endl;
+            stream << "  Select Rule: " << ruleString(rule) << '\n';
 
         if (!mData.mResultScript.empty())
         {
             if (mPrintPlain)
             {
-                std::cout << "  Result Script:" << std::endl;
-                std::cout << "START--------------------------------------" << std::endl;
-                std::cout << mData.mResultScript << std::endl;
-                std::cout << "END----------------------------------------" << std::endl;
+                stream << "  Result Script:\n";
+                stream << "START--------------------------------------\n";
+                stream << mData.mResultScript << '\n';
+                stream << "END----------------------------------------\n";
             }
             else
             {
-                std::cout << "  Result Script: [skipped]" << std::endl;
+                stream << "  Result Script: [skipped]\n";
             }
         }
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Ingredient>::print()
+    void Record<ESM::Ingredient>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
         for (int i = 0; i != 4; i++)
         {
             // A value of -1 means no effect
             if (mData.mData.mEffectID[i] == -1)
                 continue;
-            std::cout << "  Effect: " << magicEffectLabel(mData.mData.mEffectID[i]) << " (" << mData.mData.mEffectID[i]
-                      << ")" << std::endl;
-            std::cout << "  Skill: " << skillLabel(mData.mData.mSkills[i]) << " (" << mData.mData.mSkills[i] << ")"
-                      << std::endl;
-            std::cout << "  Attribute: " << attributeLabel(mData.mData.mAttributes[i]) << " ("
-                      << mData.mData.mAttributes[i] << ")" << std::endl;
+            stream << "  Effect: " << magicEffectLabel(mData.mData.mEffectID[i]) << " (" << mData.mData.mEffectID[i]
+                   << ")\n";
+            stream << "  Skill: " << skillLabel(mData.mData.mSkills[i]) << " (" << mData.mData.mSkills[i] << ")"
+                   << '\n';
+            stream << "  Attribute: " << attributeLabel(mData.mData.mAttributes[i]) << " ("
+                   << mData.mData.mAttributes[i] << ")\n";
         }
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Land>::print()
+    void Record<ESM::Land>::print(std::ostream& stream)
     {
-        std::cout << "  Coordinates: (" << mData.mX << "," << mData.mY << ")" << std::endl;
-        std::cout << "  Flags: " << landFlags(mData.mFlags) << std::endl;
-        std::cout << "  DataTypes: " << mData.mDataTypes << std::endl;
+        stream << "  Coordinates: (" << mData.mX << "," << mData.mY << ")\n";
+        stream << "  Flags: " << landFlags(mData.mFlags) << '\n';
+        stream << "  DataTypes: " << mData.mDataTypes << '\n';
 
         if (const ESM::Land::LandData* data = mData.getLandData(mData.mDataTypes))
         {
-            std::cout << "  MinHeight: " << data->mMinHeight << std::endl;
-            std::cout << "  MaxHeight: " << data->mMaxHeight << std::endl;
-            std::cout << "  DataLoaded: " << data->mDataLoaded << std::endl;
+            stream << "  MinHeight: " << data->mMinHeight << '\n';
+            stream << "  MaxHeight: " << data->mMaxHeight << '\n';
+            stream << "  DataLoaded: " << data->mDataLoaded << '\n';
         }
         mData.unloadData();
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::CreatureLevList>::print()
+    void Record<ESM::CreatureLevList>::print(std::ostream& stream)
     {
-        std::cout << "  Chance for None: " << (int)mData.mChanceNone << std::endl;
-        std::cout << "  Flags: " << creatureListFlags(mData.mFlags) << std::endl;
-        std::cout << "  Number of items: " << mData.mList.size() << std::endl;
+        stream << "  Chance for None: " << (int)mData.mChanceNone << '\n';
+        stream << "  Flags: " << creatureListFlags(mData.mFlags) << '\n';
+        stream << "  Number of items: " << mData.mList.size() << '\n';
         for (const ESM::LevelledListBase::LevelItem& item : mData.mList)
-            std::cout << "  Creature: Level: " << item.mLevel << " Creature: " << item.mId << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Creature: Level: " << item.mLevel << " Creature: " << item.mId << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::ItemLevList>::print()
+    void Record<ESM::ItemLevList>::print(std::ostream& stream)
     {
-        std::cout << "  Chance for None: " << (int)mData.mChanceNone << std::endl;
-        std::cout << "  Flags: " << itemListFlags(mData.mFlags) << std::endl;
-        std::cout << "  Number of items: " << mData.mList.size() << std::endl;
+        stream << "  Chance for None: " << (int)mData.mChanceNone << '\n';
+        stream << "  Flags: " << itemListFlags(mData.mFlags) << '\n';
+        stream << "  Number of items: " << mData.mList.size() << '\n';
         for (const ESM::LevelledListBase::LevelItem& item : mData.mList)
-            std::cout << "  Inventory: Level: " << item.mLevel << " Item: " << item.mId << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Inventory: Level: " << item.mLevel << " Item: " << item.mId << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Light>::print()
+    void Record<ESM::Light>::print(std::ostream& stream)
     {
         if (!mData.mName.empty())
-            std::cout << "  Name: " << mData.mName << std::endl;
+            stream << "  Name: " << mData.mName << '\n';
         if (!mData.mModel.empty())
-            std::cout << "  Model: " << mData.mModel << std::endl;
+            stream << "  Model: " << mData.mModel << '\n';
         if (!mData.mIcon.empty())
-            std::cout << "  Icon: " << mData.mIcon << std::endl;
+            stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Flags: " << lightFlags(mData.mData.mFlags) << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Sound: " << mData.mSound << std::endl;
-        std::cout << "  Duration: " << mData.mData.mTime << std::endl;
-        std::cout << "  Radius: " << mData.mData.mRadius << std::endl;
-        std::cout << "  Color: " << mData.mData.mColor << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Flags: " << lightFlags(mData.mData.mFlags) << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Sound: " << mData.mSound << '\n';
+        stream << "  Duration: " << mData.mData.mTime << '\n';
+        stream << "  Radius: " << mData.mData.mRadius << '\n';
+        stream << "  Color: " << mData.mData.mColor << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Lockpick>::print()
+    void Record<ESM::Lockpick>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Quality: " << mData.mData.mQuality << std::endl;
-        std::cout << "  Uses: " << mData.mData.mUses << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Quality: " << mData.mData.mQuality << '\n';
+        stream << "  Uses: " << mData.mData.mUses << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Probe>::print()
+    void Record<ESM::Probe>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Quality: " << mData.mData.mQuality << std::endl;
-        std::cout << "  Uses: " << mData.mData.mUses << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Quality: " << mData.mData.mQuality << '\n';
+        stream << "  Uses: " << mData.mData.mUses << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Repair>::print()
+    void Record<ESM::Repair>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Quality: " << mData.mData.mQuality << std::endl;
-        std::cout << "  Uses: " << mData.mData.mUses << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Quality: " << mData.mData.mQuality << '\n';
+        stream << "  Uses: " << mData.mData.mUses << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::LandTexture>::print()
+    void Record<ESM::LandTexture>::print(std::ostream& stream)
     {
-        std::cout << "  Id: " << mData.mId << std::endl;
-        std::cout << "  Index: " << mData.mIndex << std::endl;
-        std::cout << "  Texture: " << mData.mTexture << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Id: " << mData.mId << '\n';
+        stream << "  Index: " << mData.mIndex << '\n';
+        stream << "  Texture: " << mData.mTexture << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::MagicEffect>::print()
+    void Record<ESM::MagicEffect>::print(std::ostream& stream)
     {
-        std::cout << "  Index: " << magicEffectLabel(mData.mIndex) << " (" << mData.mIndex << ")" << std::endl;
-        std::cout << "  Description: " << mData.mDescription << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
-        std::cout << "  Flags: " << magicEffectFlags(mData.mData.mFlags) << std::endl;
-        std::cout << "  Particle Texture: " << mData.mParticle << std::endl;
+        stream << "  Index: " << magicEffectLabel(mData.mIndex) << " (" << mData.mIndex << ")\n";
+        stream << "  Description: " << mData.mDescription << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
+        stream << "  Flags: " << magicEffectFlags(mData.mData.mFlags) << '\n';
+        stream << "  Particle Texture: " << mData.mParticle << '\n';
         if (!mData.mCasting.empty())
-            std::cout << "  Casting Static: " << mData.mCasting << std::endl;
+            stream << "  Casting Static: " << mData.mCasting << '\n';
         if (!mData.mCastSound.empty())
-            std::cout << "  Casting Sound: " << mData.mCastSound << std::endl;
+            stream << "  Casting Sound: " << mData.mCastSound << '\n';
         if (!mData.mBolt.empty())
-            std::cout << "  Bolt Static: " << mData.mBolt << std::endl;
+            stream << "  Bolt Static: " << mData.mBolt << '\n';
         if (!mData.mBoltSound.empty())
-            std::cout << "  Bolt Sound: " << mData.mBoltSound << std::endl;
+            stream << "  Bolt Sound: " << mData.mBoltSound << '\n';
         if (!mData.mHit.empty())
-            std::cout << "  Hit Static: " << mData.mHit << std::endl;
+            stream << "  Hit Static: " << mData.mHit << '\n';
         if (!mData.mHitSound.empty())
-            std::cout << "  Hit Sound: " << mData.mHitSound << std::endl;
+            stream << "  Hit Sound: " << mData.mHitSound << '\n';
         if (!mData.mArea.empty())
-            std::cout << "  Area Static: " << mData.mArea << std::endl;
+            stream << "  Area Static: " << mData.mArea << '\n';
         if (!mData.mAreaSound.empty())
-            std::cout << "  Area Sound: " << mData.mAreaSound << std::endl;
-        std::cout << "  School: " << schoolLabel(ESM::MagicSchool::skillRefIdToIndex(mData.mData.mSchool)) << " ("
-                  << mData.mData.mSchool << ")" << std::endl;
-        std::cout << "  Base Cost: " << mData.mData.mBaseCost << std::endl;
-        std::cout << "  Unknown 1: " << mData.mData.mUnknown1 << std::endl;
-        std::cout << "  Speed: " << mData.mData.mSpeed << std::endl;
-        std::cout << "  Unknown 2: " << mData.mData.mUnknown2 << std::endl;
-        std::cout << "  RGB Color: "
-                  << "(" << mData.mData.mRed << "," << mData.mData.mGreen << "," << mData.mData.mBlue << ")"
-                  << std::endl;
+            stream << "  Area Sound: " << mData.mAreaSound << '\n';
+        stream << "  School: " << schoolLabel(ESM::MagicSchool::skillRefIdToIndex(mData.mData.mSchool)) << " ("
+               << mData.mData.mSchool << ")\n";
+        stream << "  Base Cost: " << mData.mData.mBaseCost << '\n';
+        stream << "  Unknown 1: " << mData.mData.mUnknown1 << '\n';
+        stream << "  Speed: " << mData.mData.mSpeed << '\n';
+        stream << "  Unknown 2: " << mData.mData.mUnknown2 << '\n';
+        stream << "  RGB Color: "
+               << "(" << mData.mData.mRed << "," << mData.mData.mGreen << "," << mData.mData.mBlue << ")"
+               << '\n';
     }
 
     template <>
-    void Record<ESM::Miscellaneous>::print()
+    void Record<ESM::Miscellaneous>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
-        std::cout << "  Icon: " << mData.mIcon << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
+        stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Is Key: " << (mData.mData.mFlags & ESM::Miscellaneous::Key) << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Is Key: " << (mData.mData.mFlags & ESM::Miscellaneous::Key) << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::NPC>::print()
+    void Record<ESM::NPC>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Animation: " << mData.mModel << std::endl;
-        std::cout << "  Hair Model: " << mData.mHair << std::endl;
-        std::cout << "  Head Model: " << mData.mHead << std::endl;
-        std::cout << "  Race: " << mData.mRace << std::endl;
-        std::cout << "  Class: " << mData.mClass << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Animation: " << mData.mModel << '\n';
+        stream << "  Hair Model: " << mData.mHair << '\n';
+        stream << "  Head Model: " << mData.mHead << '\n';
+        stream << "  Race: " << mData.mRace << '\n';
+        stream << "  Class: " << mData.mClass << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
         if (!mData.mFaction.empty())
-            std::cout << "  Faction: " << mData.mFaction << std::endl;
-        std::cout << "  Flags: " << npcFlags((int)mData.mFlags) << std::endl;
+            stream << "  Faction: " << mData.mFaction << '\n';
+        stream << "  Flags: " << npcFlags((int)mData.mFlags) << '\n';
         if (mData.mBloodType != 0)
-            std::cout << "  Blood Type: " << mData.mBloodType + 1 << std::endl;
+            stream << "  Blood Type: " << mData.mBloodType + 1 << '\n';
 
         if (mData.mNpdtType == ESM::NPC::NPC_WITH_AUTOCALCULATED_STATS)
         {
-            std::cout << "  Level: " << mData.mNpdt.mLevel << std::endl;
-            std::cout << "  Reputation: " << (int)mData.mNpdt.mReputation << std::endl;
-            std::cout << "  Disposition: " << (int)mData.mNpdt.mDisposition << std::endl;
-            std::cout << "  Rank: " << (int)mData.mNpdt.mRank << std::endl;
-            std::cout << "  Gold: " << mData.mNpdt.mGold << std::endl;
+            stream << "  Level: " << mData.mNpdt.mLevel << '\n';
+            stream << "  Reputation: " << (int)mData.mNpdt.mReputation << '\n';
+            stream << "  Disposition: " << (int)mData.mNpdt.mDisposition << '\n';
+            stream << "  Rank: " << (int)mData.mNpdt.mRank << '\n';
+            stream << "  Gold: " << mData.mNpdt.mGold << '\n';
         }
         else
         {
-            std::cout << "  Level: " << mData.mNpdt.mLevel << std::endl;
-            std::cout << "  Reputation: " << (int)mData.mNpdt.mReputation << std::endl;
-            std::cout << "  Disposition: " << (int)mData.mNpdt.mDisposition << std::endl;
-            std::cout << "  Rank: " << (int)mData.mNpdt.mRank << std::endl;
+            stream << "  Level: " << mData.mNpdt.mLevel << '\n';
+            stream << "  Reputation: " << (int)mData.mNpdt.mReputation << '\n';
+            stream << "  Disposition: " << (int)mData.mNpdt.mDisposition << '\n';
+            stream << "  Rank: " << (int)mData.mNpdt.mRank << '\n';
 
-            std::cout << "  Attributes:" << std::endl;
+            stream << "  Attributes:\n";
             for (size_t i = 0; i != mData.mNpdt.mAttributes.size(); i++)
-                std::cout << "    " << attributeLabel(i) << ": " << int(mData.mNpdt.mAttributes[i]) << std::endl;
+                stream << "    " << attributeLabel(i) << ": " << int(mData.mNpdt.mAttributes[i]) << '\n';
 
-            std::cout << "  Skills:" << std::endl;
+            stream << "  Skills:\n";
             for (size_t i = 0; i != mData.mNpdt.mSkills.size(); i++)
-                std::cout << "    " << skillLabel(i) << ": " << int(mData.mNpdt.mSkills[i]) << std::endl;
+                stream << "    " << skillLabel(i) << ": " << int(mData.mNpdt.mSkills[i]) << '\n';
 
-            std::cout << "  Health: " << mData.mNpdt.mHealth << std::endl;
-            std::cout << "  Magicka: " << mData.mNpdt.mMana << std::endl;
-            std::cout << "  Fatigue: " << mData.mNpdt.mFatigue << std::endl;
-            std::cout << "  Gold: " << mData.mNpdt.mGold << std::endl;
+            stream << "  Health: " << mData.mNpdt.mHealth << '\n';
+            stream << "  Magicka: " << mData.mNpdt.mMana << '\n';
+            stream << "  Fatigue: " << mData.mNpdt.mFatigue << '\n';
+            stream << "  Gold: " << mData.mNpdt.mGold << '\n';
         }
 
         for (const ESM::ContItem& item : mData.mInventory.mList)
-            std::cout << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
-                      << " Item: " << item.mItem << std::endl;
+            stream << "  Inventory: Count: " << Misc::StringUtils::format("%4d", item.mCount)
+                   << " Item: " << item.mItem << '\n';
 
         for (const auto& spell : mData.mSpells.mList)
-            std::cout << "  Spell: " << spell << std::endl;
+            stream << "  Spell: " << spell << '\n';
 
-        printTransport(mData.getTransport());
+        printTransport(stream, mData.getTransport());
 
-        std::cout << "  Artificial Intelligence: " << std::endl;
-        std::cout << "    AI Hello:" << (int)mData.mAiData.mHello << std::endl;
-        std::cout << "    AI Fight:" << (int)mData.mAiData.mFight << std::endl;
-        std::cout << "    AI Flee:" << (int)mData.mAiData.mFlee << std::endl;
-        std::cout << "    AI Alarm:" << (int)mData.mAiData.mAlarm << std::endl;
-        std::cout << "    AI Services:" << Misc::StringUtils::format("0x%08X", mData.mAiData.mServices) << std::endl;
+        stream << "  Artificial Intelligence: \n";
+        stream << "    AI Hello:" << (int)mData.mAiData.mHello << '\n';
+        stream << "    AI Fight:" << (int)mData.mAiData.mFight << '\n';
+        stream << "    AI Flee:" << (int)mData.mAiData.mFlee << '\n';
+        stream << "    AI Alarm:" << (int)mData.mAiData.mAlarm << '\n';
+        stream << "    AI Services:" << Misc::StringUtils::format("0x%08X", mData.mAiData.mServices) << '\n';
 
         for (const ESM::AIPackage& package : mData.mAiPackage.mList)
-            printAIPackage(package);
+            printAIPackage(stream, package);
 
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Pathgrid>::print()
+    void Record<ESM::Pathgrid>::print(std::ostream& stream)
     {
-        std::cout << "  Cell: " << mData.mCell << std::endl;
-        std::cout << "  Coordinates: (" << mData.mData.mX << "," << mData.mData.mY << ")" << std::endl;
-        std::cout << "  Granularity: " << mData.mData.mGranularity << std::endl;
+        stream << "  Cell: " << mData.mCell << '\n';
+        stream << "  Coordinates: (" << mData.mData.mX << "," << mData.mData.mY << ")\n";
+        stream << "  Granularity: " << mData.mData.mGranularity << '\n';
         if (mData.mData.mPoints != mData.mPoints.size())
-            std::cout << "  Reported Point Count: " << mData.mData.mPoints << std::endl;
-        std::cout << "  Point Count: " << mData.mPoints.size() << std::endl;
-        std::cout << "  Edge Count: " << mData.mEdges.size() << std::endl;
+            stream << "  Reported Point Count: " << mData.mData.mPoints << '\n';
+        stream << "  Point Count: " << mData.mPoints.size() << '\n';
+        stream << "  Edge Count: " << mData.mEdges.size() << '\n';
 
         int i = 0;
         for (const ESM::Pathgrid::Point& point : mData.mPoints)
         {
-            std::cout << "  Point[" << i << "]:" << std::endl;
-            std::cout << "    Coordinates: (" << point.mX << "," << point.mY << "," << point.mZ << ")" << std::endl;
-            std::cout << "    Auto-Generated: " << (int)point.mAutogenerated << std::endl;
-            std::cout << "    Connections: " << (int)point.mConnectionNum << std::endl;
+            stream << "  Point[" << i << "]:\n";
+            stream << "    Coordinates: (" << point.mX << "," << point.mY << "," << point.mZ << ")\n";
+            stream << "    Auto-Generated: " << (int)point.mAutogenerated << '\n';
+            stream << "    Connections: " << (int)point.mConnectionNum << '\n';
             i++;
         }
 
         i = 0;
         for (const ESM::Pathgrid::Edge& edge : mData.mEdges)
         {
-            std::cout << "  Edge[" << i << "]: " << edge.mV0 << " -> " << edge.mV1 << std::endl;
+            stream << "  Edge[" << i << "]: " << edge.mV0 << " -> " << edge.mV1 << '\n';
             if (edge.mV0 >= mData.mData.mPoints || edge.mV1 >= mData.mData.mPoints)
-                std::cout << "  BAD POINT IN EDGE!" << std::endl;
+                stream << "  BAD POINT IN EDGE!\n";
             i++;
         }
 
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Race>::print()
+    void Record<ESM::Race>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Description: " << mData.mDescription << std::endl;
-        std::cout << "  Flags: " << raceFlags(mData.mData.mFlags) << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Description: " << mData.mDescription << '\n';
+        stream << "  Flags: " << raceFlags(mData.mData.mFlags) << '\n';
 
-        std::cout << "  Male:" << std::endl;
+        stream << "  Male:\n";
         for (int j = 0; j < ESM::Attribute::Length; ++j)
         {
             ESM::RefId id = ESM::Attribute::indexToRefId(j);
-            std::cout << "    " << id << ": " << mData.mData.getAttribute(id, true) << std::endl;
+            stream << "    " << id << ": " << mData.mData.getAttribute(id, true) << '\n';
         }
-        std::cout << "    Height: " << mData.mData.mMaleHeight << std::endl;
-        std::cout << "    Weight: " << mData.mData.mMaleWeight << std::endl;
+        stream << "    Height: " << mData.mData.mMaleHeight << '\n';
+        stream << "    Weight: " << mData.mData.mMaleWeight << '\n';
 
-        std::cout << "  Female:" << std::endl;
+        stream << "  Female:\n";
         for (int j = 0; j < ESM::Attribute::Length; ++j)
         {
             ESM::RefId id = ESM::Attribute::indexToRefId(j);
-            std::cout << "    " << id << ": " << mData.mData.getAttribute(id, false) << std::endl;
+            stream << "    " << id << ": " << mData.mData.getAttribute(id, false) << '\n';
         }
-        std::cout << "    Height: " << mData.mData.mFemaleHeight << std::endl;
-        std::cout << "    Weight: " << mData.mData.mFemaleWeight << std::endl;
+        stream << "    Height: " << mData.mData.mFemaleHeight << '\n';
+        stream << "    Weight: " << mData.mData.mFemaleWeight << '\n';
 
         for (const auto& bonus : mData.mData.mBonus)
             // Not all races have 7 skills.
             if (bonus.mSkill != -1)
-                std::cout << "  Skill: " << skillLabel(bonus.mSkill) << " (" << bonus.mSkill << ") = " << bonus.mBonus
-                          << std::endl;
+                stream << "  Skill: " << skillLabel(bonus.mSkill) << " (" << bonus.mSkill << ") = " << bonus.mBonus
+                       << '\n';
 
         for (const auto& power : mData.mPowers.mList)
-            std::cout << "  Power: " << power << std::endl;
+            stream << "  Power: " << power << '\n';
 
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Region>::print()
+    void Record<ESM::Region>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
 
-        std::cout << "  Weather:" << std::endl;
+        stream << "  Weather:\n";
         std::array<std::string_view, 10> weathers
             = { "Clear", "Cloudy", "Fog", "Overcast", "Rain", "Thunder", "Ash", "Blight", "Snow", "Blizzard" };
         for (size_t i = 0; i < weathers.size(); ++i)
-            std::cout << "    " << weathers[i] << ": " << static_cast<unsigned>(mData.mData.mProbabilities[i])
-                      << std::endl;
-        std::cout << "  Map Color: " << mData.mMapColor << std::endl;
+            stream << "    " << weathers[i] << ": " << static_cast<unsigned>(mData.mData.mProbabilities[i]) << '\n';
+        stream << "  Map Color: " << mData.mMapColor << '\n';
         if (!mData.mSleepList.empty())
-            std::cout << "  Sleep List: " << mData.mSleepList << std::endl;
+            stream << "  Sleep List: " << mData.mSleepList << '\n';
         for (const ESM::Region::SoundRef& soundref : mData.mSoundList)
-            std::cout << "  Sound: " << (int)soundref.mChance << " = " << soundref.mSound << std::endl;
+            stream << "  Sound: " << (int)soundref.mChance << " = " << soundref.mSound << '\n';
     }
 
     template <>
-    void Record<ESM::Script>::print()
+    void Record<ESM::Script>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mId << std::endl;
+        stream << "  Name: " << mData.mId << '\n';
 
-        std::cout << "  Num Shorts: " << mData.mData.mNumShorts << std::endl;
-        std::cout << "  Num Longs: " << mData.mData.mNumLongs << std::endl;
-        std::cout << "  Num Floats: " << mData.mData.mNumFloats << std::endl;
-        std::cout << "  Script Data Size: " << mData.mData.mScriptDataSize << std::endl;
-        std::cout << "  Table Size: " << mData.mData.mStringTableSize << std::endl;
+        stream << "  Num Shorts: " << mData.mData.mNumShorts << '\n';
+        stream << "  Num Longs: " << mData.mData.mNumLongs << '\n';
+        stream << "  Num Floats: " << mData.mData.mNumFloats << '\n';
+        stream << "  Script Data Size: " << mData.mData.mScriptDataSize << '\n';
+        stream << "  Table Size: " << mData.mData.mStringTableSize << '\n';
 
         for (const std::string& variable : mData.mVarNames)
-            std::cout << "  Variable: " << variable << std::endl;
+            stream << "  Variable: " << variable << '\n';
 
-        std::cout << "  ByteCode: ";
+        stream << "  ByteCode: ";
         for (const unsigned char& byte : mData.mScriptData)
-            std::cout << Misc::StringUtils::format("%02X", (int)(byte));
-        std::cout << std::endl;
+            stream << Misc::StringUtils::format("%02X", (int)(byte));
+        stream << '\n';
 
         if (mPrintPlain)
         {
-            std::cout << "  Script:" << std::endl;
-            std::cout << "START--------------------------------------" << std::endl;
-            std::cout << mData.mScriptText << std::endl;
-            std::cout << "END----------------------------------------" << std::endl;
+            stream << "  Script:\n";
+            stream << "START--------------------------------------\n";
+            stream << mData.mScriptText << '\n';
+            stream << "END----------------------------------------\n";
         }
         else
         {
-            std::cout << "  Script: [skipped]" << std::endl;
+            stream << "  Script: [skipped]\n";
         }
 
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Skill>::print()
+    void Record<ESM::Skill>::print(std::ostream& stream)
     {
         int index = ESM::Skill::refIdToIndex(mData.mId);
-        std::cout << "  ID: " << skillLabel(index) << " (" << index << ")" << std::endl;
-        std::cout << "  Description: " << mData.mDescription << std::endl;
-        std::cout << "  Governing Attribute: " << attributeLabel(mData.mData.mAttribute) << " ("
-                  << mData.mData.mAttribute << ")" << std::endl;
-        std::cout << "  Specialization: " << specializationLabel(mData.mData.mSpecialization) << " ("
-                  << mData.mData.mSpecialization << ")" << std::endl;
+        stream << "  ID: " << skillLabel(index) << " (" << index << ")\n";
+        stream << "  Description: " << mData.mDescription << '\n';
+        stream << "  Governing Attribute: " << attributeLabel(mData.mData.mAttribute) << " ("
+               << mData.mData.mAttribute << ")\n";
+        stream << "  Specialization: " << specializationLabel(mData.mData.mSpecialization) << " ("
+               << mData.mData.mSpecialization << ")\n";
         for (int i = 0; i != 4; i++)
-            std::cout << "  UseValue[" << i << "]:" << mData.mData.mUseValue[i] << std::endl;
+            stream << "  UseValue[" << i << "]:" << mData.mData.mUseValue[i] << '\n';
     }
 
     template <>
-    void Record<ESM::SoundGenerator>::print()
+    void Record<ESM::SoundGenerator>::print(std::ostream& stream)
     {
         if (!mData.mCreature.empty())
-            std::cout << "  Creature: " << mData.mCreature << std::endl;
-        std::cout << "  Sound: " << mData.mSound << std::endl;
-        std::cout << "  Type: " << soundTypeLabel(mData.mType) << " (" << mData.mType << ")" << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Creature: " << mData.mCreature << '\n';
+        stream << "  Sound: " << mData.mSound << '\n';
+        stream << "  Type: " << soundTypeLabel(mData.mType) << " (" << mData.mType << ")\n";
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Sound>::print()
+    void Record<ESM::Sound>::print(std::ostream& stream)
     {
-        std::cout << "  Sound: " << mData.mSound << std::endl;
-        std::cout << "  Volume: " << (int)mData.mData.mVolume << std::endl;
+        stream << "  Sound: " << mData.mSound << '\n';
+        stream << "  Volume: " << (int)mData.mData.mVolume << '\n';
         if (mData.mData.mMinRange != 0 && mData.mData.mMaxRange != 0)
-            std::cout << "  Range: " << (int)mData.mData.mMinRange << " - " << (int)mData.mData.mMaxRange << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Range: " << (int)mData.mData.mMinRange << " - " << (int)mData.mData.mMaxRange << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Spell>::print()
+    void Record<ESM::Spell>::print(std::ostream& stream)
     {
-        std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Type: " << spellTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << std::endl;
-        std::cout << "  Flags: " << spellFlags(mData.mData.mFlags) << std::endl;
-        std::cout << "  Cost: " << mData.mData.mCost << std::endl;
-        printEffectList(mData.mEffects);
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Name: " << mData.mName << '\n';
+        stream << "  Type: " << spellTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")\n";
+        stream << "  Flags: " << spellFlags(mData.mData.mFlags) << '\n';
+        stream << "  Cost: " << mData.mData.mCost << '\n';
+        printEffectList(stream, mData.mEffects);
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::StartScript>::print()
+    void Record<ESM::StartScript>::print(std::ostream& stream)
     {
-        std::cout << "  Start Script: " << mData.mId << std::endl;
-        std::cout << "  Start Data: " << mData.mData << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+        stream << "  Start Script: " << mData.mId << '\n';
+        stream << "  Start Data: " << mData.mData << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<ESM::Static>::print()
+    void Record<ESM::Static>::print(std::ostream& stream)
     {
-        std::cout << "  Model: " << mData.mModel << std::endl;
+        stream << "  Model: " << mData.mModel << '\n';
     }
 
     template <>
-    void Record<ESM::Weapon>::print()
+    void Record<ESM::Weapon>::print(std::ostream& stream)
     {
         // No names on VFX bolts
         if (!mData.mName.empty())
-            std::cout << "  Name: " << mData.mName << std::endl;
-        std::cout << "  Model: " << mData.mModel << std::endl;
+            stream << "  Name: " << mData.mName << '\n';
+        stream << "  Model: " << mData.mModel << '\n';
         // No icons on VFX bolts or magic bolts
         if (!mData.mIcon.empty())
-            std::cout << "  Icon: " << mData.mIcon << std::endl;
+            stream << "  Icon: " << mData.mIcon << '\n';
         if (!mData.mScript.empty())
-            std::cout << "  Script: " << mData.mScript << std::endl;
+            stream << "  Script: " << mData.mScript << '\n';
         if (!mData.mEnchant.empty())
-            std::cout << "  Enchantment: " << mData.mEnchant << std::endl;
-        std::cout << "  Type: " << weaponTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")" << std::endl;
-        std::cout << "  Flags: " << weaponFlags(mData.mData.mFlags) << std::endl;
-        std::cout << "  Weight: " << mData.mData.mWeight << std::endl;
-        std::cout << "  Value: " << mData.mData.mValue << std::endl;
-        std::cout << "  Health: " << mData.mData.mHealth << std::endl;
-        std::cout << "  Speed: " << mData.mData.mSpeed << std::endl;
-        std::cout << "  Reach: " << mData.mData.mReach << std::endl;
-        std::cout << "  Enchantment Points: " << mData.mData.mEnchant << std::endl;
+            stream << "  Enchantment: " << mData.mEnchant << '\n';
+        stream << "  Type: " << weaponTypeLabel(mData.mData.mType) << " (" << mData.mData.mType << ")\n";
+        stream << "  Flags: " << weaponFlags(mData.mData.mFlags) << '\n';
+        stream << "  Weight: " << mData.mData.mWeight << '\n';
+        stream << "  Value: " << mData.mData.mValue << '\n';
+        stream << "  Health: " << mData.mData.mHealth << '\n';
+        stream << "  Speed: " << mData.mData.mSpeed << '\n';
+        stream << "  Reach: " << mData.mData.mReach << '\n';
+        stream << "  Enchantment Points: " << mData.mData.mEnchant << '\n';
         if (mData.mData.mChop[0] != 0 && mData.mData.mChop[1] != 0)
-            std::cout << "  Chop: " << (int)mData.mData.mChop[0] << "-" << (int)mData.mData.mChop[1] << std::endl;
+            stream << "  Chop: " << (int)mData.mData.mChop[0] << "-" << (int)mData.mData.mChop[1] << '\n';
         if (mData.mData.mSlash[0] != 0 && mData.mData.mSlash[1] != 0)
-            std::cout << "  Slash: " << (int)mData.mData.mSlash[0] << "-" << (int)mData.mData.mSlash[1] << std::endl;
+            stream << "  Slash: " << (int)mData.mData.mSlash[0] << "-" << (int)mData.mData.mSlash[1] << '\n';
         if (mData.mData.mThrust[0] != 0 && mData.mData.mThrust[1] != 0)
-            std::cout << "  Thrust: " << (int)mData.mData.mThrust[0] << "-" << (int)mData.mData.mThrust[1] << std::endl;
-        std::cout << "  Deleted: " << mIsDeleted << std::endl;
+            stream << "  Thrust: " << (int)mData.mData.mThrust[0] << "-" << (int)mData.mData.mThrust[1] << '\n';
+        stream << "  Deleted: " << mIsDeleted << '\n';
     }
 
     template <>
-    void Record<CellState>::print()
+    void Record<CellState>::print(std::ostream& stream)
     {
-        std::cout << "  Cell Id: \"" << mData.mCellState.mId.toString() << "\"" << std::endl;
-        std::cout << "  Water Level: " << mData.mCellState.mWaterLevel << std::endl;
-        std::cout << "  Has Fog Of War: " << mData.mCellState.mHasFogOfWar << std::endl;
-        std::cout << "  Last Respawn:" << std::endl;
-        std::cout << "    Day:" << mData.mCellState.mLastRespawn.mDay << std::endl;
-        std::cout << "    Hour:" << mData.mCellState.mLastRespawn.mHour << std::endl;
+        stream << "  Cell Id: \"" << mData.mCellState.mId.toString() << "\"\n";
+        stream << "  Water Level: " << mData.mCellState.mWaterLevel << '\n';
+        stream << "  Has Fog Of War: " << mData.mCellState.mHasFogOfWar << '\n';
+        stream << "  Last Respawn:\n";
+        stream << "    Day:" << mData.mCellState.mLastRespawn.mDay << '\n';
+        stream << "    Hour:" << mData.mCellState.mLastRespawn.mHour << '\n';
         if (mData.mCellState.mHasFogOfWar)
         {
-            std::cout << "  North Marker Angle: " << mData.mFogState.mNorthMarkerAngle << std::endl;
-            std::cout << "  Bounds:" << std::endl;
-            std::cout << "    Min X: " << mData.mFogState.mBounds.mMinX << std::endl;
-            std::cout << "    Min Y: " << mData.mFogState.mBounds.mMinY << std::endl;
-            std::cout << "    Max X: " << mData.mFogState.mBounds.mMaxX << std::endl;
-            std::cout << "    Max Y: " << mData.mFogState.mBounds.mMaxY << std::endl;
+            stream << "  North Marker Angle: " << mData.mFogState.mNorthMarkerAngle << '\n';
+            stream << "  Bounds:\n";
+            stream << "    Min X: " << mData.mFogState.mBounds.mMinX << '\n';
+            stream << "    Min Y: " << mData.mFogState.mBounds.mMinY << '\n';
+            stream << "    Max X: " << mData.mFogState.mBounds.mMaxX << '\n';
+            stream << "    Max Y: " << mData.mFogState.mBounds.mMaxY << '\n';
             for (const ESM::FogTexture& fogTexture : mData.mFogState.mFogTextures)
             {
-                std::cout << "  Fog Texture:" << std::endl;
-                std::cout << "    X: " << fogTexture.mX << std::endl;
-                std::cout << "    Y: " << fogTexture.mY << std::endl;
-                std::cout << "    Image Data: (" << fogTexture.mImageData.size() << ")" << std::endl;
+                stream << "  Fog Texture:\n";
+                stream << "    X: " << fogTexture.mX << '\n';
+                stream << "    Y: " << fogTexture.mY << '\n';
+                stream << "    Image Data: (" << fogTexture.mImageData.size() << ")\n";
             }
         }
     }
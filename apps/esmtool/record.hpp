@@ -1,6 +1,7 @@
 #ifndef OPENMW_ESMTOOL_RECORD_H
 #define OPENMW_ESMTOOL_RECORD_H
 
+#include <iosfwd>
 #include <memory>
 #include <string>
 
@@ -48,7 +49,7 @@ namespace EsmTool
 
         virtual void load(ESM::ESMReader& esm) = 0;
         virtual void save(ESM::ESMWriter& esm) = 0;
-        virtual void print() = 0;
+        virtual void print(std::ostream& stream) = 0;
 
         static std::unique_ptr<RecordBase> create(ESM::NAME type);
 
@@ -90,7 +91,7 @@ namespace EsmTool
 
         void load(ESM::ESMReader& esm) override { mData.load(esm, mIsDeleted); }
 
-        void print() override;
+        void print(std::ostream& stream) override;
     };
 
     template <>
@@ -107,91 +108,91 @@ namespace EsmTool
     std::string Record<CellState>::getId() const;
 
     template <>
-    void Record<ESM::Activator>::print();
+    void Record<ESM::Activator>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Potion>::print();
+    void Record<ESM::Potion>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Armor>::print();
+    void Record<ESM::Armor>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Apparatus>::print();
+    void Record<ESM::Apparatus>::print(std::ostream& stream);
     template <>
-    void Record<ESM::BodyPart>::print();
+    void Record<ESM::BodyPart>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Book>::print();
+    void Record<ESM::Book>::print(std::ostream& stream);
     template <>
-    void Record<ESM::BirthSign>::print();
+    void Record<ESM::BirthSign>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Cell>::print();
+    void Record<ESM::Cell>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Class>::print();
+    void Record<ESM::Class>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Clothing>::print();
+    void Record<ESM::Clothing>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Container>::print();
+    void Record<ESM::Container>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Creature>::print();
+    void Record<ESM::Creature>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Dialogue>::print();
+    void Record<ESM::Dialogue>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Door>::print();
+    void Record<ESM::Door>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Enchantment>::print();
+    void Record<ESM::Enchantment>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Faction>::print();
+    void Record<ESM::Faction>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Global>::print();
+    void Record<ESM::Global>::print(std::ostream& stream);
     template <>
-    void Record<ESM::GameSetting>::print();
+    void Record<ESM::GameSetting>::print(std::ostream& stream);
     template <>
-    void Record<ESM::DialInfo>::print();
+    void Record<ESM::DialInfo>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Ingredient>::print();
+    void Record<ESM::Ingredient>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Land>::print();
+    void Record<ESM::Land>::print(std::ostream& stream);
     template <>
-    void Record<ESM::CreatureLevList>::print();
+    void Record<ESM::CreatureLevList>::print(std::ostream& stream);
     template <>
-    void Record<ESM::ItemLevList>::print();
+    void Record<ESM::ItemLevList>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Light>::print();
+    void Record<ESM::Light>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Lockpick>::print();
+    void Record<ESM::Lockpick>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Probe>::print();
+    void Record<ESM::Probe>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Repair>::print();
+    void Record<ESM::Repair>::print(std::ostream& stream);
     template <>
-    void Record<ESM::LandTexture>::print();
+    void Record<ESM::LandTexture>::print(std::ostream& stream);
     template <>
-    void Record<ESM::MagicEffect>::print();
+    void Record<ESM::MagicEffect>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Miscellaneous>::print();
+    void Record<ESM::Miscellaneous>::print(std::ostream& stream);
     template <>
-    void Record<ESM::NPC>::print();
+    void Record<ESM::NPC>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Pathgrid>::print();
+    void Record<ESM::Pathgrid>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Race>::print();
+    void Record<ESM::Race>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Region>::print();
+    void Record<ESM::Region>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Script>::print();
+    void Record<ESM::Script>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Skill>::print();
+    void Record<ESM::Skill>::print(std::ostream& stream);
     template <>
-    void Record<ESM::SoundGenerator>::print();
+    void Record<ESM::SoundGenerator>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Sound>::print();
+    void Record<ESM::Sound>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Spell>::print();
+    void Record<ESM::Spell>::print(std::ostream& stream);
     template <>
-    void Record<ESM::StartScript>::print();
+    void Record<ESM::StartScript>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Static>::print();
+    void Record<ESM::Static>::print(std::ostream& stream);
     template <>
-    void Record<ESM::Weapon>::print();
+    void Record<ESM::Weapon>::print(std::ostream& stream);
     template <>
-    void Record<CellState>::print();
+    void Record<CellState>::print(std::ostream& stream);
 }
 
 #endif
@@ -1,8 +1,12 @@
 #include "converter.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <future>
 #include <stdexcept>
+#include <type_traits>
+#include <variant>
 
 #include <osgDB/WriteFile>
 
@@ -314,21 +318,19 @@ namespace ESSImport
             mIntCells[cell.mName] = std::move(newcell);
     }
 
-    void ConvertCell::writeCell(const Cell& cell, ESM::ESMWriter& esm)
+    struct ConvertCell::ConvertedRef
     {
-        ESM::Cell esmcell = cell.mCell;
-        esm.startRecord(ESM::REC_CSTA);
-        ESM::CellState csta;
-        csta.mHasFogOfWar = 0;
-        csta.mLastRespawn.mDay = 0;
-        csta.mLastRespawn.mHour = 0;
-        csta.mId = esmcell.mId;
-        csta.mIsInterior = !esmcell.isExterior();
-        esm.writeCellId(csta.mId);
-        // TODO csta.mLastRespawn;
-        // shouldn't be needed if we respawn on global schedule like in original MW
-        csta.mWaterLevel = esmcell.mWater;
-        csta.save(esm);
+        // type written into the OBJE subrecord
+        int mType;
+        std::variant<ESM::ObjectState, ESM::NpcState, ESM::ContainerState, ESM::CreatureState> mState;
+        // key <refIndex, refId> of the actor to assign an actor id to
+        std::pair<int, ESM::RefId> mActor;
+    };
+
+    std::vector<ConvertCell::ConvertedRef> ConvertCell::convertCell(const Cell& cell) const
+    {
+        std::vector<ConvertedRef> result;
+        result.reserve(cell.mRefs.size());
 
         for (const auto& cellref : cell.mRefs)
         {
@@ -348,8 +350,7 @@ namespace ESSImport
                 objstate.mRef.mRefID = out.mRefID;
                 objstate.mHasCustomState = false;
                 convertCellRef(cellref, objstate);
-                esm.writeHNT("OBJE", 0);
-                objstate.save(esm);
+                result.push_back({ 0, std::move(objstate), {} });
                 continue;
             }
             else
@@ -377,13 +378,7 @@ namespace ESSImport
                     convertNpcData(cellref.mActorData, objstate.mNpcStats);
                     convertNPCC(npccIt->second, objstate);
                     convertCellRef(cellref, objstate);
-
-                    objstate.mCreatureStats.mActorId = mContext->generateActorId();
-                    mContext->mActorIdMap.insert(
-                        std::make_pair(std::make_pair(refIndex, out.mRefID), objstate.mCreatureStats.mActorId));
-
-                    esm.writeHNT("OBJE", ESM::REC_NPC_);
-                    objstate.save(esm);
+                    result.push_back({ ESM::REC_NPC_, std::move(objstate), npccIt->first });
                     continue;
                 }
 
@@ -396,8 +391,7 @@ namespace ESSImport
                     objstate.mRef.mRefID = out.mRefID;
                     convertCNTC(cntcIt->second, objstate);
                     convertCellRef(cellref, objstate);
-                    esm.writeHNT("OBJE", ESM::REC_CONT);
-                    objstate.save(esm);
+                    result.push_back({ ESM::REC_CONT, std::move(objstate), {} });
                     continue;
                 }
 
@@ -418,13 +412,7 @@ namespace ESSImport
                         convertACSC(cellref.mActorData.mACSC, objstate.mCreatureStats);
                     convertCREC(crecIt->second, objstate);
                     convertCellRef(cellref, objstate);
-
-                    objstate.mCreatureStats.mActorId = mContext->generateActorId();
-                    mContext->mActorIdMap.insert(
-                        std::make_pair(std::make_pair(refIndex, out.mRefID), objstate.mCreatureStats.mActorId));
-
-                    esm.writeHNT("OBJE", ESM::REC_CREA);
-                    objstate.save(esm);
+                    result.push_back({ ESM::REC_CREA, std::move(objstate), crecIt->first });
                     continue;
                 }
 
@@ -434,16 +422,88 @@ namespace ESSImport
             }
         }
 
+        return result;
+    }
+
+    void ConvertCell::writeCell(const Cell& cell, std::vector<ConvertedRef>& refs, ESM::ESMWriter& esm)
+    {
+        ESM::Cell esmcell = cell.mCell;
+        esm.startRecord(ESM::REC_CSTA);
+        ESM::CellState csta;
+        csta.mHasFogOfWar = 0;
+        csta.mLastRespawn.mDay = 0;
+        csta.mLastRespawn.mHour = 0;
+        csta.mId = esmcell.mId;
+        csta.mIsInterior = !esmcell.isExterior();
+        esm.writeCellId(csta.mId);
+        // TODO csta.mLastRespawn;
+        // shouldn't be needed if we respawn on global schedule like in original MW
+        csta.mWaterLevel = esmcell.mWater;
+        csta.save(esm);
+
+        for (ConvertedRef& ref : refs)
+        {
+            std::visit(
+                [&](auto& objstate) {
+                    using State = std::decay_t<decltype(objstate)>;
+                    if constexpr (std::is_same_v<State, ESM::NpcState> || std::is_same_v<State, ESM::CreatureState>)
+                    {
+                        objstate.mCreatureStats.mActorId = mContext->generateActorId();
+                        mContext->mActorIdMap.insert(std::make_pair(ref.mActor, objstate.mCreatureStats.mActorId));
+                    }
+                    esm.writeHNT("OBJE", ref.mType);
+                    objstate.save(esm);
+                },
+                ref.mState);
+        }
+
         esm.endRecord(ESM::REC_CSTA);
     }
 
     void ConvertCell::write(ESM::ESMWriter& esm)
     {
+        std::vector<const Cell*> cells;
+        cells.reserve(mIntCells.size() + mExtCells.size());
         for (const auto& cell : mIntCells)
-            writeCell(cell.second, esm);
-
+            cells.push_back(&cell.second);
         for (const auto& cell : mExtCells)
-            writeCell(cell.second, esm);
+            cells.push_back(&cell.second);
+
+        // Convert the cells of a batch in parallel and write them in the original order, the batches limit the
+        // number of converted states kept in memory
+        const std::size_t threads = std::max<std::size_t>(mContext->mThreads, 1);
+        const std::size_t batchSize = threads * 16;
+
+        for (std::size_t begin = 0; begin < cells.size(); begin += batchSize)
+        {
+            const std::size_t end = std::min(begin + batchSize, cells.size());
+            std::vector<std::vector<ConvertedRef>> converted(end - begin);
+
+            if (threads <= 1)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    converted[i - begin] = convertCell(*cells[i]);
+            }
+            else
+            {
+                std::atomic_size_t next = begin;
+
+                const auto work = [&] {
+                    for (std::size_t i = next++; i < end; i = next++)
+                        converted[i - begin] = convertCell(*cells[i]);
+                };
+
+                std::vector<std::future<void>> workers;
+                for (std::size_t i = 1; i < threads; ++i)
+                    workers.push_back(std::async(std::launch::async, work));
+                work();
+                for (std::future<void>& worker : workers)
+                    worker.get();
+            }
+
+            for (std::size_t i = begin; i < end; ++i)
+                writeCell(*cells[i], converted[i - begin], esm);
+        }
 
         for (const auto& marker : mMarkers)
         {
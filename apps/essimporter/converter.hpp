@@ -356,7 +356,12 @@ namespace ESSImport
 
         std::vector<ESM::CustomMarker> mMarkers;
 
-        void writeCell(const Cell& cell, ESM::ESMWriter& esm);
+        struct ConvertedRef;
+
+        // Only reads the context, so the cells can be converted in parallel
+        std::vector<ConvertedRef> convertCell(const Cell& cell) const;
+        // Assigns the actor ids, so has to be called in the same order for every conversion
+        void writeCell(const Cell& cell, std::vector<ConvertedRef>& refs, ESM::ESMWriter& esm);
     };
 
     class ConvertKLST : public Converter
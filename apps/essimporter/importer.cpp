@@ -87,11 +87,12 @@ namespace
 namespace ESSImport
 {
 
-    Importer::Importer(
-        const std::filesystem::path& essfile, const std::filesystem::path& outfile, const std::string& encoding)
+    Importer::Importer(const std::filesystem::path& essfile, const std::filesystem::path& outfile,
+        const std::string& encoding, std::size_t threads)
         : mEssFile(essfile)
         , mOutFile(outfile)
         , mEncoding(encoding)
+        , mThreads(threads)
     {
     }
 
@@ -263,6 +264,7 @@ namespace ESSImport
         esm.setEncoder(&encoder);
 
         Context context;
+        context.mThreads = mThreads;
 
         const ESM::Header& header = esm.getHeader();
         context.mPlayerCellName = header.mGameData.mCurrentCell.toString();
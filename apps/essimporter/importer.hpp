@@ -1,7 +1,9 @@
 #ifndef OPENMW_ESSIMPORTER_IMPORTER_H
 #define OPENMW_ESSIMPORTER_IMPORTER_H
 
+#include <cstddef>
 #include <filesystem>
+#include <string>
 
 namespace ESSImport
 {
@@ -9,8 +11,8 @@ namespace ESSImport
     class Importer
     {
     public:
-        Importer(
-            const std::filesystem::path& essfile, const std::filesystem::path& outfile, const std::string& encoding);
+        Importer(const std::filesystem::path& essfile, const std::filesystem::path& outfile,
+            const std::string& encoding, std::size_t threads = 1);
 
         void run();
 
@@ -20,6 +22,7 @@ namespace ESSImport
         std::filesystem::path mEssFile;
         std::filesystem::path mOutFile;
         std::string mEncoding;
+        std::size_t mThreads;
     };
 
 }
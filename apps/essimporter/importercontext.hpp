@@ -1,6 +1,7 @@
 #ifndef OPENMW_ESSIMPORT_CONTEXT_H
 #define OPENMW_ESSIMPORT_CONTEXT_H
 
+#include <cstddef>
 #include <map>
 
 #include <components/esm3/controlsstate.hpp>
@@ -53,6 +54,9 @@ namespace ESSImport
 
         std::vector<SPLM::ActiveSpell> mActiveSpells;
 
+        // number of threads to convert the cell states with
+        std::size_t mThreads = 1;
+
         Context()
             : mDay(0)
             , mMonth(0)
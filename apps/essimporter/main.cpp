@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <thread>
 
 #include <boost/program_options.hpp>
 
@@ -23,6 +25,9 @@ Allowed options)");
         addOption("compare,c", "compare two .ess files");
         addOption("encoding", boost::program_options::value<std::string>()->default_value("win1252"),
             "encoding of the save file");
+        addOption("threads,j",
+            bpo::value<std::size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+            "number of threads to convert the cell states with, the output does not depend on it");
         p_desc.add("mwsave", 1).add("output", 1);
         Files::ConfigurationManager::addCommonOptions(desc);
 
@@ -45,8 +50,9 @@ Allowed options)");
         const auto& essFile = variables["mwsave"].as<Files::MaybeQuotedPath>();
         const auto& outputFile = variables["output"].as<Files::MaybeQuotedPath>();
         std::string encoding = variables["encoding"].as<std::string>();
+        const std::size_t threads = variables["threads"].as<std::size_t>();
 
-        ESSImport::Importer importer(essFile, outputFile, encoding);
+        ESSImport::Importer importer(essFile, outputFile, encoding, threads);
 
         if (variables.count("compare"))
             importer.compare();
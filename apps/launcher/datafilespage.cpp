@@ -138,12 +138,15 @@ Launcher::DataFilesPage::DataFilesPage(const Files::ConfigurationManager& cfg, C
     , mGameSettings(gameSettings)
     , mLauncherSettings(launcherSettings)
     , mNavMeshToolInvoker(new Process::ProcessInvoker(this))
+    , mHeaderCache(Files::pathToQString(cfg.getCachePath() / "contentheaders.cache"))
 {
     ui.setupUi(this);
     setObjectName("DataFilesPage");
     mSelector = new ContentSelectorView::ContentSelector(ui.contentSelectorWidget, /*showOMWScripts=*/true);
     const QString encoding = mGameSettings.value("encoding", { "win1252" }).value;
     mSelector->setEncoding(encoding);
+    mHeaderCache.load();
+    mSelector->setHeaderCache(&mHeaderCache);
 
     QVector<std::pair<QString, QString>> languages = { { "English", tr("English") }, { "French", tr("French") },
         { "German", tr("German") }, { "Italian", tr("Italian") }, { "Polish", tr("Polish") },
@@ -356,6 +359,7 @@ void Launcher::DataFilesPage::populateFileViews(const QString& contentModelName)
         item->setToolTip(tooltip.join('\n'));
     }
     mSelector->sortFiles();
+    mHeaderCache.save();
 
     QList<Config::SettingValue> selectedArchives = mGameSettings.getArchiveList();
     QStringList contentModelSelectedArchives = mLauncherSettings.getArchiveList(contentModelName);
@@ -3,6 +3,7 @@
 
 #include "ui_datafilespage.h"
 
+#include <components/contentselector/model/headercache.hpp>
 #include <components/process/processinvoker.hpp>
 
 #include <QDir>
@@ -126,6 +127,8 @@ namespace Launcher
         Process::ProcessInvoker* mNavMeshToolInvoker;
         NavMeshToolProgress mNavMeshToolProgress;
 
+        ContentSelectorModel::HeaderCache mHeaderCache;
+
         void addArchive(const QString& name, Qt::CheckState selected, int row = -1);
         void addArchivesFromDir(const QString& dir);
         bool moveArchive(QListWidgetItem* listItem, int step);
@@ -121,6 +121,23 @@ namespace NavMeshTool
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
+            addOption("navmeshdb", bpo::value<std::string>()->default_value(""),
+                "path to navmeshdb file, navmesh.db in the user data directory by default");
+
+            addOption("shard-count", bpo::value<std::size_t>()->default_value(1),
+                "split tiles into given number of shards generated by separate processes, each process should use own "
+                "navmeshdb starting from the same state");
+
+            addOption("shard-index", bpo::value<std::size_t>()->default_value(0),
+                "index of the shard to generate by this process, less than shard-count");
+
+            addOption("incremental", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "generate only tiles affected by cells changed since the last run using the same navmeshdb");
+
+            addOption("merge",
+                bpo::value<StringsVector>()->default_value(StringsVector(), "")->multitoken()->composing(),
+                "merge given navmeshdb files generated by shards into navmeshdb instead of generating tiles");
+
             Files::ConfigurationManager::addCommonOptions(result);
 
             return result;
@@ -180,6 +197,19 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const bool incremental = variables["incremental"].as<bool>();
+            const Shard shard{
+                .mIndex = variables["shard-index"].as<std::size_t>(),
+                .mCount = variables["shard-count"].as<std::size_t>(),
+            };
+            const StringsVector& mergedDbPaths = variables["merge"].as<StringsVector>();
+
+            if (shard.mCount < 1 || shard.mIndex >= shard.mCount)
+            {
+                std::cerr << "Invalid shard index: " << shard.mIndex << ", expected < " << shard.mCount
+                          << " and shard count >= 1";
+                return -1;
+            }
 
 #ifdef WIN32
             if (writeBinaryLog)
@@ -190,21 +220,30 @@ namespace NavMeshTool
 
             VFS::Manager vfs;
 
-            VFS::registerArchives(&vfs, fileCollections, archives, true);
-
             Settings::Manager::load(config);
 
+            VFS::registerArchives(&vfs, fileCollections, archives, true, Settings::general().mMemoryMappedArchives);
+
             const DetourNavigator::AgentBounds agentBounds{
                 Settings::game().mActorCollisionShapeType,
                 Settings::game().mDefaultActorPathfindHalfExtents,
             };
             const std::uint64_t maxDbFileSize = Settings::navigator().mMaxNavmeshdbFileSize;
-            const auto dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
+            std::string dbPath = variables["navmeshdb"].as<std::string>();
+            if (dbPath.empty())
+                dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
 
             Log(Debug::Info) << "Using navmeshdb at " << dbPath;
 
             DetourNavigator::NavMeshDb db(dbPath, maxDbFileSize);
 
+            if (!mergedDbPaths.empty())
+            {
+                mergeNavMeshDbs(mergedDbPaths, db);
+                Log(Debug::Info) << "Done";
+                return 0;
+            }
+
             ESM::ReadersCache readers;
             EsmLoader::Query query;
             query.mLoadActivators = true;
@@ -233,7 +272,7 @@ namespace NavMeshTool
                 navigatorSettings, readers, vfs, bulletShapeManager, esmData, processInteriorCells, writeBinaryLog);
 
             const Status status = generateAllNavMeshTiles(agentBounds, navigatorSettings, threadsNumber,
-                removeUnusedTiles, writeBinaryLog, cellsData, std::move(db));
+                removeUnusedTiles, writeBinaryLog, incremental, shard, cellsData, std::move(db));
 
             switch (status)
             {
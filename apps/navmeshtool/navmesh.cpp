@@ -4,6 +4,7 @@
 
 #include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/detournavigator/dbrefgeometryobject.hpp>
 #include <components/detournavigator/generatenavmeshtile.hpp>
 #include <components/detournavigator/gettilespositions.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
@@ -14,6 +15,7 @@
 #include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
 #include <components/detournavigator/tileposition.hpp>
+#include <components/files/hash.hpp>
 #include <components/misc/progressreporter.hpp>
 #include <components/navmeshtool/protocol.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -21,11 +23,19 @@
 
 #include <osg/Vec3f>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
 #include <random>
+#include <span>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,11 +44,13 @@ namespace NavMeshTool
     namespace
     {
         using DetourNavigator::AgentBounds;
+        using DetourNavigator::CellInput;
         using DetourNavigator::GenerateNavMeshTile;
         using DetourNavigator::MeshSource;
         using DetourNavigator::NavMeshDb;
         using DetourNavigator::NavMeshTileInfo;
         using DetourNavigator::PreparedNavMeshData;
+        using DetourNavigator::RecastMesh;
         using DetourNavigator::RecastMeshProvider;
         using DetourNavigator::Settings;
         using DetourNavigator::ShapeId;
@@ -90,6 +102,28 @@ namespace NavMeshTool
 
             std::size_t getProvided() const { return mProvided.load(); }
 
+            // Shards have to assign the same ids to the same shapes to be merged, so resolve the shapes of all objects
+            // in a deterministic order before generating any tile
+            void resolveMeshSources(const std::vector<BulletObject>& objects)
+            {
+                std::map<std::tuple<std::string_view, std::string_view, DetourNavigator::AreaType>, MeshSource> sources;
+                const auto addSource = [&](const BulletObject& object, DetourNavigator::AreaType areaType) {
+                    const osg::ref_ptr<const Resource::BulletShape>& shape = object.getShapeInstance()->getSource();
+                    sources.emplace(std::make_tuple(std::string_view(shape->mFileName),
+                                        std::string_view(shape->mFileHash), areaType),
+                        MeshSource{ shape, object.getObjectTransform(), areaType });
+                };
+                for (const BulletObject& object : objects)
+                {
+                    addSource(object, DetourNavigator::AreaType_ground);
+                    if (object.getShapeInstance()->mAvoidCollisionShape != nullptr)
+                        addSource(object, DetourNavigator::AreaType_null);
+                }
+                const std::lock_guard lock(mMutex);
+                for (const auto& [key, source] : sources)
+                    DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
+            }
+
             std::size_t getInserted() const { return mInserted.load(); }
 
             std::size_t getUpdated() const { return mUpdated.load(); }
@@ -217,6 +251,20 @@ namespace NavMeshTool
                 mDb.vacuum();
             }
 
+            std::vector<CellInput> getCells(ESM::RefId worldspace)
+            {
+                const std::lock_guard lock(mMutex);
+                return mDb.getCells(worldspace);
+            }
+
+            void replaceCells(ESM::RefId worldspace, const std::vector<CellInput>& cells)
+            {
+                const std::lock_guard lock(mMutex);
+                mDb.deleteCells(worldspace);
+                for (const CellInput& cell : cells)
+                    mDb.insertCell(worldspace, cell);
+            }
+
             void removeTilesOutsideRange(ESM::RefId worldspace, const TilesPositionsRange& range)
             {
                 const std::lock_guard lock(mMutex);
@@ -252,18 +300,95 @@ namespace NavMeshTool
                     logGeneratedTilesMessage(provided);
             }
         };
+
+        bool isInShard(const TilePosition& tilePosition, const Shard& shard)
+        {
+            // Don't depend on std::hash to get the same split on different platforms
+            const std::uint64_t x = static_cast<std::uint32_t>(tilePosition.x());
+            const std::uint64_t y = static_cast<std::uint32_t>(tilePosition.y());
+            return (((x << 32) | y) * 0x9E3779B97F4A7C15ull >> 32) % shard.mCount == shard.mIndex;
+        }
+
+        // Everything besides the cells content that affects tile inputs, so changing it changes all cell hashes
+        std::vector<std::byte> makeCellHashSeed(const AgentBounds& agentBounds, const Settings& settings)
+        {
+            const RecastMesh empty(DetourNavigator::Version{}, DetourNavigator::Mesh({}, {}, {}), {}, {}, {}, {});
+            return DetourNavigator::serialize(settings.mRecast, agentBounds, empty, {});
+        }
+
+        std::vector<CellInput> makeCellInputs(const WorldspaceNavMeshInput& input, const std::vector<std::byte>& seed,
+            const TilesPositionsRange& worldspaceRange, const Settings& settings)
+        {
+            std::vector<CellInput> result;
+            result.reserve(input.mCells.size());
+            for (const CellNavMeshInput& cell : input.mCells)
+            {
+                std::string content(reinterpret_cast<const char*>(seed.data()), seed.size());
+                content.append(reinterpret_cast<const char*>(cell.mHash.data()), sizeof(cell.mHash));
+                const std::array<std::uint64_t, 2> hash = Files::getHash(std::span<const char>(content));
+                const std::byte* const hashData = reinterpret_cast<const std::byte*>(hash.data());
+                // Water of interior cells covers the whole worldspace
+                const TilesPositionsRange tilesRange = cell.mAabbInitialized
+                    ? DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(cell.mAabb.m_min),
+                        Misc::Convert::toOsgXY(cell.mAabb.m_max), settings.mRecast)
+                    : worldspaceRange;
+                result.push_back(CellInput{
+                    .mCellPosition = cell.mCellPosition,
+                    .mHash = std::vector<std::byte>(hashData, hashData + sizeof(hash)),
+                    .mTilesRange = tilesRange,
+                });
+            }
+            return result;
+        }
+
+        // Tiles ranges of the cells added, removed or changed since the cells were stored
+        std::vector<TilesPositionsRange> findChangedTilesRanges(
+            const std::vector<CellInput>& stored, const std::vector<CellInput>& cells)
+        {
+            std::map<osg::Vec2i, const CellInput*> storedByPosition;
+            for (const CellInput& cell : stored)
+                storedByPosition.emplace(cell.mCellPosition, &cell);
+            std::vector<TilesPositionsRange> result;
+            for (const CellInput& cell : cells)
+            {
+                const auto it = storedByPosition.find(cell.mCellPosition);
+                if (it == storedByPosition.end())
+                {
+                    result.push_back(cell.mTilesRange);
+                    continue;
+                }
+                if (it->second->mHash != cell.mHash)
+                {
+                    result.push_back(it->second->mTilesRange);
+                    result.push_back(cell.mTilesRange);
+                }
+                storedByPosition.erase(it);
+            }
+            for (const auto& [position, cell] : storedByPosition)
+                result.push_back(cell->mTilesRange);
+            return result;
+        }
     }
 
     Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
-        bool removeUnusedTiles, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
+        bool removeUnusedTiles, bool writeBinaryLog, bool incremental, const Shard& shard, WorldspaceData& data,
+        NavMeshDb&& db)
     {
         Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
 
+        if (shard.mCount > 1)
+            Log(Debug::Info) << "Generating shard " << shard.mIndex << " of " << shard.mCount << " shards";
+
         SceneUtil::WorkQueue workQueue(threadsNumber);
         auto navMeshTileConsumer
             = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog);
+
+        if (shard.mCount > 1)
+            navMeshTileConsumer->resolveMeshSources(data.mObjects);
         std::size_t tiles = 0;
         std::mt19937_64 random;
+        const std::vector<std::byte> cellHashSeed = makeCellHashSeed(agentBounds, settings);
+        std::vector<std::pair<ESM::RefId, std::vector<CellInput>>> worldspacesCells;
 
         for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
         {
@@ -273,10 +398,36 @@ namespace NavMeshTool
             if (removeUnusedTiles)
                 navMeshTileConsumer->removeTilesOutsideRange(input->mWorldspace, range);
 
+            std::vector<CellInput> cells = makeCellInputs(*input, cellHashSeed, range, settings);
+            std::optional<std::vector<TilesPositionsRange>> changedTilesRanges;
+
+            if (incremental)
+            {
+                const std::vector<CellInput> stored = navMeshTileConsumer->getCells(input->mWorldspace);
+                if (stored.empty())
+                    Log(Debug::Info) << "No cells are stored for worldspace \"" << input->mWorldspace
+                                     << "\", generating all tiles";
+                else
+                    changedTilesRanges = findChangedTilesRanges(stored, cells);
+            }
+
             std::vector<TilePosition> worldspaceTiles;
 
-            DetourNavigator::getTilesPositions(
-                range, [&](const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); });
+            DetourNavigator::getTilesPositions(range, [&](const TilePosition& tilePosition) {
+                if (!isInShard(tilePosition, shard))
+                    return;
+                if (changedTilesRanges.has_value()
+                    && std::none_of(changedTilesRanges->begin(), changedTilesRanges->end(),
+                        [&](const TilesPositionsRange& v) { return isInTilesPositionsRange(v, tilePosition); }))
+                    return;
+                worldspaceTiles.push_back(tilePosition);
+            });
+
+            if (changedTilesRanges.has_value())
+                Log(Debug::Info) << "Generating " << worldspaceTiles.size() << " tiles affected by changed cells "
+                                 << "for worldspace \"" << input->mWorldspace << "\"";
+
+            worldspacesCells.emplace_back(input->mWorldspace, std::move(cells));
 
             tiles += worldspaceTiles.size();
 
@@ -295,7 +446,12 @@ namespace NavMeshTool
 
         const Status status = navMeshTileConsumer->wait();
         if (status == Status::Ok)
+        {
+            // Cells are stored only when all their tiles are generated to find them changed by the next run otherwise
+            for (const auto& [worldspace, cells] : worldspacesCells)
+                navMeshTileConsumer->replaceCells(worldspace, cells);
             navMeshTileConsumer->commit();
+        }
 
         const auto inserted = navMeshTileConsumer->getInserted();
         const auto updated = navMeshTileConsumer->getUpdated();
@@ -312,4 +468,18 @@ namespace NavMeshTool
 
         return status;
     }
+
+    void mergeNavMeshDbs(const std::vector<std::string>& paths, NavMeshDb& db)
+    {
+        for (const std::string& path : paths)
+        {
+            Log(Debug::Info) << "Merging navmeshdb at " << path << "...";
+            const DetourNavigator::NavMeshDbMergeStats stats = db.merge(path);
+            Log(Debug::Info) << "Merged " << stats.mShapes << " shapes, " << stats.mTiles << " tiles and "
+                             << stats.mCells << " cells from " << path;
+        }
+
+        Log(Debug::Info) << "Vacuuming the database...";
+        db.vacuum();
+    }
 }
@@ -2,6 +2,8 @@
 #define OPENMW_NAVMESHTOOL_NAVMESH_H
 
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -21,9 +23,19 @@ namespace NavMeshTool
         NotEnoughSpace,
     };
 
+    // Part of the tiles to be generated by a separate process
+    struct Shard
+    {
+        std::size_t mIndex = 0;
+        std::size_t mCount = 1;
+    };
+
     Status generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
         const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles,
-        bool writeBinaryLog, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
+        bool writeBinaryLog, bool incremental, const Shard& shard, WorldspaceData& cellsData,
+        DetourNavigator::NavMeshDb&& db);
+
+    void mergeNavMeshDbs(const std::vector<std::string>& paths, DetourNavigator::NavMeshDb& db);
 }
 
 #endif
@@ -18,6 +18,7 @@
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/lessbyid.hpp>
 #include <components/esmloader/record.hpp>
+#include <components/files/hash.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
@@ -33,12 +34,15 @@
 
 #include <algorithm>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace NavMeshTool
@@ -215,6 +219,32 @@ namespace NavMeshTool
             return { surface, landData.mMinHeight, landData.mMaxHeight };
         }
 
+        template <class T>
+        void addToHash(const T& value, std::string& content)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            content.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void addToHash(const std::string& value, std::string& content)
+        {
+            addToHash(value.size(), content);
+            content.append(value);
+        }
+
+        void addToHash(const HeightfieldShape& shape, std::string& content)
+        {
+            if (const HeightfieldSurface* const surface = std::get_if<HeightfieldSurface>(&shape))
+            {
+                addToHash(surface->mMinHeight, content);
+                addToHash(surface->mMaxHeight, content);
+                content.append(reinterpret_cast<const char*>(surface->mHeights),
+                    surface->mSize * surface->mSize * sizeof(float));
+            }
+            else
+                addToHash(std::get<HeightfieldPlane>(shape).mHeight, content);
+        }
+
         template <class T>
         void serializeToStderr(const T& value)
         {
@@ -292,6 +322,10 @@ namespace NavMeshTool
 
             const auto guard = navMeshInput.mTileCachedRecastMeshManager.makeUpdateGuard();
 
+            CellNavMeshInput cellInput;
+            cellInput.mCellPosition = cellPosition;
+            std::string cellContent;
+
             if (exterior)
             {
                 const auto it
@@ -300,8 +334,10 @@ namespace NavMeshTool
                     = makeHeightfieldShape(it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it, cellPosition,
                         data.mHeightfields, data.mLandData);
 
-                mergeOrAssign(
-                    getAabb(cellPosition, minHeight, maxHeight), navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                const btAABB cellAabb = getAabb(cellPosition, minHeight, maxHeight);
+                mergeOrAssign(cellAabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                mergeOrAssign(cellAabb, cellInput.mAabb, cellInput.mAabbInitialized);
+                addToHash(heightfieldShape, cellContent);
 
                 navMeshInput.mTileCachedRecastMeshManager.addHeightfield(
                     cellPosition, ESM::Land::REAL_SIZE, heightfieldShape, guard.get());
@@ -310,9 +346,12 @@ namespace NavMeshTool
             }
             else
             {
-                if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
+                const bool hasWater = (cell.mData.mFlags & ESM::Cell::HasWater) != 0;
+                if (hasWater)
                     navMeshInput.mTileCachedRecastMeshManager.addWater(
                         cellPosition, std::numeric_limits<int>::max(), cell.mWater, guard.get());
+                addToHash(hasWater, cellContent);
+                addToHash(cell.mWater, cellContent);
             }
 
             forEachObject(cell, esmData, vfs, bulletShapeManager, readers, [&](BulletObject object) {
@@ -322,8 +361,19 @@ namespace NavMeshTool
                 const btTransform& transform = object.getCollisionObject().getWorldTransform();
                 const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
                 mergeOrAssign(aabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                mergeOrAssign(aabb, cellInput.mAabb, cellInput.mAabbInitialized);
                 if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                    navMeshInput.mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
+                {
+                    const btAABB avoidAabb = BulletHelpers::getAabb(*avoid, transform);
+                    navMeshInput.mAabb.merge(avoidAabb);
+                    cellInput.mAabb.merge(avoidAabb);
+                }
+
+                const Resource::BulletShape& source = *object.getShapeInstance()->getSource();
+                addToHash(source.mFileName, cellContent);
+                addToHash(source.mFileHash, cellContent);
+                addToHash(object.getObjectTransform().mPosition, cellContent);
+                addToHash(object.getObjectTransform().mScale, cellContent);
 
                 const ObjectId objectId(++objectsCounter);
                 const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(),
@@ -347,6 +397,9 @@ namespace NavMeshTool
                 data.mObjects.emplace_back(std::move(object));
             });
 
+            cellInput.mHash = Files::getHash(std::span<const char>(cellContent));
+            navMeshInput.mCells.push_back(cellInput);
+
             const auto cellDescription = cell.getDescription();
 
             if (writeBinaryLog)
@@ -11,6 +11,10 @@
 #include <BulletCollision/Gimpact/btBoxCollision.h>
 #include <LinearMath/btVector3.h>
 
+#include <osg/Vec2i>
+
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,12 +50,22 @@ namespace NavMeshTool
     using DetourNavigator::ObjectTransform;
     using DetourNavigator::TileCachedRecastMeshManager;
 
+    // Hash and bounds of everything a cell adds to the navmesh input to find the tiles changed by the cell
+    struct CellNavMeshInput
+    {
+        osg::Vec2i mCellPosition;
+        std::array<std::uint64_t, 2> mHash;
+        btAABB mAabb;
+        bool mAabbInitialized = false;
+    };
+
     struct WorldspaceNavMeshInput
     {
         ESM::RefId mWorldspace;
         TileCachedRecastMeshManager mTileCachedRecastMeshManager;
         btAABB mAabb;
         bool mAabbInitialized = false;
+        std::vector<CellNavMeshInput> mCells;
 
         explicit WorldspaceNavMeshInput(ESM::RefId worldspace, const DetourNavigator::RecastSettings& settings);
     };
@@ -1,10 +1,15 @@
 /// Program to test .nif files both on the FileSystem and in BSA archives.
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
 #include <filesystem>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -59,20 +64,20 @@ std::unique_ptr<VFS::Archive> makeArchive(const std::filesystem::path& path)
     return nullptr;
 }
 
-void readFile(
-    const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs, bool quiet)
+void readFile(const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs,
+    bool quiet, std::ostream& out, std::ostream& err)
 {
     const std::string pathStr = Files::pathToUnicodeString(path);
     const bool isNif = isNIF(path);
     if (!quiet)
     {
         if (isNif)
-            std::cout << "Reading " << (hasExtension(path, ".nif") ? "NIF" : "KF") << " file '" << pathStr << "'";
+            out << "Reading " << (hasExtension(path, ".nif") ? "NIF" : "KF") << " file '" << pathStr << "'";
         else
-            std::cout << "Reading " << (hasExtension(path, ".bgsm") ? "BGSM" : "BGEM") << " file '" << pathStr << "'";
+            out << "Reading " << (hasExtension(path, ".bgsm") ? "BGSM" : "BGEM") << " file '" << pathStr << "'";
         if (!source.empty())
-            std::cout << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
-        std::cout << std::endl;
+            out << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
+        out << std::endl;
     }
     const std::filesystem::path fullPath = !source.empty() ? source / path : path;
     try
@@ -96,13 +101,60 @@ void readFile(
     }
     catch (std::exception& e)
     {
-        std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+        err << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+    }
+}
+
+/// Read the files on multiple threads, printing the messages of each file in the given order
+void readFiles(const std::filesystem::path& source, const std::vector<std::filesystem::path>& paths,
+    const VFS::Manager* vfs, bool quiet, std::size_t threads)
+{
+    if (threads <= 1)
+    {
+        for (const std::filesystem::path& path : paths)
+            readFile(source, path, vfs, quiet, std::cout, std::cerr);
+        return;
+    }
+
+    struct Messages
+    {
+        std::ostringstream mOut;
+        std::ostringstream mErr;
+    };
+
+    // Limits the number of messages kept in memory
+    const std::size_t batchSize = threads * 16;
+
+    for (std::size_t begin = 0; begin < paths.size(); begin += batchSize)
+    {
+        const std::size_t end = std::min(begin + batchSize, paths.size());
+        std::vector<Messages> messages(end - begin);
+        std::atomic_size_t next = begin;
+
+        const auto work = [&] {
+            for (std::size_t i = next++; i < end; i = next++)
+                readFile(source, paths[i], vfs, quiet, messages[i - begin].mOut, messages[i - begin].mErr);
+        };
+
+        std::vector<std::future<void>> workers;
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.push_back(std::async(std::launch::async, work));
+        work();
+        for (std::future<void>& worker : workers)
+            worker.get();
+
+        for (const Messages& v : messages)
+        {
+            std::cout << v.mOut.view() << std::flush;
+            std::cerr << v.mErr.view() << std::flush;
+        }
     }
 }
 
 /// Check all the nif files in a given VFS::Archive
 /// \note Can not read a bsa file inside of a bsa file.
-void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, bool quiet)
+void readVFS(
+    std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, bool quiet, std::size_t threads)
 {
     if (archive == nullptr)
         return;
@@ -114,14 +166,17 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
     vfs.addArchive(std::move(archive));
     vfs.buildIndex();
 
+    std::vector<std::filesystem::path> paths;
     for (const auto& name : vfs.getRecursiveDirectoryIterator())
     {
         if (isNIF(name.value()) || isMaterial(name.value()))
         {
-            readFile(archivePath, name.value(), &vfs, quiet);
+            paths.emplace_back(name.value());
         }
     }
 
+    readFiles(archivePath, paths, &vfs, quiet, threads);
+
     if (!archivePath.empty() && !isBSA(archivePath))
     {
         const Files::Collections fileCollections({ archivePath });
@@ -133,7 +188,7 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
             {
                 try
                 {
-                    readVFS(VFS::makeBsaArchive(file.second), file.second, quiet);
+                    readVFS(VFS::makeBsaArchive(file.second), file.second, quiet, threads);
                 }
                 catch (const std::exception& e)
                 {
@@ -146,7 +201,7 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
 }
 
 bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives,
-    bool& writeDebugLog, bool& quiet)
+    bool& writeDebugLog, bool& quiet, std::size_t& threads)
 {
     bpo::options_description desc(R"(Ensure that OpenMW can use the provided NIF, KF, BGEM/BGSM and BSA/BA2 files
 
@@ -159,6 +214,8 @@ Allowed options)");
     addOption("help,h", "print help message.");
     addOption("write-debug-log,v", "write debug log for unsupported nif files");
     addOption("quiet,q", "do not log read archives/files");
+    addOption("threads,j", bpo::value<std::size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+        "number of threads to read files with");
     addOption("archives", bpo::value<Files::MaybeQuotedPathContainer>(), "path to archive files to provide files");
     addOption("input-file", bpo::value<Files::MaybeQuotedPathContainer>(), "input file");
 
@@ -179,6 +236,7 @@ Allowed options)");
         }
         writeDebugLog = variables.count("write-debug-log") > 0;
         quiet = variables.count("quiet") > 0;
+        threads = variables["threads"].as<std::size_t>();
         if (variables.count("input-file"))
         {
             files = asPathContainer(variables["input-file"].as<Files::MaybeQuotedPathContainer>());
@@ -203,7 +261,8 @@ int main(int argc, char** argv)
     Files::PathContainer files, sources;
     bool writeDebugLog = false;
     bool quiet = false;
-    if (!parseOptions(argc, argv, files, sources, writeDebugLog, quiet))
+    std::size_t threads = 1;
+    if (!parseOptions(argc, argv, files, sources, writeDebugLog, quiet, threads))
         return 1;
 
     Nif::Reader::setLoadUnsupportedFiles(true);
@@ -235,18 +294,26 @@ int main(int argc, char** argv)
         vfs->buildIndex();
     }
 
+    // Consecutive files are read together so they can be read in parallel
+    std::vector<std::filesystem::path> pending;
+
     for (const auto& path : files)
     {
         const std::string pathStr = Files::pathToUnicodeString(path);
+        if (isNIF(path) || isMaterial(path))
+        {
+            pending.push_back(path);
+            continue;
+        }
+
+        readFiles({}, pending, vfs.get(), quiet, threads);
+        pending.clear();
+
         try
         {
-            if (isNIF(path) || isMaterial(path))
-            {
-                readFile({}, path, vfs.get(), quiet);
-            }
-            else if (auto archive = makeArchive(path))
+            if (auto archive = makeArchive(path))
             {
-                readVFS(std::move(archive), path, quiet);
+                readVFS(std::move(archive), path, quiet, threads);
             }
             else
             {
@@ -259,5 +326,8 @@ int main(int argc, char** argv)
             std::cerr << "Failed to read '" << pathStr << "':  " << e.what() << std::endl;
         }
     }
+
+    readFiles({}, pending, vfs.get(), quiet, threads);
+
     return 0;
 }
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <exception>
 #include <filesystem>
+#include <thread>
 
 #include <apps/opencs/model/doc/messages.hpp>
 #include <apps/opencs/model/world/data.hpp>
@@ -17,6 +18,14 @@
 
 #include "document.hpp"
 
+namespace
+{
+    int getPreparsedFiles()
+    {
+        return static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 2u, 5u)) - 1;
+    }
+}
+
 CSMDoc::Loader::Loader()
     : mShouldStop(false)
 {
@@ -100,6 +109,11 @@ void CSMDoc::Loader::load()
         {
             const std::filesystem::path& path = document->getContentFiles()[iter->second.mFile];
 
+            // Following files are preparsed in the background while the current one is merged
+            const int preparsed = std::min(size, iter->second.mFile + getPreparsedFiles());
+            for (int i = iter->second.mFile; i < preparsed; ++i)
+                document->getData().preparse(document->getContentFiles()[i], static_cast<std::size_t>(i));
+
             int steps = document->getData().startLoading(path, iter->second.mFile != editedIndex, /*project*/ false);
             iter->second.mRecordsLeft = true;
             iter->second.mRecordsLoaded = 0;
@@ -112,6 +112,8 @@ void CSMDoc::WriteHeaderStage::perform(int stage, Messages& messages)
     }
 
     mState.getWriter().save(mState.getStream());
+
+    mState.startBufferedWrites();
 }
 
 CSMDoc::WriteDialogueCollectionStage::WriteDialogueCollectionStage(Document& document, SavingState& state, bool journal)
@@ -169,9 +171,9 @@ void CSMDoc::WriteDialogueCollectionStage::perform(int stage, Messages& messages
         }
         else
         {
-            mState.getWriter().startRecord(topic.mModified.sRecordId);
-            topic.mModified.save(mState.getWriter(), topic.mState == CSMWorld::RecordBase::State_Deleted);
-            mState.getWriter().endRecord(topic.mModified.sRecordId);
+            mState.getWriter().startRecord(topic.get().sRecordId);
+            topic.get().save(mState.getWriter(), topic.mState == CSMWorld::RecordBase::State_Deleted);
+            mState.getWriter().endRecord(topic.get().sRecordId);
         }
 
         // write modified selected info records
@@ -376,7 +378,7 @@ void CSMDoc::WriteCellCollectionStage::perform(int stage, Messages& messages)
 
                 CSMWorld::RefIdData::LocalIndex localIndex = refIdData.searchId(refRecord.mRefID);
                 unsigned int recordFlags = refIdData.getRecordFlags(refRecord.mRefID);
-                bool isPersistent = ((recordFlags & ESM::FLAG_Persistent) != 0) || refRecord.mTeleport
+                bool isPersistent = ((recordFlags & ESM::FLAG_Persistent) != 0) || refRecord.getTeleport()
                     || localIndex.second == CSMWorld::UniversalId::Type_Creature
                     || localIndex.second == CSMWorld::UniversalId::Type_Npc;
 
@@ -3,7 +3,9 @@
 
 #include "stage.hpp"
 
+#include <cstddef>
 #include <deque>
+#include <string>
 #include <unordered_map>
 
 #include "../world/idcollection.hpp"
@@ -63,12 +65,19 @@ namespace CSMDoc
         ///< Messages resulting from this stage will be appended to \a messages.
     };
 
+    /// \brief Write the records of a collection
+    ///
+    /// The records are written into a buffer on a separate thread once the header is written and appended to the
+    /// file when the stage is performed.
     template <class CollectionT>
     class WriteCollectionStage : public Stage
     {
         const CollectionT& mCollection;
         SavingState& mState;
         CSMWorld::Scope mScope;
+        std::size_t mBufferedWrite;
+
+        void writeRecord(int index, ESM::ESMWriter& writer) const;
 
     public:
         WriteCollectionStage(
@@ -87,24 +96,34 @@ namespace CSMDoc
         : mCollection(collection)
         , mState(state)
         , mScope(scope)
+        , mBufferedWrite(state.addBufferedWrite(scope == CSMWorld::Scope_Project, [this](ESM::ESMWriter& writer) {
+            for (int i = 0; i < mCollection.getSize(); ++i)
+                writeRecord(i, writer);
+        }))
     {
     }
 
     template <class CollectionT>
     int WriteCollectionStage<CollectionT>::setup()
     {
-        return mCollection.getSize();
+        return 1;
     }
 
     template <class CollectionT>
     void WriteCollectionStage<CollectionT>::perform(int stage, Messages& messages)
     {
-        if (CSMWorld::getScopeFromId(mCollection.getRecord(stage).get().mId) != mScope)
+        const std::string buffer = mState.takeBufferedWrite(mBufferedWrite);
+        mState.getStream().write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    template <class CollectionT>
+    void WriteCollectionStage<CollectionT>::writeRecord(int index, ESM::ESMWriter& writer) const
+    {
+        if (CSMWorld::getScopeFromId(mCollection.getRecord(index).get().mId) != mScope)
             return;
 
-        ESM::ESMWriter& writer = mState.getWriter();
-        CSMWorld::RecordBase::State state = mCollection.getRecord(stage).mState;
-        typename CollectionT::ESXRecord record = mCollection.getRecord(stage).get();
+        CSMWorld::RecordBase::State state = mCollection.getRecord(index).mState;
+        typename CollectionT::ESXRecord record = mCollection.getRecord(index).get();
 
         if (state == CSMWorld::RecordBase::State_Modified || state == CSMWorld::RecordBase::State_ModifiedOnly
             || state == CSMWorld::RecordBase::State_Deleted)
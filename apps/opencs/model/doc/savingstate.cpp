@@ -1,6 +1,8 @@
 #include "savingstate.hpp"
 
 #include <filesystem>
+#include <sstream>
+#include <stdexcept>
 #include <utility>
 
 #include "document.hpp"
@@ -8,6 +10,7 @@
 
 CSMDoc::SavingState::SavingState(Operation& operation, std::filesystem::path projectPath, ToUTF8::FromType encoding)
     : mOperation(operation)
+    , mEncoding(encoding)
     , mEncoder(encoding)
     , mProjectPath(std::move(projectPath))
     , mProjectFile(false)
@@ -15,6 +18,23 @@ CSMDoc::SavingState::SavingState(Operation& operation, std::filesystem::path pro
     mWriter.setEncoder(&mEncoder);
 }
 
+CSMDoc::SavingState::~SavingState()
+{
+    waitForBufferedWrites();
+}
+
+void CSMDoc::SavingState::waitForBufferedWrites()
+{
+    // Writes of an aborted or failed save may still be running
+    for (BufferedWrite& write : mBufferedWrites)
+    {
+        if (write.mResult.valid())
+            write.mResult.wait();
+
+        write.mResult = std::future<std::string>();
+    }
+}
+
 bool CSMDoc::SavingState::hasError() const
 {
     return mOperation.hasError();
@@ -31,6 +51,8 @@ void CSMDoc::SavingState::start(Document& document, bool project)
 
     mSubRecords.clear();
 
+    waitForBufferedWrites();
+
     if (project)
         mPath = mProjectPath;
     else
@@ -85,3 +107,48 @@ void CSMDoc::SavingState::clearSubRecords()
 {
     mSubRecords.clear();
 }
+
+std::size_t CSMDoc::SavingState::addBufferedWrite(bool projectFile, std::function<void(ESM::ESMWriter&)> write)
+{
+    mBufferedWrites.push_back(BufferedWrite{ projectFile, std::move(write), std::future<std::string>() });
+    return mBufferedWrites.size() - 1;
+}
+
+void CSMDoc::SavingState::startBufferedWrites()
+{
+    const unsigned int version = mWriter.getVersion();
+    const ESM::FormatVersion formatVersion = mWriter.getFormatVersion();
+
+    for (BufferedWrite& write : mBufferedWrites)
+    {
+        if (write.mProjectFile != mProjectFile)
+            continue;
+
+        write.mResult = std::async(
+            std::launch::async, [&function = write.mWrite, encoding = mEncoding, version, formatVersion] {
+                // Utf8Encoder reuses its conversion buffers, so it can't be shared between threads
+                ToUTF8::Utf8Encoder encoder(encoding);
+                ESM::ESMWriter writer;
+                writer.setEncoder(&encoder);
+                writer.setVersion(version);
+                writer.setFormatVersion(formatVersion);
+
+                std::ostringstream stream;
+                writer.saveWithoutHeader(stream);
+                function(writer);
+                writer.close();
+
+                return std::move(stream).str();
+            });
+    }
+}
+
+std::string CSMDoc::SavingState::takeBufferedWrite(std::size_t index)
+{
+    std::future<std::string> result = std::move(mBufferedWrites.at(index).mResult);
+
+    if (!result.valid())
+        throw std::logic_error("buffered write has not been started");
+
+    return result.get();
+}
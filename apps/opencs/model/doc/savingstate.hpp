@@ -4,8 +4,11 @@
 #include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <components/esm3/esmwriter.hpp>
 #include <components/misc/algorithm.hpp>
@@ -18,19 +21,32 @@ namespace CSMDoc
 
     class SavingState
     {
+        struct BufferedWrite
+        {
+            bool mProjectFile;
+            std::function<void(ESM::ESMWriter&)> mWrite;
+            std::future<std::string> mResult;
+        };
+
         Operation& mOperation;
         std::filesystem::path mPath;
         std::filesystem::path mTmpPath;
+        ToUTF8::FromType mEncoding;
         ToUTF8::Utf8Encoder mEncoder;
         std::ofstream mStream;
         ESM::ESMWriter mWriter;
         std::filesystem::path mProjectPath;
         bool mProjectFile;
         std::map<ESM::RefId, std::deque<int>> mSubRecords; // record ID, list of subrecords
+        std::vector<BufferedWrite> mBufferedWrites;
+
+        void waitForBufferedWrites();
 
     public:
         SavingState(Operation& operation, std::filesystem::path projectPath, ToUTF8::FromType encoding);
 
+        ~SavingState();
+
         bool hasError() const;
 
         void start(Document& document, bool project);
@@ -52,6 +68,20 @@ namespace CSMDoc
         std::deque<int>& getOrInsertSubRecord(const ESM::RefId& refId);
 
         void clearSubRecords();
+
+        std::size_t addBufferedWrite(bool projectFile, std::function<void(ESM::ESMWriter&)> write);
+        ///< Register records that are written into a buffer on a separate thread while the preceding stages of the
+        /// file are performed. Must not be called after the saving has started.
+        ///
+        /// \param projectFile Write to the project file instead of the content file.
+        /// \return Index of the buffer for takeBufferedWrite
+
+        void startBufferedWrites();
+        ///< Start writing the buffers of the current file. The writers use the version and the format version of
+        /// the main writer, so this needs to be called after the header is written.
+
+        std::string takeBufferedWrite(std::size_t index);
+        ///< Wait for a buffer of the current file to be written. Exceptions thrown by the writing are rethrown.
     };
 
 }
@@ -8,13 +8,38 @@ CSMFilter::AndNode::AndNode(const std::vector<std::shared_ptr<Node>>& nodes)
 {
 }
 
-bool CSMFilter::AndNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
+bool CSMFilter::AndNode::test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const
 {
     int size = getSize();
 
     for (int i = 0; i < size; ++i)
-        if (!(*this)[i].test(table, row, columns))
+        if (!(*this)[i].test(snapshot, row, columns))
             return false;
 
     return true;
 }
+
+bool CSMFilter::AndNode::findRows(
+    const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const
+{
+    int size = getSize();
+
+    // The rows found by one of the children are the candidates to test the others on
+    for (int i = 0; i < size; ++i)
+    {
+        std::vector<int> candidates;
+
+        if (!(*this)[i].findRows(snapshot, columns, candidates))
+            continue;
+
+        rows.clear();
+
+        for (int row : candidates)
+            if (test(snapshot, row, columns))
+                rows.push_back(row);
+
+        return true;
+    }
+
+    return false;
+}
@@ -1,16 +1,11 @@
 #include "booleannode.hpp"
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
-
 CSMFilter::BooleanNode::BooleanNode(bool true_)
     : mTrue(true_)
 {
 }
 
-bool CSMFilter::BooleanNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
+bool CSMFilter::BooleanNode::test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const
 {
     return mTrue;
 }
@@ -6,13 +6,10 @@
 
 #include "leafnode.hpp"
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
-
 namespace CSMFilter
 {
+    class Snapshot;
+
     class BooleanNode : public LeafNode
     {
         bool mTrue;
@@ -20,7 +17,7 @@ namespace CSMFilter
     public:
         BooleanNode(bool true_);
 
-        bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const override;
+        bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const override;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
 
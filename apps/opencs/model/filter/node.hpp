@@ -8,13 +8,10 @@
 
 #include <QMetaType>
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
-
 namespace CSMFilter
 {
+    class Snapshot;
+
     /// \brief Root class for the filter node hierarchy
     ///
     /// \note When the function documentation for this class mentions "this node", this should be
@@ -27,10 +24,20 @@ namespace CSMFilter
         Node& operator=(const Node&) = delete;
         virtual ~Node() = default;
 
-        virtual bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const = 0;
+        virtual bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const = 0;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
 
+        virtual bool findRows(const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const
+        {
+            return false;
+        }
+        ///< Look up the table rows which can pass through this node without testing each row, e.g. in a column
+        /// index.
+        ///
+        /// \param rows Receives the sorted rows, if the lookup is supported
+        /// \return Is the lookup supported by this node?
+
         virtual std::vector<int> getReferencedColumns() const = 0;
         ///< Return a list of the IDs of the columns referenced by this node. The column mapping
         /// passed into test as columns must contain all columns listed here.
@@ -6,20 +6,17 @@
 
 #include "unarynode.hpp"
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
-
 namespace CSMFilter
 {
     class Node;
+    class Snapshot;
+
     class NotNode : public UnaryNode
     {
     public:
         NotNode(std::shared_ptr<Node> child);
 
-        bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const override;
+        bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const override;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
     };
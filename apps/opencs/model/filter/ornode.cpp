@@ -3,23 +3,46 @@
 #include <apps/opencs/model/filter/narynode.hpp>
 #include <apps/opencs/model/filter/node.hpp>
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
 CSMFilter::OrNode::OrNode(const std::vector<std::shared_ptr<Node>>& nodes)
     : NAryNode(nodes, "or")
 {
 }
 
-bool CSMFilter::OrNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
+bool CSMFilter::OrNode::test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const
 {
     int size = getSize();
 
     for (int i = 0; i < size; ++i)
-        if ((*this)[i].test(table, row, columns))
+        if ((*this)[i].test(snapshot, row, columns))
             return true;
 
     return false;
 }
+
+bool CSMFilter::OrNode::findRows(
+    const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const
+{
+    int size = getSize();
+
+    std::vector<int> found;
+
+    for (int i = 0; i < size; ++i)
+    {
+        std::vector<int> candidates;
+
+        if (!(*this)[i].findRows(snapshot, columns, candidates))
+            return false;
+
+        std::vector<int> merged;
+        std::set_union(found.begin(), found.end(), candidates.begin(), candidates.end(), std::back_inserter(merged));
+        found = std::move(merged);
+    }
+
+    rows = std::move(found);
+
+    return true;
+}
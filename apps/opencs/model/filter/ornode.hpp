@@ -7,22 +7,27 @@
 #include <memory>
 #include <vector>
 
-namespace CSMWorld
-{
-    class IdTableBase;
-}
-
 namespace CSMFilter
 {
     class Node;
+    class Snapshot;
+
     class OrNode : public NAryNode
     {
     public:
         OrNode(const std::vector<std::shared_ptr<Node>>& nodes);
 
-        bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const override;
+        bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const override;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
+
+        bool findRows(
+            const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const override;
+        ///< Look up the table rows which can pass through this node without testing each row, e.g. in a column
+        /// index.
+        ///
+        /// \param rows Receives the sorted rows, if the lookup is supported
+        /// \return Is the lookup supported by this node?
     };
 }
 
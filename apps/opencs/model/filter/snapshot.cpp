@@ -0,0 +1,117 @@
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "../world/columns.hpp"
+#include "../world/idtablebase.hpp"
+
+#include "node.hpp"
+
+CSMFilter::Snapshot::Snapshot(const CSMWorld::IdTableBase& table, int firstRow, int rows,
+    const std::map<int, int>& columns, const Snapshot* previous)
+    : mFirstRow(firstRow)
+    , mRows(rows)
+{
+    const bool reuse = previous != nullptr && previous->mFirstRow == firstRow && previous->mRows == rows;
+
+    for (const auto& [columnId, columnIndex] : columns)
+    {
+        if (columnIndex == -1 || mColumns.contains(columnIndex))
+            continue;
+
+        if (reuse)
+        {
+            const auto iter = previous->mColumns.find(columnIndex);
+            if (iter != previous->mColumns.end())
+            {
+                mColumns.emplace(columnIndex, iter->second);
+                continue;
+            }
+        }
+
+        auto column = std::make_shared<Column>();
+        column->mColumnId = columnId;
+        column->mValues.reserve(static_cast<std::size_t>(rows));
+        for (int row = firstRow; row < firstRow + rows; ++row)
+            column->mValues.push_back(table.data(table.index(row, columnIndex)));
+        mColumns.emplace(columnIndex, std::move(column));
+    }
+}
+
+const QVariant& CSMFilter::Snapshot::getData(int row, int column) const
+{
+    const auto iter = mColumns.find(column);
+
+    if (iter == mColumns.end() || row < mFirstRow || row >= mFirstRow + mRows)
+        throw std::logic_error("invalid cell in filter snapshot");
+
+    return iter->second->mValues[static_cast<std::size_t>(row - mFirstRow)];
+}
+
+const CSMFilter::Snapshot::Index& CSMFilter::Snapshot::getIndex(int column) const
+{
+    const auto iter = mColumns.find(column);
+
+    if (iter == mColumns.end())
+        throw std::logic_error("invalid column in filter snapshot");
+
+    const Column& data = *iter->second;
+
+    std::call_once(data.mIndexed, [&] {
+        for (std::size_t i = 0; i < data.mValues.size(); ++i)
+            if (const std::optional<QString> text = getText(data.mColumnId, data.mValues[i]))
+                data.mIndex.emplace_back(text->toCaseFolded(), mFirstRow + static_cast<int>(i));
+
+        std::sort(data.mIndex.begin(), data.mIndex.end());
+    });
+
+    return data.mIndex;
+}
+
+std::optional<QString> CSMFilter::Snapshot::getText(int columnId, const QVariant& data)
+{
+    if (data.type() == QVariant::String)
+        return data.toString();
+
+    if ((data.type() == QVariant::Int || data.type() == QVariant::UInt)
+        && CSMWorld::Columns::hasEnums(static_cast<CSMWorld::Columns::ColumnId>(columnId)))
+    {
+        int value = data.toInt();
+
+        std::vector<std::pair<int, std::string>> enums
+            = CSMWorld::Columns::getEnums(static_cast<CSMWorld::Columns::ColumnId>(columnId));
+
+        if (value >= 0 && value < static_cast<int>(enums.size()))
+            return QString::fromUtf8(enums[value].second.c_str());
+
+        return QString();
+    }
+
+    if (data.type() == QVariant::Bool)
+        return QString(data.toBool() ? "true" : "false");
+
+    return std::nullopt;
+}
+
+std::vector<bool> CSMFilter::findAcceptedRows(
+    const Node& filter, const Snapshot& snapshot, const std::map<int, int>& columns)
+{
+    std::vector<bool> accepted(static_cast<std::size_t>(snapshot.getRows()), false);
+
+    std::vector<int> rows;
+
+    if (filter.findRows(snapshot, columns, rows))
+    {
+        for (int row : rows)
+            accepted[static_cast<std::size_t>(row - snapshot.getFirstRow())] = true;
+
+        return accepted;
+    }
+
+    for (int i = 0; i < snapshot.getRows(); ++i)
+        accepted[static_cast<std::size_t>(i)] = filter.test(snapshot, snapshot.getFirstRow() + i, columns);
+
+    return accepted;
+}
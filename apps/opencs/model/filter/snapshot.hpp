@@ -0,0 +1,69 @@
+#ifndef CSM_FILTER_SNAPSHOT_H
+#define CSM_FILTER_SNAPSHOT_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <QString>
+#include <QVariant>
+
+namespace CSMWorld
+{
+    class IdTableBase;
+}
+
+namespace CSMFilter
+{
+    class Node;
+
+    /// \brief Copy of the table columns referenced by a filter, so the filter can be evaluated away from the GUI
+    /// thread
+    class Snapshot
+    {
+    public:
+        /// Case folded texts of the column values with their rows, sorted for equality and prefix lookups
+        using Index = std::vector<std::pair<QString, int>>;
+
+        /// \param columns column ID to column index mapping, columns with the index -1 are skipped
+        /// \param previous Snapshot of the same table data to reuse the copied columns and their indices of
+        Snapshot(const CSMWorld::IdTableBase& table, int firstRow, int rows, const std::map<int, int>& columns,
+            const Snapshot* previous = nullptr);
+
+        int getFirstRow() const { return mFirstRow; }
+
+        int getRows() const { return mRows; }
+
+        const QVariant& getData(int row, int column) const;
+        ///< \param row table row
+        /// \param column table column index
+
+        const Index& getIndex(int column) const;
+        ///< Built on the first use, can be called from any thread.
+
+        static std::optional<QString> getText(int columnId, const QVariant& data);
+        ///< \return Text a value is matched as by text nodes, nothing if such values never match
+
+    private:
+        struct Column
+        {
+            int mColumnId;
+            std::vector<QVariant> mValues;
+            mutable std::once_flag mIndexed;
+            mutable Index mIndex;
+        };
+
+        int mFirstRow;
+        int mRows;
+        std::map<int, std::shared_ptr<const Column>> mColumns; // by column index
+    };
+
+    std::vector<bool> findAcceptedRows(
+        const Node& filter, const Snapshot& snapshot, const std::map<int, int>& columns);
+    ///< \return For each row of the snapshot, can it pass through the filter?
+}
+
+#endif
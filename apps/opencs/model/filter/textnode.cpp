@@ -1,5 +1,6 @@
 #include "textnode.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -8,17 +9,32 @@
 #include <QRegularExpression>
 
 #include "../world/columns.hpp"
-#include "../world/idtablebase.hpp"
+
+#include "snapshot.hpp"
 
 CSMFilter::TextNode::TextNode(int columnId, const std::string& text)
     : mColumnId(columnId)
     , mText(text)
     , mRegExp(QRegularExpression::anchoredPattern(QString::fromUtf8(mText.c_str())),
           QRegularExpression::CaseInsensitiveOption)
+    , mPrefix(false)
 {
+    // Patterns without special characters other than a trailing .* are looked up in the column index
+    std::string literal = mText;
+
+    if (literal.size() > 2 && literal.ends_with(".*"))
+    {
+        literal.resize(literal.size() - 2);
+        mPrefix = true;
+    }
+
+    if (!literal.empty() && literal.find_first_of("\\^$.|?*+()[]{}") == std::string::npos)
+        mLiteral = QString::fromUtf8(literal.c_str()).toCaseFolded();
+    else
+        mPrefix = false;
 }
 
-bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
+bool CSMFilter::TextNode::test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const
 {
     const std::map<int, int>::const_iterator iter = columns.find(mColumnId);
 
@@ -28,40 +44,51 @@ bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, cons
     if (iter->second == -1)
         return true;
 
-    QModelIndex index = table.index(row, iter->second);
+    const QVariant& data = snapshot.getData(row, iter->second);
 
-    QVariant data = table.data(index);
+    const std::optional<QString> string = Snapshot::getText(mColumnId, data);
 
-    QString string;
+    if (!string.has_value())
+        return mText.empty() && !data.isValid();
 
-    if (data.type() == QVariant::String)
-    {
-        string = data.toString();
-    }
-    else if ((data.type() == QVariant::Int || data.type() == QVariant::UInt)
-        && CSMWorld::Columns::hasEnums(static_cast<CSMWorld::Columns::ColumnId>(mColumnId)))
-    {
-        int value = data.toInt();
+    /// \todo make pattern syntax configurable
+    QRegularExpressionMatch match = mRegExp.match(*string);
 
-        std::vector<std::pair<int, std::string>> enums
-            = CSMWorld::Columns::getEnums(static_cast<CSMWorld::Columns::ColumnId>(mColumnId));
+    return match.hasMatch();
+}
 
-        if (value >= 0 && value < static_cast<int>(enums.size()))
-            string = QString::fromUtf8(enums[value].second.c_str());
-    }
-    else if (data.type() == QVariant::Bool)
+bool CSMFilter::TextNode::findRows(
+    const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const
+{
+    if (!mLiteral.has_value())
+        return false;
+
+    const std::map<int, int>::const_iterator iter = columns.find(mColumnId);
+
+    if (iter == columns.end())
+        throw std::logic_error("invalid column in text node test");
+
+    if (iter->second == -1)
+        return false;
+
+    const Snapshot::Index& index = snapshot.getIndex(iter->second);
+
+    auto begin = std::lower_bound(index.begin(), index.end(), *mLiteral,
+        [](const std::pair<QString, int>& entry, const QString& text) { return entry.first < text; });
+
+    rows.clear();
+
+    for (auto entry = begin; entry != index.end(); ++entry)
     {
-        string = data.toBool() ? "true" : "false";
+        if (mPrefix ? !entry->first.startsWith(*mLiteral) : entry->first != *mLiteral)
+            break;
+
+        rows.push_back(entry->second);
     }
-    else if (mText.empty() && !data.isValid())
-        return true;
-    else
-        return false;
 
-    /// \todo make pattern syntax configurable
-    QRegularExpressionMatch match = mRegExp.match(string);
+    std::sort(rows.begin(), rows.end());
 
-    return match.hasMatch();
+    return true;
 }
 
 std::vector<int> CSMFilter::TextNode::getReferencedColumns() const
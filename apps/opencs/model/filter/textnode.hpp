@@ -2,30 +2,43 @@
 #define CSM_FILTER_TEXTNODE_H
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <QRegularExpression>
+#include <QString>
 
-#include <apps/opencs/model/world/idtablebase.hpp>
 
 #include "leafnode.hpp"
 
 namespace CSMFilter
 {
+    class Snapshot;
+
     class TextNode : public LeafNode
     {
         int mColumnId;
         std::string mText;
         QRegularExpression mRegExp;
+        std::optional<QString> mLiteral; // case folded text, if the pattern matches it literally
+        bool mPrefix; // the pattern matches any text starting with the literal
 
     public:
         TextNode(int columnId, const std::string& text);
 
-        bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const override;
+        bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const override;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
 
+        bool findRows(
+            const Snapshot& snapshot, const std::map<int, int>& columns, std::vector<int>& rows) const override;
+        ///< Look up the table rows which can pass through this node without testing each row, e.g. in a column
+        /// index.
+        ///
+        /// \param rows Receives the sorted rows, if the lookup is supported
+        /// \return Is the lookup supported by this node?
+
         std::vector<int> getReferencedColumns() const override;
         ///< Return a list of the IDs of the columns referenced by this node. The column mapping
         /// passed into test as columns must contain all columns listed here.
@@ -4,7 +4,7 @@
 #include <stdexcept>
 #include <utility>
 
-#include "../world/idtablebase.hpp"
+#include "snapshot.hpp"
 
 CSMFilter::ValueNode::ValueNode(int columnId, Type lowerType, Type upperType, double lower, double upper)
     : mColumnId(columnId)
@@ -15,7 +15,7 @@ CSMFilter::ValueNode::ValueNode(int columnId, Type lowerType, Type upperType, do
 {
 }
 
-bool CSMFilter::ValueNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
+bool CSMFilter::ValueNode::test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const
 {
     const std::map<int, int>::const_iterator iter = columns.find(mColumnId);
 
@@ -25,9 +25,7 @@ bool CSMFilter::ValueNode::test(const CSMWorld::IdTableBase& table, int row, con
     if (iter->second == -1)
         return true;
 
-    QModelIndex index = table.index(row, iter->second);
-
-    QVariant data = table.data(index);
+    const QVariant& data = snapshot.getData(row, iter->second);
 
     if (data.type() != QVariant::Double && data.type() != QVariant::Bool && data.type() != QVariant::Int
         && data.type() != QVariant::UInt && data.type() != static_cast<QVariant::Type>(QMetaType::Float))
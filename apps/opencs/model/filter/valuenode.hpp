@@ -3,7 +3,6 @@
 
 #include "leafnode.hpp"
 
-#include <apps/opencs/model/world/idtablebase.hpp>
 
 #include <map>
 #include <string>
@@ -11,6 +10,8 @@
 
 namespace CSMFilter
 {
+    class Snapshot;
+
     class ValueNode : public LeafNode
     {
     public:
@@ -32,7 +33,7 @@ namespace CSMFilter
     public:
         ValueNode(int columnId, Type lowerType, Type upperType, double lower, double upper);
 
-        bool test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const override;
+        bool test(const Snapshot& snapshot, int row, const std::map<int, int>& columns) const override;
         ///< \return Can the specified table row pass through to filter?
         /// \param columns column ID to column index mapping
 
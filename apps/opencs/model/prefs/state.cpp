@@ -202,6 +202,13 @@ void CSMPrefs::State::declare()
             "Sets the gradient color to use in conjunction with the night background color. Ignored if "
             "the gradient option is disabled.");
     declareBool(mValues->mRendering.mSceneDayNightSwitchNodes, "Use Day/Night Switch Nodes");
+    declareBool(mValues->mRendering.mDistantTerrain, "Distant Terrain")
+        .setTooltip(
+            "Render the terrain around the cells loaded in a scene with lower detail. Cells have to be loaded to be "
+            "edited.");
+    declareInt(mValues->mRendering.mDistantTerrainViewDistance, "Distant Terrain View Distance")
+        .setTooltip("Distance in cells up to which the distant terrain is rendered.")
+        .setRange(1, 256);
 
     declareCategory("Tooltips");
     declareBool(mValues->mTooltips.mScene, "Show Tooltips in 3D scenes");
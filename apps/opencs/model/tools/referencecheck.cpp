@@ -67,33 +67,33 @@ void CSMTools::ReferenceCheckStage::perform(int stage, CSMDoc::Messages& message
     }
 
     // If object have owner, check if that owner reference is valid
-    if (!cellRef.mOwner.empty() && mObjects.searchId(cellRef.mOwner) == -1)
-        messages.add(id, "Owner object '" + cellRef.mOwner.getRefIdString() + "' does not exist", "",
+    if (!cellRef.getOwner().empty() && mObjects.searchId(cellRef.getOwner()) == -1)
+        messages.add(id, "Owner object '" + cellRef.getOwner().getRefIdString() + "' does not exist", "",
             CSMDoc::Message::Severity_Error);
 
     // If object have creature soul trapped, check if that creature reference is valid
-    if (!cellRef.mSoul.empty())
-        if (mObjects.searchId(cellRef.mSoul) == -1)
-            messages.add(id, "Trapped soul object '" + cellRef.mSoul.getRefIdString() + "' does not exist", "",
+    if (!cellRef.getSoul().empty())
+        if (mObjects.searchId(cellRef.getSoul()) == -1)
+            messages.add(id, "Trapped soul object '" + cellRef.getSoul().getRefIdString() + "' does not exist", "",
                 CSMDoc::Message::Severity_Error);
 
-    if (cellRef.mFaction.empty())
+    if (cellRef.getFaction().empty())
     {
-        if (cellRef.mFactionRank != -2)
+        if (cellRef.getFactionRank() != -2)
             messages.add(id, "Reference without a faction has a faction rank", "", CSMDoc::Message::Severity_Error);
     }
     else
     {
-        if (mFactions.searchId(cellRef.mFaction) == -1)
-            messages.add(id, "Faction '" + cellRef.mFaction.getRefIdString() + "' does not exist", "",
+        if (mFactions.searchId(cellRef.getFaction()) == -1)
+            messages.add(id, "Faction '" + cellRef.getFaction().getRefIdString() + "' does not exist", "",
                 CSMDoc::Message::Severity_Error);
-        else if (cellRef.mFactionRank < -1)
+        else if (cellRef.getFactionRank() < -1)
             messages.add(id, "Invalid faction rank", "", CSMDoc::Message::Severity_Error);
     }
 
-    if (!cellRef.mDestCell.empty() && mCells.searchId(ESM::RefId::stringRefId(cellRef.mDestCell)) == -1)
+    if (!cellRef.getDestCell().empty() && mCells.searchId(ESM::RefId::stringRefId(cellRef.getDestCell())) == -1)
         messages.add(
-            id, "Destination cell '" + cellRef.mDestCell + "' does not exist", "", CSMDoc::Message::Severity_Error);
+            id, "Destination cell '" + cellRef.getDestCell() + "' does not exist", "", CSMDoc::Message::Severity_Error);
 
     if (cellRef.mScale < 0)
         messages.add(id, "Negative scale", "", CSMDoc::Message::Severity_Error);
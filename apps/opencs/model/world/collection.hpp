@@ -285,7 +285,7 @@ namespace CSMWorld
         const ESM::RefId& origin, const ESM::RefId& destination, UniversalId::Type type)
     {
         auto copy = std::make_unique<Record<ESXRecordT>>();
-        copy->mModified = getRecord(origin).get();
+        copy->getModified() = getRecord(origin).get();
         copy->mState = RecordBase::State_ModifiedOnly;
         setRecordId(destination, copy->get());
 
@@ -293,14 +293,14 @@ namespace CSMWorld
         {
             if (type == UniversalId::Type_Reference)
             {
-                CSMWorld::CellRef* ptr = (CSMWorld::CellRef*)&copy->mModified;
+                CSMWorld::CellRef* ptr = &copy->getModified();
                 ptr->mRefNum.mIndex = 0;
             }
         }
 
         if constexpr (std::is_same_v<ESXRecordT, ESM::Dialogue>)
         {
-            copy->mModified.mStringId = copy->mModified.mId.getRefIdString();
+            copy->getModified().mStringId = copy->getModified().mId.getRefIdString();
         }
 
         const int index = getAppendIndex(destination, type);
@@ -379,7 +379,7 @@ namespace CSMWorld
         {
             auto record2 = std::make_unique<Record<ESXRecordT>>();
             record2->mState = Record<ESXRecordT>::State_ModifiedOnly;
-            record2->mModified = record;
+            record2->getModified() = record;
 
             insertRecord(std::move(record2), getAppendIndex(id));
         }
@@ -517,7 +517,7 @@ namespace CSMWorld
 
         auto record2 = std::make_unique<Record<ESXRecordT>>();
         record2->mState = Record<ESXRecordT>::State_ModifiedOnly;
-        record2->mModified = std::move(record);
+        record2->getModified() = std::move(record);
 
         insertRecord(std::move(record2), getAppendIndex(id, type), type);
     }
@@ -988,14 +988,14 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            return QString::fromUtf8(record.get().mOwner.getRefIdString().c_str());
+            return QString::fromUtf8(record.get().getOwner().getRefIdString().c_str());
         }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mOwner = ESM::RefId::stringRefId(data.toString().toUtf8().constData());
+            record2.setOwner(ESM::RefId::stringRefId(data.toString().toUtf8().constData()));
 
             record.setModified(record2);
         }
@@ -1013,14 +1013,14 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            return QString::fromUtf8(record.get().mSoul.getRefIdString().c_str());
+            return QString::fromUtf8(record.get().getSoul().getRefIdString().c_str());
         }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mSoul = ESM::RefId::stringRefId(data.toString().toUtf8().constData());
+            record2.setSoul(ESM::RefId::stringRefId(data.toString().toUtf8().constData()));
 
             record.setModified(record2);
         }
@@ -1053,6 +1053,31 @@ namespace CSMWorld
         bool isEditable() const override { return true; }
     };
 
+    template <typename ESXRecordT>
+    struct ReferenceFactionColumn : public Column<ESXRecordT>
+    {
+        ReferenceFactionColumn()
+            : Column<ESXRecordT>(Columns::ColumnId_Faction, ColumnBase::Display_Faction)
+        {
+        }
+
+        QVariant get(const Record<ESXRecordT>& record) const override
+        {
+            return QString::fromUtf8(record.get().getFaction().getRefIdString().c_str());
+        }
+
+        void set(Record<ESXRecordT>& record, const QVariant& data) override
+        {
+            ESXRecordT record2 = record.get();
+
+            record2.setFaction(ESM::RefId::stringRefId(data.toString().toUtf8().constData()));
+
+            record.setModified(record2);
+        }
+
+        bool isEditable() const override { return true; }
+    };
+
     template <typename ESXRecordT>
     struct FactionIndexColumn : public Column<ESXRecordT>
     {
@@ -1061,12 +1086,12 @@ namespace CSMWorld
         {
         }
 
-        QVariant get(const Record<ESXRecordT>& record) const override { return record.get().mFactionRank; }
+        QVariant get(const Record<ESXRecordT>& record) const override { return record.get().getFactionRank(); }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
-            record2.mFactionRank = data.toInt();
+            record2.setFactionRank(data.toInt());
             record.setModified(record2);
         }
 
@@ -1141,13 +1166,13 @@ namespace CSMWorld
         {
         }
 
-        QVariant get(const Record<ESXRecordT>& record) const override { return record.get().mTeleport; }
+        QVariant get(const Record<ESXRecordT>& record) const override { return record.get().getTeleport(); }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mTeleport = data.toInt();
+            record2.setTeleport(data.toInt());
 
             record.setModified(record2);
         }
@@ -1165,16 +1190,16 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            if (!record.get().mTeleport)
+            if (!record.get().getTeleport())
                 return QVariant();
-            return QString::fromUtf8(record.get().mDestCell.c_str());
+            return QString::fromUtf8(record.get().getDestCell().c_str());
         }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mDestCell = data.toString().toUtf8().constData();
+            record2.setDestCell(data.toString().toUtf8().constData());
 
             record.setModified(record2);
         }
@@ -1240,7 +1265,7 @@ namespace CSMWorld
         QVariant get(const Record<ESXRecordT>& record) const override
         {
             if (record.get().mIsLocked)
-                return QString::fromUtf8(record.get().mKey.getRefIdString().c_str());
+                return QString::fromUtf8(record.get().getKey().getRefIdString().c_str());
             return QVariant();
         }
 
@@ -1248,7 +1273,7 @@ namespace CSMWorld
         {
             ESXRecordT record2 = record.get();
 
-            record2.mKey = ESM::RefId::stringRefId(data.toString().toUtf8().constData());
+            record2.setKey(ESM::RefId::stringRefId(data.toString().toUtf8().constData()));
 
             record.setModified(record2);
         }
@@ -1266,14 +1291,14 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            return QString::fromUtf8(record.get().mTrap.getRefIdString().c_str());
+            return QString::fromUtf8(record.get().getTrap().getRefIdString().c_str());
         }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mTrap = ESM::RefId::stringRefId(data.toString().toUtf8().constData());
+            record2.setTrap(ESM::RefId::stringRefId(data.toString().toUtf8().constData()));
 
             record.setModified(record2);
         }
@@ -1309,14 +1334,13 @@ namespace CSMWorld
     template <typename ESXRecordT>
     struct PosColumn : public Column<ESXRecordT>
     {
-        ESM::Position ESXRecordT::*mPosition;
         int mIndex;
         bool mIsDoor;
 
-        PosColumn(ESM::Position ESXRecordT::*position, int index, bool door)
+        /// @param door Use the teleport destination instead of the position of the reference
+        PosColumn(int index, bool door)
             : Column<ESXRecordT>((door ? Columns::ColumnId_DoorPositionXPos : Columns::ColumnId_PositionXPos) + index,
                 ColumnBase::Display_Float)
-            , mPosition(position)
             , mIndex(index)
             , mIsDoor(door)
         {
@@ -1324,9 +1348,9 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            if (!record.get().mTeleport && mIsDoor)
+            if (!record.get().getTeleport() && mIsDoor)
                 return QVariant();
-            const ESM::Position& position = record.get().*mPosition;
+            const ESM::Position& position = mIsDoor ? record.get().getDoorDest() : record.get().mPos;
             return position.pos[mIndex];
         }
 
@@ -1334,10 +1358,15 @@ namespace CSMWorld
         {
             ESXRecordT record2 = record.get();
 
-            ESM::Position& position = record2.*mPosition;
+            ESM::Position position = mIsDoor ? record2.getDoorDest() : record2.mPos;
 
             position.pos[mIndex] = data.toFloat();
 
+            if (mIsDoor)
+                record2.setDoorDest(position);
+            else
+                record2.mPos = position;
+
             record.setModified(record2);
         }
 
@@ -1347,14 +1376,13 @@ namespace CSMWorld
     template <typename ESXRecordT>
     struct RotColumn : public Column<ESXRecordT>
     {
-        ESM::Position ESXRecordT::*mPosition;
         int mIndex;
         bool mIsDoor;
 
-        RotColumn(ESM::Position ESXRecordT::*position, int index, bool door)
+        /// @param door Use the teleport destination instead of the position of the reference
+        RotColumn(int index, bool door)
             : Column<ESXRecordT>((door ? Columns::ColumnId_DoorPositionXRot : Columns::ColumnId_PositionXRot) + index,
                 ColumnBase::Display_Double)
-            , mPosition(position)
             , mIndex(index)
             , mIsDoor(door)
         {
@@ -1362,9 +1390,9 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            if (!record.get().mTeleport && mIsDoor)
+            if (!record.get().getTeleport() && mIsDoor)
                 return QVariant();
-            const ESM::Position& position = record.get().*mPosition;
+            const ESM::Position& position = mIsDoor ? record.get().getDoorDest() : record.get().mPos;
             return osg::RadiansToDegrees(position.rot[mIndex]);
         }
 
@@ -1372,10 +1400,15 @@ namespace CSMWorld
         {
             ESXRecordT record2 = record.get();
 
-            ESM::Position& position = record2.*mPosition;
+            ESM::Position position = mIsDoor ? record2.getDoorDest() : record2.mPos;
 
             position.rot[mIndex] = osg::DegreesToRadians(data.toFloat());
 
+            if (mIsDoor)
+                record2.setDoorDest(position);
+            else
+                record2.mPos = position;
+
             record.setModified(record2);
         }
 
@@ -1928,14 +1961,14 @@ namespace CSMWorld
 
         QVariant get(const Record<ESXRecordT>& record) const override
         {
-            return QString::fromUtf8(record.get().mGlobalVariable.c_str());
+            return QString::fromUtf8(record.get().getGlobalVariable().c_str());
         }
 
         void set(Record<ESXRecordT>& record, const QVariant& data) override
         {
             ESXRecordT record2 = record.get();
 
-            record2.mGlobalVariable = data.toString().toUtf8().constData();
+            record2.setGlobalVariable(data.toString().toUtf8().constData());
 
             record.setModified(record2);
         }
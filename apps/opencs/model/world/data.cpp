@@ -1,9 +1,11 @@
 #include "data.hpp"
 
 #include <algorithm>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 #include <QAbstractItemModel>
 
@@ -21,6 +23,7 @@
 #include <apps/opencs/model/world/nestedidcollection.hpp>
 #include <apps/opencs/model/world/nestedinfocollection.hpp>
 #include <apps/opencs/model/world/pathgrid.hpp>
+#include <apps/opencs/model/world/recordpreparser.hpp>
 #include <apps/opencs/model/world/ref.hpp>
 #include <apps/opencs/model/world/refcollection.hpp>
 #include <apps/opencs/model/world/refidcollection.hpp>
@@ -134,11 +137,13 @@ int CSMWorld::Data::count(RecordBase::State state, const CollectionBase& collect
 
 CSMWorld::Data::Data(ToUTF8::FromType encoding, const Files::PathContainer& dataPaths,
     const std::vector<std::string>& archives, const std::filesystem::path& resDir)
-    : mEncoder(encoding)
+    : mEncoding(encoding)
+    , mEncoder(encoding)
     , mPathgrids(mCells)
     , mRefs(mCells)
     , mDialogue(nullptr)
     , mReaderIndex(0)
+    , mRecordPosition(0)
     , mDataPaths(dataPaths)
     , mArchives(archives)
     , mVFS(std::make_unique<VFS::Manager>())
@@ -578,16 +583,16 @@ CSMWorld::Data::Data(ToUTF8::FromType encoding, const Files::PathContainer& data
     mRefs.addColumn(new CellColumn<CellRef>(true));
     mRefs.addColumn(new OriginalCellColumn<CellRef>);
     mRefs.addColumn(new IdColumn<CellRef>);
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mPos, 0, false));
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mPos, 1, false));
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mPos, 2, false));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mPos, 0, false));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mPos, 1, false));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mPos, 2, false));
+    mRefs.addColumn(new PosColumn<CellRef>(0, false));
+    mRefs.addColumn(new PosColumn<CellRef>(1, false));
+    mRefs.addColumn(new PosColumn<CellRef>(2, false));
+    mRefs.addColumn(new RotColumn<CellRef>(0, false));
+    mRefs.addColumn(new RotColumn<CellRef>(1, false));
+    mRefs.addColumn(new RotColumn<CellRef>(2, false));
     mRefs.addColumn(new ScaleColumn<CellRef>);
     mRefs.addColumn(new OwnerColumn<CellRef>);
     mRefs.addColumn(new SoulColumn<CellRef>);
-    mRefs.addColumn(new FactionColumn<CellRef>);
+    mRefs.addColumn(new ReferenceFactionColumn<CellRef>);
     mRefs.addColumn(new FactionIndexColumn<CellRef>);
     mRefs.addColumn(new ChargesColumn<CellRef>);
     mRefs.addColumn(new EnchantmentChargesColumn<CellRef>);
@@ -595,12 +600,12 @@ CSMWorld::Data::Data(ToUTF8::FromType encoding, const Files::PathContainer& data
     mRefs.addColumn(new TeleportColumn<CellRef>(
         ColumnBase::Flag_Table | ColumnBase::Flag_Dialogue | ColumnBase::Flag_Dialogue_Refresh));
     mRefs.addColumn(new TeleportCellColumn<CellRef>);
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mDoorDest, 0, true));
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mDoorDest, 1, true));
-    mRefs.addColumn(new PosColumn<CellRef>(&CellRef::mDoorDest, 2, true));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mDoorDest, 0, true));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mDoorDest, 1, true));
-    mRefs.addColumn(new RotColumn<CellRef>(&CellRef::mDoorDest, 2, true));
+    mRefs.addColumn(new PosColumn<CellRef>(0, true));
+    mRefs.addColumn(new PosColumn<CellRef>(1, true));
+    mRefs.addColumn(new PosColumn<CellRef>(2, true));
+    mRefs.addColumn(new RotColumn<CellRef>(0, true));
+    mRefs.addColumn(new RotColumn<CellRef>(1, true));
+    mRefs.addColumn(new RotColumn<CellRef>(2, true));
     mRefs.addColumn(new IsLockedColumn<CellRef>(
         ColumnBase::Flag_Table | ColumnBase::Flag_Dialogue | ColumnBase::Flag_Dialogue_Refresh));
     mRefs.addColumn(new LockLevelColumn<CellRef>);
@@ -1061,11 +1066,26 @@ int CSMWorld::Data::getTotalRecords(const std::vector<std::filesystem::path>& fi
     return records;
 }
 
+void CSMWorld::Data::preparse(const std::filesystem::path& path, std::size_t index)
+{
+    if (index < mReaderIndex || mPreparsers.contains(index))
+        return;
+    mPreparsers.emplace(index, std::make_unique<RecordPreparser>(path, static_cast<int>(index), mEncoding));
+}
+
 int CSMWorld::Data::startLoading(const std::filesystem::path& path, bool base, bool project)
 {
     Log(Debug::Info) << "Loading content file " << path;
 
     mDialogue = nullptr;
+    mRecordPosition = 0;
+    mPreparser.reset();
+    if (const auto it = mPreparsers.find(mReaderIndex); it != mPreparsers.end())
+    {
+        if (it->second->getPath() == path)
+            mPreparser = std::move(it->second);
+        mPreparsers.erase(it);
+    }
 
     ESM::ReadersCache::BusyItem reader = mReaders.get(mReaderIndex++);
     reader->setEncoder(&mEncoder);
@@ -1152,6 +1172,26 @@ bool CSMWorld::Data::continueLoading(CSMDoc::Messages& messages)
     ESM::NAME n = reader->getRecName();
     reader->getRecHeader();
 
+    const std::size_t position = mRecordPosition++;
+
+    if (mPreparser != nullptr)
+    {
+        if (std::optional<PreparsedRecord> record = mPreparser->take(position))
+        {
+            reader->skipRecord();
+            std::visit(
+                [&](const auto& value) {
+                    using Value = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_same_v<Value, ESM::Script>)
+                        mScripts.merge(value, record->mIsDeleted, mBase);
+                    else if constexpr (std::is_same_v<Value, Land>)
+                        mLand.merge(value, record->mIsDeleted, mBase);
+                },
+                record->mRecord);
+            return false;
+        }
+    }
+
     bool unhandledRecord = false;
 
     switch (n.toInt())
@@ -1408,6 +1448,8 @@ void CSMWorld::Data::finishLoading()
 {
     mTopicInfos.sort(mTopicInfoOrder);
     mJournalInfos.sort(mJournalInfoOrder);
+    mPreparser.reset();
+    mPreparsers.clear();
     // Release file locks so we can actually write to the file we're editing
     mReaders.clear();
 }
@@ -83,12 +83,14 @@ namespace CSMWorld
 {
     class ActorAdapter;
     class CollectionBase;
+    class RecordPreparser;
     class Resources;
 
     class Data : public QObject
     {
         Q_OBJECT
 
+        ToUTF8::FromType mEncoding;
         ToUTF8::Utf8Encoder mEncoder;
         IdCollection<ESM::Global> mGlobals;
         IdCollection<ESM::GameSetting> mGmsts;
@@ -129,6 +131,9 @@ namespace CSMWorld
         bool mProject;
         std::map<ESM::RefId, std::map<ESM::RefNum, unsigned int>> mRefLoadCache;
         std::size_t mReaderIndex;
+        std::map<std::size_t, std::unique_ptr<RecordPreparser>> mPreparsers;
+        std::unique_ptr<RecordPreparser> mPreparser; // of the file being loaded
+        std::size_t mRecordPosition;
 
         Files::PathContainer mDataPaths;
         std::vector<std::string> mArchives;
@@ -301,6 +306,10 @@ namespace CSMWorld
 
         int getTotalRecords(const std::vector<std::filesystem::path>& files); // for better loading bar
 
+        void preparse(const std::filesystem::path& path, std::size_t index);
+        ///< Start parsing the expensive records of a content file on a background thread to merge them, when the
+        /// file is loaded by startLoading as the file with the same index.
+
         int startLoading(const std::filesystem::path& path, bool base, bool project);
         ///< Begin merging content of a file into base or modified.
         ///
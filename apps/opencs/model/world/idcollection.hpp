@@ -33,6 +33,11 @@ namespace CSMWorld
         /// \return Index of loaded record (-1 if no record was loaded)
         int load(ESM::ESMReader& reader, bool base);
 
+        /// Merges a record parsed in the same way as by load
+        ///
+        /// \return Index of loaded record (-1 if no record was loaded)
+        int merge(const ESXRecordT& record, bool isDeleted, bool base);
+
         /// \param index Index at which the record can be found.
         /// Special values: -2 index unknown, -1 record does not exist yet and therefore
         /// does not have an index
@@ -56,14 +61,7 @@ namespace CSMWorld
     inline void IdCollection<Land>::loadRecord(Land& record, ESM::ESMReader& reader, bool& isDeleted)
     {
         record.load(reader, isDeleted);
-
-        // Load all land data for now. A future optimisation may only load non-base data
-        // if a suitable mechanism for avoiding race conditions can be established.
-        int flags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
-        record.loadData(flags);
-
-        // Prevent data from being reloaded.
-        record.mContext.filename.clear();
+        record.loadAllData();
     }
 
     template <typename ESXRecordT>
@@ -74,6 +72,12 @@ namespace CSMWorld
 
         loadRecord(record, reader, isDeleted);
 
+        return merge(record, isDeleted, base);
+    }
+
+    template <typename ESXRecordT>
+    int IdCollection<ESXRecordT>::merge(const ESXRecordT& record, bool isDeleted, bool base)
+    {
         ESM::RefId id = getRecordId(record);
         int index = this->searchId(id);
 
@@ -113,7 +117,7 @@ namespace CSMWorld
             // new record
             auto record2 = std::make_unique<Record<ESXRecordT>>();
             record2->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_ModifiedOnly;
-            (base ? record2->mBase : record2->mModified) = record;
+            (base ? record2->mBase : record2->getModified()) = record;
 
             index = this->getSize();
             this->appendRecord(std::move(record2));
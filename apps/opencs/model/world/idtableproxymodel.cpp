@@ -4,12 +4,15 @@
 #include <QModelIndex>
 #include <QSortFilterProxyModel>
 #include <QString>
+#include <QThreadPool>
 
 #include <compare>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <apps/opencs/model/filter/node.hpp>
+#include <apps/opencs/model/filter/snapshot.hpp>
 #include <apps/opencs/model/world/columns.hpp>
 
 #include "columnbase.hpp"
@@ -29,18 +32,72 @@ namespace
     }
 }
 
-void CSMWorld::IdTableProxyModel::updateColumnMap()
+std::map<int, int> CSMWorld::IdTableProxyModel::getColumnMap(const CSMFilter::Node& filter) const
 {
     Q_ASSERT(mSourceModel != nullptr);
 
-    mColumnMap.clear();
-    if (mFilter)
+    std::map<int, int> columnMap;
+    std::vector<int> columns = filter.getReferencedColumns();
+    for (std::vector<int>::const_iterator iter(columns.begin()); iter != columns.end(); ++iter)
+        columnMap.insert(
+            std::make_pair(*iter, mSourceModel->searchColumnIndex(static_cast<CSMWorld::Columns::ColumnId>(*iter))));
+    return columnMap;
+}
+
+void CSMWorld::IdTableProxyModel::startEvaluation()
+{
+    // Only one evaluation is running at a time, outdated results start the next one
+    if (mEvaluating)
+        return;
+
+    std::map<int, int> columns = getColumnMap(*mNextFilter);
+
+    // The snapshot is taken on the GUI thread, as the source model can only be accessed there
+    auto snapshot = std::make_shared<const CSMFilter::Snapshot>(*mSourceModel, 0, mSourceModel->rowCount(), columns,
+        mSnapshotGeneration == mSourceGeneration ? mSnapshot.get() : nullptr);
+    mSnapshot = snapshot;
+    mSnapshotGeneration = mSourceGeneration;
+    mEvaluating = true;
+
+    QThreadPool::globalInstance()->start([receiver = mReceiver, filter = mNextFilter, snapshot = std::move(snapshot),
+                                             columns = std::move(columns), generation = mSourceGeneration]() mutable {
+        std::vector<bool> accepted = CSMFilter::findAcceptedRows(*filter, *snapshot, columns);
+
+        const std::lock_guard lock(receiver->mMutex);
+        IdTableProxyModel* const model = receiver->mModel;
+        if (model == nullptr)
+            return;
+        QMetaObject::invokeMethod(
+            model,
+            [model, filter = std::move(filter), columns = std::move(columns), accepted = std::move(accepted),
+                generation]() mutable { model->filterEvaluated(filter, columns, std::move(accepted), generation); },
+            Qt::QueuedConnection);
+    });
+}
+
+void CSMWorld::IdTableProxyModel::filterEvaluated(const std::shared_ptr<CSMFilter::Node>& filter,
+    const std::map<int, int>& columns, std::vector<bool>&& accepted, std::uint64_t generation)
+{
+    mEvaluating = false;
+
+    if (filter != mNextFilter || generation != mSourceGeneration)
     {
-        std::vector<int> columns = mFilter->getReferencedColumns();
-        for (std::vector<int>::const_iterator iter(columns.begin()); iter != columns.end(); ++iter)
-            mColumnMap.insert(std::make_pair(
-                *iter, mSourceModel->searchColumnIndex(static_cast<CSMWorld::Columns::ColumnId>(*iter))));
+        startEvaluation();
+        return;
     }
+
+    // The results are published in one batch
+    const bool reset = filter != mFilter;
+    if (reset)
+        beginResetModel();
+    mFilter = filter;
+    mColumnMap = columns;
+    mAccepted = std::move(accepted);
+    mAcceptedGeneration = generation;
+    if (reset)
+        endResetModel();
+    else
+        invalidateFilter();
 }
 
 bool CSMWorld::IdTableProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
@@ -58,14 +115,26 @@ bool CSMWorld::IdTableProxyModel::filterAcceptsRow(int sourceRow, const QModelIn
     if (!mFilter)
         return true;
 
-    return mFilter->test(*mSourceModel, sourceRow, mColumnMap);
+    if (mAcceptedGeneration == mSourceGeneration && sourceRow < static_cast<int>(mAccepted.size()))
+        return mAccepted[sourceRow];
+
+    // Rows changed since the last evaluation are tested right away, until the next results are ready
+    const CSMFilter::Snapshot snapshot(*mSourceModel, sourceRow, 1, mColumnMap);
+    return mFilter->test(snapshot, sourceRow, mColumnMap);
 }
 
 CSMWorld::IdTableProxyModel::IdTableProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
     , mFilterTimer{ new QTimer(this) }
+    , mReceiver(std::make_shared<Receiver>())
+    , mSnapshotGeneration(0)
+    , mSourceGeneration(0)
+    , mAcceptedGeneration(0)
+    , mEvaluating(false)
     , mSourceModel(nullptr)
 {
+    mReceiver->mModel = this;
+
     setSortCaseSensitivity(Qt::CaseInsensitive);
 
     mFilterTimer->setSingleShot(true);
@@ -77,6 +146,12 @@ CSMWorld::IdTableProxyModel::IdTableProxyModel(QObject* parent)
     connect(mFilterTimer.get(), &QTimer::timeout, this, [this]() { this->timerTimeout(); });
 }
 
+CSMWorld::IdTableProxyModel::~IdTableProxyModel()
+{
+    const std::lock_guard lock(mReceiver->mMutex);
+    mReceiver->mModel = nullptr;
+}
+
 QModelIndex CSMWorld::IdTableProxyModel::getModelIndex(const std::string& id, int column) const
 {
     Q_ASSERT(mSourceModel != nullptr);
@@ -86,6 +161,14 @@ QModelIndex CSMWorld::IdTableProxyModel::getModelIndex(const std::string& id, in
 
 void CSMWorld::IdTableProxyModel::setSourceModel(QAbstractItemModel* model)
 {
+    // Connected before QSortFilterProxyModel, so the changed rows it filters again are not looked up in outdated
+    // results
+    const auto sourceChanged = [this] { ++mSourceGeneration; };
+    connect(model, &QAbstractItemModel::rowsInserted, this, sourceChanged);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, sourceChanged);
+    connect(model, &QAbstractItemModel::dataChanged, this, sourceChanged);
+    connect(model, &QAbstractItemModel::modelReset, this, sourceChanged);
+
     QSortFilterProxyModel::setSourceModel(model);
 
     mSourceModel = dynamic_cast<IdTableBase*>(sourceModel());
@@ -131,22 +214,17 @@ QString CSMWorld::IdTableProxyModel::getRecordId(int sourceRow) const
 
 void CSMWorld::IdTableProxyModel::refreshFilter()
 {
-    if (mFilter)
-    {
-        updateColumnMap();
-        invalidateFilter();
-    }
+    if (mNextFilter)
+        startEvaluation();
 }
 
 void CSMWorld::IdTableProxyModel::timerTimeout()
 {
     if (mAwaitingFilter)
     {
-        beginResetModel();
-        mFilter = mAwaitingFilter;
-        updateColumnMap();
-        endResetModel();
+        mNextFilter = mAwaitingFilter;
         mAwaitingFilter.reset();
+        startEvaluation();
     }
 }
 
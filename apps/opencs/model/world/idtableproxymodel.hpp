@@ -1,8 +1,10 @@
 #ifndef CSM_WOLRD_IDTABLEPROXYMODEL_H
 #define CSM_WOLRD_IDTABLEPROXYMODEL_H
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +23,7 @@ class QObject;
 namespace CSMFilter
 {
     class Node;
+    class Snapshot;
 }
 
 namespace CSMWorld
@@ -31,10 +34,25 @@ namespace CSMWorld
     {
         Q_OBJECT
 
+        // Filters are evaluated on the thread pool, the results are delivered through the receiver
+        struct Receiver
+        {
+            std::mutex mMutex;
+            IdTableProxyModel* mModel;
+        };
+
         std::shared_ptr<CSMFilter::Node> mFilter;
         std::unique_ptr<QTimer> mFilterTimer;
         std::shared_ptr<CSMFilter::Node> mAwaitingFilter;
+        std::shared_ptr<CSMFilter::Node> mNextFilter; // to be evaluated, replaces mFilter when the results are ready
         std::map<int, int> mColumnMap; // column ID, column index in this model (or -1)
+        std::shared_ptr<Receiver> mReceiver;
+        std::shared_ptr<const CSMFilter::Snapshot> mSnapshot; // kept to reuse the column indices
+        std::uint64_t mSnapshotGeneration;
+        std::uint64_t mSourceGeneration; // incremented on each change of the source
+        std::vector<bool> mAccepted; // by source row
+        std::uint64_t mAcceptedGeneration;
+        bool mEvaluating;
 
         // Cache of enum values for enum columns (e.g. Modified, Record Type).
         // Used to speed up comparisons during the sort by such columns.
@@ -45,11 +63,18 @@ namespace CSMWorld
         IdTableBase* mSourceModel;
 
     private:
-        void updateColumnMap();
+        std::map<int, int> getColumnMap(const CSMFilter::Node& filter) const;
+
+        void startEvaluation();
+
+        void filterEvaluated(const std::shared_ptr<CSMFilter::Node>& filter, const std::map<int, int>& columns,
+            std::vector<bool>&& accepted, std::uint64_t generation);
 
     public:
         IdTableProxyModel(QObject* parent = nullptr);
 
+        ~IdTableProxyModel() override;
+
         virtual QModelIndex getModelIndex(const std::string& id, int column) const;
 
         void setSourceModel(QAbstractItemModel* model) override;
@@ -39,7 +39,7 @@ void CSMWorld::InfoCollection::load(const Info& value, bool base)
         // new record
         auto record = std::make_unique<Record<Info>>();
         record->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_ModifiedOnly;
-        (base ? record->mBase : record->mModified) = value;
+        (base ? record->mBase : record->getModified()) = value;
 
         insertRecord(std::move(record), getSize());
     }
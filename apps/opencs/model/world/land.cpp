@@ -17,6 +17,14 @@ namespace CSMWorld
         ESM::Land::load(esm, isDeleted);
     }
 
+    void Land::loadAllData()
+    {
+        // A future optimisation may only load non-base data if a suitable mechanism for avoiding race conditions can
+        // be established.
+        loadData(ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX);
+        mContext.filename.clear();
+    }
+
     std::string Land::createUniqueRecordId(int x, int y)
     {
         std::ostringstream stream;
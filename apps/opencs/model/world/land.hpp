@@ -20,6 +20,9 @@ namespace CSMWorld
         /// Loads the metadata and ID
         void load(ESM::ESMReader& esm, bool& isDeleted);
 
+        /// Loads all land data and detaches the record from the content file, so the data is never reloaded
+        void loadAllData();
+
         static std::string createUniqueRecordId(int x, int y);
         static void parseUniqueRecordId(const std::string& id, int& x, int& y);
     };
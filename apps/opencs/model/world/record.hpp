@@ -44,12 +44,20 @@ namespace CSMWorld
     struct Record : public RecordBase
     {
         ESXRecordT mBase;
-        ESXRecordT mModified;
+        std::unique_ptr<ESXRecordT> mModified; // allocated on the first modification
 
         Record();
 
         Record(State state, const ESXRecordT* base = 0, const ESXRecordT* modified = 0);
 
+        Record(const Record& record);
+
+        Record(Record&& record) = default;
+
+        Record& operator=(const Record& record);
+
+        Record& operator=(Record&& record) = default;
+
         std::unique_ptr<RecordBase> clone() const override;
 
         std::unique_ptr<RecordBase> modifiedCopy() const override;
@@ -65,6 +73,9 @@ namespace CSMWorld
         const ESXRecordT& getBase() const;
         ///< Throws an exception, if the record is deleted. Returns modified, if there is no base.
 
+        ESXRecordT& getModified();
+        ///< Modified record regardless of the state, created as a copy of base on the first access.
+
         void setModified(const ESXRecordT& modified);
         ///< Throws an exception, if the record is deleted.
 
@@ -76,7 +87,6 @@ namespace CSMWorld
     Record<ESXRecordT>::Record()
         : RecordBase(State_BaseOnly)
         , mBase()
-        , mModified()
     {
     }
 
@@ -84,10 +94,31 @@ namespace CSMWorld
     Record<ESXRecordT>::Record(State state, const ESXRecordT* base, const ESXRecordT* modified)
         : RecordBase(state)
         , mBase(base == nullptr ? ESXRecordT{} : *base)
-        , mModified(modified == nullptr ? ESXRecordT{} : *modified)
+        , mModified(modified == nullptr ? nullptr : std::make_unique<ESXRecordT>(*modified))
     {
     }
 
+    template <typename ESXRecordT>
+    Record<ESXRecordT>::Record(const Record& record)
+        : RecordBase(record.mState)
+        , mBase(record.mBase)
+        , mModified(record.mModified == nullptr ? nullptr : std::make_unique<ESXRecordT>(*record.mModified))
+    {
+    }
+
+    template <typename ESXRecordT>
+    Record<ESXRecordT>& Record<ESXRecordT>::operator=(const Record& record)
+    {
+        if (this != &record)
+        {
+            mState = record.mState;
+            mBase = record.mBase;
+            mModified = record.mModified == nullptr ? nullptr : std::make_unique<ESXRecordT>(*record.mModified);
+        }
+
+        return *this;
+    }
+
     template <typename ESXRecordT>
     std::unique_ptr<RecordBase> Record<ESXRecordT>::modifiedCopy() const
     {
@@ -112,7 +143,8 @@ namespace CSMWorld
         if (mState == State_Erased)
             throw std::logic_error("attempt to access a deleted record");
 
-        return mState == State_BaseOnly || mState == State_Deleted ? mBase : mModified;
+        // The state can be changed directly, treat a missing modified record as unchanged base
+        return mState == State_BaseOnly || mState == State_Deleted || mModified == nullptr ? mBase : *mModified;
     }
 
     template <typename ESXRecordT>
@@ -121,7 +153,7 @@ namespace CSMWorld
         if (mState == State_Erased)
             throw std::logic_error("attempt to access a deleted record");
 
-        return mState == State_BaseOnly || mState == State_Deleted ? mBase : mModified;
+        return mState == State_BaseOnly || mState == State_Deleted ? mBase : getModified();
     }
 
     template <typename ESXRecordT>
@@ -130,7 +162,16 @@ namespace CSMWorld
         if (mState == State_Erased)
             throw std::logic_error("attempt to access a deleted record");
 
-        return mState == State_ModifiedOnly ? mModified : mBase;
+        return mState == State_ModifiedOnly && mModified != nullptr ? *mModified : mBase;
+    }
+
+    template <typename ESXRecordT>
+    ESXRecordT& Record<ESXRecordT>::getModified()
+    {
+        if (mModified == nullptr)
+            mModified = std::make_unique<ESXRecordT>(mBase);
+
+        return *mModified;
     }
 
     template <typename ESXRecordT>
@@ -139,7 +180,10 @@ namespace CSMWorld
         if (mState == State_Erased)
             throw std::logic_error("attempt to modify a deleted record");
 
-        mModified = modified;
+        if (mModified == nullptr)
+            mModified = std::make_unique<ESXRecordT>(modified);
+        else
+            *mModified = modified;
 
         if (mState != State_ModifiedOnly)
             mState = State_Modified;
@@ -150,7 +194,9 @@ namespace CSMWorld
     {
         if (isModified())
         {
-            mBase = mModified;
+            if (mModified != nullptr)
+                mBase = std::move(*mModified);
+            mModified.reset();
             mState = State_BaseOnly;
         }
         else if (mState == State_Deleted)
@@ -0,0 +1,89 @@
+#include "recordpreparser.hpp"
+
+#include <exception>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm3/esmreader.hpp>
+
+namespace CSMWorld
+{
+    RecordPreparser::RecordPreparser(const std::filesystem::path& path, int index, ToUTF8::FromType encoding)
+        : mPath(path)
+        , mIndex(index)
+        , mEncoding(encoding)
+        , mThread([this] { run(); })
+    {
+    }
+
+    RecordPreparser::~RecordPreparser()
+    {
+        mStop = true;
+        mThread.join();
+    }
+
+    std::optional<PreparsedRecord> RecordPreparser::take(std::size_t position)
+    {
+        std::unique_lock lock(mMutex);
+        mParsed.wait(lock, [&] { return mDone || position < mRecords.size(); });
+        if (position >= mRecords.size() || std::holds_alternative<std::monostate>(mRecords[position].mRecord))
+            return std::nullopt;
+        std::optional<PreparsedRecord> result = std::move(mRecords[position]);
+        mRecords[position] = PreparsedRecord{};
+        return result;
+    }
+
+    void RecordPreparser::run()
+    {
+        try
+        {
+            ToUTF8::Utf8Encoder encoder(mEncoding);
+            ESM::ESMReader reader;
+            reader.setEncoder(&encoder);
+            reader.open(mPath);
+            reader.setIndex(mIndex);
+
+            while (!mStop && reader.hasMoreRecs())
+            {
+                const ESM::NAME name = reader.getRecName();
+                reader.getRecHeader();
+
+                PreparsedRecord record;
+
+                switch (name.toInt())
+                {
+                    case ESM::REC_SCPT:
+                        record.mRecord.emplace<ESM::Script>().load(reader, record.mIsDeleted);
+                        break;
+                    case ESM::REC_LAND:
+                    {
+                        Land& land = record.mRecord.emplace<Land>();
+                        land.load(reader, record.mIsDeleted);
+                        land.loadAllData();
+                        break;
+                    }
+                    default:
+                        reader.skipRecord();
+                        break;
+                }
+
+                {
+                    const std::lock_guard lock(mMutex);
+                    mRecords.push_back(std::move(record));
+                }
+                mParsed.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // The records starting from the failed one are parsed by Data to report the error properly
+            Log(Debug::Verbose) << "Failed to preparse records of " << mPath << ": " << e.what();
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mDone = true;
+        }
+        mParsed.notify_all();
+    }
+}
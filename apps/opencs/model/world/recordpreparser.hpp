@@ -0,0 +1,66 @@
+#ifndef CSM_WORLD_RECORDPREPARSER_H
+#define CSM_WORLD_RECORDPREPARSER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <variant>
+
+#include <components/esm3/loadscpt.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include "land.hpp"
+
+namespace CSMWorld
+{
+    /// \brief Record parsed ahead of merging it into Data
+    struct PreparsedRecord
+    {
+        std::variant<std::monostate, ESM::Script, Land> mRecord;
+        bool mIsDeleted = false;
+    };
+
+    /// \brief Parses the records of a content file which don't depend on the already loaded data on a background
+    /// thread.
+    ///
+    /// Only the record types which are expensive to parse are handled, the others are skipped. The records are
+    /// stored by their position in the file, so Data merges them in the same order it would parse them itself.
+    class RecordPreparser
+    {
+    public:
+        /// \param index Index of the content file to be used by the reader
+        RecordPreparser(const std::filesystem::path& path, int index, ToUTF8::FromType encoding);
+
+        RecordPreparser(const RecordPreparser&) = delete;
+        RecordPreparser& operator=(const RecordPreparser&) = delete;
+
+        ~RecordPreparser();
+
+        const std::filesystem::path& getPath() const { return mPath; }
+
+        /// Waits for the record at the \a position to be parsed and moves it out.
+        ///
+        /// \return Nothing if the record type is not handled or parsing has failed, the caller has to parse it
+        std::optional<PreparsedRecord> take(std::size_t position);
+
+    private:
+        const std::filesystem::path mPath;
+        const int mIndex;
+        const ToUTF8::FromType mEncoding;
+        std::mutex mMutex;
+        std::condition_variable mParsed;
+        std::deque<PreparsedRecord> mRecords;
+        bool mDone = false;
+        std::atomic_bool mStop{ false };
+        std::thread mThread;
+
+        void run();
+    };
+}
+
+#endif
@@ -52,7 +52,7 @@ void CSMWorld::RefCollection::load(ESM::ESMReader& reader, int cellIndex, bool b
 {
     Record<Cell> cell = mCells.getRecord(cellIndex);
 
-    Cell& cell2 = base ? cell.mBase : cell.mModified;
+    Cell& cell2 = base ? cell.mBase : cell.getModified();
 
     ESM::MovedCellRef mref;
     bool isDeleted = false;
@@ -130,7 +130,7 @@ void CSMWorld::RefCollection::load(ESM::ESMReader& reader, int cellIndex, bool b
             auto record = std::make_unique<Record<CellRef>>();
             // TODO: check whether a base record be moved
             record->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_ModifiedOnly;
-            (base ? record->mBase : record->mModified) = std::move(ref);
+            (base ? record->mBase : record->getModified()) = std::move(ref);
 
             // overwrite original record
             setRecord(index, std::move(record));
@@ -179,7 +179,7 @@ void CSMWorld::RefCollection::load(ESM::ESMReader& reader, int cellIndex, bool b
 
             auto record = std::make_unique<Record<CellRef>>();
             record->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_ModifiedOnly;
-            (base ? record->mBase : record->mModified) = std::move(ref);
+            (base ? record->mBase : record->getModified()) = std::move(ref);
 
             appendRecord(std::move(record));
         }
@@ -210,7 +210,7 @@ void CSMWorld::RefCollection::load(ESM::ESMReader& reader, int cellIndex, bool b
 
             auto record = std::make_unique<Record<CellRef>>(getRecord(index));
             record->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_Modified;
-            (base ? record->mBase : record->mModified) = std::move(ref);
+            (base ? record->mBase : record->getModified()) = std::move(ref);
 
             setRecord(index, std::move(record));
         }
@@ -279,7 +279,7 @@ void CSMWorld::RefCollection::appendBlankRecord(const ESM::RefId& id, UniversalI
     auto record = std::make_unique<Record<CellRef>>();
 
     record->mState = Record<CellRef>::State_ModifiedOnly;
-    record->mModified.blank();
+    record->getModified().blank();
 
     record->get().mId = id;
     record->get().mIdNum = extractIdNum(id.getRefIdString());
@@ -293,7 +293,7 @@ void CSMWorld::RefCollection::cloneRecord(
     auto copy = std::make_unique<Record<CellRef>>();
     int index = getAppendIndex(ESM::RefId(), type);
 
-    copy->mModified = getRecord(origin).get();
+    copy->getModified() = getRecord(origin).get();
     copy->mState = RecordBase::State_ModifiedOnly;
 
     copy->get().mId = destination;
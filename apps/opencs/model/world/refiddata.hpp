@@ -139,8 +139,11 @@ namespace CSMWorld
         record->mState = base ? RecordBase::State_BaseOnly : RecordBase::State_ModifiedOnly;
 
         record->mBase.mId = id;
-        record->mModified.mId = id;
-        (base ? record->mBase : record->mModified).blank();
+
+        if (!base)
+            record->getModified().mId = id;
+
+        (base ? record->mBase : record->getModified()).blank();
 
         mContainer.push_back(std::move(record));
     }
@@ -188,7 +191,7 @@ namespace CSMWorld
                 }
                 else
                 {
-                    mContainer.back()->mModified = record;
+                    mContainer.back()->getModified() = record;
                 }
             }
             else if (!base)
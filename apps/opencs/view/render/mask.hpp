@@ -16,6 +16,7 @@ namespace CSVRender
         Mask_Pathgrid = 0x2,
         Mask_Water = 0x4,
         Mask_Terrain = 0x8,
+        Mask_DistantTerrain = 0x10, // not interactive, visible along with Mask_Terrain
 
         // used within models
         Mask_ParticleSystem = 0x100,
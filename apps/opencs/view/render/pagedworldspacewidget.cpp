@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -21,9 +23,13 @@
 #include <apps/opencs/view/render/tagbase.hpp>
 #include <apps/opencs/view/render/worldspacewidget.hpp>
 
+#include <components/esm3/loadcell.hpp>
 #include <components/esm3/loadpgrd.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/scalableicon.hpp>
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/terrain/quadtreeworld.hpp>
 
 #include <osg/Camera>
 #include <osg/Vec3f>
@@ -31,6 +37,7 @@
 #include <osgViewer/View>
 
 #include "../../model/prefs/shortcut.hpp"
+#include "../../model/prefs/state.hpp"
 
 #include "../../model/world/idtable.hpp"
 
@@ -41,6 +48,7 @@
 #include "editmode.hpp"
 #include "mask.hpp"
 #include "terrainshapemode.hpp"
+#include "terrainstorage.hpp"
 #include "terraintexturemode.hpp"
 
 class QWidget;
@@ -55,6 +63,30 @@ namespace CSVWidget
     class SceneToolbar;
 }
 
+namespace CSVRender
+{
+    /// Skips the distant terrain chunks of the loaded cells, which are rendered with full detail by their Cell.
+    ///
+    /// \note Chunks overlapping the active grid, which covers all loaded cells, are never larger than a cell, so
+    /// the cell of a chunk is the one containing its center.
+    class DistantTerrainCullCallback
+        : public SceneUtil::NodeCallback<DistantTerrainCullCallback, SceneUtil::PositionAttitudeTransform*>
+    {
+    public:
+        std::set<std::pair<int, int>> mLoadedCells;
+
+        void operator()(SceneUtil::PositionAttitudeTransform* node, osg::NodeVisitor* nv)
+        {
+            const osg::Vec3f& position = node->getPosition();
+            const std::pair<int, int> cell(static_cast<int>(std::floor(position.x() / Constants::CellSizeInUnits)),
+                static_cast<int>(std::floor(position.y() / Constants::CellSizeInUnits)));
+
+            if (!mLoadedCells.contains(cell))
+                traverse(node, nv);
+        }
+    };
+}
+
 bool CSVRender::PagedWorldspaceWidget::adjustCells()
 {
     bool modified = false;
@@ -152,6 +184,8 @@ bool CSVRender::PagedWorldspaceWidget::adjustCells()
 
             iter->second->setCellArrows(mask);
         }
+
+        updateDistantTerrain();
     }
 
     return modified;
@@ -388,6 +422,12 @@ void CSVRender::PagedWorldspaceWidget::landDataChanged(const QModelIndex& topLef
         {
             cellIt->second->landDataChanged(topLeft, bottomRight);
             flagAsModified();
+            mDistantTerrainOutdated = true;
+        }
+        else if (mDistantTerrain)
+        {
+            invalidateDistantTerrain();
+            flagAsModified();
         }
     }
 }
@@ -403,6 +443,12 @@ void CSVRender::PagedWorldspaceWidget::landAboutToBeRemoved(const QModelIndex& p
         {
             cellIt->second->landAboutToBeRemoved(parent, start, end);
             flagAsModified();
+            mDistantTerrainOutdated = true;
+        }
+        else if (mDistantTerrain)
+        {
+            invalidateDistantTerrain();
+            flagAsModified();
         }
     }
 }
@@ -418,6 +464,12 @@ void CSVRender::PagedWorldspaceWidget::landAdded(const QModelIndex& parent, int
         {
             cellIt->second->landAdded(parent, start, end);
             flagAsModified();
+            mDistantTerrainOutdated = true;
+        }
+        else if (mDistantTerrain)
+        {
+            invalidateDistantTerrain();
+            flagAsModified();
         }
     }
 }
@@ -427,6 +479,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureDataChanged(
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureChanged(topLeft, bottomRight);
+    invalidateDistantTerrain();
     flagAsModified();
 }
 
@@ -434,6 +487,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureAboutToBeRemoved(const QModelI
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureAboutToBeRemoved(parent, start, end);
+    invalidateDistantTerrain();
     flagAsModified();
 }
 
@@ -441,6 +495,7 @@ void CSVRender::PagedWorldspaceWidget::landTextureAdded(const QModelIndex& paren
 {
     for (auto cellIt : mCells)
         cellIt.second->landTextureAdded(parent, start, end);
+    invalidateDistantTerrain();
     flagAsModified();
 }
 
@@ -470,6 +525,8 @@ void CSVRender::PagedWorldspaceWidget::addCellToScene(const CSMWorld::CellCoordi
     cell->setSubMode(editMode->getSubMode(), editMode->getInteractionMask());
 
     mCells.insert(std::make_pair(coordinates, cell.release()));
+
+    updateDistantTerrain();
 }
 
 void CSVRender::PagedWorldspaceWidget::removeCellFromScene(const CSMWorld::CellCoordinates& coordinates)
@@ -480,9 +537,102 @@ void CSVRender::PagedWorldspaceWidget::removeCellFromScene(const CSMWorld::CellC
     {
         delete iter->second;
         mCells.erase(iter);
+
+        updateDistantTerrain();
     }
 }
 
+void CSVRender::PagedWorldspaceWidget::setupDistantTerrain()
+{
+    if (!CSMPrefs::get()["Rendering"]["distant-terrain"].isTrue())
+    {
+        mDistantTerrain.reset();
+        mDistantTerrainCullCallback = nullptr;
+        mDistantTerrainStorage = nullptr;
+        return;
+    }
+
+    if (!mDistantTerrain)
+    {
+        // Same as the defaults of OpenMW
+        constexpr int compMapResolution = 512;
+        constexpr float compMapLevel = 0.125f;
+        constexpr float lodFactor = 1.0f;
+        constexpr int vertexLodMod = 0;
+        constexpr float maxCompGeometrySize = 4.0f;
+        constexpr double expiryDelay = 0;
+
+        // The storage never has altered heights, only the loaded cells can be edited
+        mDistantTerrainStorage = new TerrainStorage(mDocument.getData());
+        mDistantTerrainCullCallback = new DistantTerrainCullCallback;
+        mDistantTerrain = std::make_unique<Terrain::QuadTreeWorld>(mRootNode, mRootNode,
+            mDocument.getData().getResourceSystem().get(), mDistantTerrainStorage.get(), Mask_DistantTerrain, ~0u, 0,
+            compMapResolution, compMapLevel, lodFactor, vertexLodMod, maxCompGeometrySize, false,
+            ESM::Cell::sDefaultWorldspaceId, expiryDelay);
+        mDistantTerrain->setChunkCullCallback(mDistantTerrainCullCallback.get());
+        mDistantTerrain->enable(true);
+        mDistantTerrainOutdated = false;
+        updateDistantTerrain();
+    }
+
+    mDistantTerrain->setViewDistance(static_cast<float>(
+        CSMPrefs::get()["Rendering"]["distant-terrain-view-distance"].toInt() * Constants::CellSizeInUnits));
+}
+
+void CSVRender::PagedWorldspaceWidget::updateDistantTerrain()
+{
+    if (!mDistantTerrain)
+        return;
+
+    std::set<std::pair<int, int>> loadedCells;
+    osg::Vec4i grid(std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+        std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+
+    for (const auto& [coordinates, cell] : mCells)
+    {
+        loadedCells.emplace(coordinates.getX(), coordinates.getY());
+        grid.x() = std::min(grid.x(), coordinates.getX());
+        grid.y() = std::min(grid.y(), coordinates.getY());
+        grid.z() = std::max(grid.z(), coordinates.getX() + 1);
+        grid.w() = std::max(grid.w(), coordinates.getY() + 1);
+    }
+
+    if (loadedCells.empty())
+        grid = osg::Vec4i(0, 0, 0, 0);
+
+    if (loadedCells == mDistantTerrainCullCallback->mLoadedCells)
+        return;
+
+    // The chunks of the cells not loaded anymore may have been built before their land was edited
+    if (mDistantTerrainOutdated)
+        invalidateDistantTerrain();
+
+    mDistantTerrainCullCallback->mLoadedCells = std::move(loadedCells);
+    mDistantTerrain->setActiveGrid(grid);
+}
+
+void CSVRender::PagedWorldspaceWidget::invalidateDistantTerrain()
+{
+    mDistantTerrainOutdated = false;
+
+    if (!mDistantTerrain)
+        return;
+
+    mDistantTerrain->clearAssociatedCaches();
+    mDistantTerrain->rebuildViews();
+}
+
+void CSVRender::PagedWorldspaceWidget::settingChanged(const CSMPrefs::Setting* setting)
+{
+    if (*setting == "Rendering/distant-terrain" || *setting == "Rendering/distant-terrain-view-distance")
+    {
+        setupDistantTerrain();
+        flagAsModified();
+    }
+    else
+        WorldspaceWidget::settingChanged(setting);
+}
+
 void CSVRender::PagedWorldspaceWidget::addCellSelection(int x, int y)
 {
     CSMWorld::CellSelection newSelection = mSelection;
@@ -543,6 +693,7 @@ CSVRender::PagedWorldspaceWidget::PagedWorldspaceWidget(QWidget* parent, CSMDoc:
     , mWorldspace("std::default")
     , mControlElements(nullptr)
     , mDisplayCellCoord(true)
+    , mDistantTerrainOutdated(false)
 {
     QAbstractItemModel* cells = document.getData().getTableModel(CSMWorld::UniversalId::Type_Cells);
 
@@ -585,6 +736,8 @@ CSVRender::PagedWorldspaceWidget::PagedWorldspaceWidget(QWidget* parent, CSMDoc:
     CSMPrefs::Shortcut* loadCameraSouthCellShortcut = new CSMPrefs::Shortcut("scene-load-cam-southcell", this);
     connect(loadCameraSouthCellShortcut, qOverload<>(&CSMPrefs::Shortcut::activated), this,
         &PagedWorldspaceWidget::loadSouthCell);
+
+    setupDistantTerrain();
 }
 
 CSVRender::PagedWorldspaceWidget::~PagedWorldspaceWidget()
@@ -741,7 +894,12 @@ CSVRender::WorldspaceWidget::dropRequirments CSVRender::PagedWorldspaceWidget::g
 
 unsigned int CSVRender::PagedWorldspaceWidget::getVisibilityMask() const
 {
-    return WorldspaceWidget::getVisibilityMask() | mControlElements->getSelectionMask();
+    unsigned int mask = WorldspaceWidget::getVisibilityMask() | mControlElements->getSelectionMask();
+
+    if (mask & Mask_Terrain)
+        mask |= Mask_DistantTerrain;
+
+    return mask;
 }
 
 void CSVRender::PagedWorldspaceWidget::clearSelection(int elementMask)
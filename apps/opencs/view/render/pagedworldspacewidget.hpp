@@ -2,6 +2,7 @@
 #define OPENCS_VIEW_PAGEDWORLDSPACEWIDGET_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,11 +19,16 @@ class QModelIndex;
 class QObject;
 class QWidget;
 
+#include <osg/ref_ptr>
+
 namespace osg
 {
     class Vec3f;
-    template <class T>
-    class ref_ptr;
+}
+
+namespace Terrain
+{
+    class QuadTreeWorld;
 }
 
 namespace CSMDoc
@@ -45,7 +51,9 @@ namespace CSVWidget
 namespace CSVRender
 {
     class Cell;
+    class DistantTerrainCullCallback;
     class TagBase;
+    class TerrainStorage;
 
     class PagedWorldspaceWidget : public WorldspaceWidget
     {
@@ -57,10 +65,25 @@ namespace CSVRender
         std::string mWorldspace;
         CSVWidget::SceneToolToggle2* mControlElements;
         bool mDisplayCellCoord;
+        osg::ref_ptr<TerrainStorage> mDistantTerrainStorage;
+        osg::ref_ptr<DistantTerrainCullCallback> mDistantTerrainCullCallback;
+        std::unique_ptr<Terrain::QuadTreeWorld> mDistantTerrain;
+        bool mDistantTerrainOutdated; // land of the loaded cells has changed
 
     private:
         std::pair<int, int> getCoordinatesFromId(const std::string& record) const;
 
+        /// Create or destroy the distant terrain according to the settings.
+        void setupDistantTerrain();
+
+        /// Hide the distant terrain of the loaded cells and update it, if the cells around them have changed.
+        void updateDistantTerrain();
+
+        /// Drop the cached chunks of the distant terrain.
+        void invalidateDistantTerrain();
+
+        void settingChanged(const CSMPrefs::Setting* setting) override;
+
         /// Bring mCells into sync with mSelection again.
         ///
         /// \return Any cells added or removed?
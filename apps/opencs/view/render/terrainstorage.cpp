@@ -84,8 +84,30 @@ namespace CSVRender
 
     void TerrainStorage::getBounds(float& minX, float& maxX, float& minY, float& maxY, ESM::RefId worldspace)
     {
-        // not needed at the moment - this returns the bounds of the whole world, but we only edit individual cells
-        throw std::runtime_error("getBounds not implemented");
+        // Only used by the distant terrain, which covers the whole world
+        minX = 0;
+        minY = 0;
+        maxX = 0;
+        maxY = 0;
+
+        const CSMWorld::IdCollection<CSMWorld::Land>& lands = mData.getLand();
+        for (int i = 0; i < lands.getSize(); ++i)
+        {
+            const CSMWorld::Record<CSMWorld::Land>& record = lands.getRecord(i);
+            if (record.isDeleted())
+                continue;
+
+            const float x = static_cast<float>(record.get().mX);
+            const float y = static_cast<float>(record.get().mY);
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+
+        // since grid coords are at cell origin, we need to add 1 cell
+        maxX += 1;
+        maxY += 1;
     }
 
     int TerrainStorage::getThisHeight(int col, int row, std::span<const float> heightData) const
@@ -1,8 +1,11 @@
 #include "engine.hpp"
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
+#include <cmath>
 #include <future>
+#include <optional>
 #include <system_error>
 
 #include <osgDB/WriteFile>
@@ -12,21 +15,29 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/tracing.hpp>
 
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
+#include <components/misc/taskgraph.hpp>
 
+#include <components/vfs/indexcache.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
 
 #include <components/sdlutil/imagetosurface.hpp>
+#include <components/sdlutil/inputrecording.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/gputimer.hpp>
+#include <components/resource/imagemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
+#include <components/resource/statsexporter.hpp>
 
 #include <components/compiler/extensions0.hpp>
+#include <components/compiler/scriptcache.hpp>
 
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
@@ -54,6 +65,9 @@
 #include <components/settings/shadermanager.hpp>
 #include <components/settings/values.hpp>
 
+#include <components/shader/programbinarycache.hpp>
+#include <components/shader/shadermanager.hpp>
+
 #include "mwinput/inputmanagerimp.hpp"
 
 #include "mwgui/windowmanagerimp.hpp"
@@ -65,12 +79,14 @@
 #include "mwscript/scriptmanagerimp.hpp"
 
 #include "mwsound/constants.hpp"
+#include "mwsound/loudnesscache.hpp"
 #include "mwsound/soundmanagerimp.hpp"
 
 #include "mwworld/class.hpp"
 #include "mwworld/datetimemanager.hpp"
 #include "mwworld/worldimp.hpp"
 
+#include "mwrender/renderingmanager.hpp"
 #include "mwrender/vismask.hpp"
 
 #include "mwclass/classes.hpp"
@@ -110,6 +126,14 @@ namespace
         // Unconditionnally add the async physics stats, and then remove it at runtime if necessary
         if (Settings::physics().mAsyncNumThreads == 0)
             profiler.removeUserStatsLine(" -Async");
+
+        // GPU timestamps are not on the same clock as the frame timings, so there are no bars for them
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Resource::GpuStage::Count); ++i)
+        {
+            const Resource::GpuStageStats& v = Resource::getGpuStageStats(static_cast<Resource::GpuStage>(i));
+            profiler.addUserStatsLine(
+                v.mLabel, textColor, barColor, v.mTaken, multiplier, average, averageInInverseSpace, "", "", maxValue);
+        }
     }
 
     struct ScreenCaptureMessageBox
@@ -149,10 +173,15 @@ namespace
 
         void operator()(osg::GraphicsContext* graphicsContext) override
         {
-            Log(Debug::Info) << "OpenGL Vendor: " << glGetString(GL_VENDOR);
-            Log(Debug::Info) << "OpenGL Renderer: " << glGetString(GL_RENDERER);
-            Log(Debug::Info) << "OpenGL Version: " << glGetString(GL_VERSION);
+            const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+            const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+            const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+            Log(Debug::Info) << "OpenGL Vendor: " << vendor;
+            Log(Debug::Info) << "OpenGL Renderer: " << renderer;
+            Log(Debug::Info) << "OpenGL Version: " << version;
             glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &mMaxTextureImageUnits);
+            if (vendor != nullptr && renderer != nullptr && version != nullptr)
+                mDriver = std::string(vendor) + '\n' + renderer + '\n' + version;
         }
 
         int getMaxTextureImageUnits() const
@@ -162,8 +191,11 @@ namespace
             return mMaxTextureImageUnits;
         }
 
+        const std::string& getDriver() const { return mDriver; }
+
     private:
         int mMaxTextureImageUnits = 0;
+        std::string mDriver;
     };
 
     void reportStats(unsigned frameNumber, osgViewer::Viewer& viewer, std::ostream& stream)
@@ -176,26 +208,77 @@ namespace
     }
 }
 
-void OMW::Engine::executeLocalScripts()
+void OMW::Engine::executeLocalScripts(osg::Timer_t frameStart, unsigned frameNumber, osg::Stats& stats)
 {
+    const osg::Timer& timer = *osg::Timer::instance();
+    ScopedProfile<UserStatsType::LocalScripts> profile(frameStart, frameNumber, timer, stats);
+
     MWWorld::LocalScripts& localScripts = mWorld->getLocalScripts();
+    const bool eventTriggered = Settings::game().mEventTriggeredLocalScripts;
+    const bool collectStats = stats.collectStats("engine");
+    std::size_t skipped = 0;
+    osg::Timer_t slowest = 0;
 
     localScripts.startIteration();
     std::pair<ESM::RefId, MWWorld::Ptr> script;
     while (localScripts.getNext(script))
     {
-        MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
+        MWWorld::RefData& refData = script.second.getRefData();
+
+        // Running the script would only suppress the activation again
+        if (eventTriggered && refData.isWaitingForActivation() && mScriptManager->isActivationOnly(script.first))
+        {
+            ++skipped;
+            continue;
+        }
+
+        const osg::Timer_t start = collectStats ? timer.tick() : 0;
+        MWScript::InterpreterContext interpreterContext(&refData.getLocals(), script.second);
         mScriptManager->run(script.first, interpreterContext);
+        if (collectStats)
+            slowest = std::max(slowest, timer.tick() - start);
+    }
+
+    if (collectStats)
+    {
+        stats.setAttribute(frameNumber, "LocalScripts Count", localScripts.size());
+        stats.setAttribute(frameNumber, "LocalScripts Skipped", skipped);
+        stats.setAttribute(frameNumber, "LocalScripts Slowest", timer.delta_u(0, slowest));
+    }
+}
+
+void OMW::Engine::updateSimulationTick(float frametime)
+{
+    const float rate = Settings::game().mSimulationTickRate;
+    if (rate <= 0)
+    {
+        mSimulationTickTime = 0;
+        mEnvironment.setSimulationTick(true, frametime);
+        return;
+    }
+    // Ticks cover whole periods, the rest of the time is left for the next one
+    const float period = 1.f / rate;
+    mSimulationTickTime += frametime;
+    if (mSimulationTickTime < period)
+    {
+        mEnvironment.setSimulationTick(false, 0);
+        return;
     }
+    const float remainder = std::fmod(mSimulationTickTime, period);
+    mEnvironment.setSimulationTick(true, mSimulationTickTime - remainder);
+    mSimulationTickTime = remainder;
 }
 
 bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 {
+    OPENMW_TRACE_ZONE("Engine::frame");
+
     const osg::Timer_t frameStart = mViewer->getStartTick();
     const osg::Timer* const timer = osg::Timer::instance();
     osg::Stats* const stats = mViewer->getViewerStats();
 
     mEnvironment.setFrameDuration(frametime);
+    updateSimulationTick(frametime);
 
     try
     {
@@ -250,7 +333,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
                     if (mWorld->getScriptsEnabled())
                     {
                         // local scripts
-                        executeLocalScripts();
+                        executeLocalScripts(frameStart, frameNumber, *stats);
 
                         // global scripts
                         mScriptManager->getGlobalScripts().run();
@@ -319,7 +402,10 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     const bool reportResource = stats->collectStats("resource");
 
     if (reportResource)
+    {
         stats->setAttribute(frameNumber, "UnrefQueue", mUnrefQueue->getSize());
+        stats->setAttribute(frameNumber, "UnrefQueue Shared", mUnrefQueue->getSharedSize());
+    }
 
     mUnrefQueue->flush(*mWorkQueue);
 
@@ -332,15 +418,31 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
         stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
+        const SceneUtil::WorkQueueStats workQueueStats = mWorkQueue->getStats();
+        constexpr std::string_view workPriorityNames[] = { "Urgent", "Visible", "Speculative" };
+        static_assert(std::size(workPriorityNames) == SceneUtil::workPriorities);
+        for (std::size_t i = 0; i < SceneUtil::workPriorities; ++i)
+        {
+            const std::string prefix = "WorkQueue " + std::string(workPriorityNames[i]);
+            stats->setAttribute(frameNumber, prefix + " Queued", workQueueStats.mPriorities[i].mQueued);
+            stats->setAttribute(frameNumber, prefix + " Completed", workQueueStats.mPriorities[i].mCompleted);
+            stats->setAttribute(frameNumber, prefix + " Cancelled", workQueueStats.mPriorities[i].mCancelled);
+        }
+        stats->setAttribute(frameNumber, "WorkQueue Stolen", workQueueStats.mStolen);
+
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        mSoundManager->reportStats(frameNumber, *stats);
     }
 
     mStereoManager->updateSettings(Settings::camera().mNearClip, Settings::camera().mViewingDistance);
 
-    mViewer->eventTraversal();
-    mViewer->updateTraversal();
+    {
+        OPENMW_TRACE_ZONE("Viewer::updateTraversal");
+        mViewer->eventTraversal();
+        mViewer->updateTraversal();
+    }
 
     // update GUI by world data
     {
@@ -351,7 +453,10 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     // if there is a separate Lua thread, it starts the update now
     mLuaWorker->allowUpdate(frameStart, frameNumber, *stats);
 
-    mViewer->renderingTraversals();
+    {
+        OPENMW_TRACE_ZONE("Viewer::renderingTraversals");
+        mViewer->renderingTraversals();
+    }
 
     mLuaWorker->finishUpdate(frameStart, frameNumber, *stats);
 
@@ -374,6 +479,9 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
     , mActivationDistanceOverride(-1)
     , mGrab(true)
     , mRandomSeed(0)
+    , mHiddenWindow(false)
+    , mStatsExportFormat(Resource::StatsExportFormat::Csv)
+    , mStatsExportInterval(1)
     , mScriptBlacklistUse(true)
     , mNewGame(false)
     , mCfgMgr(configurationManager)
@@ -496,7 +604,8 @@ void OMW::Engine::createWindow()
         pos_y = SDL_WINDOWPOS_UNDEFINED_DISPLAY(screen);
     }
 
-    Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+    Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+    flags |= mHiddenWindow ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     if (windowMode == Settings::WindowMode::Fullscreen)
         flags |= SDL_WINDOW_FULLSCREEN;
     else if (windowMode == Settings::WindowMode::WindowedFullscreen)
@@ -680,6 +789,7 @@ void OMW::Engine::createWindow()
 
     mViewer->realize();
     mGlMaxTextureImageUnits = identifyOp->getMaxTextureImageUnits();
+    mGlDriver = identifyOp->getDriver();
 
     mViewer->getEventQueue()->getCurrentEventState()->setWindowRectangle(
         0, 0, graphicsWindow->getTraits()->width, graphicsWindow->getTraits()->height);
@@ -722,103 +832,152 @@ void OMW::Engine::prepareEngine()
     osg::ref_ptr<osg::Group> rootNode(new osg::Group);
     mViewer->setSceneData(rootNode);
 
-    createWindow();
-
     mVFS = std::make_unique<VFS::Manager>();
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
-
-    mResourceSystem = std::make_unique<Resource::ResourceSystem>(
-        mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
-    mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
-    mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
-        false); // keep to Off for now to allow better state sharing
-    mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
-        Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap, Settings::general().mAnisotropy);
-    mEnvironment.setResourceSystem(*mResourceSystem);
-
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
-    mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
-        new SceneUtil::WriteScreenshotToFileOperation(mCfgMgr.getScreenshotPath(),
-            Settings::general().mScreenshotFormat,
-            Settings::general().mNotifyOnSavedScreenshot ? std::function<void(std::string)>(ScreenCaptureMessageBox{})
-                                                         : std::function<void(std::string)>(IgnoreString{})));
-
-    mScreenCaptureHandler = new osgViewer::ScreenCaptureHandler(mScreenCaptureOperation);
-
-    mViewer->addEventHandler(mScreenCaptureHandler);
-
-    mL10nManager = std::make_unique<l10n::Manager>(mVFS.get());
-    mL10nManager->setPreferredLocales(Settings::general().mPreferredLocales, Settings::general().mGmstOverridesL10n);
-    mEnvironment.setL10nManager(*mL10nManager);
-
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
-    mEnvironment.setLuaManager(*mLuaManager);
+    // Independent subsystems are initialised concurrently. The ones using the window, the graphics context or the GUI
+    // have to run on the main thread.
+    using Thread = Misc::TaskGraph::Thread;
+    Misc::TaskGraph startup;
+
+    const Misc::TaskGraph::TaskId window = startup.add("window", Thread::Caller, {}, [&] { createWindow(); });
+
+    const Misc::TaskGraph::TaskId vfs = startup.add("data directories", Thread::Any, {}, [&] {
+        std::optional<VFS::IndexCache> vfsIndexCache;
+        if (Settings::general().mDataDirectoriesIndexCache)
+            vfsIndexCache.emplace(mCfgMgr.getCachePath() / "datadirectories.cache");
+
+        VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true,
+            Settings::general().mMemoryMappedArchives, vfsIndexCache.has_value() ? &*vfsIndexCache : nullptr);
+
+        if (vfsIndexCache.has_value())
+            vfsIndexCache->write();
+    });
+
+    const Misc::TaskGraph::TaskId resources = startup.add("resources", Thread::Caller, { window, vfs }, [&] {
+        mResourceSystem = std::make_unique<Resource::ResourceSystem>(
+            mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
+        mResourceSystem->setMemoryBudget(
+            static_cast<std::size_t>(Settings::cells().mCacheMemoryBudget) * 1024 * 1024);
+        if (Settings::general().mCompressTextures)
+            mResourceSystem->getImageManager()->setCompressedImageCache(mCfgMgr.getCachePath() / "textures");
+        mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
+        if (Settings::shaders().mProgramBinaryCache && !mGlDriver.empty())
+        {
+            osg::ref_ptr<Shader::ProgramBinaryCache> programBinaryCache
+                = new Shader::ProgramBinaryCache(mCfgMgr.getCachePath() / "shaders", mGlDriver);
+            mResourceSystem->getSceneManager()->getShaderManager().setProgramBinaryCache(programBinaryCache);
+            mViewer->getCamera()->addInitialDrawCallback(
+                new Shader::ProgramBinaryCache::RetrieveCallback(programBinaryCache));
+        }
+        mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
+            false); // keep to Off for now to allow better state sharing
+        mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
+            Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap,
+            Settings::general().mAnisotropy);
+        mEnvironment.setResourceSystem(*mResourceSystem);
+
+        mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
+            new SceneUtil::WriteScreenshotToFileOperation(mCfgMgr.getScreenshotPath(),
+                Settings::general().mScreenshotFormat,
+                Settings::general().mNotifyOnSavedScreenshot
+                    ? std::function<void(std::string)>(ScreenCaptureMessageBox{})
+                    : std::function<void(std::string)>(IgnoreString{})));
+
+        mScreenCaptureHandler = new osgViewer::ScreenCaptureHandler(mScreenCaptureOperation);
+
+        mViewer->addEventHandler(mScreenCaptureHandler);
+    });
+
+    const Misc::TaskGraph::TaskId l10n = startup.add("localisation", Thread::Any, { vfs }, [&] {
+        mL10nManager = std::make_unique<l10n::Manager>(mVFS.get());
+        mL10nManager->setPreferredLocales(
+            Settings::general().mPreferredLocales, Settings::general().mGmstOverridesL10n);
+        mEnvironment.setL10nManager(*mL10nManager);
+    });
+
+    const Misc::TaskGraph::TaskId lua = startup.add("Lua", Thread::Any, { vfs }, [&] {
+        mLuaManager = std::make_unique<MWLua::LuaManager>(
+            mVFS.get(), mResDir / "lua_libs", mCfgMgr.getUserDataPath() / "luatraces");
+        mEnvironment.setLuaManager(*mLuaManager);
+    });
+
+    // Opening the audio device may take a while, it doesn't need to wait for the GUI
+    startup.add("sound", Thread::Any, { vfs }, [&] {
+        mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mWorkQueue.get(), mUseSound);
+        if (Settings::sound().mLoudnessCache)
+            mSoundManager->setLoudnessCache(
+                std::make_unique<MWSound::LoudnessCache>(mCfgMgr.getCachePath() / "loudness"));
+        mEnvironment.setSoundManager(*mSoundManager);
+    });
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
-
-    const auto keybinderUser = mCfgMgr.getUserConfigPath() / "input_v3.xml";
-    bool keybinderUserExists = std::filesystem::exists(keybinderUser);
-    if (!keybinderUserExists)
-    {
-        const auto input2 = (mCfgMgr.getUserConfigPath() / "input_v2.xml");
-        if (std::filesystem::exists(input2))
+    osg::ref_ptr<osg::Group> guiRoot = new osg::Group;
+    startup.add("GUI", Thread::Caller, { resources, l10n, lua }, [&] {
+        const auto keybinderUser = mCfgMgr.getUserConfigPath() / "input_v3.xml";
+        bool keybinderUserExists = std::filesystem::exists(keybinderUser);
+        if (!keybinderUserExists)
         {
-            keybinderUserExists = std::filesystem::copy_file(input2, keybinderUser);
-            Log(Debug::Info) << "Loading keybindings file: " << keybinderUser;
+            const auto input2 = (mCfgMgr.getUserConfigPath() / "input_v2.xml");
+            if (std::filesystem::exists(input2))
+            {
+                keybinderUserExists = std::filesystem::copy_file(input2, keybinderUser);
+                Log(Debug::Info) << "Loading keybindings file: " << keybinderUser;
+            }
         }
-    }
-    else
-        Log(Debug::Info) << "Loading keybindings file: " << keybinderUser;
+        else
+            Log(Debug::Info) << "Loading keybindings file: " << keybinderUser;
 
-    const auto userdefault = mCfgMgr.getUserConfigPath() / "gamecontrollerdb.txt";
-    const auto localdefault = mCfgMgr.getLocalPath() / "gamecontrollerdb.txt";
-    const auto globaldefault = mCfgMgr.getGlobalPath() / "gamecontrollerdb.txt";
+        const auto userdefault = mCfgMgr.getUserConfigPath() / "gamecontrollerdb.txt";
+        const auto localdefault = mCfgMgr.getLocalPath() / "gamecontrollerdb.txt";
+        const auto globaldefault = mCfgMgr.getGlobalPath() / "gamecontrollerdb.txt";
 
-    std::filesystem::path userGameControllerdb;
-    if (std::filesystem::exists(userdefault))
-        userGameControllerdb = userdefault;
+        std::filesystem::path userGameControllerdb;
+        if (std::filesystem::exists(userdefault))
+            userGameControllerdb = userdefault;
 
-    std::filesystem::path gameControllerdb;
-    if (std::filesystem::exists(localdefault))
-        gameControllerdb = localdefault;
-    else if (std::filesystem::exists(globaldefault))
-        gameControllerdb = globaldefault;
-    // else if it doesn't exist, pass in an empty string
+        std::filesystem::path gameControllerdb;
+        if (std::filesystem::exists(localdefault))
+            gameControllerdb = localdefault;
+        else if (std::filesystem::exists(globaldefault))
+            gameControllerdb = globaldefault;
+        // else if it doesn't exist, pass in an empty string
 
-    // gui needs our shaders path before everything else
-    mResourceSystem->getSceneManager()->setShaderPath(mResDir / "shaders");
+        // gui needs our shaders path before everything else
+        mResourceSystem->getSceneManager()->setShaderPath(mResDir / "shaders");
 
-    osg::GLExtensions& exts = SceneUtil::getGLExtensions();
-    bool shadersSupported = exts.glslLanguageVersion >= 1.2f;
+        osg::GLExtensions& exts = SceneUtil::getGLExtensions();
+        bool shadersSupported = exts.glslLanguageVersion >= 1.2f;
 
 #if OSG_VERSION_LESS_THAN(3, 6, 6)
-    // hack fix for https://github.com/openscenegraph/OpenSceneGraph/issues/1028
-    if (!osg::isGLExtensionSupported(exts.contextID, "NV_framebuffer_multisample_coverage"))
-        exts.glRenderbufferStorageMultisampleCoverageNV = nullptr;
+        // hack fix for https://github.com/openscenegraph/OpenSceneGraph/issues/1028
+        if (!osg::isGLExtensionSupported(exts.contextID, "NV_framebuffer_multisample_coverage"))
+            exts.glRenderbufferStorageMultisampleCoverageNV = nullptr;
 #endif
 
-    osg::ref_ptr<osg::Group> guiRoot = new osg::Group;
-    guiRoot->setName("GUI Root");
-    guiRoot->setNodeMask(MWRender::Mask_GUI);
-    mStereoManager->disableStereoForNode(guiRoot);
-    rootNode->addChild(guiRoot);
+        guiRoot->setName("GUI Root");
+        guiRoot->setNodeMask(MWRender::Mask_GUI);
+        mStereoManager->disableStereoForNode(guiRoot);
+        rootNode->addChild(guiRoot);
 
-    mWindowManager = std::make_unique<MWGui::WindowManager>(mWindow, mViewer, guiRoot, mResourceSystem.get(),
-        mWorkQueue.get(), mCfgMgr.getLogPath(), mScriptConsoleMode, mTranslationDataStorage, mEncoding,
-        Version::getOpenmwVersionDescription(), shadersSupported, mCfgMgr);
-    mEnvironment.setWindowManager(*mWindowManager);
+        mWindowManager = std::make_unique<MWGui::WindowManager>(mWindow, mViewer, guiRoot, mResourceSystem.get(),
+            mWorkQueue.get(), mCfgMgr.getLogPath(), mScriptConsoleMode, mTranslationDataStorage, mEncoding,
+            Version::getOpenmwVersionDescription(), shadersSupported, mCfgMgr);
+        mEnvironment.setWindowManager(*mWindowManager);
 
-    mInputManager = std::make_unique<MWInput::InputManager>(mWindow, mViewer, mScreenCaptureHandler, keybinderUser,
-        keybinderUserExists, userGameControllerdb, gameControllerdb, mGrab);
-    mEnvironment.setInputManager(*mInputManager);
+        mInputManager = std::make_unique<MWInput::InputManager>(mWindow, mViewer, mScreenCaptureHandler,
+            keybinderUser, keybinderUserExists, userGameControllerdb, gameControllerdb, mGrab);
+        mEnvironment.setInputManager(*mInputManager);
+    });
 
-    // Create sound system
-    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound);
-    mEnvironment.setSoundManager(*mSoundManager);
+    for (const Misc::TaskGraph::Timing& timing : startup.run())
+        Log(Debug::Info) << "Initialised " << timing.mName << " in "
+                         << std::chrono::duration_cast<std::chrono::milliseconds>(timing.mDuration).count()
+                         << " ms, started after "
+                         << std::chrono::duration_cast<std::chrono::milliseconds>(timing.mStart).count() << " ms";
 
     // Create the world
     mWorld = std::make_unique<MWWorld::World>(
@@ -849,6 +1008,13 @@ void OMW::Engine::prepareEngine()
     listener->loadingOff();
 
     mWorld->init(mViewer, std::move(rootNode), mWorkQueue.get(), *mUnrefQueue);
+    if (Resource::GpuTimer* gpuTimer = mWorld->getRenderingManager()->getGpuTimer())
+    {
+        // The GUI is drawn by the cameras the GUI platform added to its root
+        for (unsigned i = 0; i < guiRoot->getNumChildren(); ++i)
+            if (osg::Camera* camera = guiRoot->getChild(i)->asCamera())
+                gpuTimer->addCamera(*camera, Resource::GpuStage::Gui);
+    }
     mEnvironment.setWorldScene(mWorld->getWorldScene());
     mWorld->setupPlayer();
     mWorld->setRandomSeed(mRandomSeed);
@@ -887,6 +1053,13 @@ void OMW::Engine::prepareEngine()
     mScriptManager = std::make_unique<MWScript::ScriptManager>(mWorld->getStore(), *mScriptContext, mWarningsMode,
         mScriptBlacklistUse ? mScriptBlacklist : std::vector<ESM::RefId>());
     mEnvironment.setScriptManager(*mScriptManager);
+    if (Settings::general().mScriptCache)
+    {
+        mScriptManager->setScriptCache(
+            std::make_unique<Compiler::ScriptCache>(mCfgMgr.getCachePath() / "scripts", mWorld->getContentKey()));
+        if (Settings::general().mPreloadScriptCache)
+            mScriptManager->preloadScriptCache(*mWorkQueue);
+    }
 
     // Create game mechanics system
     mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
@@ -933,6 +1106,28 @@ void OMW::Engine::go()
     Log(Debug::Info) << "SDL version: " << (int)sdlVersion.major << "." << (int)sdlVersion.minor << "."
                      << (int)sdlVersion.patch;
 
+#ifdef OPENMW_TRACING
+#ifdef _WIN32
+    if (const auto* traceFile = _wgetenv(L"OPENMW_TRACE_FILE"))
+#else
+    if (const auto* traceFile = std::getenv("OPENMW_TRACE_FILE"))
+#endif
+        Debug::Tracing::start(traceFile);
+    Debug::Tracing::setThreadName("Main");
+#endif
+
+    if (!mInputReplayFile.empty())
+    {
+        mInputReplayer = std::make_unique<SDLUtil::InputReplayer>(mInputReplayFile);
+        mRandomSeed = mInputReplayer->getSeed();
+        Log(Debug::Info) << "Replaying input from " << mInputReplayFile << " with random seed " << mRandomSeed;
+    }
+    else if (!mInputRecordingFile.empty())
+    {
+        mInputRecorder = std::make_unique<SDLUtil::InputRecorder>(mInputRecordingFile, mRandomSeed);
+        Log(Debug::Info) << "Recording input to " << mInputRecordingFile;
+    }
+
     Misc::Rng::init(mRandomSeed);
 
     Settings::ShaderManager::get().load(mCfgMgr.getUserConfigPath() / "shaders.yaml");
@@ -953,6 +1148,8 @@ void OMW::Engine::go()
 
     prepareEngine();
 
+    mInputManager->setInputRecording(mInputRecorder.get(), mInputReplayer.get());
+
 #ifdef _WIN32
     const auto* stats_file = _wgetenv(L"OPENMW_OSG_STATS_FILE");
 #else
@@ -974,19 +1171,35 @@ void OMW::Engine::go()
                                 << "\": " << std::generic_category().message(errno);
     }
 
+    if (!mStatsExportFile.empty())
+    {
+        mStatsExporter = std::make_unique<Resource::StatsExporter>(mStatsExportFile, mStatsExportFormat,
+            mStatsExportAttributes.empty() ? Resource::getDefaultExportedStatNames() : mStatsExportAttributes,
+            mStatsExportInterval);
+        Log(Debug::Info) << "Stats will be exported to " << mStatsExportFile << " every " << mStatsExportInterval
+                         << " frames";
+    }
+
+    const bool collectStats = stats.is_open() || mStatsExporter != nullptr;
+
     // Setup profiler
-    osg::ref_ptr<Resource::Profiler> statsHandler = new Resource::Profiler(stats.is_open(), *mVFS);
+    osg::ref_ptr<Resource::Profiler> statsHandler = new Resource::Profiler(collectStats, *mVFS);
 
     initStatsHandler(*statsHandler);
 
     mViewer->addEventHandler(statsHandler);
 
-    osg::ref_ptr<Resource::StatsHandler> resourcesHandler = new Resource::StatsHandler(stats.is_open(), *mVFS);
+    osg::ref_ptr<Resource::StatsHandler> resourcesHandler = new Resource::StatsHandler(collectStats, *mVFS);
     mViewer->addEventHandler(resourcesHandler);
 
-    if (stats.is_open())
+    if (collectStats)
         Resource::collectStatistics(*mViewer);
 
+    // The default exported attributes don't depend on OPENMW_OSG_STATS_LIST
+    if (mStatsExporter != nullptr)
+        for (const char* name : { "frame_rate", "engine", "resource" })
+            mViewer->getViewerStats()->collectStats(name, true);
+
     // Start the game
     if (!mSaveGameFile.empty())
     {
@@ -1022,10 +1235,23 @@ void OMW::Engine::go()
     const std::chrono::steady_clock::duration maxSimulationInterval(std::chrono::milliseconds(200));
     while (!mViewer->done() && !mStateManager->hasQuitRequest())
     {
-        const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(
-                              std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval))
-                              .count()
-            * timeManager.getSimulationTimeScale();
+        const std::chrono::steady_clock::duration lastFrameDuration
+            = std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval);
+        double frameDuration = std::chrono::duration<double>(lastFrameDuration).count();
+
+        // Replayed frames take the recorded simulation time to make the run independent of the rendering speed
+        if (mInputReplayer != nullptr)
+        {
+            if (!mInputReplayer->nextFrame())
+            {
+                Log(Debug::Info) << "Input replay is finished after " << mInputReplayer->getFrameNumber()
+                                 << " frames";
+                break;
+            }
+            frameDuration = mInputReplayer->getFrameDuration();
+        }
+
+        const double dt = frameDuration * timeManager.getSimulationTimeScale();
 
         mViewer->advance(timeManager.getRenderingSimulationTime());
 
@@ -1036,6 +1262,8 @@ void OMW::Engine::go()
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
             continue;
         }
+        if (mInputRecorder != nullptr)
+            mInputRecorder->finishFrame(frameDuration);
         timeManager.updateIsPaused();
         if (!timeManager.isPaused())
         {
@@ -1043,26 +1271,36 @@ void OMW::Engine::go()
             timeManager.setRenderingSimulationTime(timeManager.getRenderingSimulationTime() + dt);
         }
 
-        if (stats)
+        if (collectStats)
         {
             // The delay is required because rendering happens in parallel to the main thread and stats from there is
-            // available with delay.
-            constexpr unsigned statsReportDelay = 3;
+            // available with delay. GPU timings are read back a few more frames later.
+            constexpr unsigned statsReportDelay = 5;
             if (frameNumber >= statsReportDelay)
             {
                 // Viewer frame number can be different from frameNumber because of loading screens which render new
                 // frames inside a simulation frame.
                 const unsigned currentFrameNumber = mViewer->getFrameStamp()->getFrameNumber();
                 for (unsigned i = frameNumber; i <= currentFrameNumber; ++i)
-                    reportStats(i - statsReportDelay, *mViewer, stats);
+                {
+                    if (stats)
+                        reportStats(i - statsReportDelay, *mViewer, stats);
+                    if (mStatsExporter != nullptr)
+                        mStatsExporter->collect(i - statsReportDelay, *mViewer->getViewerStats());
+                }
             }
         }
 
-        frameRateLimiter.limit();
+        if (mInputReplayer == nullptr)
+            frameRateLimiter.limit();
     }
 
     mLuaWorker->join();
 
+    mStatsExporter.reset();
+
+    Debug::Tracing::stop();
+
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
@@ -1130,3 +1368,27 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setInputRecordingFile(const std::filesystem::path& path)
+{
+    mInputRecordingFile = path;
+}
+
+void OMW::Engine::setInputReplayFile(const std::filesystem::path& path)
+{
+    mInputReplayFile = path;
+}
+
+void OMW::Engine::setHiddenWindow(bool hidden)
+{
+    mHiddenWindow = hidden;
+}
+
+void OMW::Engine::setStatsExport(const std::filesystem::path& path, Resource::StatsExportFormat format,
+    const std::vector<std::string>& attributes, unsigned interval)
+{
+    mStatsExportFile = path;
+    mStatsExportFormat = format;
+    mStatsExportAttributes = attributes;
+    mStatsExportInterval = interval;
+}
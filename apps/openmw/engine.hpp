@@ -2,6 +2,7 @@
 #define ENGINE_H
 
 #include <filesystem>
+#include <string>
 
 #include <components/compiler/extensions.hpp>
 #include <components/esm/refid.hpp>
@@ -17,6 +18,8 @@
 namespace Resource
 {
     class ResourceSystem;
+    class StatsExporter;
+    enum class StatsExportFormat;
 }
 
 namespace SceneUtil
@@ -47,6 +50,12 @@ namespace Stereo
     class Manager;
 }
 
+namespace SDLUtil
+{
+    class InputRecorder;
+    class InputReplayer;
+}
+
 namespace Files
 {
     struct ConfigurationManager;
@@ -173,6 +182,18 @@ namespace OMW
 
         unsigned int mRandomSeed;
 
+        std::filesystem::path mInputRecordingFile;
+        std::filesystem::path mInputReplayFile;
+        bool mHiddenWindow;
+        std::unique_ptr<SDLUtil::InputRecorder> mInputRecorder;
+        std::unique_ptr<SDLUtil::InputReplayer> mInputReplayer;
+
+        std::filesystem::path mStatsExportFile;
+        Resource::StatsExportFormat mStatsExportFormat;
+        std::vector<std::string> mStatsExportAttributes;
+        unsigned mStatsExportInterval;
+        std::unique_ptr<Resource::StatsExporter> mStatsExporter;
+
         Compiler::Extensions mExtensions;
         std::unique_ptr<Compiler::Context> mScriptContext;
 
@@ -181,12 +202,15 @@ namespace OMW
         std::vector<ESM::RefId> mScriptBlacklist;
         bool mScriptBlacklistUse;
         bool mNewGame;
+        float mSimulationTickTime = 0;
 
         // not implemented
         Engine(const Engine&);
         Engine& operator=(const Engine&);
 
-        void executeLocalScripts();
+        void executeLocalScripts(osg::Timer_t frameStart, unsigned frameNumber, osg::Stats& stats);
+
+        void updateSimulationTick(float frametime);
 
         bool frame(unsigned frameNumber, float dt);
 
@@ -262,9 +286,23 @@ namespace OMW
 
         void setRandomSeed(unsigned int seed);
 
+        /// Record the player input, frame durations and random seed into a file
+        void setInputRecordingFile(const std::filesystem::path& path);
+
+        /// Replay the recorded input instead of the player one and quit when it's over
+        void setInputReplayFile(const std::filesystem::path& path);
+
+        /// Render into a window which is never shown
+        void setHiddenWindow(bool hidden);
+
+        /// Write the stats attributes into a file every interval frames, the default ones if attributes is empty
+        void setStatsExport(const std::filesystem::path& path, Resource::StatsExportFormat format,
+            const std::vector<std::string>& attributes, unsigned interval);
+
     private:
         Files::ConfigurationManager& mCfgMgr;
         int mGlMaxTextureImageUnits;
+        std::string mGlDriver;
     };
 }
 
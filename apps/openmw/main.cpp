@@ -5,6 +5,7 @@
 #include <components/misc/osgpluginchecker.hpp>
 #include <components/misc/rng.hpp>
 #include <components/platform/platform.hpp>
+#include <components/resource/statsexporter.hpp>
 #include <components/version/version.hpp>
 
 #include "mwgui/debugwindow.hpp"
@@ -164,6 +165,19 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
     engine.setSoundUsage(!variables["no-sound"].as<bool>());
     engine.setActivationDistanceOverride(variables["activate-dist"].as<int>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+    engine.setInputRecordingFile(variables["record-input"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setInputReplayFile(variables["replay-input"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setHiddenWindow(variables["hidden-window"].as<bool>());
+
+    const std::string& statsExportFormat = variables["stats-export-format"].as<std::string>();
+    const std::optional<Resource::StatsExportFormat> format = Resource::parseStatsExportFormat(statsExportFormat);
+    if (!format.has_value())
+    {
+        Log(Debug::Error) << "Unknown stats export format: " << statsExportFormat << ". Aborting...";
+        return false;
+    }
+    engine.setStatsExport(variables["stats-export"].as<Files::MaybeQuotedPath>().u8string(), *format,
+        variables["stats-export-attribute"].as<StringsVector>(), variables["stats-export-interval"].as<unsigned int>());
 
     return true;
 }
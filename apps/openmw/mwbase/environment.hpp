@@ -60,6 +60,8 @@ namespace MWBase
         l10n::Manager* mL10nManager = nullptr;
         float mFrameRateLimit = 0;
         float mFrameDuration = 0;
+        float mSimulationTickDuration = 0;
+        bool mSimulationTick = true;
 
     public:
         Environment();
@@ -132,6 +134,18 @@ namespace MWBase
 
         void setFrameDuration(float value) { mFrameDuration = value; }
 
+        /// Whether AI and Lua updates run in this frame, see the simulation tick rate setting
+        bool isSimulationTick() const { return mSimulationTick; }
+
+        /// Time covered by the simulation tick of this frame, including the frames without a tick before it
+        float getSimulationTickDuration() const { return mSimulationTickDuration; }
+
+        void setSimulationTick(bool tick, float duration)
+        {
+            mSimulationTick = tick;
+            mSimulationTickDuration = duration;
+        }
+
         /// Return instance of this class.
         static const Environment& get()
         {
@@ -6,6 +6,7 @@
 #include <string>
 #include <string_view>
 
+#include <cstddef>
 #include <cstdint>
 
 #include "../mwdialogue/journalentry.hpp"
@@ -93,6 +94,9 @@ namespace MWBase
         virtual TTopicIter topicEnd() const = 0;
         ///< Iterator pointing past the last topic.
 
+        virtual std::size_t getRevision() const = 0;
+        ///< Changes whenever journal entries or topics are added or removed.
+
         virtual int countSavedGameRecords() const = 0;
 
         virtual void write(ESM::ESMWriter& writer, Loading::Listener& progress) const = 0;
@@ -22,6 +22,11 @@ namespace Loading
     class Listener;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace ESM
 {
     class ESMReader;
@@ -150,6 +155,11 @@ namespace MWBase
             = 0;
 
         virtual std::string formatResourceUsageStats() const = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
+        // Writes the calls recorded by the Lua profiler as a Chrome trace, if the recording is enabled
+        virtual void saveProfilerTrace() = 0;
     };
 
 }
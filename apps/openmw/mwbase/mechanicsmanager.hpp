@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <map>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -64,6 +65,9 @@ namespace MWBase
         virtual void updateCell(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) = 0;
         ///< Moves an object to a new cell
 
+        virtual void updatePosition(const MWWorld::Ptr& ptr) = 0;
+        ///< Notify about a changed position of an object
+
         virtual void drop(const MWWorld::CellStore* cellStore) = 0;
         ///< Deregister all objects in the given cell.
 
@@ -82,7 +86,8 @@ namespace MWBase
         virtual void setPlayerClass(const ESM::Class& class_) = 0;
         ///< Set player class to custom class.
 
-        virtual void restoreDynamicStats(const MWWorld::Ptr& actor, double hours, bool sleep) = 0;
+        virtual void restoreDynamicStats(std::span<const MWWorld::Ptr> actors, double hours, bool sleep) = 0;
+        ///< Restore dynamic stats of the actors for the given number of hours. Actors are processed in parallel.
 
         virtual void rest(double hours, bool sleep) = 0;
         ///< If the player is sleeping or waiting, this should be called every hour.
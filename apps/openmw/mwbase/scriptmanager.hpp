@@ -49,6 +49,9 @@ namespace MWBase
         ///< Compile script with the given namen
         /// \return Success?
 
+        virtual bool isActivationOnly(const ESM::RefId& name) const = 0;
+        ///< Does the compiled script only react to the activation of its object? False if not compiled yet.
+
         virtual std::pair<int, int> compileAll() = 0;
         ///< Compile all scripts
         /// \return count, success
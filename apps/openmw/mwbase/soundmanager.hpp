@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -21,6 +22,11 @@ namespace ESM
     class RefId;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWSound
 {
     // Each entry excepts of MaxCount should be used only in one place
@@ -236,6 +242,11 @@ namespace MWBase
 
         virtual void updatePtr(const MWWorld::ConstPtr& old, const MWWorld::ConstPtr& updated) = 0;
 
+        virtual void preloadSounds(std::span<const ESM::RefId> soundIds) = 0;
+        ///< Decode given sounds in background to avoid doing it on the main thread once they are played.
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
         void setSimulationTimeScale(float scale) { mSimulationTimeScale = scale; }
         float getSimulationTimeScale() const { return mSimulationTimeScale; }
 
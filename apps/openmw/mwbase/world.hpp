@@ -280,6 +280,12 @@ namespace MWBase
             const MWWorld::Ptr& ptr, const osg::Vec3f& rot, RotationFlags flags = RotationFlag_inverseOrder)
             = 0;
 
+        virtual void beginBatchedUpdate() = 0;
+        ///< Defer the physics updates of the objects moved, rotated or scaled until endBatchedUpdate, so each one is
+        /// updated once. Calls can be nested.
+
+        virtual void endBatchedUpdate() = 0;
+
         virtual MWWorld::Ptr placeObject(
             const MWWorld::ConstPtr& ptr, MWWorld::CellStore* cell, const ESM::Position& pos)
             = 0;
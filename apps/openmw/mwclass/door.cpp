@@ -329,6 +329,14 @@ namespace MWClass
         return customData.mDoorState;
     }
 
+    void Door::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& out) const
+    {
+        const MWWorld::LiveCellRef<ESM::Door>* ref = ptr.get<ESM::Door>();
+        for (const ESM::RefId& sound : { ref->mBase->mOpenSound, ref->mBase->mCloseSound })
+            if (!sound.empty())
+                out.push_back(sound);
+    }
+
     void Door::setDoorState(const MWWorld::Ptr& ptr, MWWorld::DoorState state) const
     {
         if (ptr.getCellRef().getTeleport())
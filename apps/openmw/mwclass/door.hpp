@@ -57,6 +57,8 @@ namespace MWClass
         /// This does not actually cause the door to move. Use World::activateDoor instead.
         void setDoorState(const MWWorld::Ptr& ptr, MWWorld::DoorState state) const override;
 
+        void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& out) const override;
+
         void readAdditionalState(const MWWorld::Ptr& ptr, const ESM::ObjectState& state) const override;
         ///< Read additional state from \a state into \a ptr.
 
@@ -24,6 +24,7 @@
 #include "../mwmechanics/magiceffects.hpp"
 #include "../mwmechanics/npcstats.hpp"
 
+#include "infoindex.hpp"
 #include "selectwrapper.hpp"
 
 namespace
@@ -731,6 +732,31 @@ bool MWDialogue::Filter::couldPotentiallyMatch(const ESM::DialInfo& info) const
     return testActor(info) && matchesStaticFilters(info, mActor);
 }
 
+template <class Function>
+void MWDialogue::Filter::forEachCandidate(const ESM::Dialogue& dialogue, Function&& function) const
+{
+    const InfoIndex* index = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>().getInfoIndex(dialogue);
+    if (index == nullptr)
+    {
+        for (const auto& info : dialogue.mInfo)
+            if (function(info))
+                return;
+        return;
+    }
+
+    InfoIndex::Actor actor;
+    actor.mId = mActor.getCellRef().getRefId();
+    actor.mIsNpc = mActor.getType() == ESM::NPC::sRecordId;
+    if (actor.mIsNpc)
+    {
+        const ESM::NPC& npc = *mActor.get<ESM::NPC>()->mBase;
+        actor.mRace = npc.mRace;
+        actor.mClass = npc.mClass;
+        actor.mFaction = mActor.getClass().getPrimaryFaction(mActor);
+    }
+    index->forEachCandidate(actor, std::forward<Function>(function));
+}
+
 std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
     const ESM::Dialogue& dialogue, bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition) const
 {
@@ -739,20 +765,20 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (const auto& info : dialogue.mInfo)
-    {
+    forEachCandidate(dialogue, [&](const ESM::DialInfo& info) {
         if (testActor(info) && testPlayer(info) && testSelectStructs(info))
         {
             if (testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&dialogue, &info);
                 if (!searchAll)
-                    break;
+                    return true;
             }
             else
                 infoRefusal = true;
         }
-    }
+        return false;
+    });
 
     if (infos.empty() && infoRefusal && fallbackToInfoRefusal)
     {
@@ -763,14 +789,16 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find(ESM::RefId::stringRefId("Info Refusal"));
 
-        for (const auto& info : infoRefusalDialogue.mInfo)
+        forEachCandidate(infoRefusalDialogue, [&](const ESM::DialInfo& info) {
             if (testActor(info) && testPlayer(info) && testSelectStructs(info)
                 && testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&infoRefusalDialogue, &info);
                 if (!searchAll)
-                    break;
+                    return true;
             }
+            return false;
+        });
     }
 
     return infos;
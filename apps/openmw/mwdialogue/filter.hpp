@@ -52,6 +52,10 @@ namespace MWDialogue
         bool hasFactionRankReputationRequirements(
             const MWWorld::Ptr& actor, const ESM::RefId& factionId, int rank) const;
 
+        template <class Function>
+        void forEachCandidate(const ESM::Dialogue& dialogue, Function&& function) const;
+        ///< Call \a function for the infos that could be given by the actor until it returns true
+
     public:
         using Response = std::pair<const ESM::Dialogue*, const ESM::DialInfo*>;
 
@@ -0,0 +1,26 @@
+#include "infoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+
+namespace MWDialogue
+{
+    InfoIndex::InfoIndex(const ESM::Dialogue& dialogue)
+    {
+        mInfos.reserve(dialogue.mInfo.size());
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const std::uint32_t index = static_cast<std::uint32_t>(mInfos.size());
+            mInfos.push_back(&info);
+            if (!info.mActor.empty())
+                mByActor[info.mActor].push_back(index);
+            else if (!info.mRace.empty())
+                mByRace[info.mRace].push_back(index);
+            else if (!info.mClass.empty())
+                mByClass[info.mClass].push_back(index);
+            else if (!info.mFactionLess && !info.mFaction.empty())
+                mByFaction[info.mFaction].push_back(index);
+            else
+                mOther.push_back(index);
+        }
+    }
+}
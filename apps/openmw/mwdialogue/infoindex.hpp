@@ -0,0 +1,93 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <components/esm/refid.hpp>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// @brief Infos of a dialogue grouped by the most specific actor filter they have
+    /// @par Each info belongs to one group: the actor id, the NPC race, the NPC class or the NPC faction it requires,
+    /// or the group of infos without any of these filters. An actor can only be given the infos from the groups
+    /// matching it, other filters still have to be checked.
+    class InfoIndex
+    {
+    public:
+        struct Actor
+        {
+            ESM::RefId mId;
+            bool mIsNpc = false;
+            ESM::RefId mRace;
+            ESM::RefId mClass;
+            ESM::RefId mFaction;
+        };
+
+        explicit InfoIndex(const ESM::Dialogue& dialogue);
+
+        /// Call the function for the infos that could match the actor in the dialogue order until it returns true
+        template <class Function>
+        void forEachCandidate(const Actor& actor, Function&& function) const
+        {
+            std::array<std::span<const std::uint32_t>, 5> groups;
+            std::size_t groupsCount = 0;
+            const auto addGroup = [&](const Groups& values, const ESM::RefId& key) {
+                const auto it = values.find(key);
+                if (it != values.end())
+                    groups[groupsCount++] = it->second;
+            };
+            addGroup(mByActor, actor.mId);
+            if (actor.mIsNpc)
+            {
+                addGroup(mByRace, actor.mRace);
+                addGroup(mByClass, actor.mClass);
+                addGroup(mByFaction, actor.mFaction);
+                groups[groupsCount++] = mOther;
+            }
+
+            // Merge groups sorted by info position
+            while (true)
+            {
+                std::size_t next = groupsCount;
+                std::uint32_t nextIndex = std::numeric_limits<std::uint32_t>::max();
+                for (std::size_t i = 0; i < groupsCount; ++i)
+                {
+                    if (!groups[i].empty() && groups[i].front() < nextIndex)
+                    {
+                        next = i;
+                        nextIndex = groups[i].front();
+                    }
+                }
+                if (next == groupsCount)
+                    return;
+                groups[next] = groups[next].subspan(1);
+                if (function(*mInfos[nextIndex]))
+                    return;
+            }
+        }
+
+    private:
+        using Groups = std::unordered_map<ESM::RefId, std::vector<std::uint32_t>>;
+
+        std::vector<const ESM::DialInfo*> mInfos;
+        Groups mByActor;
+        Groups mByRace;
+        Groups mByClass;
+        Groups mByFaction;
+        std::vector<std::uint32_t> mOther;
+    };
+}
+
+#endif
@@ -77,6 +77,7 @@ namespace MWDialogue
         mJournal.clear();
         mQuests.clear();
         mTopics.clear();
+        ++mRevision;
     }
 
     void Journal::addEntry(const ESM::RefId& id, int index, const MWWorld::Ptr& actor)
@@ -112,6 +113,7 @@ namespace MWDialogue
         if (!entry.getText().empty())
         {
             mJournal.push_back(entry);
+            ++mRevision;
             MWBase::Environment::get().getWindowManager()->messageBox("#{sJournalEntry}");
         }
     }
@@ -130,6 +132,7 @@ namespace MWDialogue
         JournalEntry entry(topicId, infoId, actor);
         entry.mActorName = actor.getClass().getName(actor);
         topic.addEntry(entry);
+        ++mRevision;
     }
 
     void Journal::removeLastAddedTopicResponse(const ESM::RefId& topicId, std::string_view actorName)
@@ -140,6 +143,7 @@ namespace MWDialogue
 
         if (topic.begin() == topic.end())
             mTopics.erase(mTopics.find(topicId)); // All responses removed -> remove topic
+        ++mRevision;
     }
 
     int Journal::getJournalIndex(const ESM::RefId& id) const
@@ -250,6 +254,8 @@ namespace MWDialogue
 
     void Journal::readRecord(ESM::ESMReader& reader, uint32_t type)
     {
+        ++mRevision;
+
         if (type == ESM::REC_JOUR)
         {
             ESM::JournalEntry record;
@@ -13,6 +13,7 @@ namespace MWDialogue
         TEntryContainer mJournal;
         TQuestContainer mQuests;
         TTopicContainer mTopics;
+        std::size_t mRevision = 0;
 
     private:
         Topic& getTopic(const ESM::RefId& id);
@@ -69,6 +70,8 @@ namespace MWDialogue
         TTopicIter topicEnd() const override;
         ///< Iterator pointing past the last topic.
 
+        std::size_t getRevision() const override { return mRevision; }
+
         int countSavedGameRecords() const override;
 
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
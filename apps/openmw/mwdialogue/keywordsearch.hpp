@@ -1,18 +1,23 @@
 #ifndef GAME_MWDIALOGUE_KEYWORDSEARCH_H
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
-#include <algorithm> // std::reverse
-#include <cctype>
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-#include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/lower.hpp>
 
 namespace MWDialogue
 {
 
+    /// @brief Finds the seeded keywords in a text ignoring the case of ASCII letters.
+    /// @note The keywords form an Aho-Corasick automaton, so a text is searched in one pass no matter how many
+    /// keywords there are. The links of the automaton are built by the first search after the keywords change.
     template <typename value_t>
     class KeywordSearch
     {
@@ -26,214 +31,220 @@ namespace MWDialogue
             value_t mValue;
         };
 
+        KeywordSearch()
+            : mNodes(1)
+        {
+        }
+
         void seed(std::string_view keyword, value_t value)
         {
             if (keyword.empty())
                 return;
-            seed_impl(keyword, std::move(value), 0, mRoot);
+
+            std::size_t node = 0;
+            for (char c : keyword)
+                node = addChild(node, Misc::StringUtils::toLower(c));
+
+            if (mNodes[node].mKeyword != sNone)
+            {
+                if (mKeywords[mNodes[node].mKeyword].mKeyword == keyword)
+                    throw std::runtime_error("duplicate keyword inserted");
+                // Keywords differing only by case are found as the first one
+                return;
+            }
+
+            mNodes[node].mKeyword = mKeywords.size();
+            mKeywords.push_back(Keyword{ std::string(keyword), std::move(value) });
+            mLinks.clear();
         }
 
         void clear()
         {
-            mRoot.mChildren.clear();
-            mRoot.mKeyword.clear();
+            mNodes.assign(1, Node());
+            mKeywords.clear();
+            mLinks.clear();
         }
 
-        bool containsKeyword(std::string_view keyword, value_t& value)
+        bool containsKeyword(std::string_view keyword, value_t& value) const
         {
-            auto it = keyword.begin();
-            auto current = mRoot.mChildren.find(Misc::StringUtils::toLower(*it));
-            if (current == mRoot.mChildren.end())
-                return false;
-            else if (Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
-            {
-                value = current->second.mValue;
-                return true;
-            }
-
-            for (++it; it != keyword.end(); ++it)
+            std::size_t node = 0;
+            for (char c : keyword)
             {
-                auto next = current->second.mChildren.find(Misc::StringUtils::toLower(*it));
-                if (next == current->second.mChildren.end())
+                node = findChild(node, Misc::StringUtils::toLower(c));
+                if (node == sNone)
                     return false;
-                if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
-                {
-                    value = next->second.mValue;
-                    return true;
-                }
-                current = next;
             }
-            return false;
+            if (mNodes[node].mKeyword == sNone)
+                return false;
+            value = mKeywords[mNodes[node].mKeyword].mValue;
+            return true;
         }
 
         static bool sortMatches(const Match& left, const Match& right) { return left.mBeg < right.mBeg; }
 
+        /// Add the keywords found in the text to out. A keyword inside or overlapping a longer one is not added.
         void highlightKeywords(Point beg, Point end, std::vector<Match>& out) const
         {
-            std::vector<Match> matches;
-            for (Point i = beg; i != end; ++i)
+            if (mLinks.empty())
+                buildLinks();
+
+            // The longest keyword starting at each position of the text
+            std::vector<std::size_t> longest(static_cast<std::size_t>(end - beg), sNone);
+            std::size_t state = 0;
+            std::size_t position = 0;
+            for (Point it = beg; it != end; ++it, ++position)
             {
-                // check first character
-                typename Entry::childen_t::const_iterator candidate
-                    = mRoot.mChildren.find(Misc::StringUtils::toLower(*i));
-
-                // no match, on to next character
-                if (candidate == mRoot.mChildren.end())
-                    continue;
-
-                // see how far the match goes
-                Point j = i;
-
-                // some keywords might be longer variations of other keywords, so we definitely need a list of
-                // candidates the first element in the pair is length of the match, i.e. depth from the first character
-                // on
-                std::vector<typename std::pair<std::ptrdiff_t, typename Entry::childen_t::const_iterator>> candidates;
-
-                while ((j + 1) != end)
+                state = getNextState(state, Misc::StringUtils::toLower(*it));
+                for (std::size_t node = mLinks[state].mOutput; node != sNone; node = mLinks[node].mNextOutput)
                 {
-                    typename Entry::childen_t::const_iterator next
-                        = candidate->second.mChildren.find(Misc::StringUtils::toLower(*++j));
-
-                    if (next == candidate->second.mChildren.end())
-                    {
-                        if (candidate->second.mKeyword.size() > 0)
-                            candidates.push_back(std::make_pair((j - i), candidate));
-                        break;
-                    }
-
-                    candidate = next;
-
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j - i), candidate));
-                }
-
-                if (candidates.empty())
-                    continue; // didn't match enough to disambiguate, on to next character
-
-                // shorter candidates will be added to the vector first. however, we want to check against longer
-                // candidates first
-                std::reverse(candidates.begin(), candidates.end());
-
-                for (const auto& [pos, c] : candidates)
-                {
-                    candidate = c;
-                    // try to match the rest of the keyword
-                    Point k = i + pos;
-                    Point t = candidate->second.mKeyword.begin() + (k - i);
-
-                    while (k != end && t != candidate->second.mKeyword.end())
-                    {
-                        if (Misc::StringUtils::toLower(*k) != Misc::StringUtils::toLower(*t))
-                            break;
-
-                        ++k, ++t;
-                    }
-
-                    // didn't match full keyword, try the next candidate
-                    if (t != candidate->second.mKeyword.end())
-                        continue;
-
-                    // found a keyword, but there might still be longer keywords that start somewhere _within_ this
-                    // keyword we will resolve these overlapping keywords later, choosing the longest one in case of
-                    // conflict
-                    Match match;
-                    match.mValue = candidate->second.mValue;
-                    match.mBeg = i;
-                    match.mEnd = k;
-                    matches.push_back(match);
-                    break;
+                    const std::size_t keyword = mNodes[node].mKeyword;
+                    const std::size_t length = mKeywords[keyword].mKeyword.size();
+                    std::size_t& candidate = longest[position + 1 - length];
+                    if (candidate == sNone || mKeywords[candidate].mKeyword.size() < length)
+                        candidate = keyword;
                 }
             }
 
-            // resolve overlapping keywords
-            while (!matches.empty())
+            std::vector<Match> matches;
+            for (std::size_t i = 0; i < longest.size(); ++i)
             {
-                std::size_t longestKeywordSize = 0;
-                typename std::vector<Match>::iterator longestKeyword = matches.begin();
-                for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end(); ++it)
-                {
-                    std::size_t size = it->mEnd - it->mBeg;
-                    if (size > longestKeywordSize)
-                    {
-                        longestKeywordSize = size;
-                        longestKeyword = it;
-                    }
-
-                    typename std::vector<Match>::iterator next = it;
-                    ++next;
-
-                    if (next == matches.end())
-                        break;
-
-                    if (it->mEnd <= next->mBeg)
-                    {
-                        break; // no overlap
-                    }
-                }
-
-                Match keyword = *longestKeyword;
-                matches.erase(longestKeyword);
-                out.push_back(keyword);
-                // erase anything that overlaps with the keyword we just added to the output
-                for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end();)
-                {
-                    if (it->mBeg < keyword.mEnd && it->mEnd > keyword.mBeg)
-                        it = matches.erase(it);
-                    else
-                        ++it;
-                }
+                if (longest[i] == sNone)
+                    continue;
+                const Keyword& keyword = mKeywords[longest[i]];
+                const Point matchBeg = beg + static_cast<std::ptrdiff_t>(i);
+                matches.push_back(
+                    Match{ matchBeg, matchBeg + static_cast<std::ptrdiff_t>(keyword.mKeyword.size()), keyword.mValue });
             }
 
+            resolveOverlaps(matches, out);
+
             std::sort(out.begin(), out.end(), sortMatches);
         }
 
     private:
-        struct Entry
-        {
-            typedef std::map<wchar_t, Entry> childen_t;
+        static constexpr std::size_t sNone = std::numeric_limits<std::size_t>::max();
 
+        struct Keyword
+        {
             std::string mKeyword;
             value_t mValue;
-            childen_t mChildren;
         };
 
-        void seed_impl(std::string_view keyword, value_t value, size_t depth, Entry& entry)
+        struct Node
         {
-            auto ch = Misc::StringUtils::toLower(keyword.at(depth));
+            // Sorted by the lower case character
+            std::vector<std::pair<char, std::size_t>> mChildren;
+            std::size_t mKeyword = sNone;
+        };
 
-            typename Entry::childen_t::iterator j = entry.mChildren.find(ch);
+        struct Link
+        {
+            // The node of the longest proper suffix which is in the automaton
+            std::size_t mFailure = 0;
+            // The node of the longest keyword ending at this node, the node itself if it ends a keyword
+            std::size_t mOutput = sNone;
+            // For a node ending a keyword, the node of the next shorter keyword ending at it
+            std::size_t mNextOutput = sNone;
+        };
 
-            if (j == entry.mChildren.end())
+        std::size_t findChild(std::size_t node, char c) const
+        {
+            const auto& children = mNodes[node].mChildren;
+            const auto it = std::lower_bound(children.begin(), children.end(), c,
+                [](const std::pair<char, std::size_t>& child, char value) { return child.first < value; });
+            if (it == children.end() || it->first != c)
+                return sNone;
+            return it->second;
+        }
+
+        std::size_t addChild(std::size_t node, char c)
+        {
+            auto& children = mNodes[node].mChildren;
+            const auto it = std::lower_bound(children.begin(), children.end(), c,
+                [](const std::pair<char, std::size_t>& child, char value) { return child.first < value; });
+            if (it != children.end() && it->first == c)
+                return it->second;
+            const std::size_t child = mNodes.size();
+            children.emplace(it, c, child);
+            mNodes.emplace_back();
+            return child;
+        }
+
+        std::size_t getNextState(std::size_t state, char c) const
+        {
+            while (true)
             {
-                entry.mChildren[ch].mValue = std::move(value);
-                entry.mChildren[ch].mKeyword = keyword;
+                const std::size_t next = findChild(state, c);
+                if (next != sNone)
+                    return next;
+                if (state == 0)
+                    return 0;
+                state = mLinks[state].mFailure;
             }
-            else
-            {
-                if (j->second.mKeyword.size() > 0)
-                {
-                    if (keyword == j->second.mKeyword)
-                        throw std::runtime_error("duplicate keyword inserted");
-
-                    const auto& pushKeyword = j->second.mKeyword;
+        }
 
-                    if (depth >= pushKeyword.size())
-                        throw std::runtime_error("unexpected");
+        void buildLinks() const
+        {
+            mLinks.assign(mNodes.size(), Link());
 
-                    if (depth + 1 < pushKeyword.size())
+            // Breadth first, the links of a node point to shallower nodes
+            std::vector<std::size_t> queue;
+            queue.reserve(mNodes.size());
+            queue.push_back(0);
+            for (std::size_t i = 0; i < queue.size(); ++i)
+            {
+                const std::size_t node = queue[i];
+                for (const auto& [c, child] : mNodes[node].mChildren)
+                {
+                    Link& link = mLinks[child];
+                    link.mFailure = node == 0 ? 0 : getNextState(mLinks[node].mFailure, c);
+                    const std::size_t failureOutput = mLinks[link.mFailure].mOutput;
+                    if (mNodes[child].mKeyword != sNone)
                     {
-                        seed_impl(pushKeyword, j->second.mValue, depth + 1, j->second);
-                        j->second.mKeyword.clear();
+                        link.mOutput = child;
+                        link.mNextOutput = failureOutput;
                     }
+                    else
+                        link.mOutput = failureOutput;
+                    queue.push_back(child);
                 }
-                if (depth + 1 == keyword.size())
-                    j->second.mKeyword = value;
-                else // depth+1 < keyword.size()
-                    seed_impl(keyword, std::move(value), depth + 1, j->second);
             }
         }
 
-        Entry mRoot;
+        // Of overlapping keywords the longest is kept, going through each chain of overlapping keywords from the
+        // beginning of the text. The matches are sorted and start at different positions.
+        static void resolveOverlaps(const std::vector<Match>& matches, std::vector<Match>& out)
+        {
+            std::vector<bool> removed(matches.size(), false);
+            const auto nextRemaining = [&](std::size_t i) {
+                while (i < matches.size() && removed[i])
+                    ++i;
+                return i;
+            };
+
+            for (std::size_t first = nextRemaining(0); first < matches.size(); first = nextRemaining(first))
+            {
+                std::size_t longestMatch = first;
+                for (std::size_t previous = first, i = nextRemaining(first + 1); i < matches.size();
+                     previous = i, i = nextRemaining(i + 1))
+                {
+                    if (matches[previous].mEnd <= matches[i].mBeg)
+                        break;
+                    if (matches[i].mEnd - matches[i].mBeg > matches[longestMatch].mEnd - matches[longestMatch].mBeg)
+                        longestMatch = i;
+                }
+
+                const Match& keyword = matches[longestMatch];
+                out.push_back(keyword);
+                for (std::size_t i = first; i < matches.size() && matches[i].mBeg < keyword.mEnd; ++i)
+                    if (matches[i].mEnd > keyword.mBeg)
+                        removed[i] = true;
+            }
+        }
+
+        std::vector<Node> mNodes;
+        std::vector<Keyword> mKeywords;
+        mutable std::vector<Link> mLinks;
     };
 
 }
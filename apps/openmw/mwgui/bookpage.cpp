@@ -1,6 +1,7 @@
 #include "bookpage.hpp"
 
 #include <optional>
+#include <unordered_map>
 
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_FontManager.h"
@@ -23,6 +24,27 @@ namespace MWGui
     static bool ucsCarriageReturn(int codePoint);
     static bool ucsBreakingSpace(int codePoint);
 
+    // Metrics are needed for every character laid out or rendered, so they are scaled once per font and character
+    static const GlyphInfo& getGlyphInfo(MyGUI::IFont* font, MyGUI::Char ch)
+    {
+        struct FontGlyphs
+        {
+            int mFontSize = 0;
+            std::unordered_map<MyGUI::Char, GlyphInfo> mGlyphs;
+        };
+
+        static std::unordered_map<const MyGUI::IFont*, FontGlyphs> cache;
+
+        FontGlyphs& glyphs = cache[font];
+        const int fontSize = Settings::gui().mFontSize;
+        if (glyphs.mFontSize != fontSize)
+        {
+            glyphs.mGlyphs.clear();
+            glyphs.mFontSize = fontSize;
+        }
+        return glyphs.mGlyphs.try_emplace(ch, font, ch).first->second;
+    }
+
     struct BookTypesetter::Style
     {
         virtual ~Style() {}
@@ -519,7 +541,7 @@ namespace MWGui
 
                 while (!stream.eof() && !ucsLineBreak(stream.peek()) && ucsBreakingSpace(stream.peek()))
                 {
-                    MWGui::GlyphInfo info = GlyphInfo(style->mFont, stream.peek());
+                    const GlyphInfo& info = getGlyphInfo(style->mFont, stream.peek());
                     if (info.charFound)
                         space_width += static_cast<int>(info.advance + info.bearingX);
                     stream.consume();
@@ -529,7 +551,7 @@ namespace MWGui
 
                 while (!stream.eof() && !ucsLineBreak(stream.peek()) && !ucsBreakingSpace(stream.peek()))
                 {
-                    MWGui::GlyphInfo info = GlyphInfo(style->mFont, stream.peek());
+                    const GlyphInfo& info = getGlyphInfo(style->mFont, stream.peek());
                     if (info.charFound)
                         word_width += static_cast<int>(info.advance + info.bearingX);
                     stream.consume();
@@ -778,7 +800,7 @@ namespace MWGui
 
             void emitGlyph(wchar_t ch)
             {
-                MWGui::GlyphInfo info = GlyphInfo(mFont, ch);
+                const GlyphInfo& info = getGlyphInfo(mFont, ch);
 
                 if (!info.charFound)
                     return;
@@ -800,7 +822,7 @@ namespace MWGui
 
             void emitSpace(wchar_t ch)
             {
-                MWGui::GlyphInfo info = GlyphInfo(mFont, ch);
+                const GlyphInfo& info = getGlyphInfo(mFont, ch);
 
                 if (info.charFound)
                     mCursor.left += static_cast<int>(info.bearingX + info.advance);
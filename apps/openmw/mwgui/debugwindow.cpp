@@ -1,5 +1,6 @@
 #include "debugwindow.hpp"
 
+#include <MyGUI_Button.h>
 #include <MyGUI_EditBox.h>
 #include <MyGUI_TabControl.h>
 #include <MyGUI_TabItem.h>
@@ -111,9 +112,17 @@ namespace MWGui
 
         MyGUI::TabItem* itemLuaProfiler = mTabControl->addItem("Lua Profiler");
         itemLuaProfiler->setCaptionWithReplacing(" #{OMWEngine:LuaProfiler} ");
+        const bool recordTrace = Settings::lua().mLuaProfiler && Settings::lua().mTraceFrames > 0;
         mLuaProfiler = itemLuaProfiler->createWidgetReal<MyGUI::EditBox>(
-            "LogEdit", MyGUI::FloatCoord(0, 0, 1, 1), MyGUI::Align::Stretch);
+            "LogEdit", MyGUI::FloatCoord(0, 0, 1, recordTrace ? 0.93f : 1), MyGUI::Align::Stretch);
         mLuaProfiler->setEditReadOnly(true);
+        if (recordTrace)
+        {
+            MyGUI::Button* saveTrace = itemLuaProfiler->createWidgetReal<MyGUI::Button>(
+                "MW_Button", MyGUI::FloatCoord(0, 0.94f, 0.3f, 0.06f), MyGUI::Align::Left | MyGUI::Align::Bottom);
+            saveTrace->setCaptionWithReplacing("#{OMWEngine:LuaProfilerSaveTrace}");
+            saveTrace->eventMouseButtonClick += MyGUI::newDelegate(this, &DebugWindow::onSaveLuaTrace);
+        }
 
 #ifndef BT_NO_PROFILE
         MyGUI::TabItem* item = mTabControl->addItem("Physics Profiler");
@@ -232,6 +241,11 @@ namespace MWGui
         mLuaProfiler->setVScrollPosition(std::min(previousPos, mLuaProfiler->getVScrollRange() - 1));
     }
 
+    void DebugWindow::onSaveLuaTrace(MyGUI::Widget* _sender)
+    {
+        MWBase::Environment::get().getLuaManager()->saveProfilerTrace();
+    }
+
     void DebugWindow::updateBulletProfile()
     {
 #ifndef BT_NO_PROFILE
@@ -18,6 +18,7 @@ namespace MWGui
     private:
         void updateLogView();
         void updateLuaProfile();
+        void onSaveLuaTrace(MyGUI::Widget* _sender);
         void updateBulletProfile();
 
         MyGUI::TabControl* mTabControl;
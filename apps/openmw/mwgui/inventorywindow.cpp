@@ -452,7 +452,16 @@ namespace MWGui
     void InventoryWindow::updatePreviewSize()
     {
         const MyGUI::IntSize viewport = getPreviewViewportSize();
+        const int textureWidth = mPreview->getTextureWidth();
+        const int textureHeight = mPreview->getTextureHeight();
         mPreview->setViewport(viewport.width, viewport.height);
+        if (mPreview->getTextureWidth() != textureWidth || mPreview->getTextureHeight() != textureHeight)
+        {
+            auto previewTexture
+                = std::make_unique<osgMyGUI::OSGTexture>(mPreview->getTexture(), mPreview->getTextureStateSet());
+            mAvatarImage->setRenderItemTexture(previewTexture.get());
+            mPreviewTexture = std::move(previewTexture);
+        }
         mAvatarImage->getSubWidgetMain()->_setUVSet(
             MyGUI::FloatRect(0.f, 0.f, viewport.width / float(mPreview->getTextureWidth()),
                 viewport.height / float(mPreview->getTextureHeight())));
@@ -850,8 +859,9 @@ namespace MWGui
         const MyGUI::IntSize previewWindowSize = mAvatarImage->getSize();
         const float scale = MWBase::Environment::get().getWindowManager()->getScalingFactor();
 
-        return MyGUI::IntSize(std::min<int>(mPreview->getTextureWidth(), previewWindowSize.width * scale),
-            std::min<int>(mPreview->getTextureHeight(), previewWindowSize.height * scale));
+        return MyGUI::IntSize(
+            std::min<int>(MWRender::InventoryPreview::sMaxViewportWidth, previewWindowSize.width * scale),
+            std::min<int>(MWRender::InventoryPreview::sMaxViewportHeight, previewWindowSize.height * scale));
     }
 
     osg::Vec2f InventoryWindow::mapPreviewWindowToViewport(int x, int y) const
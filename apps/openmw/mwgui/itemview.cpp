@@ -82,27 +82,48 @@ namespace MWGui
 
     void ItemView::update()
     {
-        while (mScrollView->getChildCount())
-            MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
-
         if (!mModel)
+        {
+            while (mScrollView->getChildCount())
+                MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
             return;
+        }
 
         mModel->update();
 
-        MyGUI::Widget* dragArea = mScrollView->createWidget<MyGUI::Widget>(
-            {}, 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
-        dragArea->setNeedMouseFocus(true);
-        dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
-        dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        MyGUI::Widget* dragArea = nullptr;
+        if (mScrollView->getChildCount())
+            dragArea = mScrollView->getChildAt(0);
+        else
+        {
+            dragArea = mScrollView->createWidget<MyGUI::Widget>(
+                {}, 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
+            dragArea->setNeedMouseFocus(true);
+            dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
+            dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        }
+
+        // Creating the widgets is the most expensive part, so the widgets of the previous update are reused and only
+        // get the item of their new position
+        const std::size_t count = mModel->getItemCount();
+        while (dragArea->getChildCount() > count)
+            MyGUI::Gui::getInstance().destroyWidget(dragArea->getChildAt(dragArea->getChildCount() - 1));
 
-        for (ItemModel::ModelIndex i = 0; i < static_cast<int>(mModel->getItemCount()); ++i)
+        for (ItemModel::ModelIndex i = 0; i < static_cast<int>(count); ++i)
         {
             const ItemStack& item = mModel->getItem(i);
 
-            ItemWidget* itemWidget = dragArea->createWidget<ItemWidget>(
-                "MW_ItemIcon", MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
-            itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+            ItemWidget* itemWidget = nullptr;
+            if (static_cast<std::size_t>(i) < dragArea->getChildCount())
+                itemWidget = dragArea->getChildAt(i)->castType<ItemWidget>();
+            else
+            {
+                itemWidget = dragArea->createWidget<ItemWidget>(
+                    "MW_ItemIcon", MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
+                itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+                itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
+                itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+            }
             itemWidget->setUserData(std::make_pair(i, mModel.get()));
             ItemWidget::ItemState state = ItemWidget::None;
             if (item.mType == ItemStack::Type_Barter)
@@ -111,9 +132,6 @@ namespace MWGui
                 state = ItemWidget::Equip;
             itemWidget->setItem(item.mBase, state);
             itemWidget->setCount(item.mCount);
-
-            itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
-            itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
         }
 
         layoutWidgets();
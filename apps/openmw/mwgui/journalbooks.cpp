@@ -182,6 +182,10 @@ namespace MWGui
 
     book JournalBooks::createJournalBook()
     {
+        const std::size_t revision = mModel->getRevision();
+        if (mJournalBook != nullptr && mJournalBookRevision == revision)
+            return mJournalBook;
+
         BookTypesetter::Ptr typesetter = createTypesetter();
 
         BookTypesetter::Style* header = typesetter->createStyle({}, MyGUI::Colour(0.60f, 0.00f, 0.00f));
@@ -189,7 +193,9 @@ namespace MWGui
 
         mModel->visitJournalEntries({}, AddJournalEntry(typesetter, body, header, true));
 
-        return typesetter->complete();
+        mJournalBook = typesetter->complete();
+        mJournalBookRevision = revision;
+        return mJournalBook;
     }
 
     book JournalBooks::createTopicBook(uintptr_t topicId)
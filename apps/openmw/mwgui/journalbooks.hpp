@@ -6,6 +6,9 @@
 
 #include <components/to_utf8/to_utf8.hpp>
 
+#include <cstddef>
+#include <optional>
+
 namespace MWGui
 {
     MWGui::BookTypesetter::Utf8Span to_utf8_span(std::string_view text);
@@ -27,6 +30,10 @@ namespace MWGui
         int mIndexPagesCount;
 
     private:
+        // Laying out a long journal is slow, so it is done again only when the journal changes
+        Book mJournalBook;
+        std::optional<std::size_t> mJournalBookRevision;
+
         BookTypesetter::Ptr createTypesetter();
         BookTypesetter::Ptr createLatinJournalIndex();
         BookTypesetter::Ptr createCyrillicJournalIndex();
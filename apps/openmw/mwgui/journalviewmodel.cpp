@@ -70,6 +70,8 @@ namespace MWGui
             return journal->begin() == journal->end();
         }
 
+        std::size_t getRevision() const override { return MWBase::Environment::get().getJournal()->getRevision(); }
+
         template <typename t_iterator, typename Interface>
         struct BaseEntry : Interface
         {
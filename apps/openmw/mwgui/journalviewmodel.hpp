@@ -1,6 +1,7 @@
 #ifndef MWGUI_JOURNALVIEWMODEL_HPP
 #define MWGUI_JOURNALVIEWMODEL_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -72,6 +73,9 @@ namespace MWGui
         /// returns true if their are no journal entries to display
         virtual bool isEmpty() const = 0;
 
+        /// returns a value that changes whenever the journal entries or topics change
+        virtual std::size_t getRevision() const = 0;
+
         /// walks the active and optionally completed, quests providing the name and completed status
         virtual void visitQuestNames(bool active_only, std::function<void(std::string_view, bool)> visitor) const = 0;
 
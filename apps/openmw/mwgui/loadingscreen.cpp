@@ -254,6 +254,11 @@ namespace MWGui
         draw();
     }
 
+    void LoadingScreen::redraw()
+    {
+        draw();
+    }
+
     bool LoadingScreen::needToDrawLoadingScreen()
     {
         if (mTimer.time_m() <= mLastRenderTime + (1.0 / getTargetFrameRate()) * 1000.0)
@@ -43,6 +43,7 @@ namespace MWGui
         void setProgressRange(size_t range) override;
         void setProgress(size_t value) override;
         void increaseProgress(size_t increase = 1) override;
+        void redraw() override;
 
         void setVisible(bool visible) override;
 
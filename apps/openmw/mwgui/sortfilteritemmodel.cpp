@@ -17,6 +17,12 @@
 #include <components/esm3/loadweap.hpp>
 #include <components/misc/utf8stream.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
@@ -62,11 +68,50 @@ namespace
         return std::numeric_limits<unsigned int>::max();
     }
 
-    bool compareType(unsigned int type1, unsigned int type2)
+    int getChargePercent(const MWWorld::Ptr& item)
     {
-        return getTypeOrder(type1) < getTypeOrder(type2);
+        const ESM::RefId& enchantment = item.getClass().getEnchantment(item);
+        if (enchantment.empty())
+            return -1;
+        const ESM::Enchantment* ench
+            = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(enchantment);
+        if (!ench)
+            return -1;
+        if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
+            return 101;
+        return static_cast<int>(item.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
     }
 
+    // Everything the comparison needs is computed once per item, not once per comparison
+    struct SortKey
+    {
+        MWGui::ItemStack::Type mStackType;
+        unsigned int mTypeOrder;
+        std::string mName;
+        int mChargePercent;
+        std::optional<int> mHealth;
+        float mRemainingUsageTime;
+        int mValue;
+        float mWeight;
+        ESM::RefId mRefId;
+
+        explicit SortKey(const MWGui::ItemStack& item)
+        {
+            const MWWorld::Ptr& base = item.mBase;
+            const MWWorld::Class& cls = base.getClass();
+            mStackType = item.mType;
+            mTypeOrder = getTypeOrder(base.getType());
+            mName = Utf8Stream::lowerCaseUtf8(cls.getName(base));
+            mChargePercent = getChargePercent(base);
+            if (cls.hasItemHealth(base))
+                mHealth = cls.getItemHealth(base);
+            mRemainingUsageTime = cls.getRemainingUsageTime(base);
+            mValue = cls.getValue(base);
+            mWeight = cls.getWeight(base);
+            mRefId = base.getCellRef().getRefId();
+        }
+    };
+
     struct Compare
     {
         bool mSortByType;
@@ -74,95 +119,43 @@ namespace
             : mSortByType(true)
         {
         }
-        bool operator()(const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        bool operator()(const SortKey& left, const SortKey& right) const
         {
-            if (mSortByType && left.mType != right.mType)
-                return left.mType < right.mType;
-
-            float result = 0;
+            if (mSortByType && left.mStackType != right.mStackType)
+                return left.mStackType < right.mStackType;
 
             // compare items by type
-            auto leftType = left.mBase.getType();
-            auto rightType = right.mBase.getType();
-
-            if (leftType != rightType)
-                return compareType(leftType, rightType);
+            if (left.mTypeOrder != right.mTypeOrder)
+                return left.mTypeOrder < right.mTypeOrder;
 
             // compare items by name
-            std::string leftName = Utf8Stream::lowerCaseUtf8(left.mBase.getClass().getName(left.mBase));
-            std::string rightName = Utf8Stream::lowerCaseUtf8(right.mBase.getClass().getName(right.mBase));
-
-            result = leftName.compare(rightName);
-            if (result != 0)
+            if (const int result = left.mName.compare(right.mName); result != 0)
                 return result < 0;
 
             // compare items by enchantment:
             // 1. enchanted items showed before non-enchanted
             // 2. item with lesser charge percent comes after items with more charge percent
             // 3. item with constant effect comes before items with non-constant effects
-            int leftChargePercent = -1;
-            int rightChargePercent = -1;
-            const ESM::RefId& leftNameEnch = left.mBase.getClass().getEnchantment(left.mBase);
-            const ESM::RefId& rightNameEnch = right.mBase.getClass().getEnchantment(right.mBase);
-
-            if (!leftNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(leftNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        leftChargePercent = 101;
-                    else
-                        leftChargePercent
-                            = static_cast<int>(left.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
-
-            if (!rightNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(rightNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        rightChargePercent = 101;
-                    else
-                        rightChargePercent
-                            = static_cast<int>(right.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
-
-            result = leftChargePercent - rightChargePercent;
-            if (result != 0)
-                return result > 0;
+            if (left.mChargePercent != right.mChargePercent)
+                return left.mChargePercent > right.mChargePercent;
 
             // compare items by condition
-            if (left.mBase.getClass().hasItemHealth(left.mBase) && right.mBase.getClass().hasItemHealth(right.mBase))
-            {
-                result = left.mBase.getClass().getItemHealth(left.mBase)
-                    - right.mBase.getClass().getItemHealth(right.mBase);
-                if (result != 0)
-                    return result > 0;
-            }
+            if (left.mHealth.has_value() && right.mHealth.has_value() && *left.mHealth != *right.mHealth)
+                return *left.mHealth > *right.mHealth;
 
             // compare items by remaining usage time
-            result = left.mBase.getClass().getRemainingUsageTime(left.mBase)
-                - right.mBase.getClass().getRemainingUsageTime(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mRemainingUsageTime != right.mRemainingUsageTime)
+                return left.mRemainingUsageTime > right.mRemainingUsageTime;
 
             // compare items by value
-            result = left.mBase.getClass().getValue(left.mBase) - right.mBase.getClass().getValue(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mValue != right.mValue)
+                return left.mValue > right.mValue;
 
             // compare items by weight
-            result = left.mBase.getClass().getWeight(left.mBase) - right.mBase.getClass().getWeight(right.mBase);
-            if (result != 0)
-                return result > 0;
+            if (left.mWeight != right.mWeight)
+                return left.mWeight > right.mWeight;
 
-            return left.mBase.getCellRef().getRefId() < right.mBase.getCellRef().getRefId();
+            return left.mRefId < right.mRefId;
         }
     };
 }
@@ -394,9 +387,20 @@ namespace MWGui
                 mItems.push_back(item);
         }
 
+        std::vector<std::pair<SortKey, std::size_t>> keys;
+        keys.reserve(mItems.size());
+        for (std::size_t i = 0; i < mItems.size(); ++i)
+            keys.emplace_back(SortKey(mItems[i]), i);
+
         Compare cmp;
         cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(keys.begin(), keys.end(), [&](const auto& l, const auto& r) { return cmp(l.first, r.first); });
+
+        std::vector<ItemStack> sorted;
+        sorted.reserve(mItems.size());
+        for (const auto& [key, index] : keys)
+            sorted.push_back(std::move(mItems[index]));
+        mItems = std::move(sorted);
     }
 
     void SortFilterItemModel::onClose()
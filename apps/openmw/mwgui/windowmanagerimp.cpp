@@ -26,6 +26,7 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 
+#include <components/fontloader/fontcache.hpp>
 #include <components/fontloader/fontloader.hpp>
 
 #include <components/resource/imagemanager.hpp>
@@ -215,7 +216,11 @@ namespace MWGui
         MyGUI::LanguageManager::getInstance().eventRequestTag = MyGUI::newDelegate(this, &WindowManager::onRetrieveTag);
 
         // Load fonts
-        mFontLoader = std::make_unique<Gui::FontLoader>(encoding, resourceSystem->getVFS(), mScalingFactor);
+        std::unique_ptr<Gui::FontCache> fontCache;
+        if (Settings::gui().mFontCache)
+            fontCache = std::make_unique<Gui::FontCache>(cfgMgr.getCachePath() / "fonts");
+        mFontLoader = std::make_unique<Gui::FontLoader>(
+            encoding, resourceSystem->getVFS(), mScalingFactor, std::move(fontCache));
 
         // Register own widgets with MyGUI
         MyGUI::FactoryManager::getInstance().registerFactory<MWGui::Widgets::MWSkill>("Widget");
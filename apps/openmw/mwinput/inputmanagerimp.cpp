@@ -144,6 +144,12 @@ namespace MWInput
         return mActionManager->getIdleTime() > 0.5;
     }
 
+    void InputManager::setInputRecording(SDLUtil::InputRecorder* recorder, SDLUtil::InputReplayer* replayer)
+    {
+        mInputWrapper->setInputRecorder(recorder);
+        mInputWrapper->setInputReplayer(replayer);
+    }
+
     std::string_view InputManager::getActionDescription(int action) const
     {
         return mBindingsManager->getActionDescription(action);
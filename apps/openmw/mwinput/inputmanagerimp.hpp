@@ -27,6 +27,8 @@ namespace MWBase
 namespace SDLUtil
 {
     class InputWrapper;
+    class InputRecorder;
+    class InputReplayer;
 }
 
 struct SDL_Window;
@@ -103,6 +105,9 @@ namespace MWInput
 
         bool controlsDisabled() override { return mControlsDisabled; }
 
+        /// Either of them can be null, the replayed input replaces the player input
+        void setInputRecording(SDLUtil::InputRecorder* recorder, SDLUtil::InputReplayer* replayer);
+
     private:
         void convertMousePosForMyGUI(int& x, int& y);
 
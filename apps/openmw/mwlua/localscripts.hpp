@@ -66,6 +66,7 @@ namespace MWLua
 
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
         const MWWorld::Ptr& getPtrOrEmpty() const { return mData.ptrOrEmpty(); }
+        const LuaUtil::LuaState& getLuaState() const { return mLua; }
 
         void setActive(bool active);
         void onConsume(const LObject& consumable) { callEngineHandlers(mOnConsumeHandlers, consumable); }
@@ -1,5 +1,7 @@
 #include "luaevents.hpp"
 
+#include <iterator>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/luascripts.hpp>
@@ -27,6 +29,17 @@ namespace MWLua
         mMenuEvents.clear();
     }
 
+    void LuaEvents::takeNewEvents(LuaEvents& other)
+    {
+        const auto append = [](auto& to, auto& from) {
+            to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+            from.clear();
+        };
+        append(mNewGlobalEventBatch, other.mNewGlobalEventBatch);
+        append(mNewLocalEventBatch, other.mNewLocalEventBatch);
+        append(mMenuEvents, other.mMenuEvents);
+    }
+
     void LuaEvents::finalizeEventBatch()
     {
         mNewGlobalEventBatch.swap(mGlobalEventBatch);
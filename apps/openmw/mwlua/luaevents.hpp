@@ -51,6 +51,8 @@ namespace MWLua
         void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
 
         void clear();
+        // Move the events which are not finalized yet to the end of the new events of this
+        void takeNewEvents(LuaEvents& other);
         void finalizeEventBatch();
         void callEventHandlers();
         void callMenuEventHandlers();
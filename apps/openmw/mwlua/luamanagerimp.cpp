@@ -1,6 +1,15 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 
 #include <MyGUI_InputManager.h>
 #include <osg/Stats>
@@ -13,11 +22,19 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 
+#include <components/files/conversion.hpp>
+
 #include <components/settings/values.hpp>
 
 #include <components/l10n/manager.hpp>
 
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+
+#include <components/sceneutil/workqueue.hpp>
+
 #include <components/lua_ui/content.hpp>
+#include <components/lua_ui/element.hpp>
 #include <components/lua_ui/registerscriptsettings.hpp>
 #include <components/lua_ui/util.hpp>
 
@@ -49,15 +66,36 @@ namespace MWLua
         return { .mInstructionLimit = Settings::lua().mInstructionLimitPerCall,
             .mMemoryLimit = Settings::lua().mMemoryLimit,
             .mSmallAllocMaxSize = Settings::lua().mSmallAllocMaxSize,
-            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
+            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage,
+            .mTraceFrames = Settings::lua().mTraceFrames };
+    }
+
+    thread_local LuaManager::LocalPartition* LuaManager::sUpdatingPartition = nullptr;
+
+    LuaManager::LocalPartition::LocalPartition(const VFS::Manager* vfs,
+        const LuaUtil::ScriptsConfiguration* configuration, const std::filesystem::path& libsDir,
+        GlobalScripts& globalScripts, MenuScripts& menuScripts)
+        : mLua(vfs, configuration, createLuaStateSettings())
+        , mLuaEvents(globalScripts, menuScripts)
+    {
+        mLua.addInternalLibSearchPath(libsDir);
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
-        : mLua(vfs, &mConfiguration, createLuaStateSettings())
+    LuaManager::LuaManager(
+        const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& tracesDir)
+        : mTracesDir(tracesDir)
+        , mLua(vfs, &mConfiguration, createLuaStateSettings())
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
 
+        const int localScriptStates = Settings::lua().mLocalScriptStates;
+        for (int i = 0; i < localScriptStates; ++i)
+            mLocalPartitions.push_back(
+                std::make_unique<LocalPartition>(vfs, &mConfiguration, libsDir, mGlobalScripts, mMenuScripts));
+        if (!mLocalPartitions.empty())
+            Log(Debug::Info) << "Local Lua scripts use " << mLocalPartitions.size() << " additional Lua states";
+
         mGlobalSerializer = createUserdataSerializer(false);
         mLocalSerializer = createUserdataSerializer(true);
         mGlobalLoader = createUserdataSerializer(false, &mContentFileMapping);
@@ -119,6 +157,24 @@ namespace MWLua
         mPlayerPackages["openmw.storage"]
             = LuaUtil::LuaStorage::initPlayerPackage(mLua, &mGlobalStorage, &mPlayerStorage);
 
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+        {
+            Context partitionContext = context;
+            partitionContext.mLua = &partition->mLua;
+            partitionContext.mLuaEvents = &partition->mLuaEvents;
+            for (const auto& [name, package] : initCommonPackages(partitionContext))
+                partition->mLua.addCommonPackage(name, package);
+
+            Context partitionLocalContext = localContext;
+            partitionLocalContext.mLua = &partition->mLua;
+            partitionLocalContext.mLuaEvents = &partition->mLuaEvents;
+            partition->mLocalPackages = initLocalPackages(partitionLocalContext);
+
+            LuaUtil::LuaStorage::initLuaBindings(partition->mLua.sol());
+            partition->mLocalPackages["openmw.storage"]
+                = LuaUtil::LuaStorage::initLocalPackage(partition->mLua, &mGlobalStorage);
+        }
+
         mPlayerStorage.setActive(true);
         mGlobalStorage.setActive(false);
 
@@ -146,10 +202,90 @@ namespace MWLua
         mPlayerStorage.save(userConfigPath / "player_storage.bin");
     }
 
+    LuaManager::LocalPartition* LuaManager::getLocalPartition(const ObjectId& id) const
+    {
+        if (mLocalPartitions.empty())
+            return nullptr;
+        return mLocalPartitions[std::hash<ObjectId>()(id) % mLocalPartitions.size()].get();
+    }
+
+    LuaManager::LocalPartition* LuaManager::findLocalPartition(const LocalScripts& scripts) const
+    {
+        // The partition is chosen by the object id when the scripts are created, the id may be reassigned later
+        const auto it = std::find_if(
+            mLocalPartitions.begin(), mLocalPartitions.end(), [&](const std::unique_ptr<LocalPartition>& partition) {
+                return &partition->mLua == &scripts.getLuaState();
+            });
+        return it == mLocalPartitions.end() ? nullptr : it->get();
+    }
+
+    void LuaManager::runInLocalPartitions(
+        const std::function<void(LuaUtil::LuaState&, const std::vector<LocalScripts*>&)>& function)
+    {
+        // Index 0 is the main Lua state, it is processed along with the partitions
+        const auto run = [&](std::size_t index) {
+            if (index == 0)
+                return function(mLua, mActiveMainScripts);
+            LocalPartition& partition = *mLocalPartitions[index - 1];
+            sUpdatingPartition = &partition;
+            try
+            {
+                function(partition.mLua, partition.mActiveScripts);
+            }
+            catch (...)
+            {
+                sUpdatingPartition = nullptr;
+                throw;
+            }
+            sUpdatingPartition = nullptr;
+        };
+        const std::size_t count = mLocalPartitions.size() + 1;
+        SceneUtil::WorkQueue* const workQueue
+            = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue();
+        if (workQueue != nullptr && count > 1)
+            workQueue->parallelFor(count, run);
+        else
+            for (std::size_t i = 0; i < count; ++i)
+                run(i);
+        mergeLocalPartitions();
+    }
+
+    void LuaManager::mergeLocalPartitions()
+    {
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+        {
+            mLuaEvents.takeNewEvents(partition->mLuaEvents);
+            std::move(partition->mActionQueue.begin(), partition->mActionQueue.end(), std::back_inserter(mActionQueue));
+            partition->mActionQueue.clear();
+            std::move(partition->mQueuedCallbacks.begin(), partition->mQueuedCallbacks.end(),
+                std::back_inserter(mQueuedCallbacks));
+            partition->mQueuedCallbacks.clear();
+        }
+    }
+
+    std::vector<const LuaUtil::TraceRecorder*> LuaManager::getTraceRecorders() const
+    {
+        std::vector<const LuaUtil::TraceRecorder*> result;
+        if (const LuaUtil::TraceRecorder* recorder = mLua.getTraceRecorder())
+            result.push_back(recorder);
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            if (const LuaUtil::TraceRecorder* recorder = partition->mLua.getTraceRecorder())
+                result.push_back(recorder);
+        return result;
+    }
+
     void LuaManager::update()
     {
+        if (LuaUtil::TraceRecorder* recorder = mLua.getTraceRecorder())
+            recorder->nextFrame();
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            if (LuaUtil::TraceRecorder* recorder = partition->mLua.getTraceRecorder())
+                recorder->nextFrame();
+
         if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
-            lua_gc(mLua.sol(), LUA_GCSTEP, steps);
+            runInLocalPartitions([&](LuaUtil::LuaState& lua, const std::vector<LocalScripts*>&) {
+                lua.gcStep(steps);
+            });
 
         if (mPlayer.isEmpty())
             return; // The game is not started yet.
@@ -172,10 +308,27 @@ namespace MWLua
         std::erase_if(mActiveLocalScripts,
             [](const LocalScripts* l) { return l->getPtrOrEmpty().isEmpty() || l->getPtrOrEmpty().mRef->isDeleted(); });
 
+        mActiveMainScripts.clear();
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            partition->mActiveScripts.clear();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            if (&scripts->getLuaState() == &mLua)
+                mActiveMainScripts.push_back(scripts);
+            else
+            {
+                LocalPartition* const partition = findLocalPartition(*scripts);
+                assert(partition != nullptr);
+                partition->mActiveScripts.push_back(scripts);
+            }
+        }
+
         mGlobalScripts.statsNextFrame();
         for (LocalScripts* scripts : mActiveLocalScripts)
             scripts->statsNextFrame();
 
+        // Events sent by local scripts of partitions outside of update, e.g. by callbacks from the engine handlers
+        mergeLocalPartitions();
         mLuaEvents.finalizeEventBatch();
 
         MWWorld::DateTimeManager& timeManager = *MWBase::Environment::get().getWorld()->getTimeManager();
@@ -183,13 +336,23 @@ namespace MWLua
         {
             mMenuScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
             mGlobalScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
+            runInLocalPartitions([&](LuaUtil::LuaState&, const std::vector<LocalScripts*>& activeScripts) {
+                for (LocalScripts* scripts : activeScripts)
+                    scripts->processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
+            });
         }
 
         // Run event handlers for events that were sent before `finalizeEventBatch`.
         mLuaEvents.callEventHandlers();
 
+        // Run callbacks of the work done in the worker threads
+        std::erase_if(mPendingWork, [](const PendingWork& work) {
+            if (!work.mItem->isDone())
+                return false;
+            work.mOnDone();
+            return true;
+        });
+
         // Run queued callbacks
         for (CallbackWithData& c : mQueuedCallbacks)
             c.mCallback.tryCall(c.mArg);
@@ -197,12 +360,15 @@ namespace MWLua
 
         // Run engine handlers
         mEngineEvents.callEngineHandlers();
-        if (!timeManager.isPaused())
+        const MWBase::Environment& environment = MWBase::Environment::get();
+        if (!timeManager.isPaused() && environment.isSimulationTick())
         {
-            float frameDuration = MWBase::Environment::get().getFrameDuration();
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(frameDuration);
-            mGlobalScripts.update(frameDuration);
+            const float tickDuration = environment.getSimulationTickDuration();
+            runInLocalPartitions([&](LuaUtil::LuaState&, const std::vector<LocalScripts*>& activeScripts) {
+                for (LocalScripts* scripts : activeScripts)
+                    scripts->update(tickDuration);
+            });
+            mGlobalScripts.update(tickDuration);
         }
     }
 
@@ -313,6 +479,7 @@ namespace MWLua
         mEngineEvents.clear();
         mInputEvents.clear();
         mMenuInputEvents.clear();
+        mPendingWork.clear();
         mObjectLists.clear();
         mGlobalScripts.removeAllScripts();
         mGlobalScriptsStarted = false;
@@ -330,6 +497,16 @@ namespace MWLua
         mPlayerStorage.clearTemporaryAndRemoveCallbacks();
         mInputActions.clear();
         mInputTriggers.clear();
+        mActiveMainScripts.clear();
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+        {
+            partition->mLuaEvents.clear();
+            partition->mActionQueue.clear();
+            partition->mQueuedCallbacks.clear();
+            partition->mActiveScripts.clear();
+            for (int i = 0; i < 5; ++i)
+                lua_gc(partition->mLua.sol(), LUA_GCCOLLECT, 0);
+        }
         for (int i = 0; i < 5; ++i)
             lua_gc(mLua.sol(), LUA_GCCOLLECT, 0);
     }
@@ -547,11 +724,13 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)));
+            LocalPartition* const partition = getLocalPartition(getId(ptr));
+            scripts = std::make_shared<LocalScripts>(
+                partition != nullptr ? &partition->mLua : &mLua, LObject(getId(ptr)));
             if (!autoStartConf.has_value())
                 autoStartConf = mConfiguration.getLocalConf(type, ptr.getCellRef().getRefId(), getId(ptr));
             scripts->setAutoStartConf(std::move(*autoStartConf));
-            for (const auto& [name, package] : mLocalPackages)
+            for (const auto& [name, package] : partition != nullptr ? partition->mLocalPackages : mLocalPackages)
                 scripts->addPackage(name, package);
         }
         scripts->setSerializer(mLocalSerializer.get());
@@ -570,6 +749,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
+        mergeLocalPartitions();
         mLuaEvents.save(writer);
 
         writer.endRecord(ESM::REC_LUAM);
@@ -637,6 +817,8 @@ namespace MWLua
         MWBase::Environment::get().getL10nManager()->dropCache();
         mUiResourceManager.clear();
         mLua.dropScriptCache();
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            partition->mLua.dropScriptCache();
         mInputActions.clear();
         mInputTriggers.clear();
         initConfiguration();
@@ -735,7 +917,25 @@ namespace MWLua
     {
         if (mApplyingDelayedActions)
             throw std::runtime_error("DelayedAction is not allowed to create another DelayedAction");
-        mActionQueue.emplace_back(&mLua, std::move(action), name);
+        if (sUpdatingPartition != nullptr)
+            sUpdatingPartition->mActionQueue.emplace_back(&sUpdatingPartition->mLua, std::move(action), name);
+        else
+            mActionQueue.emplace_back(&mLua, std::move(action), name);
+    }
+
+    void LuaManager::queueCallback(LuaUtil::Callback callback, sol::main_object arg)
+    {
+        if (sUpdatingPartition != nullptr)
+            sUpdatingPartition->mQueuedCallbacks.push_back({ std::move(callback), std::move(arg) });
+        else
+            mQueuedCallbacks.push_back({ std::move(callback), std::move(arg) });
+    }
+
+    void LuaManager::addPendingWork(osg::ref_ptr<SceneUtil::WorkItem> item, std::function<void()> onDone)
+    {
+        if (sUpdatingPartition != nullptr)
+            throw std::logic_error("Pending work can not be added from a partition update");
+        mPendingWork.push_back({ std::move(item), std::move(onDone) });
     }
 
     void LuaManager::addTeleportPlayerAction(std::function<void()> action)
@@ -745,7 +945,10 @@ namespace MWLua
 
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        stats.setAttribute(frameNumber, "Lua UsedMemory", mLua.getTotalMemoryUsage());
+        uint64_t usedMemory = mLua.getTotalMemoryUsage();
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            usedMemory += partition->mLua.getTotalMemoryUsage();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", usedMemory);
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -775,6 +978,12 @@ namespace MWLua
         out << "Total memory usage:";
         outMemSize(mLua.getTotalMemoryUsage());
         out << "\n";
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+        {
+            out << "Local scripts state memory usage:";
+            outMemSize(partition->mLua.getTotalMemoryUsage());
+            out << "\n";
+        }
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
@@ -786,6 +995,21 @@ namespace MWLua
         outMemSize(mLua.getTotalMemoryUsage() - mLua.getSmallAllocMemoryUsage());
         out << " (see the table below)\n\n";
 
+        const auto outStateStats = [&](std::string_view name, const LuaUtil::LuaState& lua) {
+            const LuaUtil::LuaMemoryStats memoryStats = lua.getMemoryStats();
+            out << name << ": " << memoryStats.mAllocations << " allocations, " << memoryStats.mDeallocations
+                << " deallocations, small object pool";
+            outMemSize(memoryStats.mPoolUsedSize);
+            out << " used of";
+            outMemSize(memoryStats.mPoolReservedSize);
+            out << ", " << memoryStats.mGcSteps << " GC steps, last "
+                << std::chrono::duration<double, std::micro>(memoryStats.mLastGcStepDuration).count() << " us\n";
+        };
+        outStateStats("Main state", mLua);
+        for (const std::unique_ptr<LocalPartition>& partition : mLocalPartitions)
+            outStateStats("Local scripts state", partition->mLua);
+        out << "\n";
+
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
 
         std::vector<Stats> activeStats;
@@ -865,6 +1089,127 @@ namespace MWLua
             out << "\n";
         }
 
+        const auto toMilliseconds
+            = [](auto value) { return std::chrono::duration<double, std::milli>(value).count(); };
+        constexpr std::size_t maxShownCalls = 30;
+
+        std::vector<const LuaUi::Element*> elements;
+        for (const bool menu : { false, true })
+            LuaUi::Element::forEach(menu, [&](const LuaUi::Element* element) {
+                if (element->getUpdateStats().mCount > 0)
+                    elements.push_back(element);
+            });
+        std::sort(elements.begin(), elements.end(), [](const LuaUi::Element* l, const LuaUi::Element* r) {
+            return l->getUpdateStats().mTotal > r->getUpdateStats().mTotal;
+        });
+        if (elements.size() > maxShownCalls)
+            elements.resize(maxShownCalls);
+        if (!elements.empty())
+        {
+            out << "\n";
+            out << std::left << " " << std::setw(nameW + 2) << "*** Slowest UI elements to create and update";
+            out << std::right;
+            out << std::setw(valueW) << "updates";
+            out << std::setw(valueW) << "total ms";
+            out << std::setw(valueW) << "max ms";
+            out << "\n";
+            for (const LuaUi::Element* element : elements)
+            {
+                const std::string name = element->getName();
+                const LuaUi::Element::UpdateStats& stats = element->getUpdateStats();
+                out << std::left << " " << std::setw(nameW) << name;
+                if (name.size() > nameW)
+                    out << "\n " << std::setw(nameW) << "";
+                out << std::right << std::fixed << std::setprecision(3);
+                out << std::setw(valueW) << stats.mCount;
+                out << std::setw(valueW) << toMilliseconds(stats.mTotal);
+                out << std::setw(valueW) << toMilliseconds(stats.mMax);
+                out << "\n";
+            }
+        }
+
+        const std::vector<const LuaUtil::TraceRecorder*> recorders = getTraceRecorders();
+        if (recorders.empty())
+        {
+            out << "\nSet 'trace frames' (section [Lua] in settings.cfg) to record the duration of handler calls.\n";
+            return out.str();
+        }
+
+        using CallStats = LuaUtil::TraceRecorder::CallStats;
+        std::map<std::pair<int, std::string_view>, CallStats> callStats;
+        for (const LuaUtil::TraceRecorder* recorder : recorders)
+        {
+            for (const CallStats& stats : recorder->collectCallStats())
+            {
+                const auto [it, inserted] = callStats.try_emplace({ stats.mScriptIndex, stats.mFunction }, stats);
+                if (inserted)
+                    continue;
+                CallStats& total = it->second;
+                total.mCount += stats.mCount;
+                total.mTotal += stats.mTotal;
+                total.mMax = std::max(total.mMax, stats.mMax);
+            }
+        }
+        std::vector<CallStats> slowestCalls;
+        for (const auto& [key, stats] : callStats)
+            slowestCalls.push_back(stats);
+        std::sort(slowestCalls.begin(), slowestCalls.end(),
+            [](const CallStats& l, const CallStats& r) { return l.mTotal > r.mTotal; });
+        if (slowestCalls.size() > maxShownCalls)
+            slowestCalls.resize(maxShownCalls);
+
+        out << "\n";
+        out << std::left << " " << std::setw(nameW + 2) << "*** Slowest handlers in the recorded frames";
+        out << std::right;
+        out << std::setw(valueW) << "calls";
+        out << std::setw(valueW) << "total ms";
+        out << std::setw(valueW) << "max ms";
+        out << "\n";
+        for (const CallStats& stats : slowestCalls)
+        {
+            std::string name = stats.mScriptIndex >= 0 ? mConfiguration[stats.mScriptIndex].mScriptPath : "";
+            name += " ";
+            name += stats.mFunction;
+            out << std::left << " " << std::setw(nameW) << name;
+            if (name.size() > nameW)
+                out << "\n " << std::setw(nameW) << "";
+            out << std::right << std::fixed << std::setprecision(3);
+            out << std::setw(valueW) << stats.mCount;
+            out << std::setw(valueW) << toMilliseconds(stats.mTotal);
+            out << std::setw(valueW) << toMilliseconds(stats.mMax);
+            out << "\n";
+        }
+        if (!mLastTracePath.empty())
+            out << "\nThe last trace is saved to " << Files::pathToUnicodeString(mLastTracePath) << "\n";
+
         return out.str();
     }
+
+    void LuaManager::saveProfilerTrace()
+    {
+        const std::vector<const LuaUtil::TraceRecorder*> recorders = getTraceRecorders();
+        if (recorders.empty())
+            return;
+        const std::time_t time = std::time(nullptr);
+        std::ostringstream name;
+        name << "lua_trace_" << std::put_time(std::localtime(&time), "%Y%m%d_%H%M%S") << ".json";
+        std::filesystem::path path = mTracesDir / name.str();
+        try
+        {
+            std::filesystem::create_directories(mTracesDir);
+            std::ofstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+                throw std::runtime_error("failed to open file");
+            LuaUtil::writeChromeTrace(stream, recorders, mConfiguration);
+            if (!stream.flush())
+                throw std::runtime_error("failed to write file");
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to save Lua trace to " << path << ": " << e.what();
+            return;
+        }
+        Log(Debug::Info) << "Lua trace is saved to " << path;
+        mLastTracePath = std::move(path);
+    }
 }
@@ -2,15 +2,19 @@
 #define MWLUA_LUAMANAGERIMP_H
 
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
 #include <osg/Stats>
 #include <set>
+#include <vector>
 
 #include <components/lua/inputactions.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/lua/storage.hpp>
 #include <components/lua_ui/resources.hpp>
 #include <components/misc/color.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwbase/luamanager.hpp"
 
@@ -32,7 +36,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(
+            const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& tracesDir);
         LuaManager(const LuaManager&) = delete;
         LuaManager(LuaManager&&) = delete;
         ~LuaManager();
@@ -134,10 +139,11 @@ namespace MWLua
             const std::string& consoleMode, const std::string& command, const MWWorld::Ptr& selectedPtr) override;
 
         // Used to call Lua callbacks from C++
-        void queueCallback(LuaUtil::Callback callback, sol::main_object arg)
-        {
-            mQueuedCallbacks.push_back({ std::move(callback), std::move(arg) });
-        }
+        void queueCallback(LuaUtil::Callback callback, sol::main_object arg);
+
+        // Calls `onDone` in the main thread during the first update after the work item is done. Can be used only
+        // outside of the partitions update, e.g. in a delayed action.
+        void addPendingWork(osg::ref_ptr<SceneUtil::WorkItem> item, std::function<void()> onDone);
 
         // Wraps Lua callback into an std::function.
         // NOTE: Resulted function is not thread safe. Can not be used while LuaManager::update() or
@@ -145,16 +151,18 @@ namespace MWLua
         template <class Arg>
         std::function<void(Arg)> wrapLuaCallback(const LuaUtil::Callback& c)
         {
-            return
-                [this, c](Arg arg) { this->queueCallback(c, sol::main_object(this->mLua.sol(), sol::in_place, arg)); };
+            return [this, c](Arg arg) {
+                this->queueCallback(c, sol::main_object(c.mFunc.lua_state(), sol::in_place, arg));
+            };
         }
 
         LuaUi::ResourceManager* uiResourceManager() { return &mUiResourceManager; }
 
         bool isProcessingInputEvents() const { return mProcessingInputEvents; }
 
-        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
         std::string formatResourceUsageStats() const override;
+        void saveProfilerTrace() override;
 
         LuaUtil::InputAction::Registry& inputActions() { return mInputActions; }
         LuaUtil::InputTrigger::Registry& inputTriggers() { return mInputTriggers; }
@@ -165,6 +173,15 @@ namespace MWLua
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
 
+        struct LocalPartition;
+        LocalPartition* getLocalPartition(const ObjectId& id) const;
+        LocalPartition* findLocalPartition(const LocalScripts& scripts) const;
+        // Calls the function for the main Lua state and for every partition, possibly on several threads
+        void runInLocalPartitions(
+            const std::function<void(LuaUtil::LuaState&, const std::vector<LocalScripts*>&)>& function);
+        void mergeLocalPartitions();
+        std::vector<const LuaUtil::TraceRecorder*> getTraceRecorders() const;
+
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
         bool mProcessingInputEvents = false;
@@ -172,6 +189,8 @@ namespace MWLua
         bool mNewGameStarted = false;
         bool mReloadAllScriptsRequested = false;
         LuaUtil::ScriptsConfiguration mConfiguration;
+        std::filesystem::path mTracesDir;
+        std::filesystem::path mLastTracePath;
         LuaUtil::LuaState mLua;
         LuaUi::ResourceManager mUiResourceManager;
         std::map<std::string, sol::object> mLocalPackages;
@@ -204,6 +223,13 @@ namespace MWLua
         };
         std::vector<CallbackWithData> mQueuedCallbacks;
 
+        struct PendingWork
+        {
+            osg::ref_ptr<SceneUtil::WorkItem> mItem;
+            std::function<void()> mOnDone;
+        };
+        std::vector<PendingWork> mPendingWork;
+
         // Queued actions that should be done in main thread. Processed by applyQueuedChanges().
         class DelayedAction
         {
@@ -218,6 +244,24 @@ namespace MWLua
         };
         std::vector<DelayedAction> mActionQueue;
         std::optional<DelayedAction> mTeleportPlayerAction;
+
+        // Additional Lua states running local scripts of objects other than the player in parallel.
+        // Events, actions and callbacks queued in a partition are merged into the main queues in partition order.
+        struct LocalPartition
+        {
+            LocalPartition(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* configuration,
+                const std::filesystem::path& libsDir, GlobalScripts& globalScripts, MenuScripts& menuScripts);
+
+            LuaUtil::LuaState mLua;
+            LuaEvents mLuaEvents;
+            std::map<std::string, sol::object> mLocalPackages;
+            std::vector<DelayedAction> mActionQueue;
+            std::vector<CallbackWithData> mQueuedCallbacks;
+            std::vector<LocalScripts*> mActiveScripts;
+        };
+        std::vector<std::unique_ptr<LocalPartition>> mLocalPartitions;
+        std::vector<LocalScripts*> mActiveMainScripts;
+        static thread_local LocalPartition* sUpdatingPartition;
         std::vector<std::string> mUIMessages;
         std::vector<std::pair<std::string, Misc::Color>> mInGameConsoleMessages;
         std::optional<ObjectId> mDelayedUiModeChangedArg;
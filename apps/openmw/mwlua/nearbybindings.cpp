@@ -1,9 +1,12 @@
 #include "nearbybindings.hpp"
 
+#include <components/detournavigator/findpathasync.hpp>
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/misc/constants.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -120,22 +123,25 @@ namespace MWLua
                 return rayCasting->castSphere(from, to, radius, collisionType);
             }
         };
-        // TODO: async raycasting
-        /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
-            const Callback& luaCallback, const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table>
-        options)
-        {
-            std::function<void(MWPhysics::RayCastingResult)> callback =
-                luaManager->wrapLuaCallback<MWPhysics::RayCastingResult>(luaCallback);
-            MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-
-            // Handle options the same way as in `castRay`.
-
-            // NOTE: `callback` is not thread safe. If MWPhysics works in separate thread, it must put results to a
-        queue
-            //       and use this callback from the main thread at the beginning of the next frame processing.
-            rayCasting->asyncCastRay(callback, from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
-        };*/
+        api["asyncCastRay"] = [context](const sol::table& callback, const osg::Vec3f& from, const osg::Vec3f& to,
+                                  sol::optional<sol::table> options) {
+            std::vector<MWWorld::ConstPtr> ignore;
+            int collisionType = MWPhysics::CollisionType_Default;
+            if (options)
+            {
+                ignore = parseIgnoreList<MWWorld::ConstPtr>(*options);
+                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
+                if (options->get<sol::optional<float>>("radius").value_or(0) > 0)
+                    throw std::logic_error("Currently asyncCastRay doesn't support radius > 0");
+            }
+            const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
+            rayCasting->asyncCastRay(
+                [context, callback = LuaUtil::Callback::fromLua(callback)](const MWPhysics::RayCastingResult& res) {
+                    context.mLuaManager->queueCallback(
+                        callback, sol::main_object(context.mLua->sol(), sol::in_place, res));
+                },
+                from, to, ignore, collisionType);
+        };
         api["castRenderingRay"] = [manager = context.mLuaManager](const osg::Vec3f& from, const osg::Vec3f& to,
                                       const sol::optional<sol::table>& options) {
             if (!manager->isProcessingInputEvents())
@@ -178,12 +184,40 @@ namespace MWLua
             return LObject(*refId.getIf<ESM::FormId>());
         };
 
-        api["activators"] = LObjectList{ objectLists->getActivatorsInScene() };
-        api["actors"] = LObjectList{ objectLists->getActorsInScene() };
-        api["containers"] = LObjectList{ objectLists->getContainersInScene() };
-        api["doors"] = LObjectList{ objectLists->getDoorsInScene() };
-        api["items"] = LObjectList{ objectLists->getItemsInScene() };
-        api["players"] = LObjectList{ objectLists->getPlayers() };
+        const auto makeCachedList = [](ObjectIdList ids) {
+            return LObjectList{ std::move(ids), std::make_shared<ObjectListCache>() };
+        };
+        api["activators"] = makeCachedList(objectLists->getActivatorsInScene());
+        api["actors"] = makeCachedList(objectLists->getActorsInScene());
+        api["containers"] = makeCachedList(objectLists->getContainersInScene());
+        api["doors"] = makeCachedList(objectLists->getDoorsInScene());
+        api["items"] = makeCachedList(objectLists->getItemsInScene());
+        api["players"] = makeCachedList(objectLists->getPlayers());
+
+        api["OBJECT_GROUP"]
+            = LuaUtil::makeStrictReadOnly(context.mLua->tableFromPairs<std::string_view, ObjectLists::Group>({
+                { "Activator", ObjectLists::Group_Activators },
+                { "Actor", ObjectLists::Group_Actors },
+                { "Container", ObjectLists::Group_Containers },
+                { "Door", ObjectLists::Group_Doors },
+                { "Item", ObjectLists::Group_Items },
+                { "Any", ObjectLists::Group_Any },
+            }));
+
+        static const auto getGroups = [](const sol::optional<sol::table>& options) {
+            if (!options)
+                return static_cast<unsigned>(ObjectLists::Group_Any);
+            return options->get_or<unsigned>("groups", ObjectLists::Group_Any);
+        };
+
+        api["findInRadius"] = [objectLists](const osg::Vec3f& center, float radius,
+                                  const sol::optional<sol::table>& options) {
+            return LObjectList{ objectLists->findInRadius(center, radius, getGroups(options)) };
+        };
+        api["findInBox"] = [objectLists](const osg::Vec3f& min, const osg::Vec3f& max,
+                               const sol::optional<sol::table>& options) {
+            return LObjectList{ objectLists->findInBox(min, max, getGroups(options)) };
+        };
 
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(context.mLua->tableFromPairs<std::string_view, DetourNavigator::Flag>({
@@ -220,48 +254,86 @@ namespace MWLua
         static constexpr DetourNavigator::Flags defaultIncludeFlags = DetourNavigator::Flag_walk
             | DetourNavigator::Flag_swim | DetourNavigator::Flag_openDoor | DetourNavigator::Flag_usePathgrid;
 
+        struct FindPathOptions
+        {
+            DetourNavigator::AgentBounds mAgentBounds = defaultAgentBounds;
+            DetourNavigator::Flags mIncludeFlags = defaultIncludeFlags;
+            DetourNavigator::AreaCosts mAreaCosts{};
+            float mDestinationTolerance = 1;
+        };
+
+        static const auto parseFindPathOptions = [](const sol::optional<sol::table>& options) {
+            FindPathOptions result;
+
+            if (options.has_value())
+            {
+                if (const auto& t = options->get<sol::optional<sol::table>>("agentBounds"))
+                {
+                    if (const auto& v = t->get<sol::optional<DetourNavigator::CollisionShapeType>>("shapeType"))
+                        result.mAgentBounds.mShapeType = *v;
+                    if (const auto& v = t->get<sol::optional<osg::Vec3f>>("halfExtents"))
+                        result.mAgentBounds.mHalfExtents = *v;
+                }
+                if (const auto& v = options->get<sol::optional<DetourNavigator::Flags>>("includeFlags"))
+                    result.mIncludeFlags = *v;
+                if (const auto& t = options->get<sol::optional<sol::table>>("areaCosts"))
+                {
+                    if (const auto& v = t->get<sol::optional<float>>("water"))
+                        result.mAreaCosts.mWater = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("door"))
+                        result.mAreaCosts.mDoor = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("pathgrid"))
+                        result.mAreaCosts.mPathgrid = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("ground"))
+                        result.mAreaCosts.mGround = *v;
+                }
+                if (const auto& v = options->get<sol::optional<float>>("destinationTolerance"))
+                    result.mDestinationTolerance = *v;
+            }
+
+            return result;
+        };
+
         api["findPath"]
             = [](const osg::Vec3f& source, const osg::Vec3f& destination, const sol::optional<sol::table>& options) {
-                  DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
-                  DetourNavigator::Flags includeFlags = defaultIncludeFlags;
-                  DetourNavigator::AreaCosts areaCosts{};
-                  float destinationTolerance = 1;
-
-                  if (options.has_value())
-                  {
-                      if (const auto& t = options->get<sol::optional<sol::table>>("agentBounds"))
-                      {
-                          if (const auto& v = t->get<sol::optional<DetourNavigator::CollisionShapeType>>("shapeType"))
-                              agentBounds.mShapeType = *v;
-                          if (const auto& v = t->get<sol::optional<osg::Vec3f>>("halfExtents"))
-                              agentBounds.mHalfExtents = *v;
-                      }
-                      if (const auto& v = options->get<sol::optional<DetourNavigator::Flags>>("includeFlags"))
-                          includeFlags = *v;
-                      if (const auto& t = options->get<sol::optional<sol::table>>("areaCosts"))
-                      {
-                          if (const auto& v = t->get<sol::optional<float>>("water"))
-                              areaCosts.mWater = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("door"))
-                              areaCosts.mDoor = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("pathgrid"))
-                              areaCosts.mPathgrid = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("ground"))
-                              areaCosts.mGround = *v;
-                      }
-                      if (const auto& v = options->get<sol::optional<float>>("destinationTolerance"))
-                          destinationTolerance = *v;
-                  }
+                  const FindPathOptions parsed = parseFindPathOptions(options);
 
                   std::vector<osg::Vec3f> result;
 
                   const DetourNavigator::Status status = DetourNavigator::findPath(
-                      *MWBase::Environment::get().getWorld()->getNavigator(), agentBounds, source, destination,
-                      includeFlags, areaCosts, destinationTolerance, std::back_inserter(result));
+                      *MWBase::Environment::get().getWorld()->getNavigator(), parsed.mAgentBounds, source,
+                      destination, parsed.mIncludeFlags, parsed.mAreaCosts, parsed.mDestinationTolerance,
+                      std::back_inserter(result));
 
                   return std::make_tuple(status, std::move(result));
               };
 
+        api["asyncFindPath"] = [context](const sol::table& callback, const osg::Vec3f& source,
+                                   const osg::Vec3f& destination, const sol::optional<sol::table>& options) {
+            context.mLuaManager->addAction([context, parsed = parseFindPathOptions(options),
+                                               callback = LuaUtil::Callback::fromLua(callback), source, destination] {
+                const DetourNavigator::Navigator& navigator = *MWBase::Environment::get().getWorld()->getNavigator();
+                SceneUtil::WorkQueue* const workQueue
+                    = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue();
+                osg::ref_ptr<DetourNavigator::FindPathItem> item;
+                if (workQueue != nullptr)
+                {
+                    item = DetourNavigator::findPathAsync(navigator, *workQueue, parsed.mAgentBounds, source,
+                        destination, parsed.mIncludeFlags, parsed.mAreaCosts, parsed.mDestinationTolerance);
+                }
+                else
+                {
+                    item = new DetourNavigator::FindPathItem(navigator.getNavMesh(parsed.mAgentBounds),
+                        navigator.getSettings(), parsed.mAgentBounds, source, destination, parsed.mIncludeFlags,
+                        parsed.mAreaCosts, parsed.mDestinationTolerance);
+                    item->doWork();
+                    item->signalDone();
+                }
+                context.mLuaManager->addPendingWork(
+                    item, [item, callback] { callback.tryCall(item->getStatus(), std::move(item->getPath())); });
+            });
+        };
+
         api["findRandomPointAroundCircle"] = [](const osg::Vec3f& position, float maxRadius,
                                                  const sol::optional<sol::table>& options) {
             DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
@@ -58,10 +58,14 @@ namespace MWLua
     };
 
     using ObjectIdList = std::shared_ptr<std::vector<ObjectId>>;
+    // Lua objects created for the elements of a list, an object is reused while the id at its position is unchanged
+    using ObjectListCache = std::vector<std::pair<ObjectId, sol::object>>;
     template <typename Obj>
     struct ObjectList
     {
         ObjectIdList mIds;
+        // Only for the lists that live long and are read often like `nearby.actors`, belongs to one Lua state
+        std::shared_ptr<ObjectListCache> mCache = nullptr;
     };
     using GObjectList = ObjectList<GObject>;
     using LObjectList = ObjectList<LObject>;
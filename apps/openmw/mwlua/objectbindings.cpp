@@ -1,5 +1,7 @@
 #include "objectbindings.hpp"
 
+#include <set>
+
 #include <components/esm3/loadfact.hpp>
 #include <components/esm3/loadnpc.hpp>
 #include <components/lua/luastate.hpp>
@@ -156,6 +158,60 @@ namespace MWLua
             MWBase::Environment::get().getLuaManager()->objectTeleported(newPtr);
         }
 
+        void setObjectEnabled(const GObject& object, bool enable)
+        {
+            if (object.ptr().mRef->isDeleted())
+                return;
+            if (object.ptr().isInCell())
+            {
+                if (enable)
+                    MWBase::Environment::get().getWorld()->enable(object.ptr());
+                else
+                    MWBase::Environment::get().getWorld()->disable(object.ptr());
+            }
+            else
+            {
+                if (enable)
+                    object.ptr().getRefData().enable();
+                else
+                    throw std::runtime_error("Objects in containers can't be disabled");
+            }
+        }
+
+        // Physics updates of the objects changed by a batched call are applied once at the end
+        class BatchedUpdate
+        {
+        public:
+            BatchedUpdate() { MWBase::Environment::get().getWorld()->beginBatchedUpdate(); }
+            ~BatchedUpdate() { MWBase::Environment::get().getWorld()->endBatchedUpdate(); }
+
+            BatchedUpdate(const BatchedUpdate&) = delete;
+            BatchedUpdate& operator=(const BatchedUpdate&) = delete;
+        };
+
+        // Accepts object lists like `world.activeActors` and Lua arrays of objects
+        std::vector<GObject> toObjects(const sol::object& objects)
+        {
+            std::vector<GObject> result;
+            if (objects.is<GObjectList>())
+            {
+                const GObjectList& list = objects.as<const GObjectList&>();
+                result.reserve(list.mIds->size());
+                for (const ObjectId& id : *list.mIds)
+                    result.emplace_back(id);
+                return result;
+            }
+            const sol::table table = LuaUtil::cast<sol::table>(objects);
+            const std::size_t size = table.size();
+            result.reserve(size);
+            for (std::size_t i = 1; i <= size; ++i)
+            {
+                const sol::object object = table[i];
+                result.push_back(LuaUtil::cast<GObject>(object));
+            }
+            return result;
+        }
+
         template <typename ObjT>
         using Cell = std::conditional_t<std::is_same_v<ObjT, LObject>, LCell, GCell>;
 
@@ -168,11 +224,22 @@ namespace MWLua
             listT[sol::meta_function::to_string]
                 = [](const ListT& list) { return "{" + std::to_string(list.mIds->size()) + " objects}"; };
             listT[sol::meta_function::length] = [](const ListT& list) { return list.mIds->size(); };
-            listT[sol::meta_function::index] = [](const ListT& list, size_t index) -> sol::optional<ObjectT> {
-                if (index > 0 && index <= list.mIds->size())
-                    return ObjectT((*list.mIds)[index - 1]);
-                else
-                    return sol::nullopt;
+            listT[sol::meta_function::index] = [](sol::this_state lua, const ListT& list, size_t index) -> sol::object {
+                if (index == 0 || index > list.mIds->size())
+                    return sol::nil;
+                const ObjectId id = (*list.mIds)[index - 1];
+                if (!list.mCache)
+                    return sol::make_object(lua, ObjectT(id));
+                ObjectListCache& cache = *list.mCache;
+                if (cache.size() != list.mIds->size())
+                    cache.resize(list.mIds->size());
+                auto& [cachedId, object] = cache[index - 1];
+                if (object == sol::nil || !(cachedId == id))
+                {
+                    cachedId = id;
+                    object = sol::make_object(lua, ObjectT(id));
+                }
+                return object;
             };
             listT[sol::meta_function::pairs] = lua["ipairsForArray"].template get<sol::function>();
             listT[sol::meta_function::ipairs] = lua["ipairsForArray"].template get<sol::function>();
@@ -357,24 +424,7 @@ namespace MWLua
             auto setEnabled = [context](const GObject& object, bool enable) {
                 if (enable && object.ptr().mRef->isDeleted())
                     throw std::runtime_error("Object is removed");
-                context.mLuaManager->addAction([object, enable] {
-                    if (object.ptr().mRef->isDeleted())
-                        return;
-                    if (object.ptr().isInCell())
-                    {
-                        if (enable)
-                            MWBase::Environment::get().getWorld()->enable(object.ptr());
-                        else
-                            MWBase::Environment::get().getWorld()->disable(object.ptr());
-                    }
-                    else
-                    {
-                        if (enable)
-                            object.ptr().getRefData().enable();
-                        else
-                            throw std::runtime_error("Objects in containers can't be disabled");
-                    }
-                });
+                context.mLuaManager->addAction([object, enable] { setObjectEnabled(object, enable); });
             };
             if constexpr (std::is_same_v<ObjectT, GObject>)
                 objectT["enabled"] = sol::property(isEnabled, setEnabled);
@@ -700,4 +750,96 @@ namespace MWLua
         initObjectBindings<GObject>("G", context);
     }
 
+    void addBatchedObjectBindings(sol::table& api, const Context& context)
+    {
+        api["setObjectsEnabled"] = [context](const sol::object& objectsArg, bool enable) {
+            std::vector<GObject> objects = toObjects(objectsArg);
+            for (const GObject& object : objects)
+            {
+                if (enable && object.ptr().mRef->isDeleted())
+                    throw std::runtime_error("Object is removed: " + object.toString());
+                if (!enable && !object.ptr().isInCell())
+                    throw std::runtime_error("Objects in containers can't be disabled: " + object.toString());
+            }
+            context.mLuaManager->addAction(
+                [objects = std::move(objects), enable] {
+                    const BatchedUpdate batch;
+                    for (const GObject& object : objects)
+                        setObjectEnabled(object, enable);
+                },
+                "SetObjectsEnabledAction");
+        };
+        api["teleportObjects"] = [context](const sol::object& objectsArg, const sol::object& cellOrName,
+                                     const sol::table& positionsArg, const sol::object& options) {
+            struct Teleport
+            {
+                GObject mObject;
+                MWWorld::CellStore* mCell;
+                osg::Vec3f mPosition;
+                osg::Vec3f mRotation;
+                int mCount;
+            };
+            const std::vector<GObject> objects = toObjects(objectsArg);
+            if (positionsArg.size() != objects.size())
+                throw std::runtime_error("The number of positions doesn't match the number of objects");
+            sol::object rotations = sol::nil;
+            bool placeOnGround = false;
+            if (options != sol::nil)
+            {
+                sol::table t = LuaUtil::cast<sol::table>(options);
+                rotations = t["rotations"];
+                placeOnGround = LuaUtil::getValueOrDefault(t["onGround"], placeOnGround);
+            }
+            sol::table rotationsArg;
+            if (rotations != sol::nil)
+            {
+                rotationsArg = LuaUtil::cast<sol::table>(rotations);
+                if (rotationsArg.size() != objects.size())
+                    throw std::runtime_error("The number of rotations doesn't match the number of objects");
+            }
+
+            // Everything is validated before hiding the objects, a failed call doesn't remove any of them
+            const MWWorld::Ptr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
+            std::vector<Teleport> teleports;
+            teleports.reserve(objects.size());
+            std::set<const MWWorld::LiveCellRefBase*> refs;
+            for (std::size_t i = 0; i < objects.size(); ++i)
+            {
+                const MWWorld::Ptr ptr = objects[i].ptr();
+                const int count = ptr.getCellRef().getCount();
+                if (count == 0 || !refs.insert(ptr.mRef).second)
+                    throw std::runtime_error("Object " + objects[i].toString()
+                        + " is either removed or already in the process of teleporting");
+                if (ptr.getContainerStore())
+                    throw std::runtime_error(
+                        "Object " + objects[i].toString() + " is in a container, use `teleport` to take it out");
+                if (ptr == player)
+                    throw std::runtime_error("The player can't be teleported with other objects, use `teleport`");
+                const sol::object position = positionsArg[i + 1];
+                const osg::Vec3f pos = LuaUtil::cast<osg::Vec3f>(position);
+                osg::Vec3f rot = ptr.getRefData().getPosition().asRotationVec3();
+                if (rotations != sol::nil)
+                {
+                    const sol::object rotation = rotationsArg[i + 1];
+                    rot = toEulerRotation(rotation, ptr.getClass().isActor());
+                }
+                teleports.push_back(Teleport{ objects[i], findCell(cellOrName, pos), pos, rot, count });
+            }
+
+            for (const Teleport& teleport : teleports)
+                teleport.mObject.ptr().getCellRef().setCount(0);
+            context.mLuaManager->addAction(
+                [teleports = std::move(teleports), placeOnGround] {
+                    const BatchedUpdate batch;
+                    for (const Teleport& teleport : teleports)
+                    {
+                        const MWWorld::Ptr ptr = teleport.mObject.ptr();
+                        ptr.getCellRef().setCount(teleport.mCount);
+                        teleportNotPlayer(ptr, teleport.mCell, teleport.mPosition, teleport.mRotation, placeOnGround);
+                    }
+                },
+                "TeleportObjectsAction");
+        };
+    }
+
 }
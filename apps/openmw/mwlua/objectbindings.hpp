@@ -7,6 +7,9 @@ namespace MWLua
 {
     void initObjectBindingsForLocalScripts(const Context&);
     void initObjectBindingsForGlobalScripts(const Context&);
+
+    // Global script functions changing many objects in one delayed action
+    void addBatchedObjectBindings(sol::table& api, const Context&);
 }
 
 #endif // MWLUA_OBJECTBINDINGS_H
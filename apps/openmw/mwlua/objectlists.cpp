@@ -1,5 +1,9 @@
 #include "objectlists.hpp"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadcell.hpp>
@@ -16,13 +20,23 @@
 namespace MWLua
 {
 
+    namespace
+    {
+        osg::Vec2f get2dPosition(const MWWorld::Ptr& ptr)
+        {
+            const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+            return osg::Vec2f(position.x(), position.y());
+        }
+    }
+
     void ObjectLists::update()
     {
-        mActivatorsInScene.updateList();
-        mActorsInScene.updateList();
-        mContainersInScene.updateList();
-        mDoorsInScene.updateList();
-        mItemsInScene.updateList();
+        ++mFrame;
+        mActivatorsInScene.applyChanges();
+        mActorsInScene.applyChanges();
+        mContainersInScene.applyChanges();
+        mDoorsInScene.applyChanges();
+        mItemsInScene.applyChanges();
     }
 
     void ObjectLists::clear()
@@ -59,43 +73,123 @@ namespace MWLua
         MWBase::Environment::get().getWorldModel()->registerPtr(ptr);
         ObjectGroup* group = chooseGroup(ptr);
         if (group)
-            addToGroup(*group, ptr);
+            group->mPendingChanges.emplace_back(getId(ptr), true);
     }
 
     void ObjectLists::objectRemovedFromScene(const MWWorld::Ptr& ptr)
     {
         ObjectGroup* group = chooseGroup(ptr);
         if (group)
-            removeFromGroup(*group, ptr);
+            group->mPendingChanges.emplace_back(getId(ptr), false);
+    }
+
+    void ObjectLists::ObjectGroup::applyChanges()
+    {
+        std::vector<ObjectId>& list = *mList;
+        for (const auto& [id, added] : mPendingChanges)
+        {
+            if (added)
+            {
+                // Added to the grid by the next updateGrid
+                if (mIndex.emplace(id, list.size()).second)
+                    list.push_back(id);
+                continue;
+            }
+            const auto it = mIndex.find(id);
+            if (it == mIndex.end())
+                continue;
+            const std::size_t position = it->second;
+            mIndex.erase(it);
+            if (position + 1 != list.size())
+            {
+                list[position] = list.back();
+                mIndex[list[position]] = position;
+            }
+            list.pop_back();
+            mGrid.remove(id);
+        }
+        mPendingChanges.clear();
     }
 
-    void ObjectLists::ObjectGroup::updateList()
+    void ObjectLists::ObjectGroup::updateGrid(std::size_t frame)
     {
-        if (mChanged)
+        if (mGridFrame == frame)
+            return;
+        const MWWorld::WorldModel& worldModel = *MWBase::Environment::get().getWorldModel();
+        for (ObjectId id : *mList)
         {
-            mList->clear();
-            for (ObjectId id : mSet)
-                mList->push_back(id);
-            mChanged = false;
+            const MWWorld::Ptr ptr = worldModel.getPtr(id);
+            if (!ptr.isEmpty())
+                mGrid.update(id, get2dPosition(ptr));
         }
+        mGridFrame = frame;
     }
 
     void ObjectLists::ObjectGroup::clear()
     {
-        mChanged = false;
+        mPendingChanges.clear();
         mList->clear();
-        mSet.clear();
+        mIndex.clear();
+        mGrid.clear();
+        mGridFrame = 0;
+    }
+
+    template <class Function>
+    void ObjectLists::forEachCandidate(const osg::Vec3f& center, float radius, unsigned groups, Function&& function)
+    {
+        const std::pair<ObjectGroup*, Group> allGroups[] = {
+            { &mActivatorsInScene, Group_Activators },
+            { &mActorsInScene, Group_Actors },
+            { &mContainersInScene, Group_Containers },
+            { &mDoorsInScene, Group_Doors },
+            { &mItemsInScene, Group_Items },
+        };
+        const MWWorld::WorldModel& worldModel = *MWBase::Environment::get().getWorldModel();
+        const osg::Vec2f center2d(center.x(), center.y());
+        for (const auto& [group, flag] : allGroups)
+        {
+            if ((groups & flag) == 0)
+                continue;
+            {
+                // Scripts of different Lua states may run queries at the same time
+                const std::lock_guard lock(mGridMutex);
+                group->updateGrid(mFrame);
+            }
+            group->mGrid.forEachCandidate(center2d, radius, [&](ObjectId id) {
+                const MWWorld::Ptr ptr = worldModel.getPtr(id);
+                if (!ptr.isEmpty())
+                    function(id, ptr.getRefData().getPosition().asVec3());
+            });
+        }
     }
 
-    void ObjectLists::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
+    ObjectIdList ObjectLists::findInRadius(const osg::Vec3f& center, float radius, unsigned groups)
     {
-        group.mSet.insert(getId(ptr));
-        group.mChanged = true;
+        std::vector<std::pair<float, ObjectId>> found;
+        const float radius2 = radius * radius;
+        forEachCandidate(center, radius, groups, [&](ObjectId id, const osg::Vec3f& position) {
+            const float distance2 = (position - center).length2();
+            if (distance2 <= radius2)
+                found.emplace_back(distance2, id);
+        });
+        std::sort(found.begin(), found.end());
+        auto result = std::make_shared<std::vector<ObjectId>>();
+        result->reserve(found.size());
+        for (const auto& [distance2, id] : found)
+            result->push_back(id);
+        return result;
     }
 
-    void ObjectLists::removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
+    ObjectIdList ObjectLists::findInBox(const osg::Vec3f& min, const osg::Vec3f& max, unsigned groups)
     {
-        group.mSet.erase(getId(ptr));
-        group.mChanged = true;
+        auto result = std::make_shared<std::vector<ObjectId>>();
+        const osg::Vec3f center = (min + max) / 2;
+        const float halfSize = std::max(max.x() - min.x(), max.y() - min.y()) / 2;
+        forEachCandidate(center, halfSize, groups, [&](ObjectId id, const osg::Vec3f& position) {
+            if (position.x() >= min.x() && position.x() <= max.x() && position.y() >= min.y()
+                && position.y() <= max.y() && position.z() >= min.z() && position.z() <= max.z())
+                result->push_back(id);
+        });
+        return result;
     }
 }
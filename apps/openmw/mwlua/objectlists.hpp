@@ -1,7 +1,15 @@
 #ifndef MWLUA_OBJECTLISTS_H
 #define MWLUA_OBJECTLISTS_H
 
-#include <set>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <osg/Vec3f>
+
+#include <components/misc/spatialgrid.hpp>
 
 #include "object.hpp"
 
@@ -12,7 +20,18 @@ namespace MWLua
     class ObjectLists
     {
     public:
-        void update(); // Should be called every frame.
+        // Bit flags to choose the groups of objects for the spatial queries
+        enum Group : unsigned
+        {
+            Group_Activators = 1 << 0,
+            Group_Actors = 1 << 1,
+            Group_Containers = 1 << 2,
+            Group_Doors = 1 << 3,
+            Group_Items = 1 << 4,
+            Group_Any = Group_Activators | Group_Actors | Group_Containers | Group_Doors | Group_Items,
+        };
+
+        void update(); // Should be called every frame, applies the changes of the lists.
         void clear(); // Should be called every time before starting or loading a new game.
 
         ObjectIdList getActivatorsInScene() const { return mActivatorsInScene.mList; }
@@ -27,20 +46,33 @@ namespace MWLua
 
         void setPlayer(const MWWorld::Ptr& player) { *mPlayers = { getId(player) }; }
 
+        // Objects of the groups inside the sphere, the nearest first. Can be called from several threads.
+        ObjectIdList findInRadius(const osg::Vec3f& center, float radius, unsigned groups);
+
+        // Objects of the groups inside the axis aligned box. Can be called from several threads.
+        ObjectIdList findInBox(const osg::Vec3f& min, const osg::Vec3f& max, unsigned groups);
+
     private:
         struct ObjectGroup
         {
-            void updateList();
+            void applyChanges();
+            void updateGrid(std::size_t frame);
             void clear();
 
-            bool mChanged = false;
+            // Objects added (true) or removed (false) since the last update, the list is unchanged during a frame
+            std::vector<std::pair<ObjectId, bool>> mPendingChanges;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
-            std::set<ObjectId> mSet;
+            // Positions of the objects in mList
+            std::unordered_map<ObjectId, std::size_t> mIndex;
+            // Positions may be outdated, refreshed on the first query of the frame
+            Misc::SpatialGrid<ObjectId> mGrid{ 1024.f };
+            std::size_t mGridFrame = 0;
         };
 
+        template <class Function>
+        void forEachCandidate(const osg::Vec3f& center, float radius, unsigned groups, Function&& function);
+
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
-        void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
-        void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
         ObjectGroup mActivatorsInScene;
         ObjectGroup mActorsInScene;
@@ -48,6 +80,8 @@ namespace MWLua
         ObjectGroup mDoorsInScene;
         ObjectGroup mItemsInScene;
         ObjectIdList mPlayers = std::make_shared<std::vector<ObjectId>>();
+        std::size_t mFrame = 1;
+        std::mutex mGridMutex;
     };
 
 }
@@ -2,9 +2,15 @@
 
 #include <sol/object.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 #include <components/files/istreamptr.hpp>
+#include <components/lua/asyncpackage.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -13,6 +19,7 @@
 #include "../mwbase/environment.hpp"
 
 #include "context.hpp"
+#include "luamanagerimp.hpp"
 
 namespace MWLua
 {
@@ -24,6 +31,12 @@ namespace MWLua
         // Print a message if we read a large chunk of file to string.
         constexpr std::size_t sFileSizeWarningThreshold = 1024 * 1024;
 
+        // Files larger than this are not read by asyncRead unless the script asks for a larger budget.
+        constexpr std::size_t sDefaultAsyncReadBudget = 64 * 1024 * 1024;
+
+        // An aborted asyncRead stops after the current chunk.
+        constexpr std::size_t sAsyncReadChunkSize = 1024 * 1024;
+
         struct FileHandle
         {
         public:
@@ -60,12 +73,18 @@ namespace MWLua
             return newPos - oldPos;
         }
 
-        void printLargeDataMessage(FileHandle& file, size_t size)
+        void printLargeDataMessage(std::string_view fileName, size_t size)
         {
-            if (!file.mFilePtr || !Settings::lua().mLuaDebug || size < sFileSizeWarningThreshold)
+            if (!Settings::lua().mLuaDebug || size < sFileSizeWarningThreshold)
                 return;
 
-            Log(Debug::Verbose) << "Read a large data chunk (" << size << " bytes) from '" << file.mFileName << "'.";
+            Log(Debug::Verbose) << "Read a large data chunk (" << size << " bytes) from '" << fileName << "'.";
+        }
+
+        void printLargeDataMessage(FileHandle& file, size_t size)
+        {
+            if (file.mFilePtr)
+                printLargeDataMessage(file.mFileName, size);
         }
 
         sol::object readFile(LuaUtil::LuaState* lua, FileHandle& file)
@@ -130,6 +149,64 @@ namespace MWLua
             throw std::runtime_error("Error when handling '" + self.mFileName + "': attempt to use a closed file.");
         }
 
+        class AsyncReadItem final : public SceneUtil::WorkItem
+        {
+        public:
+            AsyncReadItem(const VFS::Manager& vfs, VFS::Path::Normalized fileName, std::size_t maxBytes)
+                : mVfs(vfs)
+                , mFileName(std::move(fileName))
+                , mMaxBytes(maxBytes)
+            {
+            }
+
+            void doWork() override
+            {
+                try
+                {
+                    Files::IStreamPtr stream = mVfs.get(mFileName);
+                    const std::size_t size = getBytesLeftInStream(stream);
+                    if (size > mMaxBytes)
+                        throw std::runtime_error("file size " + std::to_string(size) + " exceeds the budget of "
+                            + std::to_string(mMaxBytes) + " bytes");
+
+                    mContent.resize(size);
+                    for (std::size_t offset = 0; offset < size && !mAborted; offset += sAsyncReadChunkSize)
+                    {
+                        const std::size_t count = std::min(sAsyncReadChunkSize, size - offset);
+                        if (!stream->read(mContent.data() + offset, static_cast<std::streamsize>(count)))
+                            throw std::runtime_error("failed to read " + std::to_string(count) + " bytes at offset "
+                                + std::to_string(offset));
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    mContent.clear();
+                    mError = "Can not read file '" + mFileName.value() + "': " + e.what();
+                }
+            }
+
+            void abort() override { mAborted = true; }
+
+            const VFS::Path::Normalized& getFileName() const { return mFileName; }
+
+            std::string& getContent() { return mContent; }
+
+            const std::string& getError() const { return mError; }
+
+        private:
+            const VFS::Manager& mVfs;
+            const VFS::Path::Normalized mFileName;
+            const std::size_t mMaxBytes;
+            std::atomic_bool mAborted{ false };
+            std::string mContent;
+            std::string mError;
+        };
+
+        struct AsyncReadRequest
+        {
+            osg::ref_ptr<AsyncReadItem> mItem;
+        };
+
         sol::variadic_results seek(
             LuaUtil::LuaState* lua, FileHandle& self, std::ios_base::seekdir dir, std::streamoff off)
         {
@@ -321,6 +398,52 @@ namespace MWLua
             return values;
         };
 
+        sol::usertype<AsyncReadRequest> request
+            = context.mLua->sol().new_usertype<AsyncReadRequest>("AsyncReadRequest");
+        request["fileName"] = sol::readonly_property(
+            [](const AsyncReadRequest& self) -> std::string_view { return self.mItem->getFileName().value(); });
+        request["isDone"] = sol::readonly_property([](const AsyncReadRequest& self) { return self.mItem->isDone(); });
+        request["isCancelled"]
+            = sol::readonly_property([](const AsyncReadRequest& self) { return self.mItem->isCancelled(); });
+        request["cancel"] = [](const AsyncReadRequest& self) { self.mItem->cancel(); };
+        request[sol::meta_function::to_string] = [](const AsyncReadRequest& self) {
+            return "AsyncReadRequest{'" + self.mItem->getFileName().value() + "'"
+                + (self.mItem->isCancelled() ? ", cancelled" : (self.mItem->isDone() ? ", done" : "")) + "}";
+        };
+
+        api["asyncRead"] = [context, vfs](const sol::table& callback, std::string_view fileName,
+                               const sol::optional<sol::table>& options) {
+            std::size_t maxBytes = sDefaultAsyncReadBudget;
+            if (options.has_value())
+                maxBytes = options->get<sol::optional<std::size_t>>("maxBytes").value_or(maxBytes);
+
+            osg::ref_ptr<AsyncReadItem> item = new AsyncReadItem(*vfs, VFS::Path::Normalized(fileName), maxBytes);
+            context.mLuaManager->addAction(
+                [context, item, callback = LuaUtil::Callback::fromLua(callback)] {
+                    SceneUtil::WorkQueue* const workQueue
+                        = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue();
+                    if (workQueue != nullptr)
+                        workQueue->addWorkItem(item);
+                    else
+                    {
+                        if (!item->isCancelled())
+                            item->doWork();
+                        item->signalDone();
+                    }
+                    context.mLuaManager->addPendingWork(item, [item, callback] {
+                        if (item->isCancelled())
+                            return;
+                        printLargeDataMessage(item->getFileName().value(), item->getContent().size());
+                        if (item->getError().empty())
+                            callback.tryCall(std::move(item->getContent()));
+                        else
+                            callback.tryCall(sol::nil, item->getError());
+                    });
+                },
+                "AsyncReadAction");
+            return AsyncReadRequest{ std::move(item) };
+        };
+
         api["type"] = sol::overload(
             [](const FileHandle& handle) -> std::string {
                 if (handle.mFilePtr)
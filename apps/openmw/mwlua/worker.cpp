@@ -5,6 +5,7 @@
 #include "apps/openmw/profile.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/settings/values.hpp>
 
 #include <cassert>
@@ -43,6 +44,7 @@ namespace MWLua
     {
         if (mThread)
         {
+            OPENMW_TRACE_ZONE("MWLua::Worker::finishUpdate");
             std::unique_lock<std::mutex> lk(mMutex);
             mCV.wait(lk, [&] { return !mUpdateRequest.has_value(); });
         }
@@ -73,6 +75,8 @@ namespace MWLua
 
     void Worker::run() noexcept
     {
+        OPENMW_TRACE_THREAD_NAME("Lua worker");
+
         while (true)
         {
             std::unique_lock<std::mutex> lk(mMutex);
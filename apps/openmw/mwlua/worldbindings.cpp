@@ -10,6 +10,9 @@
 #include <components/esm3/loadskil.hpp>
 #include <components/esm3/loadweap.hpp>
 #include <components/lua/luastate.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/vfs/pathutil.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/statemanager.hpp"
@@ -27,6 +30,7 @@
 
 #include "corebindings.hpp"
 #include "mwscriptbindings.hpp"
+#include "objectbindings.hpp"
 
 namespace MWLua
 {
@@ -137,6 +141,8 @@ namespace MWLua
         api["activeActors"] = GObjectList{ objectLists->getActorsInScene() };
         api["players"] = GObjectList{ objectLists->getPlayers() };
 
+        addBatchedObjectBindings(api, context);
+
         api["createObject"] = [lua = context.mLua](std::string_view recordId, sol::optional<int> count) -> GObject {
             checkGameInitialized(lua);
             MWWorld::ManualRef mref(*MWBase::Environment::get().getESMStore(), ESM::RefId::deserializeText(recordId));
@@ -144,6 +150,11 @@ namespace MWLua
             ptr.getRefData().disable();
             MWWorld::CellStore& cell = MWBase::Environment::get().getWorldModel()->getDraftCell();
             MWWorld::Ptr newPtr = ptr.getClass().copyToCell(ptr, cell, count.value_or(1));
+            // The object is usually placed into the scene soon after, load its model in the background meanwhile
+            const std::string model = newPtr.getClass().getCorrectedModel(newPtr);
+            if (!model.empty())
+                MWBase::Environment::get().getResourceSystem()->getSceneManager()->prefetch(
+                    { VFS::Path::Normalized(model) });
             return GObject(newPtr);
         };
         api["getObjectByFormId"] = [](std::string_view formIdStr) -> GObject {
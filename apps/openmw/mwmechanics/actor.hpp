@@ -2,6 +2,7 @@
 #define OPENMW_MECHANICS_ACTOR_H
 
 #include <memory>
+#include <utility>
 
 #include "character.hpp"
 #include "creaturestats.hpp"
@@ -62,6 +63,11 @@ namespace MWMechanics
         void setPositionAdjusted(bool adjusted) { mPositionAdjusted = adjusted; }
         bool getPositionAdjusted() const { return mPositionAdjusted; }
 
+        /// Accumulate time passed while AI update is skipped
+        void addAiUpdateDuration(float duration) { mAiUpdateDuration += duration; }
+        /// Return time passed since the last AI update and reset it
+        float takeAiUpdateDuration() { return std::exchange(mAiUpdateDuration, 0.f); }
+
     private:
         CharacterController mCharacterController;
         int mGreetingTimer{ 0 };
@@ -71,6 +77,7 @@ namespace MWMechanics
         Misc::DeviatingPeriodicTimer mEngageCombat{ 1.0f, 0.25f,
             Misc::Rng::deviate(0, 0.25f, MWBase::Environment::get().getWorld()->getPrng()) };
         bool mPositionAdjusted;
+        float mAiUpdateDuration{ 0.f };
     };
 
 }
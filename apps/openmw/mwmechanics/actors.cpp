@@ -1,7 +1,11 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <array>
 #include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
@@ -10,7 +14,10 @@
 #include <components/misc/mathutil.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 
 #include <components/esm3/loadcrea.hpp>
@@ -228,6 +235,12 @@ namespace
         ptr.getClass().getCreatureStats(ptr).getActiveSpells().unloadActor(ptr);
     }
 
+    osg::Vec2f get2dPosition(const MWWorld::Ptr& ptr)
+    {
+        const ESM::Position& position = ptr.getRefData().getPosition();
+        return osg::Vec2f(position.pos[0], position.pos[1]);
+    }
+
 }
 
 namespace MWMechanics
@@ -247,6 +260,147 @@ namespace MWMechanics
             return (distanceToNextPathPoint - package.getNextPathPointTolerance(speed, duration, halfExtents)) / speed;
         }
 
+        // Actors far from the player update AI less often, updates of different actors are spread over frames
+        std::size_t getAiUpdatePeriod(const AiSequence& sequence, float distSqr)
+        {
+            // Fights and pursuits need to react quickly at any distance
+            if (sequence.isInCombat() || sequence.isInPursuit())
+                return 1;
+            const float fullRateDistance = static_cast<float>(Settings::game().mAiFullRateDistance);
+            if (distSqr <= fullRateDistance * fullRateDistance)
+                return 1;
+            const float lowRateDistance = static_cast<float>(Settings::game().mAiLowRateDistance);
+            if (distSqr <= lowRateDistance * lowRateDistance)
+                return 4;
+            return 16;
+        }
+
+        // Distant actors evaluate their skeletons less often, the animation time advances every frame anyway
+        unsigned int getAnimationUpdateInterval(
+            const CharacterController& ctrl, const AiSequence& sequence, float distSqr)
+        {
+            // Hits, projectiles and scripts depend on the current pose of fighting and scripted actors
+            if (sequence.isInCombat() || sequence.isInPursuit() || ctrl.isAttackingOrSpell()
+                || ctrl.isScriptedAnimPlaying())
+                return 1;
+            const float fullRateDistance = static_cast<float>(Settings::game().mAnimationFullRateDistance);
+            if (distSqr <= fullRateDistance * fullRateDistance)
+                return 1;
+            const float lowRateDistance = static_cast<float>(Settings::game().mAnimationLowRateDistance);
+            if (distSqr <= lowRateDistance * lowRateDistance)
+                return 2;
+            return 4;
+        }
+
+        struct ActorMotionState
+        {
+            MWWorld::Ptr mPtr;
+            osg::Vec3f mPosition;
+            float mRotZ;
+            osg::Vec3f mHalfExtents;
+            osg::Vec3f mSpeed;
+            bool mIsDead;
+        };
+
+        struct CollisionAvoidanceRequest
+        {
+            std::size_t mActor;
+            MWWorld::Ptr mTarget;
+            osg::Vec2f mOrigMovement;
+            float mMaxSpeed;
+            bool mIsMoving;
+            bool mShouldTurnToApproachingActor;
+            float mMaxDistToCheck;
+            float mTimeToCheck;
+        };
+
+        struct CollisionCandidate
+        {
+            float mTime;
+            std::size_t mOther;
+            float mAngleToApproachingActor;
+            osg::Vec2f mMovementCorrection;
+        };
+
+        // Returns predicted collisions with the given actors sorted by time, visibility and awareness are not checked
+        std::vector<CollisionCandidate> findCollisionCandidates(const CollisionAvoidanceRequest& request,
+            const std::vector<ActorMotionState>& states, const std::vector<std::size_t>& others)
+        {
+            const float minGap = 10.f;
+            const float maxDistForPartialAvoiding = 200.f;
+            const float maxDistForStrictAvoiding = 100.f;
+
+            const ActorMotionState& base = states[request.mActor];
+            const osg::Vec2f baseSpeed = request.mOrigMovement * request.mMaxSpeed;
+
+            std::vector<CollisionCandidate> result;
+
+            for (const std::size_t i : others)
+            {
+                const ActorMotionState& other = states[i];
+                if (i == request.mActor || other.mPtr == request.mTarget)
+                    continue;
+
+                const osg::Vec3f deltaPos = other.mPosition - base.mPosition;
+                const float dist = deltaPos.length();
+
+                // Ignore actors which are not close enough.
+                if (dist > request.mMaxDistToCheck)
+                    continue;
+
+                // Ignore actors which come from behind.
+                const osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), base.mRotZ);
+                if (relPos.y() < 0)
+                    continue;
+
+                // Don't check for a collision if vertical distance is greater then the actor's height.
+                if (deltaPos.z() > base.mHalfExtents.z() * 2 || deltaPos.z() < -other.mHalfExtents.z() * 2)
+                    continue;
+
+                const osg::Vec2f relSpeed
+                    = Misc::rotateVec2f(osg::Vec2f(other.mSpeed.x(), other.mSpeed.y()), base.mRotZ - other.mRotZ)
+                    - baseSpeed;
+
+                float collisionDist = minGap + base.mHalfExtents.x() + other.mHalfExtents.x();
+                collisionDist = std::min(collisionDist, relPos.length());
+
+                // Find the earliest `t` when |relPos + relSpeed * t| == collisionDist.
+                const float vr = relPos.x() * relSpeed.x() + relPos.y() * relSpeed.y();
+                const float v2 = relSpeed.length2();
+                const float Dh = vr * vr - v2 * (relPos.length2() - collisionDist * collisionDist);
+                if (Dh <= 0 || v2 == 0)
+                    continue; // No solution; distance is always >= collisionDist.
+                const float t = (-vr - std::sqrt(Dh)) / v2;
+
+                if (t < 0 || t >= request.mTimeToCheck)
+                    continue;
+
+                const osg::Vec2f posAtT = relPos + relSpeed * t;
+                const float coef = (posAtT.x() * relSpeed.x() + posAtT.y() * relSpeed.y())
+                    / (collisionDist * collisionDist * request.mMaxSpeed)
+                    * std::clamp(
+                        (maxDistForPartialAvoiding - dist) / (maxDistForPartialAvoiding - maxDistForStrictAvoiding),
+                        0.f, 1.f);
+                osg::Vec2f movementCorrection = posAtT * coef;
+                if (other.mIsDead)
+                    // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
+                    movementCorrection.y() *= 0.5f;
+
+                result.push_back(CollisionCandidate{
+                    .mTime = t,
+                    .mOther = i,
+                    .mAngleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y()),
+                    .mMovementCorrection = movementCorrection,
+                });
+            }
+
+            std::sort(result.begin(), result.end(), [](const CollisionCandidate& l, const CollisionCandidate& r) {
+                return std::tie(l.mTime, l.mOther) < std::tie(r.mTime, r.mOther);
+            });
+
+            return result;
+        }
+
         void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
             MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
         {
@@ -882,6 +1036,22 @@ namespace MWMechanics
         stats.setFatigue(fatigue);
     }
 
+    void Actors::restoreDynamicStats(std::span<const MWWorld::Ptr> actors, double hours, bool sleep) const
+    {
+        // Getting the stats may create them with the inventory, which is not thread safe. Restoring the stats of one
+        // actor doesn't depend on other actors.
+        for (const MWWorld::Ptr& ptr : actors)
+            ptr.getClass().getContainerStore(ptr);
+
+        const auto restore = [&](std::size_t i) { restoreDynamicStats(actors[i], hours, sleep); };
+        if (SceneUtil::WorkQueue* const workQueue
+            = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue())
+            workQueue->parallelFor(actors.size(), restore);
+        else
+            for (std::size_t i = 0; i < actors.size(); ++i)
+                restore(i);
+    }
+
     void Actors::calculateRestoration(const MWWorld::Ptr& ptr, float duration) const
     {
         if (ptr.getClass().getCreatureStats(ptr).isDead())
@@ -1175,6 +1345,7 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, anim);
         mIndex.emplace(ptr.mRef, it);
+        mGrid.update(&*it, get2dPosition(ptr));
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1225,6 +1396,8 @@ namespace MWMechanics
         {
             if (!keepActive)
                 removeTemporaryEffects(iter->second->getPtr());
+            mGrid.remove(&*iter->second);
+            invalidateSidingCache();
             mActors.erase(iter->second);
             mIndex.erase(iter);
         }
@@ -1275,6 +1448,13 @@ namespace MWMechanics
             iter->second->updatePtr(ptr);
     }
 
+    void Actors::updateActorPosition(const MWWorld::Ptr& ptr)
+    {
+        const auto iter = mIndex.find(ptr.mRef);
+        if (iter != mIndex.end())
+            mGrid.update(&*iter->second, get2dPosition(ptr));
+    }
+
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
     {
         for (auto iter = mActors.begin(); iter != mActors.end();)
@@ -1283,6 +1463,8 @@ namespace MWMechanics
             {
                 removeTemporaryEffects(iter->getPtr());
                 mIndex.erase(iter->getPtr().mRef);
+                mGrid.remove(&*iter);
+                invalidateSidingCache();
                 iter = mActors.erase(iter);
             }
             else
@@ -1295,25 +1477,40 @@ namespace MWMechanics
         if (!MWBase::Environment::get().getMechanicsManager()->isAIActive())
             return;
 
-        const float minGap = 10.f;
         const float maxDistForPartialAvoiding = 200.f;
         const float maxDistForStrictAvoiding = 100.f;
         const float maxTimeToCheck = 2.0f;
         const bool giveWayWhenIdle = Settings::game().mNPCsGiveWay;
 
         const MWWorld::Ptr player = getPlayer();
-        const MWBase::World* const world = MWBase::Environment::get().getWorld();
+        MWBase::World* const world = MWBase::Environment::get().getWorld();
+
+        // Take a snapshot of all actors first so the predictions don't depend on each other and on the actors order
+        std::vector<ActorMotionState> states;
+        std::vector<CollisionAvoidanceRequest> requests;
+        std::unordered_map<const Actor*, std::size_t> stateIndices;
+        states.reserve(mActors.size());
         for (const Actor& actor : mActors)
         {
+            stateIndices.emplace(&actor, states.size());
             const MWWorld::Ptr& ptr = actor.getPtr();
+            const float maxSpeed = ptr.getClass().getMaxSpeed(ptr);
+            const Movement& movement = ptr.getClass().getMovementSettings(ptr);
+            states.push_back(ActorMotionState{
+                .mPtr = ptr,
+                .mPosition = ptr.getRefData().getPosition().asVec3(),
+                .mRotZ = ptr.getRefData().getPosition().rot[2],
+                .mHalfExtents = world->getHalfExtents(ptr),
+                .mSpeed = movement.asVec3() * maxSpeed,
+                .mIsDead = ptr.getClass().getCreatureStats(ptr).isDead(),
+            });
+
             if (ptr == player)
                 continue; // Don't interfere with player controls.
 
-            const float maxSpeed = ptr.getClass().getMaxSpeed(ptr);
             if (maxSpeed == 0.0)
                 continue; // Can't move, so there is no sense to predict collisions.
 
-            Movement& movement = ptr.getClass().getMovementSettings(ptr);
             const osg::Vec2f origMovement(movement.mPosition[0], movement.mPosition[1]);
             const bool isMoving = origMovement.length2() > 0.01;
             if (movement.mPosition[1] < 0)
@@ -1351,96 +1548,70 @@ namespace MWMechanics
             if (!shouldAvoidCollision && !shouldGiveWay)
                 continue;
 
-            const osg::Vec2f baseSpeed = origMovement * maxSpeed;
-            const osg::Vec3f basePos = ptr.getRefData().getPosition().asVec3();
-            const float baseRotZ = ptr.getRefData().getPosition().rot[2];
-            const osg::Vec3f halfExtents = world->getHalfExtents(ptr);
-            const float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
-
             float timeToCheck = maxTimeToCheck;
             if (!shouldGiveWay && !aiSequence.isEmpty())
-                timeToCheck = std::min(
-                    timeToCheck, getTimeToDestination(**aiSequence.begin(), basePos, maxSpeed, duration, halfExtents));
-
-            float timeToCollision = timeToCheck;
-            osg::Vec2f movementCorrection(0, 0);
-            float angleToApproachingActor = 0;
-
-            // Iterate through all other actors and predict collisions.
-            for (const Actor& otherActor : mActors)
-            {
-                const MWWorld::Ptr& otherPtr = otherActor.getPtr();
-                if (otherPtr == ptr || otherPtr == currentTarget)
-                    continue;
-
-                const osg::Vec3f otherHalfExtents = world->getHalfExtents(otherPtr);
-                const osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
-                const osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), baseRotZ);
-                const float dist = deltaPos.length();
-
-                // Ignore actors which are not close enough or come from behind.
-                if (dist > maxDistToCheck || relPos.y() < 0)
-                    continue;
-
-                // Don't check for a collision if vertical distance is greater then the actor's height.
-                if (deltaPos.z() > halfExtents.z() * 2 || deltaPos.z() < -otherHalfExtents.z() * 2)
-                    continue;
-
-                const osg::Vec3f speed = otherPtr.getClass().getMovementSettings(otherPtr).asVec3()
-                    * otherPtr.getClass().getMaxSpeed(otherPtr);
-                const float rotZ = otherPtr.getRefData().getPosition().rot[2];
-                const osg::Vec2f relSpeed
-                    = Misc::rotateVec2f(osg::Vec2f(speed.x(), speed.y()), baseRotZ - rotZ) - baseSpeed;
-
-                float collisionDist = minGap + halfExtents.x() + otherHalfExtents.x();
-                collisionDist = std::min(collisionDist, relPos.length());
-
-                // Find the earliest `t` when |relPos + relSpeed * t| == collisionDist.
-                const float vr = relPos.x() * relSpeed.x() + relPos.y() * relSpeed.y();
-                const float v2 = relSpeed.length2();
-                const float Dh = vr * vr - v2 * (relPos.length2() - collisionDist * collisionDist);
-                if (Dh <= 0 || v2 == 0)
-                    continue; // No solution; distance is always >= collisionDist.
-                const float t = (-vr - std::sqrt(Dh)) / v2;
-
-                if (t < 0 || t > timeToCollision)
-                    continue;
+                timeToCheck = std::min(timeToCheck,
+                    getTimeToDestination(
+                        **aiSequence.begin(), states.back().mPosition, maxSpeed, duration, states.back().mHalfExtents));
+
+            requests.push_back(CollisionAvoidanceRequest{
+                .mActor = states.size() - 1,
+                .mTarget = currentTarget,
+                .mOrigMovement = origMovement,
+                .mMaxSpeed = maxSpeed,
+                .mIsMoving = isMoving,
+                .mShouldTurnToApproachingActor = shouldTurnToApproachingActor,
+                .mMaxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding,
+                .mTimeToCheck = timeToCheck,
+            });
+        }
 
-                // Check visibility and awareness last as it's expensive.
-                if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
-                    continue;
-                if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
-                    continue;
+        // Predicting collisions reads only the snapshot and the actors grid, so it can be done for different actors on
+        // different threads
+        std::vector<std::vector<CollisionCandidate>> candidates(requests.size());
+        const auto findCandidates = [&](std::size_t i) {
+            const ActorMotionState& state = states[requests[i].mActor];
+            std::vector<std::size_t> others;
+            mGrid.forEachCandidate(osg::Vec2f(state.mPosition.x(), state.mPosition.y()), requests[i].mMaxDistToCheck,
+                [&](const Actor* actor) {
+                    if (const auto it = stateIndices.find(actor); it != stateIndices.end())
+                        others.push_back(it->second);
+                });
+            candidates[i] = findCollisionCandidates(requests[i], states, others);
+        };
+        if (SceneUtil::WorkQueue* const workQueue
+            = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue())
+            workQueue->parallelFor(requests.size(), findCandidates);
+        else
+            for (std::size_t i = 0; i < requests.size(); ++i)
+                findCandidates(i);
 
-                timeToCollision = t;
-                angleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y());
-                const osg::Vec2f posAtT = relPos + relSpeed * t;
-                const float coef = (posAtT.x() * relSpeed.x() + posAtT.y() * relSpeed.y())
-                    / (collisionDist * collisionDist * maxSpeed)
-                    * std::clamp(
-                        (maxDistForPartialAvoiding - dist) / (maxDistForPartialAvoiding - maxDistForStrictAvoiding),
-                        0.f, 1.f);
-                movementCorrection = posAtT * coef;
-                if (otherPtr.getClass().getCreatureStats(otherPtr).isDead())
-                    // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
-                    movementCorrection.y() *= 0.5f;
-            }
+        // Visibility and awareness checks are expensive and not thread safe, do them only for the nearest collisions
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const CollisionAvoidanceRequest& request = requests[i];
+            const MWWorld::Ptr& ptr = states[request.mActor].mPtr;
+            const auto candidate = std::find_if(candidates[i].begin(), candidates[i].end(), [&](const auto& v) {
+                const MWWorld::Ptr& otherPtr = states[v.mOther].mPtr;
+                return world->getLOS(otherPtr, ptr)
+                    && MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr);
+            });
+            if (candidate == candidates[i].end())
+                continue;
 
-            if (timeToCollision < timeToCheck)
-            {
-                // Try to evade the nearest collision.
-                osg::Vec2f newMovement = origMovement + movementCorrection;
-                // Step to the side rather than backward. Otherwise player will be able to push the NPC far away from
-                // it's original location.
-                newMovement.y() = std::max(newMovement.y(), 0.f);
-                newMovement.normalize();
-                if (isMoving)
-                    newMovement *= origMovement.length(); // Keep the original speed.
-                movement.mPosition[0] = newMovement.x();
-                movement.mPosition[1] = newMovement.y();
-                if (shouldTurnToApproachingActor)
-                    zTurn(ptr, angleToApproachingActor);
-            }
+            // Try to evade the nearest collision.
+            osg::Vec2f newMovement = request.mOrigMovement + candidate->mMovementCorrection;
+            // Step to the side rather than backward. Otherwise player will be able to push the NPC far away from
+            // it's original location.
+            newMovement.y() = std::max(newMovement.y(), 0.f);
+            newMovement.normalize();
+            if (request.mIsMoving)
+                newMovement *= request.mOrigMovement.length(); // Keep the original speed.
+            Movement& movement = ptr.getClass().getMovementSettings(ptr);
+            movement.mPosition[0] = newMovement.x();
+            movement.mPosition[1] = newMovement.y();
+            if (request.mShouldTurnToApproachingActor)
+                zTurn(ptr, candidate->mAngleToApproachingActor);
         }
     }
 
@@ -1471,7 +1642,8 @@ namespace MWMechanics
 
             /// \todo move update logic to Actor class where appropriate
 
-            SidingCache cachedAllies{ *this, true }; // will be filled as engageCombat iterates
+            updateSidingCache();
+            SidingCache& cachedAllies = mSidingCache; // will be filled as engageCombat iterates
 
             const bool aiActive = MWBase::Environment::get().getMechanicsManager()->isAIActive();
             const int attackedByPlayerId = player.getClass().getCreatureStats(player).getHitAttemptActorId();
@@ -1484,6 +1656,16 @@ namespace MWMechanics
             }
             const int actorsProcessingRange = Settings::game().mActorsProcessingRange;
 
+            // AI packages run only in simulation ticks, the frames in between add their time to the next update
+            const bool aiTick = MWBase::Environment::get().isSimulationTick();
+            if (aiTick)
+                ++mAiUpdateFrame;
+            mAiUpdateStats = AiUpdateStats{};
+
+            // Positions are updated when objects are moved, but make sure nothing set directly is missed
+            for (const Actor& actor : mActors)
+                mGrid.update(&actor, get2dPosition(actor.getPtr()));
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
@@ -1565,7 +1747,23 @@ namespace MWMechanics
                             CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                             if (isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
                             {
-                                stats.getAiSequence().execute(actor.getPtr(), ctrl, duration);
+                                const std::size_t period = getAiUpdatePeriod(stats.getAiSequence(), distSqr);
+                                switch (period)
+                                {
+                                    case 1:
+                                        ++mAiUpdateStats.mFullRate;
+                                        break;
+                                    case 4:
+                                        ++mAiUpdateStats.mReducedRate;
+                                        break;
+                                    default:
+                                        ++mAiUpdateStats.mLowRate;
+                                        break;
+                                }
+                                actor.addAiUpdateDuration(duration);
+                                if (aiTick
+                                    && (mAiUpdateFrame + static_cast<std::size_t>(stats.getActorId())) % period == 0)
+                                    stats.getAiSequence().execute(actor.getPtr(), ctrl, actor.takeAiUpdateDuration());
                                 updateGreetingState(actor.getPtr(), actor, mTimerUpdateHello > 0);
                                 playIdleDialogue(actor.getPtr());
                                 updateMovementSpeed(actor.getPtr());
@@ -1576,7 +1774,10 @@ namespace MWMechanics
                         && !(luaControls && luaControls->mDisableAI))
                     {
                         CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
-                        stats.getAiSequence().execute(actor.getPtr(), ctrl, duration, /*outOfRange*/ true);
+                        actor.addAiUpdateDuration(duration);
+                        if (aiTick)
+                            stats.getAiSequence().execute(
+                                actor.getPtr(), ctrl, actor.takeAiUpdateDuration(), /*outOfRange*/ true);
                     }
 
                     if (inProcessingRange && actor.getPtr().getClass().isNpc())
@@ -1622,6 +1823,12 @@ namespace MWMechanics
 
                 CharacterController& ctrl = actor.getCharacterController();
                 ctrl.setActive(active);
+                if (isPlayer)
+                    ctrl.setAnimationUpdateInterval(1, 0);
+                else
+                    ctrl.setAnimationUpdateInterval(
+                        getAnimationUpdateInterval(ctrl, stats.getAiSequence(), dist * dist),
+                        static_cast<unsigned int>(stats.getActorId()));
 
                 if (!inRange)
                 {
@@ -2035,22 +2242,20 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
-        }
+        mGrid.forEachCandidate(osg::Vec2f(position.x(), position.y()), radius, [&](const Actor* actor) {
+            if ((actor->getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                out.push_back(actor->getPtr());
+        });
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                return true;
-        }
-
-        return false;
+        bool result = false;
+        mGrid.forEachCandidate(osg::Vec2f(position.x(), position.y()), radius, [&](const Actor* actor) {
+            if ((actor->getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                result = true;
+        });
+        return result;
     }
 
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
@@ -2251,9 +2456,33 @@ namespace MWMechanics
 
     void Actors::clear()
     {
+        mGrid.clear();
         mIndex.clear();
         mActors.clear();
         mDeathCount.clear();
+        invalidateSidingCache();
+    }
+
+    void Actors::invalidateSidingCache()
+    {
+        mSidingCache.clear();
+        mSidingState.clear();
+    }
+
+    void Actors::updateSidingCache()
+    {
+        std::vector<SidingState> state;
+        state.reserve(mActors.size());
+        for (const Actor& actor : mActors)
+        {
+            const MWWorld::Ptr& ptr = actor.getPtr();
+            const CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+            state.push_back(SidingState{ ptr.mRef, stats.getAiSequence().getRevision(), stats.isDead() });
+        }
+        if (state == mSidingState)
+            return;
+        mSidingCache.clear();
+        mSidingState = std::move(state);
     }
 
     void Actors::updateMagicEffects(const MWWorld::Ptr& ptr) const
@@ -4,11 +4,14 @@
 #include <list>
 #include <map>
 #include <set>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "actor.hpp"
 
+#include <components/misc/spatialgrid.hpp>
+
 namespace ESM
 {
     class ESMReader;
@@ -36,7 +39,26 @@ namespace MWMechanics
     class Actor;
     class CharacterController;
     class CreatureStats;
-    class SidingCache;
+    class Actors;
+
+    class SidingCache
+    {
+        const Actors& mActors;
+        const bool mExcludeInfighting;
+        std::map<MWWorld::Ptr, std::set<MWWorld::Ptr>> mCache;
+
+    public:
+        SidingCache(const Actors& actors, bool excludeInfighting)
+            : mActors(actors)
+            , mExcludeInfighting(excludeInfighting)
+        {
+        }
+
+        /// Recursive version of getActorsSidingWith that takes, returns a cached set of allies
+        const std::set<MWWorld::Ptr>& getActorsSidingWith(const MWWorld::Ptr& actor);
+
+        void clear() { mCache.clear(); }
+    };
 
     class Actors
     {
@@ -45,6 +67,16 @@ namespace MWMechanics
         std::list<Actor>::const_iterator end() const { return mActors.end(); }
         std::size_t size() const { return mActors.size(); }
 
+        /// Number of actors updating AI at each rate during the last frame
+        struct AiUpdateStats
+        {
+            std::size_t mFullRate = 0;
+            std::size_t mReducedRate = 0;
+            std::size_t mLowRate = 0;
+        };
+
+        const AiUpdateStats& getAiUpdateStats() const { return mAiUpdateStats; }
+
         void notifyDied(const MWWorld::Ptr& actor);
 
         /// Check if the target actor was detected by an observer
@@ -72,6 +104,9 @@ namespace MWMechanics
         void updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) const;
         ///< Updates an actor with a new Ptr
 
+        void updateActorPosition(const MWWorld::Ptr& ptr);
+        ///< Updates position of an actor used by range queries
+
         void dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore);
         ///< Deregister all actors (except for \a ignore) in the given cell.
 
@@ -98,6 +133,9 @@ namespace MWMechanics
 
         void restoreDynamicStats(const MWWorld::Ptr& actor, double hours, bool sleep) const;
 
+        /// Same as restoring the stats of each actor in turn, but done on the work threads
+        void restoreDynamicStats(std::span<const MWWorld::Ptr> actors, double hours, bool sleep) const;
+
         int getHoursToRest(const MWWorld::Ptr& ptr) const;
         ///< Calculate how many hours the given actor needs to rest in order to be fully healed
 
@@ -171,6 +209,7 @@ namespace MWMechanics
         std::map<ESM::RefId, int> mDeathCount;
         std::list<Actor> mActors;
         std::map<const MWWorld::LiveCellRefBase*, std::list<Actor>::iterator> mIndex;
+        Misc::SpatialGrid<const Actor*> mGrid{ 1024.f };
         // We should add a delay between summoned creature death and its corpse despawning
         float mTimerDisposeSummonsCorpses = 0.2f;
         float mTimerUpdateHeadTrack = 0;
@@ -178,6 +217,25 @@ namespace MWMechanics
         float mTimerUpdateHello = 0;
         float mSneakTimer = 0; // Times update of sneak icon
         float mSneakSkillTimer = 0; // Times sneak skill progress from "avoid notice"
+        std::size_t mAiUpdateFrame = 0;
+        AiUpdateStats mAiUpdateStats;
+
+        struct SidingState
+        {
+            const MWWorld::LiveCellRefBase* mRef;
+            unsigned mAiSequenceRevision;
+            bool mDead;
+
+            friend bool operator==(const SidingState& l, const SidingState& r) = default;
+        };
+
+        // Allies found by engageCombat, kept across frames until AI packages, deaths or the set of actors change
+        SidingCache mSidingCache{ *this, true };
+        std::vector<SidingState> mSidingState;
+
+        void invalidateSidingCache();
+
+        void updateSidingCache();
 
         void updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const;
 
@@ -200,23 +258,6 @@ namespace MWMechanics
         void engageCombat(const MWWorld::Ptr& actor1, const MWWorld::Ptr& actor2, SidingCache& cachedAllies,
             bool againstPlayer) const;
     };
-
-    class SidingCache
-    {
-        const Actors& mActors;
-        const bool mExcludeInfighting;
-        std::map<MWWorld::Ptr, std::set<MWWorld::Ptr>> mCache;
-
-    public:
-        SidingCache(const Actors& actors, bool excludeInfighting)
-            : mActors(actors)
-            , mExcludeInfighting(excludeInfighting)
-        {
-        }
-
-        /// Recursive version of getActorsSidingWith that takes, returns a cached set of allies
-        const std::set<MWWorld::Ptr>& getActorsSidingWith(const MWWorld::Ptr& actor);
-    };
 }
 
 #endif
@@ -162,10 +162,21 @@ namespace MWMechanics
         return mWeapon.get<ESM::Weapon>()->mBase;
     }
 
-    std::unique_ptr<Action> prepareNextAction(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    ActorActionRatings::ActorActionRatings(const MWWorld::Ptr& actor)
     {
-        Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
+        // Werewolves don't cast spells
+        if (actor.getClass().isNpc() && actor.getClass().getNpcStats(actor).isWerewolf())
+            return;
+
+        for (const ESM::Spell* spell : actor.getClass().getCreatureStats(actor).getSpells())
+        {
+            if (const std::optional<CasterSpellRating> rating = rateSpellForCaster(spell, actor))
+                mSpells.push_back(*rating);
+        }
+    }
 
+    std::unique_ptr<Action> prepareNextAction(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    {
         float bestActionRating = 0.f;
         float antiFleeRating = 0.f;
         // Default to hand-to-hand combat
@@ -232,14 +243,14 @@ namespace MWMechanics
             }
         }
 
-        for (const ESM::Spell* spell : spells)
+        for (const CasterSpellRating& spell : ActorActionRatings(actor).mSpells)
         {
             float rating = rateSpell(spell, actor, enemy);
             if (rating > bestActionRating)
             {
                 bestActionRating = rating;
-                bestAction = std::make_unique<ActionSpell>(spell->mId);
-                antiFleeRating = vanillaRateSpell(spell, actor, enemy);
+                bestAction = std::make_unique<ActionSpell>(spell.mSpell->mId);
+                antiFleeRating = vanillaRateSpell(spell.mSpell, actor, enemy);
             }
         }
 
@@ -254,8 +265,11 @@ namespace MWMechanics
 
     float getBestActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
     {
-        Spells& spells = actor.getClass().getCreatureStats(actor).getSpells();
+        return getBestActionRating(ActorActionRatings(actor), actor, enemy);
+    }
 
+    float getBestActionRating(const ActorActionRatings& ratings, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    {
         float bestActionRating = 0.f;
         // Default to hand-to-hand combat
         if (actor.getClass().isNpc() && actor.getClass().getNpcStats(actor).isWerewolf())
@@ -290,7 +304,7 @@ namespace MWMechanics
             }
         }
 
-        for (const ESM::Spell* spell : spells)
+        for (const CasterSpellRating& spell : ratings.mSpells)
         {
             float rating = rateSpell(spell, actor, enemy);
             if (rating > bestActionRating)
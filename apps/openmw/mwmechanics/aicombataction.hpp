@@ -2,10 +2,13 @@
 #define OPENMW_AICOMBAT_ACTION_H
 
 #include <memory>
+#include <vector>
 
 #include "../mwworld/containerstore.hpp"
 #include "../mwworld/ptr.hpp"
 
+#include "spellpriority.hpp"
+
 namespace MWMechanics
 {
     class Action
@@ -99,8 +102,20 @@ namespace MWMechanics
         const ESM::Weapon* getWeapon() const override;
     };
 
+    /// @brief The parts of the action ratings of an actor which don't depend on the enemy, to rate the actions against
+    /// several enemies without computing them again.
+    /// @note Valid while the spells, the magic effects and the stats of the actor don't change, so it is made for one
+    /// round of combat decisions and not kept.
+    struct ActorActionRatings
+    {
+        std::vector<CasterSpellRating> mSpells;
+
+        explicit ActorActionRatings(const MWWorld::Ptr& actor);
+    };
+
     std::unique_ptr<Action> prepareNextAction(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
     float getBestActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
+    float getBestActionRating(const ActorActionRatings& ratings, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
 
     float getDistanceMinusHalfExtents(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool minusZDist = false);
     float getMaxAttackDistance(const MWWorld::Ptr& actor);
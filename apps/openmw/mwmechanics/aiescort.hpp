@@ -42,6 +42,7 @@ namespace MWMechanics
             AiPackage::Options options;
             options.mUseVariableSpeed = true;
             options.mSideWithTarget = true;
+            options.mAsyncPathReplanning = true;
             return options;
         }
 
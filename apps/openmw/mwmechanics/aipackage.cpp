@@ -180,8 +180,13 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
                     = world->getStore().get<ESM::Pathgrid>().search(*actor.getCell()->getCell());
                 const DetourNavigator::Flags navigatorFlags = getNavigatorFlags(actor);
                 const DetourNavigator::AreaCosts areaCosts = getAreaCosts(actor, navigatorFlags);
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(pathgrid),
-                    agentBounds, navigatorFlags, areaCosts, endTolerance, pathType);
+                const bool replanAsync = mOptions.mAsyncPathReplanning && !wasShortcutting
+                    && mPathFinder.isPathConstructed() && mPathFinder.getPathCell() == actor.getCell();
+                if (!replanAsync
+                    || !mPathFinder.buildLimitedPathAsync(actor, position, dest, actor.getCell(), agentBounds,
+                        navigatorFlags, areaCosts, endTolerance, pathType))
+                    mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(pathgrid),
+                        agentBounds, navigatorFlags, areaCosts, endTolerance, pathType);
                 mRotateOnTheRunChecks = 3;
 
                 // give priority to go directly on target if there is minimal opportunity
@@ -41,6 +41,8 @@ namespace MWMechanics
             bool mShouldCancelPreviousAi = true;
             bool mRepeat = false;
             bool mAlwaysActive = false;
+            // Keep following the current path while a new one is searched for in a worker thread
+            bool mAsyncPathReplanning = false;
 
             constexpr Options withRepeat(bool value)
             {
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <optional>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/aisequence.hpp>
@@ -26,6 +27,7 @@ namespace MWMechanics
 
     void AiSequence::copy(const AiSequence& sequence)
     {
+        ++mRevision;
         for (const auto& package : sequence.mPackages)
             mPackages.push_back(package->clone());
 
@@ -70,6 +72,7 @@ namespace MWMechanics
 
     void AiSequence::onPackageAdded(const AiPackage& package)
     {
+        ++mRevision;
         if (package.getTypeId() == AiPackageTypeId::Combat)
             mNumCombatPackages++;
         else if (package.getTypeId() == AiPackageTypeId::Pursue)
@@ -81,6 +84,7 @@ namespace MWMechanics
 
     void AiSequence::onPackageRemoved(const AiPackage& package)
     {
+        ++mRevision;
         if (package.getTypeId() == AiPackageTypeId::Combat)
         {
             mNumCombatPackages--;
@@ -279,6 +283,8 @@ namespace MWMechanics
             osg::Vec3f vActorPos = actor.getRefData().getPosition().asVec3();
 
             float bestRating = 0.f;
+            // The same for all targets, made for the first target the actor can fight
+            std::optional<ActorActionRatings> actionRatings;
 
             for (auto it = mPackages.begin(); it != mPackages.end();)
             {
@@ -296,7 +302,11 @@ namespace MWMechanics
                 {
                     float rating = 0.f;
                     if (MWMechanics::canFight(actor, target))
-                        rating = MWMechanics::getBestActionRating(actor, target);
+                    {
+                        if (!actionRatings.has_value())
+                            actionRatings.emplace(actor);
+                        rating = MWMechanics::getBestActionRating(*actionRatings, actor, target);
+                    }
 
                     const ESM::Position& targetPos = target.getRefData().getPosition();
 
@@ -325,6 +335,7 @@ namespace MWMechanics
                 assert(itActualCombat != mPackages.end());
                 // move combat package with nearest target to the front
                 std::rotate(mPackages.begin(), itActualCombat, std::next(itActualCombat));
+                ++mRevision;
             }
 
             package = mPackages.front().get();
@@ -366,6 +377,7 @@ namespace MWMechanics
 
     void AiSequence::clear()
     {
+        ++mRevision;
         mPackages.clear();
         mNumCombatPackages = 0;
         mNumPursuitPackages = 0;
@@ -439,6 +451,7 @@ namespace MWMechanics
                 && package.getTypeId() == MWMechanics::AiPackageTypeId::Cast)
             {
                 *it = package.clone();
+                ++mRevision;
                 return;
             }
 
@@ -44,6 +44,8 @@ namespace MWMechanics
         int mNumCombatPackages{};
         int mNumPursuitPackages{};
 
+        unsigned mRevision{};
+
         /// Copy AiSequence
         void copy(const AiSequence& sequence);
 
@@ -72,6 +74,9 @@ namespace MWMechanics
         AiPackages::const_iterator begin() const { return mPackages.begin(); }
         AiPackages::const_iterator end() const { return mPackages.end(); }
 
+        /// Changes every time packages are added, removed or reordered
+        unsigned getRevision() const { return mRevision; }
+
         /// Removes all packages controlled by the predicate.
         template <typename F>
         void erasePackagesIf(const F&& pred)
@@ -632,23 +632,29 @@ namespace MWMechanics
         return groupName;
     }
 
-    void CharacterController::refreshMovementAnims(CharacterState movement, bool force)
+    const std::optional<CharacterController::MovementAnimation>& CharacterController::getMovementAnimation(
+        CharacterState movement)
     {
-        if (movement == mMovementState && !force)
-            return;
-
-        std::string_view movementAnimGroup = movementStateToAnimGroup(movement);
-
-        if (movementAnimGroup.empty())
+        if (mMovementAnimationsSource != mAnimation
+            || mMovementAnimationsRevision != mAnimation->getAnimSourcesRevision())
         {
-            if (!mCurrentMovement.empty())
-                resetCurrentIdleState();
-            resetCurrentMovementState();
-            return;
+            mMovementAnimations.clear();
+            mMovementAnimationsSource = mAnimation;
+            mMovementAnimationsRevision = mAnimation->getAnimSourcesRevision();
         }
-        std::string movementAnimName{ movementAnimGroup };
 
-        mMovementState = movement;
+        const bool spellTurning = mWeaponType == ESM::Weapon::Spell && isTurning();
+        const auto key = std::make_tuple(movement, mWeaponType, spellTurning);
+        auto it = mMovementAnimations.find(key);
+        if (it == mMovementAnimations.end())
+            it = mMovementAnimations.emplace(key, resolveMovementAnimation(movement, spellTurning)).first;
+        return it->second;
+    }
+
+    std::optional<CharacterController::MovementAnimation> CharacterController::resolveMovementAnimation(
+        CharacterState movement, bool spellTurning) const
+    {
+        std::string movementAnimName{ movementStateToAnimGroup(movement) };
         std::string::size_type swimpos = movementAnimName.find("swim");
         if (!mAnimation->hasAnimation(movementAnimName))
         {
@@ -671,7 +677,7 @@ namespace MWMechanics
         {
             std::string weapMovementAnimName;
             // Spellcasting stance turning is a special case
-            if (mWeaponType == ESM::Weapon::Spell && isTurning())
+            if (spellTurning)
             {
                 weapMovementAnimName = weapShortGroup;
                 weapMovementAnimName += movementAnimName;
@@ -695,14 +701,40 @@ namespace MWMechanics
                 movementAnimName.replace(runpos, 3, "walk");
 
             if (!mAnimation->hasAnimation(movementAnimName))
-            {
-                if (!mCurrentMovement.empty())
-                    resetCurrentIdleState();
-                resetCurrentMovementState();
-                return;
-            }
+                return std::nullopt;
         }
 
+        return MovementAnimation{ std::move(movementAnimName), movemask };
+    }
+
+    void CharacterController::refreshMovementAnims(CharacterState movement, bool force)
+    {
+        if (movement == mMovementState && !force)
+            return;
+
+        std::string_view movementAnimGroup = movementStateToAnimGroup(movement);
+
+        if (movementAnimGroup.empty())
+        {
+            if (!mCurrentMovement.empty())
+                resetCurrentIdleState();
+            resetCurrentMovementState();
+            return;
+        }
+        mMovementState = movement;
+
+        const std::optional<MovementAnimation>& movementAnimation = getMovementAnimation(movement);
+        if (!movementAnimation.has_value())
+        {
+            if (!mCurrentMovement.empty())
+                resetCurrentIdleState();
+            resetCurrentMovementState();
+            return;
+        }
+
+        std::string movementAnimName = movementAnimation->mGroup;
+        const MWRender::Animation::BlendMask movemask = movementAnimation->mBlendMask;
+
         // If we're playing the same animation, start it from the point it ended
         float startpoint = 0.f;
         if (!mCurrentMovement.empty() && movementAnimName == mCurrentMovement)
@@ -3007,6 +3039,11 @@ namespace MWMechanics
         mAnimation->setActive(active);
     }
 
+    void CharacterController::setAnimationUpdateInterval(unsigned int interval, unsigned int phase) const
+    {
+        mAnimation->setUpdateInterval(interval, phase);
+    }
+
     void CharacterController::setHeadTrackTarget(const MWWorld::ConstPtr& target)
     {
         mHeadTrackTarget = target;
@@ -2,6 +2,9 @@
 #define GAME_MWMECHANICS_CHARACTER_HPP
 
 #include <deque>
+#include <map>
+#include <optional>
+#include <tuple>
 
 #include <components/esm3/loadweap.hpp>
 
@@ -155,6 +158,18 @@ namespace MWMechanics
         bool mAdjustMovementAnimSpeed{ false };
         bool mMovementAnimationHasMovement{ false };
 
+        struct MovementAnimation
+        {
+            std::string mGroup;
+            MWRender::Animation::BlendMask mBlendMask;
+        };
+
+        // Movement animation groups resolved from movement state, weapon type and spellcasting stance turning. Empty
+        // when no group is available. Cleared when the animation sources change.
+        std::map<std::tuple<CharacterState, int, bool>, std::optional<MovementAnimation>> mMovementAnimations;
+        const MWRender::Animation* mMovementAnimationsSource{ nullptr };
+        std::size_t mMovementAnimationsRevision{ 0 };
+
         CharacterState mDeathState{ CharState_None };
         std::string mCurrentDeath;
         bool mFloatToSurface{ true };
@@ -211,6 +226,8 @@ namespace MWMechanics
         void refreshHitRecoilAnims();
         void refreshJumpAnims(JumpingState jump, bool force = false);
         void refreshMovementAnims(CharacterState movement, bool force = false);
+        const std::optional<MovementAnimation>& getMovementAnimation(CharacterState movement);
+        std::optional<MovementAnimation> resolveMovementAnimation(CharacterState movement, bool spellTurning) const;
         void refreshIdleAnims(CharacterState idle, bool force = false);
 
         bool updateWeaponState();
@@ -326,6 +343,9 @@ namespace MWMechanics
         /// @see Animation::setActive
         void setActive(int active) const;
 
+        /// @see Animation::setUpdateInterval
+        void setAnimationUpdateInterval(unsigned int interval, unsigned int phase) const;
+
         /// Make this character turn its head towards \a target. To turn off head tracking, pass an empty Ptr.
         void setHeadTrackTarget(const MWWorld::ConstPtr& target);
 
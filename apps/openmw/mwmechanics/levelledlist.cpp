@@ -1,9 +1,10 @@
+#include <algorithm>
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadlevlist.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
-#include "../mwworld/manualref.hpp"
 #include "../mwworld/ptr.hpp"
 
 #include "../mwbase/environment.hpp"
@@ -33,7 +34,6 @@ namespace MWMechanics
         if (Misc::Rng::roll0to99(prng) < levItem->mChanceNone)
             return ESM::RefId();
 
-        std::vector<const ESM::RefId*> candidates;
         int highestLevel = 0;
         for (const auto& levelledItem : items)
         {
@@ -46,36 +46,35 @@ namespace MWMechanics
         if (creature)
             allLevels = levItem->mFlags & ESM::CreatureLevList::AllLevels;
 
-        for (const auto& levelledItem : items)
-        {
-            if (playerLevel >= levelledItem.mLevel && (allLevels || levelledItem.mLevel == highestLevel))
-                candidates.push_back(&levelledItem.mId);
-        }
-        if (candidates.empty())
-            return ESM::RefId();
-        const ESM::RefId& item = *candidates[Misc::Rng::rollDice(candidates.size(), prng)];
+        const auto isCandidate = [&](const ESM::LevelledListBase::LevelItem& levelledItem) {
+            return playerLevel >= levelledItem.mLevel && (allLevels || levelledItem.mLevel == highestLevel);
+        };
 
-        // Vanilla doesn't fail on nonexistent items in levelled lists
-        if (!MWBase::Environment::get().getESMStore()->find(item))
-        {
-            Log(Debug::Warning) << "Warning: ignoring nonexistent item " << item << " in levelled list "
-                                << levItem->mId;
+        const int candidatesCount = static_cast<int>(std::count_if(items.begin(), items.end(), isCandidate));
+        if (candidatesCount == 0)
             return ESM::RefId();
-        }
+        int candidate = Misc::Rng::rollDice(candidatesCount, prng);
+        const auto selected = std::find_if(items.begin(), items.end(),
+            [&](const ESM::LevelledListBase::LevelItem& levelledItem) {
+                return isCandidate(levelledItem) && candidate-- == 0;
+            });
+        const ESM::RefId& item = selected->mId;
 
-        // Is this another levelled item or a real item?
-        MWWorld::ManualRef ref(*MWBase::Environment::get().getESMStore(), item, 1);
-        if (ref.getPtr().getType() != ESM::ItemLevList::sRecordId
-            && ref.getPtr().getType() != ESM::CreatureLevList::sRecordId)
-        {
-            return item;
-        }
-        else
+        // Vanilla doesn't fail on nonexistent items in levelled lists
+        const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+        switch (store.find(item))
         {
-            if (ref.getPtr().getType() == ESM::ItemLevList::sRecordId)
-                return getLevelledItem(ref.getPtr().get<ESM::ItemLevList>()->mBase, false, prng, level);
-            else
-                return getLevelledItem(ref.getPtr().get<ESM::CreatureLevList>()->mBase, true, prng, level);
+            case 0:
+                Log(Debug::Warning) << "Warning: ignoring nonexistent item " << item << " in levelled list "
+                                    << levItem->mId;
+                return ESM::RefId();
+            // Is this another levelled item or a real item?
+            case ESM::ItemLevList::sRecordId:
+                return getLevelledItem(store.get<ESM::ItemLevList>().find(item), false, prng, level);
+            case ESM::CreatureLevList::sRecordId:
+                return getLevelledItem(store.get<ESM::CreatureLevList>().find(item), true, prng, level);
+            default:
+                return item;
         }
     }
 }
@@ -1,6 +1,7 @@
 #include "magiceffects.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <stdexcept>
 
 #include <components/esm/attr.hpp>
@@ -21,6 +22,11 @@ namespace
     {
         value = static_cast<int>(value * 1024.f) / 1024.f;
     }
+
+    bool hasNoArg(const MWMechanics::EffectKey& key)
+    {
+        return key.mArg.empty() && key.mId >= 0;
+    }
 }
 
 namespace MWMechanics
@@ -121,9 +127,28 @@ namespace MWMechanics
         return *this;
     }
 
+    void MagicEffects::updateWithoutArg(const EffectKey& key, const EffectParam& param)
+    {
+        if (!hasNoArg(key))
+            return;
+        const std::size_t index = static_cast<std::size_t>(key.mId);
+        if (index >= mWithoutArg.size())
+            mWithoutArg.resize(index + 1);
+        mWithoutArg[index] = param;
+    }
+
+    void MagicEffects::rebuildWithoutArg()
+    {
+        mWithoutArg.clear();
+        for (const auto& [key, param] : mCollection)
+            updateWithoutArg(key, param);
+    }
+
     void MagicEffects::remove(const EffectKey& key)
     {
         mCollection.erase(key);
+        if (hasNoArg(key) && static_cast<std::size_t>(key.mId) < mWithoutArg.size())
+            mWithoutArg[key.mId].reset();
     }
 
     void MagicEffects::add(const EffectKey& key, const EffectParam& param)
@@ -132,17 +157,20 @@ namespace MWMechanics
 
         if (iter == mCollection.end())
         {
-            mCollection.insert(std::make_pair(key, param));
+            iter = mCollection.insert(std::make_pair(key, param)).first;
         }
         else
         {
             iter->second += param;
         }
+        updateWithoutArg(key, iter->second);
     }
 
     void MagicEffects::modifyBase(const EffectKey& key, int diff)
     {
-        mCollection[key].modifyBase(diff);
+        EffectParam& param = mCollection[key];
+        param.modifyBase(diff);
+        updateWithoutArg(key, param);
     }
 
     void MagicEffects::setModifiers(const MagicEffects& effects)
@@ -156,6 +184,8 @@ namespace MWMechanics
         {
             mCollection[it->first].setModifier(it->second.getModifier());
         }
+
+        rebuildWithoutArg();
     }
 
     EffectParam MagicEffects::getOrDefault(const EffectKey& key) const
@@ -165,6 +195,14 @@ namespace MWMechanics
 
     std::optional<EffectParam> MagicEffects::get(const EffectKey& key) const
     {
+        if (hasNoArg(key))
+        {
+            const std::size_t index = static_cast<std::size_t>(key.mId);
+            if (index < mWithoutArg.size())
+                return mWithoutArg[index];
+            return std::nullopt;
+        }
+
         Collection::const_iterator iter = mCollection.find(key);
 
         if (iter != mCollection.end())
@@ -227,6 +265,7 @@ namespace MWMechanics
             mCollection[EffectKey(key)].setBase(params.first);
             mCollection[EffectKey(key)].setModifier(params.second);
         }
+        rebuildWithoutArg();
     }
 
     std::string getMagicEffectString(
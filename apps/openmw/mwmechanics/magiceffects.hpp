@@ -4,6 +4,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <components/esm/refid.hpp>
 
@@ -94,6 +95,14 @@ namespace MWMechanics
     private:
         Collection mCollection;
 
+        // Copies of mCollection values for the keys without argument indexed by effect id. Most lookups are done by
+        // effect id only, so they don't have to search the map.
+        std::vector<std::optional<EffectParam>> mWithoutArg;
+
+        void updateWithoutArg(const EffectKey& key, const EffectParam& param);
+
+        void rebuildWithoutArg();
+
     public:
         Collection::const_iterator begin() const { return mCollection.begin(); }
 
@@ -287,6 +287,12 @@ namespace MWMechanics
             mObjects.updateObject(old, ptr);
     }
 
+    void MechanicsManager::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        if (ptr.getClass().isActor())
+            mActors.updateActorPosition(ptr);
+    }
+
     void MechanicsManager::drop(const MWWorld::CellStore* cellStore)
     {
         mActors.dropActors(cellStore, getPlayer());
@@ -389,9 +395,9 @@ namespace MWMechanics
         mActors.rest(hours, sleep);
     }
 
-    void MechanicsManager::restoreDynamicStats(const MWWorld::Ptr& actor, double hours, bool sleep)
+    void MechanicsManager::restoreDynamicStats(std::span<const MWWorld::Ptr> actors, double hours, bool sleep)
     {
-        mActors.restoreDynamicStats(actor, hours, sleep);
+        mActors.restoreDynamicStats(actors, hours, sleep);
     }
 
     int MechanicsManager::getHoursToRest() const
@@ -2031,6 +2037,10 @@ namespace MWMechanics
     {
         stats.setAttribute(frameNumber, "Mechanics Actors", mActors.size());
         stats.setAttribute(frameNumber, "Mechanics Objects", mObjects.size());
+        const Actors::AiUpdateStats& aiUpdateStats = mActors.getAiUpdateStats();
+        stats.setAttribute(frameNumber, "Mechanics AI FullRate", aiUpdateStats.mFullRate);
+        stats.setAttribute(frameNumber, "Mechanics AI ReducedRate", aiUpdateStats.mReducedRate);
+        stats.setAttribute(frameNumber, "Mechanics AI LowRate", aiUpdateStats.mLowRate);
     }
 
     int MechanicsManager::getGreetingTimer(const MWWorld::Ptr& ptr) const
@@ -54,6 +54,9 @@ namespace MWMechanics
         void updateCell(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) override;
         ///< Moves an object to a new cell
 
+        void updatePosition(const MWWorld::Ptr& ptr) override;
+        ///< Notify about a changed position of an object
+
         void drop(const MWWorld::CellStore* cellStore) override;
         ///< Deregister all objects in the given cell.
 
@@ -78,7 +81,7 @@ namespace MWMechanics
         void setPlayerClass(const ESM::Class& class_) override;
         ///< Set player class to custom class.
 
-        void restoreDynamicStats(const MWWorld::Ptr& actor, double hours, bool sleep) override;
+        void restoreDynamicStats(std::span<const MWWorld::Ptr> actors, double hours, bool sleep) override;
 
         void rest(double hours, bool sleep) override;
         ///< If the player is sleeping or waiting, this should be called every hour.
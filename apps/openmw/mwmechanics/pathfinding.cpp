@@ -10,6 +10,9 @@
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/misc/coordinateconverter.hpp>
 #include <components/misc/math.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -65,6 +68,19 @@ namespace
         return std::pair<int, bool>(closestReachableIndex, closestReachableIndex == closestIndex);
     }
 
+    // Path search is limited to the area covered by the navmesh around the actor
+    osg::Vec3f getLimitedPathEnd(
+        const DetourNavigator::Navigator& navigator, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
+    {
+        const float maxDistance
+            = std::min(navigator.getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
+        const osg::Vec3f startToEnd = endPoint - startPoint;
+        const float distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
     float sqrDistance(const osg::Vec2f& lhs, const osg::Vec2f& rhs)
     {
         return (lhs - rhs).length2();
@@ -450,20 +466,60 @@ namespace MWMechanics
         return status;
     }
 
+    bool PathFinder::buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        if (actor.getClass().isPureWaterCreature(actor) || actor.getClass().isPureFlyingCreature(actor))
+            return false;
+
+        SceneUtil::WorkQueue* const workQueue
+            = MWBase::Environment::get().getResourceSystem()->getSceneManager()->getWorkQueue();
+        if (workQueue == nullptr)
+            return false;
+
+        if (mPathQuery != nullptr)
+        {
+            if (!mPathQuery->isDone())
+                return true;
+
+            osg::ref_ptr<DetourNavigator::FindPathItem> query;
+            query.swap(mPathQuery);
+            DetourNavigator::Status status = query->getStatus();
+            if (pathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
+                status = DetourNavigator::Status::Success;
+            // The synchronous search also tries the pathgrid and reports the error
+            if (status != DetourNavigator::Status::Success)
+                return false;
+
+            // Otherwise the destination has moved meanwhile, search again
+            if (mPathQueryCell == cell && (mPathQueryDestination - endPoint).length2() <= 10 * 10)
+            {
+                const std::vector<osg::Vec3f>& path = query->getPath();
+                mPath.assign(path.begin(), path.end());
+                mCell = cell;
+                mConstructed = !mPath.empty();
+                return true;
+            }
+        }
+
+        const DetourNavigator::Navigator& navigator = *MWBase::Environment::get().getWorld()->getNavigator();
+        const osg::Vec3f end = getLimitedPathEnd(navigator, startPoint, endPoint);
+        mPathQuery = DetourNavigator::findPathAsync(
+            navigator, *workQueue, agentBounds, startPoint, end, flags, areaCosts, endTolerance);
+        mPathQueryDestination = endPoint;
+        mPathQueryCell = cell;
+        return true;
+    }
+
     void PathFinder::buildLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
         const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance
-            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
-                endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
+        const auto end = getLimitedPathEnd(*navigator, startPoint, endPoint);
         buildPath(actor, startPoint, end, cell, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
     }
 }
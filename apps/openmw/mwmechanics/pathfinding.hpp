@@ -6,6 +6,7 @@
 #include <iterator>
 
 #include <components/detournavigator/areatype.hpp>
+#include <components/detournavigator/findpathasync.hpp>
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/status.hpp>
 #include <components/esm/position.hpp>
@@ -98,6 +99,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mPathQuery = nullptr;
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -120,6 +122,15 @@ namespace MWMechanics
             const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
             const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
 
+        /// Like buildLimitedPath but searches for the path over the navmesh in a worker thread. The current path is
+        /// kept until a later call finds the search for about the same destination done and takes its path.
+        /// @return false if the path can't be built this way now, either because the actor doesn't use the navmesh
+        /// or the search failed, then buildLimitedPath should be used instead
+        bool buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const DetourNavigator::AgentBounds& agentBounds,
+            const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+            PathType pathType);
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             UpdateFlags updateFlags, const DetourNavigator::AgentBounds& agentBounds, DetourNavigator::Flags pathFlags);
@@ -204,6 +215,9 @@ namespace MWMechanics
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        osg::ref_ptr<DetourNavigator::FindPathItem> mPathQuery;
+        osg::Vec3f mPathQueryDestination;
+        const MWWorld::CellStore* mPathQueryCell = nullptr;
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
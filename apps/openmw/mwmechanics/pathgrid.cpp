@@ -1,8 +1,10 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
 
 namespace
 {
@@ -45,6 +47,14 @@ namespace
     }
 
     constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+    constexpr std::uint8_t NoNextHop = std::numeric_limits<std::uint8_t>::max();
+
+    static_assert(MWMechanics::PathgridGraph::sMaxNextHopTablePoints <= NoNextHop);
+
+    // Lowest cost at the top
+    using OpenSet = std::priority_queue<std::pair<float, size_t>, std::vector<std::pair<float, size_t>>,
+        std::greater<std::pair<float, size_t>>>;
 }
 
 namespace MWMechanics
@@ -188,6 +198,72 @@ namespace MWMechanics
             // mGraph[edge.mV1].edges.push_back(neighbour);
         }
         Builder(*this);
+        if (mGraph.size() <= sMaxNextHopTablePoints)
+            buildNextHopTable();
+    }
+
+    /*
+     * For each goal point runs Dijkstra's algorithm over reversed edges. When a point is reached through an edge
+     * the other end of the edge is the next point on the shortest path from this point to the goal.
+     */
+    void PathgridGraph::buildNextHopTable()
+    {
+        const size_t graphSize = mGraph.size();
+
+        std::vector<std::vector<ConnectedPoint>> reversed(graphSize);
+        for (size_t v = 0; v < graphSize; ++v)
+            for (const auto& edge : mGraph[v].edges)
+                reversed[edge.index].push_back(ConnectedPoint{ v, edge.cost });
+
+        mNextHop.assign(graphSize * graphSize, NoNextHop);
+        std::vector<float> cost(graphSize);
+
+        for (size_t goal = 0; goal < graphSize; ++goal)
+        {
+            std::fill(cost.begin(), cost.end(), std::numeric_limits<float>::max());
+            cost[goal] = 0;
+            mNextHop[goal * graphSize + goal] = static_cast<std::uint8_t>(goal);
+
+            OpenSet openset;
+            openset.emplace(0.0f, goal);
+
+            while (!openset.empty())
+            {
+                const auto [currentCost, current] = openset.top();
+                openset.pop();
+
+                if (currentCost > cost[current])
+                    continue;
+
+                for (const auto& edge : reversed[current])
+                {
+                    const float tentative = currentCost + edge.cost;
+                    if (tentative < cost[edge.index])
+                    {
+                        cost[edge.index] = tentative;
+                        mNextHop[edge.index * graphSize + goal] = static_cast<std::uint8_t>(current);
+                        openset.emplace(tentative, edge.index);
+                    }
+                }
+            }
+        }
+    }
+
+    std::deque<ESM::Pathgrid::Point> PathgridGraph::getPathByNextHops(const size_t start, const size_t goal) const
+    {
+        const size_t graphSize = mGraph.size();
+        std::deque<ESM::Pathgrid::Point> path;
+        size_t current = start;
+        path.push_back(mPathgrid->mPoints[current]);
+        while (current != goal)
+        {
+            const std::uint8_t next = mNextHop[current * graphSize + goal];
+            if (next == NoNextHop)
+                return {};
+            current = next;
+            path.push_back(mPathgrid->mPoints[current]);
+        }
+        return path;
     }
 
     const PathgridGraph PathgridGraph::sEmpty = {};
@@ -222,16 +298,14 @@ namespace MWMechanics
      * Input params:
      *   start, goal - pathgrid point indexes (for this cell)
      *
+     * Small pathgrids have a precomputed table of next points of the shortest
+     * paths, for them the path is built from the table without searching.
+     *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
+     *   openset - point indexes to be traversed with their estimated costs,
+     *             lowest cost at the top, may have outdated entries
      *   closedset - point indexes already traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
-     *
-     * TODO: An interesting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
      */
     std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
     {
@@ -241,59 +315,48 @@ namespace MWMechanics
             return path; // there is no path, return an empty path
         }
 
+        if (hasNextHopTable())
+            return getPathByNextHops(start, goal);
+
         size_t graphSize = mGraph.size();
-        std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
+        std::vector<float> gScore(graphSize, std::numeric_limits<float>::max());
         std::vector<size_t> graphParent(graphSize, NoIndex);
+        std::vector<bool> closedset(graphSize, false);
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
         gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
 
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        OpenSet openset;
+        openset.emplace(costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), start);
 
         size_t current = start;
 
         while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            current = openset.top().second;
+            openset.pop();
 
             if (current == goal)
                 break;
 
-            closedset.insert(current); // remember we've been here
+            if (closedset[current])
+                continue; // outdated entry, the point was traversed with lower cost
+
+            closedset[current] = true; // remember we've been here
 
             // check all edges for the current point index
             for (const auto& edge : mGraph[current].edges)
             {
-                if (!closedset.contains(edge.index))
+                if (closedset[edge.index])
+                    continue; // traversed this edge destination already, try the next edge
+                const size_t dest = edge.index;
+                const float tentativeG = gScore[current] + edge.cost;
+                if (tentativeG < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentative_g = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentative_g < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentative_g;
-                        fScore[dest] = tentative_g + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentativeG;
+                    openset.emplace(
+                        tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]), dest);
+                }
             }
         }
 
@@ -1,7 +1,9 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -33,13 +35,23 @@ namespace MWMechanics
         // NOTE: if start equals end an empty path is returned
         std::deque<ESM::Pathgrid::Point> aStarSearch(const size_t start, const size_t end) const;
 
+        bool hasNextHopTable() const { return !mNextHop.empty(); }
+
         static const PathgridGraph sEmpty;
 
+        // Pathgrids with up to this number of points get a table of next points of the shortest paths between
+        // all pairs of points
+        static constexpr std::size_t sMaxNextHopTablePoints = 128;
+
     private:
         const ESM::Pathgrid* mPathgrid;
 
         class Builder;
 
+        void buildNextHopTable();
+
+        std::deque<ESM::Pathgrid::Point> getPathByNextHops(const size_t start, const size_t goal) const;
+
         struct ConnectedPoint // edge
         {
             size_t index; // pathgrid point index of neighbour
@@ -62,6 +74,9 @@ namespace MWMechanics
         //   all other pathgrid points are the third set
         //
         std::vector<Node> mGraph;
+
+        // Next point index on the shortest path from point "from" to point "to" stored at from * size + to
+        std::vector<std::uint8_t> mNextHop;
     };
 }
 
@@ -1030,8 +1030,10 @@ namespace MWMechanics
                 applyMagicEffect(target, caster, spellParams, effect, invalid, receivedMagicDamage, affectedHealth,
                     recalculateMagicka);
             effect.mMagnitude = magnitude;
-            magnitudes.add(EffectKey(effect.mEffectId, effect.getSkillOrAttribute()),
-                EffectParam(effect.mMagnitude - oldMagnitude));
+            // Unchanged magnitudes of lasting effects don't need to touch the collection
+            if (effect.mMagnitude != oldMagnitude || !(effect.mFlags & ESM::ActiveEffect::Flag_Applied))
+                magnitudes.add(EffectKey(effect.mEffectId, effect.getSkillOrAttribute()),
+                    EffectParam(effect.mMagnitude - oldMagnitude));
         }
         effect.mTimeLeft -= dt;
         if (invalid)
@@ -131,14 +131,11 @@ namespace MWMechanics
         return rateEffects(potion->mEffects, actor, MWWorld::Ptr());
     }
 
-    float rateSpell(const ESM::Spell* spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool checkMagicka)
+    std::optional<CasterSpellRating> rateSpellForCaster(
+        const ESM::Spell* spell, const MWWorld::Ptr& actor, bool checkMagicka)
     {
-        float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
-        if (successChance == 0.f)
-            return 0.f;
-
         if (spell->mData.mType != ESM::Spell::ST_Spell)
-            return 0.f;
+            return std::nullopt;
 
         // Don't make use of racial bonus spells, like MW. Can be made optional later
         if (actor.getClass().isNpc())
@@ -146,17 +143,37 @@ namespace MWMechanics
             const ESM::RefId& raceid = actor.get<ESM::NPC>()->mBase->mRace;
             const ESM::Race* race = MWBase::Environment::get().getESMStore()->get<ESM::Race>().find(raceid);
             if (race->mPowers.exists(spell->mId))
-                return 0.f;
+                return std::nullopt;
         }
 
-        // Spells don't stack, so early out if the spell is still active on the target
-        int types = getRangeTypes(spell->mEffects);
+        // Spells don't stack, so early out if the spell is still active on the caster
+        const int types = getRangeTypes(spell->mEffects);
         if ((types & Self) && isSpellActive(actor, actor, spell->mId))
-            return 0.f;
-        if (((types & Touch) || (types & Target)) && !enemy.isEmpty() && isSpellActive(actor, enemy, spell->mId))
+            return std::nullopt;
+
+        const float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
+        if (successChance == 0.f)
+            return std::nullopt;
+
+        return CasterSpellRating{ spell, successChance, types };
+    }
+
+    float rateSpell(const CasterSpellRating& spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
+    {
+        // Spells don't stack, so early out if the spell is still active on the target
+        if ((spell.mRangeTypes & (Touch | Target)) && !enemy.isEmpty()
+            && isSpellActive(actor, enemy, spell.mSpell->mId))
             return 0.f;
 
-        return rateEffects(spell->mEffects, actor, enemy) * (successChance / 100.f);
+        return rateEffects(spell.mSpell->mEffects, actor, enemy) * (spell.mSuccessChance / 100.f);
+    }
+
+    float rateSpell(const ESM::Spell* spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool checkMagicka)
+    {
+        const std::optional<CasterSpellRating> rating = rateSpellForCaster(spell, actor, checkMagicka);
+        if (!rating.has_value())
+            return 0.f;
+        return rateSpell(*rating, actor, enemy);
     }
 
     float rateMagicItem(const MWWorld::Ptr& ptr, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy)
@@ -1,6 +1,8 @@
 #ifndef OPENMW_SPELL_PRIORITY_H
 #define OPENMW_SPELL_PRIORITY_H
 
+#include <optional>
+
 namespace ESM
 {
     struct Spell;
@@ -25,6 +27,19 @@ namespace MWMechanics
 
     int getRangeTypes(const ESM::EffectList& effects);
 
+    /// The part of a spell rating which depends only on the caster
+    struct CasterSpellRating
+    {
+        const ESM::Spell* mSpell;
+        float mSuccessChance;
+        int mRangeTypes;
+    };
+
+    /// @return nullopt if the caster can not make use of the spell against any enemy
+    std::optional<CasterSpellRating> rateSpellForCaster(
+        const ESM::Spell* spell, const MWWorld::Ptr& actor, bool checkMagicka = true);
+    /// @note Gives the same rating as rateSpell as long as the caster doesn't change
+    float rateSpell(const CasterSpellRating& spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
     float rateSpell(
         const ESM::Spell* spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool checkMagicka = true);
     float rateMagicItem(const MWWorld::Ptr& ptr, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
@@ -24,8 +24,9 @@ namespace MWMechanics
         if (absDiff < epsilonRadians)
             return true;
 
-        float limit
-            = getAngularVelocity(actor.getClass().getMaxSpeed(actor)) * MWBase::Environment::get().getFrameDuration();
+        // AI turns actors only in simulation ticks, each turn covers the whole tick
+        float limit = getAngularVelocity(actor.getClass().getMaxSpeed(actor))
+            * MWBase::Environment::get().getSimulationTickDuration();
         if (Settings::game().mSmoothMovement)
             limit *= std::min(absDiff / osg::PI + 0.1, 0.5);
 
@@ -113,8 +113,15 @@ namespace MWPhysics
     }
 
     Actor::~Actor()
+    {
+        if (mTaskScheduler != nullptr)
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+    }
+
+    void Actor::removeFromWorld()
     {
         mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        mTaskScheduler = nullptr;
     }
 
     void Actor::enableCollisionMode(bool collision)
@@ -161,6 +168,7 @@ namespace MWPhysics
         mPositionOffset = osg::Vec3f();
         mStandingOnPtr = nullptr;
         mSkipSimulation = true;
+        mSettled = false;
     }
 
     void Actor::setSimulationPosition(const osg::Vec3f& position)
@@ -213,6 +221,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         mPositionOffset += offset;
+        mSettled = false;
     }
 
     osg::Vec3f Actor::applyOffsetChange()
@@ -227,6 +236,16 @@ namespace MWPhysics
         return mPosition;
     }
 
+    void Actor::setLodInterval(unsigned interval, unsigned phase)
+    {
+        // Keep the pending steps when going back to full rate, the next move covers them
+        if (interval > 1)
+            mLodPendingSteps = phase % interval;
+        else if (interval == 0)
+            mLodPendingSteps = 0;
+        mLodInterval = interval;
+    }
+
     void Actor::setRotation(osg::Quat quat)
     {
         std::scoped_lock lock(mPositionMutex);
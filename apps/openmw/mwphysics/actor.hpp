@@ -31,6 +31,9 @@ namespace MWPhysics
             bool canWaterWalk, DetourNavigator::CollisionShapeType collisionShapeType);
         ~Actor() override;
 
+        /// Removes the collision object from the world, so the rest can be destroyed on any thread
+        void removeFromWorld();
+
         Actor(const Actor&) = delete;
 
         Actor& operator=(const Actor&) = delete;
@@ -140,6 +143,20 @@ namespace MWPhysics
         const osg::Vec3f& getLastStuckPosition() const { return mLastStuckPosition; }
         void setLastStuckPosition(osg::Vec3f position) { mLastStuckPosition = position; }
 
+        /// Number of simulation steps between two moves of the actor, 0 when it is not moved at all
+        unsigned getLodInterval() const { return mLodInterval; }
+
+        /// @param phase spreads the moves of actors with the same interval over different steps
+        void setLodInterval(unsigned interval, unsigned phase);
+
+        /// Simulation steps skipped since the last move, the next move covers all of them
+        unsigned getLodPendingSteps() const { return mLodPendingSteps; }
+        void setLodPendingSteps(unsigned steps) { mLodPendingSteps = steps; }
+
+        /// Whether the last move left the actor resting on the ground and it wasn't moved by anything else since
+        bool isSettled() const { return mSettled; }
+        void setSettled(bool value) { mSettled = value; }
+
         bool canMoveToWaterSurface(float waterlevel, const btCollisionWorld* world) const;
 
         bool isActive() const { return mActive; }
@@ -182,6 +199,10 @@ namespace MWPhysics
         unsigned int mStuckFrames;
         osg::Vec3f mLastStuckPosition;
 
+        unsigned mLodInterval = 1;
+        unsigned mLodPendingSteps = 0;
+        bool mSettled = false;
+
         osg::Vec3f mForce;
         bool mOnGround;
         bool mOnSlope;
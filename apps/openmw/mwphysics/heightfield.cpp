@@ -3,13 +3,12 @@
 
 #include <components/bullethelpers/heightfield.hpp>
 
-#include <osg/Object>
-
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
 
 #include <LinearMath/btTransform.h>
 
+#include <stdexcept>
 #include <type_traits>
 
 #if BT_BULLET_VERSION < 310
@@ -52,13 +51,17 @@ namespace
 
 namespace MWPhysics
 {
-    HeightField::HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-        const osg::Object* holdObject, PhysicsTaskScheduler* scheduler)
-        : mHoldObject(holdObject)
+    HeightFieldShape::HeightFieldShape() = default;
+
+    HeightFieldShape::HeightFieldShape(const float* heights, int size, int verts, float minH, float maxH,
+        osg::ref_ptr<const osg::Object> holdObject)
+        : mSize(size)
+        , mMinHeight(minH)
+        , mMaxHeight(maxH)
+        , mHoldObject(std::move(holdObject))
 #if BT_BULLET_VERSION < 310
         , mHeights(makeHeights(heights, verts))
 #endif
-        , mTaskScheduler(scheduler)
     {
 #if BT_BULLET_VERSION < 310
         mShape = std::make_unique<btHeightfieldTerrainShape>(
@@ -79,20 +82,41 @@ namespace MWPhysics
         // https://github.com/bulletphysics/bullet3/issues/3276
         mShape->buildAccelerator();
 #endif
+    }
+
+    HeightFieldShape::HeightFieldShape(const HeightFieldShape& /*copy*/, const osg::CopyOp& /*copyOp*/)
+    {
+        throw std::logic_error("HeightFieldShape copy constructor is not implemented");
+    }
 
-        const btTransform transform(
-            btQuaternion::getIdentity(), BulletHelpers::getHeightfieldShift(x, y, size, minH, maxH));
+    HeightFieldShape::~HeightFieldShape() = default;
+
+    HeightField::HeightField(osg::ref_ptr<const HeightFieldShape> shape, int x, int y, PhysicsTaskScheduler* scheduler)
+        : mShape(std::move(shape))
+        , mTaskScheduler(scheduler)
+    {
+        const btTransform transform(btQuaternion::getIdentity(),
+            BulletHelpers::getHeightfieldShift(
+                x, y, mShape->getSize(), mShape->getMinHeight(), mShape->getMaxHeight()));
 
         mCollisionObject = std::make_unique<btCollisionObject>();
-        mCollisionObject->setCollisionShape(mShape.get());
+        // The shape isn't modified by collision tests, only Bullet's interface isn't const correct
+        mCollisionObject->setCollisionShape(const_cast<btHeightfieldTerrainShape*>(mShape->getShape()));
         mCollisionObject->setWorldTransform(transform);
         mTaskScheduler->addCollisionObject(
             mCollisionObject.get(), CollisionType_HeightMap, CollisionType_Actor | CollisionType_Projectile);
     }
 
     HeightField::~HeightField()
+    {
+        if (mTaskScheduler != nullptr)
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+    }
+
+    void HeightField::removeFromWorld()
     {
         mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        mTaskScheduler = nullptr;
     }
 
     btCollisionObject* HeightField::getCollisionObject()
@@ -107,6 +131,6 @@ namespace MWPhysics
 
     const btHeightfieldTerrainShape* HeightField::getShape() const
     {
-        return mShape.get();
+        return mShape->getShape();
     }
 }
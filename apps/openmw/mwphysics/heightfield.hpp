@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWPHYSICS_HEIGHTFIELD_H
 #define OPENMW_MWPHYSICS_HEIGHTFIELD_H
 
+#include <osg/Object>
 #include <osg/ref_ptr>
 
 #include <LinearMath/btScalar.h>
@@ -11,33 +12,62 @@
 class btCollisionObject;
 class btHeightfieldTerrainShape;
 
-namespace osg
-{
-    class Object;
-}
-
 namespace MWPhysics
 {
     class PhysicsTaskScheduler;
 
+    /// @brief Collision shape of the terrain of a cell, referencing the heights of the land object it's built from.
+    /// @par Immutable once constructed, so it can be built by a worker thread and shared with the collision world.
+    class HeightFieldShape : public osg::Object
+    {
+    public:
+        HeightFieldShape();
+
+        HeightFieldShape(const float* heights, int size, int verts, float minH, float maxH,
+            osg::ref_ptr<const osg::Object> holdObject);
+
+        META_Object(MWPhysics, HeightFieldShape)
+
+        const btHeightfieldTerrainShape* getShape() const { return mShape.get(); }
+
+        int getSize() const { return mSize; }
+
+        float getMinHeight() const { return mMinHeight; }
+
+        float getMaxHeight() const { return mMaxHeight; }
+
+    protected:
+        ~HeightFieldShape();
+
+    private:
+        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        int mSize = 0;
+        float mMinHeight = 0;
+        float mMaxHeight = 0;
+        osg::ref_ptr<const osg::Object> mHoldObject;
+#if BT_BULLET_VERSION < 310
+        std::vector<btScalar> mHeights;
+#endif
+
+        HeightFieldShape(const HeightFieldShape& copy, const osg::CopyOp& copyOp);
+    };
+
     class HeightField
     {
     public:
-        HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-            const osg::Object* holdObject, PhysicsTaskScheduler* scheduler);
+        HeightField(osg::ref_ptr<const HeightFieldShape> shape, int x, int y, PhysicsTaskScheduler* scheduler);
         ~HeightField();
 
+        /// Removes the collision object from the world, so the rest can be destroyed on any thread
+        void removeFromWorld();
+
         btCollisionObject* getCollisionObject();
         const btCollisionObject* getCollisionObject() const;
         const btHeightfieldTerrainShape* getShape() const;
 
     private:
-        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        osg::ref_ptr<const HeightFieldShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
-        osg::ref_ptr<const osg::Object> mHoldObject;
-#if BT_BULLET_VERSION < 310
-        std::vector<btScalar> mHeights;
-#endif
 
         PhysicsTaskScheduler* mTaskScheduler;
 
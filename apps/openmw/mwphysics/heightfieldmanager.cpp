@@ -0,0 +1,39 @@
+#include "heightfieldmanager.hpp"
+
+#include "heightfield.hpp"
+
+#include <components/esm/util.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esmterrain/storage.hpp>
+#include <components/resource/objectcache.hpp>
+
+namespace MWPhysics
+{
+    HeightFieldManager::HeightFieldManager(double expiryDelay)
+        : GenericResourceManager<ESM::ExteriorCellLocation>(nullptr, expiryDelay)
+        , mDefaultHeights(ESM::Land::LAND_SIZE * ESM::Land::LAND_SIZE, ESM::Land::DEFAULT_HEIGHT)
+    {
+    }
+
+    osg::ref_ptr<const HeightFieldShape> HeightFieldManager::getShape(
+        const ESM::ExteriorCellLocation& cellIndex, const ESMTerrain::LandObject* land)
+    {
+        if (const std::optional<osg::ref_ptr<osg::Object>> obj = mCache->getRefFromObjectCacheOrNone(cellIndex))
+            return static_cast<HeightFieldShape*>(obj->get());
+
+        const ESM::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
+        const int verts = ESM::getLandSize(cellIndex.mWorldspace);
+        const int worldsize = ESM::getCellSize(cellIndex.mWorldspace);
+
+        osg::ref_ptr<HeightFieldShape> shape;
+        if (data != nullptr)
+            shape = new HeightFieldShape(
+                data->getHeights().data(), worldsize, verts, data->getMinHeight(), data->getMaxHeight(), land);
+        else if (!ESM::isEsm4Ext(cellIndex.mWorldspace))
+            shape = new HeightFieldShape(mDefaultHeights.data(), worldsize, verts, ESM::Land::DEFAULT_HEIGHT,
+                ESM::Land::DEFAULT_HEIGHT, nullptr);
+
+        mCache->addEntryToObjectCache(cellIndex, shape.get());
+        return shape;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef OPENMW_MWPHYSICS_HEIGHTFIELDMANAGER_H
+#define OPENMW_MWPHYSICS_HEIGHTFIELDMANAGER_H
+
+#include <components/esm/exteriorcelllocation.hpp>
+#include <components/resource/resourcemanager.hpp>
+
+#include <osg/ref_ptr>
+
+#include <vector>
+
+namespace ESMTerrain
+{
+    class LandObject;
+}
+
+namespace MWPhysics
+{
+    class HeightFieldShape;
+
+    /// @brief Caches the terrain collision shapes of exterior cells, so they can be built by the cell preloader
+    /// and attaching one to the collision world when the cell is loaded takes no more than an insertion.
+    class HeightFieldManager : public Resource::GenericResourceManager<ESM::ExteriorCellLocation>
+    {
+    public:
+        explicit HeightFieldManager(double expiryDelay);
+
+        /// @param land land of the cell, the shape references its heights
+        /// @return nullptr if the cell has no terrain collision
+        /// @note Thread safe.
+        osg::ref_ptr<const HeightFieldShape> getShape(
+            const ESM::ExteriorCellLocation& cellIndex, const ESMTerrain::LandObject* land);
+
+    private:
+        const std::vector<float> mDefaultHeights;
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
+#include <string>
 #include <variant>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -15,8 +16,9 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/tracing.hpp"
 #include "components/misc/convert.hpp"
-#include <components/misc/barrier.hpp>
+#include <components/misc/workstealingrange.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -30,6 +32,7 @@
 #include "../mwbase/world.hpp"
 
 #include "actor.hpp"
+#include "closestnotmerayresultcallback.hpp"
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
@@ -191,6 +194,7 @@ namespace
                 frameData.mInertia = actor->getInertialForce();
                 frameData.mStuckFrames = actor->getStuckFrames();
                 frameData.mLastStuckPosition = actor->getLastStuckPosition();
+                frameData.mLodPendingSteps = actor->getLodPendingSteps();
             }
             void operator()(MWPhysics::ProjectileSimulation& /*sim*/) const {}
         };
@@ -200,7 +204,16 @@ namespace
             btCollisionWorld* mCollisionWorld;
             void operator()(const LockedActorSimulation& sim) const
             {
-                MWPhysics::MovementSolver::unstuck(sim.second, mCollisionWorld);
+                MWPhysics::ActorFrameData& frameData = sim.second;
+                // Actors with a lower rate skip steps and move over all of them at once
+                if (frameData.mLodInterval == 0)
+                {
+                    frameData.mMoveInStep = false;
+                    return;
+                }
+                frameData.mMoveInStep = ++frameData.mLodPendingSteps >= frameData.mLodInterval;
+                if (frameData.mMoveInStep)
+                    MWPhysics::MovementSolver::unstuck(frameData, mCollisionWorld);
             }
             void operator()(const LockedProjectileSimulation& /*sim*/) const {}
         };
@@ -236,7 +249,13 @@ namespace
             const MWPhysics::WorldFrameData& mWorldFrameData;
             void operator()(const LockedActorSimulation& sim) const
             {
-                MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData);
+                MWPhysics::ActorFrameData& frameData = sim.second;
+                if (!frameData.mMoveInStep)
+                    return;
+                MWPhysics::MovementSolver::move(
+                    frameData, mPhysicsDt * frameData.mLodPendingSteps, mCollisionWorld, mWorldFrameData);
+                frameData.mLodPendingSteps = 0;
+                frameData.mMoved = true;
             }
             void operator()(const LockedProjectileSimulation& sim) const
             {
@@ -272,7 +291,9 @@ namespace
                 actor->setSimulationPosition(::interpolateMovements(*actor, mTimeAccum, mPhysicsDt));
                 actor->setLastStuckPosition(frameData.mLastStuckPosition);
                 actor->setStuckFrames(frameData.mStuckFrames);
-                if (mAdvanceSimulation)
+                actor->setLodPendingSteps(frameData.mLodPendingSteps);
+                // Actors skipping all the steps keep the state of their last move
+                if (mAdvanceSimulation && frameData.mMoved)
                 {
                     MWWorld::Ptr standingOn;
                     if (frameData.mStandingOn != nullptr)
@@ -290,6 +311,8 @@ namespace
                     actor->setOnSlope(frameData.mIsOnSlope);
                     actor->setWalkingOnWater(frameData.mWalkingOnWater);
                     actor->setInertialForce(frameData.mInertia);
+                    actor->setSettled(frameData.mIsOnGround && !frameData.mIsOnSlope && !frameData.mFlying
+                        && frameData.mMovement.length2() == 0 && frameData.mInertia.length2() == 0);
                 }
             }
             void operator()(MWPhysics::ProjectileSimulation& sim) const
@@ -341,8 +364,25 @@ namespace MWPhysics
             throw std::runtime_error("Unsupported LockingPolicy: "
                 + std::to_string(static_cast<std::underlying_type_t<LockingPolicy>>(lockingPolicy)));
         }
+
+        // Enough chunks per thread for the ones finishing early to take over a part of the work of the others
+        constexpr std::size_t chunksPerThread = 4;
+
+        // Number of times a thread checks for the next task before blocking on the condition variable
+        constexpr int spinCount = 64;
     }
 
+    struct PhysicsTaskScheduler::Task
+    {
+        explicit Task(std::size_t workers)
+            : mRange(workers)
+        {
+        }
+
+        Misc::WorkStealingRange mRange;
+        std::atomic<std::size_t> mRemaining{ 0 };
+    };
+
     class PhysicsTaskScheduler::WorkersSync
     {
     public:
@@ -406,14 +446,12 @@ namespace MWPhysics
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
         , mDebugDrawer(debugDrawer)
+        , mCurrentTask(0)
+        , mSyncTicks(0)
         , mLockingPolicy(detectLockingPolicy())
         , mNumThreads(getNumThreads(mLockingPolicy))
-        , mNumJobs(0)
-        , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
         , mAdvanceSimulation(false)
-        , mNextJob(0)
-        , mNextLOS(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -430,18 +468,12 @@ namespace MWPhysics
         {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
             for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
+                mThreads.emplace_back([this, i] { worker(i); });
         }
         else
         {
             mLOSCacheExpiry = 0;
         }
-
-        mPreStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
-
-        mPostStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
-
-        mPostSimBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
     }
 
     PhysicsTaskScheduler::~PhysicsTaskScheduler()
@@ -449,8 +481,8 @@ namespace MWPhysics
         waitForWorkers();
         {
             MaybeExclusiveLock lock(mSimulationMutex, mLockingPolicy);
-            mNumJobs = 0;
-            mRemainingSteps = 0;
+            mTaskTypes.clear();
+            mCurrentTask = 0;
         }
         if (mWorkersSync != nullptr)
             mWorkersSync->stopWorkers();
@@ -509,6 +541,8 @@ namespace MWPhysics
     {
         assert(mSimulations != &simulations);
 
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::applyQueuedMovements");
+
         waitForWorkers();
         prepareWork(timeAccum, simulations, frameStart, frameNumber, stats);
         if (mWorkersSync != nullptr)
@@ -535,6 +569,13 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        deliverRayResults();
+        {
+            const std::lock_guard lock(mQueuedRaysMutex);
+            mRays = std::move(mQueuedRays);
+            mQueuedRays.clear();
+        }
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
 
@@ -545,14 +586,25 @@ namespace MWPhysics
             std::visit(vis, sim);
         }
         mPrevStepCount = numSteps;
-        mRemainingSteps = numSteps;
         mTimeAccum = timeAccum;
         mPhysicsDt = newDelta;
         mSimulations = &simulations;
-        mAdvanceSimulation = (mRemainingSteps != 0);
-        mNumJobs = mSimulations->size();
-        mNextLOS.store(0, std::memory_order_relaxed);
-        mNextJob.store(0, std::memory_order_release);
+        mAdvanceSimulation = (numSteps != 0);
+
+        mTaskTypes.clear();
+        for (int i = 0; i < numSteps; ++i)
+        {
+            mTaskTypes.push_back(TaskType::UpdateAabbs);
+            mTaskTypes.push_back(TaskType::PreStep);
+            mTaskTypes.push_back(TaskType::Move);
+            mTaskTypes.push_back(TaskType::UpdatePositions);
+        }
+        mTaskTypes.push_back(TaskType::Queries);
+        while (mTasks.size() < mTaskTypes.size())
+            mTasks.push_back(std::make_unique<Task>(std::max(mNumThreads, 1u)));
+        mCurrentTask.store(startTasks(0), std::memory_order_release);
+        if (mCurrentTask == mTaskTypes.size())
+            afterPostSim();
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
@@ -562,7 +614,7 @@ namespace MWPhysics
 
         if (mNumThreads == 0)
         {
-            doSimulation();
+            doSimulation(0);
             syncWithMainThread();
             if (mAdvanceSimulation)
                 mBudget.update(mTimer->delta_s(timeStart, mTimer->tick()), numSteps, mBudgetCursor);
@@ -667,7 +719,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate)
     {
-        if (immediate || mNumThreads == 0)
+        if ((immediate || mNumThreads == 0) && mAabbUpdateBatchDepth == 0)
         {
             updatePtrAabb(ptr);
         }
@@ -678,31 +730,62 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsTaskScheduler::beginAabbUpdateBatch()
+    {
+        ++mAabbUpdateBatchDepth;
+    }
+
+    void PhysicsTaskScheduler::endAabbUpdateBatch()
+    {
+        assert(mAabbUpdateBatchDepth > 0);
+        if (--mAabbUpdateBatchDepth == 0)
+            updateAabbs();
+    }
+
     bool PhysicsTaskScheduler::getLineOfSight(
         const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
     {
         MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
 
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        const auto [it, inserted] = mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size());
+        if (inserted)
         {
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
             mLOSCache.push_back(req);
             return req.mResult;
         }
-        result->mAge = 0;
-        return result->mResult;
+        LOSRequest& cached = mLOSCache[it->second];
+        // The address of a removed actor can be reused by a new one before the stale request is erased
+        if (cached.mActors[0].expired() || cached.mActors[1].expired())
+        {
+            req.mResult = hasLineOfSight(actor1.get(), actor2.get());
+            cached = req;
+            return req.mResult;
+        }
+        cached.mAge = 0;
+        return cached.mResult;
+    }
+
+    void PhysicsTaskScheduler::asyncRayTest(const btVector3& from, const btVector3& to,
+        std::vector<const btCollisionObject*> ignore, int mask, int group,
+        std::function<void(const RayCastingResult&)> callback)
+    {
+        const std::lock_guard lock(mQueuedRaysMutex);
+        mQueuedRays.push_back(RayRequest{ .mFrom = from,
+            .mTo = to,
+            .mIgnore = std::move(ignore),
+            .mMask = mask,
+            .mGroup = group,
+            .mCallback = std::move(callback) });
     }
 
-    void PhysicsTaskScheduler::refreshLOSCache()
+    void PhysicsTaskScheduler::refreshLOSCache(std::size_t begin, std::size_t end)
     {
         MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
-        int job = 0;
-        int numLOS = mLOSCache.size();
-        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
+        for (std::size_t i = begin; i < end; ++i)
         {
-            auto& req = mLOSCache[job];
+            auto& req = mLOSCache[i];
             auto actorPtr1 = req.mActors[0].lock();
             auto actorPtr2 = req.mActors[1].lock();
 
@@ -713,6 +796,62 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsTaskScheduler::castRays(std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            RayRequest& ray = mRays[i];
+            if (ray.mFrom == ray.mTo)
+                continue;
+            ClosestNotMeRayResultCallback resultCallback(ray.mIgnore, {}, ray.mFrom, ray.mTo);
+            resultCallback.m_collisionFilterGroup = ray.mGroup;
+            resultCallback.m_collisionFilterMask = ray.mMask;
+            {
+                MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+                mCollisionWorld->rayTest(ray.mFrom, ray.mTo, resultCallback);
+            }
+            if (!resultCallback.hasHit())
+                continue;
+            // The object is resolved on the main thread, it may be removed in the meantime
+            ray.mHitObject = resultCallback.m_collisionObject;
+            ray.mHitPos = resultCallback.m_hitPointWorld;
+            ray.mHitNormal = resultCallback.m_hitNormalWorld;
+        }
+    }
+
+    void PhysicsTaskScheduler::addProjectileHit(int projectileId)
+    {
+        MaybeExclusiveLock lock(mProjectileHitsMutex, mLockingPolicy);
+        mProjectileHits.push_back(projectileId);
+    }
+
+    std::vector<int> PhysicsTaskScheduler::takeProjectileHits()
+    {
+        std::vector<int> result = std::move(mSyncedProjectileHits);
+        mSyncedProjectileHits.clear();
+        return result;
+    }
+
+    void PhysicsTaskScheduler::deliverRayResults()
+    {
+        // Callbacks may queue new rays
+        const std::vector<RayRequest> rays = std::move(mRays);
+        mRays.clear();
+        for (const RayRequest& ray : rays)
+        {
+            RayCastingResult result;
+            result.mHit = ray.mHitObject != nullptr;
+            if (result.mHit)
+            {
+                result.mHitPos = Misc::Convert::toOsg(ray.mHitPos);
+                result.mHitNormal = Misc::Convert::toOsg(ray.mHitNormal);
+                if (auto* ptrHolder = static_cast<PtrHolder*>(getUserPointer(ray.mHitObject)))
+                    result.mHitObject = ptrHolder->getPtr();
+            }
+            ray.mCallback(result);
+        }
+    }
+
     void PhysicsTaskScheduler::updateAabbs()
     {
         MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
@@ -744,23 +883,15 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::worker()
+    void PhysicsTaskScheduler::worker(std::size_t threadIndex)
     {
-        mWorkersSync->runWorker([this] {
+        OPENMW_TRACE_THREAD_NAME("Physics worker " + std::to_string(threadIndex));
+        mWorkersSync->runWorker([this, threadIndex] {
             std::shared_lock lock(mSimulationMutex);
-            doSimulation();
+            doSimulation(threadIndex);
         });
     }
 
-    void PhysicsTaskScheduler::updateActorsPositions()
-    {
-        const Visitors::UpdatePosition impl{ mCollisionWorld };
-        const Visitors::WithLockedPtr<Visitors::UpdatePosition, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
-            mLockingPolicy };
-        for (Simulation& sim : *mSimulations)
-            std::visit(vis, sim);
-    }
-
     bool PhysicsTaskScheduler::hasLineOfSight(const Actor* actor1, const Actor* actor2)
     {
         btVector3 pos1 = Misc::Convert::toBullet(
@@ -778,33 +909,164 @@ namespace MWPhysics
         return !resultCallback.hasHit();
     }
 
-    void PhysicsTaskScheduler::doSimulation()
+    void PhysicsTaskScheduler::doSimulation(std::size_t worker)
+    {
+        // Threads don't wait for each other, only for the completion of the previous task. Any thread may complete
+        // tasks alone, a thread joining late skips the ones already completed.
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::doSimulation");
+        std::size_t task = 0;
+        while (task < mTaskTypes.size() && (task = waitForTask(task)) < mTaskTypes.size())
+        {
+            Task& state = *mTasks[task];
+            while (const std::optional<Misc::WorkStealingRange::Chunk> chunk = state.mRange.take(worker))
+            {
+                runTask(mTaskTypes[task], chunk->mBegin, chunk->mEnd);
+                const std::size_t count = chunk->mEnd - chunk->mBegin;
+                if (state.mRemaining.fetch_sub(count, std::memory_order_acq_rel) == count)
+                    completeTask(task);
+            }
+            ++task;
+        }
+    }
+
+    void PhysicsTaskScheduler::runTask(TaskType type, std::size_t begin, std::size_t end)
+    {
+        switch (type)
+        {
+            case TaskType::UpdateAabbs:
+                updateAabbs();
+                break;
+            case TaskType::PreStep:
+            {
+                const Visitors::PreStep impl{ mCollisionWorld };
+                const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl,
+                    mCollisionWorldMutex, mLockingPolicy };
+                for (std::size_t i = begin; i < end; ++i)
+                    std::visit(vis, (*mSimulations)[i]);
+                break;
+            }
+            case TaskType::Move:
+            {
+                const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
+                const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex,
+                    mLockingPolicy };
+                for (std::size_t i = begin; i < end; ++i)
+                    std::visit(vis, (*mSimulations)[i]);
+                break;
+            }
+            case TaskType::UpdatePositions:
+            {
+                const Visitors::UpdatePosition impl{ mCollisionWorld };
+                const Visitors::WithLockedPtr<Visitors::UpdatePosition, MaybeExclusiveLock> vis{ impl,
+                    mCollisionWorldMutex, mLockingPolicy };
+                for (std::size_t i = begin; i < end; ++i)
+                    std::visit(vis, (*mSimulations)[i]);
+                break;
+            }
+            case TaskType::Queries:
+                if (begin < mNumQueriedLOS)
+                    refreshLOSCache(begin, std::min(end, mNumQueriedLOS));
+                if (end > mNumQueriedLOS)
+                    castRays(std::max(begin, mNumQueriedLOS) - mNumQueriedLOS, end - mNumQueriedLOS);
+                break;
+        }
+    }
+
+    void PhysicsTaskScheduler::completeTask(std::size_t task)
+    {
+        // Called by the thread finishing the last chunk of the task, all other threads are done with it
+        const std::size_t next = startTasks(task + 1);
+        if (next == mTaskTypes.size())
+            afterPostSim();
+
+        {
+            const std::lock_guard lock(mCurrentTaskMutex);
+            mCurrentTask.store(next, std::memory_order_release);
+        }
+        mCurrentTaskChanged.notify_all();
+    }
+
+    std::size_t PhysicsTaskScheduler::startTasks(std::size_t first)
     {
-        while (mRemainingSteps)
+        // Empty tasks are completed right away
+        std::size_t task = first;
+        for (; task < mTaskTypes.size(); ++task)
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
-            int job = 0;
-            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
-            const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
-            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            startTask(task);
+            if (mTasks[task]->mRemaining.load(std::memory_order_relaxed) != 0)
+                break;
+        }
+        return task;
+    }
 
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+    void PhysicsTaskScheduler::startTask(std::size_t task)
+    {
+        std::size_t size = 0;
+        switch (mTaskTypes[task])
+        {
+            case TaskType::UpdateAabbs:
+                // Done as a whole, updating aabbs requires an exclusive lock on the collision world anyway
+                size = 1;
+                break;
+            case TaskType::PreStep:
+            case TaskType::Move:
+            case TaskType::UpdatePositions:
+                size = mSimulations->size();
+                break;
+            case TaskType::Queries:
+            {
+                // Requests added by the main thread after this point were just computed
+                MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
+                mNumQueriedLOS = mLOSCache.size();
+                size = mNumQueriedLOS + mRays.size();
+                break;
+            }
         }
+        const std::size_t threads = std::max(mNumThreads, 1u);
+        Task& state = *mTasks[task];
+        state.mRange.reset(size, size / (threads * chunksPerThread));
+        state.mRemaining.store(size, std::memory_order_relaxed);
+    }
+
+    std::size_t PhysicsTaskScheduler::waitForTask(std::size_t task)
+    {
+        std::size_t current = mCurrentTask.load(std::memory_order_acquire);
+        if (current >= task)
+            return current;
 
-        refreshLOSCache();
-        mPostSimBarrier->wait([this] { afterPostSim(); });
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::waitForTask");
+        const osg::Timer_t start = mTimer->tick();
+        for (int i = 0; i < spinCount && current < task; ++i)
+        {
+            std::this_thread::yield();
+            current = mCurrentTask.load(std::memory_order_acquire);
+        }
+        if (current < task)
+        {
+            std::unique_lock lock(mCurrentTaskMutex);
+            mCurrentTaskChanged.wait(
+                lock, [&] { return (current = mCurrentTask.load(std::memory_order_acquire)) >= task; });
+        }
+        mSyncTicks.fetch_add(mTimer->tick() - start, std::memory_order_relaxed);
+        return current;
     }
 
     void PhysicsTaskScheduler::updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
-        if (!stats.collectStats("engine"))
-            return;
+        const osg::Timer_t syncTicks = mSyncTicks.exchange(0, std::memory_order_relaxed);
         if (mFrameNumber == frameNumber - 1)
         {
-            stats.setAttribute(mFrameNumber, "physicsworker_time_begin", mTimer->delta_s(mFrameStart, mTimeBegin));
-            stats.setAttribute(mFrameNumber, "physicsworker_time_taken", mTimer->delta_s(mTimeBegin, mTimeEnd));
-            stats.setAttribute(mFrameNumber, "physicsworker_time_end", mTimer->delta_s(mFrameStart, mTimeEnd));
+            if (stats.collectStats("engine"))
+            {
+                stats.setAttribute(
+                    mFrameNumber, "physicsworker_time_begin", mTimer->delta_s(mFrameStart, mTimeBegin));
+                stats.setAttribute(mFrameNumber, "physicsworker_time_taken", mTimer->delta_s(mTimeBegin, mTimeEnd));
+                stats.setAttribute(mFrameNumber, "physicsworker_time_end", mTimer->delta_s(mFrameStart, mTimeEnd));
+            }
+            // Time the threads spent waiting for the tasks of others per simulation step, in microseconds
+            if (stats.collectStats("resource"))
+                stats.setAttribute(
+                    mFrameNumber, "Physics Sync", mTimer->delta_u(0, syncTicks) / std::max(mPrevStepCount, 1));
         }
         mFrameStart = frameStart;
         mTimeBegin = mTimer->tick();
@@ -835,28 +1097,13 @@ namespace MWPhysics
             mSimulations = nullptr;
         }
         mUpdateAabb.clear();
-    }
-
-    void PhysicsTaskScheduler::afterPreStep()
-    {
-        updateAabbs();
-        if (!mRemainingSteps)
-            return;
-        const Visitors::PreStep impl{ mCollisionWorld };
-        const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
-            mLockingPolicy };
-        for (auto& sim : *mSimulations)
-            std::visit(vis, sim);
-    }
-
-    void PhysicsTaskScheduler::afterPostStep()
-    {
-        if (mRemainingSteps)
         {
-            --mRemainingSteps;
-            updateActorsPositions();
+            const std::lock_guard lock(mQueuedRaysMutex);
+            mQueuedRays.clear();
         }
-        mNextJob.store(0, std::memory_order_release);
+        mRays.clear();
+        mProjectileHits.clear();
+        mSyncedProjectileHits.clear();
     }
 
     void PhysicsTaskScheduler::afterPostSim()
@@ -866,6 +1113,9 @@ namespace MWPhysics
             mLOSCache.erase(
                 std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
                 mLOSCache.end());
+            mLOSCacheIndex.clear();
+            for (std::size_t i = 0; i < mLOSCache.size(); ++i)
+                mLOSCacheIndex.emplace(mLOSCache[i].mRawActors, i);
         }
         mTimeEnd = mTimer->tick();
         if (mWorkersSync != nullptr)
@@ -881,6 +1131,9 @@ namespace MWPhysics
             std::visit(vis, sim);
         mSimulations->clear();
         mSimulations = nullptr;
+        // Hit projectiles are reported along with the positions of the same simulation
+        mSyncedProjectileHits.insert(mSyncedProjectileHits.end(), mProjectileHits.begin(), mProjectileHits.end());
+        mProjectileHits.clear();
     }
 
     // Attempt to acquire unique lock on mSimulationMutex while not all worker
@@ -891,6 +1144,7 @@ namespace MWPhysics
     // https://docs.microsoft.com/en-us/windows/win32/sync/slim-reader-writer--srw--locks
     void PhysicsTaskScheduler::waitForWorkers()
     {
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::waitForWorkers");
         if (mWorkersSync != nullptr)
             mWorkersSync->waitForWorkers();
     }
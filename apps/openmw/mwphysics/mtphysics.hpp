@@ -3,24 +3,29 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <shared_mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "components/misc/hash.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
 namespace Misc
 {
-    class Barrier;
+    class WorkStealingRange;
 }
 
 namespace MWRender
@@ -66,7 +71,22 @@ namespace MWPhysics
         void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask);
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
+        /// @brief collect the AABB updates until endAabbUpdateBatch to update each object once, must be called from
+        /// the main thread
+        /// @note collision queries in between use the previous AABBs of the objects moved meanwhile
+        void beginAabbUpdateBatch();
+        void endAabbUpdateBatch();
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// @brief cast the ray in parallel with the next simulation, must be called from the main thread
+        /// @param callback called from the main thread when the simulation after the next one starts, or when the
+        /// next one starts without async physics
+        void asyncRayTest(const btVector3& from, const btVector3& to, std::vector<const btCollisionObject*> ignore,
+            int mask, int group, std::function<void(const RayCastingResult&)> callback);
+        /// @brief record the hit of a projectile, called by the simulation
+        void addProjectileHit(int projectileId);
+        /// @return ids of the projectiles that hit something in the simulations synchronized since the last call, in
+        /// the order of the hits, must be called from the main thread
+        std::vector<int> takeProjectileHits();
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -75,17 +95,57 @@ namespace MWPhysics
     private:
         class WorkersSync;
 
-        void doSimulation();
-        void worker();
-        void updateActorsPositions();
+        enum class TaskType
+        {
+            UpdateAabbs,
+            PreStep,
+            Move,
+            UpdatePositions,
+            // Line of sight refresh followed by the queued rays
+            Queries,
+        };
+
+        struct Task;
+
+        struct LOSRequestHash
+        {
+            std::size_t operator()(const std::array<const Actor*, 2>& actors) const noexcept
+            {
+                std::size_t seed = 0;
+                Misc::hashCombine(seed, actors[0]);
+                Misc::hashCombine(seed, actors[1]);
+                return seed;
+            }
+        };
+
+        struct RayRequest
+        {
+            btVector3 mFrom;
+            btVector3 mTo;
+            std::vector<const btCollisionObject*> mIgnore;
+            int mMask;
+            int mGroup;
+            std::function<void(const RayCastingResult&)> mCallback;
+            const btCollisionObject* mHitObject = nullptr;
+            btVector3 mHitPos;
+            btVector3 mHitNormal;
+        };
+
+        void doSimulation(std::size_t worker);
+        void worker(std::size_t threadIndex);
+        void runTask(TaskType type, std::size_t begin, std::size_t end);
+        void completeTask(std::size_t task);
+        std::size_t startTasks(std::size_t first);
+        void startTask(std::size_t task);
+        std::size_t waitForTask(std::size_t task);
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
-        void refreshLOSCache();
+        void refreshLOSCache(std::size_t begin, std::size_t end);
+        void castRays(std::size_t begin, std::size_t end);
+        void deliverRayResults();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
         std::tuple<int, float> calculateStepConfig(float timeAccum) const;
-        void afterPreStep();
-        void afterPostStep();
         void afterPostSim();
         void syncWithMainThread();
         void waitForWorkers();
@@ -101,27 +161,37 @@ namespace MWPhysics
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSRequestHash> mLOSCacheIndex;
+        std::size_t mNumQueriedLOS = 0;
+        // Rays cast by the next simulation and the current one, the rays may be queued by several Lua threads
+        std::mutex mQueuedRaysMutex;
+        std::vector<RayRequest> mQueuedRays;
+        std::vector<RayRequest> mRays;
+        // Projectile hits of the current simulation and of the synchronized ones
+        std::vector<int> mProjectileHits;
+        std::vector<int> mSyncedProjectileHits;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
+        unsigned mAabbUpdateBatchDepth = 0;
 
-        // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
-        std::unique_ptr<Misc::Barrier> mPreStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostSimBarrier;
+        // Tasks of the current simulation, each one depends on the completion of the previous one
+        std::vector<TaskType> mTaskTypes;
+        std::vector<std::unique_ptr<Task>> mTasks;
+        std::atomic<std::size_t> mCurrentTask;
+        std::mutex mCurrentTaskMutex;
+        std::condition_variable mCurrentTaskChanged;
+        std::atomic<osg::Timer_t> mSyncTicks;
 
         LockingPolicy mLockingPolicy;
         unsigned mNumThreads;
-        int mNumJobs;
-        int mRemainingSteps;
         int mLOSCacheExpiry;
         bool mAdvanceSimulation;
-        std::atomic<int> mNextJob;
-        std::atomic<int> mNextLOS;
         std::vector<std::thread> mThreads;
 
         mutable std::shared_mutex mSimulationMutex;
         mutable std::shared_mutex mCollisionWorldMutex;
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
+        std::mutex mProjectileHitsMutex;
 
         unsigned int mFrameNumber;
         const osg::Timer* mTimer;
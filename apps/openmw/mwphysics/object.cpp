@@ -6,6 +6,7 @@
 #include <components/misc/convert.hpp>
 #include <components/nifosg/particle.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
@@ -34,8 +35,15 @@ namespace MWPhysics
     }
 
     Object::~Object()
+    {
+        if (mTaskScheduler != nullptr)
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+    }
+
+    void Object::removeFromWorld()
     {
         mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        mTaskScheduler = nullptr;
     }
 
     const Resource::BulletShapeInstance* Object::getShapeInstance() const
@@ -136,6 +144,12 @@ namespace MWPhysics
                 }
                 osg::NodePath nodePath = visitor.mFoundPath;
                 nodePath.erase(nodePath.begin());
+
+                // The collision has to follow the animation even while the object is offscreen
+                SceneUtil::AssignVisibilityGateVisitor removeGate(nullptr);
+                removeGate.setTraversalMode(osg::NodeVisitor::TRAVERSE_NONE);
+                for (osg::Node* node : nodePath)
+                    node->accept(removeGate);
                 nodePathFound = mRecIndexToNodePath.emplace(recIndex, nodePath).first;
             }
 
@@ -33,6 +33,9 @@ namespace MWPhysics
             int collisionType, PhysicsTaskScheduler* scheduler);
         ~Object() override;
 
+        /// Removes the collision object from the world, so the rest can be destroyed on any thread
+        void removeFromWorld();
+
         const Resource::BulletShapeInstance* getShapeInstance() const;
         void setScale(float scale);
         void setRotation(osg::Quat quat);
@@ -12,10 +12,12 @@
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
 #include <BulletCollision/CollisionShapes/btConeShape.h>
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
 
+#include <LinearMath/btAabbUtil2.h>
 #include <LinearMath/btQuickprof.h>
 #include <LinearMath/btVector3.h>
 
@@ -27,6 +29,7 @@
 #include <components/misc/strings/conversion.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/unrefqueue.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -48,9 +51,11 @@
 #include "collisiontype.hpp"
 
 #include "closestnotmerayresultcallback.hpp"
+#include "constants.hpp"
 #include "contacttestresultcallback.hpp"
 #include "hasspherecollisioncallback.hpp"
 #include "heightfield.hpp"
+#include "heightfieldmanager.hpp"
 #include "movementsolver.hpp"
 #include "mtphysics.hpp"
 #include "object.hpp"
@@ -88,15 +93,37 @@ namespace
         ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
     }
 
+    unsigned getLodInterval(
+        const MWPhysics::Actor& actor, const osg::Vec3f& position, const osg::Vec3f& playerPosition, bool isPlayer)
+    {
+        // A jump is fulfilled only if the actor is moved in the same frame
+        if (isPlayer || actor.getVelocity().z() > 0)
+            return 1;
+        // Idle actors resting on the ground stay in place until they move or something else moves them or their
+        // ground
+        const bool idle = actor.isSettled() && actor.getVelocity().length2() == 0;
+        if (idle && Settings::physics().mActorSleeping)
+            return 0;
+        const float distance = Settings::physics().mLodDistance;
+        if (distance <= 0 || (position - playerPosition).length2() <= distance * distance)
+            return 1;
+        if (idle)
+            return 0;
+        return static_cast<unsigned>(Settings::physics().mLodStepInterval);
+    }
+
 }
 
 namespace MWPhysics
 {
-    PhysicsSystem::PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode)
+    PhysicsSystem::PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode,
+        SceneUtil::UnrefQueue& unrefQueue)
         : mShapeManager(
             std::make_unique<Resource::BulletShapeManager>(resourceSystem->getVFS(), resourceSystem->getSceneManager(),
                 resourceSystem->getNifFileManager(), Settings::cells().mCacheExpiryDelay))
+        , mHeightFieldManager(std::make_unique<HeightFieldManager>(Settings::cells().mCacheExpiryDelay))
         , mResourceSystem(resourceSystem)
+        , mUnrefQueue(unrefQueue)
         , mDebugDrawEnabled(false)
         , mTimeAccum(0.0f)
         , mProjectileId(0)
@@ -106,6 +133,7 @@ namespace MWPhysics
         , mPhysicsDt(1.f / 60.f)
     {
         mResourceSystem->addResourceManager(mShapeManager.get());
+        mResourceSystem->addResourceManager(mHeightFieldManager.get());
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
@@ -137,6 +165,7 @@ namespace MWPhysics
     PhysicsSystem::~PhysicsSystem()
     {
         mResourceSystem->removeResourceManager(mShapeManager.get());
+        mResourceSystem->removeResourceManager(mHeightFieldManager.get());
 
         if (mWaterCollisionObject)
             mTaskScheduler->removeCollisionObject(mWaterCollisionObject.get());
@@ -153,6 +182,11 @@ namespace MWPhysics
         return mShapeManager.get();
     }
 
+    HeightFieldManager* PhysicsSystem::getHeightFieldManager()
+    {
+        return mHeightFieldManager.get();
+    }
+
     bool PhysicsSystem::toggleDebugRendering()
     {
         mDebugDrawEnabled = !mDebugDrawEnabled;
@@ -204,25 +238,9 @@ namespace MWPhysics
         btVector3 btFrom = Misc::Convert::toBullet(from);
         btVector3 btTo = Misc::Convert::toBullet(to);
 
-        std::vector<const btCollisionObject*> ignoreList;
+        std::vector<const btCollisionObject*> ignoreList = getCollisionObjects(ignore);
         std::vector<const btCollisionObject*> targetCollisionObjects;
 
-        for (const auto& ptr : ignore)
-        {
-            if (!ptr.isEmpty())
-            {
-                const Actor* actor = getActor(ptr);
-                if (actor)
-                    ignoreList.push_back(actor->getCollisionObject());
-                else
-                {
-                    const Object* object = getObject(ptr);
-                    if (object)
-                        ignoreList.push_back(object->getCollisionObject());
-                }
-            }
-        }
-
         if (!targets.empty())
         {
             for (const MWWorld::Ptr& target : targets)
@@ -251,6 +269,35 @@ namespace MWPhysics
         return result;
     }
 
+    void PhysicsSystem::asyncCastRay(std::function<void(const RayCastingResult&)> callback, const osg::Vec3f& from,
+        const osg::Vec3f& to, const std::vector<MWWorld::ConstPtr>& ignore, int mask, int group) const
+    {
+        mTaskScheduler->asyncRayTest(Misc::Convert::toBullet(from), Misc::Convert::toBullet(to),
+            getCollisionObjects(ignore), mask, group, std::move(callback));
+    }
+
+    std::vector<const btCollisionObject*> PhysicsSystem::getCollisionObjects(
+        const std::vector<MWWorld::ConstPtr>& ptrs) const
+    {
+        std::vector<const btCollisionObject*> result;
+        for (const auto& ptr : ptrs)
+        {
+            if (!ptr.isEmpty())
+            {
+                const Actor* actor = getActor(ptr);
+                if (actor)
+                    result.push_back(actor->getCollisionObject());
+                else
+                {
+                    const Object* object = getObject(ptr);
+                    if (object)
+                        result.push_back(object->getCollisionObject());
+                }
+            }
+        }
+        return result;
+    }
+
     RayCastingResult PhysicsSystem::castSphere(
         const osg::Vec3f& from, const osg::Vec3f& to, float radius, int mask, int group) const
     {
@@ -384,18 +431,22 @@ namespace MWPhysics
         return MovementSolver::traceDown(ptr, position, found->second.get(), mCollisionWorld.get(), maxHeight);
     }
 
-    void PhysicsSystem::addHeightField(
-        const float* heights, int x, int y, int size, int verts, float minH, float maxH, const osg::Object* holdObject)
+    void PhysicsSystem::addHeightField(osg::ref_ptr<const HeightFieldShape> shape, int x, int y)
     {
         mHeightFields[std::make_pair(x, y)]
-            = std::make_unique<HeightField>(heights, x, y, size, verts, minH, maxH, holdObject, mTaskScheduler.get());
+            = std::make_unique<HeightField>(std::move(shape), x, y, mTaskScheduler.get());
     }
 
     void PhysicsSystem::removeHeightField(int x, int y)
     {
         HeightFieldMap::iterator heightfield = mHeightFields.find(std::make_pair(x, y));
         if (heightfield != mHeightFields.end())
+        {
+            wakeActors(*heightfield->second->getCollisionObject(), MWWorld::ConstPtr());
+            heightfield->second->removeFromWorld();
+            mUnrefQueue.push(std::move(heightfield->second));
             mHeightFields.erase(heightfield);
+        }
     }
 
     const HeightField* PhysicsSystem::getHeightField(int x, int y) const
@@ -446,11 +497,17 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             mAnimatedObjects.erase(foundObject->second.get());
+            wakeActors(*foundObject->second->getCollisionObject(), ptr);
 
+            // Only the removal from the collision world has to be done now, freeing the shapes can wait
+            foundObject->second->removeFromWorld();
+            mUnrefQueue.push(std::move(foundObject->second));
             mObjects.erase(foundObject);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
+            foundActor->second->removeFromWorld();
+            mUnrefQueue.push(std::move(foundActor->second));
             mActors.erase(foundActor);
         }
     }
@@ -514,6 +571,11 @@ namespace MWPhysics
         return nullptr;
     }
 
+    std::vector<int> PhysicsSystem::takeProjectileHits()
+    {
+        return mTaskScheduler->takeProjectileHits();
+    }
+
     void PhysicsSystem::updateScale(const MWWorld::Ptr& ptr)
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
@@ -521,10 +583,12 @@ namespace MWPhysics
             float scale = ptr.getCellRef().getScale();
             foundObject->second->setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeActors(*foundObject->second->getCollisionObject(), ptr);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
             foundActor->second->updateScale();
+            foundActor->second->setSettled(false);
             mTaskScheduler->updateSingleAabb(foundActor->second);
         }
     }
@@ -535,6 +599,7 @@ namespace MWPhysics
         {
             foundObject->second->setRotation(rotate);
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeActors(*foundObject->second->getCollisionObject(), ptr);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
@@ -552,6 +617,7 @@ namespace MWPhysics
         {
             foundObject->second->updatePosition();
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeActors(*foundObject->second->getCollisionObject(), ptr);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
@@ -560,6 +626,16 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsSystem::beginBatchedUpdate()
+    {
+        mTaskScheduler->beginAabbUpdateBatch();
+    }
+
+    void PhysicsSystem::endBatchedUpdate()
+    {
+        mTaskScheduler->endAabbUpdateBatch();
+    }
+
     void PhysicsSystem::addActor(const MWWorld::Ptr& ptr, const std::string& mesh)
     {
         std::string animationMesh = Misc::ResourceHelpers::correctActorModelPath(mesh, mResourceSystem->getVFS());
@@ -596,7 +672,8 @@ namespace MWPhysics
 
         mProjectileId++;
 
-        auto projectile = std::make_shared<Projectile>(caster, position, radius, mTaskScheduler.get(), this);
+        auto projectile
+            = std::make_shared<Projectile>(mProjectileId, caster, position, radius, mTaskScheduler.get(), this);
         mProjectiles.emplace(mProjectileId, std::move(projectile));
 
         return mProjectileId;
@@ -647,6 +724,9 @@ namespace MWPhysics
         assert(simulations.empty());
         simulations.reserve(mActors.size() + mProjectiles.size());
         const MWBase::World* world = MWBase::Environment::get().getWorld();
+        const osg::Vec3f playerPosition = world->getPlayerConstPtr().getRefData().getPosition().asVec3();
+        mActorsAwake = 0;
+        mActorsSleeping = 0;
         for (const auto& [ref, physicActor] : mActors)
         {
             if (!physicActor->isActive())
@@ -681,6 +761,15 @@ namespace MWPhysics
             const bool inert = stats.isDead()
                 || (!godmode && stats.getMagicEffects().getOrDefault(ESM::MagicEffect::Paralyze).getModifier() > 0);
 
+            const unsigned lodInterval
+                = getLodInterval(*physicActor, ptr.getRefData().getPosition().asVec3(), playerPosition, isPlayer);
+            if (lodInterval != physicActor->getLodInterval())
+                physicActor->setLodInterval(lodInterval, static_cast<unsigned>(simulations.size()));
+            if (lodInterval == 0)
+                ++mActorsSleeping;
+            else
+                ++mActorsAwake;
+
             simulations.emplace_back(ActorSimulation{
                 physicActor, ActorFrameData{ *physicActor, inert, waterCollision, slowFall, waterlevel, isPlayer } });
 
@@ -705,6 +794,7 @@ namespace MWPhysics
                 auto obj = mObjects.find(animatedObject->getPtr().mRef);
                 assert(obj != mObjects.end());
                 mTaskScheduler->updateSingleAabb(obj->second);
+                wakeActors(*obj->second->getCollisionObject(), obj->second->getPtr());
                 changed = true;
             }
             else
@@ -762,7 +852,10 @@ namespace MWPhysics
         ObjectMap::iterator found = mObjects.find(object.mRef);
         if (found != mObjects.end())
             if (found->second->animateCollisionShapes())
+            {
                 mTaskScheduler->updateSingleAabb(found->second);
+                wakeActors(*found->second->getCollisionObject(), object);
+            }
     }
 
     void PhysicsSystem::debugDraw()
@@ -887,11 +980,47 @@ namespace MWPhysics
     void PhysicsSystem::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         stats.setAttribute(frameNumber, "Physics Actors", mActors.size());
+        stats.setAttribute(frameNumber, "Physics Actors Awake", mActorsAwake);
+        stats.setAttribute(frameNumber, "Physics Actors Sleeping", mActorsSleeping);
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
         stats.setAttribute(frameNumber, "Physics Projectiles", mProjectiles.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
     }
 
+    void PhysicsSystem::wakeActors(const btCollisionObject& collisionObject, const MWWorld::ConstPtr& ptr)
+    {
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        // The transform of the collision object is updated only with the next simulation, the bounds have to cover
+        // the new place of a moved object.
+        btTransform transform = collisionObject.getWorldTransform();
+        if (!ptr.isEmpty())
+        {
+            if (const auto found = mObjects.find(ptr.mRef); found != mObjects.end())
+                transform = found->second->getTransform();
+        }
+        collisionObject.getCollisionShape()->getAabb(transform, aabbMin, aabbMax);
+        // Touch the ground below the actors too
+        aabbMax.setZ(aabbMax.z() + sGroundOffset * 2);
+
+        for (const auto& [_, actor] : mActors)
+        {
+            if (!actor->isSettled())
+                continue;
+            if (!ptr.isEmpty() && actor->getStandingOnPtr() == ptr)
+            {
+                actor->setSettled(false);
+                continue;
+            }
+            const btCollisionObject* actorObject = actor->getCollisionObject();
+            btVector3 actorMin;
+            btVector3 actorMax;
+            actorObject->getCollisionShape()->getAabb(actorObject->getWorldTransform(), actorMin, actorMax);
+            if (TestAabbAgainstAabb2(aabbMin, aabbMax, actorMin, actorMax))
+                actor->setSettled(false);
+        }
+    }
+
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
     {
         if (mDebugDrawEnabled)
@@ -927,6 +1056,10 @@ namespace MWPhysics
         , mWaterCollision(waterCollision)
         , mSkipCollisionDetection(!actor.getCollisionMode())
         , mIsPlayer(isPlayer)
+        , mLodInterval(actor.getLodInterval())
+        , mLodPendingSteps(0)
+        , mMoveInStep(false)
+        , mMoved(false)
     {
     }
 
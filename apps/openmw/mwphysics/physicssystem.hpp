@@ -33,6 +33,11 @@ namespace MWRender
     class DebugDrawer;
 }
 
+namespace SceneUtil
+{
+    class UnrefQueue;
+}
+
 namespace Resource
 {
     class BulletShapeManager;
@@ -50,6 +55,8 @@ class btVector3;
 namespace MWPhysics
 {
     class HeightField;
+    class HeightFieldManager;
+    class HeightFieldShape;
     class Object;
     class Actor;
     class PhysicsTaskScheduler;
@@ -79,6 +86,37 @@ namespace MWPhysics
     struct ActorFrameData
     {
         ActorFrameData(Actor& actor, bool inert, bool waterCollision, float slowFall, float waterlevel, bool isPlayer);
+
+        /// Frame data of a walking actor which isn't a part of the game world, e.g. to benchmark MovementSolver
+        ActorFrameData(btCollisionObject* collisionObject, const osg::Vec3f& position, const osg::Vec3f& movement,
+            float halfExtentsZ, float waterlevel)
+            : mPosition(position)
+            , mStandingOn(nullptr)
+            , mIsOnGround(false)
+            , mIsOnSlope(false)
+            , mWalkingOnWater(false)
+            , mInert(false)
+            , mCollisionObject(collisionObject)
+            , mSwimLevel(waterlevel)
+            , mSlowFall(1)
+            , mMovement(movement)
+            , mWaterlevel(waterlevel)
+            , mHalfExtentsZ(halfExtentsZ)
+            , mOldHeight(0)
+            , mStuckFrames(0)
+            , mFlying(false)
+            , mWasOnGround(false)
+            , mIsAquatic(false)
+            , mWaterCollision(false)
+            , mSkipCollisionDetection(false)
+            , mIsPlayer(false)
+            , mLodInterval(1)
+            , mLodPendingSteps(0)
+            , mMoveInStep(false)
+            , mMoved(false)
+        {
+        }
+
         osg::Vec3f mPosition;
         osg::Vec3f mInertia;
         const btCollisionObject* mStandingOn;
@@ -102,6 +140,11 @@ namespace MWPhysics
         const bool mWaterCollision;
         const bool mSkipCollisionDetection;
         const bool mIsPlayer;
+        // See Actor::getLodInterval
+        const unsigned mLodInterval;
+        unsigned mLodPendingSteps;
+        bool mMoveInStep;
+        bool mMoved;
     };
 
     struct ProjectileFrameData
@@ -117,6 +160,11 @@ namespace MWPhysics
     struct WorldFrameData
     {
         WorldFrameData();
+        WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection)
+            : mIsInStorm(isInStorm)
+            , mStormDirection(stormDirection)
+        {
+        }
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
     };
@@ -150,11 +198,14 @@ namespace MWPhysics
     class PhysicsSystem : public RayCastingInterface
     {
     public:
-        PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode);
+        PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode,
+            SceneUtil::UnrefQueue& unrefQueue);
         virtual ~PhysicsSystem();
 
         Resource::BulletShapeManager* getShapeManager();
 
+        HeightFieldManager* getHeightFieldManager();
+
         void enableWater(float height);
         void setWaterHeight(float height);
         void disableWater();
@@ -177,6 +228,9 @@ namespace MWPhysics
 
         Projectile* getProjectile(int projectileId) const;
 
+        /// @return ids of the projectiles that hit something since the last call, in the order of the hits
+        std::vector<int> takeProjectileHits();
+
         // Object or Actor
         void remove(const MWWorld::Ptr& ptr);
 
@@ -184,8 +238,11 @@ namespace MWPhysics
         void updateRotation(const MWWorld::Ptr& ptr, osg::Quat rotate);
         void updatePosition(const MWWorld::Ptr& ptr);
 
-        void addHeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
-            const osg::Object* holdObject);
+        /// Update the collision bounds of the objects moved until endBatchedUpdate once at its call
+        void beginBatchedUpdate();
+        void endBatchedUpdate();
+
+        void addHeightField(osg::ref_ptr<const HeightFieldShape> shape, int x, int y);
 
         void removeHeightField(int x, int y);
 
@@ -214,6 +271,10 @@ namespace MWPhysics
             int mask = CollisionType_Default, int group = 0xff) const override;
         using RayCastingInterface::castRay;
 
+        void asyncCastRay(std::function<void(const RayCastingResult&)> callback, const osg::Vec3f& from,
+            const osg::Vec3f& to, const std::vector<MWWorld::ConstPtr>& ignore = {}, int mask = CollisionType_Default,
+            int group = 0xff) const override;
+
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
@@ -288,8 +349,13 @@ namespace MWPhysics
     private:
         void updateWater();
 
+        std::vector<const btCollisionObject*> getCollisionObjects(const std::vector<MWWorld::ConstPtr>& ptrs) const;
+
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        /// Makes the settled actors standing on the object or touching the bounds move again
+        void wakeActors(const btCollisionObject& collisionObject, const MWWorld::ConstPtr& ptr);
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
@@ -297,7 +363,9 @@ namespace MWPhysics
         std::unique_ptr<PhysicsTaskScheduler> mTaskScheduler;
 
         std::unique_ptr<Resource::BulletShapeManager> mShapeManager;
+        std::unique_ptr<HeightFieldManager> mHeightFieldManager;
         Resource::ResourceSystem* mResourceSystem;
+        SceneUtil::UnrefQueue& mUnrefQueue;
 
         using ObjectMap = std::unordered_map<const MWWorld::LiveCellRefBase*, std::shared_ptr<Object>>;
         ObjectMap mObjects;
@@ -333,6 +401,8 @@ namespace MWPhysics
         std::size_t mSimulationsCounter = 0;
         std::array<std::vector<Simulation>, 2> mSimulations;
         std::vector<std::pair<MWWorld::Ptr, osg::Vec3f>> mActorsPositions;
+        std::size_t mActorsAwake = 0;
+        std::size_t mActorsSleeping = 0;
 
         PhysicsSystem(const PhysicsSystem&);
         PhysicsSystem& operator=(const PhysicsSystem&);
@@ -12,9 +12,10 @@
 
 namespace MWPhysics
 {
-    Projectile::Projectile(const MWWorld::Ptr& caster, const osg::Vec3f& position, float radius,
+    Projectile::Projectile(int id, const MWWorld::Ptr& caster, const osg::Vec3f& position, float radius,
         PhysicsTaskScheduler* scheduler, PhysicsSystem* physicssystem)
         : PtrHolder(MWWorld::Ptr(), position)
+        , mId(id)
         , mHitWater(false)
         , mActive(true)
         , mHitTarget(nullptr)
@@ -65,6 +66,7 @@ namespace MWPhysics
         mHitTarget = target;
         mHitPosition = pos;
         mHitNormal = normal;
+        mTaskScheduler->addProjectileHit(mId);
     }
 
     MWWorld::Ptr Projectile::getTarget() const
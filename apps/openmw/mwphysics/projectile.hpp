@@ -26,10 +26,12 @@ namespace MWPhysics
     class Projectile final : public PtrHolder
     {
     public:
-        Projectile(const MWWorld::Ptr& caster, const osg::Vec3f& position, float radius,
+        Projectile(int id, const MWWorld::Ptr& caster, const osg::Vec3f& position, float radius,
             PhysicsTaskScheduler* scheduler, PhysicsSystem* physicssystem);
         ~Projectile() override;
 
+        int getId() const { return mId; }
+
         btConvexShape* getConvexShape() const { return mConvexShape; }
 
         void updateCollisionObjectPosition();
@@ -54,6 +56,7 @@ namespace MWPhysics
         btVector3 getHitPosition() const { return mHitPosition; }
 
     private:
+        int mId;
         std::unique_ptr<btCollisionShape> mShape;
         btConvexShape* mConvexShape;
 
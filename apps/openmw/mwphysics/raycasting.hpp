@@ -1,6 +1,9 @@
 #ifndef OPENMW_MWPHYSICS_RAYCASTING_H
 #define OPENMW_MWPHYSICS_RAYCASTING_H
 
+#include <functional>
+#include <vector>
+
 #include <osg/Vec3f>
 
 #include "../mwworld/ptr.hpp"
@@ -34,6 +37,13 @@ namespace MWPhysics
             return castRay(from, to, {}, {}, mask);
         }
 
+        /// @brief cast the ray in parallel with the physics simulation instead of blocking the caller
+        /// @param callback called from the main thread with the result, at the latest two frames later
+        virtual void asyncCastRay(std::function<void(const RayCastingResult&)> callback, const osg::Vec3f& from,
+            const osg::Vec3f& to, const std::vector<MWWorld::ConstPtr>& ignore = {}, int mask = CollisionType_Default,
+            int group = 0xff) const
+            = 0;
+
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
@@ -261,6 +261,7 @@ namespace
     {
     public:
         bool mHasMagicEffects;
+        std::vector<osg::ref_ptr<MWRender::UpdateVfxCallback>> mRemovedCallbacks;
 
         RemoveFinishedCallbackVisitor()
             : RemoveVisitor()
@@ -282,7 +283,10 @@ namespace
                 if (vfxCallback)
                 {
                     if (vfxCallback->mFinished)
+                    {
                         mToRemove.emplace_back(group.asNode(), group.getParent(0));
+                        mRemovedCallbacks.emplace_back(vfxCallback);
+                    }
                     else
                         mHasMagicEffects = true;
                 }
@@ -298,6 +302,7 @@ namespace
     {
     public:
         bool mHasMagicEffects;
+        std::vector<osg::ref_ptr<MWRender::UpdateVfxCallback>> mRemovedCallbacks;
 
         RemoveCallbackVisitor()
             : RemoveVisitor()
@@ -326,7 +331,10 @@ namespace
                 {
                     bool toRemove = mEffectId == "" || vfxCallback->mParams.mEffectId == mEffectId;
                     if (toRemove)
+                    {
                         mToRemove.emplace_back(group.asNode(), group.getParent(0));
+                        mRemovedCallbacks.emplace_back(vfxCallback);
+                    }
                     else
                         mHasMagicEffects = true;
                 }
@@ -341,6 +349,22 @@ namespace
         std::string_view mEffectId;
     };
 
+    // Give the instances of removed effects back for reuse
+    void releaseEffectInstances(
+        const std::vector<osg::ref_ptr<MWRender::UpdateVfxCallback>>& callbacks, Resource::SceneManager& sceneManager)
+    {
+        for (const osg::ref_ptr<MWRender::UpdateVfxCallback>& callback : callbacks)
+        {
+            const MWRender::EffectParams& params = callback->mParams;
+            if (params.mInstance == nullptr)
+                continue;
+            const osg::Node::ParentList parents = params.mInstance->getParents();
+            for (osg::Group* parent : parents)
+                parent->removeChild(params.mInstance);
+            sceneManager.releaseInstance(params.mModelName, params.mPoolKey, params.mInstance);
+        }
+    }
+
     class FindVfxCallbacksVisitor : public osg::NodeVisitor
     {
     public:
@@ -549,6 +573,12 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    void Animation::setUpdateInterval(unsigned int interval, unsigned int phase)
+    {
+        if (mSkeleton)
+            mSkeleton->setUpdateInterval(interval, phase);
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr& ptr)
     {
         mPtr = ptr;
@@ -665,6 +695,7 @@ namespace MWRender
 
         for (const std::string& group : mAnimSources.back()->getTextKeys().getGroups())
             mSupportedAnimations.insert(group);
+        ++mAnimSourcesRevision;
 
         SceneUtil::AssignControllerSourcesVisitor assignVisitor(mAnimationTimePtr[0]);
         mObjectRoot->accept(assignVisitor);
@@ -706,6 +737,7 @@ namespace MWRender
 
         mSupportedAnimations.clear();
         mAnimSources.clear();
+        ++mAnimSourcesRevision;
 
         mAnimVelocities.clear();
     }
@@ -983,6 +1015,10 @@ namespace MWRender
 
     void Animation::resetActiveGroups()
     {
+        // Show the new animations immediately even if the skeleton is evaluated at a reduced rate
+        if (mSkeleton)
+            mSkeleton->forceUpdate();
+
         // remove all previous external controllers from the scene graph
         for (auto it = mActiveControllers.begin(); it != mActiveControllers.end(); ++it)
         {
@@ -1355,7 +1391,7 @@ namespace MWRender
     }
 
     osg::ref_ptr<osg::Node> getModelInstance(Resource::ResourceSystem* resourceSystem, const std::string& model,
-        bool baseonly, bool inject, const std::string& defaultSkeleton)
+        bool baseonly, bool inject, const std::string& defaultSkeleton, bool shareSubgraphs)
     {
         Resource::SceneManager* sceneMgr = resourceSystem->getSceneManager();
         if (baseonly)
@@ -1384,6 +1420,8 @@ namespace MWRender
             else
                 return sceneMgr->getInstance(found->second);
         }
+        else if (shareSubgraphs && !inject)
+            return sceneMgr->getInstanceSharingSubgraphs(model);
         else
         {
             osg::ref_ptr<osg::Node> created = sceneMgr->getInstance(model);
@@ -1398,7 +1436,8 @@ namespace MWRender
         }
     }
 
-    void Animation::setObjectRoot(const std::string& model, bool forceskeleton, bool baseonly, bool isCreature)
+    void Animation::setObjectRoot(
+        const std::string& model, bool forceskeleton, bool baseonly, bool isCreature, bool shareSubgraphs)
     {
         osg::ref_ptr<osg::StateSet> previousStateset;
         if (mObjectRoot)
@@ -1460,7 +1499,7 @@ namespace MWRender
         if (!forceskeleton)
         {
             osg::ref_ptr<osg::Node> created
-                = getModelInstance(mResourceSystem, model, baseonly, inject, defaultSkeleton);
+                = getModelInstance(mResourceSystem, model, baseonly, inject, defaultSkeleton, shareSubgraphs);
             mInsert->addChild(created);
             mObjectRoot = created->asGroup();
             if (!mObjectRoot)
@@ -1477,7 +1516,7 @@ namespace MWRender
         else
         {
             osg::ref_ptr<osg::Node> created
-                = getModelInstance(mResourceSystem, model, baseonly, inject, defaultSkeleton);
+                = getModelInstance(mResourceSystem, model, baseonly, inject, defaultSkeleton, shareSubgraphs);
             osg::ref_ptr<SceneUtil::Skeleton> skel = dynamic_cast<SceneUtil::Skeleton*>(created.get());
             if (!skel)
             {
@@ -1580,6 +1619,12 @@ namespace MWRender
             if (found == getNodeMap().end())
                 throw std::runtime_error("Can't find bone " + std::string{ bonename });
 
+            // Nodes shared by all instances of the model can't be attached to
+            for (osg::Node* node = found->second; node != mObjectRoot && node->getNumParents() > 0;
+                 node = node->getParent(0))
+                if (node->getNumParents() > 1)
+                    throw std::runtime_error("Can't attach to shared bone " + std::string{ bonename });
+
             parentNode = found->second;
         }
 
@@ -1601,19 +1646,30 @@ namespace MWRender
         }
         parentNode->addChild(trans);
 
-        osg::ref_ptr<osg::Node> node = mResourceSystem->getSceneManager()->getInstance(model, trans);
+        // The light model, node masks and texture override are kept by reused instances
+        params.mPoolKey = "attached vfx:";
+        params.mPoolKey += texture;
+        bool reused = false;
+        osg::ref_ptr<osg::Node> node
+            = mResourceSystem->getSceneManager()->getPooledInstance(model, params.mPoolKey, reused);
+        mResourceSystem->getSceneManager()->attachTo(node, trans);
+        params.mInstance = node;
 
-        // Morrowind has a white ambient light attached to the root VFX node of the scenegraph
-        node->getOrCreateStateSet()->setAttributeAndModes(
-            getVFXLightModelInstance(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
-        mResourceSystem->getSceneManager()->setUpNormalsRTForStateSet(node->getOrCreateStateSet(), false);
-        SceneUtil::FindMaxControllerLengthVisitor findMaxLengthVisitor;
-        node->accept(findMaxLengthVisitor);
+        if (!reused)
+        {
+            // Morrowind has a white ambient light attached to the root VFX node of the scenegraph
+            node->getOrCreateStateSet()->setAttributeAndModes(
+                getVFXLightModelInstance(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+            mResourceSystem->getSceneManager()->setUpNormalsRTForStateSet(node->getOrCreateStateSet(), false);
+
+            node->setNodeMask(Mask_Effect);
 
-        node->setNodeMask(Mask_Effect);
+            MarkDrawablesVisitor markVisitor(Mask_Effect);
+            node->accept(markVisitor);
+        }
 
-        MarkDrawablesVisitor markVisitor(Mask_Effect);
-        node->accept(markVisitor);
+        SceneUtil::FindMaxControllerLengthVisitor findMaxLengthVisitor;
+        node->accept(findMaxLengthVisitor);
 
         params.mMaxControllerLength = findMaxLengthVisitor.getMaxLength();
         params.mLoop = loop;
@@ -1629,7 +1685,8 @@ namespace MWRender
         // Notify that this animation has attached magic effects
         mHasMagicEffects = true;
 
-        overrideFirstRootTexture(texture, mResourceSystem, *node);
+        if (!reused)
+            overrideFirstRootTexture(texture, mResourceSystem, *node);
     }
 
     void Animation::removeEffect(std::string_view effectId)
@@ -1637,6 +1694,7 @@ namespace MWRender
         RemoveCallbackVisitor visitor(effectId);
         mInsert->accept(visitor);
         visitor.remove();
+        releaseEffectInstances(visitor.mRemovedCallbacks, *mResourceSystem->getSceneManager());
         mHasMagicEffects = visitor.mHasMagicEffects;
     }
 
@@ -1678,6 +1736,7 @@ namespace MWRender
         RemoveFinishedCallbackVisitor visitor;
         mInsert->accept(visitor);
         visitor.remove();
+        releaseEffectInstances(visitor.mRemovedCallbacks, *mResourceSystem->getSceneManager());
         mHasMagicEffects = visitor.mHasMagicEffects;
     }
 
@@ -1901,7 +1960,8 @@ namespace MWRender
     {
         if (!model.empty())
         {
-            setObjectRoot(model, false, false, false);
+            // Animation sources add controllers to the nodes of the model
+            setObjectRoot(model, false, false, false, !animated);
             if (animated)
                 addAnimSource(model, model);
 
@@ -91,6 +91,9 @@ namespace MWRender
         std::string mEffectId;
         bool mLoop;
         std::string mBoneName;
+        // Given back to the scene manager for reuse when the effect is removed
+        osg::ref_ptr<osg::Node> mInstance;
+        std::string mPoolKey;
     };
 
     class Animation : public osg::Referenced
@@ -171,6 +174,7 @@ namespace MWRender
         AnimSourceList mAnimSources;
 
         std::unordered_set<std::string_view> mSupportedAnimations;
+        std::size_t mAnimSourcesRevision = 0;
 
         osg::ref_ptr<osg::Group> mInsert;
 
@@ -263,8 +267,11 @@ namespace MWRender
          * @param baseonly If true, then any meshes or particle systems in the model are ignored
          *      (useful for NPCs, where only the skeleton is needed for the root, and the actual NPC parts are then
          * assembled from separate files).
+         * @param shareSubgraphs Share the parts of the model that are the same for every instance, only if nothing
+         *      below the object root is changed or attached to.
          */
-        void setObjectRoot(const std::string& model, bool forceskeleton, bool baseonly, bool isCreature);
+        void setObjectRoot(
+            const std::string& model, bool forceskeleton, bool baseonly, bool isCreature, bool shareSubgraphs = false);
 
         void loadAllAnimationsInFolder(const std::string& model, const std::string& baseModel);
 
@@ -307,6 +314,10 @@ namespace MWRender
         /// 0 = Inactive, 1 = Active in place, 2 = Active
         void setActive(int active);
 
+        /// Evaluate the skeleton only on every interval-th frame, if one exists.
+        /// @see SceneUtil::Skeleton::setUpdateInterval
+        void setUpdateInterval(unsigned int interval, unsigned int phase);
+
         osg::Group* getOrCreateObjectRoot();
 
         osg::Group* getObjectRoot();
@@ -335,6 +346,9 @@ namespace MWRender
 
         bool hasAnimation(std::string_view anim) const;
 
+        /// Changes every time animation sources are added or cleared, so the set of supported animations may change
+        std::size_t getAnimSourcesRevision() const { return mAnimSourcesRevision; }
+
         bool isLoopingAnimation(std::string_view group) const;
 
         // Specifies the axis' to accumulate on. Non-accumulated axis will just
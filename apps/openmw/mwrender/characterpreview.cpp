@@ -1,5 +1,6 @@
 #include "characterpreview.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include <osg/BlendFunc>
@@ -25,6 +26,7 @@
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/stereo/multiview.hpp>
 
 #include "../mwworld/class.hpp"
@@ -153,16 +155,24 @@ namespace MWRender
         static constexpr float zfar = 10000.f;
 
     public:
-        CharacterPreviewRTTNode(uint32_t sizeX, uint32_t sizeY)
+        /// @param referenceSizeX,referenceSizeY Size of the full view, the texture only shows its top left part if
+        /// smaller, at the same scale.
+        CharacterPreviewRTTNode(uint32_t sizeX, uint32_t sizeY, uint32_t referenceSizeX, uint32_t referenceSizeY)
             : RTTNode(sizeX, sizeY, Settings::video().mAntialiasing, false, 0,
                 StereoAwareness::Unaware_MultiViewShaders, shouldAddMSAAIntermediateTarget())
-            , mAspectRatio(static_cast<float>(sizeX) / static_cast<float>(sizeY))
+            , mAspectRatio(static_cast<float>(referenceSizeX) / static_cast<float>(referenceSizeY))
         {
+            // Map the top left part of the reference view to the whole clip space
+            const float scaleX = static_cast<float>(referenceSizeX) / static_cast<float>(sizeX);
+            const float scaleY = static_cast<float>(referenceSizeY) / static_cast<float>(sizeY);
+            mCropMatrix = osg::Matrixf::scale(scaleX, scaleY, 1.f) * osg::Matrixf::translate(scaleX - 1, 1 - scaleY, 0);
+
             if (SceneUtil::AutoDepth::isReversed())
                 mPerspectiveMatrix = static_cast<osg::Matrixf>(
                     SceneUtil::getReversedZProjectionMatrixAsPerspective(fovYDegrees, mAspectRatio, znear, zfar));
             else
                 mPerspectiveMatrix = osg::Matrixf::perspective(fovYDegrees, mAspectRatio, znear, zfar);
+            mPerspectiveMatrix *= mCropMatrix;
             mGroup->getOrCreateStateSet()->addUniform(new osg::Uniform("projectionMatrix", mPerspectiveMatrix));
             mViewMatrix = osg::Matrixf::identity();
             setColorBufferInternalFormat(GL_RGBA);
@@ -176,7 +186,7 @@ namespace MWRender
             camera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT, osg::Camera::PIXEL_BUFFER_RTT);
             camera->setClearColor(osg::Vec4(0.f, 0.f, 0.f, 0.f));
             camera->setClearMask(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-            camera->setProjectionMatrixAsPerspective(fovYDegrees, mAspectRatio, znear, zfar);
+            camera->setProjectionMatrix(osg::Matrix::perspective(fovYDegrees, mAspectRatio, znear, zfar) * mCropMatrix);
             camera->setViewport(0, 0, width(), height());
             camera->setRenderOrder(osg::Camera::PRE_RENDER);
             camera->setCullMask(~(Mask_UpdateVisitor));
@@ -204,6 +214,7 @@ namespace MWRender
         void setViewMatrix(const osg::Matrixf& viewMatrix) { mViewMatrix = viewMatrix; }
 
         osg::ref_ptr<osg::Group> mGroup = new osg::Group;
+        osg::Matrixf mCropMatrix;
         osg::Matrixf mPerspectiveMatrix;
         osg::Matrixf mViewMatrix;
         osg::ref_ptr<osg::StateSet> mCameraStateset;
@@ -220,11 +231,13 @@ namespace MWRender
         , mAnimation(nullptr)
         , mSizeX(sizeX)
         , mSizeY(sizeY)
+        , mReferenceSizeX(sizeX)
+        , mReferenceSizeY(sizeY)
     {
         mTextureStateSet = new osg::StateSet;
         mTextureStateSet->setAttribute(new osg::BlendFunc(osg::BlendFunc::ONE, osg::BlendFunc::ONE_MINUS_SRC_ALPHA));
 
-        mRTTNode = new CharacterPreviewRTTNode(sizeX, sizeY);
+        mRTTNode = new CharacterPreviewRTTNode(sizeX, sizeY, sizeX, sizeY);
         mRTTNode->setNodeMask(Mask_RenderToTexture);
 
         osg::ref_ptr<SceneUtil::LightManager> lightManager = new SceneUtil::LightManager(SceneUtil::LightSettings{
@@ -235,6 +248,10 @@ namespace MWRender
             .mLightBoundsMultiplier = Settings::shaders().mLightBoundsMultiplier,
         });
         lightManager->setStartLight(1);
+        if (lightManager->getLightingMethod() == SceneUtil::LightingMethod::Clustered)
+            lightManager->setLightClustersTextureUnit(
+                mResourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::LightClusters, 2));
         osg::ref_ptr<osg::StateSet> stateset = lightManager->getOrCreateStateSet();
         stateset->setDefine("FORCE_OPAQUE", "1", osg::StateAttribute::ON);
         stateset->setMode(GL_LIGHTING, osg::StateAttribute::ON);
@@ -387,11 +404,40 @@ namespace MWRender
         mDrawOnceCallback->redrawNextFrame();
     }
 
+    void CharacterPreview::setTextureSize(int sizeX, int sizeY)
+    {
+        sizeX = std::clamp(sizeX, 1, mReferenceSizeX);
+        sizeY = std::clamp(sizeY, 1, mReferenceSizeY);
+        if (sizeX == mSizeX && sizeY == mSizeY)
+            return;
+
+        osg::ref_ptr<CharacterPreviewRTTNode> rttNode
+            = new CharacterPreviewRTTNode(sizeX, sizeY, mReferenceSizeX, mReferenceSizeY);
+        rttNode->setNodeMask(Mask_RenderToTexture);
+        rttNode->setViewMatrix(mRTTNode->mViewMatrix);
+        rttNode->setCameraStateset(mRTTNode->mCameraStateset);
+        for (unsigned int i = 0; i < mRTTNode->mGroup->getNumChildren(); ++i)
+            rttNode->addChild(mRTTNode->mGroup->getChild(i));
+
+        mDrawOnceCallback = new DrawOnceCallback(rttNode->mGroup);
+        rttNode->addUpdateCallback(mDrawOnceCallback);
+
+        mParent->removeChild(mRTTNode);
+        mRTTNode = std::move(rttNode);
+        mParent->addChild(mRTTNode);
+
+        mSizeX = sizeX;
+        mSizeY = sizeY;
+
+        redraw();
+    }
+
     // --------------------------------------------------------------------------------------------------
 
     InventoryPreview::InventoryPreview(
         osg::Group* parent, Resource::ResourceSystem* resourceSystem, const MWWorld::Ptr& character)
-        : CharacterPreview(parent, resourceSystem, character, 512, 1024, osg::Vec3f(0, 700, 71), osg::Vec3f(0, 0, 71))
+        : CharacterPreview(parent, resourceSystem, character, sMaxViewportWidth, sMaxViewportHeight,
+            osg::Vec3f(0, 700, 71), osg::Vec3f(0, 0, 71))
     {
     }
 
@@ -400,6 +446,18 @@ namespace MWRender
         sizeX = std::max(sizeX, 0);
         sizeY = std::max(sizeY, 0);
 
+        // Render no more than the widget shows, but round the texture size up to avoid reallocating it for every small
+        // change while the window is resized
+        constexpr int textureSizeStep = 64;
+        const auto roundUp = [](int size) { return (size + textureSizeStep - 1) / textureSizeStep * textureSizeStep; };
+        const int oldSizeX = mSizeX;
+        const int oldSizeY = mSizeY;
+        setTextureSize(roundUp(sizeX), roundUp(sizeY));
+
+        if (mViewport && mSizeX == oldSizeX && mSizeY == oldSizeY && mViewport->width() == std::min(mSizeX, sizeX)
+            && mViewport->height() == std::min(mSizeY, sizeY))
+            return;
+
         // NB Camera::setViewport has threading issues
         osg::ref_ptr<osg::StateSet> stateset = new osg::StateSet;
         mViewport = new osg::Viewport(0, mSizeY - sizeY, std::min(mSizeX, sizeX), std::min(mSizeY, sizeY));
@@ -480,8 +538,9 @@ namespace MWRender
     {
         if (!mViewport)
             return -1;
-        float projX = (posX / mViewport->width()) * 2 - 1.f;
-        float projY = (posY / mViewport->height()) * 2 - 1.f;
+        // The viewport is at the top left of the texture, which the projection covers entirely
+        float projX = (posX / static_cast<float>(mSizeX)) * 2 - 1.f;
+        float projY = ((posY + mSizeY - mViewport->height()) / static_cast<float>(mSizeY)) * 2 - 1.f;
         // With Intersector::WINDOW, the intersection ratios are slightly inaccurate. Seems to be a
         // precision issue - compiling with OSG_USE_FLOAT_MATRIX=0, Intersector::WINDOW works ok.
         // Using Intersector::PROJECTION results in better precision because the start/end points and the model matrices
@@ -55,6 +55,11 @@ namespace MWRender
         void setBlendMode();
         virtual void onSetup();
 
+        /// Render into a texture of the given size, showing the top left part of the view at the same scale. Can not be
+        /// larger than the size the preview was created with.
+        /// @note Replaces the texture returned by getTexture().
+        void setTextureSize(int sizeX, int sizeY);
+
         osg::ref_ptr<osg::Group> mParent;
         Resource::ResourceSystem* mResourceSystem;
         osg::ref_ptr<osg::StateSet> mTextureStateSet;
@@ -72,6 +77,8 @@ namespace MWRender
 
         int mSizeX;
         int mSizeY;
+        int mReferenceSizeX;
+        int mReferenceSizeY;
     };
 
     class InventoryPreview : public CharacterPreview
@@ -81,7 +88,12 @@ namespace MWRender
 
         void updatePtr(const MWWorld::Ptr& ptr);
 
+        static constexpr int sMaxViewportWidth = 512;
+        static constexpr int sMaxViewportHeight = 1024;
+
         void update(); // Render preview again, e.g. after changed equipment
+        /// @note Resizes the texture to fit the viewport, so getTexture() has to be called again when getTextureWidth()
+        /// or getTextureHeight() change.
         void setViewport(int sizeX, int sizeY);
 
         int getSlotSelected(int posX, int posY);
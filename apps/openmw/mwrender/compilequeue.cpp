@@ -0,0 +1,77 @@
+#include "compilequeue.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace MWRender
+{
+    class CompileQueue::CompletedCallback : public osgUtil::IncrementalCompileOperation::CompileCompletedCallback
+    {
+    public:
+        bool compileCompleted(osgUtil::IncrementalCompileOperation::CompileSet* /*compileSet*/) override
+        {
+            mCompleted = true;
+            // The node is already attached, there is nothing for the IncrementalCompileOperation to merge
+            return true;
+        }
+
+        bool isCompleted() const { return mCompleted; }
+
+    private:
+        std::atomic_bool mCompleted{ false };
+    };
+
+    CompileQueue::CompileQueue(osgUtil::IncrementalCompileOperation& ico)
+        : mIncrementalCompileOperation(&ico)
+    {
+    }
+
+    CompileQueue::~CompileQueue()
+    {
+        for (const Item& item : mItems)
+            mIncrementalCompileOperation->remove(item.mCompileSet);
+    }
+
+    void CompileQueue::add(osg::Node& node)
+    {
+        if (mIncrementalCompileOperation->getContextSet().empty())
+            return;
+
+        osg::ref_ptr<osgUtil::IncrementalCompileOperation::CompileSet> compileSet
+            = new osgUtil::IncrementalCompileOperation::CompileSet(&node);
+        // Must be collected before hiding the node, the visitor doesn't traverse nodes with a zero node mask
+        compileSet->buildCompileMap(mIncrementalCompileOperation->getContextSet());
+        if (compileSet->compileCompleted())
+            return;
+
+        osg::ref_ptr<CompletedCallback> callback = new CompletedCallback;
+        compileSet->_compileCompletedCallback = callback;
+
+        mItems.push_back(Item{ &node, node.getNodeMask(), compileSet, callback });
+        node.setNodeMask(0);
+
+        mIncrementalCompileOperation->add(compileSet, false);
+    }
+
+    void CompileQueue::remove(const osg::Node& node)
+    {
+        const auto it
+            = std::find_if(mItems.begin(), mItems.end(), [&](const Item& item) { return item.mNode == &node; });
+        if (it == mItems.end())
+            return;
+        mIncrementalCompileOperation->remove(it->mCompileSet);
+        it->mNode->setNodeMask(it->mNodeMask);
+        mItems.erase(it);
+    }
+
+    std::size_t CompileQueue::update()
+    {
+        const auto completed = std::stable_partition(
+            mItems.begin(), mItems.end(), [](const Item& item) { return !item.mCallback->isCompleted(); });
+        const std::size_t count = static_cast<std::size_t>(mItems.end() - completed);
+        for (auto it = completed; it != mItems.end(); ++it)
+            it->mNode->setNodeMask(it->mNodeMask);
+        mItems.erase(completed, mItems.end());
+        return count;
+    }
+}
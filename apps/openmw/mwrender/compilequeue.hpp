@@ -0,0 +1,53 @@
+#ifndef OPENMW_MWRENDER_COMPILEQUEUE_H
+#define OPENMW_MWRENDER_COMPILEQUEUE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <osg/Node>
+#include <osg/ref_ptr>
+
+#include <osgUtil/IncrementalCompileOperation>
+
+namespace MWRender
+{
+    /// @brief Keeps newly attached subgraphs hidden until the IncrementalCompileOperation has uploaded their textures,
+    /// buffers and programs. The uploads are spread over several frames within the compile time budget of the
+    /// operation instead of stalling the first frame the subgraphs are drawn in.
+    class CompileQueue
+    {
+    public:
+        explicit CompileQueue(osgUtil::IncrementalCompileOperation& ico);
+
+        ~CompileQueue();
+
+        /// Hide the node until its GL objects are compiled. The node keeps being shown when there is no graphics
+        /// context to compile for.
+        void add(osg::Node& node);
+
+        /// Stop tracking the node, e.g. before it is removed from the scene. It is shown again.
+        void remove(const osg::Node& node);
+
+        /// Show the nodes whose compilation completed. Call once per frame from the update thread.
+        /// @return The number of nodes shown.
+        std::size_t update();
+
+        std::size_t size() const { return mItems.size(); }
+
+    private:
+        class CompletedCallback;
+
+        struct Item
+        {
+            osg::ref_ptr<osg::Node> mNode;
+            osg::Node::NodeMask mNodeMask;
+            osg::ref_ptr<osgUtil::IncrementalCompileOperation::CompileSet> mCompileSet;
+            osg::ref_ptr<CompletedCallback> mCallback;
+        };
+
+        osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
+        std::vector<Item> mItems;
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "dynamicresolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MWRender
+{
+    namespace
+    {
+        // Weight of a new frame in the smoothed frame time
+        constexpr double averageWeight = 0.1;
+
+        // The scale goes up only when the frames are expected to take less than this share of the target after
+        constexpr double headroom = 0.85;
+
+        float roundToStep(float scale)
+        {
+            return std::round(scale / DynamicResolution::sScaleStep) * DynamicResolution::sScaleStep;
+        }
+    }
+
+    DynamicResolution::DynamicResolution(float minScale, float maxScale, double targetTime)
+        : mMinScale(roundToStep(std::min(minScale, maxScale)))
+        , mMaxScale(roundToStep(maxScale))
+        , mTargetTime(targetTime)
+        , mScale(mMaxScale)
+    {
+    }
+
+    bool DynamicResolution::update(double gpuTime)
+    {
+        if (gpuTime <= 0)
+            return false;
+
+        mAverageTime = mFrames == 0 ? gpuTime : mAverageTime + (gpuTime - mAverageTime) * averageWeight;
+        ++mFrames;
+        if (++mFramesSinceChange < sFramesBetweenChanges)
+            return false;
+
+        // The GPU time is mostly proportional to the number of the rendered pixels
+        const double idealScale = mScale * std::sqrt(mTargetTime / mAverageTime);
+        float scale = mScale;
+        if (mAverageTime > mTargetTime)
+            scale = std::max(
+                mMinScale, std::min(roundToStep(mScale - sScaleStep), roundToStep(static_cast<float>(idealScale))));
+        else if (mScale < mMaxScale)
+        {
+            const float next = std::min(mMaxScale, roundToStep(mScale + sScaleStep));
+            const double expectedTime = mAverageTime * (next * next) / (mScale * mScale);
+            if (expectedTime < mTargetTime * headroom)
+                scale = next;
+        }
+
+        if (scale == mScale)
+            return false;
+
+        // The times measured at the previous scale would drive the next change otherwise
+        mAverageTime *= (scale * scale) / (mScale * mScale);
+        mScale = scale;
+        mFramesSinceChange = 0;
+        return true;
+    }
+}
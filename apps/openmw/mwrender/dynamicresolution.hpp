@@ -0,0 +1,38 @@
+#ifndef OPENMW_MWRENDER_DYNAMICRESOLUTION_H
+#define OPENMW_MWRENDER_DYNAMICRESOLUTION_H
+
+namespace MWRender
+{
+    /// @brief Picks the scale of the internal render resolution from the GPU frame times to keep them under the
+    /// target.
+    /// @par The frame times are smoothed and the scale changes in fixed steps, not sooner than a number of frames
+    /// after the previous change. The scale goes down as soon as the frames take longer than the target but goes up
+    /// only when there is enough headroom for the frames rendered at the new scale, so it doesn't oscillate between
+    /// two steps.
+    class DynamicResolution
+    {
+    public:
+        static constexpr float sScaleStep = 0.05f;
+        static constexpr unsigned sFramesBetweenChanges = 30;
+
+        /// @param targetTime The GPU frame time to stay under in seconds.
+        explicit DynamicResolution(float minScale, float maxScale, double targetTime);
+
+        /// Feed the GPU time of a frame in seconds.
+        /// @return Whether the scale has changed.
+        bool update(double gpuTime);
+
+        float getScale() const { return mScale; }
+
+    private:
+        float mMinScale;
+        float mMaxScale;
+        double mTargetTime;
+        float mScale;
+        double mAverageTime = 0;
+        unsigned mFrames = 0;
+        unsigned mFramesSinceChange = 0;
+    };
+}
+
+#endif
@@ -30,12 +30,19 @@ namespace MWRender
     void EffectManager::addEffect(const std::string& model, std::string_view textureOverride,
         const osg::Vec3f& worldPosition, float scale, bool isMagicVFX)
     {
-        osg::ref_ptr<osg::Node> node = mResourceSystem->getSceneManager()->getInstance(model);
+        // The texture override is kept by reused instances
+        std::string poolKey = isMagicVFX ? "free vfx:" : "free:";
+        poolKey += textureOverride;
+        bool reused = false;
+        osg::ref_ptr<osg::Node> node = mResourceSystem->getSceneManager()->getPooledInstance(model, poolKey, reused);
 
         node->setNodeMask(Mask_Effect);
 
         Effect effect;
         effect.mAnimTime = std::make_shared<EffectAnimationTime>();
+        effect.mInstance = node;
+        effect.mModel = model;
+        effect.mPoolKey = std::move(poolKey);
 
         SceneUtil::FindMaxControllerLengthVisitor findMaxLengthVisitor;
         node->accept(findMaxLengthVisitor);
@@ -51,10 +58,13 @@ namespace MWRender
         SceneUtil::AssignControllerSourcesVisitor assignVisitor(effect.mAnimTime);
         node->accept(assignVisitor);
 
-        if (isMagicVFX)
-            overrideFirstRootTexture(textureOverride, mResourceSystem, *node);
-        else
-            overrideTexture(textureOverride, mResourceSystem, *node);
+        if (!reused)
+        {
+            if (isMagicVFX)
+                overrideFirstRootTexture(textureOverride, mResourceSystem, *node);
+            else
+                overrideTexture(textureOverride, mResourceSystem, *node);
+        }
 
         mParentNode->addChild(trans);
 
@@ -68,7 +78,7 @@ namespace MWRender
                                effect.mAnimTime->addTime(dt);
                                const auto remove = effect.mAnimTime->getTime() >= effect.mMaxControllerLength;
                                if (remove)
-                                   mParentNode->removeChild(effect.mTransform);
+                                   removeEffect(effect);
                                return remove;
                            }),
             mEffects.end());
@@ -78,9 +88,16 @@ namespace MWRender
     {
         for (const auto& effect : mEffects)
         {
-            mParentNode->removeChild(effect.mTransform);
+            removeEffect(effect);
         }
         mEffects.clear();
     }
 
+    void EffectManager::removeEffect(const Effect& effect)
+    {
+        mParentNode->removeChild(effect.mTransform);
+        effect.mTransform->removeChild(effect.mInstance);
+        mResourceSystem->getSceneManager()->releaseInstance(effect.mModel, effect.mPoolKey, effect.mInstance);
+    }
+
 }
@@ -10,6 +10,7 @@
 namespace osg
 {
     class Group;
+    class Node;
     class Vec3f;
     class PositionAttitudeTransform;
 }
@@ -47,10 +48,15 @@ namespace MWRender
             float mMaxControllerLength;
             std::shared_ptr<EffectAnimationTime> mAnimTime;
             osg::ref_ptr<osg::PositionAttitudeTransform> mTransform;
+            osg::ref_ptr<osg::Node> mInstance;
+            std::string mModel;
+            std::string mPoolKey;
         };
 
         std::vector<Effect> mEffects;
 
+        void removeEffect(const Effect& effect);
+
         osg::ref_ptr<osg::Group> mParentNode;
         Resource::ResourceSystem* mResourceSystem;
     };
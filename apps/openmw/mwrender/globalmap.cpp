@@ -253,10 +253,12 @@ namespace MWRender
     struct GlobalMap::WritePng final : public SceneUtil::WorkItem
     {
         osg::ref_ptr<const osg::Image> mOverlayImage;
+        std::size_t mRevision;
         std::vector<char> mImageData;
 
-        explicit WritePng(osg::ref_ptr<const osg::Image> overlayImage)
+        explicit WritePng(osg::ref_ptr<const osg::Image> overlayImage, std::size_t revision)
             : mOverlayImage(std::move(overlayImage))
+            , mRevision(revision)
         {
         }
 
@@ -431,6 +433,7 @@ namespace MWRender
         ensureLoaded();
 
         memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
+        ++mOverlayRevision;
 
         mPendingImageDest.clear();
 
@@ -451,12 +454,21 @@ namespace MWRender
         if (mWritePng != nullptr)
         {
             mWritePng->waitTillDone();
-            map.mImageData = std::move(mWritePng->mImageData);
+            if (mWritePng->mRevision == mOverlayRevision)
+            {
+                mOverlayPng = std::move(mWritePng->mImageData);
+                mOverlayPngRevision = mOverlayRevision;
+            }
             mWritePng = nullptr;
-            return;
         }
 
-        map.mImageData = writePng(*mOverlayImage);
+        if (mOverlayPngRevision != mOverlayRevision)
+        {
+            mOverlayPng = writePng(*mOverlayImage);
+            mOverlayPngRevision = mOverlayRevision;
+        }
+
+        map.mImageData = mOverlayPng;
     }
 
     struct Box
@@ -554,6 +566,7 @@ namespace MWRender
         if (srcBox == destBox && imageWidth == mWidth && imageHeight == mHeight)
         {
             mOverlayImage = image;
+            ++mOverlayRevision;
 
             requestOverlayTextureUpdate(0, 0, mWidth, mHeight, std::move(texture), true, false);
         }
@@ -591,6 +604,7 @@ namespace MWRender
             mBaseTexture = mWorkItem->mBaseTexture;
             mAlphaTexture = mWorkItem->mAlphaTexture;
             mOverlayTexture = mWorkItem->mOverlayTexture;
+            ++mOverlayRevision;
 
             requestOverlayTextureUpdate(0, 0, mWidth, mHeight, osg::ref_ptr<osg::Texture2D>(), true, false);
 
@@ -616,6 +630,7 @@ namespace MWRender
             }
 
             mOverlayImage->copySubImage(imageDest.mX, imageDest.mY, 0, imageDest.mImage);
+            ++mOverlayRevision;
             mPendingImageDest.erase(it);
             return true;
         }
@@ -651,8 +666,11 @@ namespace MWRender
     {
         if (mOverlayImage == nullptr)
             return;
+        // Nothing was explored since the image was last encoded
+        if (mOverlayPngRevision == mOverlayRevision)
+            return;
         // Use deep copy to avoid any sychronization
-        mWritePng = new WritePng(new osg::Image(*mOverlayImage, osg::CopyOp::DEEP_COPY_ALL));
-        mWorkQueue->addWorkItem(mWritePng, /*front=*/true);
+        mWritePng = new WritePng(new osg::Image(*mOverlayImage, osg::CopyOp::DEEP_COPY_ALL), mOverlayRevision);
+        mWorkQueue->addWorkItem(mWritePng, SceneUtil::WorkPriority::Urgent);
     }
 }
@@ -1,7 +1,9 @@
 #ifndef GAME_RENDER_GLOBALMAP_H
 #define GAME_RENDER_GLOBALMAP_H
 
+#include <cstddef>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -125,6 +127,11 @@ namespace MWRender
         osg::ref_ptr<CreateMapWorkItem> mWorkItem;
         osg::ref_ptr<WritePng> mWritePng;
 
+        // Incremented on every change of mOverlayImage, the encoded image is reused while it stays the same
+        std::size_t mOverlayRevision = 0;
+        std::vector<char> mOverlayPng;
+        std::optional<std::size_t> mOverlayPngRevision;
+
         int mWidth;
         int mHeight;
 
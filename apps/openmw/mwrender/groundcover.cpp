@@ -8,9 +8,8 @@
 #include <osg/VertexAttribDivisor>
 #include <osgUtil/CullVisitor>
 
-#include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadland.hpp>
-#include <components/esm3/readerscache.hpp>
+#include <components/esm3/sharedreaders.hpp>
 #include <components/misc/convert.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/nodecallback.hpp>
@@ -20,21 +19,13 @@
 
 #include "../mwworld/groundcoverstore.hpp"
 
+#include "instancing.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
 {
     namespace
     {
-        using value_type = osgUtil::CullVisitor::value_type;
-
-        // From OSG's CullVisitor.cpp
-        inline value_type distance(const osg::Vec3& coord, const osg::Matrix& matrix)
-        {
-            return -((value_type)coord[0] * (value_type)matrix(0, 2) + (value_type)coord[1] * (value_type)matrix(1, 2)
-                + (value_type)coord[2] * (value_type)matrix(2, 2) + matrix(3, 2));
-        }
-
         inline osg::Matrix computeInstanceMatrix(
             const Groundcover::GroundcoverEntry& entry, const osg::Vec3& chunkPosition)
         {
@@ -43,159 +34,27 @@ namespace MWRender
                 * osg::Matrix::translate(entry.mPos.asVec3() - chunkPosition);
         }
 
-        class InstancedComputeNearFarCullCallback : public osg::DrawableCullCallback
-        {
-        public:
-            InstancedComputeNearFarCullCallback(const std::vector<Groundcover::GroundcoverEntry>& instances,
-                const osg::Vec3& chunkPosition, const osg::BoundingBox& instanceBounds)
-                : mInstanceMatrices()
-                , mInstanceBounds(instanceBounds)
-            {
-                mInstanceMatrices.reserve(instances.size());
-                for (const auto& instance : instances)
-                    mInstanceMatrices.emplace_back(computeInstanceMatrix(instance, chunkPosition));
-            }
-
-            bool cull(osg::NodeVisitor* nv, osg::Drawable* drawable, osg::RenderInfo* renderInfo) const override
-            {
-                osgUtil::CullVisitor& cullVisitor = *nv->asCullVisitor();
-                osg::CullSettings::ComputeNearFarMode cnfMode = cullVisitor.getComputeNearFarMode();
-                const osg::BoundingBox& boundingBox = drawable->getBoundingBox();
-                osg::RefMatrix& matrix = *cullVisitor.getModelViewMatrix();
-
-                if (cnfMode != osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES
-                    && cnfMode != osg::CullSettings::COMPUTE_NEAR_USING_PRIMITIVES)
-                    return false;
-
-                if (drawable->isCullingActive() && cullVisitor.isCulled(boundingBox))
-                    return true;
-
-                osg::Vec3 lookVector = cullVisitor.getLookVectorLocal();
-                unsigned int bbCornerFar
-                    = (lookVector.x() >= 0 ? 1 : 0) | (lookVector.y() >= 0 ? 2 : 0) | (lookVector.z() >= 0 ? 4 : 0);
-                unsigned int bbCornerNear = (~bbCornerFar) & 7;
-                value_type dNear = distance(boundingBox.corner(bbCornerNear), matrix);
-                value_type dFar = distance(boundingBox.corner(bbCornerFar), matrix);
-
-                if (dNear > dFar)
-                    std::swap(dNear, dFar);
-
-                if (dFar < 0)
-                    return true;
-
-                value_type computedZNear = cullVisitor.getCalculatedNearPlane();
-                value_type computedZFar = cullVisitor.getCalculatedFarPlane();
-
-                if (dNear < computedZNear || dFar > computedZFar)
-                {
-                    osg::Polytope frustum;
-                    osg::Polytope::ClippingMask resultMask
-                        = cullVisitor.getCurrentCullingSet().getFrustum().getResultMask();
-                    if (resultMask)
-                    {
-                        // Other objects are likely cheaper and should let us skip all but a few groundcover instances
-                        cullVisitor.computeNearPlane();
-                        computedZNear = cullVisitor.getCalculatedNearPlane();
-                        computedZFar = cullVisitor.getCalculatedFarPlane();
-
-                        if (dNear < computedZNear)
-                        {
-                            dNear = computedZNear;
-                            for (const auto& instanceMatrix : mInstanceMatrices)
-                            {
-                                osg::Matrix fullMatrix = instanceMatrix * matrix;
-                                osg::Vec3 instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
-                                unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
-                                    | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
-                                unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
-                                value_type instanceDNear
-                                    = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
-                                value_type instanceDFar
-                                    = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
-
-                                if (instanceDNear > instanceDFar)
-                                    std::swap(instanceDNear, instanceDFar);
-
-                                if (instanceDFar < 0 || instanceDNear > dNear)
-                                    continue;
-
-                                frustum.setAndTransformProvidingInverse(
-                                    cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
-                                osg::Polytope::PlaneList planes;
-                                osg::Polytope::ClippingMask selectorMask = 0x1;
-                                for (const auto& plane : frustum.getPlaneList())
-                                {
-                                    if (resultMask & selectorMask)
-                                        planes.push_back(plane);
-                                    selectorMask <<= 1;
-                                }
-
-                                value_type newNear
-                                    = cullVisitor.computeNearestPointInFrustum(fullMatrix, planes, *drawable);
-                                dNear = std::min(dNear, newNear);
-                            }
-                            if (dNear < computedZNear)
-                                cullVisitor.setCalculatedNearPlane(dNear);
-                        }
-
-                        if (cnfMode == osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES && dFar > computedZFar)
-                        {
-                            dFar = computedZFar;
-                            for (const auto& instanceMatrix : mInstanceMatrices)
-                            {
-                                osg::Matrix fullMatrix = instanceMatrix * matrix;
-                                osg::Vec3 instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
-                                unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
-                                    | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
-                                unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
-                                value_type instanceDNear
-                                    = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
-                                value_type instanceDFar
-                                    = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
-
-                                if (instanceDNear > instanceDFar)
-                                    std::swap(instanceDNear, instanceDFar);
-
-                                if (instanceDFar < 0 || instanceDFar < dFar)
-                                    continue;
-
-                                frustum.setAndTransformProvidingInverse(
-                                    cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
-                                osg::Polytope::PlaneList planes;
-                                osg::Polytope::ClippingMask selectorMask = 0x1;
-                                for (const auto& plane : frustum.getPlaneList())
-                                {
-                                    if (resultMask & selectorMask)
-                                        planes.push_back(plane);
-                                    selectorMask <<= 1;
-                                }
-
-                                value_type newFar = cullVisitor.computeFurthestPointInFrustum(
-                                    instanceMatrix * matrix, planes, *drawable);
-                                dFar = std::max(dFar, newFar);
-                            }
-                            if (dFar > computedZFar)
-                                cullVisitor.setCalculatedFarPlane(dFar);
-                        }
-                    }
-                }
-
-                return false;
-            }
-
-        private:
-            std::vector<osg::Matrix> mInstanceMatrices;
-            osg::BoundingBox mInstanceBounds;
-        };
-
+        /// Converts the geometries of a model into instanced ones. The instance data is built and uploaded once for
+        /// all of them.
         class InstancingVisitor : public osg::NodeVisitor
         {
         public:
-            InstancingVisitor(std::vector<Groundcover::GroundcoverEntry>& instances, osg::Vec3f& chunkPosition)
+            InstancingVisitor(
+                const std::vector<Groundcover::GroundcoverEntry>& instances, const osg::Vec3f& chunkPosition)
                 : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
-                , mInstances(instances)
-                , mChunkPosition(chunkPosition)
+                , mTransforms(new osg::Vec4Array(instances.size()))
+                , mRotations(new osg::Vec3Array(instances.size()))
             {
+                auto instanceMatrices = std::make_shared<std::vector<osg::Matrix>>();
+                instanceMatrices->reserve(instances.size());
+                for (std::size_t i = 0; i < instances.size(); ++i)
+                {
+                    const Groundcover::GroundcoverEntry& instance = instances[i];
+                    (*mTransforms)[i] = osg::Vec4f(instance.mPos.asVec3() - chunkPosition, instance.mScale);
+                    (*mRotations)[i] = instance.mPos.asRotationVec3();
+                    instanceMatrices->push_back(computeInstanceMatrix(instance, chunkPosition));
+                }
+                mInstanceMatrices = std::move(instanceMatrices);
             }
 
             void apply(osg::Group& group) override
@@ -214,46 +73,37 @@ namespace MWRender
             {
                 for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i)
                 {
-                    geom.getPrimitiveSet(i)->setNumInstances(mInstances.size());
+                    geom.getPrimitiveSet(i)->setNumInstances(mTransforms->getNumElements());
                 }
 
-                osg::ref_ptr<osg::Vec4Array> transforms = new osg::Vec4Array(mInstances.size());
                 osg::BoundingBox box;
                 osg::BoundingBox originalBox = geom.getBoundingBox();
                 float radius = originalBox.radius();
-                for (unsigned int i = 0; i < transforms->getNumElements(); i++)
+                for (const osg::Vec4f& transform : *mTransforms)
                 {
-                    osg::Vec3f pos(mInstances[i].mPos.asVec3());
-                    osg::Vec3f relativePos = pos - mChunkPosition;
-                    (*transforms)[i] = osg::Vec4f(relativePos, mInstances[i].mScale);
-
                     // Use an additional margin due to groundcover animation
-                    float instanceRadius = radius * mInstances[i].mScale * 1.1f;
-                    osg::BoundingSphere instanceBounds(relativePos, instanceRadius);
+                    float instanceRadius = radius * transform.w() * 1.1f;
+                    osg::BoundingSphere instanceBounds(
+                        osg::Vec3f(transform.x(), transform.y(), transform.z()), instanceRadius);
                     box.expandBy(instanceBounds);
                 }
 
                 geom.setInitialBound(box);
 
-                osg::ref_ptr<osg::Vec3Array> rotations = new osg::Vec3Array(mInstances.size());
-                for (unsigned int i = 0; i < rotations->getNumElements(); i++)
-                {
-                    (*rotations)[i] = mInstances[i].mPos.asRotationVec3();
-                }
-
                 // Display lists do not support instancing in OSG 3.4
                 geom.setUseDisplayList(false);
                 geom.setUseVertexBufferObjects(true);
 
-                geom.setVertexAttribArray(6, transforms.get(), osg::Array::BIND_PER_VERTEX);
-                geom.setVertexAttribArray(7, rotations.get(), osg::Array::BIND_PER_VERTEX);
+                geom.setVertexAttribArray(6, mTransforms.get(), osg::Array::BIND_PER_VERTEX);
+                geom.setVertexAttribArray(7, mRotations.get(), osg::Array::BIND_PER_VERTEX);
 
-                geom.addCullCallback(new InstancedComputeNearFarCullCallback(mInstances, mChunkPosition, originalBox));
+                geom.addCullCallback(new InstancedComputeNearFarCullCallback(mInstanceMatrices, originalBox));
             }
 
         private:
-            std::vector<Groundcover::GroundcoverEntry> mInstances;
-            osg::Vec3f mChunkPosition;
+            osg::ref_ptr<osg::Vec4Array> mTransforms;
+            osg::ref_ptr<osg::Vec3Array> mRotations;
+            std::shared_ptr<const std::vector<osg::Matrix>> mInstanceMatrices;
         };
 
         class DensityCalculator
@@ -303,13 +153,13 @@ namespace MWRender
             osg::BoundingBox mBox;
         };
 
-        inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+        inline bool isInChunkBorders(const ESM::Position& position, osg::Vec2f& minBound, osg::Vec2f& maxBound)
         {
             osg::Vec2f size = maxBound - minBound;
             if (size.x() >= 1 && size.y() >= 1)
                 return true;
 
-            osg::Vec3f pos = ref.mPos.asVec3();
+            osg::Vec3f pos = position.asVec3();
             osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
             if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x())
                 || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
@@ -322,7 +172,8 @@ namespace MWRender
     }
 
     osg::ref_ptr<osg::Node> Groundcover::getChunk(float size, const osg::Vec2f& center, unsigned char lod,
-        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile,
+        const std::atomic<bool>* /*abort*/)
     {
         if (lod > getMaxLodLevel())
             return nullptr;
@@ -340,13 +191,14 @@ namespace MWRender
         }
     }
 
-    Groundcover::Groundcover(
-        Resource::SceneManager* sceneManager, float density, float viewDistance, const MWWorld::GroundcoverStore& store)
+    Groundcover::Groundcover(Resource::SceneManager* sceneManager, float density, float viewDistance,
+        const MWWorld::GroundcoverStore& store, ESM::SharedReaders& readers)
         : GenericResourceManager<GroundcoverChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , mSceneManager(sceneManager)
         , mDensity(density)
         , mStateset(new osg::StateSet)
         , mGroundcoverStore(store)
+        , mReaders(readers)
     {
         setViewDistance(viewDistance);
         // MGE uses default alpha settings for groundcover, so we can not rely on alpha properties
@@ -375,48 +227,25 @@ namespace MWRender
         osg::Vec2f minBound = (center - osg::Vec2f(size / 2.f, size / 2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size / 2.f, size / 2.f));
         DensityCalculator calculator(mDensity);
-        ESM::ReadersCache readers;
         osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size / 2.f), std::floor(center.y() - size / 2.f));
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
             for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
             {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty())
+                const std::shared_ptr<const MWWorld::GroundcoverStore::CellInstances> cellInstances
+                    = mGroundcoverStore.getCellInstances(cellX, cellY, mReaders);
+                if (cellInstances == nullptr)
                     continue;
 
                 calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i = 0; i < cell.mContextList.size(); ++i)
-                {
-                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                    cell.restore(*reader, i);
-                    ESM::CellRef ref;
-                    bool deleted = false;
-                    while (cell.getNextRef(*reader, ref, deleted))
-                    {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
-                            deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound))
-                            deleted = true;
-
-                        if (deleted)
-                        {
-                            refs.erase(ref.mRefNum);
-                            continue;
-                        }
-                        refs[ref.mRefNum] = std::move(ref);
-                    }
-                }
-
-                for (auto& pair : refs)
+                for (const MWWorld::GroundcoverStore::Instance& instance : *cellInstances)
                 {
-                    ESM::CellRef& ref = pair.second;
-                    const std::string& model = mGroundcoverStore.getGroundcoverModel(ref.mRefID);
-                    if (!model.empty())
-                        instances[model].emplace_back(std::move(ref));
+                    if (!calculator.isInstanceEnabled())
+                        continue;
+                    const ESM::Position position = instance.getPosition(cellX, cellY);
+                    if (!isInChunkBorders(position, minBound, maxBound))
+                        continue;
+                    instances[mGroundcoverStore.getModel(instance.mModel)].emplace_back(position, instance.getScale());
                 }
             }
         }
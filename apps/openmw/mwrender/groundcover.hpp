@@ -1,10 +1,14 @@
 #ifndef OPENMW_MWRENDER_GROUNDCOVER_H
 #define OPENMW_MWRENDER_GROUNDCOVER_H
 
-#include <components/esm3/loadcell.hpp>
+#include <components/esm/position.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+namespace ESM
+{
+    class SharedReaders;
+}
 namespace MWWorld
 {
     class ESMStore;
@@ -23,11 +27,11 @@ namespace MWRender
     {
     public:
         Groundcover(Resource::SceneManager* sceneManager, float density, float viewDistance,
-            const MWWorld::GroundcoverStore& store);
+            const MWWorld::GroundcoverStore& store, ESM::SharedReaders& readers);
         ~Groundcover();
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
-            bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
+            bool activeGrid, const osg::Vec3f& viewPoint, bool compile, const std::atomic<bool>* abort) override;
 
         unsigned int getNodeMask() override;
 
@@ -38,9 +42,9 @@ namespace MWRender
             ESM::Position mPos;
             float mScale;
 
-            GroundcoverEntry(const ESM::CellRef& ref)
-                : mPos(ref.mPos)
-                , mScale(ref.mScale)
+            GroundcoverEntry(const ESM::Position& pos, float scale)
+                : mPos(pos)
+                , mScale(scale)
             {
             }
         };
@@ -51,6 +55,7 @@ namespace MWRender
         osg::ref_ptr<osg::StateSet> mStateset;
         osg::ref_ptr<osg::Program> mProgramTemplate;
         const MWWorld::GroundcoverStore& mGroundcoverStore;
+        ESM::SharedReaders& mReaders;
 
         typedef std::map<std::string, std::vector<GroundcoverEntry>> InstanceMap;
         osg::ref_ptr<osg::Node> createChunk(InstanceMap& instances, const osg::Vec2f& center);
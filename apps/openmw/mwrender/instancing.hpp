@@ -0,0 +1,30 @@
+#ifndef OPENMW_MWRENDER_INSTANCING_H
+#define OPENMW_MWRENDER_INSTANCING_H
+
+#include <osg/BoundingBox>
+#include <osg/Drawable>
+#include <osg/Matrix>
+
+#include <memory>
+#include <vector>
+
+namespace MWRender
+{
+    /// @brief Computes the near and far planes for an instanced drawable taking into account every instance instead of
+    /// the untransformed primitives.
+    /// @par The matrices may be shared by the callbacks of all the drawables using the same instances.
+    class InstancedComputeNearFarCullCallback : public osg::DrawableCullCallback
+    {
+    public:
+        InstancedComputeNearFarCullCallback(
+            std::shared_ptr<const std::vector<osg::Matrix>> instanceMatrices, const osg::BoundingBox& instanceBounds);
+
+        bool cull(osg::NodeVisitor* nv, osg::Drawable* drawable, osg::RenderInfo* renderInfo) const override;
+
+    private:
+        std::shared_ptr<const std::vector<osg::Matrix>> mInstanceMatrices;
+        osg::BoundingBox mInstanceBounds;
+    };
+}
+
+#endif
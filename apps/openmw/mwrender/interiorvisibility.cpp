@@ -0,0 +1,455 @@
+#include "interiorvisibility.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+#include <osg/BoundingBox>
+#include <osgUtil/CullVisitor>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/constants.hpp>
+#include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/visitor.hpp>
+#include <components/settings/values.hpp>
+
+#include "../mwphysics/raycasting.hpp"
+
+#include "vismask.hpp"
+
+namespace MWRender
+{
+    namespace
+    {
+        // Increment when the way the column visibility is computed changes
+        constexpr std::uint32_t sVersion = 1;
+
+        constexpr float sMinColumnSize = 512.f;
+        constexpr int sMaxColumnsPerAxis = 16;
+        // Rays cast down per axis of a column to find its floors
+        constexpr int sSamplesPerAxis = 2;
+        constexpr int sMaxFloorHits = 8;
+        constexpr std::size_t sMaxViewpoints = 8;
+        constexpr float sEyeHeight = 100.f;
+        // A floor needs a ceiling above it at least this high to be walked on
+        constexpr float sMinRoomHeight = 128.f;
+        constexpr float sRayOffset = 1.f;
+
+        constexpr std::chrono::microseconds sTimeBudget{ 1000 };
+
+        template <class T>
+        void append(std::string& data, const T& value)
+        {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    class InteriorVisibility::CullCallback
+        : public SceneUtil::NodeCallback<CullCallback, osg::Group*, osgUtil::CullVisitor*>
+    {
+    public:
+        explicit CullCallback(const InteriorVisibility& visibility)
+            : mVisibility(visibility)
+        {
+        }
+
+        void operator()(osg::Group* node, osgUtil::CullVisitor* cv)
+        {
+            if (!mVisibility.mCulling || cv->getCurrentCamera()->getName() != Constants::SceneCamera)
+            {
+                traverse(node, cv);
+                return;
+            }
+
+            for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+            {
+                osg::Node* child = node->getChild(i);
+                if (mVisibility.isVisible(*child))
+                    child->accept(*cv);
+            }
+        }
+
+    private:
+        const InteriorVisibility& mVisibility;
+    };
+
+    InteriorVisibility::InteriorVisibility()
+        : mCullCallback(new CullCallback(*this))
+    {
+    }
+
+    InteriorVisibility::~InteriorVisibility()
+    {
+        clear();
+    }
+
+    void InteriorVisibility::setCell(const std::string& cellId, osg::Group& cellNode)
+    {
+        clear();
+
+        osg::BoundingBox bounds;
+        for (unsigned int i = 0; i < cellNode.getNumChildren(); ++i)
+        {
+            const osg::Node& child = *cellNode.getChild(i);
+            if (child.getNodeMask() & Mask_Object)
+                bounds.expandBy(child.getBound());
+        }
+        if (!bounds.valid())
+            return;
+
+        mCellNode = &cellNode;
+        mCellNode->addCullCallback(mCullCallback);
+
+        const float extent = std::max(bounds.xMax() - bounds.xMin(), bounds.yMax() - bounds.yMin());
+        mColumnSize = std::max(sMinColumnSize, extent / sMaxColumnsPerAxis);
+        mSizeX = std::max(1, static_cast<int>(std::ceil((bounds.xMax() - bounds.xMin()) / mColumnSize)));
+        mSizeY = std::max(1, static_cast<int>(std::ceil((bounds.yMax() - bounds.yMin()) / mColumnSize)));
+        mOrigin = bounds._min;
+        mHeight = bounds.zMax() - bounds.zMin();
+
+        std::string data;
+        append(data, sVersion);
+        data += cellId;
+        append(data, mSizeX);
+        append(data, mSizeY);
+        append(data, mColumnSize);
+        append(data, mOrigin);
+        append(data, mHeight);
+
+        for (unsigned int i = 0; i < cellNode.getNumChildren(); ++i)
+        {
+            osg::Node& child = *cellNode.getChild(i);
+            if (!(child.getNodeMask() & Mask_Object))
+                continue;
+            const osg::BoundingSphere& bound = child.getBound();
+            append(data, bound.center());
+            append(data, bound.radius());
+            mObjects.emplace(&child, makeObject(child));
+        }
+
+        const std::array<std::uint64_t, 2> hash = Files::getHash(data);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        mKey = key.str();
+
+        const std::size_t numColumns = static_cast<std::size_t>(mSizeX) * static_cast<std::size_t>(mSizeY);
+        mViewpoints.assign(numColumns, {});
+        mHasViewpoints.assign(numColumns, 0);
+        mColumnVisibility.assign(numColumns * numColumns, 0);
+        mVisibleColumns.assign(numColumns, 0);
+        mNextColumn = 0;
+        mNextOther = 0;
+        mStage = readCache() ? Stage::Done : Stage::Viewpoints;
+    }
+
+    void InteriorVisibility::clear()
+    {
+        if (mCellNode != nullptr)
+            mCellNode->removeCullCallback(mCullCallback);
+        mCellNode = nullptr;
+
+        mCulling = false;
+        for (auto& [node, object] : mObjects)
+            updateVisibility(object);
+        mObjects.clear();
+
+        mStage = Stage::Done;
+        mColumn = -1;
+        mSizeX = 0;
+        mSizeY = 0;
+        mViewpoints.clear();
+        mHasViewpoints.clear();
+        mColumnVisibility.clear();
+        mVisibleColumns.clear();
+    }
+
+    void InteriorVisibility::update(const osg::Vec3f& eyePoint, const MWPhysics::RayCastingInterface& rayCasting)
+    {
+        if (mCellNode == nullptr)
+            return;
+
+        if (mStage != Stage::Done)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const std::size_t numColumns = mHasViewpoints.size();
+            while (mStage != Stage::Done && std::chrono::steady_clock::now() - start < sTimeBudget)
+            {
+                if (mStage == Stage::Viewpoints)
+                {
+                    computeViewpoints(mNextColumn, rayCasting);
+                    if (++mNextColumn == numColumns)
+                    {
+                        mStage = Stage::Columns;
+                        mNextColumn = 0;
+                        mNextOther = 0;
+                    }
+                    continue;
+                }
+
+                if (mHasViewpoints[mNextColumn] && mHasViewpoints[mNextOther]
+                    && (mNextColumn == mNextOther || computeVisibility(mNextColumn, mNextOther, rayCasting)))
+                {
+                    mColumnVisibility[mNextColumn * numColumns + mNextOther] = 1;
+                    mColumnVisibility[mNextOther * numColumns + mNextColumn] = 1;
+                }
+
+                // The visibility is symmetric, only test each pair once
+                if (++mNextOther == numColumns && ++mNextColumn < numColumns)
+                    mNextOther = mNextColumn;
+                if (mNextColumn == numColumns)
+                {
+                    mStage = Stage::Done;
+                    mViewpoints.clear();
+                    writeCache();
+                }
+            }
+            if (mStage != Stage::Done)
+                return;
+        }
+
+        int column = -1;
+        const osg::Vec3f local = eyePoint - mOrigin;
+        const int x = static_cast<int>(std::floor(local.x() / mColumnSize));
+        const int y = static_cast<int>(std::floor(local.y() / mColumnSize));
+        // Outside of the geometry or inside a wall there are no viewpoints to tell what is seen
+        if (x >= 0 && x < mSizeX && y >= 0 && y < mSizeY && local.z() >= 0 && local.z() <= mHeight
+            && mHasViewpoints[y * mSizeX + x])
+            column = y * mSizeX + x;
+
+        if (column == mColumn)
+            return;
+        mColumn = column;
+
+        selectColumns(column);
+        for (auto& [node, object] : mObjects)
+            updateVisibility(object);
+    }
+
+    void InteriorVisibility::updateObject(const osg::Node& node)
+    {
+        const auto it = mObjects.find(&node);
+        if (it == mObjects.end())
+            return;
+
+        Object& object = it->second;
+        const osg::BoundingSphere& bound = node.getBound();
+        object.mRange = getRange(bound.center(), bound.radius());
+        for (Light& light : object.mLights)
+            light.mRange = getRange(bound.center(), bound.radius() + light.mRadius);
+        updateVisibility(object);
+    }
+
+    void InteriorVisibility::removeObject(const osg::Node& node)
+    {
+        const auto it = mObjects.find(&node);
+        if (it == mObjects.end())
+            return;
+
+        for (const Light& light : it->second.mLights)
+            if (osg::ref_ptr<SceneUtil::LightSource> lightSource; light.mLightSource.lock(lightSource))
+                lightSource->setSceneCulled(false);
+        mObjects.erase(it);
+    }
+
+    InteriorVisibility::Range InteriorVisibility::getRange(const osg::Vec3f& center, float radius) const
+    {
+        Range range;
+        const osg::Vec3f local = center - mOrigin;
+        range.mMinX = static_cast<int>(std::floor((local.x() - radius) / mColumnSize));
+        range.mMinY = static_cast<int>(std::floor((local.y() - radius) / mColumnSize));
+        range.mMaxX = static_cast<int>(std::floor((local.x() + radius) / mColumnSize));
+        range.mMaxY = static_cast<int>(std::floor((local.y() + radius) / mColumnSize));
+        range.mOutside = range.mMaxX < 0 || range.mMaxY < 0 || range.mMinX >= mSizeX || range.mMinY >= mSizeY;
+        range.mMinX = std::max(range.mMinX, 0);
+        range.mMinY = std::max(range.mMinY, 0);
+        range.mMaxX = std::min(range.mMaxX, mSizeX - 1);
+        range.mMaxY = std::min(range.mMaxY, mSizeY - 1);
+        return range;
+    }
+
+    InteriorVisibility::Object InteriorVisibility::makeObject(osg::Node& node) const
+    {
+        Object object;
+        const osg::BoundingSphere& bound = node.getBound();
+        object.mRange = getRange(bound.center(), bound.radius());
+
+        SceneUtil::FindByClassVisitor visitor("LightSource");
+        node.accept(visitor);
+        const float lightBoundsMultiplier = Settings::shaders().mLightBoundsMultiplier;
+        for (osg::Node* found : visitor.mFoundNodes)
+        {
+            SceneUtil::LightSource* lightSource = static_cast<SceneUtil::LightSource*>(found);
+            Light& light = object.mLights.emplace_back();
+            light.mLightSource = lightSource;
+            light.mRadius = lightSource->getRadius() * std::max(1.f, lightBoundsMultiplier);
+            light.mRange = getRange(bound.center(), bound.radius() + light.mRadius);
+        }
+
+        return object;
+    }
+
+    bool InteriorVisibility::isVisible(const Range& range) const
+    {
+        if (!mCulling || range.mOutside)
+            return true;
+        for (int y = range.mMinY; y <= range.mMaxY; ++y)
+            for (int x = range.mMinX; x <= range.mMaxX; ++x)
+                if (mVisibleColumns[y * mSizeX + x])
+                    return true;
+        return false;
+    }
+
+    bool InteriorVisibility::isVisible(const osg::Node& node) const
+    {
+        const auto it = mObjects.find(&node);
+        return it == mObjects.end() || it->second.mVisible;
+    }
+
+    void InteriorVisibility::updateVisibility(Object& object) const
+    {
+        object.mVisible = isVisible(object.mRange);
+        for (const Light& light : object.mLights)
+            if (osg::ref_ptr<SceneUtil::LightSource> lightSource; light.mLightSource.lock(lightSource))
+                lightSource->setSceneCulled(!isVisible(light.mRange));
+    }
+
+    void InteriorVisibility::selectColumns(int column)
+    {
+        mCulling = column >= 0;
+        if (!mCulling)
+            return;
+
+        // The camera can be anywhere in its column, so also include what the neighbouring columns see
+        const std::size_t numColumns = mHasViewpoints.size();
+        for (std::size_t i = 0; i < numColumns; ++i)
+            mVisibleColumns[i] = !mHasViewpoints[i];
+        const int columnX = column % mSizeX;
+        const int columnY = column / mSizeX;
+        for (int y = std::max(columnY - 1, 0); y <= std::min(columnY + 1, mSizeY - 1); ++y)
+            for (int x = std::max(columnX - 1, 0); x <= std::min(columnX + 1, mSizeX - 1); ++x)
+            {
+                const std::size_t from = static_cast<std::size_t>(y * mSizeX + x);
+                for (std::size_t i = 0; i < numColumns; ++i)
+                    mVisibleColumns[i] |= mColumnVisibility[from * numColumns + i];
+            }
+    }
+
+    void InteriorVisibility::computeViewpoints(std::size_t column, const MWPhysics::RayCastingInterface& rayCasting)
+    {
+        std::vector<osg::Vec3f>& viewpoints = mViewpoints[column];
+        const float columnX = mOrigin.x() + static_cast<float>(column % mSizeX) * mColumnSize;
+        const float columnY = mOrigin.y() + static_cast<float>(column / mSizeX) * mColumnSize;
+        const float top = mOrigin.z() + mHeight + sRayOffset;
+        const float bottom = mOrigin.z() - sRayOffset;
+
+        for (int sampleY = 0; sampleY < sSamplesPerAxis; ++sampleY)
+            for (int sampleX = 0; sampleX < sSamplesPerAxis; ++sampleX)
+            {
+                const float x = columnX + (sampleX + 0.5f) * mColumnSize / sSamplesPerAxis;
+                const float y = columnY + (sampleY + 0.5f) * mColumnSize / sSamplesPerAxis;
+
+                // Walk down the surfaces of the column. The first one has nothing above it, so it is the outside of
+                // the geometry. A surface with enough room below the previous one is a floor.
+                osg::Vec3f from(x, y, top);
+                std::optional<float> ceiling;
+                for (int i = 0; i < sMaxFloorHits && from.z() > bottom && viewpoints.size() < sMaxViewpoints; ++i)
+                {
+                    const MWPhysics::RayCastingResult result
+                        = rayCasting.castRay(from, osg::Vec3f(x, y, bottom), MWPhysics::CollisionType_World);
+                    if (!result.mHit)
+                        break;
+                    const float z = result.mHitPos.z();
+                    if (ceiling.has_value() && *ceiling - z >= sMinRoomHeight)
+                        viewpoints.emplace_back(x, y, z + sEyeHeight);
+                    ceiling = z;
+                    from.z() = z - sRayOffset;
+                }
+            }
+
+        mHasViewpoints[column] = !viewpoints.empty();
+    }
+
+    bool InteriorVisibility::computeVisibility(
+        std::size_t from, std::size_t to, const MWPhysics::RayCastingInterface& rayCasting) const
+    {
+        for (const osg::Vec3f& start : mViewpoints[from])
+            for (const osg::Vec3f& end : mViewpoints[to])
+                if (!rayCasting.castRay(start, end, MWPhysics::CollisionType_World).mHit)
+                    return true;
+        return false;
+    }
+
+    std::filesystem::path InteriorVisibility::getCachePath() const
+    {
+        return mCacheDirectory / (mKey + ".pvs");
+    }
+
+    bool InteriorVisibility::readCache()
+    {
+        if (mCacheDirectory.empty())
+            return false;
+
+        std::ifstream stream(getCachePath(), std::ios::binary);
+        if (!stream.is_open())
+            return false;
+
+        std::uint64_t numColumns = 0;
+        stream.read(reinterpret_cast<char*>(&numColumns), sizeof(numColumns));
+        if (!stream || numColumns != mHasViewpoints.size())
+        {
+            Log(Debug::Warning) << "Ignoring invalid interior visibility cache " << getCachePath();
+            return false;
+        }
+        stream.read(reinterpret_cast<char*>(mHasViewpoints.data()), mHasViewpoints.size());
+        stream.read(reinterpret_cast<char*>(mColumnVisibility.data()), mColumnVisibility.size());
+        if (!stream)
+        {
+            Log(Debug::Warning) << "Ignoring invalid interior visibility cache " << getCachePath();
+            std::fill(mHasViewpoints.begin(), mHasViewpoints.end(), 0);
+            std::fill(mColumnVisibility.begin(), mColumnVisibility.end(), 0);
+            return false;
+        }
+        mViewpoints.clear();
+        return true;
+    }
+
+    void InteriorVisibility::writeCache() const
+    {
+        if (mCacheDirectory.empty())
+            return;
+
+        const std::filesystem::path path = getCachePath();
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        try
+        {
+            std::filesystem::create_directories(mCacheDirectory);
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                const std::uint64_t numColumns = mHasViewpoints.size();
+                stream.write(reinterpret_cast<const char*>(&numColumns), sizeof(numColumns));
+                stream.write(reinterpret_cast<const char*>(mHasViewpoints.data()), mHasViewpoints.size());
+                stream.write(reinterpret_cast<const char*>(mColumnVisibility.data()), mColumnVisibility.size());
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write interior visibility cache " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef OPENMW_MWRENDER_INTERIORVISIBILITY_H
+#define OPENMW_MWRENDER_INTERIORVISIBILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Callback>
+#include <osg/Group>
+#include <osg/Vec3f>
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+namespace MWPhysics
+{
+    class RayCastingInterface;
+}
+
+namespace SceneUtil
+{
+    class LightSource;
+}
+
+namespace MWRender
+{
+    /// @brief Potentially visible set of the objects of an interior cell, precomputed from its collision geometry.
+    /// @par The cell is split into the columns of a horizontal grid. Viewpoints are placed at eye height over the
+    /// floors found by casting rays down each column, and two columns see each other when a ray between their
+    /// viewpoints does not hit the static collision geometry. Doors do not occlude.
+    /// @par The cull traversal of the scene camera skips the objects overlapping no column seen from the column of
+    /// the camera or from its neighbours, together with their particle systems, and the scene is not lit by their
+    /// lights when the light radius doesn't reach a seen column either. Actors are never skipped.
+    /// @par The column visibility is computed within a time budget per frame on the first visit of a cell and
+    /// stored on disk, keyed by the hash of the bounds of the objects of the cell.
+    class InteriorVisibility
+    {
+    public:
+        InteriorVisibility();
+
+        ~InteriorVisibility();
+
+        void setCacheDirectory(const std::filesystem::path& directory) { mCacheDirectory = directory; }
+
+        /// Compute the visibility of the objects currently attached to the cell node, replacing the previous cell.
+        /// @param cellId Identifies the cell in the disk cache.
+        void setCell(const std::string& cellId, osg::Group& cellNode);
+
+        /// Stop culling, e.g. before the cell node is removed.
+        void clear();
+
+        bool hasCell(const osg::Group& cellNode) const { return mCellNode == &cellNode; }
+
+        /// Continue the computation and select the objects seen from the eye point. Call once per frame before the
+        /// cull traversal.
+        void update(const osg::Vec3f& eyePoint, const MWPhysics::RayCastingInterface& rayCasting);
+
+        /// Update the columns overlapped by the object after it was moved, rotated or scaled.
+        void updateObject(const osg::Node& node);
+
+        /// Stop tracking the object, e.g. before it is removed from the scene.
+        void removeObject(const osg::Node& node);
+
+    private:
+        class CullCallback;
+
+        enum class Stage
+        {
+            Viewpoints,
+            Columns,
+            Done,
+        };
+
+        // Range of columns, inclusive
+        struct Range
+        {
+            int mMinX = 0;
+            int mMinY = 0;
+            int mMaxX = -1;
+            int mMaxY = -1;
+            // The bound is outside of the grid
+            bool mOutside = true;
+        };
+
+        struct Light
+        {
+            osg::observer_ptr<SceneUtil::LightSource> mLightSource;
+            float mRadius = 0;
+            Range mRange;
+        };
+
+        struct Object
+        {
+            Range mRange;
+            std::vector<Light> mLights;
+            bool mVisible = true;
+        };
+
+        Range getRange(const osg::Vec3f& center, float radius) const;
+
+        Object makeObject(osg::Node& node) const;
+
+        bool isVisible(const Range& range) const;
+
+        bool isVisible(const osg::Node& node) const;
+
+        void updateVisibility(Object& object) const;
+
+        void selectColumns(int column);
+
+        void computeViewpoints(std::size_t column, const MWPhysics::RayCastingInterface& rayCasting);
+
+        bool computeVisibility(
+            std::size_t from, std::size_t to, const MWPhysics::RayCastingInterface& rayCasting) const;
+
+        std::filesystem::path getCachePath() const;
+
+        bool readCache();
+
+        void writeCache() const;
+
+        std::filesystem::path mCacheDirectory;
+        osg::ref_ptr<osg::Callback> mCullCallback;
+        osg::ref_ptr<osg::Group> mCellNode;
+        std::string mKey;
+
+        osg::Vec3f mOrigin;
+        float mColumnSize = 0;
+        float mHeight = 0;
+        int mSizeX = 0;
+        int mSizeY = 0;
+
+        Stage mStage = Stage::Done;
+        std::size_t mNextColumn = 0;
+        std::size_t mNextOther = 0;
+        std::vector<std::vector<osg::Vec3f>> mViewpoints;
+        // Whether a column has viewpoints, the columns without any are seen from everywhere
+        std::vector<std::uint8_t> mHasViewpoints;
+        // Whether column i sees column j at i * mHasViewpoints.size() + j
+        std::vector<std::uint8_t> mColumnVisibility;
+
+        std::unordered_map<const osg::Node*, Object> mObjects;
+        int mColumn = -1;
+        // The columns seen from mColumn and its neighbours
+        std::vector<std::uint8_t> mVisibleColumns;
+        bool mCulling = false;
+    };
+}
+
+#endif
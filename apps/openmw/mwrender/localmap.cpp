@@ -1,6 +1,9 @@
 #include "localmap.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <span>
 
 #include <osg/ComputeBoundsVisitor>
 #include <osg/Fog>
@@ -9,12 +12,9 @@
 #include <osg/PolygonMode>
 #include <osg/Texture2D>
 
-#include <osgDB/ReadFile>
-
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/fogstate.hpp>
 #include <components/esm3/loadcell.hpp>
-#include <components/files/memorystream.hpp>
 #include <components/misc/constants.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
@@ -65,6 +65,11 @@ namespace MWRender
         osg::Matrix mProjectionMatrix;
         osg::Matrix mViewMatrix;
         bool mActive;
+
+        // Set when queued by LocalMap
+        osg::Vec2f mCenter;
+        std::pair<int, int> mSegment;
+        bool mInterior = false;
     };
 
     class CameraLocalUpdateCallback
@@ -164,14 +169,26 @@ namespace MWRender
     void LocalMap::setupRenderToTexture(
         int segment_x, int segment_y, float left, float top, const osg::Vec3d& upVector, float zmin, float zmax)
     {
-        mLocalMapRTTs.emplace_back(
-            new LocalMapRenderToTexture(mSceneRoot, mMapResolution, mMapWorldSize, left, top, upVector, zmin, zmax));
+        const std::pair<int, int> coords(segment_x, segment_y);
+        // A newer render of the segment supersedes the queued one
+        removePendingRenders(mInterior, coords);
 
-        mRoot->addChild(mLocalMapRTTs.back());
+        osg::ref_ptr<LocalMapRenderToTexture> rtt
+            = new LocalMapRenderToTexture(mSceneRoot, mMapResolution, mMapWorldSize, left, top, upVector, zmin, zmax);
+        rtt->mCenter = osg::Vec2f(left, top);
+        rtt->mSegment = coords;
+        rtt->mInterior = mInterior;
+        mPendingRTTs.push_back(rtt);
 
-        MapSegment& segment = mInterior ? mInteriorSegments[std::make_pair(segment_x, segment_y)]
-                                        : mExteriorSegments[std::make_pair(segment_x, segment_y)];
-        segment.mMapTexture = static_cast<osg::Texture2D*>(mLocalMapRTTs.back()->getColorTexture(nullptr));
+        MapSegment& segment = mInterior ? mInteriorSegments[coords] : mExteriorSegments[coords];
+        segment.mMapTexture = static_cast<osg::Texture2D*>(rtt->getColorTexture(nullptr));
+    }
+
+    void LocalMap::removePendingRenders(bool interior, const std::pair<int, int>& segment)
+    {
+        std::erase_if(mPendingRTTs, [&](const osg::ref_ptr<LocalMapRenderToTexture>& rtt) {
+            return rtt->mInterior == interior && rtt->mSegment == segment;
+        });
     }
 
     void LocalMap::requestMap(const MWWorld::CellStore* cell)
@@ -202,6 +219,7 @@ namespace MWRender
 
     void LocalMap::removeExteriorCell(int x, int y)
     {
+        removePendingRenders(false, { x, y });
         mExteriorSegments.erase({ x, y });
     }
 
@@ -210,9 +228,13 @@ namespace MWRender
         saveFogOfWar(cell);
 
         if (cell->isExterior())
-            mExteriorSegments.erase({ cell->getCell()->getGridX(), cell->getCell()->getGridY() });
+            removeExteriorCell(cell->getCell()->getGridX(), cell->getCell()->getGridY());
         else
+        {
+            std::erase_if(mPendingRTTs,
+                [](const osg::ref_ptr<LocalMapRenderToTexture>& rtt) { return rtt->mInterior; });
             mInteriorSegments.clear();
+        }
     }
 
     osg::ref_ptr<osg::Texture2D> LocalMap::getMapTexture(int x, int y)
@@ -248,6 +270,27 @@ namespace MWRender
             else
                 it++;
         }
+
+        if (mPendingRTTs.empty())
+            return;
+
+        // Keep the closest segments at the back of the queue
+        std::sort(mPendingRTTs.begin(), mPendingRTTs.end(),
+            [&](const osg::ref_ptr<LocalMapRenderToTexture>& lhs, const osg::ref_ptr<LocalMapRenderToTexture>& rhs) {
+                return (lhs->mCenter - mPlayerPosition).length2() > (rhs->mCenter - mPlayerPosition).length2();
+            });
+
+        const int segmentsPerFrame = Settings::map().mLocalMapSegmentsPerFrame;
+        std::size_t count = mPendingRTTs.size();
+        if (segmentsPerFrame > 0)
+            count = std::min(count, static_cast<std::size_t>(segmentsPerFrame));
+
+        for (; count > 0; --count)
+        {
+            mRoot->addChild(mPendingRTTs.back());
+            mLocalMapRTTs.push_back(std::move(mPendingRTTs.back()));
+            mPendingRTTs.pop_back();
+        }
     }
 
     void LocalMap::requestExteriorMap(const MWWorld::CellStore* cell, MapSegment& segment)
@@ -468,9 +511,7 @@ namespace MWRender
         int texU = static_cast<int>((sFogOfWarResolution - 1) * nX);
         int texV = static_cast<int>((sFogOfWarResolution - 1) * nY);
 
-        const std::uint32_t clr
-            = reinterpret_cast<const uint32_t*>(segment.mFogOfWarImage->data())[texV * sFogOfWarResolution + texU];
-        uint8_t alpha = (clr >> 24);
+        const std::uint8_t alpha = segment.mFogOfWarImage->data()[texV * sFogOfWarResolution + texU];
         return alpha < 200;
     }
 
@@ -484,6 +525,7 @@ namespace MWRender
     {
         // retrieve the x,y grid coordinates the player is in
         osg::Vec2f pos(position.x(), position.y());
+        mPlayerPosition = pos;
 
         if (mInterior)
         {
@@ -537,7 +579,7 @@ namespace MWRender
                 if (!segment.mFogOfWarImage || !segment.mMapTexture)
                     continue;
 
-                std::uint32_t* data = reinterpret_cast<std::uint32_t*>(segment.mFogOfWarImage->data());
+                std::uint8_t* data = segment.mFogOfWarImage->data();
                 bool changed = false;
                 for (int texV = 0; texV < sFogOfWarResolution; ++texV)
                 {
@@ -547,11 +589,10 @@ namespace MWRender
                             + square((texV + my * (sFogOfWarResolution - 1)) - v * (sFogOfWarResolution - 1));
 
                         const std::uint8_t alpha = std::min<std::uint8_t>(
-                            *data >> 24, std::clamp(sqrDist / sqrExploreRadius, 0.f, 1.f) * 255);
-                        std::uint32_t val = static_cast<std::uint32_t>(alpha << 24);
-                        if (*data != val)
+                            *data, std::clamp(sqrDist / sqrExploreRadius, 0.f, 1.f) * 255);
+                        if (*data != alpha)
                         {
-                            *data = val;
+                            *data = alpha;
                             changed = true;
                         }
 
@@ -602,17 +643,20 @@ namespace MWRender
         mFogOfWarTexture->setImage(mFogOfWarImage);
     }
 
-    void LocalMap::MapSegment::initFogOfWar()
+    void LocalMap::MapSegment::allocateFogOfWarImage()
     {
         mFogOfWarImage = new osg::Image;
         // Assign a PixelBufferObject for asynchronous transfer of data to the GPU
         mFogOfWarImage->setPixelBufferObject(new osg::PixelBufferObject);
-        mFogOfWarImage->allocateImage(sFogOfWarResolution, sFogOfWarResolution, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        // Only the alpha is used, the color is always black
+        mFogOfWarImage->allocateImage(sFogOfWarResolution, sFogOfWarResolution, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
         assert(mFogOfWarImage->isDataContiguous());
-        std::vector<uint32_t> data;
-        data.resize(sFogOfWarResolution * sFogOfWarResolution, 0xff000000);
+    }
 
-        memcpy(mFogOfWarImage->data(), data.data(), data.size() * 4);
+    void LocalMap::MapSegment::initFogOfWar()
+    {
+        allocateFogOfWarImage();
+        std::memset(mFogOfWarImage->data(), 0xff, sFogOfWarResolution * sFogOfWarResolution);
 
         createFogOfWarTexture();
     }
@@ -626,26 +670,15 @@ namespace MWRender
             return;
         }
 
-        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-        if (!readerwriter)
+        allocateFogOfWarImage();
+        if (!ESM::decodeFogOfWar(
+                data, std::span(mFogOfWarImage->data(), sFogOfWarResolution * sFogOfWarResolution)))
         {
-            Log(Debug::Error) << "Error: Unable to load fog, can't find a png ReaderWriter";
-            return;
-        }
-
-        Files::IMemStream in(data.data(), data.size());
-
-        osgDB::ReaderWriter::ReadResult result = readerwriter->readImage(in);
-        if (!result.success())
-        {
-            Log(Debug::Error) << "Error: Failed to read fog: " << result.message() << " code " << result.status();
+            Log(Debug::Error) << "Error: Failed to read fog: invalid data";
+            initFogOfWar();
             return;
         }
 
-        mFogOfWarImage = result.getImage();
-        mFogOfWarImage->flipVertical();
-        mFogOfWarImage->dirty();
-
         createFogOfWarTexture();
         mHasFogState = true;
     }
@@ -655,27 +688,8 @@ namespace MWRender
         if (!mFogOfWarImage)
             return;
 
-        std::ostringstream ostream;
-
-        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-        if (!readerwriter)
-        {
-            Log(Debug::Error) << "Error: Unable to write fog, can't find a png ReaderWriter";
-            return;
-        }
-
-        // extra flips are unfortunate, but required for compatibility with older versions
-        mFogOfWarImage->flipVertical();
-        osgDB::ReaderWriter::WriteResult result = readerwriter->writeImage(*mFogOfWarImage, ostream);
-        if (!result.success())
-        {
-            Log(Debug::Error) << "Error: Unable to write fog: " << result.message() << " code " << result.status();
-            return;
-        }
-        mFogOfWarImage->flipVertical();
-
-        std::string data = ostream.str();
-        fog.mImageData = std::vector<char>(data.begin(), data.end());
+        ESM::encodeFogOfWar(
+            std::span(mFogOfWarImage->data(), sFogOfWarResolution * sFogOfWarResolution), fog.mImageData);
     }
 
     LocalMapRenderToTexture::LocalMapRenderToTexture(osg::Node* sceneRoot, int res, int mapWorldSize, float x, float y,
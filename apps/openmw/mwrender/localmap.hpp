@@ -8,6 +8,7 @@
 
 #include <osg/BoundingBox>
 #include <osg/Quat>
+#include <osg/Vec2f>
 #include <osg/ref_ptr>
 
 namespace MWWorld
@@ -49,7 +50,7 @@ namespace MWRender
 
         /**
          * Request a map render for the given cell. Render textures will be immediately created and can be retrieved
-         * with the getMapTexture function.
+         * with the getMapTexture function, but the segments are rendered over the next frames by cleanupCameras.
          */
         void requestMap(const MWWorld::CellStore* cell);
 
@@ -63,8 +64,9 @@ namespace MWRender
         osg::ref_ptr<osg::Texture2D> getFogOfWarTexture(int x, int y);
 
         /**
-         * Removes cameras that have already been rendered. Should be called every frame to ensure that
-         * we do not render the same map more than once. Note, this cleanup is difficult to implement in an
+         * Removes cameras that have already been rendered and starts rendering the next queued segments, the ones
+         * closest to the player first. Should be called every frame to ensure that we do not render the same map more
+         * than once. Note, this cleanup is difficult to implement in an
          * automated fashion, since we can't alter the scene graph structure from within an update callback.
          */
         void cleanupCameras();
@@ -104,6 +106,9 @@ namespace MWRender
 
         typedef std::vector<osg::ref_ptr<LocalMapRenderToTexture>> RTTVector;
         RTTVector mLocalMapRTTs;
+        // Not yet attached to the scene, rendered a few per frame from cleanupCameras
+        RTTVector mPendingRTTs;
+        osg::Vec2f mPlayerPosition;
 
         typedef std::set<std::pair<int, int>> Grid;
         Grid mCurrentGrid;
@@ -122,6 +127,7 @@ namespace MWRender
 
         struct MapSegment
         {
+            void allocateFogOfWarImage();
             void initFogOfWar();
             void loadFogOfWar(const ESM::FogTexture& fog);
             void saveFogOfWar(ESM::FogTexture& fog) const;
@@ -156,6 +162,7 @@ namespace MWRender
 
         void setupRenderToTexture(
             int segment_x, int segment_y, float left, float top, const osg::Vec3d& upVector, float zmin, float zmax);
+        void removePendingRenders(bool interior, const std::pair<int, int>& segment);
 
         bool mInterior;
         osg::BoundingBox mBounds;
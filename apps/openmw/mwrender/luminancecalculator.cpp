@@ -1,6 +1,8 @@
 #include "luminancecalculator.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/misc/mathutil.hpp>
+#include <components/sceneutil/glextensions.hpp>
 #include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
 
@@ -14,15 +16,67 @@ namespace MWRender
             { "hdrExposureTime", std::to_string(Settings::postProcessing().mAutoExposureSpeed) },
         };
 
-        auto vertex = shaderManager.getShader("fullscreen_tri.vert", {});
-        auto luminanceFragment = shaderManager.getShader("luminance/luminance.frag", defines);
-        auto resolveFragment = shaderManager.getShader("luminance/resolve.frag", defines);
+#ifdef __APPLE__
+        mUseCompute = false;
+#else
+        constexpr float minimumGLVersionRequiredForCompute = 4.4;
+        osg::GLExtensions& exts = SceneUtil::getGLExtensions();
+        mUseCompute = exts.glVersion >= minimumGLVersionRequiredForCompute
+            && exts.glslLanguageVersion >= minimumGLVersionRequiredForCompute;
+#endif
 
-        mResolveProgram = shaderManager.getProgram(vertex, std::move(resolveFragment));
-        mLuminanceProgram = shaderManager.getProgram(std::move(vertex), std::move(luminanceFragment));
+        if (mUseCompute)
+        {
+            Log(Debug::Info) << "Initialized compute shader pipeline for scene luminance";
+
+            mReduceProgram = shaderManager.getProgram(
+                nullptr, shaderManager.getShader("core/luminance/reduce.comp", defines, osg::Shader::COMPUTE));
+            mReduceResolveProgram = shaderManager.getProgram(
+                nullptr, shaderManager.getShader("core/luminance/resolve.comp", defines, osg::Shader::COMPUTE));
+        }
+        else
+        {
+            auto vertex = shaderManager.getShader("fullscreen_tri.vert", {});
+            auto luminanceFragment = shaderManager.getShader("luminance/luminance.frag", defines);
+            auto resolveFragment = shaderManager.getShader("luminance/resolve.frag", defines);
+
+            mResolveProgram = shaderManager.getProgram(vertex, std::move(resolveFragment));
+            mLuminanceProgram = shaderManager.getProgram(std::move(vertex), std::move(luminanceFragment));
+        }
 
         for (auto& buffer : mBuffers)
         {
+            buffer.luminanceTex = new osg::Texture2D;
+            buffer.luminanceTex->setInternalFormat(GL_R16F);
+            buffer.luminanceTex->setSourceFormat(GL_RED);
+            buffer.luminanceTex->setSourceType(GL_FLOAT);
+            buffer.luminanceTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            buffer.luminanceTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            buffer.luminanceTex->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::NEAREST);
+            buffer.luminanceTex->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::NEAREST);
+            buffer.luminanceTex->setTextureSize(1, 1);
+
+            if (mUseCompute)
+            {
+                buffer.partialSumsTex = new osg::Texture2D;
+                buffer.partialSumsTex->setInternalFormat(GL_R32F);
+                buffer.partialSumsTex->setSourceFormat(GL_RED);
+                buffer.partialSumsTex->setSourceType(GL_FLOAT);
+                buffer.partialSumsTex->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::NEAREST);
+                buffer.partialSumsTex->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::NEAREST);
+                buffer.partialSumsTex->setTextureSize(1, 1);
+
+                // bindings are set in the compute shaders
+                buffer.reduceSS = new osg::StateSet;
+                buffer.reduceSS->setAttributeAndModes(mReduceProgram);
+
+                buffer.reduceResolveSS = new osg::StateSet;
+                buffer.reduceResolveSS->setAttributeAndModes(mReduceResolveProgram);
+                buffer.reduceResolveSS->addUniform(new osg::Uniform("pixelCount", 1.f));
+                buffer.reduceResolveSS->addUniform(new osg::Uniform("warmUp", true));
+                continue;
+            }
+
             buffer.mipmappedSceneLuminanceTex = new osg::Texture2D;
             buffer.mipmappedSceneLuminanceTex->setInternalFormat(GL_R16F);
             buffer.mipmappedSceneLuminanceTex->setSourceFormat(GL_RED);
@@ -34,16 +88,6 @@ namespace MWRender
             buffer.mipmappedSceneLuminanceTex->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::LINEAR);
             buffer.mipmappedSceneLuminanceTex->setTextureSize(mWidth, mHeight);
 
-            buffer.luminanceTex = new osg::Texture2D;
-            buffer.luminanceTex->setInternalFormat(GL_R16F);
-            buffer.luminanceTex->setSourceFormat(GL_RED);
-            buffer.luminanceTex->setSourceType(GL_FLOAT);
-            buffer.luminanceTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            buffer.luminanceTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            buffer.luminanceTex->setFilter(osg::Texture2D::MIN_FILTER, osg::Texture2D::NEAREST);
-            buffer.luminanceTex->setFilter(osg::Texture2D::MAG_FILTER, osg::Texture2D::NEAREST);
-            buffer.luminanceTex->setTextureSize(1, 1);
-
             buffer.luminanceProxyTex = new osg::Texture2D(*buffer.luminanceTex);
             buffer.luminanceProxyTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
             buffer.luminanceProxyTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
@@ -68,12 +112,33 @@ namespace MWRender
             buffer.resolveSS->addUniform(new osg::Uniform("prevLuminanceSceneTex", 1));
         }
 
-        mBuffers[0].resolveSS->setTextureAttributeAndModes(1, mBuffers[1].luminanceTex);
-        mBuffers[1].resolveSS->setTextureAttributeAndModes(1, mBuffers[0].luminanceTex);
+        if (mUseCompute)
+        {
+            mBuffers[0].reduceResolveSS->setTextureAttributeAndModes(1, mBuffers[1].luminanceTex);
+            mBuffers[1].reduceResolveSS->setTextureAttributeAndModes(1, mBuffers[0].luminanceTex);
+        }
+        else
+        {
+            mBuffers[0].resolveSS->setTextureAttributeAndModes(1, mBuffers[1].luminanceTex);
+            mBuffers[1].resolveSS->setTextureAttributeAndModes(1, mBuffers[0].luminanceTex);
+        }
     }
 
     void LuminanceCalculator::compile()
     {
+        if (mUseCompute)
+        {
+            for (auto& buffer : mBuffers)
+            {
+                buffer.partialSumsTex->setTextureSize((mSceneWidth + 31) / 32, (mSceneHeight + 31) / 32);
+                buffer.partialSumsTex->dirtyTextureObject();
+                buffer.reduceResolveSS->getUniform("pixelCount")->set(static_cast<float>(mSceneWidth * mSceneHeight));
+            }
+
+            mCompiled = true;
+            return;
+        }
+
         int mipmapLevels = osg::Image::computeNumberOfMipmapLevels(mWidth, mHeight);
 
         for (auto& buffer : mBuffers)
@@ -105,6 +170,15 @@ namespace MWRender
         if (dirty)
             compile();
 
+        if (mUseCompute)
+            drawCompute(canvas, state, ext, frameId);
+        else
+            drawFragment(canvas, renderInfo, state, ext, frameId);
+    }
+
+    void LuminanceCalculator::drawFragment(const PingPongCanvas& canvas, osg::RenderInfo& renderInfo,
+        osg::State& state, osg::GLExtensions* ext, size_t frameId)
+    {
         auto& buffer = mBuffers[frameId];
         buffer.sceneLumFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
         buffer.sceneLumSS->setTextureAttributeAndModes(0, canvas.getSceneTexture(frameId));
@@ -138,6 +212,44 @@ namespace MWRender
             GL_FRAMEBUFFER_EXT, state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0);
     }
 
+    void LuminanceCalculator::drawCompute(
+        const PingPongCanvas& canvas, osg::State& state, osg::GLExtensions* ext, size_t frameId)
+    {
+        const std::size_t contextID = state.getContextID();
+
+        const auto bindImage = [&](osg::Texture2D* texture, GLuint index, GLenum access, GLenum format) {
+            osg::Texture::TextureObject* to = texture->getTextureObject(contextID);
+            if (!to || texture->isDirty(contextID))
+            {
+                state.applyTextureAttribute(index, texture);
+                to = texture->getTextureObject(contextID);
+            }
+            ext->glBindImageTexture(index, to->id(), 0, GL_FALSE, 0, access, format);
+        };
+
+        auto& buffer = mBuffers[frameId];
+
+        // PASS: Sum the log luminance of the scene per workgroup
+        buffer.reduceSS->setTextureAttributeAndModes(0, canvas.getSceneTexture(frameId));
+        state.apply(buffer.reduceSS);
+        bindImage(buffer.partialSumsTex, 1, GL_WRITE_ONLY_ARB, GL_R32F);
+
+        ext->glDispatchCompute(
+            buffer.partialSumsTex->getTextureWidth(), buffer.partialSumsTex->getTextureHeight(), 1);
+        ext->glMemoryBarrier(GL_ALL_BARRIER_BITS);
+
+        // PASS: Sum the workgroup results and adapt to the new average luminance
+        buffer.reduceResolveSS->getUniform("warmUp")->set(mIsBlank);
+        mIsBlank = false;
+
+        state.apply(buffer.reduceResolveSS);
+        bindImage(buffer.partialSumsTex, 0, GL_READ_ONLY_ARB, GL_R32F);
+        bindImage(buffer.luminanceTex, 2, GL_WRITE_ONLY_ARB, GL_R16F);
+
+        ext->glDispatchCompute(1, 1, 1);
+        ext->glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    }
+
     osg::ref_ptr<osg::Texture2D> LuminanceCalculator::getLuminanceTexture(size_t frameId) const
     {
         return mBuffers[frameId].luminanceTex;
@@ -152,6 +264,9 @@ namespace MWRender
 
         mScale = osg::Vec2f(w / static_cast<float>(mWidth), h / static_cast<float>(mHeight));
 
+        mSceneWidth = std::max(1, w);
+        mSceneHeight = std::max(1, h);
+
         mCompiled = false;
     }
 }
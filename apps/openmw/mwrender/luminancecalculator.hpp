@@ -39,6 +39,11 @@ namespace MWRender
     private:
         void compile();
 
+        void drawFragment(const PingPongCanvas& canvas, osg::RenderInfo& renderInfo, osg::State& state,
+            osg::GLExtensions* ext, size_t frameId);
+
+        void drawCompute(const PingPongCanvas& canvas, osg::State& state, osg::GLExtensions* ext, size_t frameId);
+
         struct Container
         {
             osg::ref_ptr<osg::FrameBufferObject> sceneLumFbo;
@@ -50,18 +55,27 @@ namespace MWRender
             osg::ref_ptr<osg::Texture2D> luminanceProxyTex;
             osg::ref_ptr<osg::StateSet> sceneLumSS;
             osg::ref_ptr<osg::StateSet> resolveSS;
+            // Used by the compute pipeline, holds the sum of the log luminance of every 32x32 block of the scene
+            osg::ref_ptr<osg::Texture2D> partialSumsTex;
+            osg::ref_ptr<osg::StateSet> reduceSS;
+            osg::ref_ptr<osg::StateSet> reduceResolveSS;
         };
 
         std::array<Container, 2> mBuffers;
         osg::ref_ptr<osg::Program> mLuminanceProgram;
         osg::ref_ptr<osg::Program> mResolveProgram;
+        osg::ref_ptr<osg::Program> mReduceProgram;
+        osg::ref_ptr<osg::Program> mReduceResolveProgram;
 
+        bool mUseCompute = false;
         bool mCompiled = false;
         bool mEnabled = false;
         bool mIsBlank = true;
 
         int mWidth = 1;
         int mHeight = 1;
+        int mSceneWidth = 1;
+        int mSceneHeight = 1;
         osg::Vec2f mScale = osg::Vec2f(1, 1);
     };
 }
@@ -246,7 +246,8 @@ namespace MWRender
                     std::swap(latestCandidate, *it);
                 }
                 if (*it != nullptr)
-                    mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(*it)));
+                    mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(*it)),
+                        SceneUtil::WorkPriority::Speculative);
                 it = mWorkItems.erase(it);
             }
 
@@ -276,7 +277,8 @@ namespace MWRender
                     }
                 }
 
-                mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)));
+                mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)),
+                    SceneUtil::WorkPriority::Speculative);
             }
         }
 
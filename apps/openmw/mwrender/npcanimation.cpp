@@ -7,6 +7,9 @@
 #include <osgUtil/CullVisitor>
 #include <osgUtil/RenderBin>
 
+#include <algorithm>
+#include <typeinfo>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/misc/rng.hpp>
@@ -21,7 +24,10 @@
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/lightcommon.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/rigmerger.hpp>
 #include <components/sceneutil/visitor.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 
 #include <components/vfs/manager.hpp>
@@ -47,6 +53,59 @@
 
 namespace
 {
+    // Whether a node of a body part renders the same at any time, so its skinned geometry can be drawn as part of a
+    // merged geometry instead
+    bool isStatic(const osg::Node& node)
+    {
+        if (node.getNodeMask() == 0 || node.getUpdateCallback() != nullptr || node.getCullCallback() != nullptr
+            || node.getEventCallback() != nullptr)
+            return false;
+
+        if (typeid(node) != typeid(osg::Group) && typeid(node) != typeid(SceneUtil::RigGeometry)
+            && dynamic_cast<const osg::MatrixTransform*>(&node) == nullptr)
+            return false;
+
+        if (const osg::StateSet* stateSet = node.getStateSet())
+        {
+            if (stateSet->getUpdateCallback() != nullptr || stateSet->getEventCallback() != nullptr
+                || stateSet->getRenderingHint() == osg::StateSet::TRANSPARENT_BIN
+                || stateSet->getRenderBinMode() != osg::StateSet::INHERIT_RENDERBIN_DETAILS)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool equalStateSets(const osg::StateSet* left, const osg::StateSet* right)
+    {
+        if (left == right)
+            return true;
+        return left != nullptr && right != nullptr && left->compare(*right, true) == 0;
+    }
+
+    class CollectMergeableRigsVisitor : public osg::NodeVisitor
+    {
+    public:
+        CollectMergeableRigsVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            if (typeid(drawable) != typeid(SceneUtil::RigGeometry))
+                return;
+
+            for (const osg::Node* node : getNodePath())
+                if (!isStatic(*node))
+                    return;
+
+            mRigs.emplace_back(static_cast<SceneUtil::RigGeometry*>(&drawable), getNodePath());
+        }
+
+        // With the path from the visited node to each of them
+        std::vector<std::pair<osg::ref_ptr<SceneUtil::RigGeometry>, osg::NodePath>> mRigs;
+    };
 
     std::string getVampireHead(const ESM::RefId& race, bool female)
     {
@@ -251,8 +310,92 @@ namespace MWRender
     }
     const NpcAnimation::PartBoneMap NpcAnimation::sPartList = createPartListMap();
 
+    class NpcAnimation::BodyPartMerge : public SceneUtil::WorkItem
+    {
+    public:
+        struct Source
+        {
+            ESM::PartReferenceType mType;
+            osg::ref_ptr<osg::Node> mPart;
+            osg::ref_ptr<SceneUtil::RigGeometry> mRig;
+            // From the part node to the RigGeometry
+            osg::NodePath mPath;
+        };
+
+        struct Group
+        {
+            std::vector<Source> mSources;
+            std::size_t mVertexCount = 0;
+            osg::ref_ptr<SceneUtil::RigGeometry> mMerged;
+        };
+
+        std::vector<Group> mGroups;
+
+        // Nodes added to the object root to draw the merged geometries
+        std::vector<osg::ref_ptr<osg::Node>> mCreated;
+
+        // Source RigGeometries hidden while the merged geometries are shown, with their node masks
+        std::vector<std::pair<osg::ref_ptr<osg::Node>, osg::Node::NodeMask>> mHidden;
+
+        void doWork() override
+        {
+            for (Group& group : mGroups)
+            {
+                if (isCancelled())
+                    return;
+
+                std::vector<osg::ref_ptr<SceneUtil::RigGeometry>> rigs;
+                rigs.reserve(group.mSources.size());
+                for (const Source& source : group.mSources)
+                    rigs.push_back(source.mRig);
+
+                try
+                {
+                    group.mMerged = SceneUtil::mergeRigGeometries(rigs);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to merge NPC body parts: " << e.what();
+                }
+            }
+        }
+
+        bool contains(ESM::PartReferenceType type) const
+        {
+            for (const Group& group : mGroups)
+                for (const Source& source : group.mSources)
+                    if (source.mType == type)
+                        return true;
+            return false;
+        }
+
+        static bool canShare(const Group& group, const Source& source)
+        {
+            const Source& first = group.mSources.front();
+            if (first.mPath.size() != source.mPath.size()
+                || first.mRig->getGpuSkinning() != source.mRig->getGpuSkinning()
+                || group.mVertexCount + SceneUtil::getRigVertexCount(*source.mRig) > SceneUtil::sMaxMergedRigVertices)
+                return false;
+
+            if (!equalStateSets(first.mRig->getSourceGeometry()->getStateSet(),
+                    source.mRig->getSourceGeometry()->getStateSet()))
+                return false;
+
+            for (std::size_t i = 0; i < first.mPath.size(); ++i)
+            {
+                if (first.mPath[i]->getNodeMask() != source.mPath[i]->getNodeMask()
+                    || !equalStateSets(first.mPath[i]->getStateSet(), source.mPath[i]->getStateSet()))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
     NpcAnimation::~NpcAnimation()
     {
+        if (mPendingBodyPartMerge != nullptr)
+            mPendingBodyPartMerge->cancel();
         mAmmunition.reset();
     }
 
@@ -267,6 +410,8 @@ namespace MWRender
         , mSoundsDisabled(disableSounds)
         , mAccurateAiming(false)
         , mAimingFactor(0.f)
+        , mMergeBodyParts(false)
+        , mBodyPartsChanged(false)
     {
         mNpc = mPtr.get<ESM::NPC>()->mBase;
 
@@ -689,8 +834,149 @@ namespace MWRender
         return std::make_unique<PartHolder>(attached);
     }
 
+    void NpcAnimation::updateBodyPartMerge()
+    {
+        if (mPendingBodyPartMerge != nullptr && mPendingBodyPartMerge->isDone())
+        {
+            const osg::ref_ptr<BodyPartMerge> merge = mPendingBodyPartMerge;
+            mPendingBodyPartMerge = nullptr;
+
+            bool valid = !merge->isCancelled();
+            for (const BodyPartMerge::Group& group : merge->mGroups)
+                for (const BodyPartMerge::Source& source : group.mSources)
+                    valid = valid && mObjectParts[source.mType] != nullptr
+                        && mObjectParts[source.mType]->getNode() == source.mPart;
+
+            if (valid)
+            {
+                resetBodyPartMerge();
+                applyBodyPartMerge(*merge);
+                mBodyPartMerge = merge;
+            }
+        }
+
+        if (!mBodyPartsChanged)
+            return;
+        mBodyPartsChanged = false;
+
+        if (mPendingBodyPartMerge != nullptr)
+        {
+            mPendingBodyPartMerge->cancel();
+            mPendingBodyPartMerge = nullptr;
+        }
+
+        // The parts are drawn separately until the new merge is done, the hidden ones wouldn't be collected otherwise
+        resetBodyPartMerge();
+
+        if (!mMergeBodyParts || mViewMode != VM_Normal || mObjectRoot == nullptr)
+            return;
+
+        osg::ref_ptr<BodyPartMerge> merge = new BodyPartMerge;
+        for (std::size_t i = 0; i < ESM::PRT_Count; ++i)
+        {
+            if (mObjectParts[i] == nullptr)
+                continue;
+
+            // Skinned parts are attached to the skeleton, other parts are drawn where their bone is
+            osg::Node* part = mObjectParts[i]->getNode();
+            if (part->getNumParents() != 1 || part->getParent(0) != mObjectRoot)
+                continue;
+
+            CollectMergeableRigsVisitor visitor;
+            part->accept(visitor);
+            for (auto& [rig, path] : visitor.mRigs)
+            {
+                BodyPartMerge::Source source{ static_cast<ESM::PartReferenceType>(i), part, std::move(rig),
+                    std::move(path) };
+
+                auto group = std::find_if(merge->mGroups.begin(), merge->mGroups.end(),
+                    [&](const BodyPartMerge::Group& v) { return BodyPartMerge::canShare(v, source); });
+                if (group == merge->mGroups.end())
+                    group = merge->mGroups.emplace(merge->mGroups.end());
+
+                group->mVertexCount += SceneUtil::getRigVertexCount(*source.mRig);
+                group->mSources.push_back(std::move(source));
+            }
+        }
+
+        std::erase_if(merge->mGroups, [](const BodyPartMerge::Group& v) { return v.mSources.size() < 2; });
+        if (merge->mGroups.empty())
+            return;
+
+        mPendingBodyPartMerge = std::move(merge);
+        mResourceSystem->getSceneManager()->getWorkQueue()->addWorkItem(
+            mPendingBodyPartMerge, SceneUtil::WorkPriority::Visible);
+    }
+
+    void NpcAnimation::applyBodyPartMerge(BodyPartMerge& merge)
+    {
+        for (const BodyPartMerge::Group& group : merge.mGroups)
+        {
+            if (group.mMerged == nullptr)
+                continue;
+
+            // The skinned vertices are in the space of the skeleton, so only the state of the nodes on the way to the
+            // RigGeometry has to be kept
+            const osg::NodePath& path = group.mSources.front().mPath;
+            osg::Group* parent = mObjectRoot;
+            for (std::size_t i = 0; i + 1 < path.size(); ++i)
+            {
+                osg::ref_ptr<osg::Group> node = new osg::Group;
+                node->setName(path[i]->getName());
+                node->setNodeMask(path[i]->getNodeMask());
+                node->setStateSet(path[i]->getStateSet());
+                parent->addChild(node);
+                if (i == 0)
+                    merge.mCreated.push_back(node);
+                parent = node;
+            }
+
+            group.mMerged->setName(path.back()->getName());
+            group.mMerged->setNodeMask(path.back()->getNodeMask());
+            parent->addChild(group.mMerged);
+            if (path.size() == 1)
+                merge.mCreated.push_back(group.mMerged);
+
+            for (const BodyPartMerge::Source& source : group.mSources)
+            {
+                merge.mHidden.emplace_back(source.mRig, source.mRig->getNodeMask());
+                source.mRig->setNodeMask(0);
+            }
+        }
+    }
+
+    void NpcAnimation::resetBodyPartMerge()
+    {
+        if (mBodyPartMerge == nullptr)
+            return;
+
+        for (const osg::ref_ptr<osg::Node>& node : mBodyPartMerge->mCreated)
+        {
+            const osg::Node::ParentList parents = node->getParents();
+            for (osg::Group* parent : parents)
+                parent->removeChild(node);
+        }
+
+        for (const auto& [node, mask] : mBodyPartMerge->mHidden)
+            node->setNodeMask(mask);
+
+        mBodyPartMerge = nullptr;
+    }
+
+    void NpcAnimation::enableBodyPartMerging(bool enable)
+    {
+        if (mMergeBodyParts == enable)
+            return;
+        mMergeBodyParts = enable;
+        mBodyPartsChanged = true;
+        if (!enable)
+            resetBodyPartMerge();
+    }
+
     osg::Vec3f NpcAnimation::runAnimation(float timepassed)
     {
+        updateBodyPartMerge();
+
         osg::Vec3f ret = Animation::runAnimation(timepassed);
 
         mHeadAnimationTime->update(timepassed);
@@ -719,6 +1005,11 @@ namespace MWRender
         mPartPriorities[type] = 0;
         mPartslots[type] = -1;
 
+        if (mBodyPartMerge != nullptr && mBodyPartMerge->contains(type))
+            resetBodyPartMerge();
+        if (mObjectParts[type] != nullptr)
+            mBodyPartsChanged = true;
+
         mObjectParts[type].reset();
         if (mSounds[type] != nullptr && !mSoundsDisabled)
         {
@@ -786,6 +1077,7 @@ namespace MWRender
             // attachment bone
             const std::string_view bonefilter = (type == ESM::PRT_Hair) ? std::string_view{ "hair" } : bonename;
             mObjectParts[type] = insertBoundedPart(mesh, bonename, bonefilter, enchantedGlow, glowColor, isLight);
+            mBodyPartsChanged = true;
         }
         catch (std::exception& e)
         {
@@ -79,6 +79,14 @@ namespace MWRender
         bool mAccurateAiming;
         float mAimingFactor;
 
+        class BodyPartMerge;
+        bool mMergeBodyParts;
+        bool mBodyPartsChanged;
+        /// Merge of the skinned body parts built on a worker thread
+        osg::ref_ptr<BodyPartMerge> mPendingBodyPartMerge;
+        /// Merge of the skinned body parts shown instead of them
+        osg::ref_ptr<BodyPartMerge> mBodyPartMerge;
+
         void updateNpcBase();
 
         NpcType getNpcType() const;
@@ -97,6 +105,10 @@ namespace MWRender
 
         void setRenderBin();
 
+        void updateBodyPartMerge();
+        void applyBodyPartMerge(BodyPartMerge& merge);
+        void resetBodyPartMerge();
+
         osg::ref_ptr<RotateController> mFirstPersonNeckController;
 
         static bool isFemalePart(const ESM::BodyPart* bodypart);
@@ -124,6 +136,10 @@ namespace MWRender
 
         void enableHeadAnimation(bool enable) override;
 
+        /// Combine the skinned body parts that render with the same state into one mesh, rebuilt on a worker thread
+        /// after the parts change. Not used in the first person view.
+        void enableBodyPartMerging(bool enable);
+
         /// 1: the first person meshes follow the camera's rotation completely
         /// 0: the first person meshes follow the camera with a reduced factor, so you can look down at your own hands
         void setAccurateAiming(bool enabled) override;
@@ -1,6 +1,11 @@
 #include "objectpaging.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <osg/LOD>
@@ -8,6 +13,7 @@
 #include <osg/MatrixTransform>
 #include <osg/Sequence>
 #include <osg/Switch>
+#include <osg/VertexAttribDivisor>
 #include <osgAnimation/BasicAnimationManager>
 #include <osgParticle/ParticleProcessor>
 #include <osgParticle/ParticleSystemUpdater>
@@ -19,7 +25,7 @@
 #include <components/esm3/loadcont.hpp>
 #include <components/esm3/loaddoor.hpp>
 #include <components/esm3/loadstat.hpp>
-#include <components/esm3/readerscache.hpp>
+#include <components/esm3/sharedreaders.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -31,12 +37,14 @@
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "apps/openmw/mwbase/environment.hpp"
 #include "apps/openmw/mwbase/world.hpp"
 #include "apps/openmw/mwworld/esmstore.hpp"
 
+#include "instancing.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
@@ -78,7 +86,8 @@ namespace MWRender
     }
 
     osg::ref_ptr<osg::Node> ObjectPaging::getChunk(float size, const osg::Vec2f& center, unsigned char /*lod*/,
-        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile,
+        const std::atomic<bool>* abort)
     {
         if (activeGrid && !mActiveGrid)
             return nullptr;
@@ -89,8 +98,9 @@ namespace MWRender
             return static_cast<osg::Node*>(obj.get());
 
         const unsigned char lod = static_cast<unsigned char>(lodFlags >> (4 * 4));
-        osg::ref_ptr<osg::Node> node = createChunk(size, center, activeGrid, viewPoint, compile, lod);
-        mCache->addEntryToObjectCache(id, node.get());
+        osg::ref_ptr<osg::Node> node = createChunk(size, center, activeGrid, viewPoint, compile, lod, abort);
+        if (node != nullptr)
+            mCache->addEntryToObjectCache(id, node.get());
         return node;
     }
 
@@ -136,6 +146,8 @@ namespace MWRender
             osg::Vec3f mViewVector;
             osg::Node::NodeMask mCopyMask = ~0u;
             mutable std::vector<const osg::Node*> mNodePath;
+            // Cleared when the copy contains something that depends on the position of each instance
+            mutable bool mInstanceable = true;
 
             void copy(const osg::Node* toCopy, osg::Group* attachTo)
             {
@@ -184,6 +196,7 @@ namespace MWRender
                         return children.front().first.release();
                     else
                     {
+                        mInstanceable = false;
                         osg::LOD* n = new osg::LOD;
                         for (const auto& [child, range] : children)
                             n->addChild(child, range.first, range.second);
@@ -228,6 +241,8 @@ namespace MWRender
                             cloned->setDataVariance(osg::Object::DYNAMIC);
                     }
 
+                    mInstanceable = false;
+
                     if (node->getCullCallback()->getNestedCallback())
                     {
                         osg::Callback* clonedCallback = osg::clone(callback, osg::CopyOp::SHALLOW_COPY);
@@ -449,18 +464,34 @@ namespace MWRender
         };
     }
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
+    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::SharedReaders& readers, ESM::RefId worldspace)
         : GenericResourceManager<ChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , Terrain::QuadTreeWorld::ChunkManager(worldspace)
         , mSceneManager(sceneManager)
+        , mReaders(readers)
         , mActiveGrid(Settings::terrain().mObjectPagingActiveGrid)
         , mDebugBatches(Settings::terrain().mDebugChunks)
         , mMergeFactor(Settings::terrain().mObjectPagingMergeFactor)
         , mMinSize(Settings::terrain().mObjectPagingMinSize)
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
+        , mInstancing(Settings::terrain().mObjectPagingInstancing)
+        , mInstancingMinInstances(static_cast<std::size_t>(Settings::terrain().mObjectPagingInstancingMinInstances))
         , mRefTrackerLocked(false)
     {
+        if (mInstancing)
+        {
+            mInstancingStateSet = new osg::StateSet;
+            mInstancingStateSet->setAttribute(new osg::VertexAttribDivisor(6, 1));
+            mInstancingStateSet->setAttribute(new osg::VertexAttribDivisor(7, 1));
+            mInstancingStateSet->addUniform(new osg::Uniform("useInstancing", true));
+
+            mInstancingProgramTemplate = mSceneManager->getShaderManager().getProgramTemplate()
+                ? Shader::ShaderManager::cloneProgram(mSceneManager->getShaderManager().getProgramTemplate())
+                : osg::ref_ptr<osg::Program>(new osg::Program);
+            mInstancingProgramTemplate->addBindAttribLocation("aOffset", 6);
+            mInstancingProgramTemplate->addBindAttribLocation("aRotation", 7);
+        }
     }
 
     namespace
@@ -485,105 +516,354 @@ namespace MWRender
             };
         }
 
-        std::map<ESM::RefNum, PagedCellRef> collectESM3References(
-            float size, const osg::Vec2i& startCell, const MWWorld::ESMStore& store)
+        struct CellRef
         {
-            std::map<ESM::RefNum, PagedCellRef> refs;
-            ESM::ReadersCache readers;
-            for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
+            PagedCellRef mRef;
+            int mType;
+            bool mDeleted;
+            bool mLeased;
+        };
+
+        std::vector<CellRef> readCellRefs(
+            const ESM::Cell& cell, const MWWorld::ESMStore& store, ESM::SharedReaders& readers)
+        {
+            std::vector<CellRef> refs;
+            ESM::SharedReaders::Reader reader(readers);
+            for (const ESM::ESM_Context& context : cell.mContextList)
             {
-                for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
+                try
                 {
-                    const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
-                    if (!cell)
-                        continue;
-                    for (size_t i = 0; i < cell->mContextList.size(); ++i)
+                    ESM::ESMReader& esm = reader.restore(context);
+                    ESM::CellRef ref;
+                    ESM::MovedCellRef cMRef;
+                    bool deleted = false;
+                    bool moved = false;
+                    while (ESM::Cell::getNextRef(
+                        esm, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
                     {
-                        try
-                        {
-                            const std::size_t index = static_cast<std::size_t>(cell->mContextList[i].index);
-                            const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                            cell->restore(*reader, i);
-                            ESM::CellRef ref;
-                            ESM::MovedCellRef cMRef;
-                            bool deleted = false;
-                            bool moved = false;
-                            while (ESM::Cell::getNextRef(
-                                *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
-                            {
-                                if (moved)
-                                    continue;
-
-                                if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum)
-                                    != cell->mMovedRefs.end())
-                                    continue;
-
-                                int type = store.findStatic(ref.mRefID);
-                                if (!typeFilter(type, size >= 2))
-                                    continue;
-                                if (deleted)
-                                {
-                                    refs.erase(ref.mRefNum);
-                                    continue;
-                                }
-                                refs.insert_or_assign(ref.mRefNum, makePagedCellRef(ref));
-                            }
-                        }
-                        catch (const std::exception& e)
-                        {
-                            Log(Debug::Warning) << "Failed to collect references from cell \"" << cell->getDescription()
-                                                << "\": " << e.what();
+                        if (moved)
                             continue;
-                        }
-                    }
-                    for (const auto& [ref, deleted] : cell->mLeasedRefs)
-                    {
-                        if (deleted)
-                        {
-                            refs.erase(ref.mRefNum);
+
+                        if (std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum)
+                            != cell.mMovedRefs.end())
                             continue;
-                        }
-                        int type = store.findStatic(ref.mRefID);
-                        if (!typeFilter(type, size >= 2))
+
+                        const int type = store.findStatic(ref.mRefID);
+                        if (!typeFilter(type, false))
                             continue;
-                        refs.insert_or_assign(ref.mRefNum, makePagedCellRef(ref));
+                        refs.push_back(CellRef{ makePagedCellRef(ref), type, deleted, false });
                     }
                 }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to collect references from cell \"" << cell.getDescription()
+                                        << "\": " << e.what();
+                    continue;
+                }
+            }
+            for (const auto& [ref, deleted] : cell.mLeasedRefs)
+                refs.push_back(CellRef{ makePagedCellRef(ref), store.findStatic(ref.mRefID), deleted, true });
+            return refs;
+        }
+
+        // Keeps the last state of each reference, sorted by RefNum
+        std::vector<const PagedCellRef*> collectPagedRefs(
+            std::vector<std::pair<ESM::RefNum, const PagedCellRef*>>& states)
+        {
+            std::stable_sort(states.begin(), states.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            std::vector<const PagedCellRef*> refs;
+            refs.reserve(states.size());
+            for (auto it = states.begin(); it != states.end(); ++it)
+            {
+                const auto next = std::next(it);
+                if (next != states.end() && next->first == it->first)
+                    continue;
+                if (it->second != nullptr)
+                    refs.push_back(it->second);
             }
             return refs;
         }
+
+        bool containsSorted(const std::vector<ESM::RefNum>& values, ESM::RefNum value)
+        {
+            return std::binary_search(values.begin(), values.end(), value);
+        }
+
+        bool insertSorted(std::vector<ESM::RefNum>& values, ESM::RefNum value)
+        {
+            const auto it = std::lower_bound(values.begin(), values.end(), value);
+            if (it != values.end() && *it == value)
+                return false;
+            values.insert(it, value);
+            return true;
+        }
+
+        bool eraseSorted(std::vector<ESM::RefNum>& values, ESM::RefNum value)
+        {
+            const auto it = std::lower_bound(values.begin(), values.end(), value);
+            if (it == values.end() || *it != value)
+                return false;
+            values.erase(it);
+            return true;
+        }
+
+        osg::Matrix computeInstanceMatrix(const PagedCellRef& ref, const osg::Vec3f& worldCenter)
+        {
+            return osg::Matrix::scale(ref.mScale, ref.mScale, ref.mScale)
+                * osg::Matrix::rotate(osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
+                    * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
+                    * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0)))
+                * osg::Matrix::translate(ref.mPosition - worldCenter);
+        }
+
+        class CanInstanceVisitor : public osg::NodeVisitor
+        {
+        public:
+            CanInstanceVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            bool mResult = true;
+
+            void apply(osg::Transform& node) override { mResult = false; }
+
+            void apply(osg::Drawable& node) override
+            {
+                if (!node.asGeometry())
+                    mResult = false;
+            }
+
+            void apply(osg::Geometry& node) override {}
+        };
+
+        class InstancingVisitor : public osg::NodeVisitor
+        {
+        public:
+            InstancingVisitor(const std::vector<const PagedCellRef*>& instances, const osg::Vec3f& worldCenter)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mInstances(instances)
+                , mWorldCenter(worldCenter)
+            {
+            }
+
+            void apply(osg::Geometry& geom) override
+            {
+                for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i)
+                    geom.getPrimitiveSet(i)->setNumInstances(mInstances.size());
+
+                osg::ref_ptr<osg::Vec4Array> transforms = new osg::Vec4Array(mInstances.size());
+                osg::ref_ptr<osg::Vec3Array> rotations = new osg::Vec3Array(mInstances.size());
+                std::vector<osg::Matrix> instanceMatrices;
+                instanceMatrices.reserve(mInstances.size());
+                const osg::BoundingBox originalBox = geom.getBoundingBox();
+                osg::BoundingBox box;
+                for (std::size_t i = 0; i < mInstances.size(); ++i)
+                {
+                    const PagedCellRef& ref = *mInstances[i];
+                    (*transforms)[i] = osg::Vec4f(ref.mPosition - mWorldCenter, ref.mScale);
+                    (*rotations)[i] = ref.mRotation;
+                    instanceMatrices.push_back(computeInstanceMatrix(ref, mWorldCenter));
+                    for (unsigned int corner = 0; corner < 8; ++corner)
+                        box.expandBy(originalBox.corner(corner) * instanceMatrices.back());
+                }
+
+                geom.setInitialBound(box);
+
+                // Display lists do not support instancing in OSG 3.4
+                geom.setUseDisplayList(false);
+                geom.setUseVertexBufferObjects(true);
+
+                // The vertex data may be shared with the nodes of other chunks, keep the instance data apart from it
+                osg::ref_ptr<osg::VertexBufferObject> vbo = new osg::VertexBufferObject;
+                transforms->setVertexBufferObject(vbo);
+                rotations->setVertexBufferObject(vbo);
+                geom.setVertexAttribArray(6, transforms, osg::Array::BIND_PER_VERTEX);
+                geom.setVertexAttribArray(7, rotations, osg::Array::BIND_PER_VERTEX);
+                geom.setUserValue("instancing", true);
+
+                geom.addCullCallback(new InstancedComputeNearFarCullCallback(
+                    std::make_shared<const std::vector<osg::Matrix>>(std::move(instanceMatrices)), originalBox));
+            }
+
+        private:
+            const std::vector<const PagedCellRef*>& mInstances;
+            osg::Vec3f mWorldCenter;
+        };
+
+        /// Append the index of the child each LOD of the node keeps for the distances, in the order they are copied.
+        /// @return false if a LOD keeps several children, which can't be drawn using instancing
+        bool getLodSelection(const osg::Node& node, const LODRange& distances, osg::Node::NodeMask copyMask,
+            std::vector<unsigned>& selection)
+        {
+            if (!(node.getNodeMask() & copyMask))
+                return true;
+            const osg::Group* const group = node.asGroup();
+            if (group == nullptr)
+                return true;
+            if (const osg::LOD* lod = dynamic_cast<const osg::LOD*>(&node))
+            {
+                unsigned chosen = lod->getNumChildren();
+                for (unsigned int i = 0; i < lod->getNumChildren(); ++i)
+                {
+                    if (empty(intersection(lod->getRangeList()[i], distances)))
+                        continue;
+                    if (chosen != lod->getNumChildren())
+                        return false;
+                    chosen = i;
+                }
+                selection.push_back(chosen);
+                return chosen == lod->getNumChildren()
+                    || getLodSelection(*lod->getChild(chosen), distances, copyMask, selection);
+            }
+            for (unsigned int i = 0; i < group->getNumChildren(); ++i)
+                if (!getLodSelection(*group->getChild(i), distances, copyMask, selection))
+                    return false;
+            return true;
+        }
+
+        osg::ref_ptr<osg::Group> optimizeInstancedNode(
+            const osg::Node& node, CopyOp& copyop, SceneUtil::WorkQueue* workQueue)
+        {
+            osg::ref_ptr<osg::Group> result = new osg::Group;
+            copyop.copy(&node, result);
+            if (!copyop.mInstanceable)
+                return nullptr;
+
+            SceneUtil::Optimizer optimizer;
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+            optimizer.setWorkQueue(workQueue);
+            optimizer.optimize(result,
+                SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                    | SceneUtil::Optimizer::MERGE_GEOMETRY);
+
+            CanInstanceVisitor canInstance;
+            result->accept(canInstance);
+            if (!canInstance.mResult)
+                return nullptr;
+
+            // Keeps the template, and so the key of the cache entry, alive
+            result->getOrCreateUserDataContainer()->addUserObject(new Resource::TemplateRef(&node));
+            return result;
+        }
+
+        /// Copy the node once for all the instances and convert it into instanced geometry.
+        /// @return nullptr if the node can't be drawn using instancing
+        osg::ref_ptr<osg::Group> createInstancedNode(const osg::Node& node,
+            const std::vector<const PagedCellRef*>& instances, const osg::Vec3f& worldCenter, const LODRange& distances,
+            CopyOp& copyop, InstancedTemplateCache& cache, SceneUtil::WorkQueue* workQueue)
+        {
+            const auto [minScale, maxScale] = std::minmax_element(instances.begin(), instances.end(),
+                [](const PagedCellRef* l, const PagedCellRef* r) { return l->mScale < r->mScale; });
+
+            copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES);
+            copyop.mOptimizeBillboards = false;
+            copyop.mInstanceable = true;
+            // LOD children are chosen for the whole chunk, so all the instances have to end up with the same ones
+            copyop.mDistances = { distances.first / (*maxScale)->mScale, distances.second / (*minScale)->mScale };
+
+            // The optimized copy only depends on the LOD children it keeps, so chunks at different distances share it
+            InstancedTemplateKey key{ &node, copyop.mCopyMask, {} };
+            if (!getLodSelection(node, copyop.mDistances, copyop.mCopyMask, std::get<2>(key)))
+                return nullptr;
+
+            osg::ref_ptr<osg::Group> optimized;
+            if (const std::optional<osg::ref_ptr<osg::Object>> cached = cache.getRefFromObjectCacheOrNone(key))
+                optimized = static_cast<osg::Group*>(cached->get());
+            else
+            {
+                optimized = optimizeInstancedNode(node, copyop, workQueue);
+                // Also remember the nodes which can't be instanced. Such an entry doesn't keep the template alive, at
+                // worst a new template at the same address isn't instanced until the entry expires.
+                cache.addEntryToObjectCache(key, optimized.get());
+            }
+            if (optimized == nullptr)
+                return nullptr;
+
+            // Every chunk has its own instance count in the primitive sets
+            osg::ref_ptr<osg::Group> result = static_cast<osg::Group*>(optimized->clone(
+                osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES | osg::CopyOp::DEEP_COPY_PRIMITIVES));
+            InstancingVisitor visitor(instances, worldCenter);
+            result->accept(visitor);
+            return result;
+        }
+    }
+
+    struct ObjectPaging::CellRefs
+    {
+        std::vector<CellRef> mRefs;
+    };
+
+    std::shared_ptr<const ObjectPaging::CellRefs> ObjectPaging::getCellRefs(
+        const osg::Vec2i& cellPosition, const MWWorld::ESMStore& store)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mCellRefsMutex);
+            const auto it = mCellRefs.find(cellPosition);
+            if (it != mCellRefs.end())
+                return it->second;
+        }
+
+        auto cellRefs = std::make_shared<CellRefs>();
+        if (const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellPosition.x(), cellPosition.y()))
+            cellRefs->mRefs = readCellRefs(*cell, store, mReaders);
+
+        std::lock_guard<std::mutex> lock(mCellRefsMutex);
+        return mCellRefs.emplace(cellPosition, std::move(cellRefs)).first->second;
     }
 
     osg::ref_ptr<osg::Node> ObjectPaging::createChunk(float size, const osg::Vec2f& center, bool activeGrid,
-        const osg::Vec3f& viewPoint, bool compile, unsigned char lod)
+        const osg::Vec3f& viewPoint, bool compile, unsigned char lod, const std::atomic<bool>* abort)
     {
+        const auto isAborted = [&] { return abort != nullptr && abort->load(std::memory_order_relaxed); };
+
         const osg::Vec2i startCell(std::floor(center.x() - size / 2.f), std::floor(center.y() - size / 2.f));
         const MWBase::World& world = *MWBase::Environment::get().getWorld();
         const MWWorld::ESMStore& store = world.getStore();
 
-        std::map<ESM::RefNum, PagedCellRef> refs;
+        std::vector<std::shared_ptr<const CellRefs>> cellsRefs;
+        std::vector<std::pair<ESM::RefNum, const PagedCellRef*>> states;
 
         if (mWorldspace == ESM::Cell::sDefaultWorldspaceId)
         {
-            refs = collectESM3References(size, startCell, store);
+            for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
+            {
+                for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
+                {
+                    if (isAborted())
+                        return nullptr;
+                    const std::shared_ptr<const CellRefs>& cellRefs
+                        = cellsRefs.emplace_back(getCellRefs(osg::Vec2i(cellX, cellY), store));
+                    for (const CellRef& ref : cellRefs->mRefs)
+                    {
+                        if ((!ref.mLeased || !ref.mDeleted) && !typeFilter(ref.mType, size >= 2))
+                            continue;
+                        states.emplace_back(ref.mRef.mRefNum, ref.mDeleted ? nullptr : &ref.mRef);
+                    }
+                }
+            }
         }
         else
         {
             // TODO
         }
 
-        if (activeGrid && !refs.empty())
+        std::vector<const PagedCellRef*> refs = collectPagedRefs(states);
+
+        std::vector<bool> disabled;
+        if (!refs.empty())
         {
             std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-            const std::set<ESM::RefNum>& blacklist = getRefTracker().mBlacklist;
-            if (blacklist.size() < refs.size())
-            {
-                for (ESM::RefNum ref : blacklist)
-                    refs.erase(ref);
-            }
-            else
+            const RefTracker& refTracker = getRefTracker();
+            if (activeGrid && !refTracker.mBlacklist.empty())
+                std::erase_if(refs,
+                    [&](const PagedCellRef* ref) { return containsSorted(refTracker.mBlacklist, ref->mRefNum); });
+            if (!refTracker.mDisabled.empty())
             {
-                std::erase_if(refs, [&](const auto& ref) { return blacklist.contains(ref.first); });
+                disabled.reserve(refs.size());
+                for (const PagedCellRef* ref : refs)
+                    disabled.push_back(containsSorted(refTracker.mDisabled, ref->mRefNum));
             }
         }
 
@@ -614,8 +894,14 @@ namespace MWRender
 
         AnalyzeVisitor analyzeVisitor(copyMask);
         const float minSize = mMinSizeMergeFactor ? mMinSize * mMinSizeMergeFactor : mMinSize;
-        for (const auto& [refNum, ref] : refs)
+        for (std::size_t i = 0; i < refs.size(); ++i)
         {
+            if (isAborted())
+                return nullptr;
+
+            const PagedCellRef& ref = *refs[i];
+            const ESM::RefNum refNum = ref.mRefNum;
+
             if (size < 1.f)
             {
                 const osg::Vec3f cellPos = ref.mPosition / cellSize;
@@ -685,11 +971,8 @@ namespace MWRender
                     refnumSet->mRefnums.push_back(refNum);
             }
 
-            {
-                std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-                if (getRefTracker().mDisabled.count(refNum))
-                    continue;
-            }
+            if (!disabled.empty() && disabled[i])
+                continue;
 
             const float radius2 = cnode->getBound().radius2() * ref.mScale * ref.mScale;
             if (radius2 < dSqr * minSize * minSize && !activeGrid)
@@ -723,6 +1006,9 @@ namespace MWRender
         copyop.mCopyMask = copyMask;
         for (const auto& pair : nodes)
         {
+            if (isAborted())
+                return nullptr;
+
             const osg::Node* cnode = pair.first;
 
             const AnalyzeVisitor::Result& analyzeResult = pair.second.mAnalyzeResult;
@@ -736,15 +1022,48 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
-            unsigned int numinstances = 0;
+            std::vector<const PagedCellRef*> instances;
+            instances.reserve(pair.second.mInstances.size());
             for (const PagedCellRef* refPtr : pair.second.mInstances)
             {
-                const PagedCellRef& ref = *refPtr;
-
                 if (!activeGrid && minSizeMerged != minSize
-                    && cnode->getBound().radius2() * ref.mScale * ref.mScale
-                        < (viewPoint - ref.mPosition).length2() * minSizeMerged * minSizeMerged)
+                    && cnode->getBound().radius2() * refPtr->mScale * refPtr->mScale
+                        < (viewPoint - refPtr->mPosition).length2() * minSizeMerged * minSizeMerged)
                     continue;
+                instances.push_back(refPtr);
+            }
+
+            if (mInstancing && !activeGrid && instances.size() >= mInstancingMinInstances)
+            {
+                osg::ref_ptr<osg::Group> instanced = createInstancedNode(*cnode, instances, worldCenter,
+                    { smallestDistanceToChunk, higherDistanceToChunk }, copyop, *mInstancedTemplates,
+                    mSceneManager->getWorkQueue());
+                if (instanced)
+                {
+                    if (mDebugBatches)
+                    {
+                        DebugVisitor dv;
+                        instanced->accept(dv);
+                    }
+                    instanced->setStateSet(mInstancingStateSet);
+                    mSceneManager->recreateShaders(instanced, "objects", true, mInstancingProgramTemplate);
+                    group->addChild(instanced);
+
+                    templateRefs->addRef(cnode);
+                    if (compile)
+                    {
+                        stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES
+                            | osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
+                        instanced->accept(stateToCompile);
+                    }
+                    continue;
+                }
+            }
+
+            unsigned int numinstances = 0;
+            for (const PagedCellRef* refPtr : instances)
+            {
+                const PagedCellRef& ref = *refPtr;
 
                 const osg::Vec3f nodePos = ref.mPosition - worldCenter;
                 const osg::Quat nodeAttitude = osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
@@ -835,6 +1154,7 @@ namespace MWRender
                 optimizer.setMergeAlphaBlending(true);
             }
             optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+            optimizer.setWorkQueue(mSceneManager->getWorkQueue());
             const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
                 | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
 
@@ -934,9 +1254,9 @@ namespace MWRender
 
         {
             std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-            if (enabled && !getWritableRefTracker().mDisabled.erase(refnum))
+            if (enabled && !eraseSorted(getWritableRefTracker().mDisabled, refnum))
                 return false;
-            if (!enabled && !getWritableRefTracker().mDisabled.insert(refnum).second)
+            if (!enabled && !insertSorted(getWritableRefTracker().mDisabled, refnum))
                 return false;
             if (mRefTrackerLocked)
                 return false;
@@ -958,7 +1278,7 @@ namespace MWRender
 
         {
             std::lock_guard<std::mutex> lock(mRefTrackerMutex);
-            if (!getWritableRefTracker().mBlacklist.insert(refnum).second)
+            if (!insertSorted(getWritableRefTracker().mBlacklist, refnum))
                 return false;
             if (mRefTrackerLocked)
                 return false;
@@ -1038,9 +1358,24 @@ namespace MWRender
         out.erase(std::unique(out.begin(), out.end()), out.end());
     }
 
+    void ObjectPaging::updateCache(double referenceTime)
+    {
+        GenericResourceManager<ChunkId>::updateCache(referenceTime);
+        mInstancedTemplates->update(referenceTime, getExpiryDelay());
+    }
+
+    void ObjectPaging::clearCache()
+    {
+        GenericResourceManager<ChunkId>::clearCache();
+        mInstancedTemplates->clear();
+        std::lock_guard<std::mutex> lock(mCellRefsMutex);
+        mCellRefs.clear();
+    }
+
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Object Chunk", frameNumber, mCache->getStats(), *stats);
+        Resource::reportStats("Object Instanced Template", frameNumber, mInstancedTemplates->getStats(), *stats);
     }
 
 }
@@ -5,29 +5,53 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <osg/Node>
+#include <osg/Program>
+#include <osg/StateSet>
+
+#include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace Resource
 {
     class SceneManager;
 }
 
+namespace ESM
+{
+    class SharedReaders;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+}
+
 namespace MWRender
 {
 
     typedef std::tuple<osg::Vec2f, float, bool> ChunkId; // Center, Size, ActiveGrid
 
+    // Template, copy mask, children kept by its LODs
+    using InstancedTemplateKey = std::tuple<const osg::Node*, osg::Node::NodeMask, std::vector<unsigned>>;
+    using InstancedTemplateCache = Resource::GenericObjectCache<InstancedTemplateKey>;
+
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace);
+        ObjectPaging(Resource::SceneManager* sceneManager, ESM::SharedReaders& readers, ESM::RefId worldspace);
         ~ObjectPaging() = default;
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
-            bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
+            bool activeGrid, const osg::Vec3f& viewPoint, bool compile, const std::atomic<bool>* abort) override;
 
+        /// @return nullptr if aborted
         osg::ref_ptr<osg::Node> createChunk(float size, const osg::Vec2f& center, bool activeGrid,
-            const osg::Vec3f& viewPoint, bool compile, unsigned char lod);
+            const osg::Vec3f& viewPoint, bool compile, unsigned char lod, const std::atomic<bool>* abort);
 
         unsigned int getNodeMask() override;
 
@@ -43,24 +67,36 @@ namespace MWRender
         /// @return true if view needs rebuild
         bool unlockCache();
 
+        void updateCache(double referenceTime) override;
+
+        void clearCache() override;
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
         void getPagedRefnums(const osg::Vec4i& activeGrid, std::vector<ESM::RefNum>& out);
 
     private:
         Resource::SceneManager* mSceneManager;
+        ESM::SharedReaders& mReaders;
         bool mActiveGrid;
         bool mDebugBatches;
         float mMergeFactor;
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        bool mInstancing;
+        std::size_t mInstancingMinInstances;
+        osg::ref_ptr<osg::StateSet> mInstancingStateSet;
+        osg::ref_ptr<osg::Program> mInstancingProgramTemplate;
+        // Optimized copies of the templates drawn using instancing, shared by the chunks
+        osg::ref_ptr<InstancedTemplateCache> mInstancedTemplates{ new InstancedTemplateCache };
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
         {
-            std::set<ESM::RefNum> mDisabled;
-            std::set<ESM::RefNum> mBlacklist;
+            // Sorted
+            std::vector<ESM::RefNum> mDisabled;
+            std::vector<ESM::RefNum> mBlacklist;
             bool operator==(const RefTracker& other) const
             {
                 return mDisabled == other.mDisabled && mBlacklist == other.mBlacklist;
@@ -73,6 +109,13 @@ namespace MWRender
         const RefTracker& getRefTracker() const { return mRefTracker; }
         RefTracker& getWritableRefTracker() { return mRefTrackerLocked ? mRefTrackerNew : mRefTracker; }
 
+        // References of a cell in the content files order, read once
+        struct CellRefs;
+        std::mutex mCellRefsMutex;
+        std::map<osg::Vec2i, std::shared_ptr<const CellRefs>> mCellRefs;
+
+        std::shared_ptr<const CellRefs> getCellRefs(const osg::Vec2i& cellPosition, const MWWorld::ESMStore& store);
+
         std::mutex mSizeCacheMutex;
         typedef std::map<ESM::RefNum, float> SizeCache;
         SizeCache mSizeCache;
@@ -5,8 +5,10 @@
 
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
+#include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
+#include <components/settings/values.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/ptr.hpp"
@@ -41,18 +43,7 @@ namespace MWRender
     {
         assert(mObjects.find(ptr.mRef) == mObjects.end());
 
-        osg::ref_ptr<osg::Group> cellnode;
-
-        CellMap::iterator found = mCellSceneNodes.find(ptr.getCell());
-        if (found == mCellSceneNodes.end())
-        {
-            cellnode = new osg::Group;
-            cellnode->setName("Cell Root");
-            mRootNode->addChild(cellnode);
-            mCellSceneNodes[ptr.getCell()] = cellnode;
-        }
-        else
-            cellnode = found->second;
+        osg::ref_ptr<osg::Group> cellnode = getOrCreateCellNode(ptr.getCell());
 
         osg::ref_ptr<SceneUtil::PositionAttitudeTransform> insert(new SceneUtil::PositionAttitudeTransform);
         cellnode->addChild(insert);
@@ -87,6 +78,16 @@ namespace MWRender
         osg::ref_ptr<ObjectAnimation> anim(
             new ObjectAnimation(ptr, animationMesh, mResourceSystem, animated, allowLight));
 
+        // Banners, water wheels and the like do not need to play their animations while nobody sees them
+        osg::Group* baseNode = ptr.getRefData().getBaseNode();
+        if (baseNode->getNumChildrenRequiringUpdateTraversal() > 0)
+        {
+            osg::ref_ptr<SceneUtil::VisibilityGate> gate = new SceneUtil::VisibilityGate;
+            baseNode->addCullCallback(gate);
+            SceneUtil::AssignVisibilityGateVisitor visitor(gate);
+            baseNode->accept(visitor);
+        }
+
         mObjects.emplace(ptr.mRef, std::move(anim));
     }
 
@@ -127,6 +128,7 @@ namespace MWRender
         {
             osg::ref_ptr<NpcAnimation> anim(
                 new NpcAnimation(ptr, osg::ref_ptr<osg::Group>(ptr.getRefData().getBaseNode()), mResourceSystem));
+            anim->enableBodyPartMerging(Settings::game().mMergeNpcBodyParts);
 
             if (mObjects.emplace(ptr.mRef, anim).second)
             {
@@ -194,6 +196,34 @@ namespace MWRender
         }
     }
 
+    osg::Group* Objects::getOrCreateCellNode(const MWWorld::CellStore* cell)
+    {
+        osg::ref_ptr<osg::Group>& cellnode = mCellSceneNodes[cell];
+        if (!cellnode)
+        {
+            cellnode = new osg::Group;
+            cellnode->setName("Cell Root");
+            cellnode->setCullCallback(mCellCullCallback);
+            mRootNode->addChild(cellnode);
+        }
+        return cellnode;
+    }
+
+    osg::Group* Objects::getCellNode(const MWWorld::CellStore* store) const
+    {
+        const auto it = mCellSceneNodes.find(store);
+        if (it == mCellSceneNodes.end())
+            return nullptr;
+        return it->second;
+    }
+
+    void Objects::setCellCullCallback(osg::Callback* callback)
+    {
+        mCellCullCallback = callback;
+        for (const auto& [cell, cellnode] : mCellSceneNodes)
+            cellnode->setCullCallback(callback);
+    }
+
     void Objects::updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& cur)
     {
         osg::ref_ptr<osg::Node> objectNode = cur.getRefData().getBaseNode();
@@ -202,17 +232,7 @@ namespace MWRender
 
         MWWorld::CellStore* newCell = cur.getCell();
 
-        osg::Group* cellnode;
-        if (mCellSceneNodes.find(newCell) == mCellSceneNodes.end())
-        {
-            cellnode = new osg::Group;
-            mRootNode->addChild(cellnode);
-            mCellSceneNodes[newCell] = cellnode;
-        }
-        else
-        {
-            cellnode = mCellSceneNodes[newCell];
-        }
+        osg::Group* cellnode = getOrCreateCellNode(newCell);
 
         osg::UserDataContainer* userDataContainer = objectNode->getUserDataContainer();
         if (userDataContainer)
@@ -64,9 +64,12 @@ namespace MWRender
         osg::ref_ptr<osg::Group> mRootNode;
         Resource::ResourceSystem* mResourceSystem;
         SceneUtil::UnrefQueue& mUnrefQueue;
+        osg::ref_ptr<osg::Callback> mCellCullCallback;
 
         void insertBegin(const MWWorld::Ptr& ptr);
 
+        osg::Group* getOrCreateCellNode(const MWWorld::CellStore* cell);
+
     public:
         Objects(Resource::ResourceSystem* resourceSystem, const osg::ref_ptr<osg::Group>& rootNode,
             SceneUtil::UnrefQueue& unrefQueue);
@@ -86,9 +89,15 @@ namespace MWRender
 
         void removeCell(const MWWorld::CellStore* store);
 
+        /// @return The root node of the cell's objects, or null if none of them is rendered.
+        osg::Group* getCellNode(const MWWorld::CellStore* store) const;
+
         /// Updates containing cell for object rendering data
         void updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& cur);
 
+        /// Set the cull callback of the root nodes of the cells.
+        void setCellCullCallback(osg::Callback* callback);
+
     private:
         void operator=(const Objects&);
         Objects(const Objects&);
@@ -0,0 +1,244 @@
+#include "occlusionculling.hpp"
+
+#include <cstring>
+
+#include <osg/Geometry>
+#include <osg/Stats>
+#include <osgUtil/CullVisitor>
+
+#include <components/debug/debuglog.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/hizbuffer.hpp>
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/stereo/stereomanager.hpp>
+
+#include "postprocessor.hpp"
+#include "vismask.hpp"
+
+namespace MWRender
+{
+    namespace
+    {
+        // The depth of the current frame is compared to a previous one, which is useless after a teleport
+        constexpr float maxEyePointDistance = 512.f;
+
+        osg::ref_ptr<osg::Geometry> createFullscreenTriangle()
+        {
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+            geometry->setUseDisplayList(false);
+            geometry->setUseVertexBufferObjects(true);
+
+            osg::ref_ptr<osg::Vec3Array> verts = new osg::Vec3Array;
+            verts->push_back(osg::Vec3f(-1, -1, 0));
+            verts->push_back(osg::Vec3f(-1, 3, 0));
+            verts->push_back(osg::Vec3f(3, -1, 0));
+            geometry->setVertexArray(verts);
+            geometry->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::TRIANGLES, 0, 3));
+            geometry->setCullingActive(false);
+            return geometry;
+        }
+    }
+
+    class OcclusionCulling::HiZCullCallback
+        : public SceneUtil::NodeCallback<HiZCullCallback, osg::Node*, osgUtil::CullVisitor*>
+    {
+    public:
+        explicit HiZCullCallback(OcclusionCulling& occlusionCulling)
+            : mOcclusionCulling(occlusionCulling)
+        {
+        }
+
+        void operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+        {
+            const std::size_t frameId = cv->getTraversalNumber() % 2;
+
+            const osg::Camera& sceneCamera = *mOcclusionCulling.mSceneCamera;
+            View& view = mOcclusionCulling.mViews[frameId];
+            view.mViewProjection = sceneCamera.getViewMatrix() * sceneCamera.getProjectionMatrix();
+            view.mEyePoint = sceneCamera.getInverseViewMatrix().getTrans();
+
+            osg::StateSet* stateset = mOcclusionCulling.mStateSets[frameId];
+            stateset->setTextureAttribute(
+                0, mOcclusionCulling.mPostProcessor->getTexture(PostProcessor::Tex_OpaqueDepth, frameId));
+
+            cv->pushStateSet(stateset);
+            traverse(node, cv);
+            cv->popStateSet();
+        }
+
+    private:
+        OcclusionCulling& mOcclusionCulling;
+    };
+
+    class OcclusionCulling::ReadbackCallback : public osg::Camera::DrawCallback
+    {
+    public:
+        explicit ReadbackCallback(OcclusionCulling& occlusionCulling)
+            : mOcclusionCulling(occlusionCulling)
+        {
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override { mOcclusionCulling.readback(renderInfo); }
+
+    private:
+        OcclusionCulling& mOcclusionCulling;
+    };
+
+    OcclusionCulling::OcclusionCulling(osg::Group* rootNode, osg::Camera* sceneCamera, PostProcessor* postProcessor,
+        Shader::ShaderManager& shaderManager)
+        : mRootNode(rootNode)
+        , mSceneCamera(sceneCamera)
+        , mPostProcessor(postProcessor)
+        , mHiZBuffer(new SceneUtil::HiZBuffer)
+        , mReverseZ(SceneUtil::AutoDepth::isReversed())
+    {
+        mCullCallback = new SceneUtil::OcclusionCullCallback(mHiZBuffer);
+
+        osg::GLExtensions& exts = SceneUtil::getGLExtensions();
+        mSupported = exts.isGpuShader4Supported && exts.isPBOSupported && !Stereo::getStereo();
+        if (!mSupported)
+        {
+            Log(Debug::Warning) << "Occlusion culling is not supported: requires GL_EXT_gpu_shader4, pixel buffer "
+                                   "objects and no stereo rendering";
+            return;
+        }
+
+        mHiZTexture = new osg::Texture2D;
+        mHiZTexture->setTextureSize(sWidth, sHeight);
+        mHiZTexture->setInternalFormat(GL_R32F);
+        mHiZTexture->setSourceFormat(GL_RED);
+        mHiZTexture->setSourceType(GL_FLOAT);
+        mHiZTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        mHiZTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+        mHiZTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mHiZTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+
+        mReadFbo = new osg::FrameBufferObject;
+        mReadFbo->setAttachment(
+            osg::FrameBufferObject::BufferComponent::COLOR_BUFFER0, osg::FrameBufferAttachment(mHiZTexture));
+
+        for (Readback& readback : mReadbacks)
+        {
+            readback.mBuffer = new osg::PixelDataBufferObject;
+            readback.mBuffer->setDataSize(sWidth * sHeight * sizeof(float));
+            readback.mBuffer->setUsage(GL_STREAM_READ_ARB);
+        }
+
+        osg::ref_ptr<osg::Program> program = shaderManager.getProgram(
+            shaderManager.getShader("fullscreen_tri.vert", {}), shaderManager.getShader("hiz.frag", {}));
+
+        for (osg::ref_ptr<osg::StateSet>& stateset : mStateSets)
+        {
+            stateset = new osg::StateSet;
+            stateset->setAttributeAndModes(program, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+            stateset->addUniform(new osg::Uniform("depthTex", 0));
+            stateset->addUniform(new osg::Uniform("hizSize", osg::Vec2i(sWidth, sHeight)));
+            stateset->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE);
+            stateset->setMode(GL_BLEND, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE);
+        }
+
+        mCamera = new osg::Camera;
+        mCamera->setName("HiZCamera");
+        mCamera->setRenderOrder(osg::Camera::POST_RENDER);
+        mCamera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+        mCamera->setReferenceFrame(osg::Camera::ABSOLUTE_RF);
+        mCamera->setComputeNearFarMode(osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR);
+        mCamera->setProjectionMatrix(osg::Matrix::identity());
+        mCamera->setViewMatrix(osg::Matrix::identity());
+        mCamera->setClearMask(0);
+        mCamera->setViewport(0, 0, sWidth, sHeight);
+        mCamera->setNodeMask(Mask_RenderToTexture);
+        mCamera->attach(osg::Camera::COLOR_BUFFER0, mHiZTexture);
+        mCamera->addChild(createFullscreenTriangle());
+        mCamera->setCullCallback(new HiZCullCallback(*this));
+        mCamera->setFinalDrawCallback(new ReadbackCallback(*this));
+    }
+
+    OcclusionCulling::~OcclusionCulling()
+    {
+        setEnabled(false);
+    }
+
+    void OcclusionCulling::setEnabled(bool enabled)
+    {
+        enabled = enabled && mSupported;
+        if (mEnabled == enabled)
+            return;
+        mEnabled = enabled;
+
+        if (enabled)
+            mRootNode->addChild(mCamera);
+        else
+        {
+            mRootNode->removeChild(mCamera);
+            mHiZBuffer->clear();
+        }
+    }
+
+    void OcclusionCulling::update()
+    {
+        mLastNumTested = mHiZBuffer->getNumTested();
+        mLastNumOccluded = mHiZBuffer->getNumOccluded();
+        mHiZBuffer->resetStats();
+
+        if (!mEnabled)
+            return;
+
+        const osg::Vec3f eyePoint = mSceneCamera->getInverseViewMatrix().getTrans();
+        const std::lock_guard lock(mMutex);
+        if ((eyePoint - mDepthView.mEyePoint).length2() > maxEyePointDistance * maxEyePointDistance)
+        {
+            mHiZBuffer->clear();
+            return;
+        }
+        if (!mDepthReady)
+            return;
+        mHiZBuffer->build(mDepth, sWidth, sHeight, mDepthView.mViewProjection, mReverseZ);
+        mDepthReady = false;
+    }
+
+    void OcclusionCulling::readback(osg::RenderInfo& renderInfo)
+    {
+        osg::State& state = *renderInfo.getState();
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        const unsigned int contextId = state.getContextID();
+        const std::size_t frameId = state.getFrameStamp()->getFrameNumber() % 2;
+
+        // Queue the read of this frame and take the data of the previous one, which has most likely arrived already
+        Readback& current = mReadbacks[frameId];
+        mReadFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        current.mBuffer->bindBufferInWriteMode(state);
+        glReadPixels(0, 0, sWidth, sHeight, GL_RED, GL_FLOAT, nullptr);
+        current.mBuffer->unbindBuffer(contextId);
+        current.mView = mViews[frameId];
+        current.mPending = true;
+
+        Readback& previous = mReadbacks[(frameId + 1) % 2];
+        if (previous.mPending)
+        {
+            previous.mBuffer->bindBufferInWriteMode(state);
+            if (const void* data = ext->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB))
+            {
+                const std::lock_guard lock(mMutex);
+                mDepth.resize(sWidth * sHeight);
+                std::memcpy(mDepth.data(), data, mDepth.size() * sizeof(float));
+                mDepthView = previous.mView;
+                mDepthReady = true;
+            }
+            ext->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+            previous.mBuffer->unbindBuffer(contextId);
+            previous.mPending = false;
+        }
+
+        ext->glBindFramebuffer(
+            GL_FRAMEBUFFER_EXT, state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0);
+    }
+
+    void OcclusionCulling::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Occlusion Tested", mLastNumTested);
+        stats.setAttribute(frameNumber, "Occlusion Culled", mLastNumOccluded);
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef OPENMW_MWRENDER_OCCLUSIONCULLING_H
+#define OPENMW_MWRENDER_OCCLUSIONCULLING_H
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <osg/BufferObject>
+#include <osg/Camera>
+#include <osg/FrameBufferObject>
+#include <osg/Texture2D>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace Shader
+{
+    class ShaderManager;
+}
+
+namespace SceneUtil
+{
+    class HiZBuffer;
+}
+
+namespace MWRender
+{
+    class PostProcessor;
+
+    /// @brief Culls subgraphs hidden behind the opaque geometry of a previous frame for the scene camera.
+    /// @par After the scene is drawn, a render to texture pass reduces the opaque depth buffer to a small texture
+    /// holding the farthest depth of each screen block. The texture is read back asynchronously and turned into a
+    /// SceneUtil::HiZBuffer on the CPU, which is used by the callbacks returned by getCullCallback().
+    class OcclusionCulling
+    {
+    public:
+        static constexpr int sWidth = 256;
+        static constexpr int sHeight = 128;
+
+        OcclusionCulling(osg::Group* rootNode, osg::Camera* sceneCamera, PostProcessor* postProcessor,
+            Shader::ShaderManager& shaderManager);
+
+        ~OcclusionCulling();
+
+        /// @return false if occlusion culling isn't supported by the hardware.
+        bool isSupported() const { return mSupported; }
+
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return mEnabled; }
+
+        /// Build the depth hierarchy from the latest depth read back. Call before the cull traversal.
+        void update();
+
+        /// @return Cull callback skipping occluded nodes with a world space bound.
+        osg::Callback* getCullCallback() const { return mCullCallback; }
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        class HiZCullCallback;
+        class ReadbackCallback;
+
+        struct View
+        {
+            osg::Matrix mViewProjection;
+            osg::Vec3f mEyePoint;
+        };
+
+        struct Readback
+        {
+            osg::ref_ptr<osg::PixelDataBufferObject> mBuffer;
+            View mView;
+            bool mPending = false;
+        };
+
+        void readback(osg::RenderInfo& renderInfo);
+
+        osg::ref_ptr<osg::Group> mRootNode;
+        osg::ref_ptr<osg::Camera> mSceneCamera;
+        osg::ref_ptr<PostProcessor> mPostProcessor;
+        osg::ref_ptr<osg::Camera> mCamera;
+        osg::ref_ptr<osg::Texture2D> mHiZTexture;
+        osg::ref_ptr<osg::FrameBufferObject> mReadFbo;
+        std::array<osg::ref_ptr<osg::StateSet>, 2> mStateSets;
+        osg::ref_ptr<SceneUtil::HiZBuffer> mHiZBuffer;
+        osg::ref_ptr<osg::Callback> mCullCallback;
+        bool mSupported = false;
+        bool mEnabled = false;
+        bool mReverseZ = false;
+
+        // Written by the cull traversal of the reduction pass, read by its draw
+        std::array<View, 2> mViews;
+
+        // Accessed only by the draw traversal
+        std::array<Readback, 2> mReadbacks;
+
+        std::mutex mMutex;
+        std::vector<float> mDepth;
+        View mDepthView;
+        bool mDepthReady = false;
+
+        std::size_t mLastNumTested = 0;
+        std::size_t mLastNumOccluded = 0;
+    };
+}
+
+#endif
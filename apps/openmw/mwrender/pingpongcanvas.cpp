@@ -1,5 +1,6 @@
 #include "pingpongcanvas.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 #include <components/shader/shadermanager.hpp>
@@ -16,6 +17,7 @@ namespace MWRender
         Shader::ShaderManager& shaderManager, const std::shared_ptr<LuminanceCalculator>& luminanceCalculator)
         : mFallbackStateSet(new osg::StateSet)
         , mMultiviewResolveStateSet(new osg::StateSet)
+        , mUpscaleStateSet(new osg::StateSet)
         , mLuminanceCalculator(luminanceCalculator)
     {
         setUseDisplayList(false);
@@ -44,6 +46,12 @@ namespace MWRender
         mMultiviewResolveProgram = shaderManager.getProgram("multiview_resolve");
         mMultiviewResolveStateSet->setAttributeAndModes(mMultiviewResolveProgram);
         mMultiviewResolveStateSet->addUniform(new osg::Uniform("lastShader", 0));
+
+        mUpscaleProgram = shaderManager.getProgram("upscale");
+        mUpscaleStateSet->setAttributeAndModes(mUpscaleProgram);
+        mUpscaleStateSet->addUniform(new osg::Uniform("lastShader", 0));
+        mUpscaleStateSet->addUniform(new osg::Uniform("texelSize", osg::Vec2f(1, 1)));
+        mUpscaleStateSet->addUniform(new osg::Uniform("sharpness", 0.f));
     }
 
     void PingPongCanvas::setPasses(fx::DispatchArray&& passes)
@@ -63,6 +71,29 @@ namespace MWRender
         osg::Geometry::drawImplementation(renderInfo);
     }
 
+    void PingPongCanvas::drawUpscaled(
+        osg::RenderInfo& renderInfo, osg::Texture* source, const osg::Viewport& viewport) const
+    {
+        osg::State& state = *renderInfo.getState();
+        const float width = static_cast<float>(source->getTextureWidth());
+        const float height = static_cast<float>(source->getTextureHeight());
+
+        // Sharpen more the lower the render resolution is
+        const float scale = width / static_cast<float>(viewport.width());
+        mUpscaleStateSet->getUniform("texelSize")->set(osg::Vec2f(1.f / width, 1.f / height));
+        mUpscaleStateSet->getUniform("sharpness")->set(std::clamp(2.f * (1.f - scale), 0.f, 1.f));
+
+        state.pushStateSet(mUpscaleStateSet);
+        state.apply();
+        state.applyTextureAttribute(0, source);
+        viewport.apply(state);
+
+        drawGeometry(renderInfo);
+
+        state.popStateSet();
+        state.apply();
+    }
+
     static void attachCloneOfTemplate(
         osg::FrameBufferObject* fbo, osg::Camera::BufferComponent component, osg::Texture* tex)
     {
@@ -93,6 +124,17 @@ namespace MWRender
 
         auto* resolveViewport = state.getCurrentViewport();
 
+        // The scene is rendered at a lower resolution than the destination by the dynamic resolution
+        const bool upscale = !Stereo::getStereo()
+            && (mTextureScene->getTextureWidth() != static_cast<int>(resolveViewport->width())
+                || mTextureScene->getTextureHeight() != static_cast<int>(resolveViewport->height()));
+
+        if (upscale && (filtered.empty() || !mPostprocessing))
+        {
+            drawUpscaled(renderInfo, mTextureScene, *resolveViewport);
+            return;
+        }
+
         if (filtered.empty() || !mPostprocessing)
         {
             state.pushStateSet(mFallbackStateSet);
@@ -147,7 +189,7 @@ namespace MWRender
 
             mLuminanceCalculator->dirty(mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
 
-            if (Stereo::getStereo())
+            if (Stereo::getStereo() || upscale)
                 mRenderViewport
                     = new osg::Viewport(0, 0, mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
             else
@@ -163,8 +205,8 @@ namespace MWRender
 
         (mAvgLum) ? mLuminanceCalculator->enable() : mLuminanceCalculator->disable();
 
-        // A histogram based approach is superior way to calculate scene luminance. Using mipmaps is more broadly
-        // supported, so that's what we use for now.
+        // A histogram based approach is superior way to calculate scene luminance. A parallel reduction in compute
+        // shaders is used when supported, otherwise the scene luminance is averaged through mipmaps.
         mLuminanceCalculator->draw(*this, renderInfo, state, ext, frameId);
 
         auto buffer = buffers[0];
@@ -310,7 +352,7 @@ namespace MWRender
 
                     lastApplied = pass.mRenderTarget->getHandle(state.getContextID());
                 }
-                else if (pass.mResolve && index == filtered.back())
+                else if (pass.mResolve && index == filtered.back() && !upscale)
                 {
                     bindDestinationFbo();
                     if (!destinationFbo && !Stereo::getMultiview())
@@ -351,6 +393,17 @@ namespace MWRender
             state.popStateSet();
         }
 
+        if (upscale)
+        {
+            bindDestinationFbo();
+            osg::Texture* source = mTextureScene;
+            if (lastShader != 0)
+                source = (osg::Texture*)mFbos[lastShader - GL_COLOR_ATTACHMENT0_EXT]
+                             ->getAttachment(osg::Camera::COLOR_BUFFER0)
+                             .getTexture();
+            drawUpscaled(renderInfo, source, *resolveViewport);
+        }
+
         if (Stereo::getMultiview())
         {
             ext->glBindFramebuffer(GL_DRAW_FRAMEBUFFER_EXT, 0);
@@ -57,6 +57,8 @@ namespace MWRender
         const osg::ref_ptr<osg::Texture>& getSceneTexture(size_t frameId) const { return mTextureScene; }
 
     private:
+        void drawUpscaled(osg::RenderInfo& renderInfo, osg::Texture* source, const osg::Viewport& viewport) const;
+
         bool mAvgLum = false;
         bool mPostprocessing = false;
 
@@ -65,8 +67,10 @@ namespace MWRender
 
         osg::ref_ptr<osg::Program> mFallbackProgram;
         osg::ref_ptr<osg::Program> mMultiviewResolveProgram;
+        osg::ref_ptr<osg::Program> mUpscaleProgram;
         osg::ref_ptr<osg::StateSet> mFallbackStateSet;
         osg::ref_ptr<osg::StateSet> mMultiviewResolveStateSet;
+        osg::ref_ptr<osg::StateSet> mUpscaleStateSet;
 
         osg::ref_ptr<osg::Texture> mTextureScene;
         osg::ref_ptr<osg::Texture> mTextureDepth;
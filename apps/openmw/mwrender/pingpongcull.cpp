@@ -15,15 +15,11 @@ namespace MWRender
 {
 
     PingPongCull::PingPongCull(PostProcessor* pp)
-        : mViewportStateset(nullptr)
+        : mViewportStateset(new osg::StateSet)
+        , mViewport(new osg::Viewport)
         , mPostProcessor(pp)
     {
-        if (Stereo::getStereo())
-        {
-            mViewportStateset = new osg::StateSet();
-            mViewport = new osg::Viewport;
-            mViewportStateset->setAttribute(mViewport);
-        }
+        mViewportStateset->setAttribute(mViewport);
     }
 
     PingPongCull::~PingPongCull()
@@ -69,7 +65,8 @@ namespace MWRender
                 Stereo::setMultiviewMSAAResolveCallback(renderStage);
         }
 
-        if (mViewportStateset)
+        // The render targets are smaller than the camera viewport with the dynamic resolution
+        if (Stereo::getStereo() || mPostProcessor->getRenderScale() != 1)
         {
             mViewport->setViewport(0, 0, mPostProcessor->renderWidth(), mPostProcessor->renderHeight());
             renderStage->setViewport(mViewport);
@@ -3,7 +3,10 @@
 #include <SDL_opengl_glext.h>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <osg/Texture1D>
 #include <osg/Texture2D>
@@ -12,8 +15,10 @@
 #include <osg/Texture3D>
 
 #include <components/files/conversion.hpp>
+#include <components/fx/framegraph.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/resource/gputimer.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -108,6 +113,87 @@ namespace
     }
 
     constexpr float DistortionRatio = 0.25;
+
+    bool isInterchangeable(const fx::Types::RenderTarget& lhs, const fx::Types::RenderTarget& rhs)
+    {
+        const osg::Texture2D& l = *lhs.mTarget;
+        const osg::Texture2D& r = *rhs.mTarget;
+        return lhs.mMipMap == rhs.mMipMap && lhs.mSize.mWidthRatio == rhs.mSize.mWidthRatio
+            && lhs.mSize.mHeightRatio == rhs.mSize.mHeightRatio && lhs.mSize.mWidth == rhs.mSize.mWidth
+            && lhs.mSize.mHeight == rhs.mSize.mHeight && l.getInternalFormat() == r.getInternalFormat()
+            && l.getSourceFormat() == r.getSourceFormat() && l.getSourceType() == r.getSourceType()
+            && l.getFilter(osg::Texture::MIN_FILTER) == r.getFilter(osg::Texture::MIN_FILTER)
+            && l.getFilter(osg::Texture::MAG_FILTER) == r.getFilter(osg::Texture::MAG_FILTER)
+            && l.getWrap(osg::Texture::WRAP_S) == r.getWrap(osg::Texture::WRAP_S)
+            && l.getWrap(osg::Texture::WRAP_T) == r.getWrap(osg::Texture::WRAP_T);
+    }
+
+    struct RenderTargetPlan
+    {
+        // Render targets drawn to and sampled in place of others, keyed by the texture they replace
+        std::unordered_map<const osg::Texture2D*, fx::Types::RenderTarget*> mAliases;
+        std::unordered_set<const fx::Pass*> mUnusedPasses;
+
+        fx::Types::RenderTarget& get(fx::Types::RenderTarget& renderTarget) const
+        {
+            const auto it = mAliases.find(renderTarget.mTarget.get());
+            return it == mAliases.end() ? renderTarget : *it->second;
+        }
+    };
+
+    // Render targets are only used within their technique, so the ones drawn to before they are sampled each frame
+    // can share their memory with those of the other techniques
+    RenderTargetPlan planRenderTargets(const std::vector<std::shared_ptr<fx::Technique>>& techniques)
+    {
+        fx::FrameGraph graph;
+        std::vector<fx::Types::RenderTarget*> resources;
+        std::vector<const fx::Types::RenderTarget*> classes;
+        std::unordered_map<const fx::Types::RenderTarget*, fx::FrameGraph::Resource> ids;
+
+        const auto getResource = [&](fx::Types::RenderTarget& renderTarget) {
+            const auto [it, inserted] = ids.emplace(&renderTarget, resources.size());
+            if (inserted)
+            {
+                const auto aliasClass = std::find_if(classes.begin(), classes.end(),
+                    [&](const fx::Types::RenderTarget* v) { return isInterchangeable(*v, renderTarget); });
+                graph.addResource(aliasClass - classes.begin());
+                if (aliasClass == classes.end())
+                    classes.push_back(&renderTarget);
+                resources.push_back(&renderTarget);
+            }
+            return it->second;
+        };
+
+        std::vector<const fx::Pass*> passes;
+        for (const auto& technique : techniques)
+        {
+            for (const auto& pass : technique->getPasses())
+            {
+                std::optional<fx::FrameGraph::Resource> target;
+                if (!pass->getTarget().empty())
+                    target = getResource(technique->getRenderTargetsMap()[pass->getTarget()]);
+
+                std::vector<fx::FrameGraph::Resource> inputs;
+                for (const auto& name : pass->getRenderTargets())
+                    if (!name.empty())
+                        inputs.push_back(getResource(technique->getRenderTargetsMap()[name]));
+
+                graph.addPass(target, pass->getBlending(), inputs);
+                passes.push_back(pass.get());
+            }
+        }
+
+        graph.compile();
+
+        RenderTargetPlan plan;
+        for (std::size_t i = 0; i < passes.size(); ++i)
+            if (!graph.isPassUsed(i))
+                plan.mUnusedPasses.insert(passes[i]);
+        for (fx::FrameGraph::Resource i = 0; i < resources.size(); ++i)
+            if (const fx::FrameGraph::Resource alias = graph.getAlias(i); alias != i)
+                plan.mAliases.emplace(resources[i]->mTarget.get(), resources[alias]);
+        return plan;
+    }
 }
 
 namespace MWRender
@@ -146,11 +232,13 @@ namespace MWRender
         mHUDCamera->addChild(mCanvases[1]);
         mHUDCamera->setCullCallback(new HUDCullCallback);
         mViewer->getCamera()->addCullCallback(mPingPongCull);
+        if (Resource::GpuTimer* gpuTimer = mRendering.getGpuTimer())
+            gpuTimer->addCamera(*mHUDCamera, Resource::GpuStage::PostProcessing);
 
         // resolves the multisampled depth buffer and optionally draws an additional depth postpass
         mTransparentDepthPostPass
             = new TransparentDepthBinCallback(mRendering.getResourceSystem()->getSceneManager()->getShaderManager(),
-                Settings::postProcessing().mTransparentPostpass);
+                Settings::postProcessing().mTransparentPostpass, mRendering.getGpuTimer());
         osgUtil::RenderBin::getRenderBinPrototype("DepthSortedBin")->setDrawCallback(mTransparentDepthPostPass);
 
         osg::ref_ptr<osgUtil::RenderBin> distortionRenderBin
@@ -208,6 +296,21 @@ namespace MWRender
         mUBO = ext->isUniformBufferObjectSupported && mGLSLVersion >= 330;
         mStateUpdater = new fx::StateUpdater(mUBO);
 
+        if (Settings::postProcessing().mDynamicResolution && !Stereo::getStereo())
+        {
+            if (Resource::GpuTimer* gpuTimer = mRendering.getGpuTimer();
+                gpuTimer != nullptr && ext->isARBTimerQuerySupported)
+            {
+                gpuTimer->setAlwaysMeasure(true);
+                mDynamicResolution.emplace(Settings::postProcessing().mDynamicResolutionMinScale,
+                    Settings::postProcessing().mDynamicResolutionMaxScale,
+                    Settings::postProcessing().mDynamicResolutionTargetFrameTime / 1000.0);
+                mRenderScale = mDynamicResolution->getScale();
+            }
+            else
+                Log(Debug::Warning) << "GPU timer queries are unsupported, dynamic resolution is disabled.";
+        }
+
         addChild(mHUDCamera);
         addChild(mRootNode);
 
@@ -313,7 +416,10 @@ namespace MWRender
 
         size_t frame = cv->getTraversalNumber();
 
-        mStateUpdater->setResolution(osg::Vec2f(cv->getViewport()->width(), cv->getViewport()->height()));
+        if (mRenderScale != 1)
+            mStateUpdater->setResolution(osg::Vec2f(renderWidth(), renderHeight()));
+        else
+            mStateUpdater->setResolution(osg::Vec2f(cv->getViewport()->width(), cv->getViewport()->height()));
 
         // per-frame data
         if (frame != mLastFrameNumber)
@@ -367,6 +473,23 @@ namespace MWRender
         }
     }
 
+    void PostProcessor::updateDynamicResolution()
+    {
+        if (!mDynamicResolution.has_value())
+            return;
+
+        const Resource::GpuTimer::FrameTime frameTime = mRendering.getGpuTimer()->getLastFrameTime();
+        if (frameTime.mFrameNumber == mLastGpuFrameNumber)
+            return;
+        mLastGpuFrameNumber = frameTime.mFrameNumber;
+
+        if (!mDynamicResolution->update(frameTime.mTime))
+            return;
+
+        mRenderScale = mDynamicResolution->getScale();
+        resize();
+    }
+
     void PostProcessor::reloadIfRequired()
     {
         if (!mReload)
@@ -391,6 +514,8 @@ namespace MWRender
 
         reloadIfRequired();
 
+        updateDynamicResolution();
+
         mCanvases[frameId]->setNodeMask(~0u);
         mCanvases[!frameId]->setNodeMask(0);
 
@@ -562,6 +687,7 @@ namespace MWRender
 
         std::vector<fx::Types::RenderTarget> attachmentsToDirty;
 
+        std::vector<std::shared_ptr<fx::Technique>> techniques;
         for (const auto& technique : mTechniques)
         {
             if (!technique || !technique->isValid())
@@ -574,6 +700,13 @@ namespace MWRender
                 continue;
             }
 
+            techniques.push_back(technique);
+        }
+
+        const RenderTargetPlan plan = planRenderTargets(techniques);
+
+        for (const auto& technique : techniques)
+        {
             fx::DispatchNode node;
 
             node.mFlags = technique->getFlags();
@@ -632,6 +765,9 @@ namespace MWRender
 
             for (const auto& pass : technique->getPasses())
             {
+                if (plan.mUnusedPasses.contains(pass.get()))
+                    continue;
+
                 int subTexUnit = texUnit;
                 fx::DispatchNode::SubPass subPass;
 
@@ -641,7 +777,7 @@ namespace MWRender
 
                 if (!pass->getTarget().empty())
                 {
-                    auto& renderTarget = technique->getRenderTargetsMap()[pass->getTarget()];
+                    auto& renderTarget = plan.get(technique->getRenderTargetsMap()[pass->getTarget()]);
                     subPass.mSize = renderTarget.mSize;
                     subPass.mRenderTexture = renderTarget.mTarget;
                     subPass.mMipMap = renderTarget.mMipMap;
@@ -668,7 +804,7 @@ namespace MWRender
                         continue;
                     }
 
-                    auto& renderTarget = technique->getRenderTargetsMap()[name];
+                    auto& renderTarget = plan.get(technique->getRenderTargetsMap()[name]);
                     subPass.mStateSet->setTextureAttribute(subTexUnit, renderTarget.mTarget);
                     subPass.mStateSet->addUniform(new osg::Uniform(name.c_str(), subTexUnit));
 
@@ -826,14 +962,14 @@ namespace MWRender
     {
         if (Stereo::getStereo())
             return Stereo::Manager::instance().eyeResolution().x();
-        return mWidth;
+        return std::max(1, static_cast<int>(std::lround(mWidth * mRenderScale)));
     }
 
     int PostProcessor::renderHeight() const
     {
         if (Stereo::getStereo())
             return Stereo::Manager::instance().eyeResolution().y();
-        return mHeight;
+        return std::max(1, static_cast<int>(std::lround(mHeight * mRenderScale)));
     }
 
     void PostProcessor::triggerShaderReload()
@@ -19,10 +19,12 @@
 #include <components/fx/stateupdater.hpp>
 #include <components/fx/technique.hpp>
 
+#include "dynamicresolution.hpp"
 #include "pingpongcanvas.hpp"
 #include "transparentpass.hpp"
 
 #include <memory>
+#include <optional>
 
 namespace osgViewer
 {
@@ -194,6 +196,9 @@ namespace MWRender
         int renderWidth() const;
         int renderHeight() const;
 
+        /// Scale of the render resolution relative to the window picked by the dynamic resolution.
+        float getRenderScale() const { return mRenderScale; }
+
         void triggerShaderReload();
 
         bool mEnableLiveReload = false;
@@ -216,6 +221,8 @@ namespace MWRender
 
         void updateLiveReload();
 
+        void updateDynamicResolution();
+
         void cull(size_t frameId, osgUtil::CullVisitor* cv);
 
         osg::ref_ptr<osg::Group> mRootNode;
@@ -258,6 +265,9 @@ namespace MWRender
         int mWidth;
         int mHeight;
         int mSamples;
+        float mRenderScale = 1;
+        std::optional<DynamicResolution> mDynamicResolution;
+        unsigned mLastGpuFrameNumber = 0;
 
         osg::ref_ptr<fx::StateUpdater> mStateUpdater;
         osg::ref_ptr<PingPongCull> mPingPongCull;
@@ -1,6 +1,7 @@
 #include "precipitationocclusion.hpp"
 
 #include <cassert>
+#include <cmath>
 
 #include <osgUtil/CullVisitor>
 
@@ -22,8 +23,10 @@ namespace
     class PrecipitationOcclusionUpdater : public SceneUtil::StateSetUpdater
     {
     public:
-        PrecipitationOcclusionUpdater(osg::ref_ptr<osg::Texture2D> depthTexture)
+        PrecipitationOcclusionUpdater(
+            osg::ref_ptr<osg::Texture2D> depthTexture, osg::ref_ptr<const osg::RefMatrix> depthSpaceMatrix)
             : mDepthTexture(std::move(depthTexture))
+            , mDepthSpaceMatrix(std::move(depthSpaceMatrix))
         {
         }
 
@@ -32,16 +35,17 @@ namespace
         {
             stateset->setTextureAttributeAndModes(3, mDepthTexture);
             stateset->addUniform(new osg::Uniform("orthoDepthMap", 3));
-            stateset->addUniform(new osg::Uniform("depthSpaceMatrix", mDepthSpaceMatrix));
+            stateset->addUniform(new osg::Uniform("depthSpaceMatrix", osg::Matrixf(*mDepthSpaceMatrix)));
         }
         void apply(osg::StateSet* stateset, osg::NodeVisitor* nv) override
         {
-            osg::Camera* camera = nv->asCullVisitor()->getCurrentCamera();
-            stateset->getUniform("depthSpaceMatrix")->set(camera->getViewMatrix() * camera->getProjectionMatrix());
+            // The depth camera is not culled while the cached depth map is still valid, so use the matrices it was
+            // last rendered with
+            stateset->getUniform("depthSpaceMatrix")->set(osg::Matrixf(*mDepthSpaceMatrix));
         }
 
-        osg::Matrixf mDepthSpaceMatrix;
         osg::ref_ptr<osg::Texture2D> mDepthTexture;
+        osg::ref_ptr<const osg::RefMatrix> mDepthSpaceMatrix;
     };
 
     class DepthCameraUpdater : public SceneUtil::StateSetUpdater
@@ -89,8 +93,10 @@ namespace MWRender
         , mSceneNode(sceneNode)
         , mRootNode(rootNode)
         , mSceneCamera(camera)
+        , mDepthSpaceMatrix(new osg::RefMatrix)
     {
-        constexpr int rttSize = 256;
+        // Twice the texels of the precipitation area along each axis, as the cached map covers twice the range
+        constexpr int rttSize = 512;
 
         mDepthTexture = new osg::Texture2D;
         mDepthTexture->setTextureSize(rttSize, rttSize);
@@ -127,14 +133,28 @@ namespace MWRender
 
         const osg::Vec3 pos = mSceneCamera->getInverseViewMatrix().getTrans();
 
+        const osg::Vec3f offset = pos - mCachedPosition;
+        const bool covered = std::abs(offset.x()) <= mRange->x() / 2 && std::abs(offset.y()) <= mRange->y() / 2
+            && std::abs(offset.z()) <= Constants::CellSizeInUnits / 2;
+
+        if (!mDirty && covered)
+        {
+            mCamera->setNodeMask(0);
+            return;
+        }
+
+        mDirty = false;
+        mCachedPosition = pos;
+        mCamera->setNodeMask(Mask_RenderToTexture);
+
         const float zmin = pos.z() - mRange->z() - Constants::CellSizeInUnits;
         const float zmax = pos.z() + mRange->z() + Constants::CellSizeInUnits;
         const float near = 0;
         const float far = zmax - zmin;
 
-        const float left = -mRange->x() / 2;
+        const float left = -mRange->x();
         const float right = -left;
-        const float top = mRange->y() / 2;
+        const float top = mRange->y();
         const float bottom = -top;
 
         if (SceneUtil::AutoDepth::isReversed())
@@ -149,16 +169,19 @@ namespace MWRender
 
         mCamera->setViewMatrixAsLookAt(
             osg::Vec3(pos.x(), pos.y(), zmax), osg::Vec3(pos.x(), pos.y(), zmin), osg::Vec3(0, 1, 0));
+
+        mDepthSpaceMatrix->set(mCamera->getViewMatrix() * mCamera->getProjectionMatrix());
     }
 
     void PrecipitationOccluder::enable()
     {
-        mSkyCullCallback = new PrecipitationOcclusionUpdater(mDepthTexture);
+        mSkyCullCallback = new PrecipitationOcclusionUpdater(mDepthTexture, mDepthSpaceMatrix);
         mSkyNode->addCullCallback(mSkyCullCallback);
         mCamera->setCullCallback(new DepthCameraUpdater);
 
         mRootNode->removeChild(mCamera);
         mRootNode->addChild(mCamera);
+        mDirty = true;
     }
 
     void PrecipitationOccluder::disable()
@@ -177,6 +200,9 @@ namespace MWRender
         assert(range.y() != 0);
         assert(range.z() != 0);
         const osg::Vec3f margin = { -50, -50, 0 };
-        mRange = range - margin;
+        const osg::Vec3f newRange = range - margin;
+        if (mRange != newRange)
+            mDirty = true;
+        mRange = newRange;
     }
 }
@@ -21,6 +21,9 @@ namespace MWRender
 
         void updateRange(const osg::Vec3f range);
 
+        /// Render the occluders again, e.g. after objects were added or removed.
+        void dirty() { mDirty = true; }
+
     private:
         osg::Group* mSkyNode;
         osg::Group* mSceneNode;
@@ -29,7 +32,12 @@ namespace MWRender
         osg::ref_ptr<osg::Camera> mCamera;
         osg::ref_ptr<osg::Camera> mSceneCamera;
         osg::ref_ptr<osg::Texture2D> mDepthTexture;
+        osg::ref_ptr<osg::RefMatrix> mDepthSpaceMatrix;
         std::optional<osg::Vec3f> mRange;
+        // The depth map covers twice the precipitation range around this position and is only rendered again once
+        // the precipitation area leaves it
+        osg::Vec3f mCachedPosition;
+        bool mDirty = true;
     };
 }
 
@@ -24,6 +24,7 @@
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 
+#include <components/resource/gputimer.hpp>
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/keyframemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -46,6 +47,7 @@
 
 #include <components/misc/constants.hpp>
 
+#include <components/terrain/compositemapcache.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/terrain/terraingrid.hpp>
 
@@ -71,12 +73,15 @@
 
 #include "actorspaths.hpp"
 #include "camera.hpp"
+#include "compilequeue.hpp"
 #include "effectmanager.hpp"
 #include "fogmanager.hpp"
 #include "groundcover.hpp"
 #include "navmesh.hpp"
 #include "npcanimation.hpp"
 #include "objectpaging.hpp"
+#include "interiorvisibility.hpp"
+#include "occlusionculling.hpp"
 #include "pathgrid.hpp"
 #include "postprocessor.hpp"
 #include "recastmesh.hpp"
@@ -307,7 +312,7 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        ESM::SharedReaders& sharedReaders, SceneUtil::UnrefQueue& unrefQueue)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -324,6 +329,7 @@ namespace MWRender
         , mFieldOfView(Settings::camera().mFieldOfView)
         , mFirstPersonFieldOfView(Settings::camera().mFirstPersonFieldOfView)
         , mGroundCoverStore(groundcoverStore)
+        , mSharedReaders(sharedReaders)
     {
         bool reverseZ = SceneUtil::AutoDepth::isReversed();
         const SceneUtil::LightingMethod lightingMethod = Settings::shaders().mLightingMethod;
@@ -391,6 +397,8 @@ namespace MWRender
         resourceSystem->getSceneManager()->setConvertAlphaTestToAlphaToCoverage(shouldAddMSAAIntermediateTarget());
         resourceSystem->getSceneManager()->setAdjustCoverageForAlphaTest(
             Settings::shaders().mAdjustCoverageForAlphaTest);
+        resourceSystem->getSceneManager()->setGpuSkinning(Settings::shaders().mGpuSkinning);
+        resourceSystem->getSceneManager()->setGpuMorphing(Settings::shaders().mGpuMorphing);
 
         // Let LightManager choose which backend to use based on our hint. For methods besides legacy lighting, this
         // depends on support for various OpenGL extensions.
@@ -403,6 +411,10 @@ namespace MWRender
         });
         resourceSystem->getSceneManager()->setLightingMethod(sceneRoot->getLightingMethod());
         resourceSystem->getSceneManager()->setSupportedLightingMethods(sceneRoot->getSupportedLightingMethods());
+        if (sceneRoot->getLightingMethod() == SceneUtil::LightingMethod::Clustered)
+            sceneRoot->setLightClustersTextureUnit(
+                resourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::LightClusters, 2));
 
         sceneRoot->setLightingMask(Mask_Lighting);
         mSceneRoot = sceneRoot;
@@ -422,9 +434,15 @@ namespace MWRender
         if (Settings::shadows().mTerrainShadows)
             shadowCastingTraversalMask |= Mask_Terrain;
 
+        mGpuTimer = new Resource::GpuTimer(*mViewer->getViewerStats());
+        mGpuTimer->addCamera(*mViewer->getCamera(), Resource::GpuStage::Scene);
+
+        // Terrain and statics including paged objects are rendered into the cached shadow maps
         mShadowManager = std::make_unique<SceneUtil::ShadowManager>(sceneRoot, mRootNode, shadowCastingTraversalMask,
-            indoorShadowCastingTraversalMask, Mask_Terrain | Mask_Object | Mask_Static, Settings::shadows(),
+            indoorShadowCastingTraversalMask, Mask_Terrain | Mask_Object | Mask_Static,
+            Mask_Scene | Mask_Terrain | Mask_Static, ~(Mask_Terrain | Mask_Static), Settings::shadows(),
             mResourceSystem->getSceneManager()->getShaderManager());
+        mShadowManager->setGpuTimer(*mGpuTimer);
 
         Shader::ShaderManager::DefineMap shadowDefines = mShadowManager->getShadowDefines(Settings::shadows());
         Shader::ShaderManager::DefineMap lightDefines = sceneRoot->getLightDefines();
@@ -474,6 +492,12 @@ namespace MWRender
         {
             mViewer->setIncrementalCompileOperation(new osgUtil::IncrementalCompileOperation);
             mViewer->getIncrementalCompileOperation()->setTargetFrameRate(Settings::cells().mTargetFramerate);
+            if (Settings::cells().mCompileTimeBudget > 0)
+            {
+                mViewer->getIncrementalCompileOperation()->setMinimumTimeAvailableForGLCompileAndDeletePerFrame(
+                    Settings::cells().mCompileTimeBudget / 1000.0);
+                mCompileQueue = std::make_unique<CompileQueue>(*mViewer->getIncrementalCompileOperation());
+            }
         }
 
         mDebugDraw = new Debug::DebugDrawer(mResourceSystem->getSceneManager()->getShaderManager());
@@ -481,6 +505,7 @@ namespace MWRender
         sceneRoot->addChild(mDebugDraw);
 
         mResourceSystem->getSceneManager()->setIncrementalCompileOperation(mViewer->getIncrementalCompileOperation());
+        mResourceSystem->getSceneManager()->setWorkQueue(mWorkQueue);
 
         mEffectManager = std::make_unique<EffectManager>(sceneRoot, mResourceSystem);
 
@@ -515,9 +540,20 @@ namespace MWRender
         resourceSystem->getSceneManager()->setSupportsNormalsRT(mPostProcessor->getSupportsNormalsRT());
         resourceSystem->getSceneManager()->setWeatherParticleOcclusion(Settings::shaders().mWeatherParticleOcclusion);
 
+        mOcclusionCulling = std::make_unique<OcclusionCulling>(
+            mRootNode, mViewer->getCamera(), mPostProcessor, resourceSystem->getSceneManager()->getShaderManager());
+        if (mOcclusionCulling->isSupported())
+        {
+            mObjects->setCellCullCallback(mOcclusionCulling->getCullCallback());
+            for (auto& [worldspace, chunkMgr] : mWorldspaceChunks)
+                chunkMgr.mTerrain->setChunkCullCallback(mOcclusionCulling->getCullCallback());
+            mOcclusionCulling->setEnabled(Settings::camera().mOcclusionCulling);
+        }
+        mInteriorVisibility = std::make_unique<InteriorVisibility>();
+
         // water goes after terrain for correct waterculling order
-        mWater = std::make_unique<Water>(
-            sceneRoot->getParent(0), sceneRoot, mResourceSystem, mViewer->getIncrementalCompileOperation());
+        mWater = std::make_unique<Water>(sceneRoot->getParent(0), sceneRoot, mResourceSystem,
+            mViewer->getIncrementalCompileOperation(), mGpuTimer);
 
         mCamera = std::make_unique<Camera>(mViewer->getCamera());
 
@@ -582,8 +618,10 @@ namespace MWRender
         MWBase::Environment::get().getWindowManager()->setCullMask(mask);
         NifOsg::Loader::setHiddenNodeMask(Mask_UpdateVisitor);
         NifOsg::Loader::setIntersectionDisabledNodeMask(Mask_Effect);
+        NifOsg::Loader::setCompactKeyframes(Settings::models().mCompactAnimationKeyframes);
         Nif::Reader::setLoadUnsupportedFiles(Settings::models().mLoadUnsupportedNifFiles);
         Nif::Reader::setWriteNifDebugLog(Settings::models().mWriteNifDebugLog);
+        Nif::Reader::setReadIntoMemory(Settings::models().mReadNifFilesIntoMemory);
 
         mStateUpdater->setFogEnd(mViewDistance);
 
@@ -611,6 +649,9 @@ namespace MWRender
     RenderingManager::~RenderingManager()
     {
         // let background loading thread finish before we delete anything else
+        mResourceSystem->getSceneManager()->setWorkQueue(nullptr);
+        for (auto& [worldspace, chunkMgr] : mWorldspaceChunks)
+            chunkMgr.mTerrain->setWorkQueue(nullptr);
         mWorkQueue = nullptr;
     }
 
@@ -634,6 +675,11 @@ namespace MWRender
         return mWorkQueue.get();
     }
 
+    Resource::GpuTimer* RenderingManager::getGpuTimer()
+    {
+        return mGpuTimer.get();
+    }
+
     Terrain::World* RenderingManager::getTerrain()
     {
         return mTerrain;
@@ -657,7 +703,7 @@ namespace MWRender
 
         workItem->mTextures.emplace_back("textures/_land_default.dds");
 
-        mWorkQueue->addWorkItem(std::move(workItem));
+        mWorkQueue->addWorkItem(std::move(workItem), SceneUtil::WorkPriority::Speculative);
     }
 
     double RenderingManager::getReferenceTime() const
@@ -782,11 +828,26 @@ namespace MWRender
             enableTerrain(true, store->getCell()->getWorldSpace());
             mTerrain->loadCell(store->getCell()->getGridX(), store->getCell()->getGridY());
         }
+        else if (Settings::camera().mInteriorVisibility && !store->getCell()->isQuasiExterior())
+        {
+            if (osg::Group* cellNode = mObjects->getCellNode(store))
+                mInteriorVisibility->setCell(store->getCell()->getId().serializeText(), *cellNode);
+        }
+
+        mShadowManager->dirtyStaticShadows();
+        mSky->dirtyPrecipitationOcclusion();
     }
     void RenderingManager::removeCell(const MWWorld::CellStore* store)
     {
         mPathgrid->removeCell(store);
         mActorsPaths->removeCell(store);
+        if (const osg::Group* cellNode = mObjects->getCellNode(store))
+        {
+            if (mCompileQueue != nullptr)
+                mCompileQueue->remove(*cellNode);
+            if (mInteriorVisibility->hasCell(*cellNode))
+                mInteriorVisibility->clear();
+        }
         mObjects->removeCell(store);
 
         if (store->getCell()->isExterior())
@@ -796,6 +857,17 @@ namespace MWRender
         }
 
         mWater->removeCell(store);
+
+        mShadowManager->dirtyStaticShadows();
+        mSky->dirtyPrecipitationOcclusion();
+    }
+
+    void RenderingManager::compileCell(const MWWorld::CellStore* store)
+    {
+        if (mCompileQueue == nullptr)
+            return;
+        if (osg::Group* cellNode = mObjects->getCellNode(store))
+            mCompileQueue->add(*cellNode);
     }
 
     void RenderingManager::enableTerrain(bool enable, ESM::RefId worldspace)
@@ -897,6 +969,12 @@ namespace MWRender
 
         mResourceSystem->getSceneManager()->getShaderManager().update(*mViewer);
 
+        mOcclusionCulling->update();
+
+        // Static shadows are cached, they have to be redrawn with the cells that became visible
+        if (mCompileQueue != nullptr && mCompileQueue->update() > 0)
+            mShadowManager->dirtyStaticShadows();
+
         float rainIntensity = mSky->getPrecipitationAlpha();
         mWater->setRainIntensity(rainIntensity);
         mWater->setRainRipplesEnabled(mSky->getRainRipplesEnabled());
@@ -949,6 +1027,8 @@ namespace MWRender
         stateUpdater->setWindSpeed(world->getWindSpeed());
         stateUpdater->setSkyColor(mSky->getSkyColor());
         mPostProcessor->setUnderwaterFlag(isUnderwater);
+
+        mInteriorVisibility->update(mCamera->getPosition(), *world->getRayCasting());
     }
 
     void RenderingManager::updatePlayerPtr(const MWWorld::Ptr& ptr)
@@ -974,16 +1054,19 @@ namespace MWRender
         }
 
         ptr.getRefData().getBaseNode()->setAttitude(rot);
+        mInteriorVisibility->updateObject(*ptr.getRefData().getBaseNode());
     }
 
     void RenderingManager::moveObject(const MWWorld::Ptr& ptr, const osg::Vec3f& pos)
     {
         ptr.getRefData().getBaseNode()->setPosition(pos);
+        mInteriorVisibility->updateObject(*ptr.getRefData().getBaseNode());
     }
 
     void RenderingManager::scaleObject(const MWWorld::Ptr& ptr, const osg::Vec3f& scale)
     {
         ptr.getRefData().getBaseNode()->setScale(scale);
+        mInteriorVisibility->updateObject(*ptr.getRefData().getBaseNode());
 
         if (ptr == mCamera->getTrackingPtr()) // update height of camera
             mCamera->processViewChange();
@@ -992,6 +1075,8 @@ namespace MWRender
     void RenderingManager::removeObject(const MWWorld::Ptr& ptr)
     {
         mActorsPaths->remove(ptr);
+        if (const osg::Node* node = ptr.getRefData().getBaseNode())
+            mInteriorVisibility->removeObject(*node);
         mObjects->removeObject(ptr);
         mWater->removeEmitter(ptr);
     }
@@ -1470,7 +1555,7 @@ namespace MWRender
             if (Settings::terrain().mObjectPaging)
             {
                 newChunkMgr.mObjectPaging
-                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), mSharedReaders, worldspace);
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -1479,11 +1564,13 @@ namespace MWRender
                 const float groundcoverDistance = Settings::groundcover().mRenderingDistance;
                 const float density = Settings::groundcover().mDensity;
 
-                newChunkMgr.mGroundcover = std::make_unique<Groundcover>(
-                    mResourceSystem->getSceneManager(), density, groundcoverDistance, mGroundCoverStore);
+                newChunkMgr.mGroundcover = std::make_unique<Groundcover>(mResourceSystem->getSceneManager(), density,
+                    groundcoverDistance, mGroundCoverStore, mSharedReaders);
                 quadTreeWorld->addChunkManager(newChunkMgr.mGroundcover.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mGroundcover.get());
             }
+            if (Settings::terrain().mAsyncLodSelection)
+                quadTreeWorld->setWorkQueue(mWorkQueue.get());
             newChunkMgr.mTerrain = std::move(quadTreeWorld);
         }
         else
@@ -1491,6 +1578,12 @@ namespace MWRender
                 mTerrainStorage.get(), Mask_Terrain, worldspace, expiryDelay, Mask_PreCompile, Mask_Debug);
 
         newChunkMgr.mTerrain->setTargetFrameRate(Settings::cells().mTargetFramerate);
+        if (mCompositeMapCache)
+            newChunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache);
+        newChunkMgr.mTerrain->setUseTextureArrays(Settings::terrain().mTextureArrays);
+        newChunkMgr.mTerrain->setUseVertexTextureFetch(Settings::terrain().mVertexTextureFetch);
+        if (mOcclusionCulling && mOcclusionCulling->isSupported())
+            newChunkMgr.mTerrain->setChunkCullCallback(mOcclusionCulling->getCullCallback());
         float distanceMult = std::cos(osg::DegreesToRadians(std::min(mFieldOfView, 140.f)) / 2.f);
         newChunkMgr.mTerrain->setViewDistance(mViewDistance * (distanceMult ? 1.f / distanceMult : 1.f));
 
@@ -1504,6 +1597,11 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            mWater->reportStats(frameNumber, *stats);
+            if (mOcclusionCulling->isEnabled())
+                mOcclusionCulling->reportStats(frameNumber, *stats);
+            if (mCompileQueue != nullptr)
+                stats->setAttribute(frameNumber, "Compiling Cells", static_cast<double>(mCompileQueue->size()));
         }
     }
 
@@ -1527,6 +1625,16 @@ namespace MWRender
             {
                 setViewDistance(Settings::camera().mViewingDistance);
             }
+            else if (it->first == "Camera" && it->second == "occlusion culling")
+            {
+                mOcclusionCulling->setEnabled(Settings::camera().mOcclusionCulling);
+            }
+            else if (it->first == "Camera" && it->second == "interior visibility")
+            {
+                // Takes effect on the next visit of an interior when enabled
+                if (!Settings::camera().mInteriorVisibility)
+                    mInteriorVisibility->clear();
+            }
             else if (it->first == "General"
                 && (it->second == "texture filter" || it->second == "texture mipmap" || it->second == "anisotropy"))
             {
@@ -1765,6 +1873,19 @@ namespace MWRender
     {
         mTerrain->setActiveGrid(grid);
     }
+
+    void RenderingManager::setInteriorVisibilityCache(const std::filesystem::path& directory)
+    {
+        mInteriorVisibility->setCacheDirectory(directory);
+    }
+
+    void RenderingManager::setCompositeMapCache(const std::filesystem::path& directory)
+    {
+        mCompositeMapCache = new Terrain::CompositeMapCache(directory, mWorkQueue.get());
+        for (auto& [worldspace, chunkMgr] : mWorldspaceChunks)
+            chunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache);
+    }
+
     bool RenderingManager::pagingEnableObject(int type, const MWWorld::ConstPtr& ptr, bool enabled)
     {
         if (!ptr.isInCell() || !ptr.getCell()->isExterior() || !mObjectPaging)
@@ -32,6 +32,7 @@ namespace osgUtil
 
 namespace Resource
 {
+    class GpuTimer;
     class ResourceSystem;
 }
 
@@ -45,11 +46,13 @@ namespace ESM
     struct Cell;
     struct FormId;
     using RefNum = FormId;
+    class SharedReaders;
 }
 
 namespace Terrain
 {
     class World;
+    class CompositeMapCache;
 }
 
 namespace Fallback
@@ -106,6 +109,9 @@ namespace MWRender
     class ObjectPaging;
     class Groundcover;
     class PostProcessor;
+    class OcclusionCulling;
+    class InteriorVisibility;
+    class CompileQueue;
 
     class RenderingManager : public MWRender::RenderingInterface
     {
@@ -113,7 +119,7 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            ESM::SharedReaders& sharedReaders, SceneUtil::UnrefQueue& unrefQueue);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -125,6 +131,8 @@ namespace MWRender
         SceneUtil::WorkQueue* getWorkQueue();
         Terrain::World* getTerrain();
 
+        Resource::GpuTimer* getGpuTimer();
+
         void preloadCommonAssets();
 
         double getReferenceTime() const;
@@ -152,6 +160,9 @@ namespace MWRender
         void addCell(const MWWorld::CellStore* store);
         void removeCell(const MWWorld::CellStore* store);
 
+        /// Hide the objects of the newly added cell until their GL objects are compiled within the per frame budget.
+        void compileCell(const MWWorld::CellStore* store);
+
         void enableTerrain(bool enable, ESM::RefId worldspace);
 
         void updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& updated);
@@ -266,6 +277,11 @@ namespace MWRender
 
         void setActiveGrid(const osg::Vec4i& grid);
 
+        /// Store the rendered terrain composite maps in \a directory and reuse them in later sessions.
+        void setCompositeMapCache(const std::filesystem::path& directory);
+
+        void setInteriorVisibilityCache(const std::filesystem::path& directory);
+
         bool pagingEnableObject(int type, const MWWorld::ConstPtr& ptr, bool enabled);
         void pagingBlacklistObject(int type, const MWWorld::ConstPtr& ptr);
         bool pagingUnlockCache();
@@ -309,6 +325,7 @@ namespace MWRender
         osg::ref_ptr<osg::Group> mRootNode;
         osg::ref_ptr<SceneUtil::LightManager> mSceneRoot;
         Resource::ResourceSystem* mResourceSystem;
+        osg::ref_ptr<Resource::GpuTimer> mGpuTimer;
 
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
 
@@ -327,12 +344,16 @@ namespace MWRender
         std::unique_ptr<TerrainStorage> mTerrainStorage;
         ObjectPaging* mObjectPaging;
         Groundcover* mGroundcover;
+        osg::ref_ptr<Terrain::CompositeMapCache> mCompositeMapCache;
         std::unique_ptr<SkyManager> mSky;
         std::unique_ptr<FogManager> mFog;
         std::unique_ptr<ScreenshotManager> mScreenshotManager;
         std::unique_ptr<EffectManager> mEffectManager;
         std::unique_ptr<SceneUtil::ShadowManager> mShadowManager;
         osg::ref_ptr<PostProcessor> mPostProcessor;
+        std::unique_ptr<OcclusionCulling> mOcclusionCulling;
+        std::unique_ptr<InteriorVisibility> mInteriorVisibility;
+        std::unique_ptr<CompileQueue> mCompileQueue;
         osg::ref_ptr<NpcAnimation> mPlayerAnimation;
         osg::ref_ptr<SceneUtil::PositionAttitudeTransform> mPlayerNode;
         std::unique_ptr<Camera> mCamera;
@@ -354,6 +375,7 @@ namespace MWRender
         bool mUpdateProjectionMatrix = false;
         bool mNight = false;
         const MWWorld::GroundcoverStore& mGroundCoverStore;
+        ESM::SharedReaders& mSharedReaders;
 
         void operator=(const RenderingManager&);
         RenderingManager(const RenderingManager&);
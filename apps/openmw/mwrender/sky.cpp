@@ -934,6 +934,11 @@ namespace MWRender
         mUnderwaterSwitch->setWaterLevel(height);
     }
 
+    void SkyManager::dirtyPrecipitationOcclusion()
+    {
+        mPrecipitationOccluder->dirty();
+    }
+
     void SkyManager::listAssetsToPreload(std::vector<std::string>& models, std::vector<std::string>& textures)
     {
         models.push_back(Settings::models().mSkyatmosphere);
@@ -100,6 +100,9 @@ namespace MWRender
         /// Set height of water plane (used to remove underwater weather particles)
         void setWaterHeight(float height);
 
+        /// Render the precipitation occluders again, e.g. after they were added or removed.
+        void dirtyPrecipitationOcclusion();
+
         void listAssetsToPreload(std::vector<std::string>& models, std::vector<std::string>& textures);
 
         float getBaseWindSpeed() const;
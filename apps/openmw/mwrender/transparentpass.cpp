@@ -8,6 +8,7 @@
 
 #include <osgUtil/RenderStage>
 
+#include <components/resource/gputimer.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/shader/shadermanager.hpp>
 #include <components/stereo/multiview.hpp>
@@ -17,9 +18,11 @@
 
 namespace MWRender
 {
-    TransparentDepthBinCallback::TransparentDepthBinCallback(Shader::ShaderManager& shaderManager, bool postPass)
+    TransparentDepthBinCallback::TransparentDepthBinCallback(
+        Shader::ShaderManager& shaderManager, bool postPass, Resource::GpuTimer* gpuTimer)
         : mStateSet(new osg::StateSet)
         , mPostPass(postPass)
+        , mGpuTimer(gpuTimer)
     {
         osg::ref_ptr<osg::Image> image = new osg::Image;
         image->allocateImage(1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE);
@@ -71,6 +74,8 @@ namespace MWRender
             return;
         }
 
+        const Resource::ScopedGpuTime gpuTime(mGpuTimer, renderInfo, Resource::GpuStage::Transparent);
+
         const osg::Texture* tex
             = opaqueFbo->getAttachment(osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER)
                   .getTexture();
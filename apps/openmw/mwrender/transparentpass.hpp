@@ -9,6 +9,11 @@
 
 #include <osgUtil/RenderBin>
 
+namespace Resource
+{
+    class GpuTimer;
+}
+
 namespace Shader
 {
     class ShaderManager;
@@ -24,7 +29,8 @@ namespace MWRender
     class TransparentDepthBinCallback : public osgUtil::RenderBin::DrawCallback
     {
     public:
-        TransparentDepthBinCallback(Shader::ShaderManager& shaderManager, bool postPass);
+        /// @param gpuTimer Measures the GPU time of the transparent objects of the main scene, may be null.
+        TransparentDepthBinCallback(Shader::ShaderManager& shaderManager, bool postPass, Resource::GpuTimer* gpuTimer);
 
         void drawImplementation(
             osgUtil::RenderBin* bin, osg::RenderInfo& renderInfo, osgUtil::RenderLeaf*& previous) override;
@@ -38,6 +44,7 @@ namespace MWRender
     private:
         osg::ref_ptr<osg::StateSet> mStateSet;
         bool mPostPass;
+        osg::ref_ptr<Resource::GpuTimer> mGpuTimer;
     };
 
 }
@@ -15,6 +15,7 @@
 #include <osgUtil/CullVisitor>
 #include <osgUtil/IncrementalCompileOperation>
 
+#include <components/resource/gputimer.hpp>
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -47,6 +48,20 @@
 
 namespace MWRender
 {
+    namespace
+    {
+        // Reprojecting the reflection and refraction of a previous frame only hides small camera motions
+        constexpr float maxRttReprojectionDistance = 32.f;
+        const float maxRttReprojectionAngle = osg::DegreesToRadians(3.f);
+
+        unsigned int getRttUpdateInterval()
+        {
+            // The views of stereo rendering would need to be reprojected separately
+            if (Stereo::getStereo())
+                return 1;
+            return Settings::water().mRttUpdateInterval;
+        }
+    }
 
     // --------------------------------------------------------------------------------------------------------------------------------
 
@@ -247,9 +262,10 @@ namespace MWRender
     class Refraction : public SceneUtil::RTTNode
     {
     public:
-        Refraction(uint32_t rttSize)
+        Refraction(uint32_t rttSize, Resource::GpuTimer* gpuTimer)
             : RTTNode(rttSize, rttSize, 0, false, 1, StereoAwareness::Aware, shouldAddMSAAIntermediateTarget())
             , mNodeMask(Refraction::sDefaultCullMask)
+            , mGpuTimer(gpuTimer)
         {
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
             mClipCullNode = new ClipCullNode;
@@ -277,6 +293,9 @@ namespace MWRender
 
             if (Settings::water().mRefractionScale != 1) // TODO: to be removed with issue #5709
                 SceneUtil::ShadowManager::instance().disableShadowsForStateSet(*camera->getOrCreateStateSet());
+
+            if (mGpuTimer != nullptr)
+                mGpuTimer->addCamera(*camera, Resource::GpuStage::WaterRefraction);
         }
 
         void apply(osg::Camera* camera) override
@@ -301,6 +320,7 @@ namespace MWRender
                 * osg::Matrix::translate(0, 0, (1.0 - refractionScale) * waterLevel);
 
             mClipCullNode->setPlane(osg::Plane(osg::Vec3d(0, 0, -1), osg::Vec3d(0, 0, waterLevel)));
+            forceUpdate();
         }
 
         void showWorld(bool show)
@@ -309,6 +329,7 @@ namespace MWRender
                 mNodeMask = Refraction::sDefaultCullMask;
             else
                 mNodeMask = Refraction::sDefaultCullMask & ~sToggleWorldMask;
+            forceUpdate();
         }
 
     private:
@@ -317,6 +338,7 @@ namespace MWRender
         osg::Matrix mViewMatrix{ osg::Matrix::identity() };
 
         unsigned int mNodeMask;
+        osg::ref_ptr<Resource::GpuTimer> mGpuTimer;
 
         static constexpr unsigned int sDefaultCullMask = Mask_Effect | Mask_Scene | Mask_Object | Mask_Static
             | Mask_Terrain | Mask_Actor | Mask_ParticleSystem | Mask_Sky | Mask_Sun | Mask_Player | Mask_Lighting
@@ -326,8 +348,9 @@ namespace MWRender
     class Reflection : public SceneUtil::RTTNode
     {
     public:
-        Reflection(uint32_t rttSize, bool isInterior)
+        Reflection(uint32_t rttSize, bool isInterior, Resource::GpuTimer* gpuTimer)
             : RTTNode(rttSize, rttSize, 0, false, 0, StereoAwareness::Aware, shouldAddMSAAIntermediateTarget())
+            , mGpuTimer(gpuTimer)
         {
             setInterior(isInterior);
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
@@ -353,6 +376,9 @@ namespace MWRender
             camera->setNodeMask(Mask_RenderToTexture);
 
             SceneUtil::ShadowManager::instance().disableShadowsForStateSet(*camera->getOrCreateStateSet());
+
+            if (mGpuTimer != nullptr)
+                mGpuTimer->addCamera(*camera, Resource::GpuStage::WaterReflection);
         }
 
         void apply(osg::Camera* camera) override
@@ -365,12 +391,14 @@ namespace MWRender
         {
             mInterior = isInterior;
             mNodeMask = calcNodeMask();
+            forceUpdate();
         }
 
         void setWaterLevel(float waterLevel)
         {
             mViewMatrix = osg::Matrix::scale(1, 1, -1) * osg::Matrix::translate(0, 0, 2 * waterLevel);
             mClipCullNode->setPlane(osg::Plane(osg::Vec3d(0, 0, 1), osg::Vec3d(0, 0, waterLevel)));
+            forceUpdate();
         }
 
         void setScene(osg::Node* scene)
@@ -387,6 +415,7 @@ namespace MWRender
                 mNodeMask = calcNodeMask();
             else
                 mNodeMask = calcNodeMask() & ~sToggleWorldMask;
+            forceUpdate();
         }
 
     private:
@@ -413,6 +442,7 @@ namespace MWRender
         osg::Node::NodeMask mNodeMask;
         osg::Matrix mViewMatrix{ osg::Matrix::identity() };
         bool mInterior;
+        osg::ref_ptr<Resource::GpuTimer> mGpuTimer;
     };
 
     /// DepthClampCallback enables GL_DEPTH_CLAMP for the current draw, if supported.
@@ -439,11 +469,12 @@ namespace MWRender
     };
 
     Water::Water(osg::Group* parent, osg::Group* sceneRoot, Resource::ResourceSystem* resourceSystem,
-        osgUtil::IncrementalCompileOperation* ico)
+        osgUtil::IncrementalCompileOperation* ico, Resource::GpuTimer* gpuTimer)
         : mRainSettingsUpdater(nullptr)
         , mParent(parent)
         , mSceneRoot(sceneRoot)
         , mResourceSystem(resourceSystem)
+        , mGpuTimer(gpuTimer)
         , mEnabled(true)
         , mToggled(true)
         , mTop(0)
@@ -536,22 +567,26 @@ namespace MWRender
         if (Settings::water().mShader)
         {
             const unsigned int rttSize = Settings::water().mRttSize;
+            const unsigned int rttUpdateInterval = getRttUpdateInterval();
 
-            mReflection = new Reflection(rttSize, mInterior);
+            // Cull the cameras before the water surface, which uses the view they are rendered from this frame
+            mReflection = new Reflection(rttSize, mInterior, mGpuTimer);
             mReflection->setWaterLevel(mTop);
             mReflection->setScene(mSceneRoot);
+            mReflection->setUpdateInterval(rttUpdateInterval, maxRttReprojectionDistance, maxRttReprojectionAngle);
             if (mCullCallback)
                 mReflection->addCullCallback(mCullCallback);
-            mParent->addChild(mReflection);
+            mParent->insertChild(mParent->getChildIndex(mSceneRoot), mReflection);
 
             if (Settings::water().mRefraction)
             {
-                mRefraction = new Refraction(rttSize);
+                mRefraction = new Refraction(rttSize, mGpuTimer);
                 mRefraction->setWaterLevel(mTop);
                 mRefraction->setScene(mSceneRoot);
+                mRefraction->setUpdateInterval(rttUpdateInterval, maxRttReprojectionDistance, maxRttReprojectionAngle);
                 if (mCullCallback)
                     mRefraction->addCullCallback(mCullCallback);
-                mParent->addChild(mRefraction);
+                mParent->insertChild(mParent->getChildIndex(mSceneRoot), mRefraction);
             }
 
             mRipples = new Ripples(mResourceSystem);
@@ -621,11 +656,12 @@ namespace MWRender
     {
     public:
         ShaderWaterStateSetUpdater(Water* water, Reflection* reflection, Refraction* refraction, Ripples* ripples,
-            osg::ref_ptr<osg::Program> program, osg::ref_ptr<osg::Texture2D> normalMap)
+            bool reprojection, osg::ref_ptr<osg::Program> program, osg::ref_ptr<osg::Texture2D> normalMap)
             : mWater(water)
             , mReflection(reflection)
             , mRefraction(refraction)
             , mRipples(ripples)
+            , mReprojection(reprojection)
             , mProgram(std::move(program))
             , mNormalMap(std::move(normalMap))
         {
@@ -658,6 +694,12 @@ namespace MWRender
                 stateset->addUniform(new osg::Uniform("rippleMap", 4));
             }
             stateset->addUniform(new osg::Uniform("nodePosition", osg::Vec3f(mWater->getPosition())));
+            if (mReprojection)
+            {
+                stateset->addUniform(new osg::Uniform("reflectionViewProjection", osg::Matrixf()));
+                if (mRefraction)
+                    stateset->addUniform(new osg::Uniform("refractionViewProjection", osg::Matrixf()));
+            }
         }
 
         void apply(osg::StateSet* stateset, osg::NodeVisitor* nv) override
@@ -675,6 +717,14 @@ namespace MWRender
                 stateset->setTextureAttributeAndModes(4, mRipples->getColorTexture(), osg::StateAttribute::ON);
             }
             stateset->getUniform("nodePosition")->set(osg::Vec3f(mWater->getPosition()));
+            if (mReprojection)
+            {
+                stateset->getUniform("reflectionViewProjection")
+                    ->set(osg::Matrixf(mReflection->getRenderedViewProjection(cv)));
+                if (mRefraction)
+                    stateset->getUniform("refractionViewProjection")
+                        ->set(osg::Matrixf(mRefraction->getRenderedViewProjection(cv)));
+            }
         }
 
     private:
@@ -682,6 +732,7 @@ namespace MWRender
         Reflection* mReflection;
         Refraction* mRefraction;
         Ripples* mRipples;
+        bool mReprojection;
         osg::ref_ptr<osg::Program> mProgram;
         osg::ref_ptr<osg::Texture2D> mNormalMap;
     };
@@ -697,6 +748,8 @@ namespace MWRender
         defineMap["rippleMapSize"] = std::to_string(RipplesSurface::sRTTSize) + ".0";
         defineMap["sunlightScattering"] = Settings::water().mSunlightScattering ? "1" : "0";
         defineMap["wobblyShores"] = Settings::water().mWobblyShores ? "1" : "0";
+        const bool reprojection = getRttUpdateInterval() > 1;
+        defineMap["waterReprojection"] = reprojection ? "1" : "0";
 
         Stereo::shaderStereoDefines(defineMap);
 
@@ -713,7 +766,7 @@ namespace MWRender
         node->setUpdateCallback(mRainSettingsUpdater);
 
         mShaderWaterStateSetUpdater = new ShaderWaterStateSetUpdater(
-            this, mReflection, mRefraction, mRipples, std::move(program), std::move(normalMap));
+            this, mReflection, mRefraction, mRipples, reprojection, std::move(program), std::move(normalMap));
         node->addCullCallback(mShaderWaterStateSetUpdater);
     }
 
@@ -882,6 +935,14 @@ namespace MWRender
         mSimulation->clear();
     }
 
+    void Water::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        if (mReflection)
+            stats.setAttribute(frameNumber, "Water Reflection Skipped", mReflection->takeNumSkippedUpdates());
+        if (mRefraction)
+            stats.setAttribute(frameNumber, "Water Refraction Skipped", mRefraction->takeNumSkippedUpdates());
+    }
+
     void Water::showWorld(bool show)
     {
         if (mReflection)
@@ -17,6 +17,7 @@ namespace osg
     class Geometry;
     class Node;
     class Callback;
+    class Stats;
 }
 
 namespace osgUtil
@@ -26,6 +27,7 @@ namespace osgUtil
 
 namespace Resource
 {
+    class GpuTimer;
     class ResourceSystem;
 }
 
@@ -60,6 +62,7 @@ namespace MWRender
         osg::ref_ptr<osg::Geometry> mWaterGeom;
         Resource::ResourceSystem* mResourceSystem;
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
+        osg::ref_ptr<Resource::GpuTimer> mGpuTimer;
 
         std::unique_ptr<RippleSimulation> mSimulation;
 
@@ -86,8 +89,9 @@ namespace MWRender
         void updateWaterMaterial();
 
     public:
+        /// @param gpuTimer Measures the GPU time of the reflection and refraction cameras, may be null.
         Water(osg::Group* parent, osg::Group* sceneRoot, Resource::ResourceSystem* resourceSystem,
-            osgUtil::IncrementalCompileOperation* ico);
+            osgUtil::IncrementalCompileOperation* ico, Resource::GpuTimer* gpuTimer);
         ~Water();
 
         void setCullCallback(osg::Callback* callback);
@@ -122,6 +126,8 @@ namespace MWRender
         void processChangedSettings(const Settings::CategorySettingVector& settings);
 
         void showWorld(bool show);
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
     };
 
 }
@@ -1,10 +1,13 @@
 #include "miscextensions.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <iomanip>
 #include <sstream>
 
+#include <osg/Stats>
+
 #include <components/compiler/extensions.hpp>
 #include <components/compiler/locals.hpp>
 #include <components/compiler/opcodes.hpp>
@@ -20,6 +23,7 @@
 
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/resource/stats.hpp>
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 
@@ -1758,6 +1762,30 @@ namespace MWScript
             }
         };
 
+        class OpReportMemory : public Interpreter::Opcode0
+        {
+        public:
+            void execute(Interpreter::Runtime& runtime) override
+            {
+                constexpr unsigned frameNumber = 0;
+                osg::ref_ptr<osg::Stats> stats(new osg::Stats("Memory"));
+                MWBase::Environment::get().getResourceSystem()->reportStats(frameNumber, stats.get());
+                MWBase::Environment::get().getWorld()->reportStats(frameNumber, *stats);
+                MWBase::Environment::get().getLuaManager()->reportStats(frameNumber, *stats);
+                MWBase::Environment::get().getSoundManager()->reportStats(frameNumber, *stats);
+
+                std::stringstream message;
+                for (const std::string& name : Resource::getMemoryStatNames())
+                {
+                    double value = 0;
+                    if (!name.empty() && stats->getAttribute(frameNumber, name, value))
+                        message << name << ": " << static_cast<std::uint64_t>(value) << "\n";
+                }
+                Log(Debug::Info) << "Memory usage:\n" << message.str();
+                runtime.getContext().report(message.str());
+            }
+        };
+
         void installOpcodes(Interpreter::Interpreter& interpreter)
         {
             interpreter.installSegment5<OpMenuMode>(Compiler::Misc::opcodeMenuMode);
@@ -1884,6 +1912,7 @@ namespace MWScript
             interpreter.installSegment5<OpHelp>(Compiler::Misc::opcodeHelp);
             interpreter.installSegment5<OpReloadLua>(Compiler::Misc::opcodeReloadLua);
             interpreter.installSegment5<OpTestModels>(Compiler::Misc::opcodeTestModels);
+            interpreter.installSegment5<OpReportMemory>(Compiler::Misc::opcodeReportMemory);
         }
     }
 }
@@ -3,7 +3,11 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 #include <components/debug/debuglog.hpp>
 
@@ -16,6 +20,9 @@
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
 #include <components/compiler/scanner.hpp>
+#include <components/compiler/scriptcache.hpp>
+
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwworld/esmstore.hpp"
 
@@ -24,6 +31,51 @@
 
 namespace MWScript
 {
+    class ScriptManager::PreloadScriptCacheItem final : public SceneUtil::WorkItem
+    {
+    public:
+        explicit PreloadScriptCacheItem(const Compiler::ScriptCache& cache, std::vector<const ESM::Script*>&& scripts)
+            : mCache(cache)
+            , mScripts(std::move(scripts))
+        {
+        }
+
+        void doWork() override
+        {
+            for (const ESM::Script* script : mScripts)
+            {
+                if (isCancelled())
+                    return;
+                {
+                    const std::lock_guard lock(mMutex);
+                    if (mLoaded.contains(script->mId))
+                        continue;
+                }
+                std::optional<Compiler::CachedScript> cached
+                    = mCache.read(mCache.getKey(script->mId.getRefIdString(), script->mScriptText));
+                const std::lock_guard lock(mMutex);
+                mLoaded.emplace(script->mId, std::move(cached));
+            }
+        }
+
+        /// Return the script if it is already read. Otherwise the script won't be read by the item.
+        std::optional<Compiler::CachedScript> take(const ESM::RefId& name)
+        {
+            const std::lock_guard lock(mMutex);
+            // Keep an empty value to mark the script as taken
+            const auto [it, inserted] = mLoaded.try_emplace(name);
+            if (inserted)
+                return std::nullopt;
+            return std::exchange(it->second, std::nullopt);
+        }
+
+    private:
+        const Compiler::ScriptCache& mCache;
+        const std::vector<const ESM::Script*> mScripts;
+        std::mutex mMutex;
+        std::unordered_map<ESM::RefId, std::optional<Compiler::CachedScript>> mLoaded;
+    };
+
     ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
         const std::vector<ESM::RefId>& scriptBlacklist)
         : mErrorHandler()
@@ -40,6 +92,45 @@ namespace MWScript
         std::sort(mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        if (mPreloadScriptCacheItem != nullptr)
+        {
+            mPreloadScriptCacheItem->cancel();
+            mPreloadScriptCacheItem->waitTillDone();
+        }
+    }
+
+    void ScriptManager::setScriptCache(std::unique_ptr<Compiler::ScriptCache>&& cache)
+    {
+        assert(mPreloadScriptCacheItem == nullptr);
+        mScriptCache = std::move(cache);
+    }
+
+    void ScriptManager::preloadScriptCache(SceneUtil::WorkQueue& workQueue)
+    {
+        if (mScriptCache == nullptr || mPreloadScriptCacheItem != nullptr)
+            return;
+        std::vector<const ESM::Script*> scripts;
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
+            scripts.push_back(&script);
+        mPreloadScriptCacheItem = new PreloadScriptCacheItem(*mScriptCache, std::move(scripts));
+        workQueue.addWorkItem(mPreloadScriptCacheItem, SceneUtil::WorkPriority::Speculative);
+    }
+
+    bool ScriptManager::readScriptCache(const ESM::RefId& name, const std::string& key)
+    {
+        std::optional<Compiler::CachedScript> cached;
+        if (mPreloadScriptCacheItem != nullptr)
+            cached = mPreloadScriptCacheItem->take(name);
+        if (!cached.has_value())
+            cached = mScriptCache->read(key);
+        if (!cached.has_value())
+            return false;
+        mScripts.emplace(name, CompiledScript(std::move(cached->mProgram), cached->mLocals));
+        return true;
+    }
+
     bool ScriptManager::compile(const ESM::RefId& name)
     {
         mParser.reset();
@@ -47,6 +138,14 @@ namespace MWScript
 
         if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
         {
+            std::string cacheKey;
+            if (mScriptCache != nullptr)
+            {
+                cacheKey = mScriptCache->getKey(script->mId.getRefIdString(), script->mScriptText);
+                if (readScriptCache(name, cacheKey))
+                    return true;
+            }
+
             mErrorHandler.setContext(script->mId.getRefIdString());
 
             bool Success = true;
@@ -79,7 +178,10 @@ namespace MWScript
 
             if (Success)
             {
-                mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
+                Interpreter::Program program = mParser.getProgram();
+                if (mScriptCache != nullptr)
+                    mScriptCache->write(cacheKey, program, mParser.getLocals());
+                mScripts.emplace(name, CompiledScript(std::move(program), mParser.getLocals()));
 
                 return true;
             }
@@ -134,6 +236,12 @@ namespace MWScript
         return false;
     }
 
+    bool ScriptManager::isActivationOnly(const ESM::RefId& name) const
+    {
+        const auto it = mScripts.find(name);
+        return it != mScripts.end() && it->second.mActivationOnly;
+    }
+
     void ScriptManager::clear()
     {
         for (auto& script : mScripts)
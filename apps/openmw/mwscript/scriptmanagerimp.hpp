@@ -2,10 +2,14 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
+#include <osg/ref_ptr>
+
 #include <components/compiler/fileparser.hpp>
+#include <components/compiler/programanalysis.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
 
 #include <components/interpreter/interpreter.hpp>
@@ -25,6 +29,7 @@ namespace MWWorld
 namespace Compiler
 {
     class Context;
+    class ScriptCache;
 }
 
 namespace Interpreter
@@ -33,6 +38,11 @@ namespace Interpreter
     class Interpreter;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWScript
 {
     class ScriptManager : public MWBase::ScriptManager
@@ -49,10 +59,12 @@ namespace MWScript
             Interpreter::Program mProgram;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
+            bool mActivationOnly;
 
             explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
                 , mLocals(locals)
+                , mActivationOnly(Compiler::isActivationOnly(mProgram))
             {
             }
         };
@@ -62,10 +74,25 @@ namespace MWScript
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
         std::vector<ESM::RefId> mScriptBlacklist;
 
+        class PreloadScriptCacheItem;
+
+        std::unique_ptr<Compiler::ScriptCache> mScriptCache;
+        osg::ref_ptr<PreloadScriptCacheItem> mPreloadScriptCacheItem;
+
+        bool readScriptCache(const ESM::RefId& name, const std::string& key);
+
     public:
         ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
             const std::vector<ESM::RefId>& scriptBlacklist);
 
+        ~ScriptManager() override;
+
+        /// Read compiled scripts from the cache and add the scripts compiled later to it
+        void setScriptCache(std::unique_ptr<Compiler::ScriptCache>&& cache);
+
+        /// Read all cached scripts in the background, so that the first use of a script doesn't wait for the disk
+        void preloadScriptCache(SceneUtil::WorkQueue& workQueue);
+
         void clear() override;
 
         bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext) override;
@@ -75,6 +102,9 @@ namespace MWScript
         ///< Compile script with the given namen
         /// \return Success?
 
+        bool isActivationOnly(const ESM::RefId& name) const override;
+        ///< Does the compiled script only react to the activation of its object? False if not compiled yet.
+
         std::pair<int, int> compileAll() override;
         ///< Compile all scripts
         /// \return count, success
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <utility>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/sampleconversion.hpp>
 #include <components/vfs/manager.hpp>
 
 namespace MWSound
@@ -118,6 +120,30 @@ namespace MWSound
         return false;
     }
 
+    bool FFmpeg_Decoder::convertSamples()
+    {
+        const std::size_t channels = av_get_channel_layout_nb_channels(mOutputChannelLayout);
+        const std::size_t count = mFrame->nb_samples;
+        std::int16_t* const output = reinterpret_cast<std::int16_t*>(mDataBuf);
+        switch (mFrame->format)
+        {
+            case AV_SAMPLE_FMT_FLT:
+                Misc::convertSamples(
+                    std::span(reinterpret_cast<const float*>(mFrame->extended_data[0]), count * channels), output);
+                return true;
+            case AV_SAMPLE_FMT_FLTP:
+                Misc::interleaveSamples(
+                    std::span(reinterpret_cast<const float* const*>(mFrame->extended_data), channels), count, output);
+                return true;
+            case AV_SAMPLE_FMT_S16P:
+                Misc::interleaveSamples(
+                    std::span(reinterpret_cast<const std::int16_t* const*>(mFrame->extended_data), channels), count,
+                    output);
+                return true;
+        }
+        return false;
+    }
+
     bool FFmpeg_Decoder::getAVAudioData()
     {
         bool got_frame = false;
@@ -147,7 +173,7 @@ namespace MWSound
                 continue;
             got_frame = true;
 
-            if (mSwr)
+            if (mSwr || mConvertSamples)
             {
                 if (!mDataBuf || mDataBufLen < mFrame->nb_samples)
                 {
@@ -160,8 +186,13 @@ namespace MWSound
                         mDataBufLen = mFrame->nb_samples;
                 }
 
-                if (swr_convert(mSwr, (uint8_t**)&mDataBuf, mFrame->nb_samples, (const uint8_t**)mFrame->extended_data,
-                        mFrame->nb_samples)
+                if (mConvertSamples)
+                {
+                    if (!convertSamples())
+                        return false;
+                }
+                else if (swr_convert(mSwr, (uint8_t**)&mDataBuf, mFrame->nb_samples,
+                             (const uint8_t**)mFrame->extended_data, mFrame->nb_samples)
                     < 0)
                 {
                     return false;
@@ -299,6 +330,7 @@ namespace MWSound
         av_freep(&mDataBuf);
         mFrame.reset();
         swr_free(&mSwr);
+        mConvertSamples = false;
 
         mFormatCtx.reset();
         mIoCtx.reset();
@@ -365,7 +397,11 @@ namespace MWSound
         if (ch_layout == 0)
             ch_layout = av_get_default_channel_layout(mCodecCtx->channels);
 
-        if (mOutputSampleFormat != mCodecCtx->sample_fmt || mOutputChannelLayout != ch_layout)
+        mConvertSamples = mOutputSampleFormat == AV_SAMPLE_FMT_S16 && mOutputChannelLayout == ch_layout
+            && (mCodecCtx->sample_fmt == AV_SAMPLE_FMT_FLT || mCodecCtx->sample_fmt == AV_SAMPLE_FMT_FLTP
+                || mCodecCtx->sample_fmt == AV_SAMPLE_FMT_S16P);
+
+        if (!mConvertSamples && (mOutputSampleFormat != mCodecCtx->sample_fmt || mOutputChannelLayout != ch_layout))
         {
             mSwr = swr_alloc_set_opts(mSwr, // SwrContext
                 mOutputChannelLayout, // output ch layout
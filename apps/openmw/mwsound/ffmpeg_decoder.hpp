@@ -81,9 +81,13 @@ namespace MWSound
         uint8_t* mDataBuf;
         uint8_t** mFrameData;
         int mDataBufLen;
+        // Convert the common sample formats into the output one without the SwrContext
+        bool mConvertSamples = false;
 
         bool getNextPacket();
 
+        bool convertSamples();
+
         Files::IStreamPtr mDataStream;
 
         static int readPacket(void* user_data, uint8_t* buf, int buf_size);
@@ -56,6 +56,12 @@ namespace MWSound
         mQueue.erase(mQueue.begin(), mQueue.begin() + sample * advance);
     }
 
+    void Sound_Loudness::finish()
+    {
+        mQueue.clear();
+        mComplete = true;
+    }
+
     float Sound_Loudness::getLoudnessAtTime(float sec) const
     {
         if (mSamplesPerSec <= 0.0f || mSamples.empty() || sec < 0.0f)
@@ -2,6 +2,7 @@
 #define GAME_SOUND_LOUDNESS_H
 
 #include <deque>
+#include <utility>
 #include <vector>
 
 #include "sound_decoder.hpp"
@@ -18,6 +19,7 @@ namespace MWSound
 
         // Loudness sample info
         std::vector<float> mSamples;
+        bool mComplete = false;
 
         std::deque<char> mQueue;
 
@@ -36,6 +38,20 @@ namespace MWSound
         {
         }
 
+        /**
+         * @param samplesPerSecond How many loudness values per second of audio \a samples contains.
+         * @param samples loudness values of the whole sound computed before
+         */
+        Sound_Loudness(float samplesPerSecond, std::vector<float>&& samples)
+            : mSamplesPerSec(samplesPerSecond)
+            , mSampleRate(0)
+            , mChannelConfig(ChannelConfig_Mono)
+            , mSampleType(SampleType_UInt8)
+            , mSamples(std::move(samples))
+            , mComplete(true)
+        {
+        }
+
         /**
          * Analyzes the energy (closely related to loudness) of a sound buffer.
          * The buffer will be divided into segments according to \a valuesPerSecond,
@@ -53,6 +69,17 @@ namespace MWSound
          * time (see analyzeLoudness()).
          */
         float getLoudnessAtTime(float sec) const;
+
+        /**
+         * Marks the whole sound as analyzed, the data not filling a complete loudness sample is dropped.
+         */
+        void finish();
+
+        bool isComplete() const { return mComplete; }
+
+        float getSamplesPerSecond() const { return mSamplesPerSec; }
+
+        const std::vector<float>& getSamples() const { return mSamples; }
     };
 
 }
@@ -0,0 +1,137 @@
+#include "loudnesscache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+namespace MWSound
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'M', 'W', 'L' };
+
+        // Increment when the format or the loudness analysis changes
+        constexpr std::uint32_t sVersion = 1;
+
+        struct Header
+        {
+            char mMagic[std::size(sMagic)];
+            std::uint32_t mVersion;
+            float mSamplesPerSecond;
+            std::uint32_t mCount;
+        };
+
+        std::uint8_t quantize(float value)
+        {
+            return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+        }
+    }
+
+    LoudnessCache::LoudnessCache(const std::filesystem::path& directory)
+        : mDirectory(directory)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create loudness cache directory " << directory << ": " << ec.message();
+            mDirectory.clear();
+        }
+    }
+
+    std::string LoudnessCache::getKey(std::string_view fileName, std::istream& content) const
+    {
+        const std::array<std::uint64_t, 2> hash = Files::getHash(fileName, content);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return key.str();
+    }
+
+    std::filesystem::path LoudnessCache::getPath(const std::string& key) const
+    {
+        return mDirectory / (key + ".loudness");
+    }
+
+    std::optional<std::vector<float>> LoudnessCache::read(const std::string& key, float samplesPerSecond) const
+    {
+        if (mDirectory.empty())
+            return std::nullopt;
+        const std::filesystem::path path = getPath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        Header header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || std::memcmp(header.mMagic, sMagic, sizeof(sMagic)) != 0)
+        {
+            Log(Debug::Warning) << "Failed to read cached loudness " << path << ": bad header";
+            return std::nullopt;
+        }
+        // Written by another version, it is replaced once the file is analyzed
+        if (header.mVersion != sVersion || header.mSamplesPerSecond != samplesPerSecond)
+            return std::nullopt;
+        std::vector<std::uint8_t> values(header.mCount);
+        if (!stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size())))
+        {
+            Log(Debug::Warning) << "Failed to read cached loudness " << path << ": unexpected end of file";
+            return std::nullopt;
+        }
+        std::vector<float> result;
+        result.reserve(values.size());
+        for (const std::uint8_t value : values)
+            result.push_back(value / 255.0f);
+        return result;
+    }
+
+    void LoudnessCache::write(const std::string& key, float samplesPerSecond, std::span<const float> samples) const
+    {
+        if (mDirectory.empty())
+            return;
+        const std::filesystem::path path = getPath(key);
+
+        Header header;
+        std::memcpy(header.mMagic, sMagic, sizeof(sMagic));
+        header.mVersion = sVersion;
+        header.mSamplesPerSecond = samplesPerSecond;
+        header.mCount = static_cast<std::uint32_t>(samples.size());
+        std::vector<std::uint8_t> values;
+        values.reserve(samples.size());
+        std::transform(samples.begin(), samples.end(), std::back_inserter(values), quantize);
+
+        // The same file may be written by other threads at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                if (!stream.write(reinterpret_cast<const char*>(&header), sizeof(header))
+                    || !stream.write(reinterpret_cast<const char*>(values.data()),
+                        static_cast<std::streamsize>(values.size()))
+                    || !stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached loudness " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef GAME_SOUND_LOUDNESSCACHE_H
+#define GAME_SOUND_LOUDNESSCACHE_H
+
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MWSound
+{
+    /// @brief Stores the loudness of voice files used for lip-sync on disk, so that later sessions have it for the
+    /// whole file as soon as the voice starts playing instead of analyzing it while it's streamed.
+    /// @par A file is identified by the hash of its content. Values are stored with 8 bit precision.
+    class LoudnessCache
+    {
+    public:
+        explicit LoudnessCache(const std::filesystem::path& directory);
+
+        std::string getKey(std::string_view fileName, std::istream& content) const;
+
+        /// @return nullopt if the file isn't cached or it was analyzed with another number of values per second.
+        /// @note Thread safe.
+        std::optional<std::vector<float>> read(const std::string& key, float samplesPerSecond) const;
+
+        /// @note Thread safe.
+        void write(const std::string& key, float samplesPerSecond, std::span<const float> samples) const;
+
+    private:
+        std::filesystem::path getPath(const std::string& key) const;
+
+        std::filesystem::path mDirectory;
+    };
+}
+
+#endif
@@ -2,8 +2,10 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string_view>
 #include <thread>
@@ -12,12 +14,15 @@
 #include <cstdint>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/misc/constants.hpp>
-#include <components/misc/resourcehelpers.hpp>
 #include <components/misc/thread.hpp>
 #include <components/vfs/manager.hpp>
 
+#include <osg/Stats>
+
 #include "loudness.hpp"
+#include "loudnesscache.hpp"
 #include "openal_output.hpp"
 #include "sound.hpp"
 #include "sound_decoder.hpp"
@@ -178,6 +183,28 @@ namespace
             return {};
         return name;
     }
+
+    // Virtual sounds get a source only when they are this much more audible than the quietest playing sound to avoid
+    // swapping sources between sounds of similar audibility every update
+    constexpr float sVirtualSoundHysteresis = 1.5f;
+
+    // Free sources virtual sounds don't take to have some left for the streams
+    constexpr std::size_t sReservedSources = 4;
+
+    float getBufferLength(ALuint buffer)
+    {
+        ALint size = 0;
+        ALint frequency = 0;
+        ALint channels = 0;
+        ALint bits = 0;
+        alGetBufferi(buffer, AL_SIZE, &size);
+        alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+        alGetBufferi(buffer, AL_CHANNELS, &channels);
+        alGetBufferi(buffer, AL_BITS, &bits);
+        if (size <= 0 || frequency <= 0 || channels <= 0 || bits <= 0)
+            return 0.0f;
+        return static_cast<float>(size) / (channels * bits / 8) / frequency;
+    }
 }
 
 namespace MWSound
@@ -295,6 +322,8 @@ namespace MWSound
         DecoderPtr mDecoder;
 
         std::unique_ptr<Sound_Loudness> mLoudnessAnalyzer;
+        const LoudnessCache* mLoudnessCache = nullptr;
+        std::string mLoudnessCacheKey;
 
         std::atomic<bool> mIsFinished;
 
@@ -309,7 +338,7 @@ namespace MWSound
         OpenAL_SoundStream(ALuint src, DecoderPtr decoder);
         ~OpenAL_SoundStream();
 
-        bool init(bool getLoudnessData = false);
+        bool init(bool getLoudnessData = false, const LoudnessCache* loudnessCache = nullptr);
 
         bool isPlaying();
         double getStreamDelay() const;
@@ -351,16 +380,20 @@ namespace MWSound
         // thread entry point
         void run()
         {
+            OPENMW_TRACE_THREAD_NAME("Sound streaming");
             std::unique_lock<std::mutex> lock(mMutex);
             while (!mQuitNow)
             {
-                auto iter = mStreams.begin();
-                while (iter != mStreams.end())
                 {
-                    if ((*iter)->process() == false)
-                        iter = mStreams.erase(iter);
-                    else
-                        ++iter;
+                    OPENMW_TRACE_ZONE("OpenAL_Output::StreamThread::process");
+                    auto iter = mStreams.begin();
+                    while (iter != mStreams.end())
+                    {
+                        if ((*iter)->process() == false)
+                            iter = mStreams.erase(iter);
+                        else
+                            ++iter;
+                    }
                 }
 
                 mCondVar.wait_for(lock, std::chrono::milliseconds(50));
@@ -481,7 +514,7 @@ namespace MWSound
         mDecoder->close();
     }
 
-    bool OpenAL_SoundStream::init(bool getLoudnessData)
+    bool OpenAL_SoundStream::init(bool getLoudnessData, const LoudnessCache* loudnessCache)
     {
         alGenBuffers(mBuffers.size(), mBuffers.data());
         ALenum err = getALError();
@@ -519,7 +552,24 @@ namespace MWSound
         mBufferSize = static_cast<ALuint>(sBufferLength * mSampleRate);
         mBufferSize *= mFrameSize;
 
-        if (getLoudnessData)
+        if (getLoudnessData && loudnessCache != nullptr)
+        {
+            const std::string name = mDecoder->getName();
+            try
+            {
+                mLoudnessCacheKey = loudnessCache->getKey(name, *mDecoder->mResourceMgr->getNormalized(name));
+                if (std::optional<std::vector<float>> samples = loudnessCache->read(mLoudnessCacheKey, sLoudnessFPS))
+                    mLoudnessAnalyzer = std::make_unique<Sound_Loudness>(sLoudnessFPS, std::move(*samples));
+                else
+                    mLoudnessCache = loudnessCache;
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to get cached loudness of \"" << name << "\": " << e.what();
+            }
+        }
+
+        if (getLoudnessData && mLoudnessAnalyzer == nullptr)
             mLoudnessAnalyzer = std::make_unique<Sound_Loudness>(sLoudnessFPS, mSampleRate, chans, type);
 
         mIsFinished = false;
@@ -644,7 +694,7 @@ namespace MWSound
                 }
                 if (got > 0)
                 {
-                    if (mLoudnessAnalyzer.get())
+                    if (mLoudnessAnalyzer != nullptr && !mLoudnessAnalyzer->isComplete())
                         mLoudnessAnalyzer->analyzeLoudness(data);
 
                     ALuint bufid = mBuffers[mCurrentBufIdx];
@@ -653,6 +703,13 @@ namespace MWSound
                     mCurrentBufIdx = (mCurrentBufIdx + 1) % mBuffers.size();
                 }
             }
+
+            if (mIsFinished && mLoudnessAnalyzer != nullptr && !mLoudnessAnalyzer->isComplete())
+            {
+                mLoudnessAnalyzer->finish();
+                if (mLoudnessCache != nullptr)
+                    mLoudnessCache->write(mLoudnessCacheKey, sLoudnessFPS, mLoudnessAnalyzer->getSamples());
+            }
         }
 
         return queued;
@@ -985,6 +1042,10 @@ namespace MWSound
             alDeleteSources(1, &source);
         mFreeSources.clear();
 
+        for (Sound* sound : mVirtualSounds)
+            sound->mVirtual = false;
+        mVirtualSounds.clear();
+
         if (mEffectSlot)
             alDeleteAuxiliaryEffectSlots(1, &mEffectSlot);
         mEffectSlot = 0;
@@ -1034,43 +1095,30 @@ namespace MWSound
         return ret;
     }
 
-    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(VFS::Path::NormalizedView fname)
+    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const DecodedSound& sound)
     {
         getALError();
 
-        std::vector<char> data;
+        const std::vector<char>* data = &sound.mData;
         ALenum format = AL_NONE;
-        int srate = 0;
-
-        try
-        {
-            DecoderPtr decoder = mManager.getDecoder();
-            decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
-        }
-        catch (std::exception& e)
-        {
-            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-        }
+        int srate = sound.mSampleRate;
+        if (!data->empty())
+            format = getALFormat(sound.mChannelConfig, sound.mSampleType);
 
-        if (data.empty())
+        std::vector<char> silence;
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            silence.assign(8000, -128);
+            data = &silence;
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), data.size(), srate);
+        alBufferData(buf, format, data->data(), data->size(), srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1205,19 +1253,32 @@ namespace MWSound
         alSource3f(source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
     }
 
-    bool OpenAL_Output::playSound(Sound* sound, Sound_Handle data, float offset)
+    float OpenAL_Output::getAudibility(const Sound& sound) const
     {
-        ALuint source;
-
-        if (mFreeSources.empty())
-        {
-            Log(Debug::Warning) << "No free sources!";
-            return false;
-        }
-        source = mFreeSources.front();
+        float gain = sound.getRealVolume();
+        if (sound.getIs3D())
+        {
+            // Matches the inverse clamped distance model
+            const float distance = (sound.getPosition() - mListenerPos).length();
+            if (distance > sound.getMaxDistance())
+                return 0.0f;
+            if (distance > sound.getMinDistance())
+                gain *= sound.getMinDistance() / distance;
+        }
+        // Voices and sounds played by the player are heard before the others of the same gain
+        if (!sound.getIs3D() || sound.getPlayType() == Type::Voice)
+            gain *= 4.0f;
+        return gain;
+    }
 
-        initCommon2D(source, sound->getPosition(), sound->getRealVolume(), getTimeScaledPitch(sound),
-            sound->getIsLooping(), sound->getUseEnv());
+    bool OpenAL_Output::startSound(Sound* sound, ALuint source, Sound_Handle data, float offset)
+    {
+        if (sound->getIs3D())
+            initCommon3D(source, sound->getPosition(), sound->getMinDistance(), sound->getMaxDistance(),
+                sound->getRealVolume(), getTimeScaledPitch(sound), sound->getIsLooping(), sound->getUseEnv());
+        else
+            initCommon2D(source, sound->getPosition(), sound->getRealVolume(), getTimeScaledPitch(sound),
+                sound->getIsLooping(), sound->getUseEnv());
         alSourcei(source, AL_BUFFER, GET_PTRID(data));
         alSourcef(source, AL_SEC_OFFSET, offset);
         if (getALError() != AL_NO_ERROR)
@@ -1237,54 +1298,88 @@ namespace MWSound
             return false;
         }
 
-        mFreeSources.pop_front();
         sound->mHandle = MAKE_PTRID(source);
         mActiveSounds.push_back(sound);
 
         return true;
     }
 
-    bool OpenAL_Output::playSound3D(Sound* sound, Sound_Handle data, float offset)
+    ALuint OpenAL_Output::virtualizeSound(Sound* sound)
     {
-        ALuint source;
+        ALuint source = GET_PTRID(sound->mHandle);
+        sound->mHandle = nullptr;
 
-        if (mFreeSources.empty())
-        {
-            Log(Debug::Warning) << "No free sources!";
-            return false;
-        }
-        source = mFreeSources.front();
+        ALfloat offset = 0.0f;
+        alGetSourcef(source, AL_SEC_OFFSET, &offset);
+        alSourceRewind(source);
+        alSourcei(source, AL_BUFFER, 0);
+        getALError();
 
-        initCommon3D(source, sound->getPosition(), sound->getMinDistance(), sound->getMaxDistance(),
-            sound->getRealVolume(), getTimeScaledPitch(sound), sound->getIsLooping(), sound->getUseEnv());
-        alSourcei(source, AL_BUFFER, GET_PTRID(data));
-        alSourcef(source, AL_SEC_OFFSET, offset);
-        if (getALError() != AL_NO_ERROR)
-        {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
-            return false;
-        }
+        sound->mOffset = offset;
+        sound->mVirtual = true;
+        mActiveSounds.erase(std::find(mActiveSounds.begin(), mActiveSounds.end(), sound));
+        mVirtualSounds.push_back(sound);
 
-        alSourcePlay(source);
-        if (getALError() != AL_NO_ERROR)
+        return source;
+    }
+
+    bool OpenAL_Output::stealSource(float audibility)
+    {
+        Sound* quietest = nullptr;
+        float quietestAudibility = audibility;
+        for (Sound* sound : mActiveSounds)
         {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
+            if (mPausedTypes & sound->getPlayType())
+                continue;
+            const float soundAudibility = getAudibility(*sound);
+            if (soundAudibility < quietestAudibility)
+            {
+                quietest = sound;
+                quietestAudibility = soundAudibility;
+            }
+        }
+        if (quietest == nullptr)
             return false;
+        mFreeSources.push_back(virtualizeSound(quietest));
+        return true;
+    }
+
+    bool OpenAL_Output::playSound(Sound* sound, Sound_Handle data, float offset)
+    {
+        sound->mData = data;
+        sound->mLength = getBufferLength(GET_PTRID(data));
+        sound->mOffset = offset;
+        sound->mVirtual = false;
+
+        if (mFreeSources.empty() && !stealSource(getAudibility(*sound)))
+        {
+            if (!sound->getIsLooping() && sound->mLength <= offset)
+                return false;
+            // Played without a source until a quieter sound stops or it gets more audible than a playing one
+            sound->mVirtual = true;
+            mVirtualSounds.push_back(sound);
+            return true;
         }
 
+        if (!startSound(sound, mFreeSources.front(), data, offset))
+            return false;
         mFreeSources.pop_front();
-        sound->mHandle = MAKE_PTRID(source);
-        mActiveSounds.push_back(sound);
-
         return true;
     }
 
+    bool OpenAL_Output::playSound3D(Sound* sound, Sound_Handle data, float offset)
+    {
+        return playSound(sound, data, offset);
+    }
+
     void OpenAL_Output::finishSound(Sound* sound)
     {
+        if (sound->mVirtual)
+        {
+            sound->mVirtual = false;
+            mVirtualSounds.erase(std::find(mVirtualSounds.begin(), mVirtualSounds.end(), sound));
+            return;
+        }
         if (!sound->mHandle)
             return;
         ALuint source = GET_PTRID(sound->mHandle);
@@ -1302,6 +1397,8 @@ namespace MWSound
 
     bool OpenAL_Output::isSoundPlaying(Sound* sound)
     {
+        if (sound->mVirtual)
+            return sound->getIsLooping() || sound->mOffset < sound->mLength;
         if (!sound->mHandle)
             return false;
         ALuint source = GET_PTRID(sound->mHandle);
@@ -1326,7 +1423,7 @@ namespace MWSound
 
     bool OpenAL_Output::streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData)
     {
-        if (mFreeSources.empty())
+        if (mFreeSources.empty() && !stealSource(std::numeric_limits<float>::infinity()))
         {
             Log(Debug::Warning) << "No free sources!";
             return false;
@@ -1342,7 +1439,7 @@ namespace MWSound
             return false;
 
         OpenAL_SoundStream* stream = new OpenAL_SoundStream(source, std::move(decoder));
-        if (!stream->init(getLoudnessData))
+        if (!stream->init(getLoudnessData, mManager.mLoudnessCache.get()))
         {
             delete stream;
             return false;
@@ -1357,7 +1454,7 @@ namespace MWSound
 
     bool OpenAL_Output::streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData)
     {
-        if (mFreeSources.empty())
+        if (mFreeSources.empty() && !stealSource(std::numeric_limits<float>::infinity()))
         {
             Log(Debug::Warning) << "No free sources!";
             return false;
@@ -1373,7 +1470,7 @@ namespace MWSound
             return false;
 
         OpenAL_SoundStream* stream = new OpenAL_SoundStream(source, std::move(decoder));
-        if (!stream->init(getLoudnessData))
+        if (!stream->init(getLoudnessData, mManager.mLoudnessCache.get()))
         {
             delete stream;
             return false;
@@ -1462,9 +1559,75 @@ namespace MWSound
 
     void OpenAL_Output::finishUpdate()
     {
+        updateVirtualSounds();
         alcProcessContext(alcGetCurrentContext());
     }
 
+    void OpenAL_Output::updateVirtualSounds()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const float duration = std::chrono::duration<float>(now - mLastVirtualUpdate).count();
+        mLastVirtualUpdate = now;
+
+        if (mVirtualSounds.empty())
+            return;
+
+        std::vector<std::pair<float, Sound*>> virtualSounds;
+        virtualSounds.reserve(mVirtualSounds.size());
+        for (Sound* sound : mVirtualSounds)
+        {
+            if (mPausedTypes & sound->getPlayType())
+                continue;
+            sound->mOffset += duration * getTimeScaledPitch(sound);
+            if (sound->getIsLooping() && sound->mLength > 0.0f)
+                sound->mOffset = std::fmod(sound->mOffset, sound->mLength);
+            else if (sound->mOffset >= sound->mLength)
+                continue;
+            virtualSounds.emplace_back(getAudibility(*sound), sound);
+        }
+
+        std::vector<std::pair<float, Sound*>> playingSounds;
+        playingSounds.reserve(mActiveSounds.size());
+        for (Sound* sound : mActiveSounds)
+        {
+            if (!(mPausedTypes & sound->getPlayType()))
+                playingSounds.emplace_back(getAudibility(*sound), sound);
+        }
+
+        // The most audible virtual sounds take the sources of the least audible playing ones
+        std::sort(virtualSounds.begin(), virtualSounds.end(), [](const auto& l, const auto& r) { return l > r; });
+        std::sort(playingSounds.begin(), playingSounds.end());
+        auto playing = playingSounds.begin();
+        for (const auto& [audibility, sound] : virtualSounds)
+        {
+            if (audibility <= 0.0f)
+                break;
+            ALuint source;
+            if (mFreeSources.size() > sReservedSources)
+            {
+                source = mFreeSources.front();
+                mFreeSources.pop_front();
+            }
+            else if (playing != playingSounds.end() && audibility > playing->first * sVirtualSoundHysteresis)
+            {
+                source = virtualizeSound(playing->second);
+                ++playing;
+            }
+            else
+                break;
+
+            mVirtualSounds.erase(std::find(mVirtualSounds.begin(), mVirtualSounds.end(), sound));
+            sound->mVirtual = false;
+            if (!startSound(sound, source, sound->mData, sound->mOffset))
+            {
+                // Keep it virtual to let it stop at its end as if it was played
+                sound->mVirtual = true;
+                mVirtualSounds.push_back(sound);
+                mFreeSources.push_back(source);
+            }
+        }
+    }
+
     void OpenAL_Output::updateListener(
         const osg::Vec3f& pos, const osg::Vec3f& atdir, const osg::Vec3f& updir, Environment env)
     {
@@ -1509,6 +1672,7 @@ namespace MWSound
 
     void OpenAL_Output::pauseSounds(int types)
     {
+        mPausedTypes |= types;
         std::vector<ALuint> sources;
         for (Sound* sound : mActiveSounds)
         {
@@ -1560,10 +1724,21 @@ namespace MWSound
         }
 
         alListenerf(AL_GAIN, 1.0f);
+
+        // Virtual sounds don't advance while the device is paused
+        mLastVirtualUpdate = std::chrono::steady_clock::now();
+    }
+
+    void OpenAL_Output::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Sound Playing", mActiveSounds.size());
+        stats.setAttribute(frameNumber, "Sound Virtual", mVirtualSounds.size());
+        stats.setAttribute(frameNumber, "Sound Streams", mActiveStreams.size());
     }
 
     void OpenAL_Output::resumeSounds(int types)
     {
+        mPausedTypes &= ~types;
         std::vector<ALuint> sources;
         for (Sound* sound : mActiveSounds)
         {
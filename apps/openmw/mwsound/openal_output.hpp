@@ -1,6 +1,7 @@
 #ifndef GAME_SOUND_OPENAL_OUTPUT_H
 #define GAME_SOUND_OPENAL_OUTPUT_H
 
+#include <chrono>
 #include <deque>
 #include <map>
 #include <mutex>
@@ -42,6 +43,9 @@ namespace MWSound
 
         typedef std::vector<Sound*> SoundVec;
         SoundVec mActiveSounds;
+        SoundVec mVirtualSounds;
+        int mPausedTypes = 0;
+        std::chrono::steady_clock::time_point mLastVirtualUpdate;
         typedef std::vector<Stream*> StreamVec;
         StreamVec mActiveStreams;
 
@@ -72,6 +76,17 @@ namespace MWSound
 
         float getTimeScaledPitch(SoundBase* sound);
 
+        float getAudibility(const Sound& sound) const;
+
+        bool startSound(Sound* sound, ALuint source, Sound_Handle data, float offset);
+
+        ALuint virtualizeSound(Sound* sound);
+
+        /// Gives a source to a sound of given audibility by making the quietest playing sound virtual
+        bool stealSource(float audibility);
+
+        void updateVirtualSounds();
+
         OpenAL_Output& operator=(const OpenAL_Output& rhs);
         OpenAL_Output(const OpenAL_Output& rhs);
 
@@ -87,7 +102,7 @@ namespace MWSound
 
         std::vector<std::string> enumerateHrtf() override;
 
-        std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
+        std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
@@ -117,6 +132,8 @@ namespace MWSound
         void pauseActiveDevice() override;
         void resumeActiveDevice() override;
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
         OpenAL_Output(SoundManager& mgr);
         virtual ~OpenAL_Output();
     };
@@ -177,6 +177,15 @@ namespace MWSound
         Sound(const Sound&) = delete;
         Sound(Sound&&) = delete;
 
+        // Buffer and playback position of a sound, kept to play it without a source when there are not enough of
+        // them ("virtual" sound) and to give it one again later from the same position
+        Sound_Handle mData = nullptr;
+        float mLength = 0.0f;
+        float mOffset = 0.0f;
+        bool mVirtual = false;
+
+        friend class OpenAL_Output;
+
     public:
         Sound() = default;
     };
@@ -3,12 +3,17 @@
 #include "../mwbase/environment.hpp"
 #include "../mwworld/esmstore.hpp"
 
+#include "soundmanagerimp.hpp"
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadsoun.hpp>
 #include <components/misc/resourcehelpers.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include <osg/Stats>
+
 #include <algorithm>
 #include <cmath>
 
@@ -33,10 +38,52 @@ namespace MWSound
             params.mAudioMaxDistanceMult = settings.find("fAudioMaxDistanceMult")->mValue.getFloat();
             return params;
         }
+
+        DecodedSound decodeSound(Sound_Decoder& decoder, VFS::Path::NormalizedView fname)
+        {
+            DecodedSound result;
+            try
+            {
+                decoder.open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder.mResourceMgr));
+                decoder.getInfo(&result.mSampleRate, &result.mChannelConfig, &result.mSampleType);
+                decoder.readAll(result.mData);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+                result.mData.clear();
+            }
+            return result;
+        }
     }
 
-    SoundBufferPool::SoundBufferPool(Sound_Output& output)
+    class SoundBufferPool::DecodeItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit DecodeItem(DecoderPtr&& decoder, VFS::Path::NormalizedView fname)
+            : mDecoder(std::move(decoder))
+            , mFileName(fname)
+        {
+        }
+
+        void doWork() override
+        {
+            mSound = decodeSound(*mDecoder, mFileName);
+            mDecoder.reset();
+        }
+
+        /// Valid only when the item is done
+        const DecodedSound& getSound() const { return mSound; }
+
+    private:
+        DecoderPtr mDecoder;
+        VFS::Path::Normalized mFileName;
+        DecodedSound mSound;
+    };
+
+    SoundBufferPool::SoundBufferPool(Sound_Output& output, SceneUtil::WorkQueue* workQueue)
         : mOutput(&output)
+        , mWorkQueue(workQueue)
         , mBufferCacheMax(Settings::sound().mBufferCacheMax * 1024 * 1024)
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
@@ -75,9 +122,32 @@ namespace MWSound
     Sound_Buffer* SoundBufferPool::loadSfx(Sound_Buffer* sfx)
     {
         if (sfx->getHandle() != nullptr)
+        {
+            ++mHits;
             return sfx;
+        }
+
+        const auto it = mDecoding.find(sfx);
+        if (it != mDecoding.end())
+        {
+            const osg::ref_ptr<DecodeItem> item = it->second;
+            mDecoding.erase(it);
+            if (item->isDone() && !item->isCancelled())
+            {
+                ++mPrefetched;
+                return loadSfx(sfx, item->getSound());
+            }
+            // Waiting for the queued item may take longer than decoding the sound right away
+            item->cancel();
+        }
+
+        ++mMisses;
+        return loadSfx(sfx, decodeSound(*mOutput->mManager.getDecoder(), sfx->getResourceName()));
+    }
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+    Sound_Buffer* SoundBufferPool::loadSfx(Sound_Buffer* sfx, const DecodedSound& sound)
+    {
+        auto [handle, size] = mOutput->loadSound(sound);
         if (handle == nullptr)
             return {};
 
@@ -95,7 +165,7 @@ namespace MWSound
         return sfx;
     }
 
-    Sound_Buffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    Sound_Buffer* SoundBufferPool::findSound(const ESM::RefId& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -103,17 +173,21 @@ namespace MWSound
                 insertSound(sound.mId, sound);
         }
 
-        Sound_Buffer* sfx;
         const auto it = mBufferNameMap.find(soundId);
         if (it != mBufferNameMap.end())
-            sfx = it->second;
-        else
-        {
-            const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
-            if (sound == nullptr)
-                return {};
-            sfx = insertSound(soundId, *sound);
-        }
+            return it->second;
+
+        const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return nullptr;
+        return insertSound(soundId, *sound);
+    }
+
+    Sound_Buffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    {
+        Sound_Buffer* const sfx = findSound(soundId);
+        if (sfx == nullptr)
+            return {};
 
         return loadSfx(sfx);
     }
@@ -132,8 +206,54 @@ namespace MWSound
         return loadSfx(sfx);
     }
 
+    void SoundBufferPool::prefetch(const ESM::RefId& soundId)
+    {
+        if (mWorkQueue == nullptr || !mOutput->isInitialized())
+            return;
+
+        Sound_Buffer* const sfx = findSound(soundId);
+        if (sfx == nullptr || sfx->getHandle() != nullptr || mDecoding.contains(sfx))
+            return;
+
+        osg::ref_ptr<DecodeItem> item(new DecodeItem(mOutput->mManager.getDecoder(), sfx->getResourceName()));
+        mWorkQueue->addWorkItem(item, SceneUtil::WorkPriority::Speculative);
+        mDecoding.emplace(sfx, std::move(item));
+    }
+
+    void SoundBufferPool::update()
+    {
+        for (auto it = mDecoding.begin(); it != mDecoding.end();)
+        {
+            if (!it->second->isDone())
+            {
+                ++it;
+                continue;
+            }
+            Sound_Buffer* const sfx = it->first;
+            const osg::ref_ptr<DecodeItem> item = it->second;
+            it = mDecoding.erase(it);
+            if (item->isCancelled())
+                continue;
+            ++mPrefetched;
+            loadSfx(sfx, item->getSound());
+        }
+    }
+
+    void SoundBufferPool::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "SoundBuffer Hit", mHits);
+        stats.setAttribute(frameNumber, "SoundBuffer Miss", mMisses);
+        stats.setAttribute(frameNumber, "SoundBuffer Prefetched", mPrefetched);
+        stats.setAttribute(frameNumber, "SoundBuffer Decoding", mDecoding.size());
+        stats.setAttribute(frameNumber, "SoundBuffer CacheSize", mBufferCacheSize);
+    }
+
     void SoundBufferPool::clear()
     {
+        for (const auto& [sfx, item] : mDecoding)
+            item->cancel();
+        mDecoding.clear();
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
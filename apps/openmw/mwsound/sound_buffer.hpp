@@ -6,6 +6,8 @@
 #include <string>
 #include <unordered_map>
 
+#include <osg/ref_ptr>
+
 #include "sound_output.hpp"
 #include <components/esm/refid.hpp>
 
@@ -14,6 +16,16 @@ namespace ESM
     struct Sound;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace VFS
 {
     class Manager;
@@ -59,7 +71,7 @@ namespace MWSound
     class SoundBufferPool
     {
     public:
-        SoundBufferPool(Sound_Output& output);
+        SoundBufferPool(Sound_Output& output, SceneUtil::WorkQueue* workQueue);
 
         SoundBufferPool(const SoundBufferPool&) = delete;
 
@@ -80,6 +92,14 @@ namespace MWSound
         // Lookup for a sound by file name, and ensure it's ready for use.
         Sound_Buffer* load(std::string_view fileName);
 
+        /// Decode a sound in background to load it without decoding on the main thread
+        void prefetch(const ESM::RefId& soundId);
+
+        /// Load the sounds decoded in background since the last call
+        void update();
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void use(Sound_Buffer& sfx)
         {
             if (sfx.mUses++ == 0)
@@ -99,9 +119,16 @@ namespace MWSound
         void clear();
 
     private:
+        class DecodeItem;
+
         Sound_Buffer* loadSfx(Sound_Buffer* sfx);
 
+        Sound_Buffer* loadSfx(Sound_Buffer* sfx, const DecodedSound& sound);
+
+        Sound_Buffer* findSound(const ESM::RefId& soundId);
+
         Sound_Output* mOutput;
+        SceneUtil::WorkQueue* mWorkQueue;
         std::deque<Sound_Buffer> mSoundBuffers;
         std::unordered_map<ESM::RefId, Sound_Buffer*> mBufferNameMap;
         std::unordered_map<std::string, Sound_Buffer*> mBufferFileNameMap;
@@ -110,6 +137,10 @@ namespace MWSound
         std::size_t mBufferCacheSize = 0;
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<Sound_Buffer*> mUnusedBuffers;
+        std::unordered_map<Sound_Buffer*, osg::ref_ptr<DecodeItem>> mDecoding;
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+        std::size_t mPrefetched = 0;
 
         inline Sound_Buffer* insertSound(const ESM::RefId& soundId, const ESM::Sound& sound);
         inline Sound_Buffer* insertSound(std::string_view fileName);
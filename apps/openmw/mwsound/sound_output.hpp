@@ -10,6 +10,8 @@
 
 #include "../mwbase/soundmanager.hpp"
 
+#include "sound_decoder.hpp"
+
 namespace MWSound
 {
     class SoundManager;
@@ -40,7 +42,7 @@ namespace MWSound
 
         virtual std::vector<std::string> enumerateHrtf() = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
@@ -71,6 +73,8 @@ namespace MWSound
         virtual void pauseActiveDevice() = 0;
         virtual void resumeActiveDevice() = 0;
 
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
         Sound_Output& operator=(const Sound_Output& rhs);
         Sound_Output(const Sound_Output& rhs);
 
@@ -27,6 +27,7 @@
 
 #include "constants.hpp"
 #include "ffmpeg_decoder.hpp"
+#include "loudnesscache.hpp"
 #include "openal_output.hpp"
 #include "sound.hpp"
 #include "sound_buffer.hpp"
@@ -109,11 +110,11 @@ namespace MWSound
         return static_cast<int>(a) | static_cast<int>(b);
     }
 
-    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound)
+    SoundManager::SoundManager(const VFS::Manager* vfs, SceneUtil::WorkQueue* workQueue, bool useSound)
         : mVFS(vfs)
         , mOutput(std::make_unique<OpenAL_Output>(*this))
         , mWaterSoundUpdater(makeWaterSoundUpdaterSettings())
-        , mSoundBuffers(*mOutput)
+        , mSoundBuffers(*mOutput, workQueue)
         , mMusicType(MWSound::MusicType::Normal)
         , mListenerUnderwater(false)
         , mListenerPos(0, 0, 0)
@@ -159,6 +160,11 @@ namespace MWSound
         }
     }
 
+    void SoundManager::setLoudnessCache(std::unique_ptr<LoudnessCache>&& cache)
+    {
+        mLoudnessCache = std::move(cache);
+    }
+
     SoundManager::~SoundManager()
     {
         SoundManager::clear();
@@ -1084,6 +1090,8 @@ namespace MWSound
         if (!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
+
         MWBase::StateManager::State state = MWBase::Environment::get().getStateManager()->getState();
         bool isMainMenu = MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_MainMenu)
             && state == MWBase::StateManager::State_NoGame;
@@ -1166,6 +1174,18 @@ namespace MWSound
             it->second.mCell = updated.mCell;
     }
 
+    void SoundManager::preloadSounds(std::span<const ESM::RefId> soundIds)
+    {
+        for (const ESM::RefId& soundId : soundIds)
+            mSoundBuffers.prefetch(soundId);
+    }
+
+    void SoundManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mOutput->reportStats(frameNumber, stats);
+        mSoundBuffers.reportStats(frameNumber, stats);
+    }
+
     // Default readAll implementation, for decoders that can't do anything
     // better
     void Sound_Decoder::readAll(std::vector<char>& output)
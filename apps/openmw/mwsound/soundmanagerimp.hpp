@@ -24,6 +24,11 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace ESM
 {
     struct Sound;
@@ -38,6 +43,7 @@ namespace MWWorld
 namespace MWSound
 {
     class Sound_Output;
+    class LoudnessCache;
     struct Sound_Decoder;
     class SoundBase;
     class Sound;
@@ -58,6 +64,8 @@ namespace MWSound
 
         Misc::ObjectPool<Sound> mSounds;
 
+        std::unique_ptr<LoudnessCache> mLoudnessCache;
+
         Misc::ObjectPool<Stream> mStreams;
 
         typedef std::pair<SoundPtr, Sound_Buffer*> SoundBufferRefPair;
@@ -153,14 +161,17 @@ namespace MWSound
     protected:
         DecoderPtr getDecoder();
         friend class OpenAL_Output;
+        friend class SoundBufferPool;
 
         void stopSound(Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr);
         ///< Stop the given object from playing given sound buffer.
 
     public:
-        SoundManager(const VFS::Manager* vfs, bool useSound);
+        SoundManager(const VFS::Manager* vfs, SceneUtil::WorkQueue* workQueue, bool useSound);
         ~SoundManager() override;
 
+        void setLoudnessCache(std::unique_ptr<LoudnessCache>&& cache);
+
         void processChangedSettings(const Settings::CategorySettingVector& settings) override;
 
         bool isEnabled() const override { return mOutput->isInitialized(); }
@@ -285,6 +296,10 @@ namespace MWSound
 
         void updatePtr(const MWWorld::ConstPtr& old, const MWWorld::ConstPtr& updated) override;
 
+        void preloadSounds(std::span<const ESM::RefId> soundIds) override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
         void clear() override;
     };
 }
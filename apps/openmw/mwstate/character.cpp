@@ -10,6 +10,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm/defs.hpp>
 #include <components/esm3/esmreader.hpp>
+#include <components/files/compressedstream.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/utf8stream.hpp>
 
@@ -35,7 +36,7 @@ void MWState::Character::addSlot(const std::filesystem::path& path, const std::s
     slot.mTimeStamp = std::filesystem::last_write_time(path);
 
     ESM::ESMReader reader;
-    reader.open(slot.mPath);
+    reader.open(Files::openMaybeCompressedInputFileStream(slot.mPath), slot.mPath);
 
     if (reader.getRecName() != ESM::REC_SAVE)
         return; // invalid save file -> ignore
@@ -168,6 +169,16 @@ const MWState::Slot* MWState::Character::updateSlot(const Slot* slot, const ESM:
     return &mSlots.back();
 }
 
+void MWState::Character::setScreenshot(const Slot* slot, std::vector<char>&& screenshot)
+{
+    std::ptrdiff_t index = slot - mSlots.data();
+
+    if (index < 0 || static_cast<std::size_t>(index) >= mSlots.size())
+        throw std::logic_error("slot not found");
+
+    mSlots[index].mProfile.mScreenshot = std::move(screenshot);
+}
+
 MWState::Character::SlotIterator MWState::Character::begin() const
 {
     return mSlots.rbegin();
@@ -52,6 +52,9 @@ namespace MWState
         ///
         /// \attention The \a slot pointer will be invalidated by this call.
 
+        void setScreenshot(const Slot* slot, std::vector<char>&& screenshot);
+        /// \note Slot must belong to this character.
+
         SlotIterator begin() const;
         ///<  Any call to createSlot and updateSlot can invalidate the returned iterator.
 
@@ -1,6 +1,7 @@
 #include "statemanagerimp.hpp"
 
 #include <filesystem>
+#include <fstream>
 
 #include <SDL_clipboard.h>
 
@@ -15,6 +16,7 @@
 
 #include <components/loadinglistener/loadinglistener.hpp>
 
+#include <components/files/compressedstream.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/algorithm.hpp>
 #include <components/settings/values.hpp>
@@ -49,6 +51,102 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    void startSaveGameFile(
+        ESM::ESMWriter& writer, std::ostream& stream, const std::vector<std::string>& contentFiles, int recordCount)
+    {
+        for (const std::string& contentFile : contentFiles)
+            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
+
+        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+
+        // all unused
+        writer.setVersion(0);
+        writer.setType(0);
+        writer.setAuthor("");
+        writer.setDescription("");
+
+        writer.setRecordCount(recordCount);
+
+        writer.save(stream);
+    }
+
+    std::vector<char> encodeScreenshot(const osg::Image& screenshot)
+    {
+        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("jpg");
+        if (!readerwriter)
+        {
+            Log(Debug::Error) << "Error: Unable to write screenshot, can't find a jpg ReaderWriter";
+            return {};
+        }
+
+        std::ostringstream ostream;
+        osgDB::ReaderWriter::WriteResult result = readerwriter->writeImage(screenshot, ostream);
+        if (!result.success())
+        {
+            Log(Debug::Error) << "Error: Unable to write screenshot: " << result.message() << " code "
+                              << result.status();
+            return {};
+        }
+
+        std::string data = ostream.str();
+        return std::vector<char>(data.begin(), data.end());
+    }
+
+    void writeSaveFile(const std::filesystem::path& path, const std::string& data, bool compress)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // Don't trash the existing save file we are overwriting if the write fails
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream filestream(tmpPath, std::ios::binary);
+            if (compress)
+                Files::writeCompressedStream(filestream, data);
+            else
+                filestream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            filestream.close();
+            if (filestream.fail())
+            {
+                std::error_code ec;
+                std::filesystem::remove(tmpPath, ec);
+                throw std::runtime_error("Write operation failed (file stream)");
+            }
+        }
+        std::filesystem::rename(tmpPath, path);
+
+        const auto finish = std::chrono::steady_clock::now();
+
+        Log(Debug::Info) << "Saved game file " << path.filename() << " is written in "
+                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
+                         << "ms";
+    }
+
+    // The screenshot is encoded while the game continues. The file header and the profile are written again to
+    // include it, replacing the ones at the start of the serialized game.
+    std::vector<char> writeSaveGame(const std::filesystem::path& path, ESM::SavedGame profile,
+        const osg::Image& screenshot, const std::string& data, std::size_t profileEnd, int recordCount, bool compress)
+    {
+        profile.mScreenshot = encodeScreenshot(screenshot);
+
+        std::ostringstream stream;
+        ESM::ESMWriter writer;
+        startSaveGameFile(writer, stream, profile.mContentFiles, recordCount);
+        writer.startRecord(ESM::REC_SAVE);
+        profile.save(writer);
+        writer.endRecord(ESM::REC_SAVE);
+        writer.close();
+
+        std::string file = std::move(stream).str();
+        file.append(data, profileEnd);
+        writeSaveFile(path, file, compress);
+
+        return std::move(profile.mScreenshot);
+    }
+}
+
 void MWState::StateManager::cleanup(bool force)
 {
     if (mState != State_NoGame || force)
@@ -107,6 +205,80 @@ MWState::StateManager::StateManager(const std::filesystem::path& saves, const st
 {
 }
 
+MWState::StateManager::~StateManager()
+{
+    if (!mSaveWriting.valid())
+        return;
+    try
+    {
+        mSaveWriting.get();
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Error) << "Failed to save game: " << e.what();
+    }
+}
+
+void MWState::StateManager::showSaveError(const std::exception& e) const
+{
+    std::stringstream error;
+    error << "Failed to save game: " << e.what();
+
+    Log(Debug::Error) << error.str();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{Interface:OK}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+}
+
+void MWState::StateManager::waitForSaveWriting()
+{
+    if (mSaveWriting.valid())
+        mSaveWriting.wait();
+}
+
+void MWState::StateManager::finishSaveWriting(bool removeFailedSlot)
+{
+    if (!mSaveWriting.valid())
+        return;
+    try
+    {
+        std::vector<char> screenshot = mSaveWriting.get();
+        if (Character* character = getCurrentCharacter())
+        {
+            for (const Slot& slot : *character)
+            {
+                if (slot.mPath == mSaveWritingPath)
+                {
+                    character->setScreenshot(&slot, std::move(screenshot));
+                    break;
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        showSaveError(e);
+
+        // If no file was written, clean up the slot
+        Character* character = getCurrentCharacter();
+        if (removeFailedSlot && character && !std::filesystem::exists(mSaveWritingPath))
+        {
+            for (const Slot& slot : *character)
+            {
+                if (slot.mPath == mSaveWritingPath)
+                {
+                    character->deleteSlot(&slot);
+                    break;
+                }
+            }
+            character->cleanup();
+            if (mLastSavegame == mSaveWritingPath)
+                mLastSavegame.clear();
+        }
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
     mQuitRequest = true;
@@ -213,6 +385,9 @@ void MWState::StateManager::resumeGame()
 
 void MWState::StateManager::saveGame(std::string_view description, const Slot* slot)
 {
+    // Saves can't overlap. A failed slot of the previous save is kept because the given slot must stay valid.
+    finishSaveWriting(false);
+
     MWBase::Environment::get().getLuaManager()->applyDelayedActions();
 
     MWState::Character* character = getCurrentCharacter();
@@ -260,7 +435,7 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         profile.mMaximumHealth = stats.getHealth().getModified();
 
         Log(Debug::Info) << "Making a screenshot for saved game '" << description << "'";
-        writeScreenshot(profile.mScreenshot);
+        const osg::ref_ptr<const osg::Image> screenshot = makeScreenshot();
 
         if (!slot)
             slot = character->createSlot(profile);
@@ -278,17 +453,6 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
 
         ESM::ESMWriter writer;
 
-        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
-            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
-
-        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
-
-        // all unused
-        writer.setVersion(0);
-        writer.setType(0);
-        writer.setAuthor("");
-        writer.setDescription("");
-
         int recordCount = 1 // saved game header
             + MWBase::Environment::get().getJournal()->countSavedGameRecords()
             + MWBase::Environment::get().getLuaManager()->countSavedGameRecords()
@@ -298,9 +462,8 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
             + MWBase::Environment::get().getMechanicsManager()->countSavedGameRecords()
             + MWBase::Environment::get().getInputManager()->countSavedGameRecords()
             + MWBase::Environment::get().getWindowManager()->countSavedGameRecords();
-        writer.setRecordCount(recordCount);
 
-        writer.save(stream);
+        startSaveGameFile(writer, stream, profile.mContentFiles, recordCount);
 
         Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         // Using only Cells for progress information, since they typically have the largest records by far
@@ -312,6 +475,7 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         writer.startRecord(ESM::REC_SAVE);
         slot->mProfile.save(writer);
         writer.endRecord(ESM::REC_SAVE);
+        const std::size_t profileEnd = static_cast<std::size_t>(stream.tellp());
 
         MWBase::Environment::get().getJournal()->write(writer, listener);
         MWBase::Environment::get().getDialogueManager()->write(writer, listener);
@@ -334,32 +498,26 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        // All good, write to file while the game continues
+        mSaveWritingPath = slot->mPath;
+        mSaveWriting = std::async(std::launch::async,
+            [path = slot->mPath, profile = slot->mProfile, screenshot, data = std::move(stream).str(), profileEnd,
+                recordCount, compress = Settings::saves().mCompress.get()] {
+                return writeSaveGame(path, profile, *screenshot, data, profileEnd, recordCount, compress);
+            });
 
         Settings::saves().mCharacter.set(Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
         mLastSavegame = slot->mPath;
 
         const auto finish = std::chrono::steady_clock::now();
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
                          << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
                          << "ms";
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
-
-        Log(Debug::Error) << error.str();
-
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{Interface:OK}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+        showSaveError(e);
 
         // If no file was written, clean up the slot
         if (character && slot && !std::filesystem::exists(slot->mPath))
@@ -452,6 +610,9 @@ struct SaveVersionTooNewError : SaveFormatVersionError
 
 void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
 {
+    // The file may still be written
+    waitForSaveWriting();
+
     try
     {
         cleanup();
@@ -459,7 +620,7 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
         Log(Debug::Info) << "Reading save file " << filepath.filename();
 
         ESM::ESMReader reader;
-        reader.open(filepath);
+        reader.open(Files::openMaybeCompressedInputFileStream(filepath), filepath);
 
         ESM::FormatVersion version = reader.getFormatVersion();
         if (version > ESM::CurrentSaveGameFormatVersion)
@@ -705,6 +866,7 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    waitForSaveWriting();
     const std::filesystem::path savePath = slot->mPath;
     mCharacterManager.deleteSlot(character, slot);
     if (mLastSavegame == savePath)
@@ -735,6 +897,9 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    if (mSaveWriting.valid() && mSaveWriting.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        finishSaveWriting(true);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -831,7 +996,7 @@ bool MWState::StateManager::confirmLoading(const std::vector<std::string_view>&
     return true;
 }
 
-void MWState::StateManager::writeScreenshot(std::vector<char>& imageData) const
+osg::ref_ptr<const osg::Image> MWState::StateManager::makeScreenshot() const
 {
     int screenshotW = 259 * 2, screenshotH = 133 * 2; // *2 to get some nice antialiasing
 
@@ -839,21 +1004,5 @@ void MWState::StateManager::writeScreenshot(std::vector<char>& imageData) const
 
     MWBase::Environment::get().getWorld()->screenshot(screenshot.get(), screenshotW, screenshotH);
 
-    osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("jpg");
-    if (!readerwriter)
-    {
-        Log(Debug::Error) << "Error: Unable to write screenshot, can't find a jpg ReaderWriter";
-        return;
-    }
-
-    std::ostringstream ostream;
-    osgDB::ReaderWriter::WriteResult result = readerwriter->writeImage(*screenshot, ostream);
-    if (!result.success())
-    {
-        Log(Debug::Error) << "Error: Unable to write screenshot: " << result.message() << " code " << result.status();
-        return;
-    }
-
-    std::string data = ostream.str();
-    imageData = std::vector<char>(data.begin(), data.end());
+    return screenshot;
 }
@@ -2,12 +2,21 @@
 #define GAME_STATE_STATEMANAGER_H
 
 #include <filesystem>
+#include <future>
 #include <map>
+#include <vector>
+
+#include <osg/ref_ptr>
 
 #include "../mwbase/statemanager.hpp"
 
 #include "charactermanager.hpp"
 
+namespace osg
+{
+    class Image;
+}
+
 namespace MWState
 {
     class StateManager : public MWBase::StateManager
@@ -20,6 +29,9 @@ namespace MWState
         CharacterManager mCharacterManager;
         double mTimePlayed;
         std::filesystem::path mLastSavegame;
+        // The file of the last saved game is written in background, the result is the encoded screenshot
+        std::future<std::vector<char>> mSaveWriting;
+        std::filesystem::path mSaveWritingPath;
 
     private:
         void cleanup(bool force = false);
@@ -28,13 +40,23 @@ namespace MWState
 
         bool confirmLoading(const std::vector<std::string_view>& missingFiles) const;
 
-        void writeScreenshot(std::vector<char>& imageData) const;
+        osg::ref_ptr<const osg::Image> makeScreenshot() const;
+
+        void showSaveError(const std::exception& e) const;
+
+        void waitForSaveWriting();
+
+        /// Wait until the file of the last saved game is written and report the error if any
+        /// \param removeFailedSlot Invalidates the slots of the current character
+        void finishSaveWriting(bool removeFailedSlot);
 
         std::map<int, int> buildContentFileIndexMap(const ESM::ESMReader& reader) const;
 
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
+        ~StateManager() override;
+
         void requestQuit() override;
 
         bool hasQuitRequest() const override;
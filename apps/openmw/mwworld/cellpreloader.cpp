@@ -2,13 +2,18 @@
 
 #include <algorithm>
 #include <atomic>
-#include <limits>
+#include <chrono>
 #include <span>
+#include <vector>
 
 #include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
+#include <components/esm/util.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/sharedreaders.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/resourcehelpers.hpp>
@@ -16,12 +21,17 @@
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/keyframemanager.hpp>
+#include <components/resource/residentsize.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/view.hpp>
 #include <components/terrain/world.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/soundmanager.hpp"
+#include "../mwphysics/heightfield.hpp"
+#include "../mwphysics/heightfieldmanager.hpp"
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
@@ -61,42 +71,74 @@ namespace MWWorld
         std::vector<std::string_view>& mOut;
     };
 
-    /// Worker thread item: preload models in a cell.
+    struct ListSoundsVisitor
+    {
+        bool operator()(const MWWorld::ConstPtr& ptr)
+        {
+            ptr.getClass().getSoundsToPreload(ptr, mOut);
+
+            return true;
+        }
+
+        std::vector<ESM::RefId>& mOut;
+    };
+
+    /// Worker thread item: read the references of a cell and preload models in the cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
     public:
         /// Constructor to be called from the main thread.
         explicit PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager,
             Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager,
-            Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
+            MWPhysics::HeightFieldManager* heightFieldManager, Terrain::World* terrain,
+            MWRender::LandManager* landManager, ESM::SharedReaders* readers, bool preloadInstances)
             : mIsExterior(cell->getCell()->isExterior())
             , mCellLocation(cell->getCell()->getExteriorCellLocation())
             , mCellId(cell->getCell()->getId())
             , mSceneManager(sceneManager)
             , mBulletShapeManager(bulletShapeManager)
             , mKeyframeManager(keyframeManager)
+            , mHeightFieldManager(heightFieldManager)
             , mTerrain(terrain)
             , mLandManager(landManager)
+            , mReaders(readers)
             , mPreloadInstances(preloadInstances)
             , mAbort(false)
         {
             mTerrainView = mTerrain->createView();
 
+            if (mReaders != nullptr)
+                mStagedRefs = cell->stageRefs();
+
             ListModelsVisitor visitor{ mMeshes };
             cell->forEachConst(visitor);
         }
 
         void abort() override { mAbort = true; }
 
+        /// Approximate size of the preloaded resources, valid once the work is done.
+        std::size_t getResidentSize() const { return mResidentSize; }
+
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
+            OPENMW_TRACE_ZONE("CellPreloader::PreloadItem");
+
+            // First so that the cell can use the references as soon as possible
+            if (mStagedRefs != nullptr && !mAbort)
+            {
+                mStagedRefs->mRefs = CellStore::readContentRefs(mStagedRefs->mCell, *mReaders);
+                mStagedRefs->mReady.store(true, std::memory_order_release);
+            }
+
             if (mIsExterior)
             {
                 try
                 {
                     mTerrain->cacheCell(mTerrainView.get(), mCellLocation.mX, mCellLocation.mY);
-                    mPreloadedObjects.insert(mLandManager->getLand(mCellLocation));
+                    osg::ref_ptr<const ESMTerrain::LandObject> land = mLandManager->getLand(mCellLocation);
+                    mPreloadedObjects.insert(mHeightFieldManager->getShape(mCellLocation, land.get()));
+                    mPreloadedObjects.insert(std::move(land));
                 }
                 catch (const std::exception& e)
                 {
@@ -105,34 +147,42 @@ namespace MWWorld
                 }
             }
 
-            std::string mesh;
-            std::string kfname;
+            // Resolve all the meshes first to let the disk read the files while the first ones are parsed
+            const VFS::Manager& vfs = *mSceneManager->getVFS();
+            std::vector<MeshFiles> meshes;
+            std::vector<VFS::Path::Normalized> files;
+            meshes.reserve(mMeshes.size());
             for (std::string_view path : mMeshes)
+            {
+                MeshFiles& resolved = meshes.emplace_back();
+                resolved.mPath = path;
+                resolved.mMesh = Misc::ResourceHelpers::correctMeshPath(path);
+                resolved.mMesh = Misc::ResourceHelpers::correctActorModelPath(resolved.mMesh, &vfs);
+                if (!vfs.exists(resolved.mMesh))
+                {
+                    meshes.pop_back();
+                    continue;
+                }
+                files.emplace_back(resolved.mMesh);
+                resolved.mKeyframes = getKeyframesPath(resolved.mMesh);
+                if (!resolved.mKeyframes.empty() && vfs.exists(resolved.mKeyframes))
+                    files.emplace_back(resolved.mKeyframes);
+                else
+                    resolved.mKeyframes.clear();
+            }
+            if (!mAbort)
+                vfs.prefetch(files);
+
+            for (const MeshFiles& resolved : meshes)
             {
                 if (mAbort)
                     break;
 
+                const std::string& mesh = resolved.mMesh;
                 try
                 {
-                    const VFS::Manager& vfs = *mSceneManager->getVFS();
-                    mesh = Misc::ResourceHelpers::correctMeshPath(path);
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
-
-                    if (!vfs.exists(mesh))
-                        continue;
-
-                    size_t slashpos = mesh.find_last_of("/\\");
-                    if (slashpos != std::string::npos && slashpos != mesh.size() - 1)
-                    {
-                        if (Misc::StringUtils::toLower(mesh[slashpos + 1]) == 'x'
-                            && Misc::StringUtils::ciEndsWith(mesh, ".nif"))
-                        {
-                            kfname = mesh;
-                            kfname.replace(kfname.size() - 4, 4, ".kf");
-                            if (vfs.exists(kfname))
-                                mPreloadedObjects.insert(mKeyframeManager->get(kfname));
-                        }
-                    }
+                    if (!resolved.mKeyframes.empty())
+                        mPreloadedObjects.insert(mKeyframeManager->get(resolved.mKeyframes));
                     mPreloadedObjects.insert(mSceneManager->getTemplate(mesh));
                     if (mPreloadInstances)
                         mPreloadedObjects.insert(mBulletShapeManager->cacheInstance(mesh));
@@ -141,13 +191,39 @@ namespace MWWorld
                 }
                 catch (const std::exception& e)
                 {
-                    Log(Debug::Warning) << "Failed to preload mesh \"" << path << "\" from cell " << mCellId << ": "
-                                        << e.what();
+                    Log(Debug::Warning) << "Failed to preload mesh \"" << resolved.mPath << "\" from cell " << mCellId
+                                        << ": " << e.what();
                 }
             }
+
+            Resource::ResidentSizeEstimator estimator;
+            for (const osg::ref_ptr<const osg::Object>& object : mPreloadedObjects)
+                if (object != nullptr)
+                    estimator.add(*object);
+            mResidentSize = estimator.getSize();
         }
 
     private:
+        struct MeshFiles
+        {
+            std::string_view mPath;
+            std::string mMesh;
+            std::string mKeyframes;
+        };
+
+        // The animated meshes "x*.nif" come with the keyframes in "x*.kf"
+        static std::string getKeyframesPath(std::string_view mesh)
+        {
+            const std::size_t slashpos = mesh.find_last_of("/\\");
+            if (slashpos == std::string_view::npos || slashpos == mesh.size() - 1)
+                return {};
+            if (Misc::StringUtils::toLower(mesh[slashpos + 1]) != 'x' || !Misc::StringUtils::ciEndsWith(mesh, ".nif"))
+                return {};
+            std::string kfname(mesh);
+            kfname.replace(kfname.size() - 4, 4, ".kf");
+            return kfname;
+        }
+
         bool mIsExterior;
         ESM::ExteriorCellLocation mCellLocation;
         ESM::RefId mCellId;
@@ -155,11 +231,15 @@ namespace MWWorld
         Resource::SceneManager* mSceneManager;
         Resource::BulletShapeManager* mBulletShapeManager;
         Resource::KeyframeManager* mKeyframeManager;
+        MWPhysics::HeightFieldManager* mHeightFieldManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
+        ESM::SharedReaders* mReaders;
+        std::shared_ptr<CellStore::StagedRefs> mStagedRefs;
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
+        std::atomic<std::size_t> mResidentSize{ 0 };
 
         osg::ref_ptr<Terrain::View> mTerrainView;
 
@@ -181,6 +261,7 @@ namespace MWWorld
 
         void doWork() override
         {
+            OPENMW_TRACE_ZONE("CellPreloader::TerrainPreloadItem");
             for (unsigned int i = 0; i < mTerrainViews.size() && i < mPreloadPositions.size() && !mAbort; ++i)
             {
                 mTerrainViews[i]->reset();
@@ -212,7 +293,11 @@ namespace MWWorld
         {
         }
 
-        void doWork() override { mResourceSystem->updateCache(mReferenceTime); }
+        void doWork() override
+        {
+            OPENMW_TRACE_ZONE("CellPreloader::UpdateCacheItem");
+            mResourceSystem->updateCache(mReferenceTime);
+        }
 
     private:
         double mReferenceTime;
@@ -220,9 +305,11 @@ namespace MWWorld
     };
 
     CellPreloader::CellPreloader(Resource::ResourceSystem* resourceSystem,
-        Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager)
+        Resource::BulletShapeManager* bulletShapeManager, MWPhysics::HeightFieldManager* heightFieldManager,
+        Terrain::World* terrain, MWRender::LandManager* landManager)
         : mResourceSystem(resourceSystem)
         , mBulletShapeManager(bulletShapeManager)
+        , mHeightFieldManager(heightFieldManager)
         , mTerrain(terrain)
         , mLandManager(landManager)
         , mExpiryDelay(0.0)
@@ -237,7 +324,7 @@ namespace MWWorld
         clearAllTasks();
     }
 
-    void CellPreloader::preload(CellStore& cell, double timestamp)
+    void CellPreloader::preload(CellStore& cell, double timestamp, SceneUtil::WorkPriority priority)
     {
         if (!mWorkQueue)
         {
@@ -258,37 +345,56 @@ namespace MWWorld
             return;
         }
 
-        while (mPreloadCells.size() >= mMaxCacheSize)
+        while (mPreloadCells.size() >= mMaxCacheSize || (mMemoryBudget != 0 && mBytes >= mMemoryBudget))
         {
-            // throw out oldest cell to make room
-            PreloadMap::iterator oldestCell = mPreloadCells.begin();
-            double oldestTimestamp = std::numeric_limits<double>::max();
-            double threshold = 1.0; // seconds
-            for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            {
-                if (it->second.mTimeStamp < oldestTimestamp)
-                {
-                    oldestTimestamp = it->second.mTimeStamp;
-                    oldestCell = it;
-                }
-            }
-
-            if (oldestTimestamp + threshold < timestamp)
-            {
-                oldestCell->second.mWorkItem->abort();
-                mPreloadCells.erase(oldestCell);
-                ++mEvicted;
-            }
-            else
+            // throw out the most costly cell to make room
+            const PreloadMap::iterator candidate = findEvictionCandidate(timestamp);
+            if (candidate == mPreloadCells.end())
                 return;
+            ++mEvicted;
+            mEvictedBytes += candidate->second.mBytes;
+            removeCell(candidate);
         }
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
-            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
-        mWorkQueue->addWorkItem(item);
+            mResourceSystem->getKeyframeManager(), mHeightFieldManager, mTerrain, mLandManager, mReaders,
+            mPreloadInstances));
+        mWorkQueue->addWorkItem(item, priority);
 
-        mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
+        PreloadEntry& entry = mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item)).first->second;
+        if (cell.getCell()->isExterior())
+        {
+            entry.mPosition = ESM::indexToPosition(cell.getCell()->getExteriorCellLocation(), true);
+            entry.mWorldspace = cell.getCell()->getWorldSpace();
+        }
         ++mAdded;
+
+        std::vector<ESM::RefId> sounds;
+        ListSoundsVisitor visitor{ sounds };
+        cell.forEachConst(visitor);
+        MWBase::Environment::get().getSoundManager()->preloadSounds(sounds);
+    }
+
+    void CellPreloader::syncPreload(std::span<CellStore* const> cells, double timestamp, Loading::Listener& listener)
+    {
+        OPENMW_TRACE_ZONE("CellPreloader::syncPreload");
+        if (!mWorkQueue)
+            return;
+
+        std::vector<osg::ref_ptr<PreloadItem>> items;
+        for (CellStore* cell : cells)
+        {
+            if (mPreloadCells.contains(cell))
+                continue;
+            preload(*cell, timestamp, SceneUtil::WorkPriority::Urgent);
+            if (const auto found = mPreloadCells.find(cell); found != mPreloadCells.end())
+                items.push_back(found->second.mWorkItem);
+        }
+
+        constexpr std::chrono::milliseconds redrawInterval(16);
+        for (const osg::ref_ptr<PreloadItem>& item : items)
+            while (!item->waitTillDone(redrawInterval))
+                listener.redraw();
     }
 
     void CellPreloader::notifyLoaded(CellStore* cell)
@@ -296,13 +402,7 @@ namespace MWWorld
         PreloadMap::iterator found = mPreloadCells.find(cell);
         if (found != mPreloadCells.end())
         {
-            if (found->second.mWorkItem)
-            {
-                found->second.mWorkItem->abort();
-                found->second.mWorkItem = nullptr;
-            }
-
-            mPreloadCells.erase(found);
+            removeCell(found);
             ++mLoaded;
         }
     }
@@ -310,41 +410,53 @@ namespace MWWorld
     void CellPreloader::clear()
     {
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
+            it = removeCell(it);
+    }
+
+    void CellPreloader::updateCache(double timestamp)
+    {
+        OPENMW_TRACE_ZONE("CellPreloader::updateCache");
+        for (auto& [cell, entry] : mPreloadCells)
         {
-            if (it->second.mWorkItem)
+            if (entry.mBytes == 0 && entry.mWorkItem && entry.mWorkItem->isDone())
             {
-                it->second.mWorkItem->abort();
-                it->second.mWorkItem = nullptr;
+                entry.mBytes = entry.mWorkItem->getResidentSize();
+                mBytes += entry.mBytes;
+                mAddedBytes += entry.mBytes;
             }
-
-            mPreloadCells.erase(it++);
         }
-    }
 
-    void CellPreloader::updateCache(double timestamp)
-    {
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
             if (mPreloadCells.size() >= mMinCacheSize && it->second.mTimeStamp < timestamp - mExpiryDelay)
             {
-                if (it->second.mWorkItem)
-                {
-                    it->second.mWorkItem->abort();
-                    it->second.mWorkItem = nullptr;
-                }
-                mPreloadCells.erase(it++);
+                mExpiredBytes += it->second.mBytes;
+                it = removeCell(it);
                 ++mExpired;
             }
             else
                 ++it;
         }
 
+        if (mMemoryBudget != 0)
+        {
+            while (mBytes > mMemoryBudget && mPreloadCells.size() > mMinCacheSize)
+            {
+                const PreloadMap::iterator candidate = findEvictionCandidate(timestamp);
+                if (candidate == mPreloadCells.end())
+                    break;
+                ++mEvicted;
+                mEvictedBytes += candidate->second.mBytes;
+                removeCell(candidate);
+            }
+        }
+
         if (timestamp - mLastResourceCacheUpdate > 1.0 && (!mUpdateCacheItem || mUpdateCacheItem->isDone()))
         {
             // the resource cache is cleared from the worker thread so that we're not holding up the main thread with
             // delete operations
             mUpdateCacheItem = new UpdateCacheItem(mResourceSystem, timestamp);
-            mWorkQueue->addWorkItem(mUpdateCacheItem, true);
+            mWorkQueue->addWorkItem(mUpdateCacheItem, SceneUtil::WorkPriority::Urgent);
             mLastResourceCacheUpdate = timestamp;
         }
 
@@ -355,6 +467,12 @@ namespace MWWorld
         }
     }
 
+    void CellPreloader::setPredictedPosition(const osg::Vec3f& position, ESM::RefId worldspace)
+    {
+        mPredictedPosition = position;
+        mPredictedWorldspace = worldspace;
+    }
+
     void CellPreloader::setExpiryDelay(double expiryDelay)
     {
         mExpiryDelay = expiryDelay;
@@ -370,6 +488,11 @@ namespace MWWorld
         mWorkQueue = workQueue;
     }
 
+    void CellPreloader::setReaders(ESM::SharedReaders* readers)
+    {
+        mReaders = readers;
+    }
+
     void CellPreloader::syncTerrainLoad(Loading::Listener& listener)
     {
         if (mTerrainPreloadItem != nullptr && !mTerrainPreloadItem->isDone())
@@ -413,7 +536,7 @@ namespace MWWorld
             if (!positions.empty())
             {
                 mTerrainPreloadItem = new TerrainPreloadItem(mTerrainViews, mTerrain, positions);
-                mWorkQueue->addWorkItem(mTerrainPreloadItem);
+                mWorkQueue->addWorkItem(mTerrainPreloadItem, SceneUtil::WorkPriority::Visible);
             }
         }
     }
@@ -449,12 +572,57 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            it->second.mWorkItem->abort();
+            it->second.mWorkItem->cancel();
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
             it->second.mWorkItem->waitTillDone();
 
         mPreloadCells.clear();
+        mBytes = 0;
+    }
+
+    CellPreloader::PreloadMap::iterator CellPreloader::removeCell(PreloadMap::iterator it)
+    {
+        if (it->second.mWorkItem)
+        {
+            it->second.mWorkItem->cancel();
+            it->second.mWorkItem = nullptr;
+        }
+        mBytes -= it->second.mBytes;
+        return mPreloadCells.erase(it);
+    }
+
+    double CellPreloader::getEvictionCost(const PreloadEntry& entry) const
+    {
+        // Interior cells and cells of other worldspaces are preloaded only when the player can get there soon
+        double distance = 1;
+        if (entry.mPosition.has_value() && entry.mWorldspace == mPredictedWorldspace)
+        {
+            const osg::Vec2f predicted(mPredictedPosition.x(), mPredictedPosition.y());
+            distance = (*entry.mPosition - predicted).length() / ESM::getCellSize(entry.mWorldspace);
+        }
+        // Cells still being preloaded are evicted by distance only
+        return static_cast<double>(std::max<std::size_t>(entry.mBytes, 1)) * (1 + distance);
+    }
+
+    CellPreloader::PreloadMap::iterator CellPreloader::findEvictionCandidate(double timestamp)
+    {
+        // Don't throw out cells requested recently, they would be preloaded again right away
+        constexpr double threshold = 1.0; // seconds
+        PreloadMap::iterator result = mPreloadCells.end();
+        double maxCost = 0;
+        for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
+        {
+            if (it->second.mTimeStamp + threshold >= timestamp)
+                continue;
+            const double cost = getEvictionCost(it->second);
+            if (cost > maxCost)
+            {
+                maxCost = cost;
+                result = it;
+            }
+        }
+        return result;
     }
 
     void CellPreloader::reportStats(unsigned int frameNumber, osg::Stats& stats) const
@@ -464,5 +632,9 @@ namespace MWWorld
         stats.setAttribute(frameNumber, "CellPreloader Evicted", mEvicted);
         stats.setAttribute(frameNumber, "CellPreloader Loaded", mLoaded);
         stats.setAttribute(frameNumber, "CellPreloader Expired", mExpired);
+        stats.setAttribute(frameNumber, "CellPreloader Bytes", mBytes);
+        stats.setAttribute(frameNumber, "CellPreloader Added Bytes", mAddedBytes);
+        stats.setAttribute(frameNumber, "CellPreloader Evicted Bytes", mEvictedBytes);
+        stats.setAttribute(frameNumber, "CellPreloader Expired Bytes", mExpiredBytes);
     }
 }
@@ -3,11 +3,16 @@
 
 #include "positioncellgrid.hpp"
 
+#include <components/esm/refid.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
+#include <osg/Vec2f>
+#include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <span>
 
 namespace osg
@@ -32,26 +37,46 @@ namespace MWRender
     class LandManager;
 }
 
+namespace MWPhysics
+{
+    class HeightFieldManager;
+}
+
 namespace Loading
 {
     class Listener;
 }
 
+namespace ESM
+{
+    class SharedReaders;
+}
+
 namespace MWWorld
 {
     class CellStore;
+    class PreloadItem;
     class TerrainPreloadItem;
 
     class CellPreloader
     {
     public:
         CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager,
-            Terrain::World* terrain, MWRender::LandManager* landManager);
+            MWPhysics::HeightFieldManager* heightFieldManager, Terrain::World* terrain,
+            MWRender::LandManager* landManager);
         ~CellPreloader();
 
-        /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
+        /// Ask a background thread to preload rendering meshes and collision shapes for objects and terrain in this
+        /// cell.
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
-        void preload(MWWorld::CellStore& cell, double timestamp);
+        void preload(MWWorld::CellStore& cell, double timestamp,
+            SceneUtil::WorkPriority priority = SceneUtil::WorkPriority::Speculative);
+
+        /// Preload the cells that are not preloaded yet with the urgent priority and keep drawing the loading screen
+        /// until it's done, so loading them afterwards mostly takes the prepared meshes and shapes from the caches.
+        /// @note Cells that are already being preloaded are not waited for, their work may be queued behind
+        /// other speculative work.
+        void syncPreload(std::span<MWWorld::CellStore* const> cells, double timestamp, Loading::Listener& listener);
 
         void notifyLoaded(MWWorld::CellStore* cell);
 
@@ -69,6 +94,14 @@ namespace MWWorld
         /// The maximum number of preloaded cells.
         void setMaxCacheSize(std::size_t value) { mMaxCacheSize = value; }
 
+        /// The approximate number of bytes used by preloaded resources before the cells costing the most get thrown
+        /// out. The cost of a cell grows with its size and distance to the predicted player position. 0 disables the
+        /// limit.
+        void setMemoryBudget(std::size_t value) { mMemoryBudget = value; }
+
+        /// The position the player is expected to have soon, used to weight preloaded exterior cells.
+        void setPredictedPosition(const osg::Vec3f& position, ESM::RefId worldspace);
+
         /// Enables the creation of instances in the preloading thread.
         void setPreloadInstances(bool preload);
 
@@ -78,6 +111,9 @@ namespace MWWorld
 
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
 
+        /// Read the references of the preloaded cells from the content files on the worker threads too.
+        void setReaders(ESM::SharedReaders* readers);
+
         void setTerrainPreloadPositions(std::span<const PositionCellGrid> positions);
 
         void syncTerrainLoad(Loading::Listener& listener);
@@ -88,23 +124,9 @@ namespace MWWorld
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
 
     private:
-        void clearAllTasks();
-
-        Resource::ResourceSystem* mResourceSystem;
-        Resource::BulletShapeManager* mBulletShapeManager;
-        Terrain::World* mTerrain;
-        MWRender::LandManager* mLandManager;
-        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
-        double mExpiryDelay;
-        std::size_t mMinCacheSize = 0;
-        std::size_t mMaxCacheSize = 0;
-        bool mPreloadInstances;
-
-        double mLastResourceCacheUpdate;
-
         struct PreloadEntry
         {
-            PreloadEntry(double timestamp, osg::ref_ptr<SceneUtil::WorkItem> workItem)
+            PreloadEntry(double timestamp, osg::ref_ptr<PreloadItem> workItem)
                 : mTimeStamp(timestamp)
                 , mWorkItem(std::move(workItem))
             {
@@ -115,10 +137,41 @@ namespace MWWorld
             }
 
             double mTimeStamp;
-            osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+            osg::ref_ptr<PreloadItem> mWorkItem;
+            // Center of an exterior cell
+            std::optional<osg::Vec2f> mPosition;
+            ESM::RefId mWorldspace;
+            // Known once the work item is done
+            std::size_t mBytes = 0;
         };
+
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
+        void clearAllTasks();
+
+        PreloadMap::iterator removeCell(PreloadMap::iterator it);
+
+        double getEvictionCost(const PreloadEntry& entry) const;
+
+        PreloadMap::iterator findEvictionCandidate(double timestamp);
+
+        Resource::ResourceSystem* mResourceSystem;
+        Resource::BulletShapeManager* mBulletShapeManager;
+        MWPhysics::HeightFieldManager* mHeightFieldManager;
+        Terrain::World* mTerrain;
+        MWRender::LandManager* mLandManager;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        ESM::SharedReaders* mReaders = nullptr;
+        double mExpiryDelay;
+        std::size_t mMinCacheSize = 0;
+        std::size_t mMaxCacheSize = 0;
+        std::size_t mMemoryBudget = 0;
+        bool mPreloadInstances;
+        osg::Vec3f mPredictedPosition;
+        ESM::RefId mPredictedWorldspace;
+
+        double mLastResourceCacheUpdate;
+
         // Cells that are currently being preloaded, or have already finished preloading
         PreloadMap mPreloadCells;
 
@@ -133,6 +186,10 @@ namespace MWWorld
         std::size_t mAdded = 0;
         std::size_t mExpired = 0;
         std::size_t mLoaded = 0;
+        std::size_t mBytes = 0;
+        std::size_t mAddedBytes = 0;
+        std::size_t mEvictedBytes = 0;
+        std::size_t mExpiredBytes = 0;
     };
 
 }
@@ -84,7 +84,7 @@ namespace MWWorld
         return std::visit(
             ESM::VisitOverload{
                 [&](const ESM4::Reference& ref) { return ref.mDoor.destPos; },
-                [&](const ESM::CellRef& ref) -> ESM::Position { return ref.mDoorDest; },
+                [&](const ESM::CellRef& ref) -> ESM::Position { return ref.getDoorDest(); },
                 [&](const ESM4::ActorCharacter&) -> ESM::Position { throw std::logic_error("Not applicable"); },
             },
             mCellRef.mVariant);
@@ -93,13 +93,14 @@ namespace MWWorld
     ESM::RefId CellRef::getDestCell() const
     {
         auto esm3Visit = [&](const ESM::CellRef& ref) -> ESM::RefId {
-            if (!ref.mDestCell.empty())
+            if (!ref.getDestCell().empty())
             {
-                return ESM::RefId::stringRefId(ref.mDestCell);
+                return ESM::RefId::stringRefId(ref.getDestCell());
             }
             else
             {
-                const auto cellPos = ESM::positionToExteriorCellLocation(ref.mDoorDest.pos[0], ref.mDoorDest.pos[1]);
+                const ESM::Position& doorDest = ref.getDoorDest();
+                const auto cellPos = ESM::positionToExteriorCellLocation(doorDest.pos[0], doorDest.pos[1]);
                 return ESM::RefId::esm3ExteriorCell(cellPos.mX, cellPos.mY);
             }
         };
@@ -123,14 +124,14 @@ namespace MWWorld
         if (scale != getScale())
         {
             mChanged = true;
-            std::visit([scale](auto&& ref) { ref.mScale = scale; }, mCellRef.mVariant);
+            std::visit([scale](auto&& ref) { ESM::unbox(ref).mScale = scale; }, mCellRef.mVariant);
         }
     }
 
     void CellRef::setPosition(const ESM::Position& position)
     {
         mChanged = true;
-        std::visit([&position](auto&& ref) { ref.mPos = position; }, mCellRef.mVariant);
+        std::visit([&position](auto&& ref) { ESM::unbox(ref).mPos = position; }, mCellRef.mVariant);
     }
 
     float CellRef::getEnchantmentCharge() const
@@ -231,7 +232,7 @@ namespace MWWorld
         return std::visit(ESM::VisitOverload{
                               [&](const ESM4::Reference& /*ref*/) -> const std::string& { return emptyString; },
                               [&](const ESM4::ActorCharacter& /*ref*/) -> const std::string& { return emptyString; },
-                              [&](const ESM::CellRef& ref) -> const std::string& { return ref.mGlobalVariable; },
+                              [&](const ESM::CellRef& ref) -> const std::string& { return ref.getGlobalVariable(); },
                           },
             mCellRef.mVariant);
     }
@@ -244,7 +245,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter& /*ref*/) {},
-                           [&](ESM::CellRef& ref) { ref.mGlobalVariable.erase(); },
+                           [&](ESM::CellRef& ref) { ref.setGlobalVariable(std::string()); },
                        },
                 mCellRef.mVariant);
         }
@@ -256,7 +257,10 @@ namespace MWWorld
         {
             mChanged = true;
             std::visit(ESM::VisitOverload{
-                           [&](ESM4::ActorCharacter&) {}, [&](auto&& ref) { ref.mFactionRank = factionRank; } },
+                           [&](ESM4::Reference& ref) { ref.mFactionRank = factionRank; },
+                           [&](ESM4::ActorCharacter&) {},
+                           [&](ESM::CellRef& ref) { ref.setFactionRank(factionRank); },
+                       },
                 mCellRef.mVariant);
         }
     }
@@ -268,7 +272,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
-                           [&](ESM::CellRef& ref) { ref.mOwner = owner; },
+                           [&](ESM::CellRef& ref) { ref.setOwner(owner); },
                        },
                 mCellRef.mVariant);
         }
@@ -282,7 +286,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
-                           [&](ESM::CellRef& ref) { ref.mSoul = soul; },
+                           [&](ESM::CellRef& ref) { ref.setSoul(soul); },
                        },
                 mCellRef.mVariant);
         }
@@ -296,7 +300,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
-                           [&](ESM::CellRef& ref) { ref.mFaction = faction; },
+                           [&](ESM::CellRef& ref) { ref.setFaction(faction); },
                        },
                 mCellRef.mVariant);
         }
@@ -357,7 +361,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
-                           [&](ESM::CellRef& ref) { ref.mTrap = trap; },
+                           [&](ESM::CellRef& ref) { ref.setTrap(trap); },
                        },
                 mCellRef.mVariant);
         }
@@ -371,7 +375,7 @@ namespace MWWorld
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
-                           [&](ESM::CellRef& ref) { ref.mKey = key; },
+                           [&](ESM::CellRef& ref) { ref.setKey(key); },
                        },
                 mCellRef.mVariant);
         }
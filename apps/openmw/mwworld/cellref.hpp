@@ -59,7 +59,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                bool operator()(const ESM::CellRef& ref) { return ref.mTeleport; }
+                bool operator()(const ESM::CellRef& ref) { return ref.getTeleport(); }
                 bool operator()(const ESM4::Reference& ref) { return !ref.mDoor.destDoor.isZeroOrUnset(); }
                 bool operator()(const ESM4::ActorCharacter&) { throw std::logic_error("Not applicable"); }
             };
@@ -75,7 +75,7 @@ namespace MWWorld
         // Scale applied to mesh
         float getScale() const
         {
-            return std::visit([&](auto&& ref) { return ref.mScale; }, mCellRef.mVariant);
+            return std::visit([&](auto&& ref) { return ESM::unbox(ref).mScale; }, mCellRef.mVariant);
         }
         void setScale(float scale);
 
@@ -83,7 +83,8 @@ namespace MWWorld
         // Current position and rotation of the object is stored in RefData.
         const ESM::Position& getPosition() const
         {
-            return std::visit([](auto&& ref) -> const ESM::Position& { return ref.mPos; }, mCellRef.mVariant);
+            return std::visit(
+                [](auto&& ref) -> const ESM::Position& { return ESM::unbox(ref).mPos; }, mCellRef.mVariant);
         }
         void setPosition(const ESM::Position& position);
 
@@ -138,7 +139,11 @@ namespace MWWorld
         // The NPC that owns this object (and will get angry if you steal it)
         ESM::RefId getOwner() const
         {
-            return std::visit([](auto&& ref) -> ESM::RefId { return ref.mOwner; }, mCellRef.mVariant);
+            return std::visit(ESM::VisitOverload{
+                                  [](const ESM::CellRef& ref) -> ESM::RefId { return ref.getOwner(); },
+                                  [](auto&& ref) -> ESM::RefId { return ESM::unbox(ref).mOwner; },
+                              },
+                mCellRef.mVariant);
         }
         void setOwner(const ESM::RefId& owner);
 
@@ -154,7 +159,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.mSoul; }
+                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.getSoul(); }
                 ESM::RefId operator()(const ESM4::Reference& /*ref*/) { return ESM::RefId(); }
                 ESM::RefId operator()(const ESM4::ActorCharacter&) { throw std::logic_error("Not applicable"); }
             };
@@ -168,7 +173,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.mFaction; }
+                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.getFaction(); }
                 ESM::RefId operator()(const ESM4::Reference& /*ref*/) { return ESM::RefId(); }
                 ESM::RefId operator()(const ESM4::ActorCharacter& /*ref*/) { return ESM::RefId(); }
             };
@@ -182,7 +187,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                int operator()(const ESM::CellRef& ref) { return ref.mFactionRank; }
+                int operator()(const ESM::CellRef& ref) { return ref.getFactionRank(); }
                 int operator()(const ESM4::Reference& ref) { return ref.mFactionRank; }
                 int operator()(const ESM4::ActorCharacter&) { throw std::logic_error("Not applicable"); }
             };
@@ -212,7 +217,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.mKey; }
+                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.getKey(); }
                 ESM::RefId operator()(const ESM4::Reference& ref) { return ref.mKey; }
                 ESM::RefId operator()(const ESM4::ActorCharacter&) { throw std::logic_error("Not applicable"); }
             };
@@ -223,7 +228,7 @@ namespace MWWorld
         {
             struct Visitor
             {
-                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.mTrap; }
+                ESM::RefId operator()(const ESM::CellRef& ref) { return ref.getTrap(); }
                 ESM::RefId operator()(const ESM4::Reference& /*ref*/) { return ESM::RefId(); }
                 ESM::RefId operator()(const ESM4::ActorCharacter&) { throw std::logic_error("Not applicable"); }
             };
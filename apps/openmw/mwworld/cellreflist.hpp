@@ -1,7 +1,7 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
+#include <components/misc/chunkedlist.hpp>
 
 #include "livecellref.hpp"
 
@@ -12,11 +12,12 @@ namespace MWWorld
     };
 
     /// \brief Collection of references of one type
+    /// \note References never move in memory, so Ptr to them stay valid until the reference is removed.
     template <typename X>
     struct CellRefList : public CellRefListBase
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        typedef Misc::ChunkedList<LiveRef> List;
         List mList;
 
         /// Search for the given reference in the given reclist from
@@ -31,11 +32,7 @@ namespace MWWorld
         void load(const ESM4::Reference& ref, const MWWorld::ESMStore& esmStore);
         void load(const ESM4::ActorCharacter& ref, const MWWorld::ESMStore& esmStore);
 
-        LiveRef& insert(const LiveRef& item)
-        {
-            mList.push_back(item);
-            return mList.back();
-        }
+        LiveRef& insert(const LiveRef& item) { return mList.emplace_back(item); }
 
         /// Remove all references with the given refNum from this list.
         void remove(ESM::RefNum refNum)
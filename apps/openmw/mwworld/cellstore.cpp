@@ -16,6 +16,7 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/fogstate.hpp>
+#include <components/esm3/formatversion.hpp>
 #include <components/esm3/loadacti.hpp>
 #include <components/esm3/loadalch.hpp>
 #include <components/esm3/loadappa.hpp>
@@ -40,6 +41,7 @@
 #include <components/esm3/npcstate.hpp>
 #include <components/esm3/objectstate.hpp>
 #include <components/esm3/readerscache.hpp>
+#include <components/esm3/sharedreaders.hpp>
 
 #include <components/esm4/loadachr.hpp>
 #include <components/esm4/loadacti.hpp>
@@ -68,6 +70,7 @@
 #include <components/esm4/loadweap.hpp>
 #include <components/esm4/readerutils.hpp>
 
+#include <components/files/memorystream.hpp>
 #include <components/files/openfile.hpp>
 #include <components/misc/tuplehelpers.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -378,6 +381,14 @@ namespace MWWorld
 
             return true;
         }
+
+        struct FindCellCallback : CellStore::GetCellStoreCallback
+        {
+            CellStore* getCellStore(const ESM::RefId& cellId) override
+            {
+                return MWBase::Environment::get().getWorldModel()->findCell(cellId);
+            }
+        };
     }
 
     struct CellStoreImp
@@ -396,6 +407,13 @@ namespace MWWorld
             stores.mCellRefLists[storeIndex] = &refList;
         }
 
+        template <typename T>
+        static void addMemoryUsage(const CellRefList<T>& refList, CellStore::MemoryUsage& usage)
+        {
+            usage.mRefs += refList.mList.size();
+            usage.mBytes += refList.mList.size() * sizeof(typename CellRefList<T>::LiveRef);
+        }
+
         // listing only objects owned by this cell. Internal use only, you probably want to use forEach() so that moved
         // objects are accounted for.
         template <class Visitor>
@@ -418,7 +436,7 @@ namespace MWWorld
 
         if (const X* ptr = store.search(ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
+            typename List::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef(ref, ptr);
 
@@ -502,7 +520,7 @@ namespace MWWorld
         {
             mMovedHere.insert(std::make_pair(object.getBase(), from));
         }
-        requestMergedRefsUpdate();
+        addMergedRef(object.getBase());
     }
 
     MWWorld::Ptr CellStore::moveTo(const Ptr& object, CellStore* cellToMoveTo)
@@ -534,14 +552,14 @@ namespace MWWorld
                 originalCell->moveTo(object, cellToMoveTo);
             }
 
-            requestMergedRefsUpdate();
+            removeMergedRef(object.getBase());
             return MWWorld::Ptr(object.getBase(), cellToMoveTo);
         }
 
         cellToMoveTo->moveFrom(object, this);
         mMovedToAnotherCell.insert(std::make_pair(object.getBase(), cellToMoveTo));
 
-        requestMergedRefsUpdate();
+        removeMergedRef(object.getBase());
         return MWWorld::Ptr(object.getBase(), cellToMoveTo);
     }
 
@@ -583,13 +601,57 @@ namespace MWWorld
         mMergedRefsNeedsUpdate = true;
     }
 
+    void CellStore::addMergedRef(LiveCellRefBase* ref)
+    {
+        mRechargingItemsUpToDate = false;
+        if (!mMergedRefsNeedsUpdate)
+            mMergedRefsChanges.emplace_back(ref, true);
+    }
+
+    void CellStore::removeMergedRef(LiveCellRefBase* ref)
+    {
+        mRechargingItemsUpToDate = false;
+        if (!mMergedRefsNeedsUpdate)
+            mMergedRefsChanges.emplace_back(ref, false);
+    }
+
     void CellStore::updateMergedRefs() const
     {
-        mMergedRefs.clear();
-        MergeVisitor visitor(mMergedRefs, mMovedHere, mMovedToAnotherCell);
-        CellStoreImp::forEachInternal(visitor, const_cast<CellStore&>(*this));
-        visitor.merge();
-        mMergedRefsNeedsUpdate = false;
+        if (!mMergedRefsNeedsUpdate)
+        {
+            for (const auto& [ref, added] : mMergedRefsChanges)
+            {
+                if (added)
+                {
+                    if (mMergedRefIndices.emplace(ref, mMergedRefs.size()).second)
+                        mMergedRefs.push_back(ref);
+                }
+                else if (const auto it = mMergedRefIndices.find(ref); it != mMergedRefIndices.end())
+                {
+                    mMergedRefs[it->second] = nullptr;
+                    mMergedRefIndices.erase(it);
+                    ++mMergedRefsHoles;
+                }
+            }
+            mMergedRefsChanges.clear();
+            // Compact when more than a half are holes, this also leaves no holes when all refs are removed
+            if (mMergedRefsHoles * 2 <= mMergedRefs.size())
+                return;
+            std::erase(mMergedRefs, nullptr);
+        }
+        else
+        {
+            mMergedRefs.clear();
+            MergeVisitor visitor(mMergedRefs, mMovedHere, mMovedToAnotherCell);
+            CellStoreImp::forEachInternal(visitor, const_cast<CellStore&>(*this));
+            visitor.merge();
+            mMergedRefsChanges.clear();
+            mMergedRefsNeedsUpdate = false;
+        }
+        mMergedRefsHoles = 0;
+        mMergedRefIndices.clear();
+        for (std::size_t i = 0; i < mMergedRefs.size(); ++i)
+            mMergedRefIndices.emplace(mMergedRefs[i], i);
     }
 
     bool CellStore::movedHere(const MWWorld::Ptr& ptr) const
@@ -743,9 +805,16 @@ namespace MWWorld
 
     std::size_t CellStore::count() const
     {
-        if (mMergedRefsNeedsUpdate)
-            updateMergedRefs();
-        return mMergedRefs.size();
+        ensureMergedRefs();
+        return mMergedRefs.size() - mMergedRefsHoles;
+    }
+
+    CellStore::MemoryUsage CellStore::getMemoryUsage() const
+    {
+        MemoryUsage usage{ .mRefs = 0, .mBytes = sizeof(CellStore) };
+        std::apply([&](const auto&... x) { (CellStoreImp::addMemoryUsage(x, usage), ...); }, mCellStoreImp->mRefLists);
+        usage.mBytes += mMergedRefs.capacity() * sizeof(LiveCellRefBase*);
+        return usage;
     }
 
     void CellStore::load()
@@ -758,6 +827,9 @@ namespace MWWorld
             loadRefs();
 
             mState = State_Loaded;
+
+            if (mSavedReferences.has_value())
+                readSavedReferences();
         }
     }
 
@@ -765,6 +837,13 @@ namespace MWWorld
     {
         if (mState == State_Unloaded)
         {
+            // The listed ids wouldn't include the objects created in the saved game
+            if (mSavedReferences.has_value())
+            {
+                load();
+                return;
+            }
+
             listRefs();
 
             mState = State_Preloaded;
@@ -855,49 +934,100 @@ namespace MWWorld
         std::sort(mIds.begin(), mIds.end());
     }
 
-    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    std::shared_ptr<CellStore::StagedRefs> CellStore::stageRefs()
     {
+        if (mState == State_Loaded || mCellVariant.isEsm4())
+            return nullptr;
+
+        const ESM::Cell& cell = mCellVariant.getEsm3();
         if (cell.mContextList.empty())
-            return; // this is a dynamically generated cell -> skipping.
+            return nullptr;
 
-        // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < cell.mContextList.size(); i++)
+        if (mStagedRefs == nullptr)
+            mStagedRefs = std::make_shared<StagedRefs>(cell);
+        return mStagedRefs;
+    }
+
+    static void readRefs(const ESM::Cell& cell, ESM::ESMReader& reader, CellStore::ContentRefs& refs)
+    {
+        ESM::CellRef ref;
+        // Get each reference in turn
+        ESM::MovedCellRef cMRef;
+        bool deleted = false;
+        bool moved = false;
+        while (ESM::Cell::getNextRef(reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
         {
-            try
+            if (moved)
+                continue;
+
+            // Don't load reference if it was moved to a different cell.
+            ESM::MovedCellRefTracker::const_iterator iter
+                = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum);
+            if (iter != cell.mMovedRefs.end())
             {
-                // Reopen the ESM reader and seek to the right position.
-                const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
-                cell.restore(*reader, i);
+                continue;
+            }
 
-                ESM::CellRef ref;
-                // Get each reference in turn
-                ESM::MovedCellRef cMRef;
-                bool deleted = false;
-                bool moved = false;
-                while (ESM::Cell::getNextRef(
-                    *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
-                {
-                    if (moved)
-                        continue;
+            refs.emplace_back(ref, deleted);
+        }
+    }
 
-                    // Don't load reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter
-                        = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum);
-                    if (iter != cell.mMovedRefs.end())
-                    {
-                        continue;
-                    }
+    CellStore::ContentRefs CellStore::readContentRefs(const ESM::Cell& cell, ESM::SharedReaders& readers)
+    {
+        ContentRefs result;
+        ESM::SharedReaders::Reader reader(readers);
 
-                    loadRef(ref, deleted, refNumToID);
-                }
+        // Load references from all plugins that do something with this cell.
+        for (const ESM::ESM_Context& context : cell.mContextList)
+        {
+            try
+            {
+                readRefs(cell, reader.restore(context), result);
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription()
-                                  << ": " << e.what();
+                Log(Debug::Error) << "An error occurred loading references for cell " << cell.getDescription() << ": "
+                                  << e.what();
+            }
+        }
+
+        return result;
+    }
+
+    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    {
+        if (cell.mContextList.empty())
+            return; // this is a dynamically generated cell -> skipping.
+
+        // The worker thread keeps its own reference to the staged refs in case it is still reading them
+        const std::shared_ptr<StagedRefs> staged = std::move(mStagedRefs);
+        ContentRefs refs;
+        if (staged != nullptr && staged->mReady.load(std::memory_order_acquire))
+            refs = std::move(staged->mRefs);
+        else
+        {
+            // Load references from all plugins that do something with this cell.
+            for (size_t i = 0; i < cell.mContextList.size(); i++)
+            {
+                try
+                {
+                    // Reopen the ESM reader and seek to the right position.
+                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+                    const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                    cell.restore(*reader, i);
+                    readRefs(cell, *reader, refs);
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Error) << "An error occurred loading references for cell "
+                                      << getCell()->getDescription() << ": " << e.what();
+                }
             }
         }
+
+        for (auto& [ref, deleted] : refs)
+            loadRef(ref, deleted, refNumToID);
+
         // Load moved references, from separately tracked list.
         for (const auto& leasedRef : cell.mLeasedRefs)
         {
@@ -1163,6 +1293,51 @@ namespace MWWorld
         requestMergedRefsUpdate();
     }
 
+    void CellStore::deferReferences(SavedReferences&& references)
+    {
+        mHasState = true;
+        mSavedReferences = std::move(references);
+        if (mState == State_Loaded)
+            readSavedReferences();
+    }
+
+    bool CellStore::canWriteSavedReferences() const
+    {
+        if (!mSavedReferences.has_value() || mSavedReferences->mFormatVersion != ESM::CurrentSaveGameFormatVersion)
+            return false;
+        if (mSavedReferences->mContentFileMapping == nullptr)
+            return true;
+        const std::map<int, int>& mapping = *mSavedReferences->mContentFileMapping;
+        return std::all_of(mapping.begin(), mapping.end(), [](const auto& v) { return v.first == v.second; });
+    }
+
+    void CellStore::writeSavedReferences(ESM::ESMWriter& writer) const
+    {
+        writer.write(mSavedReferences->mData.data(), mSavedReferences->mData.size());
+    }
+
+    void CellStore::readSavedReferences()
+    {
+        const SavedReferences references = std::move(*mSavedReferences);
+        mSavedReferences.reset();
+
+        try
+        {
+            ESM::ESMReader reader;
+            reader.openRecordData(
+                std::make_unique<Files::IMemStream>(references.mData.data(), references.mData.size()),
+                references.mFileName, references.mFormatVersion);
+            reader.setContentFileMapping(references.mContentFileMapping.get());
+            FindCellCallback callback;
+            readReferences(reader, &callback);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to read saved references of cell " << mCellVariant.getId() << " from "
+                              << references.mFileName << ": " << e.what();
+        }
+    }
+
     void CellStore::setFog(std::unique_ptr<ESM::FogState>&& fog)
     {
         mFogState = std::move(fog);
@@ -1186,7 +1361,7 @@ namespace MWWorld
         }
     }
 
-    void CellStore::rest(double hours)
+    void CellStore::collectRestingActors(std::vector<Ptr>& actors)
     {
         if (mState == State_Loaded)
         {
@@ -1194,17 +1369,13 @@ namespace MWWorld
             {
                 Ptr ptr = getCurrentPtr(&creature);
                 if (!ptr.isEmpty() && ptr.getCellRef().getCount() > 0)
-                {
-                    MWBase::Environment::get().getMechanicsManager()->restoreDynamicStats(ptr, hours, true);
-                }
+                    actors.push_back(ptr);
             }
             for (MWWorld::LiveCellRef<ESM::NPC>& npc : get<ESM::NPC>().mList)
             {
                 Ptr ptr = getCurrentPtr(&npc);
                 if (!ptr.isEmpty() && ptr.getCellRef().getCount() > 0)
-                {
-                    MWBase::Environment::get().getMechanicsManager()->restoreDynamicStats(ptr, hours, true);
-                }
+                    actors.push_back(ptr);
             }
         }
     }
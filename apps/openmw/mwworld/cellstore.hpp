@@ -2,13 +2,18 @@
 #define GAME_MWWORLD_CELLSTORE_H
 
 #include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "cell.hpp"
@@ -17,6 +22,7 @@
 
 #include <components/esm/refid.hpp>
 #include <components/esm3/fogstate.hpp>
+#include <components/esm3/formatversion.hpp>
 #include <components/misc/tuplemeta.hpp>
 
 #include "ptr.hpp"
@@ -25,6 +31,7 @@
 namespace ESM
 {
     class ReadersCache;
+    class SharedReaders;
     struct Cell;
     struct CellState;
     struct FormId;
@@ -128,7 +135,8 @@ namespace MWWorld
         /// @return updated MWWorld::Ptr with the new CellStore pointer set.
         MWWorld::Ptr moveTo(const MWWorld::Ptr& object, MWWorld::CellStore* cellToMoveTo);
 
-        void rest(double hours);
+        /// Add the actors restoring their stats while the player is resting
+        void collectRestingActors(std::vector<Ptr>& actors);
         void recharge(float duration);
 
         /// Make a copy of the given object and insert it into this cell.
@@ -140,7 +148,7 @@ namespace MWWorld
             mHasState = true;
             CellRefList<T>& list = get<T>();
             LiveCellRefBase* ret = &list.insert(*ref);
-            requestMergedRefsUpdate();
+            addMergedRef(ret);
             return ret;
         }
 
@@ -200,6 +208,15 @@ namespace MWWorld
         std::size_t count() const;
         ///< Return total number of references, including deleted ones.
 
+        struct MemoryUsage
+        {
+            std::size_t mRefs = 0;
+            std::size_t mBytes = 0;
+        };
+
+        MemoryUsage getMemoryUsage() const;
+        ///< Approximate by the sizes of the stored references including deleted ones, the data they own is not counted.
+
         void load();
         ///< Load references from content file.
 
@@ -218,8 +235,7 @@ namespace MWWorld
             if (mState != State_Loaded)
                 return false;
 
-            if (mMergedRefsNeedsUpdate)
-                updateMergedRefs();
+            ensureMergedRefs();
             if (mMergedRefs.empty())
                 return true;
 
@@ -227,7 +243,7 @@ namespace MWWorld
 
             for (LiveCellRefBase* mergedRef : mMergedRefs)
             {
-                if (!isAccessible(mergedRef->mData, mergedRef->mRef))
+                if (mergedRef == nullptr || !isAccessible(mergedRef->mData, mergedRef->mRef))
                     continue;
 
                 if (!visitor(MWWorld::Ptr(mergedRef, this)))
@@ -247,12 +263,11 @@ namespace MWWorld
             if (mState != State_Loaded)
                 return false;
 
-            if (mMergedRefsNeedsUpdate)
-                updateMergedRefs();
+            ensureMergedRefs();
 
             for (const LiveCellRefBase* mergedRef : mMergedRefs)
             {
-                if (!isAccessible(mergedRef->mData, mergedRef->mRef))
+                if (mergedRef == nullptr || !isAccessible(mergedRef->mData, mergedRef->mRef))
                     continue;
 
                 if (!visitor(MWWorld::ConstPtr(mergedRef, this)))
@@ -272,8 +287,7 @@ namespace MWWorld
             if (mState != State_Loaded)
                 return false;
 
-            if (mMergedRefsNeedsUpdate)
-                updateMergedRefs();
+            ensureMergedRefs();
             if (mMergedRefs.empty())
                 return true;
 
@@ -336,6 +350,48 @@ namespace MWWorld
         /// references)
         void readReferences(ESM::ESMReader& reader, GetCellStoreCallback* callback);
 
+        struct SavedReferences
+        {
+            std::vector<char> mData;
+            std::filesystem::path mFileName;
+            ESM::FormatVersion mFormatVersion;
+            std::shared_ptr<const std::map<int, int>> mContentFileMapping;
+        };
+
+        /// Defers reading of the references of a saved game until the cell is loaded. They are read right away if
+        /// the cell is already loaded.
+        void deferReferences(SavedReferences&& references);
+
+        /// Returns true if the deferred references were not read yet and can be saved again as they are
+        bool canWriteSavedReferences() const;
+
+        void writeSavedReferences(ESM::ESMWriter& writer) const;
+
+        /// References of an ESM3 cell as stored in the content files, without the ones moved to other cells.
+        using ContentRefs = std::vector<std::pair<ESM::CellRef, bool>>;
+
+        /// References read by a worker thread ahead of load(), see stageRefs().
+        struct StagedRefs
+        {
+            explicit StagedRefs(const ESM::Cell& cell)
+                : mCell(cell)
+            {
+            }
+
+            const ESM::Cell& mCell;
+            ContentRefs mRefs;
+            std::atomic<bool> mReady{ false };
+        };
+
+        /// Create the structure for a worker thread to read the references of this cell into with readContentRefs().
+        /// The next load() adopts the references if the worker is done by then and reads them itself otherwise. To be
+        /// called from the main thread.
+        /// @return nullptr if the cell is loaded already or has no references in the content files.
+        std::shared_ptr<StagedRefs> stageRefs();
+
+        /// Read the references of the cell from the content files. Thread safe.
+        static ContentRefs readContentRefs(const ESM::Cell& cell, ESM::SharedReaders& readers);
+
         void respawn();
         ///< Check mLastRespawn and respawn references if necessary. This is a no-op if the cell is not loaded.
 
@@ -359,6 +415,8 @@ namespace MWWorld
         bool mHasState;
         std::vector<ESM::RefId> mIds;
         float mWaterLevel;
+        std::optional<SavedReferences> mSavedReferences;
+        std::shared_ptr<StagedRefs> mStagedRefs;
 
         MWWorld::TimeStamp mLastRespawn;
 
@@ -394,8 +452,14 @@ namespace MWWorld
         MovedRefTracker mMovedToAnotherCell;
 
         // Merged list of ref's currently in this cell - i.e. with added refs from mMovedHere, removed refs from
-        // mMovedToAnotherCell
+        // mMovedToAnotherCell. Removed refs leave nullptr until there are too many of them.
         mutable std::vector<LiveCellRefBase*> mMergedRefs;
+        // Positions of the refs in mMergedRefs
+        mutable std::unordered_map<const LiveCellRefBase*, std::size_t> mMergedRefIndices;
+        mutable std::size_t mMergedRefsHoles = 0;
+        // Refs added (true) or removed (false) since the last update, applied on the next iteration over the cell so
+        // the visitors keep iterating over the same list when they move objects
+        mutable std::vector<std::pair<LiveCellRefBase*, bool>> mMergedRefsChanges;
         mutable bool mMergedRefsNeedsUpdate = false;
 
         // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
@@ -408,6 +472,16 @@ namespace MWWorld
         void requestMergedRefsUpdate();
         void updateMergedRefs() const;
 
+        /// Update mMergedRefs with only the given ref instead of repopulating it.
+        void addMergedRef(LiveCellRefBase* ref);
+        void removeMergedRef(LiveCellRefBase* ref);
+
+        void ensureMergedRefs() const
+        {
+            if (mMergedRefsNeedsUpdate || !mMergedRefsChanges.empty())
+                updateMergedRefs();
+        }
+
         // (item, max charge)
         typedef std::vector<std::pair<LiveCellRefBase*, float>> TRechargingItems;
         TRechargingItems mRechargingItems;
@@ -428,6 +502,8 @@ namespace MWWorld
 
         void loadRefs();
 
+        void readSavedReferences();
+
         void loadRef(const ESM4::Reference& ref);
         void loadRef(const ESM4::ActorCharacter& ref);
         void loadRef(ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID);
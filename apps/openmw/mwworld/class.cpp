@@ -500,6 +500,13 @@ namespace MWWorld
         return ESM::RefId();
     }
 
+    void Class::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& out) const
+    {
+        ESM::RefId sound = getSound(ptr);
+        if (!sound.empty())
+            out.push_back(std::move(sound));
+    }
+
     int Class::getBaseFightRating(const ConstPtr& ptr) const
     {
         throw std::runtime_error("class does not support fight rating");
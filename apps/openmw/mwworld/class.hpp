@@ -368,6 +368,9 @@ namespace MWWorld
         /// Returns sound id
         virtual ESM::RefId getSound(const MWWorld::ConstPtr& ptr) const;
 
+        /// Adds ids of the sounds the object may play to \a out
+        virtual void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& out) const;
+
         virtual int getBaseFightRating(const MWWorld::ConstPtr& ptr) const;
 
         virtual ESM::RefId getPrimaryFaction(const MWWorld::ConstPtr& ptr) const;
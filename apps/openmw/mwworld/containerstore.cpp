@@ -57,24 +57,6 @@ namespace
 
         return sum;
     }
-
-    template <typename T>
-    MWWorld::Ptr searchId(MWWorld::CellRefList<T>& list, const ESM::RefId& id, MWWorld::ContainerStore* store)
-    {
-        store->resolve();
-
-        for (MWWorld::LiveCellRef<T>& liveCellRef : list.mList)
-        {
-            if ((liveCellRef.mBase->mId == id) && liveCellRef.mRef.getCount())
-            {
-                MWWorld::Ptr ptr(&liveCellRef, nullptr);
-                ptr.setContainerStore(store);
-                return ptr;
-            }
-        }
-
-        return MWWorld::Ptr();
-    }
 }
 
 MWWorld::ResolutionListener::~ResolutionListener()
@@ -105,6 +87,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getState(
     ref.load(state);
     collection.mList.push_back(ref);
     auto it = ContainerStoreIterator(this, --collection.mList.end());
+    addToItemIndex(it);
     MWBase::Environment::get().getWorldModel()->registerPtr(*it);
 
     return it;
@@ -190,12 +173,51 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::end()
 int MWWorld::ContainerStore::count(const ESM::RefId& id) const
 {
     int total = 0;
-    for (const auto&& iter : *this)
-        if (iter.getCellRef().getRefId() == id)
-            total += iter.getCellRef().getCount();
+    for (const ContainerStoreIterator& iter : getItems(id))
+        total += iter->getCellRef().getCount();
     return total;
 }
 
+template <typename T>
+void MWWorld::ContainerStore::indexItems(CellRefList<T>& collection)
+{
+    for (auto it = collection.mList.begin(); it != collection.mList.end(); ++it)
+        mItemIndex.mItems[it->mBase->mId].push_back(ContainerStoreIterator(this, it));
+}
+
+void MWWorld::ContainerStore::addToItemIndex(const ContainerStoreIterator& it)
+{
+    if (mItemIndex.mUpToDate)
+        mItemIndex.mItems[it->getCellRef().getRefId()].push_back(it);
+}
+
+std::span<const MWWorld::ContainerStoreIterator> MWWorld::ContainerStore::getItems(const ESM::RefId& id) const
+{
+    if (!mItemIndex.mUpToDate)
+    {
+        // The index gives mutable access to the items only through the non-const members
+        ContainerStore& store = const_cast<ContainerStore&>(*this);
+        mItemIndex.mItems.clear();
+        store.indexItems(store.potions);
+        store.indexItems(store.appas);
+        store.indexItems(store.armors);
+        store.indexItems(store.books);
+        store.indexItems(store.clothes);
+        store.indexItems(store.ingreds);
+        store.indexItems(store.lights);
+        store.indexItems(store.lockpicks);
+        store.indexItems(store.miscItems);
+        store.indexItems(store.probes);
+        store.indexItems(store.repairs);
+        store.indexItems(store.weapons);
+        mItemIndex.mUpToDate = true;
+    }
+    const auto it = mItemIndex.mItems.find(id);
+    if (it == mItemIndex.mItems.end())
+        return {};
+    return it->second;
+}
+
 void MWWorld::ContainerStore::updateRefNums()
 {
     for (const auto& iter : *this)
@@ -241,9 +263,10 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
 {
     resolve();
     MWWorld::ContainerStoreIterator retval = end();
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    const std::span<const ContainerStoreIterator> items = getItems(item.getCellRef().getRefId());
+    for (const ContainerStoreIterator& iter : items)
     {
-        if (item == *iter)
+        if (iter->getCellRef().getCount() != 0 && item == *iter)
         {
             retval = iter;
             break;
@@ -253,9 +276,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
     if (retval == end())
         throw std::runtime_error("item is not from this container");
 
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    for (const ContainerStoreIterator& iter : items)
     {
-        if (stacks(*iter, item))
+        if (iter->getCellRef().getCount() != 0 && stacks(*iter, item))
         {
             iter->getCellRef().setCount(
                 addItems(iter->getCellRef().getCount(false), item.getCellRef().getCount(false)));
@@ -378,8 +401,6 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
 {
     if (markModified)
         resolve();
-    int type = getType(ptr);
-
     const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
 
     // gold needs special handling: when it is inserted into a container, the base object automatically becomes Gold_001
@@ -391,9 +412,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
     // world and picks it up again. We just turn it into gold_001 here and ignore that oddity.
     if (ptr.getClass().isGold(ptr))
     {
-        for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+        for (const ContainerStoreIterator& iter : getItems(MWWorld::ContainerStore::sGoldId))
         {
-            if (iter->getCellRef().getRefId() == MWWorld::ContainerStore::sGoldId)
+            if (iter->getCellRef().getCount() != 0)
             {
                 iter->getCellRef().setCount(addItems(iter->getCellRef().getCount(false), count));
                 flagAsModified();
@@ -405,9 +426,12 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
         return addNewStack(ref.getPtr(), count);
     }
 
-    // determine whether to stack or not
-    for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+    // determine whether to stack or not, only an item with the same id can stack
+    for (const ContainerStoreIterator& iter : getItems(ptr.getCellRef().getRefId()))
     {
+        if (iter->getCellRef().getCount() == 0)
+            continue;
+
         // Don't stack with equipped items
         if (auto* inventoryStore = dynamic_cast<InventoryStore*>(this))
             if (inventoryStore->isEquipped(*iter))
@@ -483,6 +507,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack(const Const
     }
 
     it->getCellRef().setCount(count);
+    addToItemIndex(it);
 
     flagAsModified();
     return it;
@@ -536,9 +561,12 @@ int MWWorld::ContainerStore::remove(const ESM::RefId& itemId, int count, bool eq
         resolve();
     int toRemove = count;
 
-    for (ContainerStoreIterator iter(begin()); iter != end() && toRemove > 0; ++iter)
-        if (iter->getCellRef().getRefId() == itemId)
-            toRemove -= remove(*iter, toRemove, equipReplacement, resolveFirst);
+    // Removing may add new stacks of the item, for example when unequipping a part of a stack
+    const std::span<const ContainerStoreIterator> items = getItems(itemId);
+    const std::vector<ContainerStoreIterator> candidates(items.begin(), items.end());
+    for (auto iter = candidates.begin(); iter != candidates.end() && toRemove > 0; ++iter)
+        if ((*iter)->getCellRef().getCount() != 0)
+            toRemove -= remove(**iter, toRemove, equipReplacement, resolveFirst);
 
     flagAsModified();
 
@@ -812,18 +840,18 @@ MWWorld::Ptr MWWorld::ContainerStore::findReplacement(const ESM::RefId& id)
 {
     MWWorld::Ptr item;
     int itemHealth = 1;
-    for (auto&& iter : *this)
+    for (const ContainerStoreIterator& it : getItems(id))
     {
+        if (it->getCellRef().getCount() == 0)
+            continue;
+        const Ptr iter = *it;
         int iterHealth = iter.getClass().hasItemHealth(iter) ? iter.getClass().getItemHealth(iter) : 1;
-        if (iter.getCellRef().getRefId() == id)
+        // Prefer the stack with the lowest remaining uses
+        // Try to get item with zero durability only if there are no other items found
+        if (item.isEmpty() || (iterHealth > 0 && iterHealth < itemHealth) || (itemHealth <= 0 && iterHealth > 0))
         {
-            // Prefer the stack with the lowest remaining uses
-            // Try to get item with zero durability only if there are no other items found
-            if (item.isEmpty() || (iterHealth > 0 && iterHealth < itemHealth) || (itemHealth <= 0 && iterHealth > 0))
-            {
-                item = iter;
-                itemHealth = iterHealth;
-            }
+            item = iter;
+            itemHealth = iterHealth;
         }
     }
 
@@ -833,78 +861,9 @@ MWWorld::Ptr MWWorld::ContainerStore::findReplacement(const ESM::RefId& id)
 MWWorld::Ptr MWWorld::ContainerStore::search(const ESM::RefId& id)
 {
     resolve();
-    {
-        Ptr ptr = searchId(potions, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(appas, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(armors, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(books, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(clothes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(ingreds, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(lights, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(lockpicks, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(miscItems, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(probes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(repairs, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId(weapons, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
+    for (const ContainerStoreIterator& iter : getItems(id))
+        if (iter->getCellRef().getCount() != 0)
+            return *iter;
     return Ptr();
 }
 
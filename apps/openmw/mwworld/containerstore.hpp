@@ -4,7 +4,10 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <span>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/esm3/loadalch.hpp>
 #include <components/esm3/loadappa.hpp>
@@ -142,6 +145,28 @@ namespace MWWorld
         mutable float mCachedWeight;
         mutable bool mWeightUpToDate;
 
+        // All items by id in the order of iteration, including the ones with zero count which can be restored.
+        // The lists only grow, so the index is built once and then extended by the new stacks.
+        struct ItemIndex
+        {
+            std::unordered_map<ESM::RefId, std::vector<ContainerStoreIterator>> mItems;
+            bool mUpToDate = false;
+
+            ItemIndex() = default;
+
+            // The iterators can't be used with a copy of the store
+            ItemIndex(const ItemIndex& /*other*/) {}
+
+            ItemIndex& operator=(const ItemIndex& /*other*/)
+            {
+                mItems.clear();
+                mUpToDate = false;
+                return *this;
+            }
+        };
+
+        mutable ItemIndex mItemIndex;
+
         bool mModified;
         bool mResolved;
         unsigned int mSeed;
@@ -166,6 +191,14 @@ namespace MWWorld
 
         void updateRechargingItems();
 
+        template <typename T>
+        void indexItems(CellRefList<T>& collection);
+
+        void addToItemIndex(const ContainerStoreIterator& it);
+
+        std::span<const ContainerStoreIterator> getItems(const ESM::RefId& id) const;
+        ///< @return Items with refID \a id, including the ones with zero count.
+
         virtual void storeEquipmentState(
             const MWWorld::LiveCellRefBase& ref, size_t index, ESM::InventoryState& inventory) const;
 
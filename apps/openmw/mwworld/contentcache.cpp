@@ -0,0 +1,118 @@
+#include "contentcache.hpp"
+
+#include "esmstore.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/openfile.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+#include <components/version/version.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace MWWorld
+{
+    namespace
+    {
+        constexpr std::string_view author = "OpenMW content cache";
+
+        std::string getKeyHash(std::string_view key)
+        {
+            std::istringstream stream{ std::string(key) };
+            const std::array<std::uint64_t, 2> hash = Files::getHash("content cache key", stream);
+            std::ostringstream result;
+            result << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+            return result.str();
+        }
+    }
+
+    std::string makeContentCacheKey(
+        const std::vector<std::filesystem::path>& contentFiles, ToUTF8::Utf8Encoder* encoder)
+    {
+        std::ostringstream key;
+        key << Version::getOpenmwVersionDescription() << '\n';
+
+        // Record strings are converted to UTF-8 on reading so the encoding affects the result
+        if (encoder != nullptr)
+        {
+            std::string legacyChars;
+            for (int c = 0x80; c <= 0xFF; ++c)
+                legacyChars.push_back(static_cast<char>(c));
+            key << encoder->getUtf8(legacyChars) << '\n';
+        }
+
+        for (const std::filesystem::path& file : contentFiles)
+        {
+            key << Files::pathToUnicodeString(file) << ' ' << std::filesystem::file_size(file) << ' '
+                << std::filesystem::last_write_time(file).time_since_epoch().count() << '\n';
+        }
+
+        return key.str();
+    }
+
+    bool readContentCache(const std::filesystem::path& path, std::string_view key, ESMStore& store)
+    {
+        if (!std::filesystem::exists(path))
+            return false;
+
+        try
+        {
+            ESM::ESMReader reader;
+            reader.open(path);
+            if (reader.getAuthor() != author || reader.getDesc() != getKeyHash(key))
+            {
+                Log(Debug::Info) << "Content cache " << path << " is outdated";
+                return false;
+            }
+            store.readContentCache(reader);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read content cache " << path << ": " << e.what();
+            return false;
+        }
+
+        Log(Debug::Info) << "Loaded content cache " << path;
+        return true;
+    }
+
+    void writeContentCache(const std::filesystem::path& path, std::string_view key, const ESMStore& store)
+    {
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                stream.exceptions(std::ios::badbit | std::ios::failbit);
+
+                ESM::ESMWriter writer;
+                writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+                writer.setAuthor(author);
+                writer.setDescription(getKeyHash(key));
+                writer.save(stream);
+                store.writeContentCache(writer);
+                writer.close();
+            }
+
+            // Replace the previous cache only when the new one is complete
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write content cache " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+
+        Log(Debug::Info) << "Written content cache " << path;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef OPENMW_MWWORLD_CONTENTCACHE_H
+#define OPENMW_MWWORLD_CONTENTCACHE_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// Identifies the content files, their versions on the disk and the engine build the cache is valid for.
+    std::string makeContentCacheKey(
+        const std::vector<std::filesystem::path>& contentFiles, ToUTF8::Utf8Encoder* encoder);
+
+    /// Read records written by writeContentCache into the store if the cache exists and matches the key.
+    /// @return true when the records have been read.
+    bool readContentCache(const std::filesystem::path& path, std::string_view key, ESMStore& store);
+
+    /// Write the records loaded from the content files which can be restored without reading the content files.
+    void writeContentCache(const std::filesystem::path& path, std::string_view key, const ESMStore& store);
+}
+
+#endif
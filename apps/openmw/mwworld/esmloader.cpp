@@ -3,6 +3,7 @@
 
 #include <fstream>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
@@ -11,6 +12,7 @@
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -28,6 +30,67 @@ namespace MWWorld
     {
     }
 
+    EsmLoader::~EsmLoader()
+    {
+        mStop = true;
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void EsmLoader::prepare(std::vector<std::pair<std::filesystem::path, int>> files, std::size_t threads)
+    {
+        if (threads == 0 || !mThreads.empty())
+            return;
+
+        mPreparedFiles.reserve(files.size());
+        for (auto& [path, index] : files)
+        {
+            PreparedFile& file = mPreparedFiles.emplace_back(PreparedFile{ std::move(path), index, {} });
+            mPrepared.emplace(index, file.mRecords.get_future());
+        }
+
+        threads = std::min(threads, mPreparedFiles.size());
+        mThreads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            mThreads.emplace_back([this] { prepareFiles(); });
+    }
+
+    void EsmLoader::prepareFiles()
+    {
+        // Every thread needs its own encoder because it has an internal buffer
+        std::optional<ToUTF8::Utf8Encoder> encoder;
+        if (mEncoder != nullptr)
+            encoder.emplace(*mEncoder);
+
+        while (!mStop)
+        {
+            const std::size_t next = mNextPreparedFile++;
+            if (next >= mPreparedFiles.size())
+                break;
+
+            PreparedFile& file = mPreparedFiles[next];
+            try
+            {
+                PendingRecords records;
+                auto stream = Files::openBinaryInputFileStream(file.mPath);
+                if (ESM::readFormat(*stream) == ESM::Format::Tes3)
+                {
+                    stream->seekg(0);
+                    ESM::ESMReader reader;
+                    reader.setEncoder(encoder.has_value() ? &*encoder : nullptr);
+                    reader.setIndex(file.mIndex);
+                    reader.open(std::move(stream), file.mPath);
+                    records = mStore.parse(reader);
+                }
+                file.mRecords.set_value(std::move(records));
+            }
+            catch (...)
+            {
+                file.mRecords.set_exception(std::current_exception());
+            }
+        }
+    }
+
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
 
@@ -54,7 +117,24 @@ namespace MWWorld
                   "Please run the launcher to fix this issue.");
 
                 mESMVersions[index] = reader->getVer();
-                mStore.load(*reader, listener, mDialogue);
+
+                std::optional<PendingRecords> pending;
+                if (const auto it = mPrepared.find(index); it != mPrepared.end())
+                {
+                    try
+                    {
+                        pending = it->second.get();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        Log(Debug::Warning) << "Failed to read content file " << filepath
+                                            << " ahead of time, reading it sequentially: " << e.what();
+                    }
+                    mPrepared.erase(it);
+                }
+
+                mStore.load(
+                    *reader, listener, mDialogue, pending.has_value() ? &*pending : nullptr, mSkipIndependentRecords);
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
@@ -69,6 +149,8 @@ namespace MWWorld
                     mEncoder != nullptr ? &mEncoder->getStatelessEncoder() : nullptr);
                 reader.setModIndex(index);
                 reader.updateModIndices(mNameToIndex);
+                reader.inflateAhead(Files::openBinaryInputFileStream(filepath),
+                    [this](std::uint32_t typeId) { return mStore.hasESM4Store(typeId); });
                 mStore.loadESM4(reader);
                 break;
             }
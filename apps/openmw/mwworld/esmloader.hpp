@@ -1,8 +1,13 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <atomic>
+#include <future>
 #include <map>
+#include <memory>
 #include <optional>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "contentloader.hpp"
@@ -22,17 +27,36 @@ namespace MWWorld
 {
 
     class ESMStore;
+    struct PendingRecord;
 
     struct EsmLoader : public ContentLoader
     {
         explicit EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
             std::vector<int>& esmVersions);
 
+        ~EsmLoader();
+
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        /// Start reading the given content files on the background threads. Records which don't depend on the
+        /// store contents are read ahead of time, load then only inserts them into the store in the load order.
+        void prepare(std::vector<std::pair<std::filesystem::path, int>> files, std::size_t threads);
+
+        /// Skip records which can be read independently from the store contents because they are already loaded.
+        void setSkipIndependentRecords(bool value) { mSkipIndependentRecords = value; }
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        using PendingRecords = std::vector<std::unique_ptr<PendingRecord>>;
+
+        struct PreparedFile
+        {
+            std::filesystem::path mPath;
+            int mIndex;
+            std::promise<PendingRecords> mRecords;
+        };
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
@@ -40,6 +64,14 @@ namespace MWWorld
         std::optional<int> mMasterFileFormat;
         std::vector<int>& mESMVersions;
         std::map<std::string, int> mNameToIndex;
+        bool mSkipIndependentRecords = false;
+        std::vector<PreparedFile> mPreparedFiles;
+        std::map<int, std::future<PendingRecords>> mPrepared;
+        std::atomic_size_t mNextPreparedFile{ 0 };
+        std::atomic_bool mStop{ false };
+        std::vector<std::thread> mThreads;
+
+        void prepareFiles();
     };
 
 } /* namespace MWWorld */
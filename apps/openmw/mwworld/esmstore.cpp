@@ -14,10 +14,13 @@
 #include <components/esm4/reader.hpp>
 #include <components/esm4/readerutils.hpp>
 #include <components/esmloader/load.hpp>
+#include <components/files/conversion.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/lua/configuration.hpp>
 #include <components/misc/algorithm.hpp>
 
+#include <osg/Stats>
+
 #include "../mwmechanics/spelllist.hpp"
 
 namespace
@@ -54,8 +57,8 @@ namespace
                 else if (std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum)
                     == cell.mMovedRefs.end())
                 {
-                    if (!ref.mKey.empty())
-                        keyIDs.insert(std::move(ref.mKey));
+                    if (!ref.getKey().empty())
+                        keyIDs.insert(ref.getKey());
                     refs.emplace_back(ref.mRefNum, refIDs.size());
                     refIDs.push_back(std::move(ref.mRefID));
                 }
@@ -67,8 +70,8 @@ namespace
                 refs.emplace_back(value.mRefNum, deletedRefID);
             else
             {
-                if (!value.mKey.empty())
-                    keyIDs.insert(std::move(value.mKey));
+                if (!value.getKey().empty())
+                    keyIDs.insert(value.getKey());
                 refs.emplace_back(value.mRefNum, refIDs.size());
                 refIDs.push_back(value.mRefID);
             }
@@ -241,6 +244,20 @@ namespace MWWorld
         IDMap mIds;
         IDMap mStaticIds;
 
+        struct RecordStats
+        {
+            std::size_t mRecords = 0;
+            std::size_t mBytes = 0;
+        };
+
+        template <typename T>
+        static void addRecordStats(const Store<T>& store, RecordStats& stats)
+        {
+            const std::size_t size = static_cast<std::size_t>(store.getSize());
+            stats.mRecords += size;
+            stats.mBytes += size * sizeof(T);
+        }
+
         template <typename T>
         static void assignStoreToIndex(ESMStore& stores, Store<T>& store)
         {
@@ -290,6 +307,17 @@ namespace MWWorld
             return std::apply(
                 [&reader](auto&... x) { return (typedReadRecordESM4(reader, x) || ...); }, store.mStoreImp->mStores);
         }
+
+        template <typename T>
+        static bool isESM4Store(const Store<T>& /*store*/, ESM::RecNameInts recName)
+        {
+            if constexpr (HasRecordId<T>::value)
+            {
+                if constexpr (ESM::isESM4Rec(T::sRecordId))
+                    return T::sRecordId == recName;
+            }
+            return false;
+        }
     };
 
     int ESMStore::find(const ESM::RefId& id) const
@@ -386,16 +414,57 @@ namespace MWWorld
         return false;
     }
 
-    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+    std::vector<std::unique_ptr<PendingRecord>> ESMStore::parse(ESM::ESMReader& esm)
+    {
+        std::vector<std::unique_ptr<PendingRecord>> result;
+
+        while (esm.hasMoreRecs())
+        {
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+
+            std::unique_ptr<PendingRecord>& pending = result.emplace_back();
+            if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            const auto it = mStoreImp->mRecNameToStore.find(static_cast<ESM::RecNameInts>(n.toInt()));
+            if (it != mStoreImp->mRecNameToStore.end())
+                pending = it->second->parse(esm);
+
+            if (pending == nullptr)
+                esm.skipRecord();
+        }
+
+        return result;
+    }
+
+    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+        std::vector<std::unique_ptr<PendingRecord>>* pending, bool skipIndependentRecords)
     {
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
 
+        std::size_t recordIndex = 0;
+
         // Loop through all records
         while (esm.hasMoreRecs())
         {
             ESM::NAME n = esm.getRecName();
             esm.getRecHeader();
+
+            std::unique_ptr<PendingRecord> pendingRecord;
+            if (pending != nullptr)
+            {
+                if (recordIndex >= pending->size())
+                    throw std::logic_error(
+                        "Pending records do not match content file " + Files::pathToUnicodeString(esm.getName()));
+                pendingRecord = std::move((*pending)[recordIndex]);
+            }
+            ++recordIndex;
+
             if (esm.getRecordFlags() & ESM::FLAG_Ignored)
             {
                 esm.skipRecord();
@@ -406,7 +475,25 @@ namespace MWWorld
             ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
             const auto& it = mStoreImp->mRecNameToStore.find(recName);
 
-            if (it == mStoreImp->mRecNameToStore.end())
+            if (skipIndependentRecords && it != mStoreImp->mRecNameToStore.end()
+                && it->second->hasIndependentRecords())
+            {
+                esm.skipRecord();
+                dialogue = nullptr;
+            }
+            else if (pendingRecord != nullptr)
+            {
+                // The record has already been read ahead of time, it only needs to be inserted
+                esm.skipRecord();
+                const RecordId id = pendingRecord->insert();
+                if (id.mIsDeleted)
+                {
+                    it->second->eraseStatic(id.mId);
+                    continue;
+                }
+                dialogue = nullptr;
+            }
+            else if (it == mStoreImp->mRecNameToStore.end())
             {
                 if (recName == ESM::REC_INFO)
                 {
@@ -468,12 +555,38 @@ namespace MWWorld
         }
     }
 
+    void ESMStore::writeContentCache(ESM::ESMWriter& writer) const
+    {
+        for (const auto& [_, store] : mStoreImp->mRecNameToStore)
+            if (store->hasIndependentRecords())
+                store->writeStatic(writer);
+    }
+
+    void ESMStore::readContentCache(ESM::ESMReader& reader)
+    {
+        // Read everything first to leave the store intact when the cache is broken
+        std::vector<std::unique_ptr<PendingRecord>> pending = parse(reader);
+        for (const std::unique_ptr<PendingRecord>& record : pending)
+            if (record == nullptr)
+                throw std::runtime_error("Content cache contains unsupported record");
+
+        for (const std::unique_ptr<PendingRecord>& record : pending)
+            record->insert();
+    }
+
     void ESMStore::loadESM4(ESM4::Reader& reader)
     {
         auto visitorRec = [this](ESM4::Reader& reader) { return ESMStoreImp::readRecord(reader, *this); };
         ESM4::ReaderUtils::readAll(reader, visitorRec, [](ESM4::Reader&) {});
     }
 
+    bool ESMStore::hasESM4Store(std::uint32_t typeId) const
+    {
+        const auto recName = static_cast<ESM::RecNameInts>(ESM::esm4Recname(static_cast<ESM4::RecordTypes>(typeId)));
+        return std::apply([&](const auto&... x) { return (ESMStoreImp::isESM4Store(x, recName) || ...); },
+            mStoreImp->mStores);
+    }
+
     void ESMStore::setIdType(const ESM::RefId& id, ESM::RecNameInts type)
     {
         mStoreImp->mIds[id] = type;
@@ -687,6 +800,14 @@ namespace MWWorld
             + get<ESM::Container>().getDynamicSize() + get<ESM::Light>().getDynamicSize();
     }
 
+    void ESMStore::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        ESMStoreImp::RecordStats recordStats;
+        std::apply([&](const auto&... x) { (ESMStoreImp::addRecordStats(x, recordStats), ...); }, mStoreImp->mStores);
+        stats.setAttribute(frameNumber, "ESMStore Records", static_cast<double>(recordStats.mRecords));
+        stats.setAttribute(frameNumber, "ESMStore Bytes", static_cast<double>(recordStats.mBytes));
+    }
+
     void ESMStore::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
         writer.startRecord(ESM::REC_DYNA);
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWWORLD_ESMSTORE_H
 #define OPENMW_MWWORLD_ESMSTORE_H
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <stdexcept>
@@ -113,6 +114,11 @@ namespace ESM4
     struct World;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     struct ESMStoreImp;
@@ -218,9 +224,29 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
-        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
+        /// Read all records of the content file which can be read independently from the store contents.
+        /// The result has an element for each record of the file, it is nullptr when the record has to be read
+        /// by load.
+        /// @note May be called concurrently for different content files as long as the store is not modified.
+        std::vector<std::unique_ptr<PendingRecord>> parse(ESM::ESMReader& esm);
+
+        /// @param pending Records of the same content file read ahead of time by parse.
+        /// @param skipIndependentRecords Skip the records supported by parse, e.g. because they have been read
+        /// from the content cache.
+        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+            std::vector<std::unique_ptr<PendingRecord>>* pending = nullptr, bool skipIndependentRecords = false);
         void loadESM4(ESM4::Reader& esm);
 
+        /// Is there a store for the ESM4 records of the type? Records of other types are skipped by loadESM4.
+        /// @note Can be called from any thread.
+        bool hasESM4Store(std::uint32_t typeId) const;
+
+        /// Write all records supported by parse which have been loaded from the content files.
+        void writeContentCache(ESM::ESMWriter& writer) const;
+
+        /// Read records written by writeContentCache. The store is not modified if reading fails.
+        void readContentCache(ESM::ESMReader& reader);
+
         template <class T>
         const Store<T>& get() const
         {
@@ -285,6 +311,10 @@ namespace MWWorld
 
         int countSavedGameRecords() const;
 
+        /// Reports the number of records and their memory usage approximated by the sizes of the record types.
+        /// Strings and containers owned by the records are not counted.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const;
 
         bool readRecord(ESM::ESMReader& reader, uint32_t type);
@@ -1,8 +1,18 @@
 #include "groundcoverstore.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include <osg/Math>
+
+#include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
 #include <components/esm3/loadstat.hpp>
 #include <components/esm3/readerscache.hpp>
+#include <components/esm3/sharedreaders.hpp>
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/load.hpp>
 #include <components/misc/resourcehelpers.hpp>
@@ -13,6 +23,55 @@
 
 namespace MWWorld
 {
+    namespace
+    {
+        constexpr float sPositionStep = 0.5f;
+        constexpr float sRotationStep = 2 * osg::PIf / 65536.f;
+        constexpr float sMinScale = 0.5f;
+        constexpr float sMaxScale = 2.f;
+
+        osg::Vec2f getCellCenter(int cellX, int cellY)
+        {
+            return osg::Vec2f(cellX + 0.5f, cellY + 0.5f) * ESM::Land::REAL_SIZE;
+        }
+
+        std::optional<std::int16_t> quantizeOffset(float offset)
+        {
+            const float value = std::round(offset / sPositionStep);
+            if (value < std::numeric_limits<std::int16_t>::min() || value > std::numeric_limits<std::int16_t>::max())
+                return std::nullopt;
+            return static_cast<std::int16_t>(value);
+        }
+
+        std::uint16_t quantizeRotation(float rotation)
+        {
+            return static_cast<std::uint16_t>(std::lround(rotation / sRotationStep) & 0xffff);
+        }
+
+        std::uint8_t quantizeScale(float scale)
+        {
+            const float value = (std::clamp(scale, sMinScale, sMaxScale) - sMinScale) / (sMaxScale - sMinScale);
+            return static_cast<std::uint8_t>(std::lround(value * 255));
+        }
+    }
+
+    ESM::Position GroundcoverStore::Instance::getPosition(int cellX, int cellY) const
+    {
+        const osg::Vec2f center = getCellCenter(cellX, cellY);
+        ESM::Position position;
+        position.pos[0] = center.x() + mX * sPositionStep;
+        position.pos[1] = center.y() + mY * sPositionStep;
+        position.pos[2] = mZ;
+        for (int i = 0; i < 3; ++i)
+            position.rot[i] = mRotation[i] * sRotationStep;
+        return position;
+    }
+
+    float GroundcoverStore::Instance::getScale() const
+    {
+        return sMinScale + mScale / 255.f * (sMaxScale - sMinScale);
+    }
+
     void GroundcoverStore::init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
         const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
     {
@@ -24,24 +83,34 @@ namespace MWWorld
         const ::EsmLoader::EsmData content
             = ::EsmLoader::loadEsmData(query, groundcoverFiles, fileCollections, readers, encoder, listener);
 
-        static constexpr std::string_view prefix = "grass\\";
-        for (const ESM::Static& stat : statics)
-        {
+        // Many statics share a few meshes, each mesh is stored once
+        std::map<std::string, std::uint16_t, std::less<>> modelIndices;
+        const auto addModel = [&](const ESM::Static& stat) {
+            static constexpr std::string_view prefix = "grass\\";
             std::string model = Misc::StringUtils::lowerCase(stat.mModel);
             std::replace(model.begin(), model.end(), '/', '\\');
             if (!model.starts_with(prefix))
-                continue;
-            mMeshCache[stat.mId] = Misc::ResourceHelpers::correctMeshPath(model);
-        }
+                return;
+            model = Misc::ResourceHelpers::correctMeshPath(model);
+            auto it = modelIndices.find(model);
+            if (it == modelIndices.end())
+            {
+                if (mModels.size() > std::numeric_limits<std::uint16_t>::max())
+                {
+                    Log(Debug::Warning) << "Too many groundcover models, ignoring " << model;
+                    return;
+                }
+                it = modelIndices.emplace(model, static_cast<std::uint16_t>(mModels.size())).first;
+                mModels.push_back(std::move(model));
+            }
+            mModelIndices[stat.mId] = it->second;
+        };
+
+        for (const ESM::Static& stat : statics)
+            addModel(stat);
 
         for (const ESM::Static& stat : content.mStatics)
-        {
-            std::string model = Misc::StringUtils::lowerCase(stat.mModel);
-            std::replace(model.begin(), model.end(), '/', '\\');
-            if (!model.starts_with(prefix))
-                continue;
-            mMeshCache[stat.mId] = Misc::ResourceHelpers::correctMeshPath(model);
-        }
+            addModel(stat);
 
         for (const ESM::Cell& cell : content.mCells)
         {
@@ -52,21 +121,77 @@ namespace MWWorld
         }
     }
 
-    std::string GroundcoverStore::getGroundcoverModel(const ESM::RefId& id) const
+    std::shared_ptr<const GroundcoverStore::CellInstances> GroundcoverStore::getCellInstances(
+        int cellX, int cellY, ESM::SharedReaders& readers) const
     {
-        auto search = mMeshCache.find(id);
-        if (search == mMeshCache.end())
-            return std::string();
+        const auto cellIndex = std::make_pair(cellX, cellY);
+        {
+            const std::lock_guard lock(mMutex);
+            const auto it = mCellInstances.find(cellIndex);
+            if (it != mCellInstances.end())
+                return it->second;
+        }
+
+        const auto contexts = mCellContexts.find(cellIndex);
+        if (contexts == mCellContexts.end())
+            return nullptr;
 
-        return search->second;
+        // Another thread may read the same cell meanwhile, the first result is kept
+        auto instances
+            = std::make_shared<const CellInstances>(loadCellInstances(cellX, cellY, contexts->second, readers));
+        const std::lock_guard lock(mMutex);
+        return mCellInstances.emplace(cellIndex, std::move(instances)).first->second;
     }
 
-    void GroundcoverStore::initCell(ESM::Cell& cell, int cellX, int cellY) const
+    GroundcoverStore::CellInstances GroundcoverStore::loadCellInstances(
+        int cellX, int cellY, const std::vector<ESM::ESM_Context>& contexts, ESM::SharedReaders& readers) const
     {
-        cell.blank();
+        const osg::Vec2f center = getCellCenter(cellX, cellY);
+        // Later content files replace or delete the references of the previous ones
+        std::vector<std::optional<Instance>> instances;
+        std::map<ESM::RefNum, std::size_t> indices;
+        ESM::SharedReaders::Reader reader(readers);
+        for (const ESM::ESM_Context& context : contexts)
+        {
+            ESM::ESMReader& esm = reader.restore(context);
+            ESM::CellRef ref;
+            bool deleted = false;
+            while (ESM::Cell::getNextRef(esm, ref, deleted))
+            {
+                std::optional<Instance> instance;
+                const auto model = mModelIndices.find(ref.mRefID);
+                if (!deleted && model != mModelIndices.end())
+                {
+                    const std::optional<std::int16_t> x = quantizeOffset(ref.mPos.pos[0] - center.x());
+                    const std::optional<std::int16_t> y = quantizeOffset(ref.mPos.pos[1] - center.y());
+                    if (x.has_value() && y.has_value())
+                    {
+                        instance = Instance{
+                            .mX = *x,
+                            .mY = *y,
+                            .mZ = ref.mPos.pos[2],
+                            .mRotation = { quantizeRotation(ref.mPos.rot[0]), quantizeRotation(ref.mPos.rot[1]),
+                                quantizeRotation(ref.mPos.rot[2]) },
+                            .mModel = model->second,
+                            .mScale = quantizeScale(ref.mScale),
+                        };
+                    }
+                }
+
+                const auto [it, inserted] = indices.emplace(ref.mRefNum, instances.size());
+                if (inserted)
+                    instances.push_back(instance);
+                else
+                    instances[it->second] = instance;
+            }
+        }
 
-        auto searchCell = mCellContexts.find(std::make_pair(cellX, cellY));
-        if (searchCell != mCellContexts.end())
-            cell.mContextList = searchCell->second;
+        CellInstances result;
+        result.reserve(instances.size());
+        for (const std::optional<Instance>& instance : instances)
+            if (instance.has_value())
+                result.push_back(*instance);
+        result.shrink_to_fit();
+        return result;
     }
 }
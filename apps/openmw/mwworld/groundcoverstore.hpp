@@ -1,8 +1,13 @@
 #ifndef GAME_MWWORLD_GROUNDCOVER_STORE_H
 #define GAME_MWWORLD_GROUNDCOVER_STORE_H
 
+#include <components/esm/position.hpp>
 #include <components/esm/refid.hpp>
+
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -10,7 +15,7 @@ namespace ESM
 {
     struct ESM_Context;
     struct Static;
-    struct Cell;
+    class SharedReaders;
 }
 
 namespace Loading
@@ -35,17 +40,46 @@ namespace MWWorld
 
     class GroundcoverStore
     {
-    private:
-        std::map<ESM::RefId, std::string> mMeshCache;
-        std::map<std::pair<int, int>, std::vector<ESM::ESM_Context>> mCellContexts;
-
     public:
+        /// Groundcover reference quantized to what is visible on grass.
+        struct Instance
+        {
+            // Offset from the center of the cell in half units
+            std::int16_t mX;
+            std::int16_t mY;
+            float mZ;
+            // Rotation around each axis in 1/65536 of a turn
+            std::uint16_t mRotation[3];
+            // Index into the models of the store
+            std::uint16_t mModel;
+            // Scale mapped from [0.5, 2] to [0, 255]
+            std::uint8_t mScale;
+
+            ESM::Position getPosition(int cellX, int cellY) const;
+            float getScale() const;
+        };
+
+        using CellInstances = std::vector<Instance>;
+
         void init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
             Loading::Listener* listener);
 
-        std::string getGroundcoverModel(const ESM::RefId& id) const;
-        void initCell(ESM::Cell& cell, int cellX, int cellY) const;
+        const std::string& getModel(std::uint16_t index) const { return mModels[index]; }
+
+        /// Groundcover of the exterior cell in the order the references were first found in the content files.
+        /// @note Reads the references of the cell on first use and keeps them, can be called from any thread.
+        std::shared_ptr<const CellInstances> getCellInstances(int cellX, int cellY, ESM::SharedReaders& readers) const;
+
+    private:
+        std::map<ESM::RefId, std::uint16_t> mModelIndices;
+        std::vector<std::string> mModels;
+        std::map<std::pair<int, int>, std::vector<ESM::ESM_Context>> mCellContexts;
+        mutable std::mutex mMutex;
+        mutable std::map<std::pair<int, int>, std::shared_ptr<const CellInstances>> mCellInstances;
+
+        CellInstances loadCellInstances(
+            int cellX, int cellY, const std::vector<ESM::ESM_Context>& contexts, ESM::SharedReaders& readers) const;
     };
 }
 
@@ -69,22 +69,28 @@ namespace
 }
 
 MWWorld::LocalScripts::LocalScripts(const MWWorld::ESMStore& store)
-    : mStore(store)
+    : mIndex(0)
+    , mStore(store)
 {
-    mIter = mScripts.end();
+}
+
+void MWWorld::LocalScripts::erase(std::size_t index)
+{
+    mScripts.erase(mScripts.begin() + index);
+    if (index < mIndex)
+        --mIndex;
 }
 
 void MWWorld::LocalScripts::startIteration()
 {
-    mIter = mScripts.begin();
+    mIndex = 0;
 }
 
 bool MWWorld::LocalScripts::getNext(std::pair<ESM::RefId, Ptr>& script)
 {
-    if (mIter != mScripts.end())
+    if (mIndex < mScripts.size())
     {
-        auto iter = mIter++;
-        script = *iter;
+        script = mScripts[mIndex++];
         return true;
     }
     return false;
@@ -132,48 +138,46 @@ void MWWorld::LocalScripts::addCell(CellStore* cell)
 void MWWorld::LocalScripts::clear()
 {
     mScripts.clear();
+    mIndex = 0;
 }
 
 void MWWorld::LocalScripts::clearCell(CellStore* cell)
 {
-    auto iter = mScripts.begin();
-
-    while (iter != mScripts.end())
+    // Compact the scripts of the other cells in one pass, keeping the position of the iteration
+    std::size_t kept = 0;
+    std::size_t index = mIndex;
+    for (std::size_t i = 0; i < mScripts.size(); ++i)
     {
-        if (iter->second.mCell == cell)
+        if (mScripts[i].second.mCell == cell)
         {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter++);
+            if (i < mIndex)
+                --index;
+            continue;
         }
-        else
-            ++iter;
+        if (kept != i)
+            mScripts[kept] = std::move(mScripts[i]);
+        ++kept;
     }
+    mScripts.erase(mScripts.begin() + kept, mScripts.end());
+    mIndex = index;
 }
 
 void MWWorld::LocalScripts::remove(const MWWorld::CellRef* ref)
 {
-    for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (&(iter->second.getCellRef()) == ref)
+    for (std::size_t i = 0; i < mScripts.size(); ++i)
+        if (&(mScripts[i].second.getCellRef()) == ref)
         {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter);
+            erase(i);
             break;
         }
 }
 
 void MWWorld::LocalScripts::remove(const Ptr& ptr)
 {
-    for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (iter->second == ptr)
+    for (std::size_t i = 0; i < mScripts.size(); ++i)
+        if (mScripts[i].second == ptr)
         {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter);
+            erase(i);
             break;
         }
 }
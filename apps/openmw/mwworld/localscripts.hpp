@@ -1,8 +1,9 @@
 #ifndef GAME_MWWORLD_LOCALSCRIPTS_H
 #define GAME_MWWORLD_LOCALSCRIPTS_H
 
-#include <list>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "ptr.hpp"
 
@@ -13,12 +14,16 @@ namespace MWWorld
     class RefData;
 
     /// \brief List of active local scripts
+    /// \note The scripts are stored contiguously, removing a script keeps the order of the others and the position of
+    /// the current iteration.
     class LocalScripts
     {
-        std::list<std::pair<ESM::RefId, Ptr>> mScripts;
-        std::list<std::pair<ESM::RefId, Ptr>>::iterator mIter;
+        std::vector<std::pair<ESM::RefId, Ptr>> mScripts;
+        std::size_t mIndex;
         const MWWorld::ESMStore& mStore;
 
+        void erase(std::size_t index);
+
     public:
         LocalScripts(const MWWorld::ESMStore& store);
 
@@ -29,6 +34,8 @@ namespace MWWorld
         ///< Get next local script
         /// @return Did we get a script?
 
+        std::size_t size() const { return mScripts.size(); }
+
         void add(const ESM::RefId& scriptName, const Ptr& ptr);
         ///< Add script to collection of active local scripts.
 
@@ -519,38 +519,8 @@ namespace MWWorld
 
             const auto pos = projectile->getSimulationPosition();
             projectileState.mNode->setPosition(pos);
-
-            if (projectile->isActive())
-                continue;
-
-            const auto target = projectile->getTarget();
-            auto caster = projectileState.getCaster();
-            assert(target != caster);
-
-            if (caster.isEmpty())
-                caster = target;
-
-            // Try to get a Ptr to the bow that was used. It might no longer exist.
-            MWWorld::ManualRef projectileRef(*MWBase::Environment::get().getESMStore(), projectileState.mIdArrow);
-            MWWorld::Ptr bow = projectileRef.getPtr();
-            if (!caster.isEmpty() && projectileState.mIdArrow != projectileState.mBowId)
-            {
-                MWWorld::InventoryStore& inv = caster.getClass().getInventoryStore(caster);
-                MWWorld::ContainerStoreIterator invIt = inv.getSlot(MWWorld::InventoryStore::Slot_CarriedRight);
-                if (invIt != inv.end() && invIt->getCellRef().getRefId() == projectileState.mBowId)
-                    bow = *invIt;
-            }
-
-            const auto hitPosition = Misc::Convert::toOsg(projectile->getHitPosition());
-
-            if (projectile->getHitWater())
-                mRendering->emitWaterRipple(hitPosition);
-
-            MWMechanics::projectileHit(
-                caster, target, bow, projectileRef.getPtr(), hitPosition, projectileState.mAttackStrength);
-            projectileState.mToDelete = true;
         }
-        const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
+
         for (auto& magicBoltState : mMagicBolts)
         {
             if (magicBoltState.mToDelete)
@@ -562,32 +532,24 @@ namespace MWWorld
             magicBoltState.mNode->setPosition(pos);
             for (const auto& sound : magicBoltState.mSounds)
                 sound->setPosition(pos);
+        }
 
-            if (projectile->isActive())
-                continue;
-
-            const auto target = projectile->getTarget();
-            const auto caster = magicBoltState.getCaster();
-            assert(target != caster);
-
-            MWMechanics::CastSpell cast(caster, target);
-            cast.mHitPosition = Misc::Convert::toOsg(projectile->getHitPosition());
-            cast.mId = magicBoltState.mSpellId;
-            cast.mSourceName = magicBoltState.mSourceName;
-            cast.mItem = magicBoltState.mItem;
-            // Grab original effect list so the indices are correct
-            const ESM::EffectList* effects;
-            if (const ESM::Spell* spell = esmStore.get<ESM::Spell>().search(magicBoltState.mSpellId))
-                effects = &spell->mEffects;
-            else
+        for (const int projectileId : mPhysics->takeProjectileHits())
+        {
+            // The projectile may already be removed
+            const auto hasId = [&](const State& state) { return state.mProjectileId == projectileId; };
+            if (const auto it = std::find_if(mProjectiles.begin(), mProjectiles.end(), hasId);
+                it != mProjectiles.end())
             {
-                MWWorld::ManualRef ref(esmStore, magicBoltState.mSpellId);
-                const MWWorld::Ptr& ptr = ref.getPtr();
-                effects = &esmStore.get<ESM::Enchantment>().find(ptr.getClass().getEnchantment(ptr))->mEffects;
+                if (!it->mToDelete)
+                    processProjectileHit(*it);
+            }
+            else if (const auto it = std::find_if(mMagicBolts.begin(), mMagicBolts.end(), hasId);
+                     it != mMagicBolts.end())
+            {
+                if (!it->mToDelete)
+                    processMagicBoltHit(*it);
             }
-            cast.inflict(target, *effects, ESM::RT_Target);
-
-            magicBoltState.mToDelete = true;
         }
 
         for (auto& projectileState : mProjectiles)
@@ -609,6 +571,68 @@ namespace MWWorld
             mMagicBolts.end());
     }
 
+    void ProjectileManager::processProjectileHit(ProjectileState& projectileState)
+    {
+        // The hit may launch new projectiles invalidating the state
+        projectileState.mToDelete = true;
+        auto* projectile = mPhysics->getProjectile(projectileState.mProjectileId);
+
+        const auto target = projectile->getTarget();
+        auto caster = projectileState.getCaster();
+        assert(target != caster);
+
+        if (caster.isEmpty())
+            caster = target;
+
+        // Try to get a Ptr to the bow that was used. It might no longer exist.
+        MWWorld::ManualRef projectileRef(*MWBase::Environment::get().getESMStore(), projectileState.mIdArrow);
+        MWWorld::Ptr bow = projectileRef.getPtr();
+        if (!caster.isEmpty() && projectileState.mIdArrow != projectileState.mBowId)
+        {
+            MWWorld::InventoryStore& inv = caster.getClass().getInventoryStore(caster);
+            MWWorld::ContainerStoreIterator invIt = inv.getSlot(MWWorld::InventoryStore::Slot_CarriedRight);
+            if (invIt != inv.end() && invIt->getCellRef().getRefId() == projectileState.mBowId)
+                bow = *invIt;
+        }
+
+        const auto hitPosition = Misc::Convert::toOsg(projectile->getHitPosition());
+
+        if (projectile->getHitWater())
+            mRendering->emitWaterRipple(hitPosition);
+
+        MWMechanics::projectileHit(
+            caster, target, bow, projectileRef.getPtr(), hitPosition, projectileState.mAttackStrength);
+    }
+
+    void ProjectileManager::processMagicBoltHit(MagicBoltState& magicBoltState)
+    {
+        // The hit may launch new projectiles invalidating the state
+        magicBoltState.mToDelete = true;
+        const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
+        auto* projectile = mPhysics->getProjectile(magicBoltState.mProjectileId);
+
+        const auto target = projectile->getTarget();
+        const auto caster = magicBoltState.getCaster();
+        assert(target != caster);
+
+        MWMechanics::CastSpell cast(caster, target);
+        cast.mHitPosition = Misc::Convert::toOsg(projectile->getHitPosition());
+        cast.mId = magicBoltState.mSpellId;
+        cast.mSourceName = magicBoltState.mSourceName;
+        cast.mItem = magicBoltState.mItem;
+        // Grab original effect list so the indices are correct
+        const ESM::EffectList* effects;
+        if (const ESM::Spell* spell = esmStore.get<ESM::Spell>().search(magicBoltState.mSpellId))
+            effects = &spell->mEffects;
+        else
+        {
+            MWWorld::ManualRef ref(esmStore, magicBoltState.mSpellId);
+            const MWWorld::Ptr& ptr = ref.getPtr();
+            effects = &esmStore.get<ESM::Enchantment>().find(ptr.getClass().getEnchantment(ptr))->mEffects;
+        }
+        cast.inflict(target, *effects, ESM::RT_Target);
+    }
+
     void ProjectileManager::cleanupProjectile(ProjectileManager::ProjectileState& state)
     {
         mParent->removeChild(state.mNode);
@@ -128,6 +128,9 @@ namespace MWWorld
         std::vector<MagicBoltState> mMagicBolts;
         std::vector<ProjectileState> mProjectiles;
 
+        void processProjectileHit(ProjectileState& state);
+        void processMagicBoltHit(MagicBoltState& state);
+
         void cleanupProjectile(ProjectileState& state);
         void cleanupMagicBolt(MagicBoltState& state);
         void periodicCleanup(float dt);
@@ -4,11 +4,15 @@
 #include "ptr.hpp"
 
 #include "components/esm3/cellref.hpp"
+#include "components/misc/flathashmap.hpp"
 
-#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
 namespace MWWorld
 {
+    // Can be used by several Lua threads at the same time, iterating is allowed only when nothing else is running
     class PtrRegistry
     {
     public:
@@ -22,9 +26,9 @@ namespace MWWorld
 
         Ptr getOrEmpty(ESM::RefNum refNum) const
         {
-            const auto it = mIndex.find(refNum);
-            if (it != mIndex.end())
-                return it->second;
+            const std::shared_lock lock(mMutex);
+            if (const Ptr* const ptr = mIndex.find(refNum))
+                return *ptr;
             return Ptr();
         }
 
@@ -32,6 +36,7 @@ namespace MWWorld
 
         void clear()
         {
+            const std::unique_lock lock(mMutex);
             mIndex.clear();
             mLastGenerated = ESM::RefNum{};
             ++mRevision;
@@ -39,6 +44,7 @@ namespace MWWorld
 
         void insert(const Ptr& ptr)
         {
+            const std::unique_lock lock(mMutex);
             mIndex[ptr.getCellRef().getOrAssignRefNum(mLastGenerated)] = ptr;
             ++mRevision;
         }
@@ -48,10 +54,11 @@ namespace MWWorld
             ESM::RefNum refNum = ref.mRef.getRefNum();
             if (!refNum.isSet())
                 return;
-            auto it = mIndex.find(refNum);
-            if (it != mIndex.end() && it->second.mRef == &ref)
+            const std::unique_lock lock(mMutex);
+            const Ptr* const ptr = mIndex.find(refNum);
+            if (ptr != nullptr && ptr->mRef == &ref)
             {
-                mIndex.erase(it);
+                mIndex.erase(refNum);
                 ++mRevision;
             }
         }
@@ -61,6 +68,7 @@ namespace MWWorld
         {
             if (!ref.mRefNum.isSet())
             {
+                const std::unique_lock lock(mMutex);
                 CellRef temp(ref);
                 temp.getOrAssignRefNum(mLastGenerated);
                 ref.mRefNum = temp.getRefNum();
@@ -68,8 +76,9 @@ namespace MWWorld
         }
 
     private:
-        std::size_t mRevision = 0;
-        std::unordered_map<ESM::RefNum, Ptr> mIndex;
+        mutable std::shared_mutex mMutex;
+        std::atomic<std::size_t> mRevision = 0;
+        Misc::FlatHashMap<ESM::RefNum, Ptr> mIndex;
         ESM::RefNum mLastGenerated;
     };
 
@@ -302,6 +302,11 @@ namespace MWWorld
         return ret;
     }
 
+    bool RefData::isWaitingForActivation() const
+    {
+        return (mFlags & (Flag_SuppressActivate | Flag_OnActivate)) == Flag_SuppressActivate;
+    }
+
     const ESM::AnimationState& RefData::getAnimationState() const
     {
         return mAnimationState;
@@ -141,6 +141,10 @@ namespace MWWorld
 
         bool activateByScript();
 
+        bool isWaitingForActivation() const;
+        ///< Has a script checked for OnActivate, suppressing the default activation, without the object being
+        /// activated since?
+
         bool hasChanged() const;
         ///< Has this RefData changed since it was originally loaded?
 
@@ -1,5 +1,6 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
@@ -36,6 +37,7 @@
 
 #include "../mwphysics/actor.hpp"
 #include "../mwphysics/heightfield.hpp"
+#include "../mwphysics/heightfieldmanager.hpp"
 #include "../mwphysics/object.hpp"
 #include "../mwphysics/physicssystem.hpp"
 
@@ -350,9 +352,15 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCellIndex,
-                mChangeCellGridRequest->mChangeEvent);
+                mChangeCellGridRequest->mChangeEvent, mAttachTimeBudget > 0);
             mChangeCellGridRequest.reset();
         }
+        else if (!mPendingCells.empty())
+        {
+            const auto budget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(mAttachTimeBudget));
+            attachPendingCells(std::chrono::steady_clock::now() + budget);
+        }
 
         mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
@@ -440,21 +448,12 @@ namespace MWWorld
         {
             osg::ref_ptr<const ESMTerrain::LandObject> land = mRendering.getLandManager()->getLand(cellIndex);
             const ESM::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
-            const int verts = ESM::getLandSize(worldspace);
             const int worldsize = ESM::getCellSize(worldspace);
 
-            if (data)
-            {
-                mPhysics->addHeightField(data->getHeights().data(), cellX, cellY, worldsize, verts,
-                    data->getMinHeight(), data->getMaxHeight(), land.get());
-            }
-            else if (!ESM::isEsm4Ext(worldspace))
-            {
-                static std::vector<float> defaultHeight;
-                defaultHeight.resize(verts * verts, ESM::Land::DEFAULT_HEIGHT);
-                mPhysics->addHeightField(defaultHeight.data(), cellX, cellY, worldsize, verts,
-                    ESM::Land::DEFAULT_HEIGHT, ESM::Land::DEFAULT_HEIGHT, land.get());
-            }
+            if (osg::ref_ptr<const MWPhysics::HeightFieldShape> heightFieldShape
+                = mPhysics->getHeightFieldManager()->getShape(cellIndex, land.get()))
+                mPhysics->addHeightField(std::move(heightFieldShape), cellX, cellY);
+
             if (const auto heightField = mPhysics->getHeightField(cellX, cellY))
             {
                 const osg::Vec2i cellPosition(cellX, cellY);
@@ -529,8 +528,32 @@ namespace MWWorld
         mPreloader->notifyLoaded(&cell);
     }
 
+    void Scene::attachPendingCells()
+    {
+        attachPendingCells(std::chrono::steady_clock::time_point::max());
+    }
+
+    void Scene::attachPendingCells(std::chrono::steady_clock::time_point deadline)
+    {
+        if (mPendingCells.empty())
+            return;
+        auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
+        do
+        {
+            const PendingExteriorCell pending = mPendingCells.front();
+            mPendingCells.pop_front();
+            if (isCellInCollection(pending.mLocation, mActiveCells))
+                continue;
+            CellStore& cell = mWorld.getWorldModel().getExterior(pending.mLocation);
+            loadCell(cell, nullptr, pending.mRespawn, mPendingCellsPosition, navigatorUpdateGuard.get());
+            mRendering.compileCell(&cell);
+        } while (!mPendingCells.empty() && std::chrono::steady_clock::now() < deadline);
+        mNavigator.update(mPendingCellsPosition, navigatorUpdateGuard.get());
+    }
+
     void Scene::clear()
     {
+        mPendingCells.clear();
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
         for (auto iter = mActiveCells.begin(); iter != mActiveCells.end();)
         {
@@ -612,8 +635,11 @@ namespace MWWorld
             ESM::ExteriorCellLocation(cell.x(), cell.y(), mCurrentCell->getCell()->getWorldSpace()), changeEvent };
     }
 
-    void Scene::changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent)
+    void Scene::changeCellGrid(
+        const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent, bool deferFarCells)
     {
+        // The cells still waiting from the previous grid are queued again if they remain in the new one
+        mPendingCells.clear();
         const int halfGridSize
             = isEsm4Ext(playerCellIndex.mWorldspace) ? Constants::ESM4CellGridRadius : Constants::CellGridRadius;
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
@@ -656,13 +682,18 @@ namespace MWWorld
 
         addPostponedPhysicsObjects();
 
+        const auto isFarCell = [&](int x, int y) {
+            return std::max(std::abs(x - playerCellX), std::abs(y - playerCellY)) == mHalfGridSize;
+        };
+
         std::size_t refsToLoad = 0;
         std::vector<std::pair<int, int>> cellsPositionsToLoad;
         iterateOverCellsAround(playerCellX, playerCellY, mHalfGridSize, [&](int x, int y) {
             const ESM::ExteriorCellLocation location(x, y, playerCellIndex.mWorldspace);
             if (isCellInCollection(location, mActiveCells))
                 return;
-            refsToLoad += mWorld.getWorldModel().getExterior(location).count();
+            if (!deferFarCells || !isFarCell(x, y))
+                refsToLoad += mWorld.getWorldModel().getExterior(location).count();
             cellsPositionsToLoad.emplace_back(x, y);
         });
 
@@ -673,16 +704,41 @@ namespace MWWorld
 
         sortCellsToLoad(playerCellX, playerCellY, cellsPositionsToLoad);
 
+        if (mPreloadEnabled)
+        {
+            // Prepare the meshes and shapes in the worker threads while the loading screen is drawn
+            std::vector<CellStore*> cellsToPreload;
+            for (const auto& [x, y] : cellsPositionsToLoad)
+            {
+                if (deferFarCells && isFarCell(x, y))
+                    continue;
+                const ESM::ExteriorCellLocation location(x, y, playerCellIndex.mWorldspace);
+                cellsToPreload.push_back(&mWorld.getWorldModel().getExterior(location));
+            }
+            mPreloader->syncPreload(cellsToPreload, mRendering.getReferenceTime(), *loadingListener);
+        }
+
         for (const auto& [x, y] : cellsPositionsToLoad)
         {
             ESM::ExteriorCellLocation indexToLoad = { x, y, playerCellIndex.mWorldspace };
             if (!isCellInCollection(indexToLoad, mActiveCells))
             {
+                // Only the far cells can stay hidden for a few frames without the player noticing
+                const bool farCell = isFarCell(x, y);
+                if (farCell && deferFarCells)
+                {
+                    mPendingCells.push_back(PendingExteriorCell{ indexToLoad, changeEvent });
+                    continue;
+                }
                 CellStore& cell = mWorld.getWorldModel().getExterior(indexToLoad);
                 loadCell(cell, loadingListener, changeEvent, pos, navigatorUpdateGuard.get());
+                if (farCell)
+                    mRendering.compileCell(&cell);
             }
         }
 
+        mPendingCellsPosition = pos;
+
         mNavigator.update(pos, navigatorUpdateGuard.get());
 
         navigatorUpdateGuard.reset();
@@ -895,13 +951,16 @@ namespace MWWorld
         , mPreloadFastTravel(Settings::cells().mPreloadFastTravel)
         , mPredictionTime(Settings::cells().mPredictionTime)
         , mLowestPoint(std::numeric_limits<float>::max())
+        , mAttachTimeBudget(Settings::cells().mAttachTimeBudget)
     {
         mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(),
-            rendering.getTerrain(), rendering.getLandManager());
+            physics->getHeightFieldManager(), rendering.getTerrain(), rendering.getLandManager());
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
+        mPreloader->setReaders(&world.getSharedReaders());
         mPreloader->setExpiryDelay(Settings::cells().mPreloadCellExpiryDelay);
         mPreloader->setMinCacheSize(Settings::cells().mPreloadCellCacheMin);
         mPreloader->setMaxCacheSize(Settings::cells().mPreloadCellCacheMax);
+        mPreloader->setMemoryBudget(static_cast<std::size_t>(Settings::cells().mPreloadCellMemoryBudget) * 1024 * 1024);
         mPreloader->setPreloadInstances(Settings::cells().mPreloadInstances);
     }
 
@@ -949,6 +1008,7 @@ namespace MWWorld
 
         Log(Debug::Info) << "Changing to interior";
 
+        mPendingCells.clear();
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
 
         // unload
@@ -966,6 +1026,11 @@ namespace MWWorld
 
         // Load cell.
         mPagedRefs.clear();
+        if (mPreloadEnabled)
+        {
+            CellStore* const cellsToPreload[] = { &cell };
+            mPreloader->syncPreload(cellsToPreload, mRendering.getReferenceTime(), *loadingListener);
+        }
         loadCell(cell, loadingListener, changeEvent, position.asVec3(), navigatorUpdateGuard.get());
 
         navigatorUpdateGuard.reset();
@@ -1157,6 +1222,8 @@ namespace MWWorld
 
         mLastPlayerPos = playerPos;
 
+        mPreloader->setPredictedPosition(predictedPos, mCurrentCell->getCell()->getWorldSpace());
+
         if (mPreloadEnabled)
         {
             if (mPreloadDoors)
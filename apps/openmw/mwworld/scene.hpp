@@ -8,6 +8,8 @@
 #include "positioncellgrid.hpp"
 #include "ptr.hpp"
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <set>
@@ -85,6 +87,12 @@ namespace MWWorld
             bool mChangeEvent;
         };
 
+        struct PendingExteriorCell
+        {
+            ESM::ExteriorCellLocation mLocation;
+            bool mRespawn;
+        };
+
         CellStore* mCurrentCell; // the cell the player is in
         CellStoreCollection mActiveCells;
         bool mCellChanged;
@@ -114,13 +122,23 @@ namespace MWWorld
 
         std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+        float mAttachTimeBudget;
+        // Far cells of the grid that are attached over the following frames, the nearest first
+        std::deque<PendingExteriorCell> mPendingCells;
+        osg::Vec3f mPendingCellsPosition;
+
         void insertCell(CellStore& cell, Loading::Listener* loadingListener,
             const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
 
         osg::Vec2i mCurrentGridCenter;
 
         // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true);
+        // With deferFarCells the cells on the border of the grid are only queued to be attached by update
+        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true,
+            bool deferFarCells = false);
+
+        // Attach the queued cells until the deadline, at least one
+        void attachPendingCells(std::chrono::steady_clock::time_point deadline);
 
         void requestChangeCellGrid(const osg::Vec3f& position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -163,6 +181,12 @@ namespace MWWorld
 
         void resetCellLoaded() { mCellLoaded = false; }
 
+        bool hasPendingCells() const { return !mPendingCells.empty(); }
+        ///< Are there cells of the exterior grid still waiting to be attached over the following frames?
+
+        void attachPendingCells();
+        ///< Attach the waiting cells right away, so their objects can be found by scripts.
+
         void changeToInteriorCell(
             std::string_view cellName, const ESM::Position& position, bool adjustPlayerPos, bool changeEvent = true);
         ///< Move to interior cell.
@@ -1,8 +1,11 @@
 #include "store.hpp"
 
+#include <algorithm>
+#include <future>
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include <components/debug/debuglog.hpp>
 
@@ -136,19 +139,25 @@ namespace MWWorld
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::search(const Id& id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        if (dit != mDynamic.end())
-            return &dit->second;
-
-        typename Static::const_iterator it = mStatic.find(id);
-        if (it != mStatic.end())
-            return &(it->second);
+        // Most of the stores don't have dynamic records
+        if (!mDynamic.empty())
+        {
+            typename Dynamic::const_iterator dit = mDynamic.find(id);
+            if (dit != mDynamic.end())
+                return &dit->second;
+        }
 
-        return nullptr;
+        return searchStatic(id);
     }
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::searchStatic(const Id& id) const
     {
+        if (mHasStaticIndex)
+        {
+            const T* const* const found = mStaticIndex.find(id);
+            return found == nullptr ? nullptr : *found;
+        }
+
         typename Static::const_iterator it = mStatic.find(id);
         if (it != mStatic.end())
             return &(it->second);
@@ -214,14 +223,7 @@ namespace MWWorld
             bool isDeleted = false;
             record.load(esm, isDeleted);
 
-            std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
-            if (inserted.second)
-                mShared.push_back(&inserted.first->second);
-
-            if constexpr (std::is_same_v<Id, ESM::RefId>)
-                return RecordId(record.mId, isDeleted);
-            else
-                return RecordId();
+            return insertLoaded(std::move(record), isDeleted);
         }
         else
         {
@@ -232,9 +234,55 @@ namespace MWWorld
         }
     }
 
+    template <class T, class Id>
+    std::unique_ptr<PendingRecord> TypedDynamicStore<T, Id>::parse(ESM::ESMReader& esm)
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            struct Pending final : PendingRecord
+            {
+                TypedDynamicStore* mStore = nullptr;
+                T mRecord;
+                bool mIsDeleted = false;
+
+                RecordId insert() override { return mStore->insertLoaded(std::move(mRecord), mIsDeleted); }
+            };
+
+            auto pending = std::make_unique<Pending>();
+            pending->mStore = this;
+            pending->mRecord.load(esm, pending->mIsDeleted);
+            return pending;
+        }
+        else
+            return nullptr;
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::insertLoaded(T&& record, bool isDeleted)
+    {
+        const Id id = record.mId;
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id, std::move(record));
+        if (inserted.second)
+        {
+            mShared.push_back(&inserted.first->second);
+            if (mHasStaticIndex)
+                mStaticIndex.emplace(id, &inserted.first->second);
+        }
+
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            return RecordId(id, isDeleted);
+        else
+            return RecordId();
+    }
+
     template <class T, class Id>
     void TypedDynamicStore<T, Id>::setUp()
     {
+        mStaticIndex.clear();
+        mStaticIndex.reserve(mStatic.size());
+        for (const auto& [id, record] : mStatic)
+            mStaticIndex.emplace(id, &record);
+        mHasStaticIndex = true;
     }
 
     template <class T, class Id>
@@ -290,7 +338,11 @@ namespace MWWorld
         std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(item.mId, item);
         T* ptr = &result.first->second;
         if (result.second)
+        {
             mShared.push_back(ptr);
+            if (mHasStaticIndex)
+                mStaticIndex.emplace(item.mId, ptr);
+        }
         return ptr;
     }
     template <class T, class Id>
@@ -313,6 +365,8 @@ namespace MWWorld
                 }
                 ++sharedIter;
             }
+            if (mHasStaticIndex)
+                mStaticIndex.erase(id);
             mStatic.erase(it);
         }
 
@@ -353,6 +407,20 @@ namespace MWWorld
         }
     }
     template <class T, class Id>
+    void TypedDynamicStore<T, Id>::writeStatic(ESM::ESMWriter& writer) const
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            // Keep the content files order of the records
+            for (auto it = mShared.begin(), end = mShared.begin() + mStatic.size(); it != end; ++it)
+            {
+                writer.startRecord(T::sRecordId);
+                (*it)->save(writer);
+                writer.endRecord(T::sRecordId);
+            }
+        }
+    }
+    template <class T, class Id>
     RecordId TypedDynamicStore<T, Id>::read(ESM::ESMReader& reader, bool overrideOnly)
     {
         if constexpr (!ESM::isESM4Rec(T::sRecordId))
@@ -1079,6 +1147,10 @@ namespace MWWorld
         std::sort(mShared.begin(), mShared.end(),
             [](const ESM::Dialogue* l, const ESM::Dialogue* r) -> bool { return l->mId < r->mId; });
 
+        mInfoIndices.clear();
+        for (const ESM::Dialogue* dial : mShared)
+            mInfoIndices.emplace(dial, MWDialogue::InfoIndex(*dial));
+
         mKeywordSearchModFlag = true;
     }
 
@@ -1145,6 +1217,9 @@ namespace MWWorld
 
     bool Store<ESM::Dialogue>::eraseStatic(const ESM::RefId& id)
     {
+        if (const auto it = mStatic.find(id); it != mStatic.end())
+            mInfoIndices.erase(&it->second);
+
         if (eraseFromMap(mStatic, id))
             mKeywordSearchModFlag = true;
 
@@ -1179,6 +1254,14 @@ namespace MWWorld
         return mKeywordSearch;
     }
 
+    const MWDialogue::InfoIndex* Store<ESM::Dialogue>::getInfoIndex(const ESM::Dialogue& dialogue) const
+    {
+        const auto it = mInfoIndices.find(&dialogue);
+        if (it == mInfoIndices.end())
+            return nullptr;
+        return &it->second;
+    }
+
     // ESM4 Cell
     //=========================================================================
 
@@ -1240,6 +1323,78 @@ namespace MWWorld
         MWWorld::TypedDynamicStore<ESM4::Cell>::clearDynamic();
     }
 
+    // ESM4 references
+    //=========================================================================
+    template <typename T>
+    void ESM4RefsStore<T>::preprocessReferences(const Store<ESM4::Cell>& cells)
+    {
+        std::vector<T*> references;
+        references.reserve(this->mStatic.size());
+        for (auto& [_, ref] : this->mStatic)
+            references.push_back(&ref);
+
+        constexpr std::size_t minChunkSize = 16 * 1024;
+        const std::size_t chunks = std::clamp<std::size_t>(
+            references.size() / minChunkSize, 1, std::max(std::thread::hardware_concurrency(), 1u));
+        const std::size_t chunkSize = (references.size() + chunks - 1) / chunks;
+
+        // Every chunk groups its references into buckets of its own, they are merged in the chunk order to keep the
+        // order of the references the same as with a single chunk
+        using Buckets = std::unordered_map<ESM::RefId, std::vector<const T*>>;
+        std::vector<Buckets> buckets(chunks);
+
+        const auto groupChunk = [&](std::size_t chunk) {
+            const std::size_t end = std::min(references.size(), (chunk + 1) * chunkSize);
+            for (std::size_t i = chunk * chunkSize; i < end; ++i)
+            {
+                T& ref = *references[i];
+                const ESM4::Cell* cell = cells.find(ref.mParent);
+                if (cell->isExterior() && (cell->mFlags & ESM4::Rec_Persistent))
+                {
+                    const ESM4::Cell* actualCell = cells.searchExterior(
+                        positionToExteriorCellLocation(ref.mPos.pos[0], ref.mPos.pos[1], cell->mParent));
+                    if (actualCell)
+                        ref.mParent = actualCell->mId;
+                }
+                buckets[chunk][ref.mParent].push_back(&ref);
+            }
+        };
+
+        std::vector<std::future<void>> grouping;
+        for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+            grouping.push_back(std::async(std::launch::async, groupChunk, chunk));
+        groupChunk(0);
+        for (std::future<void>& future : grouping)
+            future.get();
+
+        mPerCellReferences.clear();
+
+        for (const Buckets& chunkBuckets : buckets)
+            for (const auto& [cellId, cellReferences] : chunkBuckets)
+                mPerCellReferences[cellId].mCount += cellReferences.size();
+
+        std::size_t offset = 0;
+        for (auto& [_, cellReferences] : mPerCellReferences)
+        {
+            cellReferences.mOffset = offset;
+            offset += cellReferences.mCount;
+            cellReferences.mCount = 0;
+        }
+
+        mReferences.resize(offset);
+
+        for (const Buckets& chunkBuckets : buckets)
+        {
+            for (const auto& [cellId, chunkReferences] : chunkBuckets)
+            {
+                CellReferences& cellReferences = mPerCellReferences.find(cellId)->second;
+                std::copy(chunkReferences.begin(), chunkReferences.end(),
+                    mReferences.begin() + static_cast<std::ptrdiff_t>(cellReferences.mOffset + cellReferences.mCount));
+                cellReferences.mCount += chunkReferences.size();
+            }
+        }
+    }
+
     // ESM4 Land
     //=========================================================================
     // Needed to avoid include of ESM4::Land in header
@@ -1314,6 +1469,9 @@ template class MWWorld::TypedDynamicStore<ESM::Weapon>;
 template class MWWorld::TypedDynamicStore<ESM4::Reference, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCharacter, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCreature, ESM::FormId>;
+template class MWWorld::ESM4RefsStore<ESM4::Reference>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCharacter>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCreature>;
 
 template class MWWorld::TypedDynamicStore<ESM4::Activator>;
 template class MWWorld::TypedDynamicStore<ESM4::Ammunition>;
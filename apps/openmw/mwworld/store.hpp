@@ -23,9 +23,11 @@
 #include <components/esm4/loadcell.hpp>
 #include <components/esm4/loadland.hpp>
 #include <components/esm4/loadrefr.hpp>
+#include <components/misc/flathashmap.hpp>
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
+#include "../mwdialogue/infoindex.hpp"
 #include "../mwdialogue/keywordsearch.hpp"
 
 namespace ESM
@@ -57,6 +59,15 @@ namespace MWWorld
     {
     }; // Empty interface to be parent of all store types
 
+    /// A record read from a content file which is not inserted into its store yet.
+    struct PendingRecord
+    {
+        virtual ~PendingRecord() = default;
+
+        /// Insert the record into the store it has been read for.
+        virtual RecordId insert() = 0;
+    };
+
     template <class Id>
     class DynamicStoreBase : public StoreBase
     {
@@ -73,6 +84,18 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader& esm) = 0;
 
+        /// Read the current record without modifying the store, the record is inserted later by
+        /// PendingRecord::insert. Returns nullptr for stores which depend on their contents to read a record,
+        /// such records have to be read by load.
+        /// @note May be called concurrently as long as the store is not modified.
+        virtual std::unique_ptr<PendingRecord> parse(ESM::ESMReader& esm) { return nullptr; }
+
+        /// Whether parse supports records of this store.
+        virtual bool hasIndependentRecords() const { return false; }
+
+        /// Write the records loaded from the content files. Only stores with independent records support it.
+        virtual void writeStatic(ESM::ESMWriter& writer) const {}
+
         virtual bool eraseStatic(const Id& id) { return false; }
         virtual void clearDynamic() {}
 
@@ -198,6 +221,10 @@ namespace MWWorld
         std::vector<T*> mShared;
         typedef std::unordered_map<Id, T> Dynamic;
         Dynamic mDynamic;
+        // Flat index of mStatic built by setUp. Map nodes don't move, so the index is updated only when records are
+        // added or erased.
+        Misc::FlatHashMap<Id, const T*> mStaticIndex;
+        bool mHasStaticIndex = false;
 
         friend class ESMStore;
 
@@ -243,8 +270,14 @@ namespace MWWorld
         bool erase(const T& item);
 
         RecordId load(ESM::ESMReader& esm) override;
+        std::unique_ptr<PendingRecord> parse(ESM::ESMReader& esm) override;
+        bool hasIndependentRecords() const override { return !ESM::isESM4Rec(T::sRecordId); }
+        void writeStatic(ESM::ESMWriter& writer) const override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+
+    private:
+        RecordId insertLoaded(T&& record, bool isDeleted);
     };
 
     template <class T>
@@ -534,6 +567,8 @@ namespace MWWorld
         mutable bool mKeywordSearchModFlag;
         mutable MWDialogue::KeywordSearch<int /*unused*/> mKeywordSearch;
 
+        std::unordered_map<const ESM::Dialogue*, MWDialogue::InfoIndex> mInfoIndices;
+
     public:
         Store();
 
@@ -556,38 +591,36 @@ namespace MWWorld
         void listIdentifier(std::vector<ESM::RefId>& list) const override;
 
         const MWDialogue::KeywordSearch<int>& getDialogIdKeywordSearch() const;
+
+        /// @return nullptr if the dialogue was not set up yet
+        const MWDialogue::InfoIndex* getInfoIndex(const ESM::Dialogue& dialogue) const;
     };
 
     template <typename T>
     class ESM4RefsStore : public TypedDynamicStore<T, ESM::FormId>
     {
     public:
-        void preprocessReferences(const Store<ESM4::Cell>& cells)
-        {
-            for (auto& [_, ref] : this->mStatic)
-            {
-                const ESM4::Cell* cell = cells.find(ref.mParent);
-                if (cell->isExterior() && (cell->mFlags & ESM4::Rec_Persistent))
-                {
-                    const ESM4::Cell* actualCell = cells.searchExterior(
-                        positionToExteriorCellLocation(ref.mPos.pos[0], ref.mPos.pos[1], cell->mParent));
-                    if (actualCell)
-                        ref.mParent = actualCell->mId;
-                }
-                mPerCellReferences[ref.mParent].push_back(&ref);
-            }
-        }
+        /// Moves persistent references of exterior cells to the cells they are placed in and groups all
+        /// references by cell. Large stores are processed by multiple threads.
+        void preprocessReferences(const Store<ESM4::Cell>& cells);
 
         std::span<const T* const> getByCell(ESM::RefId cellId) const
         {
             auto it = mPerCellReferences.find(cellId);
             if (it == mPerCellReferences.end())
                 return {};
-            return it->second;
+            return std::span<const T* const>(mReferences).subspan(it->second.mOffset, it->second.mCount);
         }
 
     private:
-        std::unordered_map<ESM::RefId, std::vector<T*>> mPerCellReferences;
+        struct CellReferences
+        {
+            std::size_t mOffset = 0;
+            std::size_t mCount = 0;
+        };
+
+        std::vector<const T*> mReferences; // grouped by cell
+        std::unordered_map<ESM::RefId, CellReferences> mPerCellReferences;
     };
 
     template <>
@@ -62,9 +62,9 @@ namespace MWWorld
 
     template <typename T>
     T TimeOfDayInterpolator<T>::getValue(
-        const float gameHour, const TimeOfDaySettings& timeSettings, const std::string& prefix) const
+        const float gameHour, const TimeOfDaySettings& timeSettings, TimeOfDayTransition type) const
     {
-        WeatherSetting setting = timeSettings.getSetting(prefix);
+        const WeatherSetting& setting = timeSettings.getSetting(type);
         float preSunriseTime = setting.mPreSunriseTime;
         float postSunriseTime = setting.mPostSunriseTime;
         float preSunsetTime = setting.mPreSunsetTime;
@@ -558,10 +558,10 @@ namespace MWWorld
         mTimeSettings.mDayStart = mSunriseTime + mSunriseDuration;
         mTimeSettings.mDayEnd = mSunsetTime;
 
-        mTimeSettings.addSetting("Sky");
-        mTimeSettings.addSetting("Ambient");
-        mTimeSettings.addSetting("Fog");
-        mTimeSettings.addSetting("Sun");
+        mTimeSettings.addSetting(TimeOfDayTransition::Sky, "Sky");
+        mTimeSettings.addSetting(TimeOfDayTransition::Ambient, "Ambient");
+        mTimeSettings.addSetting(TimeOfDayTransition::Fog, "Fog");
+        mTimeSettings.addSetting(TimeOfDayTransition::Sun, "Sun");
 
         // Morrowind handles stars settings differently for other ones
         mTimeSettings.mStarsPostSunsetStart = Fallback::Map::getFloat("Weather_Stars_Post-Sunset_Start");
@@ -573,7 +573,7 @@ namespace MWWorld
             mTimeSettings.mStarsPostSunsetStart,
             mTimeSettings.mStarsFadingDuration - mTimeSettings.mStarsPostSunsetStart };
 
-        mTimeSettings.mSunriseTransitions["Stars"] = starSetting;
+        mTimeSettings.setSetting(TimeOfDayTransition::Stars, starSetting);
 
         mWeatherSettings.reserve(10);
         // These distant land fog factor and offset values are the defaults MGE XE provides. Should be
@@ -768,7 +768,7 @@ namespace MWWorld
             mRendering.setNight(is_night);
         }
 
-        float underwaterFog = mUnderwaterFog.getValue(time.getHour(), mTimeSettings, "Fog");
+        float underwaterFog = mUnderwaterFog.getValue(time.getHour(), mTimeSettings, TimeOfDayTransition::Fog);
 
         float peakHour = mSunriseTime + (mTimeSettings.mNightStart - mSunriseTime) / 2;
         float glareFade = 1.f;
@@ -1174,16 +1174,16 @@ namespace MWWorld
             || gameHour
                 > mTimeSettings.mNightStart + mTimeSettings.mStarsPostSunsetStart - mTimeSettings.mStarsFadingDuration);
 
-        mResult.mFogDepth = current.mLandFogDepth.getValue(gameHour, mTimeSettings, "Fog");
-        mResult.mFogColor = current.mFogColor.getValue(gameHour, mTimeSettings, "Fog");
-        mResult.mAmbientColor = current.mAmbientColor.getValue(gameHour, mTimeSettings, "Ambient");
-        mResult.mSunColor = current.mSunColor.getValue(gameHour, mTimeSettings, "Sun");
-        mResult.mSkyColor = current.mSkyColor.getValue(gameHour, mTimeSettings, "Sky");
-        mResult.mNightFade = mNightFade.getValue(gameHour, mTimeSettings, "Stars");
+        mResult.mFogDepth = current.mLandFogDepth.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Fog);
+        mResult.mFogColor = current.mFogColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Fog);
+        mResult.mAmbientColor = current.mAmbientColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Ambient);
+        mResult.mSunColor = current.mSunColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Sun);
+        mResult.mSkyColor = current.mSkyColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Sky);
+        mResult.mNightFade = mNightFade.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Stars);
         mResult.mDLFogFactor = current.mDL.FogFactor;
         mResult.mDLFogOffset = current.mDL.FogOffset;
 
-        WeatherSetting setting = mTimeSettings.getSetting("Sun");
+        const WeatherSetting& setting = mTimeSettings.getSetting(TimeOfDayTransition::Sun);
         float preSunsetTime = setting.mPreSunsetTime;
 
         if (gameHour >= mTimeSettings.mDayEnd - preSunsetTime)
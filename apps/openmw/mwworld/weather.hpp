@@ -1,9 +1,12 @@
 #ifndef GAME_MWWORLD_WEATHER_H
 #define GAME_MWWORLD_WEATHER_H
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 
 #include <osg/Vec4f>
 
@@ -56,6 +59,17 @@ namespace MWWorld
         float mPostSunsetTime;
     };
 
+    /// Groups of weather parameters sharing the sunrise and sunset transition times
+    enum class TimeOfDayTransition : std::size_t
+    {
+        Sky,
+        Ambient,
+        Fog,
+        Sun,
+        Stars,
+        Count
+    };
+
     struct TimeOfDaySettings
     {
         float mNightStart;
@@ -63,33 +77,31 @@ namespace MWWorld
         float mDayStart;
         float mDayEnd;
 
-        std::map<std::string, WeatherSetting> mSunriseTransitions;
+        // Resolved from the fallback settings once, the interpolators read them every frame
+        std::array<WeatherSetting, static_cast<std::size_t>(TimeOfDayTransition::Count)> mSunriseTransitions;
 
         float mStarsPostSunsetStart;
         float mStarsPreSunriseFinish;
         float mStarsFadingDuration;
 
-        WeatherSetting getSetting(const std::string& type) const
+        const WeatherSetting& getSetting(TimeOfDayTransition type) const
         {
-            std::map<std::string, WeatherSetting>::const_iterator it = mSunriseTransitions.find(type);
-            if (it != mSunriseTransitions.end())
-            {
-                return it->second;
-            }
-            else
-            {
-                return { 1.f, 1.f, 1.f, 1.f };
-            }
+            return mSunriseTransitions[static_cast<std::size_t>(type)];
         }
 
-        void addSetting(const std::string& type)
+        void setSetting(TimeOfDayTransition type, const WeatherSetting& setting)
         {
-            WeatherSetting setting = { Fallback::Map::getFloat("Weather_" + type + "_Pre-Sunrise_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Post-Sunrise_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Pre-Sunset_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Post-Sunset_Time") };
+            mSunriseTransitions[static_cast<std::size_t>(type)] = setting;
+        }
 
-            mSunriseTransitions[type] = setting;
+        void addSetting(TimeOfDayTransition type, std::string_view name)
+        {
+            const std::string prefix = "Weather_" + std::string(name);
+            setSetting(type,
+                { Fallback::Map::getFloat(prefix + "_Pre-Sunrise_Time"),
+                    Fallback::Map::getFloat(prefix + "_Post-Sunrise_Time"),
+                    Fallback::Map::getFloat(prefix + "_Pre-Sunset_Time"),
+                    Fallback::Map::getFloat(prefix + "_Post-Sunset_Time") });
         }
     };
 
@@ -107,7 +119,7 @@ namespace MWWorld
         {
         }
 
-        T getValue(const float gameHour, const TimeOfDaySettings& timeSettings, const std::string& prefix) const;
+        T getValue(const float gameHour, const TimeOfDaySettings& timeSettings, TimeOfDayTransition type) const;
 
     private:
         T mSunriseValue, mDayValue, mSunsetValue, mNightValue;
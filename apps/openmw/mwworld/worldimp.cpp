@@ -34,10 +34,13 @@
 #include <components/misc/mathutil.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/strings/algorithm.hpp>
 
 #include <components/files/collections.hpp>
 
 #include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapecache.hpp>
+#include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 
 #include <components/sceneutil/lightmanager.hpp>
@@ -102,6 +105,7 @@
 #include "projectilemanager.hpp"
 #include "weather.hpp"
 
+#include "contentcache.hpp"
 #include "contentloader.hpp"
 #include "esmloader.hpp"
 
@@ -277,6 +281,7 @@ namespace MWWorld
         const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
     {
         mContentFiles = contentFiles;
+        mSharedReaders.setEncoder(encoder != nullptr ? &encoder->getStatelessEncoder() : nullptr);
         mESMVersions.resize(mContentFiles.size(), -1);
 
         loadContentFiles(fileCollections, contentFiles, encoder, listener);
@@ -294,7 +299,9 @@ namespace MWWorld
     void World::init(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode, SceneUtil::WorkQueue* workQueue,
         SceneUtil::UnrefQueue& unrefQueue)
     {
-        mPhysics = std::make_unique<MWPhysics::PhysicsSystem>(mResourceSystem, rootNode);
+        mPhysics = std::make_unique<MWPhysics::PhysicsSystem>(mResourceSystem, rootNode, unrefQueue);
+        if (Settings::physics().mShapeCache)
+            mPhysics->getShapeManager()->setShapeCache(new Resource::BulletShapeCache(mUserDataPath / "shapecache"));
 
         if (Settings::navigator().mEnable)
         {
@@ -308,7 +315,10 @@ namespace MWWorld
         }
 
         mRendering = std::make_unique<MWRender::RenderingManager>(
-            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue);
+            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, mSharedReaders, unrefQueue);
+        if (Settings::terrain().mCompositeMapCache)
+            mRendering->setCompositeMapCache(mUserDataPath / "compositemaps");
+        mRendering->setInteriorVisibilityCache(mUserDataPath / "visibility");
         mProjectileManager = std::make_unique<ProjectileManager>(
             mRendering->getLightRoot()->asGroup(), mResourceSystem, mRendering.get(), mPhysics.get());
         mRendering->preloadCommonAssets();
@@ -432,6 +442,7 @@ namespace MWWorld
         }
 
         mDoorStates.clear();
+        mStoppedDoors.clear();
 
         mGoToJail = false;
         mTeleportEnabled = true;
@@ -710,15 +721,28 @@ namespace MWWorld
             return mPlayer->getPlayer();
         }
 
-        for (CellStore* cellstore : mWorldScene->getActiveCells())
-        {
-            // TODO: caching still doesn't work efficiently here (only works for the one CellStore that the reference is
-            // in)
-            Ptr ptr = cellstore->getPtr(name);
+        const auto searchActive = [&] {
+            for (CellStore* cellstore : mWorldScene->getActiveCells())
+            {
+                // TODO: caching still doesn't work efficiently here (only works for the one CellStore that the
+                // reference is in)
+                Ptr ptr = cellstore->getPtr(name);
 
-            if (!ptr.isEmpty())
-                return ptr;
+                if (!ptr.isEmpty())
+                    return ptr;
+            }
+            return Ptr();
+        };
+
+        ret = searchActive();
+        // The object may be in a cell of the grid that is not attached yet
+        if (ret.isEmpty() && mWorldScene->hasPendingCells())
+        {
+            mWorldScene->attachPendingCells();
+            ret = searchActive();
         }
+        if (!ret.isEmpty())
+            return ret;
 
         if (!activeOnly)
         {
@@ -1198,6 +1222,8 @@ namespace MWWorld
             }
         }
 
+        MWBase::Environment::get().getMechanicsManager()->updatePosition(newPtr);
+
         if (isPlayer)
             mWorldScene->playerMoved(position);
         else
@@ -1262,6 +1288,16 @@ namespace MWWorld
             updateNavigatorObject(*object);
     }
 
+    void World::beginBatchedUpdate()
+    {
+        mPhysics->beginBatchedUpdate();
+    }
+
+    void World::endBatchedUpdate()
+    {
+        mPhysics->endBatchedUpdate();
+    }
+
     void World::rotateObject(const Ptr& ptr, const osg::Vec3f& rot, MWBase::RotationFlags flags)
     {
         ESM::Position pos = ptr.getRefData().getPosition();
@@ -1492,9 +1528,12 @@ namespace MWWorld
                 updateNavigatorObject(*object, navigatorUpdateGuard.get());
         });
 
-        for (const auto& door : mDoorStates)
-            if (const auto object = mPhysics->getObject(door.first))
+        // Moving doors are not updated every frame to avoid rebuilding the same tiles while they rotate. Actors pass
+        // through them using off-mesh connections, so the navmesh needs only the final door position.
+        for (const MWWorld::Ptr& door : mStoppedDoors)
+            if (const auto object = mPhysics->getObject(door))
                 updateNavigatorObject(*object, navigatorUpdateGuard.get());
+        mStoppedDoors.clear();
 
         mNavigator->update(getPlayerPtr().getRefData().getPosition().asVec3(), navigatorUpdateGuard.get());
     }
@@ -1609,6 +1648,7 @@ namespace MWWorld
                 {
                     // Mark as non-moving
                     it->first.getClass().setDoorState(it->first, MWWorld::DoorState::Idle);
+                    mStoppedDoors.push_back(it->first);
                     mDoorStates.erase(it++);
                 }
                 else
@@ -2416,6 +2456,7 @@ namespace MWWorld
         {
             mDoorStates.erase(door);
             rotateDoor(door, state, 1);
+            mStoppedDoors.push_back(door);
         }
     }
 
@@ -2851,6 +2892,33 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
+        std::vector<std::pair<std::filesystem::path, int>> esmFiles;
+        std::vector<std::filesystem::path> contentPaths;
+        for (std::size_t i = 0; i < content.size(); ++i)
+        {
+            const auto filename = Files::pathFromUnicodeString(content[i]);
+            const std::string extension = Files::pathToUnicodeString(filename.extension());
+            const Files::MultiDirCollection& col = fileCollections.getCollection(extension);
+            if (!col.doesExist(content[i]))
+                continue;
+            contentPaths.push_back(col.getPath(content[i]));
+            if (!Misc::StringUtils::ciEqual(extension, ".omwscripts"))
+                esmFiles.emplace_back(contentPaths.back(), static_cast<int>(i));
+        }
+
+        const bool useContentCache = Settings::general().mContentCache;
+        const std::filesystem::path contentCachePath = mUserDataPath / "content.cache";
+        mContentKey = makeContentCacheKey(contentPaths, encoder);
+        bool contentCacheLoaded = false;
+        if (useContentCache)
+        {
+            contentCacheLoaded = readContentCache(contentCachePath, mContentKey, mStore);
+            esmLoader.setSkipIndependentRecords(contentCacheLoaded);
+        }
+
+        if (const int threads = Settings::general().mContentLoadingThreads; threads > 0 && !contentCacheLoaded)
+            esmLoader.prepare(std::move(esmFiles), static_cast<std::size_t>(threads));
+
         int idx = 0;
         for (const std::string& file : content)
         {
@@ -2869,6 +2937,9 @@ namespace MWWorld
             idx++;
         }
 
+        if (useContentCache && !contentCacheLoaded)
+            writeContentCache(contentCachePath, mContentKey, mStore);
+
         if (const auto v = esmLoader.getMasterFileFormat(); v.has_value() && *v == 0)
             ensureNeededRecords(); // Insert records that may not be present in all versions of master files.
     }
@@ -3270,7 +3341,9 @@ namespace MWWorld
 
     void World::rest(double hours)
     {
-        mWorldModel.forEachLoadedCellStore([hours](CellStore& store) { store.rest(hours); });
+        std::vector<Ptr> actors;
+        mWorldModel.forEachLoadedCellStore([&](CellStore& store) { store.collectRestingActors(actors); });
+        MWBase::Environment::get().getMechanicsManager()->restoreDynamicStats(actors, hours, true);
     }
 
     void World::rechargeItems(double duration, bool activeOnly)
@@ -3794,6 +3867,8 @@ namespace MWWorld
         DetourNavigator::reportStats(mNavigator->getStats(), frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
         mWorldScene->reportStats(frameNumber, stats);
+        mStore.reportStats(frameNumber, stats);
+        mWorldModel.reportStats(frameNumber, stats);
     }
 
     void World::updateSkyDate()
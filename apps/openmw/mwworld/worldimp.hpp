@@ -5,6 +5,7 @@
 #include <osg/ref_ptr>
 
 #include <components/esm3/readerscache.hpp>
+#include <components/esm3/sharedreaders.hpp>
 #include <components/misc/rng.hpp>
 #include <components/settings/settings.hpp>
 
@@ -86,6 +87,7 @@ namespace MWWorld
         Resource::ResourceSystem* mResourceSystem;
 
         ESM::ReadersCache mReaders;
+        ESM::SharedReaders mSharedReaders;
         MWWorld::ESMStore mStore;
         GroundcoverStore mGroundcoverStore;
         LocalScripts mLocalScripts;
@@ -110,6 +112,7 @@ namespace MWWorld
         bool mScriptsEnabled;
         bool mDiscardMovements;
         std::vector<std::string> mContentFiles;
+        std::string mContentKey;
 
         std::filesystem::path mUserDataPath;
 
@@ -133,6 +136,9 @@ namespace MWWorld
         std::map<MWWorld::Ptr, MWWorld::DoorState> mDoorStates;
         ///< only holds doors that are currently moving. 1 = opening, 2 = closing
 
+        std::vector<MWWorld::Ptr> mStoppedDoors;
+        ///< doors that stopped moving since the last navigator update
+
         uint32_t mRandomSeed{};
 
         // not implemented
@@ -241,6 +247,9 @@ namespace MWWorld
 
         const MWWorld::ESMStore& getStore() const override { return mStore; }
 
+        /// Readers of the loaded content files for the worker threads.
+        ESM::SharedReaders& getSharedReaders() { return mSharedReaders; }
+
         const std::vector<int>& getESMVersions() const override;
 
         LocalScripts& getLocalScripts() override;
@@ -371,6 +380,9 @@ namespace MWWorld
         void rotateObject(const Ptr& ptr, const osg::Vec3f& rot,
             MWBase::RotationFlags flags = MWBase::RotationFlag_inverseOrder) override;
 
+        void beginBatchedUpdate() override;
+        void endBatchedUpdate() override;
+
         MWWorld::Ptr placeObject(
             const MWWorld::ConstPtr& ptr, MWWorld::CellStore* cell, const ESM::Position& pos) override;
         ///< Place an object. Makes a copy of the Ptr.
@@ -567,6 +579,10 @@ namespace MWWorld
         void applyLoopingParticles(const MWWorld::Ptr& ptr) const override;
 
         const std::vector<std::string>& getContentFiles() const override;
+
+        /// Identifies the loaded content files, see makeContentCacheKey
+        const std::string& getContentKey() const { return mContentKey; }
+
         void breakInvisibility(const MWWorld::Ptr& actor) override;
 
         // Allow NPCs to use torches?
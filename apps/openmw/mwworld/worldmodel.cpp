@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <optional>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/defs.hpp>
@@ -14,8 +17,11 @@
 #include <components/esm3/loadregn.hpp>
 #include <components/esm4/loadwrld.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
+#include <components/misc/hash.hpp>
 #include <components/settings/values.hpp>
 
+#include <osg/Stats>
+
 #include "cellstore.hpp"
 #include "esmstore.hpp"
 
@@ -101,9 +107,35 @@ namespace MWWorld
                 return Cell(*cell);
             return std::nullopt;
         }
+
+        bool hasMovedReferences(const std::vector<char>& data)
+        {
+            constexpr std::size_t headerSize = ESM::NAME::sCapacity + sizeof(std::uint32_t);
+            std::size_t offset = 0;
+            while (offset + headerSize <= data.size())
+            {
+                if (std::memcmp(data.data() + offset, "MVRF", ESM::NAME::sCapacity) == 0)
+                    return true;
+                std::uint32_t size = 0;
+                std::memcpy(&size, data.data() + offset + ESM::NAME::sCapacity, sizeof(size));
+                offset += headerSize + size;
+            }
+            return false;
+        }
     }
 }
 
+std::size_t MWWorld::WorldModel::ExteriorCellLocationHash::operator()(
+    const ESM::ExteriorCellLocation& location) const
+{
+    // Both coordinates are packed into one value to avoid collisions between the cells of the same worldspace
+    const std::uint64_t coordinates = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(location.mX)) << 32)
+        | static_cast<std::uint32_t>(location.mY);
+    std::size_t seed = static_cast<std::size_t>(coordinates);
+    Misc::hashCombine(seed, location.mWorldspace);
+    return seed;
+}
+
 MWWorld::CellStore& MWWorld::WorldModel::getOrInsertCellStore(const ESM::Cell& cell)
 {
     const auto it = mCells.find(cell.mId);
@@ -129,6 +161,7 @@ void MWWorld::WorldModel::clear()
     mInteriors.clear();
     mExteriors.clear();
     mCells.clear();
+    mSavedContentFileMapping.reset();
     std::fill(mIdCache.begin(), mIdCache.end(), std::make_pair(ESM::RefId(), (MWWorld::CellStore*)nullptr));
     mIdCacheIndex = 0;
 }
@@ -150,7 +183,9 @@ MWWorld::Ptr MWWorld::WorldModel::getPtrAndCache(const ESM::RefId& name, CellSto
 
 void MWWorld::WorldModel::writeCell(ESM::ESMWriter& writer, CellStore& cell) const
 {
-    if (cell.getState() != CellStore::State_Loaded)
+    // References that were not needed since the game was loaded are saved again without reading them
+    const bool writeSavedReferences = cell.canWriteSavedReferences();
+    if (!writeSavedReferences && cell.getState() != CellStore::State_Loaded)
         cell.load();
 
     ESM::CellState cellState;
@@ -162,7 +197,10 @@ void MWWorld::WorldModel::writeCell(ESM::ESMWriter& writer, CellStore& cell) con
     writer.writeCellId(cellState.mId);
     cellState.save(writer);
     cell.writeFog(writer);
-    cell.writeReferences(writer);
+    if (writeSavedReferences)
+        cell.writeSavedReferences(writer);
+    else
+        cell.writeReferences(writer);
     writer.endRecord(ESM::REC_CSTA);
 }
 
@@ -178,10 +216,10 @@ namespace MWWorld
 {
     CellStore& WorldModel::getExterior(ESM::ExteriorCellLocation location, bool forceLoad) const
     {
-        const auto it = mExteriors.find(location);
+        CellStore* const* const found = mExteriors.find(location);
         CellStore* cellStore = nullptr;
 
-        if (it == mExteriors.end())
+        if (found == nullptr)
         {
             auto [cell, created] = createExteriorCell(location, mStore);
             const ESM::RefId id = cell.getId();
@@ -192,8 +230,8 @@ namespace MWWorld
         }
         else
         {
-            assert(it->second != nullptr);
-            cellStore = it->second;
+            assert(*found != nullptr);
+            cellStore = *found;
         }
 
         if (forceLoad && cellStore->getState() != CellStore::State_Loaded)
@@ -204,10 +242,10 @@ namespace MWWorld
 
     CellStore* WorldModel::findInterior(std::string_view name, bool forceLoad) const
     {
-        const auto it = mInteriors.find(name);
+        CellStore* const* const found = mInteriors.find(name);
         CellStore* cellStore = nullptr;
 
-        if (it == mInteriors.end())
+        if (found == nullptr)
         {
             cellStore = emplaceInteriorCellStore(name, mStore, mReaders, mCells);
             if (cellStore == nullptr)
@@ -216,8 +254,8 @@ namespace MWWorld
         }
         else
         {
-            assert(it->second != nullptr);
-            cellStore = it->second;
+            assert(*found != nullptr);
+            cellStore = *found;
         }
 
         if (forceLoad && cellStore->getState() != CellStore::State_Loaded)
@@ -353,16 +391,21 @@ MWWorld::Ptr MWWorld::WorldModel::getPtrByRefId(const ESM::RefId& name)
     // Then check cells that are already listed
     // Search in reverse, this is a workaround for an ambiguous chargen_plank reference in the vanilla game.
     // there is one at -22,16 and one at -2,-9, the latter should be used.
-    for (auto iter = mExteriors.rbegin(); iter != mExteriors.rend(); ++iter)
+    std::vector<std::pair<ESM::ExteriorCellLocation, CellStore*>> exteriors(mExteriors.begin(), mExteriors.end());
+    std::sort(exteriors.begin(), exteriors.end(), [](const auto& l, const auto& r) { return r.first < l.first; });
+    for (const auto& [location, cellStore] : exteriors)
     {
-        Ptr ptr = getPtrAndCache(name, *iter->second);
+        Ptr ptr = getPtrAndCache(name, *cellStore);
         if (!ptr.isEmpty())
             return ptr;
     }
 
-    for (auto iter = mInteriors.begin(); iter != mInteriors.end(); ++iter)
+    std::vector<std::pair<std::string_view, CellStore*>> interiors(mInteriors.begin(), mInteriors.end());
+    std::sort(interiors.begin(), interiors.end(),
+        [](const auto& l, const auto& r) { return Misc::StringUtils::ciLess(l.first, r.first); });
+    for (const auto& [cellName, cellStore] : interiors)
     {
-        Ptr ptr = getPtrAndCache(name, *iter->second);
+        Ptr ptr = getPtrAndCache(name, *cellStore);
         if (!ptr.isEmpty())
             return ptr;
     }
@@ -447,6 +490,20 @@ void MWWorld::WorldModel::write(ESM::ESMWriter& writer, Loading::Listener& progr
         }
 }
 
+void MWWorld::WorldModel::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+{
+    CellStore::MemoryUsage total;
+    for (const auto& [id, cellStore] : mCells)
+    {
+        const CellStore::MemoryUsage usage = cellStore.getMemoryUsage();
+        total.mRefs += usage.mRefs;
+        total.mBytes += usage.mBytes;
+    }
+    stats.setAttribute(frameNumber, "CellStore Count", static_cast<double>(mCells.size()));
+    stats.setAttribute(frameNumber, "CellStore References", static_cast<double>(total.mRefs));
+    stats.setAttribute(frameNumber, "CellStore Bytes", static_cast<double>(total.mBytes));
+}
+
 struct GetCellStoreCallback : public MWWorld::CellStore::GetCellStoreCallback
 {
 public:
@@ -467,7 +524,8 @@ bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type)
         ESM::CellState state;
         state.mId = reader.getCellId();
 
-        CellStore* const cellStore = findCell(state.mId);
+        const bool lazy = Settings::saves().mLazyCellReferences;
+        CellStore* const cellStore = findCell(state.mId, !lazy);
         if (cellStore == nullptr)
         {
             Log(Debug::Warning) << "Dropping state for cell " << state.mId << " (cell no longer exists)";
@@ -481,6 +539,22 @@ bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type)
         if (state.mHasFogOfWar)
             cellStore->readFog(reader);
 
+        if (lazy)
+        {
+            if (mSavedContentFileMapping == nullptr && reader.getContentFileMapping() != nullptr)
+                mSavedContentFileMapping = std::make_shared<const std::map<int, int>>(*reader.getContentFileMapping());
+            std::vector<char> data = reader.getRecordData();
+            const bool hasMoved = hasMovedReferences(data);
+            cellStore->deferReferences(CellStore::SavedReferences{ .mData = std::move(data),
+                .mFileName = reader.getName(),
+                .mFormatVersion = reader.getFormatVersion(),
+                .mContentFileMapping = mSavedContentFileMapping });
+            // Moved references have to be read right away to be found in the cells they were moved to
+            if (hasMoved && cellStore->getState() != CellStore::State_Loaded)
+                cellStore->load();
+            return true;
+        }
+
         if (cellStore->getState() != CellStore::State_Loaded)
             cellStore->load();
 
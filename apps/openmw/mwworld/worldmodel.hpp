@@ -3,12 +3,15 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 
 #include <components/esm/exteriorcelllocation.hpp>
 #include <components/misc/algorithm.hpp>
+#include <components/misc/flathashmap.hpp>
+#include <components/misc/strings/algorithm.hpp>
 
 #include "cellstore.hpp"
 #include "ptr.hpp"
@@ -32,6 +35,11 @@ namespace Loading
     class Listener;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     class ESMStore;
@@ -90,6 +98,8 @@ namespace MWWorld
                 fn(store);
         }
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         /// Get all Ptrs referencing \a name in exterior cells
         /// @note Due to the current implementation of getPtr this only supports one Ptr per cell.
         /// @note name must be lower case
@@ -109,11 +119,18 @@ namespace MWWorld
         MWWorld::ESMStore& mStore;
         ESM::ReadersCache& mReaders;
         mutable std::unordered_map<ESM::RefId, CellStore> mCells;
-        mutable std::map<std::string, CellStore*, Misc::StringUtils::CiComp> mInteriors;
-        mutable std::map<ESM::ExteriorCellLocation, CellStore*> mExteriors;
+        struct ExteriorCellLocationHash
+        {
+            std::size_t operator()(const ESM::ExteriorCellLocation& location) const;
+        };
+
+        mutable Misc::FlatHashMap<std::string, CellStore*, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>
+            mInteriors;
+        mutable Misc::FlatHashMap<ESM::ExteriorCellLocation, CellStore*, ExteriorCellLocationHash> mExteriors;
         ESM::Cell mDraftCell;
         std::vector<std::pair<ESM::RefId, CellStore*>> mIdCache;
         std::size_t mIdCacheIndex = 0;
+        std::shared_ptr<const std::map<int, int>> mSavedContentFileMapping;
 
         CellStore& getOrInsertCellStore(const ESM::Cell& cell);
 
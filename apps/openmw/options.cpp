@@ -102,6 +102,29 @@ namespace OpenMW
         addOption("random-seed", bpo::value<unsigned int>()->default_value(Misc::Rng::generateDefaultSeed()),
             "seed value for random number generator");
 
+        addOption("record-input", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "record player input, frame durations and random seed into a file to replay them later");
+
+        addOption("replay-input", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "replay input recorded with the same build instead of the player one and quit when it's over "
+            "(overrides random-seed)");
+
+        addOption("hidden-window", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "render into a window which is never shown");
+
+        addOption("stats-export", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "write stats attributes into a file while running");
+
+        addOption("stats-export-format", bpo::value<std::string>()->default_value("csv"),
+            "format of the stats export file: csv or line-protocol");
+
+        addOption("stats-export-interval", bpo::value<unsigned int>()->default_value(1),
+            "number of frames between the exported stats records");
+
+        addOption("stats-export-attribute",
+            bpo::value<StringsVector>()->default_value(StringsVector(), "")->multitoken()->composing(),
+            "stats attribute to export (frame timings, Lua, caches, navmesh jobs and preloader counters by default)");
+
         return desc;
     }
 }
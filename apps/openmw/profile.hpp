@@ -4,6 +4,8 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
+#include <components/debug/tracing.hpp>
+
 #include <cstddef>
 #include <string>
 
@@ -31,6 +33,7 @@ namespace OMW
         Sound,
         State,
         Script,
+        LocalScripts,
         Mechanics,
         Physics,
         PhysicsWorker,
@@ -60,6 +63,9 @@ namespace OMW
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Script>::sValue{ "Script", "script" };
 
+    template <>
+    inline const UserStats UserStatsValue<UserStatsType::LocalScripts>::sValue{ " -Local", "localscripts" };
+
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Mechanics>::sValue{ "Mech", "mechanics" };
 
@@ -142,6 +148,9 @@ namespace OMW
         }
 
     private:
+#ifdef OPENMW_TRACING
+        const Debug::Tracing::ScopedZone mZone{ UserStatsValue<type>::sValue.mLabel.c_str() };
+#endif
         const osg::Timer_t mScopeStart;
         const osg::Timer_t mFrameStart;
         const unsigned int mFrameNumber;
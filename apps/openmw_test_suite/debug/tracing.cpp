@@ -0,0 +1,61 @@
+#include <components/debug/tracing.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Debug::Tracing;
+
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::ostringstream result;
+        result << file.rdbuf();
+        return std::move(result).str();
+    }
+
+    TEST(DebugTracingTest, shouldWriteZonesFromAllThreads)
+    {
+        const auto path = outputFilePath("tracing_test.json");
+        start(path);
+        {
+            const ScopedZone zone("mainZone");
+            std::thread([] {
+                setThreadName("Test worker");
+                const ScopedZone zone("workerZone");
+            }).join();
+        }
+        stop();
+        const std::string trace = readFile(path);
+        EXPECT_THAT(trace, HasSubstr(R"({"name":"mainZone","ph":"X")"));
+        EXPECT_THAT(trace, HasSubstr(R"({"name":"workerZone","ph":"X")"));
+        EXPECT_THAT(trace, HasSubstr(R"("args":{"name":"Test worker"})"));
+    }
+
+    TEST(DebugTracingTest, shouldNotRecordZonesWhenStopped)
+    {
+        const auto path = outputFilePath("tracing_stopped_test.json");
+        {
+            const ScopedZone zone("ignoredZone");
+        }
+        start(path);
+        {
+            const ScopedZone zone("recordedZone");
+        }
+        stop();
+        const std::string trace = readFile(path);
+        EXPECT_THAT(trace, HasSubstr("recordedZone"));
+        EXPECT_THAT(trace, Not(HasSubstr("ignoredZone")));
+        EXPECT_FALSE(isEnabled());
+    }
+}
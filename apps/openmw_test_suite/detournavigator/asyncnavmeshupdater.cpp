@@ -153,6 +153,42 @@ namespace
         EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_should_commit_all_tiles_written_to_db_in_transactions)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                addHeightFieldPlane(mRecastMeshManager, osg::Vec2i(x, y));
+        addObject(mBox, mRecastMeshManager);
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb* const dbPtr = db.get();
+        mSettings.mMaxDbTransactionWrites = 4;
+        mSettings.mMaxDbTransactionDuration = std::chrono::hours(1);
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db));
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(1, mSettings);
+        std::map<TilePosition, ChangeType> changedTiles;
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                changedTiles.emplace(TilePosition{ x, y }, ChangeType::add);
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        updater.stop();
+        for (const auto& [tilePosition, changeType] : changedTiles)
+        {
+            const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+            ASSERT_NE(recastMesh, nullptr);
+            const auto objects = makeDbRefGeometryObjects(
+                recastMesh->getMeshSources(), [&](const MeshSource& v) { return resolveMeshSource(*dbPtr, v); });
+            ASSERT_TRUE(std::holds_alternative<std::vector<DbRefGeometryObject>>(objects));
+            const auto input = serialize(
+                mSettings.mRecast, mAgentBounds, *recastMesh, std::get<std::vector<DbRefGeometryObject>>(objects));
+            EXPECT_TRUE(dbPtr->findTile(mWorldspace, tilePosition, input).has_value())
+                << tilePosition.x() << " " << tilePosition.y();
+        }
+        // Fails when a transaction is still open
+        EXPECT_NO_THROW(dbPtr->startTransaction().commit());
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_when_writing_to_db_disabled_should_not_write_tiles)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
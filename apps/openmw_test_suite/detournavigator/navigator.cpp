@@ -146,6 +146,14 @@ namespace
             Status::StartPolygonNotFound);
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_path_with_no_navmesh_tiles_should_be_counted_as_missing_tile_query)
+    {
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        ASSERT_EQ(findPath(*mNavigator, mAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+            Status::StartPolygonNotFound);
+        EXPECT_EQ(mNavigator->getStats().mMissingTilePathQueries, 1);
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_agent_should_count_each_agent)
     {
         ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
@@ -175,6 +183,7 @@ namespace
                 Vec3fEq(56.66664886474609375, 460, 1.99999392032623291015625),
                 Vec3fEq(460, 56.66664886474609375, 1.99999392032623291015625)))
             << mPath;
+        EXPECT_EQ(mNavigator->getStats().mMissingTilePathQueries, 0);
     }
 
     TEST_F(DetourNavigatorNavigatorTest, find_path_to_the_start_position_should_contain_single_point)
@@ -1059,6 +1068,23 @@ namespace
             std::nullopt);
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, agents_with_similar_bounds_should_share_nav_mesh)
+    {
+        mSettings.mAgentBoundsStep = 8;
+        NavigatorImpl navigator(mSettings, nullptr);
+        const AgentBounds smaller{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const AgentBounds bigger{ CollisionShapeType::Aabb, { 31, 31, 70 } };
+        const AgentBounds different{ CollisionShapeType::Aabb, { 41, 41, 66 } };
+
+        ASSERT_TRUE(navigator.addAgent(smaller));
+        ASSERT_TRUE(navigator.addAgent(bigger));
+        ASSERT_TRUE(navigator.addAgent(different));
+
+        EXPECT_EQ(navigator.getNavMesh(smaller), navigator.getNavMesh(bigger));
+        EXPECT_NE(navigator.getNavMesh(smaller), navigator.getNavMesh(different));
+        EXPECT_EQ(navigator.getStats().mNavMeshes, 2);
+    }
+
     struct DetourNavigatorUpdateTest : TestWithParam<std::function<void(Navigator&)>>
     {
     };
@@ -1,3 +1,4 @@
+#include "../testing_util.hpp"
 #include "generate.hpp"
 
 #include <components/detournavigator/navmeshdb.hpp>
@@ -7,8 +8,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
 #include <limits>
 #include <random>
+#include <string>
 
 namespace
 {
@@ -167,6 +170,113 @@ namespace
                     << "x=" << x << " y=" << y;
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, merge_should_add_missing_shapes_and_tiles)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("merged_navmesh.db");
+        std::filesystem::remove(path);
+        const std::string hash = "hash";
+        const Sqlite3::ConstBlob hashData{ hash.data(), static_cast<int>(hash.size()) };
+        const TilePosition tilePosition{ 5, 6 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        const Tile existing = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        {
+            NavMeshDb other(path.string(), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_EQ(other.insertShape(ShapeId{ 1 }, "mesh.nif", ShapeType::Collision, hashData), 1);
+            ASSERT_EQ(other.insertTile(TileId{ 1 }, existing.mWorldspace, existing.mTilePosition, TileVersion{ 1 },
+                          existing.mInput, existing.mData),
+                1);
+            ASSERT_EQ(
+                other.insertTile(TileId{ 2 }, existing.mWorldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+        }
+        const NavMeshDbMergeStats stats = mDb.merge(path.string());
+        EXPECT_EQ(stats.mShapes, 1);
+        EXPECT_EQ(stats.mTiles, 1);
+        EXPECT_EQ(mDb.findShapeId("mesh.nif", ShapeType::Collision, hashData), ShapeId{ 1 });
+        const auto tile = mDb.getTileData(existing.mWorldspace, tilePosition, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 3 });
+        EXPECT_EQ(tile->mData, data);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, merge_with_different_shape_ids_should_throw_exception_and_not_add_tiles)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("merged_navmesh_with_conflict.db");
+        std::filesystem::remove(path);
+        const std::string hash = "hash";
+        const Sqlite3::ConstBlob hashData{ hash.data(), static_cast<int>(hash.size()) };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 5, 6 };
+        const std::vector<std::byte> input = generateData();
+        ASSERT_EQ(mDb.insertShape(ShapeId{ 1 }, "mesh.nif", ShapeType::Collision, hashData), 1);
+        {
+            NavMeshDb other(path.string(), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_EQ(other.insertShape(ShapeId{ 1 }, "other.nif", ShapeType::Collision, hashData), 1);
+            ASSERT_EQ(
+                other.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, generateData()), 1);
+        }
+        EXPECT_THROW(mDb.merge(path.string()), std::runtime_error);
+        EXPECT_FALSE(mDb.findTile(worldspace, tilePosition, input).has_value());
+        EXPECT_FALSE(mDb.findShapeId("other.nif", ShapeType::Collision, hashData).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, inserted_cells_should_be_returned_for_their_worldspace)
+    {
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const ESM::RefId otherWorldspace = ESM::RefId::stringRefId("other");
+        const CellInput cell{
+            .mCellPosition = osg::Vec2i(1, -2),
+            .mHash = generateData(),
+            .mTilesRange = TilesPositionsRange{ .mBegin = TilePosition(-1, -2), .mEnd = TilePosition(3, 4) },
+        };
+        ASSERT_EQ(mDb.insertCell(worldspace, cell), 1);
+        ASSERT_EQ(mDb.insertCell(otherWorldspace,
+                      CellInput{ .mCellPosition = osg::Vec2i(5, 6), .mHash = generateData(), .mTilesRange = {} }),
+            1);
+        const std::vector<CellInput> cells = mDb.getCells(worldspace);
+        ASSERT_EQ(cells.size(), 1);
+        EXPECT_EQ(cells[0].mCellPosition, cell.mCellPosition);
+        EXPECT_EQ(cells[0].mHash, cell.mHash);
+        EXPECT_EQ(cells[0].mTilesRange, cell.mTilesRange);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, delete_cells_should_remove_only_cells_of_given_worldspace)
+    {
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const ESM::RefId otherWorldspace = ESM::RefId::stringRefId("other");
+        const CellInput cell{ .mCellPosition = osg::Vec2i(1, 2), .mHash = generateData(), .mTilesRange = {} };
+        ASSERT_EQ(mDb.insertCell(worldspace, cell), 1);
+        ASSERT_EQ(mDb.insertCell(otherWorldspace, cell), 1);
+        EXPECT_EQ(mDb.deleteCells(worldspace), 1);
+        EXPECT_THAT(mDb.getCells(worldspace), IsEmpty());
+        EXPECT_EQ(mDb.getCells(otherWorldspace).size(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, in_memory_db_should_have_empty_path)
+    {
+        EXPECT_EQ(mDb.getPath(), "");
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, read_only_db_should_get_tiles_committed_by_other_connection)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("read_only_navmesh.db");
+        std::filesystem::remove(path);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        NavMeshDb writer(path.string(), std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb reader(writer.getPath(), 0, NavMeshDbMode::ReadOnly);
+        EXPECT_FALSE(reader.getTileData(worldspace, tilePosition, input).has_value());
+        ASSERT_EQ(writer.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+        const auto tile = reader.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 1 });
+        EXPECT_EQ(tile->mData, data);
+        EXPECT_THROW(reader.insertTile(TileId{ 2 }, worldspace, TilePosition{ 5, 6 }, TileVersion{ 1 }, input, data),
+            std::runtime_error);
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, should_support_file_size_limit)
     {
         mDb = NavMeshDb(":memory:", 4096);
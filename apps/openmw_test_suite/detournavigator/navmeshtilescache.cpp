@@ -150,6 +150,23 @@ namespace
         EXPECT_EQ(result.get(), *sameCopy);
     }
 
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, set_existing_element_should_not_replace_other_unused_values)
+    {
+        const std::size_t maxSize = 2 * (mRecastMeshWithWaterSize + mPreparedNavMeshDataSize);
+        NavMeshTilesCache cache(maxSize);
+
+        const std::vector<CellWater> water(1, CellWater{ osg::Vec2i(), Water{ 1, 0.0f } });
+        const RecastMesh anotherRecastMesh(mVersion, mMesh, water, mHeightfields, mFlatHeightfields, mSources);
+        auto anotherPreparedNavMeshData = makePeparedNavMeshData(3);
+        auto copy = clone(*mPreparedNavMeshData);
+
+        ASSERT_TRUE(
+            cache.set(mAgentBounds, mTilePosition, anotherRecastMesh, std::move(anotherPreparedNavMeshData)));
+        ASSERT_TRUE(cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData)));
+        ASSERT_TRUE(cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(copy)));
+        EXPECT_TRUE(cache.get(mAgentBounds, mTilePosition, anotherRecastMesh));
+    }
+
     TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_should_return_cached_value)
     {
         const std::size_t maxSize = mRecastMeshSize + mPreparedNavMeshDataSize;
@@ -0,0 +1,154 @@
+#include <components/detournavigator/pathcache.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorPathCacheTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents{ 29, 29, 66 };
+        const PathCacheKey mKey
+            = makePathCacheKey(osg::Vec3f(1, 2, 3), osg::Vec3f(100, 200, 3), Flag_walk, {}, 0, mAgentHalfExtents);
+        const Version mNavMeshVersion{ 1, 1 };
+        const TilePosition mTilePosition{ 0, 0 };
+        std::map<TilePosition, Version> mTileVersions{ { mTilePosition, Version{ 1, 1 } } };
+
+        std::optional<Version> getTileVersion(const TilePosition& position) const
+        {
+            const auto it = mTileVersions.find(position);
+            if (it == mTileVersions.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        const CachedPath* find(PathCache& cache, const PathCacheKey& key, const Version& navMeshVersion) const
+        {
+            return cache.find(key, navMeshVersion, [&](const TilePosition& v) { return getTileVersion(v); });
+        }
+
+        CachedPath makePath(Status status = Status::Success) const
+        {
+            return CachedPath{
+                .mStatus = status,
+                .mPath = { osg::Vec3f(1, 2, 3), osg::Vec3f(100, 200, 3) },
+                .mTiles = { CachedPathTile{ mTilePosition, getTileVersion(mTilePosition) } },
+                .mNavMeshVersion = status == Status::PartialPath ? std::optional(mNavMeshVersion) : std::nullopt,
+            };
+        }
+    };
+
+    TEST_F(DetourNavigatorPathCacheTest, find_for_empty_should_return_null)
+    {
+        PathCache cache(1);
+        EXPECT_EQ(find(cache, mKey, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_inserted_path)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        const CachedPath* const result = find(cache, mKey, mNavMeshVersion);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->mStatus, Status::Success);
+        EXPECT_THAT(result->mPath, ElementsAre(osg::Vec3f(1, 2, 3), osg::Vec3f(100, 200, 3)));
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_path_for_close_positions)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        const PathCacheKey key
+            = makePathCacheKey(osg::Vec3f(2, 3, 4), osg::Vec3f(101, 201, 4), Flag_walk, {}, 0, mAgentHalfExtents);
+        EXPECT_NE(find(cache, key, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_null_for_different_flags)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        const PathCacheKey key
+            = makePathCacheKey(osg::Vec3f(1, 2, 3), osg::Vec3f(100, 200, 3), Flag_swim, {}, 0, mAgentHalfExtents);
+        EXPECT_EQ(find(cache, key, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_null_for_different_agent_half_extents)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        const PathCacheKey key
+            = makePathCacheKey(osg::Vec3f(1, 2, 3), osg::Vec3f(100, 200, 3), Flag_walk, {}, 0, osg::Vec3f(32, 32, 66));
+        EXPECT_EQ(find(cache, key, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_null_when_path_tile_is_changed)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        mTileVersions[mTilePosition].mRevision += 1;
+        EXPECT_EQ(find(cache, mKey, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_null_when_path_tile_is_removed)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        mTileVersions.clear();
+        EXPECT_EQ(find(cache, mKey, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_success_path_when_other_tile_is_changed)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath());
+        mTileVersions[TilePosition(1, 1)] = Version{ 1, 2 };
+        EXPECT_NE(find(cache, mKey, Version{ 1, 2 }), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, find_should_return_null_for_partial_path_when_navmesh_is_changed)
+    {
+        PathCache cache(1);
+        cache.insert(mKey, makePath(Status::PartialPath));
+        EXPECT_EQ(find(cache, mKey, Version{ 1, 2 }), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, insert_should_evict_least_recently_used)
+    {
+        PathCache cache(2);
+        const PathCacheKey key1
+            = makePathCacheKey(osg::Vec3f(100, 0, 0), osg::Vec3f(0, 0, 0), Flag_walk, {}, 0, mAgentHalfExtents);
+        const PathCacheKey key2
+            = makePathCacheKey(osg::Vec3f(200, 0, 0), osg::Vec3f(0, 0, 0), Flag_walk, {}, 0, mAgentHalfExtents);
+        cache.insert(mKey, makePath());
+        cache.insert(key1, makePath());
+        ASSERT_NE(find(cache, mKey, mNavMeshVersion), nullptr);
+        cache.insert(key2, makePath());
+        EXPECT_NE(find(cache, mKey, mNavMeshVersion), nullptr);
+        EXPECT_EQ(find(cache, key1, mNavMeshVersion), nullptr);
+        EXPECT_NE(find(cache, key2, mNavMeshVersion), nullptr);
+    }
+
+    TEST_F(DetourNavigatorPathCacheTest, insert_for_zero_max_size_should_not_store_path)
+    {
+        PathCache cache(0);
+        cache.insert(mKey, makePath());
+        EXPECT_EQ(find(cache, mKey, mNavMeshVersion), nullptr);
+    }
+
+    TEST(DetourNavigatorGetPathTilesPositionsTest, should_return_tiles_crossed_by_segments)
+    {
+        RecastSettings settings;
+        settings.mBorderSize = 0;
+        settings.mCellSize = 0.5;
+        settings.mRecastScaleFactor = 1;
+        settings.mTileSize = 64;
+        const std::vector<osg::Vec3f> path{ osg::Vec3f(16, 16, 0), osg::Vec3f(48, 16, 0) };
+        EXPECT_THAT(getPathTilesPositions(settings, path), ElementsAre(TilePosition(0, 0), TilePosition(1, 0)));
+    }
+}
@@ -321,6 +321,30 @@ namespace
         EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
     }
 
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, with_bounds_add_translated_bhv_triangle_shape_should_filter_by_bounds)
+    {
+        mBounds.mMin = osg::Vec2f(108, 108);
+        mBounds.mMax = osg::Vec2f(111, 111);
+        btTriangleMesh mesh;
+        mesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0));
+        mesh.addTriangle(btVector3(9, 9, 0), btVector3(9, 10, 0), btVector3(10, 9, 0));
+        btBvhTriangleMeshShape shape(&mesh, true);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObject(static_cast<const btCollisionShape&>(shape),
+            btTransform(btMatrix3x3::getIdentity(), btVector3(100, 100, 0)), AreaType_ground, mSource,
+            mObjectTransform);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getVertices(),
+            std::vector<float>({
+                109, 109, 0, // vertex 0
+                109, 110, 0, // vertex 1
+                110, 109, 0, // vertex 2
+            }))
+            << recastMesh->getMesh().getVertices();
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>({ 2, 1, 0 }));
+        EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
+    }
+
     TEST_F(
         DetourNavigatorRecastMeshBuilderTest, with_bounds_add_rotated_by_x_bhv_triangle_shape_should_filter_by_bounds)
     {
@@ -8,6 +8,8 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "../testing_util.hpp"
 
@@ -159,6 +161,31 @@ namespace ESM
             EXPECT_EQ(hash(lower), hash(upper));
         }
 
+        TEST(ESMRefIdTest, stringRefIdHasUniqueIndex)
+        {
+            EXPECT_EQ(StringRefId().getIndex(), 0);
+            EXPECT_EQ(StringRefId("index_a").getIndex(), StringRefId("INDEX_A").getIndex());
+            EXPECT_NE(StringRefId("index_a").getIndex(), StringRefId("index_b").getIndex());
+            EXPECT_NE(StringRefId("").getIndex(), 0);
+        }
+
+        TEST(ESMRefIdTest, stringRefIdConstructedConcurrentlyShouldBeEqual)
+        {
+            constexpr std::size_t count = 1000;
+            std::vector<std::vector<StringRefId>> values(4);
+            std::vector<std::thread> threads;
+            for (std::vector<StringRefId>& threadValues : values)
+                threads.emplace_back([&threadValues] {
+                    for (std::size_t i = 0; i < count; ++i)
+                        threadValues.emplace_back("concurrent_" + std::to_string(i));
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+            for (std::size_t i = 0; i < count; ++i)
+                for (const std::vector<StringRefId>& threadValues : values)
+                    EXPECT_EQ(threadValues[i], values.front()[i]);
+        }
+
         TEST(ESMRefIdTest, hasCaseInsensitiveEqualityWithStringView)
         {
             const RefId a = RefId::stringRefId("a");
@@ -1,4 +1,7 @@
+#include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm3/loadglob.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -6,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <random>
+#include <sstream>
 
 namespace ESM
 {
@@ -51,6 +55,45 @@ namespace ESM
             EXPECT_THROW(writer.writeMaybeFixedSizeString(generateRandomString(33), 32), std::runtime_error);
         }
 
+        TEST_F(Esm3EsmWriterTest, recordsSavedWithoutHeaderShouldBeReadableWhenAppendedToFile)
+        {
+            Global global;
+            global.mId = RefId::stringRefId("global");
+            global.mValue.setType(VT_Long);
+            global.mValue.setInteger(42);
+
+            std::ostringstream records;
+            {
+                ESMWriter writer;
+                writer.saveWithoutHeader(records);
+                writer.startRecord(Global::sRecordId);
+                global.save(writer);
+                writer.endRecord(Global::sRecordId);
+                EXPECT_EQ(writer.getRecordCount(), 1);
+            }
+
+            auto stream = std::make_unique<std::stringstream>();
+            {
+                ESMWriter writer;
+                writer.setFormatVersion(CurrentContentFormatVersion);
+                writer.save(*stream);
+                *stream << records.str();
+            }
+
+            ESMReader reader;
+            reader.open(std::move(stream), "stream");
+            ASSERT_TRUE(reader.hasMoreRecs());
+            EXPECT_EQ(reader.getRecName().toInt(), Global::sRecordId);
+            reader.getRecHeader();
+            Global result;
+            bool isDeleted = false;
+            result.load(reader, isDeleted);
+            EXPECT_FALSE(isDeleted);
+            EXPECT_EQ(result.mId, global.mId);
+            EXPECT_EQ(result.mValue.getInteger(), 42);
+            EXPECT_FALSE(reader.hasMoreRecs());
+        }
+
         struct Esm3EsmWriterRefIdSizeTest : TestWithParam<std::pair<RefId, std::size_t>>
         {
         };
@@ -4,6 +4,7 @@
 #include <components/esm3/effectlist.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/esm3/fogstate.hpp>
 #include <components/esm3/loadcont.hpp>
 #include <components/esm3/loaddial.hpp>
 #include <components/esm3/loadinfo.hpp>
@@ -13,6 +14,7 @@
 #include <components/esm3/loadweap.hpp>
 #include <components/esm3/player.hpp>
 #include <components/esm3/quickkeys.hpp>
+#include <components/files/memorystream.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -114,6 +116,11 @@ namespace ESM
             record.save(writer, true);
         }
 
+        void save(const FogState& record, ESMWriter& writer)
+        {
+            record.save(writer, true);
+        }
+
         template <NotHasSave T>
         auto save(const T& record, ESMWriter& writer)
         {
@@ -272,6 +279,42 @@ namespace ESM
             EXPECT_EQ(result.mData.mNumShorts, record.mData.mNumShorts);
         }
 
+        TEST_F(Esm3SaveLoadRecordTest, fogStateShouldNotChange)
+        {
+            std::vector<std::uint8_t> alpha(32 * 32, 255);
+            std::fill_n(alpha.begin() + 300, 600, 0);
+            alpha[1000] = 42;
+
+            FogState record;
+            record.mNorthMarkerAngle = 0.5f;
+            record.mBounds = { -1.f, -2.f, 3.f, 4.f };
+            record.mFogTextures.push_back({ .mX = 1, .mY = 2 });
+            encodeFogOfWar(alpha, record.mFogTextures.back().mImageData);
+
+            FogState result;
+            saveAndLoadRecord(record, CurrentSaveGameFormatVersion, result);
+            EXPECT_EQ(result.mNorthMarkerAngle, record.mNorthMarkerAngle);
+            EXPECT_EQ(result.mBounds.mMinX, record.mBounds.mMinX);
+            EXPECT_EQ(result.mBounds.mMaxY, record.mBounds.mMaxY);
+            ASSERT_EQ(result.mFogTextures.size(), 1u);
+            EXPECT_EQ(result.mFogTextures[0].mX, 1);
+            EXPECT_EQ(result.mFogTextures[0].mY, 2);
+
+            std::vector<std::uint8_t> decoded(alpha.size());
+            ASSERT_TRUE(decodeFogOfWar(result.mFogTextures[0].mImageData, decoded));
+            EXPECT_EQ(decoded, alpha);
+        }
+
+        TEST_F(Esm3SaveLoadRecordTest, decodeFogOfWarShouldRejectDataOfWrongSize)
+        {
+            std::vector<char> data;
+            encodeFogOfWar(std::vector<std::uint8_t>(32 * 32, 255), data);
+            std::vector<std::uint8_t> decoded(32 * 32 + 1);
+            EXPECT_FALSE(decodeFogOfWar(data, decoded));
+            decoded.resize(32 * 32 - 1);
+            EXPECT_FALSE(decodeFogOfWar(data, decoded));
+        }
+
         TEST_P(Esm3SaveLoadRecordTest, playerShouldNotChange)
         {
             // Player state is not saved to vanilla ESM format.
@@ -316,22 +359,24 @@ namespace ESM
             record.mRefNum.mContentFile = std::numeric_limits<int>::max();
             record.mRefID = generateRandomRefId();
             record.mScale = 2;
-            record.mOwner = generateRandomRefId();
-            record.mGlobalVariable = generateRandomString(100);
-            record.mSoul = generateRandomRefId();
-            record.mFaction = generateRandomRefId();
-            record.mFactionRank = std::numeric_limits<int>::max();
+            record.setOwner(generateRandomRefId());
+            record.setGlobalVariable(generateRandomString(100));
+            record.setSoul(generateRandomRefId());
+            record.setFaction(generateRandomRefId());
+            record.setFactionRank(std::numeric_limits<int>::max());
             record.mChargeInt = std::numeric_limits<int>::max();
             record.mEnchantmentCharge = std::numeric_limits<float>::max();
             record.mCount = std::numeric_limits<int>::max();
-            record.mTeleport = true;
-            generateArray(record.mDoorDest.pos);
-            generateArray(record.mDoorDest.rot);
-            record.mDestCell = generateRandomString(100);
+            record.setTeleport(true);
+            Position doorDest;
+            generateArray(doorDest.pos);
+            generateArray(doorDest.rot);
+            record.setDoorDest(doorDest);
+            record.setDestCell(generateRandomString(100));
             record.mLockLevel = 0;
             record.mIsLocked = true;
-            record.mKey = generateRandomRefId();
-            record.mTrap = generateRandomRefId();
+            record.setKey(generateRandomRefId());
+            record.setTrap(generateRandomRefId());
             record.mReferenceBlocked = std::numeric_limits<signed char>::max();
             generateArray(record.mPos.pos);
             generateArray(record.mPos.rot);
@@ -341,25 +386,44 @@ namespace ESM
             EXPECT_EQ(record.mRefNum.mContentFile, result.mRefNum.mContentFile);
             EXPECT_EQ(record.mRefID, result.mRefID);
             EXPECT_EQ(record.mScale, result.mScale);
-            EXPECT_EQ(record.mOwner, result.mOwner);
-            EXPECT_EQ(record.mGlobalVariable, result.mGlobalVariable);
-            EXPECT_EQ(record.mSoul, result.mSoul);
-            EXPECT_EQ(record.mFaction, result.mFaction);
-            EXPECT_EQ(record.mFactionRank, result.mFactionRank);
+            EXPECT_EQ(record.getOwner(), result.getOwner());
+            EXPECT_EQ(record.getGlobalVariable(), result.getGlobalVariable());
+            EXPECT_EQ(record.getSoul(), result.getSoul());
+            EXPECT_EQ(record.getFaction(), result.getFaction());
+            EXPECT_EQ(record.getFactionRank(), result.getFactionRank());
             EXPECT_EQ(record.mChargeInt, result.mChargeInt);
             EXPECT_EQ(record.mEnchantmentCharge, result.mEnchantmentCharge);
             EXPECT_EQ(record.mCount, result.mCount);
-            EXPECT_EQ(record.mTeleport, result.mTeleport);
-            EXPECT_EQ(record.mDoorDest, result.mDoorDest);
-            EXPECT_EQ(record.mDestCell, result.mDestCell);
+            EXPECT_EQ(record.getTeleport(), result.getTeleport());
+            EXPECT_EQ(record.getDoorDest(), result.getDoorDest());
+            EXPECT_EQ(record.getDestCell(), result.getDestCell());
             EXPECT_EQ(record.mLockLevel, result.mLockLevel);
             EXPECT_EQ(record.mIsLocked, result.mIsLocked);
-            EXPECT_EQ(record.mKey, result.mKey);
-            EXPECT_EQ(record.mTrap, result.mTrap);
+            EXPECT_EQ(record.getKey(), result.getKey());
+            EXPECT_EQ(record.getTrap(), result.getTrap());
             EXPECT_EQ(record.mReferenceBlocked, result.mReferenceBlocked);
             EXPECT_EQ(record.mPos, result.mPos);
         }
 
+        TEST_P(Esm3SaveLoadRecordTest, cellRefWithoutRareFieldsShouldNotAllocateExtra)
+        {
+            CellRef record;
+            record.blank();
+            record.mRefID = generateRandomRefId();
+            record.mScale = 2;
+            record.setOwner(RefId());
+            record.setFactionRank(-2);
+            record.setTeleport(false);
+            generateArray(record.mPos.pos);
+            generateArray(record.mPos.rot);
+            EXPECT_FALSE(record.hasExtra());
+            CellRef result;
+            saveAndLoadRecord(record, GetParam(), result);
+            EXPECT_FALSE(result.hasExtra());
+            EXPECT_EQ(record.mRefID, result.mRefID);
+            EXPECT_EQ(result.getFactionRank(), -2);
+        }
+
         TEST_P(Esm3SaveLoadRecordTest, creatureStatsShouldNotChange)
         {
             CreatureStats record;
@@ -730,6 +794,36 @@ namespace ESM
             EXPECT_EQ(result.mLandData->mDataLoaded, record.mLandData->mDataLoaded);
         }
 
+        TEST_P(Esm3SaveLoadRecordTest, recordDataShouldBeReadableLater)
+        {
+            ESMWriter writer;
+            auto stream = std::make_unique<std::stringstream>();
+            writer.setFormatVersion(GetParam());
+            writer.save(*stream);
+            writer.startRecord(fakeRecordId);
+            writer.writeHNString("NAME", "first");
+            writer.writeHNString("DATA", "second");
+            writer.writeHNString("DATA", "third");
+            writer.endRecord(fakeRecordId);
+
+            ESMReader reader;
+            reader.open(std::move(stream), "stream");
+            ASSERT_EQ(reader.getRecName().toInt(), fakeRecordId);
+            reader.getRecHeader();
+            EXPECT_EQ(reader.getHNString("NAME"), "first");
+            EXPECT_FALSE(reader.isNextSub("NAME"));
+            const std::vector<char> data = reader.getRecordData();
+            EXPECT_FALSE(reader.hasMoreSubs());
+
+            ESMReader recordReader;
+            recordReader.openRecordData(
+                std::make_unique<Files::IMemStream>(data.data(), data.size()), "record", GetParam());
+            EXPECT_EQ(recordReader.getFormatVersion(), GetParam());
+            EXPECT_EQ(recordReader.getHNString("DATA"), "second");
+            EXPECT_EQ(recordReader.getHNString("DATA"), "third");
+            EXPECT_FALSE(recordReader.hasMoreSubs());
+        }
+
         INSTANTIATE_TEST_SUITE_P(FormatVersions, Esm3SaveLoadRecordTest, ValuesIn(getFormats()));
     }
 }
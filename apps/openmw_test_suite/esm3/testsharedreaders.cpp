@@ -0,0 +1,100 @@
+#include <components/esm3/sharedreaders.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/multidircollection.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#ifndef OPENMW_DATA_DIR
+#error "OPENMW_DATA_DIR is not defined"
+#endif
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    struct ESM3SharedReadersTest : Test
+    {
+        static constexpr std::size_t sInitialOffset = 324;
+        const Files::PathContainer mDataDirs{ { std::filesystem::path{ OPENMW_DATA_DIR } } };
+        const Files::Collections mFileCollections{ mDataDirs };
+        const std::string mContentFile = "template.omwgame";
+        const std::filesystem::path mContentFilePath = mFileCollections.getCollection(".omwgame").getPath(mContentFile);
+        SharedReaders mReaders;
+
+        ESM_Context getInitialContext()
+        {
+            ESMReader reader;
+            reader.open(mContentFilePath);
+            return reader.getContext();
+        }
+
+        static std::vector<NAME> readRecordNames(ESMReader& reader)
+        {
+            std::vector<NAME> result;
+            while (reader.hasMoreRecs())
+            {
+                result.push_back(reader.getRecName());
+                reader.getRecHeader();
+                reader.skipRecord();
+            }
+            return result;
+        }
+    };
+
+    TEST_F(ESM3SharedReadersTest, restoreShouldPositionReaderAtContext)
+    {
+        SharedReaders::Reader reader(mReaders);
+        ESMReader& esm = reader.restore(getInitialContext());
+        EXPECT_TRUE(esm.isOpen());
+        EXPECT_EQ(esm.getName(), mContentFilePath);
+        EXPECT_EQ(esm.getFileOffset(), sInitialOffset);
+    }
+
+    TEST_F(ESM3SharedReadersTest, restoreShouldProvideHeaderOfFile)
+    {
+        ESMReader expected;
+        expected.open(mContentFilePath);
+        SharedReaders::Reader reader(mReaders);
+        ESMReader& esm = reader.restore(expected.getContext());
+        EXPECT_EQ(esm.getFormatVersion(), expected.getFormatVersion());
+        EXPECT_EQ(esm.getRecordCount(), expected.getRecordCount());
+        EXPECT_EQ(esm.getAuthor(), expected.getAuthor());
+    }
+
+    TEST_F(ESM3SharedReadersTest, restoreShouldAllowToReadSameRecordsAsFileReader)
+    {
+        ESMReader expected;
+        expected.open(mContentFilePath);
+        SharedReaders::Reader reader(mReaders);
+        ESMReader& esm = reader.restore(expected.getContext());
+        EXPECT_EQ(readRecordNames(esm), readRecordNames(expected));
+    }
+
+    TEST_F(ESM3SharedReadersTest, restoreShouldAllowToGoBackToEarlierContext)
+    {
+        const ESM_Context context = getInitialContext();
+        SharedReaders::Reader reader(mReaders);
+        const std::vector<NAME> expected = readRecordNames(reader.restore(context));
+        ESMReader& esm = reader.restore(context);
+        EXPECT_EQ(esm.getFileOffset(), sInitialOffset);
+        EXPECT_EQ(readRecordNames(esm), expected);
+    }
+
+    TEST_F(ESM3SharedReadersTest, readersShouldBeUsableFromDifferentThreads)
+    {
+        const ESM_Context context = getInitialContext();
+        const std::vector<NAME> expected = readRecordNames(SharedReaders::Reader(mReaders).restore(context));
+        std::vector<std::vector<NAME>> results(4);
+        std::vector<std::thread> threads;
+        for (std::vector<NAME>& result : results)
+            threads.emplace_back([&] { result = readRecordNames(SharedReaders::Reader(mReaders).restore(context)); });
+        for (std::thread& thread : threads)
+            thread.join();
+        for (const std::vector<NAME>& result : results)
+            EXPECT_EQ(result, expected);
+    }
+}
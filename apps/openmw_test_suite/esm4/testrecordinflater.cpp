@@ -0,0 +1,127 @@
+#include <components/bsa/memorystream.hpp>
+#include <components/esm4/common.hpp>
+#include <components/esm4/reader.hpp>
+#include <components/esm4/recordinflater.hpp>
+
+#include <zlib.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM4;
+
+    constexpr std::size_t headerSize = sizeof(RecordHeader);
+    constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+    struct Esm4RecordInflaterTest : Test
+    {
+        std::string mFile;
+
+        void writeHeader(std::uint32_t typeId, std::uint32_t size, std::uint32_t flags)
+        {
+            RecordHeader header{};
+            header.record.typeId = typeId;
+            header.record.dataSize = size;
+            header.record.flags = flags;
+            mFile.append(reinterpret_cast<const char*>(&header), headerSize);
+        }
+
+        void writeGroup(std::uint32_t size)
+        {
+            RecordHeader header{};
+            header.group.typeId = REC_GRUP;
+            header.group.groupSize = static_cast<std::uint32_t>(headerSize) + size;
+            mFile.append(reinterpret_cast<const char*>(&header), headerSize);
+        }
+
+        // Returns the position of the compressed data
+        std::streamoff writeCompressed(std::uint32_t typeId, const std::string& data)
+        {
+            uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+            std::vector<char> compressed(compressedSize);
+            EXPECT_EQ(compress(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                          reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size())),
+                Z_OK);
+            writeHeader(typeId, static_cast<std::uint32_t>(compressedSize + sizeof(std::uint32_t)), Rec_Compressed);
+            const auto uncompressedSize = static_cast<std::uint32_t>(data.size());
+            mFile.append(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
+            const auto position = static_cast<std::streamoff>(mFile.size());
+            mFile.append(compressed.data(), compressedSize);
+            return position;
+        }
+
+        void writeUncompressed(std::uint32_t typeId, const std::string& data)
+        {
+            writeHeader(typeId, static_cast<std::uint32_t>(data.size()), 0);
+            mFile += data;
+        }
+
+        std::unique_ptr<std::istream> makeStream() const { return std::make_unique<std::istringstream>(mFile); }
+
+        static std::string getData(std::unique_ptr<Bsa::MemoryInputStream> data)
+        {
+            EXPECT_NE(data, nullptr);
+            if (data == nullptr)
+                return {};
+            std::ostringstream result;
+            result << data->rdbuf();
+            return std::move(result).str();
+        }
+    };
+
+    TEST_F(Esm4RecordInflaterTest, shouldInflateCompressedRecordsOfAllGroups)
+    {
+        writeUncompressed(REC_TES4, "header");
+        writeGroup(0);
+        const std::streamoff first = writeCompressed(REC_STAT, "first static");
+        writeUncompressed(REC_STAT, "uncompressed static");
+        writeGroup(0);
+        const std::streamoff second = writeCompressed(REC_NPC_, "second npc");
+
+        RecordInflater inflater(makeStream(), headerSize, {}, 2, unlimited);
+
+        EXPECT_EQ(getData(inflater.take(first)), "first static");
+        EXPECT_EQ(getData(inflater.take(second)), "second npc");
+    }
+
+    TEST_F(Esm4RecordInflaterTest, shouldNotInflateRecordsRejectedByFilter)
+    {
+        const std::streamoff rejected = writeCompressed(REC_NPC_, "rejected npc");
+        const std::streamoff accepted = writeCompressed(REC_STAT, "accepted static");
+
+        RecordInflater inflater(makeStream(), headerSize, [](std::uint32_t typeId) { return typeId == REC_STAT; }, 1,
+            unlimited);
+
+        EXPECT_EQ(inflater.take(rejected), nullptr);
+        EXPECT_EQ(getData(inflater.take(accepted)), "accepted static");
+    }
+
+    TEST_F(Esm4RecordInflaterTest, shouldDiscardSkippedRecords)
+    {
+        const std::streamoff skipped = writeCompressed(REC_STAT, "skipped");
+        const std::streamoff taken = writeCompressed(REC_STAT, "taken");
+
+        RecordInflater inflater(makeStream(), headerSize, {}, 1, 1);
+
+        EXPECT_EQ(getData(inflater.take(taken)), "taken");
+        EXPECT_EQ(inflater.take(skipped), nullptr);
+    }
+
+    TEST_F(Esm4RecordInflaterTest, takeShouldReturnNullptrForPositionAfterEndOfFile)
+    {
+        const std::streamoff position = writeCompressed(REC_STAT, "static");
+
+        RecordInflater inflater(makeStream(), headerSize, {}, 1, unlimited);
+
+        EXPECT_EQ(inflater.take(position + static_cast<std::streamoff>(mFile.size())), nullptr);
+    }
+}
@@ -0,0 +1,73 @@
+#include <components/files/compressedstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Files;
+
+    std::string makeData(std::size_t size)
+    {
+        std::string result;
+        result.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result.push_back(static_cast<char>((i * 7 + i / 1000) % 251));
+        return result;
+    }
+
+    std::unique_ptr<std::istream> makeSource(const std::string& data)
+    {
+        std::ostringstream compressed;
+        writeCompressedStream(compressed, data);
+        auto result = std::make_unique<std::istringstream>(compressed.str());
+        result->seekg(sizeof(sCompressedStreamMagic));
+        return result;
+    }
+
+    TEST(FilesCompressedStreamTest, shouldReadWrittenData)
+    {
+        const std::string data = makeData(sCompressedStreamFrameSize * 2 + 123);
+        DecompressingStreamBuf buf(makeSource(data));
+        std::istream stream(&buf);
+        EXPECT_EQ(buf.getSize(), data.size());
+        const std::string result((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(result, data);
+    }
+
+    TEST(FilesCompressedStreamTest, shouldSupportSeeking)
+    {
+        const std::string data = makeData(sCompressedStreamFrameSize * 3);
+        DecompressingStreamBuf buf(makeSource(data));
+        std::istream stream(&buf);
+
+        stream.seekg(0, std::ios_base::end);
+        EXPECT_EQ(stream.tellg(), static_cast<std::streamoff>(data.size()));
+
+        const std::size_t position = sCompressedStreamFrameSize * 2 - 2;
+        stream.seekg(static_cast<std::streamoff>(position));
+        char value[4];
+        ASSERT_TRUE(stream.read(value, sizeof(value)));
+        EXPECT_EQ(std::string(value, sizeof(value)), data.substr(position, sizeof(value)));
+        EXPECT_EQ(stream.tellg(), static_cast<std::streamoff>(position + sizeof(value)));
+
+        stream.seekg(-10, std::ios_base::cur);
+        ASSERT_TRUE(stream.read(value, 1));
+        EXPECT_EQ(value[0], data[position + sizeof(value) - 10]);
+
+        stream.seekg(static_cast<std::streamoff>(data.size() + 1));
+        EXPECT_TRUE(stream.fail());
+    }
+
+    TEST(FilesCompressedStreamTest, emptyDataShouldBeEmptyStream)
+    {
+        DecompressingStreamBuf buf(makeSource(std::string()));
+        std::istream stream(&buf);
+        EXPECT_EQ(buf.getSize(), 0);
+        EXPECT_EQ(stream.get(), std::istream::traits_type::eof());
+    }
+}
@@ -0,0 +1,93 @@
+#include "../testing_util.hpp"
+
+#include <components/fontloader/fontcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+
+namespace Gui
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct GuiFontCacheTest : Test
+        {
+            const std::filesystem::path mDirectory = TestingOpenMW::outputFilePath("fontcache");
+            std::optional<FontCache> mCache;
+
+            GuiFontCacheTest()
+            {
+                std::filesystem::remove_all(mDirectory);
+                mCache.emplace(mDirectory);
+            }
+
+            static BakedFont makeFont()
+            {
+                BakedFont font;
+                font.mDefaultHeight = 16;
+                font.mWidth = 2;
+                font.mHeight = 3;
+                font.mPixelFormat = 2;
+                font.mBytesPerPixel = 2;
+                font.mGlyphs.push_back(BakedFont::Glyph{ 65, 8, 12, 9, 1, 2, 0, 0, 0.5f, 1 });
+                font.mGlyphs.push_back(BakedFont::Glyph{ 0xFFFFFFFF, 4, 6, 5, 0, 1, 0.5f, 0, 1, 0.5f });
+                for (std::size_t i = 0; i < 12; ++i)
+                    font.mPixels.push_back(static_cast<unsigned char>(i * 20));
+                return font;
+            }
+        };
+
+        TEST_F(GuiFontCacheTest, readShouldReturnNulloptForMissingFile)
+        {
+            EXPECT_FALSE(mCache->read(mCache->getKey(std::string_view("inputs"))).has_value());
+        }
+
+        TEST_F(GuiFontCacheTest, keyShouldDependOnInputs)
+        {
+            EXPECT_EQ(mCache->getKey(std::string_view("inputs")), mCache->getKey(std::string_view("inputs")));
+            EXPECT_NE(mCache->getKey(std::string_view("inputs")), mCache->getKey(std::string_view("other")));
+        }
+
+        TEST_F(GuiFontCacheTest, readShouldReturnWrittenFont)
+        {
+            const std::string key = mCache->getKey(std::string_view("inputs"));
+            const BakedFont font = makeFont();
+            mCache->write(key, font);
+            const std::optional<BakedFont> result = mCache->read(key);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mDefaultHeight, font.mDefaultHeight);
+            EXPECT_EQ(result->mWidth, font.mWidth);
+            EXPECT_EQ(result->mHeight, font.mHeight);
+            EXPECT_EQ(result->mPixelFormat, font.mPixelFormat);
+            EXPECT_EQ(result->mBytesPerPixel, font.mBytesPerPixel);
+            ASSERT_EQ(result->mGlyphs.size(), font.mGlyphs.size());
+            EXPECT_EQ(result->mGlyphs[1].mCodePoint, font.mGlyphs[1].mCodePoint);
+            EXPECT_EQ(result->mGlyphs[1].mAdvance, font.mGlyphs[1].mAdvance);
+            EXPECT_EQ(result->mGlyphs[1].mRight, font.mGlyphs[1].mRight);
+            EXPECT_EQ(result->mPixels, font.mPixels);
+        }
+
+        TEST_F(GuiFontCacheTest, writeShouldSkipFontWithAtlasOfWrongSize)
+        {
+            const std::string key = mCache->getKey(std::string_view("inputs"));
+            BakedFont font = makeFont();
+            font.mPixels.pop_back();
+            mCache->write(key, font);
+            EXPECT_FALSE(mCache->read(key).has_value());
+        }
+
+        TEST_F(GuiFontCacheTest, readShouldReturnNulloptForTruncatedFile)
+        {
+            const std::string key = mCache->getKey(std::string_view("inputs"));
+            mCache->write(key, makeFont());
+            const std::filesystem::path path = mDirectory / (key + ".font");
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+            EXPECT_FALSE(mCache->read(key).has_value());
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include <components/fx/framegraph.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using fx::FrameGraph;
+
+    TEST(FxFrameGraphTest, passDrawingToOutputShouldBeUsed)
+    {
+        FrameGraph graph;
+        const FrameGraph::PassIndex pass = graph.addPass(std::nullopt, false, {});
+        graph.compile();
+        EXPECT_TRUE(graph.isPassUsed(pass));
+    }
+
+    TEST(FxFrameGraphTest, passDrawingToUnreadTargetShouldNotBeUsed)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource target = graph.addResource(0);
+        const FrameGraph::PassIndex unread = graph.addPass(target, false, {});
+        const FrameGraph::PassIndex output = graph.addPass(std::nullopt, false, {});
+        graph.compile();
+        EXPECT_FALSE(graph.isPassUsed(unread));
+        EXPECT_TRUE(graph.isPassUsed(output));
+    }
+
+    TEST(FxFrameGraphTest, passesOnlyReadByUnusedPassesShouldNotBeUsed)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource first = graph.addResource(0);
+        const FrameGraph::Resource second = graph.addResource(0);
+        const FrameGraph::PassIndex pass1 = graph.addPass(first, false, {});
+        const FrameGraph::PassIndex pass2 = graph.addPass(second, false, std::array{ first });
+        graph.addPass(std::nullopt, false, {});
+        graph.compile();
+        EXPECT_FALSE(graph.isPassUsed(pass1));
+        EXPECT_FALSE(graph.isPassUsed(pass2));
+    }
+
+    TEST(FxFrameGraphTest, targetsWithDisjointLifetimesShouldBeShared)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource first = graph.addResource(0);
+        const FrameGraph::Resource second = graph.addResource(0);
+        graph.addPass(first, false, {});
+        graph.addPass(std::nullopt, false, std::array{ first });
+        graph.addPass(second, false, {});
+        graph.addPass(std::nullopt, false, std::array{ second });
+        graph.compile();
+        EXPECT_EQ(graph.getAlias(first), first);
+        EXPECT_EQ(graph.getAlias(second), first);
+    }
+
+    TEST(FxFrameGraphTest, targetsOfDifferentClassesShouldNotBeShared)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource first = graph.addResource(0);
+        const FrameGraph::Resource second = graph.addResource(1);
+        graph.addPass(first, false, {});
+        graph.addPass(std::nullopt, false, std::array{ first });
+        graph.addPass(second, false, {});
+        graph.addPass(std::nullopt, false, std::array{ second });
+        graph.compile();
+        EXPECT_EQ(graph.getAlias(second), second);
+    }
+
+    TEST(FxFrameGraphTest, targetReadWhileDrawingAnotherShouldNotBeShared)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource first = graph.addResource(0);
+        const FrameGraph::Resource second = graph.addResource(0);
+        graph.addPass(first, false, {});
+        graph.addPass(second, false, std::array{ first });
+        graph.addPass(std::nullopt, false, std::array{ second });
+        graph.compile();
+        EXPECT_EQ(graph.getAlias(second), second);
+    }
+
+    TEST(FxFrameGraphTest, targetReadBeforeDrawnToShouldNotBeShared)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource history = graph.addResource(0);
+        const FrameGraph::Resource other = graph.addResource(0);
+        graph.addPass(other, false, {});
+        graph.addPass(std::nullopt, false, std::array{ other });
+        graph.addPass(std::nullopt, false, std::array{ history });
+        graph.addPass(history, false, {});
+        graph.compile();
+        EXPECT_EQ(graph.getAlias(history), history);
+        EXPECT_EQ(graph.getAlias(other), other);
+    }
+
+    TEST(FxFrameGraphTest, targetBlendedWithFirstShouldNotBeShared)
+    {
+        FrameGraph graph;
+        const FrameGraph::Resource first = graph.addResource(0);
+        const FrameGraph::Resource accumulated = graph.addResource(0);
+        graph.addPass(first, false, {});
+        graph.addPass(std::nullopt, false, std::array{ first });
+        graph.addPass(accumulated, true, {});
+        graph.addPass(std::nullopt, false, std::array{ accumulated });
+        graph.compile();
+        EXPECT_EQ(graph.getAlias(accumulated), accumulated);
+    }
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <components/lua/poolallocator.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using LuaUtil::PoolAllocator;
+
+    TEST(LuaUtilPoolAllocatorTest, shouldReuseDeallocatedBlocks)
+    {
+        PoolAllocator allocator;
+        void* const first = allocator.allocate(24);
+        ASSERT_NE(first, nullptr);
+        allocator.deallocate(first, 24);
+        EXPECT_EQ(allocator.allocate(32), first);
+        EXPECT_EQ(allocator.getUsedSize(), 32);
+        EXPECT_EQ(allocator.getReservedSize(), PoolAllocator::sChunkSize);
+    }
+
+    TEST(LuaUtilPoolAllocatorTest, blocksShouldBeAlignedAndNotOverlap)
+    {
+        PoolAllocator allocator;
+        std::vector<unsigned char*> blocks;
+        for (std::size_t i = 0; i < 10000; ++i)
+        {
+            const std::size_t size = 1 + i % PoolAllocator::sMaxSize;
+            auto* block = static_cast<unsigned char*>(allocator.allocate(size));
+            ASSERT_NE(block, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t), 0);
+            std::memset(block, static_cast<int>(i % 256), size);
+            blocks.push_back(block);
+        }
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            const std::size_t size = 1 + i % PoolAllocator::sMaxSize;
+            EXPECT_EQ(blocks[i][0], i % 256);
+            EXPECT_EQ(blocks[i][size - 1], i % 256);
+            allocator.deallocate(blocks[i], size);
+        }
+        EXPECT_EQ(allocator.getUsedSize(), 0);
+    }
+
+    TEST(LuaUtilPoolAllocatorTest, isSameClassShouldCompareRoundedSizes)
+    {
+        EXPECT_TRUE(PoolAllocator::isSameClass(17, 32));
+        EXPECT_FALSE(PoolAllocator::isSameClass(16, 17));
+        EXPECT_FALSE(PoolAllocator::isSameClass(0, 1));
+        EXPECT_FALSE(PoolAllocator::isSameClass(PoolAllocator::sMaxSize + 1, PoolAllocator::sMaxSize + 1));
+    }
+}
@@ -444,6 +444,58 @@ CUSTOM, PLAYER: useInterface.lua
         EXPECT_EQ(counter4, 25);
     }
 
+    TEST_F(LuaScriptsContainerTest, TimersWithSameTimeShouldBeCalledInOrderOfAdding)
+    {
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        int test1Id = *mCfg.findId("test1.lua");
+
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts.addCustomScript(test1Id));
+        EXPECT_EQ(internal::GetCapturedStdout(), "");
+
+        std::vector<int> calls;
+        sol::function fn = sol::make_object(mLua.sol(), [&](int v) { calls.push_back(v); });
+        scripts.registerTimerCallback(test1Id, "A", fn);
+        for (int i = 0; i < 100; ++i)
+            scripts.setupSerializableTimer(
+                TimerType::SIMULATION_TIME, i % 2 == 0 ? 5 : 3, test1Id, "A", sol::make_object(mLua.sol(), i));
+
+        scripts.processTimers(10, 10);
+
+        std::vector<int> expected;
+        for (int i = 1; i < 100; i += 2)
+            expected.push_back(i);
+        for (int i = 0; i < 100; i += 2)
+            expected.push_back(i);
+        EXPECT_EQ(calls, expected);
+    }
+
+    TEST_F(LuaScriptsContainerTest, RemoveScriptShouldRemoveItsTimers)
+    {
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        int test1Id = *mCfg.findId("test1.lua");
+        int test2Id = *mCfg.findId("test2.lua");
+
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts.addCustomScript(test1Id));
+        EXPECT_TRUE(scripts.addCustomScript(test2Id));
+        EXPECT_EQ(internal::GetCapturedStdout(), "");
+
+        int counter = 0;
+        sol::function fn = sol::make_object(mLua.sol(), [&]() { counter++; });
+        scripts.setupUnsavableTimer(TimerType::SIMULATION_TIME, 5, test1Id, fn);
+        scripts.setupUnsavableTimer(TimerType::GAME_TIME, 5, test1Id, fn);
+        scripts.setupUnsavableTimer(TimerType::SIMULATION_TIME, 5, test2Id, fn);
+
+        scripts.removeScript(test1Id);
+        testing::internal::CaptureStdout();
+        scripts.processTimers(10, 10);
+        EXPECT_EQ(internal::GetCapturedStdout(), "");
+        EXPECT_EQ(counter, 1);
+    }
+
     TEST_F(LuaScriptsContainerTest, CallbackWrapper)
     {
         LuaUtil::Callback callback{ mLua.sol()["print"], mLua.newTable() };
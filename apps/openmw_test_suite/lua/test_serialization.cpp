@@ -193,6 +193,22 @@ namespace
         EXPECT_ERROR(lua.safe_script("ro_t.nested.x = 5"), "userdata value");
     }
 
+    TEST(LuaSerializationTest, ShouldNotKeepDataOfPreviousValue)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 100; ++i)
+            table[i] = i;
+        EXPECT_EQ(LuaUtil::serialize(table).size(), 1803); // version, table start, 100 keys and values, table end
+        EXPECT_ANY_THROW(LuaUtil::serialize(lua.safe_script("return { 1, 2, function() end }")));
+
+        std::string serialized = LuaUtil::serialize(sol::make_object<double>(lua, 3.14));
+        EXPECT_EQ(serialized.size(), 10);
+        sol::object value = LuaUtil::deserialize(lua, serialized);
+        ASSERT_TRUE(value.is<double>());
+        EXPECT_DOUBLE_EQ(value.as<double>(), 3.14);
+    }
+
     struct TestStruct1
     {
         double a, b;
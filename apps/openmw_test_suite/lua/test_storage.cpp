@@ -117,4 +117,58 @@ namespace
         EXPECT_TRUE(get<bool>(mLua, "temporary:get('y') == nil"));
     }
 
+    TEST(LuaUtilStorageTest, SavingShouldAppendChangedSectionsToJournal)
+    {
+        sol::state mLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        LuaUtil::LuaStorage storage(mLua);
+        storage.setActive(true);
+
+        mLua["large"] = storage.getMutableSection("large");
+        mLua["small"] = storage.getMutableSection("small");
+        mLua["removed"] = storage.getMutableSection("removed");
+        mLua.safe_script("for i = 1, 100 do large:set('key' .. i, string.rep('x', 100)) end");
+        mLua.safe_script("small:set('x', 1)");
+        mLua.safe_script("removed:set('y', 2)");
+
+        const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_journal.bin";
+        auto journalFile = tmpFile;
+        journalFile += ".journal";
+        std::filesystem::remove(journalFile);
+        storage.save(tmpFile);
+        const auto fileSize = std::filesystem::file_size(tmpFile);
+        EXPECT_FALSE(std::filesystem::exists(journalFile));
+
+        storage.save(tmpFile);
+        EXPECT_FALSE(std::filesystem::exists(journalFile));
+
+        mLua.safe_script("small:set('x', 3)");
+        mLua.safe_script("removed:removeOnExit()");
+        storage.clearTemporaryAndRemoveCallbacks();
+        storage.save(tmpFile);
+        EXPECT_EQ(std::filesystem::file_size(tmpFile), fileSize);
+        EXPECT_TRUE(std::filesystem::exists(journalFile));
+
+        LuaUtil::LuaStorage storage2(mLua);
+        storage2.setActive(true);
+        storage2.load(tmpFile);
+        mLua["large"] = storage2.getMutableSection("large");
+        mLua["small"] = storage2.getMutableSection("small");
+        mLua["removed"] = storage2.getMutableSection("removed");
+        EXPECT_EQ(get<int>(mLua, "small:get('x')"), 3);
+        EXPECT_TRUE(get<bool>(mLua, "removed:get('y') == nil"));
+        EXPECT_EQ(get<std::size_t>(mLua, "#large:get('key100')"), 100);
+
+        // Compacted when the journal becomes larger than the file
+        mLua.safe_script("for i = 1, 100 do large:set('key' .. i, string.rep('y', 100)) end");
+        storage2.save(tmpFile);
+        EXPECT_FALSE(std::filesystem::exists(journalFile));
+
+        LuaUtil::LuaStorage storage3(mLua);
+        storage3.setActive(true);
+        storage3.load(tmpFile);
+        mLua["large"] = storage3.getMutableSection("large");
+        EXPECT_EQ(get<std::string>(mLua, "large:get('key1')"), std::string(100, 'y'));
+    }
+
 }
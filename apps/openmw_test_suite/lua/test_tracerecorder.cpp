@@ -0,0 +1,77 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/configuration.hpp>
+#include <components/lua/tracerecorder.hpp>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace std::chrono_literals;
+    using LuaUtil::TraceRecorder;
+
+    const TraceRecorder::Clock::time_point start{};
+
+    TEST(LuaUtilTraceRecorderTest, collectCallStatsShouldGroupCallsByScriptAndFunction)
+    {
+        TraceRecorder recorder(2);
+        recorder.addCall(0, "a.lua:1", start, start + 1ms);
+        recorder.addCall(0, "a.lua:1", start + 2ms, start + 5ms);
+        recorder.addCall(1, "a.lua:1", start, start + 2ms);
+        recorder.addCall(1, "b.lua:3", start, start + 10ms);
+
+        const std::vector<TraceRecorder::CallStats> stats = recorder.collectCallStats();
+        ASSERT_EQ(stats.size(), 3);
+        EXPECT_EQ(stats[0].mScriptIndex, 1);
+        EXPECT_EQ(stats[0].mFunction, "b.lua:3");
+        EXPECT_EQ(stats[0].mCount, 1);
+        EXPECT_EQ(stats[1].mScriptIndex, 0);
+        EXPECT_EQ(stats[1].mFunction, "a.lua:1");
+        EXPECT_EQ(stats[1].mCount, 2);
+        EXPECT_EQ(stats[1].mTotal, 4ms);
+        EXPECT_EQ(stats[1].mMax, 3ms);
+        EXPECT_EQ(stats[2].mScriptIndex, 1);
+        EXPECT_EQ(stats[2].mTotal, 2ms);
+    }
+
+    TEST(LuaUtilTraceRecorderTest, nextFrameShouldDropOldestFrames)
+    {
+        TraceRecorder recorder(2);
+        recorder.addCall(0, "first", start, start + 1ms);
+        recorder.nextFrame();
+        recorder.addCall(0, "second", start, start + 1ms);
+        recorder.nextFrame();
+        recorder.addCall(0, "third", start, start + 1ms);
+
+        const std::vector<TraceRecorder::CallStats> stats = recorder.collectCallStats();
+        ASSERT_EQ(stats.size(), 2);
+        EXPECT_EQ(stats[0].mFunction, "second");
+        EXPECT_EQ(stats[1].mFunction, "third");
+    }
+
+    TEST(LuaUtilTraceRecorderTest, writeChromeTraceShouldWriteEventsOfAllRecorders)
+    {
+        TraceRecorder first(1);
+        first.addCall(-1, "a\"b", start + 1ms, start + 3ms);
+        TraceRecorder second(1);
+        second.addSample(-1, "c", start + 2ms);
+        const LuaUtil::ScriptsConfiguration configuration;
+        const std::vector<const TraceRecorder*> recorders{ &first, &second };
+
+        std::ostringstream stream;
+        LuaUtil::writeChromeTrace(stream, recorders, configuration);
+
+        const std::string trace = stream.str();
+        EXPECT_THAT(trace, StartsWith("{\"traceEvents\":["));
+        EXPECT_THAT(trace, HasSubstr("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1"));
+        EXPECT_THAT(trace,
+            HasSubstr("\"name\":\"[internal] a\\\"b\",\"cat\":\"call\",\"ph\":\"X\",\"ts\":1000.000000,"
+                      "\"dur\":2000.000000,\"pid\":0,\"tid\":0}"));
+        EXPECT_THAT(trace,
+            HasSubstr("\"name\":\"[internal] c\",\"cat\":\"sample\",\"ph\":\"i\",\"s\":\"t\",\"ts\":2000.000000,"
+                      "\"pid\":0,\"tid\":1}"));
+        EXPECT_THAT(trace, EndsWith("],\"displayTimeUnit\":\"ms\"}\n"));
+    }
+}
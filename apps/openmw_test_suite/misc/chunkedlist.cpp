@@ -0,0 +1,126 @@
+#include <components/misc/chunkedlist.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    template <class T, std::size_t maxChunkSize>
+    std::vector<T> toVector(const ChunkedList<T, maxChunkSize>& list)
+    {
+        return std::vector<T>(list.begin(), list.end());
+    }
+
+    TEST(MiscChunkedListTest, emptyListShouldHaveNoElements)
+    {
+        const ChunkedList<int> list;
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.size(), 0);
+        EXPECT_EQ(list.begin(), list.end());
+    }
+
+    TEST(MiscChunkedListTest, shouldIterateOverElementsInInsertionOrder)
+    {
+        ChunkedList<int, 8> list;
+        std::vector<int> expected;
+        for (int i = 0; i < 100; ++i)
+        {
+            list.push_back(i);
+            expected.push_back(i);
+        }
+        EXPECT_EQ(list.size(), 100);
+        EXPECT_EQ(list.front(), 0);
+        EXPECT_EQ(list.back(), 99);
+        EXPECT_EQ(toVector(list), expected);
+    }
+
+    TEST(MiscChunkedListTest, pushBackShouldNotMoveExistingElements)
+    {
+        ChunkedList<int, 8> list;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < 100; ++i)
+            addresses.push_back(&list.emplace_back(i));
+        int i = 0;
+        for (const int& value : list)
+            EXPECT_EQ(&value, addresses[i++]);
+    }
+
+    TEST(MiscChunkedListTest, endShouldStayValidAfterPushBack)
+    {
+        ChunkedList<int> list;
+        list.push_back(1);
+        const ChunkedList<int>::iterator end = list.end();
+        list.push_back(2);
+        EXPECT_EQ(end, list.end());
+        EXPECT_EQ(*--list.end(), 2);
+    }
+
+    TEST(MiscChunkedListTest, eraseShouldKeepOtherElementsInPlace)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        const int* const last = &list.back();
+        auto it = std::find(list.begin(), list.end(), 5);
+        it = list.erase(it);
+        EXPECT_EQ(*it, 6);
+        it = list.erase(list.begin());
+        EXPECT_EQ(*it, 1);
+        EXPECT_EQ(list.size(), 8);
+        EXPECT_EQ(&list.back(), last);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 2, 3, 4, 6, 7, 8, 9));
+    }
+
+    TEST(MiscChunkedListTest, eraseAtTheEndShouldReuseSlots)
+    {
+        ChunkedList<int> list;
+        list.push_back(1);
+        list.push_back(2);
+        EXPECT_EQ(list.erase(--list.end()), list.end());
+        list.push_back(3);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 3));
+        list.erase(list.begin());
+        list.erase(list.begin());
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.begin(), list.end());
+    }
+
+    TEST(MiscChunkedListTest, iteratorShouldMoveBackwardOverHoles)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        list.erase(std::find(list.begin(), list.end(), 4));
+        list.erase(std::find(list.begin(), list.end(), 5));
+        std::vector<int> reversed;
+        for (auto it = list.end(); it != list.begin();)
+            reversed.push_back(*--it);
+        EXPECT_THAT(reversed, ElementsAre(9, 8, 7, 6, 3, 2, 1, 0));
+    }
+
+    TEST(MiscChunkedListTest, copyShouldSkipHoles)
+    {
+        ChunkedList<int> list;
+        for (int i = 0; i < 5; ++i)
+            list.push_back(i);
+        list.erase(std::find(list.begin(), list.end(), 2));
+        const ChunkedList<int> copy(list);
+        EXPECT_EQ(copy.size(), 4);
+        EXPECT_THAT(toVector(copy), ElementsAre(0, 1, 3, 4));
+    }
+
+    TEST(MiscChunkedListTest, moveShouldKeepAddresses)
+    {
+        ChunkedList<int> list;
+        const int* const first = &list.emplace_back(1);
+        ChunkedList<int> moved(std::move(list));
+        EXPECT_EQ(&moved.front(), first);
+        EXPECT_TRUE(list.empty());
+    }
+}
@@ -0,0 +1,100 @@
+#include <components/misc/flathashmap.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscFlatHashMapTest, emptyMapShouldHaveNoValues)
+    {
+        const FlatHashMap<int, int> map;
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.find(1), nullptr);
+        EXPECT_EQ(map.begin(), map.end());
+    }
+
+    TEST(MiscFlatHashMapTest, emplaceShouldNotReplaceExistingValue)
+    {
+        FlatHashMap<int, int> map;
+        EXPECT_THAT(map.emplace(1, 2), Pair(Pointee(2), true));
+        EXPECT_THAT(map.emplace(1, 3), Pair(Pointee(2), false));
+        EXPECT_EQ(map.size(), 1);
+    }
+
+    TEST(MiscFlatHashMapTest, subscriptShouldInsertDefaultValue)
+    {
+        FlatHashMap<int, int> map;
+        EXPECT_EQ(map[1], 0);
+        map[1] = 42;
+        EXPECT_THAT(map.find(1), Pointee(42));
+    }
+
+    TEST(MiscFlatHashMapTest, shouldSupportHeterogeneousLookup)
+    {
+        FlatHashMap<std::string, int, StringUtils::CiHash, StringUtils::CiEqual> map;
+        map.emplace(std::string_view("Balmora"), 1);
+        EXPECT_THAT(map.find(std::string_view("bALMORA")), Pointee(1));
+        EXPECT_EQ(map.erase(std::string_view("BALMORA")), 1);
+        EXPECT_TRUE(map.empty());
+    }
+
+    TEST(MiscFlatHashMapTest, shouldHandleCollidingHashes)
+    {
+        struct ConstantHash
+        {
+            std::size_t operator()(int) const { return 13; }
+        };
+        FlatHashMap<int, int, ConstantHash> map;
+        for (int i = 0; i < 10; ++i)
+            map.emplace(i, i * 10);
+        EXPECT_EQ(map.erase(3), 1);
+        EXPECT_EQ(map.erase(3), 0);
+        EXPECT_EQ(map.find(3), nullptr);
+        for (int i = 0; i < 10; ++i)
+        {
+            if (i != 3)
+                EXPECT_THAT(map.find(i), Pointee(i * 10)) << i;
+        }
+    }
+
+    TEST(MiscFlatHashMapTest, shouldBeEquivalentToStdMapForRandomOperations)
+    {
+        FlatHashMap<int, int> map;
+        std::map<int, int> expected;
+        std::minstd_rand random;
+        std::uniform_int_distribution<int> distribution(0, 1000);
+        for (int i = 0; i < 100000; ++i)
+        {
+            const int key = distribution(random);
+            if (distribution(random) % 3 == 0)
+                EXPECT_EQ(map.erase(key), expected.erase(key));
+            else
+                map[key] = expected[key] = i;
+        }
+        EXPECT_EQ(map.size(), expected.size());
+        for (const auto& [key, value] : expected)
+            EXPECT_THAT(map.find(key), Pointee(value)) << key;
+        std::map<int, int> iterated(map.begin(), map.end());
+        EXPECT_EQ(iterated, expected);
+    }
+
+    TEST(MiscFlatHashMapTest, clearShouldRemoveAllValues)
+    {
+        FlatHashMap<int, int> map;
+        map.emplace(1, 1);
+        map.clear();
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.find(1), nullptr);
+        map.emplace(1, 2);
+        EXPECT_THAT(map.find(1), Pointee(2));
+    }
+}
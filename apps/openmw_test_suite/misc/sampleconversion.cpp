@@ -0,0 +1,51 @@
+#include <components/misc/sampleconversion.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(MiscSampleConversionTest, convertSamplesShouldScaleAndClampFloatSamples)
+    {
+        const std::vector<float> input{ 0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, -2.0f };
+        std::vector<std::int16_t> output(input.size());
+        Misc::convertSamples(input, output.data());
+        EXPECT_THAT(output, ElementsAre(0, 16384, -16384, 32767, -32768, 32767, -32768));
+    }
+
+    TEST(MiscSampleConversionTest, interleaveSamplesShouldInterleaveStereoFloatPlanes)
+    {
+        const std::vector<float> left{ 0.5f, 0.25f, 0.0f };
+        const std::vector<float> right{ -0.5f, -0.25f, 1.0f };
+        const std::array<const float*, 2> planes{ left.data(), right.data() };
+        std::vector<std::int16_t> output(6);
+        Misc::interleaveSamples(planes, 3, output.data());
+        EXPECT_THAT(output, ElementsAre(16384, -16384, 8192, -8192, 0, 32767));
+    }
+
+    TEST(MiscSampleConversionTest, interleaveSamplesShouldSupportAnyNumberOfChannels)
+    {
+        const std::vector<std::int16_t> first{ 1, 2 };
+        const std::vector<std::int16_t> second{ 3, 4 };
+        const std::vector<std::int16_t> third{ 5, 6 };
+        const std::array<const std::int16_t*, 3> planes{ first.data(), second.data(), third.data() };
+        std::vector<std::int16_t> output(6);
+        Misc::interleaveSamples(planes, 2, output.data());
+        EXPECT_THAT(output, ElementsAre(1, 3, 5, 2, 4, 6));
+    }
+
+    TEST(MiscSampleConversionTest, interleaveSamplesShouldCopyMonoPlane)
+    {
+        const std::vector<std::int16_t> mono{ 1, -2, 3 };
+        const std::array<const std::int16_t*, 1> planes{ mono.data() };
+        std::vector<std::int16_t> output(3);
+        Misc::interleaveSamples(planes, 3, output.data());
+        EXPECT_EQ(output, mono);
+    }
+}
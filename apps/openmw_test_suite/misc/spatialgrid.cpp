@@ -0,0 +1,65 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<int> getCandidates(const SpatialGrid<int>& grid, const osg::Vec2f& center, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachCandidate(center, radius, [&](int value) { result.push_back(value); });
+        return result;
+    }
+
+    TEST(MiscSpatialGridTest, emptyGridShouldHaveNoCandidates)
+    {
+        const SpatialGrid<int> grid(10);
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(0, 0), 100), IsEmpty());
+    }
+
+    TEST(MiscSpatialGridTest, shouldFindValuesInOverlappingCells)
+    {
+        SpatialGrid<int> grid(10);
+        grid.update(1, osg::Vec2f(1, 1));
+        grid.update(2, osg::Vec2f(-5, 8));
+        for (int i = 0; i < 10; ++i)
+            grid.update(3 + i, osg::Vec2f(100, 100 + 10 * i));
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(0, 0), 5), UnorderedElementsAre(1, 2));
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(100, 115), 10), UnorderedElementsAre(3, 4, 5));
+    }
+
+    TEST(MiscSpatialGridTest, updateShouldMoveValue)
+    {
+        SpatialGrid<int> grid(10);
+        grid.update(1, osg::Vec2f(1, 1));
+        grid.update(1, osg::Vec2f(100, 100));
+        EXPECT_EQ(grid.size(), 1);
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(0, 0), 5), IsEmpty());
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(100, 100), 5), ElementsAre(1));
+    }
+
+    TEST(MiscSpatialGridTest, removeShouldRemoveValue)
+    {
+        SpatialGrid<int> grid(10);
+        grid.update(1, osg::Vec2f(1, 1));
+        grid.update(2, osg::Vec2f(2, 2));
+        grid.remove(1);
+        grid.remove(3);
+        EXPECT_EQ(grid.size(), 1);
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(0, 0), 5), ElementsAre(2));
+    }
+
+    TEST(MiscSpatialGridTest, largeRadiusShouldCoverAllValues)
+    {
+        SpatialGrid<int> grid(10);
+        grid.update(1, osg::Vec2f(-1000, 1000));
+        grid.update(2, osg::Vec2f(1000, -1000));
+        EXPECT_THAT(getCandidates(grid, osg::Vec2f(0, 0), 1e30f), UnorderedElementsAre(1, 2));
+    }
+}
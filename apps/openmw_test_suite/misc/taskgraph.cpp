@@ -0,0 +1,88 @@
+#include <components/misc/taskgraph.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscTaskGraphTest, runShouldReturnTimingOfEachTaskInOrderOfAddition)
+    {
+        TaskGraph graph;
+        graph.add("first", TaskGraph::Thread::Any, {}, [] {});
+        graph.add("second", TaskGraph::Thread::Caller, {}, [] {});
+        const std::vector<TaskGraph::Timing> timings = graph.run();
+        ASSERT_EQ(timings.size(), 2);
+        EXPECT_EQ(timings[0].mName, "first");
+        EXPECT_EQ(timings[1].mName, "second");
+    }
+
+    TEST(MiscTaskGraphTest, callerTasksShouldRunOnCallingThread)
+    {
+        TaskGraph graph;
+        std::thread::id id;
+        graph.add("caller", TaskGraph::Thread::Caller, {}, [&] { id = std::this_thread::get_id(); });
+        graph.run();
+        EXPECT_EQ(id, std::this_thread::get_id());
+    }
+
+    TEST(MiscTaskGraphTest, taskShouldStartAfterItsDependencies)
+    {
+        TaskGraph graph;
+        std::mutex mutex;
+        std::vector<int> order;
+        const auto push = [&](int value) {
+            return [&, value] {
+                const std::lock_guard lock(mutex);
+                order.push_back(value);
+            };
+        };
+        const TaskGraph::TaskId first = graph.add("first", TaskGraph::Thread::Any, {}, push(1));
+        const TaskGraph::TaskId second = graph.add("second", TaskGraph::Thread::Caller, { first }, push(2));
+        graph.add("third", TaskGraph::Thread::Any, { first, second }, push(3));
+        graph.run();
+        EXPECT_EQ(order, (std::vector<int>{ 1, 2, 3 }));
+    }
+
+    TEST(MiscTaskGraphTest, independentTasksShouldRunConcurrently)
+    {
+        TaskGraph graph;
+        std::atomic_bool started{ false };
+        std::atomic_bool released{ false };
+        graph.add("waiting", TaskGraph::Thread::Any, {}, [&] {
+            started = true;
+            while (!released)
+                std::this_thread::yield();
+        });
+        graph.add("releasing", TaskGraph::Thread::Caller, {}, [&] {
+            while (!started)
+                std::this_thread::yield();
+            released = true;
+        });
+        graph.run();
+        EXPECT_TRUE(released);
+    }
+
+    TEST(MiscTaskGraphTest, runShouldRethrowAndSkipDependentsWhenTaskThrows)
+    {
+        TaskGraph graph;
+        bool dependentRun = false;
+        const TaskGraph::TaskId failing = graph.add(
+            "failing", TaskGraph::Thread::Any, {}, [] { throw std::runtime_error("failure"); });
+        graph.add("dependent", TaskGraph::Thread::Caller, { failing }, [&] { dependentRun = true; });
+        EXPECT_THROW(graph.run(), std::runtime_error);
+        EXPECT_FALSE(dependentRun);
+    }
+
+    TEST(MiscTaskGraphTest, addShouldThrowForDependencyNotAddedYet)
+    {
+        TaskGraph graph;
+        EXPECT_THROW(graph.add("task", TaskGraph::Thread::Any, { 0 }, [] {}), std::invalid_argument);
+    }
+}
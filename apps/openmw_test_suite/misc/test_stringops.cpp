@@ -6,9 +6,12 @@
 
 #include <components/misc/algorithm.hpp>
 
+#include <algorithm>
+#include <random>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 struct PartialBinarySearchTest : public ::testing::Test
 {
@@ -232,4 +235,62 @@ namespace
     {
         EXPECT_EQ(ciFind("foobar", "baz"), std::string_view::npos);
     }
+
+    // Covers the bytes around the letters, non-ASCII bytes and lengths around a multiple of the word size
+    std::vector<std::string> generateCaseFoldingCases()
+    {
+        constexpr std::string_view chars = "@AMZ[`amz{\x80\xc1\xda\xe1\xfa";
+        std::minstd_rand random(42);
+        std::uniform_int_distribution<std::size_t> size(0, 20);
+        std::uniform_int_distribution<std::size_t> index(0, chars.size() - 1);
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            std::string value(size(random), ' ');
+            std::generate(value.begin(), value.end(), [&] { return chars[index(random)]; });
+            result.push_back(std::move(value));
+        }
+        return result;
+    }
+
+    TEST(MiscStringsLowerCase, should_lower_case_each_byte_with_to_lower)
+    {
+        std::string value;
+        for (int c = 0; c < 256; ++c)
+            value.push_back(static_cast<char>(c));
+        for (std::size_t offset = 0; offset < 8; ++offset)
+        {
+            const std::string_view input = std::string_view(value).substr(offset);
+            std::string expected(input);
+            std::transform(expected.begin(), expected.end(), expected.begin(), [](char c) { return toLower(c); });
+            EXPECT_EQ(lowerCase(input), expected);
+        }
+    }
+
+    TEST(MiscStringsCiCompare, should_match_char_by_char_comparison)
+    {
+        const std::vector<std::string> values = generateCaseFoldingCases();
+        for (std::size_t i = 0; i + 1 < values.size(); ++i)
+        {
+            const std::string& x = values[i];
+            const std::string& y = values[i + 1];
+            const std::string lowerX = lowerCase(x);
+            const std::string lowerY = lowerCase(y);
+            EXPECT_EQ(ciLess(x, y), std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), CiCharLess()))
+                << x << " " << y;
+            EXPECT_EQ(ciEqual(x, y), lowerX == lowerY) << x << " " << y;
+            EXPECT_TRUE(ciEqual(x, lowerX)) << x;
+            EXPECT_EQ(ciEndsWith(x, y), lowerX.ends_with(lowerY)) << x << " " << y;
+
+            // Strings with long equal prefixes
+            const std::string prefixedX = lowerX + x;
+            const std::string prefixedY = x + y;
+            EXPECT_EQ(ciLess(prefixedX, prefixedY),
+                std::lexicographical_compare(
+                    prefixedX.begin(), prefixedX.end(), prefixedY.begin(), prefixedY.end(), CiCharLess()))
+                << prefixedX << " " << prefixedY;
+            EXPECT_EQ(ciEqual(prefixedX, prefixedY), lowerCase(prefixedX) == lowerCase(prefixedY))
+                << prefixedX << " " << prefixedY;
+        }
+    }
 }
@@ -0,0 +1,86 @@
+#include <components/misc/workstealingrange.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<std::size_t> takeAll(WorkStealingRange& range, std::size_t worker)
+    {
+        std::vector<std::size_t> result;
+        while (const std::optional<WorkStealingRange::Chunk> chunk = range.take(worker))
+            for (std::size_t i = chunk->mBegin; i < chunk->mEnd; ++i)
+                result.push_back(i);
+        return result;
+    }
+
+    TEST(MiscWorkStealingRangeTest, emptyRangeShouldHaveNoChunks)
+    {
+        WorkStealingRange range(2);
+        range.reset(0, 1);
+        EXPECT_FALSE(range.take(0).has_value());
+        EXPECT_FALSE(range.take(1).has_value());
+    }
+
+    TEST(MiscWorkStealingRangeTest, workerShouldStartWithItsOwnShare)
+    {
+        WorkStealingRange range(2);
+        range.reset(10, 2);
+        const std::optional<WorkStealingRange::Chunk> chunk = range.take(1);
+        ASSERT_TRUE(chunk.has_value());
+        EXPECT_EQ(chunk->mBegin, 5);
+        EXPECT_EQ(chunk->mEnd, 7);
+    }
+
+    TEST(MiscWorkStealingRangeTest, chunkShouldNotExceedShare)
+    {
+        WorkStealingRange range(2);
+        range.reset(5, 4);
+        const std::optional<WorkStealingRange::Chunk> chunk = range.take(0);
+        ASSERT_TRUE(chunk.has_value());
+        EXPECT_EQ(chunk->mBegin, 0);
+        EXPECT_EQ(chunk->mEnd, 2);
+    }
+
+    TEST(MiscWorkStealingRangeTest, singleWorkerShouldStealAllShares)
+    {
+        WorkStealingRange range(3);
+        range.reset(10, 3);
+        std::vector<std::size_t> expected(10);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(takeAll(range, 0), expected);
+    }
+
+    TEST(MiscWorkStealingRangeTest, resetShouldRestoreAllChunks)
+    {
+        WorkStealingRange range(2);
+        range.reset(4, 1);
+        takeAll(range, 0);
+        range.reset(3, 1);
+        EXPECT_EQ(takeAll(range, 1), (std::vector<std::size_t>{ 1, 2, 0 }));
+    }
+
+    TEST(MiscWorkStealingRangeTest, concurrentWorkersShouldTakeEachIndexOnce)
+    {
+        constexpr std::size_t workers = 4;
+        constexpr std::size_t size = 10000;
+        WorkStealingRange range(workers);
+        range.reset(size, 7);
+        std::vector<std::vector<std::size_t>> taken(workers);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < workers; ++i)
+            threads.emplace_back([&, i] { taken[i] = takeAll(range, i); });
+        for (std::thread& thread : threads)
+            thread.join();
+        std::vector<std::size_t> counts(size);
+        for (const std::vector<std::size_t>& indices : taken)
+            for (std::size_t index : indices)
+                ++counts[index];
+        EXPECT_EQ(counts, std::vector<std::size_t>(size, 1));
+    }
+}
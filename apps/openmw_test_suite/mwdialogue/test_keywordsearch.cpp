@@ -130,3 +130,55 @@ TEST_F(KeywordSearchTest, keyword_test_russian_ascii_before)
     EXPECT_EQ(matches.size(), 1);
     EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "Доложить Каю Косадесу");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_prefix_and_suffix_keywords)
+{
+    // Keywords being a prefix or a suffix of other keywords are found where the longer one doesn't match
+    MWDialogue::KeywordSearch<int> search;
+    search.seed("dwemer", 1);
+    search.seed("dwemer ruins", 2);
+    search.seed("ruins", 3);
+
+    std::string text = "Dwemer ruins are full of dwemer artifacts, not all ruins are dwemer ruin";
+
+    std::vector<MWDialogue::KeywordSearch<int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "Dwemer ruins");
+    EXPECT_EQ(matches[0].mValue, 2);
+    EXPECT_EQ(std::string(matches[1].mBeg, matches[1].mEnd), "dwemer");
+    EXPECT_EQ(matches[1].mValue, 1);
+    EXPECT_EQ(std::string(matches[2].mBeg, matches[2].mEnd), "ruins");
+    EXPECT_EQ(matches[2].mValue, 3);
+    EXPECT_EQ(std::string(matches[3].mBeg, matches[3].mEnd), "dwemer");
+    EXPECT_EQ(matches[3].mValue, 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_seed_after_search)
+{
+    MWDialogue::KeywordSearch<int> search;
+    search.seed("caius", 0);
+
+    std::string text = "Caius Cosades";
+
+    std::vector<MWDialogue::KeywordSearch<int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ(matches.size(), 1);
+
+    search.seed("caius cosades", 1);
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0].mValue, 1);
+
+    int value = -1;
+    EXPECT_TRUE(search.containsKeyword("CAIUS", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(search.containsKeyword("caius c", value));
+
+    search.clear();
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    EXPECT_TRUE(matches.empty());
+}
@@ -0,0 +1,72 @@
+#include "apps/openmw/mwrender/dynamicresolution.hpp"
+
+#include <gtest/gtest.h>
+
+namespace MWRender
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr double targetTime = 0.016;
+
+        unsigned updateUntilChanged(DynamicResolution& resolution, double gpuTime, unsigned maxFrames = 1000)
+        {
+            for (unsigned i = 1; i <= maxFrames; ++i)
+                if (resolution.update(gpuTime))
+                    return i;
+            return 0;
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldStartAtMaxScale)
+        {
+            const DynamicResolution resolution(0.5f, 0.9f, targetTime);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.9f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldKeepScaleWhenUnderTarget)
+        {
+            DynamicResolution resolution(0.5f, 1.0f, targetTime);
+            EXPECT_EQ(updateUntilChanged(resolution, targetTime / 2), 0);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 1.0f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldNotChangeBeforeEnoughFrames)
+        {
+            DynamicResolution resolution(0.5f, 1.0f, targetTime);
+            EXPECT_EQ(updateUntilChanged(resolution, targetTime * 2), DynamicResolution::sFramesBetweenChanges);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldLowerScaleProportionallyToPixelCount)
+        {
+            DynamicResolution resolution(0.25f, 1.0f, targetTime);
+            EXPECT_NE(updateUntilChanged(resolution, targetTime * 4), 0);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.5f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldNotGoBelowMinScale)
+        {
+            DynamicResolution resolution(0.75f, 1.0f, targetTime);
+            EXPECT_NE(updateUntilChanged(resolution, targetTime * 4), 0);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.75f);
+            EXPECT_EQ(updateUntilChanged(resolution, targetTime * 4), 0);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldRaiseScaleStepByStepWithHeadroom)
+        {
+            DynamicResolution resolution(0.5f, 1.0f, targetTime);
+            EXPECT_NE(updateUntilChanged(resolution, targetTime * 4), 0);
+            EXPECT_NE(updateUntilChanged(resolution, targetTime / 4), 0);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.55f);
+        }
+
+        TEST(MWRenderDynamicResolutionTest, shouldNotRaiseScaleWhenNextStepWouldExceedTarget)
+        {
+            DynamicResolution resolution(0.5f, 1.0f, targetTime);
+            EXPECT_NE(updateUntilChanged(resolution, targetTime * 4), 0);
+            // At 0.55 the frames would take 0.95 of the target, more than the headroom allows
+            EXPECT_EQ(updateUntilChanged(resolution, targetTime * 0.95 * (0.5 * 0.5) / (0.55 * 0.55)), 0);
+            EXPECT_FLOAT_EQ(resolution.getScale(), 0.5f);
+        }
+    }
+}
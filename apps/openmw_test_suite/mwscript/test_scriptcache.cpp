@@ -0,0 +1,77 @@
+#include "../testing_util.hpp"
+
+#include <components/compiler/scriptcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <optional>
+#include <utility>
+
+namespace Compiler
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct CompilerScriptCacheTest : Test
+        {
+            const std::filesystem::path mDirectory = TestingOpenMW::outputFilePath("scriptcache");
+            std::optional<ScriptCache> mCache;
+
+            CompilerScriptCacheTest()
+            {
+                std::filesystem::remove_all(mDirectory);
+                mCache.emplace(mDirectory, "content");
+            }
+        };
+
+        TEST_F(CompilerScriptCacheTest, readShouldReturnNulloptForMissingScript)
+        {
+            EXPECT_FALSE(mCache->read(mCache->getKey("script", "begin script\nend")).has_value());
+        }
+
+        TEST_F(CompilerScriptCacheTest, keyShouldDependOnScriptIdSourceAndContent)
+        {
+            const std::string key = mCache->getKey("script", "begin script\nend");
+            EXPECT_NE(key, mCache->getKey("other", "begin script\nend"));
+            EXPECT_NE(key, mCache->getKey("script", "begin other\nend"));
+            EXPECT_NE(key, ScriptCache(mDirectory, "other").getKey("script", "begin script\nend"));
+        }
+
+        TEST_F(CompilerScriptCacheTest, readShouldReturnWrittenScript)
+        {
+            Interpreter::Program program;
+            program.mInstructions = { 1, 2, 0x2000000 };
+            program.mIntegers = { -3, 42 };
+            program.mFloats = { 0.5f };
+            program.mStrings = { "", "string" };
+            Locals locals;
+            locals.declare('f', "third");
+            locals.declare('s', "first");
+            locals.declare('l', "second");
+            locals.declare('s', "fourth");
+
+            const std::string key = mCache->getKey("script", "source");
+            mCache->write(key, program, locals);
+            const std::optional<CachedScript> result = mCache->read(key);
+
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mProgram.mInstructions, program.mInstructions);
+            EXPECT_EQ(result->mProgram.mIntegers, program.mIntegers);
+            EXPECT_EQ(result->mProgram.mFloats, program.mFloats);
+            EXPECT_EQ(result->mProgram.mStrings, program.mStrings);
+            EXPECT_EQ(result->mLocals.get('s'), std::as_const(locals).get('s'));
+            EXPECT_EQ(result->mLocals.get('l'), std::as_const(locals).get('l'));
+            EXPECT_EQ(result->mLocals.get('f'), std::as_const(locals).get('f'));
+        }
+
+        TEST_F(CompilerScriptCacheTest, readShouldReturnNulloptForCorruptedFile)
+        {
+            const std::string key = mCache->getKey("script", "source");
+            mCache->write(key, Interpreter::Program(), Locals());
+            std::filesystem::resize_file(mDirectory / (key + ".script"), 6);
+            EXPECT_FALSE(mCache->read(key).has_value());
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <sstream>
 
+#include <components/compiler/programanalysis.hpp>
+
 #include "test_utils.hpp"
 
 namespace
@@ -477,6 +479,57 @@ set a to 1
 ( GetDisabled == 1 )
 GetDisabled == 1
 
+End)mwscript";
+
+    const std::string sActivationOnly = R"mwscript(Begin activation_only
+
+short done
+
+if ( OnActivate )
+    set done to 1
+    Activate
+endif
+
+End)mwscript";
+
+    const std::string sActivationOnlyCompared = R"mwscript(Begin activation_only_compared
+
+if ( OnActivate == 1 )
+    Activate
+endif
+
+End)mwscript";
+
+    const std::string sActivationAndTimer = R"mwscript(Begin activation_and_timer
+
+float timer
+
+if ( OnActivate )
+    Activate
+endif
+
+set timer to timer + GetSecondsPassed
+
+End)mwscript";
+
+    const std::string sActivationElse = R"mwscript(Begin activation_else
+
+short state
+
+if ( OnActivate )
+    Activate
+else
+    set state to 1
+endif
+
+End)mwscript";
+
+    const std::string sActivationComparedToZero = R"mwscript(Begin activation_compared_to_zero
+
+if ( OnActivate == 0 )
+    Activate
+endif
+
 End)mwscript";
 
     TEST_F(MWScriptTest, mwscript_test_invalid)
@@ -935,4 +988,26 @@ End)mwscript";
         registerExtensions();
         EXPECT_FALSE(!compile(sIssue6807));
     }
+
+    TEST_F(MWScriptTest, activation_only_script_should_be_detected)
+    {
+        registerExtensions();
+        for (const std::string& text : { sActivationOnly, sActivationOnlyCompared })
+        {
+            const std::optional<CompiledScript> script = compile(text);
+            ASSERT_TRUE(script.has_value());
+            EXPECT_TRUE(Compiler::isActivationOnly(script->mProgram));
+        }
+    }
+
+    TEST_F(MWScriptTest, script_doing_more_than_reacting_to_activation_should_not_be_activation_only)
+    {
+        registerExtensions();
+        for (const std::string& text : { sScript1, sActivationAndTimer, sActivationElse, sActivationComparedToZero })
+        {
+            const std::optional<CompiledScript> script = compile(text);
+            ASSERT_TRUE(script.has_value());
+            EXPECT_FALSE(Compiler::isActivationOnly(script->mProgram));
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "../testing_util.hpp"
+
+#include "apps/openmw/mwsound/loudnesscache.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <optional>
+#include <sstream>
+
+namespace MWSound
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr float samplesPerSecond = 20;
+
+        struct MWSoundLoudnessCacheTest : Test
+        {
+            const std::filesystem::path mDirectory = TestingOpenMW::outputFilePath("loudnesscache");
+            std::optional<LoudnessCache> mCache;
+
+            MWSoundLoudnessCacheTest()
+            {
+                std::filesystem::remove_all(mDirectory);
+                mCache.emplace(mDirectory);
+            }
+
+            std::string getKey(const std::string& content) const
+            {
+                std::istringstream stream(content);
+                return mCache->getKey("sound/vo/a.mp3", stream);
+            }
+        };
+
+        TEST_F(MWSoundLoudnessCacheTest, readShouldReturnNulloptForMissingFile)
+        {
+            EXPECT_FALSE(mCache->read(getKey("content"), samplesPerSecond).has_value());
+        }
+
+        TEST_F(MWSoundLoudnessCacheTest, keyShouldDependOnContent)
+        {
+            EXPECT_EQ(getKey("content"), getKey("content"));
+            EXPECT_NE(getKey("content"), getKey("other"));
+        }
+
+        TEST_F(MWSoundLoudnessCacheTest, readShouldReturnWrittenSamplesWithReducedPrecision)
+        {
+            const std::string key = getKey("content");
+            const std::vector<float> samples{ 0.0f, 0.25f, 1.0f, 2.0f };
+            mCache->write(key, samplesPerSecond, samples);
+            const std::optional<std::vector<float>> result = mCache->read(key, samplesPerSecond);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_THAT(*result, ElementsAre(0.0f, FloatNear(0.25f, 1.0f / 255), 1.0f, 1.0f));
+        }
+
+        TEST_F(MWSoundLoudnessCacheTest, readShouldReturnNulloptForOtherSamplesPerSecond)
+        {
+            const std::string key = getKey("content");
+            mCache->write(key, samplesPerSecond, std::vector<float>{ 0.5f });
+            EXPECT_FALSE(mCache->read(key, samplesPerSecond * 2).has_value());
+        }
+    }
+}
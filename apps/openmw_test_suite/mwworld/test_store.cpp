@@ -430,6 +430,93 @@ TYPED_TEST_P(StoreTest, overwrite_test)
     }
 }
 
+/// Tests loading of records read ahead of time.
+TYPED_TEST_P(StoreTest, parse_test)
+{
+    using RecordType = TypeParam;
+
+    for (const ESM::FormatVersion formatVersion : getFormats())
+    {
+        SCOPED_TRACE("FormatVersion: " + std::to_string(formatVersion));
+
+        const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+        RecordType record;
+        if constexpr (hasBlankFunction<RecordType>)
+            record.blank();
+        record.mId = recordId;
+        record.mModel = "the_model";
+
+        ESM::ESMReader reader;
+        ESM::Dialogue* dialogue = nullptr;
+        MWWorld::ESMStore esmStore;
+
+        const auto loadParsed = [&](bool deleted) {
+            reader.open(getEsmFile(record, deleted, formatVersion), "filename");
+            std::vector<std::unique_ptr<MWWorld::PendingRecord>> pending = esmStore.parse(reader);
+            ASSERT_EQ(pending.size(), 1);
+            ASSERT_NE(pending.front(), nullptr);
+            // parsing must not modify the store
+            EXPECT_EQ(esmStore.get<RecordType>().getSize(), deleted ? 1 : 0);
+            reader.open(getEsmFile(record, deleted, formatVersion), "filename");
+            esmStore.load(reader, &dummyListener, dialogue, &pending);
+        };
+
+        // master file inserts a record
+        loadParsed(false);
+        esmStore.setUp();
+
+        const RecordType* loadedRec = esmStore.get<RecordType>().search(recordId);
+        ASSERT_NE(loadedRec, nullptr);
+        EXPECT_EQ(loadedRec->mModel, "the_model");
+
+        // now a plugin deletes it
+        loadParsed(true);
+        esmStore.setUp();
+
+        EXPECT_EQ(esmStore.get<RecordType>().getSize(), 0);
+    }
+}
+
+/// Tests restoring of records written into the content cache.
+TYPED_TEST_P(StoreTest, content_cache_test)
+{
+    using RecordType = TypeParam;
+
+    const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+    RecordType record;
+    if constexpr (hasBlankFunction<RecordType>)
+        record.blank();
+    record.mId = recordId;
+    record.mModel = "the_model";
+
+    ESM::ESMReader reader;
+    ESM::Dialogue* dialogue = nullptr;
+    MWWorld::ESMStore esmStore;
+    reader.open(getEsmFile(record, false, ESM::CurrentContentFormatVersion), "filename");
+    esmStore.load(reader, &dummyListener, dialogue);
+
+    auto stream = std::make_unique<std::stringstream>();
+    ESM::ESMWriter writer;
+    writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+    writer.save(*stream);
+    esmStore.writeContentCache(writer);
+
+    MWWorld::ESMStore cachedStore;
+    reader.open(std::move(stream), "cache");
+    cachedStore.readContentCache(reader);
+
+    // records from the content files are skipped when the cache is used
+    reader.open(getEsmFile(record, true, ESM::CurrentContentFormatVersion), "filename");
+    cachedStore.load(reader, &dummyListener, dialogue, nullptr, true);
+    cachedStore.setUp();
+
+    const RecordType* cachedRec = cachedStore.get<RecordType>().search(recordId);
+    ASSERT_NE(cachedRec, nullptr);
+    EXPECT_EQ(cachedRec->mModel, "the_model");
+}
+
 namespace
 {
     using namespace ::testing;
@@ -591,7 +678,7 @@ namespace
         RecordTypesTest, StoreSaveLoadTest, typename AsTestingTypes<RecordTypesWithSave>::Type);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test);
+REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test, parse_test, content_cache_test);
 
 static_assert(std::tuple_size_v<RecordTypesWithModel> == 19);
 
@@ -879,4 +966,39 @@ namespace
         ASSERT_NE(dialogue, nullptr);
         EXPECT_THAT(dialogue->mInfo, ElementsAre(HasIdEqualTo("info0"), HasIdEqualTo("info2")));
     }
+
+    TEST(MWWorldStoreTest, preprocessReferencesShouldGroupReferencesByCell)
+    {
+        constexpr std::uint32_t cellCount = 3;
+        constexpr std::uint32_t referenceCount = 100000;
+
+        MWWorld::Store<ESM4::Cell> cells;
+        for (std::uint32_t i = 0; i < cellCount; ++i)
+        {
+            ESM4::Cell cell;
+            cell.mId = ESM::FormId::fromUint32(i + 1);
+            cell.mCellFlags = ESM4::CELL_Interior;
+            cells.insertStatic(cell);
+        }
+
+        MWWorld::Store<ESM4::Reference> references;
+        for (std::uint32_t i = 0; i < referenceCount; ++i)
+        {
+            ESM4::Reference reference;
+            reference.mId = ESM::FormId::fromUint32(cellCount + i + 1);
+            reference.mParent = ESM::FormId::fromUint32(i % cellCount + 1);
+            references.insertStatic(reference);
+        }
+
+        references.preprocessReferences(cells);
+
+        for (std::uint32_t i = 0; i < cellCount; ++i)
+        {
+            const ESM::RefId cellId = ESM::FormId::fromUint32(i + 1);
+            const auto byCell = references.getByCell(cellId);
+            EXPECT_EQ(byCell.size(), referenceCount / cellCount + (i < referenceCount % cellCount ? 1 : 0));
+            EXPECT_TRUE(std::all_of(byCell.begin(), byCell.end(),
+                [&](const ESM4::Reference* reference) { return reference->mParent == cellId; }));
+        }
+    }
 }
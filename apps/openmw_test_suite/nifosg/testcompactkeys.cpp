@@ -0,0 +1,78 @@
+#include <components/nifosg/compactkeys.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    template <class MapT>
+    MapT makeKeys(std::initializer_list<std::pair<float, typename MapT::ValueType>> values,
+        std::uint32_t type = Nif::InterpolationType_Linear)
+    {
+        MapT result;
+        result.mInterpolationType = type;
+        for (const auto& [time, value] : values)
+        {
+            typename MapT::KeyType key = {};
+            key.mValue = value;
+            result.mKeys.emplace(time, key);
+        }
+        return result;
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldReturnNullptrForEmptyTrack)
+    {
+        EXPECT_EQ(makeCompactKeys(Nif::FloatKeyMap()), nullptr);
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldReturnNullptrForQuadraticTrack)
+    {
+        const auto keys = makeKeys<Nif::FloatKeyMap>({ { 0, 1 }, { 1, 2 } }, Nif::InterpolationType_Quadratic);
+        EXPECT_EQ(makeCompactKeys(keys), nullptr);
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldDropKeysReproducibleByLinearInterpolation)
+    {
+        const auto keys = makeKeys<Nif::Vector3KeyMap>({ { 0, osg::Vec3f(0, 0, 0) }, { 1, osg::Vec3f(1, 2, 3) },
+            { 2, osg::Vec3f(2, 4, 6) }, { 3, osg::Vec3f(0, 0, 0) } });
+        const auto compact = makeCompactKeys(keys);
+        ASSERT_NE(compact, nullptr);
+        EXPECT_THAT(compact->mTimes, ElementsAre(0, 2, 3));
+        EXPECT_EQ(compact->getValue(1), osg::Vec3f(2, 4, 6));
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldKeepKeysWithValuesChangingConstantTrack)
+    {
+        const auto keys = makeKeys<Nif::FloatKeyMap>(
+            { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 2 }, { 4, 2 } }, Nif::InterpolationType_Constant);
+        const auto compact = makeCompactKeys(keys);
+        ASSERT_NE(compact, nullptr);
+        EXPECT_TRUE(compact->mConstant);
+        EXPECT_THAT(compact->mTimes, ElementsAre(0, 1, 2, 4));
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldQuantizeRotationsWithSmallError)
+    {
+        const osg::Quat rotation(0.1, 0.2, 0.3, std::sqrt(1 - 0.14));
+        const auto keys = makeKeys<Nif::QuaternionKeyMap>({ { 0, rotation } });
+        const auto compact = makeCompactKeys(keys);
+        ASSERT_NE(compact, nullptr);
+        EXPECT_EQ(compact->mValues.size(), 1);
+        const osg::Quat restored = compact->getValue(0);
+        for (int i = 0; i < 4; ++i)
+            EXPECT_NEAR(restored[i], rotation[i], 1e-4);
+    }
+
+    TEST(NifOsgMakeCompactKeysTest, shouldShareIdenticalTracks)
+    {
+        const auto keys = makeKeys<Nif::FloatKeyMap>({ { 0, 13 }, { 1, 42 }, { 2, 0 } });
+        const auto first = makeCompactKeys(keys);
+        const auto second = makeCompactKeys(keys);
+        EXPECT_EQ(first, second);
+    }
+}
@@ -0,0 +1,115 @@
+#include "../testing_util.hpp"
+
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapecache.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        const btBvhTriangleMeshShape& getTriangleMesh(const BulletShape& shape)
+        {
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape.mCollisionShape);
+            return *static_cast<const btScaledBvhTriangleMeshShape&>(*compound.getChildShape(0)).getChildShape();
+        }
+
+        struct ResourceBulletShapeCacheTest : Test
+        {
+            const std::filesystem::path mDirectory = TestingOpenMW::outputFilePath("shapecache");
+            osg::ref_ptr<BulletShapeCache> mCache;
+
+            ResourceBulletShapeCacheTest()
+            {
+                std::filesystem::remove_all(mDirectory);
+                mCache = new BulletShapeCache(mDirectory);
+            }
+
+            static osg::ref_ptr<BulletShape> makeShape()
+            {
+                auto mesh = std::make_unique<btTriangleMesh>();
+                mesh->addTriangle(btVector3(0, 0, 0), btVector3(1, 0, 0), btVector3(0, 1, 0));
+                mesh->addTriangle(btVector3(1, 0, 0), btVector3(1, 1, 0), btVector3(0, 1, 0));
+                auto triangleMesh = std::make_unique<TriangleMeshShape>(mesh.release(), true);
+                auto scaled = std::make_unique<ScaledTriangleMeshShape>(triangleMesh.release(), btVector3(2, 3, 4));
+                CollisionShapePtr compound(new btCompoundShape);
+                static_cast<btCompoundShape&>(*compound)
+                    .addChildShape(btTransform(btMatrix3x3::getIdentity(), btVector3(5, 6, 7)), scaled.release());
+
+                osg::ref_ptr<BulletShape> shape(new BulletShape);
+                shape->mCollisionShape = std::move(compound);
+                shape->mCollisionBox.mExtents = osg::Vec3f(1, 2, 3);
+                shape->mCollisionBox.mCenter = osg::Vec3f(4, 5, 6);
+                shape->mAnimatedShapes.emplace(42, 0);
+                shape->mFileName = "meshes/shape.nif";
+                shape->mFileHash = "hash";
+                shape->mVisualCollisionType = VisualCollisionType::Camera;
+                return shape;
+            }
+        };
+
+        TEST_F(ResourceBulletShapeCacheTest, readShouldReturnNullForMissingShape)
+        {
+            EXPECT_EQ(mCache->read(mCache->getKey("meshes/shape.nif", "hash")), nullptr);
+        }
+
+        TEST_F(ResourceBulletShapeCacheTest, keyShouldDependOnFileNameAndHash)
+        {
+            const std::string key = mCache->getKey("meshes/shape.nif", "hash");
+            EXPECT_NE(key, mCache->getKey("meshes/other.nif", "hash"));
+            EXPECT_NE(key, mCache->getKey("meshes/shape.nif", "other"));
+        }
+
+        TEST_F(ResourceBulletShapeCacheTest, readShouldReturnWrittenShape)
+        {
+            const osg::ref_ptr<BulletShape> shape = makeShape();
+            const std::string key = mCache->getKey(shape->mFileName, shape->mFileHash);
+            mCache->write(key, *shape);
+
+            const osg::ref_ptr<BulletShape> result = mCache->read(key);
+            ASSERT_NE(result, nullptr);
+            EXPECT_EQ(result->mFileName, shape->mFileName);
+            EXPECT_EQ(result->mFileHash, shape->mFileHash);
+            EXPECT_EQ(result->mCollisionBox.mExtents, shape->mCollisionBox.mExtents);
+            EXPECT_EQ(result->mCollisionBox.mCenter, shape->mCollisionBox.mCenter);
+            EXPECT_EQ(result->mAnimatedShapes, shape->mAnimatedShapes);
+            EXPECT_EQ(result->mVisualCollisionType, shape->mVisualCollisionType);
+            EXPECT_EQ(result->mAvoidCollisionShape, nullptr);
+
+            ASSERT_NE(result->mCollisionShape, nullptr);
+            ASSERT_TRUE(result->mCollisionShape->isCompound());
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(*result->mCollisionShape);
+            ASSERT_EQ(compound.getNumChildShapes(), 1);
+            EXPECT_EQ(compound.getChildTransform(0).getOrigin(), btVector3(5, 6, 7));
+            ASSERT_EQ(compound.getChildShape(0)->getShapeType(), SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE);
+            const auto& scaled = static_cast<const btScaledBvhTriangleMeshShape&>(*compound.getChildShape(0));
+            EXPECT_EQ(scaled.getLocalScaling(), btVector3(2, 3, 4));
+
+            const btBvhTriangleMeshShape& triangleMesh = *scaled.getChildShape();
+            const btBvhTriangleMeshShape& expectedTriangleMesh = getTriangleMesh(*shape);
+            EXPECT_EQ(triangleMesh.getMeshInterface()->getNumSubParts(), 1);
+            EXPECT_EQ(triangleMesh.getLocalAabbMin(), expectedTriangleMesh.getLocalAabbMin());
+            EXPECT_EQ(triangleMesh.getLocalAabbMax(), expectedTriangleMesh.getLocalAabbMax());
+            EXPECT_NE(const_cast<btBvhTriangleMeshShape&>(triangleMesh).getOptimizedBvh(), nullptr);
+        }
+
+        TEST_F(ResourceBulletShapeCacheTest, writeShouldSkipUnsupportedShape)
+        {
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mCollisionShape.reset(new btBoxShape(btVector3(1, 1, 1)));
+            const std::string key = mCache->getKey("meshes/box.nif", "hash");
+            mCache->write(key, *shape);
+            EXPECT_EQ(mCache->read(key), nullptr);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <components/resource/memorybudget.hpp>
+#include <components/resource/resourcemanager.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Image>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct Manager : GenericResourceManager<int>
+        {
+            Manager()
+                : GenericResourceManager(nullptr, 1)
+            {
+            }
+
+            void add(int key, int imageSize, double timestamp)
+            {
+                osg::ref_ptr<osg::Image> image(new osg::Image);
+                image->allocateImage(imageSize, imageSize, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+                mCache->addEntryToObjectCache(key, image, timestamp);
+            }
+
+            bool contains(int key) { return mCache->getRefFromObjectCacheOrNone(key).has_value(); }
+        };
+
+        struct ResourceMemoryBudgetTest : Test
+        {
+            Manager mFirst;
+            Manager mSecond;
+            BaseResourceManager* const mManagers[2] = { &mFirst, &mSecond };
+            MemoryBudget mBudget;
+        };
+
+        TEST_F(ResourceMemoryBudgetTest, enforceShouldDoNothingWithoutLimit)
+        {
+            mFirst.add(1, 4, 1);
+            mBudget.enforce(10, mManagers);
+            EXPECT_TRUE(mFirst.contains(1));
+            EXPECT_EQ(mBudget.getStats().mBytes, 4 * 4 * 4);
+            EXPECT_EQ(mBudget.getStats().mPressure, 0);
+        }
+
+        TEST_F(ResourceMemoryBudgetTest, enforceShouldEvictMostCostlyItemsOverAllManagers)
+        {
+            mFirst.add(1, 4, 1);
+            mFirst.add(2, 4, 9);
+            mSecond.add(1, 8, 5);
+            mSecond.add(2, 2, 1);
+            mBudget.setLimit(4 * 4 * 4 * 2);
+            mBudget.enforce(10, mManagers);
+            EXPECT_FALSE(mSecond.contains(1));
+            EXPECT_FALSE(mFirst.contains(1));
+            EXPECT_TRUE(mFirst.contains(2));
+            EXPECT_TRUE(mSecond.contains(2));
+            const MemoryBudgetStats stats = mBudget.getStats();
+            EXPECT_EQ(stats.mBytes, 4 * 4 * 4 + 2 * 2 * 4);
+            EXPECT_EQ(stats.mPressure, 1);
+            EXPECT_EQ(stats.mEvicted, 2);
+            EXPECT_EQ(stats.mEvictedBytes, 8 * 8 * 4 + 4 * 4 * 4);
+        }
+
+        TEST_F(ResourceMemoryBudgetTest, enforceShouldKeepItemsUsedAtReferenceTime)
+        {
+            mFirst.add(1, 4, 10);
+            mBudget.setLimit(1);
+            mBudget.enforce(10, mManagers);
+            EXPECT_TRUE(mFirst.contains(1));
+            EXPECT_EQ(mBudget.getStats().mPressure, 1);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include <components/resource/multiobjectcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Object>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct Object : osg::Object
+        {
+            Object() = default;
+
+            Object(const Object& other, const osg::CopyOp& copyOp = osg::CopyOp())
+                : osg::Object(other, copyOp)
+            {
+            }
+
+            META_Object(ResourceTest, Object)
+        };
+
+        TEST(ResourceMultiObjectCacheTest, takeFromObjectCacheShouldReturnEachAddedObjectOnce)
+        {
+            osg::ref_ptr<MultiObjectCache> cache(new MultiObjectCache);
+            cache->addEntryToObjectCache("key", new Object);
+            cache->addEntryToObjectCache("key", new Object);
+
+            EXPECT_NE(cache->takeFromObjectCache("key"), nullptr);
+            EXPECT_NE(cache->takeFromObjectCache("key"), nullptr);
+            EXPECT_EQ(cache->takeFromObjectCache("key"), nullptr);
+            EXPECT_EQ(cache->getStats().mGet, 3u);
+            EXPECT_EQ(cache->getStats().mHit, 2u);
+        }
+
+        TEST(ResourceMultiObjectCacheTest, updateShouldKeepObjectsUntilExpiryDelayPassed)
+        {
+            osg::ref_ptr<MultiObjectCache> cache(new MultiObjectCache);
+            cache->addEntryToObjectCache("key", new Object);
+
+            cache->update(10, 5);
+            cache->update(14, 5);
+            EXPECT_EQ(cache->getStats().mSize, 1u);
+
+            cache->update(15.5, 5);
+            EXPECT_EQ(cache->getStats().mSize, 0u);
+            EXPECT_EQ(cache->getStats().mExpired, 1u);
+        }
+
+        TEST(ResourceMultiObjectCacheTest, updateShouldKeepObjectsReferencedElsewhere)
+        {
+            osg::ref_ptr<MultiObjectCache> cache(new MultiObjectCache);
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache("key", value);
+
+            cache->update(10, 5);
+            cache->update(20, 5);
+
+            EXPECT_EQ(cache->takeFromObjectCache("key"), value);
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <osg/Image>
 #include <osg/Object>
 
 namespace Resource
@@ -121,6 +122,86 @@ namespace Resource
             ASSERT_EQ(cache->getStats().mExpired, 1);
         }
 
+        osg::ref_ptr<osg::Image> makeImage(int size)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            return image;
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldReportBytesOfStoredItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->addEntryToObjectCache(1, makeImage(4));
+            cache->addEntryToObjectCache(2, makeImage(2));
+            cache->addEntryToObjectCache(3, nullptr);
+            EXPECT_EQ(cache->getStats().mBytes, 4 * 4 * 4 + 2 * 2 * 4);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, addEntryToObjectCacheShouldReplaceBytesOfExistingItem)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->addEntryToObjectCache(42, makeImage(4));
+            cache->addEntryToObjectCache(42, makeImage(2));
+            EXPECT_EQ(cache->getStats().mBytes, 2 * 2 * 4);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, removeFromObjectCacheShouldSubtractBytes)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->addEntryToObjectCache(1, makeImage(4));
+            cache->addEntryToObjectCache(2, makeImage(2));
+            cache->removeFromObjectCache(1);
+            EXPECT_EQ(cache->getStats().mBytes, 2 * 2 * 4);
+            cache->clear();
+            EXPECT_EQ(cache->getStats().mBytes, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldSubtractBytesOfExpiredItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+
+            const double referenceTime = 1;
+            const double expiryDelay = 1;
+
+            cache->addEntryToObjectCache(42, makeImage(4));
+            cache->update(referenceTime, expiryDelay);
+            ASSERT_EQ(cache->getStats().mBytes, 4 * 4 * 4);
+
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+            EXPECT_EQ(cache->getStats().mBytes, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, collectEvictionCandidatesShouldSkipReferencedAndUninitializedItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            const osg::ref_ptr<osg::Image> referenced = makeImage(4);
+            cache->addEntryToObjectCache(1, referenced, 1);
+            cache->addEntryToObjectCache(2, makeImage(4), 0);
+            cache->addEntryToObjectCache(3, makeImage(2), 1);
+            std::vector<EvictionCandidate> candidates;
+            cache->collectEvictionCandidates(3, candidates);
+            ASSERT_EQ(candidates.size(), 1);
+            EXPECT_EQ(candidates[0].mBytes, 2 * 2 * 4);
+            EXPECT_EQ(candidates[0].mCost, 2 * 2 * 2 * 4);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, evictShouldRemoveUnusedItemsCostingAtLeastMinCost)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->addEntryToObjectCache(1, makeImage(4), 1);
+            cache->addEntryToObjectCache(2, makeImage(2), 1);
+            cache->addEntryToObjectCache(3, makeImage(4), 2);
+            const EvictionResult result = cache->evict(3, getEvictionCost(3, 1, 4 * 4 * 4));
+            EXPECT_EQ(result.mCount, 1);
+            EXPECT_EQ(result.mBytes, 4 * 4 * 4);
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(1), std::nullopt);
+            EXPECT_NE(cache->getRefFromObjectCache(2), nullptr);
+            EXPECT_NE(cache->getRefFromObjectCache(3), nullptr);
+            EXPECT_EQ(cache->getStats().mBytes, 2 * 2 * 4 + 4 * 4 * 4);
+            EXPECT_EQ(cache->getStats().mEvicted, 1);
+        }
+
         TEST(ResourceGenericObjectCacheTest, updateShouldKeepExternallyReferencedItems)
         {
             osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
@@ -0,0 +1,97 @@
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/residentsize.hpp>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Image>
+#include <osg/Material>
+#include <osg/Texture2D>
+
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        osg::ref_ptr<osg::Geometry> makeGeometry()
+        {
+            osg::ref_ptr<osg::Geometry> geometry(new osg::Geometry);
+            geometry->setVertexArray(new osg::Vec3Array(4));
+            osg::ref_ptr<osg::DrawElementsUShort> indices(new osg::DrawElementsUShort(GL_TRIANGLES));
+            for (unsigned short index : { 0, 1, 2, 2, 1, 3 })
+                indices->push_back(index);
+            geometry->addPrimitiveSet(indices);
+            return geometry;
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, shouldCountSharedGeometryOnce)
+        {
+            const osg::ref_ptr<osg::Geometry> geometry = makeGeometry();
+            osg::ref_ptr<osg::Group> root(new osg::Group);
+            for (int i = 0; i < 2; ++i)
+            {
+                osg::ref_ptr<osg::Geode> geode(new osg::Geode);
+                geode->addDrawable(geometry);
+                root->addChild(geode);
+            }
+            ResidentSizeEstimator estimator;
+            estimator.add(*root);
+            estimator.add(*root);
+            EXPECT_EQ(estimator.getSize(), 4 * sizeof(osg::Vec3f) + 6 * sizeof(unsigned short));
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, shouldCountTextureImages)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(4, 4, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            osg::ref_ptr<osg::Geode> geode(new osg::Geode);
+            geode->getOrCreateStateSet()->setTextureAttributeAndModes(0, new osg::Texture2D(image));
+            ResidentSizeEstimator estimator;
+            estimator.add(*geode);
+            estimator.add(*image);
+            EXPECT_EQ(estimator.getSize(), 4 * 4 * 4);
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, shouldCountTriangleMeshOfCollisionShape)
+        {
+            auto mesh = std::make_unique<btTriangleMesh>();
+            mesh->addTriangle(btVector3(0, 0, 0), btVector3(1, 0, 0), btVector3(0, 1, 0));
+            mesh->addTriangle(btVector3(1, 0, 0), btVector3(1, 1, 0), btVector3(0, 1, 0));
+            const std::size_t meshSize = 6 * 4 * sizeof(btScalar) + 2 * 3 * sizeof(unsigned);
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mCollisionShape.reset(new TriangleMeshShape(mesh.release(), true));
+            ResidentSizeEstimator estimator;
+            estimator.add(*shape);
+            EXPECT_GT(estimator.getSize(), meshSize);
+            const std::size_t size = estimator.getSize();
+            estimator.add(*shape);
+            EXPECT_EQ(estimator.getSize(), size);
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, shouldCountImagesOfTexture)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(4, 4, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            EXPECT_EQ(estimateResidentSize(osg::ref_ptr<osg::Texture2D>(new osg::Texture2D(image))), 4 * 4 * 4);
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, shouldIgnoreUnknownObjects)
+        {
+            ResidentSizeEstimator estimator;
+            estimator.add(*osg::ref_ptr<osg::Material>(new osg::Material));
+            EXPECT_EQ(estimator.getSize(), 0);
+        }
+
+        TEST(ResourceResidentSizeEstimatorTest, estimateResidentSizeShouldReturnZeroForNullptr)
+        {
+            EXPECT_EQ(estimateResidentSize(nullptr), 0);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <components/resource/statsexporter.hpp>
+
+#include <osg/Stats>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+        using namespace TestingOpenMW;
+
+        std::vector<std::string> readLines(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path);
+            std::vector<std::string> result;
+            for (std::string line; std::getline(stream, line);)
+                result.push_back(std::move(line));
+            return result;
+        }
+
+        TEST(ResourceStatsExporterTest, parseStatsExportFormatShouldSupportKnownFormats)
+        {
+            EXPECT_EQ(parseStatsExportFormat("csv"), StatsExportFormat::Csv);
+            EXPECT_EQ(parseStatsExportFormat("line-protocol"), StatsExportFormat::LineProtocol);
+            EXPECT_EQ(parseStatsExportFormat("json"), std::nullopt);
+        }
+
+        TEST(ResourceStatsExporterTest, shouldWriteCsvWithEmptyCellsForMissingAttributes)
+        {
+            const auto path = outputFilePath("stats_export_test.csv");
+            osg::ref_ptr<osg::Stats> stats(new osg::Stats("test"));
+            stats->setAttribute(0, "Node Count", 3);
+            {
+                StatsExporter exporter(path, StatsExportFormat::Csv, { "Node Count", "Missing" }, 1);
+                exporter.collect(0, *stats);
+            }
+            const std::vector<std::string> lines = readLines(path);
+            ASSERT_EQ(lines.size(), 2);
+            EXPECT_EQ(lines[0], "frame,timestamp,Node Count,Missing");
+            EXPECT_THAT(lines[1], MatchesRegex("0,[0-9]+,3,"));
+        }
+
+        TEST(ResourceStatsExporterTest, shouldEscapeLineProtocolKeysAndSkipMissingAttributes)
+        {
+            const auto path = outputFilePath("stats_export_test.txt");
+            osg::ref_ptr<osg::Stats> stats(new osg::Stats("test"));
+            stats->setAttribute(0, "Node Count", 3);
+            {
+                StatsExporter exporter(path, StatsExportFormat::LineProtocol, { "Node Count", "Missing" }, 1);
+                exporter.collect(0, *stats);
+            }
+            const std::vector<std::string> lines = readLines(path);
+            ASSERT_EQ(lines.size(), 1);
+            EXPECT_THAT(lines[0], MatchesRegex("openmw frame=0i,Node\\\\ Count=3 [0-9]+"));
+        }
+
+        TEST(ResourceStatsExporterTest, shouldCollectOnlyFramesMatchingInterval)
+        {
+            const auto path = outputFilePath("stats_export_interval_test.csv");
+            osg::ref_ptr<osg::Stats> stats(new osg::Stats("test"));
+            {
+                StatsExporter exporter(path, StatsExportFormat::Csv, { "Value" }, 2);
+                for (unsigned frameNumber = 0; frameNumber < 5; ++frameNumber)
+                {
+                    stats->setAttribute(frameNumber, "Value", frameNumber * 10);
+                    exporter.collect(frameNumber, *stats);
+                }
+            }
+            const std::vector<std::string> lines = readLines(path);
+            ASSERT_EQ(lines.size(), 4);
+            EXPECT_THAT(lines[1], MatchesRegex("0,[0-9]+,0"));
+            EXPECT_THAT(lines[2], MatchesRegex("2,[0-9]+,20"));
+            EXPECT_THAT(lines[3], MatchesRegex("4,[0-9]+,40"));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include <components/resource/texturecompression.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include <osg/Texture>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        osg::ref_ptr<osg::Image> makeImage(
+            int width, int height, GLenum format, const std::array<std::uint8_t, 4>& color)
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(width, height, 1, format, GL_UNSIGNED_BYTE);
+            const unsigned components = osg::Image::computeNumComponents(format);
+            unsigned char* data = image->data();
+            for (int i = 0; i < width * height; ++i)
+                for (unsigned c = 0; c < components; ++c)
+                    data[i * components + c] = color[c];
+            return image;
+        }
+
+        TEST(ResourceTextureCompressionTest, shouldNotCompressImageWithSizeNotMultipleOfBlockSize)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(6, 4, GL_RGB, { 255, 0, 0, 255 });
+            EXPECT_FALSE(isCompressible(*image));
+            EXPECT_EQ(compressImage(*image), nullptr);
+        }
+
+        TEST(ResourceTextureCompressionTest, shouldCompressOpaqueImageIntoDxt1WithMipmaps)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(8, 4, GL_RGB, { 255, 0, 0, 255 });
+            const osg::ref_ptr<osg::Image> compressed = compressImage(*image);
+            ASSERT_NE(compressed, nullptr);
+            EXPECT_EQ(compressed->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGB_S3TC_DXT1_EXT));
+            EXPECT_EQ(compressed->s(), 8);
+            EXPECT_EQ(compressed->t(), 4);
+            // 8x4, 4x2, 2x1 and 1x1 levels
+            EXPECT_THAT(compressed->getMipmapLevels(), ElementsAre(16u, 24u, 32u));
+            const unsigned char* data = compressed->data(0);
+            // Pure red is 0xf800 in RGB565
+            EXPECT_THAT(std::vector<unsigned char>(data, data + 8), ElementsAre(0x00, 0xf8, 0x00, 0xf8, 0, 0, 0, 0));
+        }
+
+        TEST(ResourceTextureCompressionTest, shouldCompressTranslucentImageIntoDxt5)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(4, 4, GL_RGBA, { 0, 0, 255, 128 });
+            const osg::ref_ptr<osg::Image> compressed = compressImage(*image);
+            ASSERT_NE(compressed, nullptr);
+            EXPECT_EQ(compressed->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT));
+            EXPECT_THAT(compressed->getMipmapLevels(), ElementsAre(16u, 32u));
+            const unsigned char* data = compressed->data(0);
+            EXPECT_THAT(std::vector<unsigned char>(data, data + 16),
+                ElementsAre(128, 128, 0, 0, 0, 0, 0, 0, 0x1f, 0x00, 0x1f, 0x00, 0, 0, 0, 0));
+        }
+
+        TEST(ResourceTextureCompressionTest, compressedGradientShouldUseEndpointsFromBothEnds)
+        {
+            osg::ref_ptr<osg::Image> image = makeImage(4, 4, GL_RGB, { 0, 0, 0, 255 });
+            unsigned char* data = image->data();
+            for (int i = 0; i < 16; ++i)
+                data[i * 3] = data[i * 3 + 1] = data[i * 3 + 2] = static_cast<unsigned char>((i % 4) * 85);
+            const osg::ref_ptr<osg::Image> compressed = compressImage(*image);
+            ASSERT_NE(compressed, nullptr);
+            const unsigned char* block = compressed->data(0);
+            EXPECT_EQ(block[0] | (block[1] << 8), 0xffff);
+            EXPECT_EQ(block[2] | (block[3] << 8), 0x0000);
+            // Each row goes from black through both interpolated colours to white
+            const std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (block[7] << 24);
+            for (int row = 0; row < 4; ++row)
+                EXPECT_EQ((indices >> (8 * row)) & 0xff, 0b00'10'11'01u) << row;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <components/sceneutil/clone.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/MatrixTransform>
+
+#include <gtest/gtest.h>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct NodeCallback : osg::NodeCallback
+        {
+        };
+
+        struct SceneUtilCloneTest : Test
+        {
+            osg::ref_ptr<osg::Group> mRoot = new osg::Group;
+            osg::ref_ptr<osg::MatrixTransform> mStatic = new osg::MatrixTransform;
+            osg::ref_ptr<osg::MatrixTransform> mAnimated = new osg::MatrixTransform;
+            osg::ref_ptr<osg::MatrixTransform> mStaticChild = new osg::MatrixTransform;
+
+            SceneUtilCloneTest()
+            {
+                mRoot->addChild(mStatic);
+                mRoot->addChild(mAnimated);
+                mStatic->addChild(new osg::Geometry);
+                mAnimated->addChild(mStaticChild);
+                mAnimated->setUpdateCallback(new NodeCallback);
+                mStaticChild->addChild(new osg::Geometry);
+            }
+
+            osg::ref_ptr<osg::Group> clone(bool shareSubgraphs) const
+            {
+                const CopyOp copyOp(shareSubgraphs);
+                return static_cast<osg::Group*>(mRoot->clone(copyOp));
+            }
+        };
+
+        TEST_F(SceneUtilCloneTest, shouldMarkLargestSubgraphsWithoutCallbacks)
+        {
+            markSharedSubgraphs(*mRoot);
+
+            EXPECT_FALSE(isSharedSubgraph(*mRoot));
+            EXPECT_TRUE(isSharedSubgraph(*mStatic));
+            EXPECT_FALSE(isSharedSubgraph(*mAnimated));
+            EXPECT_TRUE(isSharedSubgraph(*mStaticChild));
+        }
+
+        TEST_F(SceneUtilCloneTest, shouldNotMarkLightAttachmentNodes)
+        {
+            mStatic->setName("AttachLight");
+
+            markSharedSubgraphs(*mRoot);
+
+            EXPECT_FALSE(isSharedSubgraph(*mStatic));
+        }
+
+        TEST_F(SceneUtilCloneTest, shouldShareMarkedSubgraphsOnlyWhenRequested)
+        {
+            markSharedSubgraphs(*mRoot);
+
+            const osg::ref_ptr<osg::Group> shared = clone(true);
+            EXPECT_NE(shared, mRoot);
+            EXPECT_EQ(shared->getChild(0), mStatic);
+            ASSERT_NE(shared->getChild(1), mAnimated);
+            EXPECT_EQ(shared->getChild(1)->asGroup()->getChild(0), mStaticChild);
+
+            const osg::ref_ptr<osg::Group> copied = clone(false);
+            EXPECT_NE(copied->getChild(0), mStatic);
+            EXPECT_NE(copied->getChild(1)->asGroup()->getChild(0), mStaticChild);
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include <components/sceneutil/hizbuffer.hpp>
+
+#include <gtest/gtest.h>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr int width = 64;
+        constexpr int height = 32;
+
+        osg::BoundingBox makeBox(const osg::Vec3f& center, float halfSize)
+        {
+            const osg::Vec3f extent(halfSize, halfSize, halfSize);
+            return osg::BoundingBox(center - extent, center + extent);
+        }
+
+        struct SceneUtilHiZBufferTest : Test
+        {
+            HiZBuffer mBuffer;
+            // The camera is at the origin looking along -z, a wall at the depth of 0.999 is about 500 units away
+            const osg::Matrix mViewProjection = osg::Matrix::perspective(90, 2, 1, 1000);
+            const std::vector<float> mDepth = std::vector<float>(width * height, 0.999f);
+        };
+
+        TEST_F(SceneUtilHiZBufferTest, emptyBufferShouldNotOccludeAnything)
+        {
+            EXPECT_FALSE(mBuffer.isValid());
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -800), 10)));
+            EXPECT_EQ(mBuffer.getNumTested(), 0);
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, buildShouldCreateLevelsDownToSingleTexel)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            EXPECT_TRUE(mBuffer.isValid());
+            EXPECT_EQ(mBuffer.getNumLevels(), 7);
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, boxBehindDepthShouldBeOccluded)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            EXPECT_TRUE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -800), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, boxInFrontOfDepthShouldNotBeOccluded)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -100), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, boxBehindHoleInDepthShouldNotBeOccluded)
+        {
+            std::vector<float> depth = mDepth;
+            depth[(height / 2) * width + width / 2] = 1;
+            mBuffer.build(depth, width, height, mViewProjection, false);
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -800), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, boxOutsideOfScreenShouldNotBeOccluded)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(2000, 0, -800), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, boxCrossingNearPlaneShouldNotBeOccluded)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, 0), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, reversedDepthShouldBeNormalized)
+        {
+            // Maps the near plane to 1 and the far plane to 0
+            osg::Matrix reversed = mViewProjection;
+            reversed(2, 2) = 1.f / 999;
+            reversed(3, 2) = 1000.f / 999;
+            mBuffer.build(std::vector<float>(width * height, 1 - 0.999f), width, height, reversed, true);
+            EXPECT_TRUE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -800), 10)));
+            EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -100), 10)));
+        }
+
+        TEST_F(SceneUtilHiZBufferTest, testsShouldBeCounted)
+        {
+            mBuffer.build(mDepth, width, height, mViewProjection, false);
+            mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -800), 10));
+            mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, -100), 10));
+            EXPECT_EQ(mBuffer.getNumTested(), 2);
+            EXPECT_EQ(mBuffer.getNumOccluded(), 1);
+            mBuffer.resetStats();
+            EXPECT_EQ(mBuffer.getNumTested(), 0);
+            EXPECT_EQ(mBuffer.getNumOccluded(), 0);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <components/sceneutil/lightcluster.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct SceneUtilLightClusterGridTest : Test
+        {
+            LightClusterGrid mGrid;
+
+            SceneUtilLightClusterGridTest() { mGrid.reset(osg::Matrix::perspective(90, 1, 1, 10000), 1000); }
+        };
+
+        TEST_F(SceneUtilLightClusterGridTest, getSliceShouldCoverDepthFromNearToFar)
+        {
+            EXPECT_EQ(mGrid.getSlice(0), 0);
+            EXPECT_EQ(mGrid.getSlice(LightClusterGrid::sNear), 0);
+            EXPECT_EQ(mGrid.getSlice(999), LightClusterGrid::sSizeZ - 1);
+            EXPECT_EQ(mGrid.getSlice(2000), LightClusterGrid::sSizeZ);
+            EXPECT_LT(mGrid.getSlice(100), mGrid.getSlice(500));
+        }
+
+        TEST_F(SceneUtilLightClusterGridTest, lightInFrontOfCameraShouldBeAddedToClustersItIntersects)
+        {
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(0, 0, -100), 10));
+            const int slice = mGrid.getSlice(100);
+            EXPECT_THAT(mGrid.getLights(LightClusterGrid::sSizeX / 2, LightClusterGrid::sSizeY / 2, slice),
+                ElementsAre(1));
+            EXPECT_THAT(mGrid.getLights(0, 0, slice), IsEmpty());
+            EXPECT_THAT(mGrid.getLights(LightClusterGrid::sSizeX / 2, LightClusterGrid::sSizeY / 2, 0), IsEmpty());
+        }
+
+        TEST_F(SceneUtilLightClusterGridTest, lightBehindCameraShouldBeIgnored)
+        {
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(0, 0, 100), 10));
+            osg::ref_ptr<osg::IntArray> data = new osg::IntArray;
+            mGrid.write(*data);
+            EXPECT_EQ(data->size(), static_cast<std::size_t>(LightClusterGrid::sNumClusters));
+        }
+
+        TEST_F(SceneUtilLightClusterGridTest, lightAroundCameraShouldBeAddedToAllNearClusters)
+        {
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(0, 0, 0), 50));
+            EXPECT_THAT(mGrid.getLights(0, 0, 0), ElementsAre(1));
+            EXPECT_THAT(
+                mGrid.getLights(LightClusterGrid::sSizeX - 1, LightClusterGrid::sSizeY - 1, mGrid.getSlice(49)),
+                ElementsAre(1));
+        }
+
+        TEST_F(SceneUtilLightClusterGridTest, writeShouldStoreOffsetAndCountFollowedByLightIndices)
+        {
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(0, 0, 0), 50));
+            mGrid.addLight(2, osg::BoundingSphere(osg::Vec3f(0, 0, 0), 20));
+            osg::ref_ptr<osg::IntArray> data = new osg::IntArray;
+            mGrid.write(*data);
+            ASSERT_GT(data->size(), static_cast<std::size_t>(LightClusterGrid::sNumClusters + 2));
+            EXPECT_EQ((*data)[0], (LightClusterGrid::sNumClusters << 8) | 2);
+            EXPECT_EQ((*data)[LightClusterGrid::sNumClusters], 1);
+            EXPECT_EQ((*data)[LightClusterGrid::sNumClusters + 1], 2);
+            EXPECT_EQ((*data)[1], ((LightClusterGrid::sNumClusters + 2) << 8) | 2);
+        }
+    }
+}
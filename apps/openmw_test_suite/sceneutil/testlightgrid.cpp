@@ -0,0 +1,66 @@
+#include <components/sceneutil/lightgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct SceneUtilLightGridTest : Test
+        {
+            LightGrid mGrid;
+            std::vector<int> mLights;
+        };
+
+        TEST_F(SceneUtilLightGridTest, getLightsShouldReturnLightsInOverlappingCells)
+        {
+            mGrid.addLight(0, osg::BoundingSphere(osg::Vec3f(100, 100, 0), 50));
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(5000, 5000, 0), 50));
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(150, 100, 1000), 10), mLights);
+            EXPECT_THAT(mLights, ElementsAre(0));
+        }
+
+        TEST_F(SceneUtilLightGridTest, getLightsShouldIgnoreHeight)
+        {
+            mGrid.addLight(0, osg::BoundingSphere(osg::Vec3f(100, 100, -10000), 50));
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(100, 100, 10000), 10), mLights);
+            EXPECT_THAT(mLights, ElementsAre(0));
+        }
+
+        TEST_F(SceneUtilLightGridTest, getLightsShouldReturnLightsCoveringMultipleCellsOnceInAscendingOrder)
+        {
+            mGrid.addLight(3, osg::BoundingSphere(osg::Vec3f(0, 0, 0), LightGrid::sCellSize * 2));
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(-10, -10, 0), LightGrid::sCellSize));
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(0, 0, 0), LightGrid::sCellSize), mLights);
+            EXPECT_THAT(mLights, ElementsAre(1, 3));
+        }
+
+        TEST_F(SceneUtilLightGridTest, getLightsShouldReturnLargeLightsForAnyBound)
+        {
+            mGrid.addLight(0, osg::BoundingSphere(osg::Vec3f(0, 0, 0), LightGrid::sCellSize * 10));
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(1e6, 1e6, 0), 10), mLights);
+            EXPECT_THAT(mLights, ElementsAre(0));
+        }
+
+        TEST_F(SceneUtilLightGridTest, getLightsForLargeBoundShouldReturnAllLights)
+        {
+            mGrid.addLight(0, osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10));
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(1e5, 1e5, 0), 10));
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 1e9), mLights);
+            EXPECT_THAT(mLights, ElementsAre(0, 1));
+        }
+
+        TEST_F(SceneUtilLightGridTest, clearShouldRemoveAllLights)
+        {
+            mGrid.addLight(0, osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10));
+            mGrid.addLight(1, osg::BoundingSphere(osg::Vec3f(0, 0, 0), LightGrid::sCellSize * 10));
+            mGrid.clear();
+            mGrid.getLights(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10), mLights);
+            EXPECT_THAT(mLights, IsEmpty());
+            EXPECT_EQ(mGrid.getNumLights(), 0);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/rigmerger.hpp>
+
+#include <osg/Array>
+#include <osg/Geometry>
+#include <osg/PrimitiveSet>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        osg::ref_ptr<RigGeometry> makeRig(const std::vector<std::string>& bones, float offset)
+        {
+            osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
+            vertices->push_back(osg::Vec3f(offset, 0, 0));
+            vertices->push_back(osg::Vec3f(offset + 1, 0, 0));
+            vertices->push_back(osg::Vec3f(offset, 1, 0));
+
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+            geometry->setVertexArray(vertices);
+            osg::ref_ptr<osg::DrawElementsUShort> triangles = new osg::DrawElementsUShort(osg::PrimitiveSet::TRIANGLES);
+            triangles->push_back(0);
+            triangles->push_back(1);
+            triangles->push_back(2);
+            geometry->addPrimitiveSet(triangles);
+
+            std::vector<RigGeometry::BoneInfo> boneInfo;
+            std::vector<RigGeometry::BoneWeights> influences(vertices->size());
+            for (std::size_t i = 0; i < bones.size(); ++i)
+            {
+                boneInfo.push_back(RigGeometry::BoneInfo{ bones[i], osg::BoundingSpheref(), osg::Matrixf() });
+                influences[i % influences.size()].emplace_back(i, 1.f);
+            }
+
+            osg::ref_ptr<RigGeometry> rig = new RigGeometry;
+            rig->setBoneInfo(std::move(boneInfo));
+            rig->setInfluences(influences);
+            rig->setSourceGeometry(geometry);
+            return rig;
+        }
+
+        TEST(SceneUtilRigMergerTest, shouldConcatenateVerticesAndOffsetIndices)
+        {
+            const osg::ref_ptr<RigGeometry> merged
+                = mergeRigGeometries({ makeRig({ "Bip01" }, 0), makeRig({ "Bip01" }, 10) });
+
+            ASSERT_NE(merged, nullptr);
+            EXPECT_EQ(getRigVertexCount(*merged), 6u);
+            const osg::Geometry& source = *merged->getSourceGeometry();
+            ASSERT_EQ(source.getNumPrimitiveSets(), 1u);
+            const osg::PrimitiveSet& triangles = *source.getPrimitiveSet(0);
+            ASSERT_EQ(triangles.getNumIndices(), 6u);
+            EXPECT_EQ(triangles.index(3), 3u);
+            EXPECT_EQ(triangles.index(5), 5u);
+        }
+
+        TEST(SceneUtilRigMergerTest, shouldShareBonesWithSameNameAndBindPose)
+        {
+            const osg::ref_ptr<RigGeometry> merged
+                = mergeRigGeometries({ makeRig({ "Bip01", "Bip01 Head" }, 0), makeRig({ "Bip01 Head" }, 10) });
+
+            ASSERT_NE(merged, nullptr);
+            ASSERT_EQ(merged->getBoneInfo().size(), 2u);
+            const std::vector<RigGeometry::BoneWeights> influences = merged->getInfluences();
+            ASSERT_EQ(influences.size(), 6u);
+            ASSERT_EQ(influences[3].size(), 1u);
+            EXPECT_EQ(merged->getBoneInfo()[influences[3][0].first].mName, "Bip01 Head");
+        }
+
+        TEST(SceneUtilRigMergerTest, shouldNotMergeTooManyVertices)
+        {
+            std::vector<osg::ref_ptr<RigGeometry>> rigs(sMaxMergedRigVertices / 3 + 1, makeRig({ "Bip01" }, 0));
+            EXPECT_EQ(mergeRigGeometries(rigs), nullptr);
+        }
+    }
+}
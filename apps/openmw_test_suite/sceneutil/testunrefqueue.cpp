@@ -0,0 +1,92 @@
+#include <components/sceneutil/unrefqueue.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct BlockingWorkItem : WorkItem
+        {
+            std::promise<void> mStarted;
+            std::shared_future<void> mRelease;
+
+            explicit BlockingWorkItem(std::shared_future<void> release)
+                : mRelease(std::move(release))
+            {
+            }
+
+            void doWork() override
+            {
+                mStarted.set_value();
+                mRelease.wait();
+            }
+        };
+
+        struct EmptyWorkItem : WorkItem
+        {
+        };
+
+        struct Deleted
+        {
+            std::thread::id& mThreadId;
+
+            ~Deleted() { mThreadId = std::this_thread::get_id(); }
+        };
+
+        struct SceneUtilUnrefQueueTest : Test
+        {
+            std::promise<void> mRelease;
+            osg::ref_ptr<BlockingWorkItem> mBlocking{ new BlockingWorkItem(mRelease.get_future().share()) };
+            osg::ref_ptr<WorkQueue> mWorkQueue{ new WorkQueue(1) };
+            UnrefQueue mUnrefQueue;
+            std::thread::id mSharedThreadId;
+            std::thread::id mUniqueThreadId;
+
+            SceneUtilUnrefQueueTest()
+            {
+                std::future<void> started = mBlocking->mStarted.get_future();
+                mWorkQueue->addWorkItem(mBlocking);
+                started.wait();
+            }
+
+            void waitForWorkQueue()
+            {
+                osg::ref_ptr<WorkItem> last(new EmptyWorkItem);
+                mWorkQueue->addWorkItem(last, WorkPriority::Speculative);
+                last->waitTillDone();
+            }
+        };
+
+        TEST_F(SceneUtilUnrefQueueTest, flushShouldDestroySmartPointersInWorkerThread)
+        {
+            mUnrefQueue.push(std::make_shared<Deleted>(mSharedThreadId));
+            mUnrefQueue.push(std::make_unique<Deleted>(mUniqueThreadId));
+            EXPECT_EQ(mUnrefQueue.getSharedSize(), 2u);
+
+            mUnrefQueue.flush(*mWorkQueue);
+            EXPECT_EQ(mUnrefQueue.getSharedSize(), 0u);
+            EXPECT_EQ(mSharedThreadId, std::thread::id());
+
+            mRelease.set_value();
+            waitForWorkQueue();
+            EXPECT_NE(mSharedThreadId, std::thread::id());
+            EXPECT_NE(mSharedThreadId, std::this_thread::get_id());
+            EXPECT_EQ(mUniqueThreadId, mSharedThreadId);
+        }
+
+        TEST_F(SceneUtilUnrefQueueTest, flushShouldNotAddWorkItemWhenEmpty)
+        {
+            mUnrefQueue.flush(*mWorkQueue);
+            EXPECT_EQ(mWorkQueue->getNumItems(), 0u);
+            mRelease.set_value();
+        }
+    }
+}
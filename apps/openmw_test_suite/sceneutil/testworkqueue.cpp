@@ -0,0 +1,188 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct BlockingWorkItem : WorkItem
+        {
+            std::promise<void> mStarted;
+            std::shared_future<void> mRelease;
+
+            explicit BlockingWorkItem(std::shared_future<void> release)
+                : mRelease(std::move(release))
+            {
+            }
+
+            void doWork() override
+            {
+                mStarted.set_value();
+                mRelease.wait();
+            }
+        };
+
+        struct RecordingWorkItem : WorkItem
+        {
+            int mValue;
+            std::mutex& mMutex;
+            std::vector<int>& mOrder;
+
+            RecordingWorkItem(int value, std::mutex& mutex, std::vector<int>& order)
+                : mValue(value)
+                , mMutex(mutex)
+                , mOrder(order)
+            {
+            }
+
+            void doWork() override
+            {
+                const std::lock_guard lock(mMutex);
+                mOrder.push_back(mValue);
+            }
+        };
+
+        struct SceneUtilWorkQueueTest : Test
+        {
+            std::promise<void> mRelease;
+            osg::ref_ptr<BlockingWorkItem> mBlocking{ new BlockingWorkItem(mRelease.get_future().share()) };
+            std::mutex mMutex;
+            std::vector<int> mOrder;
+
+            void blockThread(WorkQueue& queue)
+            {
+                std::future<void> started = mBlocking->mStarted.get_future();
+                queue.addWorkItem(mBlocking);
+                started.wait();
+            }
+        };
+
+        TEST_F(SceneUtilWorkQueueTest, shouldProcessItemsByPriority)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+            blockThread(*queue);
+
+            std::vector<osg::ref_ptr<WorkItem>> items{
+                new RecordingWorkItem(3, mMutex, mOrder),
+                new RecordingWorkItem(2, mMutex, mOrder),
+                new RecordingWorkItem(1, mMutex, mOrder),
+                new RecordingWorkItem(4, mMutex, mOrder),
+            };
+            queue->addWorkItem(items[0], WorkPriority::Speculative);
+            queue->addWorkItem(items[1], WorkPriority::Visible);
+            queue->addWorkItem(items[2], WorkPriority::Urgent);
+            queue->addWorkItem(items[3], WorkPriority::Speculative);
+            EXPECT_EQ(queue->getNumItems(), 4u);
+
+            mRelease.set_value();
+            for (const osg::ref_ptr<WorkItem>& item : items)
+                item->waitTillDone();
+
+            EXPECT_THAT(mOrder, ElementsAre(1, 2, 3, 4));
+            const WorkQueueStats stats = queue->getStats();
+            EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Speculative)].mCompleted, 2u);
+            EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Urgent)].mCompleted, 1u);
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, cancelShouldSkipQueuedItemsOfPriority)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+            blockThread(*queue);
+
+            osg::ref_ptr<WorkItem> speculative(new RecordingWorkItem(1, mMutex, mOrder));
+            osg::ref_ptr<WorkItem> visible(new RecordingWorkItem(2, mMutex, mOrder));
+            queue->addWorkItem(speculative, WorkPriority::Speculative);
+            queue->addWorkItem(visible, WorkPriority::Visible);
+
+            queue->cancel(WorkPriority::Speculative);
+            EXPECT_TRUE(speculative->isDone());
+            EXPECT_TRUE(speculative->isCancelled());
+
+            mRelease.set_value();
+            visible->waitTillDone();
+
+            EXPECT_THAT(mOrder, ElementsAre(2));
+            const WorkQueueStats stats = queue->getStats();
+            EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Speculative)].mCancelled, 1u);
+            EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Speculative)].mQueued, 0u);
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, cancelledItemShouldNotBeProcessed)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+            blockThread(*queue);
+
+            osg::ref_ptr<WorkItem> item(new RecordingWorkItem(1, mMutex, mOrder));
+            queue->addWorkItem(item);
+            item->cancel();
+
+            mRelease.set_value();
+            item->waitTillDone();
+
+            EXPECT_THAT(mOrder, IsEmpty());
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, idleThreadShouldStealItemsFromOtherThreads)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(2));
+            blockThread(*queue);
+
+            // Round-robin distribution puts some of the items into the queue of the blocked thread
+            std::vector<osg::ref_ptr<WorkItem>> items;
+            for (int i = 0; i < 4; ++i)
+            {
+                items.emplace_back(new RecordingWorkItem(i, mMutex, mOrder));
+                queue->addWorkItem(items.back());
+            }
+            for (const osg::ref_ptr<WorkItem>& item : items)
+                item->waitTillDone();
+
+            EXPECT_THAT(mOrder, UnorderedElementsAre(0, 1, 2, 3));
+            EXPECT_GT(queue->getStats().mStolen, 0u);
+
+            mRelease.set_value();
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, parallelForShouldCallFunctionForEachIndexOnce)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(2));
+            std::vector<std::atomic_int> calls(100);
+            queue->parallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+            for (const std::atomic_int& v : calls)
+                EXPECT_EQ(v, 1);
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, parallelForShouldNotWaitForBusyThreads)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+            blockThread(*queue);
+
+            int sum = 0;
+            queue->parallelFor(4, [&](std::size_t i) { sum += static_cast<int>(i); });
+            EXPECT_EQ(sum, 6);
+
+            mRelease.set_value();
+        }
+
+        TEST_F(SceneUtilWorkQueueTest, parallelForShouldRethrowException)
+        {
+            osg::ref_ptr<WorkQueue> queue(new WorkQueue(2));
+            EXPECT_THROW(queue->parallelFor(8,
+                             [](std::size_t i) {
+                                 if (i == 5)
+                                     throw std::runtime_error("error");
+                             }),
+                std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <components/sdlutil/inputrecording.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace SDLUtil;
+
+    SDL_Event makeKeyEvent(Uint32 type, SDL_Scancode scancode)
+    {
+        SDL_Event event{};
+        event.type = type;
+        event.key.keysym.scancode = scancode;
+        return event;
+    }
+
+    TEST(SDLUtilInputRecordingTest, shouldReplayRecordedFrames)
+    {
+        const auto path = outputFilePath("input_recording_test.omwinput");
+        {
+            InputRecorder recorder(path, 42);
+            recorder.addEvent(makeKeyEvent(SDL_KEYDOWN, SDL_SCANCODE_W));
+            recorder.finishFrame(0.25);
+            recorder.finishFrame(0.125);
+            recorder.addEvent(makeKeyEvent(SDL_KEYUP, SDL_SCANCODE_W));
+            recorder.finishFrame(0.5);
+        }
+        InputReplayer replayer(path);
+        EXPECT_EQ(replayer.getSeed(), 42);
+
+        ASSERT_TRUE(replayer.nextFrame());
+        EXPECT_EQ(replayer.getFrameDuration(), 0.25);
+        std::vector<SDL_Event> events = replayer.takeEvents();
+        ASSERT_EQ(events.size(), 1);
+        EXPECT_EQ(events[0].type, SDL_KEYDOWN);
+        EXPECT_EQ(events[0].key.keysym.scancode, SDL_SCANCODE_W);
+
+        ASSERT_TRUE(replayer.nextFrame());
+        EXPECT_EQ(replayer.getFrameDuration(), 0.125);
+        EXPECT_THAT(replayer.takeEvents(), IsEmpty());
+
+        ASSERT_TRUE(replayer.nextFrame());
+        EXPECT_EQ(replayer.getFrameDuration(), 0.5);
+        events = replayer.takeEvents();
+        ASSERT_EQ(events.size(), 1);
+        EXPECT_EQ(events[0].type, SDL_KEYUP);
+
+        EXPECT_FALSE(replayer.nextFrame());
+        EXPECT_EQ(replayer.getFrameNumber(), 3);
+    }
+
+    TEST(SDLUtilInputRecordingTest, shouldThrowOnInvalidFile)
+    {
+        const auto path = outputFilePath("input_recording_invalid_test.omwinput");
+        std::ofstream(path, std::ios::binary) << "not a recording";
+        EXPECT_THROW(InputReplayer{ path }, std::runtime_error);
+    }
+
+    TEST(SDLUtilInputRecordingTest, shouldRecordOnlyInputEvents)
+    {
+        EXPECT_TRUE(isRecordedInputEvent(SDL_KEYDOWN));
+        EXPECT_TRUE(isRecordedInputEvent(SDL_MOUSEMOTION));
+        EXPECT_TRUE(isRecordedInputEvent(SDL_CONTROLLERAXISMOTION));
+        EXPECT_FALSE(isRecordedInputEvent(SDL_WINDOWEVENT));
+        EXPECT_FALSE(isRecordedInputEvent(SDL_QUIT));
+    }
+}
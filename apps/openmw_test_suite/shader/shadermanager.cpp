@@ -232,4 +232,25 @@ namespace
             EXPECT_FALSE(mManager.getShader(Files::pathToUnicodeString(templateName), mDefines));
         });
     }
+
+    TEST_F(ShaderManagerTest, get_program_should_return_same_program_for_same_defines)
+    {
+        const std::filesystem::path templateName = std::filesystem::path("lib")
+            / std::string(UnitTest::GetInstance()->current_test_info()->name());
+        for (const std::string extension : { ".vert", ".frag" })
+        {
+            std::ofstream stream(TestingOpenMW::outputFilePathWithSubDir(templateName.string() + extension));
+            stream << "#version 120\n"
+                      "#define FLAG @flag\n"
+                      "void main() {}\n";
+        }
+
+        mDefines["flag"] = "1";
+        const auto program = mManager.getProgram(Files::pathToUnicodeString(templateName), mDefines);
+        ASSERT_NE(program, nullptr);
+        EXPECT_EQ(mManager.getProgram(Files::pathToUnicodeString(templateName), mDefines), program);
+
+        mDefines["flag"] = "0";
+        EXPECT_NE(mManager.getProgram(Files::pathToUnicodeString(templateName), mDefines), program);
+    }
 }
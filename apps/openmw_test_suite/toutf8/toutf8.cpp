@@ -80,6 +80,34 @@ namespace
         EXPECT_EQ(result, "a\xE2\x80\x99");
     }
 
+    TEST(Utf8EncoderTest, getUtf8ShouldLookUpUntilZeroAfterLongAscii)
+    {
+        const std::string input("abcdefghijk\0lmnopqrstuvwxyz", 27);
+        Utf8Encoder encoder(FromType::CP437);
+        const std::string_view result = encoder.getUtf8(input);
+        EXPECT_EQ(result, "abcdefghijk");
+    }
+
+    TEST(Utf8EncoderTest, getUtf8ShouldLookUpUntilZeroAfterNonAscii)
+    {
+        const std::string input("abcdefghijk\x92lmnopqrstuvwxyz\0abcdefghijk\x92", 40);
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        const std::string_view result = encoder.getUtf8(input);
+        EXPECT_EQ(result, "abcdefghijk\xE2\x80\x99lmnopqrstuvwxyz");
+    }
+
+    TEST(Utf8EncoderTest, getUtf8ShouldConvertNonAsciiBetweenLongAscii)
+    {
+        const std::string input(
+            "abcdefghijk\x92"
+            "lmnopqrstuvwxyz\x92\x92"
+            "abc");
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        const std::string_view result = encoder.getUtf8(input);
+        EXPECT_EQ(result, "abcdefghijk\xE2\x80\x99lmnopqrstuvwxyz\xE2\x80\x99\xE2\x80\x99"
+                          "abc");
+    }
+
     TEST_P(Utf8EncoderTest, getUtf8ShouldConvertFromLegacyEncodingToUtf8)
     {
         const std::string input(readContent(GetParam().mLegacyEncodingFileName));
@@ -130,6 +158,18 @@ namespace
         EXPECT_EQ(result, "a\xe2");
     }
 
+    TEST(Utf8EncoderTest, getLegacyEncShouldConvertNonAsciiBetweenLongAscii)
+    {
+        const std::string input("abcdefghijk\xE2\x80\x99lmnopqrstuvwxyz\xE2\x80\x99\xE2\x80\x99"
+                                "abc");
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        const std::string_view result = encoder.getLegacyEnc(input);
+        EXPECT_EQ(result,
+            "abcdefghijk\x92"
+            "lmnopqrstuvwxyz\x92\x92"
+            "abc");
+    }
+
     TEST_P(Utf8EncoderTest, getLegacyEncShouldConvertFromUtf8ToLegacyEncoding)
     {
         const std::string input(readContent(GetParam().mUtf8FileName));
@@ -0,0 +1,93 @@
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/indexcache.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+
+#include "../testing_util.hpp"
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct VFSIndexCacheTest : Test
+        {
+            const std::filesystem::path mRoot = TestingOpenMW::outputFilePath("vfs_index_cache_test");
+            const std::filesystem::path mCachePath = TestingOpenMW::outputFilePath("vfs_index_cache_test.cache");
+
+            void SetUp() override
+            {
+                std::filesystem::remove_all(mRoot);
+                std::filesystem::remove(mCachePath);
+                std::filesystem::create_directories(mRoot / "Meshes" / "Sub");
+                std::ofstream(mRoot / "Meshes" / "Sub" / "Foo.nif") << "foo";
+                std::ofstream(mRoot / "bar.txt") << "bar";
+            }
+
+            static std::vector<std::string> listResources(FileSystemArchive& archive)
+            {
+                FileMap files;
+                archive.listResources(files);
+                std::vector<std::string> result;
+                for (const auto& [path, file] : files)
+                    result.push_back(path.value());
+                return result;
+            }
+        };
+
+        TEST_F(VFSIndexCacheTest, shouldRestoreListingOfUnmodifiedDirectory)
+        {
+            {
+                IndexCache cache(mCachePath);
+                EXPECT_EQ(cache.find(mRoot), nullptr);
+                FileSystemArchive archive(mRoot, &cache);
+                cache.write();
+            }
+
+            IndexCache cache(mCachePath);
+            const IndexCache::Listing* listing = cache.find(mRoot);
+            ASSERT_NE(listing, nullptr);
+            EXPECT_EQ(listing->mFiles.size(), 2);
+            EXPECT_EQ(listing->mDirectories.size(), 3);
+
+            FileSystemArchive archive(mRoot, &cache);
+            EXPECT_EQ(listResources(archive), (std::vector<std::string>{ "bar.txt", "meshes/sub/foo.nif" }));
+            EXPECT_TRUE(archive.contains(Path::NormalizedView("meshes/sub/foo.nif")));
+        }
+
+        TEST_F(VFSIndexCacheTest, shouldNotRestoreListingOfModifiedDirectory)
+        {
+            {
+                IndexCache cache(mCachePath);
+                FileSystemArchive archive(mRoot, &cache);
+                cache.write();
+            }
+
+            const std::filesystem::path subDirectory = mRoot / "Meshes" / "Sub";
+            std::ofstream(subDirectory / "baz.nif") << "baz";
+            std::filesystem::last_write_time(
+                subDirectory, std::filesystem::last_write_time(subDirectory) + std::chrono::hours(1));
+
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mRoot), nullptr);
+
+            FileSystemArchive archive(mRoot, &cache);
+            EXPECT_EQ(listResources(archive),
+                (std::vector<std::string>{ "bar.txt", "meshes/sub/baz.nif", "meshes/sub/foo.nif" }));
+            ASSERT_NE(cache.find(mRoot), nullptr);
+            EXPECT_EQ(cache.find(mRoot)->mFiles.size(), 3);
+        }
+
+        TEST_F(VFSIndexCacheTest, shouldIgnoreBrokenCacheFile)
+        {
+            std::ofstream(mCachePath, std::ios::binary) << "broken";
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mRoot), nullptr);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct VFSManagerTest : Test
+        {
+            const std::filesystem::path mRoot = TestingOpenMW::outputFilePath("vfs_manager_test");
+            Manager mManager;
+
+            void SetUp() override
+            {
+                std::filesystem::remove_all(mRoot);
+                std::filesystem::create_directories(mRoot / "Meshes");
+                std::ofstream(mRoot / "Meshes" / "Foo.nif") << "foo";
+                std::ofstream(mRoot / "bar.txt") << "bar";
+                mManager.addArchive(std::make_unique<FileSystemArchive>(mRoot));
+                mManager.buildIndex();
+            }
+
+            std::string read(const Path::Normalized& name) const
+            {
+                Files::IStreamPtr stream = mManager.get(name);
+                return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+            }
+        };
+
+        TEST_F(VFSManagerTest, prefetchShouldNotChangeFileContents)
+        {
+            const std::vector<Path::Normalized> names{ Path::Normalized("meshes/foo.nif"),
+                Path::Normalized("bar.txt") };
+            mManager.prefetch(names);
+            EXPECT_EQ(read(names[0]), "foo");
+            EXPECT_EQ(read(names[1]), "bar");
+        }
+
+        TEST_F(VFSManagerTest, prefetchShouldSkipMissingFiles)
+        {
+            const std::vector<Path::Normalized> names{ Path::Normalized("meshes/missing.nif"),
+                Path::Normalized("bar.txt") };
+            EXPECT_NO_THROW(mManager.prefetch(names));
+            EXPECT_EQ(read(names[1]), "bar");
+        }
+
+        TEST_F(VFSManagerTest, prefetchShouldIgnoreFilesRemovedAfterIndexing)
+        {
+            std::filesystem::remove(mRoot / "bar.txt");
+            const std::vector<Path::Normalized> names{ Path::Normalized("bar.txt") };
+            EXPECT_NO_THROW(mManager.prefetch(names));
+        }
+    }
+}
@@ -245,6 +245,15 @@ namespace Bsa
         fail("File not found: " + std::string(file->name()));
     }
 
+    void BA2DX10File::prefetch(const FileStruct* file) const
+    {
+        const std::optional<FileRecord> fileRec = getFileRecord(file->name());
+        if (!fileRec.has_value())
+            return;
+        for (const auto& c : fileRec->texturesChunks)
+            prefetchRegion(c.offset, c.packedSize != 0 ? c.packedSize : c.size);
+    }
+
     void BA2DX10File::addFile(const std::string& filename, std::istream& file)
     {
         assert(false); // not implemented yet
@@ -658,7 +667,7 @@ namespace Bsa
         {
             if (c.packedSize != 0)
             {
-                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, c.packedSize);
+                Files::IStreamPtr streamPtr = openRegion(c.offset, c.packedSize);
                 std::istream* fileStream = streamPtr.get();
 
                 boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
@@ -669,9 +678,13 @@ namespace Bsa
                 boost::iostreams::copy(inputStreamBuf, sr);
             }
             // uncompressed chunk
+            else if (const char* mapped = getMappedRegion(c.offset, c.size))
+            {
+                std::memcpy(memoryStreamPtr->getRawData() + offset, mapped, c.size);
+            }
             else
             {
-                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, c.size);
+                Files::IStreamPtr streamPtr = openRegion(c.offset, c.size);
                 std::istream* fileStream = streamPtr.get();
 
                 fileStream->read(memoryStreamPtr->getRawData() + offset, c.size);
@@ -198,6 +198,13 @@ namespace Bsa
         return getFile(fileRec);
     }
 
+    void BA2GNRLFile::prefetch(const FileStruct* file) const
+    {
+        const FileRecord fileRec = getFileRecord(file->name());
+        if (fileRec.isValid())
+            prefetchRegion(fileRec.offset, fileRec.packedSize ? fileRec.packedSize : fileRec.size);
+    }
+
     void BA2GNRLFile::addFile(const std::string& filename, std::istream& file)
     {
         assert(false); // not implemented yet
@@ -216,8 +223,10 @@ namespace Bsa
 
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
+        if (!fileRecord.packedSize && mMappedFile != nullptr)
+            return openRegion(fileRecord.offset, fileRecord.size);
         const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, inputSize);
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
         if (fileRecord.packedSize)
         {
@@ -48,6 +48,7 @@ namespace Bsa
 
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        void prefetch(const FileStruct* fileStruct) const;
         void addFile(const std::string& filename, std::istream& file);
     };
 }
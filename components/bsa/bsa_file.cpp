@@ -22,9 +22,12 @@
  */
 
 #include "bsa_file.hpp"
+#include "memorystream.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/platform/file.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -234,14 +237,29 @@ void Bsa::BSAFile::writeHeader()
 }
 
 /// Open an archive file.
-void BSAFile::open(const std::filesystem::path& file)
+void BSAFile::open(const std::filesystem::path& file, bool memoryMapped)
 {
     if (mIsLoaded)
         close();
 
     mFilepath = file;
     if (std::filesystem::exists(file))
+    {
         readHeader();
+
+        if (memoryMapped)
+        {
+            try
+            {
+                mMappedFile = std::make_shared<const Platform::File::MappedFile>(file);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to map archive " << file << " into memory, falling back to file reads: "
+                                    << e.what();
+            }
+        }
+    }
     else
     {
         {
@@ -260,12 +278,52 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMappedFile.reset();
     mIsLoaded = false;
 }
 
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile == nullptr)
+        return Files::openConstrainedFileStream(mFilepath, offset, size);
+
+    if (offset > mMappedFile->size() || size > mMappedFile->size() - offset)
+        fail("Region " + std::to_string(offset) + "+" + std::to_string(size) + " is out of archive bounds");
+
+    return std::make_unique<MemoryViewInputStream>(mMappedFile, offset, size);
+}
+
+const char* Bsa::BSAFile::getMappedRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile == nullptr)
+        return nullptr;
+
+    if (offset > mMappedFile->size() || size > mMappedFile->size() - offset)
+        fail("Region " + std::to_string(offset) + "+" + std::to_string(size) + " is out of archive bounds");
+
+    return mMappedFile->data() + offset;
+}
+
+void Bsa::BSAFile::prefetchRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile != nullptr)
+    {
+        mMappedFile->prefetch(offset, size);
+        return;
+    }
+
+    Platform::File::ScopedHandle handle(Platform::File::open(mFilepath));
+    Platform::File::prefetch(handle, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->offset, file->fileSize);
+    return openRegion(file->offset, file->fileSize);
+}
+
+void Bsa::BSAFile::prefetch(const FileStruct* file) const
+{
+    prefetchRegion(file->offset, file->fileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -273,6 +331,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // The archive is going to be modified so the mapping would become stale
+    mMappedFile.reset();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
@@ -26,12 +26,18 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
 
+namespace Platform::File
+{
+    class MappedFile;
+}
+
 namespace Bsa
 {
 
@@ -96,9 +102,25 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Archive contents when it is opened in the memory mapped mode
+        std::shared_ptr<const Platform::File::MappedFile> mMappedFile;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
+        /// Open a region of the archive. Returns a view over the mapped memory when the archive is memory mapped
+        /// and a stream reading the file otherwise.
+        /// @note Thread safe.
+        Files::IStreamPtr openRegion(std::size_t offset, std::size_t size) const;
+
+        /// Returns a pointer to the region of the mapped memory or nullptr if the archive is not memory mapped.
+        /// @note Thread safe.
+        const char* getMappedRegion(std::size_t offset, std::size_t size) const;
+
+        /// Hint the system to read a region of the archive ahead of use, see Platform::File::prefetch.
+        /// @note Thread safe.
+        void prefetchRegion(std::size_t offset, std::size_t size) const;
+
         /// Read header information from the input source
         virtual void readHeader();
         virtual void writeHeader();
@@ -119,8 +141,10 @@ namespace Bsa
             close();
         }
 
-        /// Open an archive file.
-        void open(const std::filesystem::path& file);
+        /// Open an archive file. When memoryMapped is set the whole archive is mapped into memory and the
+        /// contained files are read directly from the mapping. Falls back to reading from the file if the
+        /// mapping fails.
+        void open(const std::filesystem::path& file, bool memoryMapped = false);
 
         void close();
 
@@ -134,6 +158,11 @@ namespace Bsa
          */
         Files::IStreamPtr getFile(const FileStruct* file);
 
+        /// Start reading the contents of a file in the background so a following getFile call does not wait for the
+        /// disk.
+        /// @note Thread safe.
+        void prefetch(const FileStruct* file) const;
+
         void addFile(const std::string& filename, std::istream& file);
 
         /// Get a list of all files
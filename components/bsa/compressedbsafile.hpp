@@ -118,6 +118,7 @@ namespace Bsa
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::open;
+        using BSAFile::prefetch;
 
         CompressedBSAFile() = default;
         virtual ~CompressedBSAFile() = default;
@@ -27,7 +27,10 @@
 #define BSA_MEMORY_STREAM_H
 
 #include <components/files/memorystream.hpp>
+#include <components/platform/file.hpp>
+
 #include <istream>
+#include <memory>
 #include <vector>
 
 namespace Bsa
@@ -53,5 +56,25 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    /**
+        Allows to pass a region of a memory mapped archive as Files::IStreamPtr without copying it.
+
+        The mapping is kept alive until the class instance is destroyed.
+     */
+    class MemoryViewInputStream : public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit MemoryViewInputStream(
+            std::shared_ptr<const Platform::File::MappedFile> mappedFile, std::size_t offset, std::size_t size)
+            : Files::MemBuf(mappedFile->data() + offset, size)
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mMappedFile(std::move(mappedFile))
+        {
+        }
+
+    private:
+        std::shared_ptr<const Platform::File::MappedFile> mMappedFile;
+    };
+
 }
 #endif
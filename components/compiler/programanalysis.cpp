@@ -0,0 +1,54 @@
+#include "programanalysis.hpp"
+
+#include <cstddef>
+
+#include "generator.hpp"
+#include "opcodes.hpp"
+
+namespace Compiler
+{
+    namespace
+    {
+        constexpr unsigned getSegment0Opcode(Interpreter::Type_Code code)
+        {
+            return code >> 24;
+        }
+
+        constexpr unsigned getSegment0Argument(Interpreter::Type_Code code)
+        {
+            return code & 0xffffff;
+        }
+
+        constexpr unsigned opcodePushInt = 0;
+        constexpr unsigned opcodeJumpForward = 1;
+
+        const Interpreter::Type_Code opFetchIntLiteral = Generator::segment5(4);
+        const Interpreter::Type_Code opSkipOnNonZero = Generator::segment5(25);
+        const Interpreter::Type_Code opEqualInt = Generator::segment5(26);
+    }
+
+    bool isActivationOnly(const Interpreter::Program& program)
+    {
+        const std::vector<Interpreter::Type_Code>& code = program.mInstructions;
+        std::size_t pc = 0;
+
+        if (code.empty() || code[pc++] != Generator::segment5(Misc::opcodeOnActivate))
+            return false;
+
+        // Optional "== 1", the integer literal is pushed by its index in the literal table
+        if (pc + 3 <= code.size() && getSegment0Opcode(code[pc]) == opcodePushInt
+            && code[pc + 1] == opFetchIntLiteral && code[pc + 2] == opEqualInt)
+        {
+            const std::size_t index = getSegment0Argument(code[pc]);
+            if (index >= program.mIntegers.size() || program.mIntegers[index] != 1)
+                return false;
+            pc += 3;
+        }
+
+        // The false branch of the if has to jump to the end of the program
+        if (pc + 2 > code.size() || code[pc] != opSkipOnNonZero || getSegment0Opcode(code[pc + 1]) != opcodeJumpForward)
+            return false;
+
+        return pc + 1 + getSegment0Argument(code[pc + 1]) >= code.size();
+    }
+}
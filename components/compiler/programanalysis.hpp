@@ -0,0 +1,14 @@
+#ifndef OPENMW_COMPONENTS_COMPILER_PROGRAMANALYSIS_H
+#define OPENMW_COMPONENTS_COMPILER_PROGRAMANALYSIS_H
+
+#include <components/interpreter/program.hpp>
+
+namespace Compiler
+{
+    /// @return If the whole program is a single "if ( OnActivate )" or "if ( OnActivate == 1 )" block for the
+    /// implicit reference. Running such a program does nothing while the reference is not activated and the default
+    /// activation is already suppressed, so the caller can skip it until the next activation.
+    bool isActivationOnly(const Interpreter::Program& program);
+}
+
+#endif
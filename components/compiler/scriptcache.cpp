@@ -0,0 +1,244 @@
+#include "scriptcache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/endianness.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+namespace Compiler
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'S', 'C', 'C' };
+
+        // Increment when the cached data or the code generated by the compiler changes
+        constexpr std::uint32_t sVersion = 1;
+
+        struct Header
+        {
+            std::uint32_t mVersion = sVersion;
+            std::uint32_t mLittleEndian = Misc::IS_LITTLE_ENDIAN;
+
+            friend bool operator==(const Header& l, const Header& r)
+            {
+                return l.mVersion == r.mVersion && l.mLittleEndian == r.mLittleEndian;
+            }
+        };
+
+        using Strings = std::vector<std::vector<char>>;
+
+        struct Script
+        {
+            std::vector<Interpreter::Type_Code> mInstructions;
+            std::vector<Interpreter::Type_Integer> mIntegers;
+            std::vector<Interpreter::Type_Float> mFloats;
+            Strings mStrings;
+            Strings mShorts;
+            Strings mLongs;
+            Strings mFloatLocals;
+        };
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Header>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, sMagic);
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(sMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, sMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad script cache magic");
+                }
+                visitor(*this, value.mVersion);
+                visitor(*this, value.mLittleEndian);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Script>>
+            {
+                visitor(*this, value.mInstructions);
+                visitor(*this, value.mIntegers);
+                visitor(*this, value.mFloats);
+                visitor(*this, value.mStrings);
+                visitor(*this, value.mShorts);
+                visitor(*this, value.mLongs);
+                visitor(*this, value.mFloatLocals);
+            }
+        };
+
+        Strings toStrings(const std::vector<std::string>& values)
+        {
+            Strings result;
+            result.reserve(values.size());
+            for (const std::string& value : values)
+                result.emplace_back(value.begin(), value.end());
+            return result;
+        }
+
+        std::vector<std::byte> serialize(const Script& script)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            const Header header;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, header);
+            format(sizeAccumulator, script);
+            std::vector<std::byte> buffer(sizeAccumulator.value());
+            Serialization::BinaryWriter writer(buffer.data(), buffer.data() + buffer.size());
+            format(writer, header);
+            format(writer, script);
+            return buffer;
+        }
+
+        CachedScript fromScript(const Script& script)
+        {
+            CachedScript result;
+            result.mProgram.mInstructions = script.mInstructions;
+            result.mProgram.mIntegers = script.mIntegers;
+            result.mProgram.mFloats = script.mFloats;
+            result.mProgram.mStrings.reserve(script.mStrings.size());
+            for (const std::vector<char>& value : script.mStrings)
+                result.mProgram.mStrings.emplace_back(value.begin(), value.end());
+            const auto declare = [&](char type, const Strings& names) {
+                for (const std::vector<char>& name : names)
+                    result.mLocals.declare(type, std::string_view(name.data(), name.size()));
+            };
+            declare('s', script.mShorts);
+            declare('l', script.mLongs);
+            declare('f', script.mFloatLocals);
+            return result;
+        }
+    }
+
+    ScriptCache::ScriptCache(const std::filesystem::path& directory, std::string_view contentKey)
+        : mDirectory(directory)
+        , mContentKey(contentKey)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create script cache directory " << directory << ": " << ec.message();
+            mDirectory.clear();
+        }
+    }
+
+    std::string ScriptCache::getKey(std::string_view scriptId, std::string_view source) const
+    {
+        std::string data(reinterpret_cast<const char*>(&sVersion), sizeof(sVersion));
+        data.append(mContentKey);
+        data.push_back('\0');
+        data.append(scriptId);
+        data.push_back('\0');
+        data.append(source);
+        const std::array<std::uint64_t, 2> hash = Files::getHash(data);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return key.str();
+    }
+
+    std::filesystem::path ScriptCache::getPath(const std::string& key) const
+    {
+        return mDirectory / (key + ".script");
+    }
+
+    std::optional<CachedScript> ScriptCache::read(const std::string& key) const
+    {
+        if (mDirectory.empty())
+            return std::nullopt;
+        const std::filesystem::path path = getPath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        try
+        {
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(path, ec);
+            if (ec)
+                throw std::runtime_error(ec.message());
+            std::vector<std::byte> buffer(static_cast<std::size_t>(size));
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+                throw std::runtime_error("failed to read file");
+
+            constexpr Format<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(buffer.data(), buffer.data() + buffer.size());
+            Header header;
+            format(reader, header);
+            // Written by another version, it is replaced once the script is compiled
+            if (!(header == Header{}))
+                return std::nullopt;
+            Script script;
+            format(reader, script);
+            return fromScript(script);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read cached script " << path << ": " << e.what();
+            return std::nullopt;
+        }
+    }
+
+    void ScriptCache::write(const std::string& key, const Interpreter::Program& program, const Locals& locals) const
+    {
+        if (mDirectory.empty())
+            return;
+        const std::filesystem::path path = getPath(key);
+
+        Script script;
+        script.mInstructions = program.mInstructions;
+        script.mIntegers = program.mIntegers;
+        script.mFloats = program.mFloats;
+        script.mStrings = toStrings(program.mStrings);
+        script.mShorts = toStrings(locals.get('s'));
+        script.mLongs = toStrings(locals.get('l'));
+        script.mFloatLocals = toStrings(locals.get('f'));
+
+        // The same script may be written by other threads at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            const std::vector<std::byte> data = serialize(script);
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                if (!stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))
+                    || !stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached script " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
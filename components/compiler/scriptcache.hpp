@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_COMPILER_SCRIPTCACHE_H
+#define OPENMW_COMPONENTS_COMPILER_SCRIPTCACHE_H
+
+#include "locals.hpp"
+
+#include <components/interpreter/program.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Compiler
+{
+    struct CachedScript
+    {
+        Interpreter::Program mProgram;
+        Locals mLocals;
+    };
+
+    /// @brief Stores compiled scripts on disk, so that later sessions run them without compiling the source again.
+    /// @par The compiled code depends on the global variables, the object ids and the local variables of other
+    /// scripts, so the cache is valid only for the content it is created with. A script is identified by its id and
+    /// source text.
+    class ScriptCache
+    {
+    public:
+        /// @param contentKey identifies the content files and the engine build the compiled scripts depend on.
+        explicit ScriptCache(const std::filesystem::path& directory, std::string_view contentKey);
+
+        std::string getKey(std::string_view scriptId, std::string_view source) const;
+
+        /// @note Thread safe.
+        std::optional<CachedScript> read(const std::string& key) const;
+
+        /// @note Thread safe.
+        void write(const std::string& key, const Interpreter::Program& program, const Locals& locals) const;
+
+    private:
+        std::filesystem::path getPath(const std::string& key) const;
+
+        std::filesystem::path mDirectory;
+        std::string mContentKey;
+    };
+}
+
+#endif
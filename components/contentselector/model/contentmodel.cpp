@@ -1,14 +1,17 @@
 #include "contentmodel.hpp"
 #include "esmfile.hpp"
+#include "headercache.hpp"
 
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <unordered_set>
 
 #include <QDataStream>
 #include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include <QFont>
 #include <QIODevice>
 
@@ -18,6 +21,62 @@
 #include <components/files/openfile.hpp>
 #include <components/files/qtconversion.hpp>
 
+namespace
+{
+    // nullopt if the file can't be opened or has an unsupported format, throws if the header can't be read
+    std::optional<ContentSelectorModel::CachedHeader> readFileHeader(const QFileInfo& info, const QString& encoding)
+    {
+        std::filesystem::path filepath = Files::pathFromQString(info.absoluteFilePath());
+
+        auto stream = Files::openBinaryInputFileStream(filepath);
+        if (!stream->is_open())
+        {
+            qWarning() << "Failed to open addon file " << info.fileName() << ": "
+                       << std::generic_category().message(errno).c_str();
+            return std::nullopt;
+        }
+
+        ContentSelectorModel::CachedHeader header;
+        const ESM::Format format = ESM::readFormat(*stream);
+        stream->seekg(0);
+        switch (format)
+        {
+            case ESM::Format::Tes3:
+            {
+                ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding.toStdString()));
+                ESM::ESMReader fileReader;
+                fileReader.setEncoder(&encoder);
+                fileReader.open(std::move(stream), filepath);
+                header.mAuthor = QString::fromUtf8(fileReader.getAuthor().c_str());
+                header.mFormat = QString::number(fileReader.esmVersionF());
+                header.mDescription = QString::fromUtf8(fileReader.getDesc().c_str());
+                for (const auto& master : fileReader.getGameFiles())
+                    header.mGameFiles.append(QString::fromUtf8(master.name.c_str()));
+                break;
+            }
+            case ESM::Format::Tes4:
+            {
+                ToUTF8::StatelessUtf8Encoder encoder(ToUTF8::calculateEncoding(encoding.toStdString()));
+                ESM4::Reader fileReader(std::move(stream), filepath, nullptr, &encoder, true);
+                header.mAuthor = QString::fromUtf8(fileReader.getAuthor().c_str());
+                header.mFormat = QString::number(fileReader.esmVersionF());
+                header.mDescription = QString::fromUtf8(fileReader.getDesc().c_str());
+                for (const auto& master : fileReader.getGameFiles())
+                    header.mGameFiles.append(QString::fromUtf8(master.name.c_str()));
+                break;
+            }
+            default:
+            {
+                qWarning() << "Error reading addon file " << info.fileName() << ": unsupported ESM format "
+                           << ESM::NAME(format).toString().c_str();
+                return std::nullopt;
+            }
+        }
+
+        return header;
+    }
+}
+
 ContentSelectorModel::ContentModel::ContentModel(QObject* parent, QIcon& warningIcon, bool showOMWScripts)
     : QAbstractTableModel(parent)
     , mWarningIcon(warningIcon)
@@ -484,51 +543,24 @@ void ContentSelectorModel::ContentModel::addFiles(const QString& path, bool newf
         {
             file->setDate(info.lastModified());
             file->setFilePath(info.absoluteFilePath());
-            std::filesystem::path filepath = Files::pathFromQString(info.absoluteFilePath());
 
-            auto stream = Files::openBinaryInputFileStream(filepath);
-            if (!stream->is_open())
-            {
-                qWarning() << "Failed to open addon file " << info.fileName() << ": "
-                           << std::generic_category().message(errno).c_str();
-                continue;
-            }
-            const ESM::Format format = ESM::readFormat(*stream);
-            stream->seekg(0);
-            switch (format)
+            const CachedHeader* header = mHeaderCache != nullptr ? mHeaderCache->find(info, mEncoding) : nullptr;
+            std::optional<CachedHeader> readHeader;
+            if (header == nullptr)
             {
-                case ESM::Format::Tes3:
-                {
-                    ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(mEncoding.toStdString()));
-                    ESM::ESMReader fileReader;
-                    fileReader.setEncoder(&encoder);
-                    fileReader.open(std::move(stream), filepath);
-                    file->setAuthor(QString::fromUtf8(fileReader.getAuthor().c_str()));
-                    file->setFormat(QString::number(fileReader.esmVersionF()));
-                    file->setDescription(QString::fromUtf8(fileReader.getDesc().c_str()));
-                    for (const auto& master : fileReader.getGameFiles())
-                        file->addGameFile(QString::fromUtf8(master.name.c_str()));
-                    break;
-                }
-                case ESM::Format::Tes4:
-                {
-                    ToUTF8::StatelessUtf8Encoder encoder(ToUTF8::calculateEncoding(mEncoding.toStdString()));
-                    ESM4::Reader fileReader(std::move(stream), filepath, nullptr, &encoder, true);
-                    file->setAuthor(QString::fromUtf8(fileReader.getAuthor().c_str()));
-                    file->setFormat(QString::number(fileReader.esmVersionF()));
-                    file->setDescription(QString::fromUtf8(fileReader.getDesc().c_str()));
-                    for (const auto& master : fileReader.getGameFiles())
-                        file->addGameFile(QString::fromUtf8(master.name.c_str()));
-                    break;
-                }
-                default:
-                {
-                    qWarning() << "Error reading addon file " << info.fileName() << ": unsupported ESM format "
-                               << ESM::NAME(format).toString().c_str();
+                readHeader = readFileHeader(info, mEncoding);
+                if (!readHeader.has_value())
                     continue;
-                }
+                if (mHeaderCache != nullptr)
+                    mHeaderCache->insert(info, mEncoding, *readHeader);
+                header = &*readHeader;
             }
 
+            file->setAuthor(header->mAuthor);
+            file->setFormat(header->mFormat);
+            file->setDescription(header->mDescription);
+            file->setGameFiles(header->mGameFiles);
+
             // Put the file in the table
             if (add)
                 addFile(newFile.release());
@@ -12,6 +12,7 @@
 namespace ContentSelectorModel
 {
     class EsmFile;
+    class HeaderCache;
 
     typedef QList<EsmFile*> ContentFileList;
 
@@ -30,6 +31,9 @@ namespace ContentSelectorModel
 
         void setEncoding(const QString& encoding);
 
+        /// Use the cache to read only the headers of the new and changed files, the cache has to outlive the model.
+        void setHeaderCache(HeaderCache* cache) { mHeaderCache = cache; }
+
         int rowCount(const QModelIndex& parent = QModelIndex()) const override;
         int columnCount(const QModelIndex& parent = QModelIndex()) const override;
 
@@ -91,6 +95,7 @@ namespace ContentSelectorModel
         QHash<QString, bool> mNewFiles;
         QSet<QString> mPluginsWithLoadOrderError;
         QString mEncoding;
+        HeaderCache* mHeaderCache = nullptr;
         QIcon mWarningIcon;
         bool mShowOMWScripts;
 
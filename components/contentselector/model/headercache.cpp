@@ -0,0 +1,114 @@
+#include "headercache.hpp"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace
+{
+    // Increment when the stored data changes
+    constexpr quint32 sCacheVersion = 1;
+    constexpr quint32 sCacheMagic = 0x4f4d4843; // "OMHC"
+}
+
+ContentSelectorModel::HeaderCache::HeaderCache(const QString& path)
+    : mPath(path)
+{
+}
+
+void ContentSelectorModel::HeaderCache::load()
+{
+    mEntries.clear();
+    mChanged = false;
+
+    QFile file(mPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != sCacheMagic || version != sCacheVersion)
+        return;
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString path;
+        Entry entry;
+        stream >> path >> entry.mSize >> entry.mModified >> entry.mEncoding >> entry.mHeader.mAuthor
+            >> entry.mHeader.mFormat >> entry.mHeader.mDescription >> entry.mHeader.mGameFiles;
+        mEntries.insert(path, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qWarning() << "Failed to read content file header cache " << mPath;
+        mEntries.clear();
+    }
+}
+
+bool ContentSelectorModel::HeaderCache::save()
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (QFileInfo::exists(it.key()))
+        {
+            ++it;
+            continue;
+        }
+        it = mEntries.erase(it);
+        mChanged = true;
+    }
+
+    if (!mChanged)
+        return true;
+
+    QDir().mkpath(QFileInfo(mPath).absolutePath());
+    QSaveFile file(mPath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Failed to write content file header cache " << mPath << ": " << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << sCacheMagic << sCacheVersion << static_cast<quint32>(mEntries.size());
+    for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+    {
+        const Entry& entry = it.value();
+        stream << it.key() << entry.mSize << entry.mModified << entry.mEncoding << entry.mHeader.mAuthor
+               << entry.mHeader.mFormat << entry.mHeader.mDescription << entry.mHeader.mGameFiles;
+    }
+
+    if (!file.commit())
+    {
+        qWarning() << "Failed to write content file header cache " << mPath << ": " << file.errorString();
+        return false;
+    }
+
+    mChanged = false;
+    return true;
+}
+
+const ContentSelectorModel::CachedHeader* ContentSelectorModel::HeaderCache::find(
+    const QFileInfo& info, const QString& encoding) const
+{
+    const auto it = mEntries.constFind(info.absoluteFilePath());
+    if (it == mEntries.cend() || it->mSize != info.size() || it->mModified != info.lastModified()
+        || it->mEncoding != encoding)
+        return nullptr;
+    return &it->mHeader;
+}
+
+void ContentSelectorModel::HeaderCache::insert(
+    const QFileInfo& info, const QString& encoding, const CachedHeader& header)
+{
+    mEntries.insert(info.absoluteFilePath(), Entry{ info.size(), info.lastModified(), encoding, header });
+    mChanged = true;
+}
@@ -0,0 +1,54 @@
+#ifndef HEADERCACHE_HPP
+#define HEADERCACHE_HPP
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+class QFileInfo;
+
+namespace ContentSelectorModel
+{
+    /// \brief Content file header data the content model shows.
+    struct CachedHeader
+    {
+        QString mAuthor;
+        QString mFormat;
+        QString mDescription;
+        QStringList mGameFiles;
+    };
+
+    /// \brief Persistent cache of the content file headers, so only the new and changed files have to be read.
+    /// \note An entry is valid as long as the file has the same size and modification time, and the text is decoded
+    /// with the same encoding.
+    class HeaderCache
+    {
+    public:
+        explicit HeaderCache(const QString& path);
+
+        /// Replaces the entries by the ones stored in the file, keeps them empty if the file is missing or broken.
+        void load();
+
+        /// Writes the file if any entry has changed, dropping the entries of the files that don't exist anymore.
+        bool save();
+
+        const CachedHeader* find(const QFileInfo& info, const QString& encoding) const;
+        void insert(const QFileInfo& info, const QString& encoding, const CachedHeader& header);
+
+    private:
+        struct Entry
+        {
+            qint64 mSize = 0;
+            QDateTime mModified;
+            QString mEncoding;
+            CachedHeader mHeader;
+        };
+
+        QString mPath;
+        QHash<QString, Entry> mEntries;
+        bool mChanged = false;
+    };
+}
+
+#endif // HEADERCACHE_HPP
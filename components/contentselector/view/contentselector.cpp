@@ -175,6 +175,11 @@ void ContentSelectorView::ContentSelector::setEncoding(const QString& encoding)
     mContentModel->setEncoding(encoding);
 }
 
+void ContentSelectorView::ContentSelector::setHeaderCache(ContentSelectorModel::HeaderCache* cache)
+{
+    mContentModel->setHeaderCache(cache);
+}
+
 void ContentSelectorView::ContentSelector::setContentList(const QStringList& list)
 {
     if (list.isEmpty())
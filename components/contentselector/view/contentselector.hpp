@@ -45,6 +45,7 @@ namespace ContentSelectorView
 
         void clearCheckStates();
         void setEncoding(const QString& encoding);
+        void setHeaderCache(ContentSelectorModel::HeaderCache* cache);
         void setContentList(const QStringList& list);
 
         ContentSelectorModel::ContentFileList selectedFiles() const;
@@ -304,6 +304,9 @@ static void crash_catcher(int signum, siginfo_t* siginfo, void* /*context*/)
         return;
     }
 
+    // Messages queued for the log writer thread would be lost otherwise
+    Debug::flushLog();
+
     safe_write(STDERR_FILENO, fatal_err, sizeof(fatal_err) - 1);
     int fd[2];
     if (pipe(fd) == -1)
@@ -10,6 +10,7 @@
 #include "windowscrashdumppathhelpers.hpp"
 #include <SDL_messagebox.h>
 
+#include <components/debug/debuglog.hpp>
 #include <components/misc/strings/conversion.hpp>
 
 namespace Crash
@@ -216,6 +217,9 @@ namespace Crash
         if (!sInstance)
             return EXCEPTION_EXECUTE_HANDLER;
 
+        // Messages queued for the log writer thread would be lost otherwise
+        Debug::flushLog();
+
         sInstance->handleVectoredException(info);
 
         _Exit(1);
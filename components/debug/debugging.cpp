@@ -358,6 +358,7 @@ static std::unique_ptr<std::ostream> rawStdout = nullptr;
 static std::unique_ptr<std::ostream> rawStderr = nullptr;
 static std::unique_ptr<std::mutex> rawStderrMutex = nullptr;
 static std::ofstream logfile;
+static constexpr std::size_t maxPendingLogSize = 16 * 1024 * 1024;
 
 #if defined(_WIN32) && defined(_DEBUG)
 static boost::iostreams::stream_buffer<Debug::DebugOutput> sb;
@@ -402,6 +403,9 @@ void setupLogging(const std::filesystem::path& logDir, std::string_view appName,
 
     std::cout.rdbuf(&standardOut);
     std::cerr.rdbuf(&standardErr);
+
+    // Writing to the log file is left to a background thread once there is one
+    Debug::startAsyncLog(maxPendingLogSize);
 #endif
 
 #ifdef _WIN32
@@ -473,6 +477,8 @@ int wrapApplication(int (*innerApplication)(int argc, char* argv[]), int argc, c
         ret = 1;
     }
 
+    Debug::stopAsyncLog();
+
     // Restore cout and cerr
     std::cout.rdbuf(rawStdout->rdbuf());
     std::cerr.rdbuf(rawStderr->rdbuf());
@@ -1,6 +1,13 @@
 #include "debuglog.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/conversion.hpp>
@@ -10,24 +17,157 @@ namespace Debug
     Level CurrentDebugLevel = Level::NoLevel;
 }
 
-static std::mutex sLock;
-
-Log::Log(Debug::Level level)
-    : mShouldLog(level <= Debug::CurrentDebugLevel)
+namespace
 {
-    // No need to hold the lock if there will be no logging anyway
-    if (!mShouldLog)
-        return;
-
-    // Locks a global lock while the object is alive
-    sLock.lock();
+    struct Message
+    {
+        Debug::Level mLevel;
+        bool mMarker;
+        std::string mText;
+    };
+
+    // Guards writing to std::cout
+    std::mutex sLock;
+
+    // Messages formatted by the logging threads waiting to be written by the writer thread
+    struct AsyncLog
+    {
+        std::mutex mMutex;
+        std::condition_variable mHasMessages;
+        std::deque<Message> mMessages;
+        std::size_t mPendingSize = 0;
+        std::size_t mMaxPendingSize = 0;
+        std::size_t mDropped = 0;
+        bool mEnabled = false;
+        bool mStopping = false;
+        std::thread mWriter;
+    };
+
+    AsyncLog sAsyncLog;
+
+    std::ostringstream& getThreadStream()
+    {
+        thread_local std::ostringstream stream;
+        return stream;
+    }
+
+    void writeMessage(const Message& message)
+    {
+        // If the app has no logging system enabled, log level is not specified.
+        // Show all messages without marker - we just use the plain cout in this case.
+        if (message.mMarker)
+            std::cout << static_cast<unsigned char>(message.mLevel);
+
+        // Each message is flushed separately, the sink looks for the marker at the beginning of a write
+        std::cout << message.mText << std::endl;
+    }
+
+    void writeDropped(std::size_t dropped)
+    {
+        if (dropped == 0)
+            return;
+
+        writeMessage(Message{ Debug::Warning, Debug::CurrentDebugLevel != Debug::NoLevel,
+            "Dropped " + std::to_string(dropped) + " log messages" });
+    }
+
+    // Writes the taken messages, sLock must be held
+    void writeMessages(const std::deque<Message>& messages, std::size_t dropped)
+    {
+        for (const Message& message : messages)
+            writeMessage(message);
+
+        writeDropped(dropped);
+    }
+
+    void runWriter()
+    {
+        std::deque<Message> messages;
+
+        while (true)
+        {
+            std::size_t dropped = 0;
+
+            {
+                std::unique_lock lock(sAsyncLog.mMutex);
+                sAsyncLog.mHasMessages.wait(lock, [] { return sAsyncLog.mStopping || !sAsyncLog.mMessages.empty(); });
+
+                if (sAsyncLog.mMessages.empty())
+                    return;
+
+                std::swap(messages, sAsyncLog.mMessages);
+                std::swap(dropped, sAsyncLog.mDropped);
+                sAsyncLog.mPendingSize = 0;
+            }
+
+            {
+                const std::lock_guard lock(sLock);
+                writeMessages(messages, dropped);
+            }
+
+            messages.clear();
+        }
+    }
+}
 
-    // If the app has no logging system enabled, log level is not specified.
-    // Show all messages without marker - we just use the plain cout in this case.
-    if (Debug::CurrentDebugLevel == Debug::NoLevel)
-        return;
+namespace Debug
+{
+    void startAsyncLog(std::size_t maxPendingSize)
+    {
+        const std::lock_guard lock(sAsyncLog.mMutex);
+
+        if (sAsyncLog.mEnabled)
+            return;
+
+        sAsyncLog.mMaxPendingSize = maxPendingSize;
+        sAsyncLog.mStopping = false;
+        sAsyncLog.mEnabled = true;
+        sAsyncLog.mWriter = std::thread(runWriter);
+    }
+
+    void stopAsyncLog()
+    {
+        std::thread writer;
+
+        {
+            const std::lock_guard lock(sAsyncLog.mMutex);
+
+            if (!sAsyncLog.mEnabled)
+                return;
+
+            sAsyncLog.mEnabled = false;
+            sAsyncLog.mStopping = true;
+            writer = std::move(sAsyncLog.mWriter);
+        }
+
+        sAsyncLog.mHasMessages.notify_all();
+        writer.join();
+    }
+
+    void flushLog()
+    {
+        // Doesn't wait for the locks since the crashed thread or the writer thread may hold them
+        std::unique_lock asyncLock(sAsyncLog.mMutex, std::try_to_lock);
+        if (!asyncLock.owns_lock())
+            return;
+
+        std::unique_lock lock(sLock, std::try_to_lock);
+        if (!lock.owns_lock())
+            return;
+
+        const std::deque<Message> messages = std::exchange(sAsyncLog.mMessages, {});
+        const std::size_t dropped = std::exchange(sAsyncLog.mDropped, 0);
+        sAsyncLog.mPendingSize = 0;
+
+        writeMessages(messages, dropped);
+    }
+}
 
-    std::cout << static_cast<unsigned char>(level);
+Log::Log(Debug::Level level)
+    : mLevel(level)
+    , mShouldLog(level <= Debug::CurrentDebugLevel)
+    , mStream(mShouldLog ? &getThreadStream() : nullptr)
+{
 }
 
 Log::~Log()
@@ -35,14 +175,39 @@ Log::~Log()
     if (!mShouldLog)
         return;
 
-    std::cout << std::endl;
-    sLock.unlock();
+    Message message{ mLevel, Debug::CurrentDebugLevel != Debug::NoLevel, std::move(*mStream).str() };
+
+    // Reset the stream for the next message of the thread, including the state changed by manipulators
+    mStream->str({});
+    mStream->clear();
+    mStream->copyfmt(std::ostringstream());
+
+    {
+        const std::lock_guard lock(sAsyncLog.mMutex);
+
+        if (sAsyncLog.mEnabled)
+        {
+            if (sAsyncLog.mPendingSize + message.mText.size() > sAsyncLog.mMaxPendingSize)
+            {
+                ++sAsyncLog.mDropped;
+                return;
+            }
+
+            sAsyncLog.mPendingSize += message.mText.size();
+            sAsyncLog.mMessages.push_back(std::move(message));
+            sAsyncLog.mHasMessages.notify_one();
+            return;
+        }
+    }
+
+    const std::lock_guard lock(sLock);
+    writeMessage(message);
 }
 
 Log& Log::operator<<(const std::filesystem::path& rhs)
 {
     if (mShouldLog)
-        std::cout << Files::pathToUnicodeString(rhs);
+        *mStream << Files::pathToUnicodeString(rhs);
 
     return *this;
 }
@@ -50,7 +215,7 @@ Log& Log::operator<<(const std::filesystem::path& rhs)
 Log& Log::operator<<(const std::u8string& rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
@@ -58,7 +223,7 @@ Log& Log::operator<<(const std::u8string& rhs)
 Log& Log::operator<<(const std::u8string_view rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
@@ -66,7 +231,7 @@ Log& Log::operator<<(const std::u8string_view rhs)
 Log& Log::operator<<(const char8_t* rhs)
 {
     if (mShouldLog)
-        std::cout << Misc::StringUtils::u8StringToString(rhs);
+        *mStream << Misc::StringUtils::u8StringToString(rhs);
 
     return *this;
 }
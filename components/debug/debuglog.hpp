@@ -1,8 +1,10 @@
 #ifndef DEBUG_LOG_H
 #define DEBUG_LOG_H
 
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
+#include <sstream>
 
 namespace Debug
 {
@@ -19,6 +21,18 @@ namespace Debug
     };
 
     extern Level CurrentDebugLevel;
+
+    void startAsyncLog(std::size_t maxPendingSize);
+    ///< Write the messages on a background thread instead of the logging threads.
+    ///
+    /// \param maxPendingSize Limit for the size of messages not written yet, further messages are dropped and counted
+
+    void stopAsyncLog();
+    ///< Write the pending messages and stop the background thread.
+
+    void flushLog();
+    ///< Write the pending messages on the calling thread. Does nothing when the log is being written, for crash
+    /// handlers.
 }
 
 class Log
@@ -31,7 +45,7 @@ public:
     Log& operator<<(const T& rhs)
     {
         if (mShouldLog)
-            std::cout << rhs;
+            *mStream << rhs;
 
         return *this;
     }
@@ -45,7 +59,9 @@ public:
     Log& operator<<(const char8_t* rhs);
 
 private:
+    const Debug::Level mLevel;
     const bool mShouldLog;
+    std::ostringstream* const mStream; // Per thread, messages are formatted without holding a lock
 };
 
 #endif
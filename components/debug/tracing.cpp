@@ -0,0 +1,194 @@
+#include "tracing.hpp"
+
+#include "debuglog.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace Debug::Tracing
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Zone
+        {
+            const char* mName;
+            Clock::time_point mBegin;
+            Clock::time_point mEnd;
+        };
+
+        struct ThreadZones
+        {
+            std::size_t mThreadId = 0;
+            std::string mThreadName;
+            std::vector<Zone> mZones;
+        };
+
+        class ThreadBuffer;
+
+        struct State
+        {
+            std::mutex mMutex;
+            std::vector<ThreadBuffer*> mBuffers;
+            std::vector<ThreadZones> mFinished;
+            std::size_t mNextThreadId = 0;
+            std::filesystem::path mPath;
+            Clock::time_point mStart;
+        };
+
+        std::atomic_bool sEnabled{ false };
+
+        State& getState()
+        {
+            static State state;
+            return state;
+        }
+
+        // Locked by the owning thread to add a zone, by stop to take them. Mutexes of the buffers are locked only
+        // with the state mutex held when both are required.
+        class ThreadBuffer
+        {
+        public:
+            std::mutex mMutex;
+            ThreadZones mZones;
+
+            ThreadBuffer()
+            {
+                State& state = getState();
+                const std::lock_guard lock(state.mMutex);
+                mZones.mThreadId = state.mNextThreadId++;
+                state.mBuffers.push_back(this);
+            }
+
+            ~ThreadBuffer()
+            {
+                // Zones of a finished thread are kept until stop
+                State& state = getState();
+                const std::lock_guard lock(state.mMutex);
+                state.mBuffers.erase(std::find(state.mBuffers.begin(), state.mBuffers.end(), this));
+                const std::lock_guard bufferLock(mMutex);
+                if (!mZones.mZones.empty())
+                    state.mFinished.push_back(std::move(mZones));
+            }
+        };
+
+        ThreadBuffer& getThreadBuffer()
+        {
+            thread_local ThreadBuffer buffer;
+            return buffer;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) >= 0x20)
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        void writeZones(std::ostream& stream, const ThreadZones& zones, Clock::time_point start, bool& first)
+        {
+            const auto separate = [&] {
+                if (!first)
+                    stream << ",\n";
+                first = false;
+            };
+            if (!zones.mThreadName.empty())
+            {
+                separate();
+                stream << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << zones.mThreadId
+                       << R"(,"args":{"name":)";
+                writeString(stream, zones.mThreadName);
+                stream << "}}";
+            }
+            for (const Zone& zone : zones.mZones)
+            {
+                separate();
+                // Timestamps are in microseconds
+                const std::chrono::duration<double, std::micro> begin = zone.mBegin - start;
+                const std::chrono::duration<double, std::micro> duration = zone.mEnd - zone.mBegin;
+                stream << R"({"name":)";
+                writeString(stream, zone.mName);
+                stream << R"(,"ph":"X","pid":0,"tid":)" << zones.mThreadId << R"(,"ts":)" << begin.count()
+                       << R"(,"dur":)" << duration.count() << '}';
+            }
+        }
+    }
+
+    void start(const std::filesystem::path& path)
+    {
+        State& state = getState();
+        const std::lock_guard lock(state.mMutex);
+        state.mPath = path;
+        state.mStart = Clock::now();
+        sEnabled.store(true, std::memory_order_release);
+        Log(Debug::Info) << "Trace will be written to: " << path;
+    }
+
+    void stop()
+    {
+        if (!sEnabled.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        State& state = getState();
+        std::vector<ThreadZones> threads;
+        {
+            const std::lock_guard lock(state.mMutex);
+            threads = std::move(state.mFinished);
+            state.mFinished.clear();
+            for (ThreadBuffer* buffer : state.mBuffers)
+            {
+                const std::lock_guard bufferLock(buffer->mMutex);
+                threads.push_back(buffer->mZones);
+                buffer->mZones.mZones.clear();
+            }
+        }
+
+        std::ofstream stream(state.mPath);
+        if (!stream.is_open())
+        {
+            Log(Debug::Warning) << "Failed to open file to write trace " << state.mPath << ": "
+                                << std::generic_category().message(errno);
+            return;
+        }
+        stream << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (const ThreadZones& zones : threads)
+            writeZones(stream, zones, state.mStart, first);
+        stream << "\n]}\n";
+    }
+
+    bool isEnabled()
+    {
+        return sEnabled.load(std::memory_order_relaxed);
+    }
+
+    void setThreadName(std::string_view name)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+        const std::lock_guard lock(buffer.mMutex);
+        buffer.mZones.mThreadName = name;
+    }
+
+    void ScopedZone::finish()
+    {
+        const Clock::time_point end = Clock::now();
+        if (!isEnabled())
+            return;
+        ThreadBuffer& buffer = getThreadBuffer();
+        const std::lock_guard lock(buffer.mMutex);
+        buffer.mZones.mZones.push_back(Zone{ .mName = mName, .mBegin = mBegin, .mEnd = end });
+    }
+}
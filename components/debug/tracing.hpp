@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACING_H
+#define OPENMW_COMPONENTS_DEBUG_TRACING_H
+
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+
+/// Scoped zones shown on a timeline per thread. They are written in the Chrome trace event format which is opened by
+/// chrome://tracing, Perfetto and converted for Tracy by its import-chrome tool. Zones are compiled only with
+/// OPENMW_TRACING defined, otherwise the macros are empty.
+namespace Debug::Tracing
+{
+    /// Starts recording zones from all threads to write them into the file by stop
+    void start(const std::filesystem::path& path);
+
+    void stop();
+
+    bool isEnabled();
+
+    /// The name is shown for all zones of the calling thread
+    void setThreadName(std::string_view name);
+
+    class ScopedZone
+    {
+    public:
+        /// The name has to live until stop, usually it's a string literal
+        explicit ScopedZone(const char* name)
+            : mName(isEnabled() ? name : nullptr)
+        {
+            if (mName != nullptr)
+                mBegin = std::chrono::steady_clock::now();
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+        ~ScopedZone()
+        {
+            if (mName != nullptr)
+                finish();
+        }
+
+    private:
+        const char* const mName;
+        std::chrono::steady_clock::time_point mBegin;
+
+        void finish();
+    };
+}
+
+#define OPENMW_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENMW_TRACE_CONCAT(a, b) OPENMW_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef OPENMW_TRACING
+#define OPENMW_TRACE_ZONE(name) const Debug::Tracing::ScopedZone OPENMW_TRACE_CONCAT(traceZone, __LINE__)(name)
+#define OPENMW_TRACE_THREAD_NAME(name) Debug::Tracing::setThreadName(name)
+#else
+#define OPENMW_TRACE_ZONE(name) static_cast<void>(0)
+#define OPENMW_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif
@@ -8,6 +8,7 @@
 #include "version.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/thread.hpp>
@@ -21,8 +22,10 @@
 #include <algorithm>
 #include <optional>
 #include <set>
+#include <string>
 #include <tuple>
 #include <type_traits>
+#include <variant>
 
 namespace DetourNavigator
 {
@@ -61,7 +64,32 @@ namespace DetourNavigator
             if (db == nullptr)
                 return nullptr;
             return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+                settings.mRecast, settings.mWriteToNavMeshDb, settings.mMaxDbTransactionWrites,
+                settings.mMaxDbTransactionDuration);
+        }
+
+        std::vector<std::unique_ptr<NavMeshDb>> makeDbReaders(const NavMeshDb* db, std::size_t count)
+        {
+            std::vector<std::unique_ptr<NavMeshDb>> result;
+            if (db == nullptr)
+                return result;
+            const std::string path = db->getPath();
+            // In-memory dbs are private to their connection
+            if (path.empty())
+                return result;
+            try
+            {
+                result.reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                    result.push_back(std::make_unique<NavMeshDb>(path, 0, NavMeshDbMode::ReadOnly));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to open read-only navmeshdb connections, reading by DbWorker: "
+                                    << e.what();
+                result.clear();
+            }
+            return result;
         }
 
         std::size_t getNextJobId()
@@ -249,10 +277,14 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mDbReaders(makeDbReaders(db.get(), settings.mAsyncNavMeshUpdaterThreads))
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
-            mThreads.emplace_back([&] { process(); });
+        {
+            NavMeshDb* const dbReader = i < mDbReaders.size() ? mDbReaders[i].get() : nullptr;
+            mThreads.emplace_back([this, dbReader] { process(dbReader); });
+        }
     }
 
     AsyncNavMeshUpdater::~AsyncNavMeshUpdater()
@@ -313,7 +345,22 @@ namespace DetourNavigator
         lock.unlock();
 
         if (playerTileChanged && mDbWorker != nullptr)
-            mDbWorker->update(playerTile);
+            mDbWorker->update(getPriorityTile());
+    }
+
+    void AsyncNavMeshUpdater::setPriorityTile(const TilePosition& priorityTile)
+    {
+        {
+            auto locked = mPriorityTile.lock();
+            if (*locked == priorityTile)
+                return;
+            *locked = priorityTile;
+        }
+
+        Log(Debug::Debug) << "Priority tile has been changed to " << priorityTile;
+
+        if (mDbWorker != nullptr)
+            mDbWorker->update(priorityTile);
     }
 
     void AsyncNavMeshUpdater::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
@@ -413,20 +460,30 @@ namespace DetourNavigator
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
+        result.mDbDirectGetTileCount = mDbDirectGetTileCount.load(std::memory_order_relaxed);
+        result.mDbDirectGetTileDuration
+            = std::chrono::nanoseconds(mDbDirectGetTileNanoseconds.load(std::memory_order_relaxed));
         return result;
     }
 
-    void AsyncNavMeshUpdater::process() noexcept
+    void AsyncNavMeshUpdater::process(NavMeshDb* dbReader) noexcept
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        OPENMW_TRACE_THREAD_NAME("Navmesh updater");
         while (!mShouldStop)
         {
             try
             {
                 if (JobIt job = getNextJob(); job != mJobs.end())
                 {
-                    const JobStatus status = processJob(*job);
+                    OPENMW_TRACE_ZONE("AsyncNavMeshUpdater::processJob");
+                    JobStatus status = processJob(*job);
+                    if (status == JobStatus::MemoryCacheMiss && dbReader != nullptr && readTileData(*dbReader, *job))
+                    {
+                        job->mState = JobState::WithDbResult;
+                        status = processJob(*job);
+                    }
                     Log(Debug::Debug) << "Processed job " << job->mId << " with status=" << status
                                       << " changeType=" << job->mChangeType;
                     switch (status)
@@ -460,6 +517,41 @@ namespace DetourNavigator
         Log(Debug::Debug) << "Stop navigator jobs processing by thread=" << std::this_thread::get_id();
     }
 
+    bool AsyncNavMeshUpdater::readTileData(NavMeshDb& db, Job& job)
+    {
+        OPENMW_TRACE_ZONE("AsyncNavMeshUpdater::readTileData");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        try
+        {
+            if (job.mInput.empty())
+            {
+                const auto result = makeDbRefGeometryObjects(job.mRecastMesh->getMeshSources(),
+                    [&](const MeshSource& v) { return resolveMeshSource(db, v); });
+                const auto* const objects = std::get_if<std::vector<DbRefGeometryObject>>(&result);
+                // DbWorker adds missing shapes when writing is enabled, otherwise there is no tile to read
+                if (objects == nullptr)
+                    return !mSettings.get().mWriteToNavMeshDb;
+                job.mInput = serialize(mSettings.get().mRecast, job.mAgentBounds, *job.mRecastMesh, *objects);
+            }
+
+            job.mCachedTileData = db.getTileData(job.mWorldspace, job.mChangedTile, job.mInput);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read navmeshdb tile for job " << job.mId
+                                << ", reading by DbWorker: " << e.what();
+            return false;
+        }
+
+        const auto duration = std::chrono::steady_clock::now() - start;
+        ++mDbDirectGetTileCount;
+        mDbDirectGetTileNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+        return true;
+    }
+
     JobStatus AsyncNavMeshUpdater::processJob(Job& job)
     {
         Log(Debug::Debug) << "Processing job " << job.mId << " for agent=(" << job.mAgentBounds << ")"
@@ -658,11 +750,9 @@ namespace DetourNavigator
         if (shouldStop)
             return mJobs.end();
 
-        const TilePosition playerTile = *mPlayerTile.lockConst();
-
         JobIt job = mJobs.end();
 
-        if (const std::optional<JobIt> nextJob = mWaiting.pop(playerTile))
+        if (const std::optional<JobIt> nextJob = mWaiting.pop(getPriorityTile()))
             job = *nextJob;
 
         if (job == mJobs.end())
@@ -688,6 +778,13 @@ namespace DetourNavigator
         return job;
     }
 
+    TilePosition AsyncNavMeshUpdater::getPriorityTile() const
+    {
+        if (const std::optional<TilePosition> priorityTile = *mPriorityTile.lockConst())
+            return *priorityTile;
+        return *mPlayerTile.lockConst();
+    }
+
     void AsyncNavMeshUpdater::writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const
     {
         std::string revision;
@@ -778,13 +875,16 @@ namespace DetourNavigator
         mHasJob.notify_all();
     }
 
-    std::optional<JobIt> DbJobQueue::pop()
+    std::optional<JobIt> DbJobQueue::pop(std::optional<std::chrono::steady_clock::time_point> deadline)
     {
         std::unique_lock lock(mMutex);
 
         const auto hasJob = [&] { return mShouldStop || mReading.size() > 0 || mWriting.size() > 0; };
 
-        mHasJob.wait(lock, hasJob);
+        if (!deadline.has_value())
+            mHasJob.wait(lock, hasJob);
+        else if (!mHasJob.wait_until(lock, *deadline, hasJob))
+            return std::nullopt;
 
         if (mShouldStop)
             return std::nullopt;
@@ -826,12 +926,15 @@ namespace DetourNavigator
     }
 
     DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+        const RecastSettings& recastSettings, bool writeToDb, std::size_t maxTransactionWrites,
+        std::chrono::milliseconds maxTransactionDuration)
         : mUpdater(updater)
         , mRecastSettings(recastSettings)
         , mDb(std::move(db))
         , mVersion(version)
         , mWriteToDb(writeToDb)
+        , mMaxTransactionWrites(std::max<std::size_t>(maxTransactionWrites, 1))
+        , mMaxTransactionDuration(maxTransactionDuration)
         , mNextTileId(mDb->getMaxTileId() + 1)
         , mNextShapeId(mDb->getMaxShapeId() + 1)
         , mThread([this] { run(); })
@@ -867,22 +970,54 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        OPENMW_TRACE_THREAD_NAME("Navmesh DB");
         while (!mShouldStop)
         {
             try
             {
-                if (const auto job = mQueue.pop())
+                std::optional<std::chrono::steady_clock::time_point> deadline;
+                if (mTransaction.has_value())
+                    deadline = mTransactionStart + mMaxTransactionDuration;
+                if (const auto job = mQueue.pop(deadline))
                     processJob(*job);
+                else if (mTransaction.has_value() && std::chrono::steady_clock::now() >= *deadline)
+                    commitTransaction();
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception: " << e.what();
             }
         }
+        commitTransaction();
+    }
+
+    void DbWorker::startTransaction()
+    {
+        if (mTransaction.has_value())
+            return;
+        mTransaction.emplace(mDb->startTransaction(Sqlite3::TransactionMode::Immediate));
+        mTransactionWrites = 0;
+        mTransactionStart = std::chrono::steady_clock::now();
+    }
+
+    void DbWorker::commitTransaction() noexcept
+    {
+        if (!mTransaction.has_value())
+            return;
+        try
+        {
+            mTransaction->commit();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker failed to commit " << mTransactionWrites << " writes: " << e.what();
+        }
+        mTransaction.reset();
     }
 
     void DbWorker::processJob(JobIt job)
     {
+        OPENMW_TRACE_ZONE("DbWorker::processJob");
         const auto process = [&](auto f) {
             try
             {
@@ -930,6 +1065,11 @@ namespace DetourNavigator
         if (isWritingDbJob(*job))
         {
             process([&](JobIt job) { processWritingJob(job); });
+            // Keep what is already written when writes get disabled by an error
+            if (mTransaction.has_value()
+                && (++mTransactionWrites >= mMaxTransactionWrites || !mWriteToDb
+                    || std::chrono::steady_clock::now() - mTransactionStart >= mMaxTransactionDuration))
+                commitTransaction();
             mUpdater.removeJob(job);
             return;
         }
@@ -997,6 +1137,8 @@ namespace DetourNavigator
 
         Log(Debug::Debug) << "Processing db write job " << job->mId;
 
+        startTransaction();
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
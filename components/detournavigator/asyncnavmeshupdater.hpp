@@ -20,6 +20,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <iosfwd>
 #include <list>
@@ -134,7 +135,8 @@ namespace DetourNavigator
     public:
         void push(JobIt job);
 
-        std::optional<JobIt> pop();
+        /// @param deadline return nothing when there is no job until this time point
+        std::optional<JobIt> pop(std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
 
         void update(TilePosition playerTile);
 
@@ -157,7 +159,8 @@ namespace DetourNavigator
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const RecastSettings& recastSettings, bool writeToDb, std::size_t maxTransactionWrites,
+            std::chrono::milliseconds maxTransactionDuration);
 
         ~DbWorker();
 
@@ -175,8 +178,14 @@ namespace DetourNavigator
         const std::unique_ptr<NavMeshDb> mDb;
         const TileVersion mVersion;
         bool mWriteToDb;
+        const std::size_t mMaxTransactionWrites;
+        const std::chrono::milliseconds mMaxTransactionDuration;
         TileId mNextTileId;
         ShapeId mNextShapeId;
+        // Writes are grouped into transactions committed by size or time
+        std::optional<Sqlite3::Transaction> mTransaction;
+        std::size_t mTransactionWrites = 0;
+        std::chrono::steady_clock::time_point mTransactionStart;
         DbJobQueue mQueue;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
@@ -189,6 +198,10 @@ namespace DetourNavigator
         inline void processReadingJob(JobIt job);
 
         inline void processWritingJob(JobIt job);
+
+        inline void startTransaction();
+
+        inline void commitTransaction() noexcept;
     };
 
     class AsyncNavMeshUpdater
@@ -202,6 +215,9 @@ namespace DetourNavigator
             const TilePosition& playerTile, ESM::RefId worldspace,
             const std::map<TilePosition, ChangeType>& changedTiles);
 
+        /// Jobs for tiles closer to the priority tile are processed first. Until it is set the player tile is used.
+        void setPriorityTile(const TilePosition& priorityTile);
+
         void wait(WaitConditionType waitConditionType, Loading::Listener* listener);
 
         void stop();
@@ -225,18 +241,25 @@ namespace DetourNavigator
         JobQueue mWaiting;
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
+        Misc::ScopeGuarded<std::optional<TilePosition>> mPriorityTile;
         NavMeshTilesCache mNavMeshTilesCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
         std::vector<std::thread> mThreads;
+        // Read-only connections, one per thread, to read cached tiles without queueing behind the writes of DbWorker
+        std::vector<std::unique_ptr<NavMeshDb>> mDbReaders;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
+        std::atomic_size_t mDbDirectGetTileCount{ 0 };
+        std::atomic<std::int64_t> mDbDirectGetTileNanoseconds{ 0 };
 
-        void process() noexcept;
+        void process(NavMeshDb* dbReader) noexcept;
 
         JobStatus processJob(Job& job);
 
+        inline bool readTileData(NavMeshDb& db, Job& job);
+
         inline JobStatus processInitialJob(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
 
         inline JobStatus processJobWithDbResult(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
@@ -246,6 +269,8 @@ namespace DetourNavigator
 
         JobIt getNextJob();
 
+        TilePosition getPriorityTile() const;
+
         void postThreadJob(JobIt job, std::deque<JobIt>& queue);
 
         void writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const;
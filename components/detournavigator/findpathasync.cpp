@@ -0,0 +1,44 @@
+#include "findpathasync.hpp"
+#include "navigator.hpp"
+#include "navigatorutils.hpp"
+
+#include <components/debug/tracing.hpp>
+
+#include <iterator>
+#include <utility>
+
+namespace DetourNavigator
+{
+    FindPathItem::FindPathItem(SharedNavMeshCacheItem navMesh, const Settings& settings,
+        const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance)
+        : mNavMesh(std::move(navMesh))
+        , mSettings(settings)
+        , mAgentBounds(agentBounds)
+        , mStart(start)
+        , mEnd(end)
+        , mIncludeFlags(includeFlags)
+        , mAreaCosts(areaCosts)
+        , mEndTolerance(endTolerance)
+    {
+    }
+
+    void FindPathItem::doWork()
+    {
+        OPENMW_TRACE_ZONE("DetourNavigator::FindPathItem");
+        mStatus = findPath(mNavMesh, mSettings, mAgentBounds, mStart, mEnd, mIncludeFlags, mAreaCosts, mEndTolerance,
+            std::back_inserter(mPath));
+        // The navmesh shouldn't be kept alive by the finished queries
+        mNavMesh.reset();
+    }
+
+    osg::ref_ptr<FindPathItem> findPathAsync(const Navigator& navigator, SceneUtil::WorkQueue& workQueue,
+        const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, SceneUtil::WorkPriority priority)
+    {
+        osg::ref_ptr<FindPathItem> item(new FindPathItem(navigator.getNavMesh(agentBounds), navigator.getSettings(),
+            agentBounds, start, end, includeFlags, areaCosts, endTolerance));
+        workQueue.addWorkItem(item, priority);
+        return item;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDPATHASYNC_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDPATHASYNC_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "settings.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "status.hpp"
+
+#include <components/sceneutil/workqueue.hpp>
+
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Navigator;
+
+    /// @brief Work item finding a path like findPath in a work queue thread.
+    /// @note The navmesh is locked for the whole query, so the path is found over a consistent navmesh even when it
+    /// is updated meanwhile, and the item keeps the navmesh alive until it is done.
+    class FindPathItem : public SceneUtil::WorkItem
+    {
+    public:
+        FindPathItem(SharedNavMeshCacheItem navMesh, const Settings& settings, const AgentBounds& agentBounds,
+            const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags, const AreaCosts& areaCosts,
+            float endTolerance);
+
+        void doWork() override;
+
+        /// Valid once the work is done.
+        Status getStatus() const { return mStatus; }
+
+        /// Valid once the work is done, empty if no path is found.
+        std::vector<osg::Vec3f>& getPath() { return mPath; }
+
+    private:
+        SharedNavMeshCacheItem mNavMesh;
+        Settings mSettings;
+        AgentBounds mAgentBounds;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+        Status mStatus = Status::NavMeshNotFound;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    /**
+     * @brief findPathAsync queues finding a path in the work queue threads, see findPath for the parameters.
+     * @param priority of the query in the work queue.
+     * @return the work item to check if the path is found and to get it from.
+     */
+    osg::ref_ptr<FindPathItem> findPathAsync(const Navigator& navigator, SceneUtil::WorkQueue& workQueue,
+        const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance,
+        SceneUtil::WorkPriority priority = SceneUtil::WorkPriority::Urgent);
+}
+
+#endif
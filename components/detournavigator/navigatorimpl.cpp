@@ -7,8 +7,18 @@
 #include <components/misc/convert.hpp>
 #include <components/misc/coordinateconverter.hpp>
 
+#include <cmath>
+
 namespace DetourNavigator
 {
+    namespace
+    {
+        float roundUp(float value, float step)
+        {
+            return std::ceil(value / step) * step;
+        }
+    }
+
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
@@ -19,14 +29,15 @@ namespace DetourNavigator
     {
         if (!isSupportedAgentBounds(mSettings.mRecast, agentBounds))
             return false;
-        ++mAgents[agentBounds];
-        mNavMeshManager.addAgent(agentBounds);
+        const AgentBounds navMeshAgentBounds = getNavMeshAgentBounds(agentBounds);
+        ++mAgents[navMeshAgentBounds];
+        mNavMeshManager.addAgent(navMeshAgentBounds);
         return true;
     }
 
     void NavigatorImpl::removeAgent(const AgentBounds& agentBounds)
     {
-        const auto it = mAgents.find(agentBounds);
+        const auto it = mAgents.find(getNavMeshAgentBounds(agentBounds));
         if (it == mAgents.end())
             return;
         if (it->second > 0)
@@ -157,7 +168,7 @@ namespace DetourNavigator
 
     SharedNavMeshCacheItem NavigatorImpl::getNavMesh(const AgentBounds& agentBounds) const
     {
-        return mNavMeshManager.getNavMesh(agentBounds);
+        return mNavMeshManager.getNavMesh(getNavMeshAgentBounds(agentBounds));
     }
 
     std::map<AgentBounds, SharedNavMeshCacheItem> NavigatorImpl::getNavMeshes() const
@@ -180,6 +191,22 @@ namespace DetourNavigator
         return mNavMeshManager.getRecastMeshTiles();
     }
 
+    AgentBounds NavigatorImpl::getNavMeshAgentBounds(const AgentBounds& agentBounds) const
+    {
+        const float step = mSettings.mAgentBoundsStep;
+        if (step <= 0)
+            return agentBounds;
+        // Navmesh built for bigger bounds is walkable by a smaller agent, queries still use its own half extents
+        const AgentBounds result{
+            .mShapeType = agentBounds.mShapeType,
+            .mHalfExtents = osg::Vec3f(roundUp(agentBounds.mHalfExtents.x(), step),
+                roundUp(agentBounds.mHalfExtents.y(), step), roundUp(agentBounds.mHalfExtents.z(), step)),
+        };
+        if (!isSupportedAgentBounds(mSettings.mRecast, result))
+            return agentBounds;
+        return result;
+    }
+
     void NavigatorImpl::updateAvoidShapeId(const ObjectId id, const ObjectId avoidId, const UpdateGuard* guard)
     {
         updateId(id, avoidId, mWaterIds, guard);
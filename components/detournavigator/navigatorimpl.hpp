@@ -91,6 +91,8 @@ namespace DetourNavigator
 
         inline void removeUnusedNavMeshes();
 
+        AgentBounds getNavMeshAgentBounds(const AgentBounds& agentBounds) const;
+
         friend class UpdateGuard;
     };
 }
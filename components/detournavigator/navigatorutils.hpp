@@ -5,12 +5,17 @@
 #include "flags.hpp"
 #include "navigator.hpp"
 #include "navmeshcacheitem.hpp"
+#include "pathcache.hpp"
 #include "settings.hpp"
+#include "settingsutils.hpp"
+#include "sharednavmeshcacheitem.hpp"
 
 #include <components/misc/guarded.hpp>
 
+#include <algorithm>
 #include <iterator>
 #include <optional>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -25,19 +30,53 @@ namespace DetourNavigator
      * @return Status.
      * Equal to out if no path is found.
      */
-    inline Status findPath(const Navigator& navigator, const AgentBounds& agentBounds, const osg::Vec3f& start,
-        const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts, float endTolerance,
-        std::output_iterator<osg::Vec3f> auto out)
+    inline Status findPath(const SharedNavMeshCacheItem& navMesh, const Settings& settings,
+        const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, std::output_iterator<osg::Vec3f> auto out)
     {
-        const auto navMesh = navigator.getNavMesh(agentBounds);
         if (navMesh == nullptr)
             return Status::NavMeshNotFound;
-        const Settings& settings = navigator.getSettings();
-        FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
         const auto locked = navMesh->lock();
-        return findSmoothPath(locked->getQuery(), toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
-            toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
+        const PathCacheKey cacheKey
+            = makePathCacheKey(start, end, includeFlags, areaCosts, endTolerance, agentBounds.mHalfExtents);
+        const auto getTileVersion = [&](const TilePosition& position) { return locked->getTileVersion(position); };
+        if (const CachedPath* cached = locked->getPathCache().find(cacheKey, locked->getVersion(), getTileVersion))
+        {
+            std::copy(cached->mPath.begin(), cached->mPath.end(), out);
+            return cached->mStatus;
+        }
+        std::vector<osg::Vec3f> path;
+        auto pathOut = std::back_inserter(path);
+        FromNavMeshCoordinatesIterator outTransform(pathOut, settings.mRecast);
+        const osg::Vec3f navMeshStart = toNavMeshCoordinates(settings.mRecast, start);
+        const osg::Vec3f navMeshEnd = toNavMeshCoordinates(settings.mRecast, end);
+        const Status status = findSmoothPath(locked->getQuery(),
+            toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents), navMeshStart, navMeshEnd, includeFlags,
             areaCosts, settings.mDetour, endTolerance, outTransform);
+        if (status != Status::Success
+            && (!locked->hasTile(getTilePosition(settings.mRecast, navMeshStart))
+                || !locked->hasTile(getTilePosition(settings.mRecast, navMeshEnd))))
+            locked->addMissingTilePathQuery();
+        std::copy(path.begin(), path.end(), out);
+        if ((status == Status::Success || status == Status::PartialPath) && locked->getPathCache().getMaxSize() > 0)
+        {
+            CachedPath cachedPath{ .mStatus = status, .mPath = std::move(path), .mTiles = {}, .mNavMeshVersion = {} };
+            for (const TilePosition& position : getPathTilesPositions(settings.mRecast, cachedPath.mPath))
+                cachedPath.mTiles.push_back(CachedPathTile{ position, locked->getTileVersion(position) });
+            if (status == Status::PartialPath)
+                cachedPath.mNavMeshVersion = locked->getVersion();
+            locked->getPathCache().insert(cacheKey, std::move(cachedPath));
+        }
+        return status;
+    }
+
+    /// @brief findPath over the navmesh the navigator has for the agent bounds.
+    inline Status findPath(const Navigator& navigator, const AgentBounds& agentBounds, const osg::Vec3f& start,
+        const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts, float endTolerance,
+        std::output_iterator<osg::Vec3f> auto out)
+    {
+        return findPath(navigator.getNavMesh(agentBounds), navigator.getSettings(), agentBounds, start, end,
+            includeFlags, areaCosts, endTolerance, out);
     }
 
     /**
@@ -72,6 +72,7 @@ namespace DetourNavigator
 
     NavMeshCacheItem::NavMeshCacheItem(std::size_t generation, const Settings& settings)
         : mVersion{ generation, 0 }
+        , mPathCache(settings.mMaxPathCacheSize)
     {
         initEmptyNavMesh(settings, mImpl);
 
@@ -3,6 +3,7 @@
 
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
+#include "pathcache.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -11,6 +12,7 @@
 
 #include <iosfwd>
 #include <map>
+#include <optional>
 #include <set>
 
 struct dtMeshTile;
@@ -123,6 +125,29 @@ namespace DetourNavigator
 
         bool isEmptyTile(const TilePosition& position) const;
 
+        /// @return true if the tile is present in the navmesh or is known to be empty.
+        bool hasTile(const TilePosition& position) const
+        {
+            return getTile(mImpl, position) != nullptr || isEmptyTile(position);
+        }
+
+        void addMissingTilePathQuery() { ++mMissingTilePathQueries; }
+
+        std::size_t getMissingTilePathQueries() const { return mMissingTilePathQueries; }
+
+        std::size_t getUsedTilesCount() const { return mUsedTiles.size(); }
+
+        /// @return version of the tile present in the navmesh.
+        std::optional<Version> getTileVersion(const TilePosition& position) const
+        {
+            const auto it = mUsedTiles.find(position);
+            if (it == mUsedTiles.end())
+                return std::nullopt;
+            return it->second.mVersion;
+        }
+
+        PathCache& getPathCache() { return mPathCache; }
+
         template <class Function>
         void forEachUsedTile(Function&& function) const
         {
@@ -153,6 +178,8 @@ namespace DetourNavigator
         dtNavMeshQuery mQuery;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        std::size_t mMissingTilePathQueries = 0;
+        PathCache mPathCache;
     };
 }
 
@@ -11,7 +11,11 @@
 #include <sqlite3.h>
 
 #include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -48,6 +52,20 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_shapes_by_name_and_type_and_hash
                 ON shapes (name, type, hash);
 
+            CREATE TABLE IF NOT EXISTS cells (
+                worldspace TEXT NOT NULL,
+                cell_position_x INTEGER NOT NULL,
+                cell_position_y INTEGER NOT NULL,
+                hash BLOB NOT NULL,
+                begin_tile_position_x INTEGER NOT NULL,
+                begin_tile_position_y INTEGER NOT NULL,
+                end_tile_position_x INTEGER NOT NULL,
+                end_tile_position_y INTEGER NOT NULL
+            );
+
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_cells_by_worldspace_and_cell_position
+                ON cells (worldspace, cell_position_x, cell_position_y);
+
             COMMIT;
         )";
 
@@ -128,10 +146,130 @@ namespace DetourNavigator
                    VALUES      (:shape_id, :name, :type, :hash)
         )";
 
+        constexpr std::string_view getCellsQuery = R"(
+            SELECT cell_position_x, cell_position_y, hash,
+                   begin_tile_position_x, begin_tile_position_y, end_tile_position_x, end_tile_position_y
+              FROM cells
+             WHERE worldspace = :worldspace
+        )";
+
+        constexpr std::string_view insertCellQuery = R"(
+            INSERT INTO cells ( worldspace,  cell_position_x,  cell_position_y,  hash,
+                                begin_tile_position_x,  begin_tile_position_y,
+                                end_tile_position_x,  end_tile_position_y)
+                   VALUES     (:worldspace, :cell_position_x, :cell_position_y, :hash,
+                               :begin_tile_position_x, :begin_tile_position_y,
+                               :end_tile_position_x, :end_tile_position_y)
+        )";
+
+        constexpr std::string_view deleteCellsQuery = R"(
+            DELETE FROM cells
+             WHERE worldspace = :worldspace
+        )";
+
         constexpr std::string_view vacuumQuery = R"(
             VACUUM;
         )";
 
+        constexpr std::string_view attachMergedDbQuery = R"(
+            ATTACH DATABASE :path AS merged
+        )";
+
+        constexpr std::string_view mergeShapesQuery = R"(
+            INSERT OR IGNORE INTO main.shapes (shape_id, name, type, hash)
+                 SELECT shape_id, name, type, hash
+                   FROM merged.shapes
+        )";
+
+        constexpr std::string_view countConflictingShapesQuery = R"(
+            SELECT count(*)
+              FROM merged.shapes AS merged_shapes
+             WHERE NOT EXISTS (
+                       SELECT 1
+                         FROM main.shapes AS main_shapes
+                        WHERE main_shapes.shape_id = merged_shapes.shape_id
+                          AND main_shapes.name = merged_shapes.name
+                          AND main_shapes.type = merged_shapes.type
+                          AND main_shapes.hash = merged_shapes.hash
+                   )
+        )";
+
+        constexpr std::string_view mergeTilesQuery = R"(
+            INSERT OR IGNORE INTO main.tiles (tile_id, worldspace, version, tile_position_x, tile_position_y,
+                                              input, data)
+                 SELECT tile_id + :tile_id_offset, worldspace, version, tile_position_x, tile_position_y,
+                        input, data
+                   FROM merged.tiles
+        )";
+
+        constexpr std::string_view deleteMergedWorldspacesCellsQuery = R"(
+            DELETE FROM main.cells
+             WHERE worldspace IN (SELECT worldspace FROM merged.cells)
+        )";
+
+        constexpr std::string_view mergeCellsQuery = R"(
+            INSERT INTO main.cells (worldspace, cell_position_x, cell_position_y, hash,
+                                              begin_tile_position_x, begin_tile_position_y,
+                                              end_tile_position_x, end_tile_position_y)
+                 SELECT worldspace, cell_position_x, cell_position_y, hash,
+                        begin_tile_position_x, begin_tile_position_y, end_tile_position_x, end_tile_position_y
+                   FROM merged.cells
+        )";
+
+        struct AttachMergedDb
+        {
+            static std::string_view text() noexcept { return attachMergedDbQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view path)
+            {
+                Sqlite3::bindParameter(db, statement, ":path", path);
+            }
+        };
+
+        struct MergeShapes
+        {
+            static std::string_view text() noexcept { return mergeShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct CountConflictingShapes
+        {
+            static std::string_view text() noexcept { return countConflictingShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct MergeTiles
+        {
+            static std::string_view text() noexcept { return mergeTilesQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileIdOffset)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id_offset", tileIdOffset);
+            }
+        };
+
+        struct DeleteMergedWorldspacesCells
+        {
+            static std::string_view text() noexcept { return deleteMergedWorldspacesCellsQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct MergeCells
+        {
+            static std::string_view text() noexcept { return mergeCellsQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct DetachMergedDb
+        {
+            sqlite3& mDb;
+
+            ~DetachMergedDb()
+            {
+                if (const int ec = sqlite3_exec(&mDb, "DETACH DATABASE merged", nullptr, nullptr, nullptr);
+                    ec != SQLITE_OK)
+                    Log(Debug::Warning) << "Failed to detach merged NavMeshDb: " << sqlite3_errmsg(&mDb);
+            }
+        };
+
         struct GetPageSize
         {
             static std::string_view text() noexcept { return "pragma page_size;"; }
@@ -152,6 +290,15 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        void setWriteAheadLog(sqlite3& db)
+        {
+            // Readers don't block the writer and a commit doesn't need to sync the whole database file. Losing the
+            // last transactions on power loss is fine for a cache.
+            constexpr const char query[] = "pragma journal_mode = WAL; pragma synchronous = NORMAL;";
+            if (const int ec = sqlite3_exec(&db, query, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                Log(Debug::Warning) << "Failed to set NavMeshDb journal mode: " << sqlite3_errmsg(&db);
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -166,8 +313,8 @@ namespace DetourNavigator
         return stream << "unknown shape type (" << static_cast<std::underlying_type_t<ShapeType>>(value) << ")";
     }
 
-    NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+    NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize, NavMeshDbMode mode)
+        : mDb(mode == NavMeshDbMode::ReadOnly ? Sqlite3::makeReadOnlyDb(path) : Sqlite3::makeDb(path, schema))
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
@@ -179,12 +326,26 @@ namespace DetourNavigator
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId{})
         , mFindShapeId(*mDb, DbQueries::FindShapeId{})
         , mInsertShape(*mDb, DbQueries::InsertShape{})
+        , mGetCells(*mDb, DbQueries::GetCells{})
+        , mInsertCell(*mDb, DbQueries::InsertCell{})
+        , mDeleteCells(*mDb, DbQueries::DeleteCells{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
     {
+        if (mode == NavMeshDbMode::ReadOnly)
+            return;
         const std::uint64_t dbPageSize = getPageSize(*mDb);
         if (dbPageSize == 0)
             throw std::runtime_error("NavMeshDb page size is zero");
         setMaxPageCount(*mDb, maxFileSize / dbPageSize + static_cast<std::uint64_t>((maxFileSize % dbPageSize) != 0));
+        setWriteAheadLog(*mDb);
+    }
+
+    std::string NavMeshDb::getPath() const
+    {
+        const char* const path = sqlite3_db_filename(mDb.get(), "main");
+        if (path == nullptr)
+            return {};
+        return path;
     }
 
     Sqlite3::Transaction NavMeshDb::startTransaction(Sqlite3::TransactionMode mode)
@@ -272,11 +433,67 @@ namespace DetourNavigator
         return execute(*mDb, mInsertShape, shapeId, name, type, hash);
     }
 
+    std::vector<CellInput> NavMeshDb::getCells(ESM::RefId worldspace)
+    {
+        std::vector<std::tuple<int, int, std::vector<std::byte>, int, int, int, int>> rows;
+        request(*mDb, mGetCells, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace.serializeText());
+        std::vector<CellInput> result;
+        result.reserve(rows.size());
+        for (auto& [x, y, hash, beginX, beginY, endX, endY] : rows)
+            result.push_back(CellInput{
+                .mCellPosition = osg::Vec2i(x, y),
+                .mHash = std::move(hash),
+                .mTilesRange = TilesPositionsRange{ .mBegin = TilePosition(beginX, beginY),
+                    .mEnd = TilePosition(endX, endY) },
+            });
+        return result;
+    }
+
+    int NavMeshDb::insertCell(ESM::RefId worldspace, const CellInput& cell)
+    {
+        return execute(*mDb, mInsertCell, worldspace.serializeText(), cell);
+    }
+
+    int NavMeshDb::deleteCells(ESM::RefId worldspace)
+    {
+        return execute(*mDb, mDeleteCells, worldspace.serializeText());
+    }
+
     void NavMeshDb::vacuum()
     {
         execute(*mDb, mVacuum);
     }
 
+    NavMeshDbMergeStats NavMeshDb::merge(std::string_view path)
+    {
+        {
+            Sqlite3::Statement<AttachMergedDb> attach(*mDb);
+            execute(*mDb, attach, path);
+        }
+        // Statements using the attached db have to be finalized before it's detached
+        const DetachMergedDb detach{ *mDb };
+        Sqlite3::Statement<MergeShapes> mergeShapes(*mDb);
+        Sqlite3::Statement<CountConflictingShapes> countConflictingShapes(*mDb);
+        Sqlite3::Statement<MergeTiles> mergeTiles(*mDb);
+        Sqlite3::Statement<DeleteMergedWorldspacesCells> deleteMergedWorldspacesCells(*mDb);
+        Sqlite3::Statement<MergeCells> mergeCells(*mDb);
+        Sqlite3::Transaction transaction(*mDb, Sqlite3::TransactionMode::Immediate);
+        NavMeshDbMergeStats result;
+        result.mShapes = static_cast<std::size_t>(execute(*mDb, mergeShapes));
+        std::int64_t conflictingShapes = 0;
+        request(*mDb, countConflictingShapes, &conflictingShapes, 1);
+        if (conflictingShapes != 0)
+            throw std::runtime_error("Failed to merge NavMeshDb \"" + std::string(path) + "\": "
+                + std::to_string(conflictingShapes) + " shapes have different ids");
+        result.mTiles = static_cast<std::size_t>(execute(*mDb, mergeTiles, getMaxTileId()));
+        // All shards gather the same cells, the merged ones are the latest
+        execute(*mDb, deleteMergedWorldspacesCells);
+        result.mCells = static_cast<std::size_t>(execute(*mDb, mergeCells));
+        transaction.commit();
+        return result;
+    }
+
     namespace DbQueries
     {
         std::string_view GetMaxTileId::text() noexcept
@@ -417,6 +634,43 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":hash", hash);
         }
 
+        std::string_view GetCells::text() noexcept
+        {
+            return getCellsQuery;
+        }
+
+        void GetCells::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+        }
+
+        std::string_view InsertCell::text() noexcept
+        {
+            return insertCellQuery;
+        }
+
+        void InsertCell::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const CellInput& cell)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":cell_position_x", cell.mCellPosition.x());
+            Sqlite3::bindParameter(db, statement, ":cell_position_y", cell.mCellPosition.y());
+            Sqlite3::bindParameter(db, statement, ":hash", cell.mHash);
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_x", cell.mTilesRange.mBegin.x());
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_y", cell.mTilesRange.mBegin.y());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_x", cell.mTilesRange.mEnd.x());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_y", cell.mTilesRange.mEnd.y());
+        }
+
+        std::string_view DeleteCells::text() noexcept
+        {
+            return deleteCellsQuery;
+        }
+
+        void DeleteCells::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+        }
+
         std::string_view Vacuum::text() noexcept
         {
             return vacuumQuery;
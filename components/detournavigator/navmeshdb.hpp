@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -40,6 +41,21 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    // Hash of the navmesh input of a cell and the tiles it affects
+    struct CellInput
+    {
+        osg::Vec2i mCellPosition;
+        std::vector<std::byte> mHash;
+        TilesPositionsRange mTilesRange;
+    };
+
+    struct NavMeshDbMergeStats
+    {
+        std::size_t mShapes = 0;
+        std::size_t mTiles = 0;
+        std::size_t mCells = 0;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -48,6 +64,12 @@ namespace DetourNavigator
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value);
 
+    enum class NavMeshDbMode
+    {
+        ReadWrite,
+        ReadOnly,
+    };
+
     namespace DbQueries
     {
         struct GetMaxTileId
@@ -126,6 +148,24 @@ namespace DetourNavigator
                 ShapeType type, const Sqlite3::ConstBlob& hash);
         };
 
+        struct GetCells
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace);
+        };
+
+        struct InsertCell
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const CellInput& cell);
+        };
+
+        struct DeleteCells
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace);
+        };
+
         struct Vacuum
         {
             static std::string_view text() noexcept;
@@ -136,7 +176,12 @@ namespace DetourNavigator
     class NavMeshDb
     {
     public:
-        explicit NavMeshDb(std::string_view path, std::uint64_t maxFileSize);
+        /// @param maxFileSize Ignored in ReadOnly mode, the schema is expected to be created by a ReadWrite db
+        explicit NavMeshDb(
+            std::string_view path, std::uint64_t maxFileSize, NavMeshDbMode mode = NavMeshDbMode::ReadWrite);
+
+        /// @return Path of the db file, empty for in-memory and temporary dbs which can't be opened again
+        std::string getPath() const;
 
         Sqlite3::Transaction startTransaction(Sqlite3::TransactionMode mode = Sqlite3::TransactionMode::Default);
 
@@ -165,8 +210,19 @@ namespace DetourNavigator
 
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        std::vector<CellInput> getCells(ESM::RefId worldspace);
+
+        int insertCell(ESM::RefId worldspace, const CellInput& cell);
+
+        int deleteCells(ESM::RefId worldspace);
+
         void vacuum();
 
+        /// Copy shapes and tiles missing in this db from the db at the given path and replace cells of the same
+        /// worldspaces. Both dbs must use the same shape ids for the same shapes because tile inputs refer to them,
+        /// otherwise an exception is thrown and nothing is copied.
+        NavMeshDbMergeStats merge(std::string_view path);
+
     private:
         Sqlite3::Db mDb;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
@@ -180,6 +236,9 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
+        Sqlite3::Statement<DbQueries::GetCells> mGetCells;
+        Sqlite3::Statement<DbQueries::InsertCell> mInsertCell;
+        Sqlite3::Statement<DbQueries::DeleteCells> mDeleteCells;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
     };
 }
@@ -15,6 +15,8 @@
 
 #include <DetourNavMesh.h>
 
+#include <utility>
+
 namespace
 {
     /// Safely reset shared_ptr with definite underlying object destrutor call.
@@ -101,6 +103,8 @@ namespace DetourNavigator
             for (auto& [agent, cache] : mCache)
                 cache = std::make_shared<GuardedNavMeshCacheItem>(++mGenerationCounter, mSettings);
             mWorldspace = worldspace;
+            mLastPlayerMotion.reset();
+            mPlayerVelocity = osg::Vec3f();
         }
 
         const TilePosition playerTile = toNavMeshTilePosition(mSettings.mRecast, playerPosition);
@@ -192,6 +196,8 @@ namespace DetourNavigator
 
     void NavMeshManager::update(const osg::Vec3f& playerPosition, const UpdateGuard* guard)
     {
+        mAsyncNavMeshUpdater.setPriorityTile(
+            toNavMeshTilePosition(mSettings.mRecast, predictPlayerPosition(playerPosition)));
         const TilePosition playerTile = toNavMeshTilePosition(mSettings.mRecast, playerPosition);
         if (mLastRecastMeshManagerRevision == mRecastMeshManager.getRevision() && mPlayerTile.has_value()
             && *mPlayerTile == playerTile)
@@ -251,9 +257,20 @@ namespace DetourNavigator
 
     Stats NavMeshManager::getStats() const
     {
+        std::size_t missingTilePathQueries = 0;
+        std::size_t navMeshTiles = 0;
+        for (const auto& [agentBounds, cached] : mCache)
+        {
+            const auto locked = cached->lockConst();
+            missingTilePathQueries += locked->getMissingTilePathQueries();
+            navMeshTiles += locked->getUsedTilesCount();
+        }
         return Stats{
             .mUpdater = mAsyncNavMeshUpdater.getStats(),
             .mRecast = mRecastMeshManager.getStats(),
+            .mMissingTilePathQueries = missingTilePathQueries,
+            .mNavMeshes = mCache.size(),
+            .mNavMeshTiles = navMeshTiles,
         };
     }
 
@@ -267,6 +284,23 @@ namespace DetourNavigator
         return result;
     }
 
+    osg::Vec3f NavMeshManager::predictPlayerPosition(const osg::Vec3f& playerPosition)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const std::optional<PlayerMotion> last = std::exchange(mLastPlayerMotion, PlayerMotion{ playerPosition, now });
+        if (mSettings.mJobPriorityLeadTime.count() <= 0 || !last.has_value())
+            return playerPosition;
+        const osg::Vec3f displacement = playerPosition - last->mPosition;
+        const float maxDisplacement = getRealTileSize(mSettings.mRecast);
+        // Moving more than a tile between updates is a teleport. There is nothing to extrapolate until the player
+        // starts moving from the destination.
+        if (displacement.length2() > maxDisplacement * maxDisplacement)
+            mPlayerVelocity = osg::Vec3f();
+        else if (const float duration = std::chrono::duration<float>(now - last->mTime).count(); duration > 0)
+            mPlayerVelocity = displacement / duration;
+        return playerPosition + mPlayerVelocity * std::chrono::duration<float>(mSettings.mJobPriorityLeadTime).count();
+    }
+
     SharedNavMeshCacheItem NavMeshManager::getCached(const AgentBounds& agentBounds) const
     {
         const auto cached = mCache.find(agentBounds);
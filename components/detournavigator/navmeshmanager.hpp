@@ -11,8 +11,10 @@
 
 #include <osg/Vec3f>
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 
 class dtNavMesh;
 
@@ -66,6 +68,12 @@ namespace DetourNavigator
         RecastMeshTiles getRecastMeshTiles() const;
 
     private:
+        struct PlayerMotion
+        {
+            osg::Vec3f mPosition;
+            std::chrono::steady_clock::time_point mTime;
+        };
+
         const Settings& mSettings;
         const int mMaxRadius;
         ESM::RefId mWorldspace;
@@ -77,9 +85,13 @@ namespace DetourNavigator
         std::size_t mGenerationCounter = 0;
         std::optional<TilePosition> mPlayerTile;
         std::size_t mLastRecastMeshManagerRevision = 0;
+        std::optional<PlayerMotion> mLastPlayerMotion;
+        osg::Vec3f mPlayerVelocity;
 
         inline SharedNavMeshCacheItem getCached(const AgentBounds& agentBounds) const;
 
+        inline osg::Vec3f predictPlayerPosition(const osg::Vec3f& playerPosition);
+
         inline void update(const AgentBounds& agentBounds, const TilePosition& playerTile,
             const TilesPositionsRange& range, const SharedNavMeshCacheItem& cached,
             const std::map<osg::Vec2i, ChangeType>& changedTiles);
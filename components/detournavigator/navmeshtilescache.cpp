@@ -1,10 +1,121 @@
 #include "navmeshtilescache.hpp"
 #include "stats.hpp"
 
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
 #include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
 
 namespace DetourNavigator
 {
+    namespace
+    {
+        // Large arrays are hashed and compared as bytes, this is much faster than doing it per element. Two values may
+        // compare equal by value while having different representation (e.g. 0 and -0) which only leads to a cache
+        // miss.
+        template <class T>
+        std::string_view asBytes(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return std::string_view(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        void hashCombine(std::size_t& seed, const osg::Vec2i& value)
+        {
+            Misc::hashCombine(seed, value.x());
+            Misc::hashCombine(seed, value.y());
+        }
+
+        void hashCombine(std::size_t& seed, const Heightfield& value)
+        {
+            hashCombine(seed, value.mCellPosition);
+            Misc::hashCombine(seed, value.mCellSize);
+            Misc::hashCombine(seed, value.mLength);
+            Misc::hashCombine(seed, value.mMinHeight);
+            Misc::hashCombine(seed, value.mMaxHeight);
+            Misc::hashCombine(seed, asBytes(value.mHeights));
+            Misc::hashCombine(seed, value.mOriginalSize);
+            Misc::hashCombine(seed, value.mMinX);
+            Misc::hashCombine(seed, value.mMinY);
+        }
+
+        std::size_t makeHash(
+            const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
+        {
+            std::size_t result = 0;
+            Misc::hashCombine(result, agentBounds.mShapeType);
+            Misc::hashCombine(result, agentBounds.mHalfExtents.x());
+            Misc::hashCombine(result, agentBounds.mHalfExtents.y());
+            Misc::hashCombine(result, agentBounds.mHalfExtents.z());
+            hashCombine(result, changedTile);
+            Misc::hashCombine(result, asBytes(recastMesh.getMesh().getIndices()));
+            Misc::hashCombine(result, asBytes(recastMesh.getMesh().getVertices()));
+            Misc::hashCombine(result, asBytes(recastMesh.getMesh().getAreaTypes()));
+            for (const CellWater& v : recastMesh.getWater())
+            {
+                hashCombine(result, v.mCellPosition);
+                Misc::hashCombine(result, v.mWater.mCellSize);
+                Misc::hashCombine(result, v.mWater.mLevel);
+            }
+            for (const Heightfield& v : recastMesh.getHeightfields())
+                hashCombine(result, v);
+            for (const FlatHeightfield& v : recastMesh.getFlatHeightfields())
+            {
+                hashCombine(result, v.mCellPosition);
+                Misc::hashCombine(result, v.mCellSize);
+                Misc::hashCombine(result, v.mHeight);
+            }
+            return result;
+        }
+
+        bool isEqual(const Mesh& lhs, const Mesh& rhs)
+        {
+            return asBytes(lhs.getIndices()) == asBytes(rhs.getIndices())
+                && asBytes(lhs.getVertices()) == asBytes(rhs.getVertices())
+                && asBytes(lhs.getAreaTypes()) == asBytes(rhs.getAreaTypes());
+        }
+
+        bool isEqual(const CellWater& lhs, const CellWater& rhs)
+        {
+            return lhs.mCellPosition == rhs.mCellPosition && lhs.mWater.mCellSize == rhs.mWater.mCellSize
+                && lhs.mWater.mLevel == rhs.mWater.mLevel;
+        }
+
+        bool isEqual(const Heightfield& lhs, const Heightfield& rhs)
+        {
+            return lhs.mCellPosition == rhs.mCellPosition && lhs.mCellSize == rhs.mCellSize
+                && lhs.mLength == rhs.mLength && lhs.mMinHeight == rhs.mMinHeight && lhs.mMaxHeight == rhs.mMaxHeight
+                && lhs.mOriginalSize == rhs.mOriginalSize && lhs.mMinX == rhs.mMinX && lhs.mMinY == rhs.mMinY
+                && asBytes(lhs.mHeights) == asBytes(rhs.mHeights);
+        }
+
+        bool isEqual(const FlatHeightfield& lhs, const FlatHeightfield& rhs)
+        {
+            return lhs.mCellPosition == rhs.mCellPosition && lhs.mCellSize == rhs.mCellSize
+                && lhs.mHeight == rhs.mHeight;
+        }
+
+        template <class T>
+        bool isEqual(const std::vector<T>& lhs, const std::vector<T>& rhs)
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                [](const T& l, const T& r) { return isEqual(l, r); });
+        }
+
+        bool isEqual(const NavMeshTilesCache::Item& item, const AgentBounds& agentBounds,
+            const TilePosition& changedTile, const RecastMesh& recastMesh)
+        {
+            return item.mAgentBounds == agentBounds && item.mChangedTile == changedTile
+                && isEqual(item.mRecastMeshData.mMesh, recastMesh.getMesh())
+                && isEqual(item.mRecastMeshData.mWater, recastMesh.getWater())
+                && isEqual(item.mRecastMeshData.mHeightfields, recastMesh.getHeightfields())
+                && isEqual(item.mRecastMeshData.mFlatHeightfields, recastMesh.getFlatHeightfields());
+        }
+    }
+
     NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
         : mMaxNavMeshDataSize(maxNavMeshDataSize)
         , mUsedNavMeshDataSize(0)
@@ -17,19 +128,21 @@ namespace DetourNavigator
     NavMeshTilesCache::Value NavMeshTilesCache::get(
         const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
     {
+        const std::size_t hash = makeHash(agentBounds, changedTile, recastMesh);
+
         const std::lock_guard<std::mutex> lock(mMutex);
 
         ++mGetCount;
 
-        const auto tile = mValues.find(std::tie(agentBounds, changedTile, recastMesh));
-        if (tile == mValues.end())
+        const std::optional<ItemIterator> item = findUnsafe(hash, agentBounds, changedTile, recastMesh);
+        if (!item.has_value())
             return Value();
 
-        acquireItemUnsafe(tile->second);
+        acquireItemUnsafe(*item);
 
         ++mHitCount;
 
-        return Value(*this, tile->second);
+        return Value(*this, *item);
     }
 
     NavMeshTilesCache::Value NavMeshTilesCache::set(const AgentBounds& agentBounds, const TilePosition& changedTile,
@@ -37,30 +150,30 @@ namespace DetourNavigator
     {
         const auto itemSize = sizeof(RecastMesh) + getSize(recastMesh)
             + (value == nullptr ? 0 : sizeof(PreparedNavMeshData) + getSize(*value));
+        const std::size_t hash = makeHash(agentBounds, changedTile, recastMesh);
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
         if (itemSize > mFreeNavMeshDataSize + (mMaxNavMeshDataSize - mUsedNavMeshDataSize))
             return Value();
 
+        if (const std::optional<ItemIterator> item = findUnsafe(hash, agentBounds, changedTile, recastMesh))
+        {
+            acquireItemUnsafe(*item);
+            ++mGetCount;
+            ++mHitCount;
+            return Value(*this, *item);
+        }
+
         while (!mFreeItems.empty() && mUsedNavMeshDataSize + itemSize > mMaxNavMeshDataSize)
             removeLeastRecentlyUsed();
 
         RecastMeshData key{ recastMesh.getMesh(), recastMesh.getWater(), recastMesh.getHeightfields(),
             recastMesh.getFlatHeightfields() };
 
-        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize);
-        const auto emplaced = mValues.emplace(
-            std::make_tuple(agentBounds, changedTile, std::cref(iterator->mRecastMeshData)), iterator);
-
-        if (!emplaced.second)
-        {
-            mFreeItems.erase(iterator);
-            acquireItemUnsafe(emplaced.first->second);
-            ++mGetCount;
-            ++mHitCount;
-            return Value(*this, emplaced.first->second);
-        }
+        const auto iterator
+            = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize, hash);
+        mValues.emplace(hash, iterator);
 
         iterator->mPreparedNavMeshData = std::move(value);
         ++iterator->mUseCount;
@@ -84,16 +197,27 @@ namespace DetourNavigator
         return result;
     }
 
+    std::optional<NavMeshTilesCache::ItemIterator> NavMeshTilesCache::findUnsafe(std::size_t hash,
+        const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh) const
+    {
+        const auto [begin, end] = mValues.equal_range(hash);
+        for (auto it = begin; it != end; ++it)
+            if (isEqual(*it->second, agentBounds, changedTile, recastMesh))
+                return it->second;
+        return std::nullopt;
+    }
+
     void NavMeshTilesCache::removeLeastRecentlyUsed()
     {
-        const auto& item = mFreeItems.back();
+        const auto iterator = std::prev(mFreeItems.end());
 
-        const auto value = mValues.find(std::tie(item.mAgentBounds, item.mChangedTile, item.mRecastMeshData));
-        if (value == mValues.end())
+        const auto [begin, end] = mValues.equal_range(iterator->mHash);
+        const auto value = std::find_if(begin, end, [&](const auto& v) { return v.second == iterator; });
+        if (value == end)
             return;
 
-        mUsedNavMeshDataSize -= item.mSize;
-        mFreeNavMeshDataSize -= item.mSize;
+        mUsedNavMeshDataSize -= iterator->mSize;
+        mFreeNavMeshDataSize -= iterator->mSize;
 
         mValues.erase(value);
         mFreeItems.pop_back();
@@ -10,8 +10,9 @@
 #include <cassert>
 #include <cstring>
 #include <list>
-#include <map>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace DetourNavigator
@@ -24,24 +25,6 @@ namespace DetourNavigator
         std::vector<FlatHeightfield> mFlatHeightfields;
     };
 
-    inline bool operator<(const RecastMeshData& lhs, const RecastMeshData& rhs)
-    {
-        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
-    }
-
-    inline bool operator<(const RecastMeshData& lhs, const RecastMesh& rhs)
-    {
-        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.getMesh(), rhs.getWater(), rhs.getHeightfields(), rhs.getFlatHeightfields());
-    }
-
-    inline bool operator<(const RecastMesh& lhs, const RecastMeshData& rhs)
-    {
-        return std::tie(lhs.getMesh(), lhs.getWater(), lhs.getHeightfields(), lhs.getFlatHeightfields())
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
-    }
-
     struct NavMeshTilesCacheStats;
 
     class NavMeshTilesCache
@@ -55,14 +38,16 @@ namespace DetourNavigator
             RecastMeshData mRecastMeshData;
             std::unique_ptr<PreparedNavMeshData> mPreparedNavMeshData;
             std::size_t mSize;
+            std::size_t mHash;
 
             Item(const AgentBounds& agentBounds, const TilePosition& changedTile, RecastMeshData&& recastMeshData,
-                std::size_t size)
+                std::size_t size, std::size_t hash)
                 : mUseCount(0)
                 , mAgentBounds(agentBounds)
                 , mChangedTile(changedTile)
                 , mRecastMeshData(std::move(recastMeshData))
                 , mSize(size)
+                , mHash(hash)
             {
             }
         };
@@ -141,9 +126,11 @@ namespace DetourNavigator
         std::size_t mGetCount;
         std::list<Item> mBusyItems;
         std::list<Item> mFreeItems;
-        std::map<std::tuple<AgentBounds, TilePosition, std::reference_wrapper<const RecastMeshData>>, ItemIterator,
-            std::less<>>
-            mValues;
+        // Indexed by the hash of the whole key, items with colliding hashes are distinguished by comparing keys
+        std::unordered_multimap<std::size_t, ItemIterator> mValues;
+
+        std::optional<ItemIterator> findUnsafe(std::size_t hash, const AgentBounds& agentBounds,
+            const TilePosition& changedTile, const RecastMesh& recastMesh) const;
 
         void removeLeastRecentlyUsed();
 
@@ -0,0 +1,69 @@
+#include "pathcache.hpp"
+#include "gettilespositions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr float pathCacheQuantum = 8;
+
+        osg::Vec3i quantize(const osg::Vec3f& value)
+        {
+            return osg::Vec3i(static_cast<int>(std::floor(value.x() / pathCacheQuantum)),
+                static_cast<int>(std::floor(value.y() / pathCacheQuantum)),
+                static_cast<int>(std::floor(value.z() / pathCacheQuantum)));
+        }
+    }
+
+    PathCacheKey makePathCacheKey(const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, const osg::Vec3f& agentHalfExtents)
+    {
+        return PathCacheKey{
+            .mStart = quantize(start),
+            .mEnd = quantize(end),
+            .mIncludeFlags = includeFlags,
+            .mAreaCosts = areaCosts,
+            .mEndTolerance = endTolerance,
+            .mAgentHalfExtents = agentHalfExtents,
+        };
+    }
+
+    std::vector<TilePosition> getPathTilesPositions(const RecastSettings& settings, const std::vector<osg::Vec3f>& path)
+    {
+        std::set<TilePosition> result;
+        const auto addSegment = [&](const osg::Vec3f& begin, const osg::Vec3f& end) {
+            const osg::Vec2f min(std::min(begin.x(), end.x()), std::min(begin.y(), end.y()));
+            const osg::Vec2f max(std::max(begin.x(), end.x()), std::max(begin.y(), end.y()));
+            getTilesPositions(makeTilesPositionsRange(min, max, settings),
+                [&](const TilePosition& position) { result.insert(position); });
+        };
+        if (path.size() == 1)
+            addSegment(path.front(), path.front());
+        for (std::size_t i = 1; i < path.size(); ++i)
+            addSegment(path[i - 1], path[i]);
+        return std::vector<TilePosition>(result.begin(), result.end());
+    }
+
+    void PathCache::insert(const PathCacheKey& key, CachedPath&& path)
+    {
+        if (mMaxSize == 0)
+            return;
+        if (const auto it = mIndex.find(key); it != mIndex.end())
+        {
+            it->second->second = std::move(path);
+            mItems.splice(mItems.begin(), mItems, it->second);
+            return;
+        }
+        if (mItems.size() >= mMaxSize)
+        {
+            mIndex.erase(mItems.back().first);
+            mItems.pop_back();
+        }
+        mItems.emplace_front(key, std::move(path));
+        mIndex.emplace(key, mItems.begin());
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHCACHE_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "status.hpp"
+#include "tileposition.hpp"
+#include "version.hpp"
+
+#include <osg/Vec3f>
+#include <osg/Vec3i>
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct PathCacheKey
+    {
+        osg::Vec3i mStart;
+        osg::Vec3i mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+        // Agents with different bounds may share a navmesh but find different paths
+        osg::Vec3f mAgentHalfExtents;
+
+        friend inline auto tie(const PathCacheKey& v)
+        {
+            return std::tie(v.mStart, v.mEnd, v.mIncludeFlags, v.mAreaCosts.mWater, v.mAreaCosts.mDoor,
+                v.mAreaCosts.mPathgrid, v.mAreaCosts.mGround, v.mEndTolerance, v.mAgentHalfExtents);
+        }
+
+        friend inline bool operator<(const PathCacheKey& l, const PathCacheKey& r) { return tie(l) < tie(r); }
+    };
+
+    PathCacheKey makePathCacheKey(const osg::Vec3f& start, const osg::Vec3f& end, Flags includeFlags,
+        const AreaCosts& areaCosts, float endTolerance, const osg::Vec3f& agentHalfExtents);
+
+    struct RecastSettings;
+
+    /// @return positions of tiles crossed by the path given in world coordinates.
+    std::vector<TilePosition> getPathTilesPositions(const RecastSettings& settings, const std::vector<osg::Vec3f>& path);
+
+    struct CachedPathTile
+    {
+        TilePosition mPosition;
+        std::optional<Version> mVersion;
+    };
+
+    struct CachedPath
+    {
+        Status mStatus;
+        std::vector<osg::Vec3f> mPath;
+        // Path is valid while these tiles are not changed
+        std::vector<CachedPathTile> mTiles;
+        // Partial path may become complete after a change of any tile
+        std::optional<Version> mNavMeshVersion;
+    };
+
+    /// @brief Stores recently found paths over a single navmesh
+    /// @par Actors following or chasing the same target request almost the same path many times. Start and end
+    /// positions are quantized so such requests share the result until the navmesh tiles the path goes through change.
+    class PathCache
+    {
+    public:
+        explicit PathCache(std::size_t maxSize)
+            : mMaxSize(maxSize)
+        {
+        }
+
+        std::size_t getMaxSize() const { return mMaxSize; }
+
+        /// @param getTileVersion returns current version of the tile or nothing if the tile is not present
+        template <class GetTileVersion>
+        const CachedPath* find(const PathCacheKey& key, const Version& navMeshVersion, GetTileVersion&& getTileVersion)
+        {
+            const auto it = mIndex.find(key);
+            if (it == mIndex.end())
+                return nullptr;
+            const CachedPath& path = it->second->second;
+            const auto isChanged = [&](const CachedPathTile& tile) {
+                return getTileVersion(tile.mPosition) != tile.mVersion;
+            };
+            if ((path.mNavMeshVersion.has_value() && *path.mNavMeshVersion != navMeshVersion)
+                || std::any_of(path.mTiles.begin(), path.mTiles.end(), isChanged))
+            {
+                mItems.erase(it->second);
+                mIndex.erase(it);
+                return nullptr;
+            }
+            mItems.splice(mItems.begin(), mItems, it->second);
+            return &path;
+        }
+
+        void insert(const PathCacheKey& key, CachedPath&& path);
+
+    private:
+        using Items = std::list<std::pair<PathCacheKey, CachedPath>>;
+
+        std::size_t mMaxSize;
+        Items mItems;
+        std::map<PathCacheKey, Items::iterator> mIndex;
+    };
+}
+
+#endif
@@ -40,6 +40,30 @@ namespace DetourNavigator
             return static_cast<float>(cellSize) / (dataSize - 1);
         }
 
+        // Shape local box covering the part of the shape within the tile bounds, so shapes having bounding volume
+        // hierarchy walk only the triangles near the tile
+        void getTileLocalAabb(const btCollisionShape& shape, const btTransform& transform, const TileBounds& bounds,
+            btVector3& aabbMin, btVector3& aabbMax)
+        {
+            using BulletHelpers::transformBoundingBox;
+
+            shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+
+            transformBoundingBox(transform, aabbMin, aabbMax);
+
+            aabbMin.setX(std::max(static_cast<btScalar>(bounds.mMin.x()), aabbMin.x()));
+            aabbMin.setX(std::min(static_cast<btScalar>(bounds.mMax.x()), aabbMin.x()));
+            aabbMin.setY(std::max(static_cast<btScalar>(bounds.mMin.y()), aabbMin.y()));
+            aabbMin.setY(std::min(static_cast<btScalar>(bounds.mMax.y()), aabbMin.y()));
+
+            aabbMax.setX(std::max(static_cast<btScalar>(bounds.mMin.x()), aabbMax.x()));
+            aabbMax.setX(std::min(static_cast<btScalar>(bounds.mMax.x()), aabbMax.x()));
+            aabbMax.setY(std::max(static_cast<btScalar>(bounds.mMin.y()), aabbMax.y()));
+            aabbMax.setY(std::min(static_cast<btScalar>(bounds.mMax.y()), aabbMax.y()));
+
+            transformBoundingBox(transform.inverse(), aabbMin, aabbMax);
+        }
+
         bool isNan(const RecastMeshTriangle& triangle)
         {
             for (std::size_t i = 0; i < 3; ++i)
@@ -284,7 +308,7 @@ namespace DetourNavigator
         btVector3 aabbMin;
         btVector3 aabbMax;
 
-        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+        getTileLocalAabb(shape, transform, mBounds, aabbMin, aabbMax);
 
         const btVector3 boundsMin(mBounds.mMin.x(), mBounds.mMin.y(),
             -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
@@ -305,26 +329,10 @@ namespace DetourNavigator
     void RecastMeshBuilder::addObject(
         const btHeightfieldTerrainShape& shape, const btTransform& transform, btTriangleCallback&& callback)
     {
-        using BulletHelpers::transformBoundingBox;
-
         btVector3 aabbMin;
         btVector3 aabbMax;
 
-        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
-
-        transformBoundingBox(transform, aabbMin, aabbMax);
-
-        aabbMin.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMin.x()));
-        aabbMin.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMin.x()));
-        aabbMin.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMin.y()));
-        aabbMin.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMin.y()));
-
-        aabbMax.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMax.x()));
-        aabbMax.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMax.x()));
-        aabbMax.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMax.y()));
-        aabbMax.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMax.y()));
-
-        transformBoundingBox(transform.inverse(), aabbMin, aabbMax);
+        getTileLocalAabb(shape, transform, mBounds, aabbMin, aabbMax);
 
         auto wrapper = makeProcessTriangleCallback([&](btVector3* triangle, int partId, int triangleIndex) {
             std::array<btVector3, 3> transformed;
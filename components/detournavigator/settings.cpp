@@ -105,6 +105,13 @@ namespace DetourNavigator
         result.mEnableNavMeshDiskCache = ::Settings::navigator().mEnableNavMeshDiskCache;
         result.mWriteToNavMeshDb = ::Settings::navigator().mWriteToNavmeshdb;
         result.mMaxDbFileSize = ::Settings::navigator().mMaxNavmeshdbFileSize;
+        result.mMaxDbTransactionWrites
+            = static_cast<std::size_t>(::Settings::navigator().mMaxNavmeshdbTransactionWrites.get());
+        result.mMaxDbTransactionDuration
+            = std::chrono::milliseconds(::Settings::navigator().mMaxNavmeshdbTransactionDurationMs);
+        result.mJobPriorityLeadTime = std::chrono::milliseconds(::Settings::navigator().mJobPriorityLeadTimeMs);
+        result.mMaxPathCacheSize = static_cast<std::size_t>(::Settings::navigator().mMaxPathCacheSize.get());
+        result.mAgentBoundsStep = ::Settings::navigator().mAgentBoundsStep;
 
         return result;
     }
@@ -51,6 +51,11 @@ namespace DetourNavigator
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
         std::uint64_t mMaxDbFileSize = 0;
+        std::size_t mMaxDbTransactionWrites = 1;
+        std::chrono::milliseconds mMaxDbTransactionDuration{ 0 };
+        std::chrono::milliseconds mJobPriorityLeadTime{ 0 };
+        std::size_t mMaxPathCacheSize = 0;
+        float mAgentBoundsStep = 0;
     };
 
     inline constexpr std::int64_t navMeshFormatVersion = 2;
@@ -24,6 +24,12 @@ namespace DetourNavigator
 
                 out.setAttribute(frameNumber, "NavMesh DbCache Get", static_cast<double>(stats.mDb->mGetTileCount));
                 out.setAttribute(frameNumber, "NavMesh DbCache Hit", static_cast<double>(stats.mDbGetTileHits));
+                out.setAttribute(
+                    frameNumber, "NavMesh DbCache Direct Get", static_cast<double>(stats.mDbDirectGetTileCount));
+                if (stats.mDbDirectGetTileCount > 0)
+                    out.setAttribute(frameNumber, "NavMesh DbCache Direct Latency",
+                        std::chrono::duration<double, std::milli>(stats.mDbDirectGetTileDuration).count()
+                            / static_cast<double>(stats.mDbDirectGetTileCount));
             }
 
             out.setAttribute(frameNumber, "NavMesh CacheSize", static_cast<double>(stats.mCache.mNavMeshCacheSize));
@@ -46,5 +52,9 @@ namespace DetourNavigator
     {
         reportStats(stats.mUpdater, frameNumber, out);
         reportStats(stats.mRecast, frameNumber, out);
+        out.setAttribute(
+            frameNumber, "NavMesh Path MissingTiles", static_cast<double>(stats.mMissingTilePathQueries));
+        out.setAttribute(frameNumber, "NavMesh NavMeshes", static_cast<double>(stats.mNavMeshes));
+        out.setAttribute(frameNumber, "NavMesh NavMesh Tiles", static_cast<double>(stats.mNavMeshTiles));
     }
 }
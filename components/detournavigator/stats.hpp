@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -46,6 +47,9 @@ namespace DetourNavigator
         std::size_t mPushed = 0;
         std::size_t mProcessing = 0;
         std::size_t mDbGetTileHits = 0;
+        // Reads by the updater threads over their own connections, bypassing DbWorker
+        std::size_t mDbDirectGetTileCount = 0;
+        std::chrono::nanoseconds mDbDirectGetTileDuration{ 0 };
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
     };
@@ -62,6 +66,9 @@ namespace DetourNavigator
     {
         AsyncNavMeshUpdaterStats mUpdater;
         TileCachedRecastMeshManagerStats mRecast;
+        std::size_t mMissingTilePathQueries = 0;
+        std::size_t mNavMeshes = 0;
+        std::size_t mNavMeshTiles = 0;
     };
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out);
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_ESM_ESMBRIDGE
 #define COMPONENTS_ESM_ESMBRIDGE
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -52,17 +53,69 @@ namespace ESM
         friend VisitReturnType<F, T...> visit(F&& f, T&&... v);
     };
 
+    // Keeps a large value on the heap, so that a variant holding it is not larger than its other alternatives.
+    // Converts to a reference to the value to work with the visitors of the value type.
+    template <class T>
+    class Boxed
+    {
+    public:
+        explicit Boxed(const T& value)
+            : mValue(std::make_unique<T>(value))
+        {
+        }
+
+        Boxed(const Boxed& other)
+            : Boxed(*other.mValue)
+        {
+        }
+
+        Boxed(Boxed&& other) noexcept = default;
+
+        Boxed& operator=(const Boxed& other)
+        {
+            mValue = std::make_unique<T>(*other.mValue);
+            return *this;
+        }
+
+        Boxed& operator=(Boxed&& other) noexcept = default;
+
+        operator T&() { return *mValue; }
+        operator const T&() const { return *mValue; }
+
+    private:
+        std::unique_ptr<T> mValue;
+    };
+
+    template <class T>
+    T& unbox(T& value)
+    {
+        return value;
+    }
+
+    template <class T>
+    T& unbox(Boxed<T>& value)
+    {
+        return value;
+    }
+
+    template <class T>
+    const T& unbox(const Boxed<T>& value)
+    {
+        return value;
+    }
+
     struct ReferenceVariant
     {
-        std::variant<ESM::CellRef, ESM4::Reference, ESM4::ActorCharacter> mVariant;
+        // Most of the references are ESM3 ones, the larger ESM4 ones are boxed to not make all of them take their size
+        std::variant<ESM::CellRef, Boxed<ESM4::Reference>, Boxed<ESM4::ActorCharacter>> mVariant;
 
         explicit ReferenceVariant(const ESM4::Reference& ref)
-            : mVariant(ref)
+            : mVariant(Boxed<ESM4::Reference>(ref))
         {
         }
 
         explicit ReferenceVariant(const ESM4::ActorCharacter& ref)
-            : mVariant(ref)
+            : mVariant(Boxed<ESM4::ActorCharacter>(ref))
         {
         }
 
@@ -1,15 +1,16 @@
 #include "stringrefid.hpp"
 #include "serializerefid.hpp"
 
+#include <array>
+#include <atomic>
 #include <charconv>
 #include <iomanip>
-#include <mutex>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <system_error>
-#include <unordered_set>
+#include <utility>
 
-#include "components/misc/guarded.hpp"
 #include "components/misc/strings/algorithm.hpp"
 #include "components/misc/utf8stream.hpp"
 
@@ -17,23 +18,81 @@ namespace ESM
 {
     namespace
     {
-        using StringsSet = std::unordered_set<std::string, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
+        using Entry = StringRefId::Entry;
 
-        const std::string emptyString;
+        const Entry emptyEntry{ std::string(), Misc::StringUtils::CiHash{}(std::string_view()), 0, nullptr };
 
-        Misc::ScopeGuarded<StringsSet>& getRefIds()
+        const Entry* findEntry(const Entry* begin, const Entry* end, std::string_view value, std::size_t hash)
         {
-            static Misc::ScopeGuarded<StringsSet> refIds;
-            return refIds;
+            for (const Entry* entry = begin; entry != end; entry = entry->mNext)
+                if (entry->mHash == hash && Misc::StringUtils::ciEqual(entry->mValue, value))
+                    return entry;
+            return nullptr;
         }
 
-        Misc::NotNullPtr<const std::string> getOrInsertString(std::string_view id)
+        // Hash table with a fixed number of buckets holding lists of entries. Entries are never removed and are
+        // only added to the front of the lists, so the lookups don't need any locks.
+        class StringTable
+        {
+        public:
+            StringTable() = default;
+
+            StringTable(const StringTable&) = delete;
+
+            ~StringTable()
+            {
+                for (std::atomic<const Entry*>& bucket : mBuckets)
+                {
+                    const Entry* entry = bucket.load(std::memory_order_relaxed);
+                    while (entry != nullptr)
+                        delete std::exchange(entry, entry->mNext);
+                }
+            }
+
+            const Entry* find(std::string_view value) const
+            {
+                const std::size_t hash = Misc::StringUtils::CiHash{}(value);
+                return findEntry(getBucket(hash).load(std::memory_order_acquire), nullptr, value, hash);
+            }
+
+            const Entry* insert(std::string_view value)
+            {
+                const std::size_t hash = Misc::StringUtils::CiHash{}(value);
+                std::atomic<const Entry*>& bucket = getBucket(hash);
+                const Entry* head = bucket.load(std::memory_order_acquire);
+                if (const Entry* existing = findEntry(head, nullptr, value, hash))
+                    return existing;
+                auto entry = std::make_unique<Entry>(Entry{ std::string(value), hash,
+                    mNextIndex.fetch_add(1, std::memory_order_relaxed), head });
+                while (!bucket.compare_exchange_weak(
+                    entry->mNext, entry.get(), std::memory_order_release, std::memory_order_acquire))
+                {
+                    // Check the entries added by other threads since the list was read last time
+                    if (const Entry* existing = findEntry(entry->mNext, head, value, hash))
+                        return existing;
+                    head = entry->mNext;
+                }
+                return entry.release();
+            }
+
+        private:
+            static constexpr std::size_t sBucketsCount = 1 << 16;
+
+            std::atomic<const Entry*>& getBucket(std::size_t hash) { return mBuckets[hash % sBucketsCount]; }
+
+            const std::atomic<const Entry*>& getBucket(std::size_t hash) const
+            {
+                return mBuckets[hash % sBucketsCount];
+            }
+
+            std::array<std::atomic<const Entry*>, sBucketsCount> mBuckets{};
+            std::atomic<std::uint32_t> mNextIndex{ 1 };
+        };
+
+        StringTable& getRefIds()
         {
-            const auto locked = getRefIds().lock();
-            auto it = locked->find(id);
-            if (it == locked->end())
-                it = locked->emplace(id).first;
-            return &*it;
+            static StringTable refIds;
+            return refIds;
         }
 
         void addHex(unsigned char value, std::string& result)
@@ -50,33 +109,35 @@ namespace ESM
     }
 
     StringRefId::StringRefId()
-        : mValue(&emptyString)
+        : mEntry(&emptyEntry)
     {
     }
 
     StringRefId::StringRefId(std::string_view value)
-        : mValue(getOrInsertString(value))
+        : mEntry(getRefIds().insert(value))
     {
     }
 
     bool StringRefId::operator==(std::string_view rhs) const noexcept
     {
-        return Misc::StringUtils::ciEqual(*mValue, rhs);
+        return Misc::StringUtils::ciEqual(mEntry->mValue, rhs);
     }
 
     bool StringRefId::operator<(StringRefId rhs) const noexcept
     {
-        return Misc::StringUtils::ciLess(*mValue, *rhs.mValue);
+        if (mEntry == rhs.mEntry)
+            return false;
+        return Misc::StringUtils::ciLess(mEntry->mValue, rhs.mEntry->mValue);
     }
 
     bool operator<(StringRefId lhs, std::string_view rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(*lhs.mValue, rhs);
+        return Misc::StringUtils::ciLess(lhs.mEntry->mValue, rhs);
     }
 
     bool operator<(std::string_view lhs, StringRefId rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(lhs, *rhs.mValue);
+        return Misc::StringUtils::ciLess(lhs, rhs.mEntry->mValue);
     }
 
     std::ostream& operator<<(std::ostream& stream, StringRefId value)
@@ -87,10 +148,11 @@ namespace ESM
     std::string StringRefId::toDebugString() const
     {
         std::string result;
-        result.reserve(2 + mValue->size());
+        result.reserve(2 + mEntry->mValue.size());
         result.push_back('"');
-        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(mValue->data());
-        const unsigned char* const end = reinterpret_cast<const unsigned char*>(mValue->data() + mValue->size());
+        const std::string& value = mEntry->mValue;
+        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(value.data());
+        const unsigned char* const end = reinterpret_cast<const unsigned char*>(value.data() + value.size());
         while (ptr != end)
         {
             if (Utf8Stream::isAscii(*ptr))
@@ -122,27 +184,26 @@ namespace ESM
 
     bool StringRefId::startsWith(std::string_view prefix) const
     {
-        return Misc::StringUtils::ciStartsWith(*mValue, prefix);
+        return Misc::StringUtils::ciStartsWith(mEntry->mValue, prefix);
     }
 
     bool StringRefId::endsWith(std::string_view suffix) const
     {
-        return Misc::StringUtils::ciEndsWith(*mValue, suffix);
+        return Misc::StringUtils::ciEndsWith(mEntry->mValue, suffix);
     }
 
     bool StringRefId::contains(std::string_view subString) const
     {
-        return Misc::StringUtils::ciFind(*mValue, subString) != std::string_view::npos;
+        return Misc::StringUtils::ciFind(mEntry->mValue, subString) != std::string_view::npos;
     }
 
     std::optional<StringRefId> StringRefId::deserializeExisting(std::string_view value)
     {
-        const auto locked = getRefIds().lock();
-        auto it = locked->find(value);
-        if (it == locked->end())
+        const Entry* const entry = getRefIds().find(value);
+        if (entry == nullptr)
             return {};
         StringRefId id;
-        id.mValue = &*it;
+        id.mEntry = entry;
         return id;
     }
 }
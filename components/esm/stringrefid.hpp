@@ -1,6 +1,8 @@
 #ifndef OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 #define OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <optional>
@@ -17,12 +19,16 @@ namespace ESM
     public:
         StringRefId();
 
-        // Constructs StringRefId from string using pointer to a static set of strings.
+        // Constructs StringRefId from string using pointer to a static set of strings. Thread safe, doesn't lock
+        // when the string is already there.
         explicit StringRefId(std::string_view value);
 
-        const std::string& getValue() const { return *mValue; }
+        const std::string& getValue() const { return mEntry->mValue; }
 
-        std::string toString() const { return *mValue; }
+        // Unique number of the string in the static set, the default constructed value has 0
+        std::uint32_t getIndex() const { return mEntry->mIndex; }
+
+        std::string toString() const { return mEntry->mValue; }
 
         std::string toDebugString() const;
 
@@ -32,7 +38,7 @@ namespace ESM
 
         bool contains(std::string_view subString) const;
 
-        bool operator==(StringRefId rhs) const noexcept { return mValue == rhs.mValue; }
+        bool operator==(StringRefId rhs) const noexcept { return mEntry == rhs.mEntry; }
 
         bool operator==(std::string_view rhs) const noexcept;
 
@@ -50,8 +56,17 @@ namespace ESM
         // Similar to the constructor but only returns preexisting ids
         static std::optional<StringRefId> deserializeExisting(std::string_view value);
 
+        struct Entry
+        {
+            std::string mValue;
+            // Case insensitive hash of the value
+            std::size_t mHash;
+            std::uint32_t mIndex;
+            const Entry* mNext;
+        };
+
     private:
-        Misc::NotNullPtr<const std::string> mValue;
+        Misc::NotNullPtr<const Entry> mEntry;
     };
 }
 
@@ -62,7 +77,7 @@ namespace std
     {
         std::size_t operator()(ESM::StringRefId value) const noexcept
         {
-            return std::hash<const std::string*>{}(value.mValue);
+            return value.mEntry->mHash;
         }
     };
 }
@@ -47,16 +47,16 @@ namespace ESM
         template <bool load>
         void loadDataImpl(ESMReader& esm, bool& isDeleted, CellRef& cellRef)
         {
-            const auto getRefIdOrSkip = [&](ESM::RefId& refId) {
+            const auto getRefIdOrSkip = [&](void (CellRef::*setter)(const ESM::RefId&)) {
                 if constexpr (load)
-                    refId = esm.getRefId();
+                    (cellRef.*setter)(esm.getRefId());
                 else
                     esm.skipHRefId();
             };
 
-            const auto getHStringOrSkip = [&](std::string& value) {
+            const auto getHStringOrSkip = [&](void (CellRef::*setter)(const std::string&)) {
                 if constexpr (load)
-                    value = esm.getHString();
+                    (cellRef.*setter)(esm.getHString());
                 else
                     esm.skipHString();
             };
@@ -86,20 +86,25 @@ namespace ESM
                             cellRef.mScale = std::clamp(cellRef.mScale, 0.5f, 2.0f);
                         break;
                     case fourCC("ANAM"):
-                        getRefIdOrSkip(cellRef.mOwner);
+                        getRefIdOrSkip(&CellRef::setOwner);
                         break;
                     case fourCC("BNAM"):
-                        getHStringOrSkip(cellRef.mGlobalVariable);
+                        getHStringOrSkip(&CellRef::setGlobalVariable);
                         break;
                     case fourCC("XSOL"):
-                        getRefIdOrSkip(cellRef.mSoul);
+                        getRefIdOrSkip(&CellRef::setSoul);
                         break;
                     case fourCC("CNAM"):
-                        getRefIdOrSkip(cellRef.mFaction);
+                        getRefIdOrSkip(&CellRef::setFaction);
                         break;
                     case fourCC("INDX"):
-                        getHTOrSkip(cellRef.mFactionRank);
+                    {
+                        int32_t factionRank = 0;
+                        getHTOrSkip(factionRank);
+                        if constexpr (load)
+                            cellRef.setFactionRank(factionRank);
                         break;
+                    }
                     case fourCC("XCHG"):
                         getHTOrSkip(cellRef.mEnchantmentCharge);
                         break;
@@ -112,23 +117,25 @@ namespace ESM
                     case fourCC("DODT"):
                         if constexpr (load)
                         {
-                            esm.getSubComposite(cellRef.mDoorDest);
-                            cellRef.mTeleport = true;
+                            Position doorDest;
+                            esm.getSubComposite(doorDest);
+                            cellRef.setDoorDest(doorDest);
+                            cellRef.setTeleport(true);
                         }
                         else
                             esm.skipHSub();
                         break;
                     case fourCC("DNAM"):
-                        getHStringOrSkip(cellRef.mDestCell);
+                        getHStringOrSkip(&CellRef::setDestCell);
                         break;
                     case fourCC("FLTV"):
                         getHTOrSkip(cellRef.mLockLevel);
                         break;
                     case fourCC("KNAM"):
-                        getRefIdOrSkip(cellRef.mKey);
+                        getRefIdOrSkip(&CellRef::setKey);
                         break;
                     case fourCC("TNAM"):
-                        getRefIdOrSkip(cellRef.mTrap);
+                        getRefIdOrSkip(&CellRef::setTrap);
                         break;
                     case fourCC("DATA"):
                         if constexpr (load)
@@ -156,7 +163,7 @@ namespace ESM
             if constexpr (load)
             {
                 if (esm.getFormatVersion() == DefaultFormatVersion) // loading a content file
-                    cellRef.mIsLocked = !cellRef.mKey.empty() || cellRef.mLockLevel > 0;
+                    cellRef.mIsLocked = !cellRef.getKey().empty() || cellRef.mLockLevel > 0;
                 else
                     cellRef.mIsLocked = cellRef.mLockLevel > 0;
                 if (cellRef.mLockLevel == ZeroLock)
@@ -165,6 +172,31 @@ namespace ESM
         }
     }
 
+    const CellRef::Extra CellRef::sDefaultExtra{};
+
+    CellRef::CellRef(const CellRef& other)
+        : mRefNum(other.mRefNum)
+        , mRefID(other.mRefID)
+        , mScale(other.mScale)
+        , mChargeInt(other.mChargeInt)
+        , mChargeIntRemainder(other.mChargeIntRemainder)
+        , mEnchantmentCharge(other.mEnchantmentCharge)
+        , mCount(other.mCount)
+        , mLockLevel(other.mLockLevel)
+        , mIsLocked(other.mIsLocked)
+        , mReferenceBlocked(other.mReferenceBlocked)
+        , mPos(other.mPos)
+        , mExtra(other.mExtra != nullptr ? std::make_unique<Extra>(*other.mExtra) : nullptr)
+    {
+    }
+
+    CellRef& CellRef::operator=(const CellRef& other)
+    {
+        if (this != &other)
+            *this = CellRef(other);
+        return *this;
+    }
+
     void CellRef::load(ESMReader& esm, bool& isDeleted, bool wideRefNum)
     {
         loadId(esm, wideRefNum);
@@ -198,18 +230,20 @@ namespace ESM
             esm.writeHNT("XSCL", std::clamp(mScale, 0.5f, 2.0f));
         }
 
+        const Extra& extra = getExtra();
+
         if (!inInventory)
-            esm.writeHNOCRefId("ANAM", mOwner);
+            esm.writeHNOCRefId("ANAM", extra.mOwner);
 
-        esm.writeHNOCString("BNAM", mGlobalVariable);
-        esm.writeHNOCRefId("XSOL", mSoul);
+        esm.writeHNOCString("BNAM", extra.mGlobalVariable);
+        esm.writeHNOCRefId("XSOL", extra.mSoul);
 
         if (!inInventory)
         {
-            esm.writeHNOCRefId("CNAM", mFaction);
-            if (mFactionRank != -2)
+            esm.writeHNOCRefId("CNAM", extra.mFaction);
+            if (extra.mFactionRank != -2)
             {
-                esm.writeHNT("INDX", mFactionRank);
+                esm.writeHNT("INDX", extra.mFactionRank);
             }
         }
 
@@ -222,10 +256,10 @@ namespace ESM
         if (mCount != 1)
             esm.writeHNT("NAM9", mCount);
 
-        if (!inInventory && mTeleport)
+        if (!inInventory && extra.mTeleport)
         {
-            esm.writeNamedComposite("DODT", mDoorDest);
-            esm.writeHNOCString("DNAM", mDestCell);
+            esm.writeNamedComposite("DODT", extra.mDoorDest);
+            esm.writeHNOCString("DNAM", extra.mDestCell);
         }
 
         if (!inInventory)
@@ -236,9 +270,9 @@ namespace ESM
                 if (lockLevel == 0)
                     lockLevel = ZeroLock;
                 esm.writeHNT("FLTV", lockLevel);
-                esm.writeHNOCRefId("KNAM", mKey);
+                esm.writeHNOCRefId("KNAM", extra.mKey);
             }
-            esm.writeHNOCRefId("TNAM", mTrap);
+            esm.writeHNOCRefId("TNAM", extra.mTrap);
         }
 
         if (mReferenceBlocked != -1)
@@ -253,27 +287,17 @@ namespace ESM
         mRefNum = RefNum{};
         mRefID = ESM::RefId();
         mScale = 1;
-        mOwner = ESM::RefId();
-        mGlobalVariable.clear();
-        mSoul = ESM::RefId();
-        mFaction = ESM::RefId();
-        mFactionRank = -2;
         mChargeInt = -1;
         mChargeIntRemainder = 0.0f;
         mEnchantmentCharge = -1;
         mCount = 1;
-        mDestCell.clear();
         mLockLevel = 0;
         mIsLocked = false;
-        mKey = ESM::RefId();
-        mTrap = ESM::RefId();
         mReferenceBlocked = -1;
-        mTeleport = false;
+        mExtra.reset();
 
         for (int i = 0; i < 3; ++i)
         {
-            mDoorDest.pos[i] = 0;
-            mDoorDest.rot[i] = 0;
             mPos.pos[i] = 0;
             mPos.rot[i] = 0;
         }
@@ -2,6 +2,7 @@
 #define OPENMW_ESM_CELLREF_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include <components/esm/defs.hpp>
@@ -26,31 +27,53 @@ namespace ESM
     public:
         static constexpr std::string_view getRecordType() { return "CellRef"; }
 
-        // Reference number
-        // Note: Currently unused for items in containers
-        RefNum mRefNum;
+        // Fields only a few of the references have, allocated when any of them is set to a non-default value
+        struct Extra
+        {
+            // The NPC that owns this object (and will get angry if you steal it)
+            ESM::RefId mOwner;
 
-        ESM::RefId mRefID; // ID of object being referenced
+            // Name of a global variable. If the global variable is set to '1', using the object is temporarily
+            // allowed even if it has an Owner field.
+            // Used by bed rent scripts to allow the player to use the bed for the duration of the rent.
+            std::string mGlobalVariable;
 
-        float mScale; // Scale applied to mesh
+            // ID of creature trapped in this soul gem
+            ESM::RefId mSoul;
+
+            // The faction that owns this object (and will get angry if
+            // you take it and are not a faction member)
+            ESM::RefId mFaction;
+
+            // PC faction rank required to use the item. Sometimes is -1, which means "any rank".
+            int32_t mFactionRank = -2;
+
+            // For doors - true if this door teleports to somewhere else, false
+            // if it should open through animation.
+            bool mTeleport = false;
 
-        // The NPC that owns this object (and will get angry if you steal it)
-        ESM::RefId mOwner;
+            // Teleport location for the door, if this is a teleporting door.
+            Position mDoorDest{};
 
-        // Name of a global variable. If the global variable is set to '1', using the object is temporarily allowed
-        // even if it has an Owner field.
-        // Used by bed rent scripts to allow the player to use the bed for the duration of the rent.
-        std::string mGlobalVariable;
+            // Destination cell for doors (optional)
+            std::string mDestCell;
 
-        // ID of creature trapped in this soul gem
-        ESM::RefId mSoul;
+            ESM::RefId mKey, mTrap; // Key and trap ID names, if any
+        };
 
-        // The faction that owns this object (and will get angry if
-        // you take it and are not a faction member)
-        ESM::RefId mFaction;
+        CellRef() = default;
+        CellRef(const CellRef& other);
+        CellRef(CellRef&& other) noexcept = default;
+        CellRef& operator=(const CellRef& other);
+        CellRef& operator=(CellRef&& other) noexcept = default;
 
-        // PC faction rank required to use the item. Sometimes is -1, which means "any rank".
-        int32_t mFactionRank;
+        // Reference number
+        // Note: Currently unused for items in containers
+        RefNum mRefNum;
+
+        ESM::RefId mRefID; // ID of object being referenced
+
+        float mScale; // Scale applied to mesh
 
         // For weapon or armor, this is the remaining item health.
         // For tools (lockpicks, probes, repair hammer) it is the remaining uses.
@@ -68,20 +91,9 @@ namespace ESM
 
         int32_t mCount;
 
-        // For doors - true if this door teleports to somewhere else, false
-        // if it should open through animation.
-        bool mTeleport;
-
-        // Teleport location for the door, if this is a teleporting door.
-        Position mDoorDest;
-
-        // Destination cell for doors (optional)
-        std::string mDestCell;
-
         // Lock level for doors and containers
         int32_t mLockLevel;
         bool mIsLocked{};
-        ESM::RefId mKey, mTrap; // Key and trap ID names, if any
 
         // This corresponds to the "Reference Blocked" checkbox in the construction set,
         // which prevents editing that reference.
@@ -102,6 +114,57 @@ namespace ESM
         void save(ESMWriter& esm, bool wideRefNum = false, bool inInventory = false, bool isDeleted = false) const;
 
         void blank();
+
+        const ESM::RefId& getOwner() const { return getExtra().mOwner; }
+        void setOwner(const ESM::RefId& value) { setExtra(&Extra::mOwner, value); }
+
+        const std::string& getGlobalVariable() const { return getExtra().mGlobalVariable; }
+        void setGlobalVariable(const std::string& value) { setExtra(&Extra::mGlobalVariable, value); }
+
+        const ESM::RefId& getSoul() const { return getExtra().mSoul; }
+        void setSoul(const ESM::RefId& value) { setExtra(&Extra::mSoul, value); }
+
+        const ESM::RefId& getFaction() const { return getExtra().mFaction; }
+        void setFaction(const ESM::RefId& value) { setExtra(&Extra::mFaction, value); }
+
+        int32_t getFactionRank() const { return getExtra().mFactionRank; }
+        void setFactionRank(int32_t value) { setExtra(&Extra::mFactionRank, value); }
+
+        bool getTeleport() const { return getExtra().mTeleport; }
+        void setTeleport(bool value) { setExtra(&Extra::mTeleport, value); }
+
+        const Position& getDoorDest() const { return getExtra().mDoorDest; }
+        void setDoorDest(const Position& value) { setExtra(&Extra::mDoorDest, value); }
+
+        const std::string& getDestCell() const { return getExtra().mDestCell; }
+        void setDestCell(const std::string& value) { setExtra(&Extra::mDestCell, value); }
+
+        const ESM::RefId& getKey() const { return getExtra().mKey; }
+        void setKey(const ESM::RefId& value) { setExtra(&Extra::mKey, value); }
+
+        const ESM::RefId& getTrap() const { return getExtra().mTrap; }
+        void setTrap(const ESM::RefId& value) { setExtra(&Extra::mTrap, value); }
+
+        bool hasExtra() const { return mExtra != nullptr; }
+
+    private:
+        static const Extra sDefaultExtra;
+
+        std::unique_ptr<Extra> mExtra;
+
+        const Extra& getExtra() const { return mExtra != nullptr ? *mExtra : sDefaultExtra; }
+
+        template <class T>
+        void setExtra(T Extra::*field, const T& value)
+        {
+            if (mExtra == nullptr)
+            {
+                if (value == sDefaultExtra.*field)
+                    return;
+                mExtra = std::make_unique<Extra>();
+            }
+            (*mExtra).*field = value;
+        }
     };
 
     void skipLoadCellRef(ESMReader& esm, bool wideRefNum = false);
@@ -19,7 +19,7 @@ namespace ESM
     ESM_Context ESMReader::getContext()
     {
         // Update the file position before returning
-        mCtx.filePos = mEsm->tellg();
+        mCtx.filePos = getFileOffset();
         return mCtx;
     }
 
@@ -43,11 +43,16 @@ namespace ESM
         mCtx = rc;
 
         // Make sure we seek to the right place
+        mRecordBuffered = false;
         mEsm->seekg(mCtx.filePos);
+
+        if (mBufferRecords && mCtx.leftRec > 0)
+            bufferRecord(mCtx.filePos, static_cast<std::size_t>(mCtx.leftRec));
     }
 
     void ESMReader::close()
     {
+        mRecordBuffered = false;
         mEsm.reset();
         clearCtx();
         mHeader.blank();
@@ -132,6 +137,22 @@ namespace ESM
         openRaw(Files::openBinaryInputFileStream(filename), filename);
     }
 
+    void ESMReader::openRecordData(
+        std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name, FormatVersion version)
+    {
+        openRaw(std::move(stream), name);
+        mHeader.mFormatVersion = version;
+        mCtx.leftRec = mCtx.leftFile;
+        mCtx.leftFile = 0;
+    }
+
+    void ESMReader::openAt(std::unique_ptr<std::istream>&& stream, const Header& header, const ESM_Context& context)
+    {
+        openRaw(std::move(stream), context.filename);
+        mHeader = header;
+        restoreContext(context);
+    }
+
     void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
     {
         openRaw(std::move(stream), name);
@@ -198,7 +219,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+        if (mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -227,8 +248,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mHeader.mFormatVersion <= MaxStringRefIdFormatVersion && mCtx.leftSub == 0 && hasMoreSubs()
-            && !mEsm->peek())
+        if (mHeader.mFormatVersion <= MaxStringRefIdFormatVersion && mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -350,6 +370,8 @@ namespace ESM
         if (hasMoreSubs())
             fail("Previous record contains unread bytes");
 
+        leaveRecordBuffer();
+
         // We went out of the previous record's bounds. Backtrack.
         if (mCtx.leftRec < 0)
             mEsm->seekg(mCtx.leftRec, std::ios::cur);
@@ -372,6 +394,21 @@ namespace ESM
         mCtx.subCached = false;
     }
 
+    std::vector<char> ESMReader::getRecordData()
+    {
+        std::vector<char> result;
+        if (mCtx.subCached)
+        {
+            result.assign(std::begin(mCtx.subName.mData), std::end(mCtx.subName.mData));
+            mCtx.subCached = false;
+        }
+        const std::size_t offset = result.size();
+        result.resize(offset + static_cast<std::size_t>(mCtx.leftRec));
+        getExact(result.data() + offset, static_cast<std::size_t>(mCtx.leftRec));
+        mCtx.leftRec = 0;
+        return result;
+    }
+
     void ESMReader::getRecHeader(uint32_t& flags)
     {
         if (mCtx.leftFile < static_cast<std::streamsize>(3 * sizeof(uint32_t)))
@@ -390,6 +427,46 @@ namespace ESM
 
         // Adjust number of bytes mCtx.left in file
         mCtx.leftFile -= mCtx.leftRec;
+
+        if (mBufferRecords && mCtx.leftRec > 0)
+        {
+            // The sizes of all the records before are accounted for in leftFile
+            const std::size_t size = static_cast<std::size_t>(mCtx.leftRec);
+            bufferRecord(mFileSize - static_cast<std::size_t>(mCtx.leftFile) - size, size);
+        }
+    }
+
+    void ESMReader::bufferRecord(std::size_t offset, std::size_t size)
+    {
+        mRecordBuffer.resize(size);
+        mEsm->read(mRecordBuffer.data(), static_cast<std::streamsize>(size));
+        if (mEsm->gcount() != static_cast<std::streamsize>(size))
+        {
+            // Truncated file, keep reading from the stream to fail the same way
+            mEsm->clear();
+            mEsm->seekg(offset);
+            return;
+        }
+        mRecordBufferOffset = offset;
+        mRecordBufferPos = 0;
+        mRecordBuffered = true;
+    }
+
+    void ESMReader::leaveRecordBuffer()
+    {
+        if (!mRecordBuffered)
+            return;
+        mRecordBuffered = false;
+        if (mRecordBufferPos != mRecordBuffer.size())
+            mEsm->seekg(mRecordBufferOffset + mRecordBufferPos);
+    }
+
+    int ESMReader::peek()
+    {
+        if (mRecordBuffered && mRecordBufferPos < mRecordBuffer.size())
+            return static_cast<unsigned char>(mRecordBuffer[mRecordBufferPos]);
+        leaveRecordBuffer();
+        return mEsm->peek();
     }
 
     /*************************************************************************
@@ -422,6 +499,19 @@ namespace ESM
 
     std::string_view ESMReader::getStringView(std::size_t size)
     {
+        if (mRecordBuffered && size <= mRecordBuffer.size() - mRecordBufferPos)
+        {
+            // Use the string in place, it is valid until the next record is read
+            const char* const ptr = mRecordBuffer.data() + mRecordBufferPos;
+            mRecordBufferPos += size;
+            size = strnlen(ptr, size);
+
+            if (mEncoder != nullptr)
+                return mEncoder->getUtf8(std::string_view(ptr, size));
+
+            return std::string_view(ptr, size);
+        }
+
         if (mBuffer.size() <= size)
             // Add some extra padding to reduce the chance of having to resize
             // again later.
@@ -523,7 +613,7 @@ namespace ESM
         ss << "\n  Record: " << mCtx.recName.toStringView();
         ss << "\n  Subrecord: " << mCtx.subName.toStringView();
         if (mEsm.get())
-            ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+            ss << "\n  Offset: 0x" << std::hex << getFileOffset();
         throw std::runtime_error(ss.str());
     }
 
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <istream>
 #include <map>
@@ -99,8 +100,25 @@ namespace ESM
 
         void openRaw(const std::filesystem::path& filename);
 
+        /// Opens a file of which the header was read by another reader already and continues at the given context.
+        void openAt(std::unique_ptr<std::istream>&& stream, const Header& header, const ESM_Context& context);
+
+        /// Opens the rest of a record returned by getRecordData, to be read as if it was the current record of a
+        /// file with the given format version.
+        void openRecordData(
+            std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name, FormatVersion version);
+
         /// Get the current position in the file. Make sure that the file has been opened!
-        size_t getFileOffset() const { return mEsm->tellg(); }
+        size_t getFileOffset() const
+        {
+            if (mRecordBuffered)
+                return mRecordBufferOffset + mRecordBufferPos;
+            return mEsm->tellg();
+        }
+
+        /// Read the body of every record into memory in getRecHeader() and parse the subrecords from there instead of
+        /// reading every field from the stream. Enabled by default, applies from the next record header.
+        void setBufferRecords(bool value) { mBufferRecords = value; }
 
         // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
         //  terrain palette, but ESMReader does not pass a reference to the correct plugin
@@ -118,7 +136,7 @@ namespace ESM
 
         // Used only when loading saves to adjust FormIds if load order was changes.
         void setContentFileMapping(const std::map<int, int>* mapping) { mContentFileMapping = mapping; }
-        const std::map<int, int>* getContentFileMapping();
+        const std::map<int, int>* getContentFileMapping() const { return mContentFileMapping; }
 
         // Returns false if content file not found.
         bool applyContentFileMapping(FormId& id);
@@ -292,6 +310,9 @@ namespace ESM
         // already been read
         void skipRecord();
 
+        // Read the rest of this record as is, including a cached subrecord name
+        std::vector<char> getRecordData();
+
         /* Read record header. This updatesleftFile BEYOND the data that
            follows the header, ie beyond the entire record. You should use
            leftRec to orient yourself inside the record itself.
@@ -322,6 +343,13 @@ namespace ESM
 
         void getExact(void* x, std::size_t size)
         {
+            if (mRecordBuffered && size <= mRecordBuffer.size() - mRecordBufferPos)
+            {
+                std::memcpy(x, mRecordBuffer.data() + mRecordBufferPos, size);
+                mRecordBufferPos += size;
+                return;
+            }
+            leaveRecordBuffer();
             mEsm->read(static_cast<char*>(x), static_cast<std::streamsize>(size));
         }
 
@@ -340,6 +368,12 @@ namespace ESM
 
         void skip(std::size_t bytes)
         {
+            if (mRecordBuffered && bytes <= mRecordBuffer.size() - mRecordBufferPos)
+            {
+                mRecordBufferPos += bytes;
+                return;
+            }
+            leaveRecordBuffer();
             char buffer[4096];
             if (bytes > std::size(buffer))
                 mEsm->seekg(getFileOffset() + bytes);
@@ -368,8 +402,25 @@ namespace ESM
 
         RefId getRefIdImpl(std::size_t size);
 
+        /// Read the record body starting at the given file offset into mRecordBuffer.
+        void bufferRecord(std::size_t offset, std::size_t size);
+
+        /// Continue reading from the stream at the current position in the buffered record. Needed when reading
+        /// across the end of a record, some files have subrecords which claim to be bigger than their record.
+        void leaveRecordBuffer();
+
+        int peek();
+
         std::unique_ptr<std::istream> mEsm;
 
+        // While mRecordBuffered is set the rest of the current record is read from mRecordBuffer, and the stream is
+        // positioned at the end of the record.
+        bool mBufferRecords = true;
+        bool mRecordBuffered = false;
+        std::vector<char> mRecordBuffer;
+        std::size_t mRecordBufferPos = 0;
+        std::size_t mRecordBufferOffset = 0;
+
         ESM_Context mCtx;
 
         uint32_t mRecordFlags;
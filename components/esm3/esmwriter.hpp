@@ -59,6 +59,10 @@ namespace ESM
         void save(std::ostream& file);
         ///< Start saving a file by writing the TES3 header.
 
+        void saveWithoutHeader(std::ostream& file);
+        ///< Start writing records to a stream without the TES3 header, e.g. to append them to a file saved by
+        /// another writer.
+
         void close();
         ///< \note Does not close the stream.
 
@@ -3,6 +3,9 @@
 #include "esmreader.hpp"
 #include "esmwriter.hpp"
 
+#include <algorithm>
+#include <string>
+
 #include <osgDB/ReadFile>
 
 #include <components/debug/debuglog.hpp>
@@ -12,48 +15,85 @@ namespace ESM
 {
     namespace
     {
-        void convertFogOfWar(std::vector<char>& imageData)
+        // Older formats stored the fog as an image with the texels in the alpha channel
+        void convertFogOfWar(std::vector<char>& imageData, const std::string& extension)
         {
             if (imageData.empty())
             {
                 return;
             }
 
-            osgDB::ReaderWriter* tgaReader = osgDB::Registry::instance()->getReaderWriterForExtension("tga");
-            if (!tgaReader)
+            osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(extension);
+            if (!reader)
             {
-                Log(Debug::Error) << "Error: Unable to load fog, can't find a tga ReaderWriter";
+                Log(Debug::Error) << "Error: Unable to load fog, can't find a " << extension << " ReaderWriter";
+                imageData.clear();
                 return;
             }
 
             Files::IMemStream in(imageData.data(), imageData.size());
 
-            osgDB::ReaderWriter::ReadResult result = tgaReader->readImage(in);
+            osgDB::ReaderWriter::ReadResult result = reader->readImage(in);
             if (!result.success())
             {
                 Log(Debug::Error) << "Error: Failed to read fog: " << result.message() << " code " << result.status();
+                imageData.clear();
                 return;
             }
 
-            osgDB::ReaderWriter* pngWriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-            if (!pngWriter)
+            osg::Image& image = *result.getImage();
+            if (image.getPixelFormat() != GL_RGBA || image.getDataType() != GL_UNSIGNED_BYTE)
             {
-                Log(Debug::Error) << "Error: Unable to write fog, can't find a png ReaderWriter";
+                Log(Debug::Error) << "Error: Failed to read fog: unsupported pixel format";
+                imageData.clear();
                 return;
             }
 
-            std::ostringstream ostream;
-            osgDB::ReaderWriter::WriteResult png = pngWriter->writeImage(*result.getImage(), ostream);
-            if (!png.success())
+            // The image was flipped before it was written
+            image.flipVertical();
+
+            std::vector<std::uint8_t> alpha;
+            alpha.reserve(static_cast<std::size_t>(image.s()) * image.t());
+            for (int row = 0; row < image.t(); ++row)
             {
-                Log(Debug::Error) << "Error: Unable to write fog: " << png.message() << " code " << png.status();
-                return;
+                const unsigned char* texel = image.data(0, row);
+                for (int column = 0; column < image.s(); ++column, texel += 4)
+                    alpha.push_back(texel[3]);
             }
 
-            std::string str = ostream.str();
-            imageData = std::vector<char>(str.begin(), str.end());
+            encodeFogOfWar(alpha, imageData);
+        }
+    }
+
+    void encodeFogOfWar(std::span<const std::uint8_t> alpha, std::vector<char>& out)
+    {
+        out.clear();
+        for (std::size_t i = 0; i < alpha.size();)
+        {
+            const std::uint8_t value = alpha[i];
+            std::size_t length = 1;
+            while (length < 255 && i + length < alpha.size() && alpha[i + length] == value)
+                ++length;
+            out.push_back(static_cast<char>(length));
+            out.push_back(static_cast<char>(value));
+            i += length;
         }
+    }
 
+    bool decodeFogOfWar(std::span<const char> data, std::span<std::uint8_t> alpha)
+    {
+        if (data.size() % 2 != 0)
+            return false;
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < data.size(); i += 2)
+        {
+            const std::size_t length = static_cast<std::uint8_t>(data[i]);
+            if (length == 0 || count + length > alpha.size())
+                return false;
+            std::fill_n(alpha.begin() + count, length, static_cast<std::uint8_t>(data[i + 1]));
+            count += length;
+        }
+        return count == alpha.size();
     }
 
     void FogState::load(ESMReader& esm)
@@ -75,7 +115,9 @@ namespace ESM
             esm.getExact(tex.mImageData.data(), imageSize);
 
             if (dataFormat <= MaxOldFogOfWarFormatVersion)
-                convertFogOfWar(tex.mImageData);
+                convertFogOfWar(tex.mImageData, "tga");
+            else if (dataFormat <= MaxPngFogOfWarFormatVersion)
+                convertFogOfWar(tex.mImageData, "png");
 
             mFogTextures.push_back(tex);
         }
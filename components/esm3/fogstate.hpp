@@ -2,6 +2,7 @@
 #define OPENMW_ESM_FOGSTATE_H
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace ESM
@@ -12,9 +13,16 @@ namespace ESM
     struct FogTexture
     {
         int32_t mX, mY; // Only used for interior cells
+        // Alpha of the texels as encoded by encodeFogOfWar
         std::vector<char> mImageData;
     };
 
+    // Run length encodes the alpha of the fog of war texels as pairs of run length and alpha bytes
+    void encodeFogOfWar(std::span<const std::uint8_t> alpha, std::vector<char>& out);
+
+    // @return false if the data doesn't decode to exactly alpha.size() texels
+    bool decodeFogOfWar(std::span<const char> data, std::span<std::uint8_t> alpha);
+
     // format 0, saved games only
     // Fog of war state
     struct FogState
@@ -0,0 +1,88 @@
+#include "sharedreaders.hpp"
+
+#include <components/esm/esmcommon.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/platform/file.hpp>
+
+namespace ESM
+{
+    struct SharedReaders::File
+    {
+        std::filesystem::path mPath;
+        Platform::File::MappedFile mMapping;
+        Header mHeader;
+
+        explicit File(const std::filesystem::path& path)
+            : mPath(path)
+            , mMapping(path)
+        {
+        }
+    };
+
+    namespace
+    {
+        /// Reads a mapped content file and keeps it mapped until the stream is destroyed.
+        template <class File>
+        class MappedFileStream : public Files::MemBuf, public std::istream
+        {
+        public:
+            explicit MappedFileStream(std::shared_ptr<const File> file)
+                : Files::MemBuf(file->mMapping.data(), file->mMapping.size())
+                , std::istream(static_cast<std::streambuf*>(this))
+                , mFile(std::move(file))
+            {
+            }
+
+        private:
+            std::shared_ptr<const File> mFile;
+        };
+    }
+
+    SharedReaders::Reader::Reader(SharedReaders& owner)
+        : mOwner(owner)
+    {
+        if (owner.mEncoder != nullptr)
+            mEncoder.emplace(*owner.mEncoder);
+        mReader.setEncoder(mEncoder.has_value() ? &*mEncoder : nullptr);
+    }
+
+    ESMReader& SharedReaders::Reader::restore(const ESM_Context& context)
+    {
+        if (mFile != nullptr && mFile->mPath == context.filename)
+        {
+            mReader.restoreContext(context);
+            return mReader;
+        }
+
+        mFile = mOwner.getFile(context.filename, mEncoder.has_value() ? &*mEncoder : nullptr);
+        mReader.openAt(std::make_unique<MappedFileStream<File>>(mFile), mFile->mHeader, context);
+        return mReader;
+    }
+
+    void SharedReaders::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mFiles.clear();
+    }
+
+    std::shared_ptr<const SharedReaders::File> SharedReaders::getFile(
+        const std::filesystem::path& path, ToUTF8::Utf8Encoder* encoder)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            const auto it = mFiles.find(path);
+            if (it != mFiles.end())
+                return it->second;
+        }
+
+        // Map and read the header without holding the lock, the first file added for the path is kept
+        auto file = std::make_shared<File>(path);
+        ESMReader reader;
+        reader.setEncoder(encoder);
+        reader.open(std::make_unique<Files::IMemStream>(file->mMapping.data(), file->mMapping.size()), path);
+        file->mHeader = reader.getHeader();
+
+        const std::lock_guard lock(mMutex);
+        return mFiles.emplace(path, std::move(file)).first->second;
+    }
+}
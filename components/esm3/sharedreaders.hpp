@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_ESM3_SHAREDREADERS_H
+#define OPENMW_COMPONENTS_ESM3_SHAREDREADERS_H
+
+#include "esmreader.hpp"
+
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace ESM
+{
+    struct ESM_Context;
+
+    /// @brief Content files to be read by any number of threads at the same time.
+    /// @note Each file is mapped into memory and its header is read once, on first use. The readers read the mapping
+    /// directly, so unlike with ReadersCache there is no limit of open files and there are no files to reopen.
+    class SharedReaders
+    {
+        struct File;
+
+    public:
+        /// @brief Reader to be used by one thread, can be restored to any context of any content file.
+        class Reader
+        {
+        public:
+            explicit Reader(SharedReaders& owner);
+
+            /// Position the reader at the context, maps the file if it is read for the first time.
+            /// @throw std::runtime_error or std::system_error when the file can not be mapped or is not an ESM3 file.
+            ESMReader& restore(const ESM_Context& context);
+
+        private:
+            SharedReaders& mOwner;
+            std::optional<ToUTF8::Utf8Encoder> mEncoder;
+            std::shared_ptr<const File> mFile;
+            ESMReader mReader;
+        };
+
+        /// Encoder to decode the strings with, nullptr if the files are UTF-8. Has to be set before creating readers.
+        void setEncoder(const ToUTF8::StatelessUtf8Encoder* encoder) { mEncoder = encoder; }
+
+        /// Release the mappings of all files, each is unmapped once no reader is restored to it anymore.
+        void clear();
+
+    private:
+        const ToUTF8::StatelessUtf8Encoder* mEncoder = nullptr;
+        std::mutex mMutex;
+        std::map<std::filesystem::path, std::shared_ptr<const File>> mFiles;
+
+        std::shared_ptr<const File> getFile(const std::filesystem::path& path, ToUTF8::Utf8Encoder* encoder);
+    };
+}
+
+#endif
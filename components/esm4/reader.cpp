@@ -25,14 +25,13 @@
 #undef DEBUG_GROUPSTACK
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
-#include <optional>
-#include <span>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
-
-#include <zlib.h>
+#include <thread>
 
 #include <components/bsa/memorystream.hpp>
 #include <components/debug/debuglog.hpp>
@@ -40,10 +39,12 @@
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
 #include <components/to_utf8/to_utf8.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "grouptype.hpp"
+#include "recordinflater.hpp"
 
 namespace ESM4
 {
@@ -52,11 +53,6 @@ namespace ESM4
         using FormId = ESM::FormId;
         using FormId32 = ESM::FormId32;
 
-        std::string getError(const std::string& header, const int errorCode, const char* msg)
-        {
-            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
-        }
-
         std::u8string_view getStringsSuffix(LocalizedStringType type)
         {
             switch (type)
@@ -71,92 +67,6 @@ namespace ESM4
 
             throw std::logic_error("Unsupported LocalizedStringType: " + std::to_string(static_cast<int>(type)));
         }
-
-        struct InflateEnd
-        {
-            void operator()(z_stream* stream) const { inflateEnd(stream); }
-        };
-
-        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
-        {
-            z_stream stream{};
-
-            stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-            stream.avail_in = static_cast<uInt>(compressed.size());
-            stream.avail_out = static_cast<uInt>(decompressed.size());
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            if (const int ec = inflate(&stream, Z_NO_FLUSH); ec != Z_STREAM_END)
-                return getError("inflate error", ec, stream.msg);
-
-            return std::nullopt;
-        }
-
-        std::optional<std::string> tryDecompressByBlock(
-            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
-        {
-            z_stream stream{};
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            while (!compressed.empty() && !decompressed.empty())
-            {
-                const auto prevTotalIn = stream.total_in;
-                const auto prevTotalOut = stream.total_out;
-                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
-                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
-                const int ec = inflate(&stream, Z_NO_FLUSH);
-                if (ec == Z_STREAM_END)
-                    break;
-                if (ec != Z_OK)
-                    return getError(
-                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
-                compressed = compressed.subspan(stream.total_in - prevTotalIn);
-                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
-            }
-
-            return std::nullopt;
-        }
-
-        std::unique_ptr<Bsa::MemoryInputStream> decompress(
-            std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
-        {
-            auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
-
-            const std::span decompressed(result->getRawData(), uncompressedSize);
-
-            const auto allError = tryDecompressAll(compressed, decompressed);
-            if (!allError.has_value())
-                return result;
-
-            Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
-                                << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-                                << " uncompressed size = " << uncompressedSize << ": " << *allError
-                                << ". Trying to decompress by block...";
-
-            std::memset(result->getRawData(), 0, uncompressedSize);
-
-            constexpr std::size_t blockSize = 4;
-            const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
-            if (!blockError.has_value())
-                return result;
-
-            std::ostringstream s;
-            s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
-              << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-              << " uncompressed size = " << uncompressedSize << ": " << *blockError;
-            throw std::runtime_error(s.str());
-        }
     }
 
     ReaderContext::ReaderContext()
@@ -219,6 +129,17 @@ namespace ESM4
         close();
     }
 
+    void Reader::inflateAhead(Files::IStreamPtr&& stream, std::function<bool(std::uint32_t typeId)> filter)
+    {
+        // Keeps the inflated records within the typical size of a master file
+        constexpr std::size_t maxPendingSize = 64 * 1024 * 1024;
+
+        const std::size_t threads = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+
+        mInflater = std::make_unique<RecordInflater>(
+            std::move(stream), mCtx.recHeaderSize, std::move(filter), threads, maxPendingSize);
+    }
+
     // Since the record data may have been compressed, it is not always possible to use seek() to
     // go to a position of a sub record.
     //
@@ -250,6 +171,7 @@ namespace ESM4
 
     void Reader::close()
     {
+        mInflater.reset();
         mStream.reset();
         // clearCtx();
         // mHeader.blank();
@@ -329,8 +251,18 @@ namespace ESM4
 
             if (mVFS->exists(vfsPath))
             {
+                // Only loose files can be mapped, files of archives are read at once instead
+                if (const std::filesystem::path fsPath = mVFS->getAbsoluteFileName(vfsPath); fsPath.is_absolute())
+                {
+                    auto file = std::make_shared<const Platform::File::MappedFile>(fsPath);
+                    buildLStringIndex(stringType, file, std::string_view(file->data(), file->size()));
+                    return;
+                }
+
                 const Files::IStreamPtr stream = mVFS->get(vfsPath);
-                buildLStringIndex(stringType, *stream);
+                auto file = std::make_shared<std::string>(
+                    std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+                buildLStringIndex(stringType, file, *file);
                 return;
             }
 
@@ -350,8 +282,8 @@ namespace ESM4
 
         if (std::filesystem::exists(fsPath))
         {
-            const Files::IStreamPtr stream = Files::openConstrainedFileStream(fsPath);
-            buildLStringIndex(stringType, *stream);
+            auto file = std::make_shared<const Platform::File::MappedFile>(fsPath);
+            buildLStringIndex(stringType, file, std::string_view(file->data(), file->size()));
             return;
         }
 
@@ -359,96 +291,74 @@ namespace ESM4
             Log(Debug::Warning) << "Ignore missing strings file: " << fsPath;
     }
 
-    void Reader::buildLStringIndex(LocalizedStringType stringType, std::istream& stream)
+    void Reader::buildLStringIndex(
+        LocalizedStringType stringType, std::shared_ptr<const void> storage, std::string_view file)
     {
-        stream.seekg(0, std::ios::end);
-        const std::istream::pos_type fileSize = stream.tellg();
-        stream.seekg(0, std::ios::beg);
+        const auto readUint32 = [&](std::size_t offset) {
+            std::uint32_t value = 0;
+            std::memcpy(&value, file.data() + offset, sizeof(value));
+            return value;
+        };
 
-        std::uint32_t numEntries = 0;
-        stream.read(reinterpret_cast<char*>(&numEntries), sizeof(numEntries));
+        constexpr std::size_t entrySize = 2 * sizeof(std::uint32_t);
 
-        std::uint32_t dataSize = 0;
-        stream.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
+        if (file.size() < entrySize)
+            throw std::runtime_error("Localized strings file is too small");
 
-        const std::istream::pos_type dataStart = fileSize - static_cast<std::istream::pos_type>(dataSize);
+        const std::uint32_t numEntries = readUint32(0);
+        const std::uint32_t dataSize = readUint32(sizeof(std::uint32_t));
 
-        struct LocalizedString
-        {
-            std::uint32_t mOffset = 0;
-            std::uint32_t mStringId = 0;
-        };
+        if ((file.size() - entrySize) / entrySize < numEntries
+            || file.size() - entrySize - numEntries * entrySize < dataSize)
+            throw std::runtime_error("Localized strings file is truncated");
 
-        std::vector<LocalizedString> strings;
-        strings.reserve(numEntries);
+        LocalizedStrings& strings = mLocalizedStrings.emplace_back();
+        strings.mType = stringType;
+        strings.mStorage = std::move(storage);
+        strings.mData = file.substr(file.size() - dataSize);
+        strings.mOffsets.reserve(numEntries);
 
         for (std::uint32_t i = 0; i < numEntries; ++i)
         {
-            LocalizedString string;
-
-            stream.read(reinterpret_cast<char*>(&string.mStringId), sizeof(string.mStringId));
-            stream.read(reinterpret_cast<char*>(&string.mOffset), sizeof(string.mOffset));
-
-            strings.push_back(string);
+            const std::size_t entry = entrySize + i * entrySize;
+            strings.mOffsets.emplace_back(readUint32(entry), readUint32(entry + sizeof(std::uint32_t)));
         }
 
-        std::sort(strings.begin(), strings.end(),
-            [](const LocalizedString& l, const LocalizedString& r) { return l.mOffset < r.mOffset; });
-
-        std::uint32_t lastOffset = 0;
-        std::string_view lastValue;
-
-        for (const LocalizedString& string : strings)
-        {
-            if (string.mOffset == lastOffset)
-            {
-                mLStringIndex.emplace(FormId::fromUint32(string.mStringId), lastValue);
-                continue;
-            }
-
-            const std::istream::pos_type offset = string.mOffset + dataStart;
-            const std::istream::pos_type pos = stream.tellg();
-            if (pos != offset)
-            {
-                char buffer[4096];
-                if (pos < offset && offset - pos < static_cast<std::istream::pos_type>(sizeof(buffer)))
-                    stream.read(buffer, offset - pos);
-                else
-                    stream.seekg(offset);
-            }
-
-            const auto it
-                = mLStringIndex.emplace(FormId::fromUint32(string.mStringId), readLocalizedString(stringType, stream))
-                      .first;
-            lastOffset = string.mOffset;
-            lastValue = it->second;
-        }
+        // With duplicate ids the string stored first in the file is used
+        std::sort(strings.mOffsets.begin(), strings.mOffsets.end());
     }
 
-    std::string Reader::readLocalizedString(LocalizedStringType type, std::istream& stream)
+    void Reader::decodeLocalizedString(LocalizedStringType type, std::string_view data, std::string& str) const
     {
         if (type == LocalizedStringType::Strings)
         {
-            std::string data;
+            str = data.substr(0, data.find('\0'));
+            return;
+        }
 
-            while (true)
-            {
-                char ch = 0;
-                stream.read(&ch, sizeof(ch));
-                if (ch == 0)
-                    break;
-                data.push_back(ch);
-            }
+        std::uint32_t size = 0;
+        if (data.size() < sizeof(size))
+            throw std::runtime_error("ESM4::Reader::getLocalizedString string size is out of bounds");
+        std::memcpy(&size, data.data(), sizeof(size));
+        data.remove_prefix(sizeof(size));
 
-            return data;
+        if (size > data.size())
+            throw std::runtime_error("ESM4::Reader::getLocalizedString string is out of bounds");
+        data = data.substr(0, size); // expect null terminated string
+
+        if (mEncoder != nullptr)
+        {
+            std::string buffer;
+            const std::string_view result
+                = mEncoder->getUtf8(data, ToUTF8::BufferAllocationPolicy::FitToRequiredSize, buffer);
+            str = result;
+            return;
         }
 
-        std::uint32_t size = 0;
-        stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (data.empty() || data.back() != '\0')
+            throw std::runtime_error("ESM4::Reader::getString string is not terminated with a null");
 
-        std::string result;
-        getStringImpl(result, size, stream, true); // expect null terminated string
-        return result;
+        str = data.substr(0, data.size() - 1);
     }
 
     void Reader::getLocalizedString(std::string& str)
@@ -459,23 +369,31 @@ namespace ESM4
         std::uint32_t stringId; // FormId
         get(stringId);
         if (stringId) // TES5 FoxRace, BOOK
-            getLocalizedStringImpl(FormId::fromUint32(stringId), str);
+            getLocalizedStringImpl(stringId, str);
     }
 
-    // FIXME: very messy and probably slow/inefficient
-    void Reader::getLocalizedStringImpl(const FormId stringId, std::string& str)
+    void Reader::getLocalizedStringImpl(std::uint32_t stringId, std::string& str)
     {
-        const auto it = mLStringIndex.find(stringId);
-
-        if (it == mLStringIndex.end())
+        for (const LocalizedStrings& strings : mLocalizedStrings)
         {
-            if (mIgnoreMissingLocalizedStrings)
-                return;
-            throw std::runtime_error("ESM4::Reader::getLocalizedString localized string not found for "
-                + ESM::RefId(stringId).toDebugString());
+            const auto it = std::lower_bound(strings.mOffsets.begin(), strings.mOffsets.end(),
+                std::pair<std::uint32_t, std::uint32_t>(stringId, 0));
+
+            if (it == strings.mOffsets.end() || it->first != stringId)
+                continue;
+
+            if (it->second >= strings.mData.size())
+                throw std::runtime_error("ESM4::Reader::getLocalizedString localized string offset is out of bounds "
+                    + ESM::RefId(FormId::fromUint32(stringId)).toDebugString());
+
+            return decodeLocalizedString(strings.mType, strings.mData.substr(it->second), str);
         }
 
-        str = it->second;
+        if (mIgnoreMissingLocalizedStrings)
+            return;
+
+        throw std::runtime_error("ESM4::Reader::getLocalizedString localized string not found for "
+            + ESM::RefId(FormId::fromUint32(stringId)).toDebugString());
     }
 
     bool Reader::getRecordHeader()
@@ -521,14 +439,24 @@ namespace ESM4
             const std::streamoff position = mStream->tellg();
 
             const std::uint32_t recordSize = mCtx.recordHeader.record.dataSize - sizeof(std::uint32_t);
-            std::vector<char> compressed(recordSize);
-            mStream->read(compressed.data(), recordSize);
+
+            std::unique_ptr<Bsa::MemoryInputStream> memoryStreamPtr;
+            if (mInflater != nullptr)
+                memoryStreamPtr = mInflater->take(position);
+
+            if (memoryStreamPtr != nullptr)
+                mStream->ignore(recordSize);
+            else
+            {
+                std::vector<char> compressed(recordSize);
+                mStream->read(compressed.data(), recordSize);
+                memoryStreamPtr = inflateRecord(position, compressed, uncompressedSize);
+            }
+
             mSavedStream = std::move(mStream);
 
             mCtx.recordHeader.record.dataSize = uncompressedSize - sizeof(uncompressedSize);
 
-            auto memoryStreamPtr = decompress(position, compressed, uncompressedSize);
-
             // For debugging only
             // #if 0
             if (dump)
@@ -25,10 +25,13 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <istream>
 #include <map>
 #include <memory>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "cellgrid.hpp"
 #include "common.hpp"
@@ -49,6 +52,8 @@ namespace VFS
 
 namespace ESM4
 {
+    class RecordInflater;
+
 #pragma pack(push, 1)
     // NOTE: the label field of a group is not reliable (http://www.uesp.net/wiki/Tes4Mod:Mod_File_Format)
     union GroupLabel
@@ -157,11 +162,22 @@ namespace ESM4
         Files::IStreamPtr mStream;
         Files::IStreamPtr mSavedStream; // mStream is saved here while using deflated memory stream
 
+        std::unique_ptr<RecordInflater> mInflater;
+
         Files::IStreamPtr mStrings;
         Files::IStreamPtr mILStrings;
         Files::IStreamPtr mDLStrings;
 
-        std::unordered_map<ESM::FormId, std::string> mLStringIndex;
+        struct LocalizedStrings
+        {
+            LocalizedStringType mType;
+            std::shared_ptr<const void> mStorage; // mapping or copy of the strings file
+            std::string_view mData; // string data following the directory
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> mOffsets; // string id, offset, sorted
+        };
+
+        // Strings, ILStrings and DLStrings, searched in this order. The strings are decoded when requested.
+        std::vector<LocalizedStrings> mLocalizedStrings;
 
         std::vector<Reader*>* mGlobalReaderList = nullptr;
 
@@ -169,13 +185,14 @@ namespace ESM4
 
         void buildLStringIndex(LocalizedStringType stringType, const std::u8string& prefix);
 
-        void buildLStringIndex(LocalizedStringType stringType, std::istream& stream);
+        void buildLStringIndex(
+            LocalizedStringType stringType, std::shared_ptr<const void> storage, std::string_view file);
 
-        std::string readLocalizedString(LocalizedStringType type, std::istream& stream);
+        void decodeLocalizedString(LocalizedStringType type, std::string_view data, std::string& str) const;
 
         inline bool hasLocalizedStrings() const { return (mHeader.mFlags & Rec_Localized) != 0; }
 
-        void getLocalizedStringImpl(const ESM::FormId stringId, std::string& str);
+        void getLocalizedStringImpl(std::uint32_t stringId, std::string& str);
 
         // Close the file, resets all information.
         // After calling close() the structure may be reused to load a new file.
@@ -305,6 +322,10 @@ namespace ESM4
         // Note: assumes the header was read correctly and nothing else was read
         void getRecordData(bool dump = false);
 
+        // Inflate compressed records ahead of getRecordData() on background threads, reading them from a separate
+        // stream of the same file. Records of the types rejected by the filter are inflated only when read.
+        void inflateAhead(Files::IStreamPtr&& stream, std::function<bool(std::uint32_t typeId)> filter = {});
+
         // Skip the data part of a record
         // Note: assumes the header was read correctly (partial skip is allowed)
         void skipRecordData();
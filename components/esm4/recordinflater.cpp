@@ -0,0 +1,314 @@
+#include "recordinflater.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+#ifdef OPENMW_USE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+#include <components/bsa/memorystream.hpp>
+#include <components/debug/debuglog.hpp>
+
+#include "common.hpp"
+#include "reader.hpp"
+
+namespace ESM4
+{
+    namespace
+    {
+        std::string getError(const std::string& header, const int errorCode, const char* msg)
+        {
+            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
+        }
+
+        struct InflateEnd
+        {
+            void operator()(z_stream* stream) const { inflateEnd(stream); }
+        };
+
+#ifdef OPENMW_USE_LIBDEFLATE
+        struct FreeDecompressor
+        {
+            void operator()(libdeflate_decompressor* decompressor) const { libdeflate_free_decompressor(decompressor); }
+        };
+
+        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
+        {
+            // A decompressor can't be used by multiple threads at the same time
+            thread_local const std::unique_ptr<libdeflate_decompressor, FreeDecompressor> decompressor(
+                libdeflate_alloc_decompressor());
+
+            if (decompressor == nullptr)
+                return "libdeflate_alloc_decompressor error";
+
+            if (const libdeflate_result ec = libdeflate_zlib_decompress(decompressor.get(), compressed.data(),
+                    compressed.size(), decompressed.data(), decompressed.size(), nullptr);
+                ec != LIBDEFLATE_SUCCESS)
+                return "libdeflate_zlib_decompress error: code " + std::to_string(ec);
+
+            return std::nullopt;
+        }
+#else
+        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
+        {
+            z_stream stream{};
+
+            stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
+            stream.avail_in = static_cast<uInt>(compressed.size());
+            stream.avail_out = static_cast<uInt>(decompressed.size());
+
+            if (const int ec = inflateInit(&stream); ec != Z_OK)
+                return getError("inflateInit error", ec, stream.msg);
+
+            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
+
+            if (const int ec = inflate(&stream, Z_NO_FLUSH); ec != Z_STREAM_END)
+                return getError("inflate error", ec, stream.msg);
+
+            return std::nullopt;
+        }
+#endif
+
+        std::optional<std::string> tryDecompressByBlock(
+            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
+        {
+            z_stream stream{};
+
+            if (const int ec = inflateInit(&stream); ec != Z_OK)
+                return getError("inflateInit error", ec, stream.msg);
+
+            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
+
+            while (!compressed.empty() && !decompressed.empty())
+            {
+                const auto prevTotalIn = stream.total_in;
+                const auto prevTotalOut = stream.total_out;
+                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
+                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
+                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
+                const int ec = inflate(&stream, Z_NO_FLUSH);
+                if (ec == Z_STREAM_END)
+                    break;
+                if (ec != Z_OK)
+                    return getError(
+                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
+                compressed = compressed.subspan(stream.total_in - prevTotalIn);
+                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
+            }
+
+            return std::nullopt;
+        }
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> inflateRecord(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
+    {
+        auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
+
+        const std::span decompressed(result->getRawData(), uncompressedSize);
+
+        const auto allError = tryDecompressAll(compressed, decompressed);
+        if (!allError.has_value())
+            return result;
+
+        Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
+                            << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+                            << " uncompressed size = " << uncompressedSize << ": " << *allError
+                            << ". Trying to decompress by block...";
+
+        std::memset(result->getRawData(), 0, uncompressedSize);
+
+        constexpr std::size_t blockSize = 4;
+        const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
+        if (!blockError.has_value())
+            return result;
+
+        std::ostringstream s;
+        s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
+          << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+          << " uncompressed size = " << uncompressedSize << ": " << *blockError;
+        throw std::runtime_error(s.str());
+    }
+
+    RecordInflater::RecordInflater(Files::IStreamPtr&& stream, std::size_t recordHeaderSize, Filter filter,
+        std::size_t threads, std::size_t maxPendingSize)
+        : mStream(std::move(stream))
+        , mRecordHeaderSize(recordHeaderSize)
+        , mFilter(std::move(filter))
+        , mMaxPendingSize(maxPendingSize)
+    {
+        if (mRecordHeaderSize > sizeof(RecordHeader))
+            throw std::invalid_argument("Invalid record header size: " + std::to_string(mRecordHeaderSize));
+
+        mStream->seekg(0);
+
+        for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i)
+            mWorkers.emplace_back([this] { work(); });
+
+        mScanner = std::thread([this] { scan(); });
+    }
+
+    RecordInflater::~RecordInflater()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+
+        mHasSpace.notify_all();
+        mHasTasks.notify_all();
+
+        mScanner.join();
+
+        for (std::thread& worker : mWorkers)
+            worker.join();
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> RecordInflater::take(std::streamoff position)
+    {
+        std::future<std::unique_ptr<Bsa::MemoryInputStream>> result;
+
+        {
+            std::unique_lock lock(mMutex);
+
+            while (true)
+            {
+                while (!mPending.empty() && mPending.front().mPosition < position)
+                    pop();
+
+                if (!mPending.empty())
+                {
+                    if (mPending.front().mPosition != position)
+                        return nullptr;
+
+                    result = std::move(mPending.front().mResult);
+                    pop();
+                    break;
+                }
+
+                if (mDone || position < mScannedPosition)
+                    return nullptr;
+
+                mScanned.wait(lock);
+            }
+        }
+
+        return result.get();
+    }
+
+    void RecordInflater::scan()
+    {
+        std::streamoff position = 0;
+
+        try
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mMutex);
+                    mScannedPosition = position;
+                    mScanned.notify_all();
+                    mHasSpace.wait(lock, [&] { return mStopping || mPendingSize < mMaxPendingSize; });
+                    if (mStopping)
+                        break;
+                }
+
+                RecordHeader header{};
+                mStream->read(reinterpret_cast<char*>(&header), static_cast<std::streamsize>(mRecordHeaderSize));
+                if (mStream->gcount() != static_cast<std::streamsize>(mRecordHeaderSize))
+                    break;
+
+                position += static_cast<std::streamoff>(mRecordHeaderSize);
+
+                // Records of a group follow its header
+                if (header.record.typeId == REC_GRUP)
+                    continue;
+
+                const std::uint32_t dataSize = header.record.dataSize;
+
+                if ((header.record.flags & Rec_Compressed) == 0 || dataSize < sizeof(std::uint32_t)
+                    || (mFilter && !mFilter(header.record.typeId)))
+                {
+                    mStream->ignore(dataSize);
+                    position += dataSize;
+                    continue;
+                }
+
+                std::uint32_t uncompressedSize = 0;
+                mStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uncompressedSize));
+
+                std::vector<char> compressed(dataSize - sizeof(uncompressedSize));
+                mStream->read(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+                if (mStream->gcount() != static_cast<std::streamsize>(compressed.size()))
+                    break;
+
+                const std::streamoff dataPosition = position + static_cast<std::streamoff>(sizeof(uncompressedSize));
+                position += dataSize;
+
+                std::packaged_task<std::unique_ptr<Bsa::MemoryInputStream>()> task(
+                    [dataPosition, compressed = std::move(compressed), uncompressedSize]() mutable {
+                        return inflateRecord(dataPosition, compressed, uncompressedSize);
+                    });
+
+                {
+                    const std::lock_guard lock(mMutex);
+                    mPending.push_back(Pending{ dataPosition, uncompressedSize, task.get_future() });
+                    mPendingSize += uncompressedSize;
+                    mTasks.push_back(std::move(task));
+                }
+
+                mHasTasks.notify_one();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to scan records to inflate at 0x" << std::hex << position << ": "
+                                << e.what();
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mDone = true;
+            mScannedPosition = std::numeric_limits<std::streamoff>::max();
+        }
+
+        mScanned.notify_all();
+    }
+
+    void RecordInflater::work()
+    {
+        while (true)
+        {
+            std::packaged_task<std::unique_ptr<Bsa::MemoryInputStream>()> task;
+
+            {
+                std::unique_lock lock(mMutex);
+                mHasTasks.wait(lock, [&] { return mStopping || !mTasks.empty(); });
+                if (mStopping)
+                    return;
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    void RecordInflater::pop()
+    {
+        mPendingSize -= mPending.front().mSize;
+        mPending.pop_front();
+        mHasSpace.notify_one();
+    }
+}
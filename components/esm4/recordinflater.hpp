@@ -0,0 +1,89 @@
+#ifndef OPENMW_COMPONENTS_ESM4_RECORDINFLATER_H
+#define OPENMW_COMPONENTS_ESM4_RECORDINFLATER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <components/files/istreamptr.hpp>
+
+namespace Bsa
+{
+    class MemoryInputStream;
+}
+
+namespace ESM4
+{
+    std::unique_ptr<Bsa::MemoryInputStream> inflateRecord(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize);
+    ///< \param position Offset of the compressed data in the file, used for error messages
+
+    /// \brief Inflates compressed records of a file on background threads ahead of the reader
+    ///
+    /// A scanner thread walks the record headers of its own stream of the file, reads the compressed data of the
+    /// accepted record types and queues them for the worker threads. The results are kept in the file order until
+    /// taken, inflating no further while their size exceeds the limit.
+    class RecordInflater
+    {
+    public:
+        using Filter = std::function<bool(std::uint32_t typeId)>;
+
+        /// \param stream Separate stream of the file the reader reads
+        /// \param recordHeaderSize Size of record and group headers of the file
+        /// \param filter Whether to inflate the records of a type, all compressed records are inflated when empty
+        /// \param threads Number of worker threads
+        /// \param maxPendingSize Limit for the size of inflated records that are not taken yet
+        RecordInflater(Files::IStreamPtr&& stream, std::size_t recordHeaderSize, Filter filter, std::size_t threads,
+            std::size_t maxPendingSize);
+
+        ~RecordInflater();
+
+        std::unique_ptr<Bsa::MemoryInputStream> take(std::streamoff position);
+        ///< Wait for the record at a position to be inflated. Records before the position are discarded.
+        ///
+        /// \param position Offset of the compressed data in the file, after the uncompressed size
+        /// \return Inflated data, nullptr if the record is not inflated ahead
+
+    private:
+        struct Pending
+        {
+            std::streamoff mPosition;
+            std::size_t mSize;
+            std::future<std::unique_ptr<Bsa::MemoryInputStream>> mResult;
+        };
+
+        Files::IStreamPtr mStream;
+        const std::size_t mRecordHeaderSize;
+        const Filter mFilter;
+        const std::size_t mMaxPendingSize;
+        std::mutex mMutex;
+        std::condition_variable mScanned;
+        std::condition_variable mHasSpace;
+        std::condition_variable mHasTasks;
+        std::deque<Pending> mPending;
+        std::deque<std::packaged_task<std::unique_ptr<Bsa::MemoryInputStream>()>> mTasks;
+        std::size_t mPendingSize = 0;
+        std::streamoff mScannedPosition = 0;
+        bool mDone = false;
+        bool mStopping = false;
+        std::vector<std::thread> mWorkers;
+        std::thread mScanner;
+
+        void scan();
+
+        void work();
+
+        void pop();
+    };
+}
+
+#endif
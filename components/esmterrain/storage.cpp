@@ -259,6 +259,12 @@ namespace ESMTerrain
         const bool alteration = useAlteration();
         const int landSizeInUnits = ESM::getCellSize(worldspace);
         const osg::Vec2f origin = center - osg::Vec2f(size, size) * 0.5f;
+
+        // The grid is square, so the same coordinates are used along both axes
+        std::vector<float> vertCoords(numVerts);
+        for (std::size_t i = 0; i < numVerts; ++i)
+            vertCoords[i] = (i / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits;
+
         const int startCellX = static_cast<int>(std::floor(origin.x()));
         const int startCellY = static_cast<int>(std::floor(origin.y()));
         LandCache cache(startCellX - 1, startCellY - 1, static_cast<std::size_t>(std::ceil(size)) + 2);
@@ -277,16 +283,36 @@ namespace ESMTerrain
             validHeightDataExists = true;
         }
 
+        // Cell edges need the neighbouring cells, handle them separately from the rest of the samples
+        const auto handleEdgeSample = [&](ESM::ExteriorCellLocation cellLocation, std::size_t row, std::size_t col,
+                                          std::size_t vertIndex) {
+            osg::Vec3f& normal = normals[vertIndex];
+            const bool lastColOrRow = col == cellSize - 1 || row == cellSize - 1;
+
+            // Normals apparently don't connect seamlessly between cells
+            if (lastColOrRow)
+                fixNormal(normal, cellLocation, col, row, cache);
+
+            // some corner normals appear to be complete garbage (z < 0)
+            if ((row == 0 || row == cellSize - 1) && (col == 0 || col == cellSize - 1))
+                averageNormal(normal, cellLocation, col, row, cache);
+
+            assert(normal.z() > 0);
+
+            // Unlike normals, colors mostly connect seamlessly between cells, but not always...
+            if (lastColOrRow)
+                fixColour(colours[vertIndex], cellLocation, col, row, cache);
+        };
+
         const auto handleSample = [&](std::size_t cellShiftX, std::size_t cellShiftY, std::size_t row, std::size_t col,
                                       std::size_t vertX, std::size_t vertY) {
             const int cellX = startCellX + cellShiftX;
             const int cellY = startCellY + cellShiftY;
             const std::pair cell{ cellX, cellY };
-            const ESM::ExteriorCellLocation cellLocation(cellX, cellY, worldspace);
 
             if (lastCell != cell)
             {
-                land = getLand(cellLocation, cache);
+                land = getLand(ESM::ExteriorCellLocation(cellX, cellY, worldspace), cache);
 
                 heightData = nullptr;
                 normalData = nullptr;
@@ -303,57 +329,41 @@ namespace ESMTerrain
                 lastCell = cell;
             }
 
-            float height = defaultHeight;
-            if (heightData != nullptr)
-                height = heightData->getHeights()[col * cellSize + row];
-            if (alteration)
-                height += getAlteredHeight(col, row);
-
             const std::size_t vertIndex = vertX * numVerts + vertY;
+            const std::size_t srcIndex = col * cellSize + row;
 
-            positions[vertIndex]
-                = osg::Vec3f((vertX / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits,
-                    (vertY / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits, height);
-
-            const std::size_t srcArrayIndex = col * cellSize * 3 + row * 3;
-
-            osg::Vec3f normal(0, 0, 1);
-
+            // Normalized in a separate pass
+            osg::Vec3f& normal = normals[vertIndex];
             if (normalData != nullptr)
             {
-                for (std::size_t i = 0; i < 3; ++i)
-                    normal[i] = normalData->getNormals()[srcArrayIndex + i];
-
-                normal.normalize();
+                const std::int8_t* const src = normalData->getNormals().data() + srcIndex * 3;
+                normal.set(src[0], src[1], src[2]);
             }
-
-            // Normals apparently don't connect seamlessly between cells
-            if (col == cellSize - 1 || row == cellSize - 1)
-                fixNormal(normal, cellLocation, col, row, cache);
-
-            // some corner normals appear to be complete garbage (z < 0)
-            if ((row == 0 || row == cellSize - 1) && (col == 0 || col == cellSize - 1))
-                averageNormal(normal, cellLocation, col, row, cache);
-
-            assert(normal.z() > 0);
-
-            normals[vertIndex] = normal;
-
-            osg::Vec4ub color(255, 255, 255, 255);
+            else
+                normal.set(0, 0, 1);
 
             if (colourData != nullptr)
-                for (std::size_t i = 0; i < 3; ++i)
-                    color[i] = colourData->getColors()[srcArrayIndex + i];
+            {
+                const std::uint8_t* const src = colourData->getColors().data() + srcIndex * 3;
+                colours[vertIndex].set(src[0], src[1], src[2], 255);
+            }
+            else
+                colours[vertIndex].set(255, 255, 255, 255);
 
-            // Does nothing by default, override in OpenMW-CS
             if (alteration)
-                adjustColor(col, row, heightData, color);
+            {
+                float height = heightData != nullptr ? heightData->getHeights()[srcIndex] : defaultHeight;
+                height += getAlteredHeight(col, row);
+                positions[vertIndex].z() = height;
 
-            // Unlike normals, colors mostly connect seamlessly between cells, but not always...
-            if (col == cellSize - 1 || row == cellSize - 1)
-                fixColour(color, cellLocation, col, row, cache);
+                // Does nothing by default, override in OpenMW-CS
+                adjustColor(col, row, heightData, colours[vertIndex]);
+            }
+            else
+                positions[vertIndex].z() = heightData != nullptr ? heightData->getHeights()[srcIndex] : defaultHeight;
 
-            colours[vertIndex] = color;
+            if (col == cellSize - 1 || row == cellSize - 1 || (col == 0 && row == 0))
+                handleEdgeSample(ESM::ExteriorCellLocation(cellX, cellY, worldspace), row, col, vertIndex);
         };
 
         const std::size_t beginX = static_cast<std::size_t>((origin.x() - startCellX) * cellSize);
@@ -364,6 +374,26 @@ namespace ESMTerrain
 
         if (!validHeightDataExists && ESM::isEsm4Ext(worldspace))
             std::fill(positions.begin(), positions.end(), osg::Vec3f());
+        else
+        {
+            // Vertices are stored column by column, so these loops run over contiguous memory without branches
+            for (std::size_t vertX = 0; vertX < numVerts; ++vertX)
+            {
+                osg::Vec3f* const column = positions.data() + vertX * numVerts;
+                const float x = vertCoords[vertX];
+                for (std::size_t vertY = 0; vertY < numVerts; ++vertY)
+                {
+                    column[vertY].x() = x;
+                    column[vertY].y() = vertCoords[vertY];
+                }
+            }
+        }
+
+        for (osg::Vec3f& normal : normals)
+        {
+            const float length = std::sqrt(normal.length2());
+            normal = length > 0 ? normal / length : normal;
+        }
     }
 
     std::string Storage::getTextureName(UniqueTextureId id)
@@ -0,0 +1,173 @@
+#include "compressedstream.hpp"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <components/misc/endianness.hpp>
+
+#include "openfile.hpp"
+
+namespace Files
+{
+    namespace
+    {
+        void writeUInt32(std::ostream& stream, std::uint32_t value)
+        {
+            value = Misc::toLittleEndian(value);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        bool readUInt32(std::istream& stream, std::uint32_t& value)
+        {
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                return false;
+            value = Misc::fromLittleEndian(value);
+            return true;
+        }
+
+        class DecompressingInputStream final : public std::istream
+        {
+        public:
+            explicit DecompressingInputStream(std::unique_ptr<std::istream>&& source)
+                : std::istream(nullptr)
+                , mBuf(std::move(source))
+            {
+                rdbuf(&mBuf);
+            }
+
+        private:
+            DecompressingStreamBuf mBuf;
+        };
+    }
+
+    void writeCompressedStream(std::ostream& stream, std::string_view data)
+    {
+        stream.write(sCompressedStreamMagic, sizeof(sCompressedStreamMagic));
+        std::vector<char> compressed(
+            static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(sCompressedStreamFrameSize))));
+        for (std::size_t start = 0; start < data.size(); start += sCompressedStreamFrameSize)
+        {
+            const std::size_t size = std::min(sCompressedStreamFrameSize, data.size() - start);
+            const int compressedSize = LZ4_compress_default(data.data() + start, compressed.data(),
+                static_cast<int>(size), static_cast<int>(compressed.size()));
+            if (compressedSize <= 0)
+                throw std::runtime_error("Failed to compress");
+            writeUInt32(stream, static_cast<std::uint32_t>(compressedSize));
+            writeUInt32(stream, static_cast<std::uint32_t>(size));
+            stream.write(compressed.data(), compressedSize);
+        }
+    }
+
+    DecompressingStreamBuf::DecompressingStreamBuf(std::unique_ptr<std::istream>&& source)
+        : mSource(std::move(source))
+    {
+        std::uint32_t compressedSize = 0;
+        std::uint32_t size = 0;
+        while (readUInt32(*mSource, compressedSize))
+        {
+            if (!readUInt32(*mSource, size) || size > sCompressedStreamFrameSize
+                || compressedSize > static_cast<std::uint32_t>(LZ4_compressBound(static_cast<int>(size))))
+                throw std::runtime_error("Invalid compressed stream frame header");
+            mFrames.push_back(Frame{ mSource->tellg(), compressedSize, size, mSize });
+            mSize += size;
+            if (!mSource->seekg(compressedSize, std::ios_base::cur))
+                throw std::runtime_error("Truncated compressed stream");
+        }
+        mSource->clear();
+        mCurrentFrame = mFrames.size();
+        setg(nullptr, nullptr, nullptr);
+        if (!mFrames.empty())
+            loadFrame(0);
+    }
+
+    void DecompressingStreamBuf::loadFrame(std::size_t index)
+    {
+        const Frame& frame = mFrames[index];
+        mCompressed.resize(frame.mCompressedSize);
+        mSource->seekg(frame.mSourceOffset);
+        if (!mSource->read(mCompressed.data(), frame.mCompressedSize))
+            throw std::runtime_error("Failed to read compressed stream frame");
+        mBuffer.resize(frame.mSize);
+        const int size = LZ4_decompress_safe(mCompressed.data(), mBuffer.data(),
+            static_cast<int>(frame.mCompressedSize), static_cast<int>(frame.mSize));
+        if (size < 0 || static_cast<std::uint32_t>(size) != frame.mSize)
+            throw std::runtime_error("Failed to decompress stream frame " + std::to_string(index));
+        mCurrentFrame = index;
+        setg(mBuffer.data(), mBuffer.data(), mBuffer.data() + mBuffer.size());
+    }
+
+    DecompressingStreamBuf::int_type DecompressingStreamBuf::underflow()
+    {
+        if (gptr() == egptr())
+        {
+            if (mCurrentFrame + 1 >= mFrames.size())
+                return traits_type::eof();
+            loadFrame(mCurrentFrame + 1);
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+    DecompressingStreamBuf::pos_type DecompressingStreamBuf::seekoff(
+        off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::off_type(-1);
+
+        off_type target;
+        switch (whence)
+        {
+            case std::ios_base::beg:
+                target = offset;
+                break;
+            case std::ios_base::cur:
+            {
+                const std::size_t start = mCurrentFrame < mFrames.size() ? mFrames[mCurrentFrame].mStart : mSize;
+                target = static_cast<off_type>(start + (gptr() - eback())) + offset;
+                break;
+            }
+            case std::ios_base::end:
+                target = static_cast<off_type>(mSize) + offset;
+                break;
+            default:
+                return traits_type::off_type(-1);
+        }
+        if (target < 0 || static_cast<std::size_t>(target) > mSize)
+            return traits_type::off_type(-1);
+
+        const std::size_t position = static_cast<std::size_t>(target);
+        if (position == mSize)
+        {
+            mCurrentFrame = mFrames.size();
+            setg(nullptr, nullptr, nullptr);
+            return target;
+        }
+        const auto frame = std::prev(std::upper_bound(mFrames.begin(), mFrames.end(), position,
+            [](std::size_t value, const Frame& v) { return value < v.mStart; }));
+        const std::size_t index = static_cast<std::size_t>(frame - mFrames.begin());
+        if (index != mCurrentFrame)
+            loadFrame(index);
+        setg(eback(), eback() + (position - frame->mStart), egptr());
+        return target;
+    }
+
+    DecompressingStreamBuf::pos_type DecompressingStreamBuf::seekpos(pos_type pos, std::ios_base::openmode mode)
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, mode);
+    }
+
+    std::unique_ptr<std::istream> openMaybeCompressedInputFileStream(const std::filesystem::path& path)
+    {
+        std::unique_ptr<std::istream> stream = openBinaryInputFileStream(path);
+        char magic[sizeof(sCompressedStreamMagic)];
+        if (stream->read(magic, sizeof(magic)) && std::memcmp(magic, sCompressedStreamMagic, sizeof(magic)) == 0)
+            return std::make_unique<DecompressingInputStream>(std::move(stream));
+        stream->clear();
+        stream->seekg(0);
+        return stream;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+#define OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+namespace Files
+{
+    /// The compressed stream starts with the magic followed by LZ4 compressed frames. Each frame is the size of the
+    /// compressed data and the size of the original data as little endian 32 bit integers followed by the data.
+    inline constexpr char sCompressedStreamMagic[] = { 'O', 'M', 'W', 'Z', 'L', 'Z', '4', '\1' };
+
+    inline constexpr std::size_t sCompressedStreamFrameSize = 1024 * 1024;
+
+    /// Write the data as a compressed stream
+    void writeCompressedStream(std::ostream& stream, std::string_view data);
+
+    /// Read only streambuf decompressing the frames on demand, supports seeking
+    class DecompressingStreamBuf final : public std::streambuf
+    {
+    public:
+        /// @param source Positioned just after the magic
+        explicit DecompressingStreamBuf(std::unique_ptr<std::istream>&& source);
+
+        std::size_t getSize() const { return mSize; }
+
+    protected:
+        int_type underflow() override;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) override;
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override;
+
+    private:
+        struct Frame
+        {
+            std::streamoff mSourceOffset;
+            std::uint32_t mCompressedSize;
+            std::uint32_t mSize;
+            std::size_t mStart;
+        };
+
+        void loadFrame(std::size_t index);
+
+        std::unique_ptr<std::istream> mSource;
+        std::vector<Frame> mFrames;
+        std::size_t mSize = 0;
+        // Index of the frame in mBuffer, mFrames.size() when positioned at the end
+        std::size_t mCurrentFrame;
+        std::vector<char> mBuffer;
+        std::vector<char> mCompressed;
+    };
+
+    /// Opens the file for reading, decompressing it when it is a compressed stream
+    std::unique_ptr<std::istream> openMaybeCompressedInputFileStream(const std::filesystem::path& path);
+}
+
+#endif
@@ -0,0 +1,168 @@
+#include "fontcache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+namespace Gui
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'M', 'W', 'F' };
+
+        // Increment when the format or the way the fonts are rasterized changes
+        constexpr std::uint32_t sVersion = 1;
+
+        struct Header
+        {
+            char mMagic[std::size(sMagic)];
+            std::uint32_t mVersion;
+            std::int32_t mDefaultHeight;
+            std::int32_t mWidth;
+            std::int32_t mHeight;
+            std::uint32_t mPixelFormat;
+            std::uint32_t mBytesPerPixel;
+            std::uint32_t mGlyphCount;
+        };
+
+        std::size_t getPixelsSize(const Header& header)
+        {
+            return static_cast<std::size_t>(header.mWidth) * static_cast<std::size_t>(header.mHeight)
+                * header.mBytesPerPixel;
+        }
+    }
+
+    FontCache::FontCache(const std::filesystem::path& directory)
+        : mDirectory(directory)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create font cache directory " << directory << ": " << ec.message();
+            mDirectory.clear();
+        }
+    }
+
+    std::string FontCache::getKey(std::span<const char> inputs) const
+    {
+        std::string data(reinterpret_cast<const char*>(&sVersion), sizeof(sVersion));
+        data.append(inputs.begin(), inputs.end());
+        const std::array<std::uint64_t, 2> hash = Files::getHash(data);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return key.str();
+    }
+
+    std::filesystem::path FontCache::getPath(const std::string& key) const
+    {
+        return mDirectory / (key + ".font");
+    }
+
+    std::optional<BakedFont> FontCache::read(const std::string& key) const
+    {
+        if (mDirectory.empty())
+            return std::nullopt;
+        const std::filesystem::path path = getPath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        Header header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || std::memcmp(header.mMagic, sMagic, sizeof(sMagic)) != 0)
+        {
+            Log(Debug::Warning) << "Failed to read cached font " << path << ": bad header";
+            return std::nullopt;
+        }
+        // Written by another version, it is replaced once the font is rasterized
+        if (header.mVersion != sVersion)
+            return std::nullopt;
+
+        std::error_code ec;
+        const std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+        if (ec || header.mWidth <= 0 || header.mHeight <= 0 || header.mBytesPerPixel == 0
+            || header.mBytesPerPixel > 4
+            || fileSize
+                != sizeof(header) + static_cast<std::uintmax_t>(header.mGlyphCount) * sizeof(BakedFont::Glyph)
+                    + getPixelsSize(header))
+        {
+            Log(Debug::Warning) << "Failed to read cached font " << path << ": bad size";
+            return std::nullopt;
+        }
+
+        BakedFont result;
+        result.mDefaultHeight = header.mDefaultHeight;
+        result.mWidth = header.mWidth;
+        result.mHeight = header.mHeight;
+        result.mPixelFormat = header.mPixelFormat;
+        result.mBytesPerPixel = header.mBytesPerPixel;
+        result.mGlyphs.resize(header.mGlyphCount);
+        result.mPixels.resize(getPixelsSize(header));
+        if (!stream.read(reinterpret_cast<char*>(result.mGlyphs.data()),
+                static_cast<std::streamsize>(result.mGlyphs.size() * sizeof(BakedFont::Glyph)))
+            || !stream.read(
+                reinterpret_cast<char*>(result.mPixels.data()), static_cast<std::streamsize>(result.mPixels.size())))
+        {
+            Log(Debug::Warning) << "Failed to read cached font " << path << ": unexpected end of file";
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    void FontCache::write(const std::string& key, const BakedFont& font) const
+    {
+        if (mDirectory.empty())
+            return;
+        const std::filesystem::path path = getPath(key);
+
+        Header header;
+        std::memcpy(header.mMagic, sMagic, sizeof(sMagic));
+        header.mVersion = sVersion;
+        header.mDefaultHeight = font.mDefaultHeight;
+        header.mWidth = font.mWidth;
+        header.mHeight = font.mHeight;
+        header.mPixelFormat = font.mPixelFormat;
+        header.mBytesPerPixel = font.mBytesPerPixel;
+        header.mGlyphCount = static_cast<std::uint32_t>(font.mGlyphs.size());
+        if (font.mPixels.size() != getPixelsSize(header))
+        {
+            Log(Debug::Warning) << "Failed to write cached font " << path << ": atlas size mismatch";
+            return;
+        }
+
+        // Other instances may write the same file at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                if (!stream.write(reinterpret_cast<const char*>(&header), sizeof(header))
+                    || !stream.write(reinterpret_cast<const char*>(font.mGlyphs.data()),
+                        static_cast<std::streamsize>(font.mGlyphs.size() * sizeof(BakedFont::Glyph)))
+                    || !stream.write(reinterpret_cast<const char*>(font.mPixels.data()),
+                        static_cast<std::streamsize>(font.mPixels.size()))
+                    || !stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached font " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef OPENMW_COMPONENTS_FONTLOADER_FONTCACHE_H
+#define OPENMW_COMPONENTS_FONTLOADER_FONTCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Gui
+{
+    /// @brief Glyph atlas and metrics of a font rasterized by MyGUI.
+    struct BakedFont
+    {
+        struct Glyph
+        {
+            std::uint32_t mCodePoint;
+            float mWidth;
+            float mHeight;
+            float mAdvance;
+            float mBearingX;
+            float mBearingY;
+            // Texture coordinates
+            float mLeft;
+            float mTop;
+            float mRight;
+            float mBottom;
+        };
+
+        std::int32_t mDefaultHeight = 0;
+        std::int32_t mWidth = 0;
+        std::int32_t mHeight = 0;
+        // MyGUI::PixelFormat
+        std::uint32_t mPixelFormat = 0;
+        std::uint32_t mBytesPerPixel = 0;
+        std::vector<Glyph> mGlyphs;
+        // Top row first
+        std::vector<unsigned char> mPixels;
+    };
+
+    /// @brief Stores the glyph atlases of TrueType fonts on disk, so that later sessions load them instead of
+    /// rasterizing the fonts again.
+    /// @par A font is identified by the hash of its font files and of everything it is rasterized with, like the
+    /// resolution and the size.
+    class FontCache
+    {
+    public:
+        explicit FontCache(const std::filesystem::path& directory);
+
+        std::string getKey(std::span<const char> inputs) const;
+
+        /// @return nullopt if the font isn't cached.
+        std::optional<BakedFont> read(const std::string& key) const;
+
+        void write(const std::string& key, const BakedFont& font) const;
+
+    private:
+        std::filesystem::path getPath(const std::string& key) const;
+
+        std::filesystem::path mDirectory;
+    };
+}
+
+#endif
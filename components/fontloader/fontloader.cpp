@@ -1,14 +1,20 @@
 #include "fontloader.hpp"
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string_view>
 
 #include <osg/Image>
+#include <osg/Texture2D>
 
 #include <osgDB/WriteFile>
 
 #include <MyGUI_FactoryManager.h>
+#include <MyGUI_Prerequest.h>
 #include <MyGUI_RenderManager.h>
 #include <MyGUI_ResourceManager.h>
 #include <MyGUI_ResourceManualFont.h>
@@ -19,14 +25,19 @@
 
 #include <components/fallback/fallback.hpp>
 
+#include <components/files/hash.hpp>
+
 #include <components/vfs/manager.hpp>
 
 #include <components/misc/strings/algorithm.hpp>
 
+#include <components/myguiplatform/myguitexture.hpp>
 #include <components/myguiplatform/scalinglayer.hpp>
 
 #include <components/settings/values.hpp>
 
+#include "fontcache.hpp"
+
 namespace
 {
     MyGUI::xml::ElementPtr getProperty(MyGUI::xml::ElementPtr resourceNode, std::string_view propertyName)
@@ -222,14 +233,68 @@ namespace
         throw std::runtime_error(error.str());
     }
 
+    void appendFileHash(const VFS::Manager& vfs, const std::string& path, std::string& out)
+    {
+        const std::array<std::uint64_t, 2> hash = Files::getHash(path, *vfs.get(path));
+        out.append(reinterpret_cast<const char*>(hash.data()), sizeof(hash));
+    }
+
+    std::optional<Gui::BakedFont> bakeFont(const MyGUI::ResourceTrueTypeFont& font)
+    {
+        const osgMyGUI::OSGTexture* texture = dynamic_cast<const osgMyGUI::OSGTexture*>(font.getTextureFont());
+        if (texture == nullptr || texture->getTexture() == nullptr)
+            return std::nullopt;
+        // Still there since the texture hasn't been applied yet
+        const osg::Image* image = texture->getTexture()->getImage();
+        if (image == nullptr || image->data() == nullptr || image->s() != texture->getWidth()
+            || image->t() != texture->getHeight())
+            return std::nullopt;
+
+        Gui::BakedFont result;
+        result.mDefaultHeight = font.getDefaultHeight();
+        result.mWidth = texture->getWidth();
+        result.mHeight = texture->getHeight();
+        result.mPixelFormat = static_cast<std::uint32_t>(texture->getFormat().getValue());
+        result.mBytesPerPixel = static_cast<std::uint32_t>(texture->getNumElemBytes());
+
+        // The rows were flipped when the texture was unlocked, store them in the order MyGUI writes them
+        const std::size_t rowSize = static_cast<std::size_t>(result.mWidth) * result.mBytesPerPixel;
+        result.mPixels.reserve(rowSize * result.mHeight);
+        for (int row = result.mHeight - 1; row >= 0; --row)
+        {
+            const unsigned char* data = image->data(0, row);
+            result.mPixels.insert(result.mPixels.end(), data, data + rowSize);
+        }
+
+        std::set<MyGUI::Char> codePoints{ MyGUI::FontCodeType::Selected, MyGUI::FontCodeType::SelectedBack,
+            MyGUI::FontCodeType::Cursor, MyGUI::FontCodeType::Tab, MyGUI::FontCodeType::Space,
+            MyGUI::FontCodeType::NotDefined };
+        for (const auto& [first, last] : font.getCodePointRanges())
+            for (MyGUI::Char codePoint = first; codePoint <= last && codePoint >= first; ++codePoint)
+                codePoints.insert(codePoint);
+
+        for (const MyGUI::Char codePoint : codePoints)
+        {
+            const MyGUI::GlyphInfo* info = font.getGlyphInfo(codePoint);
+            if (info == nullptr)
+                continue;
+            result.mGlyphs.push_back(Gui::BakedFont::Glyph{ codePoint, info->width, info->height, info->advance,
+                info->bearingX, info->bearingY, info->uvRect.left, info->uvRect.top, info->uvRect.right,
+                info->uvRect.bottom });
+        }
+
+        return result;
+    }
 }
 
 namespace Gui
 {
 
-    FontLoader::FontLoader(ToUTF8::FromType encoding, const VFS::Manager* vfs, float scalingFactor)
+    FontLoader::FontLoader(
+        ToUTF8::FromType encoding, const VFS::Manager* vfs, float scalingFactor, std::unique_ptr<FontCache> cache)
         : mVFS(vfs)
         , mScalingFactor(scalingFactor)
+        , mCache(std::move(cache))
     {
         if (encoding == ToUTF8::WINDOWS_1252)
             mEncoding = ToUTF8::CP437;
@@ -243,6 +308,8 @@ namespace Gui
         loadFonts();
     }
 
+    FontLoader::~FontLoader() = default;
+
     void FontLoader::loadFonts()
     {
         std::string defaultFont{ Fallback::Map::getString("Fonts_Font_0") };
@@ -310,6 +377,21 @@ namespace Gui
             return;
         }
 
+        std::string sourceKey;
+        if (mCache != nullptr)
+        {
+            MyGUI::xml::ElementPtr sourceNode = getProperty(resourceNode.current(), "Source");
+            if (sourceNode != nullptr)
+            {
+                const std::string source = "fonts/" + std::string(sourceNode->findAttribute("value"));
+                if (mVFS->exists(source))
+                {
+                    appendFileHash(*mVFS, "fonts/" + fileName, sourceKey);
+                    appendFileHash(*mVFS, source, sourceKey);
+                }
+            }
+        }
+
         int resolution = 70;
         MyGUI::xml::ElementPtr resolutionNode = getProperty(resourceNode.current(), "Resolution");
         if (resolutionNode == nullptr)
@@ -326,20 +408,12 @@ namespace Gui
         sizeNode->addAttribute("key", "Size");
         sizeNode->addAttribute("value", std::to_string(Settings::gui().mFontSize));
 
-        MyGUI::ResourceTrueTypeFont* font = static_cast<MyGUI::ResourceTrueTypeFont*>(
-            MyGUI::FactoryManager::getInstance().createObject("Resource", "ResourceTrueTypeFont"));
-        font->deserialization(resourceNode.current(), MyGUI::Version(3, 2, 0));
-        font->setResourceName(fontId);
-        MyGUI::ResourceManager::getInstance().addResource(font);
+        addTrueTypeFont(resourceNode.current(), fontId, sourceKey);
 
         resolutionNode->setAttribute(
             "value", MyGUI::utility::toString(static_cast<int>(resolution * bookScale * mScalingFactor)));
 
-        MyGUI::ResourceTrueTypeFont* bookFont = static_cast<MyGUI::ResourceTrueTypeFont*>(
-            MyGUI::FactoryManager::getInstance().createObject("Resource", "ResourceTrueTypeFont"));
-        bookFont->deserialization(resourceNode.current(), MyGUI::Version(3, 2, 0));
-        bookFont->setResourceName("Journalbook " + fontId);
-        MyGUI::ResourceManager::getInstance().addResource(bookFont);
+        addTrueTypeFont(resourceNode.current(), "Journalbook " + fontId, sourceKey);
 
         dataManager->setResourcePath(oldDataPath);
 
@@ -348,6 +422,87 @@ namespace Gui
                                 << " contains multiple Resource entries, only first one will be used.";
     }
 
+    void FontLoader::addTrueTypeFont(
+        MyGUI::xml::ElementPtr resourceNode, const std::string& name, std::string_view sourceKey)
+    {
+        std::string key;
+        if (!sourceKey.empty())
+        {
+            std::string inputs(sourceKey);
+            const MyGUI::xml::ElementPtr resolutionNode = getProperty(resourceNode, "Resolution");
+            inputs += std::string(resolutionNode->findAttribute("value"));
+            const std::int32_t values[] = { Settings::gui().mFontSize, MYGUI_VERSION };
+            inputs.append(reinterpret_cast<const char*>(values), sizeof(values));
+            key = mCache->getKey(inputs);
+            if (const std::optional<BakedFont> bakedFont = mCache->read(key))
+            {
+                addBakedFont(*bakedFont, name);
+                return;
+            }
+        }
+
+        MyGUI::ResourceTrueTypeFont* font = static_cast<MyGUI::ResourceTrueTypeFont*>(
+            MyGUI::FactoryManager::getInstance().createObject("Resource", "ResourceTrueTypeFont"));
+        font->deserialization(resourceNode, MyGUI::Version(3, 2, 0));
+        font->setResourceName(name);
+        MyGUI::ResourceManager::getInstance().addResource(font);
+
+        if (key.empty())
+            return;
+        if (const std::optional<BakedFont> bakedFont = bakeFont(*font))
+            mCache->write(key, *bakedFont);
+        else
+            Log(Debug::Warning) << "Failed to store font " << name << " in the cache: the atlas is not available";
+    }
+
+    void FontLoader::addBakedFont(const BakedFont& font, const std::string& name)
+    {
+        // Unique for each font since the book fonts are rasterized with another resolution
+        const std::string textureName = "fonts/cache/" + name;
+        MyGUI::ITexture* tex = MyGUI::RenderManager::getInstance().createTexture(textureName);
+        tex->createManual(font.mWidth, font.mHeight, MyGUI::TextureUsage::Write,
+            MyGUI::PixelFormat(static_cast<MyGUI::PixelFormat::Enum>(font.mPixelFormat)));
+        unsigned char* texData = reinterpret_cast<unsigned char*>(tex->lock(MyGUI::TextureUsage::Write));
+        std::memcpy(texData, font.mPixels.data(), font.mPixels.size());
+        tex->unlock();
+
+        MyGUI::xml::Document xmlDocument;
+        MyGUI::xml::ElementPtr root = xmlDocument.createRoot("ResourceManualFont");
+        root->addAttribute("name", name);
+
+        MyGUI::xml::ElementPtr defaultHeight = root->createChild("Property");
+        defaultHeight->addAttribute("key", "DefaultHeight");
+        defaultHeight->addAttribute("value", font.mDefaultHeight);
+        MyGUI::xml::ElementPtr source = root->createChild("Property");
+        source->addAttribute("key", "Source");
+        source->addAttribute("value", textureName);
+        MyGUI::xml::ElementPtr codes = root->createChild("Codes");
+
+        for (const BakedFont::Glyph& glyph : font.mGlyphs)
+        {
+            const float x = glyph.mLeft * font.mWidth;
+            const float y = glyph.mTop * font.mHeight;
+            const float w = (glyph.mRight - glyph.mLeft) * font.mWidth;
+            const float h = (glyph.mBottom - glyph.mTop) * font.mHeight;
+
+            MyGUI::xml::ElementPtr code = codes->createChild("Code");
+            code->addAttribute("index", glyph.mCodePoint);
+            code->addAttribute("coord",
+                MyGUI::utility::toString(x) + " " + MyGUI::utility::toString(y) + " " + MyGUI::utility::toString(w)
+                    + " " + MyGUI::utility::toString(h));
+            code->addAttribute("advance", glyph.mAdvance);
+            code->addAttribute(
+                "bearing", MyGUI::utility::toString(glyph.mBearingX) + " " + MyGUI::utility::toString(glyph.mBearingY));
+            code->addAttribute(
+                "size", MyGUI::utility::toString(glyph.mWidth) + " " + MyGUI::utility::toString(glyph.mHeight));
+        }
+
+        MyGUI::ResourceManualFont* manualFont = static_cast<MyGUI::ResourceManualFont*>(
+            MyGUI::FactoryManager::getInstance().createObject("Resource", "ResourceManualFont"));
+        manualFont->deserialization(root, MyGUI::Version(3, 2, 0));
+        MyGUI::ResourceManager::getInstance().addResource(manualFont);
+    }
+
     typedef struct
     {
         float x;
@@ -1,6 +1,9 @@
 #ifndef OPENMW_COMPONENTS_FONTLOADER_H
 #define OPENMW_COMPONENTS_FONTLOADER_H
 
+#include <memory>
+#include <string_view>
+
 #include <MyGUI_Version.h>
 #include <MyGUI_XmlDocument.h>
 
@@ -18,6 +21,12 @@ namespace MyGUI
     class ResourceManualFont;
 }
 
+namespace Gui
+{
+    struct BakedFont;
+    class FontCache;
+}
+
 namespace Gui
 {
     /// @brief loads Morrowind's .fnt/.tex fonts for use with MyGUI and OSG
@@ -25,7 +34,11 @@ namespace Gui
     class FontLoader
     {
     public:
-        FontLoader(ToUTF8::FromType encoding, const VFS::Manager* vfs, float scalingFactor);
+        /// @param cache Stores the rasterized TrueType fonts, may be null.
+        FontLoader(ToUTF8::FromType encoding, const VFS::Manager* vfs, float scalingFactor,
+            std::unique_ptr<FontCache> cache = nullptr);
+
+        ~FontLoader();
 
         void overrideLineHeight(MyGUI::xml::ElementPtr _node, std::string_view _file, MyGUI::Version _version);
 
@@ -35,6 +48,7 @@ namespace Gui
         ToUTF8::FromType mEncoding;
         const VFS::Manager* mVFS;
         float mScalingFactor;
+        std::unique_ptr<FontCache> mCache;
 
         void loadFonts();
         void loadFont(const std::string& fontName, const std::string& fontId);
@@ -42,6 +56,10 @@ namespace Gui
         void loadBitmapFont(const std::string& fileName, const std::string& fontId);
         void loadTrueTypeFont(const std::string& fileName, const std::string& fontId);
 
+        /// @param sourceKey Identifies the font files in the cache, empty when the font is not cached.
+        void addTrueTypeFont(MyGUI::xml::ElementPtr resourceNode, const std::string& name, std::string_view sourceKey);
+        void addBakedFont(const BakedFont& font, const std::string& name);
+
         FontLoader(const FontLoader&);
         void operator=(const FontLoader&);
     };
@@ -0,0 +1,120 @@
+#include "framegraph.hpp"
+
+#include <algorithm>
+
+namespace fx
+{
+    FrameGraph::Resource FrameGraph::addResource(std::size_t aliasClass)
+    {
+        const Resource resource = mResources.size();
+        mResources.push_back(ResourceInfo{ .mAliasClass = aliasClass, .mAlias = resource });
+        return resource;
+    }
+
+    FrameGraph::PassIndex FrameGraph::addPass(
+        std::optional<Resource> target, bool blend, std::span<const Resource> inputs)
+    {
+        mPasses.push_back(PassInfo{
+            .mTarget = target, .mBlend = blend, .mInputs = std::vector<Resource>(inputs.begin(), inputs.end()) });
+        return mPasses.size() - 1;
+    }
+
+    void FrameGraph::compile()
+    {
+        cullPasses();
+        computeLifetimes();
+        assignAliases();
+    }
+
+    void FrameGraph::cullPasses()
+    {
+        // The output of the chain is always used, anything else only when it's read by a used pass
+        for (PassInfo& pass : mPasses)
+            pass.mUsed = !pass.mTarget.has_value();
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (const PassInfo& pass : mPasses)
+            {
+                if (!pass.mUsed)
+                    continue;
+                for (Resource input : pass.mInputs)
+                    mResources[input].mRead = true;
+            }
+            for (PassInfo& pass : mPasses)
+            {
+                if (!pass.mUsed && mResources[*pass.mTarget].mRead)
+                {
+                    pass.mUsed = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    void FrameGraph::computeLifetimes()
+    {
+        for (PassIndex i = 0; i < mPasses.size(); ++i)
+        {
+            const PassInfo& pass = mPasses[i];
+            if (!pass.mUsed)
+                continue;
+
+            // A render target read or blended with before it's drawn to keeps its contents of the previous frame
+            for (Resource input : pass.mInputs)
+            {
+                ResourceInfo& resource = mResources[input];
+                if (!resource.mFirstUse)
+                    resource.mFirstUse = i;
+                resource.mLastUse = i;
+            }
+            if (pass.mTarget)
+            {
+                ResourceInfo& resource = mResources[*pass.mTarget];
+                if (!resource.mFirstUse)
+                {
+                    resource.mFirstUse = i;
+                    resource.mTransient = !pass.mBlend;
+                }
+                resource.mLastUse = i;
+            }
+        }
+    }
+
+    void FrameGraph::assignAliases()
+    {
+        std::vector<Resource> transient;
+        for (Resource i = 0; i < mResources.size(); ++i)
+            if (mResources[i].mTransient)
+                transient.push_back(i);
+        std::stable_sort(transient.begin(), transient.end(),
+            [&](Resource l, Resource r) { return *mResources[l].mFirstUse < *mResources[r].mFirstUse; });
+
+        struct Slot
+        {
+            std::size_t mAliasClass;
+            Resource mResource;
+            PassIndex mLastUse;
+        };
+
+        std::vector<Slot> slots;
+        for (Resource i : transient)
+        {
+            ResourceInfo& resource = mResources[i];
+            // A pass may read one render target while drawing to another, so lifetimes must not overlap at all
+            const auto slot = std::find_if(slots.begin(), slots.end(), [&](const Slot& v) {
+                return v.mAliasClass == resource.mAliasClass && v.mLastUse < *resource.mFirstUse;
+            });
+            if (slot == slots.end())
+            {
+                slots.push_back(
+                    Slot{ .mAliasClass = resource.mAliasClass, .mResource = i, .mLastUse = resource.mLastUse });
+                continue;
+            }
+            resource.mAlias = slot->mResource;
+            slot->mLastUse = resource.mLastUse;
+        }
+    }
+}
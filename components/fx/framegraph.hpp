@@ -0,0 +1,68 @@
+#ifndef OPENMW_COMPONENTS_FX_FRAMEGRAPH_H
+#define OPENMW_COMPONENTS_FX_FRAMEGRAPH_H
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace fx
+{
+    /// @brief Plans the render targets of a chain of passes: finds the passes whose output is never read and the
+    /// render targets which can share the same memory because they are never used at the same time.
+    /// @par Passes are added in the order they are drawn. A render target read before it is written in the chain
+    /// keeps its contents between frames so it is never shared.
+    class FrameGraph
+    {
+    public:
+        using Resource = std::size_t;
+        using PassIndex = std::size_t;
+
+        /// @param aliasClass Only render targets of the same class, i.e. with the same size and format, are shared.
+        Resource addResource(std::size_t aliasClass);
+
+        /// @param target The render target drawn to, nullopt for the output of the chain.
+        /// @param blend Whether the pass blends with the previous contents of its target.
+        /// @param inputs The render targets sampled by the pass.
+        PassIndex addPass(std::optional<Resource> target, bool blend, std::span<const Resource> inputs);
+
+        /// Compute the results. Call after adding all the passes.
+        void compile();
+
+        /// @return false if nothing reads what the pass draws.
+        bool isPassUsed(PassIndex pass) const { return mPasses[pass].mUsed; }
+
+        /// @return The render target whose memory is used instead of \a resource.
+        Resource getAlias(Resource resource) const { return mResources[resource].mAlias; }
+
+    private:
+        struct ResourceInfo
+        {
+            std::size_t mAliasClass;
+            Resource mAlias;
+            bool mRead = false;
+            bool mTransient = false;
+            std::optional<PassIndex> mFirstUse;
+            PassIndex mLastUse = 0;
+        };
+
+        struct PassInfo
+        {
+            std::optional<Resource> mTarget;
+            bool mBlend;
+            std::vector<Resource> mInputs;
+            bool mUsed = false;
+        };
+
+        void cullPasses();
+
+        void computeLifetimes();
+
+        void assignAliases();
+
+        std::vector<ResourceInfo> mResources;
+        std::vector<PassInfo> mPasses;
+    };
+}
+
+#endif
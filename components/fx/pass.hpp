@@ -48,6 +48,8 @@ namespace fx
 
         const std::array<std::string, 3>& getRenderTargets() const { return mRenderTargets; }
 
+        bool getBlending() const { return mBlendSource.has_value() && mBlendDest.has_value(); }
+
         void prepareStateSet(osg::StateSet* stateSet, const std::string& name) const;
 
         std::string getName() const { return mName; }
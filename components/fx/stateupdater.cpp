@@ -4,6 +4,7 @@
 #include <osg/BufferObject>
 
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/uniformringbuffer.hpp>
 
 namespace fx
 {
@@ -24,7 +25,7 @@ namespace fx
                 = new osg::BufferTemplate<UniformData::BufferType>();
             data->setBufferObject(ubo);
 
-            osg::ref_ptr<osg::UniformBufferBinding> ubb = new osg::UniformBufferBinding(
+            osg::ref_ptr<osg::UniformBufferBinding> ubb = new SceneUtil::RingUniformBufferBinding(
                 static_cast<int>(Resource::SceneManager::UBOBinding::PostProcessor), data, 0, mData.getGPUSize());
 
             stateset->setAttributeAndModes(ubb, osg::StateAttribute::ON);
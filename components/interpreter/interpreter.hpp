@@ -1,11 +1,13 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
+#include <algorithm>
 #include <cassert>
-#include <map>
+#include <iterator>
 #include <memory>
 #include <stack>
 #include <utility>
+#include <vector>
 
 #include "components/interpreter/program.hpp"
 #include "opcodes.hpp"
@@ -16,15 +18,58 @@ namespace Interpreter
 {
     struct Program;
 
+    /// @brief Opcodes of a segment indexed directly by code
+    /// @par Codes are split into pages of consecutive codes, because extensions use codes starting at large offsets.
+    /// A segment has only a few pages, so they are searched linearly.
+    template <typename T>
+    class OpcodeTable
+    {
+    public:
+        T* find(int code) const
+        {
+            const int number = code >> sPageBits;
+            for (const Page& page : mPages)
+                if (page.mNumber == number)
+                    return page.mOpcodes[code & sPageMask].get();
+            return nullptr;
+        }
+
+        void insert(int code, std::unique_ptr<T>&& opcode)
+        {
+            const int number = code >> sPageBits;
+            auto it = std::find_if(
+                mPages.begin(), mPages.end(), [&](const Page& page) { return page.mNumber == number; });
+            if (it == mPages.end())
+            {
+                mPages.push_back(Page{ number, std::vector<std::unique_ptr<T>>(sPageSize) });
+                it = std::prev(mPages.end());
+            }
+            it->mOpcodes[code & sPageMask] = std::move(opcode);
+        }
+
+    private:
+        static constexpr int sPageBits = 10;
+        static constexpr int sPageSize = 1 << sPageBits;
+        static constexpr int sPageMask = sPageSize - 1;
+
+        struct Page
+        {
+            int mNumber;
+            std::vector<std::unique_ptr<T>> mOpcodes;
+        };
+
+        std::vector<Page> mPages;
+    };
+
     class Interpreter
     {
-        std::stack<Runtime> mCallstack;
+        std::stack<Runtime, std::vector<Runtime>> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        OpcodeTable<Opcode1> mSegment0;
+        OpcodeTable<Opcode1> mSegment2;
+        OpcodeTable<Opcode1> mSegment3;
+        OpcodeTable<Opcode0> mSegment5;
 
         void execute(Type_Code code);
 
@@ -35,8 +80,8 @@ namespace Interpreter
         template <typename TSeg, typename TOp>
         void installSegment(TSeg& seg, int code, TOp&& op)
         {
-            assert(seg.find(code) == seg.end());
-            seg.emplace(code, std::move(op));
+            assert(seg.find(code) == nullptr);
+            seg.insert(code, std::move(op));
         }
 
     public:
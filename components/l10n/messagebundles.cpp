@@ -1,6 +1,8 @@
 #include "messagebundles.hpp"
 
 #include <cstring>
+#include <utility>
+
 #include <unicode/calendar.h>
 #include <unicode/errorcode.h>
 #include <yaml-cpp/yaml.h>
@@ -19,6 +21,10 @@ namespace l10n
     {
         mPreferredLocales.clear();
         mPreferredLocaleStrings.clear();
+        {
+            const std::lock_guard lock(mKeyMessagesMutex);
+            mKeyMessages.clear();
+        }
         for (const icu::Locale& loc : preferredLocales)
         {
             mPreferredLocales.push_back(loc);
@@ -66,6 +72,38 @@ namespace l10n
         return status.isSuccess();
     }
 
+    static std::string format(const icu::MessageFormat& message, const std::vector<icu::UnicodeString>& argNames,
+        const std::vector<icu::Formattable>& args, std::string_view key)
+    {
+        icu::UnicodeString result;
+        std::string resultString;
+        icu::ErrorCode success;
+        if (!args.empty() && !argNames.empty())
+            message.format(argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
+        else
+            message.format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
+        checkSuccess(success, "Failed to format message " + std::string(key));
+        result.toUTF8String(resultString);
+        return resultString;
+    }
+
+    std::optional<MessageBundles::Message> MessageBundles::makeMessage(
+        std::string_view pattern, const icu::Locale& locale, const std::string& errorMessage)
+    {
+        icu::ErrorCode status;
+        UParseError parseError;
+        icu::MessageFormat messageFormat(
+            icu::UnicodeString::fromUTF8(icu::StringPiece(pattern.data(), static_cast<std::int32_t>(pattern.size()))),
+            locale, parseError, status);
+        if (!checkSuccess(status, errorMessage, parseError))
+            return std::nullopt;
+        std::optional<std::string> text;
+        // Such messages are formatted to the same text for any arguments
+        if (pattern.find('{') == std::string_view::npos)
+            text = format(messageFormat, {}, {}, pattern);
+        return Message{ std::move(messageFormat), std::move(text) };
+    }
+
     void MessageBundles::load(std::istream& input, const icu::Locale& lang, const std::string& path)
     {
         try
@@ -73,20 +111,17 @@ namespace l10n
             YAML::Node data = YAML::Load(input);
             std::string localeName = lang.getName();
             const icu::Locale& langOrEn = localeName == "gmst" ? icu::Locale::getEnglish() : lang;
+            Messages& messages = mBundles[localeName];
             for (const auto& it : data)
             {
                 const auto key = it.first.as<std::string>();
                 const auto value = it.second.as<std::string>();
-                icu::UnicodeString pattern = icu::UnicodeString::fromUTF8(
-                    icu::StringPiece(value.data(), static_cast<std::int32_t>(value.size())));
-                icu::ErrorCode status;
-                UParseError parseError;
-                icu::MessageFormat message(pattern, langOrEn, parseError, status);
-                if (checkSuccess(status,
-                        std::string("Failed to create message ") + key + " for locale " + lang.getName(), parseError))
-                {
-                    mBundles[localeName].insert(std::make_pair(key, message));
-                }
+                if (messages.contains(key))
+                    continue;
+                std::optional<Message> message = makeMessage(
+                    value, langOrEn, std::string("Failed to create message ") + key + " for locale " + lang.getName());
+                if (message.has_value())
+                    messages.emplace(key, std::move(*message));
             }
         }
         catch (std::exception& e)
@@ -95,12 +130,13 @@ namespace l10n
         }
     }
 
-    const icu::MessageFormat* MessageBundles::findMessage(std::string_view key, const std::string& localeName) const
+    const MessageBundles::Message* MessageBundles::findMessage(
+        std::string_view key, const std::string& localeName) const
     {
         auto iter = mBundles.find(localeName);
         if (iter != mBundles.end())
         {
-            auto message = iter->second.find(key.data());
+            auto message = iter->second.find(key);
             if (message != iter->second.end())
             {
                 return &(message->second);
@@ -109,6 +145,26 @@ namespace l10n
         return nullptr;
     }
 
+    const MessageBundles::Message* MessageBundles::getKeyMessage(std::string_view key) const
+    {
+        const std::lock_guard lock(mKeyMessagesMutex);
+        auto iter = mKeyMessages.find(key);
+        if (iter == mKeyMessages.end())
+        {
+            icu::Locale defaultLocale(nullptr);
+            if (!mPreferredLocales.empty())
+            {
+                defaultLocale = mPreferredLocales[0];
+            }
+            std::optional<Message> message
+                = makeMessage(key, defaultLocale, "Failed to create message " + std::string(key));
+            iter = mKeyMessages.emplace(std::string(key), std::move(message)).first;
+        }
+        if (!iter->second.has_value())
+            return nullptr;
+        return &*iter->second;
+    }
+
     std::string MessageBundles::formatMessage(
         std::string_view key, const std::map<std::string, icu::Formattable>& args) const
     {
@@ -140,18 +196,14 @@ namespace l10n
     std::string MessageBundles::formatMessage(std::string_view key, const std::vector<icu::UnicodeString>& argNames,
         const std::vector<icu::Formattable>& args) const
     {
-        icu::UnicodeString result;
-        std::string resultString;
-        icu::ErrorCode success;
-
-        const icu::MessageFormat* message = nullptr;
+        const Message* message = nullptr;
         for (auto& loc : mPreferredLocaleStrings)
         {
             message = findMessage(key, loc);
             if (message)
             {
                 if (loc == "gmst")
-                    return loadGmst(mGmstLoader, message);
+                    return loadGmst(mGmstLoader, &message->mFormat);
                 break;
             }
         }
@@ -159,36 +211,17 @@ namespace l10n
         if (!message)
             message = findMessage(key, mFallbackLocale.getName());
 
-        if (message)
-        {
-            if (!args.empty() && !argNames.empty())
-                message->format(argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
-            else
-                message->format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
-            checkSuccess(success, std::string("Failed to format message ") + key.data());
-            result.toUTF8String(resultString);
-            return resultString;
-        }
-        icu::Locale defaultLocale(nullptr);
-        if (!mPreferredLocales.empty())
-        {
-            defaultLocale = mPreferredLocales[0];
-        }
-        UParseError parseError;
-        icu::MessageFormat defaultMessage(
-            icu::UnicodeString::fromUTF8(icu::StringPiece(key.data(), static_cast<std::int32_t>(key.size()))),
-            defaultLocale, parseError, success);
-        if (!checkSuccess(success, std::string("Failed to create message ") + key.data(), parseError))
-            // If we can't parse the key as a pattern, just return the key
+        // Otherwise the key is formatted as a pattern
+        if (!message)
+            message = getKeyMessage(key);
+
+        // If we can't parse the key as a pattern, just return the key
+        if (!message)
             return std::string(key);
 
-        if (!args.empty() && !argNames.empty())
-            defaultMessage.format(
-                argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
-        else
-            defaultMessage.format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
-        checkSuccess(success, std::string("Failed to format message ") + key.data());
-        result.toUTF8String(resultString);
-        return resultString;
+        if (message->mText.has_value())
+            return *message->mText;
+
+        return format(message->mFormat, argNames, args, key);
     }
 }
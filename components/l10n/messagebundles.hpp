@@ -3,6 +3,9 @@
 
 #include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -10,6 +13,8 @@
 #include <unicode/locid.h>
 #include <unicode/msgfmt.h>
 
+#include <components/misc/strings/algorithm.hpp>
+
 namespace l10n
 {
     /**
@@ -46,13 +51,30 @@ namespace l10n
         void setGmstLoader(std::function<std::string(std::string_view)> fn) { mGmstLoader = std::move(fn); }
 
     private:
+        struct Message
+        {
+            icu::MessageFormat mFormat;
+            // Formatted in advance when the pattern has no arguments
+            std::optional<std::string> mText;
+        };
+
+        using Messages = std::unordered_map<std::string, Message, Misc::StringUtils::StringHash, std::equal_to<>>;
+
         // icu::Locale isn't hashable (or comparable), so we use the string form instead, which is canonicalized
-        std::unordered_map<std::string, std::unordered_map<std::string, icu::MessageFormat>> mBundles;
+        std::unordered_map<std::string, Messages> mBundles;
         const icu::Locale mFallbackLocale;
         std::vector<std::string> mPreferredLocaleStrings;
         std::vector<icu::Locale> mPreferredLocales;
         std::function<std::string(std::string_view)> mGmstLoader;
-        const icu::MessageFormat* findMessage(std::string_view key, const std::string& localeName) const;
+        // Keys missing from the bundles are formatted as patterns in the first preferred locale, nullopt when the key
+        // is not a valid pattern
+        mutable std::mutex mKeyMessagesMutex;
+        mutable std::unordered_map<std::string, std::optional<Message>, Misc::StringUtils::StringHash, std::equal_to<>>
+            mKeyMessages;
+        const Message* findMessage(std::string_view key, const std::string& localeName) const;
+        const Message* getKeyMessage(std::string_view key) const;
+        static std::optional<Message> makeMessage(
+            std::string_view pattern, const icu::Locale& locale, const std::string& errorMessage);
     };
 
 }
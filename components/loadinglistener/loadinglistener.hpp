@@ -32,6 +32,9 @@ namespace Loading
         /// Increase current progress, default by 1.
         virtual void increaseProgress(size_t increase = 1) {}
 
+        /// Keep the loading screen updating while waiting for work done by other threads without progress.
+        virtual void redraw() {}
+
         virtual ~Listener() = default;
     };
 
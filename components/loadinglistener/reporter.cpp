@@ -1,12 +1,18 @@
 #include "reporter.hpp"
 #include "loadinglistener.hpp"
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
 
 namespace Loading
 {
+    namespace
+    {
+        constexpr std::chrono::milliseconds redrawInterval(16);
+    }
+
     void Reporter::addTotal(std::size_t value)
     {
         const std::lock_guard lock(mMutex);
@@ -35,7 +41,9 @@ namespace Loading
         {
             listener.setProgressRange(mTotal);
             listener.setProgress(mProgress);
-            mUpdated.wait(lock);
+            // The work may report progress rarely, keep the loading screen drawn meanwhile
+            if (mUpdated.wait_for(lock, redrawInterval) == std::cv_status::timeout)
+                listener.redraw();
         }
     }
 }
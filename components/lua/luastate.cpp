@@ -4,8 +4,11 @@
 #include <luajit.h>
 #endif // NO_LUAJIT
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <new>
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
@@ -58,6 +61,25 @@ namespace LuaUtil
 
     bool LuaState::sProfilerEnabled = true;
 
+    static std::string getFunctionName(const lua_Debug& info)
+    {
+        return std::string(info.short_src) + ":" + std::to_string(info.linedefined);
+    }
+
+    void LuaState::popActiveScript(const sol::protected_function& fn, TraceRecorder::Clock::time_point start)
+    {
+        const ScriptId scriptId = mActiveScriptIdStack.back();
+        mActiveScriptIdStack.pop_back();
+        if (!mTraceRecorder)
+            return;
+        const TraceRecorder::Clock::time_point end = TraceRecorder::Clock::now();
+        lua_State* L = fn.lua_state();
+        lua_Debug info;
+        fn.push(L);
+        if (lua_getinfo(L, ">S", &info) != 0)
+            mTraceRecorder->addCall(scriptId.mIndex, getFunctionName(info), start, end);
+    }
+
     void LuaState::countHook(lua_State* L, lua_Debug* ar)
     {
         LuaState* self;
@@ -66,6 +88,9 @@ namespace LuaUtil
             return;
         const ScriptId& activeScript = self->mActiveScriptIdStack.back();
         activeScript.mContainer->addInstructionCount(activeScript.mIndex, countHookStep);
+        // Sample the function running every countHookStep instructions
+        if (self->mTraceRecorder && lua_getinfo(L, "S", ar) != 0)
+            self->mTraceRecorder->addSample(activeScript.mIndex, getFunctionName(*ar), TraceRecorder::Clock::now());
         self->mWatchdogInstructionCounter += countHookStep;
         if (self->mSettings.mInstructionLimit > 0
             && self->mWatchdogInstructionCounter > self->mSettings.mInstructionLimit)
@@ -77,6 +102,71 @@ namespace LuaUtil
         }
     }
 
+    void* LuaState::reallocate(void* ptr, size_t osize, size_t nsize)
+    {
+        if (!ptr)
+            osize = 0;
+        if (!ptr && nsize != 0)
+            ++mAllocations;
+        else if (ptr && nsize == 0)
+            ++mDeallocations;
+
+        if (!PoolAllocator::isPooled(osize) && !PoolAllocator::isPooled(nsize))
+        {
+            if (nsize == 0)
+            {
+                free(ptr);
+                return nullptr;
+            }
+            return realloc(ptr, nsize);
+        }
+        if (PoolAllocator::isSameClass(osize, nsize))
+            return ptr;
+
+        void* newPtr = nullptr;
+        if (nsize != 0)
+        {
+            newPtr = PoolAllocator::isPooled(nsize) ? mPool.allocate(nsize) : malloc(nsize);
+            if (!newPtr)
+                return nullptr;
+            if (ptr)
+                std::memcpy(newPtr, ptr, std::min(osize, nsize));
+        }
+        if (ptr)
+        {
+            if (PoolAllocator::isPooled(osize))
+                mPool.deallocate(ptr, osize);
+            else
+                free(ptr);
+        }
+        return newPtr;
+    }
+
+    void* LuaState::poolAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
+    {
+        return static_cast<LuaState*>(ud)->reallocate(ptr, osize, nsize);
+    }
+
+    LuaMemoryStats LuaState::getMemoryStats() const
+    {
+        LuaMemoryStats result;
+        result.mAllocations = mAllocations;
+        result.mDeallocations = mDeallocations;
+        result.mPoolUsedSize = mPool.getUsedSize();
+        result.mPoolReservedSize = mPool.getReservedSize();
+        result.mGcSteps = mGcSteps;
+        result.mLastGcStepDuration = mLastGcStepDuration;
+        return result;
+    }
+
+    void LuaState::gcStep(int steps)
+    {
+        const TraceRecorder::Clock::time_point start = TraceRecorder::Clock::now();
+        lua_gc(mLuaHolder.get(), LUA_GCSTEP, steps);
+        mLastGcStepDuration = TraceRecorder::Clock::now() - start;
+        ++mGcSteps;
+    }
+
     void* LuaState::trackingAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
     {
         LuaState* self = static_cast<LuaState*>(ud);
@@ -101,47 +191,79 @@ namespace LuaUtil
                               << " is blocked because Lua memory limit (configurable in settings.cfg) is exceeded";
             return nullptr;
         }
-        self->mTotalMemoryUsage += smallAllocDelta + bigAllocDelta;
-        self->mSmallAllocMemoryUsage += smallAllocDelta;
-
-        void* newPtr = nullptr;
-        if (nsize == 0)
-            free(ptr);
-        else
-            newPtr = realloc(ptr, nsize);
 
-        if (bigAllocDelta != 0)
+        if (osize <= smallAllocSize && nsize <= smallAllocSize)
         {
-            auto it = osize > smallAllocSize ? self->mBigAllocOwners.find(ptr) : self->mBigAllocOwners.end();
-            ScriptId id;
-            if (it != self->mBigAllocOwners.end())
-            {
-                if (it->second.mContainer)
-                    id = ScriptId{ *it->second.mContainer, it->second.mScriptIndex };
-                if (ptr != newPtr || nsize <= smallAllocSize)
-                    self->mBigAllocOwners.erase(it);
-            }
-            else if (bigAllocDelta > 0)
+            void* newPtr = self->reallocate(ptr, osize, nsize);
+            if (newPtr || nsize == 0)
             {
-                if (!self->mActiveScriptIdStack.empty())
-                    id = self->mActiveScriptIdStack.back();
-                bigAllocDelta = nsize;
-            }
-            if (id.mIndex >= 0)
-            {
-                if (static_cast<size_t>(id.mIndex) >= self->mMemoryUsage.size())
-                    self->mMemoryUsage.resize(id.mIndex + 1);
-                self->mMemoryUsage[id.mIndex] += bigAllocDelta;
-            }
-            if (id.mContainer)
-            {
-                id.mContainer->addMemoryUsage(id.mIndex, bigAllocDelta);
-                if (newPtr && nsize > smallAllocSize)
-                    self->mBigAllocOwners.emplace(newPtr, AllocOwner{ id.mContainer->mThis, id.mIndex });
+                self->mTotalMemoryUsage += smallAllocDelta;
+                self->mSmallAllocMemoryUsage += smallAllocDelta;
             }
+            return newPtr;
         }
 
-        return newPtr;
+        // Big allocations keep the owner in front of the data, so it is available when Lua reallocates or frees them
+        const size_t oldOffset = osize > smallAllocSize ? sAllocOwnerOffset : 0;
+        const size_t newOffset = nsize > smallAllocSize ? sAllocOwnerOffset : 0;
+        char* const oldBlock = ptr ? static_cast<char*>(ptr) - oldOffset : nullptr;
+        const size_t oldBlockSize = ptr ? osize + oldOffset : 0;
+        const size_t newBlockSize = nsize != 0 ? nsize + newOffset : 0;
+
+        AllocOwner owner;
+        const bool hasOwner = oldOffset != 0;
+        if (hasOwner)
+        {
+            AllocOwner* oldOwner = reinterpret_cast<AllocOwner*>(oldBlock);
+            owner = std::move(*oldOwner);
+            oldOwner->~AllocOwner();
+        }
+
+        char* newBlock = nullptr;
+        if (oldOffset == newOffset)
+            newBlock = static_cast<char*>(self->reallocate(oldBlock, oldBlockSize, newBlockSize));
+        else
+        {
+            if (nsize != 0)
+                newBlock = static_cast<char*>(self->reallocate(nullptr, 0, newBlockSize));
+            if (newBlock && ptr)
+                std::memcpy(newBlock + newOffset, oldBlock + oldOffset, std::min(osize, nsize));
+            if ((newBlock || nsize == 0) && ptr)
+                self->reallocate(oldBlock, oldBlockSize, 0);
+        }
+        if (!newBlock && nsize != 0)
+        {
+            // The old allocation is still valid
+            if (hasOwner)
+                new (oldBlock) AllocOwner(std::move(owner));
+            return nullptr;
+        }
+        self->mTotalMemoryUsage += smallAllocDelta + bigAllocDelta;
+        self->mSmallAllocMemoryUsage += smallAllocDelta;
+
+        ScriptId id;
+        if (hasOwner)
+        {
+            if (owner.mContainer)
+                id = ScriptId{ *owner.mContainer, owner.mScriptIndex };
+        }
+        else if (!self->mActiveScriptIdStack.empty())
+            id = self->mActiveScriptIdStack.back();
+        if (id.mIndex >= 0)
+        {
+            if (static_cast<size_t>(id.mIndex) >= self->mMemoryUsage.size())
+                self->mMemoryUsage.resize(id.mIndex + 1);
+            self->mMemoryUsage[id.mIndex] += bigAllocDelta;
+        }
+        if (id.mContainer)
+            id.mContainer->addMemoryUsage(id.mIndex, bigAllocDelta);
+
+        if (newOffset == 0)
+            return newBlock;
+        if (!hasOwner && id.mContainer)
+            owner = AllocOwner{ id.mContainer->mThis, id.mIndex };
+        new (newBlock) AllocOwner(std::move(owner));
+        return newBlock + newOffset;
     }
 
     lua_State* LuaState::createLuaRuntime(LuaState* luaState)
@@ -160,6 +282,9 @@ namespace LuaUtil
             }
         }
         Log(Debug::Info) << "Initializing LuaUtil::LuaState without profiler";
+        // LuaJIT doesn't allow custom allocators on some platforms
+        if (lua_State* L = lua_newstate(&poolAllocator, luaState))
+            return L;
         lua_State* L = luaL_newstate();
         if (!L)
             throw std::runtime_error("Can't create Lua runtime");
@@ -174,7 +299,11 @@ namespace LuaUtil
         , mVFS(vfs)
     {
         if (sProfilerEnabled)
+        {
             lua_sethook(mLuaHolder.get(), &countHook, LUA_MASKCOUNT, countHookStep);
+            if (mSettings.mTraceFrames > 0)
+                mTraceRecorder = std::make_unique<TraceRecorder>(mSettings.mTraceFrames);
+        }
 
         mSol.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math, sol::lib::bit32, sol::lib::string,
             sol::lib::table, sol::lib::os, sol::lib::debug);
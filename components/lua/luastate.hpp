@@ -3,11 +3,14 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <typeinfo>
 
 #include <sol/sol.hpp>
 
 #include "configuration.hpp"
+#include "poolallocator.hpp"
+#include "tracerecorder.hpp"
 
 namespace VFS
 {
@@ -32,6 +35,17 @@ namespace LuaUtil
         uint64_t mMemoryLimit = 0; // 0 is unlimited
         uint64_t mSmallAllocMaxSize = 1024 * 1024; // big default value efficiently disables memory tracking
         bool mLogMemoryUsage = false;
+        uint64_t mTraceFrames = 0; // number of the last frames kept by the trace recorder, 0 disables it
+    };
+
+    struct LuaMemoryStats
+    {
+        uint64_t mAllocations = 0;
+        uint64_t mDeallocations = 0;
+        std::size_t mPoolUsedSize = 0;
+        std::size_t mPoolReservedSize = 0;
+        uint64_t mGcSteps = 0;
+        TraceRecorder::Clock::duration mLastGcStepDuration{ 0 };
     };
 
     // Holds Lua state.
@@ -105,6 +119,10 @@ namespace LuaUtil
 
         uint64_t getTotalMemoryUsage() const { return mSol.memory_used(); }
         uint64_t getSmallAllocMemoryUsage() const { return mSmallAllocMemoryUsage; }
+        LuaMemoryStats getMemoryStats() const;
+
+        // Runs the incremental garbage collector and measures its time for the profiler
+        void gcStep(int steps);
         uint64_t getMemoryUsageByScriptIndex(unsigned id) const
         {
             return id < mMemoryUsage.size() ? mMemoryUsage[id] : 0;
@@ -112,6 +130,10 @@ namespace LuaUtil
 
         const LuaStateSettings& getSettings() const { return mSettings; }
 
+        // Null if the profiler or the trace recording is disabled.
+        TraceRecorder* getTraceRecorder() { return mTraceRecorder.get(); }
+        const TraceRecorder* getTraceRecorder() const { return mTraceRecorder.get(); }
+
         // Note: Lua profiler can not be re-enabled after disabling.
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
@@ -125,23 +147,34 @@ namespace LuaUtil
             ScriptId scriptId, const sol::protected_function& fn, Args&&... args);
 
         sol::function loadScriptAndCache(const std::string& path);
+        void popActiveScript(const sol::protected_function& fn, TraceRecorder::Clock::time_point start);
         static void countHook(lua_State* L, lua_Debug* ar);
         static void* trackingAllocator(void* ud, void* ptr, size_t osize, size_t nsize);
+        static void* poolAllocator(void* ud, void* ptr, size_t osize, size_t nsize);
+        void* reallocate(void* ptr, size_t osize, size_t nsize);
 
         lua_State* createLuaRuntime(LuaState* luaState);
 
+        // Stored before the data of the allocations bigger than mSmallAllocMaxSize when the profiler is enabled
         struct AllocOwner
         {
             std::shared_ptr<ScriptsContainer*> mContainer;
             int mScriptIndex;
         };
+        static constexpr std::size_t sAllocOwnerOffset = (sizeof(AllocOwner) + PoolAllocator::sGranularity - 1)
+            / PoolAllocator::sGranularity * PoolAllocator::sGranularity;
 
         const LuaStateSettings mSettings;
 
         // Needed to track resource usage per script, must be initialized before mLuaHolder.
         std::vector<ScriptId> mActiveScriptIdStack;
+        std::unique_ptr<TraceRecorder> mTraceRecorder;
         uint64_t mWatchdogInstructionCounter = 0;
-        std::map<void*, AllocOwner> mBigAllocOwners;
+        PoolAllocator mPool;
+        uint64_t mAllocations = 0;
+        uint64_t mDeallocations = 0;
+        uint64_t mGcSteps = 0;
+        TraceRecorder::Clock::duration mLastGcStepDuration{ 0 };
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
         std::vector<int64_t> mMemoryUsage;
@@ -205,29 +238,32 @@ namespace LuaUtil
     sol::protected_function_result call(ScriptId scriptId, const sol::protected_function& fn, Args&&... args)
     {
         LuaState* luaState = nullptr;
+        TraceRecorder::Clock::time_point start;
         if (LuaState::sProfilerEnabled && scriptId.mContainer)
         {
             (void)lua_getallocf(fn.lua_state(), reinterpret_cast<void**>(&luaState));
             luaState->mActiveScriptIdStack.push_back(scriptId);
             luaState->mWatchdogInstructionCounter = 0;
+            if (luaState->mTraceRecorder)
+                start = TraceRecorder::Clock::now();
         }
         try
         {
             auto res = LuaState::throwIfError(fn(std::forward<Args>(args)...));
             if (luaState)
-                luaState->mActiveScriptIdStack.pop_back();
+                luaState->popActiveScript(fn, start);
             return res;
         }
         catch (std::exception&)
         {
             if (luaState)
-                luaState->mActiveScriptIdStack.pop_back();
+                luaState->popActiveScript(fn, start);
             throw;
         }
         catch (...)
         {
             if (luaState)
-                luaState->mActiveScriptIdStack.pop_back();
+                luaState->popActiveScript(fn, start);
             throw std::runtime_error("Unknown error");
         }
     }
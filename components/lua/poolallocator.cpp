@@ -0,0 +1,55 @@
+#include "poolallocator.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+namespace LuaUtil
+{
+    PoolAllocator::~PoolAllocator()
+    {
+        for (void* chunk : mChunks)
+            std::free(chunk);
+    }
+
+    void* PoolAllocator::allocate(std::size_t size)
+    {
+        assert(isPooled(size));
+        const std::size_t index = getClass(size);
+        const std::size_t blockSize = (index + 1) * sGranularity;
+        SizeClass& sizeClass = mClasses[index];
+        void* result;
+        if (sizeClass.mFree != nullptr)
+        {
+            result = sizeClass.mFree;
+            sizeClass.mFree = sizeClass.mFree->mNext;
+        }
+        else
+        {
+            if (static_cast<std::size_t>(sizeClass.mEnd - sizeClass.mCurrent) < blockSize)
+            {
+                // The rest of the previous chunk is shorter than a block and is wasted
+                char* chunk = static_cast<char*>(std::malloc(sChunkSize));
+                if (chunk == nullptr)
+                    return nullptr;
+                mChunks.push_back(chunk);
+                sizeClass.mCurrent = chunk;
+                sizeClass.mEnd = chunk + sChunkSize;
+            }
+            result = sizeClass.mCurrent;
+            sizeClass.mCurrent += blockSize;
+        }
+        mUsedSize += blockSize;
+        return result;
+    }
+
+    void PoolAllocator::deallocate(void* ptr, std::size_t size)
+    {
+        assert(isPooled(size));
+        const std::size_t index = getClass(size);
+        SizeClass& sizeClass = mClasses[index];
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->mNext = sizeClass.mFree;
+        sizeClass.mFree = block;
+        mUsedSize -= (index + 1) * sGranularity;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef COMPONENTS_LUA_POOLALLOCATOR_H
+#define COMPONENTS_LUA_POOLALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace LuaUtil
+{
+    // Allocates small blocks from free lists of size classes, the memory is taken from the system allocator in
+    // chunks and released only when the allocator is destroyed. The size of a block is not stored, it has to be
+    // passed to deallocate as the Lua allocator function does. Not thread safe.
+    class PoolAllocator
+    {
+    public:
+        static constexpr std::size_t sGranularity = alignof(std::max_align_t);
+        static constexpr std::size_t sMaxSize = 256;
+        static constexpr std::size_t sChunkSize = 16 * 1024;
+
+        PoolAllocator() = default;
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+        ~PoolAllocator();
+
+        static bool isPooled(std::size_t size) { return size != 0 && size <= sMaxSize; }
+
+        // Both sizes are pooled and a block of one size can be used for the other
+        static bool isSameClass(std::size_t l, std::size_t r)
+        {
+            return isPooled(l) && isPooled(r) && getClass(l) == getClass(r);
+        }
+
+        // Returns nullptr if the system allocator fails, size should be pooled
+        void* allocate(std::size_t size);
+
+        void deallocate(void* ptr, std::size_t size);
+
+        // Size of the allocated blocks rounded up to the size classes
+        std::size_t getUsedSize() const { return mUsedSize; }
+
+        // Size of the memory taken from the system allocator
+        std::size_t getReservedSize() const { return mChunks.size() * sChunkSize; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* mNext;
+        };
+
+        struct SizeClass
+        {
+            FreeBlock* mFree = nullptr;
+            char* mCurrent = nullptr;
+            char* mEnd = nullptr;
+        };
+
+        static std::size_t getClass(std::size_t size) { return (size - 1) / sGranularity; }
+
+        std::array<SizeClass, sMaxSize / sGranularity> mClasses;
+        std::vector<void*> mChunks;
+        std::size_t mUsedSize = 0;
+    };
+}
+
+#endif // COMPONENTS_LUA_POOLALLOCATOR_H
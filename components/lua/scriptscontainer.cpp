@@ -1,5 +1,7 @@
 #include "scriptscontainer.hpp"
 
+#include <algorithm>
+
 #include <components/esm/luascripts.hpp>
 
 namespace LuaUtil
@@ -184,6 +186,8 @@ namespace LuaUtil
             removeHandler(handlers->mList, scriptId);
         for (auto& [_, handlers] : mEventHandlers)
             removeHandler(handlers, scriptId);
+        mSimulationTimersQueue.removeScript(scriptId);
+        mGameTimersQueue.removeScript(scriptId);
     }
 
     void ScriptsContainer::insertInterface(int scriptId, const Script& script)
@@ -357,10 +361,10 @@ namespace LuaUtil
             savedTimer.mCallbackArgument = timer.mSerializedArg;
             timers[timer.mScriptId].push_back(std::move(savedTimer));
         };
-        for (const Timer& timer : mSimulationTimersQueue)
-            saveTimerFn(timer, TimerType::SIMULATION_TIME);
-        for (const Timer& timer : mGameTimersQueue)
-            saveTimerFn(timer, TimerType::GAME_TIME);
+        for (const Timer* timer : mSimulationTimersQueue.getSorted())
+            saveTimerFn(*timer, TimerType::SIMULATION_TIME);
+        for (const Timer* timer : mGameTimersQueue.getSorted())
+            saveTimerFn(*timer, TimerType::GAME_TIME);
         data.mScripts.clear();
         for (auto& [scriptId, script] : mScripts)
         {
@@ -459,9 +463,9 @@ namespace LuaUtil
                     timer.mSerializedArg = serialize(timer.mArg, mSerializer);
 
                     if (savedTimer.mType == TimerType::GAME_TIME)
-                        mGameTimersQueue.push_back(std::move(timer));
+                        mGameTimersQueue.push(std::move(timer));
                     else
-                        mSimulationTimersQueue.push_back(std::move(timer));
+                        mSimulationTimersQueue.push(std::move(timer));
                 }
                 catch (std::exception& e)
                 {
@@ -469,9 +473,6 @@ namespace LuaUtil
                 }
             }
         }
-
-        std::make_heap(mSimulationTimersQueue.begin(), mSimulationTimersQueue.end());
-        std::make_heap(mGameTimersQueue.begin(), mGameTimersQueue.end());
     }
 
     ScriptsContainer::~ScriptsContainer()
@@ -514,10 +515,68 @@ namespace LuaUtil
         getScript(scriptId).mRegisteredCallbacks.emplace(std::string(callbackName), std::move(callback));
     }
 
-    void ScriptsContainer::insertTimer(std::vector<Timer>& timerQueue, Timer&& t)
+    void ScriptsContainer::TimerQueue::push(Timer&& timer)
+    {
+        std::uint32_t slot;
+        if (mFreeSlots.empty())
+        {
+            slot = static_cast<std::uint32_t>(mTimers.size());
+            mTimers.push_back(std::move(timer));
+        }
+        else
+        {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            mTimers[slot] = std::move(timer);
+        }
+        mHeap.push_back(Entry{ mTimers[slot].mTime, mNextSequence++, slot });
+        std::push_heap(mHeap.begin(), mHeap.end());
+    }
+
+    ScriptsContainer::Timer ScriptsContainer::TimerQueue::pop()
+    {
+        std::pop_heap(mHeap.begin(), mHeap.end());
+        const std::uint32_t slot = mHeap.back().mSlot;
+        mHeap.pop_back();
+        Timer result = std::move(mTimers[slot]);
+        // Release the references to Lua objects
+        mTimers[slot] = Timer{};
+        mFreeSlots.push_back(slot);
+        return result;
+    }
+
+    void ScriptsContainer::TimerQueue::removeScript(int scriptId)
+    {
+        const auto removed = std::remove_if(mHeap.begin(), mHeap.end(), [&](const Entry& entry) {
+            if (mTimers[entry.mSlot].mScriptId != scriptId)
+                return false;
+            mTimers[entry.mSlot] = Timer{};
+            mFreeSlots.push_back(entry.mSlot);
+            return true;
+        });
+        if (removed == mHeap.end())
+            return;
+        mHeap.erase(removed, mHeap.end());
+        std::make_heap(mHeap.begin(), mHeap.end());
+    }
+
+    void ScriptsContainer::TimerQueue::clear()
+    {
+        mHeap.clear();
+        mTimers.clear();
+        mFreeSlots.clear();
+    }
+
+    std::vector<const ScriptsContainer::Timer*> ScriptsContainer::TimerQueue::getSorted() const
     {
-        timerQueue.push_back(std::move(t));
-        std::push_heap(timerQueue.begin(), timerQueue.end());
+        std::vector<Entry> entries = mHeap;
+        // Entry::operator< is inverted
+        std::sort(entries.rbegin(), entries.rend());
+        std::vector<const Timer*> result;
+        result.reserve(entries.size());
+        for (const Entry& entry : entries)
+            result.push_back(&mTimers[entry.mSlot]);
+        return result;
     }
 
     void ScriptsContainer::setupSerializableTimer(
@@ -530,7 +589,7 @@ namespace LuaUtil
         t.mTime = time;
         t.mArg = std::move(callbackArg);
         t.mSerializedArg = serialize(t.mArg, mSerializer);
-        insertTimer(type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue).push(std::move(t));
     }
 
     void ScriptsContainer::setupUnsavableTimer(
@@ -545,7 +604,7 @@ namespace LuaUtil
         getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
         mTemporaryCallbackCounter++;
 
-        insertTimer(type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue).push(std::move(t));
     }
 
     void ScriptsContainer::callTimer(const Timer& t)
@@ -574,13 +633,13 @@ namespace LuaUtil
         }
     }
 
-    void ScriptsContainer::updateTimerQueue(std::vector<Timer>& timerQueue, double time)
+    void ScriptsContainer::updateTimerQueue(TimerQueue& timerQueue, double time)
     {
-        while (!timerQueue.empty() && timerQueue.front().mTime <= time)
+        while (!timerQueue.empty() && timerQueue.nextTime() <= time)
         {
-            callTimer(timerQueue.front());
-            std::pop_heap(timerQueue.begin(), timerQueue.end());
-            timerQueue.pop_back();
+            // Taken from the queue before the call because the callback may add new timers
+            const Timer timer = timerQueue.pop();
+            callTimer(timer);
         }
     }
 
@@ -1,9 +1,11 @@
 #ifndef COMPONENTS_LUA_SCRIPTSCONTAINER_H
 #define COMPONENTS_LUA_SCRIPTSCONTAINER_H
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/luascripts.hpp>
@@ -222,8 +224,39 @@ namespace LuaUtil
             std::variant<std::string, int64_t> mCallback; // string if serializable, integer otherwise
             sol::main_object mArg;
             std::string mSerializedArg;
+        };
+        // Binary heap of small entries referring to the timers in a pool, so reordering the heap doesn't move the
+        // timers. Timers with the same time are called in the order they were added.
+        class TimerQueue
+        {
+        public:
+            bool empty() const { return mHeap.empty(); }
+            double nextTime() const { return mHeap.front().mTime; }
+            void push(Timer&& timer);
+            Timer pop();
+            void removeScript(int scriptId);
+            void clear();
+            // Timers in the order they are going to be called
+            std::vector<const Timer*> getSorted() const;
+
+        private:
+            struct Entry
+            {
+                double mTime;
+                std::uint64_t mSequence;
+                std::uint32_t mSlot;
+
+                // Inverted for std::push_heap to keep the earliest entry at the front
+                bool operator<(const Entry& e) const
+                {
+                    return mTime > e.mTime || (mTime == e.mTime && mSequence > e.mSequence);
+                }
+            };
 
-            bool operator<(const Timer& t) const { return mTime > t.mTime; }
+            std::vector<Entry> mHeap;
+            std::vector<Timer> mTimers;
+            std::vector<std::uint32_t> mFreeSlots;
+            std::uint64_t mNextSequence = 0;
         };
         using EventHandlerList = std::vector<Handler>;
 
@@ -241,8 +274,7 @@ namespace LuaUtil
         const std::string& scriptPath(int scriptId) const { return mLua.getConfiguration()[scriptId].mScriptPath; }
         void callOnInit(int scriptId, const sol::function& onInit, std::string_view data);
         void callTimer(const Timer& t);
-        void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
-        static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
+        void updateTimerQueue(TimerQueue& timerQueue, double time);
         static void insertHandler(std::vector<Handler>& list, int scriptId, sol::function fn);
         static void removeHandler(std::vector<Handler>& list, int scriptId);
         void insertInterface(int scriptId, const Script& script);
@@ -260,8 +292,8 @@ namespace LuaUtil
         std::map<std::string_view, EngineHandlerList*> mEngineHandlers;
         std::map<std::string, EventHandlerList, std::less<>> mEventHandlers;
 
-        std::vector<Timer> mSimulationTimersQueue;
-        std::vector<Timer> mGameTimersQueue;
+        TimerQueue mSimulationTimersQueue;
+        TimerQueue mGameTimersQueue;
         int64_t mTemporaryCallbackCounter = 0;
 
         std::map<int, int64_t> mRemovedScriptsMemoryUsage;
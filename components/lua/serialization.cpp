@@ -17,6 +17,9 @@ namespace LuaUtil
 
     constexpr unsigned char FORMAT_VERSION = 0;
 
+    // Larger serialization buffers are not kept between calls
+    constexpr std::size_t sMaxBufferCapacity = 1024 * 1024;
+
     enum class SerializedType : char
     {
         NUMBER = 0x0,
@@ -198,41 +201,45 @@ namespace LuaUtil
     static void serialize(
         BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
     {
-        if (obj.get_type() == sol::type::lightuserdata)
-            throw std::runtime_error("Light userdata is not allowed to be serialized.");
-        if (obj.is<sol::function>())
-            throw std::runtime_error("Functions are not allowed to be serialized.");
-        else if (obj.is<sol::userdata>())
-            serializeUserdata(out, obj, customSerializer);
-        else if (obj.is<sol::lua_table>())
+        // The type is checked once, payloads with many small values are common in events
+        switch (obj.get_type())
         {
-            if (recursionCounter >= 32)
-                throw std::runtime_error(
-                    "Can not serialize more than 32 nested tables. Likely the table contains itself.");
-            sol::table table = obj;
-            appendType(out, SerializedType::TABLE_START);
-            for (auto& [key, value] : table)
+            case sol::type::lightuserdata:
+                throw std::runtime_error("Light userdata is not allowed to be serialized.");
+            case sol::type::function:
+                throw std::runtime_error("Functions are not allowed to be serialized.");
+            case sol::type::userdata:
+                serializeUserdata(out, obj, customSerializer);
+                return;
+            case sol::type::table:
             {
-                serialize(out, key, customSerializer, recursionCounter + 1);
-                serialize(out, value, customSerializer, recursionCounter + 1);
+                if (recursionCounter >= 32)
+                    throw std::runtime_error(
+                        "Can not serialize more than 32 nested tables. Likely the table contains itself.");
+                sol::table table = obj;
+                appendType(out, SerializedType::TABLE_START);
+                for (auto& [key, value] : table)
+                {
+                    serialize(out, key, customSerializer, recursionCounter + 1);
+                    serialize(out, value, customSerializer, recursionCounter + 1);
+                }
+                appendType(out, SerializedType::TABLE_END);
+                return;
             }
-            appendType(out, SerializedType::TABLE_END);
-        }
-        else if (obj.is<double>())
-        {
-            appendType(out, SerializedType::NUMBER);
-            appendValue<double>(out, obj.as<double>());
-        }
-        else if (obj.is<std::string_view>())
-            appendString(out, obj.as<std::string_view>());
-        else if (obj.is<bool>())
-        {
-            char v = obj.as<bool>() ? 1 : 0;
-            appendType(out, SerializedType::BOOLEAN);
-            out.push_back(v);
+            case sol::type::number:
+                appendType(out, SerializedType::NUMBER);
+                appendValue<double>(out, obj.as<double>());
+                return;
+            case sol::type::string:
+                appendString(out, obj.as<std::string_view>());
+                return;
+            case sol::type::boolean:
+                appendType(out, SerializedType::BOOLEAN);
+                out.push_back(obj.as<bool>() ? 1 : 0);
+                return;
+            default:
+                throw std::runtime_error("Unknown Lua type.");
         }
-        else
-            throw std::runtime_error("Unknown Lua type.");
     }
 
     static void deserializeImpl(
@@ -360,9 +367,14 @@ namespace LuaUtil
     {
         if (obj == sol::nil)
             return "";
-        BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        // Reuse the capacity of the buffer, so that serializing a value needs a single allocation of the exact size
+        thread_local BinaryData buffer;
+        buffer.clear();
+        buffer.push_back(FORMAT_VERSION);
+        serialize(buffer, obj, customSerializer, 0);
+        BinaryData res(buffer);
+        if (buffer.capacity() > sMaxBufferCapacity)
+            BinaryData().swap(buffer);
         return res;
     }
 
@@ -1,9 +1,11 @@
 #include "storage.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/endianness.hpp>
 
 namespace sol
 {
@@ -15,6 +17,34 @@ namespace sol
 
 namespace LuaUtil
 {
+    namespace
+    {
+        // The journal is a header with the size of the file it was started for followed by records. Each record
+        // is the size of the data and a serialized table of the changed sections, an empty table removes a section.
+        std::filesystem::path getJournalPath(const std::filesystem::path& path)
+        {
+            std::filesystem::path result = path;
+            result += ".journal";
+            return result;
+        }
+
+        template <class T>
+        void writeLittleEndian(std::ostream& stream, T value)
+        {
+            value = Misc::toLittleEndian(value);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        bool readLittleEndian(std::istream& stream, T& value)
+        {
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                return false;
+            value = Misc::fromLittleEndian(value);
+            return true;
+        }
+    }
+
     LuaStorage::Value LuaStorage::Section::sEmpty;
 
     void LuaStorage::registerLifeTime(LuaUtil::LuaState& luaState, sol::table& res)
@@ -31,8 +61,10 @@ namespace LuaUtil
         return deserialize(L, mSerializedValue);
     }
 
-    sol::object LuaStorage::Value::getReadOnly(lua_State* L) const
+    sol::object LuaStorage::Value::getReadOnly(lua_State* L, bool cache) const
     {
+        if (!cache)
+            return mSerializedValue.empty() ? sol::nil : deserialize(L, mSerializedValue, nullptr, true);
         if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
             mReadOnlyValue = deserialize(L, mSerializedValue, nullptr, true);
         return mReadOnlyValue;
@@ -84,6 +116,7 @@ namespace LuaUtil
     {
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
+        mChanged = true;
         if (value != sol::nil)
             mValues[std::string(key)] = Value(value);
         else
@@ -101,6 +134,7 @@ namespace LuaUtil
     {
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
+        mChanged = true;
         mValues.clear();
         if (values)
         {
@@ -112,12 +146,20 @@ namespace LuaUtil
         runCallbacks(sol::nullopt);
     }
 
-    sol::table LuaStorage::Section::asTable()
+    void LuaStorage::Section::setLifeTime(LifeTime lifeTime)
+    {
+        if (mLifeTime == lifeTime)
+            return;
+        mLifeTime = lifeTime;
+        mChanged = true;
+    }
+
+    sol::table LuaStorage::Section::asTable(lua_State* L)
     {
         checkIfActive();
-        sol::table res(mStorage->mLua, sol::create);
+        sol::table res(L, sol::create);
         for (const auto& [k, v] : mValues)
-            res[k] = v.getCopy(mStorage->mLua);
+            res[k] = v.getCopy(L);
         return res;
     }
 
@@ -126,13 +168,16 @@ namespace LuaUtil
         sol::state_view lua(L);
         sol::usertype<SectionView> sview = lua.new_usertype<SectionView>("Section");
         sview["get"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
-            return section.mSection->get(key).getReadOnly(s);
+            const bool cache = s.lua_state() == section.mSection->mStorage->mLua;
+            return section.mSection->get(key).getReadOnly(s, cache);
         };
         sview["getCopy"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
             return section.mSection->get(key).getCopy(s);
         };
-        sview["asTable"] = [](const SectionView& section) { return section.mSection->asTable(); };
+        sview["asTable"]
+            = [](sol::this_state s, const SectionView& section) { return section.mSection->asTable(s); };
         sview["subscribe"] = [](const SectionView& section, const sol::table& callback) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             std::vector<Callback>& callbacks
                 = section.mForMenuScripts ? section.mSection->mMenuScriptsCallbacks : section.mSection->mCallbacks;
             if (!callbacks.empty() && callbacks.size() == callbacks.capacity())
@@ -151,12 +196,12 @@ namespace LuaUtil
         sview["removeOnExit"] = [](const SectionView& section) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = Section::Temporary;
+            section.mSection->setLifeTime(Section::Temporary);
         };
         sview["setLifeTime"] = [](const SectionView& section, Section::LifeTime lifeTime) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = lifeTime;
+            section.mSection->setLifeTime(lifeTime);
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
             if (section.mReadOnly)
@@ -181,8 +226,9 @@ namespace LuaUtil
         sol::table res(luaState.sol(), sol::create);
         registerLifeTime(luaState, res);
 
-        res["globalSection"]
-            = [globalStorage](std::string_view section) { return globalStorage->getReadOnlySection(section); };
+        res["globalSection"] = [globalStorage, L = luaState.sol().lua_state()](std::string_view section) {
+            return globalStorage->getSection(L, section, true);
+        };
         return LuaUtil::makeReadOnly(res);
     }
 
@@ -225,6 +271,8 @@ namespace LuaUtil
             // because starting/loading a game doesn't reset menu scripts.
             if (it->second->mLifeTime == Section::Temporary)
             {
+                if (it->second->mChanged)
+                    mRemovedChangedSections.push_back(it->second->mSectionName);
                 it->second->mMenuScriptsCallbacks.clear();
                 it->second->mValues.clear();
                 it = mData.erase(it);
@@ -253,6 +301,8 @@ namespace LuaUtil
                 for (const auto& [key, value] : cast<sol::table>(sectionTable))
                     section->set(cast<std::string_view>(key), value);
             }
+            markSynced(path);
+            replayJournal(path);
         }
         catch (std::exception& e)
         {
@@ -260,24 +310,130 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::save(const std::filesystem::path& path) const
+    void LuaStorage::replayJournal(const std::filesystem::path& path)
+    {
+        const std::filesystem::path journalPath = getJournalPath(path);
+        std::ifstream fin(journalPath, std::fstream::binary);
+        if (!fin.is_open())
+            return;
+        std::uint64_t baseSize = 0;
+        // Left from a previous compaction that was interrupted before the journal was removed
+        if (!readLittleEndian(fin, baseSize) || baseSize != std::filesystem::file_size(path))
+        {
+            Log(Debug::Warning) << "Ignoring outdated Lua storage journal \"" << journalPath << "\"";
+            mSyncedPath.clear();
+            return;
+        }
+        std::size_t records = 0;
+        std::uint32_t recordSize = 0;
+        std::string serializedData;
+        while (readLittleEndian(fin, recordSize))
+        {
+            serializedData.resize(recordSize);
+            if (!fin.read(serializedData.data(), recordSize))
+            {
+                // Most likely the game was interrupted while saving, the file is rewritten by the next save
+                Log(Debug::Warning) << "Lua storage journal \"" << journalPath << "\" is truncated";
+                mSyncedPath.clear();
+                break;
+            }
+            sol::table data = deserialize(mLua, serializedData);
+            for (const auto& [sectionName, sectionTable] : data)
+                getSection(cast<std::string_view>(sectionName))->setAll(cast<sol::table>(sectionTable));
+            ++records;
+        }
+        Log(Debug::Info) << "Replayed " << records << " records of Lua storage journal \"" << journalPath << "\"";
+        for (const auto& [_, section] : mData)
+            section->mChanged = false;
+    }
+
+    sol::table LuaStorage::collectSections(bool changedOnly)
     {
         sol::table data(mLua, sol::create);
         for (const auto& [sectionName, section] : mData)
         {
+            if (changedOnly && !section->mChanged)
+                continue;
             if (section->mLifeTime == Section::Persistent && !section->mValues.empty())
-                data[sectionName] = section->asTable();
+                data[sectionName] = section->asTable(mLua);
+            else if (changedOnly)
+                data[sectionName] = sol::table(mLua, sol::create);
+        }
+        if (changedOnly)
+        {
+            for (const std::string& sectionName : mRemovedChangedSections)
+                if (!data[sectionName].valid())
+                    data[sectionName] = sol::table(mLua, sol::create);
         }
-        std::string serializedData = serialize(data);
+        return data;
+    }
+
+    void LuaStorage::writeFull(const std::filesystem::path& path)
+    {
+        std::string serializedData = serialize(collectSections(false));
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
         std::ofstream fout(path, std::fstream::binary);
         fout.write(serializedData.data(), serializedData.size());
         fout.close();
+        std::error_code ec;
+        std::filesystem::remove(getJournalPath(path), ec);
+    }
+
+    bool LuaStorage::appendToJournal(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        const std::uintmax_t baseSize = std::filesystem::file_size(path, ec);
+        if (ec)
+            return false;
+        const std::filesystem::path journalPath = getJournalPath(path);
+        std::uintmax_t journalSize = std::filesystem::file_size(journalPath, ec);
+        if (ec)
+            journalSize = 0;
+        const std::string serializedData = serialize(collectSections(true));
+        const std::uintmax_t recordSize = sizeof(std::uint32_t) + serializedData.size();
+        // Compact the journal into the file when replaying it would cost more than reading the file
+        if (journalSize + recordSize > baseSize)
+            return false;
+        std::ofstream fout(journalPath, std::fstream::binary | std::fstream::app);
+        if (journalSize == 0)
+            writeLittleEndian<std::uint64_t>(fout, baseSize);
+        writeLittleEndian(fout, static_cast<std::uint32_t>(serializedData.size()));
+        fout.write(serializedData.data(), serializedData.size());
+        fout.close();
+        if (!fout)
+            return false;
+        Log(Debug::Info) << "Saving changes of Lua storage \"" << path << "\" (" << serializedData.size()
+                         << " bytes)";
+        return true;
+    }
+
+    void LuaStorage::save(const std::filesystem::path& path)
+    {
+        if (path == mSyncedPath)
+        {
+            bool changed = !mRemovedChangedSections.empty();
+            for (const auto& [_, section] : mData)
+                changed = changed || section->mChanged;
+            if (!changed)
+                return;
+        }
+        if (path != mSyncedPath || !appendToJournal(path))
+            writeFull(path);
+        markSynced(path);
+    }
+
+    void LuaStorage::markSynced(const std::filesystem::path& path)
+    {
+        for (const auto& [_, section] : mData)
+            section->mChanged = false;
+        mRemovedChangedSections.clear();
+        mSyncedPath = path;
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
     {
         checkIfActive();
+        const std::lock_guard lock(mMutex);
         auto it = mData.find(sectionName);
         if (it != mData.end())
             return it->second;
@@ -287,11 +443,12 @@ namespace LuaUtil
         return newIt->second;
     }
 
-    sol::object LuaStorage::getSection(std::string_view sectionName, bool readOnly, bool forMenuScripts)
+    sol::object LuaStorage::getSection(
+        lua_State* L, std::string_view sectionName, bool readOnly, bool forMenuScripts)
     {
         checkIfActive();
         const std::shared_ptr<Section>& section = getSection(sectionName);
-        return sol::make_object<SectionView>(mLua, SectionView{ section, readOnly, forMenuScripts });
+        return sol::make_object<SectionView>(L, SectionView{ section, readOnly, forMenuScripts });
     }
 
     sol::table LuaStorage::getAllSections(bool readOnly)
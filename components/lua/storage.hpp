@@ -1,9 +1,13 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
 #include <map>
+#include <mutex>
 #include <sol/sol.hpp>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "asyncpackage.hpp"
 #include "serialization.hpp"
@@ -30,9 +34,17 @@ namespace LuaUtil
 
         void clearTemporaryAndRemoveCallbacks();
         void load(const std::filesystem::path& path);
-        void save(const std::filesystem::path& path) const;
+        /// Only the sections changed since the last load or save of the same file are appended to its journal.
+        /// The file is rewritten in full when the journal grows larger than the file itself.
+        void save(const std::filesystem::path& path);
 
-        sol::object getSection(std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
+        sol::object getSection(std::string_view sectionName, bool readOnly, bool forMenuScripts = false)
+        {
+            return getSection(mLua, sectionName, readOnly, forMenuScripts);
+        }
+        /// Create the section view in the given state, which may be another than the state of the storage.
+        /// @note Thread safe for read only sections, if no sections are modified meanwhile.
+        sol::object getSection(lua_State* L, std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
         sol::object getMutableSection(std::string_view sectionName, bool forMenuScripts = false)
         {
             return getSection(sectionName, false, forMenuScripts);
@@ -71,7 +83,8 @@ namespace LuaUtil
             {
             }
             sol::object getCopy(lua_State* L) const;
-            sol::object getReadOnly(lua_State* L) const;
+            // The value is cached only for the state of the storage, other states may read the same value in parallel
+            sol::object getReadOnly(lua_State* L, bool cache) const;
 
         private:
             std::string mSerializedValue;
@@ -95,9 +108,10 @@ namespace LuaUtil
             const Value& get(std::string_view key) const;
             void set(std::string_view key, const sol::object& value);
             void setAll(const sol::optional<sol::table>& values);
-            sol::table asTable();
+            sol::table asTable(lua_State* L);
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
+            void setLifeTime(LifeTime lifeTime);
 
             LuaStorage* mStorage;
             std::string mSectionName;
@@ -106,6 +120,8 @@ namespace LuaUtil
             std::vector<Callback> mMenuScriptsCallbacks; // menu callbacks are in a separate vector because we don't
                                                          // remove them in clear()
             LifeTime mLifeTime = Persistent;
+            // Changed since the storage was loaded or saved
+            bool mChanged = false;
             static Value sEmpty;
 
             void checkIfActive() const { mStorage->checkIfActive(); }
@@ -118,11 +134,22 @@ namespace LuaUtil
         };
 
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
+        sol::table collectSections(bool changedOnly);
+        void writeFull(const std::filesystem::path& path);
+        bool appendToJournal(const std::filesystem::path& path);
+        void replayJournal(const std::filesystem::path& path);
+        void markSynced(const std::filesystem::path& path);
 
         lua_State* mLua;
+        // Guards adding sections and callbacks, which may be done by several states using the storage
+        std::mutex mMutex;
         std::map<std::string_view, std::shared_ptr<Section>> mData;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
+        // The file which content matches the storage except for the changed sections
+        std::filesystem::path mSyncedPath;
+        // Changed sections that were removed from mData and so have to be removed from the file as well
+        std::vector<std::string> mRemovedChangedSections;
         bool mActive;
         void checkIfActive() const
         {
@@ -0,0 +1,173 @@
+#include "tracerecorder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+#include "configuration.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                switch (c)
+                {
+                    case '"':
+                        stream << "\\\"";
+                        break;
+                    case '\\':
+                        stream << "\\\\";
+                        break;
+                    case '\n':
+                        stream << "\\n";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            char buffer[8];
+                            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                            stream << buffer;
+                        }
+                        else
+                            stream << c;
+                }
+            }
+            stream << '"';
+        }
+
+        double toMicroseconds(TraceRecorder::Clock::duration value)
+        {
+            return std::chrono::duration<double, std::micro>(value).count();
+        }
+
+        void writeName(std::ostream& stream, const ScriptsConfiguration& configuration, int scriptIndex,
+            std::string_view function)
+        {
+            std::string name;
+            if (scriptIndex >= 0 && static_cast<std::size_t>(scriptIndex) < configuration.size())
+                name = configuration[scriptIndex].mScriptPath;
+            else
+                name = "[internal]";
+            name += ' ';
+            name += function;
+            writeString(stream, name);
+        }
+    }
+
+    TraceRecorder::TraceRecorder(std::size_t maxFrames)
+        : mMaxFrames(std::max<std::size_t>(maxFrames, 1))
+    {
+        mFrames.emplace_back();
+    }
+
+    void TraceRecorder::nextFrame()
+    {
+        if (mFrames.size() < mMaxFrames)
+        {
+            mFrames.emplace_back();
+            return;
+        }
+        // Reuse the memory of the oldest frame
+        Frame frame = std::move(mFrames.front());
+        mFrames.pop_front();
+        frame.mCalls.clear();
+        frame.mSamples.clear();
+        mFrames.push_back(std::move(frame));
+    }
+
+    std::uint32_t TraceRecorder::getFunctionId(std::string_view function)
+    {
+        const auto it = mFunctionIds.find(std::string(function));
+        if (it != mFunctionIds.end())
+            return it->second;
+        const std::uint32_t id = static_cast<std::uint32_t>(mFunctions.size());
+        const auto inserted = mFunctionIds.emplace(function, id).first;
+        // Keys of std::unordered_map are not moved on rehash
+        mFunctions.push_back(inserted->first);
+        return id;
+    }
+
+    void TraceRecorder::addCall(
+        int scriptIndex, std::string_view function, Clock::time_point start, Clock::time_point end)
+    {
+        mFrames.back().mCalls.push_back(Call{ start, end - start, scriptIndex, getFunctionId(function) });
+    }
+
+    void TraceRecorder::addSample(int scriptIndex, std::string_view function, Clock::time_point time)
+    {
+        mFrames.back().mSamples.push_back(Sample{ time, scriptIndex, getFunctionId(function) });
+    }
+
+    std::vector<TraceRecorder::CallStats> TraceRecorder::collectCallStats() const
+    {
+        std::map<std::pair<int, std::uint32_t>, CallStats> grouped;
+        for (const Frame& frame : mFrames)
+        {
+            for (const Call& call : frame.mCalls)
+            {
+                const auto [it, inserted] = grouped.try_emplace(std::make_pair(call.mScriptIndex, call.mFunction),
+                    CallStats{ .mScriptIndex = call.mScriptIndex, .mFunction = mFunctions[call.mFunction] });
+                CallStats& stats = it->second;
+                ++stats.mCount;
+                stats.mTotal += call.mDuration;
+                stats.mMax = std::max(stats.mMax, call.mDuration);
+            }
+        }
+        std::vector<CallStats> result;
+        result.reserve(grouped.size());
+        for (auto& [key, stats] : grouped)
+            result.push_back(stats);
+        std::stable_sort(result.begin(), result.end(),
+            [](const CallStats& l, const CallStats& r) { return l.mTotal > r.mTotal; });
+        return result;
+    }
+
+    void writeChromeTrace(std::ostream& stream, std::span<const TraceRecorder* const> recorders,
+        const ScriptsConfiguration& configuration)
+    {
+        stream << "{\"traceEvents\":[";
+        bool first = true;
+        const auto beginEvent = [&] {
+            if (!first)
+                stream << ",";
+            first = false;
+            stream << "\n{";
+        };
+        for (std::size_t threadId = 0; threadId < recorders.size(); ++threadId)
+        {
+            const TraceRecorder& recorder = *recorders[threadId];
+            beginEvent();
+            stream << "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadId
+                   << ",\"args\":{\"name\":\"Lua state " << threadId << "\"}}";
+            for (const TraceRecorder::Frame& frame : recorder.mFrames)
+            {
+                for (const TraceRecorder::Call& call : frame.mCalls)
+                {
+                    beginEvent();
+                    stream << "\"name\":";
+                    writeName(stream, configuration, call.mScriptIndex, recorder.mFunctions[call.mFunction]);
+                    stream << ",\"cat\":\"call\",\"ph\":\"X\",\"ts\":" << std::fixed
+                           << toMicroseconds(call.mStart.time_since_epoch())
+                           << ",\"dur\":" << toMicroseconds(call.mDuration) << ",\"pid\":0,\"tid\":" << threadId
+                           << "}";
+                }
+                for (const TraceRecorder::Sample& sample : frame.mSamples)
+                {
+                    beginEvent();
+                    stream << "\"name\":";
+                    writeName(stream, configuration, sample.mScriptIndex, recorder.mFunctions[sample.mFunction]);
+                    stream << ",\"cat\":\"sample\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << std::fixed
+                           << toMicroseconds(sample.mTime.time_since_epoch()) << ",\"pid\":0,\"tid\":" << threadId
+                           << "}";
+                }
+            }
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef COMPONENTS_LUA_TRACERECORDER_H
+#define COMPONENTS_LUA_TRACERECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace LuaUtil
+{
+    class ScriptsConfiguration;
+
+    // Records the durations of the script calls and the functions running at the instruction count hook of one Lua
+    // state for the last frames. Not thread safe, used only by the thread running the Lua state.
+    class TraceRecorder
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct CallStats
+        {
+            int mScriptIndex;
+            std::string_view mFunction;
+            std::size_t mCount = 0;
+            Clock::duration mTotal{ 0 };
+            Clock::duration mMax{ 0 };
+        };
+
+        explicit TraceRecorder(std::size_t maxFrames);
+
+        // Starts a new frame, the oldest one is dropped when there are more than maxFrames
+        void nextFrame();
+
+        void addCall(int scriptIndex, std::string_view function, Clock::time_point start, Clock::time_point end);
+
+        void addSample(int scriptIndex, std::string_view function, Clock::time_point time);
+
+        // Calls of the recorded frames grouped by the script and the function, the slowest first
+        std::vector<CallStats> collectCallStats() const;
+
+    private:
+        friend void writeChromeTrace(std::ostream& stream, std::span<const TraceRecorder* const> recorders,
+            const ScriptsConfiguration& configuration);
+
+        struct Call
+        {
+            Clock::time_point mStart;
+            Clock::duration mDuration;
+            int mScriptIndex;
+            std::uint32_t mFunction;
+        };
+
+        struct Sample
+        {
+            Clock::time_point mTime;
+            int mScriptIndex;
+            std::uint32_t mFunction;
+        };
+
+        struct Frame
+        {
+            std::vector<Call> mCalls;
+            std::vector<Sample> mSamples;
+        };
+
+        std::uint32_t getFunctionId(std::string_view function);
+
+        std::size_t mMaxFrames;
+        std::deque<Frame> mFrames;
+        std::unordered_map<std::string, std::uint32_t> mFunctionIds;
+        std::vector<std::string_view> mFunctions;
+    };
+
+    // Writes the events of all the recorders as a file for chrome://tracing, https://ui.perfetto.dev or
+    // https://www.speedscope.app
+    void writeChromeTrace(std::ostream& stream, std::span<const TraceRecorder* const> recorders,
+        const ScriptsConfiguration& configuration);
+}
+
+#endif // COMPONENTS_LUA_TRACERECORDER_H
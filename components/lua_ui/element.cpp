@@ -1,7 +1,12 @@
 #include "element.hpp"
 
+#include <map>
+#include <optional>
+
 #include <MyGUI_Gui.h>
 
+#include <components/lua/luastate.hpp>
+
 #include "content.hpp"
 #include "util.hpp"
 #include "widget.hpp"
@@ -112,43 +117,55 @@ namespace LuaUi
             }
             ContentView content(LuaUtil::cast<sol::table>(contentObj));
             result.resize(content.size());
-            size_t minSize = std::min(children.size(), content.size());
-            for (size_t i = 0; i < minSize; i++)
+
+            // Named children keep their widgets when other children are inserted or removed before them,
+            // unnamed ones are matched by position
+            std::vector<bool> reused(children.size(), false);
+            std::map<std::string_view, size_t> namedChildren;
+            for (size_t i = 0; i < children.size(); i++)
+            {
+                const std::string& name = children[i]->widget()->getName();
+                if (!name.empty())
+                    namedChildren.emplace(name, i);
+            }
+            // Children which are not reused are destroyed after matching all of them, so the names stay valid
+            const auto findReusable = [&](size_t index, const sol::table& layout) -> std::optional<size_t> {
+                const std::string name = layout.get_or(LayoutKeys::name, std::string());
+                const auto it = name.empty() ? namedChildren.end() : namedChildren.find(name);
+                if (it != namedChildren.end() && !reused[it->second])
+                    index = it->second;
+                if (index >= children.size() || reused[index] || children[index]->isRoot()
+                    || children[index]->widget()->getName() != name
+                    || children[index]->widget()->getTypeName() != widgetType(layout))
+                    return std::nullopt;
+                return index;
+            };
+
+            for (size_t i = 0; i < content.size(); i++)
             {
-                WidgetExtension* ext = children[i];
                 sol::object child = content.at(i);
                 if (child.is<Element>())
                 {
                     WidgetExtension* root = pluckElementRoot(child, depth);
-                    if (ext != root)
-                        destroyChild(ext);
+                    const auto it = std::find(children.begin(), children.end(), root);
+                    if (it != children.end())
+                        reused[it - children.begin()] = true;
                     result[i] = root;
+                    continue;
                 }
-                else
+                sol::table newLayout = child.as<sol::table>();
+                if (const std::optional<size_t> index = findReusable(i, newLayout))
                 {
-                    sol::table newLayout = child.as<sol::table>();
-                    if (ext->widget()->getTypeName() == widgetType(newLayout))
-                    {
-                        updateWidget(ext, newLayout, depth);
-                    }
-                    else
-                    {
-                        destroyChild(ext);
-                        ext = createWidget(newLayout, false, depth);
-                    }
-                    result[i] = ext;
+                    reused[*index] = true;
+                    updateWidget(children[*index], newLayout, depth);
+                    result[i] = children[*index];
                 }
-            }
-            for (size_t i = minSize; i < children.size(); i++)
-                destroyChild(children[i]);
-            for (size_t i = minSize; i < content.size(); i++)
-            {
-                sol::object child = content.at(i);
-                if (child.is<Element>())
-                    result[i] = pluckElementRoot(child, depth);
                 else
-                    result[i] = createWidget(child.as<sol::table>(), false, depth);
+                    result[i] = createWidget(newLayout, false, depth);
             }
+            for (size_t i = 0; i < children.size(); i++)
+                if (!reused[i])
+                    destroyChild(children[i]);
             return result;
         }
 
@@ -260,6 +277,7 @@ namespace LuaUi
         if (mState == New)
         {
             assert(!mRoot);
+            const ProfileScope profile(*this);
             mRoot = createWidget(layout(), true, depth);
             mLayer = setLayer(mRoot, layout());
             updateRootCoord(mRoot);
@@ -272,6 +290,7 @@ namespace LuaUi
         if (mState == Update)
         {
             assert(mRoot);
+            const ProfileScope profile(*this);
             if (mRoot->widget()->getTypeName() != widgetType(layout()))
             {
                 destroyRoot(mRoot);
@@ -294,6 +313,36 @@ namespace LuaUi
         }
     }
 
+    std::string Element::getName() const
+    {
+        if (mRoot == nullptr)
+            return std::string();
+        std::string name = mRoot->widget()->getTypeName();
+        const std::string& widgetName = mRoot->widget()->getName();
+        if (!widgetName.empty())
+            name += " \"" + widgetName + "\"";
+        if (!mLayer.empty())
+            name += " in " + mLayer;
+        return name;
+    }
+
+    Element::ProfileScope::ProfileScope(Element& element)
+        : mElement(LuaUtil::LuaState::isProfilerEnabled() ? &element : nullptr)
+        , mStart(mElement != nullptr ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+    {
+    }
+
+    Element::ProfileScope::~ProfileScope()
+    {
+        if (mElement == nullptr)
+            return;
+        const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - mStart;
+        UpdateStats& stats = mElement->mUpdateStats;
+        ++stats.mCount;
+        stats.mTotal += duration;
+        stats.mMax = std::max(stats.mMax, duration);
+    }
+
     void Element::destroy()
     {
         if (mState != Destroyed)
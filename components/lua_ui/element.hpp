@@ -1,6 +1,8 @@
 #ifndef OPENMW_LUAUI_ELEMENT
 #define OPENMW_LUAUI_ELEMENT
 
+#include <chrono>
+
 #include "widget.hpp"
 
 namespace LuaUi
@@ -38,14 +40,39 @@ namespace LuaUi
 
         void destroy();
 
+        /// The widget type, name and layer of the root, to identify the element in the profiler
+        std::string getName() const;
+
+        /// Time spent on creating and updating the widgets, collected when the Lua profiler is enabled
+        struct UpdateStats
+        {
+            std::size_t mCount = 0;
+            std::chrono::steady_clock::duration mTotal{};
+            std::chrono::steady_clock::duration mMax{};
+        };
+
+        const UpdateStats& getUpdateStats() const { return mUpdateStats; }
+
         friend void clearGameInterface();
         friend void clearMenuInterface();
 
     private:
+        class ProfileScope
+        {
+        public:
+            explicit ProfileScope(Element& element);
+            ~ProfileScope();
+
+        private:
+            Element* mElement;
+            std::chrono::steady_clock::time_point mStart;
+        };
+
         Element(sol::table layout);
         sol::table layout() { return LuaUtil::cast<sol::table>(mLayout); }
         static std::map<Element*, std::shared_ptr<Element>> sGameElements;
         static std::map<Element*, std::shared_ptr<Element>> sMenuElements;
+        UpdateStats mUpdateStats;
     };
 }
 
@@ -18,6 +18,7 @@ namespace LuaUi
         void initialize() override;
         void deinitialize() override;
         void updateProperties() override;
+        bool skipUnchangedProperties() const override { return false; }
         void updateCoord() override;
         void updateChildren() override;
         MyGUI::IntSize calculateSize() const override;
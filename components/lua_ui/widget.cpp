@@ -1,10 +1,52 @@
 #include "widget.hpp"
 
+#include <algorithm>
+
 #include <SDL_events.h>
 #include <components/sdlutil/sdlmappings.hpp>
 
 namespace LuaUi
 {
+    namespace
+    {
+        using PropertiesSnapshot = std::vector<std::pair<sol::object, sol::object>>;
+
+        bool rawEqual(const sol::object& l, const sol::object& r)
+        {
+            if (l.get_type() != r.get_type())
+                return false;
+            if (l.get_type() == sol::type::lua_nil)
+                return true;
+            lua_State* lua = l.lua_state();
+            sol::stack::push(lua, l);
+            sol::stack::push(lua, r);
+            const bool result = lua_rawequal(lua, -1, -2) == 1;
+            lua_pop(lua, 2);
+            return result;
+        }
+
+        // Values are compared by identity, so the tables and userdata have to be replaced to count as a change
+        bool appendProperties(const sol::object& props, PropertiesSnapshot& snapshot)
+        {
+            if (props == sol::nil)
+                return true;
+            if (!props.is<sol::table>())
+                return false;
+            for (const auto& [key, value] : props.as<sol::table>())
+                snapshot.emplace_back(key, value);
+            // Separate the properties from the template properties
+            snapshot.emplace_back(sol::nil, sol::nil);
+            return true;
+        }
+
+        bool isSameSnapshot(const PropertiesSnapshot& l, const PropertiesSnapshot& r)
+        {
+            return std::equal(l.begin(), l.end(), r.begin(), r.end(), [](const auto& lEntry, const auto& rEntry) {
+                return rawEqual(lEntry.first, rEntry.first) && rawEqual(lEntry.second, rEntry.second);
+            });
+        }
+    }
+
     WidgetExtension::WidgetExtension()
         : mForcePosition(false)
         , mForceSize(false)
@@ -283,7 +325,18 @@ namespace LuaUi
     void WidgetExtension::setProperties(const sol::object& props)
     {
         mProperties = props;
+
+        // Scripts often update a whole layout to change a few properties, skip re-applying everything else
+        PropertiesSnapshot snapshot;
+        const bool canSkip = skipUnchangedProperties() && appendProperties(mProperties, snapshot)
+            && appendProperties(mTemplateProperties, snapshot);
+        if (canSkip && mAppliedProperties.has_value() && isSameSnapshot(*mAppliedProperties, snapshot))
+            return;
+
+        mAppliedProperties.reset();
         updateProperties();
+        if (canSkip)
+            mAppliedProperties = std::move(snapshot);
     }
 
     void WidgetExtension::updateProperties()
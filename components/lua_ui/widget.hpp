@@ -3,6 +3,8 @@
 
 #include <functional>
 #include <map>
+#include <optional>
+#include <vector>
 
 #include <MyGUI_Widget.h>
 #include <sol/sol.hpp>
@@ -104,6 +106,9 @@ namespace LuaUi
         virtual void updateProperties();
         virtual void updateChildren() {}
 
+        // Widgets with a state changed by the user, e. g. a typed text, have to apply properties on every update
+        virtual bool skipUnchangedProperties() const { return true; }
+
         lua_State* lua() const { return mLua; }
 
         void triggerEvent(std::string_view name, sol::object argument) const;
@@ -153,6 +158,8 @@ namespace LuaUi
         sol::table mLayout;
         sol::object mProperties;
         sol::object mTemplateProperties;
+        // Shallow copy of the properties and the template properties at the last updateProperties call
+        std::optional<std::vector<std::pair<sol::object, sol::object>>> mAppliedProperties;
         sol::object mExternal;
         WidgetExtension* mParent;
         bool mTemplateChild;
@@ -16,6 +16,8 @@ namespace LuaUi
         LuaWindow();
         void updateTemplate() override;
         void updateProperties() override;
+        // Updating the layout resets the position and size changed by dragging
+        bool skipUnchangedProperties() const override { return false; }
 
     private:
         LuaText* mCaption;
@@ -0,0 +1,258 @@
+#ifndef OPENMW_COMPONENTS_MISC_CHUNKEDLIST_H
+#define OPENMW_COMPONENTS_MISC_CHUNKEDLIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Sequence container with the guarantees of std::list for the element addresses and iterators
+    /// @par Elements are stored in contiguous chunks growing twice up to maxChunkSize, so iteration doesn't jump
+    /// across the heap for every element. An element never moves: adding and erasing elements doesn't invalidate
+    /// pointers and iterators to the other ones. Erased element leaves a hole in the chunk that is skipped by the
+    /// iteration and reclaimed only when it is at the end.
+    template <class T, std::size_t maxChunkSize = 256>
+    class ChunkedList
+    {
+        using Chunk = std::vector<std::optional<T>>;
+
+        static constexpr std::size_t sFirstChunkSize = 4;
+        static constexpr std::size_t sEnd = std::numeric_limits<std::size_t>::max();
+
+        template <bool isConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<isConst, const T*, T*>;
+            using reference = std::conditional_t<isConst, const T&, T&>;
+
+            Iterator() = default;
+
+            template <bool otherConst, class = std::enable_if_t<isConst && !otherConst>>
+            Iterator(const Iterator<otherConst>& other)
+                : mList(other.mList)
+                , mChunk(other.mChunk)
+                , mSlot(other.mSlot)
+            {
+            }
+
+            reference operator*() const { return *mList->mChunks[mChunk][mSlot]; }
+
+            pointer operator->() const { return &**this; }
+
+            Iterator& operator++()
+            {
+                assert(mChunk != sEnd);
+                ++mSlot;
+                skipForward();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            Iterator& operator--()
+            {
+                if (mChunk == sEnd)
+                {
+                    assert(!mList->mChunks.empty());
+                    mChunk = mList->mChunks.size() - 1;
+                    mSlot = mList->mChunks[mChunk].size();
+                }
+                while (true)
+                {
+                    while (mSlot > 0)
+                    {
+                        --mSlot;
+                        if (mList->mChunks[mChunk][mSlot].has_value())
+                            return *this;
+                    }
+                    assert(mChunk > 0);
+                    --mChunk;
+                    mSlot = mList->mChunks[mChunk].size();
+                }
+            }
+
+            Iterator operator--(int)
+            {
+                Iterator result = *this;
+                --*this;
+                return result;
+            }
+
+            friend bool operator==(const Iterator& l, const Iterator& r)
+            {
+                return l.mChunk == r.mChunk && l.mSlot == r.mSlot;
+            }
+
+        private:
+            friend class ChunkedList;
+
+            template <bool>
+            friend class Iterator;
+
+            using List = std::conditional_t<isConst, const ChunkedList, ChunkedList>;
+
+            List* mList = nullptr;
+            std::size_t mChunk = sEnd;
+            std::size_t mSlot = 0;
+
+            Iterator(List* list, std::size_t chunk, std::size_t slot)
+                : mList(list)
+                , mChunk(chunk)
+                , mSlot(slot)
+            {
+            }
+
+            void skipForward()
+            {
+                for (; mChunk < mList->mChunks.size(); ++mChunk, mSlot = 0)
+                    for (; mSlot < mList->mChunks[mChunk].size(); ++mSlot)
+                        if (mList->mChunks[mChunk][mSlot].has_value())
+                            return;
+                mChunk = sEnd;
+                mSlot = 0;
+            }
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        ChunkedList() = default;
+
+        ChunkedList(const ChunkedList& other)
+        {
+            for (const T& value : other)
+                push_back(value);
+        }
+
+        ChunkedList(ChunkedList&& other) noexcept
+            : mChunks(std::move(other.mChunks))
+            , mSize(std::exchange(other.mSize, 0))
+        {
+            other.mChunks.clear();
+        }
+
+        ChunkedList& operator=(const ChunkedList& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (const T& value : other)
+                    push_back(value);
+            }
+            return *this;
+        }
+
+        ChunkedList& operator=(ChunkedList&& other) noexcept
+        {
+            mChunks = std::move(other.mChunks);
+            other.mChunks.clear();
+            mSize = std::exchange(other.mSize, 0);
+            return *this;
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        iterator begin() { return makeBegin<false>(this); }
+
+        iterator end() { return iterator(this, sEnd, 0); }
+
+        const_iterator begin() const { return makeBegin<true>(this); }
+
+        const_iterator end() const { return const_iterator(this, sEnd, 0); }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        T& front() { return *begin(); }
+
+        const T& front() const { return *begin(); }
+
+        // The last slot is never a hole
+        T& back() { return *mChunks.back().back(); }
+
+        const T& back() const { return *mChunks.back().back(); }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (mChunks.empty() || mChunks.back().size() == mChunks.back().capacity())
+            {
+                const std::size_t chunkSize = mChunks.empty()
+                    ? sFirstChunkSize
+                    : std::min(mChunks.back().capacity() * 2, std::max(maxChunkSize, sFirstChunkSize));
+                mChunks.emplace_back().reserve(chunkSize);
+            }
+            // Doesn't reallocate, so the other elements keep their addresses
+            T& result = mChunks.back().emplace_back(std::in_place, std::forward<Args>(args)...).value();
+            ++mSize;
+            return result;
+        }
+
+        iterator erase(const_iterator it)
+        {
+            assert(it.mList == this && it.mChunk != sEnd);
+            iterator next(this, it.mChunk, it.mSlot);
+            ++next;
+            mChunks[it.mChunk][it.mSlot].reset();
+            --mSize;
+            while (!mChunks.empty())
+            {
+                Chunk& chunk = mChunks.back();
+                while (!chunk.empty() && !chunk.back().has_value())
+                    chunk.pop_back();
+                if (!chunk.empty())
+                    break;
+                mChunks.pop_back();
+            }
+            return next;
+        }
+
+        void clear()
+        {
+            mChunks.clear();
+            mSize = 0;
+        }
+
+    private:
+        std::vector<Chunk> mChunks;
+        std::size_t mSize = 0;
+
+        template <bool isConst, class List>
+        static Iterator<isConst> makeBegin(List* list)
+        {
+            Iterator<isConst> result(list, 0, 0);
+            result.skipForward();
+            return result;
+        }
+    };
+}
+
+#endif
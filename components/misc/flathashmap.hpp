@@ -0,0 +1,280 @@
+#ifndef OPENMW_COMPONENTS_MISC_FLATHASHMAP_H
+#define OPENMW_COMPONENTS_MISC_FLATHASHMAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Hash map with open addressing and linear probing in a single array
+    /// @par Each slot stores the hash of its key, so lookups compare the keys only when the hashes are equal and growth
+    /// doesn't hash the keys again. The hash is mixed before use, identity hashes of integers are fine. Key and
+    /// Value have to be default constructible. Inserting and erasing invalidate pointers and iterators.
+    template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+    class FlatHashMap
+    {
+    public:
+        using value_type = std::pair<Key, Value>;
+
+    private:
+        struct Slot
+        {
+            std::size_t mHash = 0;
+            bool mUsed = false;
+            value_type mValue;
+        };
+
+        static constexpr std::size_t sMinCapacity = 16;
+        static constexpr std::size_t sNotFound = std::numeric_limits<std::size_t>::max();
+
+        template <class H, class = void>
+        struct IsTransparent : std::false_type
+        {
+        };
+
+        template <class H>
+        struct IsTransparent<H, std::void_t<typename H::is_transparent>> : std::true_type
+        {
+        };
+
+        // Keys of other types are converted to Key unless the hash supports heterogeneous lookup
+        template <class K>
+        static decltype(auto) toLookupKey(const K& key)
+        {
+            if constexpr (IsTransparent<Hash>::value || std::is_same_v<K, Key>)
+                return (key);
+            else
+                return Key(key);
+        }
+
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = FlatHashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            const_iterator() = default;
+
+            reference operator*() const { return mSlot->mValue; }
+
+            pointer operator->() const { return &mSlot->mValue; }
+
+            const_iterator& operator++()
+            {
+                ++mSlot;
+                skipUnused();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            friend bool operator==(const const_iterator& l, const const_iterator& r) { return l.mSlot == r.mSlot; }
+
+        private:
+            friend class FlatHashMap;
+
+            const Slot* mSlot = nullptr;
+            const Slot* mEnd = nullptr;
+
+            const_iterator(const Slot* slot, const Slot* end)
+                : mSlot(slot)
+                , mEnd(end)
+            {
+                skipUnused();
+            }
+
+            void skipUnused()
+            {
+                while (mSlot != mEnd && !mSlot->mUsed)
+                    ++mSlot;
+            }
+        };
+
+        FlatHashMap() = default;
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        const_iterator begin() const { return const_iterator(mSlots.data(), mSlots.data() + mSlots.size()); }
+
+        const_iterator end() const
+        {
+            const Slot* const end = mSlots.data() + mSlots.size();
+            return const_iterator(end, end);
+        }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        template <class K>
+        const Value* find(const K& key) const
+        {
+            const auto& lookupKey = toLookupKey(key);
+            const std::size_t index = findIndex(lookupKey, mHash(lookupKey));
+            if (index == sNotFound)
+                return nullptr;
+            return &mSlots[index].mValue.second;
+        }
+
+        template <class K>
+        Value* find(const K& key)
+        {
+            return const_cast<Value*>(std::as_const(*this).find(key));
+        }
+
+        template <class K>
+        bool contains(const K& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        /// Adds the value if there is no such key, returns the value for the key and whether it was added
+        template <class K, class V>
+        std::pair<Value*, bool> emplace(K&& key, V&& value)
+        {
+            const auto& lookupKey = toLookupKey(key);
+            const std::size_t hash = mHash(lookupKey);
+            if (const std::size_t index = findIndex(lookupKey, hash); index != sNotFound)
+                return { &mSlots[index].mValue.second, false };
+            Slot& slot = insertNew(hash);
+            slot.mValue.first = Key(std::forward<K>(key));
+            slot.mValue.second = Value(std::forward<V>(value));
+            return { &slot.mValue.second, true };
+        }
+
+        template <class K>
+        Value& operator[](K&& key)
+        {
+            const auto& lookupKey = toLookupKey(key);
+            const std::size_t hash = mHash(lookupKey);
+            if (const std::size_t index = findIndex(lookupKey, hash); index != sNotFound)
+                return mSlots[index].mValue.second;
+            Slot& slot = insertNew(hash);
+            slot.mValue.first = Key(std::forward<K>(key));
+            return slot.mValue.second;
+        }
+
+        template <class K>
+        std::size_t erase(const K& key)
+        {
+            const auto& lookupKey = toLookupKey(key);
+            std::size_t index = findIndex(lookupKey, mHash(lookupKey));
+            if (index == sNotFound)
+                return 0;
+            // Backward shift deletion keeps the probe sequences without holes
+            const std::size_t mask = mSlots.size() - 1;
+            for (std::size_t next = (index + 1) & mask; mSlots[next].mUsed; next = (next + 1) & mask)
+            {
+                const std::size_t desired = getIndex(mSlots[next].mHash);
+                if (((next - desired) & mask) >= ((next - index) & mask))
+                {
+                    mSlots[index] = std::move(mSlots[next]);
+                    index = next;
+                }
+            }
+            mSlots[index] = Slot{};
+            --mSize;
+            return 1;
+        }
+
+        void clear()
+        {
+            mSlots.clear();
+            mShift = std::numeric_limits<std::uint64_t>::digits;
+            mSize = 0;
+        }
+
+        void reserve(std::size_t size)
+        {
+            std::size_t capacity = sMinCapacity;
+            while (!fits(size, capacity))
+                capacity *= 2;
+            if (capacity > mSlots.size())
+                rehash(capacity);
+        }
+
+    private:
+        std::vector<Slot> mSlots;
+        unsigned mShift = std::numeric_limits<std::uint64_t>::digits;
+        std::size_t mSize = 0;
+        [[no_unique_address]] Hash mHash;
+        [[no_unique_address]] Equal mEqual;
+
+        static bool fits(std::size_t size, std::size_t capacity) { return size * 4 <= capacity * 3; }
+
+        std::size_t getIndex(std::size_t hash) const
+        {
+            // Fibonacci hashing spreads the values of weak hashes over the table
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> mShift);
+        }
+
+        template <class K>
+        std::size_t findIndex(const K& key, std::size_t hash) const
+        {
+            if (mSlots.empty())
+                return sNotFound;
+            const std::size_t mask = mSlots.size() - 1;
+            for (std::size_t index = getIndex(hash);; index = (index + 1) & mask)
+            {
+                const Slot& slot = mSlots[index];
+                if (!slot.mUsed)
+                    return sNotFound;
+                if (slot.mHash == hash && mEqual(slot.mValue.first, key))
+                    return index;
+            }
+        }
+
+        Slot& insertNew(std::size_t hash)
+        {
+            if (!fits(mSize + 1, mSlots.size()))
+                rehash(mSlots.empty() ? sMinCapacity : mSlots.size() * 2);
+            Slot& slot = findFree(hash);
+            slot.mHash = hash;
+            slot.mUsed = true;
+            ++mSize;
+            return slot;
+        }
+
+        Slot& findFree(std::size_t hash)
+        {
+            const std::size_t mask = mSlots.size() - 1;
+            std::size_t index = getIndex(hash);
+            while (mSlots[index].mUsed)
+                index = (index + 1) & mask;
+            return mSlots[index];
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            assert((capacity & (capacity - 1)) == 0);
+            std::vector<Slot> slots(capacity);
+            std::swap(slots, mSlots);
+            mShift = std::numeric_limits<std::uint64_t>::digits;
+            for (std::size_t i = capacity; i > 1; i /= 2)
+                --mShift;
+            for (Slot& slot : slots)
+                if (slot.mUsed)
+                    findFree(slot.mHash) = std::move(slot);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "sampleconversion.hpp"
+
+#include <algorithm>
+
+namespace Misc
+{
+    namespace
+    {
+        std::int16_t toInt16(float value)
+        {
+            return static_cast<std::int16_t>(std::min(std::max(value * 32768.0f, -32768.0f), 32767.0f));
+        }
+
+        std::int16_t toInt16(std::int16_t value)
+        {
+            return value;
+        }
+
+        template <class T>
+        void interleave(std::span<const T* const> planes, std::size_t count, std::int16_t* output)
+        {
+            // Mono and stereo are the most common layouts, loops with a known number of channels are vectorized
+            switch (planes.size())
+            {
+                case 1:
+                {
+                    const T* const mono = planes[0];
+                    for (std::size_t i = 0; i < count; ++i)
+                        output[i] = toInt16(mono[i]);
+                    return;
+                }
+                case 2:
+                {
+                    const T* const left = planes[0];
+                    const T* const right = planes[1];
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        output[2 * i] = toInt16(left[i]);
+                        output[2 * i + 1] = toInt16(right[i]);
+                    }
+                    return;
+                }
+            }
+            const std::size_t channels = planes.size();
+            for (std::size_t channel = 0; channel < channels; ++channel)
+            {
+                const T* const plane = planes[channel];
+                for (std::size_t i = 0; i < count; ++i)
+                    output[i * channels + channel] = toInt16(plane[i]);
+            }
+        }
+    }
+
+    void convertSamples(std::span<const float> input, std::int16_t* output)
+    {
+        const float* const data = input.data();
+        const std::size_t size = input.size();
+        for (std::size_t i = 0; i < size; ++i)
+            output[i] = toInt16(data[i]);
+    }
+
+    void interleaveSamples(std::span<const float* const> planes, std::size_t count, std::int16_t* output)
+    {
+        interleave(planes, count, output);
+    }
+
+    void interleaveSamples(std::span<const std::int16_t* const> planes, std::size_t count, std::int16_t* output)
+    {
+        interleave(planes, count, output);
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef OPENMW_COMPONENTS_MISC_SAMPLECONVERSION_H
+#define OPENMW_COMPONENTS_MISC_SAMPLECONVERSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Misc
+{
+    // Conversions of decoded audio samples laid out to be vectorized by the compiler. Float samples are expected in
+    // [-1, 1], values outside are clamped.
+
+    /// Converts interleaved float samples into 16 bit integer ones.
+    void convertSamples(std::span<const float> input, std::int16_t* output);
+
+    /// Interleaves the given number of samples per channel, each plane holding the samples of one channel.
+    void interleaveSamples(std::span<const float* const> planes, std::size_t count, std::int16_t* output);
+
+    void interleaveSamples(std::span<const std::int16_t* const> planes, std::size_t count, std::int16_t* output);
+}
+
+#endif
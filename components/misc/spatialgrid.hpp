@@ -0,0 +1,114 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec2f>
+#include <osg/Vec2i>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Uniform 2d grid of values for range queries
+    /// @par Each value is stored in the grid cell containing its position. A query visits the values in the cells
+    /// overlapping the bounding square of the queried circle, so the caller has to check the exact distance.
+    template <class T>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize)
+            : mCellSize(cellSize)
+        {
+            assert(cellSize > 0);
+        }
+
+        std::size_t size() const { return mValues.size(); }
+
+        /// Add a value or move already added one to the new position
+        void update(const T& value, const osg::Vec2f& position)
+        {
+            const osg::Vec2i cell = getCell(position);
+            const auto [it, inserted] = mValues.emplace(value, cell);
+            if (!inserted)
+            {
+                if (it->second == cell)
+                    return;
+                removeFromCell(it->second, value);
+                it->second = cell;
+            }
+            mCells[cell].push_back(value);
+        }
+
+        void remove(const T& value)
+        {
+            const auto it = mValues.find(value);
+            if (it == mValues.end())
+                return;
+            removeFromCell(it->second, value);
+            mValues.erase(it);
+        }
+
+        void clear()
+        {
+            mValues.clear();
+            mCells.clear();
+        }
+
+        /// Call the function for each value in the cells overlapping the bounding square of the circle
+        template <class Function>
+        void forEachCandidate(const osg::Vec2f& center, float radius, Function&& function) const
+        {
+            const float minX = std::floor((center.x() - radius) / mCellSize);
+            const float minY = std::floor((center.y() - radius) / mCellSize);
+            const float maxX = std::floor((center.x() + radius) / mCellSize);
+            const float maxY = std::floor((center.y() + radius) / mCellSize);
+
+            // Visit non-empty cells directly when the range covers more cells than there are
+            if ((maxX - minX + 1) * (maxY - minY + 1) > static_cast<float>(mCells.size()))
+            {
+                for (const auto& [cell, values] : mCells)
+                    if (cell.x() >= minX && cell.x() <= maxX && cell.y() >= minY && cell.y() <= maxY)
+                        for (const T& value : values)
+                            function(value);
+                return;
+            }
+
+            for (int x = static_cast<int>(minX); x <= static_cast<int>(maxX); ++x)
+            {
+                const auto begin = mCells.lower_bound(osg::Vec2i(x, static_cast<int>(minY)));
+                const auto end = mCells.upper_bound(osg::Vec2i(x, static_cast<int>(maxY)));
+                for (auto it = begin; it != end; ++it)
+                    for (const T& value : it->second)
+                        function(value);
+            }
+        }
+
+    private:
+        float mCellSize;
+        std::unordered_map<T, osg::Vec2i> mValues;
+        std::map<osg::Vec2i, std::vector<T>> mCells;
+
+        osg::Vec2i getCell(const osg::Vec2f& position) const
+        {
+            return osg::Vec2i(static_cast<int>(std::floor(position.x() / mCellSize)),
+                static_cast<int>(std::floor(position.y() / mCellSize)));
+        }
+
+        void removeFromCell(const osg::Vec2i& cell, const T& value)
+        {
+            const auto it = mCells.find(cell);
+            assert(it != mCells.end());
+            std::vector<T>& values = it->second;
+            values.erase(std::find(values.begin(), values.end(), value));
+            if (values.empty())
+                mCells.erase(it);
+        }
+    };
+}
+
+#endif
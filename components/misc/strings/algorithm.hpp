@@ -24,22 +24,25 @@ namespace Misc::StringUtils
 
     inline bool ciLess(std::string_view x, std::string_view y)
     {
-        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), CiCharLess());
+        const std::size_t offset = Details::ciEqualPrefix(x.data(), y.data(), std::min(x.size(), y.size()));
+        return std::lexicographical_compare(x.begin() + offset, x.end(), y.begin() + offset, y.end(), CiCharLess());
     }
 
     inline bool ciEqual(std::string_view x, std::string_view y)
     {
         if (std::size(x) != std::size(y))
             return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        const std::size_t offset = Details::ciEqualPrefix(x.data(), y.data(), x.size());
+        return std::equal(std::begin(x) + offset, std::end(x), std::begin(y) + offset,
+            [](char l, char r) { return toLower(l) == toLower(r); });
     }
     inline bool ciEqual(std::u8string_view x, std::u8string_view y)
     {
         if (std::size(x) != std::size(y))
             return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        const std::size_t offset = Details::ciEqualPrefix(x.data(), y.data(), x.size());
+        return std::equal(std::begin(x) + offset, std::end(x), std::begin(y) + offset,
+            [](char l, char r) { return toLower(l) == toLower(r); });
     }
 
     inline bool ciStartsWith(std::string_view value, std::string_view prefix)
@@ -145,15 +148,11 @@ namespace Misc::StringUtils
 
     inline bool ciEndsWith(std::string_view s, std::string_view suffix)
     {
-        return s.size() >= suffix.size() && std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(), [](char l, char r) {
-            return toLower(l) == toLower(r);
-        });
+        return s.size() >= suffix.size() && ciEqual(s.substr(s.size() - suffix.size()), suffix);
     }
     inline bool ciEndsWith(std::u8string_view s, std::u8string_view suffix)
     {
-        return s.size() >= suffix.size() && std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(), [](char l, char r) {
-            return toLower(l) == toLower(r);
-        });
+        return s.size() >= suffix.size() && ciEqual(s.substr(s.size() - suffix.size()), suffix);
     }
 
     inline void trim(std::string& s)
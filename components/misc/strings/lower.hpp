@@ -1,6 +1,9 @@
 #ifndef COMPONENTS_MISC_STRINGS_LOWER_H
 #define COMPONENTS_MISC_STRINGS_LOWER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
@@ -32,16 +35,68 @@ namespace Misc::StringUtils
         return tolowermap[static_cast<unsigned char>(c)];
     }
 
+    namespace Details
+    {
+        using Word = std::uint64_t;
+
+        template <class T>
+        inline Word loadWord(const T* data)
+        {
+            Word result;
+            std::memcpy(&result, data, sizeof(result));
+            return result;
+        }
+
+        /// Lower cases the bytes of a word like toLower does for each of them
+        inline constexpr Word toLower(Word word)
+        {
+            constexpr Word lowBits = 0x0101010101010101;
+            constexpr Word highBits = 0x8080808080808080;
+            // Adding to the lower 7 bits of each byte sets its high bit when the byte is at least 'A' or 'Z' + 1
+            const Word lower7Bits = word & ~highBits;
+            const Word atLeastA = lower7Bits + (0x80 - 'A') * lowBits;
+            const Word afterZ = lower7Bits + (0x80 - 'Z' - 1) * lowBits;
+            const Word upperCase = atLeastA & ~afterZ & ~word & highBits;
+            return word | (upperCase >> 2);
+        }
+
+        template <class T>
+        inline void lowerCaseInPlace(T* data, std::size_t size)
+        {
+            std::size_t i = 0;
+            for (; i + sizeof(Word) <= size; i += sizeof(Word))
+            {
+                const Word word = toLower(loadWord(data + i));
+                std::memcpy(data + i, &word, sizeof(word));
+            }
+            for (; i < size; ++i)
+                data[i] = StringUtils::toLower(data[i]);
+        }
+
+        /// Returns an offset before which the strings are equal when lower cased, the following word differs
+        template <class T>
+        inline std::size_t ciEqualPrefix(const T* x, const T* y, std::size_t size)
+        {
+            std::size_t i = 0;
+            for (; i + sizeof(Word) <= size; i += sizeof(Word))
+            {
+                const Word left = loadWord(x + i);
+                const Word right = loadWord(y + i);
+                if (left != right && toLower(left) != toLower(right))
+                    break;
+            }
+            return i;
+        }
+    }
+
     /// Transforms input string to lower case w/o copy
     inline void lowerCaseInPlace(std::string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        Details::lowerCaseInPlace(str.data(), str.size());
     }
     inline void lowerCaseInPlace(std::u8string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        Details::lowerCaseInPlace(str.data(), str.size());
     }
 
     /// Returns lower case copy of input string
@@ -0,0 +1,142 @@
+#include "taskgraph.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace Misc
+{
+    TaskGraph::TaskId TaskGraph::add(
+        std::string name, Thread thread, std::vector<TaskId> dependencies, std::function<void()> function)
+    {
+        const TaskId id = mTasks.size();
+        for (const TaskId dependency : dependencies)
+        {
+            if (dependency >= id)
+                throw std::invalid_argument("Task \"" + name + "\" depends on a task which is not added yet");
+            mTasks[dependency].mDependents.push_back(id);
+        }
+
+        Task& task = mTasks.emplace_back();
+        task.mName = std::move(name);
+        task.mThread = thread;
+        task.mFunction = std::move(function);
+        task.mNumDependencies = dependencies.size();
+        return id;
+    }
+
+    std::vector<TaskGraph::Timing> TaskGraph::run()
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::mutex mutex;
+        std::condition_variable completed;
+        std::vector<std::size_t> remaining(mTasks.size());
+        std::vector<std::optional<Timing>> timings(mTasks.size());
+        std::deque<TaskId> callerTasks;
+        std::vector<std::thread> threads;
+        std::size_t numRunning = 0;
+        std::size_t numCompleted = 0;
+        std::exception_ptr error;
+
+        const auto execute = [&](TaskId id) {
+            const auto taskStart = std::chrono::steady_clock::now();
+            std::exception_ptr taskError;
+            try
+            {
+                mTasks[id].mFunction();
+            }
+            catch (...)
+            {
+                taskError = std::current_exception();
+            }
+            const auto taskEnd = std::chrono::steady_clock::now();
+            return std::make_pair(Timing{ mTasks[id].mName, taskStart - start, taskEnd - taskStart }, taskError);
+        };
+
+        // Called with the mutex locked
+        std::function<void(TaskId)> schedule;
+        const auto complete = [&](TaskId id, Timing&& timing, std::exception_ptr taskError) {
+            --numRunning;
+            if (taskError != nullptr)
+            {
+                if (error == nullptr)
+                    error = taskError;
+            }
+            else
+            {
+                ++numCompleted;
+                timings[id] = std::move(timing);
+                for (const TaskId dependent : mTasks[id].mDependents)
+                    if (--remaining[dependent] == 0)
+                        schedule(dependent);
+            }
+            completed.notify_all();
+        };
+
+        schedule = [&](TaskId id) {
+            if (error != nullptr)
+                return;
+            ++numRunning;
+            if (mTasks[id].mThread == Thread::Caller)
+            {
+                callerTasks.push_back(id);
+                return;
+            }
+            threads.emplace_back([&, id] {
+                auto [timing, taskError] = execute(id);
+                const std::lock_guard lock(mutex);
+                complete(id, std::move(timing), taskError);
+            });
+        };
+
+        {
+            std::unique_lock lock(mutex);
+            for (TaskId id = 0; id < mTasks.size(); ++id)
+            {
+                remaining[id] = mTasks[id].mNumDependencies;
+                if (remaining[id] == 0)
+                    schedule(id);
+            }
+
+            while (true)
+            {
+                completed.wait(lock, [&] { return !callerTasks.empty() || numRunning == 0; });
+                if (callerTasks.empty())
+                    break;
+
+                const TaskId id = callerTasks.front();
+                callerTasks.pop_front();
+                if (error != nullptr)
+                {
+                    --numRunning;
+                    continue;
+                }
+
+                lock.unlock();
+                auto [timing, taskError] = execute(id);
+                lock.lock();
+                complete(id, std::move(timing), taskError);
+            }
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        if (error != nullptr)
+            std::rethrow_exception(error);
+
+        if (numCompleted != mTasks.size())
+            throw std::logic_error("Not all tasks were run");
+
+        std::vector<Timing> result;
+        result.reserve(timings.size());
+        for (std::optional<Timing>& timing : timings)
+            result.push_back(std::move(*timing));
+        return result;
+    }
+}
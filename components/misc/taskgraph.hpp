@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_MISC_TASKGRAPH_H
+#define OPENMW_COMPONENTS_MISC_TASKGRAPH_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Runs a set of tasks as soon as the tasks they depend on are completed, e.g. to initialise independent
+    /// subsystems concurrently.
+    /// @par Tasks which have to run on the thread calling run(), like the ones using the graphics context or the GUI,
+    /// are run by that thread in the order they were added. The other tasks run on a thread of their own.
+    class TaskGraph
+    {
+    public:
+        using TaskId = std::size_t;
+
+        enum class Thread
+        {
+            Caller,
+            Any,
+        };
+
+        struct Timing
+        {
+            std::string mName;
+            // Since the start of run()
+            std::chrono::steady_clock::duration mStart;
+            std::chrono::steady_clock::duration mDuration;
+        };
+
+        /// @param dependencies Tasks which have to complete before this one starts, must have been added before.
+        TaskId add(std::string name, Thread thread, std::vector<TaskId> dependencies, std::function<void()> function);
+
+        /// Run all the tasks and wait for their completion.
+        /// @note When a task throws, no more tasks are started and the exception is rethrown once the running ones
+        /// have completed.
+        /// @return The timing of each completed task in the order they were added.
+        std::vector<Timing> run();
+
+    private:
+        struct Task
+        {
+            std::string mName;
+            Thread mThread;
+            std::function<void()> mFunction;
+            std::vector<TaskId> mDependents;
+            std::size_t mNumDependencies = 0;
+        };
+
+        std::vector<Task> mTasks;
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGE_H
+#define OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Distributes indices among workers in chunks
+    /// @par Each worker has its own share of the range and takes chunks from it first. Once its share is exhausted it
+    /// steals chunks from the shares of the others, so a worker that finishes early takes over the remaining work of
+    /// slower ones instead of waiting for them.
+    class WorkStealingRange
+    {
+    public:
+        struct Chunk
+        {
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        /// @param workers number of distinct workers taking chunks
+        explicit WorkStealingRange(std::size_t workers)
+            : mShares(std::max<std::size_t>(workers, 1))
+        {
+        }
+
+        /// @brief split [0, size) into a share per worker, must not be called concurrently with take()
+        void reset(std::size_t size, std::size_t chunkSize)
+        {
+            mChunkSize = std::max<std::size_t>(chunkSize, 1);
+            const std::size_t count = mShares.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mShares[i].mNext.store(size * i / count, std::memory_order_relaxed);
+                mShares[i].mEnd = size * (i + 1) / count;
+            }
+        }
+
+        /// @param worker index of the calling worker, less than the number of workers
+        /// @return the next chunk to process or nothing when all chunks are taken
+        std::optional<Chunk> take(std::size_t worker)
+        {
+            const std::size_t count = mShares.size();
+            for (std::size_t i = 0; i < count; ++i)
+                if (const std::optional<Chunk> chunk = takeFrom(mShares[(worker + i) % count]))
+                    return chunk;
+            return std::nullopt;
+        }
+
+    private:
+        struct alignas(64) Share
+        {
+            std::atomic<std::size_t> mNext{ 0 };
+            std::size_t mEnd = 0;
+        };
+
+        std::size_t mChunkSize = 1;
+        std::vector<Share> mShares;
+
+        std::optional<Chunk> takeFrom(Share& share) const
+        {
+            // Don't keep incrementing exhausted shares
+            if (share.mNext.load(std::memory_order_relaxed) >= share.mEnd)
+                return std::nullopt;
+            const std::size_t begin = share.mNext.fetch_add(mChunkSize, std::memory_order_relaxed);
+            if (begin >= share.mEnd)
+                return std::nullopt;
+            return Chunk{ begin, std::min(begin + mChunkSize, share.mEnd) };
+        }
+    };
+}
+
+#endif
@@ -2,6 +2,10 @@
 
 #include <MyGUI_Timer.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <osg/Drawable>
 #include <osg/TexMat>
 #include <osg/Texture2D>
@@ -100,10 +104,31 @@ namespace osgMyGUI
 
             mReadFrom = (mReadFrom + 1) % sNumBuffers;
             const std::vector<Batch>& vec = mBatchVector[mReadFrom];
+
+            // All batches of the frame share one buffer, so it is bound and uploaded once
+            osg::VertexBufferObject* vbo = mVertexBuffer[mReadFrom];
+            osg::GLBufferObject* bufferobject = state->isVertexBufferObjectSupported() && !vec.empty()
+                ? vbo->getOrCreateGLBufferObject(state->getContextID())
+                : nullptr;
+            if (bufferobject)
+            {
+                state->bindVertexBufferObject(bufferobject);
+
+                glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(0));
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(12));
+                glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(16));
+            }
+            else if (!vec.empty())
+            {
+                const char* vertices = reinterpret_cast<const char*>(mVertexArray[mReadFrom]->getDataPointer());
+                glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex), vertices);
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex), vertices + 12);
+                glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex), vertices + 16);
+            }
+
             for (std::vector<Batch>::const_iterator it = vec.begin(); it != vec.end(); ++it)
             {
                 const Batch& batch = *it;
-                osg::VertexBufferObject* vbo = batch.mVertexBuffer;
 
                 if (batch.mStateSet)
                 {
@@ -120,28 +145,8 @@ namespace osgMyGUI
                 else
                     state->applyTextureAttribute(0, mDummyTexture);
 
-                osg::GLBufferObject* bufferobject = state->isVertexBufferObjectSupported()
-                    ? vbo->getOrCreateGLBufferObject(state->getContextID())
-                    : nullptr;
-                if (bufferobject)
-                {
-                    state->bindVertexBufferObject(bufferobject);
-
-                    glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(0));
-                    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(12));
-                    glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex), reinterpret_cast<char*>(16));
-                }
-                else
-                {
-                    glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()));
-                    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()) + 12);
-                    glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()) + 16);
-                }
-
-                glDrawArrays(GL_TRIANGLES, 0, batch.mVertexCount);
+                glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.mFirstVertex),
+                    static_cast<GLsizei>(batch.mVertexCount));
 
                 if (batch.mStateSet)
                 {
@@ -194,6 +199,8 @@ namespace osgMyGUI
             flipMat.preMultTranslate(osg::Vec3f(0, 1, 0));
             flipMat.preMultScale(osg::Vec3f(1, -1, 1));
             mStateSet->setTextureAttribute(0, new osg::TexMat(flipMat), osg::StateAttribute::ON);
+
+            createVertexBuffers();
         }
         Drawable(const Drawable& copy, const osg::CopyOp& copyop = osg::CopyOp::SHALLOW_COPY)
             : osg::Drawable(copy, copyop)
@@ -203,6 +210,7 @@ namespace osgMyGUI
             , mReadFrom(0)
             , mDummyTexture(copy.mDummyTexture)
         {
+            createVertexBuffers();
         }
 
         // Defines the necessary information for a draw call
@@ -211,22 +219,47 @@ namespace osgMyGUI
             // May be empty
             osg::ref_ptr<osg::Texture2D> mTexture;
 
-            osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer;
-            // need to hold on to this too as the mVertexBuffer does not hold a ref to its own array
-            osg::ref_ptr<osg::Array> mArray;
-
             // optional
             osg::ref_ptr<osg::StateSet> mStateSet;
 
-            size_t mVertexCount;
+            // Range of the frame vertex buffer
+            size_t mFirstVertex = 0;
+            size_t mVertexCount = 0;
         };
 
-        void addBatch(const Batch& batch) { mBatchVector[mWriteTo].push_back(batch); }
+        /// Copies the vertices into the buffer of the frame. Merges the batch with the previous one when they use the
+        /// same state, so consecutive render items with the same texture are drawn with a single call.
+        void addBatch(const Batch& batch, const MyGUI::Vertex* vertices)
+        {
+            if (batch.mVertexCount == 0)
+                return;
+
+            osg::UByteArray& array = *mVertexArray[mWriteTo];
+            const size_t firstVertex = array.size() / sizeof(MyGUI::Vertex);
+            array.resize(array.size() + batch.mVertexCount * sizeof(MyGUI::Vertex));
+            std::memcpy(&array[firstVertex * sizeof(MyGUI::Vertex)], vertices,
+                batch.mVertexCount * sizeof(MyGUI::Vertex));
+            array.dirty();
+            mVertexBuffer[mWriteTo]->dirty();
+
+            std::vector<Batch>& batches = mBatchVector[mWriteTo];
+            if (!batches.empty() && batches.back().mTexture == batch.mTexture
+                && batches.back().mStateSet == batch.mStateSet)
+            {
+                batches.back().mVertexCount += batch.mVertexCount;
+                return;
+            }
+
+            Batch& added = batches.emplace_back(batch);
+            added.mFirstVertex = firstVertex;
+        }
 
         void clear()
         {
             mWriteTo = (mWriteTo + 1) % sNumBuffers;
             mBatchVector[mWriteTo].clear();
+            // Keeps the allocated storage, the GUI has about the same number of vertices every frame
+            mVertexArray[mWriteTo]->clear();
         }
 
         osg::StateSet* getDrawableStateSet() { return mStateSet; }
@@ -239,34 +272,42 @@ namespace osgMyGUI
 
         // double buffering approach, to avoid the need for synchronization with the draw thread
         std::vector<Batch> mBatchVector[sNumBuffers];
+        osg::ref_ptr<osg::UByteArray> mVertexArray[sNumBuffers];
+        osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer[sNumBuffers];
 
         int mWriteTo;
         mutable int mReadFrom;
 
         osg::ref_ptr<osg::Texture2D> mDummyTexture;
+
+        void createVertexBuffers()
+        {
+            for (int i = 0; i < sNumBuffers; ++i)
+            {
+                mVertexArray[i] = new osg::UByteArray;
+                mVertexBuffer[i] = new osg::VertexBufferObject;
+                mVertexBuffer[i]->setDataVariance(osg::Object::DYNAMIC);
+                mVertexBuffer[i]->setUsage(GL_DYNAMIC_DRAW);
+                // NB mVertexBuffer does not own the array
+                mVertexBuffer[i]->setArray(0, mVertexArray[i].get());
+            }
+        }
     };
 
+    // The vertices are copied into the buffer of the frame when rendered, so the draw thread never reads them here
     class OSGVertexBuffer : public MyGUI::IVertexBuffer
     {
-        osg::ref_ptr<osg::VertexBufferObject> mBuffer[2];
-        osg::ref_ptr<osg::UByteArray> mVertexArray[2];
+        std::vector<MyGUI::Vertex> mVertices;
 
         size_t mNeedVertexCount;
 
-        unsigned int mCurrentBuffer;
-        bool mUsed; // has the mCurrentBuffer been submitted to the rendering thread
-
-        void destroy();
-        osg::UByteArray* create();
-
     public:
         OSGVertexBuffer();
         virtual ~OSGVertexBuffer() {}
 
-        void markUsed();
+        const MyGUI::Vertex* getVertices() const { return mVertices.data(); }
 
-        osg::Array* getVertexArray();
-        osg::VertexBufferObject* getVertexBuffer();
+        size_t getLockedVertexCount() const { return mVertices.size(); }
 
         void setVertexCount(size_t count) override;
         size_t getVertexCount() const override;
@@ -277,16 +318,9 @@ namespace osgMyGUI
 
     OSGVertexBuffer::OSGVertexBuffer()
         : mNeedVertexCount(0)
-        , mCurrentBuffer(0)
-        , mUsed(false)
     {
     }
 
-    void OSGVertexBuffer::markUsed()
-    {
-        mUsed = true;
-    }
-
     void OSGVertexBuffer::setVertexCount(size_t count)
     {
         if (count == mNeedVertexCount)
@@ -302,52 +336,11 @@ namespace osgMyGUI
 
     MyGUI::Vertex* OSGVertexBuffer::lock()
     {
-        if (mUsed)
-        {
-            mCurrentBuffer = (mCurrentBuffer + 1) % 2;
-            mUsed = false;
-        }
-        osg::UByteArray* array = mVertexArray[mCurrentBuffer];
-        if (!array)
-        {
-            array = create();
-        }
-        else if (array->size() != mNeedVertexCount * sizeof(MyGUI::Vertex))
-        {
-            array->resize(mNeedVertexCount * sizeof(MyGUI::Vertex));
-        }
-
-        return (MyGUI::Vertex*)&(*array)[0];
-    }
-
-    void OSGVertexBuffer::unlock()
-    {
-        mVertexArray[mCurrentBuffer]->dirty();
-        mBuffer[mCurrentBuffer]->dirty();
+        mVertices.resize(mNeedVertexCount);
+        return mVertices.data();
     }
 
-    osg::UByteArray* OSGVertexBuffer::create()
-    {
-        mVertexArray[mCurrentBuffer] = new osg::UByteArray(mNeedVertexCount * sizeof(MyGUI::Vertex));
-
-        mBuffer[mCurrentBuffer] = new osg::VertexBufferObject;
-        mBuffer[mCurrentBuffer]->setDataVariance(osg::Object::DYNAMIC);
-        mBuffer[mCurrentBuffer]->setUsage(GL_DYNAMIC_DRAW);
-        // NB mBuffer does not own the array
-        mBuffer[mCurrentBuffer]->setArray(0, mVertexArray[mCurrentBuffer].get());
-
-        return mVertexArray[mCurrentBuffer];
-    }
-
-    osg::Array* OSGVertexBuffer::getVertexArray()
-    {
-        return mVertexArray[mCurrentBuffer];
-    }
-
-    osg::VertexBufferObject* OSGVertexBuffer::getVertexBuffer()
-    {
-        return mBuffer[mCurrentBuffer];
-    }
+    void OSGVertexBuffer::unlock() {}
 
     // ---------------------------------------------------------------------------
 
@@ -444,10 +437,7 @@ namespace osgMyGUI
     void RenderManager::doRender(MyGUI::IVertexBuffer* buffer, MyGUI::ITexture* texture, size_t count)
     {
         Drawable::Batch batch;
-        batch.mVertexCount = count;
-        batch.mVertexBuffer = static_cast<OSGVertexBuffer*>(buffer)->getVertexBuffer();
-        batch.mArray = static_cast<OSGVertexBuffer*>(buffer)->getVertexArray();
-        static_cast<OSGVertexBuffer*>(buffer)->markUsed();
+        batch.mVertexCount = std::min(count, static_cast<OSGVertexBuffer*>(buffer)->getLockedVertexCount());
 
         if (OSGTexture* osgtexture = static_cast<OSGTexture*>(texture))
         {
@@ -460,7 +450,7 @@ namespace osgMyGUI
         if (mInjectState)
             batch.mStateSet = mInjectState;
 
-        mDrawable->addBatch(batch);
+        mDrawable->addBatch(batch, static_cast<OSGVertexBuffer*>(buffer)->getVertices());
     }
 
     void RenderManager::setInjectState(osg::StateSet* stateSet)
@@ -7,6 +7,7 @@
 #include <array>
 #include <limits>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 
@@ -23,6 +24,29 @@
 
 namespace Nif
 {
+    namespace
+    {
+        // Returns nullopt when the stream size can't be determined
+        std::optional<std::vector<char>> readContent(std::istream& stream)
+        {
+            const std::istream::pos_type start = stream.tellg();
+            stream.seekg(0, std::ios_base::end);
+            const std::istream::pos_type end = stream.tellg();
+            if (start == std::istream::pos_type(-1) || end == std::istream::pos_type(-1) || end < start)
+            {
+                stream.clear();
+                stream.seekg(start);
+                return std::nullopt;
+            }
+            stream.seekg(start);
+            std::vector<char> content(static_cast<std::size_t>(end - start));
+            stream.read(content.data(), static_cast<std::streamsize>(content.size()));
+            if (stream.bad())
+                throw std::runtime_error("Failed to read file content");
+            content.resize(static_cast<std::size_t>(stream.gcount()));
+            return content;
+        }
+    }
 
     Reader::Reader(NIFFile& file, const ToUTF8::StatelessUtf8Encoder* encoder)
         : mVersion(file.mVersion)
@@ -533,10 +557,20 @@ namespace Nif
         if (writeDebug)
             Log(Debug::Verbose) << "NIF Debug: Reading file: '" << mFilename << "'";
 
-        const std::array<std::uint64_t, 2> fileHash = Files::getHash(mFilename, *stream);
-        mHash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
-
-        NIFStream nif(*this, std::move(stream), mEncoder);
+        std::optional<NIFStream> nifStream;
+        if (std::optional<std::vector<char>> content = sReadIntoMemory ? readContent(*stream) : std::nullopt)
+        {
+            const std::array<std::uint64_t, 2> fileHash = Files::getHash(*content);
+            mHash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
+            nifStream.emplace(*this, std::move(*content), mEncoder);
+        }
+        else
+        {
+            const std::array<std::uint64_t, 2> fileHash = Files::getHash(mFilename, *stream);
+            mHash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
+            nifStream.emplace(*this, std::move(stream), mEncoder);
+        }
+        NIFStream& nif = *nifStream;
 
         // Check the header string
         std::string head = nif.getVersionString();
@@ -574,9 +608,9 @@ namespace Nif
             = mVersion >= NIFStream::generateVersion(10, 0, 0, 0) && mVersion < NIFStream::generateVersion(10, 2, 0, 0);
 
         // Record type list
-        std::vector<std::string> recTypes;
+        std::vector<std::string>& recTypes = mRecordTypes;
         // Record type mapping for each record
-        std::vector<std::uint16_t> recTypeIndices;
+        std::vector<std::uint16_t>& recTypeIndices = mRecordTypeIndices;
 
         {
             std::uint8_t endianness = 1;
@@ -641,11 +675,9 @@ namespace Nif
             }
         }
 
-        if (hasRecordSizes) // Record sizes
-        {
-            std::vector<std::uint32_t> recSizes; // Currently unused
+        std::vector<std::uint32_t> recSizes;
+        if (hasRecordSizes)
             nif.readVector(recSizes, mRecords.size());
-        }
 
         if (hasStringTable)
         {
@@ -661,49 +693,47 @@ namespace Nif
             nif.readVector(groups, nif.get<std::uint32_t>());
         }
 
-        for (std::size_t i = 0; i < mRecords.size(); i++)
+        if (hasRecordSizes)
         {
-            std::unique_ptr<Record> r;
-
-            std::string rec = hasRecTypeListings ? recTypes[recTypeIndices[i]] : nif.get<std::string>();
-            if (rec.empty())
+            // The records can be found without reading the ones before, so they are only read once referenced from
+            // a root or another referenced record. Consumers do not pay for records nothing points to.
+            mRecordOffsets.resize(mRecords.size() + 1);
+            mRecordOffsets[0] = nif.tell();
+            for (std::size_t i = 0; i < mRecords.size(); ++i)
+                mRecordOffsets[i + 1] = mRecordOffsets[i] + recSizes[i];
+            nif.seek(mRecordOffsets.back());
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mRecords.size(); i++)
             {
-                std::stringstream error;
-                error << "Record type is blank (index " << i << ")";
-                throw Nif::Exception(error.str(), mFilename);
-            }
-
-            // Record separator. Some Havok records in Oblivion do not have it.
-            if (hasRecordSeparators && !rec.starts_with("bhk") && nif.get<int32_t>())
-                throw Nif::Exception("Non-zero separator precedes " + rec + ", index " + std::to_string(i), mFilename);
-
-            const auto entry = factories.find(rec);
-
-            if (entry == factories.end())
-                throw Nif::Exception("Unknown record type " + rec, mFilename);
+                std::string rec = hasRecTypeListings ? recTypes[recTypeIndices[i]] : nif.get<std::string>();
 
-            r = entry->second();
+                // Record separator. Some Havok records in Oblivion do not have it.
+                if (hasRecordSeparators && !rec.empty() && !rec.starts_with("bhk") && nif.get<int32_t>())
+                    throw Nif::Exception(
+                        "Non-zero separator precedes " + rec + ", index " + std::to_string(i), mFilename);
 
-            if (writeDebug)
-                Log(Debug::Verbose) << "NIF Debug: Reading record of type " << rec << ", index " << i;
-
-            assert(r != nullptr);
-            assert(r->recType != RC_MISSING);
-            r->recName = std::move(rec);
-            r->recIndex = i;
-            r->read(&nif);
-            mRecords[i] = std::move(r);
+                std::unique_ptr<Record> r = createRecord(std::move(rec), i);
+                r->read(&nif);
+                mRecords[i] = std::move(r);
+            }
         }
 
         // Determine which records are roots
-        mRoots.resize(nif.get<uint32_t>());
+        std::vector<std::int32_t> rootIndices;
+        nif.readVector(rootIndices, nif.get<uint32_t>());
+
+        if (hasRecordSizes)
+            mLazyStream = &nif;
+
+        mRoots.resize(rootIndices.size());
         for (std::size_t i = 0; i < mRoots.size(); i++)
         {
-            std::int32_t idx;
-            nif.read(idx);
+            const std::int32_t idx = rootIndices[i];
             if (idx >= 0 && static_cast<std::size_t>(idx) < mRecords.size())
             {
-                mRoots[i] = mRecords[idx].get();
+                mRoots[i] = getRecord(idx);
             }
             else
             {
@@ -714,8 +744,70 @@ namespace Nif
         }
 
         // Once parsing is done, do post-processing.
-        for (const auto& record : mRecords)
-            record->post(*this);
+        if (hasRecordSizes)
+        {
+            // Post-processing resolves the references and so reads the referenced records
+            while (!mPendingPost.empty())
+            {
+                Record* const record = mPendingPost.back();
+                mPendingPost.pop_back();
+                record->post(*this);
+            }
+            mLazyStream = nullptr;
+        }
+        else
+        {
+            for (const auto& record : mRecords)
+                record->post(*this);
+        }
+    }
+
+    std::unique_ptr<Record> Reader::createRecord(std::string&& type, std::size_t index) const
+    {
+        if (type.empty())
+        {
+            std::stringstream error;
+            error << "Record type is blank (index " << index << ")";
+            throw Nif::Exception(error.str(), mFilename);
+        }
+
+        const auto entry = factories.find(type);
+
+        if (entry == factories.end())
+            throw Nif::Exception("Unknown record type " + type, mFilename);
+
+        std::unique_ptr<Record> r = entry->second();
+
+        if (sWriteNifDebugLog)
+            Log(Debug::Verbose) << "NIF Debug: Reading record of type " << type << ", index " << index;
+
+        assert(r != nullptr);
+        assert(r->recType != RC_MISSING);
+        r->recName = std::move(type);
+        r->recIndex = index;
+        return r;
+    }
+
+    void Reader::readLazyRecord(std::size_t index)
+    {
+        std::unique_ptr<Record> r = createRecord(std::string(mRecordTypes.at(mRecordTypeIndices.at(index))), index);
+        mLazyStream->seek(mRecordOffsets[index]);
+        r->read(mLazyStream);
+
+        if (sWriteNifDebugLog && mLazyStream->tell() != mRecordOffsets[index + 1])
+            Log(Debug::Verbose) << "NIF Debug: Record " << r->recName << ", index " << index << " has "
+                                << mRecordOffsets[index + 1] - mRecordOffsets[index] << " bytes but "
+                                << mLazyStream->tell() - mRecordOffsets[index] << " are read";
+
+        mPendingPost.push_back(r.get());
+        mRecords[index] = std::move(r);
+    }
+
+    Record* Reader::getRecord(size_t index)
+    {
+        if (mRecords.at(index) == nullptr && mLazyStream != nullptr)
+            readLazyRecord(index);
+        return mRecords[index].get();
     }
 
     void Reader::setUseSkinning(bool skinning)
@@ -725,6 +817,7 @@ namespace Nif
 
     std::atomic_bool Reader::sLoadUnsupportedFiles = false;
     std::atomic_bool Reader::sWriteNifDebugLog = false;
+    std::atomic_bool Reader::sReadIntoMemory = false;
 
     void Reader::setLoadUnsupportedFiles(bool load)
     {
@@ -736,6 +829,11 @@ namespace Nif
         sWriteNifDebugLog = value;
     }
 
+    void Reader::setReadIntoMemory(bool value)
+    {
+        sReadIntoMemory = value;
+    }
+
     std::string Reader::getString(std::uint32_t index) const
     {
         if (index == std::numeric_limits<std::uint32_t>::max())
@@ -5,6 +5,8 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <components/files/istreamptr.hpp>
@@ -18,6 +20,7 @@ namespace ToUTF8
 
 namespace Nif
 {
+    class NIFStream;
 
     struct NIFFile
     {
@@ -119,13 +122,27 @@ namespace Nif
         bool& mUseSkinning;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
 
+        /// When the header has the record sizes, the records are read when they are first referenced, see getRecord.
+        /// Offsets of the records and of the end of the last one
+        std::vector<std::size_t> mRecordOffsets;
+        std::vector<std::string> mRecordTypes;
+        std::vector<std::uint16_t> mRecordTypeIndices;
+        NIFStream* mLazyStream = nullptr;
+        /// Records that are read but not post-processed yet
+        std::vector<Record*> mPendingPost;
+
         static std::atomic_bool sLoadUnsupportedFiles;
         static std::atomic_bool sWriteNifDebugLog;
+        static std::atomic_bool sReadIntoMemory;
 
         /// Get the file's version in a human readable form
         ///\returns A string containing a human readable NIF version number
         std::string versionToString(std::uint32_t version);
 
+        std::unique_ptr<Record> createRecord(std::string&& type, std::size_t index) const;
+
+        void readLazyRecord(std::size_t index);
+
     public:
         /// Open a NIF stream. The name is used for error messages.
         explicit Reader(NIFFile& file, const ToUTF8::StatelessUtf8Encoder* encoder);
@@ -133,8 +150,9 @@ namespace Nif
         /// Parse the file
         void parse(Files::IStreamPtr&& stream);
 
-        /// Get a given record
-        Record* getRecord(size_t index) const { return mRecords.at(index).get(); }
+        /// Get a given record. When the file has the record sizes, the record is read on the first call, so only the
+        /// records referenced from the roots are read.
+        Record* getRecord(size_t index);
 
         /// Get a given string from the file's string table
         std::string getString(std::uint32_t index) const;
@@ -158,6 +176,9 @@ namespace Nif
         static void setLoadUnsupportedFiles(bool load);
 
         static void setWriteNifDebugLog(bool load);
+
+        /// Read the whole file into memory before parsing it instead of reading from the stream piece by piece.
+        static void setReadIntoMemory(bool value);
     };
     using NIFFilePtr = std::shared_ptr<const Nif::NIFFile>;
 
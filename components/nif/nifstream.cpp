@@ -23,12 +23,12 @@ namespace
     // This one should be used if the type can be read contiguously as an array of a different type
     // (e.g. osg::VecXf can be read as a float array of X elements)
     template <class elementType, size_t numElements, class T>
-    void readAlignedRange(Files::IStreamPtr& stream, T* dest, size_t size)
+    void readAlignedRange(Nif::NIFStream& stream, T* dest, size_t size)
     {
         static_assert(std::is_standard_layout_v<T>);
         static_assert(std::alignment_of_v<T> == std::alignment_of_v<elementType>);
         static_assert(sizeof(T) == sizeof(elementType) * numElements);
-        Nif::readDynamicBufferOfType(stream, reinterpret_cast<elementType*>(dest), size * numElements);
+        stream.read(reinterpret_cast<elementType*>(dest), size * numElements);
     }
 
 }
@@ -53,13 +53,23 @@ namespace Nif
 
     std::string NIFStream::getSizedString(size_t length)
     {
-        std::string str(length, '\0');
-        mStream->read(str.data(), length);
-        if (mStream->bad())
-            throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
-        size_t end = str.find('\0');
-        if (end != std::string::npos)
-            str.erase(end);
+        std::string str;
+        if (mStream != nullptr)
+        {
+            str.resize(length);
+            mStream->read(str.data(), length);
+            if (mStream->bad())
+                throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
+            size_t end = str.find('\0');
+            if (end != std::string::npos)
+                str.erase(end);
+        }
+        else
+        {
+            const std::string_view data(mData.data() + mPosition, std::min(length, mData.size() - mPosition));
+            str = data.substr(0, data.find('\0'));
+            mPosition += data.size();
+        }
         if (mEncoder)
             str = mEncoder->getUtf8(str, ToUTF8::BufferAllocationPolicy::UseGrowFactor, mBuffer);
         return str;
@@ -75,9 +85,19 @@ namespace Nif
     std::string NIFStream::getVersionString()
     {
         std::string result;
-        std::getline(*mStream, result);
-        if (mStream->bad())
-            throw std::runtime_error("Failed to read version string");
+        if (mStream != nullptr)
+        {
+            std::getline(*mStream, result);
+            if (mStream->bad())
+                throw std::runtime_error("Failed to read version string");
+        }
+        else
+        {
+            const std::string_view data(mData.data() + mPosition, mData.size() - mPosition);
+            const std::size_t end = data.find('\n');
+            result = data.substr(0, end);
+            mPosition += end == std::string_view::npos ? data.size() : end + 1;
+        }
         return result;
     }
 
@@ -85,34 +105,39 @@ namespace Nif
     {
         size_t size = get<uint32_t>();
         std::string str(size, '\0');
-        mStream->read(str.data(), size);
-        if (mStream->bad())
-            throw std::runtime_error("Failed to read string palette of " + std::to_string(size) + " chars");
+        if (mStream != nullptr)
+        {
+            mStream->read(str.data(), size);
+            if (mStream->bad())
+                throw std::runtime_error("Failed to read string palette of " + std::to_string(size) + " chars");
+        }
+        else
+            readFromMemory(str.data(), size);
         return str;
     }
 
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer<2>(vec._v);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer<3>(vec._v);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer<4>(vec._v);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3& mat)
     {
-        readBufferOfType<9>(mStream, reinterpret_cast<float*>(&mat.mValues));
+        readBuffer<9>(reinterpret_cast<float*>(&mat.mValues));
     }
 
     template <>
@@ -178,25 +203,25 @@ namespace Nif
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f* dest, size_t size)
     {
-        readAlignedRange<float, 2>(mStream, dest, size);
+        readAlignedRange<float, 2>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f* dest, size_t size)
     {
-        readAlignedRange<float, 3>(mStream, dest, size);
+        readAlignedRange<float, 3>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f* dest, size_t size)
     {
-        readAlignedRange<float, 4>(mStream, dest, size);
+        readAlignedRange<float, 4>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3* dest, size_t size)
     {
-        readAlignedRange<float, 9>(mStream, dest, size);
+        readAlignedRange<float, 9>(*this, dest, size);
     }
 
     template <>
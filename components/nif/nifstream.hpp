@@ -3,8 +3,10 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <istream>
 #include <stdexcept>
 #include <stdint.h>
@@ -73,9 +75,48 @@ namespace Nif
     {
         const Reader& mReader;
         Files::IStreamPtr mStream;
+        /// Whole file content when the file is read from memory, mStream is nullptr in this case
+        std::vector<char> mData;
+        std::size_t mPosition = 0;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
         std::string mBuffer;
 
+        /// Copy bytes from the file content, a read beyond the end is truncated the same way as an istream one
+        void readFromMemory(char* dest, std::size_t size)
+        {
+            size = std::min(size, mData.size() - mPosition);
+            std::memcpy(dest, mData.data() + mPosition, size);
+            mPosition += size;
+        }
+
+        template <std::size_t numInstances, typename T>
+        void readBuffer(T* dest)
+        {
+            if (mStream != nullptr)
+                return readBufferOfType<numInstances>(mStream, dest);
+            static_assert(
+                std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
+            static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+            readFromMemory(reinterpret_cast<char*>(dest), numInstances * sizeof(T));
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
+
+        template <typename T>
+        void readDynamicBuffer(T* dest, std::size_t numInstances)
+        {
+            if (mStream != nullptr)
+                return readDynamicBufferOfType<T>(mStream, dest, numInstances);
+            static_assert(
+                std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
+            static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+            readFromMemory(reinterpret_cast<char*>(dest), numInstances * sizeof(T));
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
+
     public:
         explicit NIFStream(
             const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder)
@@ -85,6 +126,14 @@ namespace Nif
         {
         }
 
+        /// Read from the whole file content loaded into memory. Arrays are copied from it in bulk.
+        explicit NIFStream(const Reader& reader, std::vector<char>&& data, const ToUTF8::StatelessUtf8Encoder* encoder)
+            : mReader(reader)
+            , mData(std::move(data))
+            , mEncoder(encoder)
+        {
+        }
+
         const Reader& getFile() const { return mReader; }
 
         unsigned int getVersion() const;
@@ -97,27 +146,49 @@ namespace Nif
             return (major << 24) + (minor << 16) + (patch << 8) + rev;
         }
 
-        void skip(size_t size) { mStream->ignore(size); }
+        /// Position from the beginning of the file
+        std::size_t tell()
+        {
+            if (mStream != nullptr)
+                return static_cast<std::size_t>(mStream->tellg());
+            return mPosition;
+        }
+
+        void seek(std::size_t position)
+        {
+            if (mStream != nullptr)
+                mStream->seekg(static_cast<std::streamoff>(position));
+            else
+                mPosition = std::min(position, mData.size());
+        }
+
+        void skip(size_t size)
+        {
+            if (mStream != nullptr)
+                mStream->ignore(size);
+            else
+                mPosition += std::min(size, mData.size() - mPosition);
+        }
 
         /// Read into a single instance of type
         template <class T>
         void read(T& data)
         {
-            readBufferOfType<1>(mStream, &data);
+            readBuffer<1>(&data);
         }
 
         /// Read multiple instances of type into an array
         template <class T, size_t size>
         void readArray(std::array<T, size>& arr)
         {
-            readBufferOfType<size>(mStream, arr.data());
+            readBuffer<size>(arr.data());
         }
 
         /// Read instances of type into a dynamic buffer
         template <class T>
         void read(T* dest, size_t size)
         {
-            readDynamicBufferOfType<T>(mStream, dest, size);
+            readDynamicBuffer(dest, size);
         }
 
         /// Read multiple instances of type into a vector
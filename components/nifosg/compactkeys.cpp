@@ -0,0 +1,212 @@
+#include "compactkeys.hpp"
+
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string_view>
+
+namespace NifOsg
+{
+    namespace
+    {
+        // Maximum allowed difference between the original and the reconstructed values. Rotations are compared
+        // by the quaternion components, 5e-4 corresponds to about 0.06 degrees.
+        constexpr float sMaxRotationError = 5e-4f;
+        constexpr float sMaxTranslationError = 5e-3f;
+        constexpr float sMaxFloatError = 1e-4f;
+
+        constexpr float sQuantizationScale = 32767.f;
+
+        float getError(const osg::Quat& a, const osg::Quat& b)
+        {
+            // q and -q represent the same rotation
+            const float sign = (a.asVec4() * b.asVec4()) < 0 ? -1.f : 1.f;
+            float result = 0;
+            for (int i = 0; i < 4; ++i)
+                result = std::max(result, static_cast<float>(std::abs(a[i] - sign * b[i])));
+            return result;
+        }
+
+        float getError(const osg::Vec3f& a, const osg::Vec3f& b)
+        {
+            return (a - b).length();
+        }
+
+        float getError(float a, float b)
+        {
+            return std::abs(a - b);
+        }
+
+        float getMaxError(const osg::Quat&)
+        {
+            return sMaxRotationError;
+        }
+
+        float getMaxError(const osg::Vec3f&)
+        {
+            return sMaxTranslationError;
+        }
+
+        float getMaxError(float)
+        {
+            return sMaxFloatError;
+        }
+
+        template <class T>
+        bool isReproducible(const std::vector<float>& times, const std::vector<T>& values, std::size_t first,
+            std::size_t last, bool constant)
+        {
+            for (std::size_t i = first + 1; i < last; ++i)
+            {
+                // Keys of a constant track can be dropped only if it doesn't change the value at any time
+                if (constant)
+                {
+                    if (!(values[i] == values[first]) || !(values[i] == values[last]))
+                        return false;
+                    continue;
+                }
+                const float fraction = (times[i] - times[first]) / (times[last] - times[first]);
+                const T value = interpolateLinear(values[first], values[last], fraction);
+                if (getError(value, values[i]) > getMaxError(values[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        template <class T>
+        std::size_t getHash(const CompactKeys<T>& keys)
+        {
+            std::size_t result = 0;
+            Misc::hashCombine(result, keys.mConstant);
+            Misc::hashCombine(result,
+                std::string_view(
+                    reinterpret_cast<const char*>(keys.mTimes.data()), keys.mTimes.size() * sizeof(float)));
+            Misc::hashCombine(result,
+                std::string_view(reinterpret_cast<const char*>(keys.mValues.data()),
+                    keys.mValues.size() * sizeof(typename CompactKeys<T>::StoredType)));
+            return result;
+        }
+
+        template <class T>
+        bool operator==(const CompactKeys<T>& l, const CompactKeys<T>& r)
+        {
+            return l.mConstant == r.mConstant && l.mTimes == r.mTimes && l.mValues == r.mValues;
+        }
+
+        template <class T>
+        class SharedTracks
+        {
+        public:
+            std::shared_ptr<const CompactKeys<T>> share(CompactKeys<T>&& keys)
+            {
+                const std::size_t hash = getHash(keys);
+                const std::lock_guard lock(mMutex);
+                const auto [begin, end] = mTracks.equal_range(hash);
+                for (auto it = begin; it != end; ++it)
+                    if (std::shared_ptr<const CompactKeys<T>> existing = it->second.lock())
+                        if (*existing == keys)
+                            return existing;
+                auto result = std::make_shared<const CompactKeys<T>>(std::move(keys));
+                mTracks.emplace(hash, result);
+                if (++mInserted % 1024 == 0)
+                    std::erase_if(mTracks, [](const auto& v) { return v.second.expired(); });
+                return result;
+            }
+
+        private:
+            std::mutex mMutex;
+            std::multimap<std::size_t, std::weak_ptr<const CompactKeys<T>>> mTracks;
+            std::size_t mInserted = 0;
+        };
+
+        template <class MapT>
+        auto makeCompactKeysImpl(const MapT& keys)
+        {
+            using T = typename MapT::ValueType;
+            using Result = std::shared_ptr<const CompactKeys<T>>;
+
+            const bool constant = keys.mInterpolationType == Nif::InterpolationType_Constant;
+            if (keys.mKeys.empty() || (!constant && keys.mInterpolationType != Nif::InterpolationType_Linear))
+                return Result();
+
+            std::vector<float> times;
+            std::vector<T> values;
+            times.reserve(keys.mKeys.size());
+            values.reserve(keys.mKeys.size());
+            for (const auto& [time, key] : keys.mKeys)
+            {
+                times.push_back(time);
+                values.push_back(key.mValue);
+            }
+
+            CompactKeys<T> result;
+            result.mConstant = constant;
+
+            std::size_t lastKept = 0;
+            result.mTimes.push_back(times.front());
+            result.mValues.push_back(CompactValue<T>::pack(values.front()));
+            for (std::size_t i = 1; i + 1 < times.size(); ++i)
+            {
+                if (isReproducible(times, values, lastKept, i + 1, constant))
+                    continue;
+                lastKept = i;
+                result.mTimes.push_back(times[i]);
+                result.mValues.push_back(CompactValue<T>::pack(values[i]));
+            }
+            if (times.size() > 1)
+            {
+                result.mTimes.push_back(times.back());
+                result.mValues.push_back(CompactValue<T>::pack(values.back()));
+            }
+
+            result.mTimes.shrink_to_fit();
+            result.mValues.shrink_to_fit();
+
+            static SharedTracks<T> sharedTracks;
+            return sharedTracks.share(std::move(result));
+        }
+    }
+
+    QuantizedQuat QuantizedQuat::pack(const osg::Quat& value)
+    {
+        osg::Quat normalized = value;
+        const double length = normalized.length();
+        if (length > 0)
+            normalized /= length;
+        QuantizedQuat result;
+        for (int i = 0; i < 4; ++i)
+        {
+            const double component = std::clamp(normalized[i], -1.0, 1.0);
+            result.mValue[i] = static_cast<std::int16_t>(std::lround(component * sQuantizationScale));
+        }
+        return result;
+    }
+
+    osg::Quat QuantizedQuat::unpack() const
+    {
+        osg::Quat result(mValue[0] / sQuantizationScale, mValue[1] / sQuantizationScale,
+            mValue[2] / sQuantizationScale, mValue[3] / sQuantizationScale);
+        const double length = result.length();
+        if (length > 0)
+            result /= length;
+        return result;
+    }
+
+    std::shared_ptr<const CompactKeys<osg::Quat>> makeCompactKeys(const Nif::QuaternionKeyMap& keys)
+    {
+        return makeCompactKeysImpl(keys);
+    }
+
+    std::shared_ptr<const CompactKeys<osg::Vec3f>> makeCompactKeys(const Nif::Vector3KeyMap& keys)
+    {
+        return makeCompactKeysImpl(keys);
+    }
+
+    std::shared_ptr<const CompactKeys<float>> makeCompactKeys(const Nif::FloatKeyMap& keys)
+    {
+        return makeCompactKeysImpl(keys);
+    }
+}
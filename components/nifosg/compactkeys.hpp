@@ -0,0 +1,83 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_COMPACTKEYS_H
+#define OPENMW_COMPONENTS_NIFOSG_COMPACTKEYS_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <osg/Quat>
+#include <osg/Vec3f>
+
+#include <components/nif/nifkey.hpp>
+
+namespace NifOsg
+{
+    /// Unit quaternion stored as 4 signed normalized 16-bit integers.
+    struct QuantizedQuat
+    {
+        std::array<std::int16_t, 4> mValue;
+
+        static QuantizedQuat pack(const osg::Quat& value);
+
+        osg::Quat unpack() const;
+
+        friend bool operator==(const QuantizedQuat& l, const QuantizedQuat& r) = default;
+    };
+
+    template <class T>
+    struct CompactValue
+    {
+        using Type = T;
+
+        static T pack(const T& value) { return value; }
+
+        static T unpack(const T& value) { return value; }
+    };
+
+    template <>
+    struct CompactValue<osg::Quat>
+    {
+        using Type = QuantizedQuat;
+
+        static QuantizedQuat pack(const osg::Quat& value) { return QuantizedQuat::pack(value); }
+
+        static osg::Quat unpack(const QuantizedQuat& value) { return value.unpack(); }
+    };
+
+    template <class T>
+    inline T interpolateLinear(const T& a, const T& b, float fraction)
+    {
+        return a + ((b - a) * fraction);
+    }
+
+    inline osg::Quat interpolateLinear(const osg::Quat& a, const osg::Quat& b, float fraction)
+    {
+        osg::Quat result;
+        result.slerp(fraction, a, b);
+        return result;
+    }
+
+    /// Linear or constant keyframe track stored as sorted arrays instead of a map. Quaternions are quantized.
+    template <class T>
+    struct CompactKeys
+    {
+        using StoredType = typename CompactValue<T>::Type;
+
+        std::vector<float> mTimes;
+        std::vector<StoredType> mValues;
+        bool mConstant = false;
+
+        T getValue(std::size_t index) const { return CompactValue<T>::unpack(mValues[index]); }
+    };
+
+    /// Convert keys into the compact form dropping the keys that interpolation of the neighbours reproduces with a
+    /// visually indistinguishable error. Identical tracks are shared between all callers.
+    /// @return nullptr when the track is empty or uses an interpolation this form doesn't support.
+    /// @note Thread safe.
+    std::shared_ptr<const CompactKeys<osg::Quat>> makeCompactKeys(const Nif::QuaternionKeyMap& keys);
+    std::shared_ptr<const CompactKeys<osg::Vec3f>> makeCompactKeys(const Nif::Vector3KeyMap& keys);
+    std::shared_ptr<const CompactKeys<float>> makeCompactKeys(const Nif::FloatKeyMap& keys);
+}
+
+#endif
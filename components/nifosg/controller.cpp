@@ -1,5 +1,7 @@
 #include "controller.hpp"
 
+#include <cmath>
+
 #include <osg/Material>
 #include <osg/MatrixTransform>
 #include <osg/TexMat>
@@ -14,6 +16,18 @@
 
 namespace NifOsg
 {
+    namespace
+    {
+        template <class Interpolator, class KeyMap, class... DefaultValue>
+        Interpolator makeInterpolator(
+            const std::shared_ptr<KeyMap>& keys, bool compact, const DefaultValue&... defaultValue)
+        {
+            if (compact && keys != nullptr)
+                if (auto compactKeys = makeCompactKeys(*keys))
+                    return Interpolator(std::move(compactKeys), defaultValue...);
+            return Interpolator(keys, defaultValue...);
+        }
+    }
 
     ControllerFunction::ControllerFunction(const Nif::NiTimeController* ctrl)
         : mFrequency(ctrl->mFrequency)
@@ -85,10 +99,11 @@ namespace NifOsg
         , mTranslations(copy.mTranslations)
         , mScales(copy.mScales)
         , mAxisOrder(copy.mAxisOrder)
+        , mPoseCache(copy.mPoseCache)
     {
     }
 
-    KeyframeController::KeyframeController(const Nif::NiKeyframeController* keyctrl)
+    KeyframeController::KeyframeController(const Nif::NiKeyframeController* keyctrl, bool compact)
     {
         if (!keyctrl->mInterpolator.empty())
         {
@@ -99,12 +114,15 @@ namespace NifOsg
                 const Nif::NiQuatTransform& defaultTransform = interp->mDefaultValue;
                 if (!interp->mData.empty())
                 {
-                    mRotations = QuaternionInterpolator(interp->mData->mRotations, defaultTransform.mRotation);
-                    mXRotations = FloatInterpolator(interp->mData->mXRotations);
-                    mYRotations = FloatInterpolator(interp->mData->mYRotations);
-                    mZRotations = FloatInterpolator(interp->mData->mZRotations);
-                    mTranslations = Vec3Interpolator(interp->mData->mTranslations, defaultTransform.mTranslation);
-                    mScales = FloatInterpolator(interp->mData->mScales, defaultTransform.mScale);
+                    mRotations = makeInterpolator<QuaternionInterpolator>(
+                        interp->mData->mRotations, compact, defaultTransform.mRotation);
+                    mXRotations = makeInterpolator<FloatInterpolator>(interp->mData->mXRotations, compact);
+                    mYRotations = makeInterpolator<FloatInterpolator>(interp->mData->mYRotations, compact);
+                    mZRotations = makeInterpolator<FloatInterpolator>(interp->mData->mZRotations, compact);
+                    mTranslations = makeInterpolator<Vec3Interpolator>(
+                        interp->mData->mTranslations, compact, defaultTransform.mTranslation);
+                    mScales = makeInterpolator<FloatInterpolator>(
+                        interp->mData->mScales, compact, defaultTransform.mScale);
 
                     mAxisOrder = interp->mData->mAxisOrder;
                 }
@@ -119,12 +137,12 @@ namespace NifOsg
         else if (!keyctrl->mData.empty())
         {
             const Nif::NiKeyframeData* keydata = keyctrl->mData.getPtr();
-            mRotations = QuaternionInterpolator(keydata->mRotations);
-            mXRotations = FloatInterpolator(keydata->mXRotations);
-            mYRotations = FloatInterpolator(keydata->mYRotations);
-            mZRotations = FloatInterpolator(keydata->mZRotations);
-            mTranslations = Vec3Interpolator(keydata->mTranslations);
-            mScales = FloatInterpolator(keydata->mScales, 1.f);
+            mRotations = makeInterpolator<QuaternionInterpolator>(keydata->mRotations, compact);
+            mXRotations = makeInterpolator<FloatInterpolator>(keydata->mXRotations, compact);
+            mYRotations = makeInterpolator<FloatInterpolator>(keydata->mYRotations, compact);
+            mZRotations = makeInterpolator<FloatInterpolator>(keydata->mZRotations, compact);
+            mTranslations = makeInterpolator<Vec3Interpolator>(keydata->mTranslations, compact);
+            mScales = makeInterpolator<FloatInterpolator>(keydata->mScales, compact, 1.f);
 
             mAxisOrder = keydata->mAxisOrder;
         }
@@ -173,24 +191,46 @@ namespace NifOsg
         return osg::Vec3f();
     }
 
+    const KeyframeController::PoseCache::Entry& KeyframeController::getPose(float time)
+    {
+        // Fine enough to be invisible, while actors started in the same frame still share the poses
+        constexpr float timeStep = 1.f / 240;
+
+        const std::int64_t tick = std::llround(static_cast<double>(time) / timeStep);
+        PoseCache::Entry& entry = mPoseCache->mEntries[static_cast<std::uint64_t>(tick) % mPoseCache->mEntries.size()];
+        if (entry.mTick == tick)
+            return entry;
+
+        const float quantizedTime = static_cast<float>(tick * static_cast<double>(timeStep));
+        if (!mRotations.empty())
+            entry.mRotation = mRotations.interpKey(quantizedTime);
+        else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
+            entry.mRotation = getXYZRotation(quantizedTime);
+        if (!mTranslations.empty())
+            entry.mTranslation = mTranslations.interpKey(quantizedTime);
+        if (!mScales.empty())
+            entry.mScale = mScales.interpKey(quantizedTime);
+        entry.mTick = tick;
+
+        return entry;
+    }
+
     void KeyframeController::operator()(NifOsg::MatrixTransform* node, osg::NodeVisitor* nv)
     {
-        if (hasInput())
+        if (hasInput() && !isOffscreen(nv))
         {
-            float time = getInputValue(nv);
+            const PoseCache::Entry& pose = getPose(getInputValue(nv));
 
-            if (!mRotations.empty())
-                node->setRotation(mRotations.interpKey(time));
-            else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
-                node->setRotation(getXYZRotation(time));
+            if (!mRotations.empty() || !mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
+                node->setRotation(pose.mRotation);
             else
                 node->setRotation(node->mRotationScale);
 
             if (!mTranslations.empty())
-                node->setTranslation(mTranslations.interpKey(time));
+                node->setTranslation(pose.mTranslation);
 
             if (!mScales.empty())
-                node->setScale(mScales.interpKey(time));
+                node->setScale(pose.mScale);
         }
 
         traverse(node, nv);
@@ -233,7 +273,7 @@ namespace NifOsg
 
     void GeomMorpherController::operator()(SceneUtil::MorphGeometry* node, osg::NodeVisitor* nv)
     {
-        if (hasInput())
+        if (hasInput() && !isOffscreen(nv))
         {
             if (mKeyFrames.size() <= 1)
                 return;
@@ -388,7 +428,8 @@ namespace NifOsg
     {
         traverse(node, nv);
 
-        if (hasInput())
+        // The rotation for the time the node was offscreen is applied at once when it is visible again
+        if (hasInput() && !isOffscreen(nv))
         {
             double newTime = nv->getFrameStamp()->getSimulationTime();
             double duration = newTime - mStartingTime;
@@ -615,7 +656,7 @@ namespace NifOsg
 
     void PathController::operator()(NifOsg::MatrixTransform* node, osg::NodeVisitor* nv)
     {
-        if (mPath.empty() || mPercent.empty() || !hasInput())
+        if (mPath.empty() || mPercent.empty() || !hasInput() || isOffscreen(nv))
         {
             traverse(node, nv);
             return;
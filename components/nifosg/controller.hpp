@@ -1,6 +1,11 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <set>
 #include <type_traits>
 
@@ -13,6 +18,8 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include "compactkeys.hpp"
+
 namespace osg
 {
     class Material;
@@ -92,8 +99,17 @@ namespace NifOsg
             }
         }
 
+        ValueInterpolator(std::shared_ptr<const CompactKeys<ValueT>> keys, ValueT defaultVal = ValueT())
+            : mCompactKeys(std::move(keys))
+            , mDefaultVal(defaultVal)
+        {
+        }
+
         ValueT interpKey(float time) const
         {
+            if (mCompactKeys != nullptr)
+                return interpCompactKey(time);
+
             if (empty())
                 return mDefaultVal;
 
@@ -119,9 +135,37 @@ namespace NifOsg
             return keys.rbegin()->second.mValue;
         }
 
-        bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
+        bool empty() const { return mCompactKeys == nullptr && (!mKeys || mKeys->mKeys.empty()); }
 
     private:
+        ValueT interpCompactKey(float time) const
+        {
+            const CompactKeys<ValueT>& keys = *mCompactKeys;
+            const std::vector<float>& times = keys.mTimes;
+
+            if (time <= times.front())
+                return keys.getValue(0);
+            if (time >= times.back())
+                return keys.getValue(times.size() - 1);
+
+            // Same as retrieveKey, optimized for the time moving forward
+            std::size_t high = mLastCompactKey;
+            if (high == 0 || high >= times.size() || time > times[high] || time < times[high - 1])
+            {
+                if (high != 0 && high + 1 < times.size() && time > times[high] && time <= times[high + 1])
+                    ++high;
+                else
+                    high = static_cast<std::size_t>(
+                        std::lower_bound(times.begin(), times.end(), time) - times.begin());
+            }
+            mLastCompactKey = high;
+
+            const float fraction = (time - times[high - 1]) / (times[high] - times[high - 1]);
+            if (keys.mConstant)
+                return fraction > 0.5f ? keys.getValue(high) : keys.getValue(high - 1);
+            return interpolateLinear(keys.getValue(high - 1), keys.getValue(high), fraction);
+        }
+
         template <typename ValueType>
         ValueType interpolate(
             const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
@@ -174,6 +218,9 @@ namespace NifOsg
 
         std::shared_ptr<const MapT> mKeys;
 
+        std::shared_ptr<const CompactKeys<ValueT>> mCompactKeys;
+        mutable std::size_t mLastCompactKey = 0;
+
         ValueT mDefaultVal = ValueT();
     };
 
@@ -231,7 +278,8 @@ namespace NifOsg
     public:
         KeyframeController();
         KeyframeController(const KeyframeController& copy, const osg::CopyOp& copyop);
-        KeyframeController(const Nif::NiKeyframeController* keyctrl);
+        /// @param compact Store the linear and constant tracks in the compact form, see makeCompactKeys.
+        KeyframeController(const Nif::NiKeyframeController* keyctrl, bool compact = false);
 
         META_Object(NifOsg, KeyframeController)
 
@@ -241,6 +289,21 @@ namespace NifOsg
         void operator()(NifOsg::MatrixTransform*, osg::NodeVisitor*);
 
     private:
+        /// Recently evaluated transforms by quantized time, shared by the copies of a controller, so actors playing
+        /// the same animation in sync evaluate the tracks once. Only used from the update traversal.
+        struct PoseCache
+        {
+            struct Entry
+            {
+                std::int64_t mTick = std::numeric_limits<std::int64_t>::min();
+                osg::Quat mRotation;
+                osg::Vec3f mTranslation;
+                float mScale = 1.f;
+            };
+
+            std::array<Entry, 4> mEntries;
+        };
+
         QuaternionInterpolator mRotations;
 
         FloatInterpolator mXRotations;
@@ -252,7 +315,11 @@ namespace NifOsg
 
         Nif::NiKeyframeData::AxisOrder mAxisOrder{ Nif::NiKeyframeData::AxisOrder::Order_XYZ };
 
+        std::shared_ptr<PoseCache> mPoseCache = std::make_shared<PoseCache>();
+
         osg::Quat getXYZRotation(float time) const;
+
+        const PoseCache::Entry& getPose(float time);
     };
 #ifdef _MSC_VER
 #pragma warning(pop)
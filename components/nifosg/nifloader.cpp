@@ -237,6 +237,18 @@ namespace NifOsg
         return sIntersectionDisabledNodeMask;
     }
 
+    bool Loader::sCompactKeyframes = false;
+
+    void Loader::setCompactKeyframes(bool compact)
+    {
+        sCompactKeyframes = compact;
+    }
+
+    bool Loader::getCompactKeyframes()
+    {
+        return sCompactKeyframes;
+    }
+
     class LoaderImpl
     {
     public:
@@ -332,7 +344,7 @@ namespace NifOsg
                     continue;
                 }
 
-                osg::ref_ptr<SceneUtil::KeyframeController> callback = new NifOsg::KeyframeController(key);
+                osg::ref_ptr<SceneUtil::KeyframeController> callback = new NifOsg::KeyframeController(key, Loader::getCompactKeyframes());
                 setupController(key, callback, /*animflags*/ 0);
 
                 if (!target.mKeyframeControllers.emplace(strdata->mData, callback).second)
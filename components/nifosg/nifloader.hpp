@@ -55,10 +55,16 @@ namespace NifOsg
         static void setIntersectionDisabledNodeMask(unsigned int mask);
         static unsigned int getIntersectionDisabledNodeMask();
 
+        /// Set whether keyframe controllers loaded from kf files use the compact keyframe storage with quantized
+        /// rotations, reduced keys and tracks shared between files. Default: false.
+        static void setCompactKeyframes(bool compact);
+        static bool getCompactKeyframes();
+
     private:
         static unsigned int sHiddenNodeMask;
         static unsigned int sIntersectionDisabledNodeMask;
         static bool sShowMarkers;
+        static bool sCompactKeyframes;
     };
 
 }
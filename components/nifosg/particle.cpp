@@ -95,6 +95,14 @@ namespace
         std::optional<osg::Matrix> mLastMatrix;
         osg::Transform* mLastAppliedTransform = nullptr;
     };
+
+    template <class Function>
+    void forEachAliveParticle(osgParticle::Particle* begin, osgParticle::Particle* end, Function&& function)
+    {
+        for (osgParticle::Particle* particle = begin; particle != end; ++particle)
+            if (particle->isAlive())
+                function(*particle);
+    }
 }
 
 namespace NifOsg
@@ -216,6 +224,16 @@ namespace NifOsg
             std::numeric_limits<float>::epsilon(), mLifetime + mLifetimeRandom * Misc::Rng::rollClosedProbability()));
     }
 
+    void BatchedOperator::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        const int count = ps->numParticles();
+        if (count == 0 || !isEnabled())
+            return;
+        // The particles of a system are stored in a single vector
+        osgParticle::Particle* begin = ps->getParticle(0);
+        operateRange(begin, begin + count, dt);
+    }
+
     GrowFadeAffector::GrowFadeAffector(float growTime, float fadeTime)
         : mGrowTime(growTime)
         , mFadeTime(fadeTime)
@@ -231,7 +249,7 @@ namespace NifOsg
     }
 
     GrowFadeAffector::GrowFadeAffector(const GrowFadeAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
     {
         mGrowTime = copy.mGrowTime;
         mFadeTime = copy.mFadeTime;
@@ -243,14 +261,21 @@ namespace NifOsg
         mCachedDefaultSize = program->getParticleSystem()->getDefaultParticleTemplate().getSizeRange().minimum;
     }
 
-    void GrowFadeAffector::operate(osgParticle::Particle* particle, double /* dt */)
+    void GrowFadeAffector::operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double /* dt */)
     {
-        float size = mCachedDefaultSize;
-        if (particle->getAge() < mGrowTime && mGrowTime != 0.f)
-            size *= particle->getAge() / mGrowTime;
-        if (particle->getLifeTime() - particle->getAge() < mFadeTime && mFadeTime != 0.f)
-            size *= (particle->getLifeTime() - particle->getAge()) / mFadeTime;
-        particle->setSizeRange(osgParticle::rangef(size, size));
+        const float growTime = mGrowTime;
+        const float fadeTime = mFadeTime;
+        const float defaultSize = mCachedDefaultSize;
+        forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+            const float age = static_cast<float>(particle.getAge());
+            const float remaining = particle.getLifeTime() - age;
+            float size = defaultSize;
+            if (age < growTime && growTime != 0.f)
+                size *= age / growTime;
+            if (remaining < fadeTime && fadeTime != 0.f)
+                size *= remaining / fadeTime;
+            particle.setSizeRange(osgParticle::rangef(size, size));
+        });
     }
 
     ParticleColorAffector::ParticleColorAffector(const Nif::NiColorData* clrdata)
@@ -261,21 +286,24 @@ namespace NifOsg
     ParticleColorAffector::ParticleColorAffector() {}
 
     ParticleColorAffector::ParticleColorAffector(const ParticleColorAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
     {
         mData = copy.mData;
     }
 
-    void ParticleColorAffector::operate(osgParticle::Particle* particle, double /* dt */)
+    void ParticleColorAffector::operateRange(
+        osgParticle::Particle* begin, osgParticle::Particle* end, double /* dt */)
     {
-        assert(particle->getLifeTime() > 0);
-        float time = static_cast<float>(particle->getAge() / particle->getLifeTime());
-        osg::Vec4f color = mData.interpKey(time);
-        float alpha = color.a();
-        color.a() = 1.0f;
+        forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+            assert(particle.getLifeTime() > 0);
+            float time = static_cast<float>(particle.getAge() / particle.getLifeTime());
+            osg::Vec4f color = mData.interpKey(time);
+            float alpha = color.a();
+            color.a() = 1.0f;
 
-        particle->setColorRange(osgParticle::rangev4(color, color));
-        particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
+            particle.setColorRange(osgParticle::rangev4(color, color));
+            particle.setAlphaRange(osgParticle::rangef(alpha, alpha));
+        });
     }
 
     GravityAffector::GravityAffector(const Nif::NiGravity* gravity)
@@ -288,7 +316,7 @@ namespace NifOsg
     }
 
     GravityAffector::GravityAffector(const GravityAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
     {
         mForce = copy.mForce;
         mType = copy.mType;
@@ -311,36 +339,45 @@ namespace NifOsg
         mCachedWorldDirection.normalize();
     }
 
-    void GravityAffector::operate(osgParticle::Particle* particle, double dt)
+    void GravityAffector::operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt)
     {
         const float magic = 1.6f;
+        const float force = static_cast<float>(mForce * dt * magic);
+        const float decay = mDecay;
+        // The type and the decay are the same for all the particles, so choose the loop once
         switch (mType)
         {
             case Nif::ForceType::Wind:
             {
-                float decayFactor = 1.f;
-                if (mDecay != 0.f)
+                const osg::Vec3f velocity = mCachedWorldDirection * force;
+                if (decay == 0.f)
                 {
-                    osg::Plane gravityPlane(mCachedWorldDirection, mCachedWorldPosition);
-                    float distance = std::abs(gravityPlane.distance(particle->getPosition()));
-                    decayFactor = std::exp(-1.f * mDecay * distance);
+                    forEachAliveParticle(
+                        begin, end, [&](osgParticle::Particle& particle) { particle.addVelocity(velocity); });
+                    break;
                 }
 
-                particle->addVelocity(mCachedWorldDirection * mForce * dt * decayFactor * magic);
-
+                const osg::Plane gravityPlane(mCachedWorldDirection, mCachedWorldPosition);
+                forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+                    float distance = std::abs(gravityPlane.distance(particle.getPosition()));
+                    particle.addVelocity(velocity * std::exp(-1.f * decay * distance));
+                });
                 break;
             }
             case Nif::ForceType::Point:
             {
-                osg::Vec3f diff = mCachedWorldPosition - particle->getPosition();
+                const osg::Vec3f position = mCachedWorldPosition;
+                forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+                    osg::Vec3f diff = position - particle.getPosition();
 
-                float decayFactor = 1.f;
-                if (mDecay != 0.f)
-                    decayFactor = std::exp(-1.f * mDecay * diff.length());
+                    float decayFactor = 1.f;
+                    if (decay != 0.f)
+                        decayFactor = std::exp(-1.f * decay * diff.length());
 
-                diff.normalize();
+                    diff.normalize();
 
-                particle->addVelocity(diff * mForce * dt * decayFactor * magic);
+                    particle.addVelocity(diff * (force * decayFactor));
+                });
                 break;
             }
         }
@@ -357,7 +394,7 @@ namespace NifOsg
     }
 
     ParticleBomb::ParticleBomb(const ParticleBomb& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
     {
         mRange = copy.mRange;
         mStrength = copy.mStrength;
@@ -381,47 +418,56 @@ namespace NifOsg
         }
     }
 
-    void ParticleBomb::operate(osgParticle::Particle* particle, double dt)
+    void ParticleBomb::operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt)
     {
-        float decay = 1.f;
-        osg::Vec3f explosionDir;
+        const float strength = static_cast<float>(mStrength * dt);
+        const float invRange = 1.f / mRange;
+        const osg::Vec3f position = mCachedWorldPosition;
+        const osg::Vec3f direction = mCachedWorldDirection;
+        const Nif::DecayType decayType = mDecayType;
+        const Nif::SymmetryType symmetryType = mSymmetryType;
 
-        osg::Vec3f particleDir = particle->getPosition() - mCachedWorldPosition;
-        float distance = particleDir.length();
-        particleDir.normalize();
+        forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+            float decay = 1.f;
+            osg::Vec3f explosionDir;
 
-        switch (mDecayType)
-        {
-            case Nif::DecayType::None:
-                break;
-            case Nif::DecayType::Linear:
-                decay = 1.f - distance / mRange;
-                break;
-            case Nif::DecayType::Exponential:
-                decay = std::exp(-distance / mRange);
-                break;
-        }
+            osg::Vec3f particleDir = particle.getPosition() - position;
+            float distance = particleDir.length();
+            particleDir.normalize();
 
-        if (decay <= 0.f)
-            return;
+            switch (decayType)
+            {
+                case Nif::DecayType::None:
+                    break;
+                case Nif::DecayType::Linear:
+                    decay = 1.f - distance * invRange;
+                    break;
+                case Nif::DecayType::Exponential:
+                    decay = std::exp(-distance * invRange);
+                    break;
+            }
 
-        switch (mSymmetryType)
-        {
-            case Nif::SymmetryType::Spherical:
-                explosionDir = particleDir;
-                break;
-            case Nif::SymmetryType::Cylindrical:
-                explosionDir = particleDir - mCachedWorldDirection * (mCachedWorldDirection * particleDir);
-                explosionDir.normalize();
-                break;
-            case Nif::SymmetryType::Planar:
-                explosionDir = mCachedWorldDirection;
-                if (explosionDir * particleDir < 0)
-                    explosionDir = -explosionDir;
-                break;
-        }
+            if (decay <= 0.f)
+                return;
+
+            switch (symmetryType)
+            {
+                case Nif::SymmetryType::Spherical:
+                    explosionDir = particleDir;
+                    break;
+                case Nif::SymmetryType::Cylindrical:
+                    explosionDir = particleDir - direction * (direction * particleDir);
+                    explosionDir.normalize();
+                    break;
+                case Nif::SymmetryType::Planar:
+                    explosionDir = direction;
+                    if (explosionDir * particleDir < 0)
+                        explosionDir = -explosionDir;
+                    break;
+            }
 
-        particle->addVelocity(explosionDir * mStrength * decay * dt);
+            particle.addVelocity(explosionDir * (strength * decay));
+        });
     }
 
     Emitter::Emitter()
@@ -614,7 +660,7 @@ namespace NifOsg
     }
 
     PlanarCollider::PlanarCollider(const PlanarCollider& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
         , mBounceFactor(copy.mBounceFactor)
         , mExtents(copy.mExtents)
         , mPosition(copy.mPosition)
@@ -643,31 +689,41 @@ namespace NifOsg
         }
     }
 
-    void PlanarCollider::operate(osgParticle::Particle* particle, double dt)
+    void PlanarCollider::operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double /* dt */)
     {
-        // Does the particle in question move towards the collider?
-        float velDotProduct = particle->getVelocity() * mPlaneInParticleSpace.getNormal();
-        if (velDotProduct <= 0)
-            return;
+        const osg::Plane plane = mPlaneInParticleSpace;
+        const osg::Vec3f normal = plane.getNormal();
+        const osg::Vec3f position = mPositionInParticleSpace;
+        const osg::Vec3f xVector = mXVectorInParticleSpace;
+        const osg::Vec3f yVector = mYVectorInParticleSpace;
+        const osg::Vec2f halfExtents = mExtents * 0.5f;
+        const float bounceFactor = mBounceFactor;
 
-        // Does it intersect the collider's plane?
-        osg::BoundingSphere bs(particle->getPosition(), 0.f);
-        if (mPlaneInParticleSpace.intersect(bs) != 1)
-            return;
+        forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+            // Does the particle in question move towards the collider?
+            float velDotProduct = particle.getVelocity() * normal;
+            if (velDotProduct <= 0)
+                return;
 
-        // Is it inside the collider's bounds?
-        osg::Vec3f relativePos = particle->getPosition() - mPositionInParticleSpace;
-        float xDotProduct = relativePos * mXVectorInParticleSpace;
-        float yDotProduct = relativePos * mYVectorInParticleSpace;
-        if (-mExtents.x() * 0.5f > xDotProduct || mExtents.x() * 0.5f < xDotProduct)
-            return;
-        if (-mExtents.y() * 0.5f > yDotProduct || mExtents.y() * 0.5f < yDotProduct)
-            return;
+            // Does it intersect the collider's plane?
+            osg::BoundingSphere bs(particle.getPosition(), 0.f);
+            if (plane.intersect(bs) != 1)
+                return;
+
+            // Is it inside the collider's bounds?
+            osg::Vec3f relativePos = particle.getPosition() - position;
+            float xDotProduct = relativePos * xVector;
+            float yDotProduct = relativePos * yVector;
+            if (-halfExtents.x() > xDotProduct || halfExtents.x() < xDotProduct)
+                return;
+            if (-halfExtents.y() > yDotProduct || halfExtents.y() < yDotProduct)
+                return;
 
-        // Deflect the particle
-        osg::Vec3 reflectedVelocity = particle->getVelocity() - mPlaneInParticleSpace.getNormal() * (2 * velDotProduct);
-        reflectedVelocity *= mBounceFactor;
-        particle->setVelocity(reflectedVelocity);
+            // Deflect the particle
+            osg::Vec3 reflectedVelocity = particle.getVelocity() - normal * (2 * velDotProduct);
+            reflectedVelocity *= bounceFactor;
+            particle.setVelocity(reflectedVelocity);
+        });
     }
 
     SphericalCollider::SphericalCollider(const Nif::NiSphericalCollider* collider)
@@ -682,7 +738,7 @@ namespace NifOsg
     }
 
     SphericalCollider::SphericalCollider(const SphericalCollider& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : BatchedOperator(copy, copyop)
         , mBounceFactor(copy.mBounceFactor)
         , mSphere(copy.mSphere)
         , mSphereInParticleSpace(copy.mSphereInParticleSpace)
@@ -696,46 +752,51 @@ namespace NifOsg
             mSphereInParticleSpace.center() = program->transformLocalToWorld(mSphereInParticleSpace.center());
     }
 
-    void SphericalCollider::operate(osgParticle::Particle* particle, double dt)
+    void SphericalCollider::operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt)
     {
-        osg::Vec3f cent
-            = (particle->getPosition() - mSphereInParticleSpace.center()); // vector from sphere center to particle
+        const osg::Vec3f center = mSphereInParticleSpace.center();
+        const float radius2 = mSphereInParticleSpace.radius2();
+        const float bounceFactor = mBounceFactor;
 
-        bool insideSphere = cent.length2() <= mSphereInParticleSpace.radius2();
+        forEachAliveParticle(begin, end, [&](osgParticle::Particle& particle) {
+            const osg::Vec3f& velocity = particle.getVelocity();
+            osg::Vec3f cent = particle.getPosition() - center; // vector from sphere center to particle
+
+            bool insideSphere = cent.length2() <= radius2;
+
+            // if outside, make sure the particle is flying towards the sphere
+            if (!insideSphere && cent * velocity >= 0.0f)
+                return;
 
-        if (insideSphere
-            || (cent * particle->getVelocity()
-                < 0.0f)) // if outside, make sure the particle is flying towards the sphere
-        {
             // Collision test (finding point of contact) is performed by solving a quadratic equation:
             // ||vec(cent) + vec(vel)*k|| = R      /^2
             // k^2 + 2*k*(vec(cent)*vec(vel))/||vec(vel)||^2 + (||vec(cent)||^2 - R^2)/||vec(vel)||^2 = 0
 
-            float b = -(cent * particle->getVelocity()) / particle->getVelocity().length2();
+            float b = -(cent * velocity) / velocity.length2();
 
-            osg::Vec3f u = cent + particle->getVelocity() * b;
+            osg::Vec3f u = cent + velocity * b;
 
-            if (insideSphere || (u.length2() < mSphereInParticleSpace.radius2()))
-            {
-                float d = (mSphereInParticleSpace.radius2() - u.length2()) / particle->getVelocity().length2();
-                float k = insideSphere ? (std::sqrt(d) + b) : (b - std::sqrt(d));
+            if (!insideSphere && u.length2() >= radius2)
+                return;
 
-                if (k < dt)
-                {
-                    // collision detected; reflect off the tangent plane
-                    osg::Vec3f contact = particle->getPosition() + particle->getVelocity() * k;
+            float d = (radius2 - u.length2()) / velocity.length2();
+            float k = insideSphere ? (std::sqrt(d) + b) : (b - std::sqrt(d));
 
-                    osg::Vec3 normal = (contact - mSphereInParticleSpace.center());
-                    normal.normalize();
+            if (k >= dt)
+                return;
 
-                    float dotproduct = particle->getVelocity() * normal;
+            // collision detected; reflect off the tangent plane
+            osg::Vec3f contact = particle.getPosition() + velocity * k;
 
-                    osg::Vec3 reflectedVelocity = particle->getVelocity() - normal * (2 * dotproduct);
-                    reflectedVelocity *= mBounceFactor;
-                    particle->setVelocity(reflectedVelocity);
-                }
-            }
-        }
+            osg::Vec3 normal = (contact - center);
+            normal.normalize();
+
+            float dotproduct = velocity * normal;
+
+            osg::Vec3 reflectedVelocity = velocity - normal * (2 * dotproduct);
+            reflectedVelocity *= bounceFactor;
+            particle.setVelocity(reflectedVelocity);
+        });
     }
 
 }
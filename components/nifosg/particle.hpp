@@ -98,7 +98,27 @@ namespace NifOsg
         float mLifetimeRandom;
     };
 
-    class PlanarCollider : public osgParticle::Operator
+    // Operator handling all the particles of a system in a single call instead of a virtual operate() call per
+    // particle. The state shared by the particles is set up once per call and the loop over the contiguous particle
+    // storage of the system is visible to the compiler.
+    class BatchedOperator : public osgParticle::Operator
+    {
+    public:
+        BatchedOperator() = default;
+        BatchedOperator(const BatchedOperator& copy, const osg::CopyOp& copyop)
+            : osgParticle::Operator(copy, copyop)
+        {
+        }
+
+        void operate(osgParticle::Particle* particle, double dt) final { operateRange(particle, particle + 1, dt); }
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) final;
+
+    protected:
+        // Skips the dead particles of [begin, end)
+        virtual void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) = 0;
+    };
+
+    class PlanarCollider : public BatchedOperator
     {
     public:
         PlanarCollider(const Nif::NiPlanarCollider* collider);
@@ -108,7 +128,9 @@ namespace NifOsg
         META_Object(NifOsg, PlanarCollider)
 
         void beginOperate(osgParticle::Program* program) override;
-        void operate(osgParticle::Particle* particle, double dt) override;
+
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
 
     private:
         float mBounceFactor{ 0.f };
@@ -119,7 +141,7 @@ namespace NifOsg
         osg::Plane mPlane, mPlaneInParticleSpace;
     };
 
-    class SphericalCollider : public osgParticle::Operator
+    class SphericalCollider : public BatchedOperator
     {
     public:
         SphericalCollider(const Nif::NiSphericalCollider* collider);
@@ -129,7 +151,9 @@ namespace NifOsg
         META_Object(NifOsg, SphericalCollider)
 
         void beginOperate(osgParticle::Program* program) override;
-        void operate(osgParticle::Particle* particle, double dt) override;
+
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
 
     private:
         float mBounceFactor;
@@ -137,7 +161,7 @@ namespace NifOsg
         osg::BoundingSphere mSphereInParticleSpace;
     };
 
-    class GrowFadeAffector : public osgParticle::Operator
+    class GrowFadeAffector : public BatchedOperator
     {
     public:
         GrowFadeAffector(float growTime, float fadeTime);
@@ -149,7 +173,9 @@ namespace NifOsg
         META_Object(NifOsg, GrowFadeAffector)
 
         void beginOperate(osgParticle::Program* program) override;
-        void operate(osgParticle::Particle* particle, double dt) override;
+
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
 
     private:
         float mGrowTime;
@@ -158,7 +184,7 @@ namespace NifOsg
         float mCachedDefaultSize;
     };
 
-    class ParticleColorAffector : public osgParticle::Operator
+    class ParticleColorAffector : public BatchedOperator
     {
     public:
         ParticleColorAffector(const Nif::NiColorData* clrdata);
@@ -169,13 +195,14 @@ namespace NifOsg
 
         META_Object(NifOsg, ParticleColorAffector)
 
-        void operate(osgParticle::Particle* particle, double dt) override;
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
 
     private:
         Vec4Interpolator mData;
     };
 
-    class GravityAffector : public osgParticle::Operator
+    class GravityAffector : public BatchedOperator
     {
     public:
         GravityAffector(const Nif::NiGravity* gravity);
@@ -186,9 +213,11 @@ namespace NifOsg
 
         META_Object(NifOsg, GravityAffector)
 
-        void operate(osgParticle::Particle* particle, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
+
     private:
         float mForce{ 0.f };
         Nif::ForceType mType{ Nif::ForceType::Wind };
@@ -199,7 +228,7 @@ namespace NifOsg
         osg::Vec3f mCachedWorldDirection;
     };
 
-    class ParticleBomb : public osgParticle::Operator
+    class ParticleBomb : public BatchedOperator
     {
     public:
         ParticleBomb(const Nif::NiParticleBomb* bomb);
@@ -210,9 +239,11 @@ namespace NifOsg
 
         META_Object(NifOsg, ParticleBomb)
 
-        void operate(osgParticle::Particle* particle, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
+    protected:
+        void operateRange(osgParticle::Particle* begin, osgParticle::Particle* end, double dt) override;
+
     private:
         float mRange{ 0.f };
         float mStrength{ 0.f };
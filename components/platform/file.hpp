@@ -30,6 +30,10 @@ namespace Platform::File
 
     size_t read(Handle handle, void* data, size_t size);
 
+    /// Hint the system to start reading the given part of the file into the page cache. Returns without waiting for
+    /// the data and does nothing when the platform has no such hint.
+    void prefetch(Handle handle, size_t offset, size_t size) noexcept;
+
     class ScopedHandle
     {
         Handle mHandle{ Handle::Invalid };
@@ -63,6 +67,27 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    /// Read-only mapping of the whole file contents into the address space of the process.
+    class MappedFile
+    {
+        const char* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        /// @throw std::system_error or std::runtime_error when the file can not be mapped.
+        explicit MappedFile(const std::filesystem::path& filename);
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        ~MappedFile();
+
+        const char* data() const { return mData; }
+
+        size_t size() const { return mSize; }
+
+        /// Hint the system to page in the given part of the mapping. Returns without waiting for the data.
+        void prefetch(size_t offset, size_t size) const noexcept;
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
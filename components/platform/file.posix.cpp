@@ -1,11 +1,14 @@
 #include "file.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <errno.h>
 #include <fcntl.h>
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +106,55 @@ namespace Platform::File
         return amount;
     }
 
+    void prefetch(Handle handle, size_t offset, size_t size) noexcept
+    {
+#ifdef POSIX_FADV_WILLNEED
+        ::posix_fadvise(getNativeHandle(handle), static_cast<off_t>(offset), static_cast<off_t>(size),
+            POSIX_FADV_WILLNEED);
+#else
+        (void)handle;
+        (void)offset;
+        (void)size;
+#endif
+    }
+
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        ScopedHandle handle(open(filename));
+        const auto nativeHandle = getNativeHandle(handle);
+
+        struct stat fileStat;
+        if (::fstat(nativeHandle, &fileStat) == -1)
+            throw std::system_error(errno, std::generic_category(), "An fstat() call failed");
+
+        mSize = static_cast<size_t>(fileStat.st_size);
+        if (mSize == 0)
+            return;
+
+        void* data = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, nativeHandle, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                std::string("Failed to map '") + Files::pathToUnicodeString(filename) + "' into memory");
+        }
+        mData = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData != nullptr)
+            ::munmap(const_cast<char*>(mData), mSize);
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t size) const noexcept
+    {
+        if (mData == nullptr || offset >= mSize)
+            return;
+        // madvise requires a page aligned address
+        const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = offset - offset % pageSize;
+        const size_t end = std::min(mSize, offset + size);
+        ::madvise(const_cast<char*>(mData + begin), end - begin, MADV_WILLNEED);
+    }
+
 }
@@ -93,4 +93,39 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    void prefetch(Handle /*handle*/, size_t /*offset*/, size_t /*size*/) noexcept {}
+
+    // There is no portable way to map a file into memory, so read the whole file instead.
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        ScopedHandle handle(open(filename));
+
+        mSize = Platform::File::size(handle);
+        if (mSize == 0)
+            return;
+
+        char* data = new char[mSize];
+        size_t offset = 0;
+        while (offset < mSize)
+        {
+            const size_t amount = read(handle, data + offset, mSize - offset);
+            if (amount == 0)
+            {
+                delete[] data;
+                throw std::runtime_error(
+                    std::string("Unexpected end of file while reading '") + Files::pathToUnicodeString(filename) + "'");
+            }
+            offset += amount;
+        }
+        mData = data;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        delete[] mData;
+    }
+
+    // The contents are already in memory
+    void MappedFile::prefetch(size_t /*offset*/, size_t /*size*/) const noexcept {}
+
 }
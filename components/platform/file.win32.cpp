@@ -1,6 +1,7 @@
 #include "file.hpp"
 
 #include <boost/locale.hpp>
+#include <algorithm>
 #include <cassert>
 #include <components/misc/windows.hpp>
 #include <stdexcept>
@@ -100,4 +101,57 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    // There is no read-ahead hint for file handles, sequential reads are detected by the cache manager
+    void prefetch(Handle /*handle*/, size_t /*offset*/, size_t /*size*/) noexcept {}
+
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        ScopedHandle handle(open(filename));
+        const auto nativeHandle = getNativeHandle(handle);
+
+        mSize = Platform::File::size(handle);
+        if (mSize == 0)
+            return;
+
+        HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to create file mapping for '")
+                + Files::pathToUnicodeString(filename) + "': " + std::to_string(GetLastError()));
+        }
+
+        // The view keeps the mapping object alive, so the handle can be closed right away
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        const DWORD errCode = GetLastError();
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "' into memory: " + std::to_string(errCode));
+        }
+        mData = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t size) const noexcept
+    {
+#if _WIN32_WINNT >= 0x0602
+        if (mData == nullptr || offset >= mSize)
+            return;
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<char*>(mData + offset);
+        range.NumberOfBytes = std::min(size, mSize - offset);
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        (void)offset;
+        (void)size;
+#endif
+    }
+
 }
@@ -0,0 +1,562 @@
+#include "bulletshapecache.hpp"
+
+#include "bulletshape.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <LinearMath/btScalar.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/endianness.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'S', 'H', 'C' };
+
+        // Increment when the cached data or the way the shapes are loaded changes
+        constexpr std::uint32_t sVersion = 1;
+
+        enum class ShapeType : std::uint32_t
+        {
+            Compound,
+            ScaledTriangleMesh,
+            TriangleMesh,
+        };
+
+        // The quantized BVH is stored in its in-memory layout, so it is readable only by the same build of Bullet
+        struct Header
+        {
+            std::uint32_t mVersion = sVersion;
+            std::uint32_t mBulletVersion = BT_BULLET_VERSION;
+            std::uint32_t mScalarSize = sizeof(btScalar);
+            std::uint32_t mPointerSize = sizeof(void*);
+            std::uint32_t mLittleEndian = Misc::IS_LITTLE_ENDIAN;
+
+            friend bool operator==(const Header& l, const Header& r)
+            {
+                return std::tie(l.mVersion, l.mBulletVersion, l.mScalarSize, l.mPointerSize, l.mLittleEndian)
+                    == std::tie(r.mVersion, r.mBulletVersion, r.mScalarSize, r.mPointerSize, r.mLittleEndian);
+            }
+        };
+
+        // A node of a shape tree stored in depth first order, children of a compound follow it
+        struct ShapeNode
+        {
+            std::uint32_t mType = static_cast<std::uint32_t>(ShapeType::TriangleMesh);
+            // The transform within the parent compound: the basis rows followed by the origin
+            btScalar mTransform[12] = {};
+            btScalar mScaling[3] = {};
+            std::uint32_t mChildren = 0;
+            std::uint32_t mMesh = 0;
+        };
+
+        struct Mesh
+        {
+            std::vector<btScalar> mVertices;
+            std::vector<std::uint32_t> mIndices;
+            std::vector<char> mBvh;
+        };
+
+        struct CachedShape
+        {
+            std::vector<char> mFileName;
+            std::vector<char> mFileHash;
+            float mCollisionBox[6] = {};
+            std::vector<std::int32_t> mAnimatedShapes;
+            std::int32_t mVisualCollisionType = 0;
+            std::vector<ShapeNode> mCollisionShape;
+            std::vector<ShapeNode> mAvoidCollisionShape;
+            std::vector<Mesh> mMeshes;
+        };
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Header>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, sMagic);
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(sMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, sMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad shape cache magic");
+                }
+                visitor(*this, value.mVersion);
+                visitor(*this, value.mBulletVersion);
+                visitor(*this, value.mScalarSize);
+                visitor(*this, value.mPointerSize);
+                visitor(*this, value.mLittleEndian);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ShapeNode>>
+            {
+                visitor(*this, value.mType);
+                visitor(*this, value.mTransform);
+                visitor(*this, value.mScaling);
+                visitor(*this, value.mChildren);
+                visitor(*this, value.mMesh);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Mesh>>
+            {
+                visitor(*this, value.mVertices);
+                visitor(*this, value.mIndices);
+                visitor(*this, value.mBvh);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedShape>>
+            {
+                visitor(*this, value.mFileName);
+                visitor(*this, value.mFileHash);
+                visitor(*this, value.mCollisionBox);
+                visitor(*this, value.mAnimatedShapes);
+                visitor(*this, value.mVisualCollisionType);
+                visitor(*this, value.mCollisionShape);
+                visitor(*this, value.mAvoidCollisionShape);
+                visitor(*this, value.mMeshes);
+            }
+        };
+
+        struct FreeAligned
+        {
+            void operator()(void* buffer) const { btAlignedFree(buffer); }
+        };
+
+        using AlignedBuffer = std::unique_ptr<void, FreeAligned>;
+
+        // Owns the buffer the BVH is deserialized into
+        class CachedTriangleMeshShape final : public TriangleMeshShape
+        {
+        public:
+            CachedTriangleMeshShape(std::unique_ptr<btTriangleMesh> mesh, const std::vector<char>& bvh)
+                : TriangleMeshShape(mesh.get(), true, false)
+            {
+                std::ignore = mesh.release();
+                const unsigned size = static_cast<unsigned>(bvh.size());
+                AlignedBuffer buffer(btAlignedAlloc(size, 16));
+                std::memcpy(buffer.get(), bvh.data(), size);
+                btOptimizedBvh* const optimizedBvh = btOptimizedBvh::deSerializeInPlace(buffer.get(), size, false);
+                if (optimizedBvh == nullptr)
+                    throw std::runtime_error("Invalid BVH");
+                setOptimizedBvh(optimizedBvh);
+                mBvhBuffer = std::move(buffer);
+            }
+
+            ~CachedTriangleMeshShape() override
+            {
+                // The BVH is not owned by btBvhTriangleMeshShape when it is set with setOptimizedBvh
+                getOptimizedBvh()->~btOptimizedBvh();
+            }
+
+        private:
+            AlignedBuffer mBvhBuffer;
+        };
+
+        void writeTransform(const btTransform& transform, btScalar (&out)[12])
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    out[i * 3 + j] = transform.getBasis()[i][j];
+            for (int i = 0; i < 3; ++i)
+                out[9 + i] = transform.getOrigin()[i];
+        }
+
+        btTransform readTransform(const btScalar (&value)[12])
+        {
+            const btMatrix3x3 basis(
+                value[0], value[1], value[2], value[3], value[4], value[5], value[6], value[7], value[8]);
+            return btTransform(basis, btVector3(value[9], value[10], value[11]));
+        }
+
+        bool isUnitScaling(const btVector3& scaling)
+        {
+            return (scaling - btVector3(1, 1, 1)).length2() <= SIMD_EPSILON;
+        }
+
+        bool writeMesh(const btBvhTriangleMeshShape& shape, Mesh& mesh)
+        {
+            btOptimizedBvh* const bvh = const_cast<btBvhTriangleMeshShape&>(shape).getOptimizedBvh();
+            const btStridingMeshInterface& meshInterface = *shape.getMeshInterface();
+            if (bvh == nullptr || !shape.usesQuantizedAabbCompression() || shape.getTriangleInfoMap() != nullptr
+                || meshInterface.getNumSubParts() != 1 || !isUnitScaling(meshInterface.getScaling()))
+                return false;
+
+            const unsigned char* vertexBase = nullptr;
+            int numVertices = 0;
+            PHY_ScalarType vertexType = PHY_FLOAT;
+            int vertexStride = 0;
+            const unsigned char* indexBase = nullptr;
+            int indexStride = 0;
+            int numFaces = 0;
+            PHY_ScalarType indexType = PHY_INTEGER;
+            meshInterface.getLockedReadOnlyVertexIndexBase(&vertexBase, numVertices, vertexType, vertexStride,
+                &indexBase, indexStride, numFaces, indexType, 0);
+
+            const bool supported = (vertexType == PHY_FLOAT || vertexType == PHY_DOUBLE)
+                && (indexType == PHY_INTEGER || indexType == PHY_SHORT);
+            if (supported)
+            {
+                mesh.mVertices.reserve(static_cast<std::size_t>(numVertices) * 3);
+                for (int i = 0; i < numVertices; ++i)
+                {
+                    const unsigned char* const vertex = vertexBase + static_cast<std::ptrdiff_t>(i) * vertexStride;
+                    for (int j = 0; j < 3; ++j)
+                        mesh.mVertices.push_back(vertexType == PHY_FLOAT
+                                ? static_cast<btScalar>(reinterpret_cast<const float*>(vertex)[j])
+                                : static_cast<btScalar>(reinterpret_cast<const double*>(vertex)[j]));
+                }
+                mesh.mIndices.reserve(static_cast<std::size_t>(numFaces) * 3);
+                for (int i = 0; i < numFaces; ++i)
+                {
+                    const unsigned char* const face = indexBase + static_cast<std::ptrdiff_t>(i) * indexStride;
+                    for (int j = 0; j < 3; ++j)
+                        mesh.mIndices.push_back(indexType == PHY_INTEGER
+                                ? reinterpret_cast<const std::uint32_t*>(face)[j]
+                                : reinterpret_cast<const std::uint16_t*>(face)[j]);
+                }
+            }
+
+            meshInterface.unLockReadOnlyVertexBase(0);
+
+            if (!supported)
+                return false;
+
+            const unsigned size = bvh->calculateSerializeBufferSize();
+            AlignedBuffer buffer(btAlignedAlloc(size, 16));
+            if (!bvh->serializeInPlace(buffer.get(), size, false))
+                return false;
+            const char* const data = static_cast<const char*>(buffer.get());
+            mesh.mBvh.assign(data, data + size);
+            return true;
+        }
+
+        bool writeShape(const btCollisionShape& shape, const btTransform& transform, std::vector<ShapeNode>& nodes,
+            CachedShape& cached)
+        {
+            ShapeNode node;
+            writeTransform(transform, node.mTransform);
+
+            switch (shape.getShapeType())
+            {
+                case COMPOUND_SHAPE_PROXYTYPE:
+                {
+                    const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+                    if (!isUnitScaling(compound.getLocalScaling()))
+                        return false;
+                    node.mType = static_cast<std::uint32_t>(ShapeType::Compound);
+                    node.mChildren = static_cast<std::uint32_t>(compound.getNumChildShapes());
+                    nodes.push_back(node);
+                    for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                        if (!writeShape(*compound.getChildShape(i), compound.getChildTransform(i), nodes, cached))
+                            return false;
+                    return true;
+                }
+                case SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE:
+                {
+                    const btScaledBvhTriangleMeshShape& scaled
+                        = static_cast<const btScaledBvhTriangleMeshShape&>(shape);
+                    node.mType = static_cast<std::uint32_t>(ShapeType::ScaledTriangleMesh);
+                    for (int i = 0; i < 3; ++i)
+                        node.mScaling[i] = scaled.getLocalScaling()[i];
+                    nodes.push_back(node);
+                    return writeShape(*scaled.getChildShape(), btTransform::getIdentity(), nodes, cached);
+                }
+                case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+                {
+                    const btBvhTriangleMeshShape& triangleMesh = static_cast<const btBvhTriangleMeshShape&>(shape);
+                    if (!isUnitScaling(triangleMesh.getLocalScaling()))
+                        return false;
+                    node.mType = static_cast<std::uint32_t>(ShapeType::TriangleMesh);
+                    node.mMesh = static_cast<std::uint32_t>(cached.mMeshes.size());
+                    if (!writeMesh(triangleMesh, cached.mMeshes.emplace_back()))
+                        return false;
+                    nodes.push_back(node);
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        CollisionShapePtr readMesh(const Mesh& mesh)
+        {
+            if (mesh.mVertices.size() % 3 != 0 || mesh.mIndices.empty() || mesh.mIndices.size() % 3 != 0)
+                throw std::runtime_error("Invalid triangle mesh");
+            if (mesh.mBvh.size() < sizeof(btQuantizedBvh))
+                throw std::runtime_error("Invalid BVH size");
+            const std::size_t numVertices = mesh.mVertices.size() / 3;
+
+            auto triangles = std::make_unique<btTriangleMesh>();
+            triangles->preallocateVertices(static_cast<int>(numVertices));
+            for (std::size_t i = 0; i < mesh.mVertices.size(); i += 3)
+                triangles->findOrAddVertex(
+                    btVector3(mesh.mVertices[i], mesh.mVertices[i + 1], mesh.mVertices[i + 2]), false);
+            triangles->preallocateIndices(static_cast<int>(mesh.mIndices.size()));
+            for (std::size_t i = 0; i < mesh.mIndices.size(); i += 3)
+            {
+                if (mesh.mIndices[i] >= numVertices || mesh.mIndices[i + 1] >= numVertices
+                    || mesh.mIndices[i + 2] >= numVertices)
+                    throw std::runtime_error("Triangle index is out of range");
+                triangles->addTriangleIndices(static_cast<int>(mesh.mIndices[i]),
+                    static_cast<int>(mesh.mIndices[i + 1]), static_cast<int>(mesh.mIndices[i + 2]));
+            }
+
+            return CollisionShapePtr(new CachedTriangleMeshShape(std::move(triangles), mesh.mBvh));
+        }
+
+        CollisionShapePtr readShape(const CachedShape& cached, const std::vector<ShapeNode>& nodes, std::size_t& next)
+        {
+            if (next >= nodes.size())
+                throw std::runtime_error("Unexpected end of shape nodes");
+            const ShapeNode& node = nodes[next++];
+
+            switch (static_cast<ShapeType>(node.mType))
+            {
+                case ShapeType::Compound:
+                {
+                    CollisionShapePtr result(new btCompoundShape);
+                    btCompoundShape& compound = static_cast<btCompoundShape&>(*result);
+                    for (std::uint32_t i = 0; i < node.mChildren; ++i)
+                    {
+                        if (next >= nodes.size())
+                            throw std::runtime_error("Unexpected end of shape nodes");
+                        const btTransform transform = readTransform(nodes[next].mTransform);
+                        CollisionShapePtr child = readShape(cached, nodes, next);
+                        compound.addChildShape(transform, child.get());
+                        std::ignore = child.release();
+                    }
+                    return result;
+                }
+                case ShapeType::ScaledTriangleMesh:
+                {
+                    CollisionShapePtr child = readShape(cached, nodes, next);
+                    if (child->getShapeType() != TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                        throw std::runtime_error("Scaled shape child is not a triangle mesh");
+                    CollisionShapePtr result(
+                        new ScaledTriangleMeshShape(static_cast<btBvhTriangleMeshShape*>(child.get()),
+                            btVector3(node.mScaling[0], node.mScaling[1], node.mScaling[2])));
+                    std::ignore = child.release();
+                    return result;
+                }
+                case ShapeType::TriangleMesh:
+                    if (node.mMesh >= cached.mMeshes.size())
+                        throw std::runtime_error("Mesh index is out of range");
+                    return readMesh(cached.mMeshes[node.mMesh]);
+            }
+
+            throw std::runtime_error("Unknown shape type: " + std::to_string(node.mType));
+        }
+
+        CollisionShapePtr readShape(const CachedShape& cached, const std::vector<ShapeNode>& nodes)
+        {
+            if (nodes.empty())
+                return nullptr;
+            std::size_t next = 0;
+            CollisionShapePtr result = readShape(cached, nodes, next);
+            if (next != nodes.size())
+                throw std::runtime_error("Unused shape nodes");
+            return result;
+        }
+
+        bool toCachedShape(const BulletShape& shape, CachedShape& cached)
+        {
+            cached.mFileName.assign(shape.mFileName.begin(), shape.mFileName.end());
+            cached.mFileHash.assign(shape.mFileHash.begin(), shape.mFileHash.end());
+            for (int i = 0; i < 3; ++i)
+            {
+                cached.mCollisionBox[i] = shape.mCollisionBox.mExtents[i];
+                cached.mCollisionBox[3 + i] = shape.mCollisionBox.mCenter[i];
+            }
+            for (const auto& [recIndex, childIndex] : shape.mAnimatedShapes)
+            {
+                cached.mAnimatedShapes.push_back(recIndex);
+                cached.mAnimatedShapes.push_back(childIndex);
+            }
+            cached.mVisualCollisionType = static_cast<std::int32_t>(shape.mVisualCollisionType);
+            if (shape.mCollisionShape != nullptr
+                && !writeShape(*shape.mCollisionShape, btTransform::getIdentity(), cached.mCollisionShape, cached))
+                return false;
+            if (shape.mAvoidCollisionShape != nullptr
+                && !writeShape(
+                    *shape.mAvoidCollisionShape, btTransform::getIdentity(), cached.mAvoidCollisionShape, cached))
+                return false;
+            return true;
+        }
+
+        osg::ref_ptr<BulletShape> fromCachedShape(const CachedShape& cached)
+        {
+            if (cached.mAnimatedShapes.size() % 2 != 0)
+                throw std::runtime_error("Invalid animated shapes");
+
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mFileName.assign(cached.mFileName.begin(), cached.mFileName.end());
+            shape->mFileHash.assign(cached.mFileHash.begin(), cached.mFileHash.end());
+            for (int i = 0; i < 3; ++i)
+            {
+                shape->mCollisionBox.mExtents[i] = cached.mCollisionBox[i];
+                shape->mCollisionBox.mCenter[i] = cached.mCollisionBox[3 + i];
+            }
+            for (std::size_t i = 0; i < cached.mAnimatedShapes.size(); i += 2)
+                shape->mAnimatedShapes.emplace(cached.mAnimatedShapes[i], cached.mAnimatedShapes[i + 1]);
+            shape->mVisualCollisionType = static_cast<VisualCollisionType>(cached.mVisualCollisionType);
+            shape->mCollisionShape = readShape(cached, cached.mCollisionShape);
+            shape->mAvoidCollisionShape = readShape(cached, cached.mAvoidCollisionShape);
+            return shape;
+        }
+
+        std::vector<std::byte> serialize(const CachedShape& cached)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            const Header header;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, header);
+            format(sizeAccumulator, cached);
+            std::vector<std::byte> buffer(sizeAccumulator.value());
+            Serialization::BinaryWriter writer(buffer.data(), buffer.data() + buffer.size());
+            format(writer, header);
+            format(writer, cached);
+            return buffer;
+        }
+    }
+
+    BulletShapeCache::BulletShapeCache(const std::filesystem::path& directory)
+        : mDirectory(directory)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create shape cache directory " << directory << ": " << ec.message();
+            mDirectory.clear();
+        }
+    }
+
+    BulletShapeCache::~BulletShapeCache() = default;
+
+    std::string BulletShapeCache::getKey(std::string_view fileName, std::string_view fileHash) const
+    {
+        std::string data(reinterpret_cast<const char*>(&sVersion), sizeof(sVersion));
+        data.append(fileName);
+        data.push_back('\0');
+        data.append(fileHash);
+        const std::array<std::uint64_t, 2> hash = Files::getHash(data);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return key.str();
+    }
+
+    std::filesystem::path BulletShapeCache::getPath(const std::string& key) const
+    {
+        return mDirectory / (key + ".shape");
+    }
+
+    osg::ref_ptr<BulletShape> BulletShapeCache::read(const std::string& key) const
+    {
+        if (mDirectory.empty())
+            return nullptr;
+        const std::filesystem::path path = getPath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+        try
+        {
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(path, ec);
+            if (ec)
+                throw std::runtime_error(ec.message());
+            std::vector<std::byte> buffer(static_cast<std::size_t>(size));
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+                throw std::runtime_error("failed to read file");
+
+            constexpr Format<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(buffer.data(), buffer.data() + buffer.size());
+            Header header;
+            format(reader, header);
+            // Written by another version, it is replaced once the shape is loaded from its file
+            if (!(header == Header{}))
+                return nullptr;
+            CachedShape cached;
+            format(reader, cached);
+            return fromCachedShape(cached);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read cached shape " << path << ": " << e.what();
+            return nullptr;
+        }
+    }
+
+    void BulletShapeCache::write(const std::string& key, const BulletShape& shape) const
+    {
+        if (mDirectory.empty())
+            return;
+        const std::filesystem::path path = getPath(key);
+
+        CachedShape cached;
+        if (!toCachedShape(shape, cached))
+        {
+            Log(Debug::Verbose) << "Shape from " << shape.mFileName << " is not supported by the shape cache";
+            return;
+        }
+
+        // The same shape may be loaded by other threads at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            const std::vector<std::byte> data = serialize(cached);
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                if (!stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))
+                    || !stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached shape " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
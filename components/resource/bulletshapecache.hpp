@@ -0,0 +1,43 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPECACHE_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+namespace Resource
+{
+    struct BulletShape;
+
+    /// @brief Stores collision shapes loaded from NIF files on disk together with their triangle meshes and quantized
+    /// BVHs, so that later sessions load them without building the BVHs again.
+    /// @par A shape is identified by the path and the content hash of the file it is loaded from. Only shapes
+    /// consisting of compounds and triangle meshes are stored.
+    class BulletShapeCache : public osg::Referenced
+    {
+    public:
+        explicit BulletShapeCache(const std::filesystem::path& directory);
+
+        ~BulletShapeCache();
+
+        std::string getKey(std::string_view fileName, std::string_view fileHash) const;
+
+        /// @return nullptr if the shape isn't cached.
+        /// @note Thread safe.
+        osg::ref_ptr<BulletShape> read(const std::string& key) const;
+
+        /// Add the loaded shape to the cache. Must be called before the shape is used by other threads.
+        /// @note Thread safe.
+        void write(const std::string& key, const BulletShape& shape) const;
+
+    private:
+        std::filesystem::path getPath(const std::string& key) const;
+
+        std::filesystem::path mDirectory;
+    };
+}
+
+#endif
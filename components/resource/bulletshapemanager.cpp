@@ -15,9 +15,11 @@
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include <components/nif/niffile.hpp>
 #include <components/nifbullet/bulletnifloader.hpp>
 
 #include "bulletshape.hpp"
+#include "bulletshapecache.hpp"
 #include "multiobjectcache.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
@@ -120,8 +122,20 @@ namespace Resource
         {
             if (Misc::getFileExtension(normalized) == "nif")
             {
-                NifBullet::BulletNifLoader loader;
-                shape = loader.load(*mNifFileManager->get(normalized));
+                const Nif::NIFFilePtr file = mNifFileManager->get(normalized);
+                std::string key;
+                if (mShapeCache != nullptr)
+                {
+                    key = mShapeCache->getKey(normalized.value(), Nif::FileView(*file).getHash());
+                    shape = mShapeCache->read(key);
+                }
+                if (shape == nullptr)
+                {
+                    NifBullet::BulletNifLoader loader;
+                    shape = loader.load(*file);
+                    if (mShapeCache != nullptr)
+                        mShapeCache->write(key, *shape);
+                }
             }
             else
             {
@@ -217,4 +231,9 @@ namespace Resource
         Resource::reportStats("Shape Instance", frameNumber, mInstanceCache->getStats(), *stats);
     }
 
+    void BulletShapeManager::setShapeCache(osg::ref_ptr<BulletShapeCache> cache)
+    {
+        mShapeCache = std::move(cache);
+    }
+
 }
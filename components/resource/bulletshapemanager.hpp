@@ -18,6 +18,7 @@ namespace Resource
     class BulletShapeInstance;
 
     class MultiObjectCache;
+    class BulletShapeCache;
 
     /// Handles loading, caching and "instancing" of bullet shapes.
     /// A shape 'instance' is a clone of another shape, with the goal of setting a different scale on this instance.
@@ -48,12 +49,17 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        /// Read shapes loaded from NIF files from \a cache and write them there when they are not cached yet.
+        /// @note Must be called before the manager is used by other threads.
+        void setShapeCache(osg::ref_ptr<BulletShapeCache> cache);
+
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(const std::string& name);
 
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
+        osg::ref_ptr<BulletShapeCache> mShapeCache;
     };
 
 }
@@ -16,6 +16,8 @@
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -87,13 +89,10 @@ namespace Resource
             return result;
         }
 
-        template <class F>
-        void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
-            Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f)
+        std::vector<BulletObject> loadObjects(std::vector<CellRef>& cellRefs, const EsmLoader::EsmData& esmData,
+            const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager)
         {
-            std::vector<CellRef> cellRefs = loadCellRefs(cell, esmData, readers);
-
-            Log(Debug::Debug) << "Prepared " << cellRefs.size() << " unique cell refs";
+            std::vector<BulletObject> result;
 
             for (CellRef& cellRef : cellRefs)
             {
@@ -126,21 +125,54 @@ namespace Resource
                     case ESM::REC_CONT:
                     case ESM::REC_DOOR:
                     case ESM::REC_STAT:
-                        f(BulletObject{ std::move(shape), cellRef.mPos, cellRef.mScale });
+                        result.push_back(BulletObject{ std::move(shape), cellRef.mPos, cellRef.mScale });
                         break;
                     default:
                         break;
                 }
             }
+
+            return result;
         }
     }
 
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
-        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData, std::size_t threads,
         std::function<void(const ESM::Cell& cell, const BulletObject& object)> callback)
     {
         Log(Debug::Info) << "Processing " << esmData.mCells.size() << " cells...";
 
+        // Readers can't be shared between threads so cell refs are loaded upfront. The shapes are loaded by the
+        // worker threads while the callback is called for the cells in order by the calling thread.
+        std::vector<std::vector<CellRef>> cellRefs;
+        std::vector<std::promise<std::vector<BulletObject>>> objects(esmData.mCells.size());
+        std::atomic_size_t next = 0;
+        std::vector<std::future<void>> workers;
+
+        if (threads > 1)
+        {
+            cellRefs.reserve(esmData.mCells.size());
+            for (const ESM::Cell& cell : esmData.mCells)
+                cellRefs.push_back(loadCellRefs(cell, esmData, readers));
+
+            const auto work = [&] {
+                for (std::size_t i = next++; i < cellRefs.size(); i = next++)
+                {
+                    try
+                    {
+                        objects[i].set_value(loadObjects(cellRefs[i], esmData, vfs, bulletShapeManager));
+                    }
+                    catch (...)
+                    {
+                        objects[i].set_exception(std::current_exception());
+                    }
+                }
+            };
+
+            for (std::size_t i = 0; i < threads; ++i)
+                workers.push_back(std::async(std::launch::async, work));
+        }
+
         for (std::size_t i = 0; i < esmData.mCells.size(); ++i)
         {
             const ESM::Cell& cell = esmData.mCells[i];
@@ -149,16 +181,24 @@ namespace Resource
             Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
                               << esmData.mCells.size() << ") \"" << cell.getDescription() << "\"";
 
-            std::size_t objects = 0;
+            std::vector<BulletObject> cellObjects;
+
+            if (threads > 1)
+            {
+                cellObjects = objects[i].get_future().get();
+            }
+            else
+            {
+                std::vector<CellRef> refs = loadCellRefs(cell, esmData, readers);
+                cellObjects = loadObjects(refs, esmData, vfs, bulletShapeManager);
+            }
 
-            forEachObject(cell, esmData, vfs, bulletShapeManager, readers, [&](const BulletObject& object) {
+            for (const BulletObject& object : cellObjects)
                 callback(cell, object);
-                ++objects;
-            });
 
             Log(Debug::Info) << "Processed " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
-                             << esmData.mCells.size() << ") " << cell.getDescription() << " with " << objects
-                             << " objects";
+                             << esmData.mCells.size() << ") " << cell.getDescription() << " with "
+                             << cellObjects.size() << " objects";
         }
     }
 }
@@ -6,6 +6,7 @@
 
 #include <osg/ref_ptr>
 
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -39,8 +40,10 @@ namespace Resource
         float mScale;
     };
 
+    /// Calls the callback for the objects with collision shapes of all cells in the order of the cells.
+    /// \param threads Number of threads to load the shapes with, the calling thread loads them when not greater than 1
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
-        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData, std::size_t threads,
         std::function<void(const ESM::Cell&, const BulletObject& object)> callback);
 }
 
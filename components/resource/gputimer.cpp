@@ -0,0 +1,189 @@
+#include "gputimer.hpp"
+
+#include <osg/FrameStamp>
+#include <osg/GLExtensions>
+#include <osg/RenderInfo>
+#include <osg/State>
+#include <osg/Stats>
+
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+namespace Resource
+{
+    namespace
+    {
+        const std::array<GpuStageStats, static_cast<std::size_t>(GpuStage::Count)> gpuStageStats{ {
+            { "GPU Shadows", "gpu_shadows_time_taken" },
+            { "GPU Reflection", "gpu_waterreflection_time_taken" },
+            { "GPU Refraction", "gpu_waterrefraction_time_taken" },
+            { "GPU Scene", "gpu_scene_time_taken" },
+            { " -Transparent", "gpu_transparent_time_taken" },
+            { "GPU PostProcess", "gpu_postprocessing_time_taken" },
+            { "GPU Gui", "gpu_gui_time_taken" },
+        } };
+    }
+
+    const GpuStageStats& getGpuStageStats(GpuStage stage)
+    {
+        return gpuStageStats[static_cast<std::size_t>(stage)];
+    }
+
+    class GpuTimer::StageCallback : public osg::Camera::DrawCallback
+    {
+    public:
+        explicit StageCallback(GpuTimer& timer, GpuStage stage, bool begin)
+            : mTimer(&timer)
+            , mStage(stage)
+            , mBegin(begin)
+        {
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override
+        {
+            if (mBegin)
+                mTimer->begin(renderInfo, mStage);
+            else
+                mTimer->end(renderInfo, mStage);
+        }
+
+    private:
+        osg::ref_ptr<GpuTimer> mTimer;
+        GpuStage mStage;
+        bool mBegin;
+    };
+
+    GpuTimer::GpuTimer(osg::Stats& stats)
+        : mStats(&stats)
+    {
+    }
+
+    GpuTimer::~GpuTimer() = default;
+
+    void GpuTimer::addCamera(osg::Camera& camera, GpuStage stage)
+    {
+        camera.addPreDrawCallback(createDrawCallback(stage, true));
+        camera.addPostDrawCallback(createDrawCallback(stage, false));
+    }
+
+    osg::ref_ptr<osg::Camera::DrawCallback> GpuTimer::createDrawCallback(GpuStage stage, bool begin)
+    {
+        return new StageCallback(*this, stage, begin);
+    }
+
+    void GpuTimer::begin(osg::RenderInfo& renderInfo, GpuStage stage)
+    {
+        if (!mAlwaysMeasure && !mStats->collectStats("engine"))
+            return;
+        ContextData* const data = getContextData(renderInfo);
+        if (data == nullptr)
+            return;
+        const std::size_t index = static_cast<std::size_t>(stage);
+        // Nested calls for the same stage are measured as a single interval
+        if (data->mDepth[index]++ > 0)
+            return;
+        data->mOpen[index] = issueTimestamp(*renderInfo.getState()->get<osg::GLExtensions>(), *data);
+    }
+
+    void GpuTimer::end(osg::RenderInfo& renderInfo, GpuStage stage)
+    {
+        ContextData* const data = getContextData(renderInfo);
+        if (data == nullptr)
+            return;
+        const std::size_t index = static_cast<std::size_t>(stage);
+        if (data->mDepth[index] == 0 || --data->mDepth[index] > 0)
+            return;
+        const unsigned endQuery = issueTimestamp(*renderInfo.getState()->get<osg::GLExtensions>(), *data);
+        data->mFrames[data->mFrameNumber % sMaxFrames].mIntervals.push_back(
+            Interval{ .mStage = stage, .mBegin = data->mOpen[index], .mEnd = endQuery });
+    }
+
+    GpuTimer::ContextData* GpuTimer::getContextData(osg::RenderInfo& renderInfo)
+    {
+        osg::State& state = *renderInfo.getState();
+        const osg::GLExtensions* const ext = state.get<osg::GLExtensions>();
+        if (ext == nullptr || !ext->isARBTimerQuerySupported)
+            return nullptr;
+        ContextData& data = mContexts[state.getContextID()];
+        const unsigned frameNumber = state.getFrameStamp()->getFrameNumber();
+        if (data.mFrameNumber != frameNumber)
+            startFrame(*ext, data, frameNumber);
+        return &data;
+    }
+
+    void GpuTimer::startFrame(const osg::GLExtensions& ext, ContextData& data, unsigned frameNumber)
+    {
+        for (Frame& frame : data.mFrames)
+            readResults(ext, data, frame, false);
+
+        // The GPU is more than sMaxFrames behind, wait for the oldest frame rather than dropping it
+        Frame& current = data.mFrames[frameNumber % sMaxFrames];
+        readResults(ext, data, current, true);
+
+        current.mFrameNumber = frameNumber;
+        data.mFrameNumber = frameNumber;
+    }
+
+    void GpuTimer::readResults(const osg::GLExtensions& ext, ContextData& data, Frame& frame, bool wait)
+    {
+        if (frame.mIntervals.empty())
+            return;
+
+        if (!wait)
+        {
+            // Timestamps are written in the order they are issued, the last one is written when all others are
+            GLint available = 0;
+            ext.glGetQueryObjectiv(frame.mIntervals.back().mEnd, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == 0)
+                return;
+        }
+
+        std::array<GLuint64, static_cast<std::size_t>(GpuStage::Count)> times{};
+        std::array<bool, static_cast<std::size_t>(GpuStage::Count)> measured{};
+        for (const Interval& interval : frame.mIntervals)
+        {
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            ext.glGetQueryObjectui64v(interval.mBegin, GL_QUERY_RESULT, &begin);
+            ext.glGetQueryObjectui64v(interval.mEnd, GL_QUERY_RESULT, &end);
+            const std::size_t index = static_cast<std::size_t>(interval.mStage);
+            if (end > begin)
+                times[index] += end - begin;
+            measured[index] = true;
+            data.mFreeQueries.push_back(interval.mBegin);
+            data.mFreeQueries.push_back(interval.mEnd);
+        }
+        frame.mIntervals.clear();
+
+        GLuint64 total = 0;
+        for (GLuint64 time : times)
+            total += time;
+        // The frames are read back in the order they are issued, except for the ones waited for
+        if (frame.mFrameNumber > mLastFrameNumber)
+        {
+            mLastFrameTime = static_cast<double>(total) / 1e9;
+            mLastFrameNumber = frame.mFrameNumber;
+        }
+
+        if (!mStats->collectStats("engine"))
+            return;
+        for (std::size_t i = 0; i < times.size(); ++i)
+            if (measured[i])
+                mStats->setAttribute(frame.mFrameNumber, gpuStageStats[i].mTaken, static_cast<double>(times[i]) / 1e9);
+    }
+
+    unsigned GpuTimer::issueTimestamp(const osg::GLExtensions& ext, ContextData& data)
+    {
+        GLuint query = 0;
+        if (data.mFreeQueries.empty())
+            ext.glGenQueries(1, &query);
+        else
+        {
+            query = data.mFreeQueries.back();
+            data.mFreeQueries.pop_back();
+        }
+        ext.glQueryCounter(query, GL_TIMESTAMP);
+        return query;
+    }
+}
@@ -0,0 +1,160 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_GPUTIMER_H
+#define OPENMW_COMPONENTS_RESOURCE_GPUTIMER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <osg/Camera>
+#include <osg/buffered_value>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class GLExtensions;
+    class RenderInfo;
+    class Stats;
+}
+
+namespace Resource
+{
+    enum class GpuStage : std::size_t
+    {
+        Shadows,
+        WaterReflection,
+        WaterRefraction,
+        Scene,
+        Transparent,
+        PostProcessing,
+        Gui,
+        Count,
+    };
+
+    struct GpuStageStats
+    {
+        std::string mLabel;
+        std::string mTaken;
+    };
+
+    /// @return The label and the name of the osg::Stats attribute holding the GPU time of the stage in seconds.
+    const GpuStageStats& getGpuStageStats(GpuStage stage);
+
+    /// @brief Measures the time the GPU spends drawing each stage of a frame with timestamp queries.
+    /// @par The results are read back a few frames later, without stalling the pipeline unless the GPU falls more
+    /// than that behind, and are added to the stats of the frame they were issued in. A stage drawn several times per
+    /// frame, e.g. one shadow map per cascade, reports the sum. Nothing is measured unless the "engine" stats are
+    /// collected or when the driver doesn't support timestamp queries, unless always measuring is requested.
+    class GpuTimer : public osg::Referenced
+    {
+    public:
+        explicit GpuTimer(osg::Stats& stats);
+
+        ~GpuTimer();
+
+        /// Measure the drawing of the camera's own render stage, excluding its nested pre and post render cameras.
+        /// Uses the pre and post draw callbacks of the camera.
+        void addCamera(osg::Camera& camera, GpuStage stage);
+
+        /// @return A camera draw callback calling begin() or end(), for cameras whose pre or post draw callbacks are
+        /// set elsewhere.
+        osg::ref_ptr<osg::Camera::DrawCallback> createDrawCallback(GpuStage stage, bool begin);
+
+        /// Start measuring the stage. Must be called on the draw thread.
+        void begin(osg::RenderInfo& renderInfo, GpuStage stage);
+
+        /// Stop measuring the stage. Must be called on the draw thread with the same context as begin().
+        void end(osg::RenderInfo& renderInfo, GpuStage stage);
+
+        /// Measure the stages even when the stats are not collected, for users of getLastFrameTime().
+        /// Must be called before the draw thread starts.
+        void setAlwaysMeasure(bool value) { mAlwaysMeasure = value; }
+
+        struct FrameTime
+        {
+            unsigned mFrameNumber = 0;
+            /// Sum of the measured stages in seconds.
+            double mTime = 0;
+        };
+
+        /// @return The GPU time of the latest frame the results are read back for. Can be called from any thread.
+        FrameTime getLastFrameTime() const
+        {
+            return FrameTime{ .mFrameNumber = mLastFrameNumber, .mTime = mLastFrameTime };
+        }
+
+    private:
+        // Queries are read back when their slot is reused, at the latest after this many frames
+        static constexpr std::size_t sMaxFrames = 3;
+
+        struct Interval
+        {
+            GpuStage mStage;
+            unsigned mBegin;
+            unsigned mEnd;
+        };
+
+        struct Frame
+        {
+            unsigned mFrameNumber = 0;
+            std::vector<Interval> mIntervals;
+        };
+
+        struct ContextData
+        {
+            unsigned mFrameNumber = 0;
+            std::array<Frame, sMaxFrames> mFrames;
+            std::array<unsigned, static_cast<std::size_t>(GpuStage::Count)> mOpen{};
+            std::array<unsigned, static_cast<std::size_t>(GpuStage::Count)> mDepth{};
+            std::vector<unsigned> mFreeQueries;
+        };
+
+        class StageCallback;
+
+        ContextData* getContextData(osg::RenderInfo& renderInfo);
+
+        void startFrame(const osg::GLExtensions& ext, ContextData& data, unsigned frameNumber);
+
+        void readResults(const osg::GLExtensions& ext, ContextData& data, Frame& frame, bool wait);
+
+        unsigned issueTimestamp(const osg::GLExtensions& ext, ContextData& data);
+
+        osg::ref_ptr<osg::Stats> mStats;
+        osg::buffered_object<ContextData> mContexts;
+        bool mAlwaysMeasure = false;
+        std::atomic<unsigned> mLastFrameNumber{ 0 };
+        std::atomic<double> mLastFrameTime{ 0 };
+    };
+
+    /// @brief Measures the stage until the end of the scope.
+    class ScopedGpuTime
+    {
+    public:
+        /// @param timer May be null to measure nothing.
+        explicit ScopedGpuTime(GpuTimer* timer, osg::RenderInfo& renderInfo, GpuStage stage)
+            : mTimer(timer)
+            , mRenderInfo(renderInfo)
+            , mStage(stage)
+        {
+            if (mTimer != nullptr)
+                mTimer->begin(mRenderInfo, mStage);
+        }
+
+        ScopedGpuTime(const ScopedGpuTime&) = delete;
+        ScopedGpuTime& operator=(const ScopedGpuTime&) = delete;
+
+        ~ScopedGpuTime()
+        {
+            if (mTimer != nullptr)
+                mTimer->end(mRenderInfo, mStage);
+        }
+
+    private:
+        GpuTimer* mTimer;
+        osg::RenderInfo& mRenderInfo;
+        GpuStage mStage;
+    };
+}
+
+#endif
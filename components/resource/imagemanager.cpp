@@ -1,15 +1,22 @@
 #include "imagemanager.hpp"
 
 #include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
 #include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/sceneutil/glextensions.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
+#include "texturecompression.hpp"
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -42,6 +49,18 @@ namespace
         return warningImage;
     }
 
+    std::filesystem::path getCompressedImagePath(
+        const std::filesystem::path& directory, std::string_view name, std::istream& stream, bool disableFlip)
+    {
+        const std::array<std::uint64_t, 2> hash = Files::getHash(name, stream);
+        std::ostringstream fileName;
+        fileName << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        if (disableFlip)
+            fileName << "-noflip";
+        fileName << ".dds";
+        return directory / fileName.str();
+    }
+
 }
 
 namespace Resource
@@ -57,6 +76,71 @@ namespace Resource
 
     ImageManager::~ImageManager() {}
 
+    void ImageManager::setCompressedImageCache(const std::filesystem::path& directory)
+    {
+        mCompressedImageCache.clear();
+        if (directory.empty())
+            return;
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create compressed image cache directory " << directory << ": "
+                                << ec.message();
+            return;
+        }
+        mCompressedImageCache = directory;
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::readCompressedImage(const std::filesystem::path& path) const
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!reader)
+            return nullptr;
+        // The stored image is already flipped when needed
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(stream);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read compressed image " << path << ": " << result.message();
+            return nullptr;
+        }
+        return result.getImage();
+    }
+
+    void ImageManager::writeCompressedImage(const std::filesystem::path& path, const osg::Image& image) const
+    {
+        osgDB::ReaderWriter* writer = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!writer)
+            return;
+
+        // Other threads may write the same image at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                const osgDB::ReaderWriter::WriteResult result = writer->writeImage(image, stream);
+                if (!result.success())
+                    throw std::runtime_error(result.message());
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write compressed image " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+
     bool checkSupported(osg::Image* image)
     {
         switch (image->getPixelFormat())
@@ -115,6 +199,31 @@ namespace Resource
                 return mWarningImage;
             }
 
+            std::filesystem::path compressedImagePath;
+            if (!mCompressedImageCache.empty() && ext != "dds")
+            {
+                try
+                {
+                    compressedImagePath
+                        = getCompressedImagePath(mCompressedImageCache, normalized, *stream, disableFlip);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to find compressed image for " << filename << ": " << e.what();
+                }
+            }
+
+            if (!compressedImagePath.empty())
+            {
+                osg::ref_ptr<osg::Image> image = readCompressedImage(compressedImagePath);
+                if (image != nullptr && checkSupported(image))
+                {
+                    image->setFileName(normalized);
+                    mCache->addEntryToObjectCache(normalized, image);
+                    return image;
+                }
+            }
+
             bool killAlpha = false;
             if (reader->supportedExtensions().count("tga"))
             {
@@ -189,6 +298,16 @@ namespace Resource
                 image = newImage;
             }
 
+            if (!compressedImagePath.empty() && isCompressible(*image))
+            {
+                osg::ref_ptr<osg::Image> compressed = compressImage(*image);
+                if (compressed != nullptr && checkSupported(compressed))
+                {
+                    writeCompressedImage(compressedImagePath, *compressed);
+                    image = compressed;
+                }
+            }
+
             mCache->addEntryToObjectCache(normalized, image);
             return image;
         }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 
+#include <filesystem>
 #include <map>
 #include <string>
 
@@ -32,12 +33,23 @@ namespace Resource
 
         osg::Image* getWarningImage();
 
+        /// Convert uncompressed images into S3TC with mipmaps and store the results in the given directory, so the
+        /// next load of the same image content reads the compressed image instead of decoding the original one.
+        /// An empty path disables the conversion.
+        /// @note Not thread safe, has to be called before loading any images.
+        void setCompressedImageCache(const std::filesystem::path& directory);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
         osg::ref_ptr<osgDB::Options> mOptionsNoFlip;
+        std::filesystem::path mCompressedImageCache;
+
+        osg::ref_ptr<osg::Image> readCompressedImage(const std::filesystem::path& path) const;
+
+        void writeCompressedImage(const std::filesystem::path& path, const osg::Image& image) const;
 
         ImageManager(const ImageManager&);
         void operator=(const ImageManager&);
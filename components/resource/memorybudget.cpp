@@ -0,0 +1,79 @@
+#include "memorybudget.hpp"
+
+#include <limits>
+
+#include <osg/Stats>
+
+#include "resourcemanager.hpp"
+
+namespace Resource
+{
+    void MemoryBudget::enforce(double referenceTime, std::span<BaseResourceManager* const> managers)
+    {
+        const std::size_t limit = getLimit();
+        const std::lock_guard lock(mMutex);
+
+        std::size_t bytes = 0;
+        for (const BaseResourceManager* manager : managers)
+            bytes += manager->getCacheBytes();
+        mBytes.store(bytes, std::memory_order_relaxed);
+        if (limit == 0 || bytes <= limit)
+            return;
+
+        mPressure.fetch_add(1, std::memory_order_relaxed);
+
+        mCandidates.clear();
+        for (const BaseResourceManager* manager : managers)
+            manager->collectEvictionCandidates(referenceTime, mCandidates);
+
+        std::sort(mCandidates.begin(), mCandidates.end(),
+            [](const EvictionCandidate& l, const EvictionCandidate& r) { return l.mCost > r.mCost; });
+
+        // Find the lowest cost to evict to fit the limit, every cache removes its objects costing at least as much
+        const std::size_t excess = bytes - limit;
+        std::size_t selected = 0;
+        double minCost = std::numeric_limits<double>::infinity();
+        for (const EvictionCandidate& candidate : mCandidates)
+        {
+            if (selected >= excess || candidate.mCost <= 0)
+                break;
+            selected += candidate.mBytes;
+            minCost = candidate.mCost;
+        }
+
+        if (selected == 0)
+            return;
+
+        EvictionResult total;
+        for (BaseResourceManager* manager : managers)
+        {
+            const EvictionResult result = manager->evict(referenceTime, minCost);
+            total.mCount += result.mCount;
+            total.mBytes += result.mBytes;
+        }
+        mBytes.store(bytes - std::min(bytes, total.mBytes), std::memory_order_relaxed);
+        mEvicted.fetch_add(total.mCount, std::memory_order_relaxed);
+        mEvictedBytes.fetch_add(total.mBytes, std::memory_order_relaxed);
+    }
+
+    MemoryBudgetStats MemoryBudget::getStats() const
+    {
+        return MemoryBudgetStats{
+            .mLimit = getLimit(),
+            .mBytes = mBytes.load(std::memory_order_relaxed),
+            .mPressure = mPressure.load(std::memory_order_relaxed),
+            .mEvicted = mEvicted.load(std::memory_order_relaxed),
+            .mEvictedBytes = mEvictedBytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    void MemoryBudget::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        const MemoryBudgetStats value = getStats();
+        stats.setAttribute(frameNumber, "ResourceBudget Limit", static_cast<double>(value.mLimit));
+        stats.setAttribute(frameNumber, "ResourceBudget Bytes", static_cast<double>(value.mBytes));
+        stats.setAttribute(frameNumber, "ResourceBudget Pressure", static_cast<double>(value.mPressure));
+        stats.setAttribute(frameNumber, "ResourceBudget Evicted", static_cast<double>(value.mEvicted));
+        stats.setAttribute(frameNumber, "ResourceBudget Evicted Bytes", static_cast<double>(value.mEvictedBytes));
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_MEMORYBUDGET_H
+#define OPENMW_COMPONENTS_RESOURCE_MEMORYBUDGET_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace Resource
+{
+    class BaseResourceManager;
+
+    /// Cost of keeping a cached object nobody else references. Grows with the time since the object was used and
+    /// with the memory it uses, so the large and long unused objects are evicted first.
+    inline double getEvictionCost(double referenceTime, double lastUsage, std::size_t bytes)
+    {
+        return std::max(0.0, referenceTime - lastUsage) * static_cast<double>(bytes);
+    }
+
+    struct EvictionCandidate
+    {
+        double mCost;
+        std::size_t mBytes;
+    };
+
+    struct EvictionResult
+    {
+        std::size_t mCount = 0;
+        std::size_t mBytes = 0;
+    };
+
+    struct MemoryBudgetStats
+    {
+        std::size_t mLimit = 0;
+        std::size_t mBytes = 0;
+        // Number of updates that found the caches over the limit
+        std::size_t mPressure = 0;
+        std::size_t mEvicted = 0;
+        std::size_t mEvictedBytes = 0;
+    };
+
+    /// @brief Keeps the estimated memory used by the objects of all resource caches within a limit.
+    /// @par The sizes come from ResidentSizeEstimator, data shared by several cached objects is counted for each of
+    /// them, so the total is an upper bound.
+    class MemoryBudget
+    {
+    public:
+        /// @param limit In bytes, 0 disables the limit.
+        void setLimit(std::size_t limit) { mLimit.store(limit, std::memory_order_relaxed); }
+
+        std::size_t getLimit() const { return mLimit.load(std::memory_order_relaxed); }
+
+        /// Evict the objects that are only referenced by the caches, starting from the highest getEvictionCost over
+        /// all the caches, until the total fits the limit. Objects used at referenceTime are kept even when the
+        /// limit is still exceeded.
+        /// @note May be called from any thread if the managers are not added or removed at that point.
+        void enforce(double referenceTime, std::span<BaseResourceManager* const> managers);
+
+        MemoryBudgetStats getStats() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        std::atomic_size_t mLimit{ 0 };
+        // Stats are read every frame, they are not guarded by the mutex to not wait for a running enforce
+        std::atomic_size_t mBytes{ 0 };
+        std::atomic_size_t mPressure{ 0 };
+        std::atomic_size_t mEvicted{ 0 };
+        std::atomic_size_t mEvictedBytes{ 0 };
+        std::mutex mMutex;
+        std::vector<EvictionCandidate> mCandidates;
+    };
+}
+
+#endif
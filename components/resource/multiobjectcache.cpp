@@ -21,9 +21,9 @@ namespace Resource
             ObjectCacheMap::iterator oitr = _objectCache.begin();
             while (oitr != _objectCache.end())
             {
-                if (oitr->second->referenceCount() <= 1)
+                if (oitr->second.mValue->referenceCount() <= 1)
                 {
-                    objectsToRemove.push_back(oitr->second);
+                    objectsToRemove.push_back(oitr->second.mValue);
                     _objectCache.erase(oitr++);
                     ++mExpired;
                 }
@@ -38,6 +38,28 @@ namespace Resource
         objectsToRemove.clear();
     }
 
+    void MultiObjectCache::update(double referenceTime, double expiryDelay)
+    {
+        std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+        {
+            const double expiryTime = referenceTime - expiryDelay;
+            std::lock_guard<std::mutex> lock(_objectCacheMutex);
+            std::erase_if(_objectCache, [&](auto& v) {
+                Item& item = v.second;
+                if (item.mValue->referenceCount() > 1 || item.mLastUsage == 0)
+                    item.mLastUsage = referenceTime;
+                if (item.mLastUsage > expiryTime)
+                    return false;
+                ++mExpired;
+                objectsToRemove.push_back(std::move(item.mValue));
+                return true;
+            });
+        }
+
+        // note, actual unref happens outside of the lock
+        objectsToRemove.clear();
+    }
+
     void MultiObjectCache::clear()
     {
         std::lock_guard<std::mutex> lock(_objectCacheMutex);
@@ -52,7 +74,7 @@ namespace Resource
             return;
         }
         std::lock_guard<std::mutex> lock(_objectCacheMutex);
-        _objectCache.insert(std::make_pair(filename, object));
+        _objectCache.insert(std::make_pair(filename, Item{ object }));
     }
 
     osg::ref_ptr<osg::Object> MultiObjectCache::takeFromObjectCache(const std::string& fileName)
@@ -64,7 +86,7 @@ namespace Resource
             return osg::ref_ptr<osg::Object>();
         else
         {
-            osg::ref_ptr<osg::Object> object = std::move(found->second);
+            osg::ref_ptr<osg::Object> object = std::move(found->second.mValue);
             _objectCache.erase(found);
             ++mHit;
             return object;
@@ -77,7 +99,7 @@ namespace Resource
 
         for (ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
         {
-            osg::Object* object = itr->second.get();
+            osg::Object* object = itr->second.mValue.get();
             object->releaseGLObjects(state);
         }
     }
@@ -28,6 +28,10 @@ namespace Resource
 
         void removeUnreferencedObjectsInCache();
 
+        /** Remove the objects not referenced from elsewhere that were added before the expiry delay passed, added
+         * objects are timestamped on the first update after that. */
+        void update(double referenceTime, double expiryDelay);
+
         /** Remove all objects from the cache. */
         void clear();
 
@@ -42,7 +46,13 @@ namespace Resource
         CacheStats getStats() const;
 
     protected:
-        typedef std::multimap<std::string, osg::ref_ptr<osg::Object>> ObjectCacheMap;
+        struct Item
+        {
+            osg::ref_ptr<osg::Object> mValue;
+            double mLastUsage = 0;
+        };
+
+        typedef std::multimap<std::string, Item> ObjectCacheMap;
 
         ObjectCacheMap _objectCache;
         mutable std::mutex _objectCacheMutex;
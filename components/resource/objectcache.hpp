@@ -3,6 +3,9 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - lookups take a shared lock, modifications take an exclusive one.
+// - approximate resident size of the objects is tracked.
+// - unused objects can be evicted by cost.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -21,15 +24,19 @@
 #define OPENMW_COMPONENTS_RESOURCE_OBJECTCACHE
 
 #include "cachestats.hpp"
+#include "memorybudget.hpp"
+#include "residentsize.hpp"
 
 #include <osg/Node>
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -46,7 +53,16 @@ namespace Resource
     struct GenericObjectCacheItem
     {
         osg::ref_ptr<osg::Object> mValue;
-        double mLastUsage;
+        // Updated by checkInObjectCache under the shared lock
+        std::atomic<double> mLastUsage;
+        std::size_t mBytes;
+
+        GenericObjectCacheItem(osg::Object* value, double lastUsage, std::size_t bytes)
+            : mValue(value)
+            , mLastUsage(lastUsage)
+            , mBytes(bytes)
+        {
+        }
     };
 
     template <typename KeyType>
@@ -61,14 +77,15 @@ namespace Resource
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
             {
                 const double expiryTime = referenceTime - expiryDelay;
-                std::lock_guard<std::mutex> lock(mMutex);
+                const std::unique_lock<std::shared_mutex> lock = lockExclusive();
                 std::erase_if(mItems, [&](auto& v) {
                     Item& item = v.second;
                     if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
                         item.mLastUsage = referenceTime;
                     if (item.mLastUsage > expiryTime)
                         return false;
-                    ++mExpired;
+                    mExpired.fetch_add(1, std::memory_order_relaxed);
+                    mBytes -= item.mBytes;
                     if (item.mValue != nullptr)
                         objectsToRemove.push_back(std::move(item.mValue));
                     return true;
@@ -78,38 +95,91 @@ namespace Resource
             objectsToRemove.clear();
         }
 
+        /** Add the objects that are only referenced by the cache, see getEvictionCost. */
+        void collectEvictionCandidates(double referenceTime, std::vector<EvictionCandidate>& out) const
+        {
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
+            for (const auto& [k, v] : mItems)
+                if (isEvictable(v))
+                    out.push_back(EvictionCandidate{
+                        .mCost = getEvictionCost(referenceTime, v.mLastUsage.load(std::memory_order_relaxed), v.mBytes),
+                        .mBytes = v.mBytes,
+                    });
+        }
+
+        /** Remove the objects that are only referenced by the cache and cost at least minCost to keep. */
+        EvictionResult evict(double referenceTime, double minCost)
+        {
+            EvictionResult result;
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            {
+                const std::unique_lock<std::shared_mutex> lock = lockExclusive();
+                std::erase_if(mItems, [&](auto& v) {
+                    Item& item = v.second;
+                    if (!isEvictable(item)
+                        || getEvictionCost(referenceTime, item.mLastUsage.load(std::memory_order_relaxed), item.mBytes)
+                            < minCost)
+                        return false;
+                    ++result.mCount;
+                    result.mBytes += item.mBytes;
+                    mBytes -= item.mBytes;
+                    objectsToRemove.push_back(std::move(item.mValue));
+                    return true;
+                });
+            }
+            mEvicted.fetch_add(result.mCount, std::memory_order_relaxed);
+            // note, actual unref happens outside of the lock
+            objectsToRemove.clear();
+            return result;
+        }
+
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::unique_lock<std::shared_mutex> lock = lockExclusive();
             mItems.clear();
+            mBytes = 0;
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         template <class K>
         void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            // Traversing the object may take a while so it's done before taking the lock
+            const std::size_t bytes = estimateResidentSize(object);
+            const std::unique_lock<std::shared_mutex> lock = lockExclusive();
             const auto it = mItems.find(key);
             if (it == mItems.end())
-                mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp });
+            {
+                mItems.emplace_hint(it, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(object, timestamp, bytes));
+            }
             else
-                it->second = Item{ object, timestamp };
+            {
+                mBytes -= it->second.mBytes;
+                it->second.mValue = object;
+                it->second.mLastUsage = timestamp;
+                it->second.mBytes = bytes;
+            }
+            mBytes += bytes;
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::unique_lock<std::shared_mutex> lock = lockExclusive();
             const auto itr = mItems.find(key);
             if (itr != mItems.end())
+            {
+                mBytes -= itr->second.mBytes;
                 mItems.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             if (Item* const item = find(key))
                 return item->mValue;
             return nullptr;
@@ -117,7 +187,7 @@ namespace Resource
 
         std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             if (Item* const item = find(key))
                 return item->mValue;
             return std::nullopt;
@@ -126,10 +196,10 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const auto& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             if (Item* const item = find(key))
             {
-                item->mLastUsage = timeStamp;
+                item->mLastUsage.store(timeStamp, std::memory_order_relaxed);
                 return true;
             }
             return false;
@@ -138,7 +208,7 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             for (const auto& [k, v] : mItems)
                 v.mValue->releaseGLObjects(state);
         }
@@ -146,7 +216,7 @@ namespace Resource
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             for (const auto& [k, v] : mItems)
                 if (osg::Object* const object = v.mValue.get())
                     if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
@@ -157,7 +227,7 @@ namespace Resource
         template <class Functor>
         void call(Functor&& f)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             for (const auto& [k, v] : mItems)
                 f(k, v.mValue.get());
         }
@@ -165,7 +235,7 @@ namespace Resource
         template <class K>
         std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> lowerBound(K&& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock = lockShared();
             const auto it = mItems.lower_bound(std::forward<K>(key));
             if (it == mItems.end())
                 return std::nullopt;
@@ -174,12 +244,15 @@ namespace Resource
 
         CacheStats getStats() const
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
+            const std::shared_lock<std::shared_mutex> lock(mMutex);
             return CacheStats{
                 .mSize = mItems.size(),
-                .mGet = mGet,
-                .mHit = mHit,
-                .mExpired = mExpired,
+                .mGet = mGet.load(std::memory_order_relaxed),
+                .mHit = mHit.load(std::memory_order_relaxed),
+                .mExpired = mExpired.load(std::memory_order_relaxed),
+                .mEvicted = mEvicted.load(std::memory_order_relaxed),
+                .mContended = mContended.load(std::memory_order_relaxed),
+                .mBytes = mBytes,
             };
         }
 
@@ -187,18 +260,52 @@ namespace Resource
         using Item = GenericObjectCacheItem;
 
         std::map<KeyType, Item, std::less<>> mItems;
-        mutable std::mutex mMutex;
-        std::size_t mGet = 0;
-        std::size_t mHit = 0;
-        std::size_t mExpired = 0;
+        mutable std::shared_mutex mMutex;
+        // Sum of the estimated resident sizes of the items, shared data is counted for each item referencing it
+        std::size_t mBytes = 0;
+        std::atomic_size_t mGet = 0;
+        std::atomic_size_t mHit = 0;
+        std::atomic_size_t mExpired = 0;
+        std::atomic_size_t mEvicted = 0;
+        // Number of times the lock was already held in a conflicting mode
+        mutable std::atomic_size_t mContended = 0;
+
+        std::unique_lock<std::shared_mutex> lockExclusive() const
+        {
+            std::unique_lock<std::shared_mutex> lock(mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                mContended.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            return lock;
+        }
+
+        std::shared_lock<std::shared_mutex> lockShared() const
+        {
+            std::shared_lock<std::shared_mutex> lock(mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                mContended.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            return lock;
+        }
+
+        // Objects with uninitialized time stamp are never removed, neither are the ones nobody would release
+        static bool isEvictable(const Item& item)
+        {
+            return item.mValue != nullptr && item.mValue->referenceCount() == 1
+                && item.mLastUsage.load(std::memory_order_relaxed) != 0 && item.mBytes != 0;
+        }
 
         Item* find(const auto& key)
         {
-            ++mGet;
+            mGet.fetch_add(1, std::memory_order_relaxed);
             const auto it = mItems.find(key);
             if (it == mItems.end())
                 return nullptr;
-            ++mHit;
+            mHit.fetch_add(1, std::memory_order_relaxed);
             return &it->second;
         }
     };
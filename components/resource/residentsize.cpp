@@ -0,0 +1,182 @@
+#include "residentsize.hpp"
+
+#include "bulletshape.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btStridingMeshInterface.h>
+
+#include <components/sceneutil/morphgeometry.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+
+namespace Resource
+{
+    class ResidentSizeVisitor : public osg::NodeVisitor
+    {
+    public:
+        explicit ResidentSizeVisitor(ResidentSizeEstimator& estimator)
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            , mEstimator(estimator)
+        {
+        }
+
+        void apply(osg::Node& node) override
+        {
+            mEstimator.addStateSet(node.getStateSet());
+            traverse(node);
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            if (!mEstimator.visit(&drawable))
+                return;
+            mEstimator.addStateSet(drawable.getStateSet());
+            if (const osg::Geometry* geometry = drawable.asGeometry())
+                mEstimator.addGeometry(geometry);
+            else if (const auto* rig = dynamic_cast<const SceneUtil::RigGeometry*>(&drawable))
+                mEstimator.addGeometry(rig->getSourceGeometry().get());
+            else if (const auto* morph = dynamic_cast<const SceneUtil::MorphGeometry*>(&drawable))
+            {
+                mEstimator.addGeometry(morph->getSourceGeometry().get());
+                for (const SceneUtil::MorphGeometry::MorphTarget& target : morph->getMorphTargetList())
+                    mEstimator.addBufferData(target.getOffsets());
+            }
+        }
+
+    private:
+        ResidentSizeEstimator& mEstimator;
+    };
+
+    void ResidentSizeEstimator::add(const osg::Object& object)
+    {
+        if (const osg::Node* node = object.asNode())
+            addNode(*node);
+        else if (const auto* image = dynamic_cast<const osg::Image*>(&object))
+            addBufferData(image);
+        else if (const auto* texture = dynamic_cast<const osg::Texture*>(&object))
+            addTexture(texture);
+        else if (const auto* shape = dynamic_cast<const BulletShape*>(&object))
+        {
+            addCollisionShape(shape->mCollisionShape.get());
+            addCollisionShape(shape->mAvoidCollisionShape.get());
+        }
+    }
+
+    void ResidentSizeEstimator::addNode(const osg::Node& node)
+    {
+        if (!visit(&node))
+            return;
+        // The visitor doesn't change the graph, it's shared with other threads
+        ResidentSizeVisitor visitor(*this);
+        const_cast<osg::Node&>(node).accept(visitor);
+    }
+
+    void ResidentSizeEstimator::addStateSet(const osg::StateSet* stateSet)
+    {
+        if (stateSet == nullptr || !visit(stateSet))
+            return;
+        for (const osg::StateSet::AttributeList& attributes : stateSet->getTextureAttributeList())
+            for (const auto& [type, attribute] : attributes)
+                addTexture(attribute.first->asTexture());
+    }
+
+    void ResidentSizeEstimator::addTexture(const osg::Texture* texture)
+    {
+        if (texture == nullptr || !visit(texture))
+            return;
+        for (unsigned i = 0; i < texture->getNumImages(); ++i)
+            addBufferData(texture->getImage(i));
+    }
+
+    void ResidentSizeEstimator::addGeometry(const osg::Geometry* geometry)
+    {
+        if (geometry == nullptr || !visit(geometry))
+            return;
+        addBufferData(geometry->getVertexArray());
+        addBufferData(geometry->getNormalArray());
+        addBufferData(geometry->getColorArray());
+        addBufferData(geometry->getSecondaryColorArray());
+        for (const osg::ref_ptr<osg::Array>& array : geometry->getTexCoordArrayList())
+            addBufferData(array.get());
+        for (const osg::ref_ptr<osg::Array>& array : geometry->getVertexAttribArrayList())
+            addBufferData(array.get());
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : geometry->getPrimitiveSetList())
+            addBufferData(primitiveSet.get());
+    }
+
+    void ResidentSizeEstimator::addBufferData(const osg::BufferData* data)
+    {
+        if (data == nullptr || !visit(data))
+            return;
+        if (const osg::Image* image = data->asImage())
+            mSize += image->getTotalSizeInBytesIncludingMipmaps();
+        else
+            mSize += data->getTotalDataSize();
+    }
+
+    void ResidentSizeEstimator::addCollisionShape(const btCollisionShape* shape)
+    {
+        if (shape == nullptr || !visit(shape))
+            return;
+        switch (shape->getShapeType())
+        {
+            case COMPOUND_SHAPE_PROXYTYPE:
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape);
+                mSize += static_cast<std::size_t>(compound.getNumChildShapes()) * sizeof(btCompoundShapeChild);
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    addCollisionShape(compound.getChildShape(i));
+                break;
+            }
+            case SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE:
+                addCollisionShape(static_cast<const btScaledBvhTriangleMeshShape&>(*shape).getChildShape());
+                break;
+            case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+            {
+                const btBvhTriangleMeshShape& triangleMesh = static_cast<const btBvhTriangleMeshShape&>(*shape);
+                const btOptimizedBvh* const bvh = const_cast<btBvhTriangleMeshShape&>(triangleMesh).getOptimizedBvh();
+                if (bvh != nullptr && visit(bvh))
+                    mSize += bvh->calculateSerializeBufferSize();
+                const btStridingMeshInterface* mesh = triangleMesh.getMeshInterface();
+                if (mesh == nullptr || !visit(mesh))
+                    break;
+                for (int part = 0, n = mesh->getNumSubParts(); part < n; ++part)
+                {
+                    const unsigned char* vertices = nullptr;
+                    int vertexCount = 0;
+                    PHY_ScalarType vertexType;
+                    int vertexStride = 0;
+                    const unsigned char* indices = nullptr;
+                    int indexStride = 0;
+                    int triangleCount = 0;
+                    PHY_ScalarType indexType;
+                    mesh->getLockedReadOnlyVertexIndexBase(&vertices, vertexCount, vertexType, vertexStride, &indices,
+                        indexStride, triangleCount, indexType, part);
+                    mSize += static_cast<std::size_t>(vertexCount) * static_cast<std::size_t>(vertexStride)
+                        + static_cast<std::size_t>(triangleCount) * static_cast<std::size_t>(indexStride);
+                    mesh->unLockReadOnlyVertexBase(part);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    std::size_t estimateResidentSize(const osg::Object* object)
+    {
+        if (object == nullptr)
+            return 0;
+        ResidentSizeEstimator estimator;
+        estimator.add(*object);
+        return estimator.getSize();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_RESIDENTSIZE_H
+#define OPENMW_COMPONENTS_RESOURCE_RESIDENTSIZE_H
+
+#include <cstddef>
+#include <unordered_set>
+
+class btCollisionShape;
+
+namespace osg
+{
+    class Object;
+    class Node;
+    class StateSet;
+    class Texture;
+    class Geometry;
+    class BufferData;
+}
+
+namespace Resource
+{
+    /// @brief Approximates the memory used by loaded resources: vertex and index data, images and collision meshes
+    /// with their BVHs.
+    /// @par Data shared by several added objects is counted once. Object headers, scene graph nodes and other small
+    /// allocations are not counted.
+    class ResidentSizeEstimator
+    {
+    public:
+        /// Supports scene graphs, images, textures and collision shapes, other objects are ignored.
+        void add(const osg::Object& object);
+
+        std::size_t getSize() const { return mSize; }
+
+    private:
+        friend class ResidentSizeVisitor;
+
+        std::unordered_set<const void*> mVisited;
+        std::size_t mSize = 0;
+
+        bool visit(const void* value) { return mVisited.insert(value).second; }
+
+        void addNode(const osg::Node& node);
+
+        void addStateSet(const osg::StateSet* stateSet);
+
+        void addTexture(const osg::Texture* texture);
+
+        void addGeometry(const osg::Geometry* geometry);
+
+        void addBufferData(const osg::BufferData* data);
+
+        void addCollisionShape(const btCollisionShape* shape);
+    };
+
+    /// Estimates a single object on its own, returns 0 for nullptr.
+    std::size_t estimateResidentSize(const osg::Object* object);
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include <components/vfs/pathutil.hpp>
 
+#include "memorybudget.hpp"
 #include "objectcache.hpp"
 
 namespace VFS
@@ -30,6 +31,13 @@ namespace Resource
         virtual void setExpiryDelay(double expiryDelay) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
+
+        /// Estimated memory used by the cached objects, see MemoryBudget.
+        virtual std::size_t getCacheBytes() const { return 0; }
+        /// Add the cached objects that could be evicted.
+        virtual void collectEvictionCandidates(double referenceTime, std::vector<EvictionCandidate>& out) const {}
+        /// Remove the unused cached objects costing at least minCost to keep.
+        virtual EvictionResult evict(double referenceTime, double minCost) { return {}; }
     };
 
     /// @brief Base class for managers that require a virtual file system and object cache.
@@ -66,6 +74,18 @@ namespace Resource
 
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
+        std::size_t getCacheBytes() const override { return mCache->getStats().mBytes; }
+
+        void collectEvictionCandidates(double referenceTime, std::vector<EvictionCandidate>& out) const override
+        {
+            mCache->collectEvictionCandidates(referenceTime, out);
+        }
+
+        EvictionResult evict(double referenceTime, double minCost) override
+        {
+            return mCache->evict(referenceTime, minCost);
+        }
+
     protected:
         const VFS::Manager* mVFS;
         osg::ref_ptr<CacheType> mCache;
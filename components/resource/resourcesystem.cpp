@@ -73,8 +73,15 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setMemoryBudget(std::size_t bytes)
+    {
+        mMemoryBudget.setLimit(bytes);
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
+        mMemoryBudget.enforce(referenceTime, mResourceManagers);
+
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
              ++it)
             (*it)->updateCache(referenceTime);
@@ -110,6 +117,7 @@ namespace Resource
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+        mMemoryBudget.reportStats(frameNumber, *stats);
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
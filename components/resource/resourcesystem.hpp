@@ -1,9 +1,12 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
+#include "memorybudget.hpp"
+
 namespace VFS
 {
     class Manager;
@@ -47,7 +50,8 @@ namespace Resource
         KeyframeManager* getKeyframeManager();
 
         /// Indicates to each resource manager to clear the cache, i.e. to drop cached objects that are no longer
-        /// referenced.
+        /// referenced. When the caches exceed the memory budget the unused objects are evicted by cost before the
+        /// expiry delay.
         /// @note May be called from any thread if you do not add or remove resource managers at that point.
         void updateCache(double referenceTime);
 
@@ -65,6 +69,9 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Approximate memory in bytes for the objects of all the resource managers, 0 disables the limit.
+        void setMemoryBudget(std::size_t bytes);
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
@@ -84,6 +91,8 @@ namespace Resource
         // Here users can register their own resourcemanager as well
         std::vector<BaseResourceManager*> mResourceManagers;
 
+        MemoryBudget mMemoryBudget;
+
         const VFS::Manager* mVFS;
 
         ResourceSystem(const ResourceSystem&);
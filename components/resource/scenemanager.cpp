@@ -58,6 +58,7 @@
 #include "bgsmfilemanager.hpp"
 #include "errormarker.hpp"
 #include "imagemanager.hpp"
+#include "multiobjectcache.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
 
@@ -98,6 +99,13 @@ namespace
         }
     };
 
+    bool isWorldSpaceParticleSystem(const osgParticle::ParticleSystem& partsys)
+    {
+        // HACK: ParticleSystem has no getReferenceFrame()
+        return partsys.getUserDataContainer() && partsys.getUserDataContainer()->getNumDescriptions() > 0
+            && partsys.getUserDataContainer()->getDescriptions()[0] == "worldspace";
+    }
+
     class InitParticlesVisitor : public osg::NodeVisitor
     {
     public:
@@ -108,18 +116,11 @@ namespace
         {
         }
 
-        bool isWorldSpaceParticleSystem(osgParticle::ParticleSystem* partsys)
-        {
-            // HACK: ParticleSystem has no getReferenceFrame()
-            return (partsys->getUserDataContainer() && partsys->getUserDataContainer()->getNumDescriptions() > 0
-                && partsys->getUserDataContainer()->getDescriptions()[0] == "worldspace");
-        }
-
         void apply(osg::Drawable& drw) override
         {
             if (osgParticle::ParticleSystem* partsys = dynamic_cast<osgParticle::ParticleSystem*>(&drw))
             {
-                if (isWorldSpaceParticleSystem(partsys))
+                if (isWorldSpaceParticleSystem(*partsys))
                 {
                     partsys->addUpdateCallback(new InitWorldSpaceParticlesCallback);
                 }
@@ -130,6 +131,46 @@ namespace
     private:
         unsigned int mMask;
     };
+
+    // Replace the particles of an instance by the initial particles of its template
+    void resetParticles(const osg::Node& base, osg::Node& instance)
+    {
+        if (const auto* baseSystem = dynamic_cast<const osgParticle::ParticleSystem*>(&base))
+        {
+            auto* system = dynamic_cast<osgParticle::ParticleSystem*>(&instance);
+            if (system == nullptr)
+                return;
+
+            for (int i = 0; i < system->numParticles(); ++i)
+                system->destroyParticle(i);
+            for (int i = 0; i < baseSystem->numParticles(); ++i)
+            {
+                if (osgParticle::Particle* particle = system->createParticle(nullptr))
+                    *particle = *baseSystem->getParticle(i);
+            }
+            system->setInitialBound(baseSystem->getInitialBound());
+
+            if (isWorldSpaceParticleSystem(*system))
+                system->addUpdateCallback(new InitWorldSpaceParticlesCallback);
+            return;
+        }
+
+        const osg::Group* baseGroup = base.asGroup();
+        osg::Group* group = instance.asGroup();
+        if (baseGroup == nullptr || group == nullptr || baseGroup->getNumChildren() != group->getNumChildren())
+            return;
+
+        for (unsigned i = 0; i < group->getNumChildren(); ++i)
+            resetParticles(*baseGroup->getChild(i), *group->getChild(i));
+    }
+
+    std::string makeInstancePoolKey(std::string_view name, std::string_view key)
+    {
+        std::string result = VFS::Path::normalizeFilename(name);
+        result += '\0';
+        result += key;
+        return result;
+    }
 }
 
 namespace Resource
@@ -423,6 +464,7 @@ namespace Resource
         , mAdjustCoverageForAlphaTest(false)
         , mSupportsNormalsRT(false)
         , mSharedStateManager(new SharedStateManager)
+        , mInstancePool(new MultiObjectCache)
         , mImageManager(imageManager)
         , mNifFileManager(nifFileManager)
         , mBgsmFileManager(bgsmFileManager)
@@ -986,6 +1028,7 @@ namespace Resource
                 SceneUtil::Optimizer optimizer;
                 optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
                 optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+                optimizer.setWorkQueue(mWorkQueue);
 
                 static const unsigned int options
                     = getOptimizationOptions() | SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
@@ -995,6 +1038,8 @@ namespace Resource
             else
                 shareState(loaded);
 
+            SceneUtil::markSharedSubgraphs(*loaded);
+
             if (compile && mIncrementalCompileOperation)
                 mIncrementalCompileOperation->add(loaded);
             else
@@ -1005,15 +1050,33 @@ namespace Resource
         }
     }
 
+    osg::ref_ptr<PrefetchItem> SceneManager::prefetch(std::vector<VFS::Path::Normalized> names)
+    {
+        osg::ref_ptr<PrefetchItem> item(new PrefetchItem(*this, std::move(names)));
+        if (mWorkQueue != nullptr)
+            mWorkQueue->addWorkItem(item);
+        else
+        {
+            item->doWork();
+            item->signalDone();
+        }
+        return item;
+    }
+
+    void SceneManager::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        mWorkQueue = workQueue;
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::getInstance(std::string_view name)
     {
         osg::ref_ptr<const osg::Node> scene = getTemplate(name);
         return getInstance(scene);
     }
 
-    osg::ref_ptr<osg::Node> SceneManager::cloneNode(const osg::Node* base)
+    osg::ref_ptr<osg::Node> SceneManager::cloneNode(const osg::Node* base, bool shareSubgraphs)
     {
-        SceneUtil::CopyOp copyop;
+        SceneUtil::CopyOp copyop(shareSubgraphs);
         if (const osg::Drawable* drawable = base->asDrawable())
         {
             if (drawable->asGeometry())
@@ -1032,9 +1095,9 @@ namespace Resource
         return cloned;
     }
 
-    osg::ref_ptr<osg::Node> SceneManager::getInstance(const osg::Node* base)
+    osg::ref_ptr<osg::Node> SceneManager::getInstance(const osg::Node* base, bool shareSubgraphs)
     {
-        osg::ref_ptr<osg::Node> cloned = cloneNode(base);
+        osg::ref_ptr<osg::Node> cloned = cloneNode(base, shareSubgraphs);
         // we can skip any scene graphs without update callbacks since we know that particle emitters will have an
         // update callback set
         if (cloned->getNumChildrenRequiringUpdateTraversal() > 0)
@@ -1046,6 +1109,12 @@ namespace Resource
         return cloned;
     }
 
+    osg::ref_ptr<osg::Node> SceneManager::getInstanceSharingSubgraphs(std::string_view name)
+    {
+        osg::ref_ptr<const osg::Node> scene = getTemplate(name);
+        return getInstance(scene, true);
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::getInstance(std::string_view name, osg::Group* parentNode)
     {
         osg::ref_ptr<osg::Node> cloned = getInstance(name);
@@ -1053,6 +1122,27 @@ namespace Resource
         return cloned;
     }
 
+    osg::ref_ptr<osg::Node> SceneManager::getPooledInstance(std::string_view name, std::string_view key, bool& reused)
+    {
+        osg::ref_ptr<osg::Object> pooled = mInstancePool->takeFromObjectCache(makeInstancePoolKey(name, key));
+        reused = pooled != nullptr;
+        if (!reused)
+            return getInstance(name);
+
+        osg::ref_ptr<osg::Node> instance = static_cast<osg::Node*>(pooled.get());
+        if (instance->getNumChildrenRequiringUpdateTraversal() > 0)
+        {
+            const osg::ref_ptr<const osg::Node> base = getTemplate(name);
+            resetParticles(*base, *instance);
+        }
+        return instance;
+    }
+
+    void SceneManager::releaseInstance(std::string_view name, std::string_view key, osg::ref_ptr<osg::Node> instance)
+    {
+        mInstancePool->addEntryToObjectCache(makeInstancePoolKey(name, key), instance.get());
+    }
+
     void SceneManager::attachTo(osg::Node* instance, osg::Group* parentNode) const
     {
         parentNode->addChild(instance);
@@ -1148,6 +1238,8 @@ namespace Resource
     {
         ResourceManager::updateCache(referenceTime);
 
+        mInstancePool->update(referenceTime, mExpiryDelay);
+
         mSharedStateMutex.lock();
         mSharedStateManager->prune();
         mSharedStateMutex.unlock();
@@ -1176,6 +1268,8 @@ namespace Resource
     {
         ResourceManager::clearCache();
 
+        mInstancePool->clear();
+
         std::lock_guard<std::mutex> lock(mSharedStateMutex);
         mSharedStateManager->clearCache();
     }
@@ -1195,6 +1289,36 @@ namespace Resource
         }
 
         Resource::reportStats("Node", frameNumber, mCache->getStats(), *stats);
+        Resource::reportStats("Node Instance", frameNumber, mInstancePool->getStats(), *stats);
+    }
+
+    PrefetchItem::PrefetchItem(SceneManager& sceneManager, std::vector<VFS::Path::Normalized>&& names)
+        : mSceneManager(sceneManager)
+        , mNames(std::move(names))
+    {
+    }
+
+    void PrefetchItem::doWork()
+    {
+        mTemplates.resize(mNames.size());
+        // Let the disk read the following files while the first ones are parsed
+        mSceneManager.getVFS()->prefetch(mNames);
+        for (std::size_t i = 0; i < mNames.size(); ++i)
+        {
+            if (mAbort)
+                break;
+            // Missing files are reported when they are actually used
+            if (!mSceneManager.getVFS()->exists(mNames[i]))
+                continue;
+            try
+            {
+                mTemplates[i] = mSceneManager.getTemplate(mNames[i].value());
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to prefetch \"" << mNames[i] << "\": " << e.what();
+            }
+        }
     }
 
     osg::ref_ptr<Shader::ShaderVisitor> SceneManager::createShaderVisitor(const std::string& shaderPrefix)
@@ -1212,6 +1336,8 @@ namespace Resource
         shaderVisitor->setAdjustCoverageForAlphaTest(mAdjustCoverageForAlphaTest);
         shaderVisitor->setSupportsNormalsRT(mSupportsNormalsRT);
         shaderVisitor->setWeatherParticleOcclusion(mWeatherParticleOcclusion);
+        shaderVisitor->setGpuSkinning(mGpuSkinning);
+        shaderVisitor->setGpuMorphing(mGpuMorphing);
         return shaderVisitor;
     }
 }
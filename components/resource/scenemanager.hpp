@@ -2,9 +2,11 @@
 #define OPENMW_COMPONENTS_RESOURCE_SCENEMANAGER_H
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <osg/Texture>
 #include <osg/ref_ptr>
@@ -12,6 +14,8 @@
 #include "resourcemanager.hpp"
 
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/vfs/pathutil.hpp>
 #include <filesystem>
 
 namespace VFS
@@ -33,6 +37,7 @@ namespace Resource
     class ImageManager;
     class NifFileManager;
     class BgsmFileManager;
+    class MultiObjectCache;
     class SharedStateManager;
 }
 
@@ -84,6 +89,30 @@ namespace Resource
         std::vector<osg::ref_ptr<const Object>> mObjects;
     };
 
+    class SceneManager;
+
+    /// @brief Work item loading a batch of scene templates in the background.
+    /// @see SceneManager::prefetch
+    class PrefetchItem : public SceneUtil::WorkItem
+    {
+    public:
+        PrefetchItem(SceneManager& sceneManager, std::vector<VFS::Path::Normalized>&& names);
+
+        void doWork() override;
+
+        void abort() override { mAbort = true; }
+
+        /// Loaded templates, can be used only after waitTillDone().
+        /// @note Contains nullptr for files that don't exist or were not loaded because of abort().
+        const std::vector<osg::ref_ptr<const osg::Node>>& getTemplates() const { return mTemplates; }
+
+    private:
+        SceneManager& mSceneManager;
+        std::vector<VFS::Path::Normalized> mNames;
+        std::vector<osg::ref_ptr<const osg::Node>> mTemplates;
+        std::atomic_bool mAbort{ false };
+    };
+
     /// @brief Handles loading and caching of scenes, e.g. .nif files or .osg files
     /// @note Some methods of the scene manager can be used from any thread, see the methods documentation for more
     /// details.
@@ -160,15 +189,28 @@ namespace Resource
         /// @note Thread safe.
         osg::ref_ptr<const osg::Node> getTemplate(std::string_view name, bool compile = true);
 
+        /// Load, convert and optimise the given scene templates on the work queue so the following getTemplate calls
+        /// don't have to do it. The templates stay loaded at least as long as the returned item is referenced, use
+        /// waitTillDone() on it to wait for all of them. Loads the templates immediately when there is no work queue.
+        /// @note Thread safe.
+        osg::ref_ptr<PrefetchItem> prefetch(std::vector<VFS::Path::Normalized> names);
+
+        /// Set the work queue to use for prefetch and to optimize the templates in parallel. The work queue has to
+        /// outlive the scene manager or be reset.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+        SceneUtil::WorkQueue* getWorkQueue() const { return mWorkQueue; }
+
         /// Clone osg::Node safely.
+        /// @param shareSubgraphs Use the subgraphs marked by SceneUtil::markSharedSubgraphs instead of copies
         /// @note Thread safe.
-        static osg::ref_ptr<osg::Node> cloneNode(const osg::Node* base);
+        static osg::ref_ptr<osg::Node> cloneNode(const osg::Node* base, bool shareSubgraphs = false);
 
         void shareState(osg::ref_ptr<osg::Node> node);
 
         /// Clone osg::Node and adjust it according to SceneManager's settings.
+        /// @param shareSubgraphs Use the subgraphs marked by SceneUtil::markSharedSubgraphs instead of copies
         /// @note Thread safe.
-        osg::ref_ptr<osg::Node> getInstance(const osg::Node* base);
+        osg::ref_ptr<osg::Node> getInstance(const osg::Node* base, bool shareSubgraphs = false);
 
         /// Instance the given scene template.
         /// @see getTemplate
@@ -180,6 +222,26 @@ namespace Resource
         /// @note Not thread safe, unless parentNode is not part of the main scene graph yet.
         osg::ref_ptr<osg::Node> getInstance(std::string_view name, osg::Group* parentNode);
 
+        /// Instance the given scene template, using its subgraphs that are the same for every instance instead of
+        /// copies. Saves memory and time for templates instanced many times.
+        /// @note Only for instances of which the nodes below the root are not changed or attached to.
+        /// @see SceneUtil::markSharedSubgraphs
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Node> getInstanceSharingSubgraphs(std::string_view name);
+
+        /// Take an instance of the given scene template given back by releaseInstance, or instance it like
+        /// getInstance.
+        /// @param key Identifies the changes the caller applies to new instances, reused instances keep them
+        /// @param reused Set to whether the instance was given back before
+        /// @note The particles of reused instances are reset, controller sources have to be assigned again.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Node> getPooledInstance(std::string_view name, std::string_view key, bool& reused);
+
+        /// Give back an instance taken by getPooledInstance that is no longer attached to any parents. The instance
+        /// is kept for reuse until it expires like the cached templates.
+        /// @note Thread safe.
+        void releaseInstance(std::string_view name, std::string_view key, osg::ref_ptr<osg::Node> instance);
+
         /// Attach the given scene instance to the given parent node
         /// @note You should have the parentNode in its intended position before calling this method,
         ///       so that world space particles of the \a instance get transformed correctly.
@@ -232,6 +294,14 @@ namespace Resource
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        /// Skin the RigGeometries of the loaded models in the vertex shader.
+        /// @note Only affects the models loaded after this call.
+        void setGpuSkinning(bool value) { mGpuSkinning = value; }
+
+        /// Apply the morph targets of the loaded models in the vertex shader.
+        /// @note Only affects the models loaded after this call.
+        void setGpuMorphing(bool value) { mGpuMorphing = value; }
+
     private:
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
         osg::ref_ptr<osg::Node> loadErrorMarker();
@@ -254,8 +324,12 @@ namespace Resource
         std::array<osg::ref_ptr<osg::Texture>, 2> mOpaqueDepthTex;
         bool mSoftParticles = false;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
 
         osg::ref_ptr<Resource::SharedStateManager> mSharedStateManager;
+        // Released instances by template name and key
+        osg::ref_ptr<MultiObjectCache> mInstancePool;
         mutable std::mutex mSharedStateMutex;
 
         Resource::ImageManager* mImageManager;
@@ -268,6 +342,7 @@ namespace Resource
         bool mUnRefImageDataAfterApply;
 
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
+        SceneUtil::WorkQueue* mWorkQueue = nullptr;
 
         unsigned int mParticleSystemMask;
         mutable osg::ref_ptr<osg::Node> mErrorMarker;
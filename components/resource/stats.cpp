@@ -47,6 +47,43 @@ namespace Resource
         bool collectStatUpdate = false;
         bool collectStatEngine = false;
 
+        constexpr std::string_view caches[] = {
+            "Node",
+            "Node Instance",
+            "Shape",
+            "Shape Instance",
+            "Image",
+            "Nif",
+            "Keyframe",
+            "BSShader Material",
+            "Groundcover Chunk",
+            "Object Chunk",
+            "Object Instanced Template",
+            "Terrain Chunk",
+            "Terrain Texture",
+            "Land",
+        };
+
+        constexpr std::string_view memory[] = {
+            "ESMStore Records",
+            "ESMStore Bytes",
+            "CellStore Count",
+            "CellStore References",
+            "CellStore Bytes",
+            "",
+            "CellPreloader Bytes",
+            "",
+            "ResourceBudget Limit",
+            "ResourceBudget Bytes",
+            "ResourceBudget Pressure",
+            "ResourceBudget Evicted",
+            "ResourceBudget Evicted Bytes",
+            "",
+            "NavMesh CacheSize",
+            "Lua UsedMemory",
+            "SoundBuffer CacheSize",
+        };
+
         std::vector<std::string> generateAllStatNames()
         {
             constexpr std::size_t itemsPerPage = 24;
@@ -56,9 +93,11 @@ namespace Resource
                 "",
                 "Loading",
                 "Compiling",
+                "Compiling Cells",
                 "WorkQueue",
                 "WorkThread",
                 "UnrefQueue",
+                "UnrefQueue Shared",
                 "",
                 "Texture",
                 "StateSet",
@@ -71,36 +110,36 @@ namespace Resource
                 "Physics Objects",
                 "Physics Projectiles",
                 "Physics HeightFields",
+                "Physics Sync",
                 "",
                 "Lua UsedMemory",
-                "",
-                "",
-                "",
             };
 
             static_assert(std::size(firstPage) == itemsPerPage);
 
-            constexpr std::string_view caches[] = {
-                "Node",
-                "Shape",
-                "Shape Instance",
-                "Image",
-                "Nif",
-                "Keyframe",
-                "BSShader Material",
-                "Groundcover Chunk",
-                "Object Chunk",
-                "Terrain Chunk",
-                "Terrain Texture",
-                "Land",
-            };
-
             constexpr std::string_view cellPreloader[] = {
                 "CellPreloader Count",
                 "CellPreloader Added",
                 "CellPreloader Evicted",
                 "CellPreloader Loaded",
                 "CellPreloader Expired",
+                "CellPreloader Bytes",
+                "CellPreloader Added Bytes",
+                "CellPreloader Evicted Bytes",
+                "CellPreloader Expired Bytes",
+            };
+
+            constexpr std::string_view workQueue[] = {
+                "WorkQueue Urgent Queued",
+                "WorkQueue Urgent Completed",
+                "WorkQueue Urgent Cancelled",
+                "WorkQueue Visible Queued",
+                "WorkQueue Visible Completed",
+                "WorkQueue Visible Cancelled",
+                "WorkQueue Speculative Queued",
+                "WorkQueue Speculative Completed",
+                "WorkQueue Speculative Cancelled",
+                "WorkQueue Stolen",
             };
 
             constexpr std::string_view navMesh[] = {
@@ -114,6 +153,8 @@ namespace Resource
                 "NavMesh DbJobs Read",
                 "NavMesh DbCache Get",
                 "NavMesh DbCache Hit",
+                "NavMesh DbCache Direct Get",
+                "NavMesh DbCache Direct Latency",
                 "NavMesh CacheSize",
                 "NavMesh UsedTiles",
                 "NavMesh CachedTiles",
@@ -123,6 +164,47 @@ namespace Resource
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
                 "NavMesh Recast Water",
+                "NavMesh Path MissingTiles",
+                "NavMesh NavMeshes",
+                "NavMesh NavMesh Tiles",
+            };
+
+            constexpr std::string_view occlusion[] = {
+                "Occlusion Tested",
+                "Occlusion Culled",
+            };
+
+            constexpr std::string_view water[] = {
+                "Water Reflection Skipped",
+                "Water Refraction Skipped",
+            };
+
+            constexpr std::string_view sound[] = {
+                "Sound Playing",
+                "Sound Virtual",
+                "Sound Streams",
+                "SoundBuffer Hit",
+                "SoundBuffer Miss",
+                "SoundBuffer Prefetched",
+                "SoundBuffer Decoding",
+                "SoundBuffer CacheSize",
+            };
+
+            constexpr std::string_view mechanics[] = {
+                "Mechanics AI FullRate",
+                "Mechanics AI ReducedRate",
+                "Mechanics AI LowRate",
+            };
+
+            constexpr std::string_view localScripts[] = {
+                "LocalScripts Count",
+                "LocalScripts Skipped",
+                "LocalScripts Slowest",
+            };
+
+            constexpr std::string_view physics[] = {
+                "Physics Actors Awake",
+                "Physics Actors Sleeping",
             };
 
             std::vector<std::string> statNames;
@@ -140,12 +222,54 @@ namespace Resource
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : workQueue)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : occlusion)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : water)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : sound)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : mechanics)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : localScripts)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : physics)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string& name : getMemoryStatNames())
+                statNames.push_back(std::move(name));
+
             return statNames;
         }
 
@@ -590,6 +714,17 @@ namespace Resource
         usage.addKeyboardMouseBinding(statsHandlerKey, "On screen resource usage stats.");
     }
 
+    std::vector<std::string> getMemoryStatNames()
+    {
+        std::vector<std::string> result;
+        for (std::string_view cache : caches)
+            result.push_back(std::string(cache) + " Bytes");
+        result.emplace_back();
+        for (std::string_view name : memory)
+            result.emplace_back(name);
+        return result;
+    }
+
     void collectStatistics(osgViewer::ViewerBase& viewer)
     {
         osgViewer::Viewer::Cameras cameras;
@@ -68,6 +68,9 @@ namespace Resource
         void setUpScene(osgViewer::ViewerBase& viewer);
     };
 
+    /// Names of the attributes describing memory usage in the order they are shown, empty ones are separators.
+    std::vector<std::string> getMemoryStatNames();
+
     void collectStatistics(osgViewer::ViewerBase& viewer);
 }
 
@@ -0,0 +1,197 @@
+#include "statsexporter.hpp"
+
+#include <components/debug/tracing.hpp>
+#include <components/files/conversion.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace Resource
+{
+    namespace
+    {
+        std::int64_t toNanoseconds(std::chrono::system_clock::time_point time)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        void writeCsvField(std::ostream& stream, std::string_view value)
+        {
+            if (value.find_first_of(",\"\n") == std::string_view::npos)
+            {
+                stream << value;
+                return;
+            }
+            stream << '"';
+            for (char c : value)
+            {
+                if (c == '"')
+                    stream << '"';
+                stream << c;
+            }
+            stream << '"';
+        }
+
+        void writeLineProtocolKey(std::ostream& stream, std::string_view value)
+        {
+            for (char c : value)
+            {
+                if (c == ' ' || c == ',' || c == '=' || c == '\\')
+                    stream << '\\';
+                stream << c;
+            }
+        }
+    }
+
+    std::optional<StatsExportFormat> parseStatsExportFormat(std::string_view value)
+    {
+        if (value == "csv")
+            return StatsExportFormat::Csv;
+        if (value == "line-protocol")
+            return StatsExportFormat::LineProtocol;
+        return std::nullopt;
+    }
+
+    std::vector<std::string> getDefaultExportedStatNames()
+    {
+        return {
+            "Frame duration",
+            "input_time_taken",
+            "mechanics_time_taken",
+            "physics_time_taken",
+            "physicsworker_time_taken",
+            "world_time_taken",
+            "lua_time_taken",
+            "Lua UsedMemory",
+            "Physics Actors",
+            "Physics Objects",
+            "Mechanics Actors",
+            "Node Count",
+            "Node Bytes",
+            "Image Count",
+            "Image Bytes",
+            "Shape Count",
+            "Shape Bytes",
+            "NavMesh Jobs",
+            "NavMesh Processing",
+            "NavMesh CacheSize",
+            "CellPreloader Count",
+            "CellPreloader Loaded",
+            "CellPreloader Bytes",
+            "WorkQueue",
+        };
+    }
+
+    StatsExporter::StatsExporter(const std::filesystem::path& path, StatsExportFormat format,
+        std::vector<std::string> attributes, unsigned interval)
+        : mFormat(format)
+        , mAttributes(std::move(attributes))
+        , mInterval(std::max(interval, 1u))
+        , mStream(path)
+    {
+        if (!mStream.is_open())
+            throw std::runtime_error("Failed to open stats export file: " + Files::pathToUnicodeString(path));
+        mStream << std::setprecision(std::numeric_limits<double>::max_digits10);
+        writeHeader();
+        mThread = std::thread([this] { run(); });
+    }
+
+    StatsExporter::~StatsExporter()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopped = true;
+        }
+        mHasSamples.notify_all();
+        mThread.join();
+    }
+
+    void StatsExporter::collect(unsigned frameNumber, const osg::Stats& stats)
+    {
+        if (frameNumber % mInterval != 0)
+            return;
+        Sample sample{
+            .mFrameNumber = frameNumber,
+            .mTime = std::chrono::system_clock::now(),
+            .mValues = std::vector<std::optional<double>>(mAttributes.size()),
+        };
+        for (std::size_t i = 0; i < mAttributes.size(); ++i)
+        {
+            double value = 0;
+            if (stats.getAttribute(frameNumber, mAttributes[i], value))
+                sample.mValues[i] = value;
+        }
+        {
+            const std::lock_guard lock(mMutex);
+            mSamples.push_back(std::move(sample));
+        }
+        mHasSamples.notify_one();
+    }
+
+    void StatsExporter::run()
+    {
+        OPENMW_TRACE_THREAD_NAME("StatsExporter");
+        std::vector<Sample> samples;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mHasSamples.wait(lock, [&] { return mStopped || !mSamples.empty(); });
+                if (mSamples.empty())
+                    break;
+                std::swap(samples, mSamples);
+            }
+            for (const Sample& sample : samples)
+                write(sample);
+            mStream.flush();
+            samples.clear();
+        }
+    }
+
+    void StatsExporter::writeHeader()
+    {
+        if (mFormat != StatsExportFormat::Csv)
+            return;
+        mStream << "frame,timestamp";
+        for (const std::string& attribute : mAttributes)
+        {
+            mStream << ',';
+            writeCsvField(mStream, attribute);
+        }
+        mStream << '\n';
+    }
+
+    void StatsExporter::write(const Sample& sample)
+    {
+        switch (mFormat)
+        {
+            case StatsExportFormat::Csv:
+                mStream << sample.mFrameNumber << ',' << toNanoseconds(sample.mTime);
+                for (const std::optional<double>& value : sample.mValues)
+                {
+                    mStream << ',';
+                    if (value.has_value())
+                        mStream << *value;
+                }
+                break;
+            case StatsExportFormat::LineProtocol:
+                mStream << "openmw frame=" << sample.mFrameNumber << 'i';
+                for (std::size_t i = 0; i < mAttributes.size(); ++i)
+                {
+                    if (!sample.mValues[i].has_value())
+                        continue;
+                    mStream << ',';
+                    writeLineProtocolKey(mStream, mAttributes[i]);
+                    mStream << '=' << *sample.mValues[i];
+                }
+                mStream << ' ' << toNanoseconds(sample.mTime);
+                break;
+        }
+        mStream << '\n';
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_STATSEXPORTER_H
+#define OPENMW_COMPONENTS_RESOURCE_STATSEXPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace Resource
+{
+    enum class StatsExportFormat
+    {
+        Csv,
+        LineProtocol,
+    };
+
+    std::optional<StatsExportFormat> parseStatsExportFormat(std::string_view value);
+
+    /// Attributes exported when none are specified: frame and subsystem timings, Lua, cache and navmesh job counters
+    std::vector<std::string> getDefaultExportedStatNames();
+
+    /// @brief Streams selected attributes of osg::Stats into a file every given number of frames.
+    /// @par Values are copied on the calling thread, formatting and writing are done by a background thread so the
+    /// file I/O doesn't affect the frame time. Missing attributes are written as empty CSV cells and are omitted from
+    /// line protocol records.
+    class StatsExporter
+    {
+    public:
+        explicit StatsExporter(const std::filesystem::path& path, StatsExportFormat format,
+            std::vector<std::string> attributes, unsigned interval);
+
+        StatsExporter(const StatsExporter&) = delete;
+        StatsExporter& operator=(const StatsExporter&) = delete;
+
+        /// Writes all collected frames before return
+        ~StatsExporter();
+
+        /// Takes the values if the frame number is a multiple of the interval
+        void collect(unsigned frameNumber, const osg::Stats& stats);
+
+    private:
+        struct Sample
+        {
+            unsigned mFrameNumber;
+            std::chrono::system_clock::time_point mTime;
+            std::vector<std::optional<double>> mValues;
+        };
+
+        const StatsExportFormat mFormat;
+        const std::vector<std::string> mAttributes;
+        const unsigned mInterval;
+        std::ofstream mStream;
+        std::mutex mMutex;
+        std::condition_variable mHasSamples;
+        std::vector<Sample> mSamples;
+        bool mStopped = false;
+        std::thread mThread;
+
+        void run();
+
+        void writeHeader();
+
+        void write(const Sample& sample);
+    };
+}
+
+#endif
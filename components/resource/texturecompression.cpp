@@ -0,0 +1,320 @@
+#include "texturecompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <osg/Texture>
+
+namespace Resource
+{
+    namespace
+    {
+        using Rgba = std::array<std::uint8_t, 4>;
+        using Block = std::array<Rgba, 16>;
+
+        struct Level
+        {
+            int mWidth;
+            int mHeight;
+            std::vector<Rgba> mPixels;
+        };
+
+        Level readLevel(const osg::Image& image)
+        {
+            const GLenum format = image.getPixelFormat();
+            const bool bgr = format == GL_BGR || format == GL_BGRA;
+            const unsigned components = osg::Image::computeNumComponents(format);
+            Level result{ image.s(), image.t(), {} };
+            result.mPixels.reserve(static_cast<std::size_t>(image.s()) * image.t());
+            for (int t = 0; t < image.t(); ++t)
+            {
+                const unsigned char* pixel = image.data(0, t);
+                for (int s = 0; s < image.s(); ++s, pixel += components)
+                {
+                    Rgba value{ pixel[0], pixel[1], pixel[2], components == 4 ? pixel[3] : std::uint8_t(255) };
+                    if (bgr)
+                        std::swap(value[0], value[2]);
+                    result.mPixels.push_back(value);
+                }
+            }
+            return result;
+        }
+
+        Level downsample(const Level& level)
+        {
+            Level result{ std::max(1, level.mWidth / 2), std::max(1, level.mHeight / 2), {} };
+            result.mPixels.reserve(static_cast<std::size_t>(result.mWidth) * result.mHeight);
+            const auto get = [&](int x, int y) -> const Rgba& {
+                return level.mPixels[std::min(y, level.mHeight - 1) * level.mWidth + std::min(x, level.mWidth - 1)];
+            };
+            for (int y = 0; y < result.mHeight; ++y)
+            {
+                for (int x = 0; x < result.mWidth; ++x)
+                {
+                    Rgba value;
+                    for (std::size_t c = 0; c < value.size(); ++c)
+                    {
+                        const int sum = get(2 * x, 2 * y)[c] + get(2 * x + 1, 2 * y)[c] + get(2 * x, 2 * y + 1)[c]
+                            + get(2 * x + 1, 2 * y + 1)[c];
+                        value[c] = static_cast<std::uint8_t>((sum + 2) / 4);
+                    }
+                    result.mPixels.push_back(value);
+                }
+            }
+            return result;
+        }
+
+        Block getBlock(const Level& level, int blockX, int blockY)
+        {
+            // Blocks of the levels smaller than 4x4 repeat the edge pixels
+            Block result;
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                    result[y * 4 + x] = level.mPixels[std::min(blockY * 4 + y, level.mHeight - 1) * level.mWidth
+                        + std::min(blockX * 4 + x, level.mWidth - 1)];
+            return result;
+        }
+
+        std::uint16_t toRgb565(const std::array<float, 3>& color)
+        {
+            const auto quantize = [](float value, int max) {
+                return static_cast<std::uint16_t>(std::clamp<long>(std::lround(value * max / 255.f), 0, max));
+            };
+            return static_cast<std::uint16_t>(
+                (quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+        }
+
+        std::array<int, 3> fromRgb565(std::uint16_t value)
+        {
+            const int r = value >> 11;
+            const int g = (value >> 5) & 63;
+            const int b = value & 31;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        template <class T>
+        void writeLittleEndian(T value, unsigned char* out, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                out[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xff);
+        }
+
+        void encodeColorBlock(const Block& block, unsigned char* out)
+        {
+            // Take the endpoints from the extreme colours along the principal axis of the block colours
+            std::array<float, 3> mean{ 0, 0, 0 };
+            for (const Rgba& pixel : block)
+                for (std::size_t c = 0; c < 3; ++c)
+                    mean[c] += pixel[c] / 16.f;
+
+            std::array<float, 6> covariance{ 0, 0, 0, 0, 0, 0 };
+            for (const Rgba& pixel : block)
+            {
+                const float r = pixel[0] - mean[0];
+                const float g = pixel[1] - mean[1];
+                const float b = pixel[2] - mean[2];
+                covariance[0] += r * r;
+                covariance[1] += r * g;
+                covariance[2] += r * b;
+                covariance[3] += g * g;
+                covariance[4] += g * b;
+                covariance[5] += b * b;
+            }
+
+            std::array<float, 3> axis{ 1, 1, 1 };
+            for (int i = 0; i < 8; ++i)
+            {
+                const std::array<float, 3> next{
+                    covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                    covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                    covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+                };
+                const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+                if (length < 1e-6f)
+                    break;
+                for (std::size_t c = 0; c < 3; ++c)
+                    axis[c] = next[c] / length;
+            }
+
+            float minProjection = 0;
+            float maxProjection = 0;
+            for (const Rgba& pixel : block)
+            {
+                float projection = 0;
+                for (std::size_t c = 0; c < 3; ++c)
+                    projection += (pixel[c] - mean[c]) * axis[c];
+                minProjection = std::min(minProjection, projection);
+                maxProjection = std::max(maxProjection, projection);
+            }
+
+            std::array<float, 3> first;
+            std::array<float, 3> second;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                first[c] = mean[c] + axis[c] * maxProjection;
+                second[c] = mean[c] + axis[c] * minProjection;
+            }
+
+            std::uint16_t color0 = toRgb565(first);
+            std::uint16_t color1 = toRgb565(second);
+            // color0 > color1 selects the 4 colour mode without transparency
+            if (color0 < color1)
+                std::swap(color0, color1);
+
+            std::uint32_t indices = 0;
+            if (color0 != color1)
+            {
+                const std::array<int, 3> c0 = fromRgb565(color0);
+                const std::array<int, 3> c1 = fromRgb565(color1);
+                std::array<std::array<int, 3>, 4> palette{ c0, c1, c0, c0 };
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+                    palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+                }
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    std::uint32_t best = 0;
+                    int bestDistance = std::numeric_limits<int>::max();
+                    for (std::uint32_t j = 0; j < palette.size(); ++j)
+                    {
+                        int distance = 0;
+                        for (std::size_t c = 0; c < 3; ++c)
+                            distance += (block[i][c] - palette[j][c]) * (block[i][c] - palette[j][c]);
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = j;
+                        }
+                    }
+                    indices |= best << (2 * i);
+                }
+            }
+
+            writeLittleEndian(color0, out, 2);
+            writeLittleEndian(color1, out + 2, 2);
+            writeLittleEndian(indices, out + 4, 4);
+        }
+
+        void encodeAlphaBlock(const Block& block, unsigned char* out)
+        {
+            std::uint8_t minAlpha = 255;
+            std::uint8_t maxAlpha = 0;
+            for (const Rgba& pixel : block)
+            {
+                minAlpha = std::min(minAlpha, pixel[3]);
+                maxAlpha = std::max(maxAlpha, pixel[3]);
+            }
+
+            // alpha0 > alpha1 selects 8 interpolated values
+            std::uint64_t indices = 0;
+            if (maxAlpha != minAlpha)
+            {
+                std::array<int, 8> palette{ maxAlpha, minAlpha };
+                for (int i = 2; i < 8; ++i)
+                    palette[i] = ((8 - i) * maxAlpha + (i - 1) * minAlpha) / 7;
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    std::uint64_t best = 0;
+                    int bestDistance = std::numeric_limits<int>::max();
+                    for (std::uint64_t j = 0; j < palette.size(); ++j)
+                    {
+                        const int distance = std::abs(block[i][3] - palette[j]);
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = j;
+                        }
+                    }
+                    indices |= best << (3 * i);
+                }
+            }
+
+            out[0] = maxAlpha;
+            out[1] = minAlpha;
+            writeLittleEndian(indices, out + 2, 6);
+        }
+
+        std::size_t getLevelSize(const Level& level, std::size_t blockSize)
+        {
+            return static_cast<std::size_t>((level.mWidth + 3) / 4) * ((level.mHeight + 3) / 4) * blockSize;
+        }
+    }
+
+    bool isCompressible(const osg::Image& image)
+    {
+        if (image.r() != 1 || image.s() <= 0 || image.t() <= 0 || image.isMipmap()
+            || image.getDataType() != GL_UNSIGNED_BYTE)
+            return false;
+        // The base level has to consist of whole blocks
+        if (image.s() % 4 != 0 || image.t() % 4 != 0)
+            return false;
+        switch (image.getPixelFormat())
+        {
+            case GL_RGB:
+            case GL_RGBA:
+            case GL_BGR:
+            case GL_BGRA:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image)
+    {
+        if (!isCompressible(image))
+            return nullptr;
+
+        std::vector<Level> levels;
+        levels.push_back(readLevel(image));
+        while (levels.back().mWidth > 1 || levels.back().mHeight > 1)
+            levels.push_back(downsample(levels.back()));
+
+        const bool alpha = std::any_of(
+            levels.front().mPixels.begin(), levels.front().mPixels.end(), [](const Rgba& v) { return v[3] != 255; });
+        const GLenum format = alpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        const std::size_t blockSize = alpha ? 16 : 8;
+
+        std::size_t totalSize = 0;
+        for (const Level& level : levels)
+            totalSize += getLevelSize(level, blockSize);
+
+        unsigned char* data = new unsigned char[totalSize];
+        osg::Image::MipmapDataType mipmapOffsets;
+        std::size_t offset = 0;
+        for (const Level& level : levels)
+        {
+            if (offset != 0)
+                mipmapOffsets.push_back(static_cast<unsigned>(offset));
+            unsigned char* out = data + offset;
+            for (int y = 0; y < (level.mHeight + 3) / 4; ++y)
+            {
+                for (int x = 0; x < (level.mWidth + 3) / 4; ++x)
+                {
+                    const Block block = getBlock(level, x, y);
+                    if (alpha)
+                    {
+                        encodeAlphaBlock(block, out);
+                        out += 8;
+                    }
+                    encodeColorBlock(block, out);
+                    out += 8;
+                }
+            }
+            offset += getLevelSize(level, blockSize);
+        }
+
+        osg::ref_ptr<osg::Image> result = new osg::Image;
+        result->setImage(
+            image.s(), image.t(), 1, format, format, GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE);
+        result->setMipmapLevels(mipmapOffsets);
+        result->setFileName(image.getFileName());
+        result->setOrigin(image.getOrigin());
+        return result;
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSION_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSION_H
+
+#include <osg/Image>
+#include <osg/ref_ptr>
+
+namespace Resource
+{
+    /// @return true for uncompressed 8-bit RGB, RGBA, BGR and BGRA 2D images without mipmaps.
+    bool isCompressible(const osg::Image& image);
+
+    /// Convert the image into S3TC with a full mipmap chain generated by a box filter. Opaque images are stored as
+    /// DXT1, images having any alpha as DXT5.
+    /// @return nullptr when the image is not compressible.
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image);
+}
+
+#endif
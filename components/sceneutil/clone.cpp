@@ -1,6 +1,9 @@
 #include "clone.hpp"
 
+#include <osg/Geometry>
+#include <osg/MatrixTransform>
 #include <osg/StateSet>
+#include <osg/UserDataContainer>
 
 #include <osgAnimation/MorphGeometry>
 #include <osgAnimation/RigGeometry>
@@ -13,10 +16,88 @@
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 
+#include <components/misc/strings/algorithm.hpp>
+
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
 namespace SceneUtil
 {
+    namespace
+    {
+        const std::string sSharedSubgraphDescription = "SharedSubgraph";
+
+        bool isInstanceIndependent(const osg::Node& node)
+        {
+            if (node.getUpdateCallback() != nullptr || node.getCullCallback() != nullptr
+                || node.getEventCallback() != nullptr || node.getDataVariance() == osg::Object::DYNAMIC)
+                return false;
+
+            if (const osg::StateSet* stateSet = node.getStateSet())
+                if (stateSet->getUpdateCallback() != nullptr || stateSet->getEventCallback() != nullptr)
+                    return false;
+
+            // Lights are attached to it by SceneUtil::addLight
+            if (Misc::StringUtils::ciEqual(node.getName(), "AttachLight"))
+                return false;
+
+            if (const osg::Drawable* drawable = node.asDrawable())
+                return typeid(*drawable) == typeid(osg::Geometry);
+
+            return typeid(node) == typeid(osg::Group) || dynamic_cast<const osg::MatrixTransform*>(&node) != nullptr;
+        }
+
+        // Returns if the whole subgraph can be shared, otherwise marks its largest subgraphs that can
+        bool markSubgraphs(osg::Node& node)
+        {
+            osg::Group* group = node.asGroup();
+            if (group == nullptr)
+                return isInstanceIndependent(node);
+
+            std::vector<bool> shareable(group->getNumChildren());
+            for (unsigned i = 0; i < group->getNumChildren(); ++i)
+                shareable[i] = markSubgraphs(*group->getChild(i));
+
+            if (isInstanceIndependent(node) && std::find(shareable.begin(), shareable.end(), false) == shareable.end())
+                return true;
+
+            // Drawables are not copied anyway
+            for (unsigned i = 0; i < group->getNumChildren(); ++i)
+                if (shareable[i] && group->getChild(i)->asGroup() != nullptr)
+                    group->getChild(i)->getOrCreateUserDataContainer()->addDescription(sSharedSubgraphDescription);
+
+            return false;
+        }
+    }
+
+    void markSharedSubgraphs(osg::Node& root)
+    {
+        // The root is changed by most users of the instances
+        osg::Group* group = root.asGroup();
+        if (group == nullptr)
+            return;
+
+        for (unsigned i = 0; i < group->getNumChildren(); ++i)
+        {
+            osg::Node& child = *group->getChild(i);
+            if (markSubgraphs(child) && child.asGroup() != nullptr)
+                child.getOrCreateUserDataContainer()->addDescription(sSharedSubgraphDescription);
+        }
+    }
+
+    bool isSharedSubgraph(const osg::Node& node)
+    {
+        const osg::UserDataContainer* container = node.getUserDataContainer();
+        if (container == nullptr)
+            return false;
+        const osg::UserDataContainer::DescriptionList& descriptions = container->getDescriptions();
+        return std::find(descriptions.begin(), descriptions.end(), sSharedSubgraphDescription) != descriptions.end();
+    }
 
-    CopyOp::CopyOp()
+    CopyOp::CopyOp(bool shareSubgraphs)
+        : mShareSubgraphs(shareSubgraphs)
     {
         setCopyFlags(osg::CopyOp::DEEP_COPY_NODES
             // Controller might need different inputs per scene instance
@@ -25,6 +106,8 @@ namespace SceneUtil
 
     osg::Node* CopyOp::operator()(const osg::Node* node) const
     {
+        if (mShareSubgraphs && isSharedSubgraph(*node))
+            return const_cast<osg::Node*>(node);
         if (const osgParticle::ParticleProcessor* processor = dynamic_cast<const osgParticle::ParticleProcessor*>(node))
             return operator()(processor);
         if (const osgParticle::ParticleSystemUpdater* updater
@@ -5,6 +5,11 @@
 
 #include <osg/CopyOp>
 
+namespace osg
+{
+    class Node;
+}
+
 namespace osgParticle
 {
     class ParticleProcessor;
@@ -15,16 +20,27 @@ namespace osgParticle
 namespace SceneUtil
 {
 
+    /// Mark the largest subgraphs below the root of a scene template that are the same for every instance: plain
+    /// groups and static transforms without callbacks and their plain geometry. Nodes lights are attached to are not
+    /// marked.
+    /// @note Call once per template, after it is optimized.
+    void markSharedSubgraphs(osg::Node& root);
+
+    /// @return If the node is the root of a subgraph marked by markSharedSubgraphs
+    bool isSharedSubgraph(const osg::Node& node);
+
     /// @par Defines the cloning behaviour we need:
     /// * Assigns updated ParticleSystem pointers on cloned emitters and programs.
     /// * Deep copies RigGeometry and MorphGeometry so they can animate without affecting clones.
+    /// * Optionally, uses the subgraphs marked by markSharedSubgraphs as they are instead of copying them.
     /// @warning Avoid using this class directly. The safety of cloning operations depends on the copy flags and the
     /// objects involved. Consider using SceneManager::cloneNode for additional safety.
     /// @warning Do not use an object of this class for more than one copy operation.
     class CopyOp : public osg::CopyOp
     {
     public:
-        CopyOp();
+        /// @param shareSubgraphs Only for instances of which the nodes below the root are not changed
+        explicit CopyOp(bool shareSubgraphs = false);
 
         virtual osgParticle::ParticleSystem* operator()(const osgParticle::ParticleSystem* partsys) const;
         virtual osgParticle::ParticleProcessor* operator()(const osgParticle::ParticleProcessor* processor) const;
@@ -33,6 +49,7 @@ namespace SceneUtil
         osg::Drawable* operator()(const osg::Drawable* drawable) const override;
 
     private:
+        bool mShareSubgraphs;
         // maps new pointers to their old pointers
         // a little messy, but I think this should be the most efficient way
         mutable std::map<osgParticle::ParticleProcessor*, const osgParticle::ParticleSystem*> mProcessorToOldPs;
@@ -12,6 +12,12 @@
 namespace SceneUtil
 {
 
+    void VisibilityGate::operator()(osg::Node* node, osg::NodeVisitor* nv)
+    {
+        mLastCullFrameNumber = nv->getTraversalNumber();
+        traverse(node, nv);
+    }
+
     Controller::Controller() {}
 
     bool Controller::hasInput() const
@@ -47,6 +53,16 @@ namespace SceneUtil
         return mFunction;
     }
 
+    void Controller::setVisibilityGate(osg::ref_ptr<const VisibilityGate> gate)
+    {
+        mVisibilityGate = std::move(gate);
+    }
+
+    bool Controller::isOffscreen(const osg::NodeVisitor* nv) const
+    {
+        return mVisibilityGate != nullptr && !mVisibilityGate->wasVisible(nv->getTraversalNumber());
+    }
+
     FrameTimeSource::FrameTimeSource() {}
 
     float FrameTimeSource::getValue(osg::NodeVisitor* nv)
@@ -130,6 +146,20 @@ namespace SceneUtil
         ctrl.setSource(mToAssign);
     }
 
+    AssignVisibilityGateVisitor::AssignVisibilityGateVisitor(osg::ref_ptr<const VisibilityGate> gate)
+        : ControllerVisitor()
+        , mGate(std::move(gate))
+    {
+    }
+
+    void AssignVisibilityGateVisitor::visit(osg::Node&, Controller& ctrl)
+    {
+        if (mGate == nullptr)
+            ctrl.setVisibilityGate(nullptr);
+        else if (dynamic_cast<const FrameTimeSource*>(ctrl.getSource().get()) != nullptr)
+            ctrl.setVisibilityGate(mGate);
+    }
+
     FindMaxControllerLengthVisitor::FindMaxControllerLengthVisitor()
         : SceneUtil::ControllerVisitor()
         , mMaxLength(0)
@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <osg/NodeVisitor>
+#include <osg/ref_ptr>
+
+#include "nodecallback.hpp"
 
 namespace SceneUtil
 {
@@ -35,6 +38,22 @@ namespace SceneUtil
         virtual float getMaximum() const = 0;
     };
 
+    /// @brief Cull callback remembering the last frame the node was culled in, i.e. found to be potentially visible by
+    /// any camera.
+    /// @par Controllers with a VisibilityGate skip their updates while the node is offscreen. The controllers compute
+    /// their state from the current input value, so they catch up with the time passed once the node is visible again.
+    class VisibilityGate : public NodeCallback<VisibilityGate>
+    {
+    public:
+        void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+        /// @return If the node was culled in one of the previous frames before the given frame.
+        bool wasVisible(unsigned int frameNumber) const { return mLastCullFrameNumber + 3 > frameNumber; }
+
+    private:
+        unsigned int mLastCullFrameNumber = 0;
+    };
+
     class Controller
     {
     public:
@@ -51,9 +70,20 @@ namespace SceneUtil
         std::shared_ptr<ControllerSource> getSource() const;
         std::shared_ptr<ControllerFunction> getFunction() const;
 
+        /// Let the controller skip its updates while the gate's node is offscreen. Only used by controllers which have
+        /// no effect on the game logic, nullptr to always update.
+        void setVisibilityGate(osg::ref_ptr<const VisibilityGate> gate);
+
+        const osg::ref_ptr<const VisibilityGate>& getVisibilityGate() const { return mVisibilityGate; }
+
+        /// @return If the update of this frame can be skipped as the gate's node was not visible recently.
+        bool isOffscreen(const osg::NodeVisitor* nv) const;
+
     private:
         std::shared_ptr<ControllerSource> mSource;
 
+        osg::ref_ptr<const VisibilityGate> mVisibilityGate;
+
         // The source value gets passed through this function before it's passed on to the DestValue.
         std::shared_ptr<ControllerFunction> mFunction;
     };
@@ -101,6 +131,20 @@ namespace SceneUtil
         void visit(osg::Node& node, Controller& ctrl) override;
     };
 
+    /// Assigns the VisibilityGate to the controllers driven by a FrameTimeSource, i.e. playing on their own regardless
+    /// of the object's animation state. Pass nullptr to remove the gate, e.g. from a node whose transform is needed by
+    /// the physics.
+    class AssignVisibilityGateVisitor : public ControllerVisitor
+    {
+    public:
+        AssignVisibilityGateVisitor(osg::ref_ptr<const VisibilityGate> gate);
+
+        void visit(osg::Node& node, Controller& ctrl) override;
+
+    private:
+        osg::ref_ptr<const VisibilityGate> mGate;
+    };
+
     /// Finds the maximum of all controller functions in the given scene graph
     class FindMaxControllerLengthVisitor : public ControllerVisitor
     {
@@ -0,0 +1,138 @@
+#include "hizbuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <osgUtil/CullVisitor>
+
+#include <components/misc/constants.hpp>
+
+namespace SceneUtil
+{
+    void HiZBuffer::build(
+        std::span<const float> depth, int width, int height, const osg::Matrix& viewProjection, bool reverseZ)
+    {
+        mViewProjection = viewProjection;
+        mReverseZ = reverseZ;
+
+        if (width <= 0 || height <= 0 || depth.size() < static_cast<std::size_t>(width) * height)
+        {
+            mLevels.clear();
+            return;
+        }
+
+        std::size_t numLevels = 1;
+        for (int size = std::max(width, height); size > 1; size = (size + 1) / 2)
+            ++numLevels;
+        mLevels.resize(numLevels);
+
+        Level& base = mLevels[0];
+        base.mWidth = width;
+        base.mHeight = height;
+        base.mDepth.resize(depth.size());
+        if (reverseZ)
+            std::transform(depth.begin(), depth.end(), base.mDepth.begin(), [](float v) { return 1.f - v; });
+        else
+            std::copy(depth.begin(), depth.end(), base.mDepth.begin());
+
+        for (std::size_t i = 1; i < numLevels; ++i)
+        {
+            const Level& src = mLevels[i - 1];
+            Level& dst = mLevels[i];
+            dst.mWidth = (src.mWidth + 1) / 2;
+            dst.mHeight = (src.mHeight + 1) / 2;
+            dst.mDepth.resize(static_cast<std::size_t>(dst.mWidth) * dst.mHeight);
+            for (int y = 0; y < dst.mHeight; ++y)
+            {
+                const int y0 = y * 2;
+                const int y1 = std::min(y0 + 1, src.mHeight - 1);
+                for (int x = 0; x < dst.mWidth; ++x)
+                {
+                    const int x0 = x * 2;
+                    const int x1 = std::min(x0 + 1, src.mWidth - 1);
+                    dst.mDepth[y * dst.mWidth + x] = std::max(
+                        std::max(src.mDepth[y0 * src.mWidth + x0], src.mDepth[y0 * src.mWidth + x1]),
+                        std::max(src.mDepth[y1 * src.mWidth + x0], src.mDepth[y1 * src.mWidth + x1]));
+                }
+            }
+        }
+    }
+
+    void HiZBuffer::clear()
+    {
+        mLevels.clear();
+    }
+
+    bool HiZBuffer::isOccluded(const osg::BoundingBox& box) const
+    {
+        if (mLevels.empty() || !box.valid())
+            return false;
+
+        ++mNumTested;
+
+        const Level& base = mLevels[0];
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        float nearest = std::numeric_limits<float>::max();
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            const osg::Vec4f clip = osg::Vec4f(box.corner(i), 1.f) * mViewProjection;
+            if (clip.w() <= 0.f)
+                return false;
+            const float x = (clip.x() / clip.w() * 0.5f + 0.5f) * base.mWidth;
+            const float y = (clip.y() / clip.w() * 0.5f + 0.5f) * base.mHeight;
+            const float z = mReverseZ ? 1.f - clip.z() / clip.w() : clip.z() / clip.w() * 0.5f + 0.5f;
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            nearest = std::min(nearest, z);
+        }
+
+        // Nothing is known about what was outside of the screen or in front of the near plane
+        if (minX < 0 || minY < 0 || maxX >= base.mWidth || maxY >= base.mHeight || nearest < 0)
+            return false;
+
+        // Pick the level where the box covers at most 2x2 texels
+        const float extent = std::max(maxX - minX, maxY - minY);
+        const std::size_t level = std::min(
+            static_cast<std::size_t>(std::max(0.f, std::ceil(std::log2(std::max(extent, 1.f))))), mLevels.size() - 1);
+        const Level& hiz = mLevels[level];
+        const int x0 = static_cast<int>(minX) >> level;
+        const int y0 = static_cast<int>(minY) >> level;
+        const int x1 = std::min(static_cast<int>(maxX) >> level, hiz.mWidth - 1);
+        const int y1 = std::min(static_cast<int>(maxY) >> level, hiz.mHeight - 1);
+
+        float farthest = 0;
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                farthest = std::max(farthest, hiz.mDepth[y * hiz.mWidth + x]);
+
+        if (nearest <= farthest)
+            return false;
+
+        ++mNumOccluded;
+        return true;
+    }
+
+    void HiZBuffer::resetStats()
+    {
+        mNumTested = 0;
+        mNumOccluded = 0;
+    }
+
+    void OcclusionCullCallback::operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+    {
+        if (mBuffer->isValid() && cv->getCurrentCamera()->getName() == Constants::SceneCamera)
+        {
+            const osg::BoundingSphere& bound = node->getBound();
+            const osg::Vec3f radius(bound.radius(), bound.radius(), bound.radius());
+            if (mBuffer->isOccluded(osg::BoundingBox(bound.center() - radius, bound.center() + radius)))
+                return;
+        }
+        traverse(node, cv);
+    }
+}
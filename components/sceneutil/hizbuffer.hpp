@@ -0,0 +1,84 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_HIZBUFFER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_HIZBUFFER_H
+
+#include <osg/BoundingBox>
+#include <osg/Matrix>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "nodecallback.hpp"
+
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace SceneUtil
+{
+    /// @brief Hierarchical depth buffer of a previous frame used to test whether bounds are hidden behind the geometry
+    /// drawn in that frame.
+    /// @par Each texel of a level holds the farthest depth of the texels it covers in the level below. The test
+    /// reprojects bounds into the frame the depth comes from, so it is exact for static geometry and lags behind by
+    /// the frames between that frame and the current one for moving geometry.
+    class HiZBuffer : public osg::Referenced
+    {
+    public:
+        /// @param depth Window space depths of width * height texels, starting with the bottom row.
+        /// @param viewProjection The view projection matrix the depth was rendered with.
+        /// @param reverseZ The depth is 1 at the near plane and 0 at the far plane.
+        void build(std::span<const float> depth, int width, int height, const osg::Matrix& viewProjection,
+            bool reverseZ);
+
+        void clear();
+
+        bool isValid() const { return !mLevels.empty(); }
+
+        /// @param box World space bounding box.
+        /// @return true if the box is on the screen and behind the depth of all the texels it covers. Boxes crossing
+        /// the near plane or the screen edges are never occluded.
+        bool isOccluded(const osg::BoundingBox& box) const;
+
+        std::size_t getNumLevels() const { return mLevels.size(); }
+
+        std::size_t getNumTested() const { return mNumTested; }
+        std::size_t getNumOccluded() const { return mNumOccluded; }
+        void resetStats();
+
+    private:
+        struct Level
+        {
+            int mWidth;
+            int mHeight;
+            // Farthest depth normalized so that 0 is the near plane and 1 is the far plane
+            std::vector<float> mDepth;
+        };
+
+        std::vector<Level> mLevels;
+        osg::Matrix mViewProjection;
+        bool mReverseZ = false;
+        mutable std::size_t mNumTested = 0;
+        mutable std::size_t mNumOccluded = 0;
+    };
+
+    /// @brief Skips the cull traversal of the subgraph for the scene camera when its bound is occluded.
+    /// @note The bound of the node must be in world space.
+    class OcclusionCullCallback : public NodeCallback<OcclusionCullCallback, osg::Node*, osgUtil::CullVisitor*>
+    {
+    public:
+        explicit OcclusionCullCallback(osg::ref_ptr<const HiZBuffer> buffer)
+            : mBuffer(std::move(buffer))
+        {
+        }
+
+        void operator()(osg::Node* node, osgUtil::CullVisitor* cv);
+
+    private:
+        osg::ref_ptr<const HiZBuffer> mBuffer;
+    };
+}
+
+#endif
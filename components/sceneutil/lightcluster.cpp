@@ -0,0 +1,206 @@
+#include "lightcluster.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <osg/BufferObject>
+#include <osg/Light>
+#include <osg/StateSet>
+#include <osg/TextureBuffer>
+#include <osg/Uniform>
+
+#ifndef GL_R32I
+#define GL_R32I 0x8235
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        int getTile(float ndc, int size)
+        {
+            return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * size)), 0, size - 1);
+        }
+
+        template <class Array>
+        osg::ref_ptr<Array> makeStreamedArray()
+        {
+            osg::ref_ptr<Array> array = new Array;
+            osg::ref_ptr<osg::VertexBufferObject> vbo = new osg::VertexBufferObject;
+            vbo->setUsage(GL_STREAM_DRAW);
+            array->setBufferObject(vbo);
+            return array;
+        }
+
+        osg::ref_ptr<osg::TextureBuffer> makeTextureBuffer(osg::BufferData* data, GLint internalFormat)
+        {
+            osg::ref_ptr<osg::TextureBuffer> texture = new osg::TextureBuffer;
+            texture->setInternalFormat(internalFormat);
+            texture->setBufferData(data);
+            return texture;
+        }
+    }
+
+    void LightClusterGrid::reset(const osg::Matrix& projection, float far)
+    {
+        mProjection = projection;
+        mFar = std::max(far, 2 * sNear);
+        mDepthScale = sSizeZ / std::log(mFar / sNear);
+        for (std::vector<int>& cluster : mClusters)
+            cluster.clear();
+    }
+
+    int LightClusterGrid::getSlice(float depth) const
+    {
+        if (depth <= sNear)
+            return 0;
+        return std::min(static_cast<int>(std::log(depth / sNear) * mDepthScale), sSizeZ);
+    }
+
+    void LightClusterGrid::addLight(int index, const osg::BoundingSphere& viewBound)
+    {
+        const osg::Vec3f& center = viewBound.center();
+        const float radius = viewBound.radius();
+        // The camera looks along -z
+        const float depth = -center.z();
+        if (depth + radius <= 0)
+            return;
+
+        const int minZ = getSlice(depth - radius);
+        if (minZ >= sSizeZ)
+            return;
+        const int maxZ = std::min(getSlice(depth + radius), sSizeZ - 1);
+
+        int minX = 0;
+        int minY = 0;
+        int maxX = sSizeX - 1;
+        int maxY = sSizeY - 1;
+        // Only a bound in front of the camera has all the corners of its box projected to finite points. Lights
+        // outside of the screen still go to the edge clusters to light the vertices outside of the screen.
+        if (depth - radius > 1.f)
+        {
+            osg::Vec2f minNdc(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+            osg::Vec2f maxNdc(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+            for (int i = 0; i < 8; ++i)
+            {
+                const osg::Vec3f corner(center.x() + ((i & 1) ? radius : -radius),
+                    center.y() + ((i & 2) ? radius : -radius), center.z() + ((i & 4) ? radius : -radius));
+                const osg::Vec4f clip = osg::Vec4f(corner, 1.f) * mProjection;
+                const osg::Vec2f ndc(clip.x() / clip.w(), clip.y() / clip.w());
+                minNdc.x() = std::min(minNdc.x(), ndc.x());
+                minNdc.y() = std::min(minNdc.y(), ndc.y());
+                maxNdc.x() = std::max(maxNdc.x(), ndc.x());
+                maxNdc.y() = std::max(maxNdc.y(), ndc.y());
+            }
+            minX = getTile(minNdc.x(), sSizeX);
+            minY = getTile(minNdc.y(), sSizeY);
+            maxX = getTile(maxNdc.x(), sSizeX);
+            maxY = getTile(maxNdc.y(), sSizeY);
+        }
+
+        for (int z = minZ; z <= maxZ; ++z)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                for (int x = minX; x <= maxX; ++x)
+                {
+                    std::vector<int>& cluster = mClusters[getIndex(x, y, z)];
+                    if (cluster.size() < sMaxLightsPerCluster)
+                        cluster.push_back(index);
+                }
+            }
+        }
+    }
+
+    void LightClusterGrid::write(osg::IntArray& out) const
+    {
+        out.clear();
+        out.resize(sNumClusters);
+        for (int i = 0; i < sNumClusters; ++i)
+        {
+            const std::vector<int>& cluster = mClusters[i];
+            out[i] = (static_cast<int>(out.size()) << 8) | static_cast<int>(cluster.size());
+            out.insert(out.end(), cluster.begin(), cluster.end());
+        }
+    }
+
+    LightClusterBuffer::LightClusterBuffer(int textureUnit)
+    {
+        for (Frame& frame : mFrames)
+        {
+            frame.mLightData = makeStreamedArray<osg::Vec4Array>();
+            frame.mClusterData = makeStreamedArray<osg::IntArray>();
+            frame.mLightDataTexture = makeTextureBuffer(frame.mLightData, GL_RGBA32F_ARB);
+            frame.mClusterDataTexture = makeTextureBuffer(frame.mClusterData, GL_R32I);
+            frame.mDepthParams = new osg::Uniform("ClusterDepthParams", osg::Vec2f(LightClusterGrid::sNear, 0.f));
+
+            frame.mStateSet = new osg::StateSet;
+            frame.mStateSet->setTextureAttribute(textureUnit, frame.mLightDataTexture, osg::StateAttribute::ON);
+            frame.mStateSet->setTextureAttribute(textureUnit + 1, frame.mClusterDataTexture, osg::StateAttribute::ON);
+            frame.mStateSet->addUniform(new osg::Uniform("ClusterLightData", textureUnit));
+            frame.mStateSet->addUniform(new osg::Uniform("ClusterData", textureUnit + 1));
+            frame.mStateSet->addUniform(frame.mDepthParams);
+        }
+    }
+
+    LightClusterBuffer::~LightClusterBuffer() = default;
+
+    void LightClusterBuffer::begin(std::size_t frameNum, const osg::Light* sun, const osg::Matrix& viewMatrix)
+    {
+        mCurrent = &mFrames[frameNum % 2];
+        mBounds.clear();
+
+        osg::Vec4Array& data = *mCurrent->mLightData;
+        data.clear();
+        if (sun)
+        {
+            const osg::Vec4f position = sun->getPosition() * viewMatrix;
+            data.emplace_back(position.x(), position.y(), position.z(), 0.f);
+            data.emplace_back(sun->getDiffuse().r(), sun->getDiffuse().g(), sun->getDiffuse().b(), 0.f);
+            data.emplace_back(sun->getAmbient().r(), sun->getAmbient().g(), sun->getAmbient().b(), 0.f);
+            data.push_back(sun->getSpecular());
+            data.emplace_back(1.f, 0.f, 0.f, 0.f);
+        }
+        else
+        {
+            data.emplace_back(0.f, 0.f, 1.f, 0.f);
+            data.resize(sLightDataSize, osg::Vec4f());
+        }
+    }
+
+    void LightClusterBuffer::addLight(const osg::Light& light, float radius, const osg::BoundingSphere& viewBound)
+    {
+        if (mBounds.size() >= sMaxLights - 1)
+            return;
+
+        osg::Vec4Array& data = *mCurrent->mLightData;
+        const osg::Vec4f& diffuse = light.getDiffuse();
+        const osg::Vec4f& ambient = light.getAmbient();
+        data.emplace_back(viewBound.center(), radius);
+        data.emplace_back(diffuse.r(), diffuse.g(), diffuse.b(), 0.f);
+        data.emplace_back(ambient.r(), ambient.g(), ambient.b(), 0.f);
+        data.push_back(light.getSpecular());
+        data.emplace_back(
+            light.getConstantAttenuation(), light.getLinearAttenuation(), light.getQuadraticAttenuation(), 0.f);
+        mBounds.push_back(viewBound);
+    }
+
+    osg::StateSet* LightClusterBuffer::end(const osg::Matrix& projection)
+    {
+        float far = 0;
+        for (const osg::BoundingSphere& bound : mBounds)
+            far = std::max(far, bound.radius() - bound.center().z());
+
+        mGrid.reset(projection, far);
+        for (std::size_t i = 0; i < mBounds.size(); ++i)
+            mGrid.addLight(static_cast<int>(i + 1), mBounds[i]);
+        mGrid.write(*mCurrent->mClusterData);
+
+        mCurrent->mLightData->dirty();
+        mCurrent->mClusterData->dirty();
+        mCurrent->mDepthParams->set(osg::Vec2f(LightClusterGrid::sNear, mGrid.getDepthScale()));
+
+        return mCurrent->mStateSet;
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTER_H
+
+#include <osg/Array>
+#include <osg/BoundingSphere>
+#include <osg/Matrix>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace osg
+{
+    class Light;
+    class StateSet;
+    class TextureBuffer;
+    class Uniform;
+}
+
+namespace SceneUtil
+{
+    /// @brief Bins point lights into a grid of view space frustum cells (clusters).
+    /// @par The clusters are distributed uniformly in screen space and exponentially in depth, starting at sNear and
+    /// ending at the farthest point affected by a light.
+    class LightClusterGrid
+    {
+    public:
+        static constexpr int sSizeX = 16;
+        static constexpr int sSizeY = 8;
+        static constexpr int sSizeZ = 24;
+        static constexpr int sNumClusters = sSizeX * sSizeY * sSizeZ;
+        // The light count is packed into the low 8 bits of the cluster data
+        static constexpr std::size_t sMaxLightsPerCluster = 255;
+        static constexpr float sNear = 16.f;
+
+        /// Remove all lights and set the depth covered by the grid.
+        void reset(const osg::Matrix& projection, float far);
+
+        /// @param viewBound Bound of the light in the view space of the projection given to reset().
+        void addLight(int index, const osg::BoundingSphere& viewBound);
+
+        /// @return Depth slice for the view space depth or sSizeZ if the depth is beyond the grid.
+        int getSlice(float depth) const;
+
+        float getFar() const { return mFar; }
+
+        /// Multiplier turning log(depth / sNear) into the depth slice.
+        float getDepthScale() const { return mDepthScale; }
+
+        const std::vector<int>& getLights(int x, int y, int z) const { return mClusters[getIndex(x, y, z)]; }
+
+        /// Write (offset << 8) | count for every cluster followed by the light indices of all the clusters. The offset
+        /// is the position of the first light index of the cluster in the output.
+        void write(osg::IntArray& out) const;
+
+        static int getIndex(int x, int y, int z) { return (z * sSizeY + y) * sSizeX + x; }
+
+    private:
+        osg::Matrix mProjection;
+        float mFar = sNear;
+        float mDepthScale = 0;
+        std::array<std::vector<int>, sNumClusters> mClusters;
+    };
+
+    /// @brief Double buffered GPU data of the clustered lighting method for a single camera.
+    /// @par Light data is stored in a texture buffer with sLightDataSize RGBA texels per light: view space position and
+    /// radius, diffuse colour, ambient colour, specular colour and attenuation. The sun is the first light. The cluster
+    /// data from LightClusterGrid::write is stored in a second, integer texture buffer.
+    class LightClusterBuffer : public osg::Referenced
+    {
+    public:
+        static constexpr int sLightDataSize = 5;
+        static constexpr int sMaxLights = 1024;
+
+        /// @param textureUnit The first of the two consecutive texture units used for the texture buffers.
+        explicit LightClusterBuffer(int textureUnit);
+
+        ~LightClusterBuffer();
+
+        void begin(std::size_t frameNum, const osg::Light* sun, const osg::Matrix& viewMatrix);
+
+        /// @param viewBound The view space bound of the area lit by the light.
+        void addLight(const osg::Light& light, float radius, const osg::BoundingSphere& viewBound);
+
+        /// Bin the lights added since begin() and upload them.
+        /// @return The StateSet to apply to the lit subgraph.
+        osg::StateSet* end(const osg::Matrix& projection);
+
+    private:
+        struct Frame
+        {
+            osg::ref_ptr<osg::StateSet> mStateSet;
+            osg::ref_ptr<osg::Vec4Array> mLightData;
+            osg::ref_ptr<osg::IntArray> mClusterData;
+            osg::ref_ptr<osg::TextureBuffer> mLightDataTexture;
+            osg::ref_ptr<osg::TextureBuffer> mClusterDataTexture;
+            osg::ref_ptr<osg::Uniform> mDepthParams;
+        };
+
+        std::array<Frame, 2> mFrames;
+        Frame* mCurrent = nullptr;
+        std::vector<osg::BoundingSphere> mBounds;
+        LightClusterGrid mGrid;
+    };
+}
+
+#endif
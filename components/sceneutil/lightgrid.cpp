@@ -0,0 +1,80 @@
+#include "lightgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SceneUtil
+{
+    void LightGrid::clear()
+    {
+        // Keep the allocations of the cells, the lights are mostly in the same cells in the next frame
+        for (auto& [key, lights] : mCells)
+            lights.clear();
+        mLargeLights.clear();
+        mLights.clear();
+    }
+
+    void LightGrid::addLight(int index, const osg::BoundingSphere& worldBound)
+    {
+        mLights.push_back(index);
+
+        const CellRange range = getCellRange(worldBound);
+        if (range.getNumCells() > sMaxCells)
+        {
+            mLargeLights.push_back(index);
+            return;
+        }
+
+        for (int y = range.mMinY; y <= range.mMaxY; ++y)
+            for (int x = range.mMinX; x <= range.mMaxX; ++x)
+                mCells[getKey(x, y)].push_back(index);
+    }
+
+    void LightGrid::getLights(const osg::BoundingSphere& worldBound, std::vector<int>& out) const
+    {
+        out.clear();
+
+        const CellRange range = getCellRange(worldBound);
+        if (range.getNumCells() > sMaxCells)
+        {
+            out = mLights;
+        }
+        else
+        {
+            out = mLargeLights;
+            for (int y = range.mMinY; y <= range.mMaxY; ++y)
+            {
+                for (int x = range.mMinX; x <= range.mMaxX; ++x)
+                {
+                    const auto it = mCells.find(getKey(x, y));
+                    if (it != mCells.end())
+                        out.insert(out.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    LightGrid::CellRange LightGrid::getCellRange(const osg::BoundingSphere& bound)
+    {
+        const osg::Vec3f& center = bound.center();
+        const float radius = bound.radius();
+        // Clamp to keep the cell coordinates representable, such bounds cover too many cells anyway
+        constexpr float limit = sCellSize * (1 << 20);
+        const auto getCell
+            = [&](float v) { return static_cast<int>(std::floor(std::clamp(v, -limit, limit) / sCellSize)); };
+        return CellRange{
+            .mMinX = getCell(center.x() - radius),
+            .mMinY = getCell(center.y() - radius),
+            .mMaxX = getCell(center.x() + radius),
+            .mMaxY = getCell(center.y() + radius),
+        };
+    }
+
+    std::uint64_t LightGrid::getKey(int x, int y)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTGRID_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTGRID_H
+
+#include <osg/BoundingSphere>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Uniform grid over the world space bounds of lights in the horizontal plane, to find the lights that may
+    /// affect a bound without testing every light.
+    class LightGrid
+    {
+    public:
+        static constexpr float sCellSize = 512.f;
+        /// Lights and queries covering more cells than this are handled as if they covered the whole grid.
+        static constexpr int sMaxCells = 64;
+
+        void clear();
+
+        /// @param worldBound Bound of the light in world space.
+        void addLight(int index, const osg::BoundingSphere& worldBound);
+
+        /// Write the indices of the lights which may intersect the bound in ascending order without duplicates.
+        /// @param worldBound Bound in world space.
+        void getLights(const osg::BoundingSphere& worldBound, std::vector<int>& out) const;
+
+        std::size_t getNumLights() const { return mLights.size(); }
+
+    private:
+        struct CellRange
+        {
+            int mMinX;
+            int mMinY;
+            int mMaxX;
+            int mMaxY;
+
+            std::int64_t getNumCells() const
+            {
+                return static_cast<std::int64_t>(mMaxX - mMinX + 1) * static_cast<std::int64_t>(mMaxY - mMinY + 1);
+            }
+        };
+
+        static CellRange getCellRange(const osg::BoundingSphere& bound);
+
+        static std::uint64_t getKey(int x, int y);
+
+        std::unordered_map<std::uint64_t, std::vector<int>> mCells;
+        // Lights which are too large to be put into the cells
+        std::vector<int> mLargeLights;
+        std::vector<int> mLights;
+    };
+}
+
+#endif
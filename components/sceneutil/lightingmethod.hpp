@@ -8,6 +8,7 @@ namespace SceneUtil
         FFP,
         PerObjectUniform,
         SingleUBO,
+        Clustered,
     };
 }
 
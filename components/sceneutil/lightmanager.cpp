@@ -14,6 +14,8 @@
 
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/lightcluster.hpp>
+#include <components/sceneutil/uniformringbuffer.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/shader/shadermanager.hpp>
 
@@ -72,6 +74,7 @@ namespace SceneUtil
             { "legacy", LightingMethod::FFP },
             { "shaders compatibility", LightingMethod::PerObjectUniform },
             { "shaders", LightingMethod::SingleUBO },
+            { "shaders clustered", LightingMethod::Clustered },
         };
     }
 
@@ -287,6 +290,11 @@ namespace SceneUtil
 
                 break;
             }
+            case LightingMethod::Clustered:
+            {
+                // The sun is a part of the per camera light data
+                break;
+            }
         }
     }
 
@@ -617,9 +625,9 @@ namespace SceneUtil
             for (size_t i = 0; i < mUBBs.size(); ++i)
             {
                 auto& buffer = lightManager->getUBOManager()->getLightBuffer(i);
-                mUBBs[i]
-                    = new osg::UniformBufferBinding(static_cast<int>(Resource::SceneManager::UBOBinding::LightBuffer),
-                        buffer->getData(), 0, buffer->getData()->getTotalDataSize());
+                mUBBs[i] = new RingUniformBufferBinding(
+                    static_cast<int>(Resource::SceneManager::UBOBinding::LightBuffer), buffer->getData(), 0,
+                    buffer->getData()->getTotalDataSize());
             }
         }
 
@@ -642,6 +650,11 @@ namespace SceneUtil
                     buffer->setSpecular(0, sun->getSpecular());
                 }
             }
+            else if (node->getLightingMethod() == LightingMethod::Clustered)
+            {
+                if (cv->getTraversalMask() & node->getLightingMask())
+                    stateset->merge(*node->getLightClustersStateSet(cv, cv->getTraversalNumber()));
+            }
             else if (node->getLightingMethod() == LightingMethod::PerObjectUniform)
             {
                 if (auto sun = node->getSunlight())
@@ -665,7 +678,7 @@ namespace SceneUtil
                 node->getPPLightsBuffer()->updateCount(cv->getTraversalNumber());
         }
 
-        std::array<osg::ref_ptr<osg::UniformBufferBinding>, 2> mUBBs;
+        std::array<osg::ref_ptr<RingUniformBufferBinding>, 2> mUBBs;
     };
 
     UBOManager::UBOManager(int lightCount)
@@ -820,10 +833,12 @@ namespace SceneUtil
         osg::GLExtensions* exts = SceneUtil::glExtensionsReady() ? &SceneUtil::getGLExtensions() : nullptr;
         bool supportsUBO = exts && exts->isUniformBufferObjectSupported;
         bool supportsGPU4 = exts && exts->isGpuShader4Supported;
+        bool supportsTBO = exts && exts->isTBOSupported;
 
         mSupported[static_cast<int>(LightingMethod::FFP)] = true;
         mSupported[static_cast<int>(LightingMethod::PerObjectUniform)] = true;
         mSupported[static_cast<int>(LightingMethod::SingleUBO)] = supportsUBO && supportsGPU4;
+        mSupported[static_cast<int>(LightingMethod::Clustered)] = supportsTBO && supportsGPU4;
 
         setUpdateCallback(new LightManagerUpdateCallback);
 
@@ -846,7 +861,20 @@ namespace SceneUtil
             hasLoggedWarnings = true;
         }
 
-        if (!supportsUBO || !supportsGPU4 || settings.mLightingMethod == LightingMethod::PerObjectUniform)
+        if (settings.mLightingMethod == LightingMethod::Clustered && !hasLoggedWarnings)
+        {
+            if (!supportsTBO)
+                Log(Debug::Warning)
+                    << "GL_ARB_texture_buffer_object not supported: switching to shader compatibility lighting mode";
+            if (!supportsGPU4)
+                Log(Debug::Warning)
+                    << "GL_EXT_gpu_shader4 not supported: switching to shader compatibility lighting mode";
+            hasLoggedWarnings = true;
+        }
+
+        if (settings.mLightingMethod == LightingMethod::Clustered && supportsTBO && supportsGPU4)
+            initClustered(settings.mMaxLights);
+        else if (!supportsUBO || !supportsGPU4 || settings.mLightingMethod != LightingMethod::SingleUBO)
             initPerObjectUniform(settings.mMaxLights);
         else
             initSingleUBO(settings.mMaxLights);
@@ -894,6 +922,8 @@ namespace SceneUtil
 
     int LightManager::getMaxLightsInScene() const
     {
+        if (getLightingMethod() == LightingMethod::Clustered)
+            return LightClusterBuffer::sMaxLights;
         static constexpr int max = 16384 / LightBuffer::queryBlockSize(1);
         return max;
     }
@@ -907,9 +937,14 @@ namespace SceneUtil
         defines["lightingMethodFFP"] = getLightingMethod() == LightingMethod::FFP ? "1" : "0";
         defines["lightingMethodPerObjectUniform"] = getLightingMethod() == LightingMethod::PerObjectUniform ? "1" : "0";
         defines["lightingMethodUBO"] = getLightingMethod() == LightingMethod::SingleUBO ? "1" : "0";
+        defines["lightingMethodClustered"] = getLightingMethod() == LightingMethod::Clustered ? "1" : "0";
         defines["useUBO"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
-        // exposes bitwise operators
-        defines["useGPUShader4"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
+        // exposes bitwise operators and texture buffers
+        defines["useGPUShader4"] = std::to_string(
+            getLightingMethod() == LightingMethod::SingleUBO || getLightingMethod() == LightingMethod::Clustered);
+        defines["clusterSizeX"] = std::to_string(LightClusterGrid::sSizeX);
+        defines["clusterSizeY"] = std::to_string(LightClusterGrid::sSizeY);
+        defines["clusterSizeZ"] = std::to_string(LightClusterGrid::sSizeZ);
         defines["getLight"] = getLightingMethod() == LightingMethod::FFP ? "gl_LightSource" : "LightBuffer";
         defines["startLight"] = getLightingMethod() == LightingMethod::SingleUBO ? "0" : "1";
         defines["endLight"] = getLightingMethod() == LightingMethod::FFP ? defines["maxLights"] : "PointLightCount";
@@ -977,6 +1012,12 @@ namespace SceneUtil
         getOrCreateStateSet()->setAttributeAndModes(mUBOManager);
     }
 
+    void LightManager::initClustered(int targetLights)
+    {
+        setLightingMethod(LightingMethod::Clustered);
+        setMaxLights(targetLights);
+    }
+
     void LightManager::setLightingMethod(LightingMethod method)
     {
         mLightingMethod = method;
@@ -991,6 +1032,10 @@ namespace SceneUtil
             case LightingMethod::PerObjectUniform:
                 mStateSetGenerator = std::make_unique<StateSetGeneratorPerObjectUniform>();
                 break;
+            case LightingMethod::Clustered:
+                // Lights are looked up per pixel from the clusters so there are no per object light lists
+                mStateSetGenerator = nullptr;
+                return;
         }
         mStateSetGenerator->mLightManager = this;
     }
@@ -1035,6 +1080,8 @@ namespace SceneUtil
         getLightIndexMap(frameNum).clear();
         mLights.clear();
         mLightsInViewSpace.clear();
+        mLightGridDirty = true;
+        std::erase_if(mLightClusterBuffers, [](const auto& v) { return !v.first.valid(); });
 
         // Do an occasional cleanup for orphaned lights.
         for (int i = 0; i < 2; ++i)
@@ -1131,10 +1178,15 @@ namespace SceneUtil
 
         if (it == mLightsInViewSpace.end())
         {
-            it = mLightsInViewSpace.insert(std::make_pair(camPtr, LightSourceViewBoundCollection())).first;
+            it = mLightsInViewSpace.insert(std::make_pair(camPtr, ViewLights())).first;
+            LightSourceViewBoundCollection& bounds = it->second.mBounds;
+            const bool isSceneCamera = camera->getName() == Constants::SceneCamera;
 
-            for (const auto& transform : mLights)
+            for (std::size_t i = 0; i < mLights.size(); ++i)
             {
+                const LightSourceTransform& transform = mLights[i];
+                if (isSceneCamera && transform.mLightSource->getSceneCulled())
+                    continue;
                 osg::Matrixf worldViewMat = transform.mWorldMatrix * (*viewMatrix);
 
                 float radius = transform.mLightSource->getRadius();
@@ -1159,12 +1211,14 @@ namespace SceneUtil
                 LightSourceViewBound l;
                 l.mLightSource = transform.mLightSource;
                 l.mViewBound = viewBound;
-                it->second.push_back(l);
+                l.mLightIndex = static_cast<int>(i);
+                bounds.push_back(l);
             }
 
             const bool fillPPLights = mPPLightBuffer && it->first->getName() == Constants::SceneCamera;
-            const bool sceneLimitReached = getLightingMethod() == LightingMethod::SingleUBO
-                && it->second.size() > static_cast<size_t>(getMaxLightsInScene() - 1);
+            const bool sceneLimitReached
+                = (getLightingMethod() == LightingMethod::SingleUBO || getLightingMethod() == LightingMethod::Clustered)
+                && bounds.size() > static_cast<size_t>(getMaxLightsInScene() - 1);
 
             if (fillPPLights || sceneLimitReached)
             {
@@ -1173,12 +1227,12 @@ namespace SceneUtil
                         < right.mViewBound.center().length2() - right.mViewBound.radius2();
                 };
 
-                std::sort(it->second.begin(), it->second.end(), sorter);
+                std::sort(bounds.begin(), bounds.end(), sorter);
 
                 if (fillPPLights)
                 {
                     osg::CullingSet& cullingSet = cv->getModelViewCullingStack().front();
-                    for (const auto& bound : it->second)
+                    for (const auto& bound : bounds)
                     {
                         if (bound.mLightSource->getEmpty())
                             continue;
@@ -1197,11 +1251,90 @@ namespace SceneUtil
                 }
 
                 if (sceneLimitReached)
-                    it->second.resize(getMaxLightsInScene() - 1);
+                    bounds.resize(getMaxLightsInScene() - 1);
+            }
+
+            it->second.mBoundIndices.assign(mLights.size(), -1);
+            for (std::size_t i = 0; i < bounds.size(); ++i)
+                it->second.mBoundIndices[bounds[i].mLightIndex] = static_cast<int>(i);
+            it->second.mInverseViewMatrix = osg::Matrix::inverse(*viewMatrix);
+        }
+
+        return it->second.mBounds;
+    }
+
+    void LightManager::getLightsInViewSpace(osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix,
+        size_t frameNum, const osg::BoundingSphere& viewBound, std::vector<const LightSourceViewBound*>& out)
+    {
+        out.clear();
+
+        const std::vector<LightSourceViewBound>& lights = getLightsInViewSpace(cv, viewMatrix, frameNum);
+
+        // Not worth it for a few lights
+        constexpr std::size_t minLightsForGrid = 16;
+        if (lights.size() < minLightsForGrid)
+        {
+            for (const LightSourceViewBound& light : lights)
+                if (light.mViewBound.intersects(viewBound))
+                    out.push_back(&light);
+            return;
+        }
+
+        if (mLightGridDirty)
+        {
+            mLightGrid.clear();
+            for (std::size_t i = 0; i < mLights.size(); ++i)
+            {
+                osg::BoundingSphere worldBound(
+                    osg::Vec3f(), mLights[i].mLightSource->getRadius() * mPointLightRadiusMultiplier);
+                transformBoundingSphere(mLights[i].mWorldMatrix, worldBound);
+                mLightGrid.addLight(static_cast<int>(i), worldBound);
             }
+            mLightGridDirty = false;
         }
 
-        return it->second;
+        const ViewLights& viewLights
+            = mLightsInViewSpace.find(osg::observer_ptr<osg::Camera>(cv->getCurrentCamera()))->second;
+
+        osg::BoundingSphere worldBound = viewBound;
+        transformBoundingSphere(viewLights.mInverseViewMatrix, worldBound);
+        mLightGrid.getLights(worldBound, mLightGridQuery);
+
+        // Replace the light indices by the indices of the intersecting view bounds and keep the order of
+        // getLightsInViewSpace(), the state sets are cached by the light lists
+        std::size_t count = 0;
+        for (int lightIndex : mLightGridQuery)
+        {
+            const int boundIndex = viewLights.mBoundIndices[lightIndex];
+            if (boundIndex != -1 && lights[boundIndex].mViewBound.intersects(viewBound))
+                mLightGridQuery[count++] = boundIndex;
+        }
+        mLightGridQuery.resize(count);
+        std::sort(mLightGridQuery.begin(), mLightGridQuery.end());
+
+        for (int boundIndex : mLightGridQuery)
+            out.push_back(&lights[boundIndex]);
+    }
+
+    osg::StateSet* LightManager::getLightClustersStateSet(osgUtil::CullVisitor* cv, size_t frameNum)
+    {
+        // Don't use Camera::getViewMatrix, that one might be relative to another camera!
+        const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
+        const std::vector<LightSourceViewBound>& lights = getLightsInViewSpace(cv, viewMatrix, frameNum);
+
+        osg::ref_ptr<LightClusterBuffer>& buffer = mLightClusterBuffers[cv->getCurrentCamera()];
+        if (!buffer)
+            buffer = new LightClusterBuffer(mLightClustersTextureUnit);
+
+        buffer->begin(frameNum, mSun, *viewMatrix);
+        for (const LightSourceViewBound& light : lights)
+        {
+            const float radius = light.mLightSource->getRadius();
+            // Unlike the light list bound, cover the whole distance where the shaders don't cut off the light
+            buffer->addLight(*light.mLightSource->getLight(frameNum), radius,
+                osg::BoundingSphere(light.mViewBound.center(), radius * 2));
+        }
+        return buffer->end(*cv->getProjectionMatrix());
     }
 
     void LightManager::updateGPUPointLight(
@@ -1275,8 +1408,8 @@ namespace SceneUtil
         if (!(cv->getTraversalMask() & mLightManager->getLightingMask()))
             return false;
 
-        // Possible optimizations:
-        // - organize lights in a quad tree
+        if (mLightManager->getLightingMethod() == LightingMethod::Clustered)
+            return false;
 
         // Don't use Camera::getViewMatrix, that one might be relative to another camera!
         const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
@@ -1301,18 +1434,11 @@ namespace SceneUtil
 
             transformBoundingSphere(*cv->getModelViewMatrix(), nodeBound);
 
-            const std::vector<LightManager::LightSourceViewBound>& lights
-                = mLightManager->getLightsInViewSpace(cv, viewMatrix, mLastFrameNumber);
-
-            mLightList.clear();
-            for (const LightManager::LightSourceViewBound& light : lights)
-            {
-                if (mIgnoredLightSources.contains(light.mLightSource))
-                    continue;
-
-                if (light.mViewBound.intersects(nodeBound))
-                    mLightList.push_back(&light);
-            }
+            mLightManager->getLightsInViewSpace(cv, viewMatrix, mLastFrameNumber, nodeBound, mLightList);
+            if (!mIgnoredLightSources.empty())
+                std::erase_if(mLightList, [&](const LightManager::LightSourceViewBound* light) {
+                    return mIgnoredLightSources.contains(light->mLightSource);
+                });
 
             const size_t maxLights = mLightManager->getMaxLights() - mLightManager->getStartLight();
 
@@ -13,11 +13,13 @@
 
 #include <components/sceneutil/nodecallback.hpp>
 
+#include "lightgrid.hpp"
 #include "lightingmethod.hpp"
 
 namespace SceneUtil
 {
     class LightBuffer;
+    class LightClusterBuffer;
     struct StateSetGenerator;
 
     class PPLightBuffer
@@ -110,6 +112,8 @@ namespace SceneUtil
 
         bool mEmpty = false;
 
+        bool mSceneCulled = false;
+
     public:
         META_Node(SceneUtil, LightSource)
 
@@ -130,6 +134,11 @@ namespace SceneUtil
 
         bool getEmpty() const { return mEmpty; }
 
+        /// Do not light the view of the scene camera, e.g. when the light only reaches geometry known to be hidden.
+        void setSceneCulled(bool culled) { mSceneCulled = culled; }
+
+        bool getSceneCulled() const { return mSceneCulled; }
+
         /// Get the osg::Light safe for modification in the given frame.
         /// @par May be used externally to animate the light's color/attenuation properties,
         /// and is used internally to synchronize the light's position with the position of the LightSource.
@@ -208,10 +217,12 @@ namespace SceneUtil
         {
             LightSource* mLightSource;
             osg::BoundingSphere mViewBound;
+            // Index of the light in the lights collected this frame
+            int mLightIndex;
         };
 
         using LightList = std::vector<const LightSourceViewBound*>;
-        using SupportedMethods = std::array<bool, 3>;
+        using SupportedMethods = std::array<bool, 4>;
 
         META_Node(SceneUtil, LightManager)
 
@@ -240,9 +251,22 @@ namespace SceneUtil
         const std::vector<LightSourceViewBound>& getLightsInViewSpace(
             osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum);
 
+        /// Find the lights of getLightsInViewSpace() which may intersect the bound, in the same order. Uses a grid
+        /// over the world space bounds of the lights which is shared by all cameras instead of testing every light.
+        /// @param viewBound Bound in the view space of \a viewMatrix.
+        void getLightsInViewSpace(osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum,
+            const osg::BoundingSphere& viewBound, std::vector<const LightSourceViewBound*>& out);
+
         osg::ref_ptr<osg::StateSet> getLightListStateSet(
             const LightList& lightList, size_t frameNum, const osg::RefMatrix* viewMatrix);
 
+        /// Bin the lights visible from the current camera into clusters for the clustered lighting method.
+        /// @return The StateSet exposing the clusters to the shaders
+        osg::StateSet* getLightClustersStateSet(osgUtil::CullVisitor* cv, size_t frameNum);
+
+        /// Set the first of two consecutive texture units used by the clustered lighting method.
+        void setLightClustersTextureUnit(int unit) { mLightClustersTextureUnit = unit; }
+
         void setSunlight(osg::ref_ptr<osg::Light> sun);
         osg::ref_ptr<osg::Light> getSunlight();
 
@@ -283,6 +307,7 @@ namespace SceneUtil
         void initFFP(int targetLights);
         void initPerObjectUniform(int targetLights);
         void initSingleUBO(int targetLights);
+        void initClustered(int targetLights);
 
         void updateSettings(float lightBoundsMultiplier, float maximumLightDistance, float lightFadeStart);
 
@@ -295,7 +320,21 @@ namespace SceneUtil
         std::vector<LightSourceTransform> mLights;
 
         using LightSourceViewBoundCollection = std::vector<LightSourceViewBound>;
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection> mLightsInViewSpace;
+        struct ViewLights
+        {
+            LightSourceViewBoundCollection mBounds;
+            // Index in mBounds per index in mLights, or -1 when the light was faded out or dropped
+            std::vector<int> mBoundIndices;
+            osg::Matrixf mInverseViewMatrix;
+        };
+        std::map<osg::observer_ptr<osg::Camera>, ViewLights> mLightsInViewSpace;
+
+        LightGrid mLightGrid;
+        bool mLightGridDirty = true;
+        std::vector<int> mLightGridQuery;
+
+        std::map<osg::observer_ptr<osg::Camera>, osg::ref_ptr<LightClusterBuffer>> mLightClusterBuffers;
+        int mLightClustersTextureUnit = -1;
 
         using LightIdList = std::vector<int>;
         struct HashLightIdList
@@ -2,6 +2,7 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
@@ -18,6 +19,7 @@ namespace SceneUtil
     MorphGeometry::MorphGeometry(const MorphGeometry& copy, const osg::CopyOp& copyop)
         : osg::Drawable(copy, copyop)
         , mMorphTargets(copy.mMorphTargets)
+        , mMorphOffsets(copy.mMorphOffsets)
         , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
@@ -28,7 +30,10 @@ namespace SceneUtil
     void MorphGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
             mGeometry[i] = nullptr;
+            mMorphWeights[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeom;
 
@@ -49,6 +54,26 @@ namespace SceneUtil
             to.setUseVertexBufferObjects(true);
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
 
+            if (mMorphOffsets != nullptr)
+            {
+                // The base morph target is the only vertex array, it's shared by the instances and never modified.
+                osg::Vec3Array* base = mMorphTargets[0].getOffsets();
+                if (base->getVertexBufferObject() == nullptr)
+                    base->setVertexBufferObject(new osg::VertexBufferObject);
+                to.setVertexArray(base);
+
+                mMorphWeights[i] = new osg::Uniform(
+                    osg::Uniform::FLOAT, "morphWeights", static_cast<int>(mMorphTargets.size() - 1));
+                osg::ref_ptr<osg::StateSet> stateSet = from.getStateSet()
+                    ? new osg::StateSet(*from.getStateSet(), osg::CopyOp::SHALLOW_COPY)
+                    : new osg::StateSet;
+                stateSet->addUniform(mMorphWeights[i]);
+                stateSet->addUniform(new osg::Uniform("morphTargets", static_cast<int>(mMorphTargets.size() - 1)));
+                stateSet->addUniform(new osg::Uniform("morphVertices", static_cast<int>(base->size())));
+                to.setStateSet(stateSet);
+                continue;
+            }
+
             // vertices are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -64,6 +89,43 @@ namespace SceneUtil
         }
     }
 
+    bool MorphGeometry::supportsGpuMorphing() const
+    {
+        if (mSourceGeometry == nullptr || mMorphTargets.size() < 2 || mMorphTargets.size() > sMaxGpuMorphTargets + 1)
+            return false;
+        const osg::Vec3Array* base = mMorphTargets[0].getOffsets();
+        return std::all_of(mMorphTargets.begin(), mMorphTargets.end(),
+            [&](const MorphTarget& target) { return target.getOffsets()->size() == base->size(); });
+    }
+
+    void MorphGeometry::setGpuMorphing(bool enabled)
+    {
+        enabled = enabled && supportsGpuMorphing();
+        if (enabled == getGpuMorphing())
+            return;
+
+        mMorphOffsets = nullptr;
+        if (enabled)
+        {
+            // Texel of vertex v in target t (starting from the first non-base one) is at t * vertices + v
+            const std::size_t vertices = mMorphTargets[0].getOffsets()->size();
+            osg::ref_ptr<osg::Vec4Array> offsets = new osg::Vec4Array;
+            offsets->reserve((mMorphTargets.size() - 1) * vertices);
+            for (std::size_t i = 1; i < mMorphTargets.size(); ++i)
+                for (const osg::Vec3f& offset : *mMorphTargets[i].getOffsets())
+                    offsets->push_back(osg::Vec4f(offset, 0.f));
+            offsets->setBufferObject(new osg::VertexBufferObject);
+
+            mMorphOffsets = new osg::TextureBuffer;
+            mMorphOffsets->setInternalFormat(GL_RGBA32F_ARB);
+            mMorphOffsets->setBufferData(offsets);
+        }
+
+        mLastFrameNumber = 0;
+        mDirty = true;
+        setSourceGeometry(mSourceGeometry);
+    }
+
     void MorphGeometry::addMorphTarget(osg::Vec3Array* offsets, float weight)
     {
         mMorphTargets.push_back(MorphTarget(offsets, weight));
@@ -111,7 +173,20 @@ namespace SceneUtil
 
     void MorphGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        if (!getGpuMorphing())
+        {
+            getGeometry(mLastFrameNumber)->accept(func);
+            return;
+        }
+
+        // The internal geometry is morphed by the vertex shader, do the same on the CPU for the intersections
+        osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array(mMorphTargets[0].getOffsets()->size());
+        morph(*positions);
+        if (positions->empty())
+            return;
+        func.setVertexArray(positions->size(), &positions->front());
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : mSourceGeometry->getPrimitiveSetList())
+            primitiveSet->accept(func);
     }
 
     osg::BoundingBox MorphGeometry::computeBoundingBox() const
@@ -185,11 +260,32 @@ namespace SceneUtil
         mLastFrameNumber = nv->getTraversalNumber();
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
+        if (getGpuMorphing())
+        {
+            osg::Uniform& weights = *mMorphWeights[mLastFrameNumber % 2];
+            for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
+                weights.setElement(i - 1, mMorphTargets[i].getWeight());
+        }
+        else
+        {
+            osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+            morph(*positionDst);
+            positionDst->dirty();
+
+            geom.osg::Drawable::dirtyGLObjects();
+        }
+
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
+
+    void MorphGeometry::morph(osg::Vec3Array& positionDst) const
+    {
         const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        assert(positionSrc->size() == positionDst->size());
+        assert(positionSrc->size() == positionDst.size());
         for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] = (*positionSrc)[vertex];
+            positionDst[vertex] = (*positionSrc)[vertex];
 
         for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
         {
@@ -198,16 +294,8 @@ namespace SceneUtil
                 continue;
             const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
             for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-                (*positionDst)[vertex] += (*offsets)[vertex] * weight;
+                positionDst[vertex] += (*offsets)[vertex] * weight;
         }
-
-        positionDst->dirty();
-
-        geom.osg::Drawable::dirtyGLObjects();
-
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
     }
 
     osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
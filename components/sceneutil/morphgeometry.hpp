@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_MORPHGEOMETRY_H
 
 #include <osg/Geometry>
+#include <osg/TextureBuffer>
 
 namespace SceneUtil
 {
@@ -10,6 +11,9 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note With GPU morphing enabled the offsets of the morph targets are stored in a buffer texture and the internal
+    /// Geometry only gets the "morphWeights" uniform updated, the vertex shader has to be built with the "morphing"
+    /// define.
     class MorphGeometry : public osg::Drawable
     {
     public:
@@ -67,6 +71,21 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Size of the morphWeights uniform array in morphing.glsl.
+        static constexpr std::size_t sMaxGpuMorphTargets = 64;
+
+        /// @return If the morph targets fit the morphWeights uniform and match the vertex count.
+        bool supportsGpuMorphing() const;
+
+        /// Apply the morph targets in the vertex shader. Has to be called after the source geometry and morph targets
+        /// are set, rebuilds the internal geometries.
+        void setGpuMorphing(bool enabled);
+
+        bool getGpuMorphing() const { return mMorphOffsets != nullptr; }
+
+        /// Offsets of all morph targets except the base one, has to be bound to the "morphOffsets" sampler.
+        osg::TextureBuffer* getMorphOffsets() const { return mMorphOffsets; }
+
         void accept(osg::NodeVisitor& nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -75,6 +94,7 @@ namespace SceneUtil
 
     private:
         void cull(osg::NodeVisitor* nv);
+        void morph(osg::Vec3Array& positionDst) const;
 
         MorphTargetList mMorphTargets;
 
@@ -83,6 +103,9 @@ namespace SceneUtil
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
+        osg::ref_ptr<osg::TextureBuffer> mMorphOffsets;
+        osg::ref_ptr<osg::Uniform> mMorphWeights[2];
+
         unsigned int mLastFrameNumber;
         bool mDirty; // Have any morph targets changed?
 
@@ -25,7 +25,12 @@
 #include <osg/io_utils>
 #include <osg/Depth>
 #include <osg/ClipControl>
+#include <osg/FrameBufferObject>
+#include <osg/GLExtensions>
 
+#include <osgUtil/StateGraph>
+
+#include <algorithm>
 #include <sstream>
 #include <deque>
 #include <vector>
@@ -40,6 +45,13 @@ using namespace SceneUtil;
 
 #define dbl_max std::numeric_limits<double>::max()
 
+// Movement of the view and the light before the cached shadows of the static casters are rendered again
+constexpr double staticCasterMaxDistance = 32.0;
+constexpr double staticCasterMinViewCosine = 0.99985; // about 1 degree
+constexpr double staticCasterMinLightCosine = 0.99999; // about 0.25 degree
+// Catches changes of the static casters nobody tells about, e.g. paged objects finishing to load
+constexpr unsigned int staticCasterMaxAge = 120;
+
 //////////////////////////////////////////////////////////////////
 // fragment shader
 //
@@ -248,12 +260,25 @@ class VDSMCameraCullCallback : public osg::NodeCallback
         osg::RefMatrix* getProjectionMatrix() { return _projectionMatrix.get(); }
         osgUtil::RenderStage* getRenderStage() { return _renderStage.get(); }
 
+        /** Cull the scene within cullPolytope, which has to contain the polytopes of the other shadow maps of the light,
+         *  and record the casters into sharedCasters. Only the casters within the own polytope are drawn. */
+        void recordCasters(MWShadowTechnique::SharedCasters* sharedCasters, const osg::Polytope& cullPolytope);
+
+        /** Draw the casters recorded by another shadow map of the light instead of traversing the scene. */
+        void reuseCasters(MWShadowTechnique::SharedCasters* sharedCasters);
+
     protected:
 
+        void record(osgUtil::CullVisitor* cv, osgUtil::StateGraph* entry);
+        void replay(osgUtil::CullVisitor* cv);
+
         MWShadowTechnique*                      _vdsm;
         osg::ref_ptr<osg::RefMatrix>            _projectionMatrix;
         osg::ref_ptr<osgUtil::RenderStage>      _renderStage;
         osg::Polytope                           _polytope;
+        MWShadowTechnique::SharedCasters*       _sharedCasters = nullptr;
+        bool                                    _recordCasters = false;
+        osg::Polytope                           _cullPolytope;
 };
 
 VDSMCameraCullCallback::VDSMCameraCullCallback(MWShadowTechnique* vdsm, osg::Polytope& polytope):
@@ -262,38 +287,67 @@ VDSMCameraCullCallback::VDSMCameraCullCallback(MWShadowTechnique* vdsm, osg::Pol
 {
 }
 
+void VDSMCameraCullCallback::recordCasters(MWShadowTechnique::SharedCasters* sharedCasters, const osg::Polytope& cullPolytope)
+{
+    _sharedCasters = sharedCasters;
+    _recordCasters = true;
+    _cullPolytope = cullPolytope;
+}
+
+void VDSMCameraCullCallback::reuseCasters(MWShadowTechnique::SharedCasters* sharedCasters)
+{
+    _sharedCasters = sharedCasters;
+    _recordCasters = false;
+}
+
 void VDSMCameraCullCallback::operator()(osg::Node* node, osg::NodeVisitor* nv)
 {
     osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(nv);
     osg::Camera* camera = node->asCamera();
     OSG_INFO<<"VDSMCameraCullCallback::operator()(osg::Node* "<<camera<<", osg::NodeVisitor* "<<cv<<")"<<std::endl;
 
-#if 1
-    if (!_polytope.empty())
+    if (_sharedCasters && !_recordCasters)
+    {
+        replay(cv);
+    }
+    else
     {
-        OSG_INFO<<"Pushing custom Polytope"<<std::endl;
+        osg::Polytope& polytope = _sharedCasters ? _cullPolytope : _polytope;
+#if 1
+        if (!polytope.empty())
+        {
+            OSG_INFO<<"Pushing custom Polytope"<<std::endl;
 
-        osg::CullingSet& cs = cv->getProjectionCullingStack().back();
+            osg::CullingSet& cs = cv->getProjectionCullingStack().back();
 
-        cs.setFrustum(_polytope);
+            cs.setFrustum(polytope);
 
-        cv->pushCullingSet();
-    }
+            cv->pushCullingSet();
+        }
 #endif
-    // bin has to go inside camera cull or the rendertexture stage will override it
-    cv->pushStateSet(_vdsm->getOrCreateShadowsBinStateSet());
-    if (_vdsm->getShadowedScene())
-    {
-        _vdsm->getShadowedScene()->osg::Group::traverse(*nv);
-    }
-    cv->popStateSet();
+        osgUtil::StateGraph* entry = cv->getCurrentStateGraph();
+        // bin has to go inside camera cull or the rendertexture stage will override it
+        cv->pushStateSet(_vdsm->getOrCreateShadowsBinStateSet());
+        if (_vdsm->getShadowedScene())
+        {
+            _vdsm->getShadowedScene()->osg::Group::traverse(*nv);
+        }
+        cv->popStateSet();
 #if 1
-    if (!_polytope.empty())
-    {
-        OSG_INFO<<"Popping custom Polytope"<<std::endl;
-        cv->popCullingSet();
-    }
+        if (!polytope.empty())
+        {
+            OSG_INFO<<"Popping custom Polytope"<<std::endl;
+            cv->popCullingSet();
+        }
 #endif
+        if (_sharedCasters)
+        {
+            // the recorded casters replace the render list so that only the ones within this shadow map are drawn
+            record(cv, entry);
+            if (_sharedCasters->_valid)
+                replay(cv);
+        }
+    }
 
     _renderStage = cv->getCurrentRenderBin()->getStage();
 
@@ -346,6 +400,129 @@ void VDSMCameraCullCallback::operator()(osg::Node* node, osg::NodeVisitor* nv)
     _projectionMatrix = cv->getProjectionMatrix();
 }
 
+void VDSMCameraCullCallback::record(osgUtil::CullVisitor* cv, osgUtil::StateGraph* entry)
+{
+    _sharedCasters->clear();
+
+    std::vector<osgUtil::RenderBin*> bins{ cv->getCurrentRenderBin()->getStage() };
+    for (std::size_t i = 0; i < bins.size(); ++i)
+    {
+        for (const auto& [binNum, bin] : bins[i]->getRenderBinList())
+            bins.push_back(bin.get());
+
+        for (osgUtil::StateGraph* graph : bins[i]->getStateGraphList())
+        {
+            MWShadowTechnique::SharedCasters::StateGroup group;
+            for (osgUtil::StateGraph* sg = graph; sg != entry; sg = sg->_parent)
+            {
+                // the state was not pushed within this camera, the render list is kept as it is
+                if (!sg)
+                {
+                    _sharedCasters->clear();
+                    return;
+                }
+                group._stateSets.push_back(sg->getStateSet());
+            }
+            std::reverse(group._stateSets.begin(), group._stateSets.end());
+
+            group._casters.reserve(graph->_leaves.size());
+            for (const auto& leaf : graph->_leaves)
+            {
+                MWShadowTechnique::SharedCasters::Caster caster;
+                caster._drawable = leaf->_drawable;
+                caster._modelView = leaf->_modelview;
+                caster._depth = leaf->_depth;
+                const osg::BoundingBox& bb = caster._drawable->getBoundingBox();
+                if (bb.valid() && caster._modelView)
+                {
+                    for (unsigned int c = 0; c < 8; ++c)
+                        caster._bound.expandBy(bb.corner(c) * *caster._modelView);
+                }
+                group._casters.push_back(std::move(caster));
+            }
+            _sharedCasters->_groups.push_back(std::move(group));
+        }
+    }
+
+    for (osgUtil::RenderBin* bin : bins)
+    {
+        for (osgUtil::StateGraph* graph : bin->getStateGraphList())
+            graph->_leaves.clear();
+        bin->getStateGraphList().clear();
+    }
+    _sharedCasters->_valid = true;
+}
+
+void VDSMCameraCullCallback::replay(osgUtil::CullVisitor* cv)
+{
+    const bool computeNearFar = cv->getComputeNearFarMode() != osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR;
+    for (const MWShadowTechnique::SharedCasters::StateGroup& group : _sharedCasters->_groups)
+    {
+        bool statePushed = false;
+        for (const MWShadowTechnique::SharedCasters::Caster& caster : group._casters)
+        {
+            if (caster._bound.valid() && !_polytope.empty() && !_polytope.contains(caster._bound))
+                continue;
+            if (computeNearFar && !cv->updateCalculatedNearFar(*caster._modelView, *caster._drawable, false))
+                continue;
+
+            if (!statePushed)
+            {
+                for (const osg::StateSet* stateSet : group._stateSets)
+                    if (stateSet)
+                        cv->pushStateSet(stateSet);
+                statePushed = true;
+            }
+            cv->addDrawableAndDepth(caster._drawable.get(), caster._modelView.get(), caster._depth);
+        }
+
+        if (statePushed)
+        {
+            for (const osg::StateSet* stateSet : group._stateSets)
+                if (stateSet)
+                    cv->popStateSet();
+        }
+    }
+}
+
+// Copies the shadow map of the static casters before the dynamic casters are drawn on top of it
+class CopyStaticShadowMapCallback : public osg::Camera::DrawCallback
+{
+    public:
+
+        CopyStaticShadowMapCallback(osg::Texture2D* source, osg::Texture2D* target):
+            _readFbo(new osg::FrameBufferObject),
+            _drawFbo(new osg::FrameBufferObject),
+            _width(source->getTextureWidth()),
+            _height(source->getTextureHeight())
+        {
+            _readFbo->setAttachment(osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER, osg::FrameBufferAttachment(source));
+            _drawFbo->setAttachment(osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER, osg::FrameBufferAttachment(target));
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override
+        {
+            osg::State& state = *renderInfo.getState();
+            osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+
+            _readFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            _drawFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+
+            // The blit is clipped by the scissor test
+            glDisable(GL_SCISSOR_TEST);
+            state.haveAppliedMode(GL_SCISSOR_TEST);
+
+            ext->glBlitFramebuffer(0, 0, _width, _height, 0, 0, _width, _height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        }
+
+    protected:
+
+        osg::ref_ptr<osg::FrameBufferObject>    _readFbo;
+        osg::ref_ptr<osg::FrameBufferObject>    _drawFbo;
+        int                                     _width;
+        int                                     _height;
+};
+
 } // namespace
 
 MWShadowTechnique::ComputeLightSpaceBounds::ComputeLightSpaceBounds() :
@@ -588,6 +765,10 @@ MWShadowTechnique::ShadowData::ShadowData(MWShadowTechnique::ViewDependentData*
     // set viewport
     _camera->setViewport(0,0,textureSize.x(),textureSize.y());
 
+    // the pre draw callback is used to copy the cached static shadow map
+    _camera->setInitialDrawCallback(vdd->getViewDependentShadowMap()->_shadowCameraInitialDrawCallback.get());
+    _camera->setFinalDrawCallback(vdd->getViewDependentShadowMap()->_shadowCameraFinalDrawCallback.get());
+
 
     if (debug)
     {
@@ -623,6 +804,29 @@ void MWShadowTechnique::ShadowData::releaseGLObjects(osg::State* state) const
     OSG_INFO<<"MWShadowTechnique::ShadowData::releaseGLObjects"<<std::endl;
     _texture->releaseGLObjects(state);
     _camera->releaseGLObjects(state);
+    if (_staticCamera)
+    {
+        _staticTexture->releaseGLObjects(state);
+        _staticCamera->releaseGLObjects(state);
+    }
+}
+
+void MWShadowTechnique::ShadowData::initStaticCasterCache()
+{
+    if (_staticCamera)
+        return;
+
+    _staticTexture = new osg::Texture2D(*_texture, osg::CopyOp::SHALLOW_COPY);
+
+    _staticCamera = new osg::Camera(*_camera, osg::CopyOp::SHALLOW_COPY);
+    _staticCamera->setName("StaticShadowCamera");
+    _staticCamera->setViewport(0, 0, _texture->getTextureWidth(), _texture->getTextureHeight());
+    _staticCamera->detach(osg::Camera::DEPTH_BUFFER);
+    _staticCamera->attach(osg::Camera::DEPTH_BUFFER, _staticTexture.get());
+    // render before the camera copying it
+    _staticCamera->setRenderOrder(osg::Camera::PRE_RENDER, -1);
+
+    _copyStaticTextureCallback = new CopyStaticShadowMapCallback(_staticTexture.get(), _texture.get());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -914,17 +1118,34 @@ void SceneUtil::MWShadowTechnique::disableFrontFaceCulling()
     }
 }
 
+void SceneUtil::MWShadowTechnique::enableStaticCasterCaching(unsigned int staticCasterMask, unsigned int dynamicCasterMask)
+{
+    _staticCasterCaching = true;
+    _staticCasterMask = staticCasterMask;
+    _dynamicCasterMask = dynamicCasterMask;
+    dirtyStaticCasterCache();
+}
+
+void SceneUtil::MWShadowTechnique::disableStaticCasterCaching()
+{
+    _staticCasterCaching = false;
+}
+
 void SceneUtil::MWShadowTechnique::setupCastingShader(Shader::ShaderManager & shaderManager)
 {
     // This can't be part of the constructor as OSG mandates that there be a trivial constructor available
 
-    osg::ref_ptr<osg::Shader> castingVertexShader = shaderManager.getShader("shadowcasting.vert");
+    // Skinning and instancing are selected by uniforms of the drawables
+    osg::ref_ptr<osg::Shader> castingVertexShader
+        = shaderManager.getShader("shadowcasting.vert", { { "skinning", "0" }, { "instancing", "0" } });
     std::string useGPUShader4 = SceneUtil::getGLExtensions().isGpuShader4Supported ? "1" : "0";
     for (int alphaFunc = GL_NEVER; alphaFunc <= GL_ALWAYS; ++alphaFunc)
     {
         auto& program = _castingPrograms[alphaFunc - GL_NEVER];
         program = new osg::Program();
         program->addShader(castingVertexShader);
+        program->addBindAttribLocation("customAttribute6", 6);
+        program->addBindAttribLocation("customAttribute7", 7);
         program->addShader(shaderManager.getShader("shadowcasting.frag", { {"alphaFunc", std::to_string(alphaFunc)},
                                                                                     {"alphaToCoverage", "0"},
                                                                                     {"adjustCoverage", "1"},
@@ -1188,6 +1409,32 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
 
     unsigned int numShadowMapsPerLight = settings->getNumShadowMapsPerLight();
 
+    const bool cacheStaticCasters = _staticCasterCaching && !settings->getDebugDraw();
+    const bool perspectiveShadowMaps = !orthographicViewFrustum && settings->getShadowMapProjectionHint()==ShadowSettings::PERSPECTIVE_SHADOW_MAP;
+
+    auto setValidRegionMatrix = [&] (unsigned int sm_i, const osg::Matrix& validRegionMatrix)
+    {
+        std::string validRegionUniformName = "validRegionMatrix" + std::to_string(sm_i);
+        osg::ref_ptr<osg::Uniform> validRegionUniform;
+
+        for (const auto & uniform : _uniforms[cv.getTraversalNumber() % 2])
+        {
+            if (uniform->getName() == validRegionUniformName)
+            {
+                validRegionUniform = uniform;
+                break;
+            }
+        }
+
+        if (!validRegionUniform)
+        {
+            validRegionUniform = new osg::Uniform(osg::Uniform::FLOAT_MAT4, validRegionUniformName);
+            _uniforms[cv.getTraversalNumber() % 2].push_back(validRegionUniform);
+        }
+
+        validRegionUniform->set(validRegionMatrix);
+    };
+
     LightDataList& pll = vdd->getLightDataList();
     for(LightDataList::iterator itr = pll.begin();
         itr != pll.end();
@@ -1331,6 +1578,33 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
         }
 #endif
 
+        // all the shadow maps of the light use the static casters rendered in the same frame to not leave gaps between them
+        bool refreshStaticCasters = false;
+        if (cacheStaticCasters)
+        {
+            refreshStaticCasters = previous_sdl.size() < numShadowMapsPerLight || needsStaticCasterRefresh(*vdd, frustum, pl, cv.getTraversalNumber());
+            ShadowDataList::const_iterator sd_itr = previous_sdl.begin();
+            for (unsigned int sm_i=0; sm_i<numShadowMapsPerLight && sd_itr!=previous_sdl.end(); ++sm_i, ++sd_itr)
+                refreshStaticCasters = refreshStaticCasters || !(*sd_itr)->_staticValid;
+
+            if (refreshStaticCasters)
+            {
+                vdd->_staticCasterCacheValid = true;
+                vdd->_staticCasterEye = frustum.eye;
+                vdd->_staticCasterViewDirection = frustum.frustumCenterLine;
+                vdd->_staticCasterLightDirection = pl.lightDir;
+                vdd->_staticCasterFrameNumber = cv.getTraversalNumber();
+                vdd->_staticCasterRevision = _staticCasterRevision;
+                vdd->_staticCasterCastsMask = _shadowedScene->getCastsShadowTraversalMask();
+            }
+        }
+
+        // the first shadow map culls the casters of all the shadow maps of the light and the others reuse them
+        const bool shareCasters = _sharedCasterCulling && numShadowMapsPerLight > 1 && !cacheStaticCasters
+            && !polytope.empty();
+        osg::Polytope sharedCasterPolytope;
+        vdd->_sharedCasters.clear();
+
         // 4. For each light/shadow map
         for (unsigned int sm_i=0; sm_i<numShadowMapsPerLight; ++sm_i)
         {
@@ -1366,6 +1640,10 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             osg::Polytope local_polytope(polytope);
             local_polytope.transformProvidingInverse(invertModelView);
 
+            // all the shadow maps of the light share the view matrix, so the casters culled in its eye coords are valid for each of them
+            if (shareCasters && sm_i == 0)
+                sharedCasterPolytope = local_polytope;
+
             double cascaseNear = reducedNear;
             double cascadeFar = reducedFar;
             if (numShadowMapsPerLight>1)
@@ -1486,52 +1764,88 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             else
                 cropShadowCameraToMainFrustum(frustum, camera, reducedNear, reducedFar, extraPlanes);
 
-            osg::ref_ptr<VDSMCameraCullCallback> vdsmCallback = new VDSMCameraCullCallback(this, local_polytope);
-            camera->setCullCallback(vdsmCallback.get());
-
-            // 4.3 traverse RTT camera
-            //
-
-            cv.pushStateSet(_shadowCastingStateSet.get());
-
-            cullShadowCastingScene(&cv, camera.get());
-
-            cv.popStateSet();
+            // With static caster caching the static casters are only rendered by their own camera when the cache is refreshed.
+            // The shadow camera then uses its matrices to draw the other casters on top of a copy of its shadow map.
+            osg::Camera* casterCamera = camera.get();
+            unsigned int casterMask = ~0u;
+            if (cacheStaticCasters)
+            {
+                sd->initStaticCasterCache();
+                if (refreshStaticCasters)
+                {
+                    casterCamera = sd->_staticCamera.get();
+                    casterCamera->setProjectionMatrix(camera->getProjectionMatrix());
+                    casterCamera->setViewMatrix(camera->getViewMatrix());
+                    casterMask = _staticCasterMask;
+                }
+                else
+                    casterCamera = nullptr;
+            }
+            else if (camera->getPreDrawCallback())
+            {
+                camera->setClearMask(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+                camera->setPreDrawCallback(nullptr);
+                sd->_staticValid = false;
+            }
 
-            if (!orthographicViewFrustum && settings->getShadowMapProjectionHint()==ShadowSettings::PERSPECTIVE_SHADOW_MAP)
+            if (casterCamera)
             {
+                osg::ref_ptr<VDSMCameraCullCallback> vdsmCallback = new VDSMCameraCullCallback(this, local_polytope);
+                if (shareCasters)
                 {
-                    osg::Matrix validRegionMatrix = cv.getCurrentCamera()->getInverseViewMatrix() *  camera->getViewMatrix() * camera->getProjectionMatrix();
+                    if (sm_i == 0)
+                        vdsmCallback->recordCasters(&vdd->_sharedCasters, sharedCasterPolytope);
+                    else if (vdd->_sharedCasters._valid)
+                        vdsmCallback->reuseCasters(&vdd->_sharedCasters);
+                }
+                casterCamera->setCullCallback(vdsmCallback.get());
 
-                    std::string validRegionUniformName = "validRegionMatrix" + std::to_string(sm_i);
-                    osg::ref_ptr<osg::Uniform> validRegionUniform;
+                // 4.3 traverse RTT camera
+                //
 
-                    for (const auto & uniform : _uniforms[cv.getTraversalNumber() % 2])
-                    {
-                        if (uniform->getName() == validRegionUniformName)
-                        {
-                            validRegionUniform = uniform;
-                            break;
-                        }
-                    }
+                cv.pushStateSet(_shadowCastingStateSet.get());
+
+                cullShadowCastingScene(&cv, casterCamera, casterMask);
+
+                cv.popStateSet();
 
-                    if (!validRegionUniform)
+                if (perspectiveShadowMaps)
+                {
+                    sd->_staticValidRegionMatrix = casterCamera->getViewMatrix() * casterCamera->getProjectionMatrix();
+                    setValidRegionMatrix(sm_i, cv.getCurrentCamera()->getInverseViewMatrix() * sd->_staticValidRegionMatrix);
+
+                    if (settings->getMultipleShadowMapHint() == ShadowSettings::CASCADED)
+                        adjustPerspectiveShadowMapCameraSettings(vdsmCallback->getRenderStage(), frustum, pl, casterCamera, cascaseNear, cascadeFar);
+                    else
+                        adjustPerspectiveShadowMapCameraSettings(vdsmCallback->getRenderStage(), frustum, pl, casterCamera, reducedNear, reducedFar);
+                    if (vdsmCallback->getProjectionMatrix())
                     {
-                        validRegionUniform = new osg::Uniform(osg::Uniform::FLOAT_MAT4, validRegionUniformName);
-                        _uniforms[cv.getTraversalNumber() % 2].push_back(validRegionUniform);
+                        vdsmCallback->getProjectionMatrix()->set(casterCamera->getProjectionMatrix());
                     }
-
-                    validRegionUniform->set(validRegionMatrix);
                 }
+            }
 
-                if (settings->getMultipleShadowMapHint() == ShadowSettings::CASCADED)
-                    adjustPerspectiveShadowMapCameraSettings(vdsmCallback->getRenderStage(), frustum, pl, camera.get(), cascaseNear, cascadeFar);
-                else
-                    adjustPerspectiveShadowMapCameraSettings(vdsmCallback->getRenderStage(), frustum, pl, camera.get(), reducedNear, reducedFar);
-                if (vdsmCallback->getProjectionMatrix())
+            if (cacheStaticCasters)
+            {
+                if (refreshStaticCasters)
                 {
-                    vdsmCallback->getProjectionMatrix()->set(camera->getProjectionMatrix());
+                    sd->_staticPolytope = local_polytope;
+                    sd->_staticValid = true;
                 }
+                else if (perspectiveShadowMaps)
+                    setValidRegionMatrix(sm_i, cv.getCurrentCamera()->getInverseViewMatrix() * sd->_staticValidRegionMatrix);
+
+                camera->setProjectionMatrix(sd->_staticCamera->getProjectionMatrix());
+                camera->setViewMatrix(sd->_staticCamera->getViewMatrix());
+                camera->setClearMask(0);
+                camera->setPreDrawCallback(sd->_copyStaticTextureCallback.get());
+                camera->setCullCallback(new VDSMCameraCullCallback(this, sd->_staticPolytope));
+
+                cv.pushStateSet(_shadowCastingStateSet.get());
+
+                cullShadowCastingScene(&cv, camera.get(), _dynamicCasterMask);
+
+                cv.popStateSet();
             }
  
             // 4.4 compute main scene graph TexGen + uniform settings + setup state
@@ -1579,6 +1893,9 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             if (_debugHud)
                 _debugHud->draw(sd->_texture, sm_i, camera->getViewMatrix() * camera->getProjectionMatrix(), cv);
         }
+
+        // the render leaves hold the casters from here on
+        vdd->_sharedCasters.clear();
     }
 
     vdd->setNumValidShadows(numValidShadows);
@@ -3096,14 +3413,14 @@ void MWShadowTechnique::cullShadowReceivingScene(osgUtil::CullVisitor* cv) const
     return;
 }
 
-void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const
+void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int casterMask) const
 {
     OSG_INFO<<"cullShadowCastingScene()"<<std::endl;
 
     // record the traversal mask on entry so we can reapply it later.
     unsigned int traversalMask = cv->getTraversalMask();
 
-    cv->setTraversalMask( traversalMask & _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask() );
+    cv->setTraversalMask( traversalMask & _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask() & casterMask );
 
         if (camera) camera->accept(*cv);
 
@@ -3112,6 +3429,17 @@ void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Ca
     return;
 }
 
+bool MWShadowTechnique::needsStaticCasterRefresh(ViewDependentData& vdd, const Frustum& frustum, const LightData& light, unsigned int frameNumber) const
+{
+    return !vdd._staticCasterCacheValid
+        || vdd._staticCasterRevision != _staticCasterRevision
+        || vdd._staticCasterCastsMask != _shadowedScene->getCastsShadowTraversalMask()
+        || frameNumber - vdd._staticCasterFrameNumber >= staticCasterMaxAge
+        || (frustum.eye - vdd._staticCasterEye).length2() > staticCasterMaxDistance * staticCasterMaxDistance
+        || frustum.frustumCenterLine * vdd._staticCasterViewDirection < staticCasterMinViewCosine
+        || light.lightDir * vdd._staticCasterLightDirection < staticCasterMinLightCosine;
+}
+
 osg::StateSet* MWShadowTechnique::prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const
 {
     OSG_INFO<<"   prepareStateSetForRenderingShadow() "<<vdd.getStateSet(traversalNumber)<<std::endl;
@@ -21,8 +21,10 @@
 #define COMPONENTS_SCENEUTIL_MWSHADOWTECHNIQUE_H 1
 
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <osg/Camera>
 #include <osg/Material>
@@ -88,6 +90,20 @@ namespace SceneUtil {
 
         virtual void setupCastingShader(Shader::ShaderManager &shaderManager);
 
+        /** Keep the shadows of the casters traversed with the static mask in persistent shadow maps, which are rendered again only when the view or
+         *  the light moves past a threshold or dirtyStaticCasterCache() is called. The casters traversed with the dynamic mask are drawn every frame
+         *  on top of a copy of them. */
+        virtual void enableStaticCasterCaching(unsigned int staticCasterMask, unsigned int dynamicCasterMask);
+
+        virtual void disableStaticCasterCaching();
+
+        /** Render the static casters again in the next frame, e.g. after some of them were added or removed. */
+        void dirtyStaticCasterCache() { ++_staticCasterRevision; }
+
+        /** Traverse the casting scene once per light instead of once per shadow map. The first shadow map culls the casters of all of them and
+         *  the others build their render lists from the recorded casters. Not used together with static caster caching. */
+        void setSharedCasterCulling(bool enabled) { _sharedCasterCulling = enabled; }
+
         class ComputeLightSpaceBounds : public osg::NodeVisitor, public osg::CullStack
         {
         public:
@@ -194,10 +210,50 @@ namespace SceneUtil {
             unsigned int                        _textureUnit;
             osg::ref_ptr<osg::Texture2D>        _texture;
             osg::ref_ptr<osg::Camera>           _camera;
+
+            void initStaticCasterCache();
+
+            // Shadows of the static casters copied into _texture before _camera draws the others
+            osg::ref_ptr<osg::Texture2D>        _staticTexture;
+            osg::ref_ptr<osg::Camera>           _staticCamera;
+            osg::ref_ptr<osg::Camera::DrawCallback> _copyStaticTextureCallback;
+            osg::Polytope                       _staticPolytope;
+            // Light view and projection before the perspective shadow map adjustment used for the valid region
+            osg::Matrixd                        _staticValidRegionMatrix;
+            bool                                _staticValid = false;
         };
 
         typedef std::list< osg::ref_ptr<ShadowData> > ShadowDataList;
 
+        /** Shadow casters culled by the first shadow map of a light, with the state they were culled with. */
+        struct SharedCasters
+        {
+            struct Caster
+            {
+                osg::ref_ptr<osg::Drawable>     _drawable;
+                osg::ref_ptr<osg::RefMatrix>    _modelView;
+                float                           _depth;
+                // Bounding box in the light's eye coordinates
+                osg::BoundingBox                _bound;
+            };
+
+            struct StateGroup
+            {
+                // State sets pushed since the cull of the shadow camera started
+                std::vector<const osg::StateSet*> _stateSets;
+                std::vector<Caster>             _casters;
+            };
+
+            std::vector<StateGroup>             _groups;
+            bool                                _valid = false;
+
+            void clear()
+            {
+                _groups.clear();
+                _valid = false;
+            }
+        };
+
 
         class ViewDependentData : public osg::Referenced
         {
@@ -230,6 +286,18 @@ namespace SceneUtil {
             ShadowDataList              _shadowDataList;
 
             unsigned int _numValidShadows;
+
+            // View and light the static casters were rendered for
+            bool                        _staticCasterCacheValid = false;
+            osg::Vec3d                  _staticCasterEye;
+            osg::Vec3d                  _staticCasterViewDirection;
+            osg::Vec3d                  _staticCasterLightDirection;
+            unsigned int                _staticCasterFrameNumber = 0;
+            unsigned int                _staticCasterRevision = 0;
+            unsigned int                _staticCasterCastsMask = 0;
+
+            // Only valid while the shadow maps of a light are culled
+            SharedCasters               _sharedCasters;
         };
 
         virtual ViewDependentData* createViewDependentData(osgUtil::CullVisitor* cv);
@@ -254,12 +322,23 @@ namespace SceneUtil {
 
         virtual void cullShadowReceivingScene(osgUtil::CullVisitor* cv) const;
 
-        virtual void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const;
+        virtual void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int casterMask = ~0u) const;
+
+        bool needsStaticCasterRefresh(ViewDependentData& vdd, const Frustum& frustum, const LightData& light, unsigned int frameNumber) const;
 
         virtual osg::StateSet* prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const;
 
         void setWorldMask(unsigned int worldMask) { _worldMask = worldMask; }
 
+        /** Set the callbacks run before and after drawing each shadow map, e.g. to measure how long it takes.
+          * They are used as the initial and final draw callbacks of the shadow cameras created afterwards. */
+        void setShadowCameraDrawCallbacks(osg::Camera::DrawCallback* initialCallback,
+            osg::Camera::DrawCallback* finalCallback)
+        {
+            _shadowCameraInitialDrawCallback = initialCallback;
+            _shadowCameraFinalDrawCallback = finalCallback;
+        }
+
         osg::ref_ptr<osg::StateSet> getOrCreateShadowsBinStateSet();
 
     protected:
@@ -299,6 +378,16 @@ namespace SceneUtil {
 
         unsigned int                            _worldMask = ~0u;
 
+        bool                                    _staticCasterCaching = false;
+        unsigned int                            _staticCasterMask = 0;
+        unsigned int                            _dynamicCasterMask = ~0u;
+        std::atomic<unsigned int>               _staticCasterRevision{ 0 };
+
+        bool                                    _sharedCasterCulling = false;
+
+        osg::ref_ptr<osg::Camera::DrawCallback> _shadowCameraInitialDrawCallback;
+        osg::ref_ptr<osg::Camera::DrawCallback> _shadowCameraFinalDrawCallback;
+
         class DebugHUD final : public osg::Referenced
         {
         public:
@@ -41,6 +41,7 @@
 #include <cassert>
 
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 using namespace osgUtil;
 
@@ -117,6 +118,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         mgv.setTargetMaximumNumberOfVertices(1000000);
         mgv.setMergeAlphaBlending(_mergeAlphaBlending);
         mgv.setViewPoint(_viewPoint);
+        mgv.setWorkQueue(_workQueue);
         node->accept(mgv);
 
         osg::Timer_t endTick = osg::Timer::instance()->tick();
@@ -1408,10 +1410,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                 group.addChild(*itr);
             }
 
-            // Place outside the loop to keep vectors allocated
-            GeometryArraySizes sizes;
-
-            // now do the merging of geometries
+            std::vector<DuplicateList*> duplicateLists;
             for(MergeList::iterator mitr = mergeList.begin();
                 mitr != mergeList.end();
                 ++mitr)
@@ -1425,22 +1424,47 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                         lgvp._viewPoint = _viewPoint;
                         std::sort(duplicateList.begin(), duplicateList.end(), lgvp);
                     }
-                    DuplicateList::iterator ditr = duplicateList.begin();
-                    osg::ref_ptr<osg::Geometry> lhs = *ditr++;
+                    group.addChild(duplicateList.front().get());
+                    if (duplicateList.size() > 1)
+                        duplicateLists.push_back(&duplicateList);
+                }
+            }
 
-                    initArraySizes(*lhs, sizes);
+            // now do the merging of geometries
+            const auto mergeDuplicateList = [&] (std::size_t index, GeometryArraySizes& sizes)
+            {
+                DuplicateList& duplicateList = *duplicateLists[index];
+                DuplicateList::iterator ditr = duplicateList.begin();
+                osg::Geometry& lhs = **ditr++;
 
-                    for (auto it = ditr; it != duplicateList.end(); ++it)
-                        addArraysSizes(*lhs, **it, sizes);
+                initArraySizes(lhs, sizes);
 
-                    group.addChild(lhs.get());
-                    for(;
-                        ditr != duplicateList.end();
-                        ++ditr)
-                    {
-                        mergeGeometry(*lhs, **ditr, sizes);
-                    }
+                for (auto it = ditr; it != duplicateList.end(); ++it)
+                    addArraysSizes(lhs, **it, sizes);
+
+                for(;
+                    ditr != duplicateList.end();
+                    ++ditr)
+                {
+                    mergeGeometry(lhs, **ditr, sizes);
                 }
+            };
+
+            // The lists never share a geometry, so each one is merged independently
+            if (_workQueue != nullptr && duplicateLists.size() > 1)
+            {
+                _workQueue->parallelFor(duplicateLists.size(), [&] (std::size_t index)
+                {
+                    GeometryArraySizes sizes;
+                    mergeDuplicateList(index, sizes);
+                });
+            }
+            else
+            {
+                // Place outside the loop to keep vectors allocated
+                GeometryArraySizes sizes;
+                for (std::size_t i = 0; i < duplicateLists.size(); ++i)
+                    mergeDuplicateList(i, sizes);
             }
         }
 
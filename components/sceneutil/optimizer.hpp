@@ -38,6 +38,7 @@ namespace SceneUtil {
 
 // forward declare
 class Optimizer;
+class WorkQueue;
 
 /** Helper base class for implementing Optimizer techniques.*/
 class BaseOptimizerVisitor : public osg::NodeVisitor
@@ -72,7 +73,7 @@ class Optimizer
 
     public:
 
-        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr) {}
+        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr), _workQueue(nullptr) {}
         virtual ~Optimizer() {}
 
         enum OptimizationOptions
@@ -130,6 +131,9 @@ class Optimizer
 
         void setSharedStateManager(osgDB::SharedStateManager* sharedStateManager, std::mutex* sharedStateMutex) { _sharedStateMutex = sharedStateMutex; _sharedStateManager = sharedStateManager; }
 
+        /** Merge the geometries of different state sets in parallel on the threads of the work queue and the calling thread.*/
+        void setWorkQueue(WorkQueue* workQueue) { _workQueue = workQueue; }
+
         /** Reset internal data to initial state - the getPermissibleOptionsMap is cleared.*/
         void reset();
 
@@ -270,6 +274,8 @@ class Optimizer
         osgDB::SharedStateManager* _sharedStateManager;
         mutable std::mutex* _sharedStateMutex;
 
+        WorkQueue* _workQueue;
+
     public:
 
         /** Flatten Static Transform nodes by applying their transform to the
@@ -408,7 +414,7 @@ class Optimizer
                 /// default to traversing all children.
                 MergeGeometryVisitor(Optimizer* optimizer=0) :
                     BaseOptimizerVisitor(optimizer, MERGE_GEOMETRY),
-                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false) {}
+                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false), _workQueue(nullptr) {}
 
                 void setMergeAlphaBlending(bool merge)
                 {
@@ -418,6 +424,10 @@ class Optimizer
                 {
                     _viewPoint = viewPoint;
                 }
+                void setWorkQueue(WorkQueue* workQueue)
+                {
+                    _workQueue = workQueue;
+                }
 
                 void setTargetMaximumNumberOfVertices(unsigned int num)
                 {
@@ -453,6 +463,7 @@ class Optimizer
                 bool _alphaBlendingActive;
                 bool _mergeAlphaBlending;
                 osg::Vec3f _viewPoint;
+                WorkQueue* _workQueue;
         };
 
 };
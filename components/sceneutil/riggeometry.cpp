@@ -1,5 +1,6 @@
 #include "riggeometry.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <osg/MatrixTransform>
@@ -24,6 +25,7 @@ namespace SceneUtil
     RigGeometry::RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop)
         : Drawable(copy, copyop)
         , mData(copy.mData)
+        , mGpuSkinning(copy.mGpuSkinning)
     {
         setSourceGeometry(copy.mSourceGeometry);
         setNumChildrenRequiringUpdateTraversal(1);
@@ -32,9 +34,16 @@ namespace SceneUtil
     void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
             mGeometry[i] = nullptr;
+            mBoneMatrices[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeometry;
+        mSourceTangents = nullptr;
+
+        if (mGpuSkinning)
+            mData->createGpuSkinningAttributes(sourceGeometry->getVertexArray()->getNumElements());
 
         for (unsigned int i = 0; i < 2; ++i)
         {
@@ -56,6 +65,27 @@ namespace SceneUtil
             to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
             to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
 
+            if (mGpuSkinning)
+            {
+                // The source arrays are not modified, only the bone matrices differ between the frames.
+                to.setVertexAttribArray(sBoneIndicesAttribute, mData->mBoneIndices, osg::Array::BIND_PER_VERTEX);
+                to.setVertexAttribArray(sBoneWeightsAttribute, mData->mBoneWeights, osg::Array::BIND_PER_VERTEX);
+
+                // The last matrix is used by the vertices without influences
+                mBoneMatrices[i] = new osg::Uniform(osg::Uniform::FLOAT_MAT4, "boneMatrices",
+                    static_cast<int>(mData->mBones.size() + 1));
+                mBoneMatrices[i]->setElement(static_cast<unsigned>(mData->mBones.size()), osg::Matrixf());
+
+                osg::ref_ptr<osg::StateSet> stateSet = from.getStateSet()
+                    ? new osg::StateSet(*from.getStateSet(), osg::CopyOp::SHALLOW_COPY)
+                    : new osg::StateSet;
+                stateSet->addUniform(mBoneMatrices[i]);
+                // Used by the shadow casting shader which is shared with the static geometry
+                stateSet->addUniform(new osg::Uniform("useSkinning", true));
+                to.setStateSet(stateSet);
+                continue;
+            }
+
             // vertices and normals are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -88,8 +118,6 @@ namespace SceneUtil
                 tangentArray->setVertexBufferObject(vbo);
                 to.setTexCoordArray(7, tangentArray, osg::Array::BIND_PER_VERTEX);
             }
-            else
-                mSourceTangents = nullptr;
         }
     }
 
@@ -98,6 +126,79 @@ namespace SceneUtil
         return mSourceGeometry;
     }
 
+    bool RigGeometry::supportsGpuSkinning() const
+    {
+        return mData != nullptr && mSourceGeometry != nullptr
+            && dynamic_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray()) != nullptr
+            && mData->mBones.size() < sMaxGpuSkinningBones;
+    }
+
+    void RigGeometry::setGpuSkinning(bool enabled)
+    {
+        enabled = enabled && supportsGpuSkinning();
+        if (enabled == mGpuSkinning)
+            return;
+        mGpuSkinning = enabled;
+        mLastFrameNumber = 0;
+        setSourceGeometry(mSourceGeometry);
+        // Bounds of the new internal geometries have to be copied again
+        mBoundsFirstFrame = true;
+        _boundingBox.init();
+    }
+
+    void RigGeometry::InfluenceData::createGpuSkinningAttributes(std::size_t vertexCount)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mBoneIndices != nullptr && mBoneIndices->size() == vertexCount)
+            return;
+
+        const float identity = static_cast<float>(mBones.size());
+        osg::ref_ptr<osg::Vec4Array> indices = new osg::Vec4Array(vertexCount, osg::Vec4f(identity, 0, 0, 0));
+        osg::ref_ptr<osg::Vec4Array> weights = new osg::Vec4Array(vertexCount, osg::Vec4f(1, 0, 0, 0));
+
+        for (const auto& [influences, vertices] : mInfluences)
+        {
+            // Only 4 influences fit into the attributes, keep the largest ones and preserve the sum of the weights
+            BoneWeights used = influences;
+            std::sort(used.begin(), used.end(), [](const BoneWeight& l, const BoneWeight& r) {
+                return l.second > r.second;
+            });
+            float total = 0;
+            for (const BoneWeight& influence : used)
+                total += influence.second;
+            if (used.size() > 4)
+                used.resize(4);
+            float usedTotal = 0;
+            for (const BoneWeight& influence : used)
+                usedTotal += influence.second;
+            const float scale = usedTotal > 0 ? total / usedTotal : 0;
+
+            osg::Vec4f vertexIndices(identity, identity, identity, identity);
+            osg::Vec4f vertexWeights(0, 0, 0, 0);
+            for (std::size_t i = 0; i < used.size(); ++i)
+            {
+                vertexIndices[i] = static_cast<float>(used[i].first);
+                vertexWeights[i] = used[i].second * scale;
+            }
+
+            for (unsigned short vertex : vertices)
+            {
+                if (vertex >= vertexCount)
+                    continue;
+                (*indices)[vertex] = vertexIndices;
+                (*weights)[vertex] = vertexWeights;
+            }
+        }
+
+        // The arrays are shared by the instances, so they have to use own VBO
+        osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
+        indices->setVertexBufferObject(vbo);
+        weights->setVertexBufferObject(vbo);
+
+        mBoneIndices = std::move(indices);
+        mBoneWeights = std::move(weights);
+    }
+
     bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
     {
         const osg::NodePath& path = nv->getNodePath();
@@ -148,7 +249,10 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        // Bones that were not updated since the last skinning keep the previous result
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0
+                && (!mSkeleton->getActive() || mSkeleton->isUpdateSkippedSince(mLastFrameNumber, traversalNumber))))
         {
             osg::Geometry& geom = *getGeometry(mLastFrameNumber);
             nv->pushOntoNodePath(&geom);
@@ -161,15 +265,39 @@ namespace SceneUtil
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
+        if (mGpuSkinning)
+        {
+            updateBoneMatrices(*mBoneMatrices[mLastFrameNumber % 2]);
+        }
+        else
+        {
+            const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+            const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+
+            osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+            osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+            osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+            skin(*positionSrc, *positionDst, normalSrc, normalDst, mSourceTangents, tangentDst);
+
+            positionDst->dirty();
+            if (normalDst)
+                normalDst->dirty();
+            if (tangentDst)
+                tangentDst->dirty();
+
+            geom.osg::Drawable::dirtyGLObjects();
+        }
+
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
 
+    void RigGeometry::skin(const osg::Vec3Array& positionSrc, osg::Vec3Array& positionDst,
+        const osg::Vec3Array* normalSrc, osg::Vec3Array* normalDst, const osg::Vec4Array* tangentSrc,
+        osg::Vec4Array* tangentDst) const
+    {
         for (const auto& [influences, vertices] : mData->mInfluences)
         {
             osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
@@ -193,7 +321,7 @@ namespace SceneUtil
 
             for (unsigned short vertex : vertices)
             {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
+                positionDst[vertex] = resultMat.preMult(positionSrc[vertex]);
                 if (normalDst)
                     (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
 
@@ -206,18 +334,23 @@ namespace SceneUtil
                 }
             }
         }
+    }
 
-        positionDst->dirty();
-        if (normalDst)
-            normalDst->dirty();
-        if (tangentDst)
-            tangentDst->dirty();
-
-        geom.osg::Drawable::dirtyGLObjects();
-
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+    void RigGeometry::updateBoneMatrices(osg::Uniform& uniform) const
+    {
+        // Same matrices as in skin() but without the influence weights applied
+        for (std::size_t index = 0; index < mNodes.size(); ++index)
+        {
+            const Bone* bone = mNodes[index];
+            osg::Matrixf boneMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+            if (bone != nullptr)
+            {
+                boneMat = mData->mBones[index].mInvBindMatrix * bone->mMatrixInSkeletonSpace;
+                if (mGeomToSkelMatrix)
+                    boneMat *= (*mGeomToSkelMatrix);
+            }
+            uniform.setElement(static_cast<unsigned>(index), boneMat);
+        }
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -338,12 +471,45 @@ namespace SceneUtil
 
         std::map<BoneWeights, VertexList> influencesToVertices;
         for (size_t i = 0; i < influences.size(); i++)
-            influencesToVertices[influences[i]].emplace_back(i);
+        {
+            // Like with the other format, vertices without influences keep the source position
+            if (!influences[i].empty())
+                influencesToVertices[influences[i]].emplace_back(i);
+        }
 
         mData->mInfluences.reserve(influencesToVertices.size());
         mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
     }
 
+    const std::vector<RigGeometry::BoneInfo>& RigGeometry::getBoneInfo() const
+    {
+        static const std::vector<BoneInfo> empty;
+        if (!mData)
+            return empty;
+        return mData->mBones;
+    }
+
+    std::vector<RigGeometry::BoneWeights> RigGeometry::getInfluences() const
+    {
+        std::vector<BoneWeights> result;
+        if (mSourceGeometry != nullptr && mSourceGeometry->getVertexArray() != nullptr)
+            result.resize(mSourceGeometry->getVertexArray()->getNumElements());
+        if (!mData)
+            return result;
+
+        for (const auto& [influences, vertices] : mData->mInfluences)
+        {
+            for (unsigned short vertex : vertices)
+            {
+                if (vertex >= result.size())
+                    result.resize(vertex + 1);
+                result[vertex] = influences;
+            }
+        }
+
+        return result;
+    }
+
     void RigGeometry::accept(osg::NodeVisitor& nv)
     {
         if (!nv.validNodeMask(*this))
@@ -374,7 +540,27 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        if (!mGpuSkinning)
+        {
+            getGeometry(mLastFrameNumber)->accept(func);
+            return;
+        }
+
+        // The internal geometry is skinned by the vertex shader, do the same on the CPU for the intersections
+        const osg::Vec3Array& positionSrc = static_cast<const osg::Vec3Array&>(*mSourceGeometry->getVertexArray());
+        if (mSkeleton == nullptr || mNodes.size() != mData->mBones.size())
+        {
+            mSourceGeometry->accept(func);
+            return;
+        }
+
+        osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array(positionSrc);
+        skin(positionSrc, *positions, nullptr, nullptr, nullptr, nullptr);
+        if (positions->empty())
+            return;
+        func.setVertexArray(positions->size(), &positions->front());
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : mSourceGeometry->getPrimitiveSetList())
+            primitiveSet->accept(func);
     }
 
     osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
@@ -4,6 +4,8 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <mutex>
+
 namespace SceneUtil
 {
     class Skeleton;
@@ -23,6 +25,9 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note With GPU skinning enabled the internal Geometry shares the source arrays and gets the bone indices and
+    /// weights as vertex attributes. The skinning matrices are passed per frame into the "boneMatrices" uniform and
+    /// the vertices are transformed by the vertex shader, which has to be built with the "skinning" define.
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -48,18 +53,37 @@ namespace SceneUtil
         using BoneWeight = std::pair<size_t, float>;
         using BoneWeights = std::vector<BoneWeight>;
 
+        /// Vertex attribute locations used by the GPU skinning.
+        static constexpr unsigned sBoneIndicesAttribute = 6;
+        static constexpr unsigned sBoneWeightsAttribute = 7;
+        /// Size of the boneMatrices uniform array in skinning.glsl.
+        static constexpr std::size_t sMaxGpuSkinningBones = 64;
+
         void setBoneInfo(std::vector<BoneInfo>&& bones);
         // Convert influences in vertex and weight list per bone format
         void setInfluences(const std::vector<VertexWeights>& influences);
         // Convert influences in bone and weight list per vertex format
         void setInfluences(const std::vector<BoneWeights>& influences);
 
+        const std::vector<BoneInfo>& getBoneInfo() const;
+        /// @return Bone and weight list per vertex of the source geometry
+        std::vector<BoneWeights> getInfluences() const;
+
         /// Initialize this geometry from the source geometry.
         /// @note The source geometry will not be modified.
         void setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom);
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// @return If the bone count fits the boneMatrices uniform.
+        bool supportsGpuSkinning() const;
+
+        /// Use the vertex shader to do the skinning. Has to be called after the source geometry and influences are
+        /// set, rebuilds the internal geometries. Intersections and bounds are still computed on the CPU.
+        void setGpuSkinning(bool enabled);
+
+        bool getGpuSkinning() const { return mGpuSkinning; }
+
         void accept(osg::NodeVisitor& nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -81,6 +105,9 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
+        void skin(const osg::Vec3Array& positionSrc, osg::Vec3Array& positionDst, const osg::Vec3Array* normalSrc,
+            osg::Vec3Array* normalDst, const osg::Vec4Array* tangentSrc, osg::Vec4Array* tangentDst) const;
+        void updateBoneMatrices(osg::Uniform& uniform) const;
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
@@ -96,10 +123,20 @@ namespace SceneUtil
         {
             std::vector<BoneInfo> mBones;
             std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
+
+            // Per vertex attributes for the GPU skinning, shared by all instances and created on demand
+            std::mutex mMutex;
+            osg::ref_ptr<osg::Vec4Array> mBoneIndices;
+            osg::ref_ptr<osg::Vec4Array> mBoneWeights;
+
+            void createGpuSkinningAttributes(std::size_t vertexCount);
         };
         osg::ref_ptr<InfluenceData> mData;
         std::vector<Bone*> mNodes;
 
+        bool mGpuSkinning{ false };
+        osg::ref_ptr<osg::Uniform> mBoneMatrices[2];
+
         unsigned int mLastFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
 
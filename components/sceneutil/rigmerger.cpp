@@ -0,0 +1,219 @@
+#include "rigmerger.hpp"
+
+#include <algorithm>
+#include <optional>
+
+#include <osg/Geometry>
+#include <osg/PrimitiveSet>
+
+#include "riggeometry.hpp"
+
+namespace SceneUtil
+{
+    namespace
+    {
+        template <class T>
+        osg::ref_ptr<osg::Array> concatenate(const std::vector<const osg::Array*>& arrays)
+        {
+            osg::ref_ptr<T> result = new T;
+            for (const osg::Array* array : arrays)
+            {
+                const T& typed = static_cast<const T&>(*array);
+                result->insert(result->end(), typed.begin(), typed.end());
+            }
+            return result;
+        }
+
+        // nullopt if the arrays can not be combined, nullptr if none of the geometries has the array
+        std::optional<osg::ref_ptr<osg::Array>> mergeArrays(
+            const std::vector<const osg::Array*>& arrays, const std::vector<std::size_t>& vertexCounts)
+        {
+            const auto isNull = [](const osg::Array* array) { return array == nullptr; };
+            if (std::all_of(arrays.begin(), arrays.end(), isNull))
+                return osg::ref_ptr<osg::Array>();
+            if (std::any_of(arrays.begin(), arrays.end(), isNull))
+                return std::nullopt;
+
+            const osg::Array& first = *arrays.front();
+            for (std::size_t i = 0; i < arrays.size(); ++i)
+            {
+                const osg::Array& array = *arrays[i];
+                if (array.getType() != first.getType() || array.getBinding() != osg::Array::BIND_PER_VERTEX
+                    || array.getNormalize() != first.getNormalize() || array.getNumElements() != vertexCounts[i])
+                    return std::nullopt;
+            }
+
+            osg::ref_ptr<osg::Array> result;
+            switch (first.getType())
+            {
+                case osg::Array::Vec2ArrayType:
+                    result = concatenate<osg::Vec2Array>(arrays);
+                    break;
+                case osg::Array::Vec3ArrayType:
+                    result = concatenate<osg::Vec3Array>(arrays);
+                    break;
+                case osg::Array::Vec4ArrayType:
+                    result = concatenate<osg::Vec4Array>(arrays);
+                    break;
+                case osg::Array::Vec4ubArrayType:
+                    result = concatenate<osg::Vec4ubArray>(arrays);
+                    break;
+                default:
+                    return std::nullopt;
+            }
+
+            result->setBinding(osg::Array::BIND_PER_VERTEX);
+            result->setNormalize(first.getNormalize());
+            return result;
+        }
+
+        template <class Get>
+        std::optional<osg::ref_ptr<osg::Array>> mergeArrays(const std::vector<osg::ref_ptr<osg::Geometry>>& sources,
+            const std::vector<std::size_t>& vertexCounts, Get&& get)
+        {
+            std::vector<const osg::Array*> arrays;
+            arrays.reserve(sources.size());
+            for (const osg::ref_ptr<osg::Geometry>& source : sources)
+                arrays.push_back(get(*source));
+            return mergeArrays(arrays, vertexCounts);
+        }
+    }
+
+    std::size_t getRigVertexCount(const RigGeometry& rig)
+    {
+        const osg::ref_ptr<osg::Geometry> source = rig.getSourceGeometry();
+        if (source == nullptr || source->getVertexArray() == nullptr)
+            return 0;
+        return source->getVertexArray()->getNumElements();
+    }
+
+    osg::ref_ptr<RigGeometry> mergeRigGeometries(const std::vector<osg::ref_ptr<RigGeometry>>& rigs)
+    {
+        if (rigs.empty())
+            return nullptr;
+
+        const bool gpuSkinning = rigs.front()->getGpuSkinning();
+        std::vector<osg::ref_ptr<osg::Geometry>> sources;
+        std::vector<std::size_t> vertexCounts;
+        std::size_t totalVertices = 0;
+        unsigned numTexCoordArrays = 0;
+        for (const osg::ref_ptr<RigGeometry>& rig : rigs)
+        {
+            osg::ref_ptr<osg::Geometry> source = rig->getSourceGeometry();
+            if (source == nullptr || dynamic_cast<const osg::Vec3Array*>(source->getVertexArray()) == nullptr
+                || rig->getGpuSkinning() != gpuSkinning || rig->getBoneInfo().empty())
+                return nullptr;
+            if (source->getSecondaryColorArray() != nullptr || source->getFogCoordArray() != nullptr)
+                return nullptr;
+            for (unsigned i = 0; i < source->getNumVertexAttribArrays(); ++i)
+                if (source->getVertexAttribArray(i) != nullptr)
+                    return nullptr;
+            for (unsigned i = 0; i < source->getNumPrimitiveSets(); ++i)
+                if (source->getPrimitiveSet(i)->getMode() != osg::PrimitiveSet::TRIANGLES)
+                    return nullptr;
+
+            vertexCounts.push_back(source->getVertexArray()->getNumElements());
+            totalVertices += vertexCounts.back();
+            numTexCoordArrays = std::max(numTexCoordArrays, source->getNumTexCoordArrays());
+            sources.push_back(std::move(source));
+        }
+
+        if (totalVertices > sMaxMergedRigVertices)
+            return nullptr;
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setName(sources.front()->getName());
+        geometry->setStateSet(sources.front()->getStateSet());
+        geometry->setSupportsDisplayList(false);
+        geometry->setUseVertexBufferObjects(true);
+
+        const auto vertices = mergeArrays(
+            sources, vertexCounts, [](const osg::Geometry& source) { return source.getVertexArray(); });
+        const auto normals = mergeArrays(
+            sources, vertexCounts, [](const osg::Geometry& source) { return source.getNormalArray(); });
+        const auto colors = mergeArrays(
+            sources, vertexCounts, [](const osg::Geometry& source) { return source.getColorArray(); });
+        if (!vertices.has_value() || !normals.has_value() || !colors.has_value())
+            return nullptr;
+
+        geometry->setVertexArray(*vertices);
+        if (*normals != nullptr)
+            geometry->setNormalArray(*normals, osg::Array::BIND_PER_VERTEX);
+        if (*colors != nullptr)
+            geometry->setColorArray(*colors, osg::Array::BIND_PER_VERTEX);
+
+        for (unsigned unit = 0; unit < numTexCoordArrays; ++unit)
+        {
+            const auto texCoords = mergeArrays(sources, vertexCounts,
+                [&](const osg::Geometry& source) { return source.getTexCoordArray(unit); });
+            if (!texCoords.has_value())
+                return nullptr;
+            if (*texCoords != nullptr)
+                geometry->setTexCoordArray(unit, *texCoords, osg::Array::BIND_PER_VERTEX);
+        }
+
+        osg::ref_ptr<osg::DrawElementsUShort> triangles = new osg::DrawElementsUShort(osg::PrimitiveSet::TRIANGLES);
+        std::vector<RigGeometry::BoneInfo> bones;
+        std::vector<RigGeometry::BoneWeights> influences;
+        influences.reserve(totalVertices);
+        std::size_t firstVertex = 0;
+        for (std::size_t i = 0; i < rigs.size(); ++i)
+        {
+            const osg::Geometry& source = *sources[i];
+            for (unsigned j = 0; j < source.getNumPrimitiveSets(); ++j)
+            {
+                const osg::PrimitiveSet& primitiveSet = *source.getPrimitiveSet(j);
+                for (unsigned k = 0; k < primitiveSet.getNumIndices(); ++k)
+                    triangles->push_back(static_cast<unsigned short>(firstVertex + primitiveSet.index(k)));
+            }
+
+            // The same bone with the same bind pose is used once, parts of a body usually share most of the bones
+            std::vector<std::size_t> boneIndices;
+            for (const RigGeometry::BoneInfo& bone : rigs[i]->getBoneInfo())
+            {
+                const auto it = std::find_if(bones.begin(), bones.end(), [&](const RigGeometry::BoneInfo& v) {
+                    return v.mName == bone.mName && v.mInvBindMatrix == bone.mInvBindMatrix;
+                });
+                if (it == bones.end())
+                {
+                    boneIndices.push_back(bones.size());
+                    bones.push_back(bone);
+                }
+                else
+                {
+                    boneIndices.push_back(static_cast<std::size_t>(it - bones.begin()));
+                    it->mBoundSphere.expandBy(bone.mBoundSphere);
+                }
+            }
+
+            std::vector<RigGeometry::BoneWeights> rigInfluences = rigs[i]->getInfluences();
+            rigInfluences.resize(vertexCounts[i]);
+            for (RigGeometry::BoneWeights& weights : rigInfluences)
+            {
+                for (RigGeometry::BoneWeight& weight : weights)
+                    weight.first = boneIndices[weight.first];
+                influences.push_back(std::move(weights));
+            }
+
+            firstVertex += vertexCounts[i];
+        }
+        geometry->addPrimitiveSet(triangles);
+
+        osg::ref_ptr<RigGeometry> result = new RigGeometry;
+        result->setName(rigs.front()->getName());
+        result->setStateSet(rigs.front()->getStateSet());
+        result->setBoneInfo(std::move(bones));
+        result->setInfluences(influences);
+        result->setSourceGeometry(geometry);
+
+        // The shaders of the state set expect the same kind of skinning
+        if (gpuSkinning)
+        {
+            result->setGpuSkinning(true);
+            if (!result->getGpuSkinning())
+                return nullptr;
+        }
+
+        return result;
+    }
+}
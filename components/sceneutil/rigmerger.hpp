@@ -0,0 +1,28 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_RIGMERGER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_RIGMERGER_H
+
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <vector>
+
+namespace SceneUtil
+{
+    class RigGeometry;
+
+    /// Maximum number of vertices of a merged RigGeometry, the influences refer to the vertices by 16 bit indices.
+    constexpr std::size_t sMaxMergedRigVertices = 65536;
+
+    std::size_t getRigVertexCount(const RigGeometry& rig);
+
+    /// @brief Combine skinned geometries into one RigGeometry to draw and skin them at once.
+    /// @note The geometries have to be skinned by the same skeleton and render with the same state. The state set of
+    /// the first RigGeometry is used.
+    /// @note Only reads the geometries, so can be called from a worker thread as long as the source geometries and
+    /// their influences are not replaced meanwhile.
+    /// @return nullptr if the geometries have different vertex attributes, primitives other than triangles, too many
+    /// vertices in total, or the GPU skinning can not be kept.
+    osg::ref_ptr<RigGeometry> mergeRigGeometries(const std::vector<osg::ref_ptr<RigGeometry>>& rigs);
+}
+
+#endif
@@ -1,6 +1,9 @@
 #include "rtt.hpp"
 #include "util.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include <osg/Texture2D>
 #include <osg/Texture2DArray>
 #include <osgUtil/CullVisitor>
@@ -54,6 +57,21 @@ namespace SceneUtil
         auto* vdd = getViewDependentData(cv);
         if (frameNumber > vdd->mFrameNumber)
         {
+            const osg::Matrix& viewMatrix = *cv->getModelViewMatrix();
+            const osg::Vec3f eyePoint = osg::Matrix::inverse(viewMatrix).getTrans();
+            const osg::Vec3f lookVector(-viewMatrix(0, 2), -viewMatrix(1, 2), -viewMatrix(2, 2));
+            if (!needsUpdate(*vdd, frameNumber, eyePoint, lookVector))
+            {
+                ++mNumSkippedUpdates;
+                vdd->mFrameNumber = frameNumber;
+                return;
+            }
+            vdd->mRendered = true;
+            vdd->mRenderedFrameNumber = frameNumber;
+            vdd->mRenderedEyePoint = eyePoint;
+            vdd->mRenderedLookVector = lookVector;
+            vdd->mRenderedViewProjection = viewMatrix * *cv->getProjectionMatrix();
+
             apply(vdd->mCamera);
             if (Stereo::getStereo())
             {
@@ -68,6 +86,34 @@ namespace SceneUtil
         vdd->mFrameNumber = frameNumber;
     }
 
+    bool RTTNode::needsUpdate(const ViewDependentData& vdd, unsigned int frameNumber, const osg::Vec3f& eyePoint,
+        const osg::Vec3f& lookVector) const
+    {
+        if (!vdd.mRendered || frameNumber - vdd.mRenderedFrameNumber >= mUpdateInterval)
+            return true;
+        if ((eyePoint - vdd.mRenderedEyePoint).length2() > mMaxUpdateDistance * mMaxUpdateDistance)
+            return true;
+        return lookVector * vdd.mRenderedLookVector < mMinUpdateCosAngle;
+    }
+
+    void RTTNode::setUpdateInterval(unsigned int interval, float maxDistance, float maxAngle)
+    {
+        mUpdateInterval = std::max(interval, 1u);
+        mMaxUpdateDistance = maxDistance;
+        mMinUpdateCosAngle = std::cos(maxAngle);
+    }
+
+    void RTTNode::forceUpdate()
+    {
+        for (auto& [cv, vdd] : mViewDependentDataMap)
+            vdd->mRendered = false;
+    }
+
+    const osg::Matrix& RTTNode::getRenderedViewProjection(osgUtil::CullVisitor* cv)
+    {
+        return getViewDependentData(cv)->mRenderedViewProjection;
+    }
+
     void RTTNode::setColorBufferInternalFormat(GLint internalFormat)
     {
         mColorBufferInternalFormat = internalFormat;
@@ -1,8 +1,10 @@
 #ifndef OPENMW_RTT_H
 #define OPENMW_RTT_H
 
+#include <osg/Matrix>
 #include <osg/Node>
 
+#include <atomic>
 #include <map>
 #include <memory>
 
@@ -73,6 +75,21 @@ namespace SceneUtil
 
         void cull(osgUtil::CullVisitor* cv);
 
+        /// Render the views at most every \a interval frames, or sooner when the parent camera moves farther than
+        /// \a maxDistance or turns by more than \a maxAngle radians. In between, the textures keep their contents.
+        void setUpdateInterval(unsigned int interval, float maxDistance, float maxAngle);
+
+        /// Render every view in the next cull traversal, regardless of the update interval.
+        void forceUpdate();
+
+        /// @return The view and projection matrix of the parent camera the textures were last rendered with. Useful
+        /// to reproject the textures when the views are not rendered every frame.
+        const osg::Matrix& getRenderedViewProjection(osgUtil::CullVisitor* cv);
+
+        /// @return The number of view updates skipped due to the update interval since the last call.
+        /// @note Thread safe.
+        unsigned int takeNumSkippedUpdates() { return mNumSkippedUpdates.exchange(0); }
+
         uint32_t width() const { return mTextureWidth; }
         uint32_t height() const { return mTextureHeight; }
         uint32_t samples() const { return mSamples; }
@@ -96,10 +113,18 @@ namespace SceneUtil
             osg::ref_ptr<osg::Texture> mColorTexture;
             osg::ref_ptr<osg::Texture> mDepthTexture;
             unsigned int mFrameNumber = 0;
+            bool mRendered = false;
+            unsigned int mRenderedFrameNumber = 0;
+            osg::Vec3f mRenderedEyePoint;
+            osg::Vec3f mRenderedLookVector;
+            osg::Matrix mRenderedViewProjection;
         };
 
         ViewDependentData* getViewDependentData(osgUtil::CullVisitor* cv);
 
+        bool needsUpdate(const ViewDependentData& vdd, unsigned int frameNumber, const osg::Vec3f& eyePoint,
+            const osg::Vec3f& lookVector) const;
+
         typedef std::map<osgUtil::CullVisitor*, std::shared_ptr<ViewDependentData>> ViewDependentDataMap;
         ViewDependentDataMap mViewDependentDataMap;
         uint32_t mTextureWidth;
@@ -111,6 +136,10 @@ namespace SceneUtil
         int mRenderOrderNum;
         StereoAwareness mStereoAwareness;
         bool mAddMSAAIntermediateTarget;
+        unsigned int mUpdateInterval = 1;
+        float mMaxUpdateDistance = 0;
+        float mMinUpdateCosAngle = 1;
+        std::atomic<unsigned int> mNumSkippedUpdates = 0;
     };
 }
 #endif
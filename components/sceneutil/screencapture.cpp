@@ -156,7 +156,7 @@ namespace SceneUtil
     void AsyncScreenCaptureOperation::operator()(const osg::Image& image, const unsigned int context_id)
     {
         osg::ref_ptr<SceneUtil::WorkItem> item(new ScreenCaptureWorkItem(mImpl, image, context_id));
-        mQueue->addWorkItem(item);
+        mQueue->addWorkItem(item, WorkPriority::Urgent);
         const auto isDone = [](const osg::ref_ptr<SceneUtil::WorkItem>& v) { return v->isDone(); };
         const auto workItems = mWorkItems.lock();
         workItems->erase(std::remove_if(workItems->begin(), workItems->end(), isDone), workItems->end());
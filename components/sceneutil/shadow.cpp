@@ -4,6 +4,7 @@
 #include <osgShadow/ShadowedScene>
 
 #include <components/misc/strings/algorithm.hpp>
+#include <components/resource/gputimer.hpp>
 #include <components/settings/categories/shadows.hpp>
 #include <components/stereo/stereomanager.hpp>
 
@@ -80,6 +81,13 @@ namespace SceneUtil
             mShadowTechnique->enableDebugHUD();
         else
             mShadowTechnique->disableDebugHUD();
+
+        if (settings.mCacheStaticShadows)
+            mShadowTechnique->enableStaticCasterCaching(mStaticShadowCastingMask, mDynamicShadowCastingMask);
+        else
+            mShadowTechnique->disableStaticCasterCaching();
+
+        mShadowTechnique->setSharedCasterCulling(settings.mSharedCasterCulling);
     }
 
     void ShadowManager::disableShadowsForStateSet(osg::StateSet& stateset) const
@@ -108,11 +116,14 @@ namespace SceneUtil
 
     ShadowManager::ShadowManager(osg::ref_ptr<osg::Group> sceneRoot, osg::ref_ptr<osg::Group> rootNode,
         unsigned int outdoorShadowCastingMask, unsigned int indoorShadowCastingMask, unsigned int worldMask,
+        unsigned int staticShadowCastingMask, unsigned int dynamicShadowCastingMask,
         const Settings::ShadowsCategory& settings, Shader::ShaderManager& shaderManager)
         : mShadowedScene(new osgShadow::ShadowedScene)
         , mShadowTechnique(new MWShadowTechnique)
         , mOutdoorShadowCastingMask(outdoorShadowCastingMask)
         , mIndoorShadowCastingMask(indoorShadowCastingMask)
+        , mStaticShadowCastingMask(staticShadowCastingMask)
+        , mDynamicShadowCastingMask(dynamicShadowCastingMask)
     {
         if (sInstance)
             throw std::logic_error("A ShadowManager already exists");
@@ -208,4 +219,15 @@ namespace SceneUtil
             mShadowTechnique->enableShadows();
         mShadowSettings->setCastsShadowTraversalMask(mOutdoorShadowCastingMask);
     }
+
+    void ShadowManager::dirtyStaticShadows()
+    {
+        mShadowTechnique->dirtyStaticCasterCache();
+    }
+
+    void ShadowManager::setGpuTimer(Resource::GpuTimer& timer)
+    {
+        mShadowTechnique->setShadowCameraDrawCallbacks(timer.createDrawCallback(Resource::GpuStage::Shadows, true),
+            timer.createDrawCallback(Resource::GpuStage::Shadows, false));
+    }
 }
@@ -15,6 +15,11 @@ namespace osgShadow
     class ShadowedScene;
 }
 
+namespace Resource
+{
+    class GpuTimer;
+}
+
 namespace Settings
 {
     struct ShadowsCategory;
@@ -32,6 +37,7 @@ namespace SceneUtil
 
         explicit ShadowManager(osg::ref_ptr<osg::Group> sceneRoot, osg::ref_ptr<osg::Group> rootNode,
             unsigned int outdoorShadowCastingMask, unsigned int indoorShadowCastingMask, unsigned int worldMask,
+            unsigned int staticShadowCastingMask, unsigned int dynamicShadowCastingMask,
             const Settings::ShadowsCategory& settings, Shader::ShaderManager& shaderManager);
         ~ShadowManager();
 
@@ -45,6 +51,12 @@ namespace SceneUtil
 
         void enableOutdoorMode();
 
+        /// Render the cached shadows of the static casters again, e.g. after they were added or removed.
+        void dirtyStaticShadows();
+
+        /// Measure the GPU time spent drawing the shadow maps.
+        void setGpuTimer(Resource::GpuTimer& timer);
+
     protected:
         static ShadowManager* sInstance;
 
@@ -56,6 +68,8 @@ namespace SceneUtil
 
         unsigned int mOutdoorShadowCastingMask;
         unsigned int mIndoorShadowCastingMask;
+        unsigned int mStaticShadowCastingMask;
+        unsigned int mDynamicShadowCastingMask;
     };
 }
 
@@ -115,6 +115,11 @@ namespace SceneUtil
                     state.mImportantState = true;
             }
 
+            // The bone matrices of a GPU skinned RigGeometry and the attribute divisors of instanced geometry can't be
+            // dropped
+            if (ss->getUniform("useSkinning") != nullptr || ss->getUniform("useInstancing") != nullptr)
+                state.mImportantState = true;
+
             if ((*itr) != sg && !state.interesting())
                 uninterestingCache.insert(*itr);
         }
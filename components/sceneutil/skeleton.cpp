@@ -37,8 +37,13 @@ namespace SceneUtil
         : mBoneCacheInit(false)
         , mNeedToUpdateBoneMatrices(true)
         , mActive(Active)
+        , mUpdateInterval(1)
+        , mUpdatePhase(0)
+        , mForceUpdate(false)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLastUpdateFrameNumber(0)
+        , mLastSkippedFrameNumber(0)
     {
     }
 
@@ -47,8 +52,13 @@ namespace SceneUtil
         , mBoneCacheInit(false)
         , mNeedToUpdateBoneMatrices(true)
         , mActive(copy.mActive)
+        , mUpdateInterval(1)
+        , mUpdatePhase(0)
+        , mForceUpdate(false)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLastUpdateFrameNumber(0)
+        , mLastSkippedFrameNumber(0)
     {
     }
 
@@ -121,6 +131,12 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setUpdateInterval(unsigned int interval, unsigned int phase)
+    {
+        mUpdateInterval = std::max(interval, 1u);
+        mUpdatePhase = phase;
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
@@ -132,10 +148,21 @@ namespace SceneUtil
     {
         if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
         {
-            if (mActive == Inactive && mLastFrameNumber != 0)
-                return;
-            if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
-                return;
+            const bool forced = mForceUpdate;
+            mForceUpdate = false;
+            if (!forced && mLastFrameNumber != 0)
+            {
+                if (mActive == Inactive)
+                    return;
+                if (mActive == SemiActive && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
+                    return;
+                if ((nv.getTraversalNumber() + mUpdatePhase) % mUpdateInterval != 0)
+                {
+                    mLastSkippedFrameNumber = nv.getTraversalNumber();
+                    return;
+                }
+            }
+            mLastUpdateFrameNumber = nv.getTraversalNumber();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
             mLastCullFrameNumber = nv.getTraversalNumber();
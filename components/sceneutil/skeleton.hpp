@@ -56,6 +56,20 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Update the bones only on every interval-th update traversal, the frames are shifted by the phase. Skipped
+        /// frames keep the previous pose, animation time still advances as it is not tracked by the skeleton.
+        void setUpdateInterval(unsigned int interval, unsigned int phase = 0);
+
+        /// Update the bones on the next update traversal regardless of the active flag and the update interval.
+        void forceUpdate() { mForceUpdate = true; }
+
+        /// @return Whether the update of the bones was skipped in this traversal because of the update interval and
+        /// the bones were not updated after a frame
+        bool isUpdateSkippedSince(unsigned int frameNumber, unsigned int traversalNumber) const
+        {
+            return mLastSkippedFrameNumber == traversalNumber && mLastUpdateFrameNumber <= frameNumber;
+        }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -76,8 +90,14 @@ namespace SceneUtil
 
         ActiveType mActive;
 
+        unsigned int mUpdateInterval;
+        unsigned int mUpdatePhase;
+        bool mForceUpdate;
+
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+        unsigned int mLastUpdateFrameNumber;
+        unsigned int mLastSkippedFrameNumber;
     };
 
 }
@@ -0,0 +1,149 @@
+#include "uniformringbuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <osg/BufferObject>
+#include <osg/FrameStamp>
+#include <osg/State>
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using BufferStorage = void(GL_APIENTRY*)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+        constexpr GLbitfield mappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    }
+
+    UniformRingBuffer& UniformRingBuffer::instance()
+    {
+        static UniformRingBuffer ringBuffer;
+        return ringBuffer;
+    }
+
+    std::optional<GLintptr> UniformRingBuffer::upload(osg::State& state, const void* data, std::size_t size)
+    {
+        ContextData& context = mContexts[state.getContextID()];
+        if (!context.mInitialized)
+            init(state, context);
+        if (context.mMapped == nullptr)
+            return std::nullopt;
+
+        const unsigned frameNumber = state.getFrameStamp()->getFrameNumber();
+        if (context.mFrameNumber != frameNumber)
+            startFrame(*state.get<osg::GLExtensions>(), context, frameNumber);
+
+        const std::size_t offset = (context.mOffset + context.mAlignment - 1) / context.mAlignment * context.mAlignment;
+        if (offset + size > sRegionSize)
+            return std::nullopt;
+
+        const std::size_t bufferOffset = context.mRegion * sRegionSize + offset;
+        std::memcpy(context.mMapped + bufferOffset, data, size);
+        context.mOffset = offset + size;
+
+        return static_cast<GLintptr>(bufferOffset);
+    }
+
+    void UniformRingBuffer::bind(osg::State& state, GLuint index, GLintptr offset, std::size_t size)
+    {
+        const ContextData& context = mContexts[state.getContextID()];
+        state.get<osg::GLExtensions>()->glBindBufferRange(
+            GL_UNIFORM_BUFFER, index, context.mBuffer, offset, static_cast<GLsizeiptr>(size));
+    }
+
+    void UniformRingBuffer::init(osg::State& state, ContextData& data)
+    {
+        data.mInitialized = true;
+
+        const unsigned contextId = state.getContextID();
+        const osg::GLExtensions* const ext = state.get<osg::GLExtensions>();
+        if (ext == nullptr || !ext->isUniformBufferObjectSupported
+            || !osg::isGLExtensionOrVersionSupported(contextId, "GL_ARB_sync", 3.2f)
+            || !osg::isGLExtensionOrVersionSupported(contextId, "GL_ARB_buffer_storage", 4.4f))
+            return;
+
+        BufferStorage bufferStorage = nullptr;
+        osg::setGLExtensionFuncPtr(bufferStorage, "glBufferStorage", "glBufferStorageARB");
+        if (bufferStorage == nullptr)
+            return;
+
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        data.mAlignment = static_cast<std::size_t>(std::max(alignment, 1));
+
+        constexpr GLsizeiptr size = static_cast<GLsizeiptr>(sRegionSize * sMaxFrames);
+        ext->glGenBuffers(1, &data.mBuffer);
+        ext->glBindBuffer(GL_UNIFORM_BUFFER, data.mBuffer);
+        bufferStorage(GL_UNIFORM_BUFFER, size, nullptr, mappingFlags);
+        data.mMapped = static_cast<char*>(ext->glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, mappingFlags));
+        ext->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        if (data.mMapped == nullptr)
+        {
+            ext->glDeleteBuffers(1, &data.mBuffer);
+            data.mBuffer = 0;
+        }
+    }
+
+    void UniformRingBuffer::startFrame(const osg::GLExtensions& ext, ContextData& data, unsigned frameNumber)
+    {
+        // Commands of the previous frame all precede the first upload of this frame
+        if (data.mOffset > 0)
+            data.mFences[data.mRegion] = ext.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        data.mRegion = (data.mRegion + 1) % sMaxFrames;
+        data.mOffset = 0;
+        data.mFrameNumber = frameNumber;
+
+        GLsync& fence = data.mFences[data.mRegion];
+        if (fence == nullptr)
+            return;
+
+        // The GPU is more than sMaxFrames behind, wait for it to finish reading the region
+        GLenum result = ext.glClientWaitSync(fence, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = ext.glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+        ext.glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void RingUniformBufferBinding::apply(osg::State& state) const
+    {
+        const osg::BufferData* const data = getBufferData();
+        if (data == nullptr || getOffset() < 0 || getSize() <= 0
+            || static_cast<std::size_t>(getOffset() + getSize()) > data->getTotalDataSize())
+        {
+            osg::UniformBufferBinding::apply(state);
+            return;
+        }
+
+        ContextData& context = mContexts[state.getContextID()];
+        const unsigned frameNumber = state.getFrameStamp()->getFrameNumber();
+        if (!context.mOffset.has_value() || context.mFrameNumber != frameNumber
+            || context.mModifiedCount != data->getModifiedCount())
+        {
+            context.mFrameNumber = frameNumber;
+            context.mModifiedCount = data->getModifiedCount();
+            context.mOffset = UniformRingBuffer::instance().upload(state,
+                static_cast<const char*>(data->getDataPointer()) + getOffset(), static_cast<std::size_t>(getSize()));
+        }
+
+        if (!context.mOffset.has_value())
+        {
+            osg::UniformBufferBinding::apply(state);
+            return;
+        }
+
+        UniformRingBuffer::instance().bind(state, getIndex(), *context.mOffset, static_cast<std::size_t>(getSize()));
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_UNIFORMRINGBUFFER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_UNIFORMRINGBUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include <osg/BufferIndexBinding>
+#include <osg/GLExtensions>
+#include <osg/buffered_value>
+
+namespace osg
+{
+    class State;
+}
+
+namespace SceneUtil
+{
+    /// @brief Persistently mapped buffer the per frame uniform data is sub-allocated from.
+    /// @par The buffer is split into one region per frame in flight. A region is reused once the fence issued after its
+    /// frame is signalled, so the CPU only waits when the GPU falls more than that many frames behind. Requires
+    /// GL_ARB_buffer_storage, users fall back to their own buffer objects without it or when a region is full.
+    class UniformRingBuffer
+    {
+    public:
+        static UniformRingBuffer& instance();
+
+        /// Copy the data into the region of the current frame. Must be called on the draw thread.
+        /// @return Offset of the copy in the buffer, nothing if the buffer is unsupported or the region is full.
+        std::optional<GLintptr> upload(osg::State& state, const void* data, std::size_t size);
+
+        /// Bind a range returned by upload() to a uniform block binding point.
+        void bind(osg::State& state, GLuint index, GLintptr offset, std::size_t size);
+
+    private:
+        static constexpr std::size_t sMaxFrames = 3;
+        static constexpr std::size_t sRegionSize = 1024 * 1024;
+
+        struct ContextData
+        {
+            bool mInitialized = false;
+            GLuint mBuffer = 0;
+            char* mMapped = nullptr;
+            std::size_t mAlignment = 1;
+            unsigned mFrameNumber = 0;
+            std::size_t mRegion = 0;
+            std::size_t mOffset = 0;
+            std::array<GLsync, sMaxFrames> mFences{};
+        };
+
+        void init(osg::State& state, ContextData& data);
+
+        void startFrame(const osg::GLExtensions& ext, ContextData& data, unsigned frameNumber);
+
+        osg::buffered_object<ContextData> mContexts;
+    };
+
+    /// @brief Binds the data of a uniform block from the UniformRingBuffer, copying it once per frame and modification.
+    /// @par Behaves like osg::UniformBufferBinding, which it falls back to, when the ring buffer can't be used.
+    class RingUniformBufferBinding : public osg::UniformBufferBinding
+    {
+    public:
+        RingUniformBufferBinding() = default;
+
+        RingUniformBufferBinding(GLuint index, osg::BufferData* data, GLintptr offset, GLsizeiptr size)
+            : osg::UniformBufferBinding(index, data, offset, size)
+        {
+        }
+
+        RingUniformBufferBinding(
+            const RingUniformBufferBinding& copy, const osg::CopyOp& copyop = osg::CopyOp::SHALLOW_COPY)
+            : osg::UniformBufferBinding(copy, copyop)
+        {
+        }
+
+        META_StateAttribute(SceneUtil, RingUniformBufferBinding, UNIFORMBUFFERBINDING)
+
+        void apply(osg::State& state) const override;
+
+    private:
+        struct ContextData
+        {
+            unsigned mFrameNumber = 0;
+            unsigned mModifiedCount = 0;
+            std::optional<GLintptr> mOffset;
+        };
+
+        mutable osg::buffered_object<ContextData> mContexts;
+    };
+}
+
+#endif
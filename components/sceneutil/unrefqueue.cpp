@@ -9,24 +9,36 @@ namespace SceneUtil
         struct ClearVector final : SceneUtil::WorkItem
         {
             std::vector<osg::ref_ptr<osg::Referenced>> mObjects;
+            std::vector<std::shared_ptr<const void>> mSharedObjects;
 
-            explicit ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>&& objects)
+            explicit ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>&& objects,
+                std::vector<std::shared_ptr<const void>>&& sharedObjects)
                 : mObjects(std::move(objects))
+                , mSharedObjects(std::move(sharedObjects))
             {
             }
 
-            void doWork() override { mObjects.clear(); }
+            void doWork() override
+            {
+                mObjects.clear();
+                mSharedObjects.clear();
+            }
         };
     }
 
     void UnrefQueue::flush(SceneUtil::WorkQueue& workQueue)
     {
-        if (mObjects.empty())
+        if (mObjects.empty() && mSharedObjects.empty())
             return;
 
-        // Move only objects to keep allocated storage in mObjects
-        workQueue.addWorkItem(new ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>(
-            std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end()))));
+        // Move only objects to keep allocated storage in mObjects and mSharedObjects
+        osg::ref_ptr<ClearVector> item(new ClearVector(
+            std::vector<osg::ref_ptr<osg::Referenced>>(
+                std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end())),
+            std::vector<std::shared_ptr<const void>>(
+                std::move_iterator(mSharedObjects.begin()), std::move_iterator(mSharedObjects.end()))));
+        workQueue.addWorkItem(std::move(item), WorkPriority::Speculative);
         mObjects.clear();
+        mSharedObjects.clear();
     }
 }
@@ -4,6 +4,7 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <memory>
 #include <vector>
 
 namespace SceneUtil
@@ -12,6 +13,9 @@ namespace SceneUtil
 
     /// @brief Handles unreferencing of objects through the WorkQueue. Typical use scenario
     /// would be the main thread pushing objects that are no longer needed, and the background thread deleting them.
+    /// @par Besides osg objects it accepts objects owned by std::shared_ptr and std::unique_ptr. Their destructors
+    /// have to be safe to call from another thread, so anything touching the main thread state (e.g. removal from
+    /// the collision world) has to be done before the push.
     class UnrefQueue
     {
     public:
@@ -20,14 +24,29 @@ namespace SceneUtil
 
         void push(const osg::ref_ptr<osg::Referenced>& obj) { mObjects.push_back(obj); }
 
+        template <class T>
+        void push(std::shared_ptr<T>&& obj)
+        {
+            mSharedObjects.push_back(std::move(obj));
+        }
+
+        template <class T, class Deleter>
+        void push(std::unique_ptr<T, Deleter>&& obj)
+        {
+            mSharedObjects.push_back(std::shared_ptr<T>(std::move(obj)));
+        }
+
         /// Adds a WorkItem to the given WorkQueue that will clear the list of objects in a worker thread,
         /// thus unreferencing them. Call from the main thread.
         void flush(SceneUtil::WorkQueue& workQueue);
 
         std::size_t getSize() const { return mObjects.size(); }
 
+        std::size_t getSharedSize() const { return mSharedObjects.size(); }
+
     private:
         std::vector<osg::ref_ptr<osg::Referenced>> mObjects;
+        std::vector<std::shared_ptr<const void>> mSharedObjects;
     };
 }
 
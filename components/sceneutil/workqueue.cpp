@@ -1,11 +1,74 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
 #include <numeric>
+#include <string>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        thread_local const WorkQueue* sCurrentWorkQueue = nullptr;
+        thread_local std::size_t sCurrentThreadIndex = 0;
+
+        struct ParallelForState
+        {
+            // Only called for the indices taken before all the calls are done, so it doesn't outlive parallelFor
+            const std::function<void(std::size_t)>* mFunction;
+            std::size_t mCount;
+            std::atomic_size_t mNext{ 0 };
+            std::size_t mDone = 0;
+            std::exception_ptr mException;
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+
+            bool runNext()
+            {
+                const std::size_t index = mNext.fetch_add(1, std::memory_order_relaxed);
+                if (index >= mCount)
+                    return false;
+                std::exception_ptr exception;
+                try
+                {
+                    (*mFunction)(index);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                const std::lock_guard lock(mMutex);
+                if (exception != nullptr && mException == nullptr)
+                    mException = std::move(exception);
+                if (++mDone == mCount)
+                    mCondition.notify_all();
+                return true;
+            }
+        };
+
+        class ParallelForItem : public WorkItem
+        {
+        public:
+            explicit ParallelForItem(std::shared_ptr<ParallelForState> state)
+                : mState(std::move(state))
+            {
+            }
+
+            void doWork() override
+            {
+                while (mState->runNext())
+                {
+                }
+            }
+
+        private:
+            std::shared_ptr<ParallelForState> mState;
+        };
+    }
 
     void WorkItem::waitTillDone()
     {
@@ -19,6 +82,15 @@ namespace SceneUtil
         }
     }
 
+    bool WorkItem::waitTillDone(std::chrono::milliseconds timeout)
+    {
+        if (mDone)
+            return true;
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        return mCondition.wait_for(lock, timeout, [&] { return mDone.load(); });
+    }
+
     void WorkItem::signalDone()
     {
         {
@@ -33,9 +105,18 @@ namespace SceneUtil
         return mDone;
     }
 
+    void WorkItem::cancel()
+    {
+        mCancelled = true;
+        abort();
+    }
+
     WorkQueue::WorkQueue(std::size_t workerThreads)
         : mIsReleased(false)
     {
+        mQueues.resize(std::max<std::size_t>(workerThreads, 1));
+        for (std::unique_ptr<ThreadQueue>& queue : mQueues)
+            queue = std::make_unique<ThreadQueue>();
         start(workerThreads);
     }
 
@@ -51,15 +132,24 @@ namespace SceneUtil
             mIsReleased = false;
         }
         while (mThreads.size() < workerThreads)
-            mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+            mThreads.emplace_back(std::make_unique<WorkThread>(*this, mThreads.size()));
     }
 
     void WorkQueue::stop()
     {
+        for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
+        {
+            const std::lock_guard lock(queue->mMutex);
+            for (std::size_t priority = 0; priority < workPriorities; ++priority)
+            {
+                mCounters[priority].mQueued -= queue->mItems[priority].size();
+                mPending -= queue->mItems[priority].size();
+                queue->mItems[priority].clear();
+            }
+        }
+
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -67,7 +157,7 @@ namespace SceneUtil
         mThreads.clear();
     }
 
-    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority)
     {
         if (item->isDone())
         {
@@ -75,34 +165,106 @@ namespace SceneUtil
             return;
         }
 
+        const std::size_t index = static_cast<std::size_t>(priority);
+        ThreadQueue& queue = *mQueues[getQueueForNewItem()];
+        // Count before pushing so a work thread never takes more items than counted
+        ++mPending;
+        ++mCounters[index].mQueued;
+        {
+            const std::lock_guard lock(queue.mMutex);
+            queue.mItems[index].push_back(std::move(item));
+        }
+
         std::unique_lock<std::mutex> lock(mMutex);
-        if (front)
-            mQueue.push_front(std::move(item));
-        else
-            mQueue.push_back(std::move(item));
         mCondition.notify_one();
     }
 
-    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+    void WorkQueue::cancel(WorkPriority priority)
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        const std::size_t index = static_cast<std::size_t>(priority);
+        std::vector<osg::ref_ptr<WorkItem>> cancelled;
+        for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
         {
-            mCondition.wait(lock);
+            const std::lock_guard lock(queue->mMutex);
+            std::deque<osg::ref_ptr<WorkItem>>& items = queue->mItems[index];
+            cancelled.insert(cancelled.end(), std::move_iterator(items.begin()), std::move_iterator(items.end()));
+            items.clear();
+        }
+
+        mPending -= cancelled.size();
+        mCounters[index].mQueued -= cancelled.size();
+        mCounters[index].mCancelled += cancelled.size();
+
+        for (const osg::ref_ptr<WorkItem>& item : cancelled)
+        {
+            item->cancel();
+            item->signalDone();
         }
-        if (!mQueue.empty())
+    }
+
+    void WorkQueue::parallelFor(
+        std::size_t count, const std::function<void(std::size_t)>& function, WorkPriority priority)
+    {
+        if (count == 0)
+            return;
+
+        const auto state = std::make_shared<ParallelForState>();
+        state->mFunction = &function;
+        state->mCount = count;
+
+        const std::size_t helpers = std::min(count - 1, mQueues.size());
+        for (std::size_t i = 0; i < helpers; ++i)
+            addWorkItem(new ParallelForItem(state), priority);
+
+        while (state->runNext())
+        {
+        }
+
+        std::unique_lock lock(state->mMutex);
+        state->mCondition.wait(lock, [&] { return state->mDone == state->mCount; });
+        if (state->mException != nullptr)
+            std::rethrow_exception(state->mException);
+    }
+
+    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex, WorkPriority& priority)
+    {
+        const std::size_t ownQueue = threadIndex % mQueues.size();
+        while (true)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            for (std::size_t index = 0; index < workPriorities; ++index)
+            {
+                priority = static_cast<WorkPriority>(index);
+                if (osg::ref_ptr<WorkItem> item = takeItem(ownQueue, index))
+                    return item;
+                for (std::size_t i = 1; i < mQueues.size(); ++i)
+                {
+                    if (osg::ref_ptr<WorkItem> item = takeItem((ownQueue + i) % mQueues.size(), index))
+                    {
+                        ++mStolen;
+                        return item;
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mPending > 0 || mIsReleased; });
+            if (mIsReleased)
+                return nullptr;
         }
-        return nullptr;
+    }
+
+    void WorkQueue::reportDone(WorkPriority priority, bool cancelled)
+    {
+        PriorityCounters& counters = mCounters[static_cast<std::size_t>(priority)];
+        if (cancelled)
+            ++counters.mCancelled;
+        else
+            ++counters.mCompleted;
     }
 
     unsigned int WorkQueue::getNumItems() const
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return static_cast<unsigned int>(mPending);
     }
 
     unsigned int WorkQueue::getNumActiveThreads() const
@@ -111,8 +273,44 @@ namespace SceneUtil
             mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
     }
 
-    WorkThread::WorkThread(WorkQueue& workQueue)
+    WorkQueueStats WorkQueue::getStats() const
+    {
+        WorkQueueStats result;
+        for (std::size_t i = 0; i < workPriorities; ++i)
+        {
+            result.mPriorities[i].mQueued = mCounters[i].mQueued;
+            result.mPriorities[i].mCompleted = mCounters[i].mCompleted;
+            result.mPriorities[i].mCancelled = mCounters[i].mCancelled;
+        }
+        result.mStolen = mStolen;
+        return result;
+    }
+
+    std::size_t WorkQueue::getQueueForNewItem()
+    {
+        // Keep items added by a work thread local to it so they are likely to be processed by the same thread
+        if (sCurrentWorkQueue == this)
+            return sCurrentThreadIndex % mQueues.size();
+        return mNextQueue++ % mQueues.size();
+    }
+
+    osg::ref_ptr<WorkItem> WorkQueue::takeItem(std::size_t queue, std::size_t priority)
+    {
+        ThreadQueue& threadQueue = *mQueues[queue];
+        const std::lock_guard lock(threadQueue.mMutex);
+        std::deque<osg::ref_ptr<WorkItem>>& items = threadQueue.mItems[priority];
+        if (items.empty())
+            return nullptr;
+        osg::ref_ptr<WorkItem> item = std::move(items.front());
+        items.pop_front();
+        --mPending;
+        --mCounters[priority].mQueued;
+        return item;
+    }
+
+    WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
         : mWorkQueue(&workQueue)
+        , mIndex(index)
         , mActive(false)
         , mThread([this] { run(); })
     {
@@ -125,13 +323,23 @@ namespace SceneUtil
 
     void WorkThread::run()
     {
+        sCurrentWorkQueue = mWorkQueue;
+        sCurrentThreadIndex = mIndex;
+        OPENMW_TRACE_THREAD_NAME("WorkQueue " + std::to_string(mIndex));
         while (true)
         {
-            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+            WorkPriority priority;
+            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex, priority);
             if (!item)
                 return;
             mActive = true;
-            item->doWork();
+            const bool cancelled = item->isCancelled();
+            if (!cancelled)
+            {
+                OPENMW_TRACE_ZONE("WorkItem::doWork");
+                item->doWork();
+            }
+            mWorkQueue->reportDone(priority, cancelled);
             item->signalDone();
             mActive = false;
         }
@@ -4,15 +4,33 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 namespace SceneUtil
 {
+    /// Work items with a higher priority are always started before the work items with a lower priority, no
+    /// matter which thread queue they are in.
+    enum class WorkPriority
+    {
+        /// Required for the current or the next frame.
+        Urgent,
+        /// Required to show something near the camera soon.
+        Visible,
+        /// May become required later, like preloading of the adjacent cells.
+        Speculative,
+    };
+
+    constexpr std::size_t workPriorities = 3;
 
     class WorkItem : public osg::Referenced
     {
@@ -25,23 +43,48 @@ namespace SceneUtil
         /// Wait until the work is completed. Usually called from the main thread.
         void waitTillDone();
 
+        /// Wait until the work is completed or the timeout passed.
+        /// @return Whether the work is completed
+        bool waitTillDone(std::chrono::milliseconds timeout);
+
         /// Internal use by the WorkQueue.
         void signalDone();
 
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Skip doWork() if it's not started yet and abort it otherwise. The item is still signalled as done.
+        void cancel();
+
+        bool isCancelled() const { return mCancelled; }
+
     private:
         std::atomic_bool mDone{ false };
+        std::atomic_bool mCancelled{ false };
         std::mutex mMutex;
         std::condition_variable mCondition;
     };
 
+    struct WorkQueueStats
+    {
+        struct Priority
+        {
+            std::size_t mQueued = 0;
+            std::size_t mCompleted = 0;
+            std::size_t mCancelled = 0;
+        };
+
+        std::array<Priority, workPriorities> mPriorities;
+        /// Number of the work items processed by a thread other than the one they have been queued to.
+        std::size_t mStolen = 0;
+    };
+
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Each thread has own queues per priority. Items added from a work thread go to its queue, others are
+    /// distributed over all threads. An idle thread steals work from the other threads. Work items of the same
+    /// priority are started roughly in the order they were given in but may complete in any order.
     class WorkQueue : public osg::Referenced
     {
     public:
@@ -52,35 +95,71 @@ namespace SceneUtil
 
         void stop();
 
-        /// Add a new work item to the back of the queue.
+        /// Add a new work item to the back of the queue of given priority.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
-        void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
+        void addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority = WorkPriority::Visible);
+
+        /// Cancel all queued work items of given priority. Their waitTillDone() returns immediately.
+        void cancel(WorkPriority priority);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Call the function for each index in [0, count) on the work threads and the calling thread, and return once
+        /// all the calls are done. The calling thread never waits for a call which is not started yet, so this may be
+        /// used from a work item even when all the other threads are busy. An exception thrown by a call is rethrown.
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function,
+            WorkPriority priority = WorkPriority::Urgent);
+
+        /// Get the next work item with the highest priority, first looking into the queue of the given thread then
+        /// into other queues. If all queues are empty, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex, WorkPriority& priority);
+
+        /// Internal use by the WorkThread.
+        void reportDone(WorkPriority priority, bool cancelled);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
+        WorkQueueStats getStats() const;
+
     private:
+        struct ThreadQueue
+        {
+            std::mutex mMutex;
+            std::array<std::deque<osg::ref_ptr<WorkItem>>, workPriorities> mItems;
+        };
+
+        struct PriorityCounters
+        {
+            std::atomic_size_t mQueued{ 0 };
+            std::atomic_size_t mCompleted{ 0 };
+            std::atomic_size_t mCancelled{ 0 };
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        // Never resized after construction so work threads may access it without locking mMutex
+        std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+        std::atomic_size_t mNextQueue{ 0 };
+        std::atomic_size_t mPending{ 0 };
+        std::array<PriorityCounters, workPriorities> mCounters;
+        std::atomic_size_t mStolen{ 0 };
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        std::size_t getQueueForNewItem();
+
+        osg::ref_ptr<WorkItem> takeItem(std::size_t queue, std::size_t priority);
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -88,6 +167,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
@@ -0,0 +1,117 @@
+#include "inputrecording.hpp"
+
+#include <components/files/conversion.hpp>
+
+#include <SDL_version.h>
+
+#include <array>
+#include <stdexcept>
+
+namespace SDLUtil
+{
+    namespace
+    {
+        constexpr std::array<char, 4> sMagic = { 'O', 'M', 'W', 'I' };
+        constexpr std::uint32_t sFormatVersion = 1;
+
+        struct Header
+        {
+            std::array<char, 4> mMagic;
+            std::uint32_t mFormatVersion;
+            std::uint32_t mEventSize;
+            std::uint32_t mSeed;
+        };
+
+        struct FrameHeader
+        {
+            double mDuration;
+            std::uint32_t mEvents;
+        };
+
+        template <class T>
+        void write(std::ofstream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        bool read(std::ifstream& stream, T& value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+    }
+
+    bool isRecordedInputEvent(Uint32 type)
+    {
+        switch (type)
+        {
+            case SDL_MOUSEMOTION:
+            case SDL_MOUSEWHEEL:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            case SDL_TEXTINPUT:
+            case SDL_SENSORUPDATE:
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+            case SDL_CONTROLLERAXISMOTION:
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+            case SDL_CONTROLLERTOUCHPADDOWN:
+            case SDL_CONTROLLERTOUCHPADMOTION:
+            case SDL_CONTROLLERTOUCHPADUP:
+#endif
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    InputRecorder::InputRecorder(const std::filesystem::path& path, unsigned seed)
+        : mStream(path, std::ios::binary)
+    {
+        if (!mStream.is_open())
+            throw std::runtime_error("Failed to open input recording file: " + Files::pathToUnicodeString(path));
+        write(mStream,
+            Header{ .mMagic = sMagic,
+                .mFormatVersion = sFormatVersion,
+                .mEventSize = static_cast<std::uint32_t>(sizeof(SDL_Event)),
+                .mSeed = seed });
+    }
+
+    void InputRecorder::finishFrame(double duration)
+    {
+        write(mStream, FrameHeader{ .mDuration = duration, .mEvents = static_cast<std::uint32_t>(mEvents.size()) });
+        for (const SDL_Event& event : mEvents)
+            write(mStream, event);
+        mEvents.clear();
+    }
+
+    InputReplayer::InputReplayer(const std::filesystem::path& path)
+        : mStream(path, std::ios::binary)
+    {
+        if (!mStream.is_open())
+            throw std::runtime_error("Failed to open input recording file: " + Files::pathToUnicodeString(path));
+        Header header;
+        if (!read(mStream, header) || header.mMagic != sMagic)
+            throw std::runtime_error("Not an input recording file: " + Files::pathToUnicodeString(path));
+        if (header.mFormatVersion != sFormatVersion || header.mEventSize != sizeof(SDL_Event))
+            throw std::runtime_error(
+                "Input recording file is made by an incompatible build: " + Files::pathToUnicodeString(path));
+        mSeed = header.mSeed;
+    }
+
+    bool InputReplayer::nextFrame()
+    {
+        FrameHeader frame;
+        if (!read(mStream, frame))
+            return false;
+        mEvents.resize(frame.mEvents);
+        for (SDL_Event& event : mEvents)
+            if (!read(mStream, event))
+                return false;
+        mFrameDuration = frame.mDuration;
+        ++mFrameNumber;
+        return true;
+    }
+}
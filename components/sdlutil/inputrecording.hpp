@@ -0,0 +1,63 @@
+#ifndef OPENMW_COMPONENTS_SDLUTIL_INPUTRECORDING_H
+#define OPENMW_COMPONENTS_SDLUTIL_INPUTRECORDING_H
+
+#include <SDL_events.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace SDLUtil
+{
+    /// Whether the event comes from the player input and has to be recorded and replayed
+    bool isRecordedInputEvent(Uint32 type);
+
+    /// \brief Writes the player input events and frame durations into a file to replay them later
+    /// \par Events are stored as is, so a recording can be replayed only by a build for the same platform.
+    class InputRecorder
+    {
+    public:
+        InputRecorder(const std::filesystem::path& path, unsigned seed);
+
+        void addEvent(const SDL_Event& event) { mEvents.push_back(event); }
+
+        /// Writes the events added since the previous frame
+        void finishFrame(double duration);
+
+    private:
+        std::ofstream mStream;
+        std::vector<SDL_Event> mEvents;
+    };
+
+    /// \brief Reads the recording written by InputRecorder frame by frame
+    class InputReplayer
+    {
+    public:
+        explicit InputReplayer(const std::filesystem::path& path);
+
+        /// Random seed the recording was made with
+        unsigned getSeed() const { return mSeed; }
+
+        /// Reads the next frame, returns false when the recording is over
+        bool nextFrame();
+
+        /// Simulation time of the current frame, real frame duration is ignored
+        double getFrameDuration() const { return mFrameDuration; }
+
+        std::size_t getFrameNumber() const { return mFrameNumber; }
+
+        /// Returns the events of the current frame, they are returned only once
+        std::vector<SDL_Event> takeEvents() { return std::move(mEvents); }
+
+    private:
+        std::ifstream mStream;
+        unsigned mSeed = 0;
+        double mFrameDuration = 0;
+        std::size_t mFrameNumber = 0;
+        std::vector<SDL_Event> mEvents;
+    };
+}
+
+#endif
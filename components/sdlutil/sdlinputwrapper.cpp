@@ -5,6 +5,8 @@
 
 #include <osgViewer/Viewer>
 
+#include "inputrecording.hpp"
+
 namespace SDLUtil
 {
 
@@ -76,158 +78,172 @@ namespace SDLUtil
 
         while (SDL_PollEvent(&evt))
         {
-            switch (evt.type)
+            if (isRecordedInputEvent(evt.type))
             {
-                case SDL_MOUSEMOTION:
-                    // Ignore this if it happened due to a warp
-                    if (!_handleWarpMotion(evt.motion))
-                    {
-                        // If in relative mode, don't trigger events unless window has focus
-                        if (!mWantRelative || mWindowHasFocus)
-                            mMouseListener->mouseMoved(_packageMouseMotion(evt));
-
-                        // Try to keep the mouse inside the window
-                        if (mWindowHasFocus)
-                            _wrapMousePointer(evt.motion);
-                    }
-                    break;
-                case SDL_MOUSEWHEEL:
+                // The player input is ignored while replaying the recorded one
+                if (mReplayer != nullptr)
+                    continue;
+                // Ignore this if it happened due to a warp
+                if (evt.type == SDL_MOUSEMOTION && _handleWarpMotion(evt.motion))
+                    continue;
+                if (mRecorder != nullptr)
+                    mRecorder->addEvent(evt);
+            }
+            handleEvent(evt);
+        }
+
+        if (mReplayer != nullptr)
+            for (const SDL_Event& replayed : mReplayer->takeEvents())
+                handleEvent(replayed);
+    }
+
+    void InputWrapper::handleEvent(const SDL_Event& evt)
+    {
+        switch (evt.type)
+        {
+            case SDL_MOUSEMOTION:
+                // If in relative mode, don't trigger events unless window has focus. Replayed input doesn't need it.
+                if (!mWantRelative || mWindowHasFocus || mReplayer != nullptr)
                     mMouseListener->mouseMoved(_packageMouseMotion(evt));
-                    mMouseListener->mouseWheelMoved(evt.wheel);
-                    break;
-                case SDL_SENSORUPDATE:
-                    mSensorListener->sensorUpdated(evt.sensor);
-                    break;
-                case SDL_MOUSEBUTTONDOWN:
-                    mMouseListener->mousePressed(evt.button, evt.button.button);
-                    break;
-                case SDL_MOUSEBUTTONUP:
-                    mMouseListener->mouseReleased(evt.button, evt.button.button);
-                    break;
-                case SDL_KEYDOWN:
-                    mKeyboardListener->keyPressed(evt.key);
+
+                // Try to keep the mouse inside the window
+                if (mWindowHasFocus && mReplayer == nullptr)
+                    _wrapMousePointer(evt.motion);
+                break;
+            case SDL_MOUSEWHEEL:
+                mMouseListener->mouseMoved(_packageMouseMotion(evt));
+                mMouseListener->mouseWheelMoved(evt.wheel);
+                break;
+            case SDL_SENSORUPDATE:
+                mSensorListener->sensorUpdated(evt.sensor);
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                mMouseListener->mousePressed(evt.button, evt.button.button);
+                break;
+            case SDL_MOUSEBUTTONUP:
+                mMouseListener->mouseReleased(evt.button, evt.button.button);
+                break;
+            case SDL_KEYDOWN:
+                mKeyboardListener->keyPressed(evt.key);
+
+                if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1 && evt.key.keysym.sym <= SDLK_F12)
+                {
+                    mViewer->getEventQueue()->keyPress(osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
+                }
+
+                break;
+            case SDL_KEYUP:
+                if (!evt.key.repeat)
+                {
+                    mKeyboardListener->keyReleased(evt.key);
 
                     if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1 && evt.key.keysym.sym <= SDLK_F12)
-                    {
-                        mViewer->getEventQueue()->keyPress(
+                        mViewer->getEventQueue()->keyRelease(
                             osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
-                    }
-
-                    break;
-                case SDL_KEYUP:
-                    if (!evt.key.repeat)
-                    {
-                        mKeyboardListener->keyReleased(evt.key);
-
-                        if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1
-                            && evt.key.keysym.sym <= SDLK_F12)
-                            mViewer->getEventQueue()->keyRelease(
-                                osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
-                    }
-
-                    break;
-                case SDL_TEXTEDITING:
-                    break;
-                case SDL_TEXTINPUT:
-                    mKeyboardListener->textInput(evt.text);
-                    break;
-                case SDL_KEYMAPCHANGED:
-                    break;
-                case SDL_JOYHATMOTION: // As we manage everything with GameController, don't even bother with these.
-                case SDL_JOYAXISMOTION:
-                case SDL_JOYBUTTONDOWN:
-                case SDL_JOYBUTTONUP:
-                case SDL_JOYDEVICEADDED:
-                case SDL_JOYDEVICEREMOVED:
-                    break;
-                case SDL_CONTROLLERDEVICEADDED:
-                    if (mConListener)
-                        mConListener->controllerAdded(
-                            1, evt.cdevice); // We only support one joystick, so give everything a generic deviceID
-                    break;
-                case SDL_CONTROLLERDEVICEREMOVED:
-                    if (mConListener)
-                        mConListener->controllerRemoved(evt.cdevice);
-                    break;
-                case SDL_CONTROLLERBUTTONDOWN:
-                    if (mConListener)
-                        mConListener->buttonPressed(1, evt.cbutton);
-                    break;
-                case SDL_CONTROLLERBUTTONUP:
-                    if (mConListener)
-                        mConListener->buttonReleased(1, evt.cbutton);
-                    break;
-                case SDL_CONTROLLERAXISMOTION:
-                    if (mConListener)
-                        mConListener->axisMoved(1, evt.caxis);
-                    break;
+                }
+
+                break;
+            case SDL_TEXTEDITING:
+                break;
+            case SDL_TEXTINPUT:
+                mKeyboardListener->textInput(evt.text);
+                break;
+            case SDL_KEYMAPCHANGED:
+                break;
+            case SDL_JOYHATMOTION: // As we manage everything with GameController, don't even bother with these.
+            case SDL_JOYAXISMOTION:
+            case SDL_JOYBUTTONDOWN:
+            case SDL_JOYBUTTONUP:
+            case SDL_JOYDEVICEADDED:
+            case SDL_JOYDEVICEREMOVED:
+                break;
+            case SDL_CONTROLLERDEVICEADDED:
+                if (mConListener)
+                    mConListener->controllerAdded(
+                        1, evt.cdevice); // We only support one joystick, so give everything a generic deviceID
+                break;
+            case SDL_CONTROLLERDEVICEREMOVED:
+                if (mConListener)
+                    mConListener->controllerRemoved(evt.cdevice);
+                break;
+            case SDL_CONTROLLERBUTTONDOWN:
+                if (mConListener)
+                    mConListener->buttonPressed(1, evt.cbutton);
+                break;
+            case SDL_CONTROLLERBUTTONUP:
+                if (mConListener)
+                    mConListener->buttonReleased(1, evt.cbutton);
+                break;
+            case SDL_CONTROLLERAXISMOTION:
+                if (mConListener)
+                    mConListener->axisMoved(1, evt.caxis);
+                break;
 #if SDL_VERSION_ATLEAST(2, 0, 14)
-                case SDL_CONTROLLERSENSORUPDATE:
-                    // controller sensor data is received on demand
-                    break;
-                case SDL_CONTROLLERTOUCHPADDOWN:
-                    mConListener->touchpadPressed(1, TouchEvent(evt.ctouchpad));
-                    break;
-                case SDL_CONTROLLERTOUCHPADMOTION:
-                    mConListener->touchpadMoved(1, TouchEvent(evt.ctouchpad));
-                    break;
-                case SDL_CONTROLLERTOUCHPADUP:
-                    mConListener->touchpadReleased(1, TouchEvent(evt.ctouchpad));
-                    break;
+            case SDL_CONTROLLERSENSORUPDATE:
+                // controller sensor data is received on demand
+                break;
+            case SDL_CONTROLLERTOUCHPADDOWN:
+                mConListener->touchpadPressed(1, TouchEvent(evt.ctouchpad));
+                break;
+            case SDL_CONTROLLERTOUCHPADMOTION:
+                mConListener->touchpadMoved(1, TouchEvent(evt.ctouchpad));
+                break;
+            case SDL_CONTROLLERTOUCHPADUP:
+                mConListener->touchpadReleased(1, TouchEvent(evt.ctouchpad));
+                break;
 #endif
-                case SDL_WINDOWEVENT:
-                    handleWindowEvent(evt);
-                    break;
-                case SDL_QUIT:
-                    if (mWindowListener)
-                        mWindowListener->windowClosed();
-                    break;
-                case SDL_DISPLAYEVENT:
-                    switch (evt.display.event)
-                    {
-                        case SDL_DISPLAYEVENT_ORIENTATION:
-                            if (mSensorListener
-                                && evt.display.display == static_cast<Uint32>(Settings::video().mScreen))
-                            {
-                                mSensorListener->displayOrientationChanged();
-                            }
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                case SDL_CLIPBOARDUPDATE:
-                    break; // We don't need this event, clipboard is retrieved on demand
-
-                case SDL_FINGERDOWN:
-                case SDL_FINGERUP:
-                case SDL_FINGERMOTION:
-                case SDL_DOLLARGESTURE:
-                case SDL_DOLLARRECORD:
-                case SDL_MULTIGESTURE:
-                    // No use for touch & gesture events
-                    break;
-
-                case SDL_APP_WILLENTERBACKGROUND:
-                case SDL_APP_WILLENTERFOREGROUND:
-                case SDL_APP_DIDENTERBACKGROUND:
-                case SDL_APP_DIDENTERFOREGROUND:
-                    // We do not need background/foreground switch event for mobile devices so far
-                    break;
-
-                case SDL_APP_TERMINATING:
-                    // There is nothing we can do here.
-                    break;
-
-                case SDL_APP_LOWMEMORY:
-                    Log(Debug::Warning) << "System reports that free RAM on device is running low. You may encounter "
-                                           "an unexpected behaviour.";
-                    break;
-
-                default:
-                    Log(Debug::Info) << "Unhandled SDL event of type 0x" << std::hex << evt.type;
-                    break;
-            }
+            case SDL_WINDOWEVENT:
+                handleWindowEvent(evt);
+                break;
+            case SDL_QUIT:
+                if (mWindowListener)
+                    mWindowListener->windowClosed();
+                break;
+            case SDL_DISPLAYEVENT:
+                switch (evt.display.event)
+                {
+                    case SDL_DISPLAYEVENT_ORIENTATION:
+                        if (mSensorListener
+                            && evt.display.display == static_cast<Uint32>(Settings::video().mScreen))
+                        {
+                            mSensorListener->displayOrientationChanged();
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case SDL_CLIPBOARDUPDATE:
+                break; // We don't need this event, clipboard is retrieved on demand
+
+            case SDL_FINGERDOWN:
+            case SDL_FINGERUP:
+            case SDL_FINGERMOTION:
+            case SDL_DOLLARGESTURE:
+            case SDL_DOLLARRECORD:
+            case SDL_MULTIGESTURE:
+                // No use for touch & gesture events
+                break;
+
+            case SDL_APP_WILLENTERBACKGROUND:
+            case SDL_APP_WILLENTERFOREGROUND:
+            case SDL_APP_DIDENTERBACKGROUND:
+            case SDL_APP_DIDENTERFOREGROUND:
+                // We do not need background/foreground switch event for mobile devices so far
+                break;
+
+            case SDL_APP_TERMINATING:
+                // There is nothing we can do here.
+                break;
+
+            case SDL_APP_LOWMEMORY:
+                Log(Debug::Warning) << "System reports that free RAM on device is running low. You may encounter "
+                                       "an unexpected behaviour.";
+                break;
+
+            default:
+                Log(Debug::Info) << "Unhandled SDL event of type 0x" << std::hex << evt.type;
+                break;
         }
     }
 
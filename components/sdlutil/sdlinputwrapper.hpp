@@ -15,6 +15,9 @@ namespace osgViewer
 
 namespace SDLUtil
 {
+    class InputRecorder;
+    class InputReplayer;
+
     /// \brief A wrapper around SDL's event queue, mostly used for handling input-related events.
     class InputWrapper
     {
@@ -28,6 +31,11 @@ namespace SDLUtil
         void setWindowEventCallback(WindowListener* listen) { mWindowListener = listen; }
         void setControllerEventCallback(ControllerListener* listen) { mConListener = listen; }
 
+        /// Receives the player input events processed by capture
+        void setInputRecorder(InputRecorder* recorder) { mRecorder = recorder; }
+        /// Provides the input events for capture instead of the player
+        void setInputReplayer(InputReplayer* replayer) { mReplayer = replayer; }
+
         void capture(bool windowEventsOnly);
         bool isModifierHeld(int mod);
         bool isKeyDown(SDL_Scancode key);
@@ -42,6 +50,7 @@ namespace SDLUtil
         void updateMouseSettings();
 
     private:
+        void handleEvent(const SDL_Event& evt);
         void handleWindowEvent(const SDL_Event& evt);
 
         bool _handleWarpMotion(const SDL_MouseMotionEvent& evt);
@@ -57,6 +66,8 @@ namespace SDLUtil
         KeyListener* mKeyboardListener;
         WindowListener* mWindowListener;
         ControllerListener* mConListener;
+        InputRecorder* mRecorder = nullptr;
+        InputReplayer* mReplayer = nullptr;
 
         Uint16 mWarpX;
         Uint16 mWarpY;
@@ -27,11 +27,16 @@ namespace Settings
         SettingValue<bool> mPreloadInstances{ mIndex, "Cells", "preload instances" };
         SettingValue<int> mPreloadCellCacheMin{ mIndex, "Cells", "preload cell cache min", makeMaxSanitizerInt(1) };
         SettingValue<int> mPreloadCellCacheMax{ mIndex, "Cells", "preload cell cache max", makeMaxSanitizerInt(1) };
+        SettingValue<int> mPreloadCellMemoryBudget{ mIndex, "Cells", "preload cell memory budget",
+            makeMaxSanitizerInt(0) };
         SettingValue<float> mPreloadCellExpiryDelay{ mIndex, "Cells", "preload cell expiry delay",
             makeMaxSanitizerFloat(0) };
         SettingValue<float> mPredictionTime{ mIndex, "Cells", "prediction time", makeMaxSanitizerFloat(0) };
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mCacheMemoryBudget{ mIndex, "Cells", "cache memory budget", makeMaxSanitizerInt(0) };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<float> mCompileTimeBudget{ mIndex, "Cells", "compile time budget", makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAttachTimeBudget{ mIndex, "Cells", "attach time budget", makeMaxSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
     };
 }
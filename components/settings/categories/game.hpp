@@ -29,6 +29,14 @@ namespace Settings
         // complete (bug #1876)
         SettingValue<int> mActorsProcessingRange{ mIndex, "Game", "actors processing range",
             makeClampSanitizerInt(3584, 7168) };
+        SettingValue<int> mAiFullRateDistance{ mIndex, "Game", "ai full rate distance", makeMaxSanitizerInt(0) };
+        SettingValue<int> mAiLowRateDistance{ mIndex, "Game", "ai low rate distance", makeMaxSanitizerInt(0) };
+        SettingValue<float> mSimulationTickRate{ mIndex, "Game", "simulation tick rate", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mAnimationFullRateDistance{ mIndex, "Game", "animation full rate distance",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mAnimationLowRateDistance{ mIndex, "Game", "animation low rate distance",
+            makeMaxSanitizerInt(0) };
+        SettingValue<bool> mMergeNpcBodyParts{ mIndex, "Game", "merge npc body parts" };
         SettingValue<bool> mClassicReflectedAbsorbSpellsBehavior{ mIndex, "Game",
             "classic reflected absorb spells behavior" };
         SettingValue<bool> mClassicCalmSpellsBehavior{ mIndex, "Game", "classic calm spells behavior" };
@@ -75,6 +83,7 @@ namespace Settings
         SettingValue<DetourNavigator::CollisionShapeType> mActorCollisionShapeType{ mIndex, "Game",
             "actor collision shape type" };
         SettingValue<bool> mPlayerMovementIgnoresAnimation{ mIndex, "Game", "player movement ignores animation" };
+        SettingValue<bool> mEventTriggeredLocalScripts{ mIndex, "Game", "event triggered local scripts" };
     };
 }
 
@@ -32,6 +32,13 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<bool> mMemoryMappedArchives{ mIndex, "General", "memory mapped archives" };
+        SettingValue<bool> mDataDirectoriesIndexCache{ mIndex, "General", "data directories index cache" };
+        SettingValue<int> mContentLoadingThreads{ mIndex, "General", "content loading threads", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mContentCache{ mIndex, "General", "content cache" };
+        SettingValue<bool> mCompressTextures{ mIndex, "General", "compress textures" };
+        SettingValue<bool> mScriptCache{ mIndex, "General", "script cache" };
+        SettingValue<bool> mPreloadScriptCache{ mIndex, "General", "preload script cache" };
     };
 }
 
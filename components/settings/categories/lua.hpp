@@ -21,12 +21,14 @@ namespace Settings
         SettingValue<bool> mLuaDebug{ mIndex, "Lua", "lua debug" };
         SettingValue<int> mLuaNumThreads{ mIndex, "Lua", "lua num threads", makeEnumSanitizerInt({ 0, 1 }) };
         SettingValue<bool> mLuaProfiler{ mIndex, "Lua", "lua profiler" };
+        SettingValue<std::uint64_t> mTraceFrames{ mIndex, "Lua", "trace frames" };
         SettingValue<std::uint64_t> mSmallAllocMaxSize{ mIndex, "Lua", "small alloc max size" };
         SettingValue<std::uint64_t> mMemoryLimit{ mIndex, "Lua", "memory limit" };
         SettingValue<bool> mLogMemoryUsage{ mIndex, "Lua", "log memory usage" };
         SettingValue<std::uint64_t> mInstructionLimitPerCall{ mIndex, "Lua", "instruction limit per call",
             makeMaxSanitizerUInt64(1001) };
         SettingValue<int> mGcStepsPerFrame{ mIndex, "Lua", "gc steps per frame", makeMaxSanitizerInt(0) };
+        SettingValue<int> mLocalScriptStates{ mIndex, "Lua", "local script states", makeClampSanitizerInt(0, 64) };
     };
 }
 
@@ -27,6 +27,8 @@ namespace Settings
         SettingValue<bool> mAllowZooming{ mIndex, "Map", "allow zooming" };
         SettingValue<int> mMaxLocalViewingDistance{ mIndex, "Map", "max local viewing distance",
             makeMaxSanitizerInt(Constants::CellGridRadius) };
+        SettingValue<int> mLocalMapSegmentsPerFrame{ mIndex, "Map", "local map segments per frame",
+            makeMaxSanitizerInt(0) };
     };
 }
 
@@ -42,6 +42,8 @@ namespace Settings
         SettingValue<std::string> mWeathersnow{ mIndex, "Models", "weathersnow" };
         SettingValue<std::string> mWeatherblizzard{ mIndex, "Models", "weatherblizzard" };
         SettingValue<bool> mWriteNifDebugLog{ mIndex, "Models", "write nif debug log" };
+        SettingValue<bool> mReadNifFilesIntoMemory{ mIndex, "Models", "read nif files into memory" };
+        SettingValue<bool> mCompactAnimationKeyframes{ mIndex, "Models", "compact animation keyframes" };
     };
 }
 
@@ -63,6 +63,14 @@ namespace Settings
         SettingValue<bool> mEnableNavMeshDiskCache{ mIndex, "Navigator", "enable nav mesh disk cache" };
         SettingValue<bool> mWriteToNavmeshdb{ mIndex, "Navigator", "write to navmeshdb" };
         SettingValue<std::uint64_t> mMaxNavmeshdbFileSize{ mIndex, "Navigator", "max navmeshdb file size" };
+        SettingValue<int> mMaxNavmeshdbTransactionWrites{ mIndex, "Navigator", "max navmeshdb transaction writes",
+            makeMaxSanitizerInt(1) };
+        SettingValue<int> mMaxNavmeshdbTransactionDurationMs{ mIndex, "Navigator",
+            "max navmeshdb transaction duration ms", makeMaxSanitizerInt(0) };
+        SettingValue<int> mJobPriorityLeadTimeMs{ mIndex, "Navigator", "job priority lead time ms",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mMaxPathCacheSize{ mIndex, "Navigator", "max path cache size", makeMaxSanitizerInt(0) };
+        SettingValue<float> mAgentBoundsStep{ mIndex, "Navigator", "agent bounds step", makeMaxSanitizerFloat(0) };
         SettingValue<bool> mWaitForAllJobsOnExit{ mIndex, "Navigator", "wait for all jobs on exit" };
     };
 }
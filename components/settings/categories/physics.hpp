@@ -21,6 +21,10 @@ namespace Settings
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<bool> mShapeCache{ mIndex, "Physics", "shape cache" };
+        SettingValue<float> mLodDistance{ mIndex, "Physics", "lod distance", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mLodStepInterval{ mIndex, "Physics", "lod step interval", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mActorSleeping{ mIndex, "Physics", "actor sleeping" };
     };
 }
 
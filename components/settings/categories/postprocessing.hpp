@@ -23,6 +23,13 @@ namespace Settings
         SettingValue<float> mAutoExposureSpeed{ mIndex, "Post Processing", "auto exposure speed",
             makeMaxStrictSanitizerFloat(0.0001f) };
         SettingValue<bool> mTransparentPostpass{ mIndex, "Post Processing", "transparent postpass" };
+        SettingValue<bool> mDynamicResolution{ mIndex, "Post Processing", "dynamic resolution" };
+        SettingValue<float> mDynamicResolutionTargetFrameTime{ mIndex, "Post Processing",
+            "dynamic resolution target frame time", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<float> mDynamicResolutionMinScale{ mIndex, "Post Processing", "dynamic resolution min scale",
+            makeClampSanitizerFloat(0.25f, 1) };
+        SettingValue<float> mDynamicResolutionMaxScale{ mIndex, "Post Processing", "dynamic resolution max scale",
+            makeClampSanitizerFloat(0.25f, 1) };
     };
 }
 
@@ -22,6 +22,8 @@ namespace Settings
         SettingValue<bool> mAutosave{ mIndex, "Saves", "autosave" };
         SettingValue<bool> mTimeplayed{ mIndex, "Saves", "timeplayed" };
         SettingValue<int> mMaxQuicksaves{ mIndex, "Saves", "max quicksaves", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mCompress{ mIndex, "Saves", "compress" };
+        SettingValue<bool> mLazyCellReferences{ mIndex, "Saves", "lazy cell references" };
     };
 }
 
@@ -42,6 +42,8 @@ namespace Settings
         SettingValue<bool> mTerrainShadows{ mIndex, "Shadows", "terrain shadows" };
         SettingValue<bool> mObjectShadows{ mIndex, "Shadows", "object shadows" };
         SettingValue<bool> mEnableIndoorShadows{ mIndex, "Shadows", "enable indoor shadows" };
+        SettingValue<bool> mCacheStaticShadows{ mIndex, "Shadows", "cache static shadows" };
+        SettingValue<bool> mSharedCasterCulling{ mIndex, "Shadows", "shared caster culling" };
     };
 }
 
@@ -26,6 +26,9 @@ namespace Settings
             makeMaxSanitizerInt(1) };
         SettingValue<float> mMaxCompositeGeometrySize{ mIndex, "Terrain", "max composite geometry size",
             makeMaxSanitizerFloat(1) };
+        SettingValue<bool> mCompositeMapCache{ mIndex, "Terrain", "composite map cache" };
+        SettingValue<bool> mTextureArrays{ mIndex, "Terrain", "texture arrays" };
+        SettingValue<bool> mVertexTextureFetch{ mIndex, "Terrain", "vertex texture fetch" };
         SettingValue<bool> mDebugChunks{ mIndex, "Terrain", "debug chunks" };
         SettingValue<bool> mObjectPaging{ mIndex, "Terrain", "object paging" };
         SettingValue<bool> mObjectPagingActiveGrid{ mIndex, "Terrain", "object paging active grid" };
@@ -37,6 +40,10 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mObjectPagingInstancing{ mIndex, "Terrain", "object paging instancing" };
+        SettingValue<int> mObjectPagingInstancingMinInstances{ mIndex, "Terrain",
+            "object paging instancing min instances", makeMaxSanitizerInt(2) };
+        SettingValue<bool> mAsyncLodSelection{ mIndex, "Terrain", "async lod selection" };
     };
 }
 
@@ -20,6 +20,7 @@ namespace Settings
 
         SettingValue<bool> mShader{ mIndex, "Water", "shader" };
         SettingValue<int> mRttSize{ mIndex, "Water", "rtt size", makeMaxSanitizerInt(1) };
+        SettingValue<int> mRttUpdateInterval{ mIndex, "Water", "rtt update interval", makeClampSanitizerInt(1, 4) };
         SettingValue<bool> mRefraction{ mIndex, "Water", "refraction" };
         SettingValue<int> mReflectionDetail{ mIndex, "Water", "reflection detail", makeClampSanitizerInt(0, 5) };
         SettingValue<int> mRainRippleDetail{ mIndex, "Water", "rain ripple detail", makeClampSanitizerInt(0, 2) };
@@ -0,0 +1,218 @@
+#include "programbinarycache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <osg/GLExtensions>
+#include <osg/State>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+namespace Shader
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'M', 'W', 'P', 'R', 'O', 'G', 'B' };
+        constexpr std::uint32_t sVersion = 1;
+
+        osg::ref_ptr<osg::ProgramBinary> readBinary(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+                return nullptr;
+
+            char magic[sizeof(sMagic)];
+            std::uint32_t version = 0;
+            std::uint32_t format = 0;
+            std::uint32_t size = 0;
+            if (!stream.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), sMagic)
+                || !stream.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != sVersion
+                || !stream.read(reinterpret_cast<char*>(&format), sizeof(format))
+                || !stream.read(reinterpret_cast<char*>(&size), sizeof(size)) || size == 0)
+            {
+                Log(Debug::Warning) << "Ignoring broken program binary " << path;
+                return nullptr;
+            }
+
+            osg::ref_ptr<osg::ProgramBinary> binary = new osg::ProgramBinary;
+            binary->allocate(size);
+            if (!stream.read(reinterpret_cast<char*>(binary->getData()), size))
+            {
+                Log(Debug::Warning) << "Ignoring truncated program binary " << path;
+                return nullptr;
+            }
+            binary->setFormat(format);
+            return binary;
+        }
+
+        void writeBinary(const std::filesystem::path& path, GLenum format, const std::vector<char>& data)
+        {
+            const std::uint32_t values[] = { sVersion, static_cast<std::uint32_t>(format),
+                static_cast<std::uint32_t>(data.size()) };
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+                throw std::runtime_error("failed to open file");
+            stream.write(sMagic, sizeof(sMagic));
+            stream.write(reinterpret_cast<const char*>(values), sizeof(values));
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!stream.flush())
+                throw std::runtime_error("failed to write file");
+        }
+    }
+
+    void ProgramBinaryCache::RetrieveCallback::operator()(osg::RenderInfo& renderInfo) const
+    {
+        mCache->retrieveBinaries(*renderInfo.getState());
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(const std::filesystem::path& directory, const std::string& driver)
+        : mDirectory(directory)
+        , mDriver(driver)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mDirectory, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to create program binary cache directory " << mDirectory << ": "
+                                << ec.message();
+    }
+
+    std::filesystem::path ProgramBinaryCache::getPath(const osg::Program& program) const
+    {
+        // Anything affecting the result of the link has to be a part of the key
+        std::string key = mDriver;
+        for (unsigned int i = 0; i < program.getNumShaders(); ++i)
+        {
+            const osg::Shader* shader = program.getShader(i);
+            key += '\n';
+            key += std::to_string(shader->getType());
+            key += '\n';
+            key += shader->getShaderSource();
+        }
+        for (const auto& [name, index] : program.getAttribBindingList())
+            key += "\nattrib " + name + ' ' + std::to_string(index);
+        for (const auto& [name, index] : program.getFragDataBindingList())
+            key += "\nfragdata " + name + ' ' + std::to_string(index);
+
+        const std::array<std::uint64_t, 2> hash = Files::getHash(key);
+        std::ostringstream fileName;
+        fileName << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1] << ".bin";
+        return mDirectory / fileName.str();
+    }
+
+    void ProgramBinaryCache::addProgram(osg::Program& program)
+    {
+        std::filesystem::path path = getPath(program);
+        osg::ref_ptr<osg::ProgramBinary> binary = readBinary(path);
+        program.setProgramBinary(binary);
+
+        const std::lock_guard lock(mMutex);
+        const auto it = std::find_if(
+            mPending.begin(), mPending.end(), [&](const Entry& entry) { return entry.mProgram == &program; });
+        Entry entry{ &program, std::move(path), binary != nullptr };
+        if (it == mPending.end())
+            mPending.push_back(std::move(entry));
+        else
+            *it = std::move(entry);
+    }
+
+    void ProgramBinaryCache::retrieveBinaries(osg::State& state)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mPending.empty())
+            return;
+
+        const osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        if (!ext->isGetProgramBinarySupported)
+        {
+            for (const Entry& entry : mPending)
+                entry.mProgram->setProgramBinary(nullptr);
+            mPending.clear();
+            return;
+        }
+
+        auto it = mPending.begin();
+        while (it != mPending.end())
+        {
+            osg::Program::PerContextProgram* pcp = it->mProgram->getPCP(state);
+            if (pcp == nullptr || pcp->needsLink())
+            {
+                ++it;
+                continue;
+            }
+
+            if (!pcp->isLinked())
+            {
+                // A driver update may have made the stored binary unusable without changing its identification
+                if (it->mLoaded)
+                {
+                    Log(Debug::Warning) << "Failed to load program binary " << it->mPath
+                                        << ", linking it from the sources";
+                    std::error_code ec;
+                    std::filesystem::remove(it->mPath, ec);
+                    it->mProgram->setProgramBinary(nullptr);
+                    it->mProgram->dirtyProgram();
+                    it->mLoaded = false;
+                    ++it;
+                    continue;
+                }
+                it = mPending.erase(it);
+                continue;
+            }
+
+            if (!it->mLoaded)
+            {
+                const GLuint handle = pcp->getHandle();
+                GLint length = 0;
+                ext->glGetProgramiv(handle, GL_PROGRAM_BINARY_LENGTH, &length);
+                if (length > 0)
+                {
+                    Binary binary{ it->mPath, 0, std::vector<char>(length) };
+                    GLsizei written = 0;
+                    ext->glGetProgramBinary(handle, length, &written, &binary.mFormat, binary.mData.data());
+                    binary.mData.resize(std::max(written, 0));
+                    if (!binary.mData.empty())
+                        mRetrieved.push_back(std::move(binary));
+                }
+            }
+            it = mPending.erase(it);
+        }
+    }
+
+    void ProgramBinaryCache::write()
+    {
+        std::vector<Binary> retrieved;
+        {
+            const std::lock_guard lock(mMutex);
+            if (mRetrieved.empty())
+                return;
+            retrieved.swap(mRetrieved);
+        }
+
+        for (const Binary& binary : retrieved)
+        {
+            std::filesystem::path tmpPath = binary.mPath;
+            tmpPath += ".tmp";
+            try
+            {
+                writeBinary(tmpPath, binary.mFormat, binary.mData);
+                std::filesystem::rename(tmpPath, binary.mPath);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write program binary " << binary.mPath << ": " << e.what();
+                std::error_code ec;
+                std::filesystem::remove(tmpPath, ec);
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+#define OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osg/Camera>
+#include <osg/Program>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+namespace Shader
+{
+    /// @brief Stores the binaries of linked programs on disk so that the driver doesn't have to compile and link the
+    /// same shaders again on the next start.
+    /// @par The binaries are keyed by the hash of the sources and bindings of the program and the OpenGL driver. A
+    /// stored binary the driver refuses to load is removed and the program is linked from its sources instead.
+    class ProgramBinaryCache : public osg::Referenced
+    {
+    public:
+        /// Retrieves the binaries of the programs linked by the previous frames.
+        class RetrieveCallback : public osg::Camera::DrawCallback
+        {
+        public:
+            explicit RetrieveCallback(osg::ref_ptr<ProgramBinaryCache> cache)
+                : mCache(std::move(cache))
+            {
+            }
+
+            void operator()(osg::RenderInfo& renderInfo) const override;
+
+        private:
+            osg::ref_ptr<ProgramBinaryCache> mCache;
+        };
+
+        /// @param driver Identifies the OpenGL implementation, the binaries of other implementations aren't used.
+        ProgramBinaryCache(const std::filesystem::path& directory, const std::string& driver);
+
+        /// Attach the stored binary to the program or retrieve the binary once the program is linked if there is none.
+        /// @note Call again after changing the shaders of the program and before linking it.
+        /// @note Thread safe.
+        void addProgram(osg::Program& program);
+
+        /// @note Call from the draw thread.
+        void retrieveBinaries(osg::State& state);
+
+        /// Write the retrieved binaries. Failures are logged and ignored.
+        void write();
+
+    private:
+        struct Entry
+        {
+            osg::ref_ptr<osg::Program> mProgram;
+            std::filesystem::path mPath;
+            bool mLoaded;
+        };
+
+        struct Binary
+        {
+            std::filesystem::path mPath;
+            GLenum mFormat;
+            std::vector<char> mData;
+        };
+
+        std::filesystem::path getPath(const osg::Program& program) const;
+
+        std::filesystem::path mDirectory;
+        std::string mDriver;
+        std::mutex mMutex;
+        std::vector<Entry> mPending;
+        std::vector<Binary> mRetrieved;
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "shadermanager.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <components/debug/debuglog.hpp>
@@ -18,6 +19,8 @@
 #include <sstream>
 #include <unordered_map>
 
+#include "programbinarycache.hpp"
+
 namespace
 {
     osg::Shader::Type getShaderType(const std::string& templateName)
@@ -513,6 +516,7 @@ namespace Shader
                         }
                         shaderIt->second->setShaderSource(shaderSource);
                     }
+                    Manager.updateProgramBinaries();
                 }
             }
             if (threadsRunningToStop)
@@ -559,45 +563,64 @@ namespace Shader
         }
 
         ShaderMap::iterator shaderIt = mShaders.find(std::make_pair(templateName, defines));
-        if (shaderIt == mShaders.end())
-        {
-            std::string shaderSource = templateIt->second;
-            std::vector<std::string> linkedShaderNames;
-            if (!createSourceFromTemplate(shaderSource, linkedShaderNames, templateName, defines))
-            {
-                // Add to the cache anyway to avoid logging the same error over and over.
-                mShaders.insert(std::make_pair(std::make_pair(templateName, defines), nullptr));
-                return nullptr;
-            }
+        if (shaderIt != mShaders.end())
+            return shaderIt->second;
 
-            osg::ref_ptr<osg::Shader> shader(new osg::Shader(type ? *type : getShaderType(templateName)));
-            shader->setShaderSource(shaderSource);
-            // Assign a unique prefix to allow the SharedStateManager to compare shaders efficiently.
-            // Append shader source filename for debugging.
-            static unsigned int counter = 0;
-            shader->setName(Misc::StringUtils::format("%u %s", counter++, templateName));
+        // Expand the template without holding the lock, loader threads request many permutations at once
+        std::string shaderSource = templateIt->second;
+        lock.unlock();
 
-            mHotReloadManager->addShaderFiles(templateName, defines);
-
-            lock.unlock();
-            getLinkedShaders(shader, linkedShaderNames, defines);
+        std::vector<std::string> linkedShaderNames;
+        if (!createSourceFromTemplate(shaderSource, linkedShaderNames, templateName, defines))
+        {
+            // Add to the cache anyway to avoid logging the same error over and over.
             lock.lock();
+            mShaders.emplace(std::make_pair(templateName, defines), nullptr);
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::Shader> shader(new osg::Shader(type ? *type : getShaderType(templateName)));
+        shader->setShaderSource(shaderSource);
+        // Assign a unique prefix to allow the SharedStateManager to compare shaders efficiently.
+        // Append shader source filename for debugging.
+        static std::atomic<unsigned int> counter = 0;
+        shader->setName(Misc::StringUtils::format("%u %s", counter++, templateName));
+
+        ShaderList linkedShaders = getLinkedShaders(shader->getType(), linkedShaderNames, defines);
 
-            shaderIt = mShaders.insert(std::make_pair(std::make_pair(templateName, defines), shader)).first;
+        lock.lock();
+        // Another thread may have created the same permutation meanwhile, everyone has to use the same shader
+        const auto [inserted, isNew] = mShaders.emplace(std::make_pair(templateName, defines), shader);
+        if (isNew)
+        {
+            setLinkedShaders(shader, std::move(linkedShaders));
+            mHotReloadManager->addShaderFiles(templateName, defines);
         }
-        return shaderIt->second;
+        return inserted->second;
     }
 
     osg::ref_ptr<osg::Program> ShaderManager::getProgram(
         const std::string& templateName, const DefineMap& defines, const osg::Program* programTemplate)
     {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const auto it = mProgramsBySignature.find(std::pair<const std::string&, const DefineMap&>(
+                templateName, defines));
+            if (it != mProgramsBySignature.end())
+                return it->second;
+        }
+
         auto vert = getShader(templateName + ".vert", defines);
         auto frag = getShader(templateName + ".frag", defines);
 
         if (!vert || !frag)
             throw std::runtime_error("failed initializing shader: " + templateName);
 
-        return getProgram(std::move(vert), std::move(frag), programTemplate);
+        osg::ref_ptr<osg::Program> program = getProgram(std::move(vert), std::move(frag), programTemplate);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mProgramsBySignature.emplace(std::make_pair(templateName, defines), program);
+        return program;
     }
 
     osg::ref_ptr<osg::Program> ShaderManager::getProgram(osg::ref_ptr<osg::Shader> vertexShader,
@@ -615,6 +638,8 @@ namespace Shader
             program->addShader(fragmentShader);
             addLinkedShaders(vertexShader, program);
             addLinkedShaders(fragmentShader, program);
+            if (mProgramBinaryCache)
+                mProgramBinaryCache->addProgram(*program);
 
             found = mPrograms.insert(std::make_pair(std::make_pair(vertexShader, fragmentShader), program)).first;
         }
@@ -654,8 +679,9 @@ namespace Shader
                 continue;
             shader->setShaderSource(shaderSource);
 
-            getLinkedShaders(shader, linkedShaderNames, defines);
+            setLinkedShaders(shader, getLinkedShaders(shader->getType(), linkedShaderNames, defines));
         }
+        updateProgramBinaries();
     }
 
     void ShaderManager::releaseGLObjects(osg::State* state)
@@ -670,6 +696,21 @@ namespace Shader
             program->releaseGLObjects(state);
     }
 
+    void ShaderManager::setProgramBinaryCache(osg::ref_ptr<ProgramBinaryCache> cache)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mProgramBinaryCache = std::move(cache);
+        updateProgramBinaries();
+    }
+
+    void ShaderManager::updateProgramBinaries()
+    {
+        if (!mProgramBinaryCache)
+            return;
+        for (const auto& [_, program] : mPrograms)
+            mProgramBinaryCache->addProgram(*program);
+    }
+
     bool ShaderManager::createSourceFromTemplate(std::string& source,
         std::vector<std::string>& linkedShaderTemplateNames, const std::string& templateName,
         const ShaderManager::DefineMap& defines)
@@ -681,19 +722,25 @@ namespace Shader
         return true;
     }
 
-    void ShaderManager::getLinkedShaders(
-        osg::ref_ptr<osg::Shader> shader, const std::vector<std::string>& linkedShaderNames, const DefineMap& defines)
+    ShaderManager::ShaderList ShaderManager::getLinkedShaders(
+        osg::Shader::Type type, const std::vector<std::string>& linkedShaderNames, const DefineMap& defines)
     {
-        mLinkedShaders.erase(shader);
-        if (linkedShaderNames.empty())
-            return;
-
+        ShaderList result;
         for (auto& linkedShaderName : linkedShaderNames)
         {
-            auto linkedShader = getShader(linkedShaderName, defines, shader->getType());
+            auto linkedShader = getShader(linkedShaderName, defines, type);
             if (linkedShader)
-                mLinkedShaders[shader].emplace_back(linkedShader);
+                result.emplace_back(std::move(linkedShader));
         }
+        return result;
+    }
+
+    void ShaderManager::setLinkedShaders(osg::ref_ptr<osg::Shader> shader, ShaderList&& linkedShaders)
+    {
+        if (linkedShaders.empty())
+            mLinkedShaders.erase(shader);
+        else
+            mLinkedShaders[shader] = std::move(linkedShaders);
     }
 
     void ShaderManager::addLinkedShaders(osg::ref_ptr<osg::Shader> shader, osg::ref_ptr<osg::Program> program)
@@ -733,6 +780,12 @@ namespace Shader
             case Slot::ShadowMaps:
                 slotDescr = "shadow maps";
                 break;
+            case Slot::MorphOffsets:
+                slotDescr = "morph offsets";
+                break;
+            case Slot::LightClusters:
+                slotDescr = "light clusters";
+                break;
             default:
                 slotDescr = "UNKNOWN";
         }
@@ -748,6 +801,8 @@ namespace Shader
     void ShaderManager::update(osgViewer::Viewer& viewer)
     {
         mHotReloadManager->update(*this, viewer);
+        if (mProgramBinaryCache)
+            mProgramBinaryCache->write();
     }
 
     void ShaderManager::setHotReloadEnabled(bool value)
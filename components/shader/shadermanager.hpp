@@ -7,6 +7,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <osg/ref_ptr>
@@ -23,6 +24,8 @@ namespace osgViewer
 namespace Shader
 {
     struct HotReloadManager;
+    class ProgramBinaryCache;
+
     /// @brief Reads shader template files and turns them into a concrete shader, based on a list of define's.
     /// @par Shader templates can get the value of a define with the syntax @define.
     class ShaderManager
@@ -69,6 +72,10 @@ namespace Shader
 
         void releaseGLObjects(osg::State* state);
 
+        /// Use the stored binaries of the programs instead of linking them from the sources when possible.
+        /// @note The retrieved binaries are written by update().
+        void setProgramBinaryCache(osg::ref_ptr<ProgramBinaryCache> cache);
+
         bool createSourceFromTemplate(std::string& source, std::vector<std::string>& linkedShaderTemplateNames,
             const std::string& templateName, const ShaderManager::DefineMap& defines);
 
@@ -81,6 +88,8 @@ namespace Shader
             OpaqueDepthTexture,
             SkyTexture,
             ShadowMaps,
+            MorphOffsets,
+            LightClusters,
             SLOT_COUNT
         };
 
@@ -91,9 +100,13 @@ namespace Shader
         void triggerShaderReload();
 
     private:
-        void getLinkedShaders(osg::ref_ptr<osg::Shader> shader, const std::vector<std::string>& linkedShaderNames,
-            const DefineMap& defines);
+        typedef std::vector<osg::ref_ptr<osg::Shader>> ShaderList;
+
+        ShaderList getLinkedShaders(
+            osg::Shader::Type type, const std::vector<std::string>& linkedShaderNames, const DefineMap& defines);
+        void setLinkedShaders(osg::ref_ptr<osg::Shader> shader, ShaderList&& linkedShaders);
         void addLinkedShaders(osg::ref_ptr<osg::Shader> shader, osg::ref_ptr<osg::Program> program);
+        void updateProgramBinaries();
 
         std::filesystem::path mPath;
 
@@ -111,7 +124,21 @@ namespace Shader
             ProgramMap;
         ProgramMap mPrograms;
 
-        typedef std::vector<osg::ref_ptr<osg::Shader>> ShaderList;
+        struct SignatureLess
+        {
+            using is_transparent = void;
+
+            template <class L, class R>
+            bool operator()(const L& l, const R& r) const
+            {
+                return std::tie(l.first, l.second) < std::tie(r.first, r.second);
+            }
+        };
+
+        // Programs by the template name and defines they were requested with, most materials share few signatures
+        typedef std::map<MapKey, osg::ref_ptr<osg::Program>, SignatureLess> ProgramsBySignatureMap;
+        ProgramsBySignatureMap mProgramsBySignature;
+
         typedef std::map<osg::ref_ptr<osg::Shader>, ShaderList> LinkedShadersMap;
         LinkedShadersMap mLinkedShaders;
 
@@ -122,6 +149,7 @@ namespace Shader
         int mMaxTextureUnits = 0;
         int mReservedTextureUnits = 0;
         std::unique_ptr<HotReloadManager> mHotReloadManager;
+        osg::ref_ptr<ProgramBinaryCache> mProgramBinaryCache;
         struct ReservedTextureUnits
         {
             int index = -1;
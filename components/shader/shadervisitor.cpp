@@ -189,6 +189,8 @@ namespace Shader
         , mReconstructNormalZ(false)
         , mTexStageRequiringTangents(-1)
         , mSoftParticles(false)
+        , mSkinning(false)
+        , mMorphOffsets(nullptr)
         , mNode(nullptr)
     {
     }
@@ -230,6 +232,14 @@ namespace Shader
             popRequirements();
     }
 
+    bool gpuMorphingSupported()
+    {
+        if (!SceneUtil::glExtensionsReady())
+            return false;
+        const osg::GLExtensions& extensions = SceneUtil::getGLExtensions();
+        return extensions.isGpuShader4Supported && extensions.isTBOSupported;
+    }
+
     osg::StateSet* getWritableStateSet(osg::Node& node)
     {
         if (!node.getStateSet())
@@ -716,6 +726,10 @@ namespace Shader
         node.getUserValue("particleOcclusion", particleOcclusion);
         defineMap["particleOcclusion"] = particleOcclusion && mWeatherParticleOcclusion ? "1" : "0";
 
+        bool instancing = false;
+        node.getUserValue("instancing", instancing);
+        defineMap["instancing"] = instancing ? "1" : "0";
+
         if (reqs.mAlphaBlend && mSupportsNormalsRT)
         {
             if (reqs.mSoftParticles)
@@ -753,6 +767,19 @@ namespace Shader
         }
 
         defineMap["softParticles"] = reqs.mSoftParticles ? "1" : "0";
+        defineMap["skinning"] = reqs.mSkinning ? "1" : "0";
+
+        defineMap["morphing"] = reqs.mMorphOffsets != nullptr ? "1" : "0";
+        if (reqs.mMorphOffsets != nullptr)
+        {
+            // samplerBuffer, texelFetchBuffer and gl_VertexID come from EXT_gpu_shader4
+            defineMap["useGPUShader4"] = "1";
+            const int unit = mShaderManager.reserveGlobalTextureUnits(ShaderManager::Slot::MorphOffsets);
+            writableStateSet->setTextureAttribute(unit, reqs.mMorphOffsets, osg::StateAttribute::ON);
+            addedState->setTextureAttribute(unit, reqs.mMorphOffsets);
+            writableStateSet->addUniform(new osg::Uniform("morphOffsets", unit));
+            addedState->addUniform("morphOffsets");
+        }
 
         Stereo::shaderStereoDefines(defineMap);
 
@@ -760,7 +787,8 @@ namespace Shader
         if (!node.getUserValue("shaderPrefix", shaderPrefix))
             shaderPrefix = mDefaultShaderPrefix;
 
-        auto program = mShaderManager.getProgram(shaderPrefix, defineMap, mProgramTemplate);
+        auto program = mShaderManager.getProgram(
+            shaderPrefix, defineMap, reqs.mSkinning ? getSkinningProgramTemplate() : mProgramTemplate.get());
         writableStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
         addedState->setAttributeAndModes(std::move(program));
 
@@ -783,6 +811,20 @@ namespace Shader
         }
     }
 
+    const osg::Program* ShaderVisitor::getSkinningProgramTemplate()
+    {
+        if (mSkinningProgramTemplate == nullptr)
+        {
+            const osg::Program* base = mProgramTemplate ? mProgramTemplate.get() : mShaderManager.getProgramTemplate();
+            osg::ref_ptr<osg::Program> program
+                = base ? mShaderManager.cloneProgram(base) : osg::ref_ptr<osg::Program>(new osg::Program);
+            program->addBindAttribLocation("boneIndices", SceneUtil::RigGeometry::sBoneIndicesAttribute);
+            program->addBindAttribLocation("boneWeights", SceneUtil::RigGeometry::sBoneWeightsAttribute);
+            mSkinningProgramTemplate = std::move(program);
+        }
+        return mSkinningProgramTemplate.get();
+    }
+
     void ShaderVisitor::ensureFFP(osg::Node& node)
     {
         if (!node.getStateSet() || !node.getStateSet()->getAttribute(osg::StateAttribute::PROGRAM))
@@ -911,6 +953,11 @@ namespace Shader
     void ShaderVisitor::apply(osg::Geometry& geometry)
     {
         bool needPop = geometry.getStateSet() || mRequirements.empty();
+
+        // Instanced geometry needs own shader variant
+        bool instancing = false;
+        if (!needPop && geometry.getUserValue("instancing", instancing) && instancing)
+            needPop = true;
         if (needPop)
             pushRequirements(geometry);
 
@@ -941,6 +988,21 @@ namespace Shader
         if (!needPop && dynamic_cast<osgParticle::ParticleSystem*>(&drawable))
             needPop = true;
 
+        // Skinned drawables need own shader variant as well
+        auto rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable);
+        if (rig != nullptr && mAllowedToModifyStateSets)
+            rig->setGpuSkinning(mGpuSkinning);
+        const bool gpuSkinning = rig != nullptr && rig->getGpuSkinning();
+        if (gpuSkinning)
+            needPop = true;
+
+        auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable);
+        if (morph != nullptr && mAllowedToModifyStateSets)
+            morph->setGpuMorphing(mGpuMorphing && gpuMorphingSupported());
+        const bool gpuMorphing = morph != nullptr && morph->getGpuMorphing();
+        if (gpuMorphing)
+            needPop = true;
+
         if (needPop)
         {
             pushRequirements(drawable);
@@ -949,16 +1011,27 @@ namespace Shader
                 applyStateSet(drawable.getStateSet(), drawable);
         }
 
+        if (gpuSkinning)
+        {
+            mRequirements.back().mSkinning = true;
+            mRequirements.back().mShaderRequired = true;
+        }
+        if (gpuMorphing)
+        {
+            mRequirements.back().mMorphOffsets = morph->getMorphOffsets();
+            mRequirements.back().mShaderRequired = true;
+        }
+
         const ShaderRequirements& reqs = mRequirements.back();
         createProgram(reqs);
 
-        if (auto rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable))
+        if (rig != nullptr)
         {
             osg::ref_ptr<osg::Geometry> sourceGeometry = rig->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
                 rig->setSourceGeometry(std::move(sourceGeometry));
         }
-        else if (auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable))
+        else if (morph != nullptr)
         {
             osg::ref_ptr<osg::Geometry> sourceGeometry = morph->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
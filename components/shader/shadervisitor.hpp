@@ -53,6 +53,12 @@ namespace Shader
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        /// Do the skinning of the encountered RigGeometries in the vertex shader when their bone count allows it.
+        void setGpuSkinning(bool value) { mGpuSkinning = value; }
+
+        /// Apply the morph targets of the encountered MorphGeometries in the vertex shader when supported.
+        void setGpuMorphing(bool value) { mGpuMorphing = value; }
+
         void apply(osg::Node& node) override;
 
         void apply(osg::Drawable& drawable) override;
@@ -81,6 +87,8 @@ namespace Shader
 
         bool mSupportsNormalsRT;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
 
         ShaderManager& mShaderManager;
         Resource::ImageManager& mImageManager;
@@ -117,6 +125,11 @@ namespace Shader
 
             bool mSoftParticles;
 
+            bool mSkinning;
+
+            // buffer texture of a GPU morphed MorphGeometry
+            osg::Texture* mMorphOffsets;
+
             // the Node that requested these requirements
             osg::Node* mNode;
         };
@@ -129,6 +142,9 @@ namespace Shader
         bool adjustGeometry(osg::Geometry& sourceGeometry, const ShaderRequirements& reqs);
 
         osg::ref_ptr<const osg::Program> mProgramTemplate;
+        osg::ref_ptr<const osg::Program> mSkinningProgramTemplate;
+
+        const osg::Program* getSkinningProgramTemplate();
     };
 
     class ReinstateRemovedStateVisitor : public osg::NodeVisitor
@@ -16,8 +16,9 @@ namespace Sqlite3
     Db makeDb(std::string_view path, const char* schema)
     {
         sqlite3* handle = nullptr;
-        // All uses of NavMeshDb are protected by a mutex (navmeshtool) or serialized in a single thread (DbWorker)
-        // so additional synchronization between threads is not required and SQLITE_OPEN_NOMUTEX can be used.
+        // All uses of NavMeshDb are protected by a mutex (navmeshtool) or serialized in a single thread (DbWorker, each
+        // navmesh updater thread for its read-only connection) so additional synchronization between threads is not
+        // required and SQLITE_OPEN_NOMUTEX can be used.
         // This is unsafe to use NavMeshDb without external synchronization because of internal state.
         const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
         if (const int ec = sqlite3_open_v2(std::string(path).c_str(), &handle, flags, nullptr); ec != SQLITE_OK)
@@ -31,4 +32,17 @@ namespace Sqlite3
             throw std::runtime_error("Failed create database schema: " + std::string(sqlite3_errmsg(handle)));
         return result;
     }
+
+    Db makeReadOnlyDb(std::string_view path)
+    {
+        sqlite3* handle = nullptr;
+        const int flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+        if (const int ec = sqlite3_open_v2(std::string(path).c_str(), &handle, flags, nullptr); ec != SQLITE_OK)
+        {
+            const std::string message(sqlite3_errmsg(handle));
+            sqlite3_close(handle);
+            throw std::runtime_error("Failed to open database: " + message);
+        }
+        return Db(handle);
+    }
 }
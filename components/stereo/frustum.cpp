@@ -95,9 +95,12 @@ namespace Stereo
             mMultiviewFrustumCallback = std::make_unique<MultiviewFrustumCallback>(this, camera);
         }
 
+        // Multiview culls both views at once, so the shadow maps have to fit the combined frustum either way
+        if (sharedShadowMaps || Stereo::getMultiview())
+            mShadowFrustumCallback = new ShadowFrustumCallback(this);
+
         if (sharedShadowMaps)
         {
-            mShadowFrustumCallback = new ShadowFrustumCallback(this);
             auto* renderer = static_cast<osgViewer::Renderer*>(mCamera->getRenderer());
             for (auto* sceneView : { renderer->getSceneView(0), renderer->getSceneView(1) })
             {
@@ -206,6 +206,31 @@ namespace Terrain
         return uvs;
     }
 
+    osg::ref_ptr<osg::Vec3Array> BufferCache::getGridBuffer(unsigned int numVerts, float size)
+    {
+        std::lock_guard<std::mutex> lock(mGridBufferMutex);
+        osg::ref_ptr<osg::Vec3Array>& grid = mGridBufferMap[std::make_pair(numVerts, size)];
+        if (grid != nullptr)
+            return grid;
+
+        grid = new osg::Vec3Array(osg::Array::BIND_PER_VERTEX);
+        grid->reserve(numVerts * numVerts);
+
+        // Same layout as the positions filled by Storage::fillVertexBuffers
+        for (unsigned int col = 0; col < numVerts; ++col)
+        {
+            for (unsigned int row = 0; row < numVerts; ++row)
+            {
+                grid->push_back(osg::Vec3f((col / static_cast<float>(numVerts - 1) - 0.5f) * size,
+                    (row / static_cast<float>(numVerts - 1) - 0.5f) * size, 0.f));
+            }
+        }
+
+        grid->setVertexBufferObject(new osg::VertexBufferObject);
+
+        return grid;
+    }
+
     osg::ref_ptr<osg::DrawElements> BufferCache::getIndexBuffer(unsigned int numVerts, unsigned int flags)
     {
         std::pair<int, int> id = std::make_pair(numVerts, flags);
@@ -240,6 +265,10 @@ namespace Terrain
             std::lock_guard<std::mutex> lock(mUvBufferMutex);
             mUvBufferMap.clear();
         }
+        {
+            std::lock_guard<std::mutex> lock(mGridBufferMutex);
+            mGridBufferMap.clear();
+        }
     }
 
     void BufferCache::releaseGLObjects(osg::State* state)
@@ -254,6 +283,11 @@ namespace Terrain
             for (const auto& [_, uvbuffer] : mUvBufferMap)
                 uvbuffer->releaseGLObjects(state);
         }
+        {
+            std::lock_guard<std::mutex> lock(mGridBufferMutex);
+            for (const auto& [_, gridbuffer] : mGridBufferMap)
+                gridbuffer->releaseGLObjects(state);
+        }
     }
 
 }
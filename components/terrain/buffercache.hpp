@@ -23,6 +23,11 @@ namespace Terrain
         /// @note Thread safe.
         osg::ref_ptr<osg::Vec2Array> getUVBuffer(unsigned int numVerts);
 
+        /// Flat vertex grid for chunks sampling their heights from a texture.
+        /// @param size chunk size in world units
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Vec3Array> getGridBuffer(unsigned int numVerts, float size);
+
         void clearCache();
 
         void releaseGLObjects(osg::State* state);
@@ -35,6 +40,9 @@ namespace Terrain
 
         std::map<int, osg::ref_ptr<osg::Vec2Array>> mUvBufferMap;
         std::mutex mUvBufferMutex;
+
+        std::map<std::pair<unsigned int, float>, osg::ref_ptr<osg::Vec3Array>> mGridBufferMap;
+        std::mutex mGridBufferMutex;
     };
 
 }
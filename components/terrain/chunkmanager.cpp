@@ -1,23 +1,110 @@
 #include "chunkmanager.hpp"
 
+#include <osg/ClusterCullingCallback>
 #include <osg/Material>
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
+#include <components/sceneutil/glextensions.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
 #include "storage.hpp"
 #include "terraindrawable.hpp"
 #include "texturemanager.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 namespace Terrain
 {
+    namespace
+    {
+        // Every layer of a texture array pass is sampled by all the fragments of the chunk
+        constexpr std::size_t maxTextureArrayLayers = 16;
+
+        template <class T>
+        void appendValue(std::string& data, const T& value)
+        {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        bool isVertexTextureFetchSupported()
+        {
+            // Float textures sampled in the vertex shader
+            return SceneUtil::glExtensionsReady() && SceneUtil::getGLExtensions().glVersion >= 3.f;
+        }
+
+        osg::ref_ptr<osg::Texture2D> createVertexTexture(osg::Image* image)
+        {
+            osg::ref_ptr<osg::Texture2D> texture(new osg::Texture2D(image));
+            texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+            texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+            texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            texture->setResizeNonPowerOfTwoHint(false);
+            texture->setUnRefImageDataAfterApply(true);
+            return texture;
+        }
+
+        // Texel (s, t) holds the vertex t * numVerts + s
+        osg::ref_ptr<TerrainDrawable::VertexTextures> createVertexTextures(unsigned int numVerts,
+            osg::DrawElements* indexBuffer, float waterBoundingBoxMargin, osg::Vec3Array* positions,
+            osg::Vec3Array* normals, const osg::Vec4ubArray& colors)
+        {
+            const int size = static_cast<int>(numVerts);
+
+            osg::ref_ptr<osg::Image> heights(new osg::Image);
+            heights->allocateImage(size, size, 1, GL_RED, GL_FLOAT);
+            heights->setInternalTextureFormat(GL_R32F);
+            float* const heightData = reinterpret_cast<float*>(heights->data());
+
+            osg::ref_ptr<osg::Image> normalMap(new osg::Image);
+            normalMap->allocateImage(size, size, 1, GL_RGB, GL_UNSIGNED_BYTE);
+            normalMap->setInternalTextureFormat(GL_RGB8);
+            unsigned char* const normalData = normalMap->data();
+
+            for (std::size_t i = 0; i < positions->size(); ++i)
+            {
+                heightData[i] = (*positions)[i].z();
+                for (std::size_t j = 0; j < 3; ++j)
+                    normalData[i * 3 + j] = static_cast<unsigned char>(
+                        std::clamp(((*normals)[i][j] * 0.5f + 0.5f) * 255.f + 0.5f, 0.f, 255.f));
+            }
+
+            osg::ref_ptr<osg::Image> colorMap(new osg::Image);
+            colorMap->allocateImage(size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            colorMap->setInternalTextureFormat(GL_RGBA8);
+            std::copy_n(reinterpret_cast<const unsigned char*>(colors.getDataPointer()), colors.getTotalDataSize(),
+                colorMap->data());
+
+            // Let the drawable compute what depends on the actual vertices
+            osg::ref_ptr<TerrainDrawable> source(new TerrainDrawable);
+            source->setVertexArray(positions);
+            source->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+            source->addPrimitiveSet(indexBuffer);
+            source->createClusterCullingCallback();
+            source->setupWaterBoundingBox(-1, waterBoundingBoxMargin);
+
+            osg::ref_ptr<TerrainDrawable::VertexTextures> vertexTextures(new TerrainDrawable::VertexTextures);
+            vertexTextures->mStateSet = createVertexTexturesStateSet(createVertexTexture(heights),
+                createVertexTexture(normalMap), createVertexTexture(colorMap), numVerts);
+            vertexTextures->mBoundingBox = source->getBoundingBox();
+            vertexTextures->mWaterBoundingBox = source->getWaterBoundingBox();
+            vertexTextures->mClusterCullingCallback = source->getClusterCullingCallback();
+            return vertexTextures;
+        }
+    }
 
     ChunkManager::ChunkManager(Storage* storage, Resource::SceneManager* sceneMgr, TextureManager* textureManager,
         CompositeMapRenderer* renderer, ESM::RefId worldspace, double expiryDelay)
@@ -40,7 +127,8 @@ namespace Terrain
     }
 
     osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f& center, unsigned char lod,
-        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+        unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile,
+        const std::atomic<bool>* /*abort*/)
     {
         // Override lod with the vertexLodMod adjusted value.
         // TODO: maybe we can refactor this code by moving all vertexLodMod code into this class.
@@ -61,6 +149,21 @@ namespace Terrain
         return node;
     }
 
+    void ChunkManager::setCompositeMapCache(osg::ref_ptr<CompositeMapCache> cache)
+    {
+        mCompositeMapCache = std::move(cache);
+    }
+
+    void ChunkManager::setUseTextureArrays(bool enabled)
+    {
+        mUseTextureArrays = enabled;
+    }
+
+    void ChunkManager::setUseVertexTextureFetch(bool enabled)
+    {
+        mUseVertexTextureFetch = enabled;
+    }
+
     void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Terrain Chunk", frameNumber, mCache->getStats(), *stats);
@@ -120,7 +223,7 @@ namespace Terrain
             float width = texCoords.z() * 2.f;
             float height = texCoords.w() * 2.f;
 
-            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(chunkSize, chunkCenter, true);
+            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(chunkSize, chunkCenter, true, false);
             for (std::vector<osg::ref_ptr<osg::StateSet>>::iterator it = passes.begin(); it != passes.end(); ++it)
             {
                 osg::ref_ptr<osg::Geometry> geom = osg::createTexturedQuadGeometry(
@@ -137,8 +240,46 @@ namespace Terrain
         }
     }
 
+    void ChunkManager::getCompositeMapInputs(float chunkSize, const osg::Vec2f& chunkCenter, std::string& inputs)
+    {
+        if (chunkSize > mMaxCompGeometrySize)
+        {
+            const float offset = chunkSize / 4.f;
+            getCompositeMapInputs(chunkSize / 2.f, chunkCenter + osg::Vec2f(offset, offset), inputs);
+            getCompositeMapInputs(chunkSize / 2.f, chunkCenter + osg::Vec2f(-offset, offset), inputs);
+            getCompositeMapInputs(chunkSize / 2.f, chunkCenter + osg::Vec2f(offset, -offset), inputs);
+            getCompositeMapInputs(chunkSize / 2.f, chunkCenter + osg::Vec2f(-offset, -offset), inputs);
+            return;
+        }
+
+        std::vector<LayerInfo> layerList;
+        std::vector<osg::ref_ptr<osg::Image>> blendmaps;
+        mStorage->getBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, mWorldspace);
+
+        // A texture replaced by another data directory or archive changes the map
+        const VFS::Manager& vfs = *mSceneManager->getVFS();
+        appendValue(inputs, layerList.size());
+        for (const LayerInfo& layer : layerList)
+        {
+            inputs.append(layer.mDiffuseMap);
+            inputs.push_back('\0');
+            inputs.append(vfs.getArchive(VFS::Path::Normalized(layer.mDiffuseMap)));
+            inputs.push_back('\0');
+        }
+
+        appendValue(inputs, blendmaps.size());
+        for (const osg::ref_ptr<osg::Image>& blendmap : blendmaps)
+        {
+            appendValue(inputs, blendmap->s());
+            appendValue(inputs, blendmap->t());
+            inputs.append(reinterpret_cast<const char*>(blendmap->data()), blendmap->getTotalSizeInBytes());
+        }
+
+        appendValue(inputs, mStorage->getBlendmapScale(chunkSize));
+    }
+
     std::vector<osg::ref_ptr<osg::StateSet>> ChunkManager::createPasses(
-        float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap)
+        float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap, bool vertexTextureFetch)
     {
         std::vector<LayerInfo> layerList;
         std::vector<osg::ref_ptr<osg::Image>> blendmaps;
@@ -171,6 +312,17 @@ namespace Terrain
 
         if (forCompositeMap)
             useShaders = false;
+        else if (vertexTextureFetch)
+            useShaders = true;
+
+        float blendmapScale = mStorage->getBlendmapScale(chunkSize);
+
+        if (useShaders && mUseTextureArrays && !blendmaps.empty())
+        {
+            if (osg::ref_ptr<osg::StateSet> pass
+                = createTextureArrayPass(layerList, blendmaps, blendmapScale, vertexTextureFetch))
+                return { std::move(pass) };
+        }
 
         std::vector<osg::ref_ptr<osg::Texture2D>> blendmapTextures;
         for (std::vector<osg::ref_ptr<osg::Image>>::const_iterator it = blendmaps.begin(); it != blendmaps.end(); ++it)
@@ -183,10 +335,68 @@ namespace Terrain
             blendmapTextures.push_back(texture);
         }
 
-        float blendmapScale = mStorage->getBlendmapScale(chunkSize);
-
         return ::Terrain::createPasses(
-            useShaders, mSceneManager, layers, blendmapTextures, blendmapScale, blendmapScale);
+            useShaders, mSceneManager, layers, blendmapTextures, blendmapScale, blendmapScale, vertexTextureFetch);
+    }
+
+    osg::ref_ptr<osg::StateSet> ChunkManager::createTextureArrayPass(const std::vector<LayerInfo>& layerList,
+        const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, float blendmapScale, bool vertexTextureFetch)
+    {
+        if (!SceneUtil::glExtensionsReady() || !SceneUtil::getGLExtensions().isTexture2DArraySupported)
+            return nullptr;
+        if (layerList.size() > maxTextureArrayLayers)
+            return nullptr;
+
+        // The shader handles the layers of a chunk the same way, so they must agree on their maps
+        const LayerInfo& first = layerList.front();
+        const bool normalMaps = !first.mNormalMap.empty();
+        for (const LayerInfo& layer : layerList)
+        {
+            if (layer.mNormalMap.empty() != first.mNormalMap.empty() || layer.mParallax != first.mParallax
+                || layer.mSpecular != first.mSpecular)
+                return nullptr;
+        }
+
+        // Drawn in a single pass the order of the layers doesn't matter, so sort them to share the arrays between
+        // chunks using the same textures
+        std::vector<std::size_t> order(layerList.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [&](std::size_t l, std::size_t r) { return layerList[l].mDiffuseMap < layerList[r].mDiffuseMap; });
+
+        std::vector<std::string> diffuseMapNames;
+        std::vector<std::string> normalMapNames;
+        for (std::size_t i : order)
+        {
+            diffuseMapNames.push_back(layerList[i].mDiffuseMap);
+            if (normalMaps)
+                normalMapNames.push_back(layerList[i].mNormalMap);
+        }
+
+        TextureArrayLayers layers;
+        layers.mParallax = first.mParallax;
+        layers.mSpecular = first.mSpecular;
+        layers.mDiffuseMaps = mTextureManager->getTextureArray(diffuseMapNames);
+        if (!layers.mDiffuseMaps)
+            return nullptr;
+        if (normalMaps)
+        {
+            layers.mNormalMaps = mTextureManager->getTextureArray(normalMapNames);
+            if (!layers.mNormalMaps)
+                return nullptr;
+        }
+
+        layers.mBlendmaps = new osg::Texture2DArray;
+        layers.mBlendmaps->setTextureSize(
+            blendmaps.front()->s(), blendmaps.front()->t(), static_cast<int>(blendmaps.size()));
+        for (std::size_t i = 0; i < order.size(); ++i)
+            layers.mBlendmaps->setImage(static_cast<unsigned>(i), blendmaps[order[i]]);
+        layers.mBlendmaps->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        layers.mBlendmaps->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        layers.mBlendmaps->setResizeNonPowerOfTwoHint(false);
+
+        return ::Terrain::createTextureArrayPass(
+            mSceneManager, layers, blendmapScale, blendmapScale, vertexTextureFetch);
     }
 
     osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Vec2f& chunkCenter, unsigned char lod,
@@ -194,7 +404,35 @@ namespace Terrain
     {
         osg::ref_ptr<TerrainDrawable> geometry(new TerrainDrawable);
 
-        if (!templateGeometry)
+        const unsigned int numVerts = (mStorage->getCellVertices(mWorldspace) - 1) * chunkSize / (1 << lod) + 1;
+        const osg::ref_ptr<osg::DrawElements> indexBuffer = mBufferCache.getIndexBuffer(numVerts, lodFlags);
+        const float chunkWorldSize = chunkSize * mStorage->getCellWorldSize(mWorldspace);
+        const float waterBoundingBoxMargin = chunkWorldSize / numVerts;
+
+        // A template of the same center and LOD has the same vertex data, so follow how it was built
+        const bool vertexTextureFetch = templateGeometry != nullptr
+            ? templateGeometry->getVertexTextures() != nullptr
+            : mUseVertexTextureFetch && isVertexTextureFetchSupported();
+
+        if (vertexTextureFetch)
+        {
+            if (templateGeometry)
+                geometry->setVertexTextures(templateGeometry->getVertexTextures());
+            else
+            {
+                osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+                osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+                osg::Vec4ubArray colors;
+
+                mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, colors);
+
+                geometry->setVertexTextures(
+                    createVertexTextures(numVerts, indexBuffer, waterBoundingBoxMargin, positions, normals, colors));
+            }
+
+            geometry->setVertexArray(mBufferCache.getGridBuffer(numVerts, chunkWorldSize));
+        }
+        else if (!templateGeometry)
         {
             osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
             osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
@@ -238,16 +476,15 @@ namespace Terrain
         if (chunkSize <= 1.f)
             geometry->setLightListCallback(new SceneUtil::LightListCallback);
 
-        unsigned int numVerts = (mStorage->getCellVertices(mWorldspace) - 1) * chunkSize / (1 << lod) + 1;
-
-        geometry->addPrimitiveSet(mBufferCache.getIndexBuffer(numVerts, lodFlags));
+        geometry->addPrimitiveSet(indexBuffer);
 
         bool useCompositeMap = chunkSize >= mCompositeMapLevel;
         unsigned int numUvSets = useCompositeMap ? 1 : 2;
 
         geometry->setTexCoordArrayList(osg::Geometry::ArrayList(numUvSets, mBufferCache.getUVBuffer(numVerts)));
 
-        geometry->createClusterCullingCallback();
+        if (!vertexTextureFetch)
+            geometry->createClusterCullingCallback();
 
         geometry->setStateSet(mMultiPassRoot);
 
@@ -267,28 +504,55 @@ namespace Terrain
                 osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
                 compositeMap->mTexture = createCompositeMapRTT();
 
-                createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
-
-                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                bool cached = false;
+                if (mCompositeMapCache)
+                {
+                    std::string inputs;
+                    appendValue(inputs, chunkSize);
+                    appendValue(inputs, mCompositeMapSize);
+                    appendValue(inputs, mMaxCompGeometrySize);
+                    getCompositeMapInputs(chunkSize, chunkCenter, inputs);
+                    compositeMap->mCacheKey = mCompositeMapCache->getKey(inputs);
+
+                    if (osg::ref_ptr<osg::Image> image = mCompositeMapCache->read(compositeMap->mCacheKey))
+                    {
+                        // Upload the compressed data and its mipmaps as they are
+                        compositeMap->mTexture->setInternalFormatMode(osg::Texture::USE_IMAGE_DATA_FORMAT);
+                        compositeMap->mTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_LINEAR);
+                        compositeMap->mTexture->setImage(image);
+                        cached = true;
+                    }
+                    else
+                        compositeMap->mCache = mCompositeMapCache;
+                }
+
+                if (!cached)
+                {
+                    createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
+                    mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                }
 
                 geometry->setCompositeMap(compositeMap);
-                geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+                if (!cached)
+                    geometry->setCompositeMapRenderer(mCompositeMapRenderer);
 
                 TextureLayer layer;
                 layer.mDiffuseMap = compositeMap->mTexture;
                 layer.mParallax = false;
                 layer.mSpecular = false;
                 geometry->setPasses(::Terrain::createPasses(
-                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting(), mSceneManager,
-                    std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1.f, 1.f));
+                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting() || vertexTextureFetch,
+                    mSceneManager, std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(),
+                    1.f, 1.f, vertexTextureFetch));
             }
             else
             {
-                geometry->setPasses(createPasses(chunkSize, chunkCenter, false));
+                geometry->setPasses(createPasses(chunkSize, chunkCenter, false, vertexTextureFetch));
             }
         }
 
-        geometry->setupWaterBoundingBox(-1, chunkSize * mStorage->getCellWorldSize(mWorldspace) / numVerts);
+        if (!vertexTextureFetch)
+            geometry->setupWaterBoundingBox(-1, waterBoundingBoxMargin);
 
         if (!templateGeometry && compile && mSceneManager->getIncrementalCompileOperation())
         {
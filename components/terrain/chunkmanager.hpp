@@ -6,11 +6,13 @@
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
+#include "defs.hpp"
 #include "quadtreeworld.hpp"
 
 namespace osg
 {
     class Group;
+    class Image;
     class Texture2D;
 }
 
@@ -24,6 +26,7 @@ namespace Terrain
 
     class TextureManager;
     class CompositeMapRenderer;
+    class CompositeMapCache;
     class Storage;
     class CompositeMap;
     class TerrainDrawable;
@@ -79,12 +82,22 @@ namespace Terrain
             CompositeMapRenderer* renderer, ESM::RefId worldspace, double expiryDelay);
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
-            bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
+            bool activeGrid, const osg::Vec3f& viewPoint, bool compile, const std::atomic<bool>* abort) override;
 
         void setCompositeMapSize(unsigned int size) { mCompositeMapSize = size; }
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
 
+        /// Load the composite maps of new chunks from the cache, and add the ones rendered to it.
+        void setCompositeMapCache(osg::ref_ptr<CompositeMapCache> cache);
+
+        /// Draw the layers of new chunks in a single pass sampling texture arrays, when their textures allow it.
+        void setUseTextureArrays(bool enabled);
+
+        /// Sample the heights, normals and colours of new chunks from textures in the vertex shader, so the chunks
+        /// share their vertex grids. Requires OpenGL 3.0, chunks are built as usual otherwise.
+        void setUseVertexTextureFetch(bool enabled);
+
         void setNodeMask(unsigned int mask) { mNodeMask = mask; }
         unsigned int getNodeMask() override { return mNodeMask; }
 
@@ -103,13 +116,21 @@ namespace Terrain
         void createCompositeMapGeometry(
             float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
 
+        // Append what the composite map is rendered from, subdivided the same way as by createCompositeMapGeometry
+        void getCompositeMapInputs(float chunkSize, const osg::Vec2f& chunkCenter, std::string& inputs);
+
         std::vector<osg::ref_ptr<osg::StateSet>> createPasses(
-            float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap);
+            float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap, bool vertexTextureFetch);
+
+        // @return nullptr if the layers can't be drawn in a single pass
+        osg::ref_ptr<osg::StateSet> createTextureArrayPass(const std::vector<LayerInfo>& layerList,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, float blendmapScale, bool vertexTextureFetch);
 
         Terrain::Storage* mStorage;
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
         CompositeMapRenderer* mCompositeMapRenderer;
+        osg::ref_ptr<CompositeMapCache> mCompositeMapCache;
         BufferCache mBufferCache;
 
         osg::ref_ptr<osg::StateSet> mMultiPassRoot;
@@ -119,6 +140,8 @@ namespace Terrain
         unsigned int mCompositeMapSize;
         float mCompositeMapLevel;
         float mMaxCompGeometrySize;
+        bool mUseTextureArrays = false;
+        bool mUseVertexTextureFetch = false;
     };
 
 }
@@ -0,0 +1,147 @@
+#include "compositemapcache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/resource/texturecompression.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Increment when the way the composite maps are rendered changes
+        constexpr std::uint32_t sVersion = 1;
+    }
+
+    class CompositeMapCache::WriteItem : public SceneUtil::WorkItem
+    {
+    public:
+        WriteItem(const CompositeMapCache& cache, const std::string& key, osg::ref_ptr<const osg::Image> image)
+            : mCache(&cache)
+            , mKey(key)
+            , mImage(std::move(image))
+        {
+        }
+
+        void doWork() override { mCache->writeImage(mKey, *mImage); }
+
+    private:
+        osg::ref_ptr<const CompositeMapCache> mCache;
+        std::string mKey;
+        osg::ref_ptr<const osg::Image> mImage;
+    };
+
+    CompositeMapCache::CompositeMapCache(const std::filesystem::path& directory, SceneUtil::WorkQueue* workQueue)
+        : mDirectory(directory)
+        , mWorkQueue(workQueue)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create composite map cache directory " << directory << ": "
+                                << ec.message();
+            mDirectory.clear();
+        }
+    }
+
+    CompositeMapCache::~CompositeMapCache() = default;
+
+    std::string CompositeMapCache::getKey(std::span<const char> inputs) const
+    {
+        std::string data(reinterpret_cast<const char*>(&sVersion), sizeof(sVersion));
+        data.append(inputs.begin(), inputs.end());
+        const std::array<std::uint64_t, 2> hash = Files::getHash(data);
+        std::ostringstream key;
+        key << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return key.str();
+    }
+
+    std::filesystem::path CompositeMapCache::getPath(const std::string& key) const
+    {
+        return mDirectory / (key + ".dds");
+    }
+
+    osg::ref_ptr<osg::Image> CompositeMapCache::read(const std::string& key) const
+    {
+        if (mDirectory.empty())
+            return nullptr;
+        const std::filesystem::path path = getPath(key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!reader)
+            return nullptr;
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(stream);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read composite map " << path << ": " << result.message();
+            return nullptr;
+        }
+        return result.getImage();
+    }
+
+    void CompositeMapCache::write(const std::string& key, osg::ref_ptr<const osg::Image> image)
+    {
+        if (mDirectory.empty())
+            return;
+        if (mWorkQueue == nullptr)
+        {
+            writeImage(key, *image);
+            return;
+        }
+        mWorkQueue->addWorkItem(new WriteItem(*this, key, std::move(image)), SceneUtil::WorkPriority::Speculative);
+    }
+
+    void CompositeMapCache::writeImage(const std::string& key, const osg::Image& image) const
+    {
+        const std::filesystem::path path = getPath(key);
+        osg::ref_ptr<osg::Image> compressed = Resource::compressImage(image);
+        if (compressed == nullptr)
+        {
+            Log(Debug::Warning) << "Failed to compress composite map " << path;
+            return;
+        }
+
+        osgDB::ReaderWriter* writer = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!writer)
+            return;
+        // Keep the rows in the order of the rendered image, bottom first
+        const osg::ref_ptr<osgDB::Options> options = new osgDB::Options("ddsNoAutoFlipWrite");
+
+        // Chunks with the same inputs may be written by other threads at the same time
+        std::filesystem::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+                const osgDB::ReaderWriter::WriteResult result = writer->writeImage(*compressed, stream, options);
+                if (!result.success())
+                    throw std::runtime_error(result.message());
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write composite map " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+#include <osg/Image>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Terrain
+{
+    /// @brief Stores rendered composite maps on disk as S3TC compressed images, so that later sessions load them
+    /// instead of rendering them again.
+    /// @par A map is identified by the hash of everything it is rendered from: the blendmaps, the layer textures with
+    /// the archives providing them and the sizes of the map and of its chunk.
+    class CompositeMapCache : public osg::Referenced
+    {
+    public:
+        /// @param workQueue Compresses and writes the maps in the background. When null, they are written by the
+        /// calling thread.
+        CompositeMapCache(const std::filesystem::path& directory, SceneUtil::WorkQueue* workQueue);
+
+        ~CompositeMapCache();
+
+        /// @param inputs The data the composite map is rendered from.
+        std::string getKey(std::span<const char> inputs) const;
+
+        /// @return nullptr if the map isn't cached.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Image> read(const std::string& key) const;
+
+        /// Add the rendered map to the cache. The image must not be modified afterwards.
+        void write(const std::string& key, osg::ref_ptr<const osg::Image> image);
+
+    private:
+        class WriteItem;
+
+        std::filesystem::path getPath(const std::string& key) const;
+
+        void writeImage(const std::string& key, const osg::Image& image) const;
+
+        std::filesystem::path mDirectory;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+    };
+}
+
+#endif
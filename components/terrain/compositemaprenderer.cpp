@@ -6,6 +6,8 @@
 
 #include <algorithm>
 
+#include "compositemapcache.hpp"
+
 namespace Terrain
 {
 
@@ -125,8 +127,21 @@ namespace Terrain
             compositeMap.mDrawables[i] = nullptr;
         }
         if (compositeMap.mCompiled == compositeMap.mDrawables.size())
+        {
             compositeMap.mDrawables = std::vector<osg::ref_ptr<osg::Drawable>>();
 
+            if (compositeMap.mCache)
+            {
+                // Stalls until the map is rendered, but only the first time a map is rendered
+                mFBO->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->readPixels(0, 0, compositeMap.mTexture->getTextureWidth(),
+                    compositeMap.mTexture->getTextureHeight(), GL_RGB, GL_UNSIGNED_BYTE);
+                compositeMap.mCache->write(compositeMap.mCacheKey, image);
+                compositeMap.mCache = nullptr;
+            }
+        }
+
         state.haveAppliedAttribute(osg::StateAttribute::VIEWPORT);
 
         GLuint fboId = state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0;
@@ -5,6 +5,7 @@
 
 #include <mutex>
 #include <set>
+#include <string>
 
 namespace osg
 {
@@ -15,6 +16,7 @@ namespace osg
 
 namespace Terrain
 {
+    class CompositeMapCache;
 
     class CompositeMap : public osg::Referenced
     {
@@ -24,6 +26,10 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Drawable>> mDrawables;
         osg::ref_ptr<osg::Texture2D> mTexture;
         unsigned int mCompiled;
+
+        // When set, the map is read back and stored in the cache once it's fully rendered
+        osg::ref_ptr<CompositeMapCache> mCache;
+        std::string mCacheKey;
     };
 
     /**
@@ -7,6 +7,7 @@
 #include <osg/TexEnvCombine>
 #include <osg/TexMat>
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -15,6 +16,7 @@
 #include <components/stereo/stereomanager.hpp>
 
 #include <mutex>
+#include <string>
 
 namespace
 {
@@ -208,22 +210,42 @@ namespace
         osg::ref_ptr<osg::Uniform> mBlendMap;
         osg::ref_ptr<osg::Uniform> mNormalMap;
         osg::ref_ptr<osg::Uniform> mColorMode;
+        osg::ref_ptr<osg::Uniform> mVertexHeightMap;
+        osg::ref_ptr<osg::Uniform> mVertexNormalMap;
+        osg::ref_ptr<osg::Uniform> mVertexColorMap;
 
         UniformCollection()
             : mDiffuseMap(new osg::Uniform("diffuseMap", 0))
             , mBlendMap(new osg::Uniform("blendMap", 1))
             , mNormalMap(new osg::Uniform("normalMap", 2))
             , mColorMode(new osg::Uniform("colorMode", 2))
+            , mVertexHeightMap(new osg::Uniform("vertexHeightMap", 3))
+            , mVertexNormalMap(new osg::Uniform("vertexNormalMap", 4))
+            , mVertexColorMap(new osg::Uniform("vertexColorMap", 5))
         {
         }
     };
+
+    // Special handling for red-green normal maps (e.g. BC5 or R8G8).
+    bool isRedGreenNormalMap(const osg::Image* image)
+    {
+        if (!image)
+            return false;
+        switch (SceneUtil::computeUnsizedPixelFormat(image->getPixelFormat()))
+        {
+            case GL_RG:
+            case GL_RG_INTEGER:
+                return true;
+        }
+        return false;
+    }
 }
 
 namespace Terrain
 {
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize)
+        int blendmapScale, float layerTileSize, bool vertexTextureFetch)
     {
         auto& shaderManager = sceneManager->getShaderManager();
         std::vector<osg::ref_ptr<osg::StateSet>> passes;
@@ -280,19 +302,10 @@ namespace Terrain
                     stateset->setTextureAttributeAndModes(2, it->mNormalMap);
                     stateset->addUniform(UniformCollection::value().mNormalMap);
 
-                    // Special handling for red-green normal maps (e.g. BC5 or R8G8).
-                    const osg::Image* image = it->mNormalMap->getImage(0);
-                    if (image)
+                    if (isRedGreenNormalMap(it->mNormalMap->getImage(0)))
                     {
-                        switch (SceneUtil::computeUnsizedPixelFormat(image->getPixelFormat()))
-                        {
-                            case GL_RG:
-                            case GL_RG_INTEGER:
-                            {
-                                reconstructNormalZ = true;
-                                parallax = false;
-                            }
-                        }
+                        reconstructNormalZ = true;
+                        parallax = false;
                     }
                 }
 
@@ -303,6 +316,9 @@ namespace Terrain
                 defineMap["parallax"] = parallax ? "1" : "0";
                 defineMap["writeNormals"] = (it == layers.end() - 1) ? "1" : "0";
                 defineMap["reconstructNormalZ"] = reconstructNormalZ ? "1" : "0";
+                defineMap["textureArrays"] = "0";
+                defineMap["layerCount"] = "1";
+                defineMap["vertexTextureFetch"] = vertexTextureFetch ? "1" : "0";
                 Stereo::shaderStereoDefines(defineMap);
 
                 stateset->setAttributeAndModes(shaderManager.getProgram("terrain", defineMap));
@@ -338,4 +354,68 @@ namespace Terrain
         return passes;
     }
 
+    osg::ref_ptr<osg::StateSet> createTextureArrayPass(Resource::SceneManager* sceneManager,
+        const TextureArrayLayers& layers, int blendmapScale, float layerTileSize, bool vertexTextureFetch)
+    {
+        osg::ref_ptr<osg::StateSet> stateset(new osg::StateSet);
+
+        stateset->setTextureAttributeAndModes(0, layers.mDiffuseMaps);
+        if (layerTileSize != 1.f)
+            stateset->setTextureAttributeAndModes(0, LayerTexMat::value(layerTileSize), osg::StateAttribute::ON);
+        stateset->addUniform(UniformCollection::value().mDiffuseMap);
+
+        stateset->setTextureAttributeAndModes(1, layers.mBlendmaps);
+        stateset->setTextureAttributeAndModes(1, BlendmapTexMat::value(blendmapScale));
+        stateset->addUniform(UniformCollection::value().mBlendMap);
+
+        bool parallax = layers.mNormalMaps && layers.mParallax;
+        bool reconstructNormalZ = false;
+
+        if (layers.mNormalMaps)
+        {
+            stateset->setTextureAttributeAndModes(2, layers.mNormalMaps);
+            stateset->addUniform(UniformCollection::value().mNormalMap);
+
+            if (isRedGreenNormalMap(layers.mNormalMaps->getImage(0)))
+            {
+                reconstructNormalZ = true;
+                parallax = false;
+            }
+        }
+
+        Shader::ShaderManager::DefineMap defineMap;
+        defineMap["normalMap"] = layers.mNormalMaps ? "1" : "0";
+        defineMap["blendMap"] = "1";
+        defineMap["specularMap"] = layers.mSpecular ? "1" : "0";
+        defineMap["parallax"] = parallax ? "1" : "0";
+        defineMap["writeNormals"] = "1";
+        defineMap["reconstructNormalZ"] = reconstructNormalZ ? "1" : "0";
+        defineMap["textureArrays"] = "1";
+        defineMap["layerCount"] = std::to_string(layers.mDiffuseMaps->getTextureDepth());
+        defineMap["vertexTextureFetch"] = vertexTextureFetch ? "1" : "0";
+        Stereo::shaderStereoDefines(defineMap);
+
+        stateset->setAttributeAndModes(sceneManager->getShaderManager().getProgram("terrain", defineMap));
+        stateset->addUniform(UniformCollection::value().mColorMode);
+
+        return stateset;
+    }
+
+    osg::ref_ptr<osg::StateSet> createVertexTexturesStateSet(
+        osg::Texture2D* heights, osg::Texture2D* normals, osg::Texture2D* colors, unsigned int numVerts)
+    {
+        osg::ref_ptr<osg::StateSet> stateset(new osg::StateSet);
+
+        // Sampled by the vertex shader only
+        stateset->setTextureAttribute(3, heights);
+        stateset->setTextureAttribute(4, normals);
+        stateset->setTextureAttribute(5, colors);
+        stateset->addUniform(UniformCollection::value().mVertexHeightMap);
+        stateset->addUniform(UniformCollection::value().mVertexNormalMap);
+        stateset->addUniform(UniformCollection::value().mVertexColorMap);
+        stateset->addUniform(new osg::Uniform("vertexTextureSize", static_cast<float>(numVerts)));
+
+        return stateset;
+    }
+
 }
@@ -6,6 +6,7 @@
 namespace osg
 {
     class Texture2D;
+    class Texture2DArray;
 }
 
 namespace Resource
@@ -24,9 +25,30 @@ namespace Terrain
         bool mSpecular;
     };
 
+    /// All the layers of a chunk, the blendmap of a layer has the same index as its textures.
+    struct TextureArrayLayers
+    {
+        osg::ref_ptr<osg::Texture2DArray> mDiffuseMaps;
+        osg::ref_ptr<osg::Texture2DArray> mNormalMaps; // optional
+        osg::ref_ptr<osg::Texture2DArray> mBlendmaps;
+        bool mParallax;
+        bool mSpecular;
+    };
+
+    /// @param vertexTextureFetch Sample the vertex data from the textures of createVertexTexturesStateSet, requires
+    /// shaders
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize);
+        int blendmapScale, float layerTileSize, bool vertexTextureFetch);
+
+    /// Create a single pass drawing all the layers instead of one pass per layer. Requires shaders.
+    osg::ref_ptr<osg::StateSet> createTextureArrayPass(Resource::SceneManager* sceneManager,
+        const TextureArrayLayers& layers, int blendmapScale, float layerTileSize, bool vertexTextureFetch);
+
+    /// Bind the heights, normals and colours of a chunk for passes sampling them in the vertex shader.
+    /// @param numVerts number of vertices on each side of the chunk, the size of the textures
+    osg::ref_ptr<osg::StateSet> createVertexTexturesStateSet(
+        osg::Texture2D* heights, osg::Texture2D* normals, osg::Texture2D* colors, unsigned int numVerts);
 
 }
 
@@ -13,6 +13,7 @@
 #include <components/misc/mathutil.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "chunkmanager.hpp"
 #include "compositemaprenderer.hpp"
@@ -260,7 +261,8 @@ namespace Terrain
         {
         }
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& chunkCenter, unsigned char lod,
-            unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+            unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile,
+            const std::atomic<bool>* /*abort*/) override
         {
             osg::Vec3f center = { chunkCenter.x(), chunkCenter.y(), 0 };
             auto chunkBorder = CellBorder::createBorderGeometry(center.x() - size / 2.f, center.y() - size / 2.f, size,
@@ -305,7 +307,47 @@ namespace Terrain
         }
     }
 
-    QuadTreeWorld::~QuadTreeWorld() {}
+    /// Worker thread item: select the LODs for a view point and load the rendering nodes of the selected chunks.
+    class QuadTreeWorld::UpdateViewWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        UpdateViewWorkItem(QuadTreeWorld& world, ViewData* viewData, float viewDistance)
+            : mWorld(world)
+            , mViewData(viewData)
+            , mViewDistance(viewDistance)
+            , mAbort(false)
+        {
+        }
+
+        void doWork() override
+        {
+            const float cellWorldSize = ESM::getCellSize(mWorld.mWorldspace);
+            const osg::Vec4i& grid = mViewData->getActiveGrid();
+            DefaultLodCallback lodCallback(mWorld.mLodFactor, mWorld.mMinSize, mViewDistance, grid, cellWorldSize);
+            mWorld.mRootNode->traverseNodes(mViewData, mViewData->getViewPoint(), &lodCallback);
+
+            for (unsigned int i = 0, n = mViewData->getNumEntries(); i < n && !mAbort; ++i)
+                mWorld.loadRenderingNode(mViewData->getEntry(i), mViewData, cellWorldSize, grid, false, &mAbort);
+
+            if (mAbort)
+                mViewData->clear();
+            else
+                mViewData->resetChanged();
+        }
+
+        void abort() override { mAbort = true; }
+
+    private:
+        QuadTreeWorld& mWorld;
+        osg::ref_ptr<ViewData> mViewData;
+        float mViewDistance;
+        std::atomic<bool> mAbort;
+    };
+
+    QuadTreeWorld::~QuadTreeWorld()
+    {
+        waitForPreparedView();
+    }
 
     /// get the level of vertex detail to render this node at, expressed relative to the native resolution of the vertex
     /// data set, NOT relative to mMinSize as is the case with node LODs.
@@ -362,8 +404,8 @@ namespace Terrain
         return lodFlags;
     }
 
-    void QuadTreeWorld::loadRenderingNode(
-        ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds, bool compile)
+    void QuadTreeWorld::loadRenderingNode(ViewDataEntry& entry, ViewData* vd, float cellWorldSize,
+        const osg::Vec4i& gridbounds, bool compile, const std::atomic<bool>* abort)
     {
         if (!vd->hasChanged() && entry.mRenderingNode)
             return;
@@ -387,6 +429,7 @@ namespace Terrain
             osg::ref_ptr<SceneUtil::PositionAttitudeTransform> pat = new SceneUtil::PositionAttitudeTransform;
             pat->setPosition(osg::Vec3f(
                 entry.mNode->getCenter().x() * cellWorldSize, entry.mNode->getCenter().y() * cellWorldSize, 0.f));
+            pat->setCullCallback(mChunkCullCallback);
 
             const osg::Vec2f& center = entry.mNode->getCenter();
             bool activeGrid = (center.x() > gridbounds.x() && center.y() > gridbounds.y() && center.x() < gridbounds.z()
@@ -396,11 +439,13 @@ namespace Terrain
             {
                 osg::ref_ptr<osg::Node> n = m->getChunk(entry.mNode->getSize(), entry.mNode->getCenter(),
                     DefaultLodCallback::getNativeLodLevel(entry.mNode, mMinSize), entry.mLodFlags, activeGrid,
-                    vd->getViewPoint(), compile);
+                    vd->getViewPoint(), compile, abort);
                 if (n)
                     pat->addChild(n);
             }
-            entry.mRenderingNode = pat;
+            // Chunk managers may skip the rest of an aborted chunk, don't keep it incomplete
+            if (abort == nullptr || !*abort)
+                entry.mRenderingNode = pat;
         }
     }
 
@@ -473,6 +518,9 @@ namespace Terrain
         bool needsUpdate = true;
         osg::Vec3f viewPoint = viewer ? nv.getViewPoint() : nv.getEyePoint();
         ViewData* vd = mViewDataMap->getViewData(viewer, viewPoint, mActiveGrid, needsUpdate);
+        const bool isSceneCamera = viewer && viewer->getName() == Constants::SceneCamera;
+        if (needsUpdate && isSceneCamera && takePreparedView(*vd, viewPoint))
+            needsUpdate = false;
         if (needsUpdate)
         {
             vd->reset();
@@ -486,7 +534,7 @@ namespace Terrain
         for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
         {
             ViewDataEntry& entry = vd->getEntry(i);
-            loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false);
+            loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false, nullptr);
             entry.mRenderingNode->accept(nv);
         }
 
@@ -496,6 +544,9 @@ namespace Terrain
 
         vd->resetChanged();
 
+        if (isSceneCamera)
+            prepareView(*vd, viewPoint);
+
         double referenceTime = nv.getFrameStamp() ? nv.getFrameStamp()->getReferenceTime() : 0.0;
         if (referenceTime != 0.0)
         {
@@ -504,6 +555,80 @@ namespace Terrain
         }
     }
 
+    bool QuadTreeWorld::takePreparedView(ViewData& vd, const osg::Vec3f& viewPoint)
+    {
+        if (!mUpdateViewWorkItem || !mUpdateViewWorkItem->isDone())
+            return false;
+
+        const float reuseDistance = mViewDataMap->getReuseDistance();
+        if (!mPreparedView->suitableToUse(mActiveGrid)
+            || mPreparedView->getWorldUpdateRevision() != mViewDataMap->getWorldUpdateRevision()
+            || (mPreparedView->getViewPoint() - viewPoint).length2() >= reuseDistance * reuseDistance)
+            return false;
+
+        vd.copyFrom(*mPreparedView);
+        return true;
+    }
+
+    void QuadTreeWorld::prepareView(const ViewData& vd, const osg::Vec3f& viewPoint)
+    {
+        if (!mWorkQueue || (mUpdateViewWorkItem && !mUpdateViewWorkItem->isDone()))
+            return;
+
+        // Start preparing once the camera has moved half of the reuse distance away from the view point of the
+        // current LODs. Assuming it keeps moving in the same direction, the prepared view point is close to where the
+        // camera is when the current view can no longer be reused.
+        const float reuseDistance = mViewDataMap->getReuseDistance();
+        const osg::Vec3f offset = viewPoint - vd.getViewPoint();
+        if (offset.length2() < reuseDistance * reuseDistance / 4)
+            return;
+        const osg::Vec3f predictedViewPoint = viewPoint + offset;
+
+        const unsigned int revision = mViewDataMap->getWorldUpdateRevision();
+        if (!mPreparedView)
+            mPreparedView = mViewDataMap->createIndependentView();
+        else if (mUpdateViewWorkItem && mPreparedView->suitableToUse(mActiveGrid)
+            && mPreparedView->getWorldUpdateRevision() == revision
+            && (mPreparedView->getViewPoint() - predictedViewPoint).length2() < reuseDistance * reuseDistance / 4)
+            return; // The view prepared already is still good enough
+
+        if (mPreparedView->getWorldUpdateRevision() != revision)
+        {
+            mPreparedView->clear();
+            mPreparedView->setWorldUpdateRevision(revision);
+        }
+        mPreparedView->reset();
+        mPreparedView->setViewPoint(predictedViewPoint);
+        mPreparedView->setActiveGrid(mActiveGrid);
+
+        mUpdateViewWorkItem = new UpdateViewWorkItem(*this, mPreparedView, mViewDistance);
+        mWorkQueue->addWorkItem(mUpdateViewWorkItem, SceneUtil::WorkPriority::Urgent);
+    }
+
+    void QuadTreeWorld::waitForPreparedView()
+    {
+        if (!mUpdateViewWorkItem)
+            return;
+        mUpdateViewWorkItem->cancel();
+        mUpdateViewWorkItem->waitTillDone();
+        mUpdateViewWorkItem = nullptr;
+        if (mPreparedView)
+            mPreparedView->clear();
+    }
+
+    void QuadTreeWorld::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        waitForPreparedView();
+        mWorkQueue = workQueue;
+    }
+
+    void QuadTreeWorld::setChunkCullCallback(osg::Callback* callback)
+    {
+        waitForPreparedView();
+        mChunkCullCallback = callback;
+        mViewDataMap->rebuildViews();
+    }
+
     void QuadTreeWorld::ensureQuadTreeBuilt()
     {
         std::lock_guard<std::mutex> lock(mQuadTreeMutex);
@@ -554,7 +679,7 @@ namespace Terrain
         for (unsigned int i = 0, n = vd->getNumEntries(); i < n && !abort; ++i)
         {
             ViewDataEntry& entry = vd->getEntry(i);
-            loadRenderingNode(entry, vd, cellWorldSize, grid, true);
+            loadRenderingNode(entry, vd, cellWorldSize, grid, true, &abort);
             reporter.addProgress(1);
         }
     }
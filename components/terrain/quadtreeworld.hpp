@@ -56,6 +56,13 @@ namespace Terrain
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) override;
 
+        /// Select the LODs for the scene camera in a background thread ahead of its movement, so the cull traversal
+        /// only has to take the prepared view. Set to nullptr to disable, which waits for the pending work item.
+        /// @note The work queue must outlive this object or be unset before it's stopped.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue) override;
+
+        void setChunkCullCallback(osg::Callback* callback) override;
+
         class ChunkManager
         {
         public:
@@ -66,8 +73,11 @@ namespace Terrain
             {
                 mWorldspace = worldspace;
             }
+            /// @param abort Set when the chunk is no longer needed, may be nullptr
+            /// @return nullptr if there is nothing to render or the build is aborted, aborted builds are not cached
             virtual osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod,
-                unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
+                unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile,
+                const std::atomic<bool>* abort)
                 = 0;
             virtual unsigned int getNodeMask() { return 0; }
 
@@ -88,9 +98,15 @@ namespace Terrain
         void addChunkManager(ChunkManager*);
 
     private:
+        class UpdateViewWorkItem;
+
         void ensureQuadTreeBuilt();
-        void loadRenderingNode(
-            ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds, bool compile);
+        void loadRenderingNode(ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds,
+            bool compile, const std::atomic<bool>* abort);
+        /// @return true if the view prepared in the background is suitable for the view point and has been copied
+        bool takePreparedView(ViewData& vd, const osg::Vec3f& viewPoint);
+        void prepareView(const ViewData& vd, const osg::Vec3f& viewPoint);
+        void waitForPreparedView();
 
         osg::ref_ptr<RootNode> mRootNode;
 
@@ -106,6 +122,12 @@ namespace Terrain
         float mMinSize;
         bool mDebugTerrainChunks;
         std::unique_ptr<DebugChunkManager> mDebugChunkManager;
+
+        osg::ref_ptr<osg::Callback> mChunkCullCallback;
+
+        SceneUtil::WorkQueue* mWorkQueue = nullptr;
+        osg::ref_ptr<ViewData> mPreparedView;
+        osg::ref_ptr<UpdateViewWorkItem> mUpdateViewWorkItem;
     };
 
 }
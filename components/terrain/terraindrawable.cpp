@@ -18,6 +18,7 @@ namespace Terrain
         : osg::Geometry(copy, copyop)
         , mPasses(copy.mPasses)
         , mLightListCallback(copy.mLightListCallback)
+        , mVertexTextures(copy.mVertexTextures)
     {
     }
 
@@ -88,7 +89,8 @@ namespace Terrain
 
         if (shadowcam)
         {
-            cv->addDrawableAndDepth(this, &matrix, depth);
+            if (!mVertexTextures)
+                cv->addDrawableAndDepth(this, &matrix, depth);
             return;
         }
 
@@ -103,6 +105,8 @@ namespace Terrain
         osg::StateSet* stateset = getStateSet();
         if (stateset)
             cv->pushStateSet(stateset);
+        if (mVertexTextures)
+            cv->pushStateSet(mVertexTextures->mStateSet);
 
         for (PassVector::const_iterator it = mPasses.begin(); it != mPasses.end(); ++it)
         {
@@ -111,6 +115,8 @@ namespace Terrain
             cv->popStateSet();
         }
 
+        if (mVertexTextures)
+            cv->popStateSet();
         if (stateset)
             cv->popStateSet();
         if (pushedLight)
@@ -132,6 +138,21 @@ namespace Terrain
         mLightListCallback = lightListCallback;
     }
 
+    void TerrainDrawable::setVertexTextures(VertexTextures* vertexTextures)
+    {
+        mVertexTextures = vertexTextures;
+        mClusterCullingCallback = vertexTextures->mClusterCullingCallback;
+        mWaterBoundingBox = vertexTextures->mWaterBoundingBox;
+        dirtyBound();
+    }
+
+    osg::BoundingBox TerrainDrawable::computeBoundingBox() const
+    {
+        if (mVertexTextures)
+            return mVertexTextures->mBoundingBox;
+        return osg::Geometry::computeBoundingBox();
+    }
+
     void TerrainDrawable::setupWaterBoundingBox(float waterheight, float margin)
     {
         osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(getVertexArray());
@@ -159,6 +180,9 @@ namespace Terrain
             stateset->compileGLObjects(*renderInfo.getState());
         }
 
+        if (mVertexTextures)
+            mVertexTextures->mStateSet->compileGLObjects(*renderInfo.getState());
+
         osg::Geometry::compileGLObjects(renderInfo);
     }
 
@@ -30,6 +30,16 @@ namespace Terrain
     class TerrainDrawable : public osg::Geometry
     {
     public:
+        /// Heights, normals and colours of a chunk sampled by the vertex shader from textures, with what would
+        /// otherwise be computed from the vertex arrays. Shared by the chunks of the same center and LOD.
+        struct VertexTextures : public osg::Referenced
+        {
+            osg::ref_ptr<osg::StateSet> mStateSet;
+            osg::BoundingBox mBoundingBox;
+            osg::BoundingBox mWaterBoundingBox;
+            osg::ref_ptr<osg::ClusterCullingCallback> mClusterCullingCallback;
+        };
+
         osg::Object* cloneType() const override { return new TerrainDrawable(); }
         osg::Object* clone(const osg::CopyOp& copyop) const override { return new TerrainDrawable(*this, copyop); }
         bool isSameKindAs(const osg::Object* obj) const override
@@ -53,6 +63,7 @@ namespace Terrain
         void setLightListCallback(SceneUtil::LightListCallback* lightListCallback);
 
         void createClusterCullingCallback();
+        osg::ClusterCullingCallback* getClusterCullingCallback() const { return mClusterCullingCallback; }
 
         void compileGLObjects(osg::RenderInfo& renderInfo) const override;
 
@@ -63,6 +74,13 @@ namespace Terrain
         CompositeMap* getCompositeMap() const { return mCompositeMap; }
         void setCompositeMapRenderer(CompositeMapRenderer* renderer) { mCompositeMapRenderer = renderer; }
 
+        /// The vertex array is then expected to be a flat grid. Such chunks don't cast shadows since the shadow
+        /// casting shader uses the vertex arrays.
+        void setVertexTextures(VertexTextures* vertexTextures);
+        VertexTextures* getVertexTextures() const { return mVertexTextures; }
+
+        osg::BoundingBox computeBoundingBox() const override;
+
     private:
         osg::BoundingBox mWaterBoundingBox;
         PassVector mPasses;
@@ -72,6 +90,7 @@ namespace Terrain
         osg::ref_ptr<SceneUtil::LightListCallback> mLightListCallback;
         osg::ref_ptr<CompositeMap> mCompositeMap;
         osg::ref_ptr<CompositeMapRenderer> mCompositeMapRenderer;
+        osg::ref_ptr<VertexTextures> mVertexTextures;
     };
 
 }
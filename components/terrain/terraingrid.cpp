@@ -71,7 +71,7 @@ namespace Terrain
         else
         {
             osg::ref_ptr<osg::Node> node
-                = mChunkManager->getChunk(chunkSize, chunkCenter, 0, 0, false, osg::Vec3f(), true);
+                = mChunkManager->getChunk(chunkSize, chunkCenter, 0, 0, false, osg::Vec3f(), true, nullptr);
             if (!node)
                 return nullptr;
 
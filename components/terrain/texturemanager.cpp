@@ -1,6 +1,7 @@
 #include "texturemanager.hpp"
 
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/objectcache.hpp>
@@ -8,6 +9,16 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        bool canShareArray(const osg::Image& l, const osg::Image& r)
+        {
+            return l.s() == r.s() && l.t() == r.t() && l.r() == 1 && r.r() == 1
+                && l.getPixelFormat() == r.getPixelFormat()
+                && l.getInternalTextureFormat() == r.getInternalTextureFormat()
+                && l.getDataType() == r.getDataType() && l.getNumMipmapLevels() == r.getNumMipmapLevels();
+        }
+    }
 
     TextureManager::TextureManager(Resource::SceneManager* sceneMgr, double expiryDelay)
         : ResourceManager(sceneMgr->getVFS(), expiryDelay)
@@ -25,7 +36,7 @@ namespace Terrain
 
         void operator()(std::string, osg::Object* obj)
         {
-            mSceneManager->applyFilterSettings(static_cast<osg::Texture2D*>(obj));
+            mSceneManager->applyFilterSettings(static_cast<osg::Texture*>(obj));
         }
     };
 
@@ -53,6 +64,40 @@ namespace Terrain
         }
     }
 
+    osg::ref_ptr<osg::Texture2DArray> TextureManager::getTextureArray(const std::vector<std::string>& names)
+    {
+        // Texture names never contain a null character, so the key can't be the name of a single texture
+        std::string key;
+        for (const std::string& name : names)
+        {
+            key += name;
+            key += '\0';
+        }
+
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(key);
+        if (obj)
+            return static_cast<osg::Texture2DArray*>(obj.get());
+
+        std::vector<osg::ref_ptr<osg::Image>> images;
+        images.reserve(names.size());
+        for (const std::string& name : names)
+        {
+            images.push_back(mSceneManager->getImageManager()->getImage(name));
+            if (!canShareArray(*images.front(), *images.back()))
+                return nullptr;
+        }
+
+        osg::ref_ptr<osg::Texture2DArray> texture(new osg::Texture2DArray);
+        texture->setTextureSize(images.front()->s(), images.front()->t(), static_cast<int>(images.size()));
+        for (std::size_t i = 0; i < images.size(); ++i)
+            texture->setImage(static_cast<unsigned>(i), images[i]);
+        texture->setWrap(osg::Texture::WRAP_S, osg::Texture::REPEAT);
+        texture->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
+        mSceneManager->applyFilterSettings(texture);
+        mCache->addEntryToObjectCache(key, texture.get());
+        return texture;
+    }
+
     void TextureManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Terrain Texture", frameNumber, mCache->getStats(), *stats);
@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_TERRAIN_TEXTUREMANAGER_H
 
 #include <string>
+#include <vector>
 
 #include <components/resource/resourcemanager.hpp>
 
@@ -13,6 +14,7 @@ namespace Resource
 namespace osg
 {
     class Texture2D;
+    class Texture2DArray;
 }
 
 namespace Terrain
@@ -27,6 +29,10 @@ namespace Terrain
 
         osg::ref_ptr<osg::Texture2D> getTexture(const std::string& name);
 
+        /// @return An array with a layer for each texture, in the given order, or nullptr if the images don't all
+        /// have the same size and format.
+        osg::ref_ptr<osg::Texture2DArray> getTextureArray(const std::vector<std::string>& names);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
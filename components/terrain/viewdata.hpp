@@ -70,6 +70,7 @@ namespace Terrain
                 mNodes.clear();
             }
         }
+        const osg::Vec4i& getActiveGrid() const { return mActiveGrid; }
 
         unsigned int getWorldUpdateRevision() const { return mWorldUpdateRevision; }
         void setWorldUpdateRevision(int updateRevision) { mWorldUpdateRevision = updateRevision; }
@@ -115,6 +116,8 @@ namespace Terrain
 
         float getReuseDistance() const { return mReuseDistance; }
 
+        unsigned int getWorldUpdateRevision() const { return mWorldUpdateRevision; }
+
     private:
         std::list<ViewData> mViewVector;
 
@@ -8,6 +8,7 @@
 #include <components/settings/values.hpp>
 
 #include "chunkmanager.hpp"
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "heightcull.hpp"
 #include "storage.hpp"
@@ -126,6 +127,24 @@ namespace Terrain
         mCompositeMapRenderer->setTargetFrameRate(rate);
     }
 
+    void World::setCompositeMapCache(osg::ref_ptr<CompositeMapCache> cache)
+    {
+        if (mChunkManager)
+            mChunkManager->setCompositeMapCache(std::move(cache));
+    }
+
+    void World::setUseTextureArrays(bool enabled)
+    {
+        if (mChunkManager)
+            mChunkManager->setUseTextureArrays(enabled);
+    }
+
+    void World::setUseVertexTextureFetch(bool enabled)
+    {
+        if (mChunkManager)
+            mChunkManager->setUseVertexTextureFetch(enabled);
+    }
+
     float World::getHeightAt(const osg::Vec3f& worldPos)
     {
         return mStorage->getHeightAt(worldPos, mWorldspace);
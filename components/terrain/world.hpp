@@ -14,6 +14,7 @@
 
 namespace osg
 {
+    class Callback;
     class Group;
     class Stats;
 }
@@ -28,6 +29,11 @@ namespace Loading
     class Reporter;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
     class Storage;
@@ -35,6 +41,7 @@ namespace Terrain
     class TextureManager;
     class ChunkManager;
     class CompositeMapRenderer;
+    class CompositeMapCache;
     class View;
     class HeightCullCallback;
 
@@ -58,6 +65,15 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// See ChunkManager::setCompositeMapCache
+        void setCompositeMapCache(osg::ref_ptr<CompositeMapCache> cache);
+
+        /// See ChunkManager::setUseTextureArrays
+        void setUseTextureArrays(bool enabled);
+
+        /// See ChunkManager::setUseVertexTextureFetch
+        void setUseVertexTextureFetch(bool enabled);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
@@ -102,6 +118,12 @@ namespace Terrain
 
         virtual void setViewDistance(float distance) {}
 
+        /// Set the work queue used to prepare views in the background, if supported.
+        virtual void setWorkQueue(SceneUtil::WorkQueue* workQueue) {}
+
+        /// Set the cull callback of the distant chunks, if supported. The callback must accept world space bounds.
+        virtual void setChunkCullCallback(osg::Callback* callback) {}
+
         ESM::RefId getWorldspace() { return mWorldspace; }
 
         Storage* getStorage() { return mStorage; }
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <ios>
 #include <iterator>
 #include <stdexcept>
@@ -47,9 +48,23 @@ using namespace ToUTF8;
 
 namespace
 {
+    // Returns the position of the first zero or non-ASCII byte. Checks 8 bytes at once until a word contains one.
     std::string_view::iterator skipAscii(std::string_view input)
     {
-        return std::find_if(input.begin(), input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
+        constexpr std::uint64_t lowBits = 0x0101010101010101;
+        constexpr std::uint64_t highBits = 0x8080808080808080;
+
+        std::size_t offset = 0;
+        for (; offset + sizeof(std::uint64_t) <= input.size(); offset += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, input.data() + offset, sizeof(word));
+            // The high bit is set for non-ASCII bytes and, when there are none of them, for zero bytes
+            if (((word | ((word - lowBits) & ~word)) & highBits) != 0)
+                break;
+        }
+
+        return std::find_if(input.begin() + offset, input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
     }
 
     std::basic_string_view<signed char> getTranslationArray(FromType sourceEncoding)
@@ -126,9 +141,16 @@ std::string_view StatelessUtf8Encoder::getUtf8(
     resize(outlen, bufferAllocationPolicy, buffer);
     char* out = buffer.data();
 
-    // Translate
+    // Translate, copying the ASCII runs as they are
     for (auto it = input.begin(); it != input.end() && *it != 0; ++it)
+    {
+        const auto nonAscii = skipAscii(std::string_view(it, input.end()));
+        out = std::copy(it, nonAscii, out);
+        it = nonAscii;
+        if (it == input.end() || *it == 0)
+            break;
         copyFromArray(*it, out);
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == (int)outlen);
@@ -164,9 +186,16 @@ std::string_view StatelessUtf8Encoder::getLegacyEnc(
     resize(outlen, bufferAllocationPolicy, buffer);
     char* out = buffer.data();
 
-    // Translate
+    // Translate, copying the ASCII runs as they are
     for (auto it = input.begin(); it != input.end() && *it != 0;)
+    {
+        const auto nonAscii = skipAscii(std::string_view(it, input.end()));
+        out = std::copy(it, nonAscii, out);
+        it = nonAscii;
+        if (it == input.end() || *it == 0)
+            break;
         copyFromArrayLegacyEnc(it, input.end(), out);
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == static_cast<int>(outlen));
@@ -208,6 +237,11 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLength(std::string_view in
         // lookup table.
         len += mTranslationArray[static_cast<unsigned char>(*it) * 6];
         ++it;
+
+        // ASCII characters are not translated
+        const auto nonAscii = skipAscii(std::string_view(it, input.end()));
+        len += nonAscii - it;
+        it = nonAscii;
     } while (it != input.end() && *it != 0);
 
     return { len, false };
@@ -273,6 +307,14 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLengthLegacyEnc(std::strin
         }
 
         ++it;
+
+        // ASCII characters between complete symbols are not translated
+        if (symbolLen == 0)
+        {
+            const auto nonAscii = skipAscii(std::string_view(it, input.end()));
+            len += nonAscii - it;
+            it = nonAscii;
+        }
     } while (it != input.end() && *it != 0);
 
     return { len, false };
@@ -348,6 +390,12 @@ Utf8Encoder::Utf8Encoder(FromType sourceEncoding)
 {
 }
 
+Utf8Encoder::Utf8Encoder(const StatelessUtf8Encoder& encoder)
+    : mBuffer(50 * 1024, '\0')
+    , mImpl(encoder)
+{
+}
+
 std::string_view Utf8Encoder::getUtf8(std::string_view input)
 {
     return mImpl.getUtf8(input, BufferAllocationPolicy::UseGrowFactor, mBuffer);
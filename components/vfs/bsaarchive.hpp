@@ -28,6 +28,8 @@ namespace VFS
 
         Files::IStreamPtr open() override { return mFile->getFile(mInfo); }
 
+        void prefetch() override { mFile->prefetch(mInfo); }
+
         std::filesystem::path getPath() override { return mInfo->name(); }
 
         const Bsa::BSAFile::FileStruct* mInfo;
@@ -38,11 +40,11 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::filesystem::path& filename)
+        BsaArchive(const std::filesystem::path& filename, bool memoryMapped = false)
             : Archive()
         {
             mFile = std::make_unique<BSAFileType>();
-            mFile->open(filename);
+            mFile->open(filename, memoryMapped);
 
             const Bsa::BSAFile::FileList& filelist = mFile->getList();
             for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
@@ -73,20 +75,20 @@ namespace VFS
         std::vector<VFS::Path::Normalized> mFiles;
     };
 
-    inline std::unique_ptr<VFS::Archive> makeBsaArchive(const std::filesystem::path& path)
+    inline std::unique_ptr<VFS::Archive> makeBsaArchive(const std::filesystem::path& path, bool memoryMapped = false)
     {
         switch (Bsa::BSAFile::detectVersion(path))
         {
             case Bsa::BsaVersion::Unknown:
                 break;
             case Bsa::BsaVersion::Uncompressed:
-                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, memoryMapped);
             case Bsa::BsaVersion::Compressed:
-                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, memoryMapped);
             case Bsa::BsaVersion::BA2GNRL:
-                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, memoryMapped);
             case Bsa::BsaVersion::BA2DX10:
-                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path);
+                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, memoryMapped);
         }
 
         throw std::runtime_error("Unknown archive type '" + Files::pathToUnicodeString(path) + "'");
@@ -14,6 +14,10 @@ namespace VFS
 
         virtual Files::IStreamPtr open() = 0;
 
+        /// Hint to start reading the file contents in the background, a following open() is then served from
+        /// memory. May do nothing.
+        virtual void prefetch() {}
+
         virtual std::filesystem::path getPath() = 0;
     };
 }
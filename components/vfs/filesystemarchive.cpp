@@ -2,24 +2,48 @@
 
 #include <filesystem>
 
+#include "indexcache.hpp"
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/platform/file.hpp>
 
 namespace VFS
 {
 
-    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path)
+    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path, IndexCache* indexCache)
         : mPath(path)
     {
+        if (indexCache != nullptr)
+        {
+            if (const IndexCache::Listing* listing = indexCache->find(mPath))
+            {
+                for (const std::string& file : listing->mFiles)
+                    addFile(file, mPath / Files::pathFromUnicodeString(file));
+                return;
+            }
+        }
+
         const auto str = mPath.u8string();
         std::size_t prefix = str.size();
 
         if (prefix > 0 && str[prefix - 1] != '\\' && str[prefix - 1] != '/')
             ++prefix;
 
+        IndexCache::Listing listing;
+
+        if (indexCache != nullptr)
+        {
+            std::error_code ec;
+            const std::int64_t modificationTime = IndexCache::getModificationTime(mPath, ec);
+            if (ec != std::error_code())
+                indexCache = nullptr;
+            else
+                listing.mDirectories.emplace_back(std::string(), modificationTime);
+        }
+
         std::filesystem::recursive_directory_iterator iterator(mPath);
 
         for (auto it = std::filesystem::begin(iterator), end = std::filesystem::end(iterator); it != end;)
@@ -30,14 +54,20 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                const std::string_view relativePath = std::string_view{ proper }.substr(prefix);
+                addFile(relativePath, filePath);
+                if (indexCache != nullptr)
+                    listing.mFiles.emplace_back(relativePath);
+            }
+            else if (indexCache != nullptr)
+            {
+                std::error_code ec;
+                const std::int64_t modificationTime = IndexCache::getModificationTime(entry.path(), ec);
+                if (ec != std::error_code())
+                    indexCache = nullptr;
+                else
+                    listing.mDirectories.emplace_back(
+                        Files::pathToUnicodeString(entry.path()).substr(prefix), modificationTime);
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -51,6 +81,18 @@ namespace VFS
                     + "\" when incrementing to the next item from \"" + Files::pathToUnicodeString(prevPath)
                     + "\": " + ec.message());
         }
+
+        if (indexCache != nullptr)
+            indexCache->insert(mPath, std::move(listing));
+    }
+
+    void FileSystemArchive::addFile(std::string_view relativePath, const std::filesystem::path& filePath)
+    {
+        const auto inserted = mIndex.emplace(VFS::Path::Normalized(relativePath), FileSystemArchiveFile(filePath));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
     }
 
     void FileSystemArchive::listResources(FileMap& out)
@@ -81,4 +123,10 @@ namespace VFS
         return Files::openConstrainedFileStream(mPath);
     }
 
+    void FileSystemArchiveFile::prefetch()
+    {
+        Platform::File::ScopedHandle handle(Platform::File::open(mPath));
+        Platform::File::prefetch(handle, 0, Platform::File::size(handle));
+    }
+
 }
@@ -6,6 +6,7 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 namespace VFS
 {
@@ -17,16 +18,22 @@ namespace VFS
 
         Files::IStreamPtr open() override;
 
+        void prefetch() override;
+
         std::filesystem::path getPath() override { return mPath; }
 
     private:
         std::filesystem::path mPath;
     };
 
+    class IndexCache;
+
     class FileSystemArchive : public Archive
     {
     public:
-        FileSystemArchive(const std::filesystem::path& path);
+        /// @param indexCache Restore the list of files from the cache when the directory is not modified and store the
+        /// new list otherwise.
+        FileSystemArchive(const std::filesystem::path& path, IndexCache* indexCache = nullptr);
 
         void listResources(FileMap& out) override;
 
@@ -35,6 +42,8 @@ namespace VFS
         std::string getDescription() const override;
 
     private:
+        void addFile(std::string_view relativePath, const std::filesystem::path& filePath);
+
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
     };
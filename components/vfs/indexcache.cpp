@@ -0,0 +1,158 @@
+#include "indexcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace VFS
+{
+    namespace
+    {
+        constexpr char sMagic[] = { 'O', 'M', 'W', 'V', 'F', 'S', 'I', 'X' };
+        constexpr std::uint32_t sVersion = 1;
+
+        template <class T>
+        void writeValue(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(std::ostream& stream, const std::string& value)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value;
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string value(readValue<std::uint32_t>(stream), '\0');
+            if (!stream.read(value.data(), static_cast<std::streamsize>(value.size())))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+    }
+
+    IndexCache::IndexCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::ifstream stream(mPath, std::ios::binary);
+        if (!stream.is_open())
+            return;
+
+        try
+        {
+            char magic[sizeof(sMagic)];
+            if (!stream.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), sMagic))
+                throw std::runtime_error("not an index cache file");
+            if (readValue<std::uint32_t>(stream) != sVersion)
+                return;
+
+            std::map<std::string, Listing, std::less<>> listings;
+            for (std::uint32_t roots = readValue<std::uint32_t>(stream); roots > 0; --roots)
+            {
+                std::string root = readString(stream);
+                Listing listing;
+                for (std::uint32_t n = readValue<std::uint32_t>(stream); n > 0; --n)
+                {
+                    std::string directory = readString(stream);
+                    listing.mDirectories.emplace_back(std::move(directory), readValue<std::int64_t>(stream));
+                }
+                for (std::uint32_t n = readValue<std::uint32_t>(stream); n > 0; --n)
+                    listing.mFiles.push_back(readString(stream));
+                listings.emplace(std::move(root), std::move(listing));
+            }
+            mListings = std::move(listings);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read data directories index cache " << mPath << ": " << e.what();
+        }
+    }
+
+    const IndexCache::Listing* IndexCache::find(const std::filesystem::path& root) const
+    {
+        const auto it = mListings.find(Files::pathToUnicodeString(root));
+        if (it == mListings.end())
+            return nullptr;
+
+        for (const auto& [directory, modificationTime] : it->second.mDirectories)
+        {
+            std::error_code ec;
+            const std::int64_t actual = getModificationTime(root / Files::pathFromUnicodeString(directory), ec);
+            if (ec != std::error_code() || actual != modificationTime)
+                return nullptr;
+        }
+
+        return &it->second;
+    }
+
+    void IndexCache::insert(const std::filesystem::path& root, Listing&& listing)
+    {
+        mListings.insert_or_assign(Files::pathToUnicodeString(root), std::move(listing));
+        mChanged = true;
+    }
+
+    void IndexCache::write() const
+    {
+        if (!mChanged)
+            return;
+
+        try
+        {
+            std::filesystem::create_directories(mPath.parent_path());
+
+            std::filesystem::path tmpPath = mPath;
+            tmpPath += ".tmp";
+
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                    throw std::runtime_error("failed to open file");
+
+                stream.write(sMagic, sizeof(sMagic));
+                writeValue(stream, sVersion);
+                writeValue(stream, static_cast<std::uint32_t>(mListings.size()));
+                for (const auto& [root, listing] : mListings)
+                {
+                    writeString(stream, root);
+                    writeValue(stream, static_cast<std::uint32_t>(listing.mDirectories.size()));
+                    for (const auto& [directory, modificationTime] : listing.mDirectories)
+                    {
+                        writeString(stream, directory);
+                        writeValue(stream, modificationTime);
+                    }
+                    writeValue(stream, static_cast<std::uint32_t>(listing.mFiles.size()));
+                    for (const std::string& file : listing.mFiles)
+                        writeString(stream, file);
+                }
+
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write file");
+            }
+
+            std::filesystem::rename(tmpPath, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write data directories index cache " << mPath << ": " << e.what();
+        }
+    }
+
+    std::int64_t IndexCache::getModificationTime(const std::filesystem::path& path, std::error_code& ec)
+    {
+        return static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    }
+}
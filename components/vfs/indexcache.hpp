@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace VFS
+{
+    /// @brief Persistent listing of the data directories. A listing is reused when none of the directories it consists
+    /// of is modified since the listing was made so the directory tree doesn't have to be walked again.
+    class IndexCache
+    {
+    public:
+        struct Listing
+        {
+            /// Paths relative to the root directory with modification times, including the root itself as "".
+            std::vector<std::pair<std::string, std::int64_t>> mDirectories;
+            /// Paths relative to the root directory.
+            std::vector<std::string> mFiles;
+        };
+
+        /// Reads the cache file. A missing or broken file results in an empty cache.
+        explicit IndexCache(const std::filesystem::path& path);
+
+        /// @return listing of the given root directory or nullptr when there is none or any of its directories is
+        /// modified.
+        const Listing* find(const std::filesystem::path& root) const;
+
+        void insert(const std::filesystem::path& root, Listing&& listing);
+
+        /// Writes the cache file if it's changed. Failures are logged and ignored.
+        void write() const;
+
+        static std::int64_t getModificationTime(const std::filesystem::path& path, std::error_code& ec);
+
+    private:
+        std::filesystem::path mPath;
+        std::map<std::string, Listing, std::less<>> mListings;
+        bool mChanged = false;
+    };
+}
+
+#endif
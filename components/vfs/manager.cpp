@@ -4,6 +4,7 @@
 #include <cassert>
 #include <stdexcept>
 
+#include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/vfs/recursivedirectoryiterator.hpp>
@@ -57,6 +58,25 @@ namespace VFS
         return found->second->open();
     }
 
+    void Manager::prefetch(std::span<const Path::Normalized> names) const
+    {
+        for (const Path::Normalized& name : names)
+        {
+            const auto found = mIndex.find(name);
+            if (found == mIndex.end())
+                continue;
+            try
+            {
+                found->second->prefetch();
+            }
+            catch (const std::exception& e)
+            {
+                // Not fatal, the file will be read when it is needed and the error reported then
+                Log(Debug::Verbose) << "Failed to prefetch '" << name << "': " << e.what();
+            }
+        }
+    }
+
     bool Manager::exists(const Path::Normalized& name) const
     {
         return mIndex.find(name) != mIndex.end();
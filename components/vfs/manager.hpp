@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -57,6 +58,12 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(std::string_view normalizedName) const;
 
+        /// Start reading the given files in the background, e.g. before a worker thread loads them one by one.
+        /// Files that do not exist are skipped.
+        /// @note The system decides how much is read ahead, it is only a hint.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(std::span<const Path::Normalized> names) const;
+
         std::string getArchive(const Path::Normalized& name) const;
 
         /// Recursively iterate over the elements of the given path
@@ -14,7 +14,8 @@ namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles)
+        const std::vector<std::string>& archives, bool useLooseFiles, bool memoryMapArchives,
+        IndexCache* indexCache)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -25,7 +26,7 @@ namespace VFS
                 // Last BSA has the highest priority
                 const auto archivePath = collections.getPath(*archive);
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
-                vfs->addArchive(makeBsaArchive(archivePath));
+                vfs->addArchive(makeBsaArchive(archivePath, memoryMapArchives));
             }
             else
             {
@@ -42,7 +43,7 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir, indexCache));
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
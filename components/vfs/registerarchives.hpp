@@ -5,11 +5,15 @@
 
 namespace VFS
 {
+    class IndexCache;
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param memoryMapArchives Map BSA archives into memory instead of reading each contained file separately.
+    /// @param indexCache Cache for the listings of the data directories, may be nullptr.
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, bool memoryMapArchives = false,
+        IndexCache* indexCache = nullptr);
 }
 
 #endif
@@ -351,20 +351,23 @@ void VideoState::video_refresh()
 int VideoState::queue_picture(const AVFrame &pFrame, double pts)
 {
     VideoPicture *vp;
+    unsigned long windex;
 
     /* wait until we have a new pic */
     {
         std::unique_lock<std::mutex> lock(this->pictq_mutex);
         while(this->pictq_size >= VIDEO_PICTURE_QUEUE_SIZE && !this->mQuit)
             this->pictq_cond.wait_for(lock, std::chrono::milliseconds(1));
+
+        // windex is set to 0 initially
+        windex = this->pictq_windex;
     }
     if(this->mQuit)
         return -1;
 
-    std::lock_guard<std::mutex> lock(this->pictq_mutex);
-
-    // windex is set to 0 initially
-    vp = &this->pictq[this->pictq_windex];
+    // The display thread doesn't read the picture at windex until it is queued, so it is converted without holding
+    // the lock
+    vp = &this->pictq[windex];
 
     // Convert the image into RGBA format
     // TODO: we could do this in a pixel shader instead, if the source format
@@ -389,7 +392,13 @@ int VideoState::queue_picture(const AVFrame &pFrame, double pts)
         return -1;
 
     sws_scale(this->sws_context, pFrame.data, pFrame.linesize,
-              0, this->video_ctx->height, vp->rgbaFrame->data, vp->rgbaFrame->linesize);
+              0, h, vp->rgbaFrame->data, vp->rgbaFrame->linesize);
+
+    std::lock_guard<std::mutex> lock(this->pictq_mutex);
+
+    // the queue was flushed by a seek in the meantime
+    if (this->pictq_windex != windex)
+        return 0;
 
     // now we inform our display thread that we have a pic ready
     this->pictq_windex = (this->pictq_windex+1) % this->pictq.size();
@@ -707,6 +716,11 @@ int VideoState::stream_open(int stream_index, AVFormatContext *pFormatCtx)
         av_codec_set_pkt_timebase(this->video_ctx, pFormatCtx->streams[stream_index]->time_base);
 #endif
 
+        // Decode on as many threads as there are cores. Frame threading delays the output by a frame per thread,
+        // which the picture queue absorbs.
+        this->video_ctx->thread_count = 0;
+        this->video_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
         if (avcodec_open2(this->video_ctx, codec, nullptr) < 0)
         {
             fprintf(stderr, "Unsupported codec!\n");
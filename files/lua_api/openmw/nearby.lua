@@ -30,6 +30,46 @@
 -- List of nearby players. Currently (since multiplayer is not yet implemented) always has one element.
 -- @field [parent=#nearby] openmw.core#ObjectList players
 
+---
+-- @type OBJECT_GROUP
+-- @field [parent=#OBJECT_GROUP] #number Activator Objects from @{#nearby.activators}
+-- @field [parent=#OBJECT_GROUP] #number Actor Objects from @{#nearby.actors}
+-- @field [parent=#OBJECT_GROUP] #number Container Objects from @{#nearby.containers}
+-- @field [parent=#OBJECT_GROUP] #number Door Objects from @{#nearby.doors}
+-- @field [parent=#OBJECT_GROUP] #number Item Objects from @{#nearby.items}
+-- @field [parent=#OBJECT_GROUP] #number Any All of the above
+
+---
+-- Groups of objects that are used in `findInRadius` and `findInBox`.
+-- Several groups can be combined with @{openmw_util#util.bitOr}.
+-- @field [parent=#nearby] #OBJECT_GROUP OBJECT_GROUP
+
+---
+-- A table of parameters for @{#nearby.findInRadius} and @{#nearby.findInBox}
+-- @type FindObjectsOptions
+-- @field #number groups Groups of objects to search (see @{openmw.nearby#OBJECT_GROUP}), all of them by default.
+
+---
+-- Find nearby objects with the position inside the sphere.
+-- Uses a spatial index, much cheaper than iterating over the lists like @{#nearby.items} in Lua.
+-- @function [parent=#nearby] findInRadius
+-- @param openmw.util#Vector3 center Center of the sphere.
+-- @param #number radius Radius of the sphere.
+-- @param #FindObjectsOptions options An optional table with additional optional arguments
+-- @return openmw.core#ObjectList Found objects, the nearest first
+-- @usage local enemies = nearby.findInRadius(self.position, 1000, {groups = nearby.OBJECT_GROUP.Actor})
+
+---
+-- Find nearby objects with the position inside the axis aligned box.
+-- @function [parent=#nearby] findInBox
+-- @param openmw.util#Vector3 min Corner of the box with the minimal coordinates.
+-- @param openmw.util#Vector3 max Corner of the box with the maximal coordinates.
+-- @param #FindObjectsOptions options An optional table with additional optional arguments
+-- @return openmw.core#ObjectList Found objects
+-- @usage local loot = nearby.findInBox(min, max, {
+--     groups = util.bitOr(nearby.OBJECT_GROUP.Item, nearby.OBJECT_GROUP.Container),
+-- })
+
 ---
 -- Return an object by RefNum/FormId.
 -- Note: the function always returns @{openmw.core#GameObject} and doesn't validate that
@@ -89,6 +129,20 @@
 --     radius = 10,
 -- })
 
+---
+-- Asynchronously cast ray from one point to another and find the first collision.
+-- The ray is cast in parallel with the physics simulation,
+-- the result is passed to the callback one or two frames later.
+-- Cheaper than `castRay` when many rays are cast each frame.
+-- @function [parent=#nearby] asyncCastRay
+-- @param openmw.async#Callback callback The callback to pass the result to (should accept a single argument @{openmw.nearby#RayCastingResult}).
+-- @param openmw.util#Vector3 from Start point of the ray.
+-- @param openmw.util#Vector3 to End point of the ray.
+-- @param #CastRayOptions options An optional table with additional optional arguments. NOTE: `radius` is not supported.
+-- @usage nearby.asyncCastRay(async:callback(function(res)
+--     if res.hit then print('obstacle between A and B') end
+-- end), pointA, pointB)
+
 ---
 -- A table of parameters for @{#nearby.castRenderingRay} and @{#nearby.asyncCastRenderingRay}
 -- @type CastRenderingRayOptions
@@ -171,7 +225,7 @@
 -- (default: 1).
 
 ---
--- A table of parameters for @{#nearby.findPath}
+-- A table of parameters for @{#nearby.findPath} and @{#nearby.asyncFindPath}
 -- @type FindPathOptions
 -- @field [parent=#FindPathOptions] #AgentBounds agentBounds identifies which navmesh to use.
 -- @field [parent=#FindPathOptions] #number includeFlags allowed areas for agent to move, a sum of @{#NAVIGATOR_FLAGS}
@@ -220,6 +274,20 @@
 --     agentBounds = Actor.getPathfindingAgentBounds(self),
 -- })
 
+---
+-- Asynchronously find path over navigation mesh from source to destination with given options. The path is searched
+-- for in a worker thread over the navigation mesh as it is when the search starts, and the result is passed to the
+-- callback during one of the next frames.
+-- @function [parent=#nearby] asyncFindPath
+-- @param openmw.async#Callback callback The callback to pass the result to (should accept two arguments
+-- @{#FIND_PATH_STATUS} and #list<openmw.util#Vector3>).
+-- @param openmw.util#Vector3 source Initial path position.
+-- @param openmw.util#Vector3 destination Final path position.
+-- @param #FindPathOptions options An optional table with additional optional arguments.
+-- @usage nearby.asyncFindPath(async:callback(function(status, path)
+--     if status == nearby.FIND_PATH_STATUS.Success then print('path has ' .. #path .. ' points') end
+-- end), source, destination)
+
 ---
 -- Returns random location on navigation mesh within the reach of specified location.
 -- The location is not exactly constrained by the circle, but it limits the area.
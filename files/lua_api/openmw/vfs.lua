@@ -130,6 +130,39 @@
 --     print(line);
 -- end
 
+---
+-- A pending @{#vfs.asyncRead}.
+-- @type AsyncReadRequest
+-- @field #string fileName VFS path to the file being read
+-- @field #boolean isDone True once the file is read or the request is cancelled
+-- @field #boolean isCancelled True if the request is cancelled
+
+---
+-- Cancel the request. The callback is not called after the cancellation, even if the file is already read.
+-- @function [parent=#AsyncReadRequest] cancel
+-- @param self
+
+---
+-- A table of parameters for @{#vfs.asyncRead}
+-- @type AsyncReadOptions
+-- @field #number maxBytes Files larger than this are not read and passed to the callback as an error
+-- (default: 64 MiB).
+
+---
+-- Read the whole file in a background thread, so large files do not stall the frame.
+-- The callback is called in one of the next frames with the content of the file as a string,
+-- or with nil and an error message if the file can not be read.
+-- @function [parent=#vfs] asyncRead
+-- @param openmw.async#Callback callback The callback to pass the result to.
+-- @param #string fileName Path to file in VFS
+-- @param #AsyncReadOptions options An optional table with additional optional arguments.
+-- @return #AsyncReadRequest
+-- @usage local request = vfs.asyncRead(async:callback(function(content, err)
+--     if content then print(#content) else print(err) end
+-- end), "Test\\test.txt", { maxBytes = 1024 * 1024 })
+-- -- the callback is not called anymore
+-- request:cancel()
+
 ---
 -- Get iterator function to fetch file names with given path prefix from VFS
 -- @function [parent=#vfs] pathsWithPrefix
@@ -146,6 +146,31 @@
 -- @return openmw.core#GameObject
 -- @usage local obj = world.getObjectByFormId(core.getFormId('Morrowind.esm', 128964))
 
+---
+-- Enable or disable many objects at once.
+-- The effect is not immediate, all objects change in the next frame at once. Faster than setting `enabled` of
+-- every object, the collision bounds of the objects are updated once for the whole call.
+-- @function [parent=#world] setObjectsEnabled
+-- @param #any objects A list of @{openmw.core#GameObject}, e.g. @{openmw.core#ObjectList} or a Lua array
+-- @param #boolean enabled
+-- @usage world.setObjectsEnabled(nearbyBarrels, false)
+
+---
+-- Move many objects at once, as @{openmw.core#GameObject.teleport} does for one object.
+-- The effect is not immediate, all objects move in the next frame at once. Faster than calling `teleport` for
+-- every object, the collision bounds of the objects are updated once for the whole call.
+-- Can't be used for the player or for objects in containers and inventories.
+-- @function [parent=#world] teleportObjects
+-- @param #any objects A list of @{openmw.core#GameObject}, e.g. @{openmw.core#ObjectList} or a Lua array
+-- @param #any cellOrName A cell to define the destination worldspace, see @{openmw.core#GameObject.teleport}.
+-- @param #list<openmw.util#Vector3> positions New positions, one per object.
+-- @param #TeleportObjectsOptions options (optional)
+
+---
+-- @type TeleportObjectsOptions
+-- @field #list<openmw.util#Transform> rotations New rotations, one per object; if missing, then the current rotations are used.
+-- @field #boolean onGround If true, adjust destination positions to the ground.
+
 ---
 -- Create a new instance of the given record.
 -- After creation the object is in the disabled state. Use :teleport to place to the world or :moveInto to put it into a container or an inventory.
@@ -37,22 +37,44 @@ varying vec3 passNormal;
 #include "compatibility/vertexcolors.glsl"
 #include "compatibility/shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
+#include "compatibility/skinning.glsl"
+#include "compatibility/morphing.glsl"
+#include "compatibility/instancing.glsl"
 
 void main(void)
 {
-    gl_Position = modelToClip(gl_Vertex);
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+    vec4 tangent = gl_MultiTexCoord7.xyzw;
+#if @morphing
+    vertex.xyz += getMorphOffset();
+#endif
+#if @skinning
+    mat4 skinningMatrix = getSkinningMatrix(boneIndices, boneWeights);
+    vertex = skinningMatrix * vertex;
+    normal = mat3(skinningMatrix) * normal;
+    tangent.xyz = mat3(skinningMatrix) * tangent.xyz;
+#endif
+#if @instancing
+    mat4 instanceMatrix = getInstanceMatrix(aOffset, aRotation);
+    vertex = instanceMatrix * vertex;
+    normal = normalize(mat3(instanceMatrix) * normal);
+    tangent.xyz = mat3(instanceMatrix) * tangent.xyz;
+#endif
+
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     normalToViewMatrix = gl_NormalMatrix;
 
 #if @normalMap
-    normalToViewMatrix *= generateTangentSpace(gl_MultiTexCoord7.xyzw, passNormal);
+    normalToViewMatrix *= generateTangentSpace(tangent, passNormal);
 #endif
 
 #if @diffuseMap
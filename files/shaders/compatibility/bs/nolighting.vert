@@ -27,12 +27,31 @@ uniform vec4 falloffParams;
 
 #include "compatibility/vertexcolors.glsl"
 #include "compatibility/shadows_vertex.glsl"
+#include "compatibility/skinning.glsl"
+#include "compatibility/morphing.glsl"
+#include "compatibility/instancing.glsl"
 
 void main(void)
 {
-    gl_Position = modelToClip(gl_Vertex);
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+#if @morphing
+    vertex.xyz += getMorphOffset();
+#endif
+#if @skinning
+    mat4 skinningMatrix = getSkinningMatrix(boneIndices, boneWeights);
+    vertex = skinningMatrix * vertex;
+    normal = mat3(skinningMatrix) * normal;
+#endif
+#if @instancing
+    mat4 instanceMatrix = getInstanceMatrix(aOffset, aRotation);
+    vertex = instanceMatrix * vertex;
+    normal = normalize(mat3(instanceMatrix) * normal);
+#endif
+
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
@@ -43,11 +62,11 @@ void main(void)
 
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
 
     if (useFalloff)
     {
-        vec3 viewNormal = gl_NormalMatrix * normalize(gl_Normal.xyz);
+        vec3 viewNormal = gl_NormalMatrix * normalize(normal);
         vec3 viewDir = normalize(viewPos.xyz);
         float viewAngle = abs(dot(viewNormal, viewDir));
         passFalloff = smoothstep(falloffParams.x, falloffParams.y, viewAngle);
@@ -130,6 +130,14 @@ void main(void)
     vec3 position = aOffset.xyz;
     float scale = aOffset.w;
 
+    // Chunks are culled by distance as a whole, skip the work for their farther instances
+    if (length(gl_ModelViewMatrix * vec4(position, 1.0)) > @groundcoverFadeEnd)
+    {
+        gl_ClipVertex = vec4(0.0, 0.0, 0.0, 1.0);
+        gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
     mat4 rotation = rotation(aRotation);
     vec4 displacedVertex = rotation * scale * gl_Vertex;
 
@@ -142,10 +150,7 @@ void main(void)
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
 
-    if (length(gl_ModelViewMatrix * vec4(position, 1.0)) > @groundcoverFadeEnd)
-        gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
-    else
-        gl_Position = viewToClip(viewPos);
+    gl_Position = viewToClip(viewPos);
 
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
@@ -0,0 +1,34 @@
+#version 120
+#extension GL_EXT_gpu_shader4: require
+
+uniform sampler2D depthTex;
+uniform ivec2 hizSize;
+
+// Write the farthest depth of the screen area covered by the texel
+void main()
+{
+    ivec2 depthSize = textureSize2D(depthTex, 0);
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 begin = texel * depthSize / hizSize;
+    ivec2 end = max((texel + ivec2(1)) * depthSize / hizSize, begin + ivec2(1));
+
+#if @reverseZ
+    float farthest = 1.0;
+#else
+    float farthest = 0.0;
+#endif
+    for (int y = begin.y; y < end.y; ++y)
+    {
+        for (int x = begin.x; x < end.x; ++x)
+        {
+            float depth = texelFetch2D(depthTex, ivec2(x, y), 0).r;
+#if @reverseZ
+            farthest = min(farthest, depth);
+#else
+            farthest = max(farthest, depth);
+#endif
+        }
+    }
+
+    gl_FragColor = vec4(farthest, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,22 @@
+#if @instancing
+attribute vec4 aOffset;
+attribute vec3 aRotation;
+#endif
+
+// Same transform as used by the groundcover: xyz of the offset is the position, w is the scale and the rotation is
+// given by the Euler angles of the ESM position
+mat4 getInstanceMatrix(vec4 offset, vec3 rotation)
+{
+    float sin_x = sin(rotation.x);
+    float cos_x = cos(rotation.x);
+    float sin_y = sin(rotation.y);
+    float cos_y = cos(rotation.y);
+    float sin_z = sin(rotation.z);
+    float cos_z = cos(rotation.z);
+
+    return mat4(
+        offset.w * vec4(cos_z*cos_y+sin_x*sin_y*sin_z, -sin_z*cos_x, cos_z*sin_y+sin_z*sin_x*cos_y, 0.0),
+        offset.w * vec4(sin_z*cos_y+cos_z*sin_x*sin_y, cos_z*cos_x, sin_z*sin_y-cos_z*sin_x*cos_y, 0.0),
+        offset.w * vec4(-sin_y*cos_x, sin_x, cos_x*cos_y, 0.0),
+        vec4(offset.xyz, 1.0));
+}
@@ -0,0 +1,18 @@
+#if @morphing
+// Matches SceneUtil::MorphGeometry::sMaxGpuMorphTargets
+uniform float morphWeights[64];
+uniform int morphTargets;
+uniform int morphVertices;
+uniform samplerBuffer morphOffsets;
+
+vec3 getMorphOffset()
+{
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < morphTargets; ++i)
+    {
+        if (morphWeights[i] != 0.0)
+            result += texelFetchBuffer(morphOffsets, i * morphVertices + gl_VertexID).xyz * morphWeights[i];
+    }
+    return result;
+}
+#endif
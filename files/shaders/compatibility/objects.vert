@@ -68,6 +68,9 @@ varying vec4 passTangent;
 #include "vertexcolors.glsl"
 #include "shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
+#include "compatibility/skinning.glsl"
+#include "compatibility/morphing.glsl"
+#include "compatibility/instancing.glsl"
 
 #include "lib/light/lighting.glsl"
 #include "lib/view/depth.glsl"
@@ -81,22 +84,44 @@ uniform mat4 osg_ViewMatrixInverse;
 
 void main(void)
 {
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+#if @morphing
+    vertex.xyz += getMorphOffset();
+#endif
+#if @skinning
+    mat4 skinningMatrix = getSkinningMatrix(boneIndices, boneWeights);
+    vertex = skinningMatrix * vertex;
+    normal = mat3(skinningMatrix) * normal;
+#endif
+#if @instancing
+    mat4 instanceMatrix = getInstanceMatrix(aOffset, aRotation);
+    vertex = instanceMatrix * vertex;
+    normal = normalize(mat3(instanceMatrix) * normal);
+#endif
+
 #if @particleOcclusion
     mat4 model = osg_ViewMatrixInverse * gl_ModelViewMatrix;
-    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(gl_Vertex.xyz, 1.0)).xyz;
+    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(vertex.xyz, 1.0)).xyz;
 #endif
 
-    gl_Position = modelToClip(gl_Vertex);
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     normalToViewMatrix = gl_NormalMatrix;
 
 #if @normalMap || @diffuseParallax
     passTangent = gl_MultiTexCoord7.xyzw;
+#if @skinning
+    passTangent.xyz = mat3(skinningMatrix) * passTangent.xyz;
+#endif
+#if @instancing
+    passTangent.xyz = mat3(instanceMatrix) * passTangent.xyz;
+#endif
     normalToViewMatrix *= generateTangentSpace(passTangent, passNormal);
 #endif
 
@@ -8,12 +8,27 @@ uniform int colorMode;
 uniform bool useTreeAnim;
 uniform bool useDiffuseMapForShadowAlpha = true;
 uniform bool alphaTestShadows = true;
+uniform bool useSkinning = false;
+uniform bool useInstancing = false;
+
+// Bone indices and weights of the skinned geometry or the instance transforms of the instanced geometry
+attribute vec4 customAttribute6;
+attribute vec4 customAttribute7;
+
+#include "compatibility/skinning.glsl"
+#include "compatibility/instancing.glsl"
 
 void main(void)
 {
-    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    vec4 vertex = gl_Vertex;
+    if (useSkinning)
+        vertex = getSkinningMatrix(customAttribute6, customAttribute7) * vertex;
+    else if (useInstancing)
+        vertex = getInstanceMatrix(customAttribute6, customAttribute7.xyz) * vertex;
+
+    gl_Position = gl_ModelViewProjectionMatrix * vertex;
 
-    vec4 viewPos = (gl_ModelViewMatrix * gl_Vertex);
+    vec4 viewPos = (gl_ModelViewMatrix * vertex);
     gl_ClipVertex = viewPos;
 
     if (useDiffuseMapForShadowAlpha)
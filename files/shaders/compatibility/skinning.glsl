@@ -0,0 +1,18 @@
+// Matches SceneUtil::RigGeometry::sMaxGpuSkinningBones
+uniform mat4 boneMatrices[64];
+
+#if @skinning
+attribute vec4 boneIndices;
+attribute vec4 boneWeights;
+#endif
+
+mat4 getSkinningMatrix(vec4 indices, vec4 weights)
+{
+    mat4 result = boneMatrices[int(indices.x)] * weights.x
+        + boneMatrices[int(indices.y)] * weights.y
+        + boneMatrices[int(indices.z)] * weights.z
+        + boneMatrices[int(indices.w)] * weights.w;
+    // Same as the CPU skinning, weights don't have to add up to 1
+    result[3][3] = 1.0;
+    return result;
+}
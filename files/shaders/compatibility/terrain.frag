@@ -8,8 +8,21 @@
     #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if @textureArrays
+    #extension GL_EXT_texture_array : require
+#endif
+
 varying vec2 uv;
 
+#if @textureArrays
+// A layer of each array for each texture layer of the chunk
+uniform sampler2DArray diffuseMap;
+uniform sampler2DArray blendMap;
+
+#if @normalMap
+uniform sampler2DArray normalMap;
+#endif
+#else
 uniform sampler2D diffuseMap;
 
 #if @normalMap
@@ -19,6 +32,7 @@ uniform sampler2D normalMap;
 #if @blendMap
 uniform sampler2D blendMap;
 #endif
+#endif
 
 varying float euclideanDepth;
 varying float linearDepth;
@@ -48,6 +62,31 @@ void main()
 {
     vec2 adjustedUV = (gl_TextureMatrix[0] * vec4(uv, 0.0, 1.0)).xy;
 
+#if @textureArrays
+    // The blendmaps of a chunk add up to one, so blending the layers in one pass gives the same result as drawing
+    // them one by one. Layers are sampled unconditionally to keep the texture derivatives defined.
+    vec2 blendMapUV = (gl_TextureMatrix[1] * vec4(uv, 0.0, 1.0)).xy;
+    vec4 diffuseTex = vec4(0.0);
+#if @normalMap
+    vec4 normalTex = vec4(0.0);
+#endif
+    for (int i = 0; i < @layerCount; ++i)
+    {
+        float blend = texture2DArray(blendMap, vec3(blendMapUV, float(i))).a;
+        vec3 layerUV = vec3(adjustedUV, float(i));
+#if @parallax
+        layerUV.xy += getParallaxOffset(transpose(normalToViewMatrix) * normalize(-passViewPos), texture2DArray(normalMap, layerUV).a, 1.f);
+#endif
+        diffuseTex += texture2DArray(diffuseMap, layerUV) * blend;
+#if @normalMap
+        normalTex += texture2DArray(normalMap, layerUV) * blend;
+#endif
+    }
+    gl_FragData[0] = vec4(diffuseTex.xyz, 1.0);
+
+    vec4 diffuseColor = getDiffuseColor();
+    gl_FragData[0].a *= diffuseColor.a;
+#else
 #if @parallax
     adjustedUV += getParallaxOffset(transpose(normalToViewMatrix) * normalize(-passViewPos), texture2D(normalMap, adjustedUV).a, 1.f);
 #endif
@@ -61,9 +100,12 @@ void main()
     vec2 blendMapUV = (gl_TextureMatrix[1] * vec4(uv, 0.0, 1.0)).xy;
     gl_FragData[0].a *= texture2D(blendMap, blendMapUV).a;
 #endif
+#endif
 
 #if @normalMap
+#if !@textureArrays
     vec4 normalTex = texture2D(normalMap, adjustedUV);
+#endif
     vec3 normal = normalTex.xyz * 2.0 - 1.0;
 #if @reconstructNormalZ
     normal.z = sqrt(1.0 - dot(normal.xy, normal.xy));
@@ -24,6 +24,13 @@ centroid varying vec3 shadowSpecularLighting;
 varying vec3 passViewPos;
 varying vec3 passNormal;
 
+#if @vertexTextureFetch
+uniform sampler2D vertexHeightMap;
+uniform sampler2D vertexNormalMap;
+uniform sampler2D vertexColorMap;
+uniform float vertexTextureSize;
+#endif
+
 #include "vertexcolors.glsl"
 #include "shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
@@ -33,15 +40,27 @@ varying vec3 passNormal;
 
 void main(void)
 {
-    gl_Position = modelToClip(gl_Vertex);
+#if @vertexTextureFetch
+    // The vertex grid is shared, so find the texel of the vertex from its position in the chunk
+    vec2 vertexUV = (vec2(1.0 - gl_MultiTexCoord0.y, gl_MultiTexCoord0.x) * (vertexTextureSize - 1.0) + 0.5) / vertexTextureSize;
+    vec4 vertex = vec4(gl_Vertex.xy, texture2DLod(vertexHeightMap, vertexUV, 0.0).r, 1.0);
+    vec3 normal = texture2DLod(vertexNormalMap, vertexUV, 0.0).xyz * 2.0 - 1.0;
+    vec4 color = texture2DLod(vertexColorMap, vertexUV, 0.0);
+#else
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+    vec4 color = gl_Color;
+#endif
+
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
-    passColor = gl_Color;
-    passNormal = gl_Normal.xyz;
+    passColor = color;
+    passNormal = normal;
     passViewPos = viewPos.xyz;
     normalToViewMatrix = gl_NormalMatrix;
 
@@ -0,0 +1,25 @@
+#version 120
+
+varying vec2 uv;
+
+uniform sampler2D lastShader;
+uniform vec2 texelSize;
+uniform float sharpness;
+
+// Bilinear upscale of the scene rendered at a lower resolution, sharpened to make up for the lost detail
+void main()
+{
+    vec4 center = texture2D(lastShader, uv);
+    vec3 left = texture2D(lastShader, uv - vec2(texelSize.x, 0.0)).rgb;
+    vec3 right = texture2D(lastShader, uv + vec2(texelSize.x, 0.0)).rgb;
+    vec3 down = texture2D(lastShader, uv - vec2(0.0, texelSize.y)).rgb;
+    vec3 up = texture2D(lastShader, uv + vec2(0.0, texelSize.y)).rgb;
+
+    vec3 sharpened = center.rgb + (center.rgb * 4.0 - left - right - down - up) * sharpness * 0.25;
+
+    // Stay within the neighbourhood to avoid halos around the edges
+    vec3 minColor = min(center.rgb, min(min(left, right), min(down, up)));
+    vec3 maxColor = max(center.rgb, max(max(left, right), max(down, up)));
+
+    gl_FragColor = vec4(clamp(sharpened, minColor, maxColor), center.a);
+}
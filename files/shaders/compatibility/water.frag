@@ -82,6 +82,13 @@ uniform bool enableRainRipples;
 
 uniform vec2 screenRes;
 
+#if @waterReprojection
+varying vec4 reflectionClipPos;
+#if @waterRefraction
+varying vec4 refractionClipPos;
+#endif
+#endif
+
 #define PER_PIXEL_LIGHTING 0
 
 #include "shadows_fragment.glsl"
@@ -98,6 +105,15 @@ void main(void)
     float shadow = unshadowedLightRatio(linearDepth);
 
     vec2 screenCoords = gl_FragCoord.xy / screenRes;
+#if @waterReprojection
+    vec2 reflectionCoords = reflectionClipPos.xy / reflectionClipPos.w * 0.5 + 0.5;
+#if @waterRefraction
+    vec2 refractionCoords = refractionClipPos.xy / refractionClipPos.w * 0.5 + 0.5;
+#endif
+#else
+    vec2 reflectionCoords = screenCoords;
+    vec2 refractionCoords = screenCoords;
+#endif
 
     #define waterTimer osg_SimulationTime
 
@@ -144,15 +160,15 @@ void main(void)
 
     vec2 screenCoordsOffset = normal.xy * REFL_BUMP;
 #if @waterRefraction
-    float depthSample = linearizeDepth(sampleRefractionDepthMap(screenCoords), near, far);
+    float depthSample = linearizeDepth(sampleRefractionDepthMap(refractionCoords), near, far);
     float surfaceDepth = linearizeDepth(gl_FragCoord.z, near, far);
     float realWaterDepth = depthSample - surfaceDepth;  // undistorted water depth in view direction, independent of frustum
-    float depthSampleDistorted = linearizeDepth(sampleRefractionDepthMap(screenCoords - screenCoordsOffset), near, far);
+    float depthSampleDistorted = linearizeDepth(sampleRefractionDepthMap(refractionCoords - screenCoordsOffset), near, far);
     float waterDepthDistorted = max(depthSampleDistorted - surfaceDepth, 0.0);
     screenCoordsOffset *= clamp(realWaterDepth / BUMP_SUPPRESS_DEPTH, 0.0, 1.0);
 #endif
     // reflection
-    vec3 reflection = sampleReflectionMap(screenCoords + screenCoordsOffset).rgb;
+    vec3 reflection = sampleReflectionMap(reflectionCoords + screenCoordsOffset).rgb;
 
     vec3 waterColor = WATER_COLOR * sunFade;
 
@@ -173,14 +189,14 @@ void main(void)
     if (cameraPos.z > 0.0 && realWaterDepth <= VISIBILITY_DEPTH && waterDepthDistorted > VISIBILITY_DEPTH)
         screenCoordsOffset = vec2(0.0);
 
-    depthSampleDistorted = linearizeDepth(sampleRefractionDepthMap(screenCoords - screenCoordsOffset), near, far);
+    depthSampleDistorted = linearizeDepth(sampleRefractionDepthMap(refractionCoords - screenCoordsOffset), near, far);
     waterDepthDistorted = max(depthSampleDistorted - surfaceDepth, 0.0);
 
     // fade to realWaterDepth at a distance to compensate for physically inaccurate depth calculation
     waterDepthDistorted = mix(waterDepthDistorted, realWaterDepth, min(surfaceDepth / REFR_FOG_DISTORT_DISTANCE, 1.0));
 
     // refraction
-    vec3 refraction = sampleRefractionMap(screenCoords - screenCoordsOffset).rgb;
+    vec3 refraction = sampleRefractionMap(refractionCoords - screenCoordsOffset).rgb;
     vec3 rawRefraction = refraction;
 
     // brighten up the refraction underwater
@@ -14,6 +14,15 @@ uniform vec3 playerPos;
 varying vec3 worldPos;
 varying vec2 rippleMapUV;
 
+#if @waterReprojection
+uniform mat4 reflectionViewProjection;
+varying vec4 reflectionClipPos;
+#if @waterRefraction
+uniform mat4 refractionViewProjection;
+varying vec4 refractionClipPos;
+#endif
+#endif
+
 void main(void)
 {
     gl_Position = modelToClip(gl_Vertex);
@@ -23,6 +32,15 @@ void main(void)
     worldPos = position.xyz + nodePosition.xyz;
     rippleMapUV = (worldPos.xy - playerPos.xy + (@rippleMapSize * @rippleMapWorldScale / 2.0)) / @rippleMapSize / @rippleMapWorldScale;
 
+#if @waterReprojection
+    // The reflection and refraction maps may have been rendered from the camera of a previous frame. Points of the
+    // water surface are kept in place by both, so projecting them with that camera locates them in the maps.
+    reflectionClipPos = reflectionViewProjection * vec4(worldPos, 1.0);
+#if @waterRefraction
+    refractionClipPos = refractionViewProjection * vec4(worldPos, 1.0);
+#endif
+#endif
+
     vec4 viewPos = modelToView(gl_Vertex);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
@@ -55,10 +55,19 @@ void doLighting(vec3 viewPos, vec3 viewNormal, float shininess, out vec3 diffuse
     specularLight = vec3(0.0);
 #endif
 
+#if @lightingMethodClustered
+    int clusterData = getClusterData(viewPos);
+    int clusterOffset = clusterData >> 8;
+    int clusterCount = clusterData & 0xff;
+    for (int i = 0; i < clusterCount; ++i)
+#else
     for (int i = @startLight; i < @endLight; ++i)
+#endif
     {
 #if @lightingMethodUBO
         int lightIndex = PointLightIndex[i];
+#elif @lightingMethodClustered
+        int lightIndex = texelFetchBuffer(ClusterData, clusterOffset + i).x;
 #else
         int lightIndex = i;
 #endif
@@ -57,12 +57,48 @@ uniform LightBufferBinding
 uniform mat4 LightBuffer[@maxLights];
 uniform int PointLightCount;
 
+#elif @lightingMethodClustered
+
+/* Layout of ClusterLightData, 5 texels per light, the sun is light 0:
+position.xyz, radius
+diffuse.rgb, unused
+ambient.rgb, unused
+specular.rgba
+attenuation constant, linear, quadratic, unused
+
+ClusterData: (offset << 8) | count per cluster followed by the light indices, see SceneUtil::LightClusterGrid
+*/
+uniform samplerBuffer ClusterLightData;
+uniform isamplerBuffer ClusterData;
+// near plane of the cluster grid, depth scale
+uniform vec2 ClusterDepthParams;
+
+vec4 lcalcClusterLight(int lightIndex, int texel)
+{
+    return texelFetchBuffer(ClusterLightData, lightIndex * 5 + texel);
+}
+
+int getClusterData(vec3 viewPos)
+{
+    vec4 clip = gl_ProjectionMatrix * vec4(viewPos, 1.0);
+    vec2 ndc = clip.xy / clip.w;
+    ivec2 size = ivec2(@clusterSizeX, @clusterSizeY);
+    ivec2 tile = clamp(ivec2(floor((ndc * 0.5 + 0.5) * vec2(size))), ivec2(0), size - ivec2(1));
+    float depth = max(-viewPos.z, ClusterDepthParams.x);
+    int slice = int(log(depth / ClusterDepthParams.x) * ClusterDepthParams.y);
+    if (slice >= @clusterSizeZ)
+        return 0;
+    return texelFetchBuffer(ClusterData, (slice * size.y + tile.y) * size.x + tile.x).x;
+}
+
 #endif
 
 float lcalcConstantAttenuation(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][0].w;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 4).x;
 #elif @lightingMethodUBO
     return @getLight[lightIndex].attenuation.x;
 #else
@@ -74,6 +110,8 @@ float lcalcLinearAttenuation(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][1].w;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 4).y;
 #elif @lightingMethodUBO
     return @getLight[lightIndex].attenuation.y;
 #else
@@ -85,6 +123,8 @@ float lcalcQuadraticAttenuation(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][2].w;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 4).z;
 #elif @lightingMethodUBO
     return @getLight[lightIndex].attenuation.z;
 #else
@@ -97,6 +137,8 @@ float lcalcRadius(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][3].w;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 0).w;
 #else
     return @getLight[lightIndex].attenuation.w;
 #endif
@@ -106,7 +148,7 @@ float lcalcRadius(int lightIndex)
 float lcalcIllumination(int lightIndex, float dist)
 {
     float illumination = 1.0 / (lcalcConstantAttenuation(lightIndex) + lcalcLinearAttenuation(lightIndex) * dist + lcalcQuadraticAttenuation(lightIndex) * dist * dist);
-#if @lightingMethodPerObjectUniform || @lightingMethodUBO
+#if @lightingMethodPerObjectUniform || @lightingMethodUBO || @lightingMethodClustered
     // Fade illumination between the radius and the radius doubled to diminish pop-in
     illumination *= 1.0 - quickstep((dist / lcalcRadius(lightIndex)) - 1.0);
 #endif
@@ -117,6 +159,8 @@ vec3 lcalcPosition(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][0].xyz;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 0).xyz;
 #else
     return @getLight[lightIndex].position.xyz;
 #endif
@@ -126,6 +170,8 @@ vec3 lcalcDiffuse(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][2].xyz;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 1).xyz;
 #elif @lightingMethodUBO
     return unpackRGB(@getLight[lightIndex].packedColors.x) * float(@getLight[lightIndex].packedColors.w);
 #else
@@ -137,6 +183,8 @@ vec3 lcalcAmbient(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][1].xyz;
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 2).xyz;
 #elif @lightingMethodUBO
     return unpackRGB(@getLight[lightIndex].packedColors.y);
 #else
@@ -148,6 +196,8 @@ vec4 lcalcSpecular(int lightIndex)
 {
 #if @lightingMethodPerObjectUniform
     return @getLight[lightIndex][3];
+#elif @lightingMethodClustered
+    return lcalcClusterLight(lightIndex, 3);
 #elif @lightingMethodUBO
     return unpackRGBA(@getLight[lightIndex].packedColors.z);
 #else